@@ -0,0 +1,69 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+/**
+ *    @file
+ *      Alternate Weave project configuration for building standalone as a
+ *      server or gateway that talks to many peers at once.
+ *
+ *      The pools of exchange contexts, bindings, timers and packet buffers
+ *      are allocated dynamically, and the lookups that are otherwise linear
+ *      scans are hash indexed.  Since this header is also included ahead of
+ *      the system and Inet layer configuration, it sets their options too.
+ *
+ */
+#ifndef WEAVEPROJECTCONFIG_HIGHSCALE_H
+#define WEAVEPROJECTCONFIG_HIGHSCALE_H
+
+#include "../WeaveProjectConfig.h"
+
+#undef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
+#undef WEAVE_CONFIG_MAX_BINDINGS
+
+// System layer: packet buffers come from the heap, and timers from a growable pool kept in a hashed timing wheel.
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC 0
+#define WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL 1
+#define WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL 1
+#define WEAVE_SYSTEM_CONFIG_NUM_TIMERS 256
+#define WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS 256
+
+// Inet layer.
+#define INET_CONFIG_NUM_TCP_ENDPOINTS 1024
+
+// Message layer: more peers than connections, each of which may hold a session key.
+#define WEAVE_CONFIG_MAX_PEER_NODES 1024
+#define WEAVE_CONFIG_MAX_SESSION_KEYS 1024
+
+// Exchange manager: contexts and bindings are allocated in slabs of the sizes below, and found through hash indexes.
+#define WEAVE_CONFIG_EXCHANGE_MGR_DYNAMIC_POOLS 1
+#define WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS 64
+#define WEAVE_CONFIG_MAX_BINDINGS 64
+#define WEAVE_CONFIG_EXCHANGE_CONTEXT_INDEX_SIZE 256
+#define WEAVE_CONFIG_UNSOLICITED_MESSAGE_HANDLER_INDEX_SIZE 64
+#define WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE 256
+
+// Security manager: establish several sessions at once, and queue CASE requests beyond that.
+#define WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS 16
+#define WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS 16
+
+// Data management: publish to many subscribers, with the subscription handlers and their traits indexed.
+#define WDM_MAX_NUM_SUBSCRIPTION_HANDLERS 128
+#define WDM_MAX_NUM_SUBSCRIPTION_CLIENTS 16
+#define WDM_PUBLISHER_HANDLER_INDEX_SIZE 128
+#define WDM_PUBLISHER_TRAIT_INDEX_SIZE 64
+
+#endif /* WEAVEPROJECTCONFIG_HIGHSCALE_H */
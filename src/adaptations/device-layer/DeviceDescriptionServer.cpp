@@ -46,6 +46,9 @@ WEAVE_ERROR DeviceDescriptionServer::Init()
     // Initialize various members.
     mUserSelectedModeEndTime = 0;
     mUserSelectedModeTimeoutSec = WEAVE_DEVICE_CONFIG_USER_SELECTED_MODE_TIMEOUT_SEC;
+    mEncodedDeviceDescLen = 0;
+
+    SetMaxResponseJitter(WEAVE_DEVICE_CONFIG_IDENTIFY_RESPONSE_MAX_JITTER);
 
 exit:
     return err;
@@ -94,6 +97,16 @@ void DeviceDescriptionServer::SetUserSelectedModeTimeout(uint16_t val)
     mUserSelectedModeTimeoutSec = val;
 }
 
+/**
+ * Discard the cached device descriptor, so that the next IdentifyResponse is built from the current configuration.
+ *
+ * Called by the configuration manager whenever it stores a value that appears in the device descriptor.
+ */
+void DeviceDescriptionServer::InvalidateDeviceDescriptorCache(void)
+{
+    mEncodedDeviceDescLen = 0;
+}
+
 void DeviceDescriptionServer::HandleIdentifyRequest(void *appState, uint64_t nodeId, const IPAddress& nodeAddr,
         const IdentifyRequestMessage& reqMsg, bool& sendResp, IdentifyResponseMessage& respMsg)
 {
@@ -165,7 +178,28 @@ exit:
 
     if (err == WEAVE_NO_ERROR && sendResp)
     {
-        err = ConfigurationMgr().GetDeviceDescriptor(respMsg.DeviceDesc);
+        // Commissioners identify devices by multicast, often repeatedly, so encode the descriptor once and reuse it
+        // until the configuration changes.  Fall back to encoding it per response if it doesn't fit in the cache.
+        if (sInstance.mEncodedDeviceDescLen == 0)
+        {
+            size_t encodedLen;
+
+            if (ConfigurationMgr().GetDeviceDescriptorTLV(sInstance.mEncodedDeviceDesc, sizeof(sInstance.mEncodedDeviceDesc),
+                                                          encodedLen) == WEAVE_NO_ERROR)
+            {
+                sInstance.mEncodedDeviceDescLen = static_cast<uint16_t>(encodedLen);
+            }
+        }
+
+        if (sInstance.mEncodedDeviceDescLen != 0)
+        {
+            respMsg.EncodedDeviceDesc = sInstance.mEncodedDeviceDesc;
+            respMsg.EncodedDeviceDescLen = sInstance.mEncodedDeviceDescLen;
+        }
+        else
+        {
+            err = ConfigurationMgr().GetDeviceDescriptor(respMsg.DeviceDesc);
+        }
     }
 
     if (err != WEAVE_NO_ERROR)
@@ -177,7 +211,11 @@ exit:
 
 void DeviceDescriptionServer::OnPlatformEvent(const WeaveDeviceEvent * event)
 {
-    // Nothing to do so far.
+    // The device descriptor includes the fabric id.
+    if (event->Type == DeviceEventType::kFabricMembershipChange)
+    {
+        InvalidateDeviceDescriptorCache();
+    }
 }
 
 
@@ -39,6 +39,19 @@ using namespace ::Schema::Weave::Trait::Description;
 DeviceIdentityTraitDataSource::DeviceIdentityTraitDataSource(void)
     : TraitDataSource(&DeviceIdentityTrait::TraitSchema)
 {
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT && WEAVE_DEVICE_CONFIG_DEVICE_IDENTITY_TRAIT_SNAPSHOT_SIZE > 0
+    SetSnapshotStore(mSnapshot, sizeof(mSnapshot));
+#endif
+}
+
+/**
+ * Publish the fabric id of a newly joined fabric, or its removal after leaving the fabric.
+ */
+void DeviceIdentityTraitDataSource::OnFabricMembershipChange(void)
+{
+    Lock();
+    SetDirty(DeviceIdentityTrait::kPropertyHandle_FabricId);
+    Unlock();
 }
 
 WEAVE_ERROR DeviceIdentityTraitDataSource::GetLeafData(PropertyPathHandle aLeafHandle, uint64_t aTagToWrite, TLVWriter & aWriter)
@@ -176,6 +176,42 @@ uint16_t BLEManagerImpl::_NumConnections(void)
     return numCons;
 }
 
+WEAVE_ERROR BLEManagerImpl::_SetHighThroughputEnabled(BLE_CONNECTION_OBJECT conId, bool val)
+{
+    WEAVE_ERROR                                   err = WEAVE_NO_ERROR;
+    gecko_msg_le_connection_set_parameters_rsp_t *rsp;
+
+    WeaveLogDetail(DeviceLayer, "Requesting %s BLE connection parameters (con %u)", (val) ? "fast" : "slow", conId);
+
+    // Ask the central for a connection interval suited to the traffic.  The central has the final say
+    // and reports the outcome with a gecko_evt_le_connection_parameters event.
+    rsp = gecko_cmd_le_connection_set_parameters(
+        conId, (val) ? WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MIN : WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MIN,
+        (val) ? WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MAX : WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MAX, 0,
+        WEAVE_DEVICE_CONFIG_BLE_CONNECTION_SUPERVISION_TIMEOUT);
+    err = MapBLEError(rsp->result);
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(DeviceLayer, "gecko_cmd_le_connection_set_parameters() failed: %s", ErrorStr(err));
+        ExitNow();
+    }
+
+#if WEAVE_DEVICE_CONFIG_BLE_ENABLE_2M_PHY
+    // Prefer the 2M PHY while there is data to move, and the 1M PHY otherwise.  A failure here leaves the
+    // connection interval change in effect.
+    {
+        gecko_msg_le_connection_set_phy_rsp_t *phyRsp = gecko_cmd_le_connection_set_phy(conId, (val) ? 2 : 1);
+        if (phyRsp->result != bg_err_success)
+        {
+            WeaveLogProgress(DeviceLayer, "gecko_cmd_le_connection_set_phy() failed: %s", ErrorStr(MapBLEError(phyRsp->result)));
+        }
+    }
+#endif // WEAVE_DEVICE_CONFIG_BLE_ENABLE_2M_PHY
+
+exit:
+    return err;
+}
+
 void BLEManagerImpl::bluetoothStackEventHandler(void *p_arg)
 {
     EventBits_t flags = 0;
@@ -515,6 +551,11 @@ void BLEManagerImpl::NotifyWeaveConnectionClosed(BLE_CONNECTION_OBJECT conId)
     // Nothing to do
 }
 
+bool BLEManagerImpl::RequestHighThroughput(BLE_CONNECTION_OBJECT conId, bool enable)
+{
+    return (_SetHighThroughputEnabled(conId, enable) == WEAVE_NO_ERROR);
+}
+
 WEAVE_ERROR BLEManagerImpl::MapBLEError(int bleErr)
 {
     WEAVE_ERROR err;
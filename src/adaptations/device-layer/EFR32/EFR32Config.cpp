@@ -24,6 +24,7 @@
 
 #include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
 #include <Weave/DeviceLayer/EFR32/EFR32Config.h>
+#include <Weave/DeviceLayer/internal/ConfigValueCache.h>
 #include <Weave/Core/WeaveEncoding.h>
 #include <Weave/DeviceLayer/internal/testing/ConfigUnitTest.h>
 
@@ -64,6 +65,26 @@ namespace Internal {
 
 static nvm3_Handle_t handle;
 
+namespace {
+
+// Scalar values are cached to spare opening NVM3 and looking up the object on every read.
+// Writes of unchanged values are skipped as well.
+ConfigValueCache<EFR32Config::Key, WEAVE_DEVICE_CONFIG_CONFIG_VALUE_CACHE_SIZE> sValueCache;
+
+void CacheReadResult(EFR32Config::Key key, WEAVE_ERROR err, uint64_t val)
+{
+    if (err == WEAVE_NO_ERROR)
+    {
+        sValueCache.Store(key, val);
+    }
+    else if (err == WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND)
+    {
+        sValueCache.StoreNotFound(key);
+    }
+}
+
+} // unnamed namespace
+
 // Declare NVM3 data area and cache.
 
 WEAVE_NVM3_DEFINE_SECTION_STATIC_DATA(weaveNvm3,
@@ -97,9 +118,18 @@ WEAVE_ERROR EFR32Config::ReadConfigValue(Key key, bool &val)
     uint32_t    objectType;
     size_t      dataLen;
     bool        tmpVal;
+    uint64_t    cachedVal;
+    bool        exists;
 
     VerifyOrExit(ValidConfigKey(key), err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND); // Verify key id.
 
+    if (sValueCache.Lookup(key, cachedVal, exists))
+    {
+        VerifyOrExit(exists, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+        val = static_cast<bool>(cachedVal);
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
+
     err = MapNvm3Error(nvm3_open(&handle, &weaveNvm3));
     SuccessOrExit(err);
     needClose = true;
@@ -117,6 +147,7 @@ exit:
     if (needClose)
     {
         nvm3_close(&handle);
+        CacheReadResult(key, err, (err == WEAVE_NO_ERROR) ? val : 0);
     }
     return err;
 }
@@ -128,9 +159,18 @@ WEAVE_ERROR EFR32Config::ReadConfigValue(Key key, uint32_t &val)
     uint32_t    objectType;
     size_t      dataLen;
     uint32_t    tmpVal;
+    uint64_t    cachedVal;
+    bool        exists;
 
     VerifyOrExit(ValidConfigKey(key), err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND); // Verify key id.
 
+    if (sValueCache.Lookup(key, cachedVal, exists))
+    {
+        VerifyOrExit(exists, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+        val = static_cast<uint32_t>(cachedVal);
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
+
     err = MapNvm3Error(nvm3_open(&handle, &weaveNvm3));
     SuccessOrExit(err);
     needClose = true;
@@ -148,6 +188,7 @@ exit:
     if (needClose)
     {
         nvm3_close(&handle);
+        CacheReadResult(key, err, (err == WEAVE_NO_ERROR) ? val : 0);
     }
     return err;
 }
@@ -159,9 +200,18 @@ WEAVE_ERROR EFR32Config::ReadConfigValue(Key key, uint64_t &val)
     uint32_t    objectType;
     size_t      dataLen;
     uint64_t    tmpVal;
+    uint64_t    cachedVal;
+    bool        exists;
 
     VerifyOrExit(ValidConfigKey(key), err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND); // Verify key id.
 
+    if (sValueCache.Lookup(key, cachedVal, exists))
+    {
+        VerifyOrExit(exists, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+        val = static_cast<uint64_t>(cachedVal);
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
+
     err = MapNvm3Error(nvm3_open(&handle, &weaveNvm3));
     SuccessOrExit(err);
     needClose = true;
@@ -179,6 +229,7 @@ exit:
     if (needClose)
     {
         nvm3_close(&handle);
+        CacheReadResult(key, err, (err == WEAVE_NO_ERROR) ? val : 0);
     }
     return err;
 }
@@ -314,6 +365,9 @@ WEAVE_ERROR EFR32Config::WriteConfigValue(Key key, bool val)
 
     VerifyOrExit(ValidConfigKey(key), err = WEAVE_ERROR_INVALID_ARGUMENT); // Verify key id.
 
+    // Spare the flash if the value is already stored.
+    VerifyOrExit(!sValueCache.Contains(key, val), err = WEAVE_NO_ERROR);
+
     err = MapNvm3Error(nvm3_open(&handle, &weaveNvm3));
     SuccessOrExit(err);
     needClose = true;
@@ -321,6 +375,8 @@ WEAVE_ERROR EFR32Config::WriteConfigValue(Key key, bool val)
     err = MapNvm3Error(nvm3_writeData(&handle, key, &val, sizeof(val)));
     SuccessOrExit(err);
 
+    sValueCache.Store(key, val);
+
 exit:
     if (needClose)
     {
@@ -336,6 +392,9 @@ WEAVE_ERROR EFR32Config::WriteConfigValue(Key key, uint32_t val)
 
     VerifyOrExit(ValidConfigKey(key), err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND); // Verify key id.
 
+    // Spare the flash if the value is already stored.
+    VerifyOrExit(!sValueCache.Contains(key, val), err = WEAVE_NO_ERROR);
+
     err = MapNvm3Error(nvm3_open(&handle, &weaveNvm3));
     SuccessOrExit(err);
     needClose = true;
@@ -343,6 +402,8 @@ WEAVE_ERROR EFR32Config::WriteConfigValue(Key key, uint32_t val)
     err = MapNvm3Error(nvm3_writeData(&handle, key, &val, sizeof(val)));
     SuccessOrExit(err);
 
+    sValueCache.Store(key, val);
+
 exit:
     if (needClose)
     {
@@ -358,6 +419,9 @@ WEAVE_ERROR EFR32Config::WriteConfigValue(Key key, uint64_t val)
 
     VerifyOrExit(ValidConfigKey(key), err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND); // Verify key id.
 
+    // Spare the flash if the value is already stored.
+    VerifyOrExit(!sValueCache.Contains(key, val), err = WEAVE_NO_ERROR);
+
     err = MapNvm3Error(nvm3_open(&handle, &weaveNvm3));
     SuccessOrExit(err);
     needClose = true;
@@ -365,6 +429,8 @@ WEAVE_ERROR EFR32Config::WriteConfigValue(Key key, uint64_t val)
     err = MapNvm3Error(nvm3_writeData(&handle, key, &val, sizeof(val)));
     SuccessOrExit(err);
 
+    sValueCache.Store(key, val);
+
 exit:
     if (needClose)
     {
@@ -385,6 +451,8 @@ WEAVE_ERROR EFR32Config::WriteConfigValueStr(Key key, const char *str, size_t st
 
     VerifyOrExit(ValidConfigKey(key), err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND); // Verify key id.
 
+    sValueCache.Invalidate(key);
+
     err = MapNvm3Error(nvm3_open(&handle, &weaveNvm3));
     SuccessOrExit(err);
     needClose = true;
@@ -417,6 +485,8 @@ WEAVE_ERROR EFR32Config::WriteConfigValueBin(Key key, const uint8_t *data, size_
 
     VerifyOrExit(ValidConfigKey(key), err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND); // Verify key id.
 
+    sValueCache.Invalidate(key);
+
     err = MapNvm3Error(nvm3_open(&handle, &weaveNvm3));
     SuccessOrExit(err);
     needClose = true;
@@ -479,6 +549,8 @@ WEAVE_ERROR EFR32Config::ClearConfigValue(Key key)
     err = MapNvm3Error(nvm3_deleteObject(&handle, key));
     SuccessOrExit(err);
 
+    sValueCache.StoreNotFound(key);
+
 exit:
     if (needClose)
     {
@@ -493,6 +565,13 @@ bool EFR32Config::ConfigValueExists(Key key)
     bool        needClose = false;
     uint32_t    objectType;
     size_t      dataLen;
+    uint64_t    cachedVal;
+    bool        exists;
+
+    if (sValueCache.Lookup(key, cachedVal, exists))
+    {
+        return exists;
+    }
 
     err = MapNvm3Error(nvm3_open(&handle, &weaveNvm3));
     SuccessOrExit(err);
@@ -516,6 +595,8 @@ WEAVE_ERROR EFR32Config::FactoryResetConfig(void)
 
     WEAVE_ERROR err;
 
+    sValueCache.Clear();
+
     // Iterate over all the Weave Config nvm3 records and delete each one...
     err = ForEachRecord(kMinConfigKey_WeaveConfig, kMaxConfigKey_WeaveConfig, false,
                         [](const Key &nvm3Key, const size_t &length) -> WEAVE_ERROR {
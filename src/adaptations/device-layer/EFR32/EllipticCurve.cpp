@@ -0,0 +1,194 @@
+/*
+ *
+ *    Copyright (c) 2019 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides implementations for the OpenWeave secp256r1 ECDSA and ECDH
+ *          functions on the Silcon Labs EFR32 platforms.
+ *
+ *          The functions use mbedTLS, whose elliptic curve point arithmetic is
+ *          performed by the CRYPTO (Series 1) or SE (Series 2) accelerator via
+ *          the Silicon Labs alternative implementations.
+ */
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+
+#include <Weave/Support/crypto/WeaveCrypto.h>
+#include <Weave/Support/crypto/WeaveRNG.h>
+#include <Weave/Support/crypto/EllipticCurve.h>
+
+#include <mbedtls/ecdh.h>
+#include <mbedtls/ecdsa.h>
+
+#if WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM
+
+namespace nl {
+namespace Weave {
+namespace Platform {
+namespace Security {
+
+namespace {
+
+int GetSecureRandomData_mbedTLS(void * ctx, unsigned char * buf, size_t len)
+{
+    if (len > UINT16_MAX)
+        return MBEDTLS_ERR_ECP_RANDOM_FAILED;
+
+    return (GetSecureRandomData(buf, (uint16_t) len) == WEAVE_NO_ERROR) ? 0 : MBEDTLS_ERR_ECP_RANDOM_FAILED;
+}
+
+int ReadPublicKey(mbedtls_ecp_point & point, const uint8_t * pubKey)
+{
+    int res;
+
+    res = mbedtls_mpi_read_binary(&point.X, pubKey, kP256_PublicKeyLength / 2);
+    if (res == 0)
+        res = mbedtls_mpi_read_binary(&point.Y, pubKey + kP256_PublicKeyLength / 2, kP256_PublicKeyLength / 2);
+    if (res == 0)
+        res = mbedtls_mpi_lset(&point.Z, 1);
+
+    return res;
+}
+
+} // unnamed namespace
+
+WEAVE_ERROR P256_GenerateECDSASignature(const uint8_t * privKey, const uint8_t * msgHash, uint8_t msgHashLen,
+                                        uint8_t * fixedLenSig)
+{
+    mbedtls_ecp_group grp;
+    mbedtls_mpi d, r, s;
+    int res;
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_mpi_init(&d);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+
+    res = mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1);
+    if (res == 0)
+        res = mbedtls_mpi_read_binary(&d, privKey, kP256_PrivateKeyLength);
+    if (res == 0)
+        res = mbedtls_ecdsa_sign(&grp, &r, &s, &d, msgHash, msgHashLen, GetSecureRandomData_mbedTLS, NULL);
+    if (res == 0)
+        res = mbedtls_mpi_write_binary(&r, fixedLenSig, kP256_FixedLenSigLength / 2);
+    if (res == 0)
+        res = mbedtls_mpi_write_binary(&s, fixedLenSig + kP256_FixedLenSigLength / 2, kP256_FixedLenSigLength / 2);
+
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_group_free(&grp);
+
+    return (res == 0) ? WEAVE_NO_ERROR : WEAVE_ERROR_RANDOM_DATA_UNAVAILABLE;
+}
+
+WEAVE_ERROR P256_VerifyECDSASignature(const uint8_t * pubKey, const uint8_t * msgHash, uint8_t msgHashLen,
+                                      const uint8_t * fixedLenSig)
+{
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point Q;
+    mbedtls_mpi r, s;
+    int res;
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&Q);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+
+    res = mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1);
+    if (res == 0)
+        res = ReadPublicKey(Q, pubKey);
+    if (res == 0)
+        res = mbedtls_mpi_read_binary(&r, fixedLenSig, kP256_FixedLenSigLength / 2);
+    if (res == 0)
+        res = mbedtls_mpi_read_binary(&s, fixedLenSig + kP256_FixedLenSigLength / 2, kP256_FixedLenSigLength / 2);
+    if (res == 0)
+        res = mbedtls_ecdsa_verify(&grp, msgHash, msgHashLen, &Q, &r, &s);
+
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_ecp_point_free(&Q);
+    mbedtls_ecp_group_free(&grp);
+
+    return (res == 0) ? WEAVE_NO_ERROR : WEAVE_ERROR_INVALID_SIGNATURE;
+}
+
+WEAVE_ERROR P256_GenerateECDHKey(uint8_t * pubKey, uint8_t * privKey)
+{
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point Q;
+    mbedtls_mpi d;
+    int res;
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&Q);
+    mbedtls_mpi_init(&d);
+
+    res = mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1);
+    if (res == 0)
+        res = mbedtls_ecdh_gen_public(&grp, &d, &Q, GetSecureRandomData_mbedTLS, NULL);
+    if (res == 0)
+        res = mbedtls_mpi_write_binary(&d, privKey, kP256_PrivateKeyLength);
+    if (res == 0)
+        res = mbedtls_mpi_write_binary(&Q.X, pubKey, kP256_PublicKeyLength / 2);
+    if (res == 0)
+        res = mbedtls_mpi_write_binary(&Q.Y, pubKey + kP256_PublicKeyLength / 2, kP256_PublicKeyLength / 2);
+
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_point_free(&Q);
+    mbedtls_ecp_group_free(&grp);
+
+    return (res == 0) ? WEAVE_NO_ERROR : WEAVE_ERROR_RANDOM_DATA_UNAVAILABLE;
+}
+
+WEAVE_ERROR P256_ECDHComputeSharedSecret(const uint8_t * pubKey, const uint8_t * privKey, uint8_t * sharedSecret)
+{
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point Q;
+    mbedtls_mpi d, z;
+    int res;
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&Q);
+    mbedtls_mpi_init(&d);
+    mbedtls_mpi_init(&z);
+
+    res = mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1);
+    if (res == 0)
+        res = ReadPublicKey(Q, pubKey);
+    if (res == 0)
+        res = mbedtls_mpi_read_binary(&d, privKey, kP256_PrivateKeyLength);
+    if (res == 0)
+        res = mbedtls_ecdh_compute_shared(&grp, &z, &Q, &d, GetSecureRandomData_mbedTLS, NULL);
+    if (res == 0)
+        res = mbedtls_mpi_write_binary(&z, sharedSecret, kP256_SharedSecretLength);
+
+    mbedtls_mpi_free(&z);
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_point_free(&Q);
+    mbedtls_ecp_group_free(&grp);
+
+    return (res == 0) ? WEAVE_NO_ERROR : WEAVE_ERROR_INVALID_ARGUMENT;
+}
+
+} // namespace Security
+} // namespace Platform
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM
@@ -37,50 +37,32 @@ namespace Internal {
 WEAVE_ERROR GroupKeyStoreImpl::RetrieveGroupKey(uint32_t keyId, WeaveGroupKey &key)
 {
     WEAVE_ERROR err;
+    size_t      keyLen;
+    uint8_t     buf[kMaxEncodedKeySize]; // (buf length == 45 bytes)
 
-    // Iterate over all the GroupKey nvm3 records looking for a matching key...
-    err = ForEachRecord(kConfigKey_GroupKeyBase, kConfigKey_GroupKeyMax, false,
-                        [keyId, &key](const Key &nvm3Key, const size_t &length) -> WEAVE_ERROR {
-                            WEAVE_ERROR err2;
-                            size_t      keyLen;
-                            uint8_t     buf[kMaxEncodedKeySize]; // (buf length == 45 bytes)
-                            uint32_t    curKeyId;
-
-                            // Read the nvm3 obj binary data data into the buffer.
-                            err2 = ReadConfigValueBin(nvm3Key, buf, sizeof(buf), keyLen);
+    err = LoadKeyIndex();
+    SuccessOrExit(err);
 
-                            // Decode the Weave key id for the current key.
-                            err2 = DecodeGroupKeyId(buf, keyLen, curKeyId);
-                            SuccessOrExit(err2);
-
-                            // If it matches the key we're looking for...
-                            if (curKeyId == keyId)
-                            {
-                                // Decode the associated key data.
-                                err2 = DecodeGroupKey(buf, keyLen, key);
-                                SuccessOrExit(err2);
-
-                                // End the iteration by returning a WEAVE_END_OF_INPUT result.
-                                ExitNow(err2 = WEAVE_END_OF_INPUT);
-                            }
-
-                        exit:
-                            return err2;
-                        });
-
-    // Modify error code for return.
-    switch (err)
+    // Look up the nvm3 object holding the key and read it directly.
+    err = WEAVE_ERROR_KEY_NOT_FOUND;
+    for (uint8_t i = 0; i < mNumKeys; i++)
     {
-    case WEAVE_END_OF_INPUT:
-        err = WEAVE_NO_ERROR; // Match found.
-        break;
-    case WEAVE_NO_ERROR:
-        err = WEAVE_ERROR_KEY_NOT_FOUND; // Match not found.
-        break;
-    default:
-        break;
+        if (mKeyIds[i] == keyId)
+        {
+            err = ReadConfigValueBin(mNvm3Keys[i], buf, sizeof(buf), keyLen);
+            if (err == WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND)
+            {
+                err = WEAVE_ERROR_KEY_NOT_FOUND;
+            }
+            SuccessOrExit(err);
+
+            err = DecodeGroupKey(buf, keyLen, key);
+            break;
+        }
     }
 
+exit:
+    ClearSecretData(buf, sizeof(buf));
     return err;
 }
 
@@ -88,6 +70,8 @@ WEAVE_ERROR GroupKeyStoreImpl::StoreGroupKey(const WeaveGroupKey &key)
 {
     WEAVE_ERROR err;
 
+    mIndexLoaded = false;
+
     // Delete any existing group key with the same id (this may or may not exit).
     DeleteGroupKey(key.KeyId); // no error checking here.
 
@@ -166,6 +150,8 @@ WEAVE_ERROR GroupKeyStoreImpl::DeleteGroupKey(uint32_t keyId)
 {
     WEAVE_ERROR err;
 
+    mIndexLoaded = false;
+
     // Iterate over all the GroupKey nvm3 records looking for a matching key...
     err = ForEachRecord(kConfigKey_GroupKeyBase, kConfigKey_GroupKeyMax, false,
                         [keyId](const Key &nvm3Key, const size_t &length) -> WEAVE_ERROR {
@@ -216,6 +202,8 @@ WEAVE_ERROR GroupKeyStoreImpl::DeleteGroupKeysOfAType(uint32_t keyType)
 {
     WEAVE_ERROR err;
 
+    mIndexLoaded = false;
+
     // Iterate over all the GroupKey nvm3 records looking for a matching key...
     err = ForEachRecord(kConfigKey_GroupKeyBase, kConfigKey_GroupKeyMax, false,
                         [keyType](const Key &nvm3Key, const size_t &length) -> WEAVE_ERROR {
@@ -255,42 +243,19 @@ WEAVE_ERROR GroupKeyStoreImpl::EnumerateGroupKeys(uint32_t  keyType,
 
     keyCount = 0;
 
-    // Iterate over all the GroupKey records looking for keys of the specified type...
-    err = ForEachRecord(
-        kConfigKey_GroupKeyBase, kConfigKey_GroupKeyMax, false,
-        [keyType, keyIds, keyIdsArraySize, &keyCount](const Key &nvm3Key, const size_t &length) -> WEAVE_ERROR {
-            WEAVE_ERROR err2;
-            size_t      keyLen;
-            uint8_t     buf[kMaxEncodedKeySize]; // (buf length == 45 bytes)
-            uint32_t    curKeyId;
-
-            // Read the nvm3 obj binary data data into the buffer.
-            err2 = ReadConfigValueBin(nvm3Key, buf, sizeof(buf), keyLen);
-            SuccessOrExit(err2);
-
-            // Decode the Weave key id for the current group key.
-            err2 = DecodeGroupKeyId(buf, keyLen, curKeyId);
-            SuccessOrExit(err2);
-
-            // If the current key matches the type we're looking for, add it to the keyIds array.
-            if ((keyType == WeaveKeyId::kType_None) || (WeaveKeyId::GetType(curKeyId) == keyType))
-            {
-                keyIds[keyCount++] = curKeyId;
-
-                // Stop iterating if there's no more room in the keyIds array.
-                VerifyOrExit(keyCount < keyIdsArraySize, err2 = WEAVE_ERROR_BUFFER_TOO_SMALL);
-            }
-
-        exit:
-            return err2;
-        });
+    err = LoadKeyIndex();
+    SuccessOrExit(err);
 
     // Simply return a truncated list if there are more matching keys than will fit in the array.
-    if (err == WEAVE_ERROR_BUFFER_TOO_SMALL)
+    for (uint8_t i = 0; i < mNumKeys && keyCount < keyIdsArraySize; i++)
     {
-        err = WEAVE_NO_ERROR;
+        if ((keyType == WeaveKeyId::kType_None) || (WeaveKeyId::GetType(mKeyIds[i]) == keyType))
+        {
+            keyIds[keyCount++] = mKeyIds[i];
+        }
     }
 
+exit:
     return err;
 }
 
@@ -298,6 +263,8 @@ WEAVE_ERROR GroupKeyStoreImpl::Clear(void)
 {
     WEAVE_ERROR err;
 
+    mIndexLoaded = false;
+
     // Iterate over all the GroupKey nvm3 records deleting each one...
     err = ForEachRecord(kConfigKey_GroupKeyBase, kConfigKey_GroupKeyMax, false,
                         [](const Key &nvm3Key, const size_t &length) -> WEAVE_ERROR {
@@ -313,6 +280,51 @@ WEAVE_ERROR GroupKeyStoreImpl::Clear(void)
     return err;
 }
 
+WEAVE_ERROR GroupKeyStoreImpl::EnumerateEpochKeys(uint32_t *keyIds, uint32_t *startTimes, uint8_t arraySize, uint8_t &keyCount)
+{
+    WEAVE_ERROR err;
+
+    keyCount = 0;
+
+    err = LoadKeyIndex();
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < mNumKeys && keyCount < arraySize; i++)
+    {
+        if (WeaveKeyId::IsAppEpochKey(mKeyIds[i]))
+        {
+            keyIds[keyCount]     = mKeyIds[i];
+            startTimes[keyCount] = mKeyInfo[i];
+            keyCount++;
+        }
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR GroupKeyStoreImpl::FindGroupMasterKeyId(uint32_t groupGlobalId, uint32_t &groupMasterKeyId)
+{
+    WEAVE_ERROR err;
+
+    err = LoadKeyIndex();
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < mNumKeys; i++)
+    {
+        if (WeaveKeyId::IsAppGroupMasterKey(mKeyIds[i]) && mKeyInfo[i] == groupGlobalId)
+        {
+            groupMasterKeyId = mKeyIds[i];
+            ExitNow();
+        }
+    }
+
+    err = WEAVE_ERROR_KEY_NOT_FOUND;
+
+exit:
+    return err;
+}
+
 WEAVE_ERROR GroupKeyStoreImpl::RetrieveLastUsedEpochKeyId(void)
 {
     WEAVE_ERROR err;
@@ -333,10 +345,54 @@ WEAVE_ERROR GroupKeyStoreImpl::StoreLastUsedEpochKeyId(void)
 
 WEAVE_ERROR GroupKeyStoreImpl::Init()
 {
-    // Nothing to do
+    // The key index is built on first use.
+    mNumKeys     = 0;
+    mIndexLoaded = false;
+
     return WEAVE_NO_ERROR;
 }
 
+WEAVE_ERROR GroupKeyStoreImpl::LoadKeyIndex(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(!mIndexLoaded, err = WEAVE_NO_ERROR);
+
+    mNumKeys = 0;
+
+    // Record the key id, start time / global id and nvm3 object key of each GroupKey object.
+    err = ForEachRecord(kConfigKey_GroupKeyBase, kConfigKey_GroupKeyMax, false,
+                        [this](const Key &nvm3Key, const size_t &length) -> WEAVE_ERROR {
+                            WEAVE_ERROR err2;
+                            size_t      keyLen;
+                            uint8_t     buf[kMaxEncodedKeySize]; // (buf length == 45 bytes)
+
+                            VerifyOrExit(mNumKeys < kMaxGroupKeys, err2 = WEAVE_ERROR_TOO_MANY_KEYS);
+
+                            // Read the nvm3 obj binary data data into the buffer.
+                            err2 = ReadConfigValueBin(nvm3Key, buf, sizeof(buf), keyLen);
+                            SuccessOrExit(err2);
+
+                            // Decode the Weave key id for the current group key.
+                            err2 = DecodeGroupKeyId(buf, keyLen, mKeyIds[mNumKeys]);
+                            SuccessOrExit(err2);
+
+                            mKeyInfo[mNumKeys]  = Encoding::LittleEndian::Get32(buf + 4);
+                            mNvm3Keys[mNumKeys] = nvm3Key;
+                            mNumKeys++;
+
+                        exit:
+                            ClearSecretData(buf, sizeof(buf));
+                            return err2;
+                        });
+    SuccessOrExit(err);
+
+    mIndexLoaded = true;
+
+exit:
+    return err;
+}
+
 WEAVE_ERROR GroupKeyStoreImpl::EncodeGroupKey(const WeaveGroupKey &key,
                                               uint8_t *            buf,
                                               size_t               bufSize,
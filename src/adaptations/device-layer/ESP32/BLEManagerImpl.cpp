@@ -364,6 +364,11 @@ void BLEManagerImpl::NotifyWeaveConnectionClosed(BLE_CONNECTION_OBJECT conId)
 {
 }
 
+bool BLEManagerImpl::RequestHighThroughput(BLE_CONNECTION_OBJECT conId, bool enable)
+{
+    return (_SetHighThroughputEnabled(conId, enable) == WEAVE_NO_ERROR);
+}
+
 void BLEManagerImpl::DriveBLEState(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -846,8 +851,15 @@ void BLEManagerImpl::HandleGATTCommEvent(esp_gatts_cb_event_t event, esp_gatt_if
     case ESP_GATTS_CONNECT_EVT:
         WeaveLogProgress(DeviceLayer, "BLE GATT connection established (con %u)", param->connect.conn_id);
 
-        // Allocate a connection state record for the new connection.
-        GetConnectionState(param->mtu.conn_id, true);
+        // Allocate a connection state record for the new connection, noting the peer's address
+        // for later connection parameter updates.
+        {
+            WoBLEConState * conState = GetConnectionState(param->connect.conn_id, true);
+            if (conState != NULL)
+            {
+                memcpy(conState->PeerAddr, param->connect.remote_bda, sizeof(esp_bd_addr_t));
+            }
+        }
 
         // Receiving a connection stops the advertising processes.  So force a refresh of the advertising
         // state.
@@ -1174,6 +1186,36 @@ uint16_t BLEManagerImpl::_NumConnections(void)
     return numCons;
 }
 
+WEAVE_ERROR BLEManagerImpl::_SetHighThroughputEnabled(BLE_CONNECTION_OBJECT conId, bool val)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WoBLEConState * conState = GetConnectionState(conId);
+    esp_ble_conn_update_params_t connParams;
+
+    VerifyOrExit(conState != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    WeaveLogDetail(DeviceLayer, "Requesting %s BLE connection parameters (con %u)", (val) ? "fast" : "slow", conId);
+
+    // Ask the central for a connection interval suited to the traffic.  The central has the final say
+    // and reports the outcome with an ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT event.
+    //
+    // NOTE: The ESP32 radio has no LE 2M PHY, so WEAVE_DEVICE_CONFIG_BLE_ENABLE_2M_PHY has no effect here.
+    memcpy(connParams.bda, conState->PeerAddr, sizeof(esp_bd_addr_t));
+    connParams.min_int = (val) ? WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MIN : WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MIN;
+    connParams.max_int = (val) ? WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MAX : WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MAX;
+    connParams.latency = 0;
+    connParams.timeout = WEAVE_DEVICE_CONFIG_BLE_CONNECTION_SUPERVISION_TIMEOUT;
+    err = esp_ble_gap_update_conn_params(&connParams);
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(DeviceLayer, "esp_ble_gap_update_conn_params() failed: %s", ErrorStr(err));
+        ExitNow();
+    }
+
+exit:
+    return err;
+}
+
 void BLEManagerImpl::HandleGATTEvent(esp_gatts_cb_event_t event, esp_gatt_if_t gatts_if, esp_ble_gatts_cb_param_t * param)
 {
     ESP_LOGV(TAG, "GATT Event: %d (if %d)", (int)event, (int)gatts_if);
@@ -316,6 +316,12 @@ WEAVE_ERROR ConnectivityManagerImpl::_GetAndLogWifiStatsCounters(void)
     statsEvent.sleepTimePercent = 0;
     statsEvent.numOfAp          = 0;
 
+    // Only log an event after a change of access point or channel.
+    mWiFiStatsChangeFilter.BeginSample();
+    mWiFiStatsChangeFilter.AddMetric(statsEvent.bssid);
+    mWiFiStatsChangeFilter.AddMetric(statsEvent.freq);
+    VerifyOrExit(mWiFiStatsChangeFilter.ShouldLog(), );
+
     WeaveLogProgress(DeviceLayer,
                      "WiFi-Telemtry\n"
                      "BSSID:         %x\n"
@@ -24,6 +24,7 @@
 
 #include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
 #include <Weave/DeviceLayer/ESP32/ESP32Config.h>
+#include <Weave/DeviceLayer/internal/ConfigValueCache.h>
 
 #include "nvs_flash.h"
 #include "nvs.h"
@@ -64,10 +65,143 @@ const ESP32Config::Key ESP32Config::kConfigKey_OperationalDeviceId         = { k
 const ESP32Config::Key ESP32Config::kConfigKey_OperationalDeviceCert       = { kConfigNamespace_WeaveConfig,  "op-device-cert"     };
 const ESP32Config::Key ESP32Config::kConfigKey_OperationalDeviceICACerts   = { kConfigNamespace_WeaveConfig,  "op-device-ca-certs" };
 const ESP32Config::Key ESP32Config::kConfigKey_OperationalDevicePrivateKey = { kConfigNamespace_WeaveConfig,  "op-device-key"      };
+const ESP32Config::Key ESP32Config::kConfigKey_SoftwareUpdateProgress      = { kConfigNamespace_WeaveConfig,  "swu-progress"       };
 
 // Prefix used for NVS keys that contain Weave group encryption keys.
 const char ESP32Config::kGroupKeyNamePrefix[]                              = "gk-";
 
+namespace {
+
+// Key under which a scalar value is cached.  Key names are copied, as callers such as the
+// persisted counter code supply them from transient buffers.  Namespaces are always one of the
+// static namespace strings above.
+struct CachedKey
+{
+    const char * Namespace;
+    char Name[ESP32Config::kMaxConfigKeyNameLength + 1];
+
+    bool operator ==(const CachedKey & other) const
+    {
+        return strcmp(Namespace, other.Namespace) == 0 && strcmp(Name, other.Name) == 0;
+    }
+};
+
+ConfigValueCache<CachedKey, WEAVE_DEVICE_CONFIG_CONFIG_VALUE_CACHE_SIZE> sValueCache;
+
+// Returns false for keys whose names are too long to be valid, and hence never cached.
+bool MakeCachedKey(const ESP32Config::Key & key, CachedKey & cachedKey)
+{
+    size_t nameLen = strlen(key.Name);
+    if (nameLen > ESP32Config::kMaxConfigKeyNameLength)
+    {
+        return false;
+    }
+    cachedKey.Namespace = key.Namespace;
+    memcpy(cachedKey.Name, key.Name, nameLen + 1);
+    return true;
+}
+
+bool LookupCachedValue(const ESP32Config::Key & key, uint64_t & val, bool & exists)
+{
+    CachedKey cachedKey;
+    return MakeCachedKey(key, cachedKey) && sValueCache.Lookup(cachedKey, val, exists);
+}
+
+// Returns true if the given scalar value is known to be stored already, so writing it can be skipped.
+bool IsValueUnchanged(const ESP32Config::Key & key, uint64_t val)
+{
+    CachedKey cachedKey;
+    return MakeCachedKey(key, cachedKey) && sValueCache.Contains(cachedKey, val);
+}
+
+void CacheValue(const ESP32Config::Key & key, uint64_t val)
+{
+    CachedKey cachedKey;
+    if (MakeCachedKey(key, cachedKey))
+    {
+        sValueCache.Store(cachedKey, val);
+    }
+}
+
+void CacheNotFound(const ESP32Config::Key & key)
+{
+    CachedKey cachedKey;
+    if (MakeCachedKey(key, cachedKey))
+    {
+        sValueCache.StoreNotFound(cachedKey);
+    }
+}
+
+void InvalidateCachedValue(const ESP32Config::Key & key)
+{
+    CachedKey cachedKey;
+    if (MakeCachedKey(key, cachedKey))
+    {
+        sValueCache.Invalidate(cachedKey);
+    }
+}
+
+// State of the current write batch, if any.
+uint16_t sWriteBatchDepth;
+const char * sWriteBatchNamespace;
+nvs_handle sWriteBatchHandle;
+
+WEAVE_ERROR FlushWriteBatch(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    if (sWriteBatchNamespace != NULL)
+    {
+        err = nvs_commit(sWriteBatchHandle);
+        nvs_close(sWriteBatchHandle);
+        sWriteBatchNamespace = NULL;
+    }
+
+    return err;
+}
+
+// Open the given namespace for writing.  Within a write batch, the batch's handle is returned
+// and the caller must not close it.
+WEAVE_ERROR OpenForWrite(const char * ns, nvs_handle & handle, bool & needClose)
+{
+    WEAVE_ERROR err;
+
+    needClose = false;
+
+    if (sWriteBatchDepth == 0)
+    {
+        err = nvs_open(ns, NVS_READWRITE, &handle);
+        SuccessOrExit(err);
+        needClose = true;
+        ExitNow();
+    }
+
+    if (sWriteBatchNamespace != ns)
+    {
+        // Commit what has been written to the previous namespace before moving to the next.
+        err = FlushWriteBatch();
+        SuccessOrExit(err);
+
+        err = nvs_open(ns, NVS_READWRITE, &sWriteBatchHandle);
+        SuccessOrExit(err);
+        sWriteBatchNamespace = ns;
+    }
+
+    handle = sWriteBatchHandle;
+    err = WEAVE_NO_ERROR;
+
+exit:
+    return err;
+}
+
+// Commit a write to the persistent store, unless a write batch defers the commit to its end.
+WEAVE_ERROR CommitWrite(nvs_handle handle)
+{
+    return (sWriteBatchDepth == 0) ? nvs_commit(handle) : WEAVE_NO_ERROR;
+}
+
+} // unnamed namespace
+
 
 WEAVE_ERROR ESP32Config::ReadConfigValue(Key key, bool & val)
 {
@@ -75,6 +209,15 @@ WEAVE_ERROR ESP32Config::ReadConfigValue(Key key, bool & val)
     nvs_handle handle;
     bool needClose = false;
     uint32_t intVal;
+    uint64_t cachedVal;
+    bool exists;
+
+    if (LookupCachedValue(key, cachedVal, exists))
+    {
+        VerifyOrExit(exists, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+        val = (cachedVal != 0);
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
 
     err = nvs_open(key.Namespace, NVS_READONLY, &handle);
     SuccessOrExit(err);
@@ -83,11 +226,13 @@ WEAVE_ERROR ESP32Config::ReadConfigValue(Key key, bool & val)
     err = nvs_get_u32(handle, key.Name, &intVal);
     if (err == ESP_ERR_NVS_NOT_FOUND)
     {
+        CacheNotFound(key);
         err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND;
     }
     SuccessOrExit(err);
 
     val = (intVal != 0);
+    CacheValue(key, intVal);
 
 exit:
     if (needClose)
@@ -102,6 +247,15 @@ WEAVE_ERROR ESP32Config::ReadConfigValue(Key key, uint32_t & val)
     WEAVE_ERROR err;
     nvs_handle handle;
     bool needClose = false;
+    uint64_t cachedVal;
+    bool exists;
+
+    if (LookupCachedValue(key, cachedVal, exists))
+    {
+        VerifyOrExit(exists, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+        val = static_cast<uint32_t>(cachedVal);
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
 
     err = nvs_open(key.Namespace, NVS_READONLY, &handle);
     SuccessOrExit(err);
@@ -110,10 +264,13 @@ WEAVE_ERROR ESP32Config::ReadConfigValue(Key key, uint32_t & val)
     err = nvs_get_u32(handle, key.Name, &val);
     if (err == ESP_ERR_NVS_NOT_FOUND)
     {
+        CacheNotFound(key);
         err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND;
     }
     SuccessOrExit(err);
 
+    CacheValue(key, val);
+
 exit:
     if (needClose)
     {
@@ -127,6 +284,13 @@ WEAVE_ERROR ESP32Config::ReadConfigValue(Key key, uint64_t & val)
     WEAVE_ERROR err;
     nvs_handle handle;
     bool needClose = false;
+    bool exists;
+
+    if (LookupCachedValue(key, val, exists))
+    {
+        VerifyOrExit(exists, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
 
     err = nvs_open(key.Namespace, NVS_READONLY, &handle);
     SuccessOrExit(err);
@@ -149,6 +313,7 @@ WEAVE_ERROR ESP32Config::ReadConfigValue(Key key, uint64_t & val)
         {
             VerifyOrExit(deviceIdLen == sizeof(deviceIdBytes), err = ESP_ERR_NVS_INVALID_LENGTH);
             val = Encoding::BigEndian::Get64(deviceIdBytes);
+            CacheValue(key, val);
             ExitNow();
         }
     }
@@ -156,10 +321,13 @@ WEAVE_ERROR ESP32Config::ReadConfigValue(Key key, uint64_t & val)
     err = nvs_get_u64(handle, key.Name, &val);
     if (err == ESP_ERR_NVS_NOT_FOUND)
     {
+        CacheNotFound(key);
         err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND;
     }
     SuccessOrExit(err);
 
+    CacheValue(key, val);
+
 exit:
     if (needClose)
     {
@@ -240,17 +408,21 @@ WEAVE_ERROR ESP32Config::WriteConfigValue(Key key, bool val)
     nvs_handle handle;
     bool needClose = false;
 
-    err = nvs_open(key.Namespace, NVS_READWRITE, &handle);
+    // Spare the flash if the value is already stored.
+    VerifyOrExit(!IsValueUnchanged(key, val ? 1 : 0), err = WEAVE_NO_ERROR);
+
+    err = OpenForWrite(key.Namespace, handle, needClose);
     SuccessOrExit(err);
-    needClose = true;
 
     err = nvs_set_u32(handle, key.Name, val ? 1 : 0);
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = nvs_commit(handle);
+    err = CommitWrite(handle);
     SuccessOrExit(err);
 
+    CacheValue(key, val ? 1 : 0);
+
     WeaveLogProgress(DeviceLayer, "NVS set: %s/%s = %s", key.Namespace, key.Name, val ? "true" : "false");
 
 exit:
@@ -268,17 +440,21 @@ WEAVE_ERROR ESP32Config::WriteConfigValue(Key key, uint32_t val)
     nvs_handle handle;
     bool needClose = false;
 
-    err = nvs_open(key.Namespace, NVS_READWRITE, &handle);
+    // Spare the flash if the value is already stored.
+    VerifyOrExit(!IsValueUnchanged(key, val), err = WEAVE_NO_ERROR);
+
+    err = OpenForWrite(key.Namespace, handle, needClose);
     SuccessOrExit(err);
-    needClose = true;
 
     err = nvs_set_u32(handle, key.Name, val);
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = nvs_commit(handle);
+    err = CommitWrite(handle);
     SuccessOrExit(err);
 
+    CacheValue(key, val);
+
     WeaveLogProgress(DeviceLayer, "NVS set: %s/%s = %" PRIu32 " (0x%" PRIX32 ")", key.Namespace, key.Name, val, val);
 
 exit:
@@ -296,17 +472,21 @@ WEAVE_ERROR ESP32Config::WriteConfigValue(Key key, uint64_t val)
     nvs_handle handle;
     bool needClose = false;
 
-    err = nvs_open(key.Namespace, NVS_READWRITE, &handle);
+    // Spare the flash if the value is already stored.
+    VerifyOrExit(!IsValueUnchanged(key, val), err = WEAVE_NO_ERROR);
+
+    err = OpenForWrite(key.Namespace, handle, needClose);
     SuccessOrExit(err);
-    needClose = true;
 
     err = nvs_set_u64(handle, key.Name, val);
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = nvs_commit(handle);
+    err = CommitWrite(handle);
     SuccessOrExit(err);
 
+    CacheValue(key, val);
+
     WeaveLogProgress(DeviceLayer, "NVS set: %s/%s = %" PRIu64 " (0x%" PRIX64 ")", key.Namespace, key.Name, val, val);
 
 exit:
@@ -326,15 +506,16 @@ WEAVE_ERROR ESP32Config::WriteConfigValueStr(Key key, const char * str)
 
     if (str != NULL)
     {
-        err = nvs_open(key.Namespace, NVS_READWRITE, &handle);
+        InvalidateCachedValue(key);
+
+        err = OpenForWrite(key.Namespace, handle, needClose);
         SuccessOrExit(err);
-        needClose = true;
 
         err = nvs_set_str(handle, key.Name, str);
         SuccessOrExit(err);
 
         // Commit the value to the persistent store.
-        err = nvs_commit(handle);
+        err = CommitWrite(handle);
         SuccessOrExit(err);
 
         WeaveLogProgress(DeviceLayer, "NVS set: %s/%s = \"%s\"", key.Namespace, key.Name, str);
@@ -384,15 +565,16 @@ WEAVE_ERROR ESP32Config::WriteConfigValueBin(Key key, const uint8_t * data, size
 
     if (data != NULL)
     {
-        err = nvs_open(key.Namespace, NVS_READWRITE, &handle);
+        InvalidateCachedValue(key);
+
+        err = OpenForWrite(key.Namespace, handle, needClose);
         SuccessOrExit(err);
-        needClose = true;
 
         err = nvs_set_blob(handle, key.Name, data, dataLen);
         SuccessOrExit(err);
 
         // Commit the value to the persistent store.
-        err = nvs_commit(handle);
+        err = CommitWrite(handle);
         SuccessOrExit(err);
 
         WeaveLogProgress(DeviceLayer, "NVS set: %s/%s = (blob length %" PRId32 ")", key.Namespace, key.Name, dataLen);
@@ -419,21 +601,23 @@ WEAVE_ERROR ESP32Config::ClearConfigValue(Key key)
     nvs_handle handle;
     bool needClose = false;
 
-    err = nvs_open(key.Namespace, NVS_READWRITE, &handle);
+    err = OpenForWrite(key.Namespace, handle, needClose);
     SuccessOrExit(err);
-    needClose = true;
 
     err = nvs_erase_key(handle, key.Name);
     if (err == ESP_ERR_NVS_NOT_FOUND)
     {
+        CacheNotFound(key);
         ExitNow(err = WEAVE_NO_ERROR);
     }
     SuccessOrExit(err);
 
     // Commit the value to the persistent store.
-    err = nvs_commit(handle);
+    err = CommitWrite(handle);
     SuccessOrExit(err);
 
+    CacheNotFound(key);
+
     WeaveLogProgress(DeviceLayer, "NVS erase: %s/%s", key.Namespace, key.Name);
 
 exit:
@@ -450,6 +634,13 @@ bool ESP32Config::ConfigValueExists(Key key)
     WEAVE_ERROR err;
     nvs_handle handle;
     bool needClose = false;
+    uint64_t cachedVal;
+    bool exists;
+
+    if (LookupCachedValue(key, cachedVal, exists))
+    {
+        return exists;
+    }
 
     err = nvs_open(key.Namespace, NVS_READONLY, &handle);
     SuccessOrExit(err);
@@ -567,6 +758,8 @@ WEAVE_ERROR ESP32Config::ClearNamespace(const char * ns)
     SuccessOrExit(err);
     needClose = true;
 
+    sValueCache.Clear();
+
     err = nvs_erase_all(handle);
     SuccessOrExit(err);
 
@@ -581,6 +774,28 @@ exit:
     return err;
 }
 
+WEAVE_ERROR ESP32Config::BeginWriteBatch(void)
+{
+    sWriteBatchDepth++;
+    return WEAVE_NO_ERROR;
+}
+
+WEAVE_ERROR ESP32Config::CommitWriteBatch(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(sWriteBatchDepth > 0, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // Writes are committed when the outermost batch ends.
+    if (--sWriteBatchDepth == 0)
+    {
+        err = FlushWriteBatch();
+    }
+
+exit:
+    return err;
+}
+
 } // namespace Internal
 } // namespace DeviceLayer
 } // namespace Weave
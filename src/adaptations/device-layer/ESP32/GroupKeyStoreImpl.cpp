@@ -124,6 +124,19 @@ WEAVE_ERROR GroupKeyStoreImpl::StoreGroupKey(const WeaveGroupKey & key)
     err = nvs_commit(handle);
     SuccessOrExit(err);
 
+    // Keep the in-memory copy of the key's start time / global id up to date.
+    if (mKeyInfoLoaded)
+    {
+        for (uint8_t i = 0; i < mNumKeys; i++)
+        {
+            if (mKeyIndex[i] == key.KeyId)
+            {
+                mKeyInfo[i] = key.StartTime;
+                break;
+            }
+        }
+    }
+
 exit:
 	if (needClose)
 	{
@@ -168,6 +181,52 @@ WEAVE_ERROR GroupKeyStoreImpl::Clear(void)
     return DeleteKeyOrKeys(WeaveKeyId::kNone, WeaveKeyId::kType_None);
 }
 
+WEAVE_ERROR GroupKeyStoreImpl::EnumerateEpochKeys(uint32_t * keyIds, uint32_t * startTimes,
+        uint8_t arraySize, uint8_t & keyCount)
+{
+    WEAVE_ERROR err;
+
+    keyCount = 0;
+
+    err = LoadKeyInfo();
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < mNumKeys && keyCount < arraySize; i++)
+    {
+        if (WeaveKeyId::IsAppEpochKey(mKeyIndex[i]))
+        {
+            keyIds[keyCount] = mKeyIndex[i];
+            startTimes[keyCount] = mKeyInfo[i];
+            keyCount++;
+        }
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR GroupKeyStoreImpl::FindGroupMasterKeyId(uint32_t groupGlobalId, uint32_t & groupMasterKeyId)
+{
+    WEAVE_ERROR err;
+
+    err = LoadKeyInfo();
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < mNumKeys; i++)
+    {
+        if (WeaveKeyId::IsAppGroupMasterKey(mKeyIndex[i]) && mKeyInfo[i] == groupGlobalId)
+        {
+            groupMasterKeyId = mKeyIndex[i];
+            ExitNow();
+        }
+    }
+
+    err = WEAVE_ERROR_KEY_NOT_FOUND;
+
+exit:
+    return err;
+}
+
 WEAVE_ERROR GroupKeyStoreImpl::RetrieveLastUsedEpochKeyId(void)
 {
     WEAVE_ERROR err;
@@ -202,7 +261,37 @@ WEAVE_ERROR GroupKeyStoreImpl::Init()
 
     mNumKeys = indexSizeBytes / sizeof(uint32_t);
 
+    // The start times and global ids of the keys are read on first use.
+    mKeyInfoLoaded = false;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR GroupKeyStoreImpl::LoadKeyInfo(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveGroupKey key;
+
+    VerifyOrExit(!mKeyInfoLoaded, err = WEAVE_NO_ERROR);
+
+    for (uint8_t i = 0; i < mNumKeys; i++)
+    {
+        mKeyInfo[i] = 0;
+
+        if (WeaveKeyId::IsAppEpochKey(mKeyIndex[i]) || WeaveKeyId::IsAppGroupMasterKey(mKeyIndex[i]))
+        {
+            err = RetrieveGroupKey(mKeyIndex[i], key);
+            SuccessOrExit(err);
+
+            mKeyInfo[i] = key.StartTime;
+        }
+    }
+
+    mKeyInfoLoaded = true;
+
 exit:
+    ClearSecretData(key.Key, sizeof(key.Key));
     return err;
 }
 
@@ -222,6 +311,7 @@ WEAVE_ERROR GroupKeyStoreImpl::AddKeyToIndex(uint32_t keyId, bool & indexUpdated
 
     VerifyOrExit(mNumKeys < kMaxGroupKeys, err = WEAVE_ERROR_TOO_MANY_KEYS);
 
+    mKeyInfo[mNumKeys] = 0;
     mKeyIndex[mNumKeys++] = keyId;
     indexUpdated = true;
 
@@ -296,6 +386,7 @@ WEAVE_ERROR GroupKeyStoreImpl::DeleteKeyOrKeys(uint32_t targetKeyId, uint32_t ta
             mNumKeys--;
 
             memmove(&mKeyIndex[i], &mKeyIndex[i+1], (mNumKeys - i) * sizeof(uint32_t));
+            memmove(&mKeyInfo[i], &mKeyInfo[i+1], (mNumKeys - i) * sizeof(uint32_t));
         }
         else
         {
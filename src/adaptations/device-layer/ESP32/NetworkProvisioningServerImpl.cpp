@@ -46,6 +46,10 @@ NetworkProvisioningServerImpl NetworkProvisioningServerImpl::sInstance;
 
 WEAVE_ERROR NetworkProvisioningServerImpl::_Init(void)
 {
+    mScanResultsTime = 0;
+    mScanResultCount = 0;
+    mScanChannel = 0;
+
     return GenericNetworkProvisioningServerImpl<NetworkProvisioningServerImpl>::DoInit();
 }
 
@@ -213,8 +217,29 @@ WEAVE_ERROR NetworkProvisioningServerImpl::InitiateWiFiScan(void)
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     wifi_scan_config_t scanConfig;
 
+#if WEAVE_DEVICE_CONFIG_WIFI_STREAMING_SCAN_MAX_CHANNEL
+    // If the client of a new ScanNetworks request accepts streamed results, scan one channel at a time,
+    // sending the results of each channel as soon as it is done.  Give the client the results of the
+    // last scan while it waits for the first channel, provided they are still fresh.
+    if (mScanChannel == 0 && IsStreamingScanResults())
+    {
+#if WEAVE_DEVICE_CONFIG_WIFI_SCAN_CACHE_LIFETIME
+        if (mScanResultCount > 0 &&
+            System::Layer::GetClock_MonotonicMS() - mScanResultsTime < WEAVE_DEVICE_CONFIG_WIFI_SCAN_CACHE_LIFETIME)
+        {
+            err = SendScanResults(0, mScanResultCount, false);
+            SuccessOrExit(err);
+        }
+#endif // WEAVE_DEVICE_CONFIG_WIFI_SCAN_CACHE_LIFETIME
+
+        mScanResultCount = 0;
+        mScanChannel = 1;
+    }
+#endif // WEAVE_DEVICE_CONFIG_WIFI_STREAMING_SCAN_MAX_CHANNEL
+
     // Initiate an active scan using the default dwell times.  Configure the scan to return hidden networks.
     memset(&scanConfig, 0, sizeof(scanConfig));
+    scanConfig.channel = mScanChannel;
     scanConfig.show_hidden = 1;
     scanConfig.scan_type = WIFI_SCAN_TYPE_ACTIVE;
     err = esp_wifi_scan_start(&scanConfig, false);
@@ -226,6 +251,10 @@ WEAVE_ERROR NetworkProvisioningServerImpl::InitiateWiFiScan(void)
 #endif // WEAVE_DEVICE_CONFIG_WIFI_SCAN_COMPLETION_TIMEOUT
 
 exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        mScanChannel = 0;
+    }
     return err;
 }
 
@@ -234,8 +263,8 @@ void NetworkProvisioningServerImpl::HandleScanDone()
     WEAVE_ERROR err;
     wifi_ap_record_t * scanResults = NULL;
     uint16_t scanResultCount;
-    uint16_t encodedResultCount;
-    PacketBuffer * respBuf = NULL;
+    uint8_t first;
+    bool scanDone = true;
 
     // If we receive a SCAN DONE event for a scan that we didn't initiate, simply ignore it.
     VerifyOrExit(mState == kState_ScanNetworks_InProgress, err = WEAVE_NO_ERROR);
@@ -247,15 +276,19 @@ void NetworkProvisioningServerImpl::HandleScanDone()
     SystemLayer.CancelTimer(HandleScanTimeOut, NULL);
 #endif // WEAVE_DEVICE_CONFIG_WIFI_SCAN_COMPLETION_TIMEOUT
 
+    // The results of a streamed scan accumulate across channels; those of an all-channel scan replace
+    // the previous ones.
+    first = (mScanChannel != 0) ? mScanResultCount : 0;
+
     // Determine the number of scan results found.
     err = esp_wifi_scan_get_ap_num(&scanResultCount);
     SuccessOrExit(err);
 
-    // Only return up to WEAVE_DEVICE_CONFIG_MAX_SCAN_NETWORKS_RESULTS.
-    scanResultCount = min(scanResultCount, (uint16_t)WEAVE_DEVICE_CONFIG_MAX_SCAN_NETWORKS_RESULTS);
+    // Only return up to WEAVE_DEVICE_CONFIG_MAX_SCAN_NETWORKS_RESULTS in total.
+    scanResultCount = min(scanResultCount, (uint16_t)(WEAVE_DEVICE_CONFIG_MAX_SCAN_NETWORKS_RESULTS - first));
 
     // Allocate a buffer to hold the scan results array.
-    scanResults = (wifi_ap_record_t *)malloc(scanResultCount * sizeof(wifi_ap_record_t));
+    scanResults = (wifi_ap_record_t *)malloc(max(scanResultCount, (uint16_t)1) * sizeof(wifi_ap_record_t));
     VerifyOrExit(scanResults != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     // Collect the scan results from the ESP WiFi driver.  Note that this also *frees*
@@ -263,74 +296,140 @@ void NetworkProvisioningServerImpl::HandleScanDone()
     err = esp_wifi_scan_get_ap_records(&scanResultCount, scanResults);
     SuccessOrExit(err);
 
+    // Sort results by rssi.
+    qsort(scanResults, scanResultCount, sizeof(*scanResults), ESP32Utils::OrderScanResultsByRSSI);
+
+    // Save the results, both for the response and for streamed scans that follow shortly.
+    for (uint16_t i = 0; i < scanResultCount; i++)
+    {
+        ScanResult & result = mScanResults[first + i];
+
+        memcpy(result.SSID, scanResults[i].ssid, min(strlen((char *)scanResults[i].ssid) + 1, sizeof(result.SSID)));
+        result.SSID[DeviceNetworkInfo::kMaxWiFiSSIDLength] = 0;
+        result.RSSI = scanResults[i].rssi;
+        result.AuthMode = scanResults[i].authmode;
+    }
+    mScanResultCount = first + scanResultCount;
+    mScanResultsTime = System::Layer::GetClock_MonotonicMS();
+
     // If the ScanNetworks request is still outstanding...
     if (GetCurrentOp() == kMsgType_ScanNetworks)
     {
-        nl::Weave::TLV::TLVWriter writer;
-        TLVType outerContainerType;
+        // During a streamed scan, send the networks found on this channel and move on to the next.
+        if (mScanChannel != 0 && mScanChannel < WEAVE_DEVICE_CONFIG_WIFI_STREAMING_SCAN_MAX_CHANNEL)
+        {
+            if (scanResultCount > 0)
+            {
+                err = SendScanResults(first, scanResultCount, false);
+                SuccessOrExit(err);
+            }
 
-        // Sort results by rssi.
-        qsort(scanResults, scanResultCount, sizeof(*scanResults), ESP32Utils::OrderScanResultsByRSSI);
+            mScanChannel++;
+            mState = kState_ScanNetworks_InProgress;
 
-        // Allocate a packet buffer to hold the encoded scan results.
-        respBuf = PacketBuffer::New(WEAVE_SYSTEM_CONFIG_HEADER_RESERVE_SIZE + 1);
-        VerifyOrExit(respBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+            err = InitiateWiFiScan();
+            if (err != WEAVE_NO_ERROR)
+            {
+                mState = kState_Idle;
+            }
+            SuccessOrExit(err);
 
-        // Encode the list of scan results into the response buffer.  If the encoded size of all
-        // the results exceeds the size of the buffer, encode only what will fit.
-        writer.Init(respBuf, respBuf->AvailableDataLength() - 1);
-        err = writer.StartContainer(AnonymousTag, kTLVType_Array, outerContainerType);
+            ExitNow(scanDone = false);
+        }
+
+        // Otherwise send the remaining results to the requestor, completing the request.
+        err = SendScanResults(first, scanResultCount, true);
         SuccessOrExit(err);
-        for (encodedResultCount = 0; encodedResultCount < scanResultCount; encodedResultCount++)
+    }
+
+exit:
+    free(scanResults);
+
+    if (scanDone)
+    {
+        mScanChannel = 0;
+
+        // If an error occurred and we haven't yet responded, send a Internal Error back to the
+        // requestor.
+        if (err != WEAVE_NO_ERROR && GetCurrentOp() == kMsgType_ScanNetworks)
         {
-            NetworkInfo netInfo;
-            const wifi_ap_record_t & scanResult = scanResults[encodedResultCount];
-
-            netInfo.Reset();
-            netInfo.NetworkType = kNetworkType_WiFi;
-            memcpy(netInfo.WiFiSSID, scanResult.ssid, min(strlen((char *)scanResult.ssid) + 1, (size_t)NetworkInfo::kMaxWiFiSSIDLength));
-            netInfo.WiFiSSID[NetworkInfo::kMaxWiFiSSIDLength] = 0;
-            netInfo.WiFiMode = kWiFiMode_Managed;
-            netInfo.WiFiRole = kWiFiRole_Station;
-            netInfo.WiFiSecurityType = ESP32Utils::WiFiAuthModeToWeaveWiFiSecurityType(scanResult.authmode);
-            netInfo.WirelessSignalStrength = scanResult.rssi;
+            SendStatusReport(kWeaveProfile_Common, kStatus_InternalError, err);
+        }
+
+        // Tell the ConnectivityManager that the WiFi scan is now done.  This allows it to continue
+        // any activities that were deferred while the scan was in progress.
+        ConnectivityMgr().OnWiFiScanDone();
+    }
+}
 
+/**
+ * Send saved scan results to the client of the outstanding ScanNetworks request.
+ *
+ * Results are sent in a NetworkScanResults message, which leaves the request outstanding, or, if \c final is
+ * set, in the NetworkScanComplete message that completes it.  If the encoded results exceed the size of a
+ * buffer, only those that fit are sent.
+ */
+WEAVE_ERROR NetworkProvisioningServerImpl::SendScanResults(uint8_t first, uint8_t count, bool final)
+{
+    WEAVE_ERROR err;
+    PacketBuffer * respBuf = NULL;
+    nl::Weave::TLV::TLVWriter writer;
+    TLVType outerContainerType;
+    uint8_t encodedResultCount;
+
+    // Allocate a packet buffer to hold the encoded scan results.
+    respBuf = PacketBuffer::New(WEAVE_SYSTEM_CONFIG_HEADER_RESERVE_SIZE + 1);
+    VerifyOrExit(respBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    // Encode the list of scan results into the response buffer.  If the encoded size of all
+    // the results exceeds the size of the buffer, encode only what will fit.
+    writer.Init(respBuf, respBuf->AvailableDataLength() - 1);
+    err = writer.StartContainer(AnonymousTag, kTLVType_Array, outerContainerType);
+    SuccessOrExit(err);
+    for (encodedResultCount = 0; encodedResultCount < count; encodedResultCount++)
+    {
+        NetworkInfo netInfo;
+        const ScanResult & scanResult = mScanResults[first + encodedResultCount];
+
+        netInfo.Reset();
+        netInfo.NetworkType = kNetworkType_WiFi;
+        memcpy(netInfo.WiFiSSID, scanResult.SSID, sizeof(scanResult.SSID));
+        netInfo.WiFiMode = kWiFiMode_Managed;
+        netInfo.WiFiRole = kWiFiRole_Station;
+        netInfo.WiFiSecurityType = ESP32Utils::WiFiAuthModeToWeaveWiFiSecurityType((wifi_auth_mode_t)scanResult.AuthMode);
+        netInfo.WirelessSignalStrength = scanResult.RSSI;
+
+        {
+            nl::Weave::TLV::TLVWriter savePoint = writer;
+            err = netInfo.Encode(writer);
+            if (err == WEAVE_ERROR_BUFFER_TOO_SMALL)
             {
-                nl::Weave::TLV::TLVWriter savePoint = writer;
-                err = netInfo.Encode(writer);
-                if (err == WEAVE_ERROR_BUFFER_TOO_SMALL)
-                {
-                    writer = savePoint;
-                    break;
-                }
+                writer = savePoint;
+                break;
             }
-            SuccessOrExit(err);
         }
-        err = writer.EndContainer(outerContainerType);
-        SuccessOrExit(err);
-        err = writer.Finalize();
         SuccessOrExit(err);
+    }
+    err = writer.EndContainer(outerContainerType);
+    SuccessOrExit(err);
+    err = writer.Finalize();
+    SuccessOrExit(err);
 
-        // Send the scan results to the requestor.  Note that this method takes ownership of the
-        // buffer, success or fail.
+    // Send the scan results to the requestor.  Note that these methods take ownership of the
+    // buffer, success or fail.
+    if (final)
+    {
         err = SendNetworkScanComplete(encodedResultCount, respBuf);
-        respBuf = NULL;
-        SuccessOrExit(err);
     }
-
-exit:
-    PacketBuffer::Free(respBuf);
-
-    // If an error occurred and we haven't yet responded, send a Internal Error back to the
-    // requestor.
-    if (err != WEAVE_NO_ERROR && GetCurrentOp() == kMsgType_ScanNetworks)
+    else
     {
-        SendStatusReport(kWeaveProfile_Common, kStatus_InternalError, err);
+        err = SendNetworkScanResults(encodedResultCount, respBuf);
     }
+    respBuf = NULL;
 
-    // Tell the ConnectivityManager that the WiFi scan is now done.  This allows it to continue
-    // any activities that were deferred while the scan was in progress.
-    ConnectivityMgr().OnWiFiScanDone();
+exit:
+    PacketBuffer::Free(respBuf);
+    return err;
 }
 
 #if WEAVE_DEVICE_CONFIG_WIFI_SCAN_COMPLETION_TIMEOUT
@@ -341,6 +440,7 @@ void NetworkProvisioningServerImpl::HandleScanTimeOut(::nl::Weave::System::Layer
 
     // Reset the state.
     sInstance.mState = kState_Idle;
+    sInstance.mScanChannel = 0;
 
     // Verify that the ScanNetworks request is still outstanding; if so, send a
     // Common:InternalError StatusReport to the client.
@@ -167,6 +167,15 @@ exit:
 
 
 #if WEAVE_DEVICE_CONFIG_ENABLE_TUNNEL_TELEMETRY
+TunnelTelemetry::TunnelTelemetry(void)
+{
+    mLastPollTime = 0;
+    mLastTxBytes = 0;
+    mLastRxBytes = 0;
+    mLastTxMessages = 0;
+    mLastRxMessages = 0;
+}
+
 void TunnelTelemetry::GetTelemetryStatsAndLogEvent(void)
 {
     if (ConnectivityMgr().GetServiceTunnelMode() == ConnectivityManager::kServiceTunnelMode_Enabled)
@@ -227,6 +236,45 @@ void TunnelTelemetry::GetTelemetryStatsAndLogEvent(void)
             break;
         }
 
+        // Sample the per-direction rates over the polling interval.
+        {
+            uint64_t now = nl::Weave::System::Layer::GetClock_MonotonicMS();
+            uint64_t elapsedMsec = now - mLastPollTime;
+
+            if (mLastPollTime != 0 && elapsedMsec != 0 &&
+                tunnelStats.mPrimaryStats.mTxBytesToService >= mLastTxBytes &&
+                tunnelStats.mPrimaryStats.mRxBytesFromService >= mLastRxBytes)
+            {
+                mTxBytesRate.Add(static_cast<int32_t>((tunnelStats.mPrimaryStats.mTxBytesToService - mLastTxBytes) * 1000 / elapsedMsec));
+                mRxBytesRate.Add(static_cast<int32_t>((tunnelStats.mPrimaryStats.mRxBytesFromService - mLastRxBytes) * 1000 / elapsedMsec));
+                mTxMessagesRate.Add(static_cast<int32_t>(static_cast<uint64_t>(tunnelStats.mPrimaryStats.mTxMessagesToService - mLastTxMessages) * 1000 / elapsedMsec));
+                mRxMessagesRate.Add(static_cast<int32_t>(static_cast<uint64_t>(tunnelStats.mPrimaryStats.mRxMessagesFromService - mLastRxMessages) * 1000 / elapsedMsec));
+            }
+
+            mLastPollTime = now;
+            mLastTxBytes = tunnelStats.mPrimaryStats.mTxBytesToService;
+            mLastRxBytes = tunnelStats.mPrimaryStats.mRxBytesFromService;
+            mLastTxMessages = tunnelStats.mPrimaryStats.mTxMessagesToService;
+            mLastRxMessages = tunnelStats.mPrimaryStats.mRxMessagesFromService;
+        }
+
+        mQueuedPackets.Add(tunnelStats.mQueuedPacketsCount);
+
+        // Only log an event when the tunnel has seen traffic or changed state since the last one.
+        mChangeFilter.BeginSample();
+        mChangeFilter.AddMetric(statsEvent.txBytesToService);
+        mChangeFilter.AddMetric(statsEvent.rxBytesFromService);
+        mChangeFilter.AddMetric(statsEvent.txMessagesToService);
+        mChangeFilter.AddMetric(statsEvent.rxMessagesFromService);
+        mChangeFilter.AddMetric(statsEvent.tunnelDownCount);
+        mChangeFilter.AddMetric(statsEvent.tunnelConnAttemptCount);
+        mChangeFilter.AddMetric(statsEvent.lastTimeTunnelWentDown);
+        mChangeFilter.AddMetric(statsEvent.lastTimeTunnelEstablished);
+        mChangeFilter.AddMetric(statsEvent.droppedMessagesCount);
+        mChangeFilter.AddMetric(statsEvent.currentTunnelState);
+        mChangeFilter.AddMetric(statsEvent.currentActiveTunnel);
+        VerifyOrExit(mChangeFilter.ShouldLog(), );
+
         WeaveLogProgress(DeviceLayer,
                          "Weave Tunnel Counters\n"
                          "Tx Messages:                   %d\n"
@@ -244,10 +292,61 @@ void TunnelTelemetry::GetTelemetryStatsAndLogEvent(void)
                          "LastTime TunnelEstablished:    %" PRIu64 "\n",
                          statsEvent.lastTimeTunnelWentDown, statsEvent.lastTimeTunnelEstablished);
 
+        // Summarize the rates sampled since the last logged event.
+        if (mTxBytesRate.Count() != 0)
+        {
+            WeaveLogProgress(DeviceLayer,
+                             "Weave Tunnel Rates over %" PRIu32 " samples (min/avg/max)\n"
+                             "Tx Bytes/sec:                  %" PRId32 "/%" PRId32 "/%" PRId32 "\n"
+                             "Rx Bytes/sec:                  %" PRId32 "/%" PRId32 "/%" PRId32 "\n"
+                             "Tx Messages/sec:               %" PRId32 "/%" PRId32 "/%" PRId32 "\n"
+                             "Rx Messages/sec:               %" PRId32 "/%" PRId32 "/%" PRId32 "\n",
+                             mTxBytesRate.Count(),
+                             mTxBytesRate.Min(), mTxBytesRate.Average(), mTxBytesRate.Max(),
+                             mRxBytesRate.Min(), mRxBytesRate.Average(), mRxBytesRate.Max(),
+                             mTxMessagesRate.Min(), mTxMessagesRate.Average(), mTxMessagesRate.Max(),
+                             mRxMessagesRate.Min(), mRxMessagesRate.Average(), mRxMessagesRate.Max());
+        }
+
+        WeaveLogProgress(DeviceLayer, "Weave Tunnel Queued Packets (min/avg/max): %" PRId32 "/%" PRId32 "/%" PRId32,
+                         mQueuedPackets.Min(), mQueuedPackets.Average(), mQueuedPackets.Max());
+
+        mTxBytesRate.Reset();
+        mRxBytesRate.Reset();
+        mTxMessagesRate.Reset();
+        mRxMessagesRate.Reset();
+        mQueuedPackets.Reset();
+
+        WeaveLogProgress(DeviceLayer,
+                         "Weave Tunnel Latencies\n"
+                         "Last Connect (TCP+CASE) ms:    %" PRIu32 "\n"
+                         "Last TunnelOpen ms:            %" PRIu32 "\n"
+                         "Queued Packets (now/peak):     %u/%u\n"
+                         "Queued Bytes:                  %" PRIu32 "\n",
+                         tunnelStats.mPrimaryStats.mLastConnectLatencyMsec, tunnelStats.mPrimaryStats.mLastTunnelOpenLatencyMsec,
+                         tunnelStats.mQueuedPacketsCount, tunnelStats.mPeakQueuedPacketsCount, tunnelStats.mQueuedBytes);
+
+        for (int i = 0; i < WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS; i++)
+        {
+            if (i < WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS - 1)
+            {
+                WeaveLogProgress(DeviceLayer, "Queue Delay < %5" PRIu32 " ms:       %" PRIu32,
+                                 static_cast<uint32_t>(WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BASE_MSEC) << i,
+                                 tunnelStats.mQueueDelayHistogram[i]);
+            }
+            else
+            {
+                WeaveLogProgress(DeviceLayer, "Queue Delay >= %5" PRIu32 " ms:      %" PRIu32,
+                                 static_cast<uint32_t>(WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BASE_MSEC) << (i - 1),
+                                 tunnelStats.mQueueDelayHistogram[i]);
+            }
+        }
+
         eventId = nl::LogEvent(&statsEvent);
         WeaveLogProgress(DeviceLayer, "Weave Tunnel Tolopoly Stats Event Id: %u\n", eventId);
     }
 
+exit:
     return;
 }
 #endif // WEAVE_DEVICE_CONFIG_ENABLE_TUNNEL_TELEMETRY
@@ -45,6 +45,9 @@ WEAVE_ERROR ServiceProvisioningServer::Init(void)
 
     mProvServiceBinding = NULL;
     mWaitingForServiceConnectivity = false;
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+    mPendingPairingBuf = NULL;
+#endif
 
 exit:
     return err;
@@ -93,9 +96,28 @@ WEAVE_ERROR ServiceProvisioningServer::HandleRegisterServicePairAccount(Register
 
 #if !WEAVE_DEVICE_CONFIG_DISABLE_ACCOUNT_PAIRING
 
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
+    // Hold on to the request, whose fields refer to its message buffer, so that pairing can
+    // continue once the client has been answered.
+    mPendingPairingMsg = msg;
+    mPendingPairingBuf = mCurClientOpBuf;
+    mPendingPairingBuf->AddRef();
+
+#endif // WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
     // Initiate the process of sending a PairDeviceToAccount request to the Service Provisioning service.
     PlatformMgr().ScheduleWork(AsyncStartPairDeviceToAccount);
 
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
+    // Now that the service configuration has been stored, answer the client without waiting for
+    // the service.  The outcome of pairing is reported later with a kAccountPairingResult event.
+    err = SendSuccessResponse();
+    SuccessOrExit(err);
+
+#endif // WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
 #else // !WEAVE_DEVICE_CONFIG_DISABLE_ACCOUNT_PAIRING
 
     // Store the account id in persistent storage.
@@ -179,6 +201,24 @@ WEAVE_ERROR ServiceProvisioningServer::HandleUnregisterService(uint64_t serviceI
     err = ConfigurationMgr().ClearServiceProvisioningData();
     SuccessOrExit(err);
 
+#if !WEAVE_DEVICE_CONFIG_DISABLE_ACCOUNT_PAIRING && WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
+    // Abandon any pairing with the service that is still in progress.
+    if (IsPairingPending())
+    {
+        if (mProvServiceBinding != NULL)
+        {
+            mProvServiceBinding->Close();
+            mProvServiceBinding = NULL;
+        }
+        mWaitingForServiceConnectivity = false;
+        SystemLayer.CancelTimer(HandleServiceConnectivityTimeout, NULL);
+
+        EndPendingPairing();
+    }
+
+#endif // !WEAVE_DEVICE_CONFIG_DISABLE_ACCOUNT_PAIRING && WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
     // Send "Success" back to the requestor.
     err = sInstance.SendSuccessResponse();
     SuccessOrExit(err);
@@ -205,7 +245,7 @@ void ServiceProvisioningServer::OnPlatformEvent(const WeaveDeviceEvent * event)
     {
         // If a RegisterServicePairAccount request is pending and the system is waiting for
         // the service connectivity to be established, initiate the PairDeviceToAccount request now.
-        if (mCurClientOp != NULL && mWaitingForServiceConnectivity)
+        if (IsPairingPending() && mWaitingForServiceConnectivity)
         {
             StartPairDeviceToAccount();
         }
@@ -220,6 +260,11 @@ void ServiceProvisioningServer::StartPairDeviceToAccount(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+    // Do nothing if the pairing was abandoned before it could start.
+    VerifyOrExit(IsPairingPending(), /* no-op */);
+#endif // WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
     // If the system does not currently have a tunnel established with the service,
     // AND the system does not have service connectivity by some other means (e.g. Thread)
     // wait a period of time for connectivity to be established.
@@ -263,7 +308,7 @@ exit:
 void ServiceProvisioningServer::SendPairDeviceToAccountRequest(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    const RegisterServicePairAccountMessage & regServiceMsg = mCurClientOpMsg.RegisterServicePairAccount;
+    const RegisterServicePairAccountMessage & regServiceMsg = GetPairingRequest();
     uint8_t devDesc[100]; // TODO: make configurable
     size_t devDescLen;
 
@@ -304,20 +349,32 @@ void ServiceProvisioningServer::HandlePairDeviceToAccountResult(WEAVE_ERROR err,
         mProvServiceBinding = NULL;
     }
 
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
+    // Ignore the result if the pairing was abandoned when the service was unregistered.
+    if (!IsPairingPending())
+    {
+        return;
+    }
+
+#else // WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
     // Return immediately if for some reason the client's RegisterServicePairAccount request
     // is no longer pending.  Note that, even if the PairDeviceToAccount request succeeded,
     // the device must clear the persisted service configuration in this case because it has
     // lost access to the account id (which was in the RegisterServicePairAccount message)
     // and therefore cannot complete the process of registering the service.
-    if (mCurClientOp == NULL)
+    if (!IsPairingPending())
     {
         ExitNow(err = WEAVE_ERROR_INCORRECT_STATE);
     }
 
+#endif // WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
     // If the PairDeviceToAccount request was successful...
     if (err == WEAVE_NO_ERROR)
     {
-        const RegisterServicePairAccountMessage & regServiceMsg = mCurClientOpMsg.RegisterServicePairAccount;
+        const RegisterServicePairAccountMessage & regServiceMsg = GetPairingRequest();
 
         // Store the account id in persistent storage.  This is the final step of registering a
         // service and marks that the device is properly associated with a user's account.
@@ -334,9 +391,13 @@ void ServiceProvisioningServer::HandlePairDeviceToAccountResult(WEAVE_ERROR err,
 
         WeaveLogProgress(DeviceLayer, "PairDeviceToAccount request completed successfully");
 
+#if !WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
         // Send a success StatusReport back to the client.
         err = SendSuccessResponse();
         SuccessOrExit(err);
+
+#endif // !WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
     }
 
 exit:
@@ -367,13 +428,61 @@ exit:
             }
         }
 
+#if !WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
         // Send an error StatusReport back to the client.  Only include the local error code if it isn't
         // WEAVE_ERROR_STATUS_REPORT_RECEIVED.
         SendStatusReport(statusReportProfileId, statusReportStatusCode,
                 (err != WEAVE_ERROR_STATUS_REPORT_RECEIVED) ? err : WEAVE_NO_ERROR);
+
+#endif // !WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
     }
+
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
+    // The client has already been answered, so post an event reporting the outcome of the pairing.
+    {
+        WeaveDeviceEvent event;
+        event.Type = DeviceEventType::kAccountPairingResult;
+        event.AccountPairingResult.Error = err;
+        event.AccountPairingResult.StatusReportProfileId = statusReportProfileId;
+        event.AccountPairingResult.StatusReportStatusCode = statusReportStatusCode;
+        PlatformMgr().PostEvent(&event);
+    }
+
+    EndPendingPairing();
+
+#endif // WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
 }
 
+bool ServiceProvisioningServer::IsPairingPending(void) const
+{
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+    return mPendingPairingBuf != NULL;
+#else
+    return mCurClientOp != NULL;
+#endif
+}
+
+const RegisterServicePairAccountMessage & ServiceProvisioningServer::GetPairingRequest(void) const
+{
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+    return mPendingPairingMsg;
+#else
+    return mCurClientOpMsg.RegisterServicePairAccount;
+#endif
+}
+
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
+void ServiceProvisioningServer::EndPendingPairing(void)
+{
+    PacketBuffer::Free(mPendingPairingBuf);
+    mPendingPairingBuf = NULL;
+}
+
+#endif // WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+
 void ServiceProvisioningServer::AsyncStartPairDeviceToAccount(intptr_t arg)
 {
     sInstance.StartPairDeviceToAccount();
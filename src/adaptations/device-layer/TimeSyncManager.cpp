@@ -44,6 +44,17 @@ namespace DeviceLayer {
 
 namespace {
 
+enum
+{
+    // Minimum time between two clock updates for their offset to be used as a drift sample.
+    // Over shorter spans, the error of the time sync itself dominates the measured offset.
+    kMinDriftSampleSpanMS   = 60 * kMillisecondPerSecond,
+
+    // Offsets implying a larger drift than this are taken to mean that the real time clock
+    // was changed by other means, rather than having drifted.
+    kMaxPlausibleDriftPPM   = 500,
+};
+
 #if WEAVE_DEVICE_CONFIG_ENABLE_WEAVE_TIME_SERVICE_TIME_SYNC
 SingleSourceTimeSyncClient TimeSyncClient;
 #endif
@@ -74,6 +85,7 @@ exit:
 void TimeSyncManager::SetSyncInterval(uint32_t intervalSec)
 {
     mSyncIntervalSec = intervalSec;
+    mCurSyncIntervalSec = intervalSec;
     DriveTimeSync();
 }
 
@@ -91,6 +103,10 @@ WEAVE_ERROR TimeSyncManager::Init()
     mServiceDirTimeSyncStartUS = 0;
 #endif // WEAVE_DEVICE_CONFIG_ENABLE_SERVICE_DIRECTORY_TIME_SYNC
 
+    mLastClockSetTimeMS = 0;
+    mClockDriftPPM = 0;
+    mClockDriftValid = false;
+
 #if WEAVE_DEVICE_CONFIG_ENABLE_WEAVE_TIME_SERVICE_TIME_SYNC
     new (&TimeSyncClient) SingleSourceTimeSyncClient();
 
@@ -99,6 +115,7 @@ WEAVE_ERROR TimeSyncManager::Init()
 
     mLastSyncTimeMS = 0;
     mSyncIntervalSec = WEAVE_DEVICE_CONFIG_DEFAULT_TIME_SYNC_INTERVAL;
+    mCurSyncIntervalSec = mSyncIntervalSec;
     mTimeSyncBinding = NULL;
 #endif // WEAVE_DEVICE_CONFIG_ENABLE_WEAVE_TIME_SERVICE_TIME_SYNC
 
@@ -179,7 +196,7 @@ void TimeSyncManager::DriveTimeSync()
         uint64_t timeToNextSyncMS = 0;
         if (mLastSyncTimeMS != 0)
         {
-            uint64_t nextSyncTimeMS = mLastSyncTimeMS + (mSyncIntervalSec * 1000);
+            uint64_t nextSyncTimeMS = mLastSyncTimeMS + ((uint64_t)mCurSyncIntervalSec * 1000);
             uint64_t nowMS = System::Layer::GetClock_MonotonicMS();
             if (nowMS < nextSyncTimeMS)
             {
@@ -244,16 +261,25 @@ void TimeSyncManager::CancelTimeSync()
 void TimeSyncManager::ApplySynchronizedTime(uint64_t syncedRealTimeUS)
 {
     WEAVE_ERROR err;
+    uint64_t nowMS = System::Layer::GetClock_MonotonicMS();
 
     // Only change the system clock if the final time value is valid...
     if (syncedRealTimeUS > (((uint64_t)WEAVE_SYSTEM_CONFIG_VALID_REAL_TIME_THRESHOLD) * kMicrosecondsPerSecond))
     {
         bool wasSynchronized = sInstance.IsTimeSynchronized();
 
+        // Before correcting the clock, measure how far it has drifted since it was last set.
+        if (wasSynchronized)
+        {
+            UpdateClockDriftEstimate(syncedRealTimeUS, nowMS);
+        }
+
         // Attempt to set the system's real time clock.  If successful...
         err = System::Layer::SetClock_RealTime(syncedRealTimeUS);
         if (err == WEAVE_NO_ERROR)
         {
+            mLastClockSetTimeMS = nowMS;
+
             // If this is the first point at which time is synchronized, post a Time Sync change event.
             if (!wasSynchronized)
             {
@@ -269,8 +295,87 @@ void TimeSyncManager::ApplySynchronizedTime(uint64_t syncedRealTimeUS)
         }
     }
 
+    // Adjust the sync interval to the current drift estimate.
+    UpdateSyncInterval();
+
     // Update the time from which the next sync interval should be counted.
-    sInstance.mLastSyncTimeMS = System::Layer::GetClock_MonotonicMS();
+    sInstance.mLastSyncTimeMS = nowMS;
+}
+
+/**
+ * Estimate the drift rate of the real time clock from the offset between a newly synchronized
+ * time and the local clock, accumulated since the clock was last set.
+ */
+void TimeSyncManager::UpdateClockDriftEstimate(uint64_t syncedRealTimeUS, uint64_t nowMS)
+{
+    uint64_t localRealTimeUS;
+    uint64_t elapsedMS = nowMS - mLastClockSetTimeMS;
+    int64_t offsetUS;
+    uint64_t absOffsetUS;
+    int32_t sampleDriftPPM;
+
+    VerifyOrExit(mLastClockSetTimeMS != 0 && elapsedMS >= kMinDriftSampleSpanMS, /* no-op */);
+    VerifyOrExit(System::Layer::GetClock_RealTime(localRealTimeUS) == WEAVE_NO_ERROR, /* no-op */);
+
+    offsetUS = (int64_t)(syncedRealTimeUS - localRealTimeUS);
+    absOffsetUS = (offsetUS < 0) ? (uint64_t)-offsetUS : (uint64_t)offsetUS;
+
+    // Discard offsets too large to be the result of drift.  (ppm = us of offset per s elapsed)
+    VerifyOrExit(absOffsetUS <= (elapsedMS * kMaxPlausibleDriftPPM) / kMillisecondPerSecond, /* no-op */);
+
+    sampleDriftPPM = (int32_t)((offsetUS * (int64_t)kMillisecondPerSecond) / (int64_t)elapsedMS);
+
+    // Smooth the estimate, as each sample includes the error of the time syncs that bound it.
+    mClockDriftPPM = (mClockDriftValid) ? (3 * mClockDriftPPM + sampleDriftPPM) / 4 : sampleDriftPPM;
+    mClockDriftValid = true;
+
+    WeaveLogDetail(DeviceLayer, "Clock offset %" PRId32 " ms after %" PRIu32 " s; estimated drift %" PRId32 " ppm",
+            (int32_t)(offsetUS / 1000), (uint32_t)(elapsedMS / kMillisecondPerSecond), mClockDriftPPM);
+
+exit:
+    return;
+}
+
+/**
+ * Set the interval until the next time sync so that the drift of the clock over the interval
+ * stays within the configured tolerance, bounded by the configured and maximum sync intervals.
+ */
+void TimeSyncManager::UpdateSyncInterval(void)
+{
+#if WEAVE_DEVICE_CONFIG_ENABLE_WEAVE_TIME_SERVICE_TIME_SYNC
+
+    uint64_t intervalSec = mSyncIntervalSec;
+
+    if (mClockDriftValid && WEAVE_DEVICE_CONFIG_MAX_TIME_SYNC_INTERVAL > mSyncIntervalSec)
+    {
+        uint32_t absDriftPPM = (mClockDriftPPM < 0) ? -mClockDriftPPM : mClockDriftPPM;
+
+        // The time (in seconds) for the clock to drift by the tolerated error.
+        intervalSec = ((uint64_t)WEAVE_DEVICE_CONFIG_TIME_SYNC_DRIFT_TOLERANCE * kMillisecondPerSecond) / ((absDriftPPM != 0) ? absDriftPPM : 1);
+
+        // Lengthen the interval by at most a factor of two at each sync, so that it only grows
+        // long once several samples have confirmed the drift estimate.
+        if (intervalSec > 2 * (uint64_t)mCurSyncIntervalSec)
+        {
+            intervalSec = 2 * (uint64_t)mCurSyncIntervalSec;
+        }
+        if (intervalSec > WEAVE_DEVICE_CONFIG_MAX_TIME_SYNC_INTERVAL)
+        {
+            intervalSec = WEAVE_DEVICE_CONFIG_MAX_TIME_SYNC_INTERVAL;
+        }
+        if (intervalSec < mSyncIntervalSec)
+        {
+            intervalSec = mSyncIntervalSec;
+        }
+    }
+
+    if (intervalSec != mCurSyncIntervalSec)
+    {
+        WeaveLogProgress(DeviceLayer, "Time sync interval now %" PRIu32 " s", (uint32_t)intervalSec);
+        mCurSyncIntervalSec = (uint32_t)intervalSec;
+    }
+
+#endif // WEAVE_DEVICE_CONFIG_ENABLE_WEAVE_TIME_SERVICE_TIME_SYNC
 }
 
 void TimeSyncManager::TimeSyncFailed(WEAVE_ERROR reason, Profiles::StatusReporting::StatusReport * statusReport)
@@ -283,6 +388,9 @@ void TimeSyncManager::TimeSyncFailed(WEAVE_ERROR reason, Profiles::StatusReporti
     // Clear the current state
     CancelTimeSync();
 
+    // Retry at the configured interval, as the clock keeps drifting while time is not synchronized.
+    sInstance.mCurSyncIntervalSec = sInstance.mSyncIntervalSec;
+
     // Update the time from which the next sync interval should be counted.
     sInstance.mLastSyncTimeMS = System::Layer::GetClock_MonotonicMS();
 
@@ -212,6 +212,20 @@ void TraitManager::OnPlatformEvent(const WeaveDeviceEvent* event)
     {
         // Update the service subscription state as needed.
         DriveServiceSubscriptionState(true);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+        // Let the event log flush policy know whether an offload would have to wait for the service.
+        if (LoggingManagement::GetInstance().IsValid())
+        {
+            LoggingManagement::GetInstance().SetOffloadLinkActive(ConnectivityMgr().HaveServiceConnectivity());
+        }
+#endif
+    }
+
+    // If the device has joined or left a fabric, publish the change to the fabric id.
+    else if (event->Type == DeviceEventType::kFabricMembershipChange)
+    {
+        DeviceIdTraitDataSource.OnFabricMembershipChange();
     }
 }
 
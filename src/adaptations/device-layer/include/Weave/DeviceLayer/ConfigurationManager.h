@@ -44,6 +44,7 @@ class ConfigurationManagerImpl;
 class TraitManager;
 namespace Internal {
 template<class> class GenericPlatformManagerImpl;
+template<class> class GenericSoftwareUpdateManagerImpl;
 class DeviceControlServer;
 class NetworkProvisioningServer;
 }
@@ -138,6 +139,7 @@ private:
 
     friend class ::nl::Weave::DeviceLayer::PlatformManagerImpl;
     template<class> friend class ::nl::Weave::DeviceLayer::Internal::GenericPlatformManagerImpl;
+    template<class> friend class ::nl::Weave::DeviceLayer::Internal::GenericSoftwareUpdateManagerImpl;
     friend class ::nl::Weave::DeviceLayer::TraitManager;
     friend class ::nl::Weave::DeviceLayer::Internal::DeviceControlServer;
     // Parentheses used to fix clang parsing issue with these declarations
@@ -152,6 +154,9 @@ private:
     bool CanFactoryReset();
     WEAVE_ERROR GetFailSafeArmed(bool & val);
     WEAVE_ERROR SetFailSafeArmed(bool val);
+    WEAVE_ERROR GetSoftwareUpdateProgress(uint8_t * buf, size_t bufSize, size_t & progressLen);
+    WEAVE_ERROR StoreSoftwareUpdateProgress(const uint8_t * progress, size_t progressLen);
+    WEAVE_ERROR ClearSoftwareUpdateProgress(void);
     WEAVE_ERROR ReadPersistedStorageValue(::nl::Weave::Platform::PersistedStorage::Key key, uint32_t & value);
     WEAVE_ERROR WritePersistedStorageValue(::nl::Weave::Platform::PersistedStorage::Key key, uint32_t value);
 #if WEAVE_DEVICE_CONFIG_ENABLE_JUST_IN_TIME_PROVISIONING
@@ -519,6 +524,21 @@ inline WEAVE_ERROR ConfigurationManager::SetFailSafeArmed(bool val)
     return static_cast<ImplClass*>(this)->_SetFailSafeArmed(val);
 }
 
+inline WEAVE_ERROR ConfigurationManager::GetSoftwareUpdateProgress(uint8_t * buf, size_t bufSize, size_t & progressLen)
+{
+    return static_cast<ImplClass*>(this)->_GetSoftwareUpdateProgress(buf, bufSize, progressLen);
+}
+
+inline WEAVE_ERROR ConfigurationManager::StoreSoftwareUpdateProgress(const uint8_t * progress, size_t progressLen)
+{
+    return static_cast<ImplClass*>(this)->_StoreSoftwareUpdateProgress(progress, progressLen);
+}
+
+inline WEAVE_ERROR ConfigurationManager::ClearSoftwareUpdateProgress(void)
+{
+    return static_cast<ImplClass*>(this)->_ClearSoftwareUpdateProgress();
+}
+
 #if WEAVE_DEVICE_CONFIG_ENABLE_JUST_IN_TIME_PROVISIONING
 
 inline bool ConfigurationManager::OperationalDeviceCredentialsProvisioned()
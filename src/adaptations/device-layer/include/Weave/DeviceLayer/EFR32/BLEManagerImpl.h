@@ -61,6 +61,7 @@ class BLEManagerImpl final : public BLEManager,
     WEAVE_ERROR          _GetDeviceName(char *buf, size_t bufSize);
     WEAVE_ERROR          _SetDeviceName(const char *deviceName);
     uint16_t             _NumConnections(void);
+    WEAVE_ERROR          _SetHighThroughputEnabled(BLE_CONNECTION_OBJECT conId, bool val);
     void                 _OnPlatformEvent(const WeaveDeviceEvent *event);
     ::nl::Ble::BleLayer *_GetBleLayer(void) const;
 
@@ -90,6 +91,7 @@ class BLEManagerImpl final : public BLEManager,
                               BLE_READ_REQUEST_CONTEXT requestContext,
                               const WeaveBleUUID *     svcId,
                               const WeaveBleUUID *     charId) override;
+    bool     RequestHighThroughput(BLE_CONNECTION_OBJECT conId, bool enable) override;
 
     // ===== Members that implement virtual methods on BleApplicationDelegate.
 
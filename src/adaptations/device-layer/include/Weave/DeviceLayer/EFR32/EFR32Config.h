@@ -101,12 +101,13 @@ public:
     static constexpr Key kConfigKey_GroupKeyBase = EFR32ConfigKey(kWeaveConfig_KeyBase, 0x0D);
     static constexpr Key kConfigKey_GroupKeyMax =
         EFR32ConfigKey(kWeaveConfig_KeyBase, 0x1C); // Allows 16 Group Keys to be created.
+    static constexpr Key kConfigKey_SoftwareUpdateProgress = EFR32ConfigKey(kWeaveConfig_KeyBase, 0x1D);
 
     // Set key id limits for each group.
     static constexpr Key kMinConfigKey_WeaveFactory = EFR32ConfigKey(kWeaveFactory_KeyBase, 0x00);
     static constexpr Key kMaxConfigKey_WeaveFactory = EFR32ConfigKey(kWeaveFactory_KeyBase, 0x06);
     static constexpr Key kMinConfigKey_WeaveConfig  = EFR32ConfigKey(kWeaveConfig_KeyBase, 0x00);
-    static constexpr Key kMaxConfigKey_WeaveConfig  = EFR32ConfigKey(kWeaveConfig_KeyBase, 0x1C);
+    static constexpr Key kMaxConfigKey_WeaveConfig  = EFR32ConfigKey(kWeaveConfig_KeyBase, 0x1D);
     static constexpr Key kMinConfigKey_WeaveCounter = EFR32ConfigKey(kWeaveCounter_KeyBase, 0x00);
     static constexpr Key kMaxConfigKey_WeaveCounter =
         EFR32ConfigKey(kWeaveCounter_KeyBase, 0x1F); // Allows 32 Counters to be created.
@@ -130,6 +131,10 @@ public:
     static WEAVE_ERROR ClearConfigValue(Key key);
     static bool        ConfigValueExists(Key key);
     static WEAVE_ERROR FactoryResetConfig(void);
+
+    // Write batching.  NVM3 commits each object as it is written, so there is nothing to coalesce.
+    static WEAVE_ERROR BeginWriteBatch(void) { return WEAVE_NO_ERROR; }
+    static WEAVE_ERROR CommitWriteBatch(void) { return WEAVE_NO_ERROR; }
     static bool        ValidConfigKey(Key key);
 
     static void RunConfigUnitTest(void);
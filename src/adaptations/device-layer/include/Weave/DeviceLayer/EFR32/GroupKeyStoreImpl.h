@@ -52,6 +52,8 @@ public:
                                    uint8_t   keyIdsArraySize,
                                    uint8_t & keyCount) override;
     WEAVE_ERROR Clear(void) override;
+    WEAVE_ERROR EnumerateEpochKeys(uint32_t *keyIds, uint32_t *startTimes, uint8_t arraySize, uint8_t &keyCount) override;
+    WEAVE_ERROR FindGroupMasterKeyId(uint32_t groupGlobalId, uint32_t &groupMasterKeyId) override;
     WEAVE_ERROR RetrieveLastUsedEpochKeyId(void) override;
     WEAVE_ERROR StoreLastUsedEpochKeyId(void) override;
 
@@ -67,6 +69,19 @@ private:
     static constexpr uint16_t kGroupKeyRecordKey =  GetRecordKey(kConfigKey_GroupKey);
     */
 
+    static constexpr uint8_t kMaxGroupKeys = kConfigKey_GroupKeyMax - kConfigKey_GroupKeyBase + 1;
+
+    // In-memory index of the GroupKey nvm3 objects, built on first use by a single pass over the
+    // objects and discarded whenever a key is stored or deleted.  Key material is only read when
+    // a key is retrieved, directly from the object named in the index.
+    uint32_t mKeyIds[kMaxGroupKeys];
+    uint32_t mKeyInfo[kMaxGroupKeys]; // Start time or global id of each key
+    Key      mNvm3Keys[kMaxGroupKeys]; // nvm3 object key of each key
+    uint8_t  mNumKeys;
+    bool     mIndexLoaded;
+
+    WEAVE_ERROR LoadKeyIndex(void);
+
     static WEAVE_ERROR EncodeGroupKey(const WeaveGroupKey &key, uint8_t *buf, size_t bufSize, size_t &encodedKeyLen);
     static WEAVE_ERROR DecodeGroupKey(const uint8_t *encodedKey, size_t encodedKeyLen, WeaveGroupKey &key);
     static WEAVE_ERROR DecodeGroupKeyId(const uint8_t *encodedKey, size_t encodedKeyLen, uint32_t &keyId);
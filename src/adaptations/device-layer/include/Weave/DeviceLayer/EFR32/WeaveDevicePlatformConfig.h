@@ -131,4 +131,10 @@
 #define WEAVE_DEVICE_CONFIG_BLE_APP_TASK_NAME "Bluetooth App Task"
 #endif // WEAVE_DEVICE_CONFIG_BLE_APP_TASK_NAME
 
+// Hand downloaded software images to the application in flash page sized, page aligned batches
+// (EFR32MG12 flash pages are 2 KB).
+#ifndef WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+#define WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE 2048
+#endif // WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
 #endif // WEAVE_DEVICE_PLATFORM_CONFIG_H
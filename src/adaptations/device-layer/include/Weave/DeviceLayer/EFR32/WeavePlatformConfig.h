@@ -57,9 +57,13 @@
 #define WEAVE_CONFIG_USE_OPENSSL_ECC 0
 #define WEAVE_CONFIG_USE_MICRO_ECC 1
 
+// P-256 ECDSA/ECDH, SHA-1/SHA-256 and AES are performed by mbedTLS, which uses the
+// CRYPTO/SE accelerator via the Silicon Labs alternative implementations.
+#define WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM 1
+
 #define WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL 0
-#define WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT 1
-#define WEAVE_CONFIG_HASH_IMPLEMENTATION_MBEDTLS 0
+#define WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT 0
+#define WEAVE_CONFIG_HASH_IMPLEMENTATION_MBEDTLS 1
 #define WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM 0
 
 // FIXME: EFR32 set to MBED-TLS (But this is third-party repo in OpenWeave, not SDK)
@@ -119,6 +123,10 @@
 #define WEAVE_CONFIG_MAX_LOCAL_ADDR_UDP_ENDPOINTS 4
 #endif // WEAVE_CONFIG_MAX_LOCAL_ADDR_UDP_ENDPOINTS
 
+#ifndef WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT
+#define WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT 10
+#endif // WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef WEAVE_CONFIG_MAX_APPLICATION_GROUPS
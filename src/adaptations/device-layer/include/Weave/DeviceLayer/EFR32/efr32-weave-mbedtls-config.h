@@ -35,6 +35,7 @@
 #define MBEDTLS_AES_C
 #define MBEDTLS_ECP_C
 #define MBEDTLS_ECDH_C
+#define MBEDTLS_ECDSA_C
 #define MBEDTLS_ENTROPY_C
 #define MBEDTLS_SHA1_C
 #define MBEDTLS_SHA256_C
@@ -62,6 +62,7 @@ class BLEManagerImpl final
     WEAVE_ERROR _GetDeviceName(char * buf, size_t bufSize);
     WEAVE_ERROR _SetDeviceName(const char * deviceName);
     uint16_t _NumConnections(void);
+    WEAVE_ERROR _SetHighThroughputEnabled(BLE_CONNECTION_OBJECT conId, bool val);
     void _OnPlatformEvent(const WeaveDeviceEvent * event);
     ::nl::Ble::BleLayer * _GetBleLayer(void) const;
 
@@ -75,6 +76,7 @@ class BLEManagerImpl final
     bool SendWriteRequest(BLE_CONNECTION_OBJECT conId, const WeaveBleUUID * svcId, const WeaveBleUUID * charId, PacketBuffer * pBuf) override;
     bool SendReadRequest(BLE_CONNECTION_OBJECT conId, const WeaveBleUUID * svcId, const WeaveBleUUID * charId, PacketBuffer * pBuf) override;
     bool SendReadResponse(BLE_CONNECTION_OBJECT conId, BLE_READ_REQUEST_CONTEXT requestContext, const WeaveBleUUID * svcId, const WeaveBleUUID * charId) override;
+    bool RequestHighThroughput(BLE_CONNECTION_OBJECT conId, bool enable) override;
 
     // ===== Members that implement virtual methods on BleApplicationDelegate.
 
@@ -114,6 +116,7 @@ class BLEManagerImpl final
     struct WoBLEConState
     {
         PacketBuffer * PendingIndBuf;
+        esp_bd_addr_t PeerAddr;
         uint16_t ConId;
         uint16_t MTU : 10;
         uint16_t Allocated : 1;
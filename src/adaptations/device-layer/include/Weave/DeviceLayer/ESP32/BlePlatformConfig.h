@@ -33,6 +33,7 @@
 #define BLE_CONNECTION_OBJECT uint16_t
 #define BLE_CONNECTION_UNINITIALIZED ((uint16_t)0xFFFF)
 #define BLE_MAX_RECEIVE_WINDOW_SIZE 5
+#define BLE_CONFIG_MAX_FRAGMENT_SIZE 244
 
 #define BLE_CONFIG_ERROR_TYPE esp_err_t
 #define BLE_CONFIG_NO_ERROR ESP_OK
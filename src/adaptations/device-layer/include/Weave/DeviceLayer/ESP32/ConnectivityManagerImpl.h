@@ -31,6 +31,9 @@
 #include <Weave/Profiles/weave-tunneling/WeaveTunnelCommon.h>
 #include <Weave/Profiles/weave-tunneling/WeaveTunnelConnectionMgr.h>
 #include <Weave/Support/FlagUtils.hpp>
+#if WEAVE_DEVICE_CONFIG_ENABLE_WIFI_TELEMETRY
+#include <Weave/DeviceLayer/internal/TelemetryChangeFilter.h>
+#endif
 
 #include "esp_event.h"
 
@@ -158,6 +161,9 @@ private:
     uint32_t mWiFiStationReconnectIntervalMS;
     uint32_t mWiFiAPIdleTimeoutMS;
     uint16_t mFlags;
+#if WEAVE_DEVICE_CONFIG_ENABLE_WIFI_TELEMETRY
+    Internal::TelemetryChangeFilter mWiFiStatsChangeFilter;
+#endif
 
     void DriveStationState(void);
     void OnStationConnected(void);
@@ -74,6 +74,7 @@ public:
     static const Key kConfigKey_OperationalDeviceCert;
     static const Key kConfigKey_OperationalDeviceICACerts;
     static const Key kConfigKey_OperationalDevicePrivateKey;
+    static const Key kConfigKey_SoftwareUpdateProgress;
 
     static const char kGroupKeyNamePrefix[];
 
@@ -92,6 +93,11 @@ public:
     static WEAVE_ERROR ClearConfigValue(Key key);
     static bool ConfigValueExists(Key key);
 
+    // Write batching.  Between BeginWriteBatch() and the matching CommitWriteBatch(), config value
+    // writes and erasures share an open NVS handle and are committed together when the batch ends.
+    static WEAVE_ERROR BeginWriteBatch(void);
+    static WEAVE_ERROR CommitWriteBatch(void);
+
     // NVS Namespace helper functions.
     static WEAVE_ERROR EnsureNamespace(const char * ns);
     static WEAVE_ERROR ClearNamespace(const char * ns);
@@ -60,15 +60,20 @@ public:
     WEAVE_ERROR DeleteGroupKeysOfAType(uint32_t keyType) override;
     WEAVE_ERROR EnumerateGroupKeys(uint32_t keyType, uint32_t * keyIds, uint8_t keyIdsArraySize, uint8_t & keyCount) override;
     WEAVE_ERROR Clear(void) override;
+    WEAVE_ERROR EnumerateEpochKeys(uint32_t * keyIds, uint32_t * startTimes, uint8_t arraySize, uint8_t & keyCount) override;
+    WEAVE_ERROR FindGroupMasterKeyId(uint32_t groupGlobalId, uint32_t & groupMasterKeyId) override;
     WEAVE_ERROR RetrieveLastUsedEpochKeyId(void) override;
     WEAVE_ERROR StoreLastUsedEpochKeyId(void) override;
 
 private:
 
     uint32_t mKeyIndex[kMaxGroupKeys];
+    uint32_t mKeyInfo[kMaxGroupKeys];       // Start time or global id of each key in mKeyIndex
     uint8_t mNumKeys;
+    bool mKeyInfoLoaded;
 
     WEAVE_ERROR AddKeyToIndex(uint32_t keyId, bool & indexUpdated);
+    WEAVE_ERROR LoadKeyInfo(void);
     WEAVE_ERROR WriteKeyIndex(nvs_handle handle);
     WEAVE_ERROR DeleteKeyOrKeys(uint32_t targetKeyId, uint32_t targetKeyType);
 
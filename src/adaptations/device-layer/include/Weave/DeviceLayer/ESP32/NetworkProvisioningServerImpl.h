@@ -20,6 +20,7 @@
 #define NETWORK_PROVISIONING_SERVER_IMPL_H
 
 #include <Weave/DeviceLayer/internal/GenericNetworkProvisioningServerImpl.h>
+#include <Weave/DeviceLayer/internal/DeviceNetworkInfo.h>
 
 
 namespace nl {
@@ -61,6 +62,7 @@ private:
     WEAVE_ERROR ClearWiFiStationProvision(void);
     WEAVE_ERROR InitiateWiFiScan(void);
     void HandleScanDone(void);
+    WEAVE_ERROR SendScanResults(uint8_t first, uint8_t count, bool final);
     static NetworkProvisioningServerImpl & Instance(void);
     static void HandleScanTimeOut(::nl::Weave::System::Layer * aLayer, void * aAppState, ::nl::Weave::System::Error aError);
     static bool IsSupportedWiFiSecurityType(WiFiSecurityType_t wifiSecType);
@@ -70,6 +72,23 @@ private:
     friend ::nl::Weave::DeviceLayer::Internal::NetworkProvisioningServer & NetworkProvisioningSvr(void);
     friend NetworkProvisioningServerImpl & NetworkProvisioningSvrImpl(void);
 
+    // ===== Private members for use by this class only.
+
+    struct ScanResult
+    {
+        char SSID[DeviceNetworkInfo::kMaxWiFiSSIDLength + 1];
+        int8_t RSSI;
+        uint8_t AuthMode;
+    };
+
+    // Results of the last (or current) scan, in order of decreasing signal strength within each channel.
+    ScanResult mScanResults[WEAVE_DEVICE_CONFIG_MAX_SCAN_NETWORKS_RESULTS];
+    uint64_t mScanResultsTime;
+    uint8_t mScanResultCount;
+
+    // The channel being scanned during a streamed scan; 0 during an all-channel scan.
+    uint8_t mScanChannel;
+
     static NetworkProvisioningServerImpl sInstance;
 };
 
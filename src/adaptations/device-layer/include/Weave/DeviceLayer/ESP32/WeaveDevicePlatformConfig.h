@@ -29,6 +29,16 @@
 
 #define WEAVE_DEVICE_CONFIG_LWIP_WIFI_STATION_IF_NAME "st"
 
+// The ESP32 mbedTLS SHA-256 driver may keep hash state in the SHA engine rather
+// than in its context, so that state cannot be persisted.
+#define WEAVE_DEVICE_CONFIG_SWU_PERSIST_HASH_STATE 0
+
+// Hand downloaded software images to the application in flash sector sized, sector aligned
+// batches, so that each esp_ota_write() call programs whole sectors.
+#ifndef WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+#define WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE 4096
+#endif
+
 // ==================== Kconfig Overrides ====================
 
 // The following values are configured via the ESP-IDF Kconfig mechanism.
@@ -61,6 +71,7 @@
 #define WEAVE_DEVICE_CONFIG_WEAVE_TIME_SERVICE_ENDPOINT_ID CONFIG_WEAVE_TIME_SERVICE_ENDPOINT_ID
 #define WEAVE_DEVICE_CONFIG_DEFAULT_TIME_SYNC_INTERVAL CONFIG_DEFAULT_TIME_SYNC_INTERVAL
 #define WEAVE_DEVICE_CONFIG_TIME_SYNC_TIMEOUT CONFIG_TIME_SYNC_TIMEOUT
+#define WEAVE_DEVICE_CONFIG_MAX_TIME_SYNC_INTERVAL CONFIG_MAX_TIME_SYNC_INTERVAL
 #define WEAVE_DEVICE_CONFIG_SERVICE_PROVISIONING_ENDPOINT_ID CONFIG_SERVICE_PROVISIONING_ENDPOINT_ID
 #define WEAVE_DEVICE_CONFIG_SERVICE_PROVISIONING_CONNECTIVITY_TIMEOUT CONFIG_SERVICE_PROVISIONING_CONNECTIVITY_TIMEOUT
 #define WEAVE_DEVICE_CONFIG_SERVICE_PROVISIONING_REQUEST_TIMEOUT CONFIG_SERVICE_PROVISIONING_REQUEST_TIMEOUT
@@ -75,6 +86,7 @@
 #define WEAVE_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY CONFIG_ENABLE_THREAD_TELEMETRY
 #define WEAVE_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY_FULL CONFIG_ENABLE_THREAD_TELEMETRY_FULL
 #define WEAVE_DEVICE_CONFIG_ENABLE_TUNNEL_TELEMETRY CONFIG_ENABLE_TUNNEL_TELEMETRY
+#define WEAVE_DEVICE_CONFIG_TELEMETRY_MAX_SUPPRESSED_INTERVAL_MS CONFIG_TELEMETRY_MAX_SUPPRESSED_INTERVAL_MS
 #define WEAVE_DEVICE_CONFIG_EVENT_LOGGING_CRIT_BUFFER_SIZE CONFIG_EVENT_LOGGING_CRIT_BUFFER_SIZE
 #define WEAVE_DEVICE_CONFIG_EVENT_LOGGING_PROD_BUFFER_SIZE CONFIG_EVENT_LOGGING_PROD_BUFFER_SIZE
 #define WEAVE_DEVICE_CONFIG_EVENT_LOGGING_INFO_BUFFER_SIZE CONFIG_EVENT_LOGGING_INFO_BUFFER_SIZE
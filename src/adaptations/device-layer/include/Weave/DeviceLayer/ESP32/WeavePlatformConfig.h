@@ -109,5 +109,6 @@
 #define WDM_RESUBSCRIBE_MAX_RETRY_WAIT_INTERVAL_MS CONFIG_MAX_WDM_RESUBSCRIBE_INTERVAL
 #define WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK CONFIG_WDM_ENABLE_SCHEMA_CHECK
 #define WEAVE_CONFIG_DEFAULT_INCOMING_CONNECTION_IDLE_TIMEOUT CONFIG_DEFAULT_INCOMING_CONNECTION_IDLE_TIMEOUT
+#define WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT
 
 #endif /* WEAVE_PLATFORM_CONFIG_H */
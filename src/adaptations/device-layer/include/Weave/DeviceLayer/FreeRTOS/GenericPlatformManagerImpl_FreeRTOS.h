@@ -57,13 +57,37 @@ template<class ImplClass>
 class GenericPlatformManagerImpl_FreeRTOS
     : public GenericPlatformManagerImpl<ImplClass>
 {
+public:
+
+    // ===== Members that may be accessed directly by the application.
+
+    /**
+     * Counters describing the use of the Weave Platform event queues.
+     *
+     * Counters are updated without synchronization and are intended for diagnostics only.
+     */
+    struct EventQueueStats
+    {
+        uint32_t HighPriorityOverflows;     /**< Events dropped because the high-priority queue was full. */
+        uint32_t NormalPriorityOverflows;   /**< Events dropped because the normal-priority queue was full. */
+        uint16_t HighPriorityPeak;          /**< Greatest number of events seen waiting in the high-priority queue. */
+        uint16_t NormalPriorityPeak;        /**< Greatest number of events seen waiting in the normal-priority queue. */
+        uint16_t LargestBatch;              /**< Greatest number of events dispatched under one acquisition of the stack lock. */
+    };
+
+    void GetEventQueueStats(EventQueueStats & stats) const;
+    void ResetEventQueueStats(void);
+
 protected:
 
     TimeOut_t mNextTimerBaseTime;
     TickType_t mNextTimerDurationTicks;
     SemaphoreHandle_t mWeaveStackLock;
     QueueHandle_t mWeaveEventQueue;
+    QueueHandle_t mWeaveHighPriEventQueue;
+    SemaphoreHandle_t mWeaveEventSignal;
     TaskHandle_t mEventLoopTask;
+    EventQueueStats mEventQueueStats;
     bool mWeaveTimerActive;
 
     // ===== Methods that implement the PlatformManager abstract interface.
@@ -87,6 +111,10 @@ private:
 
     inline ImplClass * Impl() { return static_cast<ImplClass*>(this); }
 
+    QueueHandle_t SelectEventQueue(const WeaveDeviceEvent * event);
+    void CountEventOverflow(QueueHandle_t queue);
+    uint16_t DispatchEventBatch(void);
+
     static void EventLoopTaskMain(void * arg);
 };
 
@@ -51,6 +51,7 @@ WEAVE_ERROR GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_InitWeaveStack(void
     mNextTimerDurationTicks = 0;
     mEventLoopTask = NULL;
     mWeaveTimerActive = false;
+    memset(&mEventQueueStats, 0, sizeof(mEventQueueStats));
 
     mWeaveStackLock = xSemaphoreCreateMutex();
     if (mWeaveStackLock == NULL)
@@ -66,6 +67,20 @@ WEAVE_ERROR GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_InitWeaveStack(void
         ExitNow(err = WEAVE_ERROR_NO_MEMORY);
     }
 
+    mWeaveHighPriEventQueue = xQueueCreate(WEAVE_DEVICE_CONFIG_MAX_HIGH_PRIORITY_EVENT_QUEUE_SIZE, sizeof(WeaveDeviceEvent));
+    if (mWeaveHighPriEventQueue == NULL)
+    {
+        WeaveLogError(DeviceLayer, "Failed to allocate Weave high-priority event queue");
+        ExitNow(err = WEAVE_ERROR_NO_MEMORY);
+    }
+
+    mWeaveEventSignal = xSemaphoreCreateBinary();
+    if (mWeaveEventSignal == NULL)
+    {
+        WeaveLogError(DeviceLayer, "Failed to create Weave event signal");
+        ExitNow(err = WEAVE_ERROR_NO_MEMORY);
+    }
+
     // Call up to the base class _InitWeaveStack() to perform the bulk of the initialization.
     err = GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack();
     SuccessOrExit(err);
@@ -95,12 +110,20 @@ void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_UnlockWeaveStack(void)
 template<class ImplClass>
 void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_PostEvent(const WeaveDeviceEvent * event)
 {
-    if (mWeaveEventQueue != NULL)
+    QueueHandle_t queue = SelectEventQueue(event);
+
+    if (queue != NULL)
     {
-        if (!xQueueSend(mWeaveEventQueue, event, 1))
+        if (!xQueueSend(queue, event, 1))
         {
+            CountEventOverflow(queue);
             WeaveLogError(DeviceLayer, "Failed to post event to Weave Platform event queue");
         }
+        else
+        {
+            // Wake the event loop.
+            xSemaphoreGive(mWeaveEventSignal);
+        }
     }
 }
 
@@ -108,7 +131,7 @@ template<class ImplClass>
 void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_RunEventLoop(void)
 {
     WEAVE_ERROR err;
-    WeaveDeviceEvent event;
+    bool moreEvents = true;
 
     VerifyOrDie(mEventLoopTask == NULL);
 
@@ -162,23 +185,104 @@ void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_RunEventLoop(void)
             waitTime = portMAX_DELAY;
         }
 
+        // If the last batch stopped short of emptying the event queues, don't wait before starting the next.
+        if (moreEvents)
+        {
+            waitTime = 0;
+        }
+
         // Unlock the Weave stack, allowing other threads to enter Weave while the event loop thread is sleeping.
         Impl()->UnlockWeaveStack();
 
-        BaseType_t eventReceived = xQueueReceive(mWeaveEventQueue, &event, waitTime);
+        // Wait for an event to be posted to either queue, or for the next timer to expire.
+        xSemaphoreTake(mWeaveEventSignal, waitTime);
 
         // Lock the Weave stack.
         Impl()->LockWeaveStack();
 
-        // If an event was received, dispatch it.  Continue receiving events from the queue and
-        // dispatching them until the queue is empty.
-        while (eventReceived == pdTRUE)
-        {
-            Impl()->DispatchEvent(&event);
+        // Dispatch a batch of events, if any are waiting.  The signal may have been consumed by an event
+        // that a previous batch has already dispatched, so check the queues regardless of the wait outcome.
+        moreEvents = (DispatchEventBatch() == WEAVE_DEVICE_CONFIG_EVENT_BATCH_SIZE);
+    }
+}
+
+template<class ImplClass>
+uint16_t GenericPlatformManagerImpl_FreeRTOS<ImplClass>::DispatchEventBatch(void)
+{
+    WeaveDeviceEvent event;
+    uint16_t count = 0;
+    UBaseType_t waiting;
+
+    // Record queue depth peaks.
+    waiting = uxQueueMessagesWaiting(mWeaveHighPriEventQueue);
+    if (waiting > mEventQueueStats.HighPriorityPeak)
+    {
+        mEventQueueStats.HighPriorityPeak = waiting;
+    }
+    waiting = uxQueueMessagesWaiting(mWeaveEventQueue);
+    if (waiting > mEventQueueStats.NormalPriorityPeak)
+    {
+        mEventQueueStats.NormalPriorityPeak = waiting;
+    }
 
-            eventReceived = xQueueReceive(mWeaveEventQueue, &event, 0);
+    // Dispatch events until the batch is full or both queues are empty, always preferring a
+    // high-priority event over a normal one.
+    while (count < WEAVE_DEVICE_CONFIG_EVENT_BATCH_SIZE)
+    {
+        if (xQueueReceive(mWeaveHighPriEventQueue, &event, 0) != pdTRUE &&
+            xQueueReceive(mWeaveEventQueue, &event, 0) != pdTRUE)
+        {
+            break;
         }
+
+        Impl()->DispatchEvent(&event);
+        count++;
     }
+
+    if (count > mEventQueueStats.LargestBatch)
+    {
+        mEventQueueStats.LargestBatch = count;
+    }
+
+    return count;
+}
+
+template<class ImplClass>
+QueueHandle_t GenericPlatformManagerImpl_FreeRTOS<ImplClass>::SelectEventQueue(const WeaveDeviceEvent * event)
+{
+    // Internal events, which are raised by the network and BLE stacks and by the Weave timer machinery,
+    // take the high-priority queue.  Public events and work items scheduled by the application take the
+    // normal-priority queue.  Events within each queue are dispatched in the order they were posted.
+    if (event->IsInternal() && event->Type != DeviceEventType::kCallWorkFunct)
+    {
+        return mWeaveHighPriEventQueue;
+    }
+    return mWeaveEventQueue;
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::CountEventOverflow(QueueHandle_t queue)
+{
+    if (queue == mWeaveHighPriEventQueue)
+    {
+        mEventQueueStats.HighPriorityOverflows++;
+    }
+    else
+    {
+        mEventQueueStats.NormalPriorityOverflows++;
+    }
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::GetEventQueueStats(EventQueueStats & stats) const
+{
+    stats = mEventQueueStats;
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::ResetEventQueueStats(void)
+{
+    memset(&mEventQueueStats, 0, sizeof(mEventQueueStats));
 }
 
 template<class ImplClass>
@@ -226,14 +330,27 @@ WEAVE_ERROR GenericPlatformManagerImpl_FreeRTOS<ImplClass>::_StartWeaveTimer(uin
 template<class ImplClass>
 void GenericPlatformManagerImpl_FreeRTOS<ImplClass>::PostEventFromISR(const WeaveDeviceEvent * event, BaseType_t & yieldRequired)
 {
+    QueueHandle_t queue = SelectEventQueue(event);
+    BaseType_t signalYieldRequired = pdFALSE;
+
     yieldRequired = pdFALSE;
 
-    if (mWeaveEventQueue != NULL)
+    if (queue != NULL)
     {
-        if (!xQueueSendFromISR(mWeaveEventQueue, event, &yieldRequired))
+        if (!xQueueSendFromISR(queue, event, &yieldRequired))
         {
+            CountEventOverflow(queue);
             WeaveLogError(DeviceLayer, "Failed to post event to Weave Platform event queue");
         }
+        else
+        {
+            // Wake the event loop.
+            xSemaphoreGiveFromISR(mWeaveEventSignal, &signalYieldRequired);
+            if (signalYieldRequired == pdTRUE)
+            {
+                yieldRequired = pdTRUE;
+            }
+        }
     }
 }
 
@@ -29,6 +29,8 @@
 #ifndef NETWORK_TELEMETRY_MANAGER_H
 #define NETWORK_TELEMETRY_MANAGER_H
 
+#include <Weave/DeviceLayer/internal/TelemetryChangeFilter.h>
+
 namespace nl {
 namespace Weave {
 namespace DeviceLayer {
@@ -113,8 +115,29 @@ protected:
 #if WEAVE_DEVICE_CONFIG_ENABLE_TUNNEL_TELEMETRY
 class TunnelTelemetry : public WeaveTelemetryBase
 {
+public:
+    TunnelTelemetry(void);
+
 protected:
     virtual void GetTelemetryStatsAndLogEvent(void);
+
+private:
+    // Suppresses events whose counters and state have not changed since the last logged event.
+    TelemetryChangeFilter mChangeFilter;
+
+    // Rates and queue depth at each poll since the last logged event.
+    TelemetryWindowStats mTxBytesRate;
+    TelemetryWindowStats mRxBytesRate;
+    TelemetryWindowStats mTxMessagesRate;
+    TelemetryWindowStats mRxMessagesRate;
+    TelemetryWindowStats mQueuedPackets;
+
+    // Counters at the previous poll, from which the rates are computed.
+    uint64_t mLastPollTime;
+    uint64_t mLastTxBytes;
+    uint64_t mLastRxBytes;
+    uint32_t mLastTxMessages;
+    uint32_t mLastRxMessages;
 };
 #endif // WEAVE_DEVICE_CONFIG_ENABLE_TUNNEL_TELEMETRY
 
@@ -28,6 +28,10 @@
 
 #include <openthread/instance.h>
 
+#if WEAVE_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY
+#include <Weave/DeviceLayer/internal/TelemetryChangeFilter.h>
+#endif
+
 namespace nl {
 namespace Weave {
 namespace DeviceLayer {
@@ -99,6 +103,12 @@ private:
     otInstance * mOTInst;
     ConnectivityManager::ThreadPollingConfig mPollingConfig;
 
+#if WEAVE_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY
+    TelemetryChangeFilter mStatsChangeFilter;
+    TelemetryChangeFilter mTopologyChangeFilter;
+    TelemetryWindowStats mInstantRssi;
+#endif
+
     inline ImplClass * Impl() { return static_cast<ImplClass*>(this); }
 };
 
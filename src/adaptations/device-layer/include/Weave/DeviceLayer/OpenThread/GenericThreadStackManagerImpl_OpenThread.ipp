@@ -667,6 +667,45 @@ WEAVE_ERROR GenericThreadStackManagerImpl_OpenThread<ImplClass>::_GetAndLogThrea
 
     counterEvent.threadType = TelemetryNetworkWpanTrait::THREAD_TYPE_OPENTHREAD;
 
+    // Only log an event when a counter or the node type has changed since the last one.
+    mStatsChangeFilter.BeginSample();
+    mStatsChangeFilter.AddMetric(counterEvent.phyRx);
+    mStatsChangeFilter.AddMetric(counterEvent.macUnicastRx);
+    mStatsChangeFilter.AddMetric(counterEvent.macBroadcastRx);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxData);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxDataPoll);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxBeacon);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxBeaconReq);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxOtherPkt);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxFilterWhitelist);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxFilterDestAddr);
+    mStatsChangeFilter.AddMetric(counterEvent.phyTx);
+    mStatsChangeFilter.AddMetric(counterEvent.macUnicastTx);
+    mStatsChangeFilter.AddMetric(counterEvent.macBroadcastTx);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxAckReq);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxNoAckReq);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxAcked);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxData);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxDataPoll);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxBeacon);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxBeaconReq);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxOtherPkt);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxRetry);
+    mStatsChangeFilter.AddMetric(counterEvent.macTxFailCca);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxFailDecrypt);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxFailNoFrame);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxFailUnknownNeighbor);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxFailInvalidSrcAddr);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxFailFcs);
+    mStatsChangeFilter.AddMetric(counterEvent.macRxFailOther);
+    mStatsChangeFilter.AddMetric(counterEvent.ipTxSuccess);
+    mStatsChangeFilter.AddMetric(counterEvent.ipRxSuccess);
+    mStatsChangeFilter.AddMetric(counterEvent.ipTxFailure);
+    mStatsChangeFilter.AddMetric(counterEvent.ipRxFailure);
+    mStatsChangeFilter.AddMetric(counterEvent.channel);
+    mStatsChangeFilter.AddMetric(counterEvent.nodeType);
+    VerifyOrExit(mStatsChangeFilter.ShouldLog(), );
+
     WeaveLogProgress(DeviceLayer,
                      "Rx Counters:\n"
                      "PHY Rx Total:                 %d\n"
@@ -760,6 +799,17 @@ WEAVE_ERROR GenericThreadStackManagerImpl_OpenThread<ImplClass>::_GetAndLogThrea
 
     topologyEvent.instantRssi = otPlatRadioGetRssi(mOTInst);
 
+    mInstantRssi.Add(topologyEvent.instantRssi);
+
+    // Only log an event when the node's place in the topology, or the parent link quality, has changed since the last one.
+    // The instant RSSI varies from one sample to the next, and is summarized over the samples taken in between instead.
+    mTopologyChangeFilter.BeginSample();
+    mTopologyChangeFilter.AddMetric(topologyEvent.rloc16);
+    mTopologyChangeFilter.AddMetric(topologyEvent.leaderRouterId);
+    mTopologyChangeFilter.AddMetric(topologyEvent.partitionId);
+    mTopologyChangeFilter.AddGauge(topologyEvent.parentAverageRssi, WEAVE_DEVICE_CONFIG_TELEMETRY_RSSI_RESOLUTION);
+    VerifyOrExit(mTopologyChangeFilter.ShouldLog(), );
+
     WeaveLogProgress(DeviceLayer,
                      "Thread Topology:\n"
                      "RLOC16:           %04X\n"
@@ -775,6 +825,10 @@ WEAVE_ERROR GenericThreadStackManagerImpl_OpenThread<ImplClass>::_GetAndLogThrea
                      topologyEvent.extAddress.mBuf[2], topologyEvent.extAddress.mBuf[3], topologyEvent.extAddress.mBuf[4],
                      topologyEvent.extAddress.mBuf[5], topologyEvent.extAddress.mBuf[6], topologyEvent.extAddress.mBuf[7], topologyEvent.instantRssi);
 
+    WeaveLogProgress(DeviceLayer, "Instant RSSI over %" PRIu32 " samples (min/avg/max): %" PRId32 "/%" PRId32 "/%" PRId32,
+                     mInstantRssi.Count(), mInstantRssi.Min(), mInstantRssi.Average(), mInstantRssi.Max());
+    mInstantRssi.Reset();
+
     eventId = nl::LogEvent(&topologyEvent);
     WeaveLogProgress(DeviceLayer, "OpenThread Telemetry Stats Event Id: %u", eventId);
 
@@ -60,6 +60,27 @@ template<class> class GenericThreadStackManagerImpl_OpenThread;
 template<class> class GenericThreadStackManagerImpl_OpenThread_LwIP;
 } // namespace Internal
 
+/**
+ * A consistent snapshot of frequently read Device Layer state.
+ *
+ * The snapshot is refreshed by the Weave task whenever a platform event reports a change to
+ * the state it contains, and can be read from any task without taking the Weave stack lock
+ * (see PlatformManager::GetDeviceState()).
+ */
+struct DeviceStateSnapshot
+{
+    uint64_t DeviceId;                      /**< The Weave node id of the device. */
+    uint64_t FabricId;                      /**< The id of the device's fabric; kFabricIdNotSpecified if none. */
+    bool IsMemberOfFabric;
+    bool IsServiceProvisioned;
+    bool IsPairedToAccount;
+    bool IsWiFiStationConnected;
+    bool IsThreadAttached;
+    bool HaveIPv4InternetConnectivity;
+    bool HaveIPv6InternetConnectivity;
+    bool IsServiceTunnelConnected;
+    bool HaveServiceConnectivity;
+};
 
 /**
  * Provides features for initializing and interacting with the Weave network
@@ -84,6 +105,7 @@ public:
     void LockWeaveStack(void);
     bool TryLockWeaveStack(void);
     void UnlockWeaveStack(void);
+    void GetDeviceState(DeviceStateSnapshot & state);
 
 private:
 
@@ -204,6 +226,18 @@ inline void PlatformManager::UnlockWeaveStack(void)
     static_cast<ImplClass*>(this)->_UnlockWeaveStack();
 }
 
+/**
+ * Get a snapshot of frequently read Device Layer state.
+ *
+ * Unlike the corresponding ConfigurationManager and ConnectivityManager methods, this method
+ * may be called from any task without holding the Weave stack lock, so that application tasks
+ * do not wait for the Weave task to finish processing a message.
+ */
+inline void PlatformManager::GetDeviceState(DeviceStateSnapshot & state)
+{
+    static_cast<ImplClass*>(this)->_GetDeviceState(state);
+}
+
 inline void PlatformManager::PostEvent(const WeaveDeviceEvent * event)
 {
     static_cast<ImplClass*>(this)->_PostEvent(event);
@@ -74,6 +74,14 @@ public:
          *  Generated when a software update check has been triggered. Provides an opportunity
          *  for the application to supply product related information to the
          *  SofwareUpdate:ImageQuery message.
+         *
+         *  When WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE is non-zero, an application that
+         *  handles ReadInstalledImage events can receive delta images by returning the SHA-256
+         *  hash of its installed image in the InstalledImageSHA256 output parameter.  The hash
+         *  identifies the installed image to the server, which may then offer a delta image
+         *  based on it.  The system reconstructs the new image from the delta and the installed
+         *  image as it is downloaded, and stores the new image as usual.  The integrity value
+         *  of a delta image covers the new image.
          */
         kEvent_PrepareQuery,
 
@@ -123,6 +131,14 @@ public:
          *  of PartialImageLenInBytes to 0 to indicate that no partial image exists or
          *  that the URI of the partial image does not match.
          *
+         *  The DownloadProgressLen input parameter gives the number of bytes of the
+         *  image that the system itself recorded as stored before the download was
+         *  interrupted, or 0 if it holds no record for the URI.  An application that does
+         *  not track the length of its partial image can return this value, provided its
+         *  storage retains every block it acknowledged.  If the length returned differs
+         *  from the recorded progress, the download still resumes, but the image integrity
+         *  value is computed by the application (see ComputeImageIntegrity).
+         *
          *  The application may choose to ignore this event by passing it to the default
          *  event handler. If this is done, the system will always download the entirety
          *  of the available firmware image.
@@ -171,6 +187,15 @@ public:
          *  To support resuming an interrupted download, the application should maintain a
          *  persistent count of the total number of image bytes stored, and use this value
          *  when handling subsequent FetchPartialImageInfo events.
+         *
+         *  When WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE is non-zero, the data is a batch of
+         *  downloaded blocks rather than a single block.  The application may then write the
+         *  batch asynchronously, by setting the IsAsync output parameter and later calling the
+         *  \c StoreImageBlockComplete() method; the data remains valid until it does so.  The
+         *  download continues in the meantime, and is held off if it gets a batch ahead.
+         *  Batches are only written asynchronously when the IsAsyncAllowed input parameter is
+         *  set; it is not while a delta image is applied, as a single downloaded block can then
+         *  expand to any number of batches.
          */
         kEvent_StoreImageBlock,
 
@@ -179,6 +204,11 @@ public:
          *
          *  Requests the application to compute an integrity check value over the downloaded
          *  image. Generated once downloading is complete.
+         *
+         *  When WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH is enabled and the image uses a
+         *  SHA-256 integrity check, the system hashes image blocks as they are stored and
+         *  this event is only generated if that running hash is unavailable, e.g. when a
+         *  download resumes without its persisted hash state.
          */
         kEvent_ComputeImageIntegrity,
 
@@ -225,6 +255,37 @@ public:
          */
         kEvent_Finished,
 
+        /**
+         *  Read a range of the installed image
+         *
+         *  Requests the application to copy a range of its currently installed image into the
+         *  buffer provided.  Generated while a delta image is being applied (see PrepareQuery).
+         *
+         *  An application that does not return the hash of its installed image in response to
+         *  PrepareQuery events never receives this event.
+         */
+        kEvent_ReadInstalledImage,
+
+        /**
+         *  Prepare a region of image storage ahead of writing
+         *
+         *  Informs the application of the region of the image that the next StoreImageBlock
+         *  event will write, at the point where the data for that region starts to download.
+         *  The application can use this, for example, to start erasing the flash sector(s)
+         *  backing the region, so that the erase overlaps with the download rather than
+         *  delaying the write.
+         *
+         *  Generated only when WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE is non-zero, and only
+         *  for regions that start on a multiple of the batch size, so that the region never
+         *  covers data that has already been stored.  The region may extend beyond the end of
+         *  the image.
+         *
+         *  An application that prepares all of its image storage in response to the
+         *  PrepareImageStorage event can ignore this event by passing it to the default
+         *  event handler.
+         */
+        kEvent_PrepareImageRegion,
+
         /**
          *  Check default event handling behavior.
          *
@@ -300,6 +361,7 @@ public:
     WEAVE_ERROR CheckNow(void);
     WEAVE_ERROR ImageInstallComplete(WEAVE_ERROR aError);
     WEAVE_ERROR PrepareImageStorageComplete(WEAVE_ERROR aError);
+    WEAVE_ERROR StoreImageBlockComplete(WEAVE_ERROR aError);
     WEAVE_ERROR SetEventCallback(void * const aAppState, const EventCallback aEventCallback);
     WEAVE_ERROR SetQueryIntervalWindow(uint32_t aMinWaitTimeMs, uint32_t aMaxWaitTimeMs);
 
@@ -390,11 +452,13 @@ union SoftwareUpdateManager::InEventParam
         uint8_t IntegrityType;
         const char *URI;
         const char *Version;
+        bool IsDeltaImage;              // The image is a delta, applied to the installed image as it is downloaded.
     } SoftwareUpdateAvailable;
 
     struct
     {
         const char *URI;
+        uint64_t DownloadProgressLen;   // Image bytes recorded as stored by the system, or 0.
     } FetchPartialImageInfo;
 
     struct
@@ -407,6 +471,7 @@ union SoftwareUpdateManager::InEventParam
     {
         uint8_t *DataBlock;
         uint32_t DataBlockLen;
+        bool IsAsyncAllowed;            // Whether the application may set IsAsync for this block.
     } StoreImageBlock;
 
     struct
@@ -421,6 +486,19 @@ union SoftwareUpdateManager::InEventParam
         WEAVE_ERROR Error;
         Profiles::StatusReporting::StatusReport *StatusReport;
     } Finished;
+
+    struct
+    {
+        uint32_t Offset;                // Offset of the range within the installed image.
+        uint8_t *Buf;                   // Pointer to the buffer for the app to copy the range into.
+        uint32_t Length;                // Length of the range.
+    } ReadInstalledImage;
+
+    struct
+    {
+        uint64_t Offset;                // Offset of the region within the image.
+        uint32_t Length;                // Length of the region.
+    } PrepareImageRegion;
 };
 
 union SoftwareUpdateManager::OutEventParam
@@ -433,6 +511,7 @@ union SoftwareUpdateManager::OutEventParam
         const char *PackageSpecification;
         const char *DesiredLocale;
         WEAVE_ERROR Error;
+        const uint8_t *InstalledImageSHA256;   // SHA-256 hash of the installed image, if delta images are wanted.
     } PrepareQuery;
 
     struct
@@ -453,12 +532,18 @@ union SoftwareUpdateManager::OutEventParam
     struct
     {
         WEAVE_ERROR Error;
+        bool IsAsync;                   // Set if the block will be completed with StoreImageBlockComplete().
     } StoreImageBlock;
 
     struct
     {
         WEAVE_ERROR Error;
     } ComputeImageIntegrity;
+
+    struct
+    {
+        WEAVE_ERROR Error;
+    } ReadInstalledImage;
 };
 
 inline WEAVE_ERROR SoftwareUpdateManager::Init(void)
@@ -481,6 +566,11 @@ inline WEAVE_ERROR SoftwareUpdateManager::PrepareImageStorageComplete(WEAVE_ERRO
     return static_cast<ImplClass*>(this)->_PrepareImageStorageComplete(aError);
 }
 
+inline WEAVE_ERROR SoftwareUpdateManager::StoreImageBlockComplete(WEAVE_ERROR aError)
+{
+    return static_cast<ImplClass*>(this)->_StoreImageBlockComplete(aError);
+}
+
 inline SoftwareUpdateManager::State SoftwareUpdateManager::GetState(void)
 {
     return static_cast<ImplClass*>(this)->_GetState();
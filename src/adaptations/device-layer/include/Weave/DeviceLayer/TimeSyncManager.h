@@ -94,6 +94,7 @@ private:
     // ===== Private members for use by this class only.
 
     uint64_t mLastSyncTimeMS; // in monotonic time
+    uint64_t mLastClockSetTimeMS; // in monotonic time
 #if WEAVE_DEVICE_CONFIG_ENABLE_SERVICE_DIRECTORY_TIME_SYNC
     uint64_t mServiceDirTimeSyncStartUS;
 #endif
@@ -101,11 +102,16 @@ private:
     ::nl::Weave::Binding * mTimeSyncBinding;
 #endif
     uint32_t mSyncIntervalSec;
+    uint32_t mCurSyncIntervalSec;
+    int32_t mClockDriftPPM;
+    bool mClockDriftValid;
     TimeSyncMode mMode;
 
     void DriveTimeSync();
     void CancelTimeSync();
     void ApplySynchronizedTime(uint64_t syncedRealTimeUS);
+    void UpdateClockDriftEstimate(uint64_t syncedRealTimeUS, uint64_t nowMS);
+    void UpdateSyncInterval(void);
     void TimeSyncFailed(WEAVE_ERROR reason, nl::Weave::Profiles::StatusReporting::StatusReport * statusReport);
 
 #if WEAVE_DEVICE_CONFIG_ENABLE_WEAVE_TIME_SERVICE_TIME_SYNC
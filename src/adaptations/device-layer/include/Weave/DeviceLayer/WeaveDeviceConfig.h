@@ -88,6 +88,30 @@
 #define WEAVE_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE 100
 #endif
 
+/**
+ * WEAVE_DEVICE_CONFIG_MAX_HIGH_PRIORITY_EVENT_QUEUE_SIZE
+ *
+ * The maximum number of events that can be held in the Weave Platform high-priority event queue.
+ *
+ * Internal events raised by the network stacks, the BLE stack and the Weave timer machinery are
+ * posted to this queue, and dispatched ahead of application work items and public events waiting
+ * in the main event queue.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_MAX_HIGH_PRIORITY_EVENT_QUEUE_SIZE
+#define WEAVE_DEVICE_CONFIG_MAX_HIGH_PRIORITY_EVENT_QUEUE_SIZE 25
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_EVENT_BATCH_SIZE
+ *
+ * The maximum number of events the Weave event loop dispatches under a single acquisition of the
+ * Weave stack lock.  Between batches, the event loop services expired Weave timers and briefly
+ * releases the lock so that other tasks may enter the Weave stack.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_EVENT_BATCH_SIZE
+#define WEAVE_DEVICE_CONFIG_EVENT_BATCH_SIZE 8
+#endif
+
 /**
  * WEAVE_DEVICE_CONFIG_SERVICE_DIRECTORY_CACHE_SIZE
  *
@@ -130,6 +154,34 @@
 #define WEAVE_DEVICE_CONFIG_LOG_PROVISIONING_HASH 1
 #endif
 
+/**
+ * WEAVE_DEVICE_CONFIG_CONFIG_VALUE_CACHE_SIZE
+ *
+ * The number of scalar (bool, uint32_t and uint64_t) configuration values the platform
+ * configuration store caches in RAM.  Cached values are read without accessing persistent
+ * storage, and writes of unchanged values are skipped.
+ *
+ * Set to 0 to disable the cache.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_CONFIG_VALUE_CACHE_SIZE
+#define WEAVE_DEVICE_CONFIG_CONFIG_VALUE_CACHE_SIZE 16
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT
+ *
+ * Defer the initialization of the Weave servers that no other component depends on (device
+ * control, provisioning and echo servers, and the network telemetry manager) until the Weave
+ * event loop is running.  This lets the first network connection attempt, which is started
+ * during stack initialization, overlap with the initialization of these servers.
+ *
+ * The deferred initialization is completed before any platform event is delivered to the
+ * Device Layer components.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT
+#define WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT 0
+#endif
+
 // -------------------- Device Identification Configuration --------------------
 
 /**
@@ -189,6 +241,28 @@
 #define WEAVE_DEVICE_CONFIG_USER_SELECTED_MODE_TIMEOUT_SEC 30
 #endif // WEAVE_DEVICE_CONFIG_USER_SELECTED_MODE_TIMEOUT_SEC
 
+/**
+ * WEAVE_DEVICE_CONFIG_IDENTIFY_RESPONSE_MAX_JITTER
+ *
+ * The upper bound, in milliseconds, of the random delay applied to responses to multicast
+ * Device Identify Requests.  When a commissioner identifies devices on a busy network, the
+ * delay keeps the responses of all matching devices from arriving at once.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_IDENTIFY_RESPONSE_MAX_JITTER
+#define WEAVE_DEVICE_CONFIG_IDENTIFY_RESPONSE_MAX_JITTER 250
+#endif // WEAVE_DEVICE_CONFIG_IDENTIFY_RESPONSE_MAX_JITTER
+
+/**
+ * WEAVE_DEVICE_CONFIG_DEVICE_DESCRIPTOR_CACHE_SIZE
+ *
+ * The size of the buffer in which the device's encoded device descriptor is kept for use
+ * in Device Identify Responses.  If the descriptor does not fit, it is encoded anew for
+ * every response.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_DEVICE_DESCRIPTOR_CACHE_SIZE
+#define WEAVE_DEVICE_CONFIG_DEVICE_DESCRIPTOR_CACHE_SIZE 128
+#endif // WEAVE_DEVICE_CONFIG_DEVICE_DESCRIPTOR_CACHE_SIZE
+
 // -------------------- WiFi Station Configuration --------------------
 
 /**
@@ -229,6 +303,29 @@
 #define WEAVE_DEVICE_CONFIG_WIFI_SCAN_COMPLETION_TIMEOUT 10000
 #endif
 
+/**
+ * WEAVE_DEVICE_CONFIG_WIFI_STREAMING_SCAN_MAX_CHANNEL
+ *
+ * The highest WiFi channel scanned when a NetworkProvisioning:ScanNetworks client requests streamed results.
+ * Such scans visit channels 1 through this value one at a time, sending the networks found on each channel
+ * as soon as that channel is done.  A value of 0 disables streaming; such requests then get a single
+ * all-channel scan.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_WIFI_STREAMING_SCAN_MAX_CHANNEL
+#define WEAVE_DEVICE_CONFIG_WIFI_STREAMING_SCAN_MAX_CHANNEL 13
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_WIFI_SCAN_CACHE_LIFETIME
+ *
+ * The amount of time (in milliseconds) for which the results of the last WiFi scan are considered fresh.
+ * A ScanNetworks client that requests streamed results is sent fresh cached results immediately, ahead
+ * of those of the new scan.  A value of 0 disables the use of cached results.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_WIFI_SCAN_CACHE_LIFETIME
+#define WEAVE_DEVICE_CONFIG_WIFI_SCAN_CACHE_LIFETIME 10000
+#endif
+
 /**
  * WEAVE_DEVICE_CONFIG_WIFI_CONNECTIVITY_TIMEOUT
  *
@@ -384,6 +481,60 @@
 #define WEAVE_DEVICE_CONFIG_BLE_SLOW_ADVERTISING_INTERVAL 3200
 #endif
 
+/**
+ * WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MIN
+ * WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MAX
+ *
+ * The range of connection intervals (in units of 1.25ms) the device will request from the
+ * central while a WoBLE connection is carrying data.
+ *
+ * Defaults to 6 - 12 (7.5ms - 15ms).
+ */
+#ifndef WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MIN
+#define WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MIN 6
+#endif
+#ifndef WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MAX
+#define WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MAX 12
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MIN
+ * WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MAX
+ *
+ * The range of connection intervals (in units of 1.25ms) the device will request from the
+ * central once a WoBLE connection has gone idle.
+ *
+ * Defaults to 40 - 80 (50ms - 100ms).
+ */
+#ifndef WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MIN
+#define WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MIN 40
+#endif
+#ifndef WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MAX
+#define WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MAX 80
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_BLE_CONNECTION_SUPERVISION_TIMEOUT
+ *
+ * The supervision timeout (in units of 10ms) the device will request along with either
+ * range of connection intervals.
+ *
+ * Defaults to 400 (4000ms).
+ */
+#ifndef WEAVE_DEVICE_CONFIG_BLE_CONNECTION_SUPERVISION_TIMEOUT
+#define WEAVE_DEVICE_CONFIG_BLE_CONNECTION_SUPERVISION_TIMEOUT 400
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_BLE_ENABLE_2M_PHY
+ *
+ * Request the LE 2M PHY while a WoBLE connection is carrying data, on platforms whose
+ * radio supports it.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_BLE_ENABLE_2M_PHY
+#define WEAVE_DEVICE_CONFIG_BLE_ENABLE_2M_PHY 1
+#endif
+
 // -------------------- Time Sync Configuration --------------------
 
 /**
@@ -446,6 +597,37 @@
 #define WEAVE_DEVICE_CONFIG_TIME_SYNC_TIMEOUT 10000
 #endif
 
+/**
+ * WEAVE_DEVICE_CONFIG_MAX_TIME_SYNC_INTERVAL
+ *
+ * Specifies the maximum interval (in seconds) at which the device synchronizes its real time
+ * clock with the configured Weave Time Sync server.
+ *
+ * The device estimates the drift of its clock from successive synchronizations, and lengthens
+ * the sync interval, from the configured sync interval up to this value, for as long as the
+ * drift accumulated over an interval stays within WEAVE_DEVICE_CONFIG_TIME_SYNC_DRIFT_TOLERANCE.
+ * Setting this value to the sync interval or below disables the adaptation.
+ *
+ * This value is only meaningful if WEAVE_DEVICE_CONFIG_ENABLE_WEAVE_TIME_SERVICE_TIME_SYNC has
+ * been enabled.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_MAX_TIME_SYNC_INTERVAL
+#define WEAVE_DEVICE_CONFIG_MAX_TIME_SYNC_INTERVAL 7200
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_TIME_SYNC_DRIFT_TOLERANCE
+ *
+ * Specifies the clock error (in milliseconds) the device may accumulate through drift between
+ * two time synchronizations.  Used to derive the sync interval from the estimated clock drift.
+ *
+ * This value is only meaningful if WEAVE_DEVICE_CONFIG_ENABLE_WEAVE_TIME_SERVICE_TIME_SYNC has
+ * been enabled.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_TIME_SYNC_DRIFT_TOLERANCE
+#define WEAVE_DEVICE_CONFIG_TIME_SYNC_DRIFT_TOLERANCE 250
+#endif
+
 // -------------------- Service Provisioning Configuration --------------------
 
 /**
@@ -600,6 +782,19 @@
 #define WEAVE_DEVICE_CONFIG_ENABLE_TRAIT_MANAGER 0
 #endif
 
+/**
+ * WEAVE_DEVICE_CONFIG_DEVICE_IDENTITY_TRAIT_SNAPSHOT_SIZE
+ *
+ * Size, in bytes, of the pre-encoded snapshot kept by the DeviceIdentityTrait data source.
+ *
+ * The values published by this trait rarely change after boot, so notifies carrying the whole
+ * trait copy the snapshot rather than reading every property from the configuration store.
+ * Set to 0 to disable the snapshot.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_DEVICE_IDENTITY_TRAIT_SNAPSHOT_SIZE
+#define WEAVE_DEVICE_CONFIG_DEVICE_IDENTITY_TRAIT_SNAPSHOT_SIZE 128
+#endif
+
 // -------------------- Test Configuration --------------------
 
 /**
@@ -655,6 +850,20 @@
 #define WEAVE_DEVICE_CONFIG_DISABLE_ACCOUNT_PAIRING 0
 #endif
 
+/**
+ * WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+ *
+ * Answers a RegisterServicePairAccount request as soon as the service configuration has been
+ * stored, rather than once the PairDeviceToAccount request to the service has completed.  This
+ * spares the client from waiting while the device establishes connectivity with the service.
+ * The device then pairs with the service in the background and reports the outcome with a
+ * kAccountPairingResult event.  If pairing fails, the service configuration is cleared as it
+ * would be otherwise.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+#define WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING 0
+#endif
+
 // -------------------- Network Telemetry Configuration --------------------
 
 /**
@@ -743,6 +952,33 @@
 #define WEAVE_DEVICE_CONFIG_DEFAULT_TUNNEL_TELEMETRY_INTERVAL_MS 300000
 #endif
 
+/**
+ *  @def WEAVE_DEVICE_CONFIG_TELEMETRY_MAX_SUPPRESSED_INTERVAL_MS
+ *
+ *  @brief
+ *    Network telemetry is sampled at the telemetry intervals, but a telemetry
+ *    event is only logged when one of its metrics has changed since the last
+ *    logged event, or when that event was logged longer ago than this interval.
+ *    Set to 0 to log an event for every sample.
+ *
+ */
+#ifndef WEAVE_DEVICE_CONFIG_TELEMETRY_MAX_SUPPRESSED_INTERVAL_MS
+#define WEAVE_DEVICE_CONFIG_TELEMETRY_MAX_SUPPRESSED_INTERVAL_MS 3600000
+#endif
+
+/**
+ *  @def WEAVE_DEVICE_CONFIG_TELEMETRY_RSSI_RESOLUTION
+ *
+ *  @brief
+ *    The size, in dB, of the smallest change in a sampled RSSI value that
+ *    counts as a change of the telemetry it is part of.  Smaller moves are
+ *    only reflected in the min/max/average summary of the reporting window.
+ *
+ */
+#ifndef WEAVE_DEVICE_CONFIG_TELEMETRY_RSSI_RESOLUTION
+#define WEAVE_DEVICE_CONFIG_TELEMETRY_RSSI_RESOLUTION 6
+#endif
+
 // -------------------- Event Logging Configuration --------------------
 
 /**
@@ -969,4 +1205,80 @@
  */
 #define WEAVE_DEVICE_CONFIG_SWU_BDX_BLOCK_SIZE		1024
 
+/**
+ * WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH
+ *
+ * Compute the SHA-256 integrity value of a software image as its blocks are stored,
+ * rather than asking the application to read the stored image back with a
+ * ComputeImageIntegrity event once the download completes.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH
+#define WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH 1
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_SWU_PROGRESS_PERSIST_INTERVAL
+ *
+ * Specifies the number of image bytes stored between updates of the persisted download
+ * progress, which records how much of an image has been downloaded so that an interrupted
+ * download can be resumed.  0 updates the progress after every block.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_SWU_PROGRESS_PERSIST_INTERVAL
+#define WEAVE_DEVICE_CONFIG_SWU_PROGRESS_PERSIST_INTERVAL 0
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_SWU_PERSIST_HASH_STATE
+ *
+ * Include the state of the running image hash in the persisted download progress, so that
+ * a resumed download still has its integrity value computed as it is stored.
+ *
+ * The state is persisted as the raw SHA-256 context.  Platforms whose SHA-256 implementation
+ * keeps state outside of the context, e.g. in a hardware engine, must set this to 0.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_SWU_PERSIST_HASH_STATE
+#define WEAVE_DEVICE_CONFIG_SWU_PERSIST_HASH_STATE 1
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+ *
+ * Specifies the size, in bytes, of the batches in which downloaded image blocks are handed to
+ * the application with StoreImageBlock events.  0 hands over each block as it is received.
+ *
+ * When non-zero, two batch buffers of this size are used, so that the application can write
+ * one batch to storage asynchronously, completing it with StoreImageBlockComplete(), while the
+ * next one is downloaded.  The download is paused if it gets ahead of storage.  All batches
+ * other than the first and last one start and end on multiples of this size within the image,
+ * so it is typically set to the flash page or write unit size.  It must be a multiple of 4, and
+ * no smaller than the largest block the download delivers (WEAVE_DEVICE_CONFIG_SWU_BDX_BLOCK_SIZE
+ * over BDX).
+ */
+#ifndef WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+#define WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE 0
+#endif
+
+#if (WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE % 4) != 0
+#error "WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE must be a multiple of 4."
+#endif
+
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE && (WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE < WEAVE_DEVICE_CONFIG_SWU_BDX_BLOCK_SIZE)
+#error "WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE must be at least WEAVE_DEVICE_CONFIG_SWU_BDX_BLOCK_SIZE."
+#endif
+
+/**
+ * WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+ *
+ * Specifies the size, in bytes, of the buffer through which the installed image is read while
+ * a delta image is applied.  0 disables support for delta images.
+ *
+ * Delta images describe a new image in terms of the installed image, and are only offered to
+ * applications that identify their installed image when preparing the image query (see
+ * SoftwareUpdateManager::kEvent_PrepareQuery).  Larger buffers mean fewer, larger,
+ * ReadInstalledImage and StoreImageBlock events.
+ */
+#ifndef WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+#define WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE 0
+#endif
+
 #endif // WEAVE_DEVICE_CONFIG_H
@@ -196,6 +196,15 @@ enum PublicEventTypes
      * Signals that the state of WoBLE advertising has changed.
      */
     kWoBLEAdvertisingChange,
+
+    /**
+     * Account Pairing Result
+     *
+     * Signals the outcome of pairing the device to a user account with the service, when that
+     * completes after the RegisterServicePairAccount request has been answered (see
+     * #WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING).
+     */
+    kAccountPairingResult,
 };
 
 /**
@@ -349,6 +358,12 @@ struct WeaveDeviceEvent final
             bool IsPairedToAccount;
         } AccountPairingChange;
         struct
+        {
+            WEAVE_ERROR Error;
+            uint32_t StatusReportProfileId;
+            uint16_t StatusReportStatusCode;
+        } AccountPairingResult;
+        struct
         {
             bool IsTimeSynchronized;
         } TimeSyncChange;
@@ -63,6 +63,7 @@ public:
     WEAVE_ERROR GetDeviceName(char * buf, size_t bufSize);
     WEAVE_ERROR SetDeviceName(const char * deviceName);
     uint16_t NumConnections(void);
+    WEAVE_ERROR SetHighThroughputEnabled(BLE_CONNECTION_OBJECT conId, bool val);
     void OnPlatformEvent(const WeaveDeviceEvent * event);
     ::nl::Ble::BleLayer * GetBleLayer(void) const;
 
@@ -169,6 +170,11 @@ inline uint16_t BLEManager::NumConnections(void)
     return static_cast<ImplClass*>(this)->_NumConnections();
 }
 
+inline WEAVE_ERROR BLEManager::SetHighThroughputEnabled(BLE_CONNECTION_OBJECT conId, bool val)
+{
+    return static_cast<ImplClass*>(this)->_SetHighThroughputEnabled(conId, val);
+}
+
 inline void BLEManager::OnPlatformEvent(const WeaveDeviceEvent * event)
 {
     static_cast<ImplClass*>(this)->_OnPlatformEvent(event);
@@ -0,0 +1,197 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Defines a small RAM cache of scalar configuration values, for use by
+ *          platform configuration stores.
+ */
+
+#ifndef CONFIG_VALUE_CACHE_H
+#define CONFIG_VALUE_CACHE_H
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+
+namespace nl {
+namespace Weave {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * A write-through RAM cache of scalar (bool, uint32_t, uint64_t) configuration values.
+ *
+ * Platform configuration stores consult the cache before reading a scalar value from persistent
+ * storage, and update it after every successful read, write or erase, so that the repeated reads
+ * of values such as the fabric id or fail-safe state made by the generic configuration manager
+ * are served from RAM.  The cache also remembers values that are known to be absent.  A write of
+ * a value equal to the cached one can be skipped entirely, sparing the flash.
+ *
+ * Entries are replaced in round-robin order once the cache is full.  The cache is not
+ * thread-safe; callers must hold the Weave stack lock, as is required of all configuration
+ * accesses.
+ *
+ * @tparam KeyType      The platform's key type.  Must be copyable and comparable with ==, and
+ *                      must not refer to storage that the caller may release.
+ * @tparam CacheSize    The number of entries in the cache.  A size of 0 disables caching.
+ */
+template<typename KeyType, size_t CacheSize>
+class ConfigValueCache
+{
+public:
+
+    /**
+     * Look up a cached value.
+     *
+     * @param[in]  key      The key to look up.
+     * @param[out] val      The cached value, if one is present.
+     * @param[out] exists   Whether the value exists in persistent storage.
+     *
+     * @return true if the cache holds the state of the given key.
+     */
+    bool Lookup(const KeyType & key, uint64_t & val, bool & exists) const
+    {
+        const Entry * entry = Find(key);
+        if (entry == NULL)
+        {
+            return false;
+        }
+        val = entry->Value;
+        exists = entry->Exists;
+        return true;
+    }
+
+    /** Returns true if the given value is known to be stored under the given key. */
+    bool Contains(const KeyType & key, uint64_t val) const
+    {
+        const Entry * entry = Find(key);
+        return entry != NULL && entry->Exists && entry->Value == val;
+    }
+
+    /** Record the value of the given key, as read from or written to persistent storage. */
+    void Store(const KeyType & key, uint64_t val)
+    {
+        Entry * entry = FindOrAllocate(key);
+        entry->Value = val;
+        entry->Exists = true;
+    }
+
+    /** Record that the given key has no value in persistent storage. */
+    void StoreNotFound(const KeyType & key)
+    {
+        Entry * entry = FindOrAllocate(key);
+        entry->Value = 0;
+        entry->Exists = false;
+    }
+
+    /** Forget anything known about the given key, e.g. after it was written with a non-scalar type. */
+    void Invalidate(const KeyType & key)
+    {
+        Entry * entry = Find(key);
+        if (entry != NULL)
+        {
+            entry->InUse = false;
+        }
+    }
+
+    /** Forget all cached values, e.g. after a namespace or file was erased. */
+    void Clear(void)
+    {
+        for (size_t i = 0; i < CacheSize; i++)
+        {
+            mEntries[i].InUse = false;
+        }
+    }
+
+private:
+
+    struct Entry
+    {
+        KeyType Key;
+        uint64_t Value;
+        bool Exists;
+        bool InUse;
+    };
+
+    Entry mEntries[CacheSize];
+    size_t mNextVictim;
+
+    const Entry * Find(const KeyType & key) const
+    {
+        for (size_t i = 0; i < CacheSize; i++)
+        {
+            if (mEntries[i].InUse && mEntries[i].Key == key)
+            {
+                return &mEntries[i];
+            }
+        }
+        return NULL;
+    }
+
+    Entry * Find(const KeyType & key)
+    {
+        return const_cast<Entry *>(static_cast<const ConfigValueCache *>(this)->Find(key));
+    }
+
+    Entry * FindOrAllocate(const KeyType & key)
+    {
+        Entry * entry = Find(key);
+
+        if (entry == NULL)
+        {
+            // Prefer an unused entry; otherwise replace entries in turn.
+            for (size_t i = 0; i < CacheSize && entry == NULL; i++)
+            {
+                if (!mEntries[i].InUse)
+                {
+                    entry = &mEntries[i];
+                }
+            }
+            if (entry == NULL)
+            {
+                entry = &mEntries[mNextVictim];
+                mNextVictim = (mNextVictim + 1) % CacheSize;
+            }
+            entry->Key = key;
+            entry->InUse = true;
+        }
+
+        return entry;
+    }
+};
+
+/**
+ * Specialization of ConfigValueCache<> used when caching is disabled.
+ */
+template<typename KeyType>
+class ConfigValueCache<KeyType, 0>
+{
+public:
+    bool Lookup(const KeyType & key, uint64_t & val, bool & exists) const { return false; }
+    bool Contains(const KeyType & key, uint64_t val) const { return false; }
+    void Store(const KeyType & key, uint64_t val) { }
+    void StoreNotFound(const KeyType & key) { }
+    void Invalidate(const KeyType & key) { }
+    void Clear(void) { }
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace Weave
+} // namespace nl
+
+#endif // CONFIG_VALUE_CACHE_H
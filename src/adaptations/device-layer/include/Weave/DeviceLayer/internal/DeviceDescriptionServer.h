@@ -50,6 +50,7 @@ public:
     void SetUserSelectedMode(bool val);
     uint16_t GetUserSelectedModeTimeout(void);
     void SetUserSelectedModeTimeout(uint16_t val);
+    void InvalidateDeviceDescriptorCache(void);
 
     void OnPlatformEvent(const WeaveDeviceEvent * event);
 
@@ -70,6 +71,8 @@ private:
 
     uint32_t mUserSelectedModeEndTime; // Monotonic system time scaled to units of 1024ms.
     uint16_t mUserSelectedModeTimeoutSec;
+    uint16_t mEncodedDeviceDescLen;    // Zero when the cache is empty.
+    uint8_t mEncodedDeviceDesc[WEAVE_DEVICE_CONFIG_DEVICE_DESCRIPTOR_CACHE_SIZE];
 
     static void HandleIdentifyRequest(void *appState, uint64_t nodeId, const IPAddress& nodeAddr,
             const ::nl::Weave::Profiles::DeviceDescription::IdentifyRequestMessage& reqMsg, bool& sendResp,
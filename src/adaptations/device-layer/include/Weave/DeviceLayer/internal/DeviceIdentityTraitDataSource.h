@@ -45,9 +45,15 @@ class DeviceIdentityTraitDataSource final
 public:
     DeviceIdentityTraitDataSource(void);
 
+    void OnFabricMembershipChange(void);
+
 private:
     WEAVE_ERROR GetLeafData(::nl::Weave::Profiles::DataManagement_Current::PropertyPathHandle aLeafHandle, uint64_t aTagToWrite,
                     ::nl::Weave::TLV::TLVWriter & aWriter) override;
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT && WEAVE_DEVICE_CONFIG_DEVICE_IDENTITY_TRAIT_SNAPSHOT_SIZE > 0
+    uint8_t mSnapshot[WEAVE_DEVICE_CONFIG_DEVICE_IDENTITY_TRAIT_SNAPSHOT_SIZE];
+#endif
 };
 
 } // Internal
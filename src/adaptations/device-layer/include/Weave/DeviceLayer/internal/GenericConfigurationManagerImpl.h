@@ -99,6 +99,9 @@ public:
     WEAVE_ERROR _ClearServiceProvisioningData();
     WEAVE_ERROR _GetFailSafeArmed(bool & val);
     WEAVE_ERROR _SetFailSafeArmed(bool val);
+    WEAVE_ERROR _GetSoftwareUpdateProgress(uint8_t * buf, size_t bufSize, size_t & progressLen);
+    WEAVE_ERROR _StoreSoftwareUpdateProgress(const uint8_t * progress, size_t progressLen);
+    WEAVE_ERROR _ClearSoftwareUpdateProgress(void);
     WEAVE_ERROR _GetDeviceDescriptor(::nl::Weave::Profiles::DeviceDescription::WeaveDeviceDescriptor & deviceDesc);
     WEAVE_ERROR _GetDeviceDescriptorTLV(uint8_t * buf, size_t bufSize, size_t & encodedLen);
     WEAVE_ERROR _GetQRCodeString(char * buf, size_t bufSize);
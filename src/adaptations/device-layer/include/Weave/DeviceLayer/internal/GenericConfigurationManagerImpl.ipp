@@ -28,6 +28,7 @@
 
 #include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
 #include <Weave/DeviceLayer/internal/GenericConfigurationManagerImpl.h>
+#include <Weave/DeviceLayer/internal/DeviceDescriptionServer.h>
 #include <BleLayer/WeaveBleServiceData.h>
 #include <Weave/Support/Base64.h>
 
@@ -204,6 +205,7 @@ exit:
 template<class ImplClass>
 WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreSerialNumber(const char * serialNum, size_t serialNumLen)
 {
+    DeviceDescriptionSvr().InvalidateDeviceDescriptorCache();
     return Impl()->WriteConfigValueStr(ImplClass::kConfigKey_SerialNum, serialNum, serialNumLen);
 }
 
@@ -258,6 +260,7 @@ inline WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_GetProductRevisi
 template<class ImplClass>
 inline WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreProductRevision(uint16_t productRev)
 {
+    DeviceDescriptionSvr().InvalidateDeviceDescriptorCache();
     return Impl()->WriteConfigValue(ImplClass::kConfigKey_ProductRevision, (uint32_t)productRev);
 }
 
@@ -297,6 +300,7 @@ exit:
 template<class ImplClass>
 WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreManufacturingDate(const char * mfgDate, size_t mfgDateLen)
 {
+    DeviceDescriptionSvr().InvalidateDeviceDescriptorCache();
     return Impl()->WriteConfigValueStr(ImplClass::kConfigKey_ManufacturingDate, mfgDate, mfgDateLen);
 }
 
@@ -504,10 +508,12 @@ WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreDevicePrivateKey(c
 template<class ImplClass>
 WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_ClearOperationalDeviceCredentials(void)
 {
+    Impl()->BeginWriteBatch();
     Impl()->ClearConfigValue(ImplClass::kConfigKey_OperationalDeviceId);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_OperationalDeviceCert);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_OperationalDeviceICACerts);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_OperationalDevicePrivateKey);
+    Impl()->CommitWriteBatch();
 
     ClearFlag(mFlags, kFlag_OperationalDeviceCredentialsProvisioned);
 
@@ -635,6 +641,10 @@ WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreServiceProvisionin
 {
     WEAVE_ERROR err;
 
+    // Commit the provisioning data to persistent storage as a unit.
+    err = Impl()->BeginWriteBatch();
+    SuccessOrExit(err);
+
     err = Impl()->WriteConfigValue(ImplClass::kConfigKey_ServiceId, serviceId);
     SuccessOrExit(err);
 
@@ -644,6 +654,9 @@ WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreServiceProvisionin
     err = _StorePairedAccountId(accountId, accountIdLen);
     SuccessOrExit(err);
 
+    err = Impl()->CommitWriteBatch();
+    SuccessOrExit(err);
+
     SetFlag(mFlags, kFlag_IsServiceProvisioned);
     SetFlag(mFlags, kFlag_IsPairedToAccount, (accountId != NULL && accountIdLen != 0));
 
@@ -653,6 +666,7 @@ exit:
         Impl()->ClearConfigValue(ImplClass::kConfigKey_ServiceId);
         Impl()->ClearConfigValue(ImplClass::kConfigKey_ServiceConfig);
         Impl()->ClearConfigValue(ImplClass::kConfigKey_PairedAccountId);
+        Impl()->CommitWriteBatch();
         ClearFlag(mFlags, kFlag_IsServiceProvisioned);
         ClearFlag(mFlags, kFlag_IsPairedToAccount);
     }
@@ -662,9 +676,11 @@ exit:
 template<class ImplClass>
 WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_ClearServiceProvisioningData()
 {
+    Impl()->BeginWriteBatch();
     Impl()->ClearConfigValue(ImplClass::kConfigKey_ServiceId);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_ServiceConfig);
     Impl()->ClearConfigValue(ImplClass::kConfigKey_PairedAccountId);
+    Impl()->CommitWriteBatch();
 
     // TODO: Move these behaviors out of configuration manager.
 
@@ -707,6 +723,24 @@ WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_SetFailSafeArmed(bool v
     return Impl()->WriteConfigValue(ImplClass::kConfigKey_FailSafeArmed, val);
 }
 
+template<class ImplClass>
+WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_GetSoftwareUpdateProgress(uint8_t * buf, size_t bufSize, size_t & progressLen)
+{
+    return Impl()->ReadConfigValueBin(ImplClass::kConfigKey_SoftwareUpdateProgress, buf, bufSize, progressLen);
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_StoreSoftwareUpdateProgress(const uint8_t * progress, size_t progressLen)
+{
+    return Impl()->WriteConfigValueBin(ImplClass::kConfigKey_SoftwareUpdateProgress, progress, progressLen);
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_ClearSoftwareUpdateProgress(void)
+{
+    return Impl()->ClearConfigValue(ImplClass::kConfigKey_SoftwareUpdateProgress);
+}
+
 template<class ImplClass>
 WEAVE_ERROR GenericConfigurationManagerImpl<ImplClass>::_GetDeviceDescriptor(::nl::Weave::Profiles::DeviceDescription::WeaveDeviceDescriptor & deviceDesc)
 {
@@ -25,6 +25,8 @@
 #ifndef GENERIC_PLATFORM_MANAGER_IMPL_H
 #define GENERIC_PLATFORM_MANAGER_IMPL_H
 
+#include <Weave/DeviceLayer/internal/LockFreeSnapshot.h>
+
 namespace nl {
 namespace Weave {
 namespace DeviceLayer {
@@ -59,6 +61,7 @@ protected:
     void _RemoveEventHandler(PlatformManager::EventHandlerFunct handler, intptr_t arg);
     void _ScheduleWork(AsyncWorkFunct workFunct, intptr_t arg);
     void _DispatchEvent(const WeaveDeviceEvent * event);
+    void _GetDeviceState(DeviceStateSnapshot & state);
 
     // ===== Support methods that can be overridden by the implementation subclass.
 
@@ -68,9 +71,21 @@ protected:
     static void HandleSessionEstablished(WeaveSecurityManager * sm, WeaveConnection * con,
             void * reqState, uint16_t sessionKeyId, uint64_t peerNodeId, uint8_t encType);
     static void HandleMessageLayerActivityChanged(bool messageLayerIsActive);
+    void UpdateDeviceState(void);
 
 private:
+    LockFreeSnapshot<DeviceStateSnapshot> mDeviceState;
     bool mMsgLayerWasActive;
+#if WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT
+    bool mDeferredInitPending;
+#endif
+
+    WEAVE_ERROR InitDeferrableServices(void);
+#if WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT
+    void CompleteDeferredInit(void);
+    static void HandleDeferredInit(System::Layer * aLayer, void * aAppState, System::Error aError);
+#endif
+    static void LogInitStageTime(const char * stageName, uint64_t & stageStartTime);
 
     ImplClass * Impl() { return static_cast<ImplClass*>(this); }
 };
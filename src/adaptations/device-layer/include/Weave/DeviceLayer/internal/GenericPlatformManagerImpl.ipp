@@ -56,6 +56,8 @@ template<class ImplClass>
 WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack(void)
 {
     WEAVE_ERROR err;
+    uint64_t initStartTime = System::Layer::GetClock_MonotonicMS();
+    uint64_t stageStartTime = initStartTime;
 
     mMsgLayerWasActive = false;
 
@@ -73,6 +75,7 @@ WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack(void)
         WeaveLogError(DeviceLayer, "Configuration Manager initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
+    LogInitStageTime("Configuration Manager", stageStartTime);
 
     // Initialize the Weave system layer.
     new (&SystemLayer) System::Layer();
@@ -91,6 +94,7 @@ WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack(void)
         WeaveLogError(DeviceLayer, "InetLayer initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
+    LogInitStageTime("System and Inet layers", stageStartTime);
 
     // Initialize the Weave fabric state object.
     new (&FabricState) WeaveFabricState();
@@ -158,6 +162,8 @@ WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack(void)
     SecurityMgr.CASEUseKnownECDHKey = true;
 #endif
 
+    LogInitStageTime("Fabric state, messaging and security", stageStartTime);
+
     // Perform dynamic configuration of the core Weave objects based on stored settings.
     //
     // NB: In general, initialization of Device Layer objects should happen *after* this call
@@ -170,6 +176,7 @@ WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack(void)
         WeaveLogError(DeviceLayer, "ConfigureWeaveStack failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
+    LogInitStageTime("ConfigureWeaveStack", stageStartTime);
 
 #if WEAVE_CONFIG_ENABLE_SERVICE_DIRECTORY
     // Initialize the service directory manager.
@@ -185,6 +192,7 @@ WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack(void)
         WeaveLogError(DeviceLayer, "BLEManager initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
+    LogInitStageTime("BLE Manager", stageStartTime);
 #endif
 
     // Initialize the Connectivity Manager object.
@@ -194,90 +202,127 @@ WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack(void)
         WeaveLogError(DeviceLayer, "Connectivity Manager initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
+    LogInitStageTime("Connectivity Manager", stageStartTime);
 
-    // Initialize the Device Control server.
-    err = DeviceControlSvr().Init();
+    // Initialize the Device Description server.
+    err = DeviceDescriptionSvr().Init();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Weave Device Control server initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Weave Device Description server initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
 
-    // Initialize the Device Description server.
-    err = DeviceDescriptionSvr().Init();
+#if WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT
+    // Initialize the remaining servers once the event loop is running.  The work queued by the
+    // Connectivity Manager to start the network connection runs first, so that the connection
+    // attempt proceeds while they are initialized.
+    mDeferredInitPending = true;
+    err = SystemLayer.ScheduleWork(HandleDeferredInit, this);
+    SuccessOrExit(err);
+#else
+    err = InitDeferrableServices();
+    SuccessOrExit(err);
+#endif
+
+    // Initialize Weave Event Logging.
+    err = InitWeaveEventLogging();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Weave Device Description server initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Event Logging initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
+    LogInitStageTime("Event Logging", stageStartTime);
 
-    // Initialize the Network Provisioning server.
-    err = NetworkProvisioningSvr().Init();
+    // Initialize the Trait Manager object.
+#if WEAVE_DEVICE_CONFIG_ENABLE_TRAIT_MANAGER
+    err = TraitMgr().Init();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Weave Network Provisioning server initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Trait Manager initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
+    LogInitStageTime("Trait Manager", stageStartTime);
+#endif // WEAVE_DEVICE_CONFIG_ENABLE_TRAIT_MANAGER
 
-    // Initialize the Fabric Provisioning server.
-    err = FabricProvisioningSvr().Init();
+    // Initialize the Time Sync Manager object.
+    err = TimeSyncMgr().Init();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Weave Fabric Provisioning server initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Time Sync Manager initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
+    LogInitStageTime("Time Sync Manager", stageStartTime);
 
-    // Initialize the Service Provisioning server.
-    err = ServiceProvisioningSvr().Init();
+    // Initialize the Software Update Manager object.
+#if WEAVE_DEVICE_CONFIG_ENABLE_SOFTWARE_UPDATE_MANAGER
+    err = SoftwareUpdateMgr().Init();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Weave Service Provisioning server initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Software Update Manager initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
+    LogInitStageTime("Software Update Manager", stageStartTime);
+#endif // WEAVE_DEVICE_CONFIG_ENABLE_SOFTWARE_UPDATE_MANAGER
 
-    // Initialize the Echo server.
-    err = EchoSvr().Init();
+    UpdateDeviceState();
+
+    WeaveLogProgress(DeviceLayer, "Weave stack initialized in %" PRIu32 " ms",
+                     static_cast<uint32_t>(System::Layer::GetClock_MonotonicMS() - initStartTime));
+
+exit:
+    return err;
+}
+
+/**
+ * Initialize the servers and services that nothing else in the Device Layer depends on, and that
+ * the application does not configure.  Their initialization may be deferred until the event loop
+ * is running (see WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT).
+ */
+template<class ImplClass>
+WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::InitDeferrableServices(void)
+{
+    WEAVE_ERROR err;
+    uint64_t stageStartTime = System::Layer::GetClock_MonotonicMS();
+
+    // Initialize the Device Control server.
+    err = DeviceControlSvr().Init();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Weave Echo server initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Weave Device Control server initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
 
-    // Initialize Weave Event Logging.
-    err = InitWeaveEventLogging();
+    // Initialize the Network Provisioning server.
+    err = NetworkProvisioningSvr().Init();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Event Logging initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Weave Network Provisioning server initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
 
-    // Initialize the Trait Manager object.
-#if WEAVE_DEVICE_CONFIG_ENABLE_TRAIT_MANAGER
-    err = TraitMgr().Init();
+    // Initialize the Fabric Provisioning server.
+    err = FabricProvisioningSvr().Init();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Trait Manager initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Weave Fabric Provisioning server initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
-#endif // WEAVE_DEVICE_CONFIG_ENABLE_TRAIT_MANAGER
 
-    // Initialize the Time Sync Manager object.
-    err = TimeSyncMgr().Init();
+    // Initialize the Service Provisioning server.
+    err = ServiceProvisioningSvr().Init();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Time Sync Manager initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Weave Service Provisioning server initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
 
-    // Initialize the Software Update Manager object.
-#if WEAVE_DEVICE_CONFIG_ENABLE_SOFTWARE_UPDATE_MANAGER
-    err = SoftwareUpdateMgr().Init();
+    // Initialize the Echo server.
+    err = EchoSvr().Init();
     if (err != WEAVE_NO_ERROR)
     {
-        WeaveLogError(DeviceLayer, "Software Update Manager initialization failed: %s", ErrorStr(err));
+        WeaveLogError(DeviceLayer, "Weave Echo server initialization failed: %s", ErrorStr(err));
     }
     SuccessOrExit(err);
-#endif // WEAVE_DEVICE_CONFIG_ENABLE_SOFTWARE_UPDATE_MANAGER
 
 #if WEAVE_DEVICE_CONFIG_ENABLE_NETWORK_TELEMETRY
     err = NetworkTelemetryMgr().Init();
@@ -288,10 +333,44 @@ WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::_InitWeaveStack(void)
     SuccessOrExit(err);
 #endif // WEAVE_DEVICE_CONFIG_ENABLE_NETWORK_TELEMETRY
 
+    LogInitStageTime("Servers", stageStartTime);
+
 exit:
     return err;
 }
 
+#if WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT
+
+template<class ImplClass>
+void GenericPlatformManagerImpl<ImplClass>::CompleteDeferredInit(void)
+{
+    if (mDeferredInitPending)
+    {
+        mDeferredInitPending = false;
+
+        // Failures have already been logged; the rest of the stack carries on without the failed server.
+        InitDeferrableServices();
+    }
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl<ImplClass>::HandleDeferredInit(System::Layer * aLayer, void * aAppState, System::Error aError)
+{
+    static_cast<GenericPlatformManagerImpl<ImplClass> *>(aAppState)->CompleteDeferredInit();
+}
+
+#endif // WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT
+
+template<class ImplClass>
+void GenericPlatformManagerImpl<ImplClass>::LogInitStageTime(const char * stageName, uint64_t & stageStartTime)
+{
+    uint64_t now = System::Layer::GetClock_MonotonicMS();
+
+    WeaveLogDetail(DeviceLayer, "%s initialized in %" PRIu32 " ms", stageName, static_cast<uint32_t>(now - stageStartTime));
+
+    stageStartTime = now;
+}
+
 template<class ImplClass>
 WEAVE_ERROR GenericPlatformManagerImpl<ImplClass>::_AddEventHandler(PlatformManager::EventHandlerFunct handler, intptr_t arg)
 {
@@ -352,6 +431,34 @@ void GenericPlatformManagerImpl<ImplClass>::_ScheduleWork(AsyncWorkFunct workFun
     Impl()->PostEvent(&event);
 }
 
+template<class ImplClass>
+void GenericPlatformManagerImpl<ImplClass>::_GetDeviceState(DeviceStateSnapshot & state)
+{
+    mDeviceState.Get(state);
+}
+
+template<class ImplClass>
+void GenericPlatformManagerImpl<ImplClass>::UpdateDeviceState(void)
+{
+    DeviceStateSnapshot state;
+
+    memset(&state, 0, sizeof(state));
+
+    state.DeviceId = FabricState.LocalNodeId;
+    state.FabricId = FabricState.FabricId;
+    state.IsMemberOfFabric = ConfigurationMgr().IsMemberOfFabric();
+    state.IsServiceProvisioned = ConfigurationMgr().IsServiceProvisioned();
+    state.IsPairedToAccount = ConfigurationMgr().IsPairedToAccount();
+    state.IsWiFiStationConnected = ConnectivityMgr().IsWiFiStationConnected();
+    state.IsThreadAttached = ConnectivityMgr().IsThreadAttached();
+    state.HaveIPv4InternetConnectivity = ConnectivityMgr().HaveIPv4InternetConnectivity();
+    state.HaveIPv6InternetConnectivity = ConnectivityMgr().HaveIPv6InternetConnectivity();
+    state.IsServiceTunnelConnected = ConnectivityMgr().IsServiceTunnelConnected();
+    state.HaveServiceConnectivity = ConnectivityMgr().HaveServiceConnectivity();
+
+    mDeviceState.Set(state);
+}
+
 template<class ImplClass>
 void GenericPlatformManagerImpl<ImplClass>::_DispatchEvent(const WeaveDeviceEvent * event)
 {
@@ -376,9 +483,32 @@ void GenericPlatformManagerImpl<ImplClass>::_DispatchEvent(const WeaveDeviceEven
         break;
 
     default:
+#if WEAVE_DEVICE_CONFIG_DEFER_SERVER_INIT
+        // Make sure the servers are initialized before any of them is handed an event.
+        CompleteDeferredInit();
+#endif
+
         // For all other events, deliver the event to each of the components in the Device Layer.
         Impl()->DispatchEventToDeviceLayer(event);
 
+        // Refresh the lock-free device state snapshot before the application hears of the change.
+        switch (event->Type)
+        {
+        case DeviceEventType::kWiFiConnectivityChange:
+        case DeviceEventType::kThreadConnectivityChange:
+        case DeviceEventType::kInternetConnectivityChange:
+        case DeviceEventType::kServiceTunnelStateChange:
+        case DeviceEventType::kServiceConnectivityChange:
+        case DeviceEventType::kFabricMembershipChange:
+        case DeviceEventType::kServiceProvisioningChange:
+        case DeviceEventType::kAccountPairingChange:
+        case DeviceEventType::kThreadStateChange:
+            UpdateDeviceState();
+            break;
+        default:
+            break;
+        }
+
         // If the event is not an internal event, also deliver it to the application's registered
         // event handlers.
         if (!event->IsInternal())
@@ -28,6 +28,8 @@
 // #if WEAVE_DEVICE_CONFIG_ENABLE_SOFTWARE_UPDATE_MANAGER
 
 #include <Weave/DeviceLayer/SoftwareUpdateManager.h>
+#include <Weave/Support/crypto/HashAlgos.h>
+#include <Weave/Profiles/software-update/DeltaImageDecoder.h>
 
 namespace nl {
 namespace Weave {
@@ -46,6 +48,8 @@ template<class ImplClass>
 class GenericSoftwareUpdateManagerImpl
 {
     using StatusReport = ::nl::Weave::Profiles::StatusReporting::StatusReport;
+    using SHA256 = ::nl::Weave::Platform::Security::SHA256;
+    using DeltaImageDecoder = ::nl::Weave::Profiles::SoftwareUpdate::DeltaImageDecoder;
 
 protected:
     // ===== Methods that implement the SoftwareUpdateManager abstract interface.
@@ -62,6 +66,7 @@ protected:
     WEAVE_ERROR _Abort(void);
     WEAVE_ERROR _CheckNow(void);
     WEAVE_ERROR _PrepareImageStorageComplete(WEAVE_ERROR aError);
+    WEAVE_ERROR _StoreImageBlockComplete(WEAVE_ERROR aError);
     WEAVE_ERROR _ImageInstallComplete(WEAVE_ERROR aError);
     WEAVE_ERROR _SetQueryIntervalWindow(uint32_t aMinWaitTimeMs, uint32_t aMaxWaitTimeMs);
     WEAVE_ERROR _SetEventCallback(void * const aAppState, const SoftwareUpdateManager::EventCallback aEventCallback);
@@ -90,8 +95,30 @@ private:
     void SendQuery(void);
     void StartImageInstall(void);
     void PrepareImageStorage(void);
+    void ComputeURIDigest(void);
+    void BeginImageProgress(void);
+    void UpdateImageProgress(uint32_t aLength, const uint8_t * aData);
 
     WEAVE_ERROR PrepareQuery(void);
+    WEAVE_ERROR ReadImageProgress(uint64_t & aOffset, bool & aHashRestored);
+    WEAVE_ERROR WriteImageProgress(void);
+    WEAVE_ERROR StoreImageData(uint32_t aLength, uint8_t * aData);
+    WEAVE_ERROR WriteImageBlock(uint32_t aLength, uint8_t * aData, bool & aIsAsync);
+
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+    void ResetImageBatches(void);
+    WEAVE_ERROR BatchImageBlock(uint32_t aLength, const uint8_t * aData);
+    WEAVE_ERROR WriteImageBatch(void);
+    WEAVE_ERROR PrepareImageRegion(void);
+    WEAVE_ERROR CompleteImageBatch(WEAVE_ERROR aError);
+    uint8_t * ImageBatch(uint8_t aIndex) { return reinterpret_cast<uint8_t *>(mImageBatches[aIndex]); }
+#endif
+
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+    bool IsDeltaImage(void) const { return mIsDeltaImage; }
+#else
+    bool IsDeltaImage(void) const { return false; }
+#endif
 
     uint32_t GetNextWaitTimeInterval(void);
     uint32_t ComputeNextScheduledWaitTimeInterval(void);
@@ -116,8 +143,31 @@ private:
                                            SoftwareUpdateManager::RetryParam & aRetryParam,
                                            uint32_t & aOutIntervalMsec);
 
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+    static WEAVE_ERROR ReadInstalledImage(void * aAppState, uint32_t aOffset, uint8_t * aBuf, uint32_t aLength);
+    static WEAVE_ERROR WriteDeltaImageData(void * aAppState, uint8_t * aData, uint32_t aLength);
+#endif
+
 private:
 
+    /**
+     * Layout of the persisted download progress record.
+     *
+     * All fields are little-endian: record version (1 byte), image offset (8 bytes),
+     * SHA-256 digest of the image URI (32 bytes), hash state flag (1 byte), followed,
+     * when the flag is set, by the raw state of the running image hash.
+     */
+    enum
+    {
+        kProgressRecordVersion      = 1,
+        kProgressRecordHeaderLen    = 1 + 8 + SHA256::kHashLength + 1,
+#if WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH && WEAVE_DEVICE_CONFIG_SWU_PERSIST_HASH_STATE
+        kProgressRecordMaxLen       = kProgressRecordHeaderLen + sizeof(SHA256),
+#else
+        kProgressRecordMaxLen       = kProgressRecordHeaderLen,
+#endif
+    };
+
     SoftwareUpdateManager::State mState;
 
     void * mAppState;
@@ -136,6 +186,38 @@ private:
 
     uint64_t mNumBytesToDownload;
     uint64_t mStartOffset;
+    uint64_t mImageOffset;
+    uint64_t mPersistedImageOffset;
+
+    uint8_t mURIDigest[SHA256::kHashLength];
+
+#if WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH
+    SHA256 mImageHash;
+    bool mImageHashValid;
+#endif
+
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+    // Word arrays, so that the batches handed to the application are aligned.
+    uint32_t mImageBatches[2][WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE / 4];
+    uint64_t mFillBatchOffset;              // Image offset of the batch being filled.
+    uint32_t mFillBatchLen;
+    uint32_t mFillBatchTargetLen;           // Length at which the batch being filled ends on a batch boundary.
+    uint32_t mWriteBatchLen;
+    uint32_t mMaxImageBlockLen;
+    uint8_t mFillBatch;
+    uint8_t mWriteBatch;
+    bool mIsBatchWriteInProgress;
+    bool mIsDownloadPaused;
+    bool mIsDownloadComplete;
+#endif
+
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+    DeltaImageDecoder mDeltaDecoder;
+    uint8_t mDeltaBuf[WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE];
+    ::nl::Weave::Profiles::SoftwareUpdate::IntegritySpec mInstalledImageSpec;
+    bool mHasInstalledImageSpec;            // The installed image was identified in the image query.
+    bool mIsDeltaImage;                     // The image being downloaded is a delta.
+#endif
 
     uint32_t mMinWaitTimeMs;
     uint32_t mMaxWaitTimeMs;
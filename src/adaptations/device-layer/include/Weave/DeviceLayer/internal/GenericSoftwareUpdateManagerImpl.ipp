@@ -29,6 +29,7 @@
 
 #include <Weave/Core/WeaveCore.h>
 #include <Weave/DeviceLayer/PlatformManager.h>
+#include <Weave/DeviceLayer/ConfigurationManager.h>
 #include <Weave/DeviceLayer/ConnectivityManager.h>
 #include <Weave/DeviceLayer/SoftwareUpdateManager.h>
 #include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
@@ -46,6 +47,7 @@ namespace DeviceLayer {
 namespace Internal {
 
 using namespace ::nl::Weave;
+using namespace ::nl::Weave::Encoding::LittleEndian;
 using namespace ::nl::Weave::TLV;
 using namespace ::nl::Weave::Profiles;
 using namespace ::nl::Weave::Profiles::Common;
@@ -71,6 +73,16 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::DoInit()
     mMinWaitTimeMs = 0;
     mMaxWaitTimeMs = 0;
 
+    mImageOffset = 0;
+    mPersistedImageOffset = 0;
+#if WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH
+    mImageHashValid = false;
+#endif
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+    mHasInstalledImageSpec = false;
+    mIsDeltaImage = false;
+#endif
+
     mState = SoftwareUpdateManager::kState_Idle;
 }
 
@@ -198,6 +210,7 @@ WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::PrepareQuery(void)
     outParam.PrepareQuery.PackageSpecification = NULL;
     outParam.PrepareQuery.DesiredLocale = NULL;
     outParam.PrepareQuery.Error = WEAVE_NO_ERROR;
+    outParam.PrepareQuery.InstalledImageSHA256 = NULL;
 
     mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_PrepareQuery, inParam, outParam);
     VerifyOrExit(mState == SoftwareUpdateManager::kState_PrepareQuery, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
@@ -206,6 +219,20 @@ WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::PrepareQuery(void)
     err = outParam.PrepareQuery.Error;
     SuccessOrExit(err);
 
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+    // Identifying the installed image is optional.  When the application does so, the server may
+    // respond with a delta image based on it.
+    mHasInstalledImageSpec = (outParam.PrepareQuery.InstalledImageSHA256 != NULL);
+    if (mHasInstalledImageSpec)
+    {
+        err = mInstalledImageSpec.init(kIntegrityType_SHA256, (uint8_t *)outParam.PrepareQuery.InstalledImageSHA256);
+        SuccessOrExit(err);
+
+        imageQuery.hasInstalledImageSpec = true;
+        imageQuery.installedImageSpec = mInstalledImageSpec;
+    }
+#endif // WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+
     err = imageQuery.version.init((uint8_t) firmwareRevLen, firmwareRev);
     SuccessOrExit(err);
 
@@ -578,12 +605,22 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::HandleImageQueryResponse(Packe
         // Save the integrity spec
         mIntegritySpec = imageQueryResponse.integritySpec;
 
+        // Only accept a delta image based on the installed image, as identified in the query.
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+        mIsDeltaImage = imageQueryResponse.isDeltaImage;
+        VerifyOrExit(!mIsDeltaImage || (mHasInstalledImageSpec && imageQueryResponse.baseImageSpec == mInstalledImageSpec),
+                     err = WEAVE_ERROR_INVALID_ARGUMENT);
+#else
+        VerifyOrExit(!imageQueryResponse.isDeltaImage, err = WEAVE_ERROR_INVALID_ARGUMENT);
+#endif
+
         // Arrange to pass query response information to the application.
         inParam.SoftwareUpdateAvailable.Priority        = imageQueryResponse.updatePriority;
         inParam.SoftwareUpdateAvailable.Condition       = imageQueryResponse.updateCondition;
         inParam.SoftwareUpdateAvailable.IntegrityType   = imageQueryResponse.integritySpec.type;
         inParam.SoftwareUpdateAvailable.Version         = versionString;
         inParam.SoftwareUpdateAvailable.URI             = mURI;
+        inParam.SoftwareUpdateAvailable.IsDeltaImage    = imageQueryResponse.isDeltaImage;
     }
 
     // Release the packet buffer.
@@ -627,16 +664,32 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::HandleImageQueryResponse(Packe
 
     case SoftwareUpdateManager::kAction_DownloadNow:
 
-        // If not ignoring partial images...
-        if (!mIgnorePartialImage)
+        // Identify the desired image in the persisted download progress record.
+        ComputeURIDigest();
+
+        // If not ignoring partial images...  Delta images are always applied from the beginning, as
+        // the state of the decoder is not persisted.
+        if (!mIgnorePartialImage && !IsDeltaImage())
         {
+            uint64_t progressOffset;
+            bool hashRestored;
+
+            // Read the download progress persisted for the desired image, if any.  This also restores
+            // the running image hash to its state at the recorded offset, when that state was persisted.
+            if (ReadImageProgress(progressOffset, hashRestored) != WEAVE_NO_ERROR)
+            {
+                progressOffset = 0;
+                hashRestored = false;
+            }
+
             inParam.Clear();
             outParam.Clear();
 
             // Call the application to determine if a partially downloaded copy of the desired firmware image
             // already exists in local storage.  Pass the URI of the desired image, which must match the metadata
-            // stored with the image.
+            // stored with the image, along with the download progress recorded for it.
             inParam.FetchPartialImageInfo.URI = mURI;
+            inParam.FetchPartialImageInfo.DownloadProgressLen = progressOffset;
             outParam.FetchPartialImageInfo.PartialImageLen = 0;
             mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_FetchPartialImageInfo, inParam, outParam);
             VerifyOrExit(mState == SoftwareUpdateManager::kState_Query, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
@@ -646,6 +699,16 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::HandleImageQueryResponse(Packe
             {
                 // Use the length of the partial image as the starting offset for the download.
                 mStartOffset = outParam.FetchPartialImageInfo.PartialImageLen;
+                mImageOffset = mStartOffset;
+                mPersistedImageOffset = mStartOffset;
+
+#if WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH
+                // The restored hash state can only be used if it covers exactly the bytes the
+                // application has stored.  Otherwise, fall back to having the application compute
+                // the integrity value once the download completes.
+                mImageHashValid = (hashRestored && progressOffset == mStartOffset &&
+                                   mIntegritySpec.type == kIntegrityType_SHA256);
+#endif
 
                 // Resume downloading the image.
                 DriveState(SoftwareUpdateManager::kState_Download);
@@ -656,6 +719,7 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::HandleImageQueryResponse(Packe
 
         // Start downloading from the image from the beginning.
         mStartOffset = 0;
+        BeginImageProgress();
 
         // Initiate the process of preparing local storage for new the image.
         DriveState(SoftwareUpdateManager::kState_PrepareImageStorage);
@@ -902,6 +966,44 @@ exit:
 
 template<class ImplClass>
 WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::StoreImageBlock(uint32_t aLength, uint8_t *aData)
+{
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+    // A delta image is applied as it is downloaded, and the new image it describes is stored.
+    if (mIsDeltaImage)
+    {
+        return mDeltaDecoder.Decode(aData, aLength);
+    }
+#endif
+
+    return StoreImageData(aLength, aData);
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::StoreImageData(uint32_t aLength, uint8_t *aData)
+{
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
+    return BatchImageBlock(aLength, aData);
+
+#else // WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
+    WEAVE_ERROR err;
+    bool isAsync;
+
+    // Asynchronous writes are only supported for batches, so IsAsync is ignored here.
+    err = WriteImageBlock(aLength, aData, isAsync);
+    SuccessOrExit(err);
+
+    UpdateImageProgress(aLength, aData);
+
+exit:
+    return err;
+
+#endif // WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::WriteImageBlock(uint32_t aLength, uint8_t * aData, bool & aIsAsync)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
@@ -911,9 +1013,17 @@ WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::StoreImageBlock(uint32_
     inParam.Clear();
     outParam.Clear();
 
+    aIsAsync = false;
+
     inParam.StoreImageBlock.DataBlockLen = aLength;
     inParam.StoreImageBlock.DataBlock = aData;
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+    // A block of a delta image can expand to any number of batches, which must then be written
+    // before the next block is taken.
+    inParam.StoreImageBlock.IsAsyncAllowed = !IsDeltaImage();
+#endif
     outParam.StoreImageBlock.Error = WEAVE_NO_ERROR;
+    outParam.StoreImageBlock.IsAsync = false;
 
     mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_StoreImageBlock, inParam, outParam);
     VerifyOrExit(mState == SoftwareUpdateManager::kState_Download, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
@@ -925,6 +1035,342 @@ WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::StoreImageBlock(uint32_
     err = outParam.StoreImageBlock.Error;
     SuccessOrExit(err);
 
+    aIsAsync = (outParam.StoreImageBlock.IsAsync && inParam.StoreImageBlock.IsAsyncAllowed);
+
+exit:
+    return err;
+}
+
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl<ImplClass>::ResetImageBatches(void)
+{
+    mFillBatchOffset = mImageOffset;
+    mFillBatchLen = 0;
+    mFillBatchTargetLen = WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE - (mFillBatchOffset % WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE);
+    mWriteBatchLen = 0;
+    mMaxImageBlockLen = 0;
+    mFillBatch = 0;
+    mWriteBatch = 0;
+    mIsBatchWriteInProgress = false;
+    mIsDownloadPaused = false;
+    mIsDownloadComplete = false;
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::BatchImageBlock(uint32_t aLength, const uint8_t * aData)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    mMaxImageBlockLen = max(mMaxImageBlockLen, aLength);
+
+    while (aLength > 0)
+    {
+        uint32_t copyLen = min(aLength, mFillBatchTargetLen - mFillBatchLen);
+
+        // The batch being filled is only full if the other one is still being written, which
+        // pausing the download below normally prevents.
+        VerifyOrExit(copyLen > 0, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+        memcpy(ImageBatch(mFillBatch) + mFillBatchLen, aData, copyLen);
+        mFillBatchLen += copyLen;
+        aData += copyLen;
+        aLength -= copyLen;
+
+        if (mFillBatchLen == mFillBatchTargetLen && !mIsBatchWriteInProgress)
+        {
+            err = WriteImageBatch();
+            SuccessOrExit(err);
+        }
+    }
+
+    // Hold off the next block if it might not fit before the batch being written completes.
+    if (mIsBatchWriteInProgress && !mIsDownloadPaused && mFillBatchTargetLen - mFillBatchLen < mMaxImageBlockLen)
+    {
+        mIsDownloadPaused = true;
+        Impl()->PauseImageDownload();
+    }
+
+exit:
+    return err;
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::WriteImageBatch(void)
+{
+    WEAVE_ERROR err;
+    bool isAsync;
+
+    // Hand the batch being filled over for writing, and start filling the other one.
+    mWriteBatch = mFillBatch;
+    mWriteBatchLen = mFillBatchLen;
+    mIsBatchWriteInProgress = true;
+
+    mFillBatch ^= 1;
+    mFillBatchOffset += mFillBatchLen;
+    mFillBatchLen = 0;
+    mFillBatchTargetLen = WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE - (mFillBatchOffset % WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE);
+
+    err = WriteImageBlock(mWriteBatchLen, ImageBatch(mWriteBatch), isAsync);
+
+    // Let the application prepare the storage for the batch now being filled while it downloads.
+    if (err == WEAVE_NO_ERROR && !mIsDownloadComplete)
+    {
+        err = PrepareImageRegion();
+    }
+
+    if (err == WEAVE_NO_ERROR && isAsync)
+    {
+        // The application will call StoreImageBlockComplete() once the batch is written.
+        ExitNow();
+    }
+
+    err = CompleteImageBatch(err);
+
+exit:
+    return err;
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::PrepareImageRegion(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    SoftwareUpdateManager::InEventParam inParam;
+    SoftwareUpdateManager::OutEventParam outParam;
+
+    // The first batch of a resumed download may start part way into a region, which
+    // then already holds stored data.
+    VerifyOrExit(mFillBatchOffset % WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE == 0, );
+
+    inParam.Clear();
+    outParam.Clear();
+
+    inParam.PrepareImageRegion.Offset = mFillBatchOffset;
+    inParam.PrepareImageRegion.Length = WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE;
+
+    mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_PrepareImageRegion, inParam, outParam);
+    VerifyOrExit(mState == SoftwareUpdateManager::kState_Download, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
+
+exit:
+    return err;
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::CompleteImageBatch(WEAVE_ERROR aError)
+{
+    WEAVE_ERROR err = aError;
+
+    mIsBatchWriteInProgress = false;
+    SuccessOrExit(err);
+
+    // The image hash and the persisted progress only cover data that has been written.
+    UpdateImageProgress(mWriteBatchLen, ImageBatch(mWriteBatch));
+
+    // Write the batch filled in the meantime, or the last, partial, batch of a completed download.
+    if (mFillBatchLen == mFillBatchTargetLen || (mIsDownloadComplete && mFillBatchLen > 0))
+    {
+        err = WriteImageBatch();
+        SuccessOrExit(err);
+    }
+    else if (mIsDownloadComplete)
+    {
+        CheckImageIntegrity();
+        ExitNow();
+    }
+
+    // Let the download continue once another block can be taken: with no batch being written,
+    // a full batch is written as soon as it fills up.
+    if (mIsDownloadPaused && (!mIsBatchWriteInProgress || mFillBatchTargetLen - mFillBatchLen >= mMaxImageBlockLen))
+    {
+        mIsDownloadPaused = false;
+        Impl()->ResumeImageDownload();
+    }
+
+exit:
+    return err;
+}
+
+#endif // WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::ReadInstalledImage(void * aAppState, uint32_t aOffset, uint8_t * aBuf,
+                                                                             uint32_t aLength)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    GenericSoftwareUpdateManagerImpl<ImplClass> * self = static_cast<GenericSoftwareUpdateManagerImpl<ImplClass> *>(aAppState);
+
+    SoftwareUpdateManager::InEventParam inParam;
+    SoftwareUpdateManager::OutEventParam outParam;
+
+    inParam.Clear();
+    outParam.Clear();
+
+    inParam.ReadInstalledImage.Offset = aOffset;
+    inParam.ReadInstalledImage.Buf = aBuf;
+    inParam.ReadInstalledImage.Length = aLength;
+    outParam.ReadInstalledImage.Error = WEAVE_NO_ERROR;
+
+    self->mEventHandlerCallback(self->mAppState, SoftwareUpdateManager::kEvent_ReadInstalledImage, inParam, outParam);
+    VerifyOrExit(self->mState == SoftwareUpdateManager::kState_Download, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
+
+    // Fail if the application didn't handle the ReadInstalledImage event.
+    VerifyOrExit(!outParam.DefaultHandlerCalled, err = WEAVE_ERROR_NOT_IMPLEMENTED);
+
+    err = outParam.ReadInstalledImage.Error;
+
+exit:
+    return err;
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::WriteDeltaImageData(void * aAppState, uint8_t * aData, uint32_t aLength)
+{
+    return static_cast<GenericSoftwareUpdateManagerImpl<ImplClass> *>(aAppState)->StoreImageData(aLength, aData);
+}
+
+#endif // WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl<ImplClass>::ComputeURIDigest(void)
+{
+    SHA256 sha;
+
+    sha.Begin();
+    sha.AddData(reinterpret_cast<const uint8_t *>(mURI), strlen(mURI));
+    sha.Finish(mURIDigest);
+}
+
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl<ImplClass>::BeginImageProgress(void)
+{
+    mImageOffset = 0;
+    mPersistedImageOffset = 0;
+
+#if WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH
+    mImageHashValid = (mIntegritySpec.type == kIntegrityType_SHA256);
+    if (mImageHashValid)
+    {
+        mImageHash.Begin();
+    }
+#endif
+
+    // Forget the progress of any previously downloaded image.
+    ConfigurationMgr().ClearSoftwareUpdateProgress();
+}
+
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl<ImplClass>::UpdateImageProgress(uint32_t aLength, const uint8_t * aData)
+{
+    WEAVE_ERROR err;
+
+#if WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH
+    if (mImageHashValid)
+    {
+        const uint8_t * data = aData;
+        uint32_t remainingLen = aLength;
+
+        while (remainingLen > 0)
+        {
+            uint16_t chunkLen = (remainingLen > UINT16_MAX) ? UINT16_MAX : static_cast<uint16_t>(remainingLen);
+
+            mImageHash.AddData(data, chunkLen);
+            data += chunkLen;
+            remainingLen -= chunkLen;
+        }
+    }
+#endif
+
+    mImageOffset += aLength;
+
+    // Persist the progress once enough new image data has been stored.
+    if (aLength > 0 && mImageOffset - mPersistedImageOffset >= WEAVE_DEVICE_CONFIG_SWU_PROGRESS_PERSIST_INTERVAL)
+    {
+        err = WriteImageProgress();
+        if (err != WEAVE_NO_ERROR)
+        {
+            WeaveLogError(DeviceLayer, "Failed to persist Software Update progress: %s", ErrorStr(err));
+        }
+    }
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::ReadImageProgress(uint64_t & aOffset, bool & aHashRestored)
+{
+    WEAVE_ERROR err;
+    uint8_t record[kProgressRecordMaxLen];
+    const uint8_t * p = record;
+    size_t recordLen;
+    uint8_t hashStatePresent;
+
+    aOffset = 0;
+    aHashRestored = false;
+
+    err = ConfigurationMgr().GetSoftwareUpdateProgress(record, sizeof(record), recordLen);
+    SuccessOrExit(err);
+
+    VerifyOrExit(recordLen >= kProgressRecordHeaderLen, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+    VerifyOrExit(Read8(p) == kProgressRecordVersion, err = WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+
+    aOffset = Read64(p);
+
+    // Ignore progress recorded for a different image.
+    VerifyOrExit(memcmp(p, mURIDigest, sizeof(mURIDigest)) == 0, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+    p += sizeof(mURIDigest);
+
+    hashStatePresent = Read8(p);
+
+#if WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH && WEAVE_DEVICE_CONFIG_SWU_PERSIST_HASH_STATE
+    if (hashStatePresent && recordLen == kProgressRecordHeaderLen + sizeof(mImageHash))
+    {
+        memcpy(&mImageHash, p, sizeof(mImageHash));
+        aHashRestored = true;
+    }
+#else
+    IgnoreUnusedVariable(hashStatePresent);
+#endif
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        aOffset = 0;
+    }
+    return err;
+}
+
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::WriteImageProgress(void)
+{
+    WEAVE_ERROR err;
+    uint8_t record[kProgressRecordMaxLen];
+    uint8_t * p = record;
+
+    Write8(p, kProgressRecordVersion);
+    Write64(p, mImageOffset);
+    memcpy(p, mURIDigest, sizeof(mURIDigest));
+    p += sizeof(mURIDigest);
+
+#if WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH && WEAVE_DEVICE_CONFIG_SWU_PERSIST_HASH_STATE
+    if (mImageHashValid)
+    {
+        Write8(p, 1);
+        memcpy(p, &mImageHash, sizeof(mImageHash));
+        p += sizeof(mImageHash);
+    }
+    else
+#endif
+    {
+        Write8(p, 0);
+    }
+
+    err = ConfigurationMgr().StoreSoftwareUpdateProgress(record, p - record);
+    SuccessOrExit(err);
+
+    mPersistedImageOffset = mImageOffset;
+
 exit:
     return err;
 }
@@ -966,6 +1412,16 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::StartDownload(intptr_t arg)
     self->mEventHandlerCallback(self->mAppState, SoftwareUpdateManager::kEvent_StartImageDownload, inParam, outParam);
     VerifyOrExit(self->mState == SoftwareUpdateManager::kState_Download, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
 
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+    self->ResetImageBatches();
+
+    err = self->PrepareImageRegion();
+    SuccessOrExit(err);
+#endif
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+    self->mDeltaDecoder.Init(self, ReadInstalledImage, WriteDeltaImageData, self->mDeltaBuf, sizeof(self->mDeltaBuf));
+#endif
+
     err = self->Impl()->StartImageDownload(self->mURI, self->mStartOffset);
     SuccessOrExit(err);
 
@@ -997,8 +1453,42 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::DownloadComplete()
     evOptions.relatedEventID = mEventId;
     nl::LogEvent(&ev, evOptions);
 
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE || WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+#endif
+
+#if WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+    // Fail if the delta image was cut short.
+    if (mIsDeltaImage)
+    {
+        err = mDeltaDecoder.Finish();
+        SuccessOrExit(err);
+    }
+#endif
+
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+    mIsDownloadComplete = true;
+
+    // If a batch is still being written, the image is checked once the remaining batches are.
+    VerifyOrExit(!mIsBatchWriteInProgress, );
+
+    if (mFillBatchLen > 0)
+    {
+        err = WriteImageBatch();
+        ExitNow();
+    }
+#endif // WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
     // Download is complete. Check Image Integrity.
     CheckImageIntegrity();
+
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE || WEAVE_DEVICE_CONFIG_SWU_DELTA_BUFFER_SIZE
+exit:
+    if (err != WEAVE_NO_ERROR && err != WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED)
+    {
+        Impl()->SoftwareUpdateFailed(err, NULL);
+    }
+#endif
 }
 
 template<class ImplClass>
@@ -1032,23 +1522,38 @@ void GenericSoftwareUpdateManagerImpl<ImplClass>::CheckImageIntegrity(void)
 
     uint8_t computedIntegrityValue[typeLength];
 
-    inParam.ComputeImageIntegrity.IntegrityType = mIntegritySpec.type;
-    inParam.ComputeImageIntegrity.IntegrityValueBuf = computedIntegrityValue;
-    inParam.ComputeImageIntegrity.IntegrityValueBufLen = typeLength;
-    outParam.ComputeImageIntegrity.Error = WEAVE_NO_ERROR;
-
-    // Request the application to compute an integrity check value for the stored image.
-    // Fail if the application returns an error.
-    mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_ComputeImageIntegrity, inParam, outParam);
-    VerifyOrExit(mState == SoftwareUpdateManager::kState_Download, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
-    err = outParam.ComputeImageIntegrity.Error;
-    SuccessOrExit(err);
+#if WEAVE_DEVICE_CONFIG_SWU_RUNNING_IMAGE_HASH
+    // If the image was hashed as it was stored, use the running hash as the computed
+    // integrity value.
+    if (mImageHashValid)
+    {
+        mImageHash.Finish(computedIntegrityValue);
+        mImageHashValid = false;
+    }
+    else
+#endif
+    {
+        inParam.ComputeImageIntegrity.IntegrityType = mIntegritySpec.type;
+        inParam.ComputeImageIntegrity.IntegrityValueBuf = computedIntegrityValue;
+        inParam.ComputeImageIntegrity.IntegrityValueBufLen = typeLength;
+        outParam.ComputeImageIntegrity.Error = WEAVE_NO_ERROR;
+
+        // Request the application to compute an integrity check value for the stored image.
+        // Fail if the application returns an error.
+        mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_ComputeImageIntegrity, inParam, outParam);
+        VerifyOrExit(mState == SoftwareUpdateManager::kState_Download, err = WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED);
+        err = outParam.ComputeImageIntegrity.Error;
+        SuccessOrExit(err);
+    }
 
     // Verify the computed integrity value matches the expected value given
     // in the SoftwareUpdate:ImageQueryResponse.
     result = memcmp(computedIntegrityValue, mIntegritySpec.value, typeLength);
     VerifyOrExit(result == 0, err = WEAVE_ERROR_INTEGRITY_CHECK_FAILED);
 
+    // The download is complete, so its progress no longer needs to be tracked.
+    ConfigurationMgr().ClearSoftwareUpdateProgress();
+
     // Given that the integrity check succeeded, allow future software update attempts
     // to restart an interrupted download.  This turns off the defensive mechanism enabled
     // below when an image fails its integrity check.
@@ -1070,6 +1575,8 @@ exit:
          * the persisted image state. This will make sure the image is downloaded from
          * scratch on the next attempt.
          */
+        ConfigurationMgr().ClearSoftwareUpdateProgress();
+
         inParam.Clear();
         outParam.Clear();
         mEventHandlerCallback(mAppState, SoftwareUpdateManager::kEvent_ResetPartialImageInfo, inParam, outParam);
@@ -1253,6 +1760,35 @@ exit:
     return err;
 }
 
+template<class ImplClass>
+WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::_StoreImageBlockComplete(WEAVE_ERROR aError)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+#if WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
+    // Fail if there is no batch being written.
+    VerifyOrExit(mState == SoftwareUpdateManager::kState_Download && mIsBatchWriteInProgress, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // Failing to write the batch, or the ones that follow, fails the software update attempt.
+    aError = CompleteImageBatch(aError);
+    if (aError != WEAVE_NO_ERROR && aError != WEAVE_DEVICE_ERROR_SOFTWARE_UPDATE_ABORTED)
+    {
+        Impl()->AbortDownload();
+        Impl()->SoftwareUpdateFailed(aError, NULL);
+    }
+
+#else // WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
+    // Image blocks are only written asynchronously in batches.
+    ExitNow(err = WEAVE_ERROR_INCORRECT_STATE);
+
+#endif // WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
+exit:
+    return err;
+}
+
 template<class ImplClass>
 WEAVE_ERROR GenericSoftwareUpdateManagerImpl<ImplClass>::_ImageInstallComplete(WEAVE_ERROR aError)
 {
@@ -59,6 +59,8 @@ protected:
     WEAVE_ERROR StartImageDownload(char *aURI, uint64_t aStartOffset);
     WEAVE_ERROR GetUpdateSchemeList(::nl::Weave::Profiles::SoftwareUpdate::UpdateSchemeList * aUpdateSchemeList);
     void AbortDownload(void);
+    void PauseImageDownload(void);
+    void ResumeImageDownload(void);
 
 private:
     // ===== Private members reserved for use by this class only.
@@ -258,6 +258,25 @@ void GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::AbortDownload(void)
     ResetState();
 }
 
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::PauseImageDownload(void)
+{
+    if (mBDXTransfer)
+    {
+        BdxProtocol::PauseTransfer(*mBDXTransfer);
+    }
+}
+
+template<class ImplClass>
+void GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::ResumeImageDownload(void)
+{
+    // Errors resuming the transfer are reported through its ErrorHandler.
+    if (mBDXTransfer)
+    {
+        BdxProtocol::ResumeTransfer(*mBDXTransfer);
+    }
+}
+
 template<class ImplClass>
 void GenericSoftwareUpdateManagerImpl_BDX<ImplClass>::ResetState(void)
 {
@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Defines a container for a small value that is published by the Weave
+ *          task and can be read from any task without taking the Weave stack lock.
+ */
+
+#ifndef LOCK_FREE_SNAPSHOT_H
+#define LOCK_FREE_SNAPSHOT_H
+
+#include <stdint.h>
+#include <string.h>
+
+namespace nl {
+namespace Weave {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * Holds a copy of a value that a single writer updates and any number of tasks read, without a lock.
+ *
+ * This is a sequence lock over two copies of the value.  The writer fills the copy that readers
+ * are not directed to, then bumps the sequence number to direct them to it.  A reader copies the
+ * current copy out, and retries if the sequence number changed meanwhile.  Because the writer
+ * never modifies the copy readers are directed to, a reader that preempts the writer on a single
+ * core does not wait for it, and on multiple cores readers only retry when a write completes
+ * during their copy.
+ *
+ * Writers must be serialized by the caller; in the Device Layer this is done by holding the
+ * Weave stack lock.
+ *
+ * @tparam T    The type of the value.  Must be trivially copyable, and should be small, as it
+ *              is copied on every read and write.
+ */
+template<typename T>
+class LockFreeSnapshot
+{
+public:
+    LockFreeSnapshot(void) : mSeq(0) { memset(mValues, 0, sizeof(mValues)); }
+
+    void Set(const T & aValue);
+    void Get(T & aValue) const;
+
+private:
+    T mValues[2];
+    volatile uint32_t mSeq;
+};
+
+template<typename T>
+inline void LockFreeSnapshot<T>::Set(const T & aValue)
+{
+    uint32_t seq = mSeq;
+
+    memcpy(&mValues[(seq + 1) & 1], &aValue, sizeof(T));
+
+    // Make the new value visible before directing readers to it.
+    __sync_synchronize();
+
+    mSeq = seq + 1;
+}
+
+template<typename T>
+inline void LockFreeSnapshot<T>::Get(T & aValue) const
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = mSeq;
+        __sync_synchronize();
+
+        memcpy(&aValue, &mValues[seq & 1], sizeof(T));
+
+        // Once the sequence number has moved on, the next write may have been overwriting
+        // the copy just read.
+        __sync_synchronize();
+    } while (mSeq != seq);
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace Weave
+} // namespace nl
+
+#endif // LOCK_FREE_SNAPSHOT_H
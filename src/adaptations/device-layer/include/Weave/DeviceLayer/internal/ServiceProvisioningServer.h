@@ -84,9 +84,18 @@ private:
 
     ::nl::Weave::Binding * mProvServiceBinding;
     bool mWaitingForServiceConnectivity;
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+    ::nl::Weave::Profiles::ServiceProvisioning::RegisterServicePairAccountMessage mPendingPairingMsg;
+    ::nl::Weave::System::PacketBuffer * mPendingPairingBuf;
+#endif
 
     void StartPairDeviceToAccount(void);
     void SendPairDeviceToAccountRequest(void);
+    bool IsPairingPending(void) const;
+    const ::nl::Weave::Profiles::ServiceProvisioning::RegisterServicePairAccountMessage & GetPairingRequest(void) const;
+#if WEAVE_DEVICE_CONFIG_ASYNC_ACCOUNT_PAIRING
+    void EndPendingPairing(void);
+#endif
 
     static void AsyncStartPairDeviceToAccount(intptr_t arg);
     static void HandleServiceConnectivityTimeout(::nl::Weave::System::Layer * layer, void * appState, ::nl::Weave::System::Error err);
@@ -0,0 +1,175 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Defines helpers used to reduce the volume of network telemetry events:
+ *          change detection across samples, and min/max/average summaries of
+ *          values sampled over a reporting window.
+ */
+
+#ifndef TELEMETRY_CHANGE_FILTER_H
+#define TELEMETRY_CHANGE_FILTER_H
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/DeviceLayer/WeaveDeviceConfig.h>
+
+namespace nl {
+namespace Weave {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * Decides whether a telemetry sample differs enough from the last logged one to be worth logging.
+ *
+ * For each sample, the caller feeds the metrics that make up the telemetry event to the filter,
+ * between BeginSample() and ShouldLog().  Counters are fed as-is; noisy gauges such as RSSI can be
+ * fed with a resolution, so that only moves of at least that size count as a change.  A sample
+ * whose metrics all match those of the last logged sample is suppressed, unless the last event was
+ * logged more than the maximum suppressed interval ago, so that the service still sees the stream
+ * is alive.
+ *
+ * The metrics are folded into a 64-bit FNV-1a digest, so the filter costs a few words of RAM
+ * whatever the size of the event.
+ */
+class TelemetryChangeFilter
+{
+public:
+    TelemetryChangeFilter(void);
+
+    void BeginSample(void);
+    void AddMetric(uint64_t val);
+    void AddGauge(int32_t val, uint32_t resolution);
+    bool ShouldLog(void);
+
+    /** Forget the last logged sample, so that the next one is logged whatever its value. */
+    void Reset(void) { mHaveLogged = false; }
+
+    /** Set the interval after which an unchanged sample is logged anyway; 0 disables change detection. */
+    void SetMaxSuppressedInterval(uint32_t aIntervalMsec) { mMaxSuppressedInterval = aIntervalMsec; }
+
+private:
+    static const uint64_t kFNVOffsetBasis = 0xcbf29ce484222325ULL;
+    static const uint64_t kFNVPrime       = 0x100000001b3ULL;
+
+    uint64_t mDigest;
+    uint64_t mLoggedDigest;
+    uint64_t mLastLogTime;
+    uint32_t mMaxSuppressedInterval;
+    bool mHaveLogged;
+};
+
+inline TelemetryChangeFilter::TelemetryChangeFilter(void)
+{
+    mDigest = kFNVOffsetBasis;
+    mLoggedDigest = 0;
+    mLastLogTime = 0;
+    mMaxSuppressedInterval = WEAVE_DEVICE_CONFIG_TELEMETRY_MAX_SUPPRESSED_INTERVAL_MS;
+    mHaveLogged = false;
+}
+
+inline void TelemetryChangeFilter::BeginSample(void)
+{
+    mDigest = kFNVOffsetBasis;
+}
+
+inline void TelemetryChangeFilter::AddMetric(uint64_t val)
+{
+    for (uint8_t i = 0; i < sizeof(val); i++, val >>= 8)
+    {
+        mDigest = (mDigest ^ static_cast<uint8_t>(val)) * kFNVPrime;
+    }
+}
+
+inline void TelemetryChangeFilter::AddGauge(int32_t val, uint32_t resolution)
+{
+    int64_t bucket = val;
+
+    // Round towards negative infinity, so that every bucket spans the same range of values.
+    if (resolution > 1)
+    {
+        bucket = (bucket >= 0) ? bucket / resolution : -((-bucket + resolution - 1) / resolution);
+    }
+
+    AddMetric(static_cast<uint64_t>(bucket));
+}
+
+inline bool TelemetryChangeFilter::ShouldLog(void)
+{
+    uint64_t now = System::Layer::GetClock_MonotonicMS();
+
+    if (mMaxSuppressedInterval != 0 && mHaveLogged && mDigest == mLoggedDigest && now - mLastLogTime < mMaxSuppressedInterval)
+    {
+        return false;
+    }
+
+    mLoggedDigest = mDigest;
+    mLastLogTime = now;
+    mHaveLogged = true;
+
+    return true;
+}
+
+/**
+ * Accumulates the minimum, maximum and average of a value sampled over a reporting window.
+ */
+class TelemetryWindowStats
+{
+public:
+    TelemetryWindowStats(void) { Reset(); }
+
+    void Reset(void)
+    {
+        mSum = 0;
+        mMin = 0;
+        mMax = 0;
+        mCount = 0;
+    }
+
+    void Add(int32_t val)
+    {
+        if (mCount == 0 || val < mMin)
+        {
+            mMin = val;
+        }
+        if (mCount == 0 || val > mMax)
+        {
+            mMax = val;
+        }
+        mSum += val;
+        mCount++;
+    }
+
+    uint32_t Count(void) const { return mCount; }
+    int32_t Min(void) const { return mMin; }
+    int32_t Max(void) const { return mMax; }
+    int32_t Average(void) const { return (mCount != 0) ? static_cast<int32_t>(mSum / static_cast<int64_t>(mCount)) : 0; }
+
+private:
+    int64_t mSum;
+    int32_t mMin;
+    int32_t mMax;
+    uint32_t mCount;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace Weave
+} // namespace nl
+
+#endif // TELEMETRY_CHANGE_FILTER_H
@@ -70,6 +70,7 @@ private:
     WEAVE_ERROR _GetDeviceName(char * buf, size_t bufSize);
     WEAVE_ERROR _SetDeviceName(const char * deviceName);
     uint16_t _NumConnections(void);
+    WEAVE_ERROR _SetHighThroughputEnabled(BLE_CONNECTION_OBJECT conId, bool val);
     void _OnPlatformEvent(const WeaveDeviceEvent * event);
     ::nl::Ble::BleLayer * _GetBleLayer(void) const;
 
@@ -83,6 +84,7 @@ private:
     bool SendWriteRequest(BLE_CONNECTION_OBJECT conId, const WeaveBleUUID * svcId, const WeaveBleUUID * charId, PacketBuffer * pBuf) override;
     bool SendReadRequest(BLE_CONNECTION_OBJECT conId, const WeaveBleUUID * svcId, const WeaveBleUUID * charId, PacketBuffer * pBuf) override;
     bool SendReadResponse(BLE_CONNECTION_OBJECT conId, BLE_READ_REQUEST_CONTEXT requestContext, const WeaveBleUUID * svcId, const WeaveBleUUID * charId) override;
+    bool RequestHighThroughput(BLE_CONNECTION_OBJECT conId, bool enable) override;
 
     // ===== Members that implement virtual methods on BleApplicationDelegate.
 
@@ -43,6 +43,13 @@ class GroupKeyStoreImpl final
     using WeaveGroupKey = ::nl::Weave::Profiles::Security::AppKeys::WeaveGroupKey;
 
 public:
+    enum
+    {
+        kMaxGroupKeys = WEAVE_CONFIG_MAX_APPLICATION_EPOCH_KEYS +       // Maximum number of Epoch keys
+                        WEAVE_CONFIG_MAX_APPLICATION_GROUPS +           // Maximum number of Application Group Master keys
+                        1 +                                             // Maximum number of Root keys (1 for Service root key)
+                        1                                               // Fabric secret
+    };
 
     WEAVE_ERROR Init();
 
@@ -52,6 +59,8 @@ public:
     WEAVE_ERROR DeleteGroupKeysOfAType(uint32_t keyType) override;
     WEAVE_ERROR EnumerateGroupKeys(uint32_t keyType, uint32_t * keyIds, uint8_t keyIdsArraySize, uint8_t & keyCount) override;
     WEAVE_ERROR Clear(void) override;
+    WEAVE_ERROR EnumerateEpochKeys(uint32_t * keyIds, uint32_t * startTimes, uint8_t arraySize, uint8_t & keyCount) override;
+    WEAVE_ERROR FindGroupMasterKeyId(uint32_t groupGlobalId, uint32_t & groupMasterKeyId) override;
     WEAVE_ERROR RetrieveLastUsedEpochKeyId(void) override;
     WEAVE_ERROR StoreLastUsedEpochKeyId(void) override;
 
@@ -66,6 +75,18 @@ private:
     static constexpr uint16_t kGroupKeyFileId =     GetFileId(kConfigKey_GroupKey);
     static constexpr uint16_t kGroupKeyRecordKey =  GetRecordKey(kConfigKey_GroupKey);
 
+    // In-memory index of the GroupKey records, built on first use by a single pass over the
+    // records and discarded whenever a key is stored or deleted.  Key material is only read
+    // when a key is retrieved, directly from the record named in the index.
+    uint32_t mKeyIds[kMaxGroupKeys];
+    uint32_t mKeyInfo[kMaxGroupKeys];       // Start time or global id of each key
+    uint32_t mRecordIds[kMaxGroupKeys];     // FDS record id of each key
+    uint8_t mNumKeys;
+    bool mIndexLoaded;
+
+    WEAVE_ERROR LoadKeyIndex(void);
+    WEAVE_ERROR RetrieveGroupKeyFromRecord(uint32_t recordId, WeaveGroupKey & key);
+
     static WEAVE_ERROR EncodeGroupKey(const WeaveGroupKey & key, uint8_t * buf, size_t bufSize, size_t & encodedKeyLen);
     static WEAVE_ERROR DecodeGroupKey(const uint8_t * encodedKey, size_t encodedKeyLen, WeaveGroupKey & key);
     static WEAVE_ERROR DecodeGroupKeyId(const uint8_t * encodedKey, size_t encodedKeyLen, uint32_t & keyId);
@@ -0,0 +1,43 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Platform-specific declarations for the OpenWeave AES and hash
+ *          implementations on the Nordic nRF52 platforms, which use the
+ *          CryptoCell (CC310) accelerator via the nrf_crypto library.
+ */
+
+#ifndef WEAVE_CRYPTO_PLATFORM_NRF5_H
+#define WEAVE_CRYPTO_PLATFORM_NRF5_H
+
+#include <nrf_crypto_hash.h>
+
+// Map mincrypt's SHA_CTX type to a unique name, as is done by HashAlgos.h.  The CC310
+// does not implement SHA-1, so SHA1 continues to use the mincrypt implementation.
+#define SHA_CTX MINCRYPT_SHA_CTX
+#include "mincrypt/sha.h"
+#undef SHA_CTX
+
+// Encrypt runs of counter blocks with a single call into the CryptoCell.
+#define WEAVE_AES_ENCRYPT_BLOCKS_PLATFORM 1
+
+#define SHA_CTX_PLATFORM MINCRYPT_SHA_CTX
+#define SHA256_CTX_PLATFORM nrf_crypto_hash_context_t
+
+#endif // WEAVE_CRYPTO_PLATFORM_NRF5_H
@@ -89,4 +89,9 @@
 #define WEAVE_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY_FULL 0
 #define WEAVE_DEVICE_CONFIG_ENABLE_TUNNEL_TELEMETRY 0
 
+// Hand downloaded software images to the application in flash page sized, page aligned batches.
+#ifndef WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+#define WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE 4096
+#endif // WEAVE_DEVICE_CONFIG_SWU_WRITE_BATCH_SIZE
+
 #endif // WEAVE_DEVICE_PLATFORM_CONFIG_H
@@ -58,6 +58,26 @@
 #define WEAVE_CONFIG_USE_OPENSSL_ECC 0
 #define WEAVE_CONFIG_USE_MICRO_ECC 1
 
+// When the nrf_crypto library is configured with the CryptoCell (CC310) backend,
+// AES-128, SHA-256 and P-256 ECDSA/ECDH are performed by the accelerator.
+#if NRF_CRYPTO_ENABLED && NRF_CRYPTO_BACKEND_CC310_ENABLED
+
+#define WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL 0
+#define WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT 0
+#define WEAVE_CONFIG_HASH_IMPLEMENTATION_MBEDTLS 0
+#define WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM 1
+#define WEAVE_HASH_ALGOS_PLATFORM_INCLUDE <Weave/DeviceLayer/nRF5/WeaveCryptoPlatform.h>
+
+#define WEAVE_CONFIG_AES_IMPLEMENTATION_OPENSSL 0
+#define WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI 0
+#define WEAVE_CONFIG_AES_IMPLEMENTATION_MBEDTLS 0
+#define WEAVE_CONFIG_AES_IMPLEMENTATION_PLATFORM 1
+#define WEAVE_AES_BLOCK_CIPHER_PLATFORM_INCLUDE <Weave/DeviceLayer/nRF5/WeaveCryptoPlatform.h>
+
+#define WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM 1
+
+#else // NRF_CRYPTO_ENABLED && NRF_CRYPTO_BACKEND_CC310_ENABLED
+
 #define WEAVE_CONFIG_HASH_IMPLEMENTATION_OPENSSL 0
 #define WEAVE_CONFIG_HASH_IMPLEMENTATION_MINCRYPT 1
 #define WEAVE_CONFIG_HASH_IMPLEMENTATION_MBEDTLS 0
@@ -68,6 +88,8 @@
 #define WEAVE_CONFIG_AES_IMPLEMENTATION_MBEDTLS 1
 #define WEAVE_CONFIG_AES_IMPLEMENTATION_PLATFORM 0
 
+#endif // NRF_CRYPTO_ENABLED && NRF_CRYPTO_BACKEND_CC310_ENABLED
+
 #define WEAVE_CONFIG_RNG_IMPLEMENTATION_OPENSSL 0
 #define WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG 1
 #define WEAVE_CONFIG_RNG_IMPLEMENTATION_PLATFORM 0
@@ -112,6 +134,10 @@
 #define WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS 1
 #endif // WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS
 
+#ifndef WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT
+#define WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT 10
+#endif // WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT
+
 // ==================== Security Configuration Overrides ====================
 
 #ifndef WEAVE_CONFIG_MAX_APPLICATION_GROUPS
@@ -99,6 +99,7 @@ public:
     static constexpr Key kConfigKey_OperationalDeviceCert       = NRF5ConfigKey(kFileId_WeaveConfig,  0x0012);
     static constexpr Key kConfigKey_OperationalDeviceICACerts   = NRF5ConfigKey(kFileId_WeaveConfig,  0x0013);
     static constexpr Key kConfigKey_OperationalDevicePrivateKey = NRF5ConfigKey(kFileId_WeaveConfig,  0x0014);
+    static constexpr Key kConfigKey_SoftwareUpdateProgress      = NRF5ConfigKey(kFileId_WeaveConfig,  0x0015);
 
     // Range of FDS record keys used to store Weave persisted counter values.
     static constexpr uint16_t kPersistedCounterRecordKeyBase    = kFDSRecordKeyMin;
@@ -125,6 +126,10 @@ public:
     static bool ConfigValueExists(Key key);
     static WEAVE_ERROR FactoryResetConfig(void);
 
+    // Write batching.  FDS commits each record as it is written, so there is nothing to coalesce.
+    static WEAVE_ERROR BeginWriteBatch(void) { return WEAVE_NO_ERROR; }
+    static WEAVE_ERROR CommitWriteBatch(void) { return WEAVE_NO_ERROR; }
+
     static void RunConfigUnitTest(void);
 
 protected:
@@ -165,6 +170,7 @@ protected:
     static constexpr uint16_t GetFileId(uint32_t key);
     static constexpr uint16_t GetRecordKey(uint32_t key);
     static WEAVE_ERROR OpenRecord(NRF5Config::Key key, fds_record_desc_t & recDesc, fds_flash_record_t & rec);
+    static WEAVE_ERROR OpenRecordById(uint32_t recordId, fds_record_desc_t & recDesc, fds_flash_record_t & rec);
     static WEAVE_ERROR ForEachRecord(uint16_t fileId, uint16_t recordKey, ForEachRecordFunct funct);
     static WEAVE_ERROR DoAsyncFDSOp(FDSAsyncOp & asyncOp);
     static constexpr uint16_t FDSWords(size_t s);
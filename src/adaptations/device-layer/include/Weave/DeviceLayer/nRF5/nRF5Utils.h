@@ -31,6 +31,8 @@ namespace Internal {
 
 void RegisterNRFErrorFormatter(void);
 bool FormatNRFError(char * buf, uint16_t bufSize, int32_t err);
+void LockCryptoCell(void);
+void UnlockCryptoCell(void);
 
 } // namespace Internal
 } // namespace DeviceLayer
@@ -0,0 +1,172 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides implementations for the OpenWeave AES BlockCipher classes
+ *          on the Nordic nRF52 platforms.
+ *
+ *          AES-128 operations are performed by the CryptoCell (CC310) accelerator
+ *          via the nrf_crypto library.  The CC310 backend of nrf_crypto does not
+ *          support AES-256, which is therefore implemented in software using mbedTLS.
+ */
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+#include <Weave/DeviceLayer/nRF5/nRF5Utils.h>
+
+#include <string.h>
+
+#include <Weave/Support/crypto/WeaveCrypto.h>
+#include <Weave/Support/crypto/AESBlockCipher.h>
+
+#include <nrf_crypto.h>
+#include <mbedtls/aes.h>
+
+#if WEAVE_CONFIG_AES_IMPLEMENTATION_PLATFORM
+
+namespace nl {
+namespace Weave {
+namespace Platform {
+namespace Security {
+
+using namespace nl::Weave::Crypto;
+using namespace nl::Weave::DeviceLayer::Internal;
+
+namespace {
+
+void CC310_AES128_ECB(const uint8_t *key, nrf_crypto_operation_t operation, const uint8_t *in, uint8_t *out, size_t len)
+{
+    nrf_crypto_aes_context_t ctx;
+    size_t outLen = len;
+    ret_code_t res;
+
+    LockCryptoCell();
+    res = nrf_crypto_aes_crypt(&ctx, &g_nrf_crypto_aes_ecb_128_info, operation, const_cast<uint8_t *>(key), NULL,
+                               const_cast<uint8_t *>(in), len, out, &outLen);
+    UnlockCryptoCell();
+
+    VerifyOrDie(res == NRF_SUCCESS && outLen == len);
+}
+
+void MbedTLS_AES256_ECB(const uint8_t *key, int mode, const uint8_t *in, uint8_t *out)
+{
+    mbedtls_aes_context ctx;
+    int res;
+
+    mbedtls_aes_init(&ctx);
+    if (mode == MBEDTLS_AES_ENCRYPT)
+        res = mbedtls_aes_setkey_enc(&ctx, key, AES256BlockCipher::kKeyLengthBits);
+    else
+        res = mbedtls_aes_setkey_dec(&ctx, key, AES256BlockCipher::kKeyLengthBits);
+    if (res == 0)
+        res = mbedtls_aes_crypt_ecb(&ctx, mode, in, out);
+    mbedtls_aes_free(&ctx);
+
+    VerifyOrDie(res == 0);
+}
+
+} // unnamed namespace
+
+AES128BlockCipher::AES128BlockCipher()
+{
+    memset(&mKey, 0, sizeof(mKey));
+}
+
+AES128BlockCipher::~AES128BlockCipher()
+{
+    Reset();
+}
+
+void AES128BlockCipher::Reset()
+{
+    ClearSecretData((uint8_t *)&mKey, sizeof(mKey));
+}
+
+void AES128BlockCipherEnc::SetKey(const uint8_t *key)
+{
+    memcpy(mKey, key, kKeyLength);
+}
+
+void AES128BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock)
+{
+    CC310_AES128_ECB(mKey, NRF_CRYPTO_ENCRYPT, inBlock, outBlock, kBlockLength);
+}
+
+void AES128BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    if (numBlocks > 0)
+        CC310_AES128_ECB(mKey, NRF_CRYPTO_ENCRYPT, inBlocks, outBlocks, numBlocks * kBlockLength);
+}
+
+void AES128BlockCipherDec::SetKey(const uint8_t *key)
+{
+    memcpy(mKey, key, kKeyLength);
+}
+
+void AES128BlockCipherDec::DecryptBlock(const uint8_t *inBlock, uint8_t *outBlock)
+{
+    CC310_AES128_ECB(mKey, NRF_CRYPTO_DECRYPT, inBlock, outBlock, kBlockLength);
+}
+
+AES256BlockCipher::AES256BlockCipher()
+{
+    memset(&mKey, 0, sizeof(mKey));
+}
+
+AES256BlockCipher::~AES256BlockCipher()
+{
+    Reset();
+}
+
+void AES256BlockCipher::Reset()
+{
+    ClearSecretData((uint8_t *)&mKey, sizeof(mKey));
+}
+
+void AES256BlockCipherEnc::SetKey(const uint8_t *key)
+{
+    memcpy(mKey, key, kKeyLength);
+}
+
+void AES256BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock)
+{
+    MbedTLS_AES256_ECB(mKey, MBEDTLS_AES_ENCRYPT, inBlock, outBlock);
+}
+
+void AES256BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    for (; numBlocks > 0; numBlocks--, inBlocks += kBlockLength, outBlocks += kBlockLength)
+        EncryptBlock(inBlocks, outBlocks);
+}
+
+void AES256BlockCipherDec::SetKey(const uint8_t *key)
+{
+    memcpy(mKey, key, kKeyLength);
+}
+
+void AES256BlockCipherDec::DecryptBlock(const uint8_t *inBlock, uint8_t *outBlock)
+{
+    MbedTLS_AES256_ECB(mKey, MBEDTLS_AES_DECRYPT, inBlock, outBlock);
+}
+
+} // namespace Security
+} // namespace Platform
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_AES_IMPLEMENTATION_PLATFORM
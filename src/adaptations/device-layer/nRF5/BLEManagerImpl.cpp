@@ -393,6 +393,11 @@ void BLEManagerImpl::NotifyWeaveConnectionClosed(BLE_CONNECTION_OBJECT conId)
     // Nothing to do
 }
 
+bool BLEManagerImpl::RequestHighThroughput(BLE_CONNECTION_OBJECT conId, bool enable)
+{
+    return (_SetHighThroughputEnabled(conId, enable) == WEAVE_NO_ERROR);
+}
+
 void BLEManagerImpl::DriveBLEState(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -659,6 +664,44 @@ uint16_t BLEManagerImpl::_NumConnections(void)
     return numCons;
 }
 
+WEAVE_ERROR BLEManagerImpl::_SetHighThroughputEnabled(BLE_CONNECTION_OBJECT conId, bool val)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    ble_gap_conn_params_t connParams;
+
+    WeaveLogDetail(DeviceLayer, "Requesting %s BLE connection parameters (con %u)", (val) ? "fast" : "slow", conId);
+
+    // Ask the central for a connection interval suited to the traffic.  The central has the final say
+    // and reports the outcome with a BLE_GAP_EVT_CONN_PARAM_UPDATE event.
+    connParams.min_conn_interval = (val) ? WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MIN : WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MIN;
+    connParams.max_conn_interval = (val) ? WEAVE_DEVICE_CONFIG_BLE_FAST_CONNECTION_INTERVAL_MAX : WEAVE_DEVICE_CONFIG_BLE_SLOW_CONNECTION_INTERVAL_MAX;
+    connParams.slave_latency = 0;
+    connParams.conn_sup_timeout = WEAVE_DEVICE_CONFIG_BLE_CONNECTION_SUPERVISION_TIMEOUT;
+    err = sd_ble_gap_conn_param_update(conId, &connParams);
+    SuccessOrExit(err);
+
+#if WEAVE_DEVICE_CONFIG_BLE_ENABLE_2M_PHY
+    // Prefer the 2M PHY while there is data to move; let the SoftDevice choose otherwise.  A failure here
+    // (e.g. a PHY procedure already in progress) leaves the connection interval change in effect.
+    {
+        const ble_gap_phys_t phys = { (val) ? (uint8_t)BLE_GAP_PHY_2MBPS : (uint8_t)BLE_GAP_PHY_AUTO,
+                                      (val) ? (uint8_t)BLE_GAP_PHY_2MBPS : (uint8_t)BLE_GAP_PHY_AUTO };
+        WEAVE_ERROR phyErr = sd_ble_gap_phy_update(conId, &phys);
+        if (phyErr != WEAVE_NO_ERROR)
+        {
+            WeaveLogProgress(DeviceLayer, "sd_ble_gap_phy_update() failed: %s", ErrorStr(phyErr));
+        }
+    }
+#endif // WEAVE_DEVICE_CONFIG_BLE_ENABLE_2M_PHY
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(DeviceLayer, "BLEManagerImpl::_SetHighThroughputEnabled() failed: %s", ErrorStr(err));
+    }
+    return err;
+}
+
 void BLEManagerImpl::DriveBLEState(intptr_t arg)
 {
     sInstance.DriveBLEState();
@@ -0,0 +1,153 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides implementations for the OpenWeave secp256r1 ECDSA and ECDH
+ *          functions on the Nordic nRF52 platforms, using the CryptoCell (CC310)
+ *          accelerator via the nrf_crypto library.
+ */
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+#include <Weave/DeviceLayer/nRF5/nRF5Utils.h>
+
+#include <Weave/Support/crypto/WeaveCrypto.h>
+#include <Weave/Support/crypto/EllipticCurve.h>
+
+#include <nrf_crypto.h>
+
+#if WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM
+
+namespace nl {
+namespace Weave {
+namespace Platform {
+namespace Security {
+
+using namespace nl::Weave::DeviceLayer::Internal;
+
+WEAVE_ERROR P256_GenerateECDSASignature(const uint8_t *privKey, const uint8_t *msgHash, uint8_t msgHashLen,
+                                        uint8_t *fixedLenSig)
+{
+    nrf_crypto_ecc_private_key_t key;
+    size_t sigLen = kP256_FixedLenSigLength;
+    ret_code_t res;
+
+    // Only SHA-256 message hashes are handed to the CryptoCell.
+    if (msgHashLen != SHA256::kHashLength)
+    {
+        return WEAVE_ERROR_NOT_IMPLEMENTED;
+    }
+
+    LockCryptoCell();
+
+    res = nrf_crypto_ecc_private_key_from_raw(&g_nrf_crypto_ecc_secp256r1_curve_info, &key, privKey, kP256_PrivateKeyLength);
+    if (res == NRF_SUCCESS)
+    {
+        res = nrf_crypto_ecdsa_sign(NULL, &key, msgHash, msgHashLen, fixedLenSig, &sigLen);
+        nrf_crypto_ecc_private_key_free(&key);
+    }
+
+    UnlockCryptoCell();
+
+    return (res == NRF_SUCCESS && sigLen == kP256_FixedLenSigLength) ? WEAVE_NO_ERROR : WEAVE_ERROR_INVALID_ARGUMENT;
+}
+
+WEAVE_ERROR P256_VerifyECDSASignature(const uint8_t *pubKey, const uint8_t *msgHash, uint8_t msgHashLen,
+                                      const uint8_t *fixedLenSig)
+{
+    nrf_crypto_ecc_public_key_t key;
+    ret_code_t res;
+
+    if (msgHashLen != SHA256::kHashLength)
+    {
+        return WEAVE_ERROR_NOT_IMPLEMENTED;
+    }
+
+    LockCryptoCell();
+
+    res = nrf_crypto_ecc_public_key_from_raw(&g_nrf_crypto_ecc_secp256r1_curve_info, &key, pubKey, kP256_PublicKeyLength);
+    if (res == NRF_SUCCESS)
+    {
+        res = nrf_crypto_ecdsa_verify(NULL, &key, msgHash, msgHashLen, fixedLenSig, kP256_FixedLenSigLength);
+        nrf_crypto_ecc_public_key_free(&key);
+    }
+
+    UnlockCryptoCell();
+
+    return (res == NRF_SUCCESS) ? WEAVE_NO_ERROR : WEAVE_ERROR_INVALID_SIGNATURE;
+}
+
+WEAVE_ERROR P256_GenerateECDHKey(uint8_t *pubKey, uint8_t *privKey)
+{
+    nrf_crypto_ecc_private_key_t privKeyObj;
+    nrf_crypto_ecc_public_key_t pubKeyObj;
+    size_t privKeyLen = kP256_PrivateKeyLength;
+    size_t pubKeyLen = kP256_PublicKeyLength;
+    ret_code_t res;
+
+    LockCryptoCell();
+
+    res = nrf_crypto_ecc_key_pair_generate(NULL, &g_nrf_crypto_ecc_secp256r1_curve_info, &privKeyObj, &pubKeyObj);
+    if (res == NRF_SUCCESS)
+    {
+        res = nrf_crypto_ecc_private_key_to_raw(&privKeyObj, privKey, &privKeyLen);
+        if (res == NRF_SUCCESS)
+        {
+            res = nrf_crypto_ecc_public_key_to_raw(&pubKeyObj, pubKey, &pubKeyLen);
+        }
+        nrf_crypto_ecc_private_key_free(&privKeyObj);
+        nrf_crypto_ecc_public_key_free(&pubKeyObj);
+    }
+
+    UnlockCryptoCell();
+
+    return (res == NRF_SUCCESS) ? WEAVE_NO_ERROR : WEAVE_ERROR_RANDOM_DATA_UNAVAILABLE;
+}
+
+WEAVE_ERROR P256_ECDHComputeSharedSecret(const uint8_t *pubKey, const uint8_t *privKey, uint8_t *sharedSecret)
+{
+    nrf_crypto_ecc_private_key_t privKeyObj;
+    nrf_crypto_ecc_public_key_t pubKeyObj;
+    size_t sharedSecretLen = kP256_SharedSecretLength;
+    ret_code_t res;
+
+    LockCryptoCell();
+
+    res = nrf_crypto_ecc_private_key_from_raw(&g_nrf_crypto_ecc_secp256r1_curve_info, &privKeyObj, privKey, kP256_PrivateKeyLength);
+    if (res == NRF_SUCCESS)
+    {
+        res = nrf_crypto_ecc_public_key_from_raw(&g_nrf_crypto_ecc_secp256r1_curve_info, &pubKeyObj, pubKey, kP256_PublicKeyLength);
+        if (res == NRF_SUCCESS)
+        {
+            res = nrf_crypto_ecdh_compute(NULL, &privKeyObj, &pubKeyObj, sharedSecret, &sharedSecretLen);
+            nrf_crypto_ecc_public_key_free(&pubKeyObj);
+        }
+        nrf_crypto_ecc_private_key_free(&privKeyObj);
+    }
+
+    UnlockCryptoCell();
+
+    return (res == NRF_SUCCESS) ? WEAVE_NO_ERROR : WEAVE_ERROR_INVALID_ARGUMENT;
+}
+
+} // namespace Security
+} // namespace Platform
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM
@@ -40,6 +40,27 @@ WEAVE_ERROR GroupKeyStoreImpl::RetrieveGroupKey(uint32_t keyId, WeaveGroupKey &
 {
     WEAVE_ERROR err;
 
+    // If the key index is available, read the key straight from the record that holds it.
+    err = LoadKeyIndex();
+    if (err == WEAVE_NO_ERROR)
+    {
+        err = WEAVE_ERROR_KEY_NOT_FOUND;
+
+        for (uint8_t i = 0; i < mNumKeys; i++)
+        {
+            if (mKeyIds[i] == keyId)
+            {
+                err = RetrieveGroupKeyFromRecord(mRecordIds[i], key);
+                break;
+            }
+        }
+
+        ExitNow();
+    }
+
+    // Otherwise, if there are too many keys to index, fall back to searching the records.
+    VerifyOrExit(err == WEAVE_ERROR_TOO_MANY_KEYS, );
+
     // Iterate over all the GroupKey records looking for a matching key...
     err = ForEachRecord(kGroupKeyFileId, kGroupKeyRecordKey,
               [keyId, &key](const fds_flash_record_t & rec, bool & deleteRec) -> WEAVE_ERROR
@@ -90,6 +111,8 @@ WEAVE_ERROR GroupKeyStoreImpl::StoreGroupKey(const WeaveGroupKey & key)
     uint8_t * storedVal = NULL;
     size_t storedValLen = FDSWords(kMaxEncodedKeySize) * kFDSWordSize;
 
+    mIndexLoaded = false;
+
     // Delete any existing group key with the same id.
     err = DeleteGroupKey(key.KeyId);
     SuccessOrExit(err);
@@ -154,6 +177,8 @@ WEAVE_ERROR GroupKeyStoreImpl::DeleteGroupKey(uint32_t keyId)
 {
     WEAVE_ERROR err;
 
+    mIndexLoaded = false;
+
     // Iterate over all the GroupKey records looking for matching keys...
     err = ForEachRecord(kGroupKeyFileId, kGroupKeyRecordKey,
               [keyId](const fds_flash_record_t & rec, bool & deleteRec) -> WEAVE_ERROR
@@ -187,6 +212,8 @@ WEAVE_ERROR GroupKeyStoreImpl::DeleteGroupKeysOfAType(uint32_t keyType)
 {
     WEAVE_ERROR err;
 
+    mIndexLoaded = false;
+
     // Iterate over all the GroupKey records looking for matching keys...
     err = ForEachRecord(kGroupKeyFileId, kGroupKeyRecordKey,
               [keyType](const fds_flash_record_t & rec, bool & deleteRec) -> WEAVE_ERROR
@@ -224,6 +251,22 @@ WEAVE_ERROR GroupKeyStoreImpl::EnumerateGroupKeys(uint32_t keyType, uint32_t * k
 
     keyCount = 0;
 
+    // If the key index is available, enumerate the keys from it.
+    err = LoadKeyIndex();
+    if (err == WEAVE_NO_ERROR)
+    {
+        for (uint8_t i = 0; i < mNumKeys && keyCount < keyIdsArraySize; i++)
+        {
+            if (keyType == WeaveKeyId::kType_None || WeaveKeyId::GetType(mKeyIds[i]) == keyType)
+            {
+                keyIds[keyCount++] = mKeyIds[i];
+            }
+        }
+
+        ExitNow();
+    }
+    VerifyOrExit(err == WEAVE_ERROR_TOO_MANY_KEYS, );
+
     // Iterate over all the GroupKey records looking for keys of the specified type...
     err = ForEachRecord(kGroupKeyFileId, kGroupKeyRecordKey,
               [keyType, keyIds, keyIdsArraySize, &keyCount](const fds_flash_record_t & rec, bool & deleteRec) -> WEAVE_ERROR
@@ -264,6 +307,8 @@ WEAVE_ERROR GroupKeyStoreImpl::Clear(void)
 {
     WEAVE_ERROR err;
 
+    mIndexLoaded = false;
+
     // Iterate over all GroupKey records deleting each one.
     err = ForEachRecord(kGroupKeyFileId, kGroupKeyRecordKey,
               [](const fds_flash_record_t & rec, bool & deleteRec) -> WEAVE_ERROR
@@ -280,6 +325,60 @@ exit:
     return err;
 }
 
+WEAVE_ERROR GroupKeyStoreImpl::EnumerateEpochKeys(uint32_t * keyIds, uint32_t * startTimes,
+        uint8_t arraySize, uint8_t & keyCount)
+{
+    WEAVE_ERROR err;
+
+    keyCount = 0;
+
+    err = LoadKeyIndex();
+    if (err == WEAVE_ERROR_TOO_MANY_KEYS)
+    {
+        ExitNow(err = GroupKeyStoreBase::EnumerateEpochKeys(keyIds, startTimes, arraySize, keyCount));
+    }
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < mNumKeys && keyCount < arraySize; i++)
+    {
+        if (WeaveKeyId::IsAppEpochKey(mKeyIds[i]))
+        {
+            keyIds[keyCount] = mKeyIds[i];
+            startTimes[keyCount] = mKeyInfo[i];
+            keyCount++;
+        }
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR GroupKeyStoreImpl::FindGroupMasterKeyId(uint32_t groupGlobalId, uint32_t & groupMasterKeyId)
+{
+    WEAVE_ERROR err;
+
+    err = LoadKeyIndex();
+    if (err == WEAVE_ERROR_TOO_MANY_KEYS)
+    {
+        ExitNow(err = GroupKeyStoreBase::FindGroupMasterKeyId(groupGlobalId, groupMasterKeyId));
+    }
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < mNumKeys; i++)
+    {
+        if (WeaveKeyId::IsAppGroupMasterKey(mKeyIds[i]) && mKeyInfo[i] == groupGlobalId)
+        {
+            groupMasterKeyId = mKeyIds[i];
+            ExitNow();
+        }
+    }
+
+    err = WEAVE_ERROR_KEY_NOT_FOUND;
+
+exit:
+    return err;
+}
+
 WEAVE_ERROR GroupKeyStoreImpl::RetrieveLastUsedEpochKeyId(void)
 {
     WEAVE_ERROR err;
@@ -300,10 +399,75 @@ WEAVE_ERROR GroupKeyStoreImpl::StoreLastUsedEpochKeyId(void)
 
 WEAVE_ERROR GroupKeyStoreImpl::Init()
 {
-    // Nothing to do
+    // The key index is built on first use.
+    mNumKeys = 0;
+    mIndexLoaded = false;
+
     return WEAVE_NO_ERROR;
 }
 
+WEAVE_ERROR GroupKeyStoreImpl::LoadKeyIndex(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(!mIndexLoaded, err = WEAVE_NO_ERROR);
+
+    mNumKeys = 0;
+
+    // Record the key id, start time / global id and record id of each GroupKey record.
+    err = ForEachRecord(kGroupKeyFileId, kGroupKeyRecordKey,
+              [this](const fds_flash_record_t & rec, bool & deleteRec) -> WEAVE_ERROR
+              {
+                  WEAVE_ERROR err2;
+                  const uint8_t * p = (const uint8_t *)rec.p_data;
+
+                  VerifyOrExit(mNumKeys < kMaxGroupKeys, err2 = WEAVE_ERROR_TOO_MANY_KEYS);
+
+                  err2 = DecodeGroupKeyId(p, rec.p_header->length_words * kFDSWordSize, mKeyIds[mNumKeys]);
+                  SuccessOrExit(err2);
+
+                  mKeyInfo[mNumKeys] = Encoding::LittleEndian::Get32(p + 4);
+                  mRecordIds[mNumKeys] = rec.p_header->record_id;
+                  mNumKeys++;
+
+              exit:
+                  return err2;
+              }
+          );
+    SuccessOrExit(err);
+
+    mIndexLoaded = true;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR GroupKeyStoreImpl::RetrieveGroupKeyFromRecord(uint32_t recordId, WeaveGroupKey & key)
+{
+    WEAVE_ERROR err;
+    fds_record_desc_t recDesc;
+    fds_flash_record_t rec;
+    bool needClose = false;
+
+    err = OpenRecordById(recordId, recDesc, rec);
+    if (err == WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND)
+    {
+        err = WEAVE_ERROR_KEY_NOT_FOUND;
+    }
+    SuccessOrExit(err);
+    needClose = true;
+
+    err = DecodeGroupKey((const uint8_t *)rec.p_data, rec.p_header->length_words * kFDSWordSize, key);
+    SuccessOrExit(err);
+
+exit:
+    if (needClose)
+    {
+        fds_record_close(&recDesc);
+    }
+    return err;
+}
+
 WEAVE_ERROR GroupKeyStoreImpl::EncodeGroupKey(const WeaveGroupKey & key, uint8_t * buf, size_t bufSize, size_t & encodedKeyLen)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -0,0 +1,128 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides implementations for the OpenWeave SHA1 and SHA256 classes
+ *          on the Nordic nRF52 platforms.
+ *
+ *          SHA-256 is computed by the CryptoCell (CC310) accelerator via the
+ *          nrf_crypto library.  The CC310 does not implement SHA-1, which is
+ *          computed in software using mincrypt.
+ */
+
+#include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
+#include <Weave/DeviceLayer/nRF5/nRF5Utils.h>
+
+#include <string.h>
+
+#include <Weave/Support/crypto/WeaveCrypto.h>
+#include <Weave/Support/crypto/HashAlgos.h>
+
+#if WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM
+
+namespace nl {
+namespace Weave {
+namespace Platform {
+namespace Security {
+
+using namespace nl::Weave::Crypto;
+using namespace nl::Weave::DeviceLayer::Internal;
+
+SHA1::SHA1()
+{
+}
+
+SHA1::~SHA1()
+{
+}
+
+void SHA1::Begin()
+{
+    SHA_init(&mSHACtx);
+}
+
+void SHA1::AddData(const uint8_t *data, uint16_t dataLen)
+{
+    SHA_update(&mSHACtx, data, dataLen);
+}
+
+void SHA1::Finish(uint8_t *hashBuf)
+{
+    const uint8_t *hashResult = SHA_final(&mSHACtx);
+    memcpy(hashBuf, hashResult, kHashLength);
+}
+
+void SHA1::Reset()
+{
+    memset(this, 0, sizeof(*this));
+}
+
+SHA256::SHA256()
+{
+}
+
+SHA256::~SHA256()
+{
+}
+
+void SHA256::Begin()
+{
+    ret_code_t res;
+
+    LockCryptoCell();
+    res = nrf_crypto_hash_init(&mSHACtx, &g_nrf_crypto_hash_sha256_info);
+    UnlockCryptoCell();
+
+    VerifyOrDie(res == NRF_SUCCESS);
+}
+
+void SHA256::AddData(const uint8_t *data, uint16_t dataLen)
+{
+    ret_code_t res;
+
+    LockCryptoCell();
+    res = nrf_crypto_hash_update(&mSHACtx, data, dataLen);
+    UnlockCryptoCell();
+
+    VerifyOrDie(res == NRF_SUCCESS);
+}
+
+void SHA256::Finish(uint8_t *hashBuf)
+{
+    size_t hashLen = kHashLength;
+    ret_code_t res;
+
+    LockCryptoCell();
+    res = nrf_crypto_hash_finalize(&mSHACtx, hashBuf, &hashLen);
+    UnlockCryptoCell();
+
+    VerifyOrDie(res == NRF_SUCCESS && hashLen == kHashLength);
+}
+
+void SHA256::Reset()
+{
+    ClearSecretData((uint8_t *)&mSHACtx, sizeof(mSHACtx));
+}
+
+} // namespace Security
+} // namespace Platform
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_HASH_IMPLEMENTATION_PLATFORM
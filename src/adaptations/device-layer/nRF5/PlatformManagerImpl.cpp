@@ -29,6 +29,10 @@
 
 #include <lwip/tcpip.h>
 
+#if NRF_CRYPTO_ENABLED
+#include <nrf_crypto.h>
+#endif
+
 namespace nl {
 namespace Weave {
 namespace DeviceLayer {
@@ -49,6 +53,16 @@ WEAVE_ERROR PlatformManagerImpl::_InitWeaveStack(void)
     // Initialize LwIP.
     tcpip_init(NULL, NULL);
 
+#if NRF_CRYPTO_ENABLED
+    // Initialize the nrf_crypto library, used by the Weave crypto functions, unless
+    // the application has already done so.
+    if (!nrf_crypto_is_initialized())
+    {
+        err = nrf_crypto_init();
+        SuccessOrExit(err);
+    }
+#endif // NRF_CRYPTO_ENABLED
+
     // Call _InitWeaveStack() on the generic implementation base class
     // to finish the initialization process.
     err = Internal::GenericPlatformManagerImpl_FreeRTOS<PlatformManagerImpl>::_InitWeaveStack();
@@ -27,6 +27,7 @@
 
 #include <Weave/DeviceLayer/internal/WeaveDeviceLayerInternal.h>
 #include <Weave/DeviceLayer/nRF5/nRF5Config.h>
+#include <Weave/DeviceLayer/internal/ConfigValueCache.h>
 #include <Weave/Core/WeaveEncoding.h>
 #include <Weave/DeviceLayer/internal/testing/ConfigUnitTest.h>
 
@@ -44,6 +45,26 @@ namespace Internal {
 NRF5Config::FDSAsyncOp * volatile NRF5Config::sActiveAsyncOp;
 SemaphoreHandle_t NRF5Config::sAsyncOpCompletionSem;
 
+namespace {
+
+// Scalar values are cached to spare the FDS record search on every read.  Because each FDS
+// update writes a new record, writes of unchanged values are skipped as well.
+ConfigValueCache<NRF5Config::Key, WEAVE_DEVICE_CONFIG_CONFIG_VALUE_CACHE_SIZE> sValueCache;
+
+void CacheReadResult(NRF5Config::Key key, WEAVE_ERROR err, uint64_t val)
+{
+    if (err == WEAVE_NO_ERROR)
+    {
+        sValueCache.Store(key, val);
+    }
+    else if (err == WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND)
+    {
+        sValueCache.StoreNotFound(key);
+    }
+}
+
+} // unnamed namespace
+
 WEAVE_ERROR NRF5Config::Init()
 {
     WEAVE_ERROR err;
@@ -73,8 +94,17 @@ WEAVE_ERROR NRF5Config::ReadConfigValue(Key key, bool & val)
     WEAVE_ERROR err;
     fds_record_desc_t recDesc;
     fds_flash_record_t rec;
-    uint32_t wordVal;
+    uint32_t wordVal = 0;
     bool needClose = false;
+    uint64_t cachedVal;
+    bool exists;
+
+    if (sValueCache.Lookup(key, cachedVal, exists))
+    {
+        VerifyOrExit(exists, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+        val = (cachedVal != 0);
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
 
     err = OpenRecord(key, recDesc, rec);
     SuccessOrExit(err);
@@ -89,6 +119,11 @@ exit:
     if (needClose)
     {
         fds_record_close(&recDesc);
+        CacheReadResult(key, err, wordVal);
+    }
+    else if (err == WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND)
+    {
+        CacheReadResult(key, err, 0);
     }
     return err;
 }
@@ -99,6 +134,15 @@ WEAVE_ERROR NRF5Config::ReadConfigValue(Key key, uint32_t & val)
     fds_record_desc_t recDesc;
     fds_flash_record_t rec;
     bool needClose = false;
+    uint64_t cachedVal;
+    bool exists;
+
+    if (sValueCache.Lookup(key, cachedVal, exists))
+    {
+        VerifyOrExit(exists, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+        val = static_cast<uint32_t>(cachedVal);
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
 
     err = OpenRecord(key, recDesc, rec);
     SuccessOrExit(err);
@@ -112,6 +156,11 @@ exit:
     if (needClose)
     {
         fds_record_close(&recDesc);
+        CacheReadResult(key, err, val);
+    }
+    else if (err == WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND)
+    {
+        CacheReadResult(key, err, 0);
     }
     return err;
 }
@@ -122,6 +171,15 @@ WEAVE_ERROR NRF5Config::ReadConfigValue(Key key, uint64_t & val)
     fds_record_desc_t recDesc;
     fds_flash_record_t rec;
     bool needClose = false;
+    uint64_t cachedVal;
+    bool exists;
+
+    if (sValueCache.Lookup(key, cachedVal, exists))
+    {
+        VerifyOrExit(exists, err = WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND);
+        val = static_cast<uint64_t>(cachedVal);
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
 
     err = OpenRecord(key, recDesc, rec);
     SuccessOrExit(err);
@@ -135,6 +193,11 @@ exit:
     if (needClose)
     {
         fds_record_close(&recDesc);
+        CacheReadResult(key, err, val);
+    }
+    else if (err == WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND)
+    {
+        CacheReadResult(key, err, 0);
     }
     return err;
 }
@@ -215,6 +278,12 @@ WEAVE_ERROR NRF5Config::WriteConfigValue(Key key, bool val)
     WEAVE_ERROR err;
     uint32_t storedVal = (val) ? 1 : 0;
 
+    // Spare the flash if the value is already stored.
+    if (sValueCache.Contains(key, storedVal))
+    {
+        return WEAVE_NO_ERROR;
+    }
+
     FDSAsyncOp addOrUpdateOp(FDSAsyncOp::kAddOrUpdateRecord);
     addOrUpdateOp.FileId = GetFileId(key);
     addOrUpdateOp.RecordKey = GetRecordKey(key);
@@ -224,6 +293,8 @@ WEAVE_ERROR NRF5Config::WriteConfigValue(Key key, bool val)
     err = DoAsyncFDSOp(addOrUpdateOp);
     SuccessOrExit(err);
 
+    CacheReadResult(key, err, storedVal);
+
     WeaveLogProgress(DeviceLayer, "FDS set: %04" PRIX16 "/%04" PRIX16 " = %s", GetFileId(key), GetRecordKey(key), val ? "true" : "false");
 
 exit:
@@ -234,6 +305,12 @@ WEAVE_ERROR NRF5Config::WriteConfigValue(Key key, uint32_t val)
 {
     WEAVE_ERROR err;
 
+    // Spare the flash if the value is already stored.
+    if (sValueCache.Contains(key, val))
+    {
+        return WEAVE_NO_ERROR;
+    }
+
     FDSAsyncOp addOrUpdateOp(FDSAsyncOp::kAddOrUpdateRecord);
     addOrUpdateOp.FileId = GetFileId(key);
     addOrUpdateOp.RecordKey = GetRecordKey(key);
@@ -243,6 +320,8 @@ WEAVE_ERROR NRF5Config::WriteConfigValue(Key key, uint32_t val)
     err = DoAsyncFDSOp(addOrUpdateOp);
     SuccessOrExit(err);
 
+    CacheReadResult(key, err, val);
+
     WeaveLogProgress(DeviceLayer, "FDS set: 0x%04" PRIX16 "/0x%04" PRIX16 " = %" PRIu32 " (0x%" PRIX32 ")", GetFileId(key), GetRecordKey(key), val, val);
 
 exit:
@@ -253,6 +332,12 @@ WEAVE_ERROR NRF5Config::WriteConfigValue(Key key, uint64_t val)
 {
     WEAVE_ERROR err;
 
+    // Spare the flash if the value is already stored.
+    if (sValueCache.Contains(key, val))
+    {
+        return WEAVE_NO_ERROR;
+    }
+
     FDSAsyncOp addOrUpdateOp(FDSAsyncOp::kAddOrUpdateRecord);
     addOrUpdateOp.FileId = GetFileId(key);
     addOrUpdateOp.RecordKey = GetRecordKey(key);
@@ -262,6 +347,8 @@ WEAVE_ERROR NRF5Config::WriteConfigValue(Key key, uint64_t val)
     err = DoAsyncFDSOp(addOrUpdateOp);
     SuccessOrExit(err);
 
+    CacheReadResult(key, err, val);
+
     WeaveLogProgress(DeviceLayer, "FDS set: 0x%04" PRIX16 "/0x%04" PRIX16 " = %" PRIu64 " (0x%" PRIX64 ")", GetFileId(key), GetRecordKey(key), val, val);
 
 exit:
@@ -288,6 +375,8 @@ WEAVE_ERROR NRF5Config::WriteConfigValueStr(Key key, const char * str, size_t st
         memcpy(storedVal, str, strLen);
         storedVal[strLen] = 0;
 
+        sValueCache.Invalidate(key);
+
         FDSAsyncOp addOrUpdateOp(FDSAsyncOp::kAddOrUpdateRecord);
         addOrUpdateOp.FileId = GetFileId(key);
         addOrUpdateOp.RecordKey = GetRecordKey(key);
@@ -331,6 +420,8 @@ WEAVE_ERROR NRF5Config::WriteConfigValueBin(Key key, const uint8_t * data, size_
 
         memcpy(storedVal + 2, data, dataLen);
 
+        sValueCache.Invalidate(key);
+
         FDSAsyncOp addOrUpdateOp(FDSAsyncOp::kAddOrUpdateRecord);
         addOrUpdateOp.FileId = GetFileId(key);
         addOrUpdateOp.RecordKey = GetRecordKey(key);
@@ -368,6 +459,8 @@ WEAVE_ERROR NRF5Config::ClearConfigValue(Key key)
     err = DoAsyncFDSOp(delOp);
     SuccessOrExit(err);
 
+    CacheReadResult(key, WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND, 0);
+
     WeaveLogProgress(DeviceLayer, "FDS delete: 0x%04" PRIX16 "/0x%04" PRIX16, GetFileId(key), GetRecordKey(key));
 
 exit:
@@ -379,6 +472,13 @@ bool NRF5Config::ConfigValueExists(Key key)
     ret_code_t fdsRes;
     fds_record_desc_t recDesc;
     fds_find_token_t findToken;
+    uint64_t cachedVal;
+    bool exists;
+
+    if (sValueCache.Lookup(key, cachedVal, exists))
+    {
+        return exists;
+    }
 
     // Search for the requested record.
     memset(&findToken, 0, sizeof(findToken));
@@ -392,6 +492,8 @@ WEAVE_ERROR NRF5Config::FactoryResetConfig(void)
 {
     WEAVE_ERROR err;
 
+    sValueCache.Clear();
+
     // Delete the WeaveConfig file and all records its contains.
     {
         FDSAsyncOp delOp(FDSAsyncOp::kDeleteFile);
@@ -438,6 +540,24 @@ exit:
     return err;
 }
 
+WEAVE_ERROR NRF5Config::OpenRecordById(uint32_t recordId, fds_record_desc_t & recDesc, fds_flash_record_t & rec)
+{
+    WEAVE_ERROR err;
+    ret_code_t fdsRes;
+
+    fdsRes = fds_descriptor_from_rec_id(&recDesc, recordId);
+    err = MapFDSError(fdsRes);
+    SuccessOrExit(err);
+
+    // Open the record for reading.  Return "CONFIG_NOT_FOUND" if it has been deleted.
+    fdsRes = fds_record_open(&recDesc, &rec);
+    err = (fdsRes == FDS_ERR_NOT_FOUND) ? WEAVE_DEVICE_ERROR_CONFIG_NOT_FOUND : MapFDSError(fdsRes);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
 WEAVE_ERROR NRF5Config::ForEachRecord(uint16_t fileId, uint16_t recordKey, ForEachRecordFunct funct)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;;
@@ -79,6 +79,36 @@ bool FormatNRFError(char * buf, uint16_t bufSize, int32_t err)
     return true;
 }
 
+/**
+ * Acquire exclusive use of the CryptoCell (CC310) accelerator.
+ *
+ * The Nordic port of OpenThread uses the CryptoCell directly, without any coordination
+ * with the nrf_crypto library.  Therefore, as with the entropy source, the OpenThread stack
+ * lock is held while OpenWeave code is interacting with the accelerator.
+ */
+void LockCryptoCell(void)
+{
+#if WEAVE_DEVICE_CONFIG_ENABLE_THREAD
+    if (ThreadStackManagerImpl::IsInitialized())
+    {
+        ThreadStackMgr().LockThreadStack();
+    }
+#endif // WEAVE_DEVICE_CONFIG_ENABLE_THREAD
+}
+
+/**
+ * Release the CryptoCell (CC310) accelerator acquired by LockCryptoCell().
+ */
+void UnlockCryptoCell(void)
+{
+#if WEAVE_DEVICE_CONFIG_ENABLE_THREAD
+    if (ThreadStackManagerImpl::IsInitialized())
+    {
+        ThreadStackMgr().UnlockThreadStack();
+    }
+#endif // WEAVE_DEVICE_CONFIG_ENABLE_THREAD
+}
+
 
 } // namespace Internal
 } // namespace DeviceLayer
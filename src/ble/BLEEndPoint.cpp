@@ -112,6 +112,21 @@ BLE_ERROR BLEEndPoint::StartConnect()
     VerifyOrExit(mState == kState_Ready, err = BLE_ERROR_INCORRECT_STATE);
     mState = kState_Connecting;
 
+#if BLE_CONFIG_L2CAP_COC_SUPPORTED
+    // If the application has opened a Weave L2CAP channel on the BLE connection, messages are sent on it as they are,
+    // so there is no handshake to perform. Complete the connection from the event loop, as a handshake would.
+    if (mBle->mPlatformDelegate->IsL2capChannelOpen(mConnObj))
+    {
+        SetFlag(mConnStateFlags, kConnState_L2capChannel, true);
+
+        VerifyOrExit(mBle->mSystemLayer->StartTimer(0, HandleL2capConnectComplete, this) == WEAVE_SYSTEM_NO_ERROR,
+                     err = BLE_ERROR_START_TIMER_FAILED);
+        SetFlag(mTimerStateFlags, kTimerState_L2capConnectTimerRunning, true);
+
+        ExitNow();
+    }
+#endif // BLE_CONFIG_L2CAP_COC_SUPPORTED
+
     // Build BLE transport protocol capabilities request.
     buf = PacketBuffer::New();
     VerifyOrExit(buf != NULL, err = BLE_ERROR_NO_MEMORY);
@@ -150,6 +165,23 @@ BLE_ERROR BLEEndPoint::StartConnect()
     QueueTx(buf, kType_Data);
     buf = NULL;
 
+#if BLE_CONFIG_PEER_CACHE_SIZE > 0
+    // If the peripheral completed a handshake with us before, abbreviate this one: subscribe to its indication
+    // characteristic right away, so that the GATT stack sends the subscribe request as soon as the capabilities
+    // request write is acknowledged, without a round trip through this end point in between.
+    mPeerKey = mBle->mPlatformDelegate->GetPeerKey(mConnObj);
+    if (mPeerKey != 0 && mBle->LookupPeerCache(mPeerKey) != NULL)
+    {
+        WeaveLogProgress(Ble, "abbreviated handshake with known peer, ep = %p", this);
+
+        VerifyOrExit(mBle->mPlatformDelegate->SubscribeCharacteristic(mConnObj, &WEAVE_BLE_SVC_ID, &mBle->WEAVE_BLE_CHAR_2_ID),
+                     err = BLE_ERROR_GATT_SUBSCRIBE_FAILED);
+
+        SetFlag(mConnStateFlags, kConnState_DidBeginSubscribe, true);
+        SetFlag(mConnStateFlags, kConnState_SubscribeInFlight, true);
+    }
+#endif // BLE_CONFIG_PEER_CACHE_SIZE > 0
+
 exit:
     if (buf != NULL)
     {
@@ -275,7 +307,13 @@ exit:
 void BLEEndPoint::HandleSubscribeComplete()
 {
     WeaveLogProgress(Ble, "subscribe complete, ep = %p", this);
-    SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, false);
+    SetFlag(mConnStateFlags, kConnState_SubscribeInFlight, false);
+
+    // A subscribe sent alongside the capabilities request may complete first, while that write is still in flight.
+    if (GetFlag(mConnStateFlags, kConnState_CapabilitiesConfReceived))
+    {
+        SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, false);
+    }
 
     BLE_ERROR err = DriveSending();
 
@@ -291,6 +329,152 @@ void BLEEndPoint::HandleUnsubscribeComplete()
     Free();
 }
 
+#if BLE_CONFIG_L2CAP_COC_SUPPORTED
+BLE_ERROR BLEEndPoint::HandleL2capChannelOpened()
+{
+    // A peripheral's end point is connected as soon as the central has opened the L2CAP channel.
+    SetFlag(mConnStateFlags, kConnState_L2capChannel, true);
+    mState = kState_Connecting;
+
+    return HandleReceiveConnectionComplete();
+}
+
+BLE_ERROR BLEEndPoint::ReceiveL2capSdu(PacketBuffer * data)
+{
+    BLE_ERROR err = BLE_NO_ERROR;
+
+    VerifyOrExit(GetFlag(mConnStateFlags, kConnState_L2capChannel), err = BLE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(IsConnected(mState), err = BLE_ERROR_INCORRECT_STATE);
+
+    // If we have a message received callback, and end point is not closing...
+    if (OnMessageReceived && mState != kState_Closing)
+    {
+        // Pass received message up the stack.
+        OnMessageReceived(this, data);
+        data = NULL;
+    }
+
+exit:
+    if (data != NULL)
+    {
+        // Free received message if there's no one to own it.
+        PacketBuffer::Free(data);
+    }
+
+    return err;
+}
+
+void BLEEndPoint::HandleL2capConnectComplete(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err)
+{
+    BLEEndPoint * ep = static_cast<BLEEndPoint *>(appState);
+
+    // Check for event-based timer race condition.
+    if (GetFlag(ep->mTimerStateFlags, kTimerState_L2capConnectTimerRunning))
+    {
+        SetFlag(ep->mTimerStateFlags, kTimerState_L2capConnectTimerRunning, false);
+
+        BLE_ERROR bleErr = ep->HandleConnectComplete();
+        if (bleErr != BLE_NO_ERROR)
+        {
+            ep->DoClose(kBleCloseFlag_AbortTransmission, bleErr);
+        }
+    }
+}
+#endif // BLE_CONFIG_L2CAP_COC_SUPPORTED
+
+bool BLEEndPoint::IsImmediateAckDue() const
+{
+    SequenceNumber_t threshold = BLE_CONFIG_IMMEDIATE_ACK_WINDOW_THRESHOLD;
+
+#if BLE_CONFIG_ADAPTIVE_ACK_TIMING
+    // Acknowledge once the configured fraction of the receive window is used, leaving at least 2 fragments of it.
+    SequenceNumber_t used = static_cast<SequenceNumber_t>(mReceiveWindowMaxSize * BLE_CONFIG_ACK_WINDOW_FRACTION / 100);
+
+    used = nl::Weave::max(used, static_cast<SequenceNumber_t>(2));
+
+    if (mReceiveWindowMaxSize > used)
+    {
+        threshold = nl::Weave::max(threshold, static_cast<SequenceNumber_t>(mReceiveWindowMaxSize - used));
+    }
+
+    // If the application usually answers the messages it receives, and has yet to answer the last one, hold the ack back
+    // for its answer to carry. The send-ack timer bounds the wait.
+    if (mMessageReceivedTime != 0 && mResponseTime != 0)
+    {
+        return false;
+    }
+#endif
+
+    return mLocalReceiveWindowSize <= threshold;
+}
+
+#if BLE_CONFIG_ADAPTIVE_ACK_TIMING
+void BLEEndPoint::HandleApplicationResponse()
+{
+    uint64_t now;
+    uint32_t responseTime;
+
+    // If the application isn't answering a received message, there's nothing to measure.
+    if (mMessageReceivedTime == 0)
+    {
+        return;
+    }
+
+    now                  = Weave::System::Layer::GetClock_MonotonicMS();
+    responseTime         = static_cast<uint32_t>(nl::Weave::min(now - mMessageReceivedTime,
+                                                                static_cast<uint64_t>(BTP_ACK_SEND_TIMEOUT_MS)));
+    mMessageReceivedTime = 0;
+
+    if (responseTime >= BTP_ACK_SEND_TIMEOUT_MS)
+    {
+        // Answer came too late to carry the ack.
+        mResponseTime = 0;
+    }
+    else
+    {
+        // Smooth the response time as 3/4 of the previous value plus 1/4 of the new one; 1 ms is the least.
+        mResponseTime = (mResponseTime == 0) ? responseTime : (3 * mResponseTime + responseTime) / 4;
+        mResponseTime = nl::Weave::max(mResponseTime, static_cast<uint32_t>(1));
+    }
+}
+#endif // BLE_CONFIG_ADAPTIVE_ACK_TIMING
+
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+bool BLEEndPoint::IsLinkBusy()
+{
+    // Link is busy while messages wait to be sent, a message is being fragmented, or a message is being reassembled.
+    return (mSendQueue != NULL || mWoBle.TxState() != WoBle::kState_Idle || mWoBle.RxState() == WoBle::kState_InProgress);
+}
+
+void BLEEndPoint::UpdateLinkThroughput()
+{
+    if (IsLinkBusy())
+    {
+        StopThroughputIdleTimer();
+
+        if (!GetFlag(mConnStateFlags, kConnState_HighThroughput))
+        {
+            // Ask once per busy period. If the platform can't change connection parameters, keep quiet about it.
+            if (mBle->mPlatformDelegate->RequestHighThroughput(mConnObj, true))
+            {
+                WeaveLogDebugBleEndPoint(Ble, "requested high-throughput connection parameters");
+                SetFlag(mConnStateFlags, kConnState_HighThroughput, true);
+            }
+        }
+    }
+    else if (GetFlag(mConnStateFlags, kConnState_HighThroughput) &&
+             !GetFlag(mTimerStateFlags, kTimerState_ThroughputIdleTimerRunning))
+    {
+        // Hold the parameters through short pauses between messages of the same exchange.
+        if (mBle->mSystemLayer->StartTimer(BLE_CONFIG_LINK_THROUGHPUT_IDLE_TIMEOUT, HandleThroughputIdleTimeout, this) ==
+            WEAVE_SYSTEM_NO_ERROR)
+        {
+            SetFlag(mTimerStateFlags, kTimerState_ThroughputIdleTimerRunning, true);
+        }
+    }
+}
+#endif // BLE_CONFIG_LINK_THROUGHPUT_POLICY
+
 bool BLEEndPoint::IsConnected(uint8_t state) const
 {
     return (state == kState_Connected || state == kState_Closing);
@@ -340,6 +524,14 @@ void BLEEndPoint::DoClose(uint8_t flags, BLE_ERROR err)
         if (mRole == kBleRole_Central)
         {
             StopConnectTimer();
+
+#if BLE_CONFIG_PEER_CACHE_SIZE > 0
+            // Don't abbreviate the next handshake with a peripheral this one failed with.
+            if (oldState == kState_Connecting && err != BLE_NO_ERROR && mPeerKey != 0)
+            {
+                mBle->InvalidatePeerCache(mPeerKey);
+            }
+#endif
         }
         else // (mRole == kBleRole_Peripheral), verified on Init
         {
@@ -465,6 +657,14 @@ void BLEEndPoint::ReleaseBleConnection()
 {
     if (mConnObj != BLE_CONNECTION_UNINITIALIZED)
     {
+#if BLE_CONFIG_L2CAP_COC_SUPPORTED
+        if (GetFlag(mConnStateFlags, kConnState_L2capChannel))
+        {
+            // Signal close of the WeaveConnection to the remote device by closing the L2CAP channel.
+            mBle->mPlatformDelegate->CloseL2capChannel(mConnObj);
+        }
+#endif // BLE_CONFIG_L2CAP_COC_SUPPORTED
+
         if (GetFlag(mConnStateFlags, kConnState_AutoClose))
         {
             WeaveLogProgress(Ble, "Auto-closing end point's BLE connection.");
@@ -472,6 +672,15 @@ void BLEEndPoint::ReleaseBleConnection()
         }
         else
         {
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+            // Don't leave the application's connection running at high-throughput parameters.
+            if (GetFlag(mConnStateFlags, kConnState_HighThroughput))
+            {
+                mBle->mPlatformDelegate->RequestHighThroughput(mConnObj, false);
+                SetFlag(mConnStateFlags, kConnState_HighThroughput, false);
+            }
+#endif
+
             WeaveLogProgress(Ble, "Releasing end point's BLE connection back to application.");
             mBle->mApplicationDelegate->NotifyWeaveConnectionClosed(mConnObj);
         }
@@ -500,6 +709,16 @@ void BLEEndPoint::Free()
     StopAckReceivedTimer();
     StopSendAckTimer();
     StopUnsubscribeTimer();
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+    StopSendCompleteTimer();
+#endif
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+    StopThroughputIdleTimer();
+#endif
+#if BLE_CONFIG_L2CAP_COC_SUPPORTED
+    mBle->mSystemLayer->CancelTimer(HandleL2capConnectComplete, this);
+    SetFlag(mTimerStateFlags, kTimerState_L2capConnectTimerRunning, false);
+#endif
 #if WEAVE_ENABLE_WOBLE_TEST
     mWoBleTest.StopTestTimer();
     // Clear callback
@@ -593,6 +812,13 @@ BLE_ERROR BLEEndPoint::Init(BleLayer * bleLayer, BLE_CONNECTION_OBJECT connObj,
     mReceiveWindowMaxSize    = 0;
     mSendQueue               = NULL;
     mAckToSend               = NULL;
+#if BLE_CONFIG_ADAPTIVE_ACK_TIMING
+    mMessageReceivedTime = 0;
+    mResponseTime        = 0;
+#endif
+#if BLE_CONFIG_PEER_CACHE_SIZE > 0
+    mPeerKey = 0;
+#endif
 
     WeaveLogDebugBleEndPoint(Ble, "initialized local rx window, size = %u", mLocalReceiveWindowSize);
 
@@ -607,6 +833,22 @@ BLE_ERROR BLEEndPoint::SendCharacteristic(PacketBuffer * buf)
 {
     BLE_ERROR err = BLE_NO_ERROR;
 
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+    if (GetFlag(mConnStateFlags, kConnState_UnconfirmedGattOps))
+    {
+        if (!SendUnconfirmed(buf))
+        {
+            err = (mRole == kBleRole_Central) ? BLE_ERROR_GATT_WRITE_FAILED : BLE_ERROR_GATT_INDICATE_FAILED;
+        }
+        else
+        {
+            // Send succeeded, so shrink remote receive window counter by 1.
+            mRemoteReceiveWindowSize -= 1;
+            WeaveLogDebugBleEndPoint(Ble, "decremented remote rx window, new size = %u", mRemoteReceiveWindowSize);
+        }
+    }
+    else
+#endif // BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
     if (mRole == kBleRole_Central)
     {
         if (!SendWrite(buf))
@@ -674,6 +916,10 @@ BLE_ERROR BLEEndPoint::Send(PacketBuffer * data)
     VerifyOrExit(data != NULL, err = BLE_ERROR_BAD_ARGS);
     VerifyOrExit(IsConnected(mState), err = BLE_ERROR_INCORRECT_STATE);
 
+#if BLE_CONFIG_ADAPTIVE_ACK_TIMING
+    HandleApplicationResponse();
+#endif
+
     // Ensure outgoing message fits in a single contiguous PacketBuffer, as currently required by the
     // message fragmentation and reassembly engine.
     if (data->Next() != NULL)
@@ -687,6 +933,18 @@ BLE_ERROR BLEEndPoint::Send(PacketBuffer * data)
         }
     }
 
+#if BLE_CONFIG_L2CAP_COC_SUPPORTED
+    if (GetFlag(mConnStateFlags, kConnState_L2capChannel))
+    {
+        // The BLE stack segments the message and flow-controls it with LE credits, so hand it to the platform as is.
+        bool sent = mBle->mPlatformDelegate->SendL2capSdu(mConnObj, data);
+        data      = NULL; // Ownership passed to platform.
+
+        VerifyOrExit(sent, err = BLE_ERROR_L2CAP_SEND_FAILED);
+        ExitNow();
+    }
+#endif // BLE_CONFIG_L2CAP_COC_SUPPORTED
+
     // Add new message to send queue.
     QueueTx(data, kType_Data);
     data = NULL; // Buffer freed when send queue freed on close, or on completion of current message transmission.
@@ -714,8 +972,16 @@ exit:
 bool BLEEndPoint::PrepareNextFragment(PacketBuffer * data, bool & sentAck)
 {
     // If we have a pending fragment acknowledgement to send, piggyback it on the fragment we're about to transmit.
-    if (GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning))
+    // This includes a stand-alone ack that is due but not yet sent, which the fragment's ack makes redundant.
+    if (GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning) ||
+        (mAckToSend != NULL && !GetFlag(mConnStateFlags, kConnState_StandAloneAckInFlight)))
     {
+        if (mAckToSend != NULL && !GetFlag(mConnStateFlags, kConnState_StandAloneAckInFlight))
+        {
+            PacketBuffer::Free(mAckToSend);
+            mAckToSend = NULL;
+        }
+
         // Reset local receive window counter.
         mLocalReceiveWindowSize = mReceiveWindowMaxSize;
         WeaveLogDebugBleEndPoint(Ble, "reset local rx window on piggyback ack tx, size = %u", mLocalReceiveWindowSize);
@@ -842,7 +1108,13 @@ BLE_ERROR BLEEndPoint::HandleHandshakeConfirmationReceived()
     mSendQueue = PacketBuffer::FreeHead(mSendQueue);
     QueueTxUnlock();
 
-    if (mRole == kBleRole_Central)
+    if (mRole == kBleRole_Central && GetFlag(mConnStateFlags, kConnState_DidBeginSubscribe))
+    {
+        // Abbreviated handshake: the subscribe request went out with the capabilities request, and remains the GATT
+        // operation in flight until it completes.
+        SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, GetFlag(mConnStateFlags, kConnState_SubscribeInFlight));
+    }
+    else if (mRole == kBleRole_Central)
     {
         // Subscribe to characteristic which peripheral will use to send indications. Prompts peripheral to send
         // BLE transport capabilities indication.
@@ -851,6 +1123,7 @@ BLE_ERROR BLEEndPoint::HandleHandshakeConfirmationReceived()
 
         // We just sent a GATT subscribe request, so make sure to attempt unsubscribe on close.
         SetFlag(mConnStateFlags, kConnState_DidBeginSubscribe, true);
+        SetFlag(mConnStateFlags, kConnState_SubscribeInFlight, true);
 
         // Mark GATT operation in progress for subscribe request.
         SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, true);
@@ -863,7 +1136,7 @@ BLE_ERROR BLEEndPoint::HandleHandshakeConfirmationReceived()
         {
             // If local receive window size has shrunk to or below immediate ack threshold, AND a message fragment is not
             // pending on which to piggyback an ack, send immediate stand-alone ack.
-            if (mLocalReceiveWindowSize <= BLE_CONFIG_IMMEDIATE_ACK_WINDOW_THRESHOLD && mSendQueue == NULL)
+            if (IsImmediateAckDue() && mSendQueue == NULL)
             {
                 err = DriveStandAloneAck(); // Encode stand-alone ack and drive sending.
                 SuccessOrExit(err);
@@ -929,8 +1202,7 @@ BLE_ERROR BLEEndPoint::HandleFragmentConfirmationReceived()
     // This check covers the case where the local receive window has shrunk between transmission and confirmation of
     // the stand-alone ack, and also the case where a window size < the immediate ack threshold was detected in
     // Receive(), but the stand-alone ack was deferred due to a pending outbound message fragment.
-    if (mLocalReceiveWindowSize <= BLE_CONFIG_IMMEDIATE_ACK_WINDOW_THRESHOLD &&
-        !(mSendQueue != NULL || mWoBle.TxState() == WoBle::kState_InProgress) )
+    if (IsImmediateAckDue() && !(mSendQueue != NULL || mWoBle.TxState() == WoBle::kState_InProgress))
     {
         err = DriveStandAloneAck(); // Encode stand-alone ack and drive sending.
         SuccessOrExit(err);
@@ -1051,7 +1323,8 @@ BLE_ERROR BLEEndPoint::DriveSending()
 
     // Otherwise, let's see what we can send.
 
-    if (mAckToSend != NULL) // If immediate, stand-alone ack is pending, send it.
+    // If immediate, stand-alone ack is pending, send it, unless a message fragment is ready to carry it instead.
+    if (mAckToSend != NULL && mSendQueue == NULL && mWoBle.TxState() != WoBle::kState_InProgress)
     {
         err = DoSendStandAloneAck();
         SuccessOrExit(err);
@@ -1107,6 +1380,13 @@ BLE_ERROR BLEEndPoint::DriveSending()
     }
 
 exit:
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+    if (err == BLE_NO_ERROR && IsConnected(mState))
+    {
+        UpdateLinkThroughput();
+    }
+#endif
+
     return err;
 }
 
@@ -1183,6 +1463,12 @@ BLE_ERROR BLEEndPoint::HandleCapabilitiesRequestReceived(PacketBuffer * data)
         // This is the peripheral, so set Rx fragment size, and leave Tx at default
         mWoBle.SetRxFragmentSize(resp.mFragmentSize);
     }
+
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+    // The capabilities response is still indicated; fragments after it are notified.
+    SetFlag(mConnStateFlags, kConnState_UnconfirmedGattOps,
+            resp.mSelectedProtocolVersion >= kBleTransportProtocolVersion_V4);
+#endif
     WeaveLogProgress(Ble, "using BTP fragment sizes rx %d / tx %d.", mWoBle.GetRxFragmentSize(), mWoBle.GetTxFragmentSize());
 
     err = resp.Encode(responseBuf);
@@ -1247,13 +1533,36 @@ BLE_ERROR BLEEndPoint::HandleCapabilitiesResponseReceived(PacketBuffer * data)
         // This is the central, so set Tx fragement size, and leave Rx at default.
         mWoBle.SetTxFragmentSize(resp.mFragmentSize);
     }
+
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+    SetFlag(mConnStateFlags, kConnState_UnconfirmedGattOps,
+            resp.mSelectedProtocolVersion >= kBleTransportProtocolVersion_V4);
+#endif
     WeaveLogProgress(Ble, "using BTP fragment sizes rx %d / tx %d.", mWoBle.GetRxFragmentSize(), mWoBle.GetTxFragmentSize());
 
     // Select local and remote max receive window size based on local resources available for both incoming indications
-    // AND GATT confirmations.
-    mRemoteReceiveWindowSize = mLocalReceiveWindowSize = mReceiveWindowMaxSize = resp.mWindowSize;
+    // AND GATT confirmations. The peripheral chooses no more than the central requested, but never trust it to.
+    VerifyOrExit(resp.mWindowSize > 0, err = BLE_ERROR_INVALID_MESSAGE);
+    mRemoteReceiveWindowSize = mLocalReceiveWindowSize = mReceiveWindowMaxSize =
+        nl::Weave::min(resp.mWindowSize, static_cast<uint8_t>(BLE_MAX_RECEIVE_WINDOW_SIZE));
+
+    WeaveLogProgress(Ble, "local and remote recv window size = %u", mReceiveWindowMaxSize);
+
+#if BLE_CONFIG_PEER_CACHE_SIZE > 0
+    if (mPeerKey != 0)
+    {
+        const BleLayer::PeerCacheEntry * cached = mBle->LookupPeerCache(mPeerKey);
 
-    WeaveLogProgress(Ble, "local and remote recv window size = %u", resp.mWindowSize);
+        if (cached != NULL &&
+            (cached->ProtocolVersion != resp.mSelectedProtocolVersion || cached->FragmentSize != resp.mFragmentSize ||
+             cached->WindowSize != mReceiveWindowMaxSize))
+        {
+            WeaveLogProgress(Ble, "known peer changed BTP parameters, ep = %p", this);
+        }
+
+        mBle->UpdatePeerCache(mPeerKey, resp.mSelectedProtocolVersion, resp.mFragmentSize, mReceiveWindowMaxSize);
+    }
+#endif
 
     // Shrink local receive window counter by 1, since connect handshake indication requires acknowledgement.
     mLocalReceiveWindowSize -= 1;
@@ -1394,6 +1703,25 @@ BLE_ERROR BLEEndPoint::Receive(PacketBuffer * data)
     mLocalReceiveWindowSize -= 1;
     WeaveLogDebugBleEndPoint(Ble, "decremented local rx window, new size = %u", mLocalReceiveWindowSize);
 
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+    // Speed up the link for the rest of a multi-fragment message.
+    UpdateLinkThroughput();
+#endif
+
+#if BLE_CONFIG_ADAPTIVE_ACK_TIMING
+    if (mWoBle.RxState() == WoBle::kState_Complete)
+    {
+        // If the application never answered the previous message, it isn't expected to answer this one either.
+        if (mMessageReceivedTime != 0)
+        {
+            mResponseTime = 0;
+        }
+
+        // Note when the message was received, to measure how soon the application answers it.
+        mMessageReceivedTime = Weave::System::Layer::GetClock_MonotonicMS();
+    }
+#endif
+
     // Respond to received ack, if any.
     if (didReceiveAck)
     {
@@ -1450,8 +1778,7 @@ BLE_ERROR BLEEndPoint::Receive(PacketBuffer * data)
     // this threshold again when the GATT operation is confirmed.
     if (mWoBle.HasUnackedData())
     {
-        if (mLocalReceiveWindowSize <= BLE_CONFIG_IMMEDIATE_ACK_WINDOW_THRESHOLD &&
-            !GetFlag(mConnStateFlags, kConnState_GattOperationInFlight))
+        if (IsImmediateAckDue() && !GetFlag(mConnStateFlags, kConnState_GattOperationInFlight))
         {
             WeaveLogDebugBleEndPoint(Ble, "sending immediate ack");
             err = DriveStandAloneAck();
@@ -1541,6 +1868,33 @@ bool BLEEndPoint::SendIndication(PacketBuffer * buf)
     return mBle->mPlatformDelegate->SendIndication(mConnObj, &WEAVE_BLE_SVC_ID, &mBle->WEAVE_BLE_CHAR_2_ID, buf);
 }
 
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+bool BLEEndPoint::SendUnconfirmed(PacketBuffer * buf)
+{
+    bool sent;
+
+    // Add reference to message fragment for duration of platform's GATT operation, as for SendWrite() and
+    // SendIndication(). The platform copies the fragment before it returns, so the reference is typically released
+    // before the call returns.
+    buf->AddRef();
+
+    SetFlag(mConnStateFlags, kConnState_GattOperationInFlight, true);
+
+    if (mRole == kBleRole_Central)
+    {
+        sent = mBle->mPlatformDelegate->SendWriteWithoutResponse(mConnObj, &WEAVE_BLE_SVC_ID, &mBle->WEAVE_BLE_CHAR_1_ID, buf);
+    }
+    else
+    {
+        sent = mBle->mPlatformDelegate->SendNotification(mConnObj, &WEAVE_BLE_SVC_ID, &mBle->WEAVE_BLE_CHAR_2_ID, buf);
+    }
+
+    // No GATT confirmation will arrive for the operation, so complete it from the event loop instead. The transmit path
+    // then proceeds as on confirmation, sending the next fragment while the remote receive window is open.
+    return (sent && StartSendCompleteTimer() == BLE_NO_ERROR);
+}
+#endif // BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+
 BLE_ERROR BLEEndPoint::StartConnectTimer()
 {
     BLE_ERROR err = BLE_NO_ERROR;
@@ -1608,8 +1962,19 @@ BLE_ERROR BLEEndPoint::StartSendAckTimer()
 
     if (!GetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning))
     {
+        uint32_t timeoutMs = BTP_ACK_SEND_TIMEOUT_MS;
+
+#if BLE_CONFIG_ADAPTIVE_ACK_TIMING
+        // If the application is expected to answer the last message received, wait for the answer to carry the ack
+        // for up to twice as long as the application usually takes.
+        if (mMessageReceivedTime != 0 && mResponseTime != 0)
+        {
+            timeoutMs = nl::Weave::min(timeoutMs, 2 * mResponseTime);
+        }
+#endif
+
         WeaveLogDebugBleEndPoint(Ble, "starting new SendAckTimer");
-        timerErr = mBle->mSystemLayer->StartTimer(BTP_ACK_SEND_TIMEOUT_MS, HandleSendAckTimeout, this);
+        timerErr = mBle->mSystemLayer->StartTimer(timeoutMs, HandleSendAckTimeout, this);
         VerifyOrExit(timerErr == WEAVE_SYSTEM_NO_ERROR, err = BLE_ERROR_START_TIMER_FAILED);
 
         SetFlag(mTimerStateFlags, kTimerState_SendAckTimerRunning, true);
@@ -1632,6 +1997,21 @@ exit:
     return err;
 }
 
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+BLE_ERROR BLEEndPoint::StartSendCompleteTimer()
+{
+    BLE_ERROR err = BLE_NO_ERROR;
+    Weave::System::Error timerErr;
+
+    timerErr = mBle->mSystemLayer->StartTimer(0, HandleSendCompleteTimeout, this);
+    VerifyOrExit(timerErr == WEAVE_SYSTEM_NO_ERROR, err = BLE_ERROR_START_TIMER_FAILED);
+    SetFlag(mTimerStateFlags, kTimerState_SendCompleteTimerRunning, true);
+
+exit:
+    return err;
+}
+#endif // BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+
 void BLEEndPoint::StopConnectTimer()
 {
     // Cancel any existing connect timer.
@@ -1667,6 +2047,24 @@ void BLEEndPoint::StopUnsubscribeTimer()
     SetFlag(mTimerStateFlags, kTimerState_UnsubscribeTimerRunning, false);
 }
 
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+void BLEEndPoint::StopSendCompleteTimer()
+{
+    // Cancel any pending completion of an unconfirmed GATT send.
+    mBle->mSystemLayer->CancelTimer(HandleSendCompleteTimeout, this);
+    SetFlag(mTimerStateFlags, kTimerState_SendCompleteTimerRunning, false);
+}
+#endif // BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+void BLEEndPoint::StopThroughputIdleTimer()
+{
+    // Cancel any pending release of high-throughput connection parameters.
+    mBle->mSystemLayer->CancelTimer(HandleThroughputIdleTimeout, this);
+    SetFlag(mTimerStateFlags, kTimerState_ThroughputIdleTimerRunning, false);
+}
+#endif // BLE_CONFIG_LINK_THROUGHPUT_POLICY
+
 void BLEEndPoint::HandleConnectTimeout(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err)
 {
     BLEEndPoint * ep = static_cast<BLEEndPoint *>(appState);
@@ -1716,6 +2114,16 @@ void BLEEndPoint::HandleSendAckTimeout(Weave::System::Layer * systemLayer, void
     {
         SetFlag(ep->mTimerStateFlags, kTimerState_SendAckTimerRunning, false);
 
+#if BLE_CONFIG_ADAPTIVE_ACK_TIMING
+        // If the application hasn't answered the last message received in time to carry its ack, stop holding acks
+        // back for its answers.
+        if (ep->mMessageReceivedTime != 0)
+        {
+            ep->mMessageReceivedTime = 0;
+            ep->mResponseTime        = 0;
+        }
+#endif
+
         // If previous stand-alone ack isn't still in flight...
         if (!GetFlag(ep->mConnStateFlags, kConnState_StandAloneAckInFlight))
         {
@@ -1742,6 +2150,40 @@ void BLEEndPoint::HandleUnsubscribeTimeout(Weave::System::Layer * systemLayer, v
     }
 }
 
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+void BLEEndPoint::HandleSendCompleteTimeout(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err)
+{
+    BLEEndPoint * ep = static_cast<BLEEndPoint *>(appState);
+
+    // Check for event-based timer race condition.
+    if (GetFlag(ep->mTimerStateFlags, kTimerState_SendCompleteTimerRunning))
+    {
+        SetFlag(ep->mTimerStateFlags, kTimerState_SendCompleteTimerRunning, false);
+        ep->HandleGattSendConfirmationReceived();
+    }
+}
+#endif // BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+void BLEEndPoint::HandleThroughputIdleTimeout(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err)
+{
+    BLEEndPoint * ep = static_cast<BLEEndPoint *>(appState);
+
+    // Check for event-based timer race condition.
+    if (GetFlag(ep->mTimerStateFlags, kTimerState_ThroughputIdleTimerRunning))
+    {
+        SetFlag(ep->mTimerStateFlags, kTimerState_ThroughputIdleTimerRunning, false);
+
+        if (!ep->IsLinkBusy() && GetFlag(ep->mConnStateFlags, kConnState_HighThroughput))
+        {
+            WeaveLogDebugBleEndPoint(Ble, "link idle, releasing high-throughput connection parameters");
+            ep->mBle->mPlatformDelegate->RequestHighThroughput(ep->mConnObj, false);
+            SetFlag(ep->mConnStateFlags, kConnState_HighThroughput, false);
+        }
+    }
+}
+#endif // BLE_CONFIG_LINK_THROUGHPUT_POLICY
+
 } /* namespace Ble */
 } /* namespace nl */
 
@@ -115,8 +115,13 @@ private:
         kConnState_CapabilitiesMsgReceived  = 0x04, // Capabilities request or response message received.
         kConnState_DidBeginSubscribe        = 0x08, // GATT subscribe request sent; must unsubscribe on close.
         kConnState_StandAloneAckInFlight    = 0x10, // Stand-alone ack in flight, awaiting GATT confirmation.
-        kConnState_GattOperationInFlight    = 0x20  // GATT write, indication, subscribe, or unsubscribe in flight,
+        kConnState_GattOperationInFlight    = 0x20, // GATT write, indication, subscribe, or unsubscribe in flight,
                                                     // awaiting GATT confirmation.
+        kConnState_UnconfirmedGattOps       = 0x40, // Fragments sent by GATT notification or write without response.
+        kConnState_L2capChannel             = 0x80, // Messages sent as SDUs on an L2CAP channel rather than over BTP.
+        kConnState_SubscribeInFlight        = 0x100, // GATT subscribe request in flight, possibly alongside the
+                                                     // capabilities request write.
+        kConnState_HighThroughput           = 0x200  // High-throughput connection parameters requested from platform.
     };
 
     enum TimerStateFlags
@@ -126,9 +131,12 @@ private:
         kTimerState_AckReceivedTimerRunning       = 0x04, // Ack received timer running due to unacked sent fragment.
         kTimerState_SendAckTimerRunning           = 0x08, // Send ack timer running; indicates pending ack to send.
         kTimerState_UnsubscribeTimerRunning       = 0x10, // Unsubscribe completion timer running.
+        kTimerState_SendCompleteTimerRunning      = 0x20, // Completion of unconfirmed GATT send pending.
+        kTimerState_L2capConnectTimerRunning      = 0x40, // Completion of connect on an L2CAP channel pending.
 #if WEAVE_ENABLE_WOBLE_TEST
-        kTimerState_UnderTestTimerRunnung = 0x80 // running throughput Tx test
+        kTimerState_UnderTestTimerRunnung = 0x80, // running throughput Tx test
 #endif
+        kTimerState_ThroughputIdleTimerRunning    = 0x100 // Release of high-throughput connection parameters pending.
     };
 
     // BLE connection to which an end point is uniquely bound. Type BLE_CONNECTION_OBJECT is defined by the platform or
@@ -148,11 +156,18 @@ private:
 
     WoBle mWoBle;
     BleRole mRole;
-    uint8_t mConnStateFlags;
-    uint8_t mTimerStateFlags;
+    uint16_t mConnStateFlags;
+    uint16_t mTimerStateFlags;
     SequenceNumber_t mLocalReceiveWindowSize;
     SequenceNumber_t mRemoteReceiveWindowSize;
     SequenceNumber_t mReceiveWindowMaxSize;
+#if BLE_CONFIG_ADAPTIVE_ACK_TIMING
+    uint64_t mMessageReceivedTime; // Time, in ms, the last message was received, until the application answers it.
+    uint32_t mResponseTime;        // Smoothed time, in ms, the application takes to answer a received message, or 0.
+#endif
+#if BLE_CONFIG_PEER_CACHE_SIZE > 0
+    uint64_t mPeerKey; // Platform key of the remote peripheral, or 0 if it could not be identified.
+#endif
 #if WEAVE_ENABLE_WOBLE_TEST
     nl::Weave::System::Mutex mTxQueueMutex; // For MT-safe Tx queuing
 #endif
@@ -176,6 +191,16 @@ private:
     BLE_ERROR SendCharacteristic(PacketBuffer * buf);
     bool SendIndication(PacketBuffer * buf);
     bool SendWrite(PacketBuffer * buf);
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+    bool SendUnconfirmed(PacketBuffer * buf);
+#endif
+
+#if BLE_CONFIG_L2CAP_COC_SUPPORTED
+    // L2CAP channel transport:
+    BLE_ERROR HandleL2capChannelOpened(void);
+    BLE_ERROR ReceiveL2capSdu(PacketBuffer * data);
+    static void HandleL2capConnectComplete(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err);
+#endif
 
     // Receive path:
     BLE_ERROR HandleConnectComplete(void);
@@ -190,6 +215,14 @@ private:
     BLE_ERROR HandleCapabilitiesResponseReceived(PacketBuffer * data);
     SequenceNumber_t AdjustRemoteReceiveWindow(SequenceNumber_t lastReceivedAck, SequenceNumber_t maxRemoteWindowSize,
                                                SequenceNumber_t newestUnackedSentSeqNum);
+    bool IsImmediateAckDue(void) const;
+#if BLE_CONFIG_ADAPTIVE_ACK_TIMING
+    void HandleApplicationResponse(void);
+#endif
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+    bool IsLinkBusy(void);
+    void UpdateLinkThroughput(void);
+#endif
 
     // Timer control functions:
     BLE_ERROR StartConnectTimer(void);           // Start connect timer.
@@ -198,11 +231,20 @@ private:
     BLE_ERROR RestartAckReceivedTimer(void);     // Restart ack-received timer.
     BLE_ERROR StartSendAckTimer(void);           // Start send-ack timer if it's not already running.
     BLE_ERROR StartUnsubscribeTimer(void);
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+    BLE_ERROR StartSendCompleteTimer(void); // Start timer completing an unconfirmed GATT send.
+#endif
     void StopConnectTimer(void);           // Stop connect timer.
     void StopReceiveConnectionTimer(void); // Stop receive connection timer.
     void StopAckReceivedTimer(void);       // Stop ack-received timer.
     void StopSendAckTimer(void);           // Stop send-ack timer.
     void StopUnsubscribeTimer(void);       // Stop unsubscribe timer.
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+    void StopSendCompleteTimer(void); // Stop send complete timer.
+#endif
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+    void StopThroughputIdleTimer(void); // Stop timer releasing high-throughput connection parameters.
+#endif
 
     // Timer expired callbacks:
     static void HandleConnectTimeout(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err);
@@ -210,6 +252,12 @@ private:
     static void HandleAckReceivedTimeout(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err);
     static void HandleSendAckTimeout(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err);
     static void HandleUnsubscribeTimeout(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err);
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+    static void HandleSendCompleteTimeout(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err);
+#endif
+#if BLE_CONFIG_LINK_THROUGHPUT_POLICY
+    static void HandleThroughputIdleTimeout(Weave::System::Layer * systemLayer, void * appState, Weave::System::Error err);
+#endif
 
     // Close functions:
     void DoCloseCallback(uint8_t state, uint8_t flags, BLE_ERROR err);
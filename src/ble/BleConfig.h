@@ -91,7 +91,9 @@
  *    This defines the number of BLEEndPoint objects allocated for use by the
  *    BleLayer subsystem. Value should be defined as the minimum of (max number
  *    of simultaneous BLE connections the system supports, max number of
- *    simultaneous BLE connections the application will establish).
+ *    simultaneous BLE connections the application will establish), e.g. the
+ *    number of devices a commissioning station provisions in parallel, each
+ *    with its own WeaveDeviceManager.
  */
 #ifndef BLE_LAYER_NUM_BLE_ENDPOINTS
 #define BLE_LAYER_NUM_BLE_ENDPOINTS 1
@@ -178,7 +180,9 @@
  *    BLE_CONFIG_IMMEDIATE_ACK_WINDOW_THRESHOLD with receipt of any single message fragment.
  *
  *    Default value of 3 is absolute minimum for stable performance, and an attempt to ensure safe window sizes on new
- *    platforms.
+ *    platforms. Platforms with the GATT buffers to spare may raise it, e.g. to 16, so that bulk transfers such as
+ *    certificate exchange during pairing stall less often on a closed window and need fewer stand-alone acks. The
+ *    window of a connection is negotiated in the BTP capabilities handshake as the smaller of both peers' values.
  *
  */
 #ifndef BLE_MAX_RECEIVE_WINDOW_SIZE
@@ -189,6 +193,157 @@
 #error "BLE_MAX_RECEIVE_WINDOW_SIZE must be greater than 2 for BLE transport protocol stability."
 #endif
 
+#if (BLE_MAX_RECEIVE_WINDOW_SIZE > 127)
+#error "BLE_MAX_RECEIVE_WINDOW_SIZE must be less than half the BTP sequence number space."
+#endif
+
+/**
+ *  @def BLE_CONFIG_MAX_FRAGMENT_SIZE
+ *
+ *  @brief
+ *    This is the maximum size, in bytes, of a BTP fragment, i.e. of the value of the WoBLE write and indication
+ *    characteristics. The fragment size of a connection is negotiated in the BTP capabilities handshake as the
+ *    smaller of this value and the connection's ATT MTU less the 3-byte ATT operation header.
+ *
+ *    Platforms supporting a larger ATT MTU may raise this value to exchange fewer, larger fragments, e.g. to 244
+ *    to fill a single link-layer packet with the BLE 4.2 data length extension (ATT MTU of 247), or up to 512, the
+ *    maximum length of a characteristic value. The value must not exceed the length of the WoBLE characteristics
+ *    declared by the platform, and a fragment must fit in a PacketBuffer.
+ *
+ */
+#ifndef BLE_CONFIG_MAX_FRAGMENT_SIZE
+#define BLE_CONFIG_MAX_FRAGMENT_SIZE                           128
+#endif // BLE_CONFIG_MAX_FRAGMENT_SIZE
+
+#if (BLE_CONFIG_MAX_FRAGMENT_SIZE < 20) || (BLE_CONFIG_MAX_FRAGMENT_SIZE > 512)
+#error "BLE_CONFIG_MAX_FRAGMENT_SIZE must be between 20, for the minimum ATT MTU, and 512, the maximum characteristic value length."
+#endif
+
+/**
+ *  @def BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+ *
+ *  @brief
+ *    This enables BTP protocol version 4, in which message fragments and stand-alone acks are sent with GATT
+ *    notifications and writes without response instead of indications and writes with response. BTP acks alone then
+ *    provide reliability, and a BLE end point sends as many fragments as the remote receive window allows without
+ *    waiting a connection event for the GATT confirmation of each, so that several fragments may go out per connection
+ *    event.
+ *
+ *    The version is only selected when both peers support it, and the capabilities handshake itself still uses
+ *    confirmed GATT operations. Platforms enabling it must implement BlePlatformDelegate::SendNotification() and
+ *    BlePlatformDelegate::SendWriteWithoutResponse(), declare the WoBLE characteristics with the notify and
+ *    write-without-response properties, and, as centrals, subscribe to both indications and notifications.
+ *
+ */
+#ifndef BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+#define BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS                 0
+#endif // BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+
+/**
+ *  @def BLE_CONFIG_L2CAP_COC_SUPPORTED
+ *
+ *  @brief
+ *    This enables Weave over BLE on L2CAP connection-oriented channels with LE credit-based flow control, as an
+ *    alternative to the GATT-based BLE transport protocol. Each Weave message is sent as one L2CAP SDU, which the
+ *    BLE stack segments and flow-controls, so there is no ATT header per fragment, and no BTP handshake,
+ *    fragmentation or acknowledgement.
+ *
+ *    The transport is used for a BLE connection on which the platform reports an open Weave L2CAP channel: a
+ *    central opens the channel before it calls WeaveConnection::ConnectBle(), and a peripheral reports channels it
+ *    accepts with BleLayer::HandleL2capChannelOpened(). The PSM of the channel is agreed on by the applications, e.g.
+ *    advertised by the peripheral. Platforms enabling it must implement the L2CAP functions of BlePlatformDelegate.
+ *
+ */
+#ifndef BLE_CONFIG_L2CAP_COC_SUPPORTED
+#define BLE_CONFIG_L2CAP_COC_SUPPORTED                         0
+#endif // BLE_CONFIG_L2CAP_COC_SUPPORTED
+
+/**
+ *  @def BLE_CONFIG_ADAPTIVE_ACK_TIMING
+ *
+ *  @brief
+ *    This enables adaptive timing of BTP stand-alone acks, which are otherwise sent when a BLE end point's receive
+ *    window is nearly closed or its send-ack timer expires.
+ *
+ *    With it, an end point acknowledges a stream of fragments once BLE_CONFIG_ACK_WINDOW_FRACTION percent of its
+ *    receive window is used, so that a peer with a large window is not stopped waiting for the ack. And it measures
+ *    how soon the application answers the messages it receives: while it does, the ack of a received message is held
+ *    back for up to twice that time, rather than sent at once, so that it is piggybacked on the answer instead of
+ *    taking a fragment of its own.
+ *
+ *    Adaptive ack timing is local to the end point, and needs no support from the peer.
+ *
+ */
+#ifndef BLE_CONFIG_ADAPTIVE_ACK_TIMING
+#define BLE_CONFIG_ADAPTIVE_ACK_TIMING                         1
+#endif // BLE_CONFIG_ADAPTIVE_ACK_TIMING
+
+/**
+ *  @def BLE_CONFIG_PEER_CACHE_SIZE
+ *
+ *  @brief
+ *    The number of remote peripherals for which a central BleLayer remembers the parameters of the last successful
+ *    BTP handshake, least recently connected first out. 0 disables the cache.
+ *
+ *    Peripherals are identified by the key the platform returns from BlePlatformDelegate::GetPeerKey(). When
+ *    reconnecting to a cached peripheral, the central subscribes to the peripheral's indication characteristic right
+ *    after writing its capabilities request, rather than once that write is confirmed, which saves a GATT round trip
+ *    from the handshake. An entry is dropped whenever a handshake with its peripheral fails, so the next connect
+ *    falls back to the full handshake.
+ *
+ */
+#ifndef BLE_CONFIG_PEER_CACHE_SIZE
+#define BLE_CONFIG_PEER_CACHE_SIZE                             4
+#endif // BLE_CONFIG_PEER_CACHE_SIZE
+
+/**
+ *  @def BLE_CONFIG_LINK_THROUGHPUT_POLICY
+ *
+ *  @brief
+ *    This enables a policy by which a BLE end point asks the platform, through
+ *    BlePlatformDelegate::RequestHighThroughput(), for high-throughput connection parameters, such as a short
+ *    connection interval and the 2M PHY, while it has WoBLE message fragments to send or is receiving a multi-fragment
+ *    message. Once it has been idle for BLE_CONFIG_LINK_THROUGHPUT_IDLE_TIMEOUT, it asks for the platform's power-saving
+ *    parameters back.
+ *
+ *    Platforms that don't implement RequestHighThroughput() are unaffected.
+ *
+ */
+#ifndef BLE_CONFIG_LINK_THROUGHPUT_POLICY
+#define BLE_CONFIG_LINK_THROUGHPUT_POLICY                      1
+#endif // BLE_CONFIG_LINK_THROUGHPUT_POLICY
+
+/**
+ *  @def BLE_CONFIG_LINK_THROUGHPUT_IDLE_TIMEOUT
+ *
+ *  @brief
+ *    With BLE_CONFIG_LINK_THROUGHPUT_POLICY, the time, in milliseconds, a BLE end point must have nothing to send or
+ *    reassemble before it releases its request for high-throughput connection parameters. Protocol exchanges such as
+ *    certificate-based session establishment pause briefly between messages, so this should span such pauses.
+ *
+ */
+#ifndef BLE_CONFIG_LINK_THROUGHPUT_IDLE_TIMEOUT
+#define BLE_CONFIG_LINK_THROUGHPUT_IDLE_TIMEOUT                2000 // 2 seconds
+#endif // BLE_CONFIG_LINK_THROUGHPUT_IDLE_TIMEOUT
+
+/**
+ *  @def BLE_CONFIG_ACK_WINDOW_FRACTION
+ *
+ *  @brief
+ *    With BLE_CONFIG_ADAPTIVE_ACK_TIMING, this is the percentage of a BLE end point's receive window that received
+ *    fragments may use before the end point acknowledges them. At least 2 fragments are always left unacknowledged,
+ *    so that stand-alone acks are not sent in response to one another. The default of 75% leaves the behavior of the
+ *    minimum window of 3 fragments unchanged.
+ *
+ */
+#ifndef BLE_CONFIG_ACK_WINDOW_FRACTION
+#define BLE_CONFIG_ACK_WINDOW_FRACTION                         75
+#endif // BLE_CONFIG_ACK_WINDOW_FRACTION
+
+#if (BLE_CONFIG_ACK_WINDOW_FRACTION < 1) || (BLE_CONFIG_ACK_WINDOW_FRACTION > 100)
+#error "BLE_CONFIG_ACK_WINDOW_FRACTION must be a percentage between 1 and 100."
+#endif
+
 /**
  *  @def BLE_CONFIG_ERROR_TYPE
  *
@@ -93,6 +93,7 @@ bool FormatBleLayerError(char * buf, uint16_t bufSize, int32_t err)
     case BLE_ERROR_INVALID_BTP_SEQUENCE_NUMBER                  : desc = "Received invalid BLE transport protocol sequence number"; break;
     case BLE_ERROR_REASSEMBLER_INCORRECT_STATE                  : desc = "BLE message reassembler received packet in incorrect state"; break;
     case BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG                     : desc = "Message received by BLE message reassembler was too large"; break;
+    case BLE_ERROR_L2CAP_SEND_FAILED                            : desc = "L2CAP channel send operation failed"; break;
     }
 #endif // !WEAVE_CONFIG_SHORT_ERROR_STR
 
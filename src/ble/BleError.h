@@ -407,6 +407,16 @@ typedef BLE_CONFIG_ERROR_TYPE BLE_ERROR;
  */
 #define BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG                 _BLE_ERROR(32)
 
+/**
+ *  @def BLE_ERROR_L2CAP_SEND_FAILED
+ *
+ *  @brief
+ *    A message could not be sent on an L2CAP connection-oriented
+ *    channel.
+ *
+ */
+#define BLE_ERROR_L2CAP_SEND_FAILED                        _BLE_ERROR(33)
+
 // !!!!! IMPORTANT !!!!!  If you add new Ble errors, please update the translation
 // of error codes to strings in BleError.cpp, and add them to unittest
 // in test-apps/TestErrorStr.cpp
@@ -125,9 +125,12 @@ public:
             return NULL;
         }
 
+        // Probe from the end point's home slot, where it is usually found.
+        int home = HomeSlot(c);
+
         for (int i = 0; i < BLE_LAYER_NUM_BLE_ENDPOINTS; i++)
         {
-            BLEEndPoint * elem = Get(i);
+            BLEEndPoint * elem = Get((home + i) % BLE_LAYER_NUM_BLE_ENDPOINTS);
             if (elem->mBle != NULL && elem->mConnObj == c)
             {
                 return elem;
@@ -137,11 +140,14 @@ public:
         return NULL;
     }
 
-    BLEEndPoint * GetFree() const
+    BLEEndPoint * GetFree(BLE_CONNECTION_OBJECT c) const
     {
+        // Allocate the first free slot at or after the home slot of the connection object.
+        int home = HomeSlot(c);
+
         for (int i = 0; i < BLE_LAYER_NUM_BLE_ENDPOINTS; i++)
         {
-            BLEEndPoint * elem = Get(i);
+            BLEEndPoint * elem = Get((home + i) % BLE_LAYER_NUM_BLE_ENDPOINTS);
             if (elem->mBle == NULL)
             {
                 return elem;
@@ -149,6 +155,23 @@ public:
         }
         return NULL;
     }
+
+private:
+    // End points are placed at, or else as close as possible after, the slot indexed by a hash of their BLE connection
+    // object, so that the platform's GATT events for any of several concurrent connections are dispatched to their end
+    // point without a search of the whole pool.
+    static int HomeSlot(BLE_CONNECTION_OBJECT c)
+    {
+        const uint8_t * p = reinterpret_cast<const uint8_t *>(&c);
+        uint32_t hash     = 2166136261UL;
+
+        for (size_t i = 0; i < sizeof(c); i++)
+        {
+            hash = (hash ^ p[i]) * 16777619UL;
+        }
+
+        return static_cast<int>(hash % BLE_LAYER_NUM_BLE_ENDPOINTS);
+    }
 };
 
 // EndPoint Pools
@@ -319,6 +342,10 @@ BLE_ERROR BleLayer::Init(BlePlatformDelegate * platformDelegate, BleApplicationD
 
     memset(&sBLEEndPointPool, 0, sizeof(sBLEEndPointPool));
 
+#if BLE_CONFIG_PEER_CACHE_SIZE > 0
+    memset(mPeerCache, 0, sizeof(mPeerCache));
+#endif
+
     mState = kState_Initialized;
 
 #if WEAVE_ENABLE_WOBLE_TEST
@@ -374,7 +401,7 @@ BLE_ERROR BleLayer::NewBleEndPoint(BLEEndPoint ** retEndPoint, BLE_CONNECTION_OB
         return BLE_ERROR_BAD_ARGS;
     }
 
-    *retEndPoint = sBLEEndPointPool.GetFree();
+    *retEndPoint = sBLEEndPointPool.GetFree(connObj);
     if (*retEndPoint == NULL)
     {
         WeaveLogError(Ble, "%s endpoint pool FULL", "Ble");
@@ -705,6 +732,63 @@ void BleLayer::HandleConnectionError(BLE_CONNECTION_OBJECT connObj, BLE_ERROR er
     }
 }
 
+#if BLE_CONFIG_L2CAP_COC_SUPPORTED
+bool BleLayer::HandleL2capChannelOpened(BLE_CONNECTION_OBJECT connObj)
+{
+    BLE_ERROR err             = BLE_NO_ERROR;
+    BLEEndPoint * newEndPoint = NULL;
+
+    // Only BLE peripherals accept L2CAP channels for Weave; as with GATT, the end point doesn't auto-close the
+    // connection.
+    err = NewBleEndPoint(&newEndPoint, connObj, kBleRole_Peripheral, false);
+    SuccessOrExit(err);
+
+    newEndPoint->mAppState = mAppState;
+
+    err = newEndPoint->HandleL2capChannelOpened();
+    if (err != BLE_NO_ERROR)
+    {
+        newEndPoint->DoClose(kBleCloseFlag_AbortTransmission, err);
+    }
+
+exit:
+    // If we failed to allocate a new end point, release underlying BLE connection.
+    if (newEndPoint == NULL)
+    {
+        mApplicationDelegate->NotifyWeaveConnectionClosed(connObj);
+    }
+
+    if (err != BLE_NO_ERROR)
+    {
+        WeaveLogError(Ble, "HandleL2capChannelOpened failed, err = %d", err);
+    }
+
+    return (err == BLE_NO_ERROR);
+}
+
+bool BleLayer::HandleL2capSduReceived(BLE_CONNECTION_OBJECT connObj, PacketBuffer * pBuf)
+{
+    BLEEndPoint * endPoint = sBLEEndPointPool.Find(connObj);
+
+    if (endPoint != NULL)
+    {
+        BLE_ERROR status = endPoint->ReceiveL2capSdu(pBuf);
+
+        if (status != BLE_NO_ERROR)
+        {
+            WeaveLogError(Ble, "endpoint l2cap sdu rcv failed, err = %d", status);
+        }
+    }
+    else
+    {
+        WeaveLogError(Ble, "no endpoint for rcvd l2cap sdu");
+        PacketBuffer::Free(pBuf);
+    }
+
+    return true;
+}
+#endif // BLE_CONFIG_L2CAP_COC_SUPPORTED
+
 BleTransportProtocolVersion BleLayer::GetHighestSupportedProtocolVersion(const BleTransportCapabilitiesRequestMessage & reqMsg)
 {
     BleTransportProtocolVersion retVersion = kBleTransportProtocolVersion_None;
@@ -732,6 +816,56 @@ BleTransportProtocolVersion BleLayer::GetHighestSupportedProtocolVersion(const B
     return retVersion;
 }
 
+#if BLE_CONFIG_PEER_CACHE_SIZE > 0
+const BleLayer::PeerCacheEntry * BleLayer::LookupPeerCache(uint64_t peerKey) const
+{
+    for (int i = 0; i < BLE_CONFIG_PEER_CACHE_SIZE; i++)
+    {
+        if (peerKey != 0 && mPeerCache[i].PeerKey == peerKey)
+        {
+            return &mPeerCache[i];
+        }
+    }
+
+    return NULL;
+}
+
+void BleLayer::UpdatePeerCache(uint64_t peerKey, uint8_t protocolVersion, uint16_t fragmentSize, uint8_t windowSize)
+{
+    PeerCacheEntry * entry = const_cast<PeerCacheEntry *>(LookupPeerCache(peerKey));
+
+    // Otherwise replace the least recently used entry. Unused entries are zeroed, so they go first.
+    if (entry == NULL)
+    {
+        entry = &mPeerCache[0];
+
+        for (int i = 1; i < BLE_CONFIG_PEER_CACHE_SIZE; i++)
+        {
+            if (mPeerCache[i].LastUsed < entry->LastUsed)
+            {
+                entry = &mPeerCache[i];
+            }
+        }
+    }
+
+    entry->PeerKey         = peerKey;
+    entry->LastUsed        = Weave::System::Layer::GetClock_MonotonicMS();
+    entry->FragmentSize    = fragmentSize;
+    entry->ProtocolVersion = protocolVersion;
+    entry->WindowSize      = windowSize;
+}
+
+void BleLayer::InvalidatePeerCache(uint64_t peerKey)
+{
+    PeerCacheEntry * entry = const_cast<PeerCacheEntry *>(LookupPeerCache(peerKey));
+
+    if (entry != NULL)
+    {
+        memset(entry, 0, sizeof(*entry));
+    }
+}
+#endif // BLE_CONFIG_PEER_CACHE_SIZE > 0
+
 } /* namespace Ble */
 } /* namespace nl */
 
@@ -82,7 +82,11 @@ using ::nl::Weave::System::PacketBuffer;
 #define NUM_SUPPORTED_PROTOCOL_VERSIONS     8
 /// Version(s) of the Nest BLE Transport Protocol that this stack supports.
 #define NL_BLE_TRANSPORT_PROTOCOL_MIN_SUPPORTED_VERSION kBleTransportProtocolVersion_V2
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+#define NL_BLE_TRANSPORT_PROTOCOL_MAX_SUPPORTED_VERSION kBleTransportProtocolVersion_V4
+#else
 #define NL_BLE_TRANSPORT_PROTOCOL_MAX_SUPPORTED_VERSION kBleTransportProtocolVersion_V3
+#endif
 
 /// Forward declarations.
 class BleLayer;
@@ -101,7 +105,8 @@ typedef enum
     kBleTransportProtocolVersion_None = 0,
     kBleTransportProtocolVersion_V1   = 1, // Prototype WoBLe version without ACKs or flow-control.
     kBleTransportProtocolVersion_V2   = 2, // First WoBLE version with ACKs and flow-control.
-    kBleTransportProtocolVersion_V3   = 3  // First WoBLE version with asymetric fragement sizes.
+    kBleTransportProtocolVersion_V3   = 3, // First WoBLE version with asymetric fragement sizes.
+    kBleTransportProtocolVersion_V4   = 4  // V3 with fragments sent by GATT notifications and writes without response.
 } BleTransportProtocolVersion;
 
 class BleLayerObject
@@ -331,6 +336,16 @@ public:
      *   err = BLE_ERROR_APP_CLOSED_CONNECTION to prevent the leak of this WeaveConnection and its end point object. */
     void HandleConnectionError(BLE_CONNECTION_OBJECT connObj, BLE_ERROR err);
 
+#if BLE_CONFIG_L2CAP_COC_SUPPORTED
+    /**< Platform must call this function when, as a peripheral, it accepts a Weave L2CAP connection-oriented channel
+     *   from a remote central. If this function returns true, Weave has accepted the channel and wrapped it in a
+     *   WeaveConnection object. */
+    bool HandleL2capChannelOpened(BLE_CONNECTION_OBJECT connObj);
+
+    /// Call when an SDU, i.e. a whole Weave message, is received on a Weave L2CAP channel.
+    bool HandleL2capSduReceived(BLE_CONNECTION_OBJECT connObj, PacketBuffer * pBuf);
+#endif // BLE_CONFIG_L2CAP_COC_SUPPORTED
+
 #if WEAVE_ENABLE_WOBLE_TEST
     BLEEndPoint * mTestBleEndPoint;
 #endif
@@ -347,6 +362,20 @@ private:
     BleApplicationDelegate * mApplicationDelegate;
     Weave::System::Layer * mSystemLayer;
 
+#if BLE_CONFIG_PEER_CACHE_SIZE > 0
+    // Parameters of the last successful BTP handshake with a remote peripheral.
+    struct PeerCacheEntry
+    {
+        uint64_t PeerKey;        // Platform key of the peripheral, or 0 if the entry is unused.
+        uint64_t LastUsed;       // Time, in ms, of the last handshake with the peripheral.
+        uint16_t FragmentSize;   // Negotiated tx fragment size.
+        uint8_t ProtocolVersion; // BTP version the peripheral selected.
+        uint8_t WindowSize;      // Negotiated receive window size.
+    };
+
+    PeerCacheEntry mPeerCache[BLE_CONFIG_PEER_CACHE_SIZE];
+#endif // BLE_CONFIG_PEER_CACHE_SIZE > 0
+
 private:
     // Private functions:
     void HandleDataReceived(BLE_CONNECTION_OBJECT connObj, PacketBuffer * pBuf);
@@ -354,6 +383,12 @@ private:
     void DriveSending(void);
     BLE_ERROR HandleBleTransportConnectionInitiated(BLE_CONNECTION_OBJECT connObj, PacketBuffer * pBuf);
 
+#if BLE_CONFIG_PEER_CACHE_SIZE > 0
+    const PeerCacheEntry * LookupPeerCache(uint64_t peerKey) const;
+    void UpdatePeerCache(uint64_t peerKey, uint8_t protocolVersion, uint16_t fragmentSize, uint8_t windowSize);
+    void InvalidatePeerCache(uint64_t peerKey);
+#endif // BLE_CONFIG_PEER_CACHE_SIZE > 0
+
     static BleTransportProtocolVersion GetHighestSupportedProtocolVersion(const BleTransportCapabilitiesRequestMessage & reqMsg);
 };
 
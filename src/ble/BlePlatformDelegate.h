@@ -82,6 +82,61 @@ public:
     virtual bool SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID * svcId, const WeaveBleUUID * charId,
                                   PacketBuffer * pBuf) = 0;
 
+    // Following APIs must be implemented by platforms enabling BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS:
+    //
+    //   No GATT confirmation is expected for these operations, and Weave sends the next message fragment, which
+    //   overwrites the tail of pBuf's payload, as soon as they return. The platform must therefore have copied pBuf's
+    //   payload, e.g. into the BLE controller's transmit buffers, before returning true, and return false if it cannot
+    //   queue the operation, rather than drop it.
+
+    // Send GATT characteristic notification
+    virtual bool SendNotification(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID * svcId, const WeaveBleUUID * charId,
+                                  PacketBuffer * pBuf)
+    {
+        PacketBuffer::Free(pBuf);
+        return false;
+    }
+
+    // Send GATT characteristic write command, i.e. write without response
+    virtual bool SendWriteWithoutResponse(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID * svcId,
+                                          const WeaveBleUUID * charId, PacketBuffer * pBuf)
+    {
+        PacketBuffer::Free(pBuf);
+        return false;
+    }
+
+    // Following APIs must be implemented by platforms enabling BLE_CONFIG_L2CAP_COC_SUPPORTED:
+    //
+    //   The platform must call BleLayer::HandleL2capSduReceived() for each SDU received on a Weave L2CAP channel, and
+    //   BleLayer::HandleConnectionError() when the channel closes.
+
+    // Check whether a Weave L2CAP connection-oriented channel is open on the specified BLE connection
+    virtual bool IsL2capChannelOpen(BLE_CONNECTION_OBJECT connObj) const { return false; }
+
+    // Send a Weave message as one SDU on the connection's Weave L2CAP channel. The platform takes ownership of pBuf,
+    // and must free it once the SDU has been sent, or before it returns false.
+    virtual bool SendL2capSdu(BLE_CONNECTION_OBJECT connObj, PacketBuffer * pBuf)
+    {
+        PacketBuffer::Free(pBuf);
+        return false;
+    }
+
+    // Close the connection's Weave L2CAP channel
+    virtual bool CloseL2capChannel(BLE_CONNECTION_OBJECT connObj) { return false; }
+
+    // Following API may be implemented by platforms enabling BLE_CONFIG_LINK_THROUGHPUT_POLICY:
+
+    // Request connection parameters favoring throughput, e.g. a short connection interval and the 2M PHY, for the
+    // specified BLE connection, or, if enable is false, revert to the platform's power-saving parameters. The request
+    // is a hint that the remote device may decline. Return value of false means the platform could not make it.
+    virtual bool RequestHighThroughput(BLE_CONNECTION_OBJECT connObj, bool enable) { return false; }
+
+    // Following API may be implemented by platforms enabling BLE_CONFIG_PEER_CACHE_SIZE:
+
+    // Get a key that identifies the remote device of the specified BLE connection across reconnects, e.g. one derived
+    // from its BLE address and Weave device id. Return value of 0 means the remote device could not be identified.
+    virtual uint64_t GetPeerKey(BLE_CONNECTION_OBJECT connObj) const { return 0; }
+
     // Send GATT characteristic read request
     virtual bool SendReadRequest(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID * svcId, const WeaveBleUUID * charId,
                                  PacketBuffer * pBuf) = 0;
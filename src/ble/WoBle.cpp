@@ -25,6 +25,8 @@
  *
  */
 
+#include <string.h>
+
 #include <BleLayer/BleConfig.h>
 
 #if CONFIG_NETWORK_LAYER_BLE
@@ -89,7 +91,7 @@ static void PrintBufDebug(PacketBuffer * buf)
 }
 
 const uint16_t WoBle::sDefaultFragmentSize = 20;  // 23-byte minimum ATT_MTU - 3 bytes for ATT operation header
-const uint16_t WoBle::sMaxFragmentSize     = 128; // Size of write and indication characteristics
+const uint16_t WoBle::sMaxFragmentSize     = BLE_CONFIG_MAX_FRAGMENT_SIZE; // Size of write and indication characteristics
 
 BLE_ERROR WoBle::Init(void * an_app_state, bool expect_first_ack)
 {
@@ -328,13 +330,18 @@ BLE_ERROR WoBle::HandleCharacteristicReceived(PacketBuffer * data, SequenceNumbe
 
         data->SetStart(&(characteristic[cursor]));
 
-        // Create a new buffer for use as the Rx re-assembly area.
-        mRxBuf = PacketBuffer::New();
+        // For now, limit WoBle message size to max length of 1 pbuf, as we do for Weave messages sent via IP.
+        VerifyOrExit(static_cast<size_t>(mRxLength) + WEAVE_SYSTEM_CONFIG_HEADER_RESERVE_SIZE <=
+                         WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX,
+                     err = BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG);
+
+        // Create a new buffer for use as the Rx re-assembly area, sized by the message length the sender announced,
+        // so that each fragment is copied once, straight into its place in the reassembled message.
+        mRxBuf = PacketBuffer::NewWithAvailableSize(mRxLength);
 
         VerifyOrExit(mRxBuf != NULL, err = BLE_ERROR_NO_MEMORY);
 
-        mRxBuf->AddToEnd(data);
-        mRxBuf->CompactHead(); // will free 'data' and adjust rx buf's end/length
+        AppendRxFragment(data);
         data = NULL;
     }
     else if (mRxState == kState_InProgress)
@@ -348,13 +355,8 @@ BLE_ERROR WoBle::HandleCharacteristicReceived(PacketBuffer * data, SequenceNumbe
 
         // Add received fragment to reassembled message buffer.
         data->SetStart(&(characteristic[cursor]));
-        mRxBuf->AddToEnd(data);
-        mRxBuf->CompactHead(); // will free 'data' and adjust rx buf's end/length
+        AppendRxFragment(data);
         data = NULL;
-
-        // For now, limit WoBle message size to max length of 1 pbuf, as we do for Weave messages sent via IP.
-        // TODO add support for WoBle messages longer than 1 pbuf
-        VerifyOrExit(mRxBuf->Next() == NULL, err = BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG);
     }
     else
     {
@@ -364,14 +366,6 @@ BLE_ERROR WoBle::HandleCharacteristicReceived(PacketBuffer * data, SequenceNumbe
 
     if (rx_flags & kHeaderFlag_EndMessage)
     {
-        // Trim remainder, if any, of received PacketBuffer based on sender-specified length of reassembled message.
-        int padding = mRxBuf->DataLength() - mRxLength;
-
-        if (padding > 0)
-        {
-            mRxBuf->SetDataLength(mRxLength);
-        }
-
         // Ensure all received fragments add up to sender-specified total message size.
         VerifyOrExit(mRxBuf->DataLength() == mRxLength, err = BLE_ERROR_REASSEMBLER_MISSING_DATA);
 
@@ -414,6 +408,18 @@ exit:
     return err;
 }
 
+// Copies the payload of a received fragment to the end of the reassembled message, and frees the fragment. Any bytes
+// beyond the sender-specified message length (i.e., padding of the last fragment) are dropped.
+void WoBle::AppendRxFragment(PacketBuffer * data)
+{
+    uint16_t length = nl::Weave::min(data->DataLength(), static_cast<uint16_t>(mRxLength - mRxBuf->DataLength()));
+
+    memcpy(mRxBuf->Start() + mRxBuf->DataLength(), data->Start(), length);
+    mRxBuf->SetDataLength(mRxBuf->DataLength() + length);
+
+    PacketBuffer::Free(data);
+}
+
 PacketBuffer * WoBle::RxPacket()
 {
     return mRxBuf;
@@ -73,9 +73,10 @@ GenericTraitUpdatableDataSink::GenericTraitUpdatableDataSink(
     const nl::Weave::Profiles::DataManagement::TraitSchemaEngine * apEngine, WdmClient * apWdmClient) :
     TraitUpdatableDataSink(apEngine)
 {
-    mpAppState  = NULL;
-    mOnError    = NULL;
-    mpWdmClient = apWdmClient;
+    mpAppState      = NULL;
+    mOnError        = NULL;
+    mDataGeneration = 0;
+    mpWdmClient     = apWdmClient;
 }
 
 GenericTraitUpdatableDataSink::~GenericTraitUpdatableDataSink()
@@ -102,6 +103,7 @@ void GenericTraitUpdatableDataSink::Clear(void)
     }
 
     mPathTlvDataMap.clear();
+    mDataGeneration++;
 }
 
 void GenericTraitUpdatableDataSink::UpdateTLVDataMap(PropertyPathHandle aPropertyPathHandle, PacketBuffer * apMsgBuf)
@@ -112,6 +114,68 @@ void GenericTraitUpdatableDataSink::UpdateTLVDataMap(PropertyPathHandle aPropert
         PacketBuffer::Free(it->second);
     }
     mPathTlvDataMap[aPropertyPathHandle] = apMsgBuf;
+    mDataGeneration++;
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::LocateLeafData(PropertyPathHandle aPropertyPathHandle, PacketBuffer *& apMsgBuf)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    std::map<PropertyPathHandle, PacketBuffer *>::iterator it;
+
+    it = mPathTlvDataMap.find(aPropertyPathHandle);
+    VerifyOrExit(it != mPathTlvDataMap.end(), err = WEAVE_ERROR_INVALID_TLV_TAG);
+
+    apMsgBuf = it->second;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::LocateLeafData(GenericTraitPath & aPath, PacketBuffer *& apMsgBuf)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aPath.mpDataSink == this, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // The buffer cached by the path is still the one in the map if no buffer has been replaced
+    // or released since it was looked up.
+    if (aPath.mpDataBuf == NULL || aPath.mDataGeneration != mDataGeneration)
+    {
+        err = LocateLeafData(aPath.mHandle, aPath.mpDataBuf);
+        SuccessOrExit(err);
+
+        aPath.mDataGeneration = mDataGeneration;
+    }
+
+    apMsgBuf = aPath.mpDataBuf;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        aPath.mpDataBuf = NULL;
+    }
+    return err;
+}
+
+/**
+ * Resolve a property path once, for repeated use with the GenericTraitPath overloads of the
+ * accessors.
+ */
+WEAVE_ERROR GenericTraitUpdatableDataSink::CompilePath(const char * apPath, GenericTraitPath & aPath) const
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
+
+    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
+    SuccessOrExit(err);
+
+    aPath.mpDataSink = this;
+    aPath.mHandle    = propertyPathHandle;
+    aPath.mpDataBuf  = NULL;
+
+exit:
+    WeaveLogFunctError(err);
+    return err;
 }
 
 WEAVE_ERROR GenericTraitUpdatableDataSink::LocateTraitHandle(void * apContext,
@@ -146,48 +210,27 @@ WEAVE_ERROR GenericTraitUpdatableDataSink::SetData(const char * apPath, double a
 
 WEAVE_ERROR GenericTraitUpdatableDataSink::SetBoolean(const char * apPath, bool aValue, bool aIsConditional)
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
-    nl::Weave::TLV::TLVWriter writer;
-    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
-    PacketBuffer * pMsgBuf                = PacketBuffer::New();
-    VerifyOrExit(NULL != pMsgBuf, err = WEAVE_ERROR_NO_MEMORY);
-
-    VerifyOrExit(GetSubscriptionClient() != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
-
-    Lock(GetSubscriptionClient());
-
-    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
-    SuccessOrExit(err);
-
-    writer.Init(pMsgBuf);
-
-    err = writer.PutBoolean(AnonymousTag, aValue);
-    SuccessOrExit(err);
-
-    err = writer.Finalize();
-    SuccessOrExit(err);
-
-#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
-    err = DebugPrettyPrint(pMsgBuf);
-    SuccessOrExit(err);
-#endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+    return Set(apPath, aValue, aIsConditional);
+}
 
-    UpdateTLVDataMap(propertyPathHandle, pMsgBuf);
-    pMsgBuf = NULL;
-    err     = SetUpdated(GetSubscriptionClient(), propertyPathHandle, aIsConditional);
-    Unlock(GetSubscriptionClient());
+WEAVE_ERROR GenericTraitUpdatableDataSink::SetData(GenericTraitPath & aPath, int64_t aValue, bool aIsConditional)
+{
+    return Set(aPath, aValue, aIsConditional);
+}
 
-    WeaveLogDetail(DataManagement, "<set updated> in 0x%08x", propertyPathHandle);
+WEAVE_ERROR GenericTraitUpdatableDataSink::SetData(GenericTraitPath & aPath, uint64_t aValue, bool aIsConditional)
+{
+    return Set(aPath, aValue, aIsConditional);
+}
 
-exit:
-    WeaveLogFunctError(err);
+WEAVE_ERROR GenericTraitUpdatableDataSink::SetData(GenericTraitPath & aPath, double aValue, bool aIsConditional)
+{
+    return Set(aPath, aValue, aIsConditional);
+}
 
-    if (NULL != pMsgBuf)
-    {
-        PacketBuffer::Free(pMsgBuf);
-        pMsgBuf = NULL;
-    }
-    return err;
+WEAVE_ERROR GenericTraitUpdatableDataSink::SetBoolean(GenericTraitPath & aPath, bool aValue, bool aIsConditional)
+{
+    return Set(aPath, aValue, aIsConditional);
 }
 
 WEAVE_ERROR GenericTraitUpdatableDataSink::SetString(const char * apPath, const char * aValue, bool aIsConditional)
@@ -292,30 +335,56 @@ exit:
 
 WEAVE_ERROR GenericTraitUpdatableDataSink::SetTLVBytes(const char * apPath, const uint8_t * dataBuf, size_t dataLen,
                                                        bool aIsConditional)
+{
+    WEAVE_ERROR err                       = WEAVE_NO_ERROR;
+    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
+
+    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
+    SuccessOrExit(err);
+
+    err = SetTLVBytes(propertyPathHandle, dataBuf, dataLen, aIsConditional);
+
+exit:
+    WeaveLogFunctError(err);
+
+    return err;
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::SetTLVBytes(GenericTraitPath & aPath, const uint8_t * dataBuf, size_t dataLen,
+                                                       bool aIsConditional)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aPath.mpDataSink == this, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = SetTLVBytes(aPath.mHandle, dataBuf, dataLen, aIsConditional);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::SetTLVBytes(PropertyPathHandle aPropertyPathHandle, const uint8_t * dataBuf,
+                                                       size_t dataLen, bool aIsConditional)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     TLVReader reader;
-    PropertyPathHandle propertyPathHandle                 = kNullPropertyPathHandle;
     TraitSchemaEngine::ISetDataDelegate * setDataDelegate = NULL;
 
     VerifyOrExit(GetSubscriptionClient() != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
     Lock(GetSubscriptionClient());
 
-    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
-    SuccessOrExit(err);
-
     reader.Init(dataBuf, dataLen);
     err = reader.Next();
     SuccessOrExit(err);
 
     setDataDelegate = static_cast<TraitSchemaEngine::ISetDataDelegate *>(this);
-    err             = GetSchemaEngine()->StoreData(propertyPathHandle, reader, setDataDelegate, NULL);
+    err             = GetSchemaEngine()->StoreData(aPropertyPathHandle, reader, setDataDelegate, NULL);
     SuccessOrExit(err);
 
-    err = SetUpdated(GetSubscriptionClient(), propertyPathHandle, aIsConditional);
+    err = SetUpdated(GetSubscriptionClient(), aPropertyPathHandle, aIsConditional);
 
     Unlock(GetSubscriptionClient());
-    WeaveLogDetail(DataManagement, "<set updated> in 0x%08x", propertyPathHandle);
+    WeaveLogDetail(DataManagement, "<set updated> in 0x%08x", aPropertyPathHandle);
 
 exit:
     WeaveLogFunctError(err);
@@ -430,23 +499,59 @@ exit:
 
 template <class T>
 WEAVE_ERROR GenericTraitUpdatableDataSink::Set(const char * apPath, T aValue, bool aIsConditional)
+{
+    WEAVE_ERROR err                       = WEAVE_NO_ERROR;
+    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
+
+    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
+    SuccessOrExit(err);
+
+    err = SetLeaf(propertyPathHandle, aValue, aIsConditional);
+
+exit:
+    WeaveLogFunctError(err);
+    return err;
+}
+
+template <class T>
+WEAVE_ERROR GenericTraitUpdatableDataSink::Set(GenericTraitPath & aPath, T aValue, bool aIsConditional)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aPath.mpDataSink == this, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = SetLeaf(aPath.mHandle, aValue, aIsConditional);
+
+exit:
+    return err;
+}
+
+static inline WEAVE_ERROR PutLeafValue(nl::Weave::TLV::TLVWriter & aWriter, bool aValue)
+{
+    return aWriter.PutBoolean(AnonymousTag, aValue);
+}
+
+template <class T>
+static inline WEAVE_ERROR PutLeafValue(nl::Weave::TLV::TLVWriter & aWriter, T aValue)
+{
+    return aWriter.Put(AnonymousTag, aValue);
+}
+
+template <class T>
+WEAVE_ERROR GenericTraitUpdatableDataSink::SetLeaf(PropertyPathHandle aPropertyPathHandle, T aValue, bool aIsConditional)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     nl::Weave::TLV::TLVWriter writer;
-    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
-    PacketBuffer * pMsgBuf                = PacketBuffer::New();
+    PacketBuffer * pMsgBuf = PacketBuffer::New();
     VerifyOrExit(NULL != pMsgBuf, err = WEAVE_ERROR_NO_MEMORY);
 
     VerifyOrExit(GetSubscriptionClient() != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
 
     Lock(GetSubscriptionClient());
 
-    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
-    SuccessOrExit(err);
-
     writer.Init(pMsgBuf);
 
-    err = writer.Put(AnonymousTag, aValue);
+    err = PutLeafValue(writer, aValue);
     SuccessOrExit(err);
 
     err = writer.Finalize();
@@ -457,13 +562,13 @@ WEAVE_ERROR GenericTraitUpdatableDataSink::Set(const char * apPath, T aValue, bo
     SuccessOrExit(err);
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
-    UpdateTLVDataMap(propertyPathHandle, pMsgBuf);
+    UpdateTLVDataMap(aPropertyPathHandle, pMsgBuf);
     pMsgBuf = NULL;
 
-    err = SetUpdated(GetSubscriptionClient(), propertyPathHandle, aIsConditional);
+    err = SetUpdated(GetSubscriptionClient(), aPropertyPathHandle, aIsConditional);
     Unlock(GetSubscriptionClient());
 
-    WeaveLogDetail(DataManagement, "<set updated> in 0x%08x", propertyPathHandle);
+    WeaveLogDetail(DataManagement, "<set updated> in 0x%08x", aPropertyPathHandle);
 
 exit:
     WeaveLogFunctError(err);
@@ -494,30 +599,47 @@ WEAVE_ERROR GenericTraitUpdatableDataSink::GetData(const char * apPath, double &
 
 WEAVE_ERROR GenericTraitUpdatableDataSink::GetBoolean(const char * apPath, bool & aValue)
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
-    nl::Weave::TLV::TLVReader reader;
-    PacketBuffer * pMsgBuf                = NULL;
-    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
-    std::map<PropertyPathHandle, PacketBuffer *>::iterator it;
+    return Get(apPath, aValue);
+}
 
-    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
-    SuccessOrExit(err);
+WEAVE_ERROR GenericTraitUpdatableDataSink::GetData(GenericTraitPath & aPath, int64_t & aValue)
+{
+    return Get(aPath, aValue);
+}
 
-    it = mPathTlvDataMap.find(propertyPathHandle);
-    VerifyOrExit(it != mPathTlvDataMap.end(), err = WEAVE_ERROR_INVALID_TLV_TAG);
+WEAVE_ERROR GenericTraitUpdatableDataSink::GetData(GenericTraitPath & aPath, uint64_t & aValue)
+{
+    return Get(aPath, aValue);
+}
 
-    pMsgBuf = mPathTlvDataMap[propertyPathHandle];
+WEAVE_ERROR GenericTraitUpdatableDataSink::GetData(GenericTraitPath & aPath, double & aValue)
+{
+    return Get(aPath, aValue);
+}
 
-#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
-    err = DebugPrettyPrint(pMsgBuf);
+WEAVE_ERROR GenericTraitUpdatableDataSink::GetBoolean(GenericTraitPath & aPath, bool & aValue)
+{
+    return Get(aPath, aValue);
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::GetString(const char * apPath, BytesData * apBytesData)
+{
+    return GetBytes(apPath, apBytesData);
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::GetBytes(const char * apPath, BytesData * apBytesData)
+{
+    WEAVE_ERROR err                       = WEAVE_NO_ERROR;
+    PacketBuffer * pMsgBuf                = NULL;
+    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
+
+    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
     SuccessOrExit(err);
-#endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
-    reader.Init(pMsgBuf);
-    err = reader.Next();
+    err = LocateLeafData(propertyPathHandle, pMsgBuf);
     SuccessOrExit(err);
 
-    err = reader.Get(aValue);
+    err = ReadLeafBytes(pMsgBuf, apBytesData);
     SuccessOrExit(err);
 
 exit:
@@ -525,33 +647,33 @@ exit:
     return err;
 }
 
-WEAVE_ERROR GenericTraitUpdatableDataSink::GetString(const char * apPath, BytesData * apBytesData)
+WEAVE_ERROR GenericTraitUpdatableDataSink::GetBytes(GenericTraitPath & aPath, BytesData * apBytesData)
 {
-    return GetBytes(apPath, apBytesData);
-}
+    WEAVE_ERROR err        = WEAVE_NO_ERROR;
+    PacketBuffer * pMsgBuf = NULL;
 
-WEAVE_ERROR GenericTraitUpdatableDataSink::GetBytes(const char * apPath, BytesData * apBytesData)
-{
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
-    nl::Weave::TLV::TLVReader reader;
-    PacketBuffer * pMsgBuf                = NULL;
-    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
-    std::map<PropertyPathHandle, PacketBuffer *>::iterator it;
+    err = LocateLeafData(aPath, pMsgBuf);
+    SuccessOrExit(err);
 
-    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
+    err = ReadLeafBytes(pMsgBuf, apBytesData);
     SuccessOrExit(err);
 
-    it = mPathTlvDataMap.find(propertyPathHandle);
-    VerifyOrExit(it != mPathTlvDataMap.end(), err = WEAVE_ERROR_INVALID_TLV_TAG);
+exit:
+    WeaveLogFunctError(err);
+    return err;
+}
 
-    pMsgBuf = mPathTlvDataMap[propertyPathHandle];
+WEAVE_ERROR GenericTraitUpdatableDataSink::ReadLeafBytes(PacketBuffer * apMsgBuf, BytesData * apBytesData)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    nl::Weave::TLV::TLVReader reader;
 
 #if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
-    err = DebugPrettyPrint(pMsgBuf);
+    err = DebugPrettyPrint(apMsgBuf);
     SuccessOrExit(err);
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
-    reader.Init(pMsgBuf);
+    reader.Init(apMsgBuf);
     err = reader.Next();
     SuccessOrExit(err);
 
@@ -563,32 +685,79 @@ WEAVE_ERROR GenericTraitUpdatableDataSink::GetBytes(const char * apPath, BytesDa
         SuccessOrExit(err);
     }
 
+    // Keep the bytes valid until the caller clears apBytesData, whatever happens to the sink.
+    apMsgBuf->AddRef();
+    apBytesData->mpMsgBuf = apMsgBuf;
+
 exit:
-    WeaveLogFunctError(err);
     return err;
 }
 
 WEAVE_ERROR GenericTraitUpdatableDataSink::GetTLVBytes(const char * apPath, BytesData * apBytesData)
+{
+    WEAVE_ERROR err                       = WEAVE_NO_ERROR;
+    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
+
+    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
+    SuccessOrExit(err);
+
+    err = GetTLVBytes(propertyPathHandle, NULL, apBytesData);
+
+exit:
+    WeaveLogFunctError(err);
+    return err;
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::GetTLVBytes(GenericTraitPath & aPath, BytesData * apBytesData)
+{
+    WEAVE_ERROR err        = WEAVE_NO_ERROR;
+    PacketBuffer * pMsgBuf = NULL;
+
+    VerifyOrExit(aPath.mpDataSink == this, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // A leaf is held in a buffer of its own, which can be copied without consulting the schema.
+    if (GetSchemaEngine()->IsLeaf(aPath.mHandle))
+    {
+        err = LocateLeafData(aPath, pMsgBuf);
+        SuccessOrExit(err);
+    }
+
+    err = GetTLVBytes(aPath.mHandle, pMsgBuf, apBytesData);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::GetTLVBytes(PropertyPathHandle aPropertyPathHandle, PacketBuffer * apCachedLeafBuf,
+                                                       BytesData * apBytesData)
 {
     WEAVE_ERROR err                                       = WEAVE_NO_ERROR;
     TraitSchemaEngine::IGetDataDelegate * getDataDelegate = NULL;
-    TLVType dummyContainerType;
     nl::Weave::TLV::TLVWriter writer;
-    PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
+    nl::Weave::TLV::TLVReader reader;
 
     PacketBuffer * pMsgBuf = PacketBuffer::New();
     VerifyOrExit(NULL != pMsgBuf, err = WEAVE_ERROR_NO_MEMORY);
 
     VerifyOrExit(NULL != apBytesData, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
-    SuccessOrExit(err);
-
     writer.Init(pMsgBuf);
 
-    getDataDelegate = static_cast<TraitSchemaEngine::IGetDataDelegate *>(this);
-    err             = GetSchemaEngine()->RetrieveData(propertyPathHandle, AnonymousTag, writer, getDataDelegate);
-    SuccessOrExit(err);
+    if (apCachedLeafBuf != NULL)
+    {
+        reader.Init(apCachedLeafBuf);
+        err = reader.Next();
+        SuccessOrExit(err);
+
+        err = writer.CopyElement(AnonymousTag, reader);
+        SuccessOrExit(err);
+    }
+    else
+    {
+        getDataDelegate = static_cast<TraitSchemaEngine::IGetDataDelegate *>(this);
+        err             = GetSchemaEngine()->RetrieveData(aPropertyPathHandle, AnonymousTag, writer, getDataDelegate);
+        SuccessOrExit(err);
+    }
 
     err = writer.Finalize();
     SuccessOrExit(err);
@@ -616,40 +785,57 @@ exit:
 
 WEAVE_ERROR GenericTraitUpdatableDataSink::IsNull(const char * apPath, bool & aIsNull)
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
-    nl::Weave::TLV::TLVReader reader;
+    WEAVE_ERROR err                       = WEAVE_NO_ERROR;
     PacketBuffer * pMsgBuf                = NULL;
     PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
-    std::map<PropertyPathHandle, PacketBuffer *>::iterator it;
 
     err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
     SuccessOrExit(err);
 
-    it = mPathTlvDataMap.find(propertyPathHandle);
-    VerifyOrExit(it != mPathTlvDataMap.end(), err = WEAVE_ERROR_INVALID_TLV_TAG);
+    err = LocateLeafData(propertyPathHandle, pMsgBuf);
+    SuccessOrExit(err);
 
-    pMsgBuf = mPathTlvDataMap[propertyPathHandle];
+    err = ReadLeafIsNull(pMsgBuf, aIsNull);
+    SuccessOrExit(err);
+
+exit:
+    WeaveLogFunctError(err);
+    return err;
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::IsNull(GenericTraitPath & aPath, bool & aIsNull)
+{
+    WEAVE_ERROR err        = WEAVE_NO_ERROR;
+    PacketBuffer * pMsgBuf = NULL;
+
+    err = LocateLeafData(aPath, pMsgBuf);
+    SuccessOrExit(err);
+
+    err = ReadLeafIsNull(pMsgBuf, aIsNull);
+    SuccessOrExit(err);
+
+exit:
+    WeaveLogFunctError(err);
+    return err;
+}
+
+WEAVE_ERROR GenericTraitUpdatableDataSink::ReadLeafIsNull(PacketBuffer * apMsgBuf, bool & aIsNull)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    nl::Weave::TLV::TLVReader reader;
 
 #if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
-    err = DebugPrettyPrint(pMsgBuf);
+    err = DebugPrettyPrint(apMsgBuf);
     SuccessOrExit(err);
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
-    reader.Init(pMsgBuf);
+    reader.Init(apMsgBuf);
     err = reader.Next();
     SuccessOrExit(err);
 
-    if (reader.GetType() == kTLVType_Null)
-    {
-        aIsNull = true;
-    }
-    else
-    {
-        aIsNull = false;
-    }
+    aIsNull = (reader.GetType() == kTLVType_Null);
 
 exit:
-    WeaveLogFunctError(err);
     return err;
 }
 
@@ -714,26 +900,53 @@ exit:
 template <class T>
 WEAVE_ERROR GenericTraitUpdatableDataSink::Get(const char * apPath, T & aValue)
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
-    nl::Weave::TLV::TLVReader reader;
+    WEAVE_ERROR err                       = WEAVE_NO_ERROR;
     PacketBuffer * pMsgBuf                = NULL;
     PropertyPathHandle propertyPathHandle = kNullPropertyPathHandle;
-    std::map<PropertyPathHandle, PacketBuffer *>::iterator it;
 
     err = GetSchemaEngine()->MapPathToHandle(apPath, propertyPathHandle);
     SuccessOrExit(err);
 
-    it = mPathTlvDataMap.find(propertyPathHandle);
-    VerifyOrExit(it != mPathTlvDataMap.end(), err = WEAVE_ERROR_INVALID_TLV_TAG);
+    err = LocateLeafData(propertyPathHandle, pMsgBuf);
+    SuccessOrExit(err);
 
-    pMsgBuf = mPathTlvDataMap[propertyPathHandle];
+    err = ReadLeaf(pMsgBuf, aValue);
+    SuccessOrExit(err);
+
+exit:
+    WeaveLogFunctError(err);
+    return err;
+}
+
+template <class T>
+WEAVE_ERROR GenericTraitUpdatableDataSink::Get(GenericTraitPath & aPath, T & aValue)
+{
+    WEAVE_ERROR err        = WEAVE_NO_ERROR;
+    PacketBuffer * pMsgBuf = NULL;
+
+    err = LocateLeafData(aPath, pMsgBuf);
+    SuccessOrExit(err);
+
+    err = ReadLeaf(pMsgBuf, aValue);
+    SuccessOrExit(err);
+
+exit:
+    WeaveLogFunctError(err);
+    return err;
+}
+
+template <class T>
+WEAVE_ERROR GenericTraitUpdatableDataSink::ReadLeaf(PacketBuffer * apMsgBuf, T & aValue)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    nl::Weave::TLV::TLVReader reader;
 
 #if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
-    err = DebugPrettyPrint(pMsgBuf);
+    err = DebugPrettyPrint(apMsgBuf);
     SuccessOrExit(err);
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
-    reader.Init(pMsgBuf);
+    reader.Init(apMsgBuf);
     err = reader.Next();
     SuccessOrExit(err);
 
@@ -741,7 +954,6 @@ WEAVE_ERROR GenericTraitUpdatableDataSink::Get(const char * apPath, T & aValue)
     SuccessOrExit(err);
 
 exit:
-    WeaveLogFunctError(err);
     return err;
 }
 
@@ -767,6 +979,7 @@ WEAVE_ERROR GenericTraitUpdatableDataSink::DeleteData(const char * apPath)
     }
 
     mPathTlvDataMap.erase(it);
+    mDataGeneration++;
 
     err = ClearUpdated(GetSubscriptionClient(), propertyPathHandle);
 
@@ -49,6 +49,14 @@ using namespace nl::Weave::Profiles::DataManagement;
 using namespace nl::Weave::Profiles::Security;
 using namespace ::nl::Weave::Profiles::DataManagement_Current;
 
+/**
+ * A view onto bytes held in a PacketBuffer.
+ *
+ * When mpMsgBuf is set, the view holds a reference on that buffer, which keeps mpDataBuf valid
+ * until Clear() is called, even if the data sink the bytes came from is refreshed or cleared
+ * meanwhile.  This lets the language bindings hand the bytes to the application without copying
+ * them.
+ */
 class NL_DLL_EXPORT BytesData
 {
 public:
@@ -58,6 +66,7 @@ public:
         if (mpMsgBuf != NULL)
         {
             PacketBuffer::Free(mpMsgBuf);
+            mpMsgBuf = NULL;
         }
         mpDataBuf = NULL;
         mDataLen  = 0;
@@ -71,6 +80,31 @@ public:
 class GenericTraitUpdatableDataSink;
 class WdmClient;
 
+/**
+ * A property path within a GenericTraitUpdatableDataSink, resolved once so that the property can be
+ * read and written repeatedly without parsing the path string and walking the schema each time.
+ *
+ * The path also remembers the buffer holding the property's data at its last access, and reuses it
+ * for as long as the sink's data has not changed since, sparing the lookup in the sink's data map.
+ * A path may only be used with the sink that compiled it.
+ */
+class NL_DLL_EXPORT GenericTraitPath
+{
+    friend class GenericTraitUpdatableDataSink;
+
+public:
+    GenericTraitPath(void) : mpDataSink(NULL), mHandle(kNullPropertyPathHandle), mpDataBuf(NULL), mDataGeneration(0) { }
+
+    bool IsCompiled(void) const { return mpDataSink != NULL; }
+    PropertyPathHandle GetHandle(void) const { return mHandle; }
+
+private:
+    const GenericTraitUpdatableDataSink * mpDataSink;
+    PropertyPathHandle mHandle;
+    PacketBuffer * mpDataBuf;
+    uint32_t mDataGeneration;
+};
+
 class WdmClientFlushUpdateStatus
 {
 public:
@@ -129,6 +163,22 @@ public:
 
     WEAVE_ERROR DeleteData(const char * apPath);
 
+    WEAVE_ERROR CompilePath(const char * apPath, GenericTraitPath & aPath) const;
+
+    WEAVE_ERROR SetData(GenericTraitPath & aPath, int64_t aValue, bool aIsConditional = false);
+    WEAVE_ERROR SetData(GenericTraitPath & aPath, uint64_t aValue, bool aIsConditional = false);
+    WEAVE_ERROR SetData(GenericTraitPath & aPath, double aValue, bool aIsConditional = false);
+    WEAVE_ERROR SetBoolean(GenericTraitPath & aPath, bool aValue, bool aIsConditional = false);
+    WEAVE_ERROR SetTLVBytes(GenericTraitPath & aPath, const uint8_t * dataBuf, size_t dataLen, bool aIsConditional = false);
+
+    WEAVE_ERROR GetData(GenericTraitPath & aPath, int64_t & aValue);
+    WEAVE_ERROR GetData(GenericTraitPath & aPath, uint64_t & aValue);
+    WEAVE_ERROR GetData(GenericTraitPath & aPath, double & aValue);
+    WEAVE_ERROR GetBoolean(GenericTraitPath & aPath, bool & aValue);
+    WEAVE_ERROR GetBytes(GenericTraitPath & aPath, BytesData * apBytesData);
+    WEAVE_ERROR GetTLVBytes(GenericTraitPath & aPath, BytesData * apBytesData);
+    WEAVE_ERROR IsNull(GenericTraitPath & aPath, bool & aIsNull);
+
     void * mpAppState;
 
 private:
@@ -141,7 +191,22 @@ private:
     template <class T>
     WEAVE_ERROR Set(const char * apPath, T aValue, bool aIsConditional = false);
     template <class T>
+    WEAVE_ERROR Set(GenericTraitPath & aPath, T aValue, bool aIsConditional = false);
+    template <class T>
+    WEAVE_ERROR SetLeaf(PropertyPathHandle aPropertyPathHandle, T aValue, bool aIsConditional);
+    template <class T>
     WEAVE_ERROR Get(const char * apPath, T & aValue);
+    template <class T>
+    WEAVE_ERROR Get(GenericTraitPath & aPath, T & aValue);
+    template <class T>
+    static WEAVE_ERROR ReadLeaf(PacketBuffer * apMsgBuf, T & aValue);
+
+    WEAVE_ERROR LocateLeafData(PropertyPathHandle aPropertyPathHandle, PacketBuffer *& apMsgBuf);
+    WEAVE_ERROR LocateLeafData(GenericTraitPath & aPath, PacketBuffer *& apMsgBuf);
+    static WEAVE_ERROR ReadLeafBytes(PacketBuffer * apMsgBuf, BytesData * apBytesData);
+    static WEAVE_ERROR ReadLeafIsNull(PacketBuffer * apMsgBuf, bool & aIsNull);
+    WEAVE_ERROR SetTLVBytes(PropertyPathHandle aPropertyPathHandle, const uint8_t * dataBuf, size_t dataLen, bool aIsConditional);
+    WEAVE_ERROR GetTLVBytes(PropertyPathHandle aPropertyPathHandle, PacketBuffer * apCachedLeafBuf, BytesData * apBytesData);
 
     WEAVE_ERROR SetLeafData(nl::Weave::Profiles::DataManagement::PropertyPathHandle aLeafHandle,
                             nl::Weave::TLV::TLVReader & aReader) __OVERRIDE;
@@ -161,6 +226,9 @@ private:
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
     std::map<PropertyPathHandle, PacketBuffer *> mPathTlvDataMap;
+    // Changes whenever a buffer in mPathTlvDataMap is replaced or released, invalidating the
+    // buffers cached by compiled paths.
+    uint32_t mDataGeneration;
     WdmClient * mpWdmClient;
 };
 
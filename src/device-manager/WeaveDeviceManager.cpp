@@ -149,6 +149,13 @@ WEAVE_ERROR WeaveDeviceManager::Init(WeaveExchangeManager *exchangeMgr, WeaveSec
     mEnumeratedNodes = NULL;
     mEnumeratedNodesLen = 0;
     mEnumeratedNodesMaxLen = 0;
+    mIdleConTimeout = 0;
+
+    for (int i = 0; i < WEAVE_CONFIG_DEVICE_MGR_MAX_IDLE_CONNECTIONS; i++)
+    {
+        mIdleCons[i].DevMgr = this;
+        mIdleCons[i].Con = NULL;
+    }
 
     // By default, rendezvous messages are sent to the IPv6 link-local, all-nodes multicast address.
     mRendezvousAddr = IPAddress::MakeIPv6WellKnownMulticast(kIPv6MulticastScope_Link, kIPV6MulticastGroup_AllNodes);
@@ -190,9 +197,12 @@ WEAVE_ERROR WeaveDeviceManager::Shutdown()
 
     if (mSystemLayer != NULL)
     {
+        CloseIdleConnections();
+
         mSystemLayer->CancelTimer(HandleConnectionIdentifyTimeout, this);
         mSystemLayer->CancelTimer(RetrySession, this);
         mSystemLayer->CancelTimer(HandleDeviceEnumerationTimeout, this);
+        mSystemLayer->CancelTimer(HandleIdleConnectionAdopted, this);
         CancelConnectionMonitorTimer();
         CancelRemotePassiveRendezvousTimer();
     }
@@ -747,8 +757,7 @@ WEAVE_ERROR WeaveDeviceManager::ConnectBle(BLE_CONNECTION_OBJECT connObj,
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    if (mOpState != kOpState_Idle || mConState != kConnectionState_NotConnected ||
-            sListeningDeviceMgr != NULL)
+    if (mOpState != kOpState_Idle || mConState != kConnectionState_NotConnected)
     {
         err = WEAVE_ERROR_INCORRECT_STATE;
         ExitNow();
@@ -768,8 +777,7 @@ WEAVE_ERROR WeaveDeviceManager::ConnectBle(BLE_CONNECTION_OBJECT connObj, const
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    if (mOpState != kOpState_Idle || mConState != kConnectionState_NotConnected ||
-            sListeningDeviceMgr != NULL)
+    if (mOpState != kOpState_Idle || mConState != kConnectionState_NotConnected)
     {
         err = WEAVE_ERROR_INCORRECT_STATE;
         ExitNow();
@@ -790,8 +798,7 @@ WEAVE_ERROR WeaveDeviceManager::ConnectBle(BLE_CONNECTION_OBJECT connObj, const
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    if (mOpState != kOpState_Idle || mConState != kConnectionState_NotConnected ||
-            sListeningDeviceMgr != NULL)
+    if (mOpState != kOpState_Idle || mConState != kConnectionState_NotConnected)
     {
         err = WEAVE_ERROR_INCORRECT_STATE;
         ExitNow();
@@ -838,9 +845,8 @@ WEAVE_ERROR WeaveDeviceManager::InitiateBleConnection(BLE_CONNECTION_OBJECT conn
     mOpState = kOpState_InitializeBleConnection;
     mConState = kConnectionState_ConnectDevice;
 
-    // Setup pointer to listening device manager. This lets us reuse the code in static HandleConnectionReceived
-    // callback also used by PassiveRendezvous.
-    sListeningDeviceMgr = this;
+    // The BLE connection is bound to this device manager through its AppState, rather than through the listening
+    // device manager, so that several device managers may drive BLE connections to different devices at once.
 
     // Bind BLE connection object to new WeaveConnection.
     bleCon = mMessageLayer->NewConnection();
@@ -858,7 +864,6 @@ exit:
     {
         ClearOpState();
         mConState = kConnectionState_NotConnected;
-        sListeningDeviceMgr = NULL;
     }
 
     return err;
@@ -1263,6 +1268,10 @@ void WeaveDeviceManager::Close(bool graceful)
     // Cancel outstanding Remote Passive Rendezvous attempt, if any, and clear associated state.
     CancelRemotePassiveRendezvous();
 
+    // Keep the connection to the device open for reuse, if enabled.
+    if (ParkDeviceConnection())
+        WeaveLogProgress(DeviceManager, "Keeping idle connection to device");
+
     // Close connection to device, if any, and clear associated state.
     CloseDeviceConnection(graceful);
 
@@ -1308,6 +1317,7 @@ void WeaveDeviceManager::CloseDeviceConnection(bool graceful)
     // Cancel any outstanding timers.
     mSystemLayer->CancelTimer(HandleConnectionIdentifyTimeout, this);
     mSystemLayer->CancelTimer(RetrySession, this);
+    mSystemLayer->CancelTimer(HandleIdleConnectionAdopted, this);
     CancelConnectionMonitorTimer();
 
     // Reset various state.
@@ -2484,6 +2494,27 @@ WEAVE_ERROR WeaveDeviceManager::SetConnectTimeout(uint32_t timeoutMS)
     return WEAVE_NO_ERROR;
 }
 
+/**
+ * Sets how long a connection to a device is kept open after the application closes it.
+ *
+ * While kept open, the connection and the secure session established over it are taken over by
+ * a ConnectDevice() or ReconnectDevice() to the same device with the same credentials, saving the
+ * TCP connect and the PASE or CASE handshake.  Connections over BLE, to a remote device, or with
+ * the connection monitor enabled are never kept.
+ *
+ * @param[in] timeoutMS     Time to keep idle connections open, in milliseconds.  0, the default,
+ *                          disables the feature and closes any connections currently kept.
+ */
+WEAVE_ERROR WeaveDeviceManager::SetIdleConnectionTimeout(uint32_t timeoutMS)
+{
+    mIdleConTimeout = timeoutMS;
+
+    if (mIdleConTimeout == 0)
+        CloseIdleConnections();
+
+    return WEAVE_NO_ERROR;
+}
+
 // DEPRECATED
 WEAVE_ERROR WeaveDeviceManager::SetWiFiRendezvousAddress(IPAddress addr)
 {
@@ -2679,6 +2710,7 @@ exit:
 void WeaveDeviceManager::ClearAuthKey()
 {
     ClearAuthKey(mAuthKey, mAuthKeyLen);
+    mDecodedAccessToken.Clear();
 
     if (mMessageLayer && mMessageLayer->FabricState)
     {
@@ -2853,6 +2885,20 @@ WEAVE_ERROR WeaveDeviceManager::InitiateConnection()
                 ? "Initiating rendezvous for device"
                 : "Initiating connection to device");
         mConTryCount = 0;
+
+        // If an idle connection to the device was kept open, take it over and complete the connection
+        // from the event loop, rather than calling the application back before it has even returned.
+        if (mOpState == kOpState_ConnectDevice || mOpState == kOpState_ReconnectDevice)
+        {
+            IdleConnection *idleCon = FindIdleConnection();
+            if (idleCon != NULL)
+            {
+                WeaveLogProgress(DeviceManager, "Reusing idle connection to device");
+                AdoptIdleConnection(idleCon);
+                err = mSystemLayer->StartTimer(0, HandleIdleConnectionAdopted, this);
+                ExitNow();
+            }
+        }
     }
 
     // Enable UDP if not already enabled.
@@ -3380,7 +3426,7 @@ void WeaveDeviceManager::HandleConnectionComplete(WeaveConnection *con, WEAVE_ER
             //TODO Clean up this kludge:
             devMgr->mConState = kConnectionState_WaitDeviceConnect;
 
-            devMgr->HandleConnectionReceived(devMgr->mMessageLayer, con);
+            devMgr->HandleDeviceConnection(con);
         }
         else // Else, TCP connection...
         {
@@ -3409,88 +3455,93 @@ void WeaveDeviceManager::HandleConnectionComplete(WeaveConnection *con, WEAVE_ER
 
 void WeaveDeviceManager::HandleConnectionReceived(WeaveMessageLayer *msgLayer, WeaveConnection *con)
 {
-    WEAVE_ERROR             err     = WEAVE_NO_ERROR;
-    WeaveDeviceManager*     devMgr  = sListeningDeviceMgr;
-    PacketBuffer*           msgBuf  = NULL;
-    IdentifyRequestMessage  reqMsg;
+    WeaveDeviceManager *devMgr = sListeningDeviceMgr;
 
     if (devMgr != NULL && devMgr->mConState == kConnectionState_WaitDeviceConnect)
     {
+        // Disallow further incoming connections. Since we can only process one connection at a time
+        // we must do this even if the connecting device isn't the one we want to talk to.
+        sListeningDeviceMgr = NULL;
 
-#if WEAVE_PROGRESS_LOGGING
-        if (devMgr->mOpState == kOpState_PassiveRendezvousDevice)
-        {
-            char ipAddrStr[64];
-            con->PeerAddr.ToString(ipAddrStr, sizeof(ipAddrStr));
-            WeaveLogProgress(DeviceManager, "Received connection from device (%s)", ipAddrStr);
-        }
-        else if (devMgr->mOpState == kOpState_InitializeBleConnection)
-        {
-            WeaveLogProgress(DeviceManager, "Initializing Weave BLE connection");
-        }
-#endif
+        devMgr->HandleDeviceConnection(con);
+    }
+    else
+    {
+        WeaveLogError(DeviceManager, "Unexpected connection rxd, closing");
+        con->Close();
+    }
+}
 
-        // Let the app know we're starting the
-        // authentication/provisioning process.
-        if (devMgr->mOnStart)
-        {
-            devMgr->mOnStart(devMgr, devMgr->mAppReqState, con);
-        }
+void WeaveDeviceManager::HandleDeviceConnection(WeaveConnection *con)
+{
+    WEAVE_ERROR             err     = WEAVE_NO_ERROR;
+    PacketBuffer*           msgBuf  = NULL;
+    IdentifyRequestMessage  reqMsg;
 
-        // Capture the connection object.
-        devMgr->mDeviceCon = con;
-        devMgr->mDeviceCon->AppState = devMgr;
-        devMgr->mDeviceCon->OnConnectionClosed = HandleConnectionClosed;
+#if WEAVE_PROGRESS_LOGGING
+    if (mOpState == kOpState_PassiveRendezvousDevice)
+    {
+        char ipAddrStr[64];
+        con->PeerAddr.ToString(ipAddrStr, sizeof(ipAddrStr));
+        WeaveLogProgress(DeviceManager, "Received connection from device (%s)", ipAddrStr);
+    }
+    else if (mOpState == kOpState_InitializeBleConnection)
+    {
+        WeaveLogProgress(DeviceManager, "Initializing Weave BLE connection");
+    }
+#endif
 
-        // Disallow further incoming connections. Since we can only process one connection at a time
-        // we must do this even if the connecting device isn't the one we want to talk to.
-        sListeningDeviceMgr = NULL;
+    // Let the app know we're starting the
+    // authentication/provisioning process.
+    if (mOnStart)
+    {
+        mOnStart(this, mAppReqState, con);
+    }
 
-        // Remove unsecured incoming connection handler if performing passive rendezvous.
-        if (devMgr->mOpState == kOpState_PassiveRendezvousDevice)
-        {
-            err = devMgr->ClearUnsecuredConnectionHandler();
-            SuccessOrExit(err);
-        }
+    // Capture the connection object.
+    mDeviceCon = con;
+    mDeviceCon->AppState = this;
+    mDeviceCon->OnConnectionClosed = HandleConnectionClosed;
 
-        // Encode an Identify device request message. Since we're doing this solely to get the device's
-        // node id, we leave all criteria fields blank (i.e. wildcarded).
-        msgBuf = PacketBuffer::New();
-        VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
-        reqMsg.Reset();
-        err = reqMsg.Encode(msgBuf);
+    // Remove unsecured incoming connection handler if performing passive rendezvous.
+    if (mOpState == kOpState_PassiveRendezvousDevice)
+    {
+        err = ClearUnsecuredConnectionHandler();
         SuccessOrExit(err);
+    }
 
-        // Construct an exchange context.
-        devMgr->mCurReq = devMgr->mExchangeMgr->NewContext(con, devMgr);
-        VerifyOrExit(devMgr->mCurReq != NULL, err = WEAVE_ERROR_NO_MEMORY);
-        devMgr->mCurReq->OnMessageReceived = HandleConnectionIdentifyResponse;
+    // Encode an Identify device request message. Since we're doing this solely to get the device's
+    // node id, we leave all criteria fields blank (i.e. wildcarded).
+    msgBuf = PacketBuffer::New();
+    VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    reqMsg.Reset();
+    err = reqMsg.Encode(msgBuf);
+    SuccessOrExit(err);
 
-        // Since we don't know the device's id yet, arrange to send the identify request to the 'Any' node id.
-        devMgr->mCurReq->PeerNodeId = kAnyNodeId;
+    // Construct an exchange context.
+    mCurReq = mExchangeMgr->NewContext(con, this);
+    VerifyOrExit(mCurReq != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    mCurReq->OnMessageReceived = HandleConnectionIdentifyResponse;
 
-        WeaveLogProgress(DeviceManager, "Sending IdentifyRequest to device");
+    // Since we don't know the device's id yet, arrange to send the identify request to the 'Any' node id.
+    mCurReq->PeerNodeId = kAnyNodeId;
 
-        devMgr->mConState = kConnectionState_IdentifyDevice;
+    WeaveLogProgress(DeviceManager, "Sending IdentifyRequest to device");
 
-        // Send the Identify message.
-        err = devMgr->mCurReq->SendMessage(kWeaveProfile_DeviceDescription, kMessageType_IdentifyRequest, msgBuf, 0);
-        msgBuf = NULL;
-        SuccessOrExit(err);
-    }
-    else
-    {
-        WeaveLogError(DeviceManager, "Unexpected connection rxd, closing");
-        con->Close();
-    }
+    mConState = kConnectionState_IdentifyDevice;
+
+    // Send the Identify message.
+    err = mCurReq->SendMessage(kWeaveProfile_DeviceDescription, kMessageType_IdentifyRequest, msgBuf, 0);
+    msgBuf = NULL;
+    SuccessOrExit(err);
 
 exit:
     if (msgBuf != NULL)
         PacketBuffer::Free(msgBuf);
-    if (err != WEAVE_NO_ERROR && devMgr != NULL)
+    if (err != WEAVE_NO_ERROR)
     {
-        devMgr->Close();
-        devMgr->mOnError(devMgr, devMgr->mAppReqState, err, NULL);
+        Close();
+        mOnError(this, mAppReqState, err, NULL);
     }
 }
 
@@ -3563,6 +3614,20 @@ WEAVE_ERROR WeaveDeviceManager::StartSession()
         break;
     }
 
+    // If all of the security manager's session slots are taken, e.g. by other device manager instances
+    // sharing it to commission devices concurrently, wait for one to free up rather than failing the
+    // connection, for up to the connection timeout.
+    if (err == WEAVE_ERROR_SECURITY_MANAGER_BUSY &&
+        (mConTimeout == 0 || mConTryCount * kSecurityMgrBusyRetryInterval < mConTimeout))
+    {
+        err = mSystemLayer->StartTimer(kSecurityMgrBusyRetryInterval, RetrySession, this);
+        if (err == WEAVE_NO_ERROR)
+        {
+            WeaveLogProgress(DeviceManager, "Security manager busy; retrying session establishment after %d ms",
+                    kSecurityMgrBusyRetryInterval);
+        }
+    }
+
     return err;
 }
 
@@ -3833,6 +3898,149 @@ exit:
     }
 }
 
+void WeaveDeviceManager::HashAuthKey(uint8_t *hashBuf)
+{
+    Platform::Security::SHA256 sha256;
+
+    sha256.Begin();
+    sha256.AddData(&mAuthType, sizeof(mAuthType));
+    if (mAuthKey != NULL)
+        sha256.AddData(static_cast<const uint8_t *>(mAuthKey), static_cast<uint16_t>(mAuthKeyLen));
+    sha256.Finish(hashBuf);
+}
+
+/**
+ * Detach the connection to the device, if it is eligible, and keep it open for mIdleConTimeout.
+ *
+ * Note that the session keys established over the connection are bound to it, so they stay
+ * valid, on both ends, for as long as the connection does.
+ */
+bool WeaveDeviceManager::ParkDeviceConnection()
+{
+    IdleConnection *idleCon = NULL;
+    WEAVE_ERROR err;
+
+    if (mIdleConTimeout == 0 || mOpState != kOpState_Idle || mConState != kConnectionState_Connected ||
+        mDeviceCon == NULL || mDeviceCon->NetworkType != WeaveConnection::kNetworkType_IP ||
+        mDeviceId == kNodeIdNotSpecified || mConnectedToRemoteDevice || mConMonitorEnabled)
+        return false;
+
+    // Only one connection is kept per device.  Otherwise use a free entry, or evict the least
+    // recently used one.
+    for (int i = 0; i < WEAVE_CONFIG_DEVICE_MGR_MAX_IDLE_CONNECTIONS; i++)
+    {
+        IdleConnection *entry = &mIdleCons[i];
+
+        if (entry->Con != NULL && entry->DeviceId == mDeviceId)
+        {
+            idleCon = entry;
+            break;
+        }
+        if (idleCon == NULL || (idleCon->Con != NULL && (entry->Con == NULL || entry->LastUsed < idleCon->LastUsed)))
+            idleCon = entry;
+    }
+    CloseIdleConnection(idleCon);
+
+    err = mSystemLayer->StartTimer(mIdleConTimeout, HandleIdleConnectionTimeout, idleCon);
+    if (err != WEAVE_NO_ERROR)
+        return false;
+
+    mExchangeMgr->UnregisterUnsolicitedMessageHandler(kWeaveProfile_Echo, kEchoMessageType_EchoRequest, mDeviceCon);
+
+    idleCon->Con = mDeviceCon;
+    idleCon->DeviceId = mDeviceId;
+    idleCon->DeviceAddr = mDeviceAddr;
+    idleCon->LastUsed = System::Layer::GetClock_MonotonicMS();
+    idleCon->SessionKeyId = mSessionKeyId;
+    idleCon->EncType = mEncType;
+    idleCon->AuthType = mAuthType;
+    HashAuthKey(idleCon->AuthKeyHash);
+
+    mDeviceCon->AppState = idleCon;
+    mDeviceCon->OnConnectionComplete = NULL;
+    mDeviceCon->OnConnectionClosed = HandleIdleConnectionClosed;
+    mDeviceCon = NULL;
+
+    return true;
+}
+
+WeaveDeviceManager::IdleConnection *WeaveDeviceManager::FindIdleConnection()
+{
+    uint8_t authKeyHash[Platform::Security::SHA256::kHashLength];
+
+    HashAuthKey(authKeyHash);
+
+    for (int i = 0; i < WEAVE_CONFIG_DEVICE_MGR_MAX_IDLE_CONNECTIONS; i++)
+    {
+        IdleConnection *idleCon = &mIdleCons[i];
+
+        if (idleCon->Con != NULL && idleCon->DeviceId == mDeviceId && idleCon->AuthType == mAuthType &&
+            (mDeviceAddr == IPAddress::Any || mDeviceAddr == idleCon->DeviceAddr) &&
+            memcmp(idleCon->AuthKeyHash, authKeyHash, sizeof(authKeyHash)) == 0)
+            return idleCon;
+    }
+
+    return NULL;
+}
+
+void WeaveDeviceManager::AdoptIdleConnection(IdleConnection *idleCon)
+{
+    mSystemLayer->CancelTimer(HandleIdleConnectionTimeout, idleCon);
+
+    mDeviceCon = idleCon->Con;
+    mDeviceCon->AppState = this;
+    mDeviceCon->OnConnectionClosed = HandleConnectionClosed;
+    mDeviceAddr = idleCon->DeviceAddr;
+    mSessionKeyId = idleCon->SessionKeyId;
+    mEncType = idleCon->EncType;
+    mConState = kConnectionState_ConnectDevice;
+
+    idleCon->Con = NULL;
+}
+
+void WeaveDeviceManager::CloseIdleConnection(IdleConnection *idleCon)
+{
+    if (idleCon->Con != NULL)
+    {
+        idleCon->DevMgr->mSystemLayer->CancelTimer(HandleIdleConnectionTimeout, idleCon);
+
+        idleCon->Con->OnConnectionClosed = NULL;
+        idleCon->Con->Abort();
+        idleCon->Con = NULL;
+    }
+}
+
+void WeaveDeviceManager::CloseIdleConnections()
+{
+    for (int i = 0; i < WEAVE_CONFIG_DEVICE_MGR_MAX_IDLE_CONNECTIONS; i++)
+        CloseIdleConnection(&mIdleCons[i]);
+}
+
+void WeaveDeviceManager::HandleIdleConnectionAdopted(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    WeaveDeviceManager *devMgr = static_cast<WeaveDeviceManager *>(aAppState);
+
+    devMgr->ReenableConnectionMonitor();
+}
+
+void WeaveDeviceManager::HandleIdleConnectionTimeout(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    WeaveLogProgress(DeviceManager, "Closing idle connection to device");
+
+    CloseIdleConnection(static_cast<IdleConnection *>(aAppState));
+}
+
+void WeaveDeviceManager::HandleIdleConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    IdleConnection *idleCon = static_cast<IdleConnection *>(con->AppState);
+
+    WeaveLogProgress(DeviceManager, "Idle connection to device closed");
+
+    idleCon->DevMgr->mSystemLayer->CancelTimer(HandleIdleConnectionTimeout, idleCon);
+    idleCon->Con = NULL;
+    con->Close();
+}
+
 void WeaveDeviceManager::HandleConnectionReady()
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -5072,14 +5280,12 @@ WEAVE_ERROR WeaveDeviceManager::EncodeNodeCertInfo(const Security::CASE::BeginSe
         TLVWriter & writer)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    TLVReader reader;
 
-    // Initialize a reader to read the access token.
-    reader.Init((const uint8_t *)mAuthKey, mAuthKeyLen);
-    reader.ImplicitProfileId = kWeaveProfile_Security;
+    err = DecodeAccessToken();
+    SuccessOrExit(err);
 
-    // Generate a CASE CertificateInformation structure from the information in the access token.
-    err = CASECertInfoFromAccessToken(reader, writer);
+    // Write the CASE CertificateInformation structure generated from the information in the access token.
+    err = mDecodedAccessToken.WriteCertInfo(writer);
     SuccessOrExit(err);
 
 exit:
@@ -5146,11 +5352,14 @@ WEAVE_ERROR WeaveDeviceManager::GetNodeCertInfo(bool isInitiator, uint8_t *buf,
 {
     WEAVE_ERROR err;
 
-    // Decode the supplied access token and generate a CASE Certificate Info TLV structure
-    // containing the certificate(s) from the access token.
-    err = CASECertInfoFromAccessToken((const uint8_t *)mAuthKey, mAuthKeyLen, buf, bufSize, certInfoLen);
+    err = DecodeAccessToken();
     SuccessOrExit(err);
 
+    // Return the CASE Certificate Info TLV structure containing the certificate(s) from the access token.
+    VerifyOrExit(mDecodedAccessToken.GetCertInfoLength() <= bufSize, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+    memcpy(buf, mDecodedAccessToken.GetCertInfo(), mDecodedAccessToken.GetCertInfoLength());
+    certInfoLen = mDecodedAccessToken.GetCertInfoLength();
+
 exit:
     if (err != WEAVE_NO_ERROR)
         err = WEAVE_ERROR_INVALID_ACCESS_TOKEN;
@@ -5171,36 +5380,45 @@ WEAVE_ERROR WeaveDeviceManager::GetNodePayload(bool isInitiator, uint8_t *buf, u
 WEAVE_ERROR WeaveDeviceManager::GetNodePrivateKey(bool isInitiator, const uint8_t *& weavePrivKey, uint16_t& weavePrivKeyLen)
 {
     WEAVE_ERROR err;
-    uint8_t *privKeyBuf = NULL;
-
-    // Allocate a buffer to hold the private key.  Since the key is held within the access token, a
-    // buffer as big as the access token will always be sufficient.
-    privKeyBuf = (uint8_t *)malloc(mAuthKeyLen);
-    VerifyOrExit(privKeyBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    // Extract the private key from the access token, converting the encoding to a EllipticCurvePrivateKey TLV object.
-    err = ExtractPrivateKeyFromAccessToken((const uint8_t *)mAuthKey, mAuthKeyLen, privKeyBuf, mAuthKeyLen, weavePrivKeyLen);
+    err = DecodeAccessToken();
     SuccessOrExit(err);
 
-    // Pass the extracted key back to the caller.
-    weavePrivKey = privKeyBuf;
-    privKeyBuf = NULL;
+    // Pass the key extracted from the access token, encoded as an EllipticCurvePrivateKey TLV object, back to the
+    // caller.  It remains owned by the decoded access token.
+    weavePrivKey = mDecodedAccessToken.GetPrivateKey();
+    weavePrivKeyLen = mDecodedAccessToken.GetPrivateKeyLength();
 
 exit:
-    if (err != WEAVE_NO_ERROR)
-        err = WEAVE_ERROR_INVALID_ACCESS_TOKEN;
-    if (privKeyBuf != NULL)
-        free(privKeyBuf);
     return err;
 }
 
 // Called when the CASE engine is done with the buffer returned by GetNodePrivateKey().
 WEAVE_ERROR WeaveDeviceManager::ReleaseNodePrivateKey(const uint8_t *weavePrivKey)
 {
-    free((void *)weavePrivKey);
+    // The key is cleared along with the decoded access token, when the access token is cleared.
     return WEAVE_NO_ERROR;
 }
 
+// Decode the access token in mAuthKey, unless it has already been decoded.  The decoded token is reused by every
+// CASE session established with the same access token.
+WEAVE_ERROR WeaveDeviceManager::DecodeAccessToken(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    if (!mDecodedAccessToken.IsInitialized())
+    {
+        VerifyOrExit(mAuthKey != NULL, err = WEAVE_ERROR_INVALID_ACCESS_TOKEN);
+
+        err = mDecodedAccessToken.Init((const uint8_t *)mAuthKey, mAuthKeyLen);
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        err = WEAVE_ERROR_INVALID_ACCESS_TOKEN;
+    return err;
+}
+
 // Prepare the supplied certificate set and validation context for use in validating the certificate of a peer.
 // This method is responsible for loading the trust anchors into the certificate set.
 WEAVE_ERROR WeaveDeviceManager::BeginCertValidation(bool isInitiator, WeaveCertificateSet& certSet, ValidationContext& validContext)
@@ -37,6 +37,7 @@
 #include <Weave/Profiles/network-provisioning/NetworkInfo.h>
 #include <Weave/Profiles/network-provisioning/WirelessRegConfig.h>
 #include <Weave/Profiles/security/WeaveSecurity.h>
+#include <Weave/Profiles/security/WeaveAccessToken.h>
 #include <Weave/Profiles/security/WeaveCASE.h>
 #include <Weave/Profiles/security/WeaveSig.h>
 #include <Weave/Profiles/service-directory/ServiceDirectory.h>
@@ -44,6 +45,7 @@
 #include <Weave/Profiles/token-pairing/TokenPairing.h>
 #include <Weave/Profiles/vendor/nestlabs/dropcam-legacy-pairing/DropcamLegacyPairing.h>
 #include <Weave/Profiles/vendor/nestlabs/thermostat/NestThermostatWeaveConstants.h>
+#include <Weave/Support/crypto/HashAlgos.h>
 
 namespace nl {
 namespace Weave {
@@ -106,6 +108,9 @@ public:
 
     void *AppState;
 
+    // Each device manager drives one device connection and one operation at a time.  To work with several
+    // devices concurrently, initialize one device manager per device over the same exchange and security
+    // managers.  Only one of them can perform a passive rendezvous at a time.
     WEAVE_ERROR Init(WeaveExchangeManager *exchangeMsg, WeaveSecurityManager *securityMgr);
     WEAVE_ERROR Shutdown();
 
@@ -189,6 +194,7 @@ public:
     WEAVE_ERROR SetUseAccessToken(bool useAccessToken);
     WEAVE_ERROR SetRendezvousLinkLocal(bool RendezvousLinkLocal);
     WEAVE_ERROR SetConnectTimeout(uint32_t timeoutMS);
+    WEAVE_ERROR SetIdleConnectionTimeout(uint32_t timeoutMS);
     void Close();
     void Close(bool graceful);
     void CloseDeviceConnection();
@@ -329,6 +335,7 @@ private:
         kEnumerateDevicesRetryInterval                   = 500, // ms
         kSessionRetryInterval                            = 1000, // ms
         kMaxSessionRetryCount                            = 20,
+        kSecurityMgrBusyRetryInterval                    = 250,  // ms
     };
 
     enum
@@ -355,6 +362,21 @@ private:
         kCertDecodeBufferSize = 1024
     };
 
+    // A connection to a device, and the secure session bound to it, kept open after the application
+    // closed it so that a later connection to the same device can take it over.
+    struct IdleConnection
+    {
+        WeaveDeviceManager *DevMgr;
+        WeaveConnection *Con;                                   // NULL when the entry is free.
+        uint64_t DeviceId;
+        IPAddress DeviceAddr;
+        uint64_t LastUsed;                                      // in ms, for eviction of the oldest entry.
+        uint16_t SessionKeyId;
+        uint8_t EncType;
+        uint8_t AuthType;
+        uint8_t AuthKeyHash[Platform::Security::SHA256::kHashLength];
+    };
+
     System::Layer* mSystemLayer;
     WeaveMessageLayer *mMessageLayer;
     WeaveExchangeManager *mExchangeMgr;
@@ -403,6 +425,7 @@ private:
     uint64_t mDeviceId;
     uint64_t mAssistingDeviceId;
     uint32_t mConTimeout;                                       // in ms; 0 means disabled.
+    uint32_t mIdleConTimeout;                                   // in ms; 0 means disabled.
     uint32_t mConTryCount;
     uint16_t mSessionKeyId;
     uint8_t mEncType;
@@ -416,6 +439,7 @@ private:
     uint32_t mAuthKeyLen;
     uint32_t mAssistingDeviceAuthKeyLen;
     uint32_t mRemoteDeviceAuthKeyLen;
+    Security::DecodedAccessToken mDecodedAccessToken;           // mAuthKey decoded for CASE; empty until first needed.
     uint32_t mConMonitorInterval;                               // in ms; 0 means disabled.
     uint32_t mConMonitorTimeout;                                // in ms; 0 means disabled.
     uint32_t mRemotePassiveRendezvousTimeout;                   // in seconds; 0 means disabled.
@@ -433,8 +457,9 @@ private:
     uint64_t *mEnumeratedNodes;
     uint32_t mEnumeratedNodesLen;
     uint32_t mEnumeratedNodesMaxLen;
+    IdleConnection mIdleCons[WEAVE_CONFIG_DEVICE_MGR_MAX_IDLE_CONNECTIONS];
 
-    // Use by static HandleConnectionReceived callback.
+    // Used by static HandleConnectionReceived callback, for passive rendezvous.
     static WeaveDeviceManager *sListeningDeviceMgr;
 
 #if WEAVE_CONFIG_DEVICE_MGR_DEMAND_ENABLE_UDP
@@ -463,6 +488,16 @@ private:
     void ClearRequestState();
     void ClearOpState();
 
+    void HashAuthKey(uint8_t *hashBuf);
+    bool ParkDeviceConnection();
+    IdleConnection *FindIdleConnection();
+    void AdoptIdleConnection(IdleConnection *idleCon);
+    static void CloseIdleConnection(IdleConnection *idleCon);
+    void CloseIdleConnections();
+    static void HandleIdleConnectionAdopted(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+    static void HandleIdleConnectionTimeout(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+    static void HandleIdleConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr);
+
     static void HandleRequestConnectionClosed(ExchangeContext *ec, WeaveConnection *con, WEAVE_ERROR conErr);
 
     WEAVE_ERROR ValidateIdentifyRequest(const IdentifyRequestMessage &reqMsg);
@@ -489,6 +524,7 @@ private:
     static void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr);
     static void HandleConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr);
     static void HandleConnectionReceived(WeaveMessageLayer *msgLayer, WeaveConnection *con);
+    void HandleDeviceConnection(WeaveConnection *con);
     static void HandleUnsecuredConnectionCallbackRemoved(void *appState);
 
     WEAVE_ERROR StartSession();
@@ -578,6 +614,7 @@ private:
     static void HandleRemoteIdentifyConnectionClosed(ExchangeContext *ec, WeaveConnection *con, WEAVE_ERROR conErr);
     static void HandleRemoteIdentifyTimeout(ExchangeContext *ec);
 
+    WEAVE_ERROR DecodeAccessToken(void);
     static WEAVE_ERROR DecodeStatusReport(PacketBuffer *msgBuf, DeviceStatus& status);
     static WEAVE_ERROR DecodeNetworkInfoList(PacketBuffer *buf, uint16_t& count, NetworkInfo *& netInfoList);
 
@@ -692,6 +692,11 @@ exit:
     {
         *val = [[NSString alloc] initWithBytes:bytesData.mpDataBuf length:bytesData.mDataLen encoding:NSUTF8StringEncoding];
     }
+
+    // Drop the reference GetBytes() took on the sink's buffer.
+    dispatch_sync(_mWeaveWorkQueue, ^() {
+        bytesData.Clear();
+    });
     return err;
 }
 
@@ -744,6 +749,11 @@ exit:
         *val = [NSData dataWithBytes:bytesData.mpDataBuf length:bytesData.mDataLen];
     }
 
+    // Drop the reference GetBytes() took on the sink's buffer.
+    dispatch_sync(_mWeaveWorkQueue, ^() {
+        bytesData.Clear();
+    });
+
     return err;
 }
 
@@ -38,9 +38,27 @@ typedef void (^WDMFailureBlock)(id owner, NSError * error);
 
 @property (copy, readonly) NSString * name;
 @property (readonly) CBPeripheral * blePeripheral;
-@property (readonly) dispatch_queue_t resultCallbackQueue;
 @property (weak) id owner;
 
+/**
+ *  @brief The queue on which completion and failure blocks are called.
+ *
+ *  May be changed at any time, for example to move the handling of results for a device manager off the main queue.
+ *  The change applies to callbacks dispatched afterwards.  Must not be the Weave work queue.
+ */
+@property (atomic) dispatch_queue_t resultCallbackQueue;
+
+/**
+ *  @brief The queue on which intermediate results of an operation, such as the devices found during device
+ *  enumeration, are delivered.
+ *
+ *  Defaults to nil, in which case intermediate results are delivered on resultCallbackQueue.  Setting a background
+ *  queue here avoids a hop to the main queue for each intermediate result when resultCallbackQueue is the main queue.
+ *  If the queue is serial, the completion or failure block of an operation is only called after all of its
+ *  intermediate results have been delivered.  Must not be the Weave work queue.
+ */
+@property (atomic) dispatch_queue_t progressCallbackQueue;
+
 /**
  *  @brief Disable default initializer inherited from NSObject
  */
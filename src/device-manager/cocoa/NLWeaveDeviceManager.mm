@@ -52,7 +52,6 @@ static void onIdentifyDeviceComplete(nl::Weave::DeviceManager::WeaveDeviceManage
 @interface NLWeaveDeviceManager () {
     nl::Weave::DeviceManager::WeaveDeviceManager * _mWeaveCppDM;
     dispatch_queue_t _mWeaveWorkQueue;
-    dispatch_queue_t _mAppCallbackQueue;
 
     // Note that these context variables are independent from context variables in the C++ Weave Device Manager,
     // for the C++ Weave Device Manager only takes one pointer as the app context, which is not enough to hold all
@@ -71,7 +70,6 @@ static void onIdentifyDeviceComplete(nl::Weave::DeviceManager::WeaveDeviceManage
 @implementation NLWeaveDeviceManager
 
 @synthesize blePeripheral = _blePeripheral;
-@synthesize resultCallbackQueue = _mAppCallbackQueue;
 
 /**
  @note
@@ -109,7 +107,7 @@ static void onIdentifyDeviceComplete(nl::Weave::DeviceManager::WeaveDeviceManage
     VerifyOrExit(nil != self, err = WEAVE_ERROR_NO_MEMORY);
 
     _mWeaveWorkQueue = weaveWorkQueue;
-    _mAppCallbackQueue = appCallbackQueue;
+    _resultCallbackQueue = appCallbackQueue;
 
     _name = name;
 
@@ -150,6 +148,25 @@ exit:
     return _mRequestName;
 }
 
+/**
+ @note
+   Final results are funneled through the progress callback queue, when there is one, so that they are not
+   delivered ahead of intermediate results still queued there.
+ */
+- (void)DispatchAsyncResult:(dispatch_block_t)block
+{
+    dispatch_queue_t resultQueue = self.resultCallbackQueue;
+    dispatch_queue_t progressQueue = self.progressCallbackQueue;
+
+    if (nil != progressQueue && progressQueue != resultQueue) {
+        dispatch_async(progressQueue, ^() {
+            dispatch_async(resultQueue, block);
+        });
+    } else {
+        dispatch_async(resultQueue, block);
+    }
+}
+
 - (void)DispatchAsyncFailureBlock:(WEAVE_ERROR)code taskName:(NSString *)taskName handler:(WDMFailureBlock)handler
 {
     NSError * error =
@@ -164,10 +181,10 @@ exit:
 {
     if (NULL != handler) {
         // we use async because we don't need to wait for completion of this final completion report
-        dispatch_async(_mAppCallbackQueue, ^() {
+        [self DispatchAsyncResult:^() {
             WDM_LOG_DEBUG(@"%@: Calling failure handler for %@", _name, taskName);
             handler(_owner, error);
-        });
+        }];
     } else {
         WDM_LOG_DEBUG(@"%@: Skipping failure handler for %@", _name, taskName);
     }
@@ -195,18 +212,19 @@ exit:
     [self MarkTransactionCompleted];
 
     if (nil != completionHandler) {
-        dispatch_async(_mAppCallbackQueue, ^() {
+        [self DispatchAsyncResult:^() {
             completionHandler(_owner, data);
-        });
+        }];
     }
 }
 
 - (void)DispatchAsyncResponseBlock:(id)data
 {
     WDMCompletionBlock completionHandler = _mCompletionHandler;
+    dispatch_queue_t progressQueue = self.progressCallbackQueue;
 
     if (nil != completionHandler) {
-        dispatch_async(_mAppCallbackQueue, ^() {
+        dispatch_async((nil != progressQueue) ? progressQueue : self.resultCallbackQueue, ^() {
             completionHandler(_owner, data);
         });
     }
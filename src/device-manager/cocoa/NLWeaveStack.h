@@ -59,6 +59,18 @@ typedef void (^ShutdownCompletionBlock)(WEAVE_ERROR result);
 
 - (void)ShutdownStack:(ShutdownCompletionBlock)block;
 
+/**
+ @brief Creates a device manager, for interacting with one device at a time.
+
+ Several device managers may be created to work with several devices concurrently.  Each device manager runs one
+ operation at a time, but operations on different device managers proceed independently of each other.
+
+ @note This function must not be called from the Weave work queue.
+
+ @param name                The name of the device manager, used in logs.
+ @param appCallbackQueue    The queue on which the device manager's results are delivered.  See
+                            NLWeaveDeviceManager resultCallbackQueue and progressCallbackQueue.
+ */
 - (NLWeaveDeviceManager *)createDeviceManager:(NSString *)name appCallbackQueue:(dispatch_queue_t)appCallbackQueue;
 
 - (NLWdmClient *)createWdmClient:(NSString *)name appCallbackQueue:(dispatch_queue_t)appCallbackQueue;
@@ -485,17 +485,27 @@ exit:
 
 - (NLWeaveDeviceManager *)createDeviceManager:(NSString *)name appCallbackQueue:(dispatch_queue_t)appCallbackQueue
 {
+    __block NLWeaveDeviceManager * deviceMgr = nil;
+
     WDM_LOG_METHOD_SIG();
 
-    _mDeviceMgr = [[NLWeaveDeviceManager alloc] init:name
-                                      weaveWorkQueue:_mWorkQueue
-                                    appCallbackQueue:appCallbackQueue
-                                         exchangeMgr:&_mExchangeMgr
-                                         securityMgr:&_mSecurityMgr];
-    if (nil == _mDeviceMgr) {
+    // The C++ device manager is initialized against the shared exchange and security managers, so this must
+    // happen on the Weave work queue, where other device managers may be running operations at the same time.
+    dispatch_sync(_mWorkQueue, ^(void) {
+        deviceMgr = [[NLWeaveDeviceManager alloc] init:name
+                                        weaveWorkQueue:_mWorkQueue
+                                      appCallbackQueue:appCallbackQueue
+                                           exchangeMgr:&_mExchangeMgr
+                                           securityMgr:&_mSecurityMgr];
+        if (nil != deviceMgr) {
+            _mDeviceMgr = deviceMgr;
+        }
+    });
+
+    if (nil == deviceMgr) {
         WDM_LOG_ERROR(@"Cannot create new NLWeaveDeviceManager\n");
     }
-    return _mDeviceMgr;
+    return deviceMgr;
 }
 
 #if WEAVE_CONFIG_DATA_MANAGEMENT_CLIENT_EXPERIMENTAL
@@ -146,6 +146,7 @@ extern "C" {
     NL_DLL_EXPORT void Java_nl_Weave_DeviceManager_WeaveDeviceManager_setAutoReconnect(JNIEnv *env, jobject self, jlong deviceMgrPtr, jboolean autoReconnect);
     NL_DLL_EXPORT void Java_nl_Weave_DeviceManager_WeaveDeviceManager_setRendezvousLinkLocal(JNIEnv *env, jobject self, jlong deviceMgrPtr, jboolean rendezvousLinkLocal);
     NL_DLL_EXPORT void Java_nl_Weave_DeviceManager_WeaveDeviceManager_setConnectTimeout(JNIEnv *env, jobject self, jlong deviceMgrPtr, jint timeoutMS);
+    NL_DLL_EXPORT void Java_nl_Weave_DeviceManager_WeaveDeviceManager_setIdleConnectionTimeout(JNIEnv *env, jobject self, jlong deviceMgrPtr, jint timeoutMS);
     NL_DLL_EXPORT void Java_nl_Weave_DeviceManager_WeaveDeviceManager_beginCreateFabric(JNIEnv *env, jobject self, jlong deviceMgrPtr);
     NL_DLL_EXPORT void Java_nl_Weave_DeviceManager_WeaveDeviceManager_beginLeaveFabric(JNIEnv *env, jobject self, jlong deviceMgrPtr);
     NL_DLL_EXPORT void Java_nl_Weave_DeviceManager_WeaveDeviceManager_beginGetFabricConfig(JNIEnv *env, jobject self, jlong deviceMgrPtr);
@@ -194,6 +195,7 @@ extern "C" {
     NL_DLL_EXPORT void Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_setString(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path, jstring value, jboolean isConditional);
     NL_DLL_EXPORT void Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_setNull(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path, jboolean isConditional);
     NL_DLL_EXPORT void Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_setBytes(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path, jbyteArray value, jboolean isConditional);
+    NL_DLL_EXPORT void Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_setBytesBuffer(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path, jobject value, jboolean isConditional);
     NL_DLL_EXPORT void Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_setStringArray(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path, jobjectArray stringArray, jboolean isConditional);
     NL_DLL_EXPORT jlong Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getLong(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path);
     NL_DLL_EXPORT jdouble Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getDouble(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path);
@@ -201,6 +203,9 @@ extern "C" {
     NL_DLL_EXPORT jstring Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getString(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path);
     NL_DLL_EXPORT jboolean Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_isNull(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path);
     NL_DLL_EXPORT jbyteArray Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getBytes(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path);
+    NL_DLL_EXPORT jlong Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getBytesView(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path);
+    NL_DLL_EXPORT jobject Java_nl_Weave_DataManagement_BytesView_getBuffer(JNIEnv *env, jclass cls, jlong bytesViewPtr);
+    NL_DLL_EXPORT void Java_nl_Weave_DataManagement_BytesView_release(JNIEnv *env, jclass cls, jlong bytesViewPtr);
     NL_DLL_EXPORT jobjectArray Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getStringArray(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path);
     NL_DLL_EXPORT jlong Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getVersion(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr);
     NL_DLL_EXPORT void Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_deleteData(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path);
@@ -1282,6 +1287,23 @@ void Java_nl_Weave_DeviceManager_WeaveDeviceManager_setConnectTimeout(JNIEnv *en
         ThrowError(env, err);
 }
 
+void Java_nl_Weave_DeviceManager_WeaveDeviceManager_setIdleConnectionTimeout(JNIEnv *env, jobject self, jlong deviceMgrPtr, jint timeoutMS)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveDeviceManager *deviceMgr = (WeaveDeviceManager *)deviceMgrPtr;
+
+    WeaveLogProgress(DeviceManager, "setIdleConnectionTimeout() called");
+
+    pthread_mutex_lock(&sStackLock);
+
+    err = deviceMgr->SetIdleConnectionTimeout((uint32_t)timeoutMS);
+
+    pthread_mutex_unlock(&sStackLock);
+
+    if (err != WEAVE_NO_ERROR && err != WDM_JNI_ERROR_EXCEPTION_THROWN)
+        ThrowError(env, err);
+}
+
 void Java_nl_Weave_DeviceManager_WeaveDeviceManager_beginCreateFabric(JNIEnv *env, jobject self, jlong deviceMgrPtr)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -4230,6 +4252,38 @@ exit:
     }
 }
 
+void Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_setBytesBuffer(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path, jobject value, jboolean isConditional)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const char *pPathStr = NULL;
+    const uint8_t *pDataBuf = NULL;
+    jlong dataLen;
+    GenericTraitUpdatableDataSink *pDataSink = (GenericTraitUpdatableDataSink *)genericTraitUpdatableDataSinkPtr;
+
+    WeaveLogProgress(DeviceManager, "setBytesBuffer() called");
+
+    pPathStr = env->GetStringUTFChars(path, 0);
+    VerifyOrExit(pPathStr != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    // The bytes are read in place; only direct buffers have an address to read them from.
+    pDataBuf = (const uint8_t *)env->GetDirectBufferAddress(value);
+    dataLen = env->GetDirectBufferCapacity(value);
+    VerifyOrExit(pDataBuf != NULL && dataLen >= 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = pDataSink->SetBytes(pPathStr, pDataBuf, (size_t)dataLen, isConditional == JNI_TRUE);
+
+exit:
+    if (pPathStr != NULL)
+    {
+        env->ReleaseStringUTFChars(path, pPathStr);
+    }
+
+    if (err != WEAVE_NO_ERROR && err != WDM_JNI_ERROR_EXCEPTION_THROWN)
+    {
+        ThrowError(env, err);
+    }
+}
+
 void Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_setStringArray(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path, jobjectArray stringArray, jboolean isConditional)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -4382,6 +4436,8 @@ jstring Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getString
     valueStr = std::string((char *)(bytesData.mpDataBuf), bytesData.mDataLen);
 
 exit:
+    bytesData.Clear();
+
     if (pPathStr != NULL)
     {
         env->ReleaseStringUTFChars(path, pPathStr);
@@ -4416,6 +4472,8 @@ jbyteArray Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getByt
     SuccessOrExit(err);
 
 exit:
+    bytesData.Clear();
+
     if (pPathStr != NULL)
     {
         env->ReleaseStringUTFChars(path, pPathStr);
@@ -4429,6 +4487,73 @@ exit:
     return value;
 }
 
+jlong Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getBytesView(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const char *pPathStr = NULL;
+    BytesData *pBytesData = NULL;
+
+    GenericTraitUpdatableDataSink *pDataSink = (GenericTraitUpdatableDataSink *)genericTraitUpdatableDataSinkPtr;
+
+    WeaveLogProgress(DeviceManager, "getBytesView() called");
+
+    pPathStr = env->GetStringUTFChars(path, 0);
+    VerifyOrExit(pPathStr != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    pBytesData = new BytesData();
+    VerifyOrExit(pBytesData != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    // The view holds a reference on the sink's buffer, so the bytes stay valid until it is released.
+    err = pDataSink->GetBytes(pPathStr, pBytesData);
+    SuccessOrExit(err);
+
+exit:
+    if (pPathStr != NULL)
+    {
+        env->ReleaseStringUTFChars(path, pPathStr);
+    }
+
+    if (err != WEAVE_NO_ERROR)
+    {
+        if (pBytesData != NULL)
+        {
+            pBytesData->Clear();
+            delete pBytesData;
+            pBytesData = NULL;
+        }
+
+        if (err != WDM_JNI_ERROR_EXCEPTION_THROWN)
+        {
+            ThrowError(env, err);
+        }
+    }
+
+    return (jlong)pBytesData;
+}
+
+jobject Java_nl_Weave_DataManagement_BytesView_getBuffer(JNIEnv *env, jclass cls, jlong bytesViewPtr)
+{
+    static uint8_t sEmpty;
+    BytesData *pBytesData = (BytesData *)bytesViewPtr;
+
+    // A direct buffer needs a valid address even when empty.
+    uint8_t *pDataBuf = (pBytesData->mDataLen != 0) ? const_cast<uint8_t *>(pBytesData->mpDataBuf) : &sEmpty;
+
+    return env->NewDirectByteBuffer(pDataBuf, (jlong)pBytesData->mDataLen);
+}
+
+void Java_nl_Weave_DataManagement_BytesView_release(JNIEnv *env, jclass cls, jlong bytesViewPtr)
+{
+    BytesData *pBytesData = (BytesData *)bytesViewPtr;
+
+    // The buffer's reference count is shared with the sink, which is updated on the network thread.
+    pthread_mutex_lock(&sStackLock);
+    pBytesData->Clear();
+    pthread_mutex_unlock(&sStackLock);
+
+    delete pBytesData;
+}
+
 jobjectArray Java_nl_Weave_DataManagement_GenericTraitUpdatableDataSinkImpl_getStringArray(JNIEnv *env, jobject self, jlong genericTraitUpdatableDataSinkPtr, jstring path)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
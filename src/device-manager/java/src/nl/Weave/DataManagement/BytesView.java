@@ -0,0 +1,80 @@
+/*
+
+    Copyright (c) 2020 Google LLC.
+    All rights reserved.
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      Represents a read-only view onto bytes held by the native Weave stack.
+ */
+
+package nl.Weave.DataManagement;
+
+import java.io.Closeable;
+import java.nio.ByteBuffer;
+
+/**
+ * A read-only view onto a bytes property of a GenericTraitUpdatableDataSink, backed directly by
+ * the native buffer the property was received in, so that reading it does not copy the bytes.
+ *
+ * The view keeps the native buffer alive, even if the data sink is refreshed or closed meanwhile,
+ * until close() is called.  The buffer returned by getBuffer() must not be used after that.
+ */
+public class BytesView implements Closeable
+{
+    BytesView(long bytesViewPtr)
+    {
+        mBytesViewPtr = bytesViewPtr;
+        mBuffer = getBuffer(bytesViewPtr).asReadOnlyBuffer();
+    }
+
+    /**
+     * Returns a read-only buffer onto the bytes.  Valid until close() is called.
+     */
+    public ByteBuffer getBuffer()
+    {
+        if (mBytesViewPtr == 0) {
+            throw new IllegalStateException("This bytes view has already been closed.");
+        }
+        return mBuffer;
+    }
+
+    /**
+     * Releases the native buffer behind the view.
+     */
+    @Override
+    public synchronized void close()
+    {
+        if (mBytesViewPtr != 0) {
+            release(mBytesViewPtr);
+            mBytesViewPtr = 0;
+            mBuffer = null;
+        }
+    }
+
+    @Override
+    protected void finalize() throws Throwable
+    {
+        close();
+        super.finalize();
+    }
+
+    private long mBytesViewPtr;
+    private ByteBuffer mBuffer;
+
+    private static native ByteBuffer getBuffer(long bytesViewPtr);
+    private static native void release(long bytesViewPtr);
+};
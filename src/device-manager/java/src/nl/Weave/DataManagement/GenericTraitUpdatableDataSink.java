@@ -27,6 +27,7 @@ import android.os.Build;
 import android.util.Log;
 
 import java.math.BigInteger;
+import java.nio.ByteBuffer;
 import java.util.EnumSet;
 import java.util.Random;
 import java.util.HashMap;
@@ -150,6 +151,18 @@ public interface GenericTraitUpdatableDataSink
      */
     public void set(String path, byte[] value, boolean isConditional);
 
+    /**
+     * Assigns the remaining bytes of the provided buffer to the given path.  The bytes of a direct
+     * buffer are read in place, without first being copied into a Java array.
+     *
+     * @param path the proto path to the property to modify
+     * @param value the bytes value to assign to the property
+     * @param isConditional whether or not to allow overwriting any conflicting changes. If true, then if a later
+     *     version of the trait has modified this property and does not equal to required version from update,
+     *     this update will be dropped; otherwise, this value will overwrite the newer change
+     */
+    public void set(String path, ByteBuffer value, boolean isConditional);
+
     /**
      * Assigns the provided value to the given path.
      *
@@ -251,6 +264,14 @@ public interface GenericTraitUpdatableDataSink
      */
     public void set(String path, byte[] value);
 
+    /**
+     * Assigns the remaining bytes of the provided buffer to the given path with unconditional capability
+     *
+     * @param path the proto path to the property to modify
+     * @param value the bytes value to assign to the property
+     */
+    public void set(String path, ByteBuffer value);
+
     /**
      * Assigns the provided value to the given path with unconditional capability
      *
@@ -315,6 +336,15 @@ public interface GenericTraitUpdatableDataSink
      */
     public byte[] getBytes(String path);
 
+    /**
+     * Returns a view onto the Bytes value assigned to the property at the given path within this trait,
+     * which reads the value in place rather than copying it.  The caller must close the view once done
+     * with it.
+     *
+     * @throws Exception if no property exists at this path, or if the type of the property does not match
+     */
+    public BytesView getBytesView(String path);
+
     /**
      * Check if null property at the given path within this trait.
      *
@@ -27,6 +27,7 @@ import android.os.Build;
 import android.util.Log;
 
 import java.math.BigInteger;
+import java.nio.ByteBuffer;
 import java.util.EnumSet;
 import java.util.Random;
 import java.util.HashMap;
@@ -117,6 +118,19 @@ public class GenericTraitUpdatableDataSinkImpl implements GenericTraitUpdatableD
         setBytes(mTraitInstancePtr, path, value, isConditional);
     }
 
+    @Override
+    public void set(String path, ByteBuffer value, boolean isConditional)
+    {
+        ensureNotClosed();
+        if (value.isDirect()) {
+            setBytesBuffer(mTraitInstancePtr, path, value.slice(), isConditional);
+        } else {
+            byte[] bytes = new byte[value.remaining()];
+            value.duplicate().get(bytes);
+            setBytes(mTraitInstancePtr, path, bytes, isConditional);
+        }
+    }
+
     @Override
     public void setNull(String path, boolean isConditional)
     {
@@ -191,6 +205,12 @@ public class GenericTraitUpdatableDataSinkImpl implements GenericTraitUpdatableD
         set(path, value, false);
     }
 
+    @Override
+    public void set(String path, ByteBuffer value)
+    {
+        set(path, value, false);
+    }
+
     @Override
     public void setNull(String path)
     {
@@ -256,6 +276,13 @@ public class GenericTraitUpdatableDataSinkImpl implements GenericTraitUpdatableD
         return getBytes(mTraitInstancePtr, path);
     }
 
+    @Override
+    public BytesView getBytesView(String path)
+    {
+        ensureNotClosed();
+        return new BytesView(getBytesView(mTraitInstancePtr, path));
+    }
+
     @Override
     public boolean isNull(String path)
     {
@@ -369,12 +396,14 @@ public class GenericTraitUpdatableDataSinkImpl implements GenericTraitUpdatableD
     private native void setString(long genericTraitUpdatableDataSinkPtr, String path, String value, boolean isConditional);
     private native void setNull(long genericTraitUpdatableDataSinkPtr, String path, boolean isConditional);
     private native void setBytes(long genericTraitUpdatableDataSinkPtr, String path, byte[] value, boolean isConditional);
+    private native void setBytesBuffer(long genericTraitUpdatableDataSinkPtr, String path, ByteBuffer value, boolean isConditional);
     private native void setStringArray(long genericTraitUpdatableDataSinkPtr, String path, String[] value, boolean isConditional);
     private native long getLong(long genericTraitUpdatableDataSinkPtr, String path);
     private native double getDouble(long genericTraitUpdatableDataSinkPtr, String path);
     private native boolean getBoolean(long genericTraitUpdatableDataSinkPtr, String path);
     private native String getString(long genericTraitUpdatableDataSinkPtr, String path);
     private native byte[] getBytes(long genericTraitUpdatableDataSinkPtr, String path);
+    private native long getBytesView(long genericTraitUpdatableDataSinkPtr, String path);
     private native boolean isNull(long genericTraitUpdatableDataSinkPtr, String path);
     private native String[] getStringArray(long genericTraitUpdatableDataSinkPtr, String path);
     private native long getVersion(long genericTraitUpdatableDataSinkPtr);
@@ -442,6 +442,11 @@ public class WeaveDeviceManager
         setConnectTimeout(mDeviceMgrPtr, timeoutMS);
     }
 
+    public void setIdleConnectionTimeout(int timeoutMS)
+    {
+        setIdleConnectionTimeout(mDeviceMgrPtr, timeoutMS);
+    }
+
     public WeaveDeviceDescriptor decodeDeviceDescriptor(byte[] encodedDeviceDesc)
     {
         return WeaveDeviceDescriptor.decode(encodedDeviceDesc);
@@ -814,6 +819,7 @@ public class WeaveDeviceManager
     private native void setAutoReconnect(long deviceMgrPtr, boolean autoReconnect);
     private native void setRendezvousLinkLocal(long deviceMgrPtr, boolean rendezvousLinkLocal);
     private native void setConnectTimeout(long deviceMgrPtr, int timeoutMS);
+    private native void setIdleConnectionTimeout(long deviceMgrPtr, int timeoutMS);
 
 
     private void onGetRendezvousModeComplete(int modeFlags)
@@ -24,6 +24,7 @@ DeviceManager_BlePlatformDelegate::DeviceManager_BlePlatformDelegate(BleLayer *b
     writeCB = NULL;
     subscribeCB = NULL;
     closeCB = NULL;
+    peerKey = 0;
 }
 
 bool DeviceManager_BlePlatformDelegate::SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId)
@@ -66,6 +67,12 @@ uint16_t DeviceManager_BlePlatformDelegate::GetMTU(BLE_CONNECTION_OBJECT connObj
     return 0;
 }
 
+uint64_t DeviceManager_BlePlatformDelegate::GetPeerKey(BLE_CONNECTION_OBJECT connObj) const
+{
+    // The Python BLE managers handle one peripheral at a time.
+    return peerKey;
+}
+
 bool DeviceManager_BlePlatformDelegate::SendIndication(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf)
 {
     // TODO Python queue-based implementation
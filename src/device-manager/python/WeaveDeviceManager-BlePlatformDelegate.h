@@ -37,6 +37,7 @@ public:
     WriteBleCharacteristicCBFunct writeCB;
     SubscribeBleCharacteristicCBFunct subscribeCB;
     CloseBleCBFunct closeCB;
+    uint64_t peerKey;
 
     // ctor
     DeviceManager_BlePlatformDelegate(BleLayer *ble);
@@ -46,11 +47,15 @@ public:
     inline void SetSubscribeCharCB(SubscribeBleCharacteristicCBFunct cb) { subscribeCB = cb; };
     inline void SetCloseCB(CloseBleCBFunct cb) { closeCB = cb; };
 
+    // Set key identifying the connected peripheral, or 0 if unknown
+    inline void SetPeerKey(uint64_t key) { peerKey = key; };
+
     // Virtuals from BlePlatformDelegate:
     bool SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId);
     bool UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId);
     bool CloseConnection(BLE_CONNECTION_OBJECT connObj);
     uint16_t GetMTU(BLE_CONNECTION_OBJECT connObj) const;
+    uint64_t GetPeerKey(BLE_CONNECTION_OBJECT connObj) const;
     bool SendIndication(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf);
     bool SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf);
     bool SendReadRequest(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf);
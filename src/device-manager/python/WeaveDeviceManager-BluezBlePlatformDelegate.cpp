@@ -0,0 +1,532 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a BLE platform delegate for the Linux device
+ *      manager that drives the WoBLE data path through BlueZ's D-Bus API
+ *      from C++.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <BleLayer/BleLayer.h>
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+
+#include "WeaveDeviceManager-BluezBlePlatformDelegate.h"
+
+using namespace nl::Weave;
+
+#define BLUEZ_SERVICE_NAME              "org.bluez"
+#define BLUEZ_DEVICE_INTERFACE          "org.bluez.Device1"
+#define BLUEZ_CHARACTERISTIC_INTERFACE  "org.bluez.GattCharacteristic1"
+#define DBUS_PROPERTIES_INTERFACE       "org.freedesktop.DBus.Properties"
+
+// UUID of the WoBLE C2 (indication) characteristic: 18EE2EF5-263D-4559-959F-4F9C429F9D12
+static const WeaveBleUUID sIndicateCharId = { { 0x18, 0xEE, 0x2E, 0xF5, 0x26, 0x3D, 0x45, 0x59, 0x95, 0x9F, 0x4F, 0x9C, 0x42,
+                                                0x9F, 0x9D, 0x12 } };
+
+// UUID of the WoBLE C1 (write) characteristic: 18EE2EF5-263D-4559-959F-4F9C429F9D11
+static const WeaveBleUUID sWriteCharId = { { 0x18, 0xEE, 0x2E, 0xF5, 0x26, 0x3D, 0x45, 0x59, 0x95, 0x9F, 0x4F, 0x9C, 0x42,
+                                             0x9F, 0x9D, 0x11 } };
+
+DeviceManager_BluezBlePlatformDelegate::DeviceManager_BluezBlePlatformDelegate(BleLayer *ble) :
+    DeviceManager_BlePlatformDelegate(ble)
+{
+    mBus = NULL;
+    memset(mConnections, 0, sizeof(mConnections));
+}
+
+WEAVE_ERROR DeviceManager_BluezBlePlatformDelegate::AttachConnection(BLE_CONNECTION_OBJECT connObj, const char *devicePath,
+                                                                     const char *writeCharPath, const char *indicateCharPath,
+                                                                     uint16_t mtu)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    Connection *conn = NULL;
+
+    VerifyOrExit(devicePath != NULL && writeCharPath != NULL && indicateCharPath != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(strlen(devicePath) < kMaxObjectPathLength && strlen(writeCharPath) < kMaxObjectPathLength &&
+                 strlen(indicateCharPath) < kMaxObjectPathLength, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = OpenBus();
+    SuccessOrExit(err);
+
+    // Re-attaching a connection object replaces its previous paths.
+    conn = FindConnection(connObj);
+    if (conn != NULL)
+    {
+        ReleaseConnection(conn);
+    }
+
+    for (int i = 0; i < kMaxConnections && conn == NULL; i++)
+    {
+        if (!mConnections[i].InUse)
+        {
+            conn = &mConnections[i];
+        }
+    }
+    VerifyOrExit(conn != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    memset(conn, 0, sizeof(*conn));
+    conn->ConnObj = connObj;
+    strcpy(conn->DevicePath, devicePath);
+    strcpy(conn->WriteCharPath, writeCharPath);
+    strcpy(conn->IndicateCharPath, indicateCharPath);
+    conn->MTU = mtu;
+    conn->InUse = true;
+
+    UpdateMatchRule(conn, true);
+
+    WeaveLogProgress(Ble, "BlueZ data path attached to %s", devicePath);
+
+exit:
+    return err;
+}
+
+void DeviceManager_BluezBlePlatformDelegate::DetachConnection(BLE_CONNECTION_OBJECT connObj)
+{
+    Connection *conn = FindConnection(connObj);
+
+    if (conn != NULL)
+    {
+        ReleaseConnection(conn);
+    }
+}
+
+void DeviceManager_BluezBlePlatformDelegate::Shutdown(void)
+{
+    for (int i = 0; i < kMaxConnections; i++)
+    {
+        if (mConnections[i].InUse)
+        {
+            ReleaseConnection(&mConnections[i]);
+        }
+    }
+
+    if (mBus != NULL)
+    {
+        dbus_connection_close(mBus);
+        dbus_connection_unref(mBus);
+        mBus = NULL;
+    }
+}
+
+void DeviceManager_BluezBlePlatformDelegate::PrepareSelect(int &maxFDs, fd_set *readFDs, struct timeval &sleepTime)
+{
+    int fd;
+
+    VerifyOrExit(mBus != NULL, );
+    VerifyOrExit(dbus_connection_get_unix_fd(mBus, &fd), );
+
+    FD_SET(fd, readFDs);
+    if (fd + 1 > maxFDs)
+        maxFDs = fd + 1;
+
+    // Messages already read from the socket must not wait for the next wake-up.
+    if (dbus_connection_get_dispatch_status(mBus) == DBUS_DISPATCH_DATA_REMAINS)
+    {
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 0;
+    }
+
+exit:
+    return;
+}
+
+void DeviceManager_BluezBlePlatformDelegate::HandleSelectResult(int &selectRes, fd_set *readFDs)
+{
+    DBusMessage *msg;
+    int fd;
+
+    VerifyOrExit(mBus != NULL, );
+    VerifyOrExit(dbus_connection_get_unix_fd(mBus, &fd), );
+
+    if (FD_ISSET(fd, readFDs))
+    {
+        dbus_connection_read_write(mBus, 0);
+
+        // Don't bother the other layers with D-Bus IO.
+        selectRes--;
+    }
+
+    while (mBus != NULL && (msg = dbus_connection_pop_message(mBus)) != NULL)
+    {
+        HandleMessage(msg);
+        dbus_message_unref(msg);
+    }
+
+exit:
+    return;
+}
+
+bool DeviceManager_BluezBlePlatformDelegate::SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId)
+{
+    Connection *conn = FindConnection(connObj);
+
+    if (conn == NULL)
+    {
+        return DeviceManager_BlePlatformDelegate::SubscribeCharacteristic(connObj, svcId, charId);
+    }
+
+    return CallMethod(conn->IndicateCharPath, BLUEZ_CHARACTERISTIC_INTERFACE, "StartNotify", NULL, 0, &conn->SubscribeSerial);
+}
+
+bool DeviceManager_BluezBlePlatformDelegate::UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId)
+{
+    Connection *conn = FindConnection(connObj);
+
+    if (conn == NULL)
+    {
+        return DeviceManager_BlePlatformDelegate::UnsubscribeCharacteristic(connObj, svcId, charId);
+    }
+
+    return CallMethod(conn->IndicateCharPath, BLUEZ_CHARACTERISTIC_INTERFACE, "StopNotify", NULL, 0, &conn->UnsubscribeSerial);
+}
+
+bool DeviceManager_BluezBlePlatformDelegate::CloseConnection(BLE_CONNECTION_OBJECT connObj)
+{
+    Connection *conn = FindConnection(connObj);
+    bool ret;
+
+    if (conn == NULL)
+    {
+        return DeviceManager_BlePlatformDelegate::CloseConnection(connObj);
+    }
+
+    // The disconnect completes asynchronously; the Weave stack has no further interest in this connection.
+    ret = CallMethod(conn->DevicePath, BLUEZ_DEVICE_INTERFACE, "Disconnect", NULL, 0, NULL);
+
+    ReleaseConnection(conn);
+
+    return ret;
+}
+
+uint16_t DeviceManager_BluezBlePlatformDelegate::GetMTU(BLE_CONNECTION_OBJECT connObj) const
+{
+    const Connection *conn = FindConnection(connObj);
+
+    if (conn == NULL)
+    {
+        return DeviceManager_BlePlatformDelegate::GetMTU(connObj);
+    }
+
+    return conn->MTU;
+}
+
+bool DeviceManager_BluezBlePlatformDelegate::SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf)
+{
+    Connection *conn = FindConnection(connObj);
+    bool ret = false;
+
+    if (conn == NULL)
+    {
+        return DeviceManager_BlePlatformDelegate::SendWriteRequest(connObj, svcId, charId, pBuf);
+    }
+
+    if (pBuf != NULL)
+    {
+        ret = CallMethod(conn->WriteCharPath, BLUEZ_CHARACTERISTIC_INTERFACE, "WriteValue", pBuf->Start(), pBuf->DataLength(),
+                         &conn->WriteSerial);
+    }
+
+    // The payload has been copied into the D-Bus message, so release the delegate's reference to pBuf.
+    nl::Weave::System::PacketBuffer::Free(pBuf);
+
+    return ret;
+}
+
+WEAVE_ERROR DeviceManager_BluezBlePlatformDelegate::OpenBus(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    DBusError dbusErr;
+
+    VerifyOrExit(mBus == NULL, );
+
+    dbus_error_init(&dbusErr);
+
+    // A private connection keeps the IO thread's traffic away from the Python D-Bus main loop.
+    mBus = dbus_bus_get_private(DBUS_BUS_SYSTEM, &dbusErr);
+    if (mBus == NULL)
+    {
+        WeaveLogError(Ble, "Failed to connect to system bus: %s", dbusErr.message);
+        dbus_error_free(&dbusErr);
+        ExitNow(err = WEAVE_ERROR_INCORRECT_STATE);
+    }
+
+    dbus_connection_set_exit_on_disconnect(mBus, FALSE);
+
+exit:
+    return err;
+}
+
+DeviceManager_BluezBlePlatformDelegate::Connection *DeviceManager_BluezBlePlatformDelegate::FindConnection(BLE_CONNECTION_OBJECT connObj)
+{
+    for (int i = 0; i < kMaxConnections; i++)
+    {
+        if (mConnections[i].InUse && mConnections[i].ConnObj == connObj)
+        {
+            return &mConnections[i];
+        }
+    }
+
+    return NULL;
+}
+
+const DeviceManager_BluezBlePlatformDelegate::Connection *DeviceManager_BluezBlePlatformDelegate::FindConnection(BLE_CONNECTION_OBJECT connObj) const
+{
+    return const_cast<DeviceManager_BluezBlePlatformDelegate *>(this)->FindConnection(connObj);
+}
+
+void DeviceManager_BluezBlePlatformDelegate::ReleaseConnection(Connection *conn)
+{
+    UpdateMatchRule(conn, false);
+    conn->InUse = false;
+}
+
+bool DeviceManager_BluezBlePlatformDelegate::CallMethod(const char *path, const char *interface, const char *method,
+                                                        const uint8_t *value, uint16_t length, dbus_uint32_t *serial)
+{
+    DBusMessage *msg = NULL;
+    DBusMessageIter iter, array;
+    bool ret = false;
+
+    VerifyOrExit(mBus != NULL, );
+
+    msg = dbus_message_new_method_call(BLUEZ_SERVICE_NAME, path, interface, method);
+    VerifyOrExit(msg != NULL, );
+
+    if (value != NULL)
+    {
+        // WriteValue(array{byte} value, dict{string, variant} options)
+        dbus_message_iter_init_append(msg, &iter);
+
+        VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, DBUS_TYPE_BYTE_AS_STRING, &array), );
+        VerifyOrExit(dbus_message_iter_append_fixed_array(&array, DBUS_TYPE_BYTE, &value, length), );
+        VerifyOrExit(dbus_message_iter_close_container(&iter, &array), );
+
+        VerifyOrExit(dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, "{sv}", &array), );
+        VerifyOrExit(dbus_message_iter_close_container(&iter, &array), );
+    }
+
+    if (serial == NULL)
+    {
+        dbus_message_set_no_reply(msg, TRUE);
+    }
+
+    VerifyOrExit(dbus_connection_send(mBus, msg, serial), );
+    dbus_connection_flush(mBus);
+
+    ret = true;
+
+exit:
+    if (msg != NULL)
+    {
+        dbus_message_unref(msg);
+    }
+
+    return ret;
+}
+
+void DeviceManager_BluezBlePlatformDelegate::UpdateMatchRule(const Connection *conn, bool add)
+{
+    char rule[kMaxObjectPathLength + 160];
+
+    VerifyOrExit(mBus != NULL, );
+
+    // Property changes of the device (link state) and of its characteristics (indicated values).
+    snprintf(rule, sizeof(rule),
+             "type='signal',sender='" BLUEZ_SERVICE_NAME "',interface='" DBUS_PROPERTIES_INTERFACE "',"
+             "member='PropertiesChanged',path_namespace='%s'", conn->DevicePath);
+
+    // Passing no error makes these calls asynchronous.
+    if (add)
+    {
+        dbus_bus_add_match(mBus, rule, NULL);
+    }
+    else
+    {
+        dbus_bus_remove_match(mBus, rule, NULL);
+    }
+    dbus_connection_flush(mBus);
+
+exit:
+    return;
+}
+
+void DeviceManager_BluezBlePlatformDelegate::HandleMessage(DBusMessage *msg)
+{
+    switch (dbus_message_get_type(msg))
+    {
+    case DBUS_MESSAGE_TYPE_METHOD_RETURN:
+    case DBUS_MESSAGE_TYPE_ERROR:
+        HandleReply(msg);
+        break;
+
+    case DBUS_MESSAGE_TYPE_SIGNAL:
+        if (dbus_message_is_signal(msg, DBUS_PROPERTIES_INTERFACE, "PropertiesChanged"))
+        {
+            HandlePropertiesChanged(msg);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void DeviceManager_BluezBlePlatformDelegate::HandleReply(DBusMessage *msg)
+{
+    const dbus_uint32_t replySerial = dbus_message_get_reply_serial(msg);
+    const bool success = (dbus_message_get_type(msg) == DBUS_MESSAGE_TYPE_METHOD_RETURN);
+
+    for (int i = 0; i < kMaxConnections; i++)
+    {
+        Connection *conn = &mConnections[i];
+
+        if (!conn->InUse)
+        {
+            continue;
+        }
+
+        if (conn->WriteSerial == replySerial)
+        {
+            conn->WriteSerial = 0;
+
+            if (success)
+                Ble->HandleWriteConfirmation(conn->ConnObj, &WEAVE_BLE_SVC_ID, &sWriteCharId);
+            else
+                Ble->HandleConnectionError(conn->ConnObj, BLE_ERROR_GATT_WRITE_FAILED);
+            break;
+        }
+
+        if (conn->SubscribeSerial == replySerial)
+        {
+            conn->SubscribeSerial = 0;
+
+            if (success)
+                Ble->HandleSubscribeComplete(conn->ConnObj, &WEAVE_BLE_SVC_ID, &sIndicateCharId);
+            else
+                Ble->HandleConnectionError(conn->ConnObj, BLE_ERROR_GATT_SUBSCRIBE_FAILED);
+            break;
+        }
+
+        if (conn->UnsubscribeSerial == replySerial)
+        {
+            conn->UnsubscribeSerial = 0;
+
+            if (success)
+                Ble->HandleUnsubscribeComplete(conn->ConnObj, &WEAVE_BLE_SVC_ID, &sIndicateCharId);
+            else
+                Ble->HandleConnectionError(conn->ConnObj, BLE_ERROR_GATT_UNSUBSCRIBE_FAILED);
+            break;
+        }
+    }
+}
+
+void DeviceManager_BluezBlePlatformDelegate::HandlePropertiesChanged(DBusMessage *msg)
+{
+    // PropertiesChanged(string interface, dict{string, variant} changed, array{string} invalidated)
+    const char *path = dbus_message_get_path(msg);
+    const char *interface = NULL;
+    Connection *conn = NULL;
+    DBusMessageIter iter, dict, entry, variant, array;
+
+    VerifyOrExit(path != NULL, );
+
+    for (int i = 0; i < kMaxConnections && conn == NULL; i++)
+    {
+        if (mConnections[i].InUse &&
+            (strcmp(path, mConnections[i].IndicateCharPath) == 0 || strcmp(path, mConnections[i].DevicePath) == 0))
+        {
+            conn = &mConnections[i];
+        }
+    }
+    VerifyOrExit(conn != NULL, );
+
+    VerifyOrExit(dbus_message_iter_init(msg, &iter), );
+    VerifyOrExit(dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_STRING, );
+    dbus_message_iter_get_basic(&iter, &interface);
+
+    VerifyOrExit(dbus_message_iter_next(&iter), );
+    VerifyOrExit(dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_ARRAY, );
+    dbus_message_iter_recurse(&iter, &dict);
+
+    for (; dbus_message_iter_get_arg_type(&dict) == DBUS_TYPE_DICT_ENTRY; dbus_message_iter_next(&dict))
+    {
+        const char *name = NULL;
+
+        dbus_message_iter_recurse(&dict, &entry);
+        VerifyOrExit(dbus_message_iter_get_arg_type(&entry) == DBUS_TYPE_STRING, );
+        dbus_message_iter_get_basic(&entry, &name);
+        dbus_message_iter_next(&entry);
+        VerifyOrExit(dbus_message_iter_get_arg_type(&entry) == DBUS_TYPE_VARIANT, );
+        dbus_message_iter_recurse(&entry, &variant);
+
+        if (strcmp(interface, BLUEZ_CHARACTERISTIC_INTERFACE) == 0 && strcmp(name, "Value") == 0 &&
+            strcmp(path, conn->IndicateCharPath) == 0 && dbus_message_iter_get_arg_type(&variant) == DBUS_TYPE_ARRAY &&
+            dbus_message_iter_get_element_type(&variant) == DBUS_TYPE_BYTE)
+        {
+            const uint8_t *value = NULL;
+            int length = 0;
+            System::PacketBuffer *msgBuf;
+
+            dbus_message_iter_recurse(&variant, &array);
+            dbus_message_iter_get_fixed_array(&array, &value, &length);
+
+            msgBuf = System::PacketBuffer::New();
+            if (msgBuf == NULL || static_cast<uint16_t>(length) > msgBuf->AvailableDataLength())
+            {
+                System::PacketBuffer::Free(msgBuf);
+                Ble->HandleConnectionError(conn->ConnObj, BLE_ERROR_NO_MEMORY);
+                ExitNow();
+            }
+
+            memcpy(msgBuf->Start(), value, length);
+            msgBuf->SetDataLength(length);
+
+            // BlueZ has already confirmed the indication on our behalf.
+            if (!Ble->HandleIndicationReceived(conn->ConnObj, &WEAVE_BLE_SVC_ID, &sIndicateCharId, msgBuf))
+            {
+                System::PacketBuffer::Free(msgBuf);
+            }
+
+            // The Weave stack may have closed the connection while handling the indication.
+            ExitNow();
+        }
+        else if (strcmp(interface, BLUEZ_DEVICE_INTERFACE) == 0 && strcmp(name, "Connected") == 0 &&
+                 dbus_message_iter_get_arg_type(&variant) == DBUS_TYPE_BOOLEAN)
+        {
+            dbus_bool_t connected = TRUE;
+
+            dbus_message_iter_get_basic(&variant, &connected);
+            if (!connected)
+            {
+                BLE_CONNECTION_OBJECT connObj = conn->ConnObj;
+
+                ReleaseConnection(conn);
+                Ble->HandleConnectionError(connObj, BLE_ERROR_REMOTE_DEVICE_DISCONNECTED);
+                ExitNow();
+            }
+        }
+    }
+
+exit:
+    return;
+}
@@ -0,0 +1,106 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a BLE platform delegate for the Linux device
+ *      manager that carries WoBLE traffic over BlueZ directly from C++.
+ *
+ *      The Python BluezManager keeps ownership of the control plane
+ *      (adapter selection, scanning, connecting and GATT discovery). Once
+ *      the Weave service has been resolved it attaches the connection's
+ *      BlueZ object paths to this delegate, after which characteristic
+ *      writes, indications and subscription changes are exchanged with
+ *      bluetoothd over a private D-Bus connection that is serviced from
+ *      the device manager's IO thread select() loop, without a round trip
+ *      through the Python interpreter.
+ *
+ *      Connections that have not been attached fall back to the Python
+ *      callbacks of DeviceManager_BlePlatformDelegate.
+ */
+
+#ifndef DEVICEMANAGER_BLUEZBLEPLATFORMDELEGATE_H_
+#define DEVICEMANAGER_BLUEZBLEPLATFORMDELEGATE_H_
+
+#include <sys/select.h>
+#include <sys/time.h>
+
+#include <dbus/dbus.h>
+
+#include "WeaveDeviceManager-BlePlatformDelegate.h"
+
+class DeviceManager_BluezBlePlatformDelegate :
+    public DeviceManager_BlePlatformDelegate
+{
+public:
+    // ctor
+    DeviceManager_BluezBlePlatformDelegate(BleLayer *ble);
+
+    // Hand the data path of a connected Weave peripheral over to the native implementation.
+    WEAVE_ERROR AttachConnection(BLE_CONNECTION_OBJECT connObj, const char *devicePath, const char *writeCharPath,
+                                 const char *indicateCharPath, uint16_t mtu);
+    void DetachConnection(BLE_CONNECTION_OBJECT connObj);
+    void Shutdown(void);
+
+    // Integration with the IO thread select() loop.
+    void PrepareSelect(int &maxFDs, fd_set *readFDs, struct timeval &sleepTime);
+    void HandleSelectResult(int &selectRes, fd_set *readFDs);
+
+    // Virtuals from BlePlatformDelegate:
+    bool SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId);
+    bool UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId);
+    bool CloseConnection(BLE_CONNECTION_OBJECT connObj);
+    uint16_t GetMTU(BLE_CONNECTION_OBJECT connObj) const;
+    bool SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const nl::Ble::WeaveBleUUID *svcId, const nl::Ble::WeaveBleUUID *charId, nl::Weave::System::PacketBuffer *pBuf);
+
+private:
+    enum
+    {
+        kMaxConnections      = BLE_LAYER_NUM_BLE_ENDPOINTS,
+        kMaxObjectPathLength = 128
+    };
+
+    struct Connection
+    {
+        BLE_CONNECTION_OBJECT ConnObj;
+        char DevicePath[kMaxObjectPathLength];
+        char WriteCharPath[kMaxObjectPathLength];
+        char IndicateCharPath[kMaxObjectPathLength];
+        uint16_t MTU;
+        dbus_uint32_t WriteSerial;
+        dbus_uint32_t SubscribeSerial;
+        dbus_uint32_t UnsubscribeSerial;
+        bool InUse;
+    };
+
+    DBusConnection *mBus;
+    Connection mConnections[kMaxConnections];
+
+    WEAVE_ERROR OpenBus(void);
+    Connection *FindConnection(BLE_CONNECTION_OBJECT connObj);
+    const Connection *FindConnection(BLE_CONNECTION_OBJECT connObj) const;
+    void ReleaseConnection(Connection *conn);
+    bool CallMethod(const char *path, const char *interface, const char *method, const uint8_t *value, uint16_t length,
+                    dbus_uint32_t *serial);
+    void UpdateMatchRule(const Connection *conn, bool add);
+    void HandleMessage(DBusMessage *msg);
+    void HandleReply(DBusMessage *msg);
+    void HandlePropertiesChanged(DBusMessage *msg);
+};
+
+#endif /* DEVICEMANAGER_BLUEZBLEPLATFORMDELEGATE_H_ */
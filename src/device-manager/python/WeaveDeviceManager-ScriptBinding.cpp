@@ -55,6 +55,9 @@
 #if CONFIG_NETWORK_LAYER_BLE
 #include "WeaveDeviceManager-BlePlatformDelegate.h"
 #include "WeaveDeviceManager-BleApplicationDelegate.h"
+#if CONFIG_BLE_PLATFORM_BLUEZ
+#include "WeaveDeviceManager-BluezBlePlatformDelegate.h"
+#endif
 #if WEAVE_ENABLE_WOBLE_TEST
 #include "WoBleTest.h"
 #endif
@@ -139,7 +142,11 @@ static InetLayer Inet;
 
 #if CONFIG_NETWORK_LAYER_BLE
 static BleLayer Ble;
+#if CONFIG_BLE_PLATFORM_BLUEZ
+static DeviceManager_BluezBlePlatformDelegate sBlePlatformDelegate(&Ble);
+#else
 static DeviceManager_BlePlatformDelegate sBlePlatformDelegate(&Ble);
+#endif
 static DeviceManager_BleApplicationDelegate sBleApplicationDelegate;
 
 static volatile GetBleEventCBFunct GetBleEventCB = NULL;
@@ -152,6 +159,8 @@ extern "C" {
     typedef void (*DeviceEnumerationResponseScriptFunct)(WeaveDeviceManager *deviceMgr, const DeviceDescription::WeaveDeviceDescriptor *devdesc, const char *deviceAddrStr);
 
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_DriveIO(uint32_t sleepTimeMS);
+    NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_PrepareIO(int *readFDs, uint32_t *numReadFDs, int *writeFDs, uint32_t *numWriteFDs,
+                                                               uint32_t *sleepTimeMS);
 
 #if CONFIG_NETWORK_LAYER_BLE
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_WakeForBleIO();
@@ -159,6 +168,13 @@ extern "C" {
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_SetBleWriteCharacteristic(WriteBleCharacteristicCBFunct writeBleCharacteristicCB);
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_SetBleSubscribeCharacteristic(SubscribeBleCharacteristicCBFunct subscribeBleCharacteristicCB);
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_SetBleClose(CloseBleCBFunct closeBleCB);
+    NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_SetBlePeerKey(uint64_t peerKey);
+#if CONFIG_BLE_PLATFORM_BLUEZ
+    NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_AttachBluezConnection(BLE_CONNECTION_OBJECT connObj, const char *devicePath,
+                                                                           const char *writeCharPath, const char *indicateCharPath,
+                                                                           uint16_t mtu);
+    NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_DetachBluezConnection(BLE_CONNECTION_OBJECT connObj);
+#endif /* CONFIG_BLE_PLATFORM_BLUEZ */
 #endif /* CONFIG_NETWORK_LAYER_BLE */
 
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_NewDeviceManager(WeaveDeviceManager **outDevMgr);
@@ -233,6 +249,7 @@ extern "C" {
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_SetAutoReconnect(WeaveDeviceManager *devMgr, bool autoReconnect);
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_SetRendezvousLinkLocal(WeaveDeviceManager *devMgr, bool RendezvousLinkLocal);
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_SetConnectTimeout(WeaveDeviceManager *devMgr, uint32_t timeoutMS);
+    NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_SetIdleConnectionTimeout(WeaveDeviceManager *devMgr, uint32_t timeoutMS);
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_DeviceManager_RegisterServicePairAccount(WeaveDeviceManager *devMgr, uint64_t serviceId, const char *accountId,
             const uint8_t *serviceConfig, uint16_t serviceConfigLen,
             const uint8_t *pairingToken, uint16_t pairingTokenLen,
@@ -274,6 +291,12 @@ extern "C" {
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_RefreshData(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, DMCompleteFunct onComplete, DMErrorFunct onError);
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_SetTLVBytes(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, const char * apPath, const uint8_t * dataBuf, size_t dataLen, bool aIsConditional);
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytes(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, const char * apPath, ConstructBytesArrayFunct aCallback);
+    NL_DLL_EXPORT WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesView(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, const char * apPath, BytesData ** apBytesView, const uint8_t ** apDataBuf, uint32_t * apDataLen);
+    NL_DLL_EXPORT void nl_Weave_GenericTraitUpdatableDataSink_ReleaseBytesView(BytesData * apBytesView);
+    NL_DLL_EXPORT WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_CompilePath(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, const char * apPath, GenericTraitPath ** apCompiledPath);
+    NL_DLL_EXPORT void nl_Weave_GenericTraitUpdatableDataSink_ReleasePath(GenericTraitPath * apCompiledPath);
+    NL_DLL_EXPORT WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_SetTLVBytesByPath(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, GenericTraitPath * apCompiledPath, const uint8_t * dataBuf, size_t dataLen, bool aIsConditional);
+    NL_DLL_EXPORT WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesViewByPath(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, GenericTraitPath * apCompiledPath, BytesData ** apBytesView, const uint8_t ** apDataBuf, uint32_t * apDataLen);
     NL_DLL_EXPORT uint64_t nl_Weave_GenericTraitUpdatableDataSink_GetVersion(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink);
     NL_DLL_EXPORT WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_DeleteData(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, const char * apPath);
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_CLIENT_EXPERIMENTAL
@@ -338,6 +361,40 @@ WEAVE_ERROR nl_Weave_DeviceManager_DeleteDeviceManager(WeaveDeviceManager *devMg
     return WEAVE_NO_ERROR;
 }
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+/**
+ * Collect the file descriptors the stack is waiting on, and shorten the given sleep time to the
+ * expiration of the next timer.
+ */
+static void PrepareSelect(int & maxFDs, fd_set * readFDs, fd_set * writeFDs, fd_set * exceptFDs, struct timeval & sleepTime)
+{
+    FD_ZERO(readFDs);
+    FD_ZERO(writeFDs);
+    FD_ZERO(exceptFDs);
+
+    if (sSystemLayer.State() == System::kLayerState_Initialized)
+        sSystemLayer.PrepareSelect(maxFDs, readFDs, writeFDs, exceptFDs, sleepTime);
+
+    if (Inet.State == InetLayer::kState_Initialized)
+        Inet.PrepareSelect(maxFDs, readFDs, writeFDs, exceptFDs, sleepTime);
+
+#if CONFIG_NETWORK_LAYER_BLE
+    // Add read end of BLE wake pipe to readFDs.
+    FD_SET(BleWakePipe[0], readFDs);
+
+    if (BleWakePipe[0] + 1 > maxFDs)
+        maxFDs = BleWakePipe[0] + 1;
+
+#if CONFIG_BLE_PLATFORM_BLUEZ
+    // Add the D-Bus connection carrying natively attached BLE connections.
+    sBlePlatformDelegate.PrepareSelect(maxFDs, readFDs, sleepTime);
+#endif /* CONFIG_BLE_PLATFORM_BLUEZ */
+#endif /* CONFIG_NETWORK_LAYER_BLE */
+}
+
+#endif /* WEAVE_SYSTEM_CONFIG_USE_SOCKETS */
+
 WEAVE_ERROR nl_Weave_DeviceManager_DriveIO(uint32_t sleepTimeMS)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -365,31 +422,19 @@ WEAVE_ERROR nl_Weave_DeviceManager_DriveIO(uint32_t sleepTimeMS)
     } evu;
 #endif /* CONFIG_NETWORK_LAYER_BLE */
 
-    FD_ZERO(&readFDs);
-    FD_ZERO(&writeFDs);
-    FD_ZERO(&exceptFDs);
-
     sleepTime.tv_sec = sleepTimeMS / 1000;
     sleepTime.tv_usec = (sleepTimeMS % 1000) * 1000;
 
-    if (sSystemLayer.State() == System::kLayerState_Initialized)
-        sSystemLayer.PrepareSelect(maxFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
-
-    if (Inet.State == InetLayer::kState_Initialized)
-        Inet.PrepareSelect(maxFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
-
-#if CONFIG_NETWORK_LAYER_BLE
-    // Add read end of BLE wake pipe to readFDs.
-    FD_SET(BleWakePipe[0], &readFDs);
-
-    if (BleWakePipe[0] + 1 > maxFDs)
-        maxFDs = BleWakePipe[0] + 1;
-#endif /* CONFIG_NETWORK_LAYER_BLE */
+    PrepareSelect(maxFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
 
     int selectRes = select(maxFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
     VerifyOrExit(selectRes >= 0, err = System::MapErrorPOSIX(errno));
 
 #if CONFIG_NETWORK_LAYER_BLE
+#if CONFIG_BLE_PLATFORM_BLUEZ
+    sBlePlatformDelegate.HandleSelectResult(selectRes, &readFDs);
+#endif /* CONFIG_BLE_PLATFORM_BLUEZ */
+
     // Drive IO to InetLayer and/or BleLayer.
     if (FD_ISSET(BleWakePipe[0], &readFDs))
     {
@@ -514,6 +559,68 @@ exit:
     return err;
 }
 
+/**
+ * Report what the stack is waiting on, for callers that wait in their own event loop (e.g. asyncio)
+ * rather than in nl_Weave_DeviceManager_DriveIO().
+ *
+ * When any of the returned file descriptors becomes ready, or the returned sleep time elapses, the
+ * caller must call nl_Weave_DeviceManager_DriveIO(0) and then call this function again, as the set
+ * of file descriptors may have changed.  The same applies after any call that starts an operation.
+ * Exception conditions are not reported; they are picked up by the next call to DriveIO().
+ *
+ * @param[out]    readFDs       File descriptors to wait on for readability.
+ * @param[inout]  numReadFDs    On entry, the capacity of readFDs; on return, the number of entries filled.
+ * @param[out]    writeFDs      File descriptors to wait on for writability.
+ * @param[inout]  numWriteFDs   On entry, the capacity of writeFDs; on return, the number of entries filled.
+ * @param[inout]  sleepTimeMS   On entry, the longest time the caller intends to wait; on return, the time
+ *                              until the next stack timer expires, if that is sooner.
+ *
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL    If the stack is waiting on more file descriptors than fit.
+ */
+WEAVE_ERROR nl_Weave_DeviceManager_PrepareIO(int *readFDs, uint32_t *numReadFDs, int *writeFDs, uint32_t *numWriteFDs,
+                                             uint32_t *sleepTimeMS)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+#if !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+    ExitNow(err = WEAVE_ERROR_NOT_IMPLEMENTED);
+
+#else /* WEAVE_SYSTEM_CONFIG_USE_SOCKETS */
+    struct timeval sleepTime;
+    fd_set readSet, writeSet, exceptSet;
+    int maxFDs = 0;
+    uint32_t readCount = 0, writeCount = 0;
+
+    sleepTime.tv_sec = *sleepTimeMS / 1000;
+    sleepTime.tv_usec = (*sleepTimeMS % 1000) * 1000;
+
+    PrepareSelect(maxFDs, &readSet, &writeSet, &exceptSet, sleepTime);
+
+    for (int fd = 0; fd < maxFDs; fd++)
+    {
+        if (FD_ISSET(fd, &readSet))
+        {
+            VerifyOrExit(readCount < *numReadFDs, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+            readFDs[readCount++] = fd;
+        }
+        if (FD_ISSET(fd, &writeSet))
+        {
+            VerifyOrExit(writeCount < *numWriteFDs, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+            writeFDs[writeCount++] = fd;
+        }
+    }
+
+    *numReadFDs = readCount;
+    *numWriteFDs = writeCount;
+    *sleepTimeMS = sleepTime.tv_sec * 1000 + (sleepTime.tv_usec + 999) / 1000;
+
+#endif /* WEAVE_SYSTEM_CONFIG_USE_SOCKETS */
+
+exit:
+    return err;
+}
+
 #if CONFIG_NETWORK_LAYER_BLE
 WEAVE_ERROR nl_Weave_DeviceManager_WakeForBleIO()
 {
@@ -555,6 +662,26 @@ WEAVE_ERROR nl_Weave_DeviceManager_SetBleClose(CloseBleCBFunct closeBleCB)
     return WEAVE_NO_ERROR;
 }
 
+WEAVE_ERROR nl_Weave_DeviceManager_SetBlePeerKey(uint64_t peerKey)
+{
+    sBlePlatformDelegate.SetPeerKey(peerKey);
+    return WEAVE_NO_ERROR;
+}
+
+#if CONFIG_BLE_PLATFORM_BLUEZ
+WEAVE_ERROR nl_Weave_DeviceManager_AttachBluezConnection(BLE_CONNECTION_OBJECT connObj, const char *devicePath,
+                                                         const char *writeCharPath, const char *indicateCharPath, uint16_t mtu)
+{
+    return sBlePlatformDelegate.AttachConnection(connObj, devicePath, writeCharPath, indicateCharPath, mtu);
+}
+
+WEAVE_ERROR nl_Weave_DeviceManager_DetachBluezConnection(BLE_CONNECTION_OBJECT connObj)
+{
+    sBlePlatformDelegate.DetachConnection(connObj);
+    return WEAVE_NO_ERROR;
+}
+#endif /* CONFIG_BLE_PLATFORM_BLUEZ */
+
 #endif /* CONFIG_NETWORK_LAYER_BLE */
 
 void nl_Weave_DeviceManager_Close(WeaveDeviceManager *devMgr)
@@ -984,6 +1111,11 @@ WEAVE_ERROR nl_Weave_DeviceManager_SetConnectTimeout(WeaveDeviceManager *devMgr,
     return devMgr->SetConnectTimeout(timeoutMS);
 }
 
+WEAVE_ERROR nl_Weave_DeviceManager_SetIdleConnectionTimeout(WeaveDeviceManager *devMgr, uint32_t timeoutMS)
+{
+    return devMgr->SetIdleConnectionTimeout(timeoutMS);
+}
+
 WEAVE_ERROR nl_Weave_DeviceManager_RegisterServicePairAccount(WeaveDeviceManager *devMgr, uint64_t serviceId, const char *accountId,
         const uint8_t *serviceConfig, uint16_t serviceConfigLen,
         const uint8_t *pairingToken, uint16_t pairingTokenLen,
@@ -1485,6 +1617,97 @@ exit:
 
 }
 
+/**
+ * Get the TLV encoding of the data at the given path, without copying it out.
+ *
+ * On success, the encoding lies at *apDataBuf, and stays valid until the returned view is passed
+ * to nl_Weave_GenericTraitUpdatableDataSink_ReleaseBytesView().
+ */
+WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesView(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, const char * apPath, BytesData ** apBytesView, const uint8_t ** apDataBuf, uint32_t * apDataLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    BytesData * bytesView = new BytesData();
+    VerifyOrExit(bytesView != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = apGenericTraitUpdatableDataSink->GetTLVBytes(apPath, bytesView);
+    SuccessOrExit(err);
+
+    *apBytesView = bytesView;
+    *apDataBuf = bytesView->mpDataBuf;
+    *apDataLen = bytesView->mDataLen;
+    bytesView = NULL;
+
+exit:
+    if (bytesView != NULL)
+    {
+        bytesView->Clear();
+        delete bytesView;
+    }
+    return err;
+}
+
+void nl_Weave_GenericTraitUpdatableDataSink_ReleaseBytesView(BytesData * apBytesView)
+{
+    if (apBytesView != NULL)
+    {
+        apBytesView->Clear();
+        delete apBytesView;
+    }
+}
+
+WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_CompilePath(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, const char * apPath, GenericTraitPath ** apCompiledPath)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    GenericTraitPath * compiledPath = new GenericTraitPath();
+    VerifyOrExit(compiledPath != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = apGenericTraitUpdatableDataSink->CompilePath(apPath, *compiledPath);
+    SuccessOrExit(err);
+
+    *apCompiledPath = compiledPath;
+    compiledPath = NULL;
+
+exit:
+    if (compiledPath != NULL)
+    {
+        delete compiledPath;
+    }
+    return err;
+}
+
+void nl_Weave_GenericTraitUpdatableDataSink_ReleasePath(GenericTraitPath * apCompiledPath)
+{
+    delete apCompiledPath;
+}
+
+WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_SetTLVBytesByPath(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, GenericTraitPath * apCompiledPath, const uint8_t * dataBuf, size_t dataLen, bool aIsConditional)
+{
+    return apGenericTraitUpdatableDataSink->SetTLVBytes(*apCompiledPath, dataBuf, dataLen, aIsConditional);
+}
+
+WEAVE_ERROR nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesViewByPath(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink, GenericTraitPath * apCompiledPath, BytesData ** apBytesView, const uint8_t ** apDataBuf, uint32_t * apDataLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    BytesData * bytesView = new BytesData();
+    VerifyOrExit(bytesView != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = apGenericTraitUpdatableDataSink->GetTLVBytes(*apCompiledPath, bytesView);
+    SuccessOrExit(err);
+
+    *apBytesView = bytesView;
+    *apDataBuf = bytesView->mpDataBuf;
+    *apDataLen = bytesView->mDataLen;
+    bytesView = NULL;
+
+exit:
+    if (bytesView != NULL)
+    {
+        bytesView->Clear();
+        delete bytesView;
+    }
+    return err;
+}
+
 uint64_t nl_Weave_GenericTraitUpdatableDataSink_GetVersion(GenericTraitUpdatableDataSink * apGenericTraitUpdatableDataSink)
 {
     uint64_t version = apGenericTraitUpdatableDataSink->GetVersion();
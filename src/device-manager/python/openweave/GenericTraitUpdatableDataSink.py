@@ -28,12 +28,56 @@ from .WeaveStack import *
 from .WeaveTLV import *
 
 
-__all__ = [ 'GenericTraitUpdatableDataSink' ]
+__all__ = [ 'GenericTraitUpdatableDataSink', 'TraitPath' ]
 
 _CompleteFunct                              = CFUNCTYPE(None, c_void_p, c_void_p)
 _ErrorFunct                                 = CFUNCTYPE(None, c_void_p, c_void_p, c_ulong, POINTER(DeviceStatusStruct))
 _ConstructBytesArrayFunct                   = CFUNCTYPE(None, c_void_p, c_uint32)
 
+class _TLVBytesView(object):
+    '''A read-only buffer-protocol view onto TLV bytes held by the openweave library.
+       The bytes stay valid until release() is called, after which the buffer must not be used.'''
+    def __init__(self, dataSink, bytesView, dataBuf, dataLen):
+        self._dataSink = dataSink
+        self._bytesView = bytesView
+        if dataLen != 0:
+            self._buffer = memoryview((c_uint8 * dataLen).from_address(dataBuf.value)).cast('B')
+        else:
+            self._buffer = memoryview(b'')
+
+    @property
+    def buffer(self):
+        return self._buffer
+
+    def release(self):
+        if self._bytesView != None:
+            self._buffer.release()
+            self._dataSink._releaseTLVBytesView(self._bytesView)
+            self._bytesView = None
+
+    def __del__(self):
+        self.release()
+
+class TraitPath(object):
+    '''A property path resolved once by GenericTraitUpdatableDataSink.compilePath(), which can be
+       passed to getData() and setData() in place of the path string to skip resolving it again.'''
+    def __init__(self, dataSink, path, compiledPath):
+        self._dataSink = dataSink
+        self._path = path
+        self._compiledPath = compiledPath
+
+    @property
+    def path(self):
+        return self._path
+
+    def release(self):
+        if self._compiledPath != None:
+            self._dataSink._releaseTraitPath(self._compiledPath)
+            self._compiledPath = None
+
+    def __del__(self):
+        self.release()
+
 class GenericTraitUpdatableDataSink:
     def __init__(self, resourceIdentifier, profileId, instanceId, path, traitInstance, wdmClient):
         self._resourceIdentifier = resourceIdentifier
@@ -97,12 +141,19 @@ class GenericTraitUpdatableDataSink:
         writer = TLVWriter()
         writer.put(None, val)
 
-        dataBuf = WeaveUtility.ByteArrayToVoidPtr(writer.encoding)
-        dataLen = len(writer.encoding) if (writer.encoding != None) else 0
+        # Hand the encoding to the library in place, rather than copying it into a ctypes array.
+        dataLen = len(writer.encoding)
+        dataBuf = cast((c_uint8 * dataLen).from_buffer(writer.encoding), c_void_p) if dataLen != 0 else c_void_p(0)
 
-        res = self._weaveStack.Call(
-            lambda: self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_SetTLVBytes(self._traitInstance, path, dataBuf, dataLen, isConditional)
-        )
+        if isinstance(path, TraitPath):
+            compiledPath = self._compiledPathOf(path)
+            res = self._weaveStack.Call(
+                lambda: self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_SetTLVBytesByPath(self._traitInstance, compiledPath, dataBuf, dataLen, isConditional)
+            )
+        else:
+            res = self._weaveStack.Call(
+                lambda: self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_SetTLVBytes(self._traitInstance, path, dataBuf, dataLen, isConditional)
+            )
 
         del writer
         if (res != 0):
@@ -110,13 +161,15 @@ class GenericTraitUpdatableDataSink:
 
     def getData(self, path):
         self._ensureNotClosed()
-        res = self._getTLVBytes(path)
 
-        if isinstance(res, int):
-            raise self._weaveStack.ErrorToException(res)
+        # Decode the encoding in place; the decoded values do not refer back to it.
+        view = self._getTLVBytesView(path)
+        try:
+            reader = TLVReader(view.buffer)
+            out = reader.get()
+        finally:
+            view.release()
 
-        reader = TLVReader(res)
-        out = reader.get()
         try :
             return out["Any"]
         except:
@@ -132,6 +185,50 @@ class GenericTraitUpdatableDataSink:
                 lambda: self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytes(self._traitInstance, path, cbHandleConstructBytesArray)
             )
 
+    def compilePath(self, path):
+        '''Resolve a property path once, for repeated use with getData() and setData().'''
+        self._ensureNotClosed()
+        compiledPath = c_void_p(None)
+        res = self._weaveStack.Call(
+            lambda: self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_CompilePath(self._traitInstance, path, byref(compiledPath))
+        )
+        if (res != 0):
+            raise self._weaveStack.ErrorToException(res)
+        return TraitPath(self, path, compiledPath)
+
+    def _compiledPathOf(self, traitPath):
+        if traitPath._dataSink is not self or traitPath._compiledPath == None:
+            raise ValueError("TraitPath was not compiled by this data sink, or has been released")
+        return traitPath._compiledPath
+
+    def _releaseTraitPath(self, compiledPath):
+        if self._weaveStack != None:
+            self._weaveStack.Call(
+                lambda: self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_ReleasePath(compiledPath)
+            )
+
+    def _getTLVBytesView(self, path):
+        bytesView = c_void_p(None)
+        dataBuf = c_void_p(None)
+        dataLen = c_uint32(0)
+        if isinstance(path, TraitPath):
+            compiledPath = self._compiledPathOf(path)
+            res = self._weaveStack.Call(
+                lambda: self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesViewByPath(self._traitInstance, compiledPath, byref(bytesView), byref(dataBuf), byref(dataLen))
+            )
+        else:
+            res = self._weaveStack.Call(
+                lambda: self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesView(self._traitInstance, path, byref(bytesView), byref(dataBuf), byref(dataLen))
+            )
+        if (res != 0):
+            raise self._weaveStack.ErrorToException(res)
+        return _TLVBytesView(self, bytesView, dataBuf, dataLen.value)
+
+    def _releaseTLVBytesView(self, bytesView):
+        self._weaveStack.Call(
+            lambda: self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_ReleaseBytesView(bytesView)
+        )
+
     def getVersion(self):
         self._ensureNotClosed()
         return self._weaveStack.Call(
@@ -160,6 +257,18 @@ class GenericTraitUpdatableDataSink:
             self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_SetTLVBytes.restype = c_uint32
             self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytes.argtypes = [ c_void_p, c_char_p, _ConstructBytesArrayFunct ]
             self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytes.restype = c_uint32
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesView.argtypes = [ c_void_p, c_char_p, POINTER(c_void_p), POINTER(c_void_p), POINTER(c_uint32) ]
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesView.restype = c_uint32
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_ReleaseBytesView.argtypes = [ c_void_p ]
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_ReleaseBytesView.restype = None
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_CompilePath.argtypes = [ c_void_p, c_char_p, POINTER(c_void_p) ]
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_CompilePath.restype = c_uint32
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_ReleasePath.argtypes = [ c_void_p ]
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_ReleasePath.restype = None
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_SetTLVBytesByPath.argtypes = [ c_void_p, c_void_p, c_void_p, c_uint32, c_bool ]
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_SetTLVBytesByPath.restype = c_uint32
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesViewByPath.argtypes = [ c_void_p, c_void_p, POINTER(c_void_p), POINTER(c_void_p), POINTER(c_uint32) ]
+            self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetTLVBytesViewByPath.restype = c_uint32
             self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetVersion.argtypes = [ c_void_p ]
             self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_GetVersion.restype = c_uint64
             self._generictraitupdatabledatasinkLib.nl_Weave_GenericTraitUpdatableDataSink_DeleteData.argtypes = [ c_void_p, c_char_p ]
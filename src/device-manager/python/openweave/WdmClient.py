@@ -147,7 +147,7 @@ class WdmClient():
                 print(statusResults[-1])
 
             self._weaveStack.callbackRes = statusResults
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandleComplete = _FlushUpdateCompleteFunct(HandleFlushUpdateComplete)
 
@@ -0,0 +1,178 @@
+#
+#    Copyright (c) 2020 Google LLC.
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+#    @file
+#      asyncio interface for the Weave Device Manager
+#
+
+"""asyncio interface for the Weave Device Manager
+
+Drives the openweave network I/O from an asyncio event loop, rather than from a
+dedicated network thread, and exposes the device manager operations as awaitables:
+
+    devMgr = AsyncWeaveDeviceManager()
+    await devMgr.ConnectDevice(deviceId, deviceAddr, pairingCode='...')
+    await devMgr.ArmFailSafe(...)
+
+Requires Python 3.5.2 or later.
+"""
+
+from __future__ import absolute_import
+import asyncio
+from ctypes import *
+from .WeaveStack import *
+from .WeaveDeviceMgr import WeaveDeviceManager
+
+__all__ = [ 'WeaveAsyncIODriver', 'AsyncWeaveDeviceManager' ]
+
+# Longest time to wait between services of the openweave library, in milliseconds.
+_MaxSleepTimeMS = 1000
+
+# Capacity of the file descriptor lists fetched from the openweave library.
+_MaxFDs = 64
+
+
+class WeaveAsyncIODriver(object):
+    '''Drives the openweave network I/O from an asyncio event loop.
+
+       The file descriptors the stack waits on are registered with the loop, and the stack
+       is serviced, without blocking, whenever one of them becomes ready or the next stack
+       timer expires.  All calls into the openweave library, and all awaits of the results,
+       must then be made on the thread running the loop.'''
+
+    def __init__(self, dmLib, loop=None):
+        self._dmLib = dmLib
+        self._weaveStack = WeaveStack()
+        self._loop = loop if loop != None else asyncio.get_event_loop()
+        self._readFDs = set()
+        self._writeFDs = set()
+        self._timer = None
+        self._serviceScheduled = False
+        self._running = False
+
+    @property
+    def loop(self):
+        return self._loop
+
+    def Start(self):
+        if self._running:
+            return
+        self._running = True
+        self._weaveStack.awaitableLoop = self._loop
+        self.Kick()
+
+    def Stop(self):
+        if not self._running:
+            return
+        self._running = False
+        self._weaveStack.awaitableLoop = None
+        self._UpdateFDs(set(), set())
+        if self._timer != None:
+            self._timer.cancel()
+            self._timer = None
+
+    def Kick(self):
+        '''Arrange for the stack to be serviced on the next pass of the loop.  Must be called
+           after any call that may have changed what the stack is waiting on.'''
+        if self._running and not self._serviceScheduled:
+            self._serviceScheduled = True
+            self._loop.call_soon(self._Service)
+
+    # ----- Private Members -----
+    def _Service(self):
+        self._serviceScheduled = False
+        if not self._running:
+            return
+        with self._weaveStack.networkLock:
+            self._dmLib.nl_Weave_DeviceManager_DriveIO(0)
+        self._Rearm()
+
+    def _Rearm(self):
+        readFDs = (c_int * _MaxFDs)()
+        writeFDs = (c_int * _MaxFDs)()
+        numReadFDs = c_uint32(_MaxFDs)
+        numWriteFDs = c_uint32(_MaxFDs)
+        sleepTimeMS = c_uint32(_MaxSleepTimeMS)
+        with self._weaveStack.networkLock:
+            res = self._dmLib.nl_Weave_DeviceManager_PrepareIO(readFDs, byref(numReadFDs), writeFDs, byref(numWriteFDs), byref(sleepTimeMS))
+        if (res != 0):
+            raise self._weaveStack.ErrorToException(res)
+
+        self._UpdateFDs(set(readFDs[:numReadFDs.value]), set(writeFDs[:numWriteFDs.value]))
+
+        if self._timer != None:
+            self._timer.cancel()
+        self._timer = self._loop.call_later(sleepTimeMS.value / 1000.0, self.Kick)
+
+    def _UpdateFDs(self, readFDs, writeFDs):
+        for fd in self._readFDs - readFDs:
+            self._loop.remove_reader(fd)
+        for fd in readFDs - self._readFDs:
+            self._loop.add_reader(fd, self.Kick)
+        for fd in self._writeFDs - writeFDs:
+            self._loop.remove_writer(fd)
+        for fd in writeFDs - self._writeFDs:
+            self._loop.add_writer(fd, self.Kick)
+        self._readFDs = readFDs
+        self._writeFDs = writeFDs
+
+
+class AsyncWeaveDeviceManager(object):
+    '''A WeaveDeviceManager whose network I/O is driven by an asyncio event loop.
+
+       Every method of WeaveDeviceManager is available.  Methods that start an operation on
+       the device return an awaitable for its result, instead of blocking until it completes;
+       the others return their result directly.  As with WeaveDeviceManager, only one
+       operation may be in progress at a time.'''
+
+    def __init__(self, loop=None):
+        self._devMgr = WeaveDeviceManager(startNetworkThread=False)
+        self._weaveStack = self._devMgr._weaveStack
+        self._ioDriver = WeaveAsyncIODriver(self._devMgr._dmLib, loop)
+        self._ioDriver.Start()
+
+    @property
+    def ioDriver(self):
+        return self._ioDriver
+
+    def Close(self):
+        self._devMgr.Close()
+        self._ioDriver.Kick()
+
+    def Shutdown(self):
+        self._ioDriver.Stop()
+
+    def __getattr__(self, name):
+        attr = getattr(self._devMgr, name)
+        if not callable(attr):
+            return attr
+
+        def call(*args, **kwargs):
+            # Operations started through WeaveStack.CallAsync() leave their future in
+            # completeFuture, whether or not the method returns it.
+            prevFuture = self._weaveStack.completeFuture
+            try:
+                res = attr(*args, **kwargs)
+            finally:
+                self._ioDriver.Kick()
+            future = self._weaveStack.completeFuture
+            if future is not prevFuture and future != None:
+                return future
+            return res
+
+        return call
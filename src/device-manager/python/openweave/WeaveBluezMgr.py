@@ -28,6 +28,7 @@ import dbus
 import dbus.service
 import dbus.mainloop.glib
 import gc
+import hashlib
 import logging
 import os
 import pprint
@@ -38,6 +39,7 @@ import time
 import traceback
 import uuid
 import six.moves.queue
+import struct
 
 
 from ctypes import *
@@ -487,6 +489,27 @@ class BluezDbusDevice():
             self.logger.debug(traceback.format_exc())
             return None
 
+    @property
+    def PeerKey(self):
+        """ Key identifying this peripheral across reconnects: its BLE address plus the Weave
+            service data it advertises, which carries its device id."""
+        weaveData = bytearray()
+        serviceData = self.ServiceData
+        if serviceData:
+            for svcUUID, value in dict(serviceData).items():
+                if uuid.UUID(str(svcUUID)) in [weave_service, weave_service_short]:
+                    weaveData = bytearray(value)
+        digest = hashlib.sha256(bytearray(str(self.Address).upper().encode('utf-8')) + weaveData).digest()
+        return struct.unpack('>Q', digest[:8])[0] or 1
+
+    def wait_services_resolved(self):
+        expired = time.time() + bleSeviceDiscoveryTimeoutSec
+        while time.time() < expired:
+            if self.ServicesResolved:
+                return True
+            time.sleep(bleIdleDelta)
+        return False
+
     @property
     def ServicesResolved(self):
         try:
@@ -681,6 +704,18 @@ class BluezDbusGattCharacteristic():
         except:
             self.logger.debug(traceback.format_exc())
 
+    @property
+    def MTU(self):
+        try:
+            result = self.characteristic_properties.Get(CHARACTERISTIC_INTERFACE, 'MTU')
+            return int(result)
+        except dbus.exceptions.DBusException as ex:
+            self.logger.debug(str(ex))
+            return 0
+        except:
+            self.logger.debug(traceback.format_exc())
+            return 0
+
     @property
     def Notifying(self):
         try:
@@ -721,6 +756,8 @@ class BluezManager(WeaveBleBase):
         self.connect_state = False
         self.tx = None
         self.rx = None
+        self.gatt_cache = {}
+        self.peer_key = 0
         self.setInputHook(self.readlineCB)
         self.devMgr = devMgr
         self.devMgr.SetBlockingCB(self.devMgrCB)
@@ -894,7 +931,35 @@ class BluezManager(WeaveBleBase):
         self.runLoopUntil(self.scan_bg_implementation, timeout=args[0], identifier=args[2])
         return True
 
+    def weaveServieCharCachedConnect(self):
+        # BlueZ keeps the object paths of a bonded or recently seen peripheral's GATT database,
+        # so on reconnect they only need checking, not discovering.
+        paths = self.gatt_cache.get(self.peer_key)
+        if paths is None or not self.target.wait_services_resolved():
+            return False
+        try:
+            service = BluezDbusGattService(self.bus.get_object(BLUEZ_NAME, paths[0]), self.bluez, self.bus, self.logger)
+            rx = BluezDbusGattCharacteristic(self.bus.get_object(BLUEZ_NAME, paths[1]), self.bluez, self.bus, self.logger)
+            tx = BluezDbusGattCharacteristic(self.bus.get_object(BLUEZ_NAME, paths[2]), self.bluez, self.bus, self.logger)
+        except dbus.exceptions.DBusException as ex:
+            self.logger.debug(str(ex))
+            del self.gatt_cache[self.peer_key]
+            return False
+        if service.uuid not in [weave_service, weave_service_short] or rx.uuid != weave_rx or tx.uuid != weave_tx:
+            self.logger.debug("cached weave service is stale")
+            del self.gatt_cache[self.peer_key]
+            return False
+        self.service = service
+        self.rx = rx
+        self.tx = tx
+        self.logger.info("weave service found in cache")
+        return True
+
     def weaveServieCharConnect(self):
+        self.peer_key = self.target.PeerKey
+        if self.weaveServieCharCachedConnect():
+            return True
+
         gatt_dic={'services': [weave_service, weave_service_short], 'chars': [weave_tx, weave_rx]}
         self.service = self.target.service_discover(gatt_dic)
         if self.service is None:
@@ -912,6 +977,7 @@ class BluezManager(WeaveBleBase):
             self.connect_state = False
             return False
 
+        self.gatt_cache[self.peer_key] = (self.service.path, self.rx.path, self.tx.path)
         return True
 
     def connect_bg_implementation(self, **kwargs):
@@ -924,11 +990,26 @@ class BluezManager(WeaveBleBase):
         if self.weaveServieCharConnect():
             self.logger.info("connect success")
             self.connect_state = True
+            if self.devMgr:
+                self.devMgr.SetBlePeerKey(self.peer_key)
+            self.attach_native_data_path()
         else:
             self.logger.info("connect fail")
             self.connect_state = False
 
+    def attach_native_data_path(self):
+        # Weave traffic is carried by the device manager library itself when it has BlueZ support;
+        # Python then only drives scanning, connection and GATT discovery.
+        if self.devMgr and self.devMgr.HasNativeBluez():
+            try:
+                self.devMgr.AttachBluezConnection(FAKE_CONN_OBJ_VALUE, self.target.path, self.tx.path, self.rx.path, self.tx.MTU)
+                self.logger.debug("weave data path attached to native bluez delegate")
+            except:
+                self.logger.debug(traceback.format_exc())
+
     def disconnect_bg_implementation(self, **kwargs):
+        if self.devMgr and self.devMgr.HasNativeBluez():
+            self.devMgr.DetachBluezConnection(FAKE_CONN_OBJ_VALUE)
         if self.target:
             self.target.device_bg_connect(False)
         if self.tx:
@@ -449,10 +449,16 @@ def _singleton(cls):
 
 @_singleton
 class WeaveDeviceManager(object):
+    # The thread driving network IO for the openweave library, shared by all device managers
+    # in the process, and the number of device managers using it.
+    _networkThread = None
+    _networkThreadRunable = False
+    _networkThreadUsers = 0
+    _networkThreadLock = Lock()
+
     def __init__(self, startNetworkThread=True):
         self.devMgr = None
         self.networkThread = None
-        self.networkThreadRunable = False
         self._weaveStack = WeaveStack()
         self._dmLib = None
 
@@ -513,27 +519,65 @@ class WeaveDeviceManager(object):
             self.cbHandleBleClose = _CloseBleFunct(bleCloseCB)
             self._dmLib.nl_Weave_DeviceManager_SetBleClose(self.cbHandleBleClose)
 
+    def SetBlePeerKey(self, peerKey):
+        # identifies the connected peripheral to the Weave BLE layer, which then abbreviates repeat handshakes
+        res = self._dmLib.nl_Weave_DeviceManager_SetBlePeerKey(peerKey)
+        if (res != 0):
+            raise self._weaveStack.ErrorToException(res)
+
+    def HasNativeBluez(self):
+        return hasattr(self._dmLib, 'nl_Weave_DeviceManager_AttachBluezConnection')
+
+    def AttachBluezConnection(self, connObj, devicePath, writeCharPath, indicateCharPath, mtu=0):
+        # hand the WoBLE data path of a connected peripheral to the native BlueZ delegate
+        res = self._dmLib.nl_Weave_DeviceManager_AttachBluezConnection(connObj,
+                                                                       WeaveUtility.StringToCString(devicePath),
+                                                                       WeaveUtility.StringToCString(writeCharPath),
+                                                                       WeaveUtility.StringToCString(indicateCharPath),
+                                                                       mtu)
+        if (res != 0):
+            raise self._weaveStack.ErrorToException(res)
+
+    def DetachBluezConnection(self, connObj):
+        res = self._dmLib.nl_Weave_DeviceManager_DetachBluezConnection(connObj)
+        if (res != 0):
+            raise self._weaveStack.ErrorToException(res)
+
     def StartNetworkThread(self):
         if (self.networkThread != None):
             return
 
-        def RunNetworkThread():
-            while (self.networkThreadRunable):
-                self._weaveStack.networkLock.acquire()
-                self._dmLib.nl_Weave_DeviceManager_DriveIO(50)
-                self._weaveStack.networkLock.release()
-                time.sleep(0.005)
+        with WeaveDeviceManager._networkThreadLock:
+            cls = WeaveDeviceManager
+            if (cls._networkThread == None):
+                weaveStack = self._weaveStack
+                dmLib = self._dmLib
+
+                def RunNetworkThread():
+                    while (cls._networkThreadRunable):
+                        weaveStack.networkLock.acquire()
+                        dmLib.nl_Weave_DeviceManager_DriveIO(50)
+                        weaveStack.networkLock.release()
+                        time.sleep(0.005)
+
+                cls._networkThread = Thread(target=RunNetworkThread, name="WeaveNetworkThread")
+                cls._networkThread.daemon = True
+                cls._networkThreadRunable = True
+                cls._networkThread.start()
 
-        self.networkThread = Thread(target=RunNetworkThread, name="WeaveNetworkThread")
-        self.networkThread.daemon = True
-        self.networkThreadRunable = True
-        self.networkThread.start()
+            cls._networkThreadUsers += 1
+            self.networkThread = cls._networkThread
 
     def StopNetworkThread(self):
         if (self.networkThread != None):
-            self.networkThreadRunable = False
-            self.networkThread.join()
-            self.networkThread = None
+            with WeaveDeviceManager._networkThreadLock:
+                cls = WeaveDeviceManager
+                self.networkThread = None
+                cls._networkThreadUsers -= 1
+                if (cls._networkThreadUsers == 0):
+                    cls._networkThreadRunable = False
+                    cls._networkThread.join()
+                    cls._networkThread = None
 
     def IsConnected(self):
         return self._weaveStack.Call(
@@ -570,6 +614,16 @@ class WeaveDeviceManager(object):
         if (res != 0):
             raise self._weaveStack.ErrorToException(res)
 
+    def SetIdleConnectionTimeout(self, timeoutMS):
+        if timeoutMS < 0 or timeoutMS > pow(2,32):
+            raise ValueError("timeoutMS must be an unsigned 32-bit integer")
+
+        res = self._weaveStack.Call(
+            lambda: self._dmLib.nl_Weave_DeviceManager_SetIdleConnectionTimeout(self.devMgr, timeoutMS)
+        )
+        if (res != 0):
+            raise self._weaveStack.ErrorToException(res)
+
     def SetAutoReconnect(self, autoReconnect):
         res = self._weaveStack.Call(
             lambda: self._dmLib.nl_Weave_DeviceManager_SetAutoReconnect(self.devMgr, autoReconnect)
@@ -786,7 +840,7 @@ class WeaveDeviceManager(object):
     def IdentifyDevice(self):
         def HandleIdentifyDeviceComplete(devMgr, reqState, deviceDescPtr):
             self._weaveStack.callbackRes = deviceDescPtr.contents.toDeviceDescriptor()
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandleIdentifyDeviceComplete = _IdentifyDeviceCompleteFunct(HandleIdentifyDeviceComplete)
 
@@ -797,7 +851,7 @@ class WeaveDeviceManager(object):
     def PairToken(self, pairingToken):
         def HandlePairTokenComplete(devMgr, reqState, tokenPairingBundlePtr, tokenPairingBundleLen):
             self._weaveStack.callbackRes = WeaveUtility.VoidPtrToByteArray(tokenPairingBundlePtr, tokenPairingBundleLen)
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandlePairTokenComplete = _PairTokenCompleteFunct(HandlePairTokenComplete)
 
@@ -811,7 +865,7 @@ class WeaveDeviceManager(object):
     def UnpairToken(self):
         def HandleUnpairTokenComplete(devMgr, reqState):
             self._weaveStack.callbackRes = True
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandleUnpairTokenComplete = _UnpairTokenCompleteFunct(HandleUnpairTokenComplete)
 
@@ -822,7 +876,7 @@ class WeaveDeviceManager(object):
     def ScanNetworks(self, networkType):
         def HandleScanNetworksComplete(devMgr, reqState, netCount, netInfoPtr):
             self._weaveStack.callbackRes = [ netInfoPtr[i].toNetworkInfo() for i in range(netCount) ]
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandleScanNetworksComplete = _NetworkScanCompleteFunct(HandleScanNetworksComplete)
 
@@ -833,7 +887,7 @@ class WeaveDeviceManager(object):
     def GetNetworks(self, getFlags):
         def HandleGetNetworksComplete(devMgr, reqState, netCount, netInfoPtr):
             self._weaveStack.callbackRes = [ netInfoPtr[i].toNetworkInfo() for i in range(netCount) ]
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandleGetNetworksComplete = _GetNetworksCompleteFunct(HandleGetNetworksComplete)
 
@@ -846,8 +900,8 @@ class WeaveDeviceManager(object):
             raise ValueError("Unexpected NUL character in nonce")
 
         def HandleGetCameraAuthDataComplete(devMgr, reqState, macAddress, signedCameraPayload):
-            self.callbackRes = [ WeaveUtility.CStringToString(macAddress), WeaveUtility.CStringToString(signedCameraPayload) ]
-            self.completeEvent.set()
+            self._weaveStack.callbackRes = [ WeaveUtility.CStringToString(macAddress), WeaveUtility.CStringToString(signedCameraPayload) ]
+            self._weaveStack.NotifyComplete()
 
         cbHandleGetCameraAuthDataComplete = _GetCameraAuthDataCompleteFunct(HandleGetCameraAuthDataComplete)
 
@@ -858,7 +912,7 @@ class WeaveDeviceManager(object):
     def AddNetwork(self, networkInfo):
         def HandleAddNetworkComplete(devMgr, reqState, networkId):
             self._weaveStack.callbackRes = networkId
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandleAddNetworkComplete = _AddNetworkCompleteFunct(HandleAddNetworkComplete)
 
@@ -911,7 +965,7 @@ class WeaveDeviceManager(object):
     def GetRendezvousMode(self):
         def HandleGetRendezvousModeComplete(devMgr, reqState, modeFlags):
             self._weaveStack.callbackRes = modeFlags
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandleGetRendezvousModeComplete = _GetRendezvousModeCompleteFunct(HandleGetRendezvousModeComplete)
 
@@ -930,7 +984,7 @@ class WeaveDeviceManager(object):
     def GetWirelessRegulatoryConfig(self):
         def HandleComplete(devMgr, reqState, regConfigPtr):
             self._weaveStack.callbackRes = regConfigPtr[0].toWirelessRegConfig()
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandleComplete = _GetWirelessRegulatoryConfigCompleteFunct(HandleComplete)
 
@@ -962,7 +1016,7 @@ class WeaveDeviceManager(object):
     def GetFabricConfig(self):
         def HandleGetFabricConfigComplete(devMgr, reqState, fabricConfigPtr, fabricConfigLen):
             self._weaveStack.callbackRes = WeaveUtility.VoidPtrToByteArray(fabricConfigPtr, fabricConfigLen)
-            self._weaveStack.completeEvent.set()
+            self._weaveStack.NotifyComplete()
 
         cbHandleGetFabricConfigComplete = _GetFabricConfigCompleteFunct(HandleGetFabricConfigComplete)
 
@@ -1089,6 +1143,9 @@ class WeaveDeviceManager(object):
             self._dmLib.nl_Weave_DeviceManager_DriveIO.argtypes = [ c_uint32 ]
             self._dmLib.nl_Weave_DeviceManager_DriveIO.restype = c_uint32
 
+            self._dmLib.nl_Weave_DeviceManager_PrepareIO.argtypes = [ POINTER(c_int), POINTER(c_uint32), POINTER(c_int), POINTER(c_uint32), POINTER(c_uint32) ]
+            self._dmLib.nl_Weave_DeviceManager_PrepareIO.restype = c_uint32
+
             self._dmLib.nl_Weave_DeviceManager_WakeForBleIO.argtypes = [ ]
             self._dmLib.nl_Weave_DeviceManager_WakeForBleIO.restype = c_uint32
 
@@ -1104,6 +1161,16 @@ class WeaveDeviceManager(object):
             self._dmLib.nl_Weave_DeviceManager_SetBleClose.argtypes = [ _CloseBleFunct ]
             self._dmLib.nl_Weave_DeviceManager_SetBleClose.restype = c_uint32
 
+            self._dmLib.nl_Weave_DeviceManager_SetBlePeerKey.argtypes = [ c_uint64 ]
+            self._dmLib.nl_Weave_DeviceManager_SetBlePeerKey.restype = c_uint32
+
+            if hasattr(self._dmLib, 'nl_Weave_DeviceManager_AttachBluezConnection'):
+                self._dmLib.nl_Weave_DeviceManager_AttachBluezConnection.argtypes = [ c_void_p, c_char_p, c_char_p, c_char_p, c_uint16 ]
+                self._dmLib.nl_Weave_DeviceManager_AttachBluezConnection.restype = c_uint32
+
+                self._dmLib.nl_Weave_DeviceManager_DetachBluezConnection.argtypes = [ c_void_p ]
+                self._dmLib.nl_Weave_DeviceManager_DetachBluezConnection.restype = c_uint32
+
             self._dmLib.nl_Weave_DeviceManager_IsConnected.argtypes = [ c_void_p ]
             self._dmLib.nl_Weave_DeviceManager_IsConnected.restype = c_bool
 
@@ -1257,6 +1324,9 @@ class WeaveDeviceManager(object):
             self._dmLib.nl_Weave_DeviceManager_SetConnectTimeout.argtypes = [ c_void_p, c_uint32 ]
             self._dmLib.nl_Weave_DeviceManager_SetConnectTimeout.restype = c_uint32
 
+            self._dmLib.nl_Weave_DeviceManager_SetIdleConnectionTimeout.argtypes = [ c_void_p, c_uint32 ]
+            self._dmLib.nl_Weave_DeviceManager_SetIdleConnectionTimeout.restype = c_uint32
+
             self._dmLib.nl_Weave_DeviceManager_SetAutoReconnect.argtypes = [ c_void_p, c_bool ]
             self._dmLib.nl_Weave_DeviceManager_SetAutoReconnect.restype = c_uint32
 
@@ -146,13 +146,20 @@ _LogMessageFunct                            = CFUNCTYPE(None, c_int64, c_int64,
 
 @_singleton
 class WeaveStack(object):
+    # All WeaveStack objects drive the same openweave library state, and so must serialize
+    # their calls into it with the same lock.  Completion state is kept per object, so that
+    # several device managers can each have an operation in progress.
+    _networkLock = Lock()
+
     def __init__(self, installDefaultLogHandler=True):
-        self.networkLock = Lock()
+        self.networkLock = WeaveStack._networkLock
         self.completeEvent = Event()
         self._weaveStackLib = None
         self._weaveDLLPath = None
         self.devMgr = None
         self.callbackRes = None
+        self.completeFuture = None
+        self.awaitableLoop = None
         self._activeLogFunct = None
         self.addModulePrefixToLogMessage = True
 
@@ -205,11 +212,11 @@ class WeaveStack(object):
 
         def HandleComplete(appState, reqState):
             self.callbackRes = True
-            self.completeEvent.set()
+            self.NotifyComplete()
 
         def HandleError(appState, reqState, err, devStatusPtr):
             self.callbackRes = self.ErrorToException(err, devStatusPtr)
-            self.completeEvent.set()
+            self.NotifyComplete()
 
         self.cbHandleComplete = _CompleteFunct(HandleComplete)
         self.cbHandleError = _ErrorFunct(HandleError)
@@ -283,6 +290,10 @@ class WeaveStack(object):
         return res
 
     def CallAsync(self, callFunct):
+        # When driven from an asyncio event loop, return an awaitable rather than blocking.
+        if self.awaitableLoop != None:
+            return self.CallAwaitable(callFunct, self.awaitableLoop)
+
         # throw error if op in progress
         self.callbackRes = None
         self.completeEvent.clear()
@@ -301,6 +312,25 @@ class WeaveStack(object):
             raise self.callbackRes
         return self.callbackRes
     
+    def CallAwaitable(self, callFunct, loop):
+        '''Start an asynchronous operation and return an asyncio future for its result.
+           Must be called on the thread running loop, and the openweave network I/O must
+           be driven by that loop (see openweave.WeaveAsync), as the future is completed
+           from the openweave callbacks.'''
+        if self.completeFuture != None and not self.completeFuture.done():
+            raise WeaveStackException('An asynchronous operation is already in progress')
+        # The operation may fail synchronously through its error callback, so the future
+        # must be in place before it is started.
+        self.callbackRes = None
+        self.completeFuture = loop.create_future()
+        future = self.completeFuture
+        with self.networkLock:
+            res = callFunct()
+        if (res != 0):
+            self.completeFuture = None
+            raise self.ErrorToException(res)
+        return future
+
     def ErrorToException(self, err, devStatusPtr=None):
         if (err == 4044 and devStatusPtr):
             devStatus = devStatusPtr.contents
@@ -341,7 +371,19 @@ class WeaveStack(object):
 
         raise Exception("Unable to locate Weave Device Manager DLL (%s); expected location: %s" % (WeaveStackDLLBaseName, scriptDir))
 
+    def NotifyComplete(self):
+        '''Signal the completion of the operation in progress, whose result has been stored
+           in self.callbackRes.  Called from the openweave completion callbacks.'''
+        self.completeEvent.set()
+        future = self.completeFuture
+        if future != None and not future.done():
+            if (isinstance(self.callbackRes, WeaveStackException)):
+                future.set_exception(self.callbackRes)
+            else:
+                future.set_result(self.callbackRes)
+
     # ----- Private Members -----
+
     def _AllDirsToRoot(self, dir):
         dir = os.path.abspath(dir)
         while True:
@@ -549,7 +549,7 @@ class TLVReader(object):
     def _get(self, tlv, decodings, out):
         endOfEncoding = False
 
-        while len(tlv[self._bytesRead:]) > 0 and endOfEncoding == False:
+        while self._bytesRead < len(tlv) and endOfEncoding == False:
             decoding = {}
             self._decodeControlAndTag(tlv, decoding)
             self._decodeStrLength(tlv, decoding)
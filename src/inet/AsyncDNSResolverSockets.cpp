@@ -37,6 +37,11 @@
 namespace nl {
 namespace Inet {
 
+AsyncDNSResolverSockets::AsyncDNSResolverSockets(void) :
+    mNumThreads(INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT)
+{
+}
+
 /**
  *  The explicit initializer for the AsynchronousDNSResolverSockets class.
  *  This initializes the mutex and semaphore variables and creates the
@@ -58,6 +63,18 @@ INET_ERROR AsyncDNSResolverSockets::Init(InetLayer *aInet)
     mAsyncDNSQueueHead = NULL;
     mAsyncDNSQueueTail = NULL;
 
+    memset(&mQueueStats, 0, sizeof(mQueueStats));
+
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    for (int i = 0; i < INET_CONFIG_DNS_CACHE_SIZE; i++)
+    {
+        mCache[i].state = kCacheEntry_Unused;
+        mCache[i].waiters = NULL;
+    }
+
+    memset(&mCacheStats, 0, sizeof(mCacheStats));
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
     pthreadErr = pthread_cond_init(&mAsyncDNSCondVar, NULL);
     VerifyOrDie(pthreadErr == 0);
 
@@ -65,7 +82,7 @@ INET_ERROR AsyncDNSResolverSockets::Init(InetLayer *aInet)
     VerifyOrDie(pthreadErr == 0);
 
     // Create the thread pool for asynchronous DNS resolution.
-    for (int i = 0; i < INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT; i++)
+    for (int i = 0; i < mNumThreads; i++)
     {
         pthreadErr = pthread_create(&mAsyncDNSThreadHandle[i], NULL, &AsyncDNSThreadRun, this);
         VerifyOrDie(pthreadErr == 0);
@@ -97,12 +114,15 @@ INET_ERROR AsyncDNSResolverSockets::Shutdown(void)
     AsyncMutexUnlock();
 
     // Have the Weave thread join the thread pool for asynchronous DNS resolution.
-    for (int i = 0; i < INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT; i++)
+    for (int i = 0; i < mNumThreads; i++)
     {
         pthreadErr = pthread_join(mAsyncDNSThreadHandle[i], NULL);
         VerifyOrDie(pthreadErr == 0);
     }
 
+    // A thread count passed to InetLayer::Init() applies to that initialization only.
+    mNumThreads = INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT;
+
     pthreadErr = pthread_mutex_destroy(&mAsyncDNSMutex);
     VerifyOrDie(pthreadErr == 0);
 
@@ -159,6 +179,10 @@ INET_ERROR AsyncDNSResolverSockets::PrepareDNSResolver(DNSResolver &resolver, co
 /**
  *  Enqueue a DNSResolver object for asynchronous IP address resolution of a specified hostname.
  *
+ *  If the result for the host name is cached, the request completes from the cache; if
+ *  a lookup for the same host name is already in progress, the request is attached to it.
+ *  Either way, the completion is delivered on the Weave thread as for a fresh lookup.
+ *
  *  @param[in]  resolver    A reference to the DNSResolver object.
  *
  *  @retval #INET_NO_ERROR                   if a DNS request is queued
@@ -172,9 +196,74 @@ INET_ERROR AsyncDNSResolverSockets::EnqueueRequest(DNSResolver &resolver)
 {
     INET_ERROR err = INET_NO_ERROR;
     int pthreadErr;
+    uint64_t now = Weave::System::Layer::GetClock_MonotonicMS();
+
+    resolver.asyncEnqueueTimeMS = now;
+
+#if INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
+    resolver.SystemLayer().StartTimer(INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS, HandleResolveTimeout, &resolver);
+#endif // INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
 
     AsyncMutexLock();
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    {
+        struct addrinfo gaiHints;
+        CacheEntry *entry;
+
+        resolver.InitAddrInfoHints(gaiHints);
+
+        entry = LookupCacheEntry(resolver.asyncHostNameBuf, gaiHints.ai_family);
+
+        if (entry != NULL && entry->state == kCacheEntry_Valid && now >= entry->expiryTimeMS)
+        {
+            entry->state = kCacheEntry_Unused;
+            entry = NULL;
+        }
+
+        if (entry != NULL && entry->state == kCacheEntry_Valid)
+        {
+            resolver.asyncDNSResolveResult = resolver.ProcessCachedResult(entry->result, entry->addrs, entry->numAddrs);
+            resolver.mState = DNSResolver::kState_Complete;
+
+            if (entry->result == INET_NO_ERROR)
+                mCacheStats.Hits++;
+            else
+                mCacheStats.NegativeHits++;
+
+            AsyncMutexUnlock();
+
+            NotifyWeaveThread(&resolver);
+            ExitNow();
+        }
+
+        if (entry != NULL)
+        {
+            resolver.pNextAsyncDNSResolver = entry->waiters;
+            entry->waiters = &resolver;
+            mCacheStats.Coalesced++;
+
+            AsyncMutexUnlock();
+            ExitNow();
+        }
+
+        mCacheStats.Misses++;
+
+        // Claim an entry so that identical requests arriving before this lookup
+        // completes are coalesced onto it.  If every entry is pending, the lookup
+        // simply goes uncached.
+        entry = AllocCacheEntry(now);
+        if (entry != NULL)
+        {
+            memcpy(entry->hostName, resolver.asyncHostNameBuf, sizeof(entry->hostName));
+            entry->addrFamily = gaiHints.ai_family;
+            entry->waiters = NULL;
+            entry->numAddrs = 0;
+            entry->state = kCacheEntry_Pending;
+        }
+    }
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
     // Add the DNSResolver object to the queue.
     if (mAsyncDNSQueueHead == NULL)
     {
@@ -188,11 +277,19 @@ INET_ERROR AsyncDNSResolverSockets::EnqueueRequest(DNSResolver &resolver)
 
     mAsyncDNSQueueTail = &resolver;
 
+    if (++mQueueStats.QueueDepth > mQueueStats.MaxQueueDepth)
+    {
+        mQueueStats.MaxQueueDepth = mQueueStats.QueueDepth;
+    }
+
     pthreadErr = pthread_cond_signal(&mAsyncDNSCondVar);
     VerifyOrDie(pthreadErr == 0);
 
     AsyncMutexUnlock();
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+exit:
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
     return err;
 }
 
@@ -225,6 +322,8 @@ INET_ERROR AsyncDNSResolverSockets::DequeueRequest(DNSResolver **outResolver)
     }
     else
     {
+        uint64_t queueTimeMS;
+
         *outResolver = const_cast<DNSResolver *>(mAsyncDNSQueueHead);
 
         mAsyncDNSQueueHead = mAsyncDNSQueueHead->pNextAsyncDNSResolver;
@@ -234,6 +333,16 @@ INET_ERROR AsyncDNSResolverSockets::DequeueRequest(DNSResolver **outResolver)
             // Queue is empty
             mAsyncDNSQueueTail = NULL;
         }
+
+        queueTimeMS = Weave::System::Layer::GetClock_MonotonicMS() - (*outResolver)->asyncEnqueueTimeMS;
+
+        mQueueStats.QueueDepth--;
+        mQueueStats.Dequeued++;
+        mQueueStats.TotalQueueTimeMS += queueTimeMS;
+        if (queueTimeMS > mQueueStats.MaxQueueTimeMS)
+        {
+            mQueueStats.MaxQueueTimeMS = static_cast<uint32_t>(queueTimeMS);
+        }
     }
 
     AsyncMutexUnlock();
@@ -244,21 +353,168 @@ INET_ERROR AsyncDNSResolverSockets::DequeueRequest(DNSResolver **outResolver)
 /**
  *  Cancel an outstanding DNS query that may still be active.
  *
+ *  A request that has not yet been picked up by a worker thread is withdrawn
+ *  and released at once, so it neither occupies a worker nor holds its
+ *  DNSResolver object behind slower lookups.  A request whose lookup is in
+ *  progress is released when that lookup completes.
+ *
  *  @param[in]    resolver   A reference to the DNSResolver object.
  */
 INET_ERROR AsyncDNSResolverSockets::Cancel(DNSResolver &resolver)
 {
     INET_ERROR err = INET_NO_ERROR;
+    bool withdrawn;
+
+#if INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
+    resolver.SystemLayer().CancelTimer(HandleResolveTimeout, &resolver);
+#endif // INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
 
     AsyncMutexLock();
 
     resolver.mState = DNSResolver::kState_Canceled;
 
+    withdrawn = WithdrawRequest(resolver);
+
     AsyncMutexUnlock();
 
+    if (withdrawn)
+    {
+        resolver.Release();
+    }
+
     return err;
 }
 
+/* Remove a request that no worker has picked up from the queue, or from the cache entry
+ * it was coalesced onto. A queued request that other requests are coalesced onto stays
+ * queued, as its lookup is still needed. Called with the mutex held. */
+bool AsyncDNSResolverSockets::WithdrawRequest(DNSResolver &resolver)
+{
+    DNSResolver *prev = NULL;
+
+    for (DNSResolver *cur = const_cast<DNSResolver *>(mAsyncDNSQueueHead); cur != NULL; prev = cur, cur = cur->pNextAsyncDNSResolver)
+    {
+        if (cur != &resolver)
+        {
+            continue;
+        }
+
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+        {
+            struct addrinfo gaiHints;
+            CacheEntry *entry;
+
+            resolver.InitAddrInfoHints(gaiHints);
+
+            entry = LookupCacheEntry(resolver.asyncHostNameBuf, gaiHints.ai_family);
+            if (entry != NULL && entry->state == kCacheEntry_Pending)
+            {
+                if (entry->waiters != NULL)
+                {
+                    return false;
+                }
+
+                entry->state = kCacheEntry_Unused;
+            }
+        }
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
+        if (prev == NULL)
+        {
+            mAsyncDNSQueueHead = cur->pNextAsyncDNSResolver;
+        }
+        else
+        {
+            prev->pNextAsyncDNSResolver = cur->pNextAsyncDNSResolver;
+        }
+
+        if (mAsyncDNSQueueTail == cur)
+        {
+            mAsyncDNSQueueTail = prev;
+        }
+
+        mQueueStats.QueueDepth--;
+        mQueueStats.Withdrawn++;
+
+        return true;
+    }
+
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    for (int i = 0; i < INET_CONFIG_DNS_CACHE_SIZE; i++)
+    {
+        if (mCache[i].state != kCacheEntry_Pending)
+        {
+            continue;
+        }
+
+        for (DNSResolver **link = &mCache[i].waiters; *link != NULL; link = &(*link)->pNextAsyncDNSResolver)
+        {
+            if (*link == &resolver)
+            {
+                *link = resolver.pNextAsyncDNSResolver;
+                mQueueStats.Withdrawn++;
+                return true;
+            }
+        }
+    }
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
+    return false;
+}
+
+#if INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
+/* Timer handler that fails a request which has not completed within
+ * INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS. */
+void AsyncDNSResolverSockets::HandleResolveTimeout(Weave::System::Layer* aLayer, void* aAppState, Weave::System::Error aError)
+{
+    DNSResolver *resolver = static_cast<DNSResolver *>(aAppState);
+    AsyncDNSResolverSockets &asyncResolver = resolver->Layer().mAsyncDNSResolver;
+    DNSResolver::OnResolveCompleteFunct onComplete = resolver->OnComplete;
+    void *appState = resolver->AppState;
+    IPAddress *addrArray = resolver->AddrArray;
+    bool complete;
+
+    VerifyOrExit(onComplete != NULL, );
+
+    asyncResolver.AsyncMutexLock();
+
+    // If the result is already on its way to the Weave thread, let it be delivered.
+    complete = (resolver->mState == DNSResolver::kState_Complete);
+    if (!complete)
+    {
+        asyncResolver.mQueueStats.TimedOut++;
+    }
+
+    asyncResolver.AsyncMutexUnlock();
+
+    VerifyOrExit(!complete, );
+
+    WeaveLogDetail(Inet, "Async DNS request for %s timed out", resolver->asyncHostNameBuf);
+
+    // Canceling may release the resolver, so nothing below may touch it.
+    resolver->Cancel();
+
+    onComplete(appState, INET_ERROR_DNS_TRY_AGAIN, 0, addrArray);
+
+exit:
+    return;
+}
+#endif // INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
+
+/**
+ *  Get the counters describing the request queue and lookup latency.
+ *
+ *  @param[out]   outStats   The counters accumulated since Init().
+ */
+void AsyncDNSResolverSockets::GetQueueStats(DNSQueueStats &outStats)
+{
+    AsyncMutexLock();
+
+    outStats = mQueueStats;
+
+    AsyncMutexUnlock();
+}
+
 void AsyncDNSResolverSockets::UpdateDNSResult(DNSResolver &resolver, struct addrinfo *inLookupRes)
 {
     resolver.NumAddrs = 0;
@@ -269,31 +525,224 @@ void AsyncDNSResolverSockets::UpdateDNSResult(DNSResolver &resolver, struct addr
     }
 }
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+
+/**
+ *  Get the counters describing how resolution requests have been satisfied.
+ *
+ *  @param[out]   outStats   The counters accumulated since Init().
+ */
+void AsyncDNSResolverSockets::GetCacheStats(DNSCacheStats &outStats)
+{
+    AsyncMutexLock();
+
+    outStats = mCacheStats;
+
+    AsyncMutexUnlock();
+}
+
+/* Find the pending or valid cache entry for a host name. Called with the mutex held. */
+AsyncDNSResolverSockets::CacheEntry *AsyncDNSResolverSockets::LookupCacheEntry(const char *hostName, int addrFamily)
+{
+    for (int i = 0; i < INET_CONFIG_DNS_CACHE_SIZE; i++)
+    {
+        CacheEntry &entry = mCache[i];
+
+        if (entry.state != kCacheEntry_Unused && entry.addrFamily == addrFamily && strcmp(entry.hostName, hostName) == 0)
+        {
+            return &entry;
+        }
+    }
+
+    return NULL;
+}
+
+/* Pick an entry to hold a new lookup: an unused one, else the valid one closest to
+ * expiry. Pending entries are never evicted. Called with the mutex held. */
+AsyncDNSResolverSockets::CacheEntry *AsyncDNSResolverSockets::AllocCacheEntry(uint64_t now)
+{
+    CacheEntry *victim = NULL;
+
+    for (int i = 0; i < INET_CONFIG_DNS_CACHE_SIZE; i++)
+    {
+        CacheEntry &entry = mCache[i];
+
+        if (entry.state == kCacheEntry_Unused)
+        {
+            return &entry;
+        }
+
+        if (entry.state == kCacheEntry_Valid && (victim == NULL || entry.expiryTimeMS < victim->expiryTimeMS))
+        {
+            victim = &entry;
+        }
+    }
+
+    return victim;
+}
+
+/* Record the outcome of a lookup in its cache entry and complete any requests that were
+ * coalesced onto it. Returns the list of those requests, which the caller must notify
+ * once the mutex is released. Called with the mutex held. */
+DNSResolver *AsyncDNSResolverSockets::CompleteCacheEntry(DNSResolver &resolver, int gaiReturnCode, struct addrinfo *gaiResults)
+{
+    struct addrinfo gaiHints;
+    CacheEntry *entry;
+    DNSResolver *waiters = NULL;
+
+    resolver.InitAddrInfoHints(gaiHints);
+
+    entry = LookupCacheEntry(resolver.asyncHostNameBuf, gaiHints.ai_family);
+    VerifyOrExit(entry != NULL && entry->state == kCacheEntry_Pending, );
+
+    entry->result = (gaiReturnCode == 0) ? INET_NO_ERROR : DNSResolver::MapGetAddrInfoError(gaiReturnCode);
+    entry->numAddrs = 0;
+
+    for (struct addrinfo *addr = gaiResults; addr != NULL && entry->numAddrs < INET_CONFIG_DNS_CACHE_MAX_ADDRS; addr = addr->ai_next)
+    {
+        if (addr->ai_addr->sa_family == AF_INET6
+#if INET_CONFIG_ENABLE_IPV4
+            || addr->ai_addr->sa_family == AF_INET
+#endif // INET_CONFIG_ENABLE_IPV4
+            )
+        {
+            entry->addrs[entry->numAddrs++] = IPAddress::FromSockAddr(*addr->ai_addr);
+        }
+    }
+
+    waiters = entry->waiters;
+    entry->waiters = NULL;
+
+    for (DNSResolver *waiter = waiters; waiter != NULL; waiter = waiter->pNextAsyncDNSResolver)
+    {
+        if (waiter->mState != DNSResolver::kState_Canceled)
+        {
+            waiter->asyncDNSResolveResult = waiter->ProcessCachedResult(entry->result, entry->addrs, entry->numAddrs);
+            waiter->mState = DNSResolver::kState_Complete;
+        }
+    }
+
+    // Only definitive answers are cached; transient failures are retried by the next request.
+    if (entry->result == INET_NO_ERROR)
+    {
+        entry->expiryTimeMS = Weave::System::Layer::GetClock_MonotonicMS() + INET_CONFIG_DNS_CACHE_TTL_MS;
+        entry->state = kCacheEntry_Valid;
+    }
+    else if (entry->result == INET_ERROR_HOST_NOT_FOUND)
+    {
+        entry->expiryTimeMS = Weave::System::Layer::GetClock_MonotonicMS() + INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS;
+        entry->state = kCacheEntry_Valid;
+    }
+    else
+    {
+        entry->state = kCacheEntry_Unused;
+    }
+
+exit:
+    return waiters;
+}
+
+/* Decide whether a dequeued request still needs a lookup. A canceled request is still
+ * resolved on behalf of any requests coalesced onto it; otherwise its pending cache
+ * entry is discarded. */
+bool AsyncDNSResolverSockets::IsLookupNeeded(DNSResolver &resolver)
+{
+    struct addrinfo gaiHints;
+    CacheEntry *entry;
+    bool needed = true;
+
+    AsyncMutexLock();
+
+    if (resolver.mState == DNSResolver::kState_Canceled)
+    {
+        resolver.InitAddrInfoHints(gaiHints);
+
+        entry = LookupCacheEntry(resolver.asyncHostNameBuf, gaiHints.ai_family);
+        if (entry != NULL && entry->state == kCacheEntry_Pending && entry->waiters != NULL)
+        {
+            needed = true;
+        }
+        else
+        {
+            if (entry != NULL && entry->state == kCacheEntry_Pending)
+            {
+                entry->state = kCacheEntry_Unused;
+            }
+
+            needed = false;
+        }
+    }
+
+    AsyncMutexUnlock();
+
+    return needed;
+}
+
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
 void AsyncDNSResolverSockets::Resolve(DNSResolver &resolver)
 {
     struct addrinfo gaiHints;
     struct addrinfo * gaiResults = NULL;
     int gaiReturnCode;
+    uint64_t lookupTimeMS;
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    DNSResolver *waiters;
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
 
     // Configure the hints argument for getaddrinfo()
     resolver.InitAddrInfoHints(gaiHints);
 
+    lookupTimeMS = Weave::System::Layer::GetClock_MonotonicMS();
+
     // Call getaddrinfo() to perform the name resolution.
     gaiReturnCode = getaddrinfo(resolver.asyncHostNameBuf, NULL, &gaiHints, &gaiResults);
 
+    lookupTimeMS = Weave::System::Layer::GetClock_MonotonicMS() - lookupTimeMS;
+
     // Mutex protects the read and write operation on resolver->mState
     AsyncMutexLock();
 
-    // Process the return code and results list returned by getaddrinfo(). If the call
-    // was successful this will copy the resultant addresses into the caller's array.
-    resolver.asyncDNSResolveResult = resolver.ProcessGetAddrInfoResult(gaiReturnCode, gaiResults);
+    mQueueStats.Lookups++;
+    mQueueStats.TotalLookupTimeMS += lookupTimeMS;
+    if (lookupTimeMS > mQueueStats.MaxLookupTimeMS)
+    {
+        mQueueStats.MaxLookupTimeMS = static_cast<uint32_t>(lookupTimeMS);
+    }
+
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    // Cache the result and hand it to any requests coalesced onto this lookup.
+    waiters = CompleteCacheEntry(resolver, gaiReturnCode, gaiResults);
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
 
-    // Set the DNS resolver state.
-    resolver.mState = DNSResolver::kState_Complete;
+    if (resolver.mState != DNSResolver::kState_Canceled)
+    {
+        // Process the return code and results list returned by getaddrinfo(). If the call
+        // was successful this will copy the resultant addresses into the caller's array.
+        resolver.asyncDNSResolveResult = resolver.ProcessGetAddrInfoResult(gaiReturnCode, gaiResults);
+
+        // Set the DNS resolver state.
+        resolver.mState = DNSResolver::kState_Complete;
+    }
+    else if (gaiResults != NULL)
+    {
+        // The caller's address array may no longer exist.
+        freeaddrinfo(gaiResults);
+    }
 
     // Release lock.
     AsyncMutexUnlock();
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    while (waiters != NULL)
+    {
+        DNSResolver *waiter = waiters;
+
+        waiters = waiter->pNextAsyncDNSResolver;
+        NotifyWeaveThread(waiter);
+    }
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
     return;
 }
 
@@ -335,7 +784,11 @@ void *AsyncDNSResolverSockets::AsyncDNSThreadRun(void *args)
         // In that case, break out of the loop and exit thread.
         VerifyOrExit(err == INET_NO_ERROR && request != NULL, );
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+        if (asyncResolver->IsLookupNeeded(*request))
+#else // INET_CONFIG_DNS_CACHE_SIZE > 0
         if (request->mState != DNSResolver::kState_Canceled)
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
         {
             asyncResolver->Resolve(*request);
         }
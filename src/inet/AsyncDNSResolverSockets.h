@@ -41,6 +41,50 @@
 namespace nl {
 namespace Inet {
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+/**
+ *  @struct DNSCacheStats
+ *
+ *  @brief
+ *    Counters describing how host name resolution requests were satisfied
+ *    by the asynchronous DNS resolver.
+ *
+ *  The hit rate is (Hits + NegativeHits + Coalesced) divided by the sum of
+ *  all four counters.
+ */
+struct DNSCacheStats
+{
+    uint32_t Hits;          /**< Requests answered from a cached address list. */
+    uint32_t NegativeHits;  /**< Requests answered from a cached "host not found" result. */
+    uint32_t Coalesced;     /**< Requests attached to an identical lookup already in progress. */
+    uint32_t Misses;        /**< Requests that required a getaddrinfo() call. */
+};
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
+/**
+ *  @struct DNSQueueStats
+ *
+ *  @brief
+ *    Counters describing the asynchronous DNS request queue and the time
+ *    requests spend in it and in getaddrinfo().
+ *
+ *  The mean queue wait is TotalQueueTimeMS / Dequeued and the mean lookup
+ *  time is TotalLookupTimeMS / Lookups.
+ */
+struct DNSQueueStats
+{
+    uint32_t QueueDepth;        /**< Requests currently waiting for a worker thread. */
+    uint32_t MaxQueueDepth;     /**< The largest value QueueDepth has reached. */
+    uint32_t Dequeued;          /**< Requests picked up by a worker thread. */
+    uint32_t Lookups;           /**< getaddrinfo() calls completed. */
+    uint32_t Withdrawn;         /**< Canceled or timed out requests removed before reaching a worker. */
+    uint32_t TimedOut;          /**< Requests failed after #INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS. */
+    uint32_t MaxQueueTimeMS;    /**< The longest time a request waited for a worker. */
+    uint32_t MaxLookupTimeMS;   /**< The longest getaddrinfo() call. */
+    uint64_t TotalQueueTimeMS;  /**< Total time dequeued requests waited for a worker. */
+    uint64_t TotalLookupTimeMS; /**< Total time spent in getaddrinfo(). */
+};
+
 /**
  *  @class AsyncDNSResolverSockets
  *
@@ -56,6 +100,8 @@ class AsyncDNSResolverSockets
     friend class DNSResolver;
 public:
 
+    AsyncDNSResolverSockets(void);
+
     INET_ERROR EnqueueRequest(DNSResolver &resolver);
 
     INET_ERROR Init(InetLayer *inet);
@@ -68,17 +114,60 @@ public:
                                   uint8_t options, uint8_t maxAddrs, IPAddress *addrArray,
                                   DNSResolver::OnResolveCompleteFunct onComplete, void *appState);
 
+    void GetQueueStats(DNSQueueStats &outStats);
+
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    void GetCacheStats(DNSCacheStats &outStats);
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
 private:
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    enum
+    {
+        kCacheEntry_Unused                   = 0,
+        kCacheEntry_Pending                  = 1,
+        kCacheEntry_Valid                    = 2
+    };
+
+    struct CacheEntry
+    {
+        char                hostName[NL_DNS_HOSTNAME_MAX_LEN + 1];
+        IPAddress           addrs[INET_CONFIG_DNS_CACHE_MAX_ADDRS];
+        uint64_t            expiryTimeMS;   /* Monotonic time at which a valid entry goes stale. */
+        DNSResolver         *waiters;       /* Requests coalesced onto a pending lookup. */
+        INET_ERROR          result;
+        int                 addrFamily;     /* The getaddrinfo() hints family the entry was resolved with. */
+        uint8_t             numAddrs;
+        uint8_t             state;
+    };
+
+    CacheEntry              mCache[INET_CONFIG_DNS_CACHE_SIZE]; /* Protected by mAsyncDNSMutex. */
+    DNSCacheStats           mCacheStats;                        /* Protected by mAsyncDNSMutex. */
+
+    CacheEntry *LookupCacheEntry(const char *hostName, int addrFamily);
+    CacheEntry *AllocCacheEntry(uint64_t now);
+    DNSResolver *CompleteCacheEntry(DNSResolver &resolver, int gaiReturnCode, struct addrinfo *gaiResults);
+    bool IsLookupNeeded(DNSResolver &resolver);
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
     pthread_t               mAsyncDNSThreadHandle[INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT];
     pthread_mutex_t         mAsyncDNSMutex;      /* Mutex for accessing the DNSResolver queue. */
     pthread_cond_t          mAsyncDNSCondVar;    /* Condition Variable for thread synchronization. */
     volatile DNSResolver    *mAsyncDNSQueueHead; /* The head of the asynchronous DNSResolver object queue. */
     volatile DNSResolver    *mAsyncDNSQueueTail; /* The tail of the asynchronous DNSResolver object queue. */
     InetLayer               *mInet;              /* The pointer to the InetLayer. */
+    uint8_t                 mNumThreads;         /* The number of worker threads started by Init(). */
+    DNSQueueStats           mQueueStats;         /* Protected by mAsyncDNSMutex. */
     static void             DNSResultEventHandler(Weave::System::Layer* aLayer, void* aAppState, Weave::System::Error aError); /* Timer event handler function for asynchronous DNS notification */
 
     INET_ERROR DequeueRequest(DNSResolver **outResolver);
 
+    bool WithdrawRequest(DNSResolver &resolver);
+
+#if INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
+    static void HandleResolveTimeout(Weave::System::Layer* aLayer, void* aAppState, Weave::System::Error aError);
+#endif // INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
+
     bool ShouldThreadShutdown(void);
 
     void Resolve(DNSResolver &resolver);
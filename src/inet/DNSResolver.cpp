@@ -387,33 +387,8 @@ INET_ERROR DNSResolver::ProcessGetAddrInfoResult(int returnCode, struct addrinfo
 
         // Based on the address family option specified by the application, determine which
         // types of addresses should be returned and the order in which they should appear.
-        uint8_t addrFamilyOption = (DNSOptions & kDNSOption_AddrFamily_Mask);
         int primaryFamily, secondaryFamily;
-        switch (addrFamilyOption)
-        {
-        case kDNSOption_AddrFamily_Any:
-            primaryFamily = AF_UNSPEC;
-            secondaryFamily = AF_UNSPEC;
-            break;
-        case kDNSOption_AddrFamily_IPv4Only:
-            primaryFamily = AF_INET;
-            secondaryFamily = AF_UNSPEC;
-            break;
-        case kDNSOption_AddrFamily_IPv4Preferred:
-            primaryFamily = AF_INET;
-            secondaryFamily = AF_INET6;
-            break;
-        case kDNSOption_AddrFamily_IPv6Only:
-            primaryFamily = AF_INET6;
-            secondaryFamily = AF_UNSPEC;
-            break;
-        case kDNSOption_AddrFamily_IPv6Preferred:
-            primaryFamily = AF_INET6;
-            secondaryFamily = AF_INET;
-            break;
-        default:
-            WeaveDie();
-        }
+        GetAddrFamilyOrder(primaryFamily, secondaryFamily);
 
         // Determine the number of addresses of each family present in the results.
         // In the case of the secondary address family, only count these if they are
@@ -462,30 +437,7 @@ INET_ERROR DNSResolver::ProcessGetAddrInfoResult(int returnCode, struct addrinfo
     // Inet error...
     else
     {
-        switch (returnCode)
-        {
-        case EAI_NONAME:
-        case EAI_NODATA:
-        case EAI_ADDRFAMILY:
-            // Each of these errors is translated to "host not found" for simplicity at the
-            // application layer. On most systems, the errors have the following meanings:
-            //    EAI_NONAME is returned when there are no DNS records for the requested host name.
-            //    EAI_NODATA is returned when there are no host records (A or AAAA) for the requested
-            //      name, but other records do exist (e.g. MX or TXT).
-            //    EAI_ADDRFAMILY is returned when a text-form address is given as the name, but its
-            //      address family (IPv4 or IPv6) does not match the value specified in hints.ai_family.
-            err = INET_ERROR_HOST_NOT_FOUND;
-            break;
-        case EAI_AGAIN:
-            err = INET_ERROR_DNS_TRY_AGAIN;
-            break;
-        case EAI_SYSTEM:
-            err = Weave::System::MapErrorPOSIX(errno);
-            break;
-        default:
-            err = INET_ERROR_DNS_NO_RECOVERY;
-            break;
-        }
+        err = MapGetAddrInfoError(returnCode);
     }
 
     // Free the results structure.
@@ -495,6 +447,63 @@ INET_ERROR DNSResolver::ProcessGetAddrInfoResult(int returnCode, struct addrinfo
     return err;
 }
 
+INET_ERROR DNSResolver::MapGetAddrInfoError(int returnCode)
+{
+    switch (returnCode)
+    {
+    case EAI_NONAME:
+    case EAI_NODATA:
+    case EAI_ADDRFAMILY:
+        // Each of these errors is translated to "host not found" for simplicity at the
+        // application layer. On most systems, the errors have the following meanings:
+        //    EAI_NONAME is returned when there are no DNS records for the requested host name.
+        //    EAI_NODATA is returned when there are no host records (A or AAAA) for the requested
+        //      name, but other records do exist (e.g. MX or TXT).
+        //    EAI_ADDRFAMILY is returned when a text-form address is given as the name, but its
+        //      address family (IPv4 or IPv6) does not match the value specified in hints.ai_family.
+        return INET_ERROR_HOST_NOT_FOUND;
+    case EAI_AGAIN:
+        return INET_ERROR_DNS_TRY_AGAIN;
+    case EAI_SYSTEM:
+        return Weave::System::MapErrorPOSIX(errno);
+    default:
+        return INET_ERROR_DNS_NO_RECOVERY;
+    }
+}
+
+#if INET_CONFIG_ENABLE_IPV4
+void DNSResolver::GetAddrFamilyOrder(int & primaryFamily, int & secondaryFamily)
+{
+    uint8_t addrFamilyOption = (DNSOptions & kDNSOption_AddrFamily_Mask);
+
+    switch (addrFamilyOption)
+    {
+    case kDNSOption_AddrFamily_Any:
+        primaryFamily = AF_UNSPEC;
+        secondaryFamily = AF_UNSPEC;
+        break;
+    case kDNSOption_AddrFamily_IPv4Only:
+        primaryFamily = AF_INET;
+        secondaryFamily = AF_UNSPEC;
+        break;
+    case kDNSOption_AddrFamily_IPv4Preferred:
+        primaryFamily = AF_INET;
+        secondaryFamily = AF_INET6;
+        break;
+    case kDNSOption_AddrFamily_IPv6Only:
+        primaryFamily = AF_INET6;
+        secondaryFamily = AF_UNSPEC;
+        break;
+    case kDNSOption_AddrFamily_IPv6Preferred:
+        primaryFamily = AF_INET6;
+        secondaryFamily = AF_INET;
+        break;
+    default:
+        WeaveDie();
+    }
+}
+#endif // INET_CONFIG_ENABLE_IPV4
+
 void DNSResolver::CopyAddresses(int family, uint8_t count, const struct addrinfo * addrs)
 {
     for (const struct addrinfo *addr = addrs;
@@ -528,8 +537,110 @@ uint8_t DNSResolver::CountAddresses(int family, const struct addrinfo * addrs)
 
 #if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+
+/**
+ *  Fill the application's address array from a cached resolution result.
+ *
+ *  The cached addresses are held in the order returned by getaddrinfo(), so
+ *  this applies the same address family selection and ordering as
+ *  ProcessGetAddrInfoResult() does for a fresh lookup.
+ *
+ *  @param[in]  result      The result of the cached lookup.
+ *  @param[in]  addrs       The cached addresses.
+ *  @param[in]  addrCount   The number of cached addresses.
+ *
+ *  @return The error to report to the application.
+ */
+INET_ERROR DNSResolver::ProcessCachedResult(INET_ERROR result, const IPAddress * addrs, uint8_t addrCount)
+{
+    INET_ERROR err = result;
+
+    NumAddrs = 0;
+
+    if (err == INET_NO_ERROR)
+    {
+#if INET_CONFIG_ENABLE_IPV4
+
+        int primaryFamily, secondaryFamily;
+        GetAddrFamilyOrder(primaryFamily, secondaryFamily);
+
+        uint8_t numPrimaryAddrs = CountAddresses(primaryFamily, addrs, addrCount);
+        uint8_t numSecondaryAddrs = (secondaryFamily != AF_UNSPEC) ? CountAddresses(secondaryFamily, addrs, addrCount) : 0;
+        uint8_t numAddrs = numPrimaryAddrs + numSecondaryAddrs;
+
+        // As for a fresh lookup, make sure at least one secondary address survives truncation.
+        if (numAddrs > MaxAddrs && MaxAddrs > 1 && numPrimaryAddrs > 0 && numSecondaryAddrs > 0)
+        {
+            numPrimaryAddrs = ::nl::Weave::min(numPrimaryAddrs, (uint8_t)(MaxAddrs - 1));
+        }
+
+        CopyAddresses(primaryFamily, numPrimaryAddrs, addrs, addrCount);
+
+        if (numSecondaryAddrs != 0)
+        {
+            CopyAddresses(secondaryFamily, numSecondaryAddrs, addrs, addrCount);
+        }
+
+#else // INET_CONFIG_ENABLE_IPV4
+
+        CopyAddresses(AF_INET6, UINT8_MAX, addrs, addrCount);
+
+#endif // INET_CONFIG_ENABLE_IPV4
+
+        if (NumAddrs == 0)
+        {
+            err = INET_ERROR_HOST_NOT_FOUND;
+        }
+    }
+
+    return err;
+}
+
+static inline bool IsAddrFamily(int family, const IPAddress & addr)
+{
+#if INET_CONFIG_ENABLE_IPV4
+    return family == AF_UNSPEC || (family == AF_INET) == addr.IsIPv4();
+#else // INET_CONFIG_ENABLE_IPV4
+    return family == AF_UNSPEC || family == AF_INET6;
+#endif // INET_CONFIG_ENABLE_IPV4
+}
+
+void DNSResolver::CopyAddresses(int family, uint8_t count, const IPAddress * addrs, uint8_t addrCount)
+{
+    for (uint8_t i = 0; i < addrCount && NumAddrs < MaxAddrs && count > 0; i++)
+    {
+        if (IsAddrFamily(family, addrs[i]))
+        {
+            AddrArray[NumAddrs++] = addrs[i];
+            count--;
+        }
+    }
+}
+
+uint8_t DNSResolver::CountAddresses(int family, const IPAddress * addrs, uint8_t addrCount)
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < addrCount; i++)
+    {
+        if (IsAddrFamily(family, addrs[i]))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
 void DNSResolver::HandleAsyncResolveComplete(void)
 {
+#if INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
+    SystemLayer().CancelTimer(AsyncDNSResolverSockets::HandleResolveTimeout, this);
+#endif // INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS > 0
+
     // Copy the resolved address to the application supplied buffer, but only if the request hasn't been canceled.
     if (OnComplete && mState != kState_Canceled)
     {
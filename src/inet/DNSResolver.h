@@ -139,6 +139,10 @@ private:
     INET_ERROR ProcessGetAddrInfoResult(int returnCode, struct addrinfo * results);
     void CopyAddresses(int family, uint8_t maxAddrs, const struct addrinfo * addrs);
     uint8_t CountAddresses(int family, const struct addrinfo * addrs);
+    static INET_ERROR MapGetAddrInfoError(int returnCode);
+#if INET_CONFIG_ENABLE_IPV4
+    void GetAddrFamilyOrder(int & primaryFamily, int & secondaryFamily);
+#endif // INET_CONFIG_ENABLE_IPV4
 
 #if INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
@@ -146,6 +150,8 @@ private:
     char asyncHostNameBuf[NL_DNS_HOSTNAME_MAX_LEN + 1]; // DNS limits hostnames to 253 max characters.
 
     INET_ERROR asyncDNSResolveResult;
+    /* The monotonic time at which the request was queued. */
+    uint64_t asyncEnqueueTimeMS;
     /* The next DNSResolver object in the asynchronous DNS resolution queue. */
     DNSResolver *pNextAsyncDNSResolver;
 
@@ -153,6 +159,12 @@ private:
 
     void HandleAsyncResolveComplete(void);
 
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    INET_ERROR ProcessCachedResult(INET_ERROR result, const IPAddress * addrs, uint8_t addrCount);
+    void CopyAddresses(int family, uint8_t maxAddrs, const IPAddress * addrs, uint8_t addrCount);
+    uint8_t CountAddresses(int family, const IPAddress * addrs, uint8_t addrCount);
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+
 #endif // INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -41,6 +41,11 @@ void EndPointBasis::InitEndPointBasis(InetLayer& aInetLayer, void* aAppState)
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     mSocket = INET_INVALID_SOCKET_FD;
     mPendingIO.Clear();
+
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+    mWatchedSocket = INET_INVALID_SOCKET_FD;
+    mWatchedEvents.Clear();
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 }
 
@@ -84,6 +84,13 @@ protected:
     int mSocket;                    /**< Encapsulated socket descriptor. */
     IPAddressType mAddrType;        /**< Protocol family, i.e. IPv4 or IPv6. */
     SocketEvents mPendingIO;        /**< Socket event masks */
+
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+    int mWatchedSocket;             /**< Socket descriptor registered with the InetLayer event notifier. */
+    SocketEvents mWatchedEvents;    /**< Socket event masks registered with the InetLayer event notifier. */
+
+    friend class InetLayer;
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -36,6 +36,7 @@
 #include <InetLayer/InetLayer.h>
 
 #include <Weave/Support/CodeUtils.h>
+#include <SystemLayer/SystemTrace.h>
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if INET_CONFIG_ENABLE_IPV4
@@ -56,6 +57,9 @@
 #include <netinet/in.h>
 #include <net/if.h>
 #include <sys/ioctl.h>
+#if INET_CONFIG_UDP_SEND_BATCH_SIZE > 1 && INET_CONFIG_ENABLE_UDP_GSO
+#include <netinet/udp.h>
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE > 1 && INET_CONFIG_ENABLE_UDP_GSO
 #if HAVE_SYS_SOCKET_H
 #include <sys/socket.h>
 #endif // HAVE_SYS_SOCKET_H
@@ -98,6 +102,16 @@ union PeerSockAddr
 };
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_GSO && defined(UDP_SEGMENT)
+#define INET_HAVE_UDP_GSO 1
+
+// The limits the Linux kernel places on a single UDP GSO request.
+#define INET_UDP_GSO_MAX_SEGMENTS 64
+#define INET_UDP_GSO_MAX_BYTES    65507
+#else // !(WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_GSO && defined(UDP_SEGMENT))
+#define INET_HAVE_UDP_GSO 0
+#endif // !(WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_UDP_GSO && defined(UDP_SEGMENT))
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if INET_CONFIG_ENABLE_IPV4
 #define LWIP_IPV4_ADDR_T           ip4_addr_t
@@ -577,6 +591,8 @@ void IPEndPointBasis::Init(InetLayer *aInetLayer)
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 void IPEndPointBasis::HandleDataReceived(PacketBuffer *aBuffer)
 {
+    SYSTEM_TRACE_SCOPE("Inet", "IPEndPointBasis::HandleDataReceived");
+
     if ((mState == kState_Listening) && (OnMessageReceived != NULL))
     {
         const IPPacketInfo *pktInfo = GetPacketInfo(aBuffer);
@@ -645,6 +661,69 @@ IPPacketInfo *IPEndPointBasis::GetPacketInfo(PacketBuffer *aBuffer)
  done:
     return (lPacketInfo);
 }
+
+/**
+ *  @brief Make a buffer received from LwIP usable as a single PacketBuffer.
+ *
+ *  @param[in]   aPBuf         the pbuf chain holding the received IP message
+ *
+ *  @returns  the PacketBuffer holding the whole message contiguously on success;
+ *            otherwise, NULL if no buffer could be allocated, in which case
+ *            \c aPBuf has been freed.
+ *
+ *  @details
+ *     The message layer decodes each datagram from a single, contiguous
+ *     buffer and stores the IPPacketInfo in the space before it, so a
+ *     pbuf can be handed over as is only if it is not chained and its
+ *     payload lies within its own storage.  This is the common case, and
+ *     no data is moved.
+ *
+ *     A chained message whose first pbuf has room for all of it, as when
+ *     the network interface fills small pool buffers, is gathered into
+ *     the first pbuf, moving only the data held by the rest of the chain.
+ *     Only a message in a PBUF_REF or PBUF_ROM pbuf, whose payload is
+ *     memory that LwIP does not own, or a chained message that does not
+ *     fit in its first pbuf, is copied into a newly allocated buffer.
+ */
+PacketBuffer *IPEndPointBasis::PrepareReceivedBuffer(struct pbuf *aPBuf)
+{
+    PacketBuffer *  lBuffer = reinterpret_cast<PacketBuffer *>(static_cast<void *>(aPBuf));
+    PacketBuffer *  lCopy;
+    const uint16_t  lTotalLength = lBuffer->TotalLength();
+
+#if LWIP_VERSION_MAJOR > 2 || (LWIP_VERSION_MAJOR == 2 && LWIP_VERSION_MINOR >= 1)
+    const uint8_t   lAllocSource = pbuf_get_allocsrc(aPBuf);
+    const bool      lIsReference = (lAllocSource == PBUF_TYPE_ALLOC_SRC_MASK_STD_MEMP_PBUF);
+    const bool      lIsPoolBuffer = (lAllocSource == PBUF_TYPE_ALLOC_SRC_MASK_STD_MEMP_PBUF_POOL);
+#else // LWIP_VERSION_MAJOR < 2 || (LWIP_VERSION_MAJOR == 2 && LWIP_VERSION_MINOR < 1)
+    const bool      lIsReference = (aPBuf->type == PBUF_REF || aPBuf->type == PBUF_ROM);
+    const bool      lIsPoolBuffer = (aPBuf->type == PBUF_POOL);
+#endif // LWIP_VERSION_MAJOR < 2 || (LWIP_VERSION_MAJOR == 2 && LWIP_VERSION_MINOR < 1)
+
+    if (lIsReference)
+        goto copy;
+
+    if (aPBuf->next == NULL)
+        goto done;
+
+    // Only a pool buffer is known to have the room that PullUp() assumes.
+    if (lIsPoolBuffer && lBuffer->PullUp(lTotalLength))
+        goto done;
+
+ copy:
+    lCopy = PacketBuffer::NewWithAvailableSize(static_cast<size_t>(lTotalLength));
+    if (lCopy != NULL)
+    {
+        pbuf_copy_partial(aPBuf, lCopy->Start(), lTotalLength, 0);
+        lCopy->SetDataLength(lTotalLength);
+    }
+
+    PacketBuffer::Free(lBuffer);
+    lBuffer = lCopy;
+
+ done:
+    return (lBuffer);
+}
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -760,39 +839,46 @@ INET_ERROR IPEndPointBasis::BindInterface(IPAddressType aAddressType, InterfaceI
     return (lRetval);
 }
 
-INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System::PacketBuffer *aBuffer, uint16_t aSendFlags)
+/**
+ *  Storage for the destination address and ancillary data of an outbound datagram.
+ */
+struct SendMsgStorage
 {
-    INET_ERROR     res = INET_NO_ERROR;
-    PeerSockAddr   peerSockAddr;
-    struct iovec   msgIOV;
-    uint8_t        controlData[256];
-    struct msghdr  msgHeader;
-    InterfaceId    intfId = aPktInfo->Interface;
-
-    // Ensure the destination address type is compatible with the endpoint address type.
-    VerifyOrExit(mAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
+    PeerSockAddr    peerSockAddr;
+    uint8_t         controlData[256];
+};
 
-    // For now the entire message must fit within a single buffer.
-    VerifyOrExit(aBuffer->Next() == NULL, res = INET_ERROR_MESSAGE_TOO_LONG);
+/**
+ *  Construct the message header for sending the data described by \c aIOV to the destination in \c aPktInfo.
+ *
+ *  If \c aSegmentSize is not zero, the data is a run of datagrams of that size, except for a possibly shorter last datagram, and
+ *  the header requests that the kernel segment it (UDP GSO).
+ */
+static INET_ERROR BuildSendMsgHeader(IPAddressType aAddrType, InterfaceId aBoundIntfId, const IPPacketInfo *aPktInfo,
+    struct iovec *aIOV, size_t aIOVLen, uint16_t aSegmentSize, SendMsgStorage &aStorage, struct msghdr &aMsgHeader)
+{
+    INET_ERROR       res = INET_NO_ERROR;
+    PeerSockAddr    &peerSockAddr = aStorage.peerSockAddr;
+    InterfaceId      intfId = aPktInfo->Interface;
+    struct cmsghdr  *controlHdr;
+    size_t           controlLen = 0;
 
-    memset(&msgHeader, 0, sizeof (msgHeader));
+    memset(&aMsgHeader, 0, sizeof (aMsgHeader));
 
-    msgIOV.iov_base      = aBuffer->Start();
-    msgIOV.iov_len       = aBuffer->DataLength();
-    msgHeader.msg_iov    = &msgIOV;
-    msgHeader.msg_iovlen = 1;
+    aMsgHeader.msg_iov    = aIOV;
+    aMsgHeader.msg_iovlen = aIOVLen;
 
     // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
     memset(&peerSockAddr, 0, sizeof (peerSockAddr));
-    msgHeader.msg_name = &peerSockAddr;
-    if (mAddrType == kIPAddressType_IPv6)
+    aMsgHeader.msg_name = &peerSockAddr;
+    if (aAddrType == kIPAddressType_IPv6)
     {
         peerSockAddr.in6.sin6_family    = AF_INET6;
         peerSockAddr.in6.sin6_port      = htons(aPktInfo->DestPort);
         peerSockAddr.in6.sin6_flowinfo  = 0;
         peerSockAddr.in6.sin6_addr      = aPktInfo->DestAddress.ToIPv6();
         peerSockAddr.in6.sin6_scope_id  = aPktInfo->Interface;
-        msgHeader.msg_namelen           = sizeof(sockaddr_in6);
+        aMsgHeader.msg_namelen          = sizeof(sockaddr_in6);
     }
 #if INET_CONFIG_ENABLE_IPV4
     else
@@ -800,10 +886,16 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System:
         peerSockAddr.in.sin_family      = AF_INET;
         peerSockAddr.in.sin_port        = htons(aPktInfo->DestPort);
         peerSockAddr.in.sin_addr        = aPktInfo->DestAddress.ToIPv4();
-        msgHeader.msg_namelen           = sizeof(sockaddr_in);
+        aMsgHeader.msg_namelen          = sizeof(sockaddr_in);
     }
 #endif // INET_CONFIG_ENABLE_IPV4
 
+    memset(aStorage.controlData, 0, sizeof(aStorage.controlData));
+    aMsgHeader.msg_control = aStorage.controlData;
+    aMsgHeader.msg_controllen = sizeof(aStorage.controlData);
+
+    controlHdr = CMSG_FIRSTHDR(&aMsgHeader);
+
     // If the endpoint has been bound to a particular interface,
     // and the caller didn't supply a specific interface to send
     // on, use the bound interface. This appears to be necessary
@@ -811,7 +903,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System:
     // don't seem to get sent out the correct interface, despite
     // the socket being bound.
     if (intfId == INET_NULL_INTERFACEID)
-        intfId = mBoundIntfId;
+        intfId = aBoundIntfId;
 
     // If the packet should be sent over a specific interface, or with a specific source
     // address, construct an IP_PKTINFO/IPV6_PKTINFO "control message" to that effect
@@ -820,15 +912,9 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System:
     if (intfId != INET_NULL_INTERFACEID || aPktInfo->SrcAddress.Type() != kIPAddressType_Any)
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-        memset(controlData, 0, sizeof(controlData));
-        msgHeader.msg_control = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
-
-        struct cmsghdr *controlHdr = CMSG_FIRSTHDR(&msgHeader);
-
 #if INET_CONFIG_ENABLE_IPV4
 
-        if (mAddrType == kIPAddressType_IPv4)
+        if (aAddrType == kIPAddressType_IPv4)
         {
 #if defined(IP_PKTINFO)
             controlHdr->cmsg_level = IPPROTO_IP;
@@ -839,7 +925,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System:
             pktInfo->ipi_ifindex = intfId;
             pktInfo->ipi_spec_dst = aPktInfo->SrcAddress.ToIPv4();
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in_pktinfo));
+            controlLen += CMSG_SPACE(sizeof(in_pktinfo));
 #else // !defined(IP_PKTINFO)
             ExitNow(res = INET_ERROR_NOT_SUPPORTED);
 #endif // !defined(IP_PKTINFO)
@@ -847,7 +933,7 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System:
 
 #endif // INET_CONFIG_ENABLE_IPV4
 
-        if (mAddrType == kIPAddressType_IPv6)
+        if (aAddrType == kIPAddressType_IPv6)
         {
 #if defined(IPV6_PKTINFO)
             controlHdr->cmsg_level = IPPROTO_IPV6;
@@ -858,12 +944,14 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System:
             pktInfo->ipi6_ifindex = intfId;
             pktInfo->ipi6_addr = aPktInfo->SrcAddress.ToIPv6();
 
-            msgHeader.msg_controllen = CMSG_SPACE(sizeof(in6_pktinfo));
+            controlLen += CMSG_SPACE(sizeof(in6_pktinfo));
 #else // !defined(IPV6_PKTINFO)
             ExitNow(res = INET_ERROR_NOT_SUPPORTED);
 #endif // !defined(IPV6_PKTINFO)
         }
 
+        controlHdr = CMSG_NXTHDR(&aMsgHeader, controlHdr);
+
 #else // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
 
         ExitNow(res = INET_ERROR_NOT_SUPPORTED);
@@ -871,6 +959,48 @@ INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System:
 #endif // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
     }
 
+    if (aSegmentSize != 0)
+    {
+#if INET_HAVE_UDP_GSO
+        controlHdr->cmsg_level = SOL_UDP;
+        controlHdr->cmsg_type  = UDP_SEGMENT;
+        controlHdr->cmsg_len   = CMSG_LEN(sizeof(uint16_t));
+
+        memcpy(CMSG_DATA(controlHdr), &aSegmentSize, sizeof(uint16_t));
+
+        controlLen += CMSG_SPACE(sizeof(uint16_t));
+#else // !INET_HAVE_UDP_GSO
+        ExitNow(res = INET_ERROR_NOT_SUPPORTED);
+#endif // !INET_HAVE_UDP_GSO
+    }
+
+exit:
+    if (controlLen == 0)
+        aMsgHeader.msg_control = NULL;
+    aMsgHeader.msg_controllen = controlLen;
+
+    return (res);
+}
+
+INET_ERROR IPEndPointBasis::SendMsg(const IPPacketInfo *aPktInfo, Weave::System::PacketBuffer *aBuffer, uint16_t aSendFlags)
+{
+    INET_ERROR      res = INET_NO_ERROR;
+    SendMsgStorage  storage;
+    struct iovec    msgIOV;
+    struct msghdr   msgHeader;
+
+    // Ensure the destination address type is compatible with the endpoint address type.
+    VerifyOrExit(mAddrType == aPktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
+
+    // For now the entire message must fit within a single buffer.
+    VerifyOrExit(aBuffer->Next() == NULL, res = INET_ERROR_MESSAGE_TOO_LONG);
+
+    msgIOV.iov_base      = aBuffer->Start();
+    msgIOV.iov_len       = aBuffer->DataLength();
+
+    res = BuildSendMsgHeader(mAddrType, mBoundIntfId, aPktInfo, &msgIOV, 1, 0, storage, msgHeader);
+    SuccessOrExit(res);
+
     // Send IP packet.
     {
         const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
@@ -884,6 +1014,160 @@ exit:
     return (res);
 }
 
+#if INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+
+#if INET_HAVE_UDP_GSO
+/**
+ *  Whether two outbound datagrams may be sent together as the segments of a single UDP GSO request.
+ */
+static bool IsSameFlow(const IPPacketInfo &aFirst, const IPPacketInfo &aSecond)
+{
+    return (aFirst.DestAddress == aSecond.DestAddress &&
+            aFirst.DestPort == aSecond.DestPort &&
+            aFirst.Interface == aSecond.Interface &&
+            aFirst.SrcAddress == aSecond.SrcAddress);
+}
+#endif // INET_HAVE_UDP_GSO
+
+/**
+ *  Send a batch of datagrams.
+ *
+ *  Where the target system provides sendmmsg, the whole batch is passed to the kernel with as few system calls as possible. When
+ *  \c aUseSegmentation is set, consecutive equal-size datagrams to the same destination are coalesced into UDP GSO requests; if the
+ *  kernel rejects such a request, its datagrams are sent individually and \c aUseSegmentation is cleared.
+ *
+ *  The buffers remain owned by the caller. A datagram that cannot be sent does not prevent sending the others.
+ *
+ *  @return #INET_NO_ERROR if every datagram was sent; otherwise, the error for the first datagram that could not be sent.
+ */
+INET_ERROR IPEndPointBasis::SendMsgBatch(const IPPacketInfo *aPktInfos, PacketBuffer * const *aBuffers, size_t aCount,
+    bool &aUseSegmentation)
+{
+#if HAVE_SENDMMSG
+    typedef struct mmsghdr BatchMsg;
+#else // !HAVE_SENDMMSG
+    struct BatchMsg { struct msghdr msg_hdr; };
+#endif // !HAVE_SENDMMSG
+
+    INET_ERROR      res = INET_NO_ERROR;
+    INET_ERROR      lErr;
+    struct iovec    lIOVs[INET_CONFIG_UDP_SEND_BATCH_SIZE];
+    SendMsgStorage  lStorage[INET_CONFIG_UDP_SEND_BATCH_SIZE];
+    BatchMsg        lMessages[INET_CONFIG_UDP_SEND_BATCH_SIZE];
+    uint8_t         lFirstDatagram[INET_CONFIG_UDP_SEND_BATCH_SIZE];
+    uint8_t         lNumDatagrams[INET_CONFIG_UDP_SEND_BATCH_SIZE];
+    size_t          lNumMessages = 0;
+    size_t          i = 0;
+
+    VerifyOrExit(aCount <= INET_CONFIG_UDP_SEND_BATCH_SIZE, res = INET_ERROR_BAD_ARGS);
+
+    // Build one message header per datagram, or per run of datagrams to be segmented by the kernel.
+    while (i < aCount)
+    {
+        const IPPacketInfo &lPktInfo = aPktInfos[i];
+        size_t              lEnd = i + 1;
+        uint16_t            lSegmentSize = 0;
+
+        if (mAddrType != lPktInfo.DestAddress.Type())
+            lErr = INET_ERROR_BAD_ARGS;
+        else if (aBuffers[i]->Next() != NULL)
+            lErr = INET_ERROR_MESSAGE_TOO_LONG;
+        else
+            lErr = INET_NO_ERROR;
+
+        if (lErr == INET_NO_ERROR)
+        {
+#if INET_HAVE_UDP_GSO
+            const uint16_t lSize = aBuffers[i]->DataLength();
+            size_t lTotal = lSize;
+
+            // All segments but the last must have the segment size; the last may be shorter.
+            while (aUseSegmentation && lSize > 0 && lEnd < aCount && lEnd - i < INET_UDP_GSO_MAX_SEGMENTS &&
+                   aBuffers[lEnd - 1]->DataLength() == lSize && aBuffers[lEnd]->Next() == NULL &&
+                   aBuffers[lEnd]->DataLength() > 0 && aBuffers[lEnd]->DataLength() <= lSize &&
+                   lTotal + aBuffers[lEnd]->DataLength() <= INET_UDP_GSO_MAX_BYTES && IsSameFlow(lPktInfo, aPktInfos[lEnd]))
+            {
+                lTotal += aBuffers[lEnd]->DataLength();
+                lEnd++;
+            }
+
+            if (lEnd - i > 1)
+                lSegmentSize = lSize;
+#endif // INET_HAVE_UDP_GSO
+
+            for (size_t k = i; k < lEnd; k++)
+            {
+                lIOVs[k].iov_base = aBuffers[k]->Start();
+                lIOVs[k].iov_len = aBuffers[k]->DataLength();
+            }
+
+            lErr = BuildSendMsgHeader(mAddrType, mBoundIntfId, &lPktInfo, &lIOVs[i], lEnd - i, lSegmentSize,
+                lStorage[lNumMessages], lMessages[lNumMessages].msg_hdr);
+        }
+
+        if (lErr == INET_NO_ERROR)
+        {
+            lFirstDatagram[lNumMessages] = static_cast<uint8_t>(i);
+            lNumDatagrams[lNumMessages] = static_cast<uint8_t>(lEnd - i);
+            lNumMessages++;
+        }
+        else if (res == INET_NO_ERROR)
+        {
+            res = lErr;
+        }
+
+        i = lEnd;
+    }
+
+    // Hand the messages to the kernel, skipping over any message it refuses.
+    i = 0;
+    while (i < lNumMessages)
+    {
+#if HAVE_SENDMMSG
+        const int lNumSent = sendmmsg(mSocket, &lMessages[i], lNumMessages - i, 0);
+#else // !HAVE_SENDMMSG
+        const int lNumSent = (sendmsg(mSocket, &lMessages[i].msg_hdr, 0) < 0) ? -1 : 1;
+#endif // !HAVE_SENDMMSG
+
+        if (lNumSent > 0)
+        {
+            i += lNumSent;
+            continue;
+        }
+
+        lErr = Weave::System::MapErrorPOSIX(errno);
+
+#if INET_HAVE_UDP_GSO
+        // The kernel or the outbound interface does not support segmentation; fall back to sending the datagrams individually.
+        if (lNumDatagrams[i] > 1 && (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT || errno == EOPNOTSUPP))
+        {
+            aUseSegmentation = false;
+
+            for (size_t k = lFirstDatagram[i]; k < static_cast<size_t>(lFirstDatagram[i] + lNumDatagrams[i]); k++)
+            {
+                lErr = SendMsg(&aPktInfos[k], aBuffers[k], 0);
+
+                if (lErr != INET_NO_ERROR && res == INET_NO_ERROR)
+                    res = lErr;
+            }
+
+            i++;
+            continue;
+        }
+#endif // INET_HAVE_UDP_GSO
+
+        if (res == INET_NO_ERROR)
+            res = lErr;
+
+        i++;
+    }
+
+exit:
+    return (res);
+}
+
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+
 INET_ERROR IPEndPointBasis::GetSocket(IPAddressType aAddressType, int aType, int aProtocol)
 {
     INET_ERROR res = INET_NO_ERROR;
@@ -1007,8 +1291,172 @@ SocketEvents IPEndPointBasis::PrepareIO(void)
     return res;
 }
 
+/**
+ *  Fill in the source address and port, and the destination address and interface when the corresponding ancillary data is
+ *  present, of a datagram received with recvmsg or recvmmsg.
+ */
+static INET_ERROR GetPacketInfoFromMessage(const struct msghdr &aMsgHeader, IPPacketInfo &aPacketInfo)
+{
+    const PeerSockAddr &lPeerSockAddr = *static_cast<const PeerSockAddr *>(aMsgHeader.msg_name);
+
+    if (lPeerSockAddr.any.sa_family == AF_INET6)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
+        aPacketInfo.SrcPort = ntohs(lPeerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (lPeerSockAddr.any.sa_family == AF_INET)
+    {
+        aPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
+        aPacketInfo.SrcPort = ntohs(lPeerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return INET_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr *controlHdr = CMSG_FIRSTHDR(&aMsgHeader);
+         controlHdr != NULL;
+         controlHdr = CMSG_NXTHDR(const_cast<struct msghdr *>(&aMsgHeader), controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            struct in_pktinfo *inPktInfo = (struct in_pktinfo *)CMSG_DATA(controlHdr);
+            aPacketInfo.Interface = inPktInfo->ipi_ifindex;
+            aPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            struct in6_pktinfo *in6PktInfo = (struct in6_pktinfo *)CMSG_DATA(controlHdr);
+            aPacketInfo.Interface = in6PktInfo->ipi6_ifindex;
+            aPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return INET_NO_ERROR;
+}
+
+#if INET_CONFIG_RECV_BATCH_SIZE > 1 && HAVE_RECVMMSG
+
+void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
+{
+    SYSTEM_TRACE_SCOPE("Inet", "IPEndPointBasis::HandlePendingIO");
+
+    INET_ERROR      lStatus = INET_NO_ERROR;
+    PacketBuffer *  lBuffers[INET_CONFIG_RECV_BATCH_SIZE];
+    struct mmsghdr  lMessages[INET_CONFIG_RECV_BATCH_SIZE];
+    struct iovec    lIOVs[INET_CONFIG_RECV_BATCH_SIZE];
+    PeerSockAddr    lPeerSockAddrs[INET_CONFIG_RECV_BATCH_SIZE];
+    uint8_t         lControlData[INET_CONFIG_RECV_BATCH_SIZE][256];
+    unsigned int    lNumBuffers;
+    int             lNumReceived;
+
+    // Pre-allocate as many buffers as are available, up to the batch size.
+    for (lNumBuffers = 0; lNumBuffers < INET_CONFIG_RECV_BATCH_SIZE; lNumBuffers++)
+    {
+        SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_InetLayer);
+        PacketBuffer *lBuffer = PacketBuffer::New(0);
+
+        if (lBuffer == NULL)
+            break;
+
+        lBuffers[lNumBuffers] = lBuffer;
+
+        lIOVs[lNumBuffers].iov_base = lBuffer->Start();
+        lIOVs[lNumBuffers].iov_len = lBuffer->AvailableDataLength();
+
+        memset(&lPeerSockAddrs[lNumBuffers], 0, sizeof (lPeerSockAddrs[lNumBuffers]));
+
+        memset(&lMessages[lNumBuffers], 0, sizeof (lMessages[lNumBuffers]));
+
+        lMessages[lNumBuffers].msg_hdr.msg_name = &lPeerSockAddrs[lNumBuffers];
+        lMessages[lNumBuffers].msg_hdr.msg_namelen = sizeof (lPeerSockAddrs[lNumBuffers]);
+        lMessages[lNumBuffers].msg_hdr.msg_iov = &lIOVs[lNumBuffers];
+        lMessages[lNumBuffers].msg_hdr.msg_iovlen = 1;
+        lMessages[lNumBuffers].msg_hdr.msg_control = lControlData[lNumBuffers];
+        lMessages[lNumBuffers].msg_hdr.msg_controllen = sizeof (lControlData[lNumBuffers]);
+    }
+
+    VerifyOrExit(lNumBuffers > 0, lStatus = INET_ERROR_NO_MEMORY);
+
+    lNumReceived = recvmmsg(mSocket, lMessages, lNumBuffers, MSG_DONTWAIT, NULL);
+    VerifyOrExit(lNumReceived >= 0, lStatus = Weave::System::MapErrorPOSIX(errno));
+
+    // Keep the endpoint alive while dispatching, since an upcall may close it.
+    Retain();
+
+    for (int i = 0; i < lNumReceived; i++)
+    {
+        PacketBuffer *  lBuffer = lBuffers[i];
+        IPPacketInfo    lPacketInfo;
+        INET_ERROR      lMessageStatus = INET_NO_ERROR;
+
+        lBuffers[i] = NULL;
+
+        // Stop dispatching, and drop the remaining datagrams, if an upcall closed the endpoint.
+        if (mState != kState_Listening || OnMessageReceived == NULL)
+        {
+            PacketBuffer::Free(lBuffer);
+            continue;
+        }
+
+        lPacketInfo.Clear();
+        lPacketInfo.DestPort = aPort;
+
+        if (lMessages[i].msg_len > lBuffer->AvailableDataLength())
+        {
+            lMessageStatus = INET_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            lBuffer->SetDataLength((uint16_t) lMessages[i].msg_len);
+
+            lMessageStatus = GetPacketInfoFromMessage(lMessages[i].msg_hdr, lPacketInfo);
+        }
+
+        if (lMessageStatus == INET_NO_ERROR)
+            OnMessageReceived(this, lBuffer, &lPacketInfo);
+        else
+        {
+            PacketBuffer::Free(lBuffer);
+            if (OnReceiveError != NULL)
+                OnReceiveError(this, lMessageStatus, NULL);
+        }
+    }
+
+    Release();
+
+exit:
+    for (unsigned int i = 0; i < lNumBuffers; i++)
+    {
+        if (lBuffers[i] != NULL)
+            PacketBuffer::Free(lBuffers[i]);
+    }
+
+    if (lStatus != INET_NO_ERROR && OnReceiveError != NULL
+        && lStatus != Weave::System::MapErrorPOSIX(EAGAIN)
+       )
+        OnReceiveError(this, lStatus, NULL);
+
+    return;
+}
+
+#else // INET_CONFIG_RECV_BATCH_SIZE <= 1 || !HAVE_RECVMMSG
+
 void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 {
+    SYSTEM_TRACE_SCOPE("Inet", "IPEndPointBasis::HandlePendingIO");
+
     INET_ERROR      lStatus = INET_NO_ERROR;
     IPPacketInfo    lPacketInfo;
     PacketBuffer *  lBuffer;
@@ -1016,7 +1464,10 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
     lPacketInfo.Clear();
     lPacketInfo.DestPort = aPort;
 
-    lBuffer = PacketBuffer::New(0);
+    {
+        SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_InetLayer);
+        lBuffer = PacketBuffer::New(0);
+    }
 
     if (lBuffer != NULL)
     {
@@ -1053,52 +1504,7 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
         {
             lBuffer->SetDataLength((uint16_t) rcvLen);
 
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv6(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress::FromIPv4(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = INET_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == INET_NO_ERROR)
-        {
-            for (struct cmsghdr *controlHdr = CMSG_FIRSTHDR(&msgHeader);
-                 controlHdr != NULL;
-                 controlHdr = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    struct in_pktinfo *inPktInfo = (struct in_pktinfo *)CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface = inPktInfo->ipi_ifindex;
-                    lPacketInfo.DestAddress = IPAddress::FromIPv4(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    struct in6_pktinfo *in6PktInfo = (struct in6_pktinfo *)CMSG_DATA(controlHdr);
-                    lPacketInfo.Interface = in6PktInfo->ipi6_ifindex;
-                    lPacketInfo.DestAddress = IPAddress::FromIPv6(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = GetPacketInfoFromMessage(msgHeader, lPacketInfo);
         }
     }
     else
@@ -1119,6 +1525,8 @@ void IPEndPointBasis::HandlePendingIO(uint16_t aPort)
 
     return;
 }
+
+#endif // INET_CONFIG_RECV_BATCH_SIZE <= 1 || !HAVE_RECVMMSG
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 } // namespace Inet
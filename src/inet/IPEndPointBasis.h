@@ -83,7 +83,14 @@ public:
      */
     enum {
         /** Do not destructively queue the message directly. Queue a copy. */
-        kSendFlag_RetainBuffer = 0x0040
+        kSendFlag_RetainBuffer = 0x0040,
+
+        /**
+         * Queue the message on the endpoint and send it with other deferred messages at the end of the current event loop
+         * iteration. Only UDP endpoints on sockets platforms with #INET_CONFIG_UDP_SEND_BATCH_SIZE greater than one defer
+         * messages; others send them immediately.
+         */
+        kSendFlag_Deferred = 0x0080
     };
 
     /**
@@ -134,6 +141,7 @@ protected:
     void HandleDataReceived(Weave::System::PacketBuffer *aBuffer);
 
     static IPPacketInfo *GetPacketInfo(Weave::System::PacketBuffer *buf);
+    static Weave::System::PacketBuffer *PrepareReceivedBuffer(struct pbuf *aPBuf);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -146,6 +154,10 @@ protected:
     INET_ERROR GetSocket(IPAddressType aAddressType, int aType, int aProtocol);
     SocketEvents PrepareIO(void);
     void HandlePendingIO(uint16_t aPort);
+#if INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+    INET_ERROR SendMsgBatch(const IPPacketInfo *aPktInfos, Weave::System::PacketBuffer * const *aBuffers, size_t aCount,
+        bool &aUseSegmentation);
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 private:
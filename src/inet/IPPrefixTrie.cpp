@@ -0,0 +1,348 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the class <tt>nl::Inet::IPPrefixTrie</tt>.
+ *
+ */
+
+#include <InetLayer/IPPrefixTrie.h>
+#include <Weave/Core/WeaveEncoding.h>
+#include <Weave/Support/CodeUtils.h>
+
+namespace nl {
+namespace Inet {
+
+using nl::Weave::Encoding::BigEndian::HostSwap32;
+
+// Return bit aBit (0 = most significant) of an address.
+static inline uint8_t GetBit(const IPAddress &aAddr, uint8_t aBit)
+{
+    return (HostSwap32(aAddr.Addr[aBit / 32]) >> (31 - (aBit % 32))) & 1;
+}
+
+// Return the number of leading bits, up to aMaxLen, that two addresses have in common.
+static uint8_t CommonPrefixLength(const IPAddress &aAddr1, const IPAddress &aAddr2, uint8_t aMaxLen)
+{
+    uint8_t len = 0;
+
+    for (int i = 0; i < 4 && len < aMaxLen; i++)
+    {
+        uint32_t diff = HostSwap32(aAddr1.Addr[i] ^ aAddr2.Addr[i]);
+
+        if (diff == 0)
+        {
+            len += 32;
+            continue;
+        }
+
+        while ((diff & 0x80000000) == 0)
+        {
+            diff <<= 1;
+            len++;
+        }
+        break;
+    }
+
+    return (len < aMaxLen) ? len : aMaxLen;
+}
+
+// Return a copy of an address with all bits beyond the first aLength cleared.
+static IPAddress MaskAddress(const IPAddress &aAddr, uint8_t aLength)
+{
+    IPAddress masked = aAddr;
+
+    for (int i = 0; i < 4; i++, aLength = (aLength > 32) ? aLength - 32 : 0)
+    {
+        if (aLength >= 32)
+            continue;
+        masked.Addr[i] &= (aLength == 0) ? 0 : HostSwap32(0xFFFFFFFF << (32 - aLength));
+    }
+
+    return masked;
+}
+
+/**
+ * Initialize an empty trie.
+ *
+ * @param[in]   aNodes      Storage for the nodes of the trie, which must remain valid for as long as the trie is used.
+ * @param[in]   aNumNodes   The number of elements in \c aNodes; at most #kMaxNodes.
+ */
+void IPPrefixTrie::Init(Node *aNodes, uint8_t aNumNodes)
+{
+    mNodes = aNodes;
+    mNumNodes = (aNumNodes <= kMaxNodes) ? aNumNodes : static_cast<uint8_t>(kMaxNodes);
+    Clear();
+}
+
+/**
+ * Remove all prefixes from the trie.
+ */
+void IPPrefixTrie::Clear(void)
+{
+    for (uint8_t i = 0; i < mNumNodes; i++)
+        mNodes[i].Flags = 0;
+
+    mRoot = kNoNode;
+}
+
+/**
+ * Add a prefix to the trie, or update the value of a prefix already present.
+ *
+ * Bits of \c aPrefix.IPAddr beyond \c aPrefix.Length are ignored.
+ *
+ * @param[in]   aPrefix     The prefix to add.
+ * @param[in]   aValue      The value to return for addresses whose longest matching prefix is \c aPrefix.
+ *
+ * @retval  INET_NO_ERROR           On success.
+ * @retval  INET_ERROR_BAD_ARGS     If the prefix length is greater than 128.
+ * @retval  INET_ERROR_NO_MEMORY    If the trie has run out of nodes.
+ */
+INET_ERROR IPPrefixTrie::Add(const IPPrefix &aPrefix, uint8_t aValue)
+{
+    INET_ERROR err = INET_NO_ERROR;
+    const IPAddress key = MaskAddress(aPrefix.IPAddr, aPrefix.Length);
+    const uint8_t keyLen = aPrefix.Length;
+    uint8_t *link = &mRoot;
+    uint8_t newIndex;
+
+    VerifyOrExit(keyLen <= NL_INET_IPV6_MAX_PREFIX_LEN, err = INET_ERROR_BAD_ARGS);
+
+    while (*link != kNoNode)
+    {
+        Node &node = mNodes[*link];
+        uint8_t common = CommonPrefixLength(node.Prefix, key, (node.Length < keyLen) ? node.Length : keyLen);
+
+        if (common == node.Length && common == keyLen)
+        {
+            // The prefix is already present, possibly as an interior node without a value.
+            node.Value = aValue;
+            node.Flags |= kFlag_HasValue;
+            ExitNow();
+        }
+
+        if (common == node.Length)
+        {
+            // The node's prefix covers the new one; continue down the matching branch.
+            link = &node.Child[GetBit(key, common)];
+            continue;
+        }
+
+        if (common == keyLen)
+        {
+            // The new prefix covers the node; insert it above the node.
+            newIndex = AllocNode(key, keyLen);
+            VerifyOrExit(newIndex != kNoNode, err = INET_ERROR_NO_MEMORY);
+
+            mNodes[newIndex].Child[GetBit(node.Prefix, keyLen)] = *link;
+        }
+        else
+        {
+            // The prefixes diverge; insert a branch node at the point where they differ, with the node and the new
+            // prefix below it.
+            uint8_t branchIndex;
+            const uint8_t existingIndex = *link;
+
+            VerifyOrExit(NumFreeNodes() >= 2, err = INET_ERROR_NO_MEMORY);
+
+            branchIndex = AllocNode(MaskAddress(key, common), common);
+            newIndex = AllocNode(key, keyLen);
+
+            mNodes[branchIndex].Child[GetBit(key, common)] = newIndex;
+            mNodes[branchIndex].Child[GetBit(node.Prefix, common)] = existingIndex;
+
+            mNodes[newIndex].Value = aValue;
+            mNodes[newIndex].Flags |= kFlag_HasValue;
+
+            *link = branchIndex;
+            ExitNow();
+        }
+
+        break;
+    }
+
+    if (*link == kNoNode)
+    {
+        newIndex = AllocNode(key, keyLen);
+        VerifyOrExit(newIndex != kNoNode, err = INET_ERROR_NO_MEMORY);
+    }
+
+    mNodes[newIndex].Value = aValue;
+    mNodes[newIndex].Flags |= kFlag_HasValue;
+    *link = newIndex;
+
+exit:
+    return err;
+}
+
+/**
+ * Remove a prefix from the trie.
+ *
+ * @param[in]   aPrefix     The prefix to remove.  The length must match the one it was added with.
+ *
+ * @retval  INET_NO_ERROR                   On success.
+ * @retval  INET_ERROR_BAD_ARGS             If the prefix length is greater than 128.
+ * @retval  INET_ERROR_ADDRESS_NOT_FOUND    If the prefix is not in the trie.
+ */
+INET_ERROR IPPrefixTrie::Remove(const IPPrefix &aPrefix)
+{
+    INET_ERROR err = INET_NO_ERROR;
+    const IPAddress key = MaskAddress(aPrefix.IPAddr, aPrefix.Length);
+    const uint8_t keyLen = aPrefix.Length;
+    uint8_t *parentLink = NULL;
+    uint8_t *link = &mRoot;
+    uint8_t index;
+
+    VerifyOrExit(keyLen <= NL_INET_IPV6_MAX_PREFIX_LEN, err = INET_ERROR_BAD_ARGS);
+
+    // Find the node holding the prefix, remembering the link to its parent.
+    while (true)
+    {
+        VerifyOrExit(*link != kNoNode, err = INET_ERROR_ADDRESS_NOT_FOUND);
+
+        Node &node = mNodes[*link];
+
+        VerifyOrExit(node.Length <= keyLen && CommonPrefixLength(node.Prefix, key, node.Length) == node.Length,
+                     err = INET_ERROR_ADDRESS_NOT_FOUND);
+
+        if (node.Length == keyLen)
+            break;
+
+        parentLink = link;
+        link = &node.Child[GetBit(key, node.Length)];
+    }
+
+    index = *link;
+    VerifyOrExit(mNodes[index].Flags & kFlag_HasValue, err = INET_ERROR_ADDRESS_NOT_FOUND);
+
+    mNodes[index].Flags &= ~kFlag_HasValue;
+
+    // A node without a value is only needed while it has two children.
+    if (mNodes[index].Child[0] != kNoNode && mNodes[index].Child[1] != kNoNode)
+        ExitNow();
+
+    *link = (mNodes[index].Child[0] != kNoNode) ? mNodes[index].Child[0] : mNodes[index].Child[1];
+    FreeNode(index);
+
+    // Removing a leaf may leave its parent as a valueless node with a single child.
+    if (*link == kNoNode && parentLink != NULL)
+    {
+        Node &parent = mNodes[*parentLink];
+
+        if ((parent.Flags & kFlag_HasValue) == 0)
+        {
+            index = *parentLink;
+            *parentLink = (parent.Child[0] != kNoNode) ? parent.Child[0] : parent.Child[1];
+            FreeNode(index);
+        }
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * Find the longest prefix in the trie that matches an address.
+ *
+ * @param[in]   aAddr       The address to look up.
+ * @param[out]  aValue      The value of the longest matching prefix.  Unchanged if there is no match.
+ *
+ * @return  \c true if any prefix in the trie matches \c aAddr, else \c false.
+ */
+bool IPPrefixTrie::Lookup(const IPAddress &aAddr, uint8_t &aValue) const
+{
+    uint8_t length;
+
+    return Lookup(aAddr, aValue, length);
+}
+
+/**
+ * Find the longest prefix in the trie that matches an address.
+ *
+ * @param[in]   aAddr       The address to look up.
+ * @param[out]  aValue      The value of the longest matching prefix.  Unchanged if there is no match.
+ * @param[out]  aLength     The length of the longest matching prefix.  Unchanged if there is no match.
+ *
+ * @return  \c true if any prefix in the trie matches \c aAddr, else \c false.
+ */
+bool IPPrefixTrie::Lookup(const IPAddress &aAddr, uint8_t &aValue, uint8_t &aLength) const
+{
+    bool found = false;
+    uint8_t index = mRoot;
+
+    while (index != kNoNode)
+    {
+        const Node &node = mNodes[index];
+
+        if (CommonPrefixLength(node.Prefix, aAddr, node.Length) != node.Length)
+            break;
+
+        if (node.Flags & kFlag_HasValue)
+        {
+            aValue = node.Value;
+            aLength = node.Length;
+            found = true;
+        }
+
+        if (node.Length == NL_INET_IPV6_MAX_PREFIX_LEN)
+            break;
+
+        index = node.Child[GetBit(aAddr, node.Length)];
+    }
+
+    return found;
+}
+
+uint8_t IPPrefixTrie::AllocNode(const IPAddress &aPrefix, uint8_t aLength)
+{
+    for (uint8_t i = 0; i < mNumNodes; i++)
+    {
+        if ((mNodes[i].Flags & kFlag_InUse) == 0)
+        {
+            mNodes[i].Prefix = aPrefix;
+            mNodes[i].Length = aLength;
+            mNodes[i].Value = 0;
+            mNodes[i].Flags = kFlag_InUse;
+            mNodes[i].Child[0] = kNoNode;
+            mNodes[i].Child[1] = kNoNode;
+            return i;
+        }
+    }
+
+    return kNoNode;
+}
+
+uint8_t IPPrefixTrie::NumFreeNodes(void) const
+{
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < mNumNodes; i++)
+        if ((mNodes[i].Flags & kFlag_InUse) == 0)
+            count++;
+
+    return count;
+}
+
+void IPPrefixTrie::FreeNode(uint8_t aIndex)
+{
+    mNodes[aIndex].Flags = 0;
+}
+
+} // namespace Inet
+} // namespace nl
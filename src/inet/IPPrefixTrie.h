@@ -0,0 +1,110 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the class <tt>nl::Inet::IPPrefixTrie</tt>, a
+ *      compact longest-prefix-match table that maps Internet protocol
+ *      address prefixes to small application-defined values.
+ */
+
+#ifndef IPPREFIXTRIE_H
+#define IPPREFIXTRIE_H
+
+#include <InetLayer/IPPrefix.h>
+#include <InetLayer/InetError.h>
+
+namespace nl {
+namespace Inet {
+
+/**
+ * @brief   Longest-prefix-match table of Internet protocol address prefixes
+ *
+ * @details
+ *  The table is a path-compressed binary trie over the 128-bit representation of \c IPAddress, so IPv4 prefixes are
+ *  matched in the same way as by IPPrefix::MatchAddress().  Looking up an address visits at most one node per
+ *  distinct prefix length along its path, i.e. the cost is bounded by the prefix length rather than by the number
+ *  of prefixes in the table.
+ *
+ *  The table performs no dynamic allocation: nodes come from storage supplied to Init().  Holding N prefixes needs
+ *  at most <tt>IPPrefixTrie::NodesForPrefixes(N)</tt> nodes.
+ */
+class IPPrefixTrie
+{
+public:
+    /** One node of the trie.  Applications only provide storage for these. */
+    struct Node
+    {
+        IPAddress   Prefix;
+        uint8_t     Length;
+        uint8_t     Value;
+        uint8_t     Flags;
+        uint8_t     Child[2];
+    };
+
+    enum
+    {
+        kMaxNodes = 255     /**< The maximum number of nodes a single trie can use. */
+    };
+
+    /**
+     * The number of nodes needed to hold the given number of prefixes.
+     */
+    static inline uint16_t NodesForPrefixes(uint8_t aNumPrefixes) { return (aNumPrefixes > 0) ? 2 * aNumPrefixes - 1 : 0; }
+
+    void Init(Node *aNodes, uint8_t aNumNodes);
+    void Clear(void);
+
+    INET_ERROR Add(const IPPrefix &aPrefix, uint8_t aValue);
+    INET_ERROR Remove(const IPPrefix &aPrefix);
+
+    bool Lookup(const IPAddress &aAddr, uint8_t &aValue) const;
+    bool Lookup(const IPAddress &aAddr, uint8_t &aValue, uint8_t &aLength) const;
+
+    bool IsEmpty(void) const;
+
+private:
+    enum
+    {
+        kNoNode         = 0xFF,
+
+        kFlag_InUse     = 0x01,
+        kFlag_HasValue  = 0x02
+    };
+
+    Node *mNodes;
+    uint8_t mNumNodes;
+    uint8_t mRoot;
+
+    uint8_t AllocNode(const IPAddress &aPrefix, uint8_t aLength);
+    uint8_t NumFreeNodes(void) const;
+    void FreeNode(uint8_t aIndex);
+};
+
+/**
+ * Returns \c true if the trie holds no prefixes.
+ */
+inline bool IPPrefixTrie::IsEmpty(void) const
+{
+    return mRoot == kNoNode;
+}
+
+} // namespace Inet
+} // namespace nl
+
+#endif // !defined(IPPREFIXTRIE_H)
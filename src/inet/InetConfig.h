@@ -599,6 +599,239 @@
 #define INET_CONFIG_TUNNEL_DEVICE_NAME                      "/dev/net/tun"
 #endif //INET_CONFIG_TUNNEL_DEVICE_NAME
 
+/**
+ *  @def INET_CONFIG_TUN_READ_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of packets read from the tunnel device per
+ *    readable event.
+ *
+ *  @details
+ *    On sockets-based systems, a TunEndPoint drains up to this many
+ *    packets from the tun device each time it is reported readable,
+ *    rather than returning to select() after every packet. When the
+ *    value is greater than one the device is opened in non-blocking
+ *    mode so that the drain stops as soon as the queue is empty.
+ */
+#ifndef INET_CONFIG_TUN_READ_BATCH_SIZE
+#define INET_CONFIG_TUN_READ_BATCH_SIZE                     8
+#endif // INET_CONFIG_TUN_READ_BATCH_SIZE
+
+#if INET_CONFIG_TUN_READ_BATCH_SIZE < 1
+#error "INET_CONFIG_TUN_READ_BATCH_SIZE must be at least 1."
+#endif // INET_CONFIG_TUN_READ_BATCH_SIZE < 1
+
+/**
+ *  @def INET_CONFIG_TUN_SEND_MAX_IOV
+ *
+ *  @brief
+ *    The maximum number of buffers in a chained packet that a
+ *    TunEndPoint writes to the tunnel device with a single writev call.
+ *
+ *  @details
+ *    A tun device accepts exactly one packet per write, so the buffers
+ *    of a chained packet are gathered rather than flattened. Chains
+ *    longer than this are rejected with INET_ERROR_MESSAGE_TOO_LONG.
+ */
+#ifndef INET_CONFIG_TUN_SEND_MAX_IOV
+#define INET_CONFIG_TUN_SEND_MAX_IOV                        8
+#endif // INET_CONFIG_TUN_SEND_MAX_IOV
+
+#if INET_CONFIG_TUN_SEND_MAX_IOV < 1
+#error "INET_CONFIG_TUN_SEND_MAX_IOV must be at least 1."
+#endif // INET_CONFIG_TUN_SEND_MAX_IOV < 1
+
+/**
+ *  @def INET_CONFIG_TUN_ENABLE_MULTI_QUEUE
+ *
+ *  @brief
+ *    Defines whether (1) or not (0) tunnel devices are opened with
+ *    IFF_MULTI_QUEUE on Linux.
+ *
+ *  @details
+ *    A multi-queue tun interface may be attached to several file
+ *    descriptors, allowing independent TunEndPoint objects--for example,
+ *    one per InetLayer shard--to be opened on the same interface name
+ *    and share the forwarding load. Every queue attached to a given
+ *    interface must be opened with the same setting.
+ */
+#ifndef INET_CONFIG_TUN_ENABLE_MULTI_QUEUE
+#define INET_CONFIG_TUN_ENABLE_MULTI_QUEUE                  0
+#endif // INET_CONFIG_TUN_ENABLE_MULTI_QUEUE
+
+/**
+ *  @def INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+ *
+ *  @brief
+ *    When this flag is set, and the target system provides either
+ *    epoll (Linux) or kqueue (BSD and macOS), the InetLayer keeps
+ *    the sockets of its endpoints persistently registered with a
+ *    kernel event queue rather than rebuilding descriptor sets on
+ *    every pass through the event loop.
+ *
+ *  @details
+ *    When enabled, InetLayer::PrepareSelect contributes only the
+ *    descriptor of the kernel event queue to the select sets, and
+ *    InetLayer::HandleSelectResult harvests the ready endpoints from
+ *    the queue and dispatches only those. The number of endpoint
+ *    sockets is then no longer capped by FD_SETSIZE.
+ *
+ *    When this flag is clear, the traditional select path is used.
+ */
+#ifndef INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+#define INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER           0
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
+/**
+ *  @def INET_CONFIG_SOCKET_EVENT_NOTIFIER_MAX_EVENTS
+ *
+ *  @brief
+ *    The maximum number of ready endpoint events harvested from the
+ *    kernel event queue in a single call to
+ *    InetLayer::HandleSelectResult.
+ *
+ *  @details
+ *    Events that remain pending beyond this limit are harvested on the
+ *    next pass through the event loop.
+ */
+#ifndef INET_CONFIG_SOCKET_EVENT_NOTIFIER_MAX_EVENTS
+#define INET_CONFIG_SOCKET_EVENT_NOTIFIER_MAX_EVENTS       64
+#endif // INET_CONFIG_SOCKET_EVENT_NOTIFIER_MAX_EVENTS
+
+/**
+ *  @def INET_CONFIG_RECV_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams that a UDP or raw endpoint
+ *    drains from its socket each time it becomes readable.
+ *
+ *  @details
+ *    When this is greater than one and the target system provides
+ *    recvmmsg, the endpoint pre-allocates up to this many packet
+ *    buffers, receives into all of them with a single system call,
+ *    and then dispatches the datagrams to OnMessageReceived in the
+ *    order they arrived. Unused buffers are returned to the pool
+ *    immediately.
+ *
+ *    When this is one, or recvmmsg is not available, each readable
+ *    event receives a single datagram with recvmsg.
+ */
+#ifndef INET_CONFIG_RECV_BATCH_SIZE
+#define INET_CONFIG_RECV_BATCH_SIZE                        1
+#endif // INET_CONFIG_RECV_BATCH_SIZE
+
+/**
+ *  @def INET_CONFIG_UDP_SEND_BATCH_SIZE
+ *
+ *  @brief
+ *    The capacity of the deferred send queue of each UDP endpoint.
+ *
+ *  @details
+ *    When this is greater than one, messages sent on a UDP endpoint
+ *    with the \c kSendFlag_Deferred option are queued rather than
+ *    sent immediately. The queue is flushed when it fills, when the
+ *    endpoint is closed, when UDPEndPoint::FlushSendQueue is called,
+ *    and at the end of every InetLayer::HandleSelectResult. A flush
+ *    hands the whole queue to the kernel with a single sendmmsg call
+ *    where the target system provides it.
+ *
+ *    When this is one, deferred sends are sent immediately.
+ */
+#ifndef INET_CONFIG_UDP_SEND_BATCH_SIZE
+#define INET_CONFIG_UDP_SEND_BATCH_SIZE                    1
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE
+
+#if INET_CONFIG_UDP_SEND_BATCH_SIZE > 255
+#error "INET_CONFIG_UDP_SEND_BATCH_SIZE must not exceed 255."
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE > 255
+
+/**
+ *  @def INET_CONFIG_ENABLE_UDP_GSO
+ *
+ *  @brief
+ *    When this flag is set, and the target system supports the
+ *    UDP_SEGMENT socket option, a flush of the deferred send queue
+ *    passes consecutive equal-size messages to the same destination
+ *    to the kernel as a single segmentation offload (GSO) request.
+ *
+ *  @details
+ *    If the kernel or the outbound interface rejects a segmentation
+ *    request, the messages are sent individually and segmentation
+ *    is disabled for the endpoint.
+ */
+#ifndef INET_CONFIG_ENABLE_UDP_GSO
+#define INET_CONFIG_ENABLE_UDP_GSO                         1
+#endif // INET_CONFIG_ENABLE_UDP_GSO
+
+/**
+ *  @def INET_CONFIG_TCP_RECV_CHAIN_LENGTH
+ *
+ *  @brief
+ *    The number of fresh packet buffers that a TCP endpoint receives
+ *    into each time its socket becomes readable.
+ *
+ *  @details
+ *    When this is greater than one, the endpoint fills any space left
+ *    at the end of its receive queue, followed by a chain of up to
+ *    this many newly allocated buffers, with a single readv call.
+ *    Data already in the receive queue is not moved. Unused buffers
+ *    are returned to the pool immediately.
+ *
+ *    When this is one, each readable event receives into a single
+ *    buffer with recv, first compacting the last buffer of the
+ *    receive queue if it has room.
+ */
+#ifndef INET_CONFIG_TCP_RECV_CHAIN_LENGTH
+#define INET_CONFIG_TCP_RECV_CHAIN_LENGTH                  1
+#endif // INET_CONFIG_TCP_RECV_CHAIN_LENGTH
+
+#if INET_CONFIG_TCP_RECV_CHAIN_LENGTH < 1
+#error "INET_CONFIG_TCP_RECV_CHAIN_LENGTH must be at least 1."
+#endif // INET_CONFIG_TCP_RECV_CHAIN_LENGTH < 1
+
+/**
+ *  @def INET_CONFIG_TCP_SEND_CHAIN_LENGTH
+ *
+ *  @brief
+ *    The maximum number of buffers from the send queue of a TCP
+ *    endpoint that are handed to the kernel by a single system call.
+ *
+ *  @details
+ *    When this is greater than one, the endpoint gathers up to this
+ *    many buffers, and no more than the system's IOV_MAX, from the
+ *    head of its send queue and sends them with a single sendmsg
+ *    call. OnDataSent is still called once for each buffer, or part
+ *    of a buffer, that was sent.
+ *
+ *    When this is one, each buffer is sent with its own send call.
+ */
+#ifndef INET_CONFIG_TCP_SEND_CHAIN_LENGTH
+#define INET_CONFIG_TCP_SEND_CHAIN_LENGTH                  16
+#endif // INET_CONFIG_TCP_SEND_CHAIN_LENGTH
+
+#if INET_CONFIG_TCP_SEND_CHAIN_LENGTH < 1
+#error "INET_CONFIG_TCP_SEND_CHAIN_LENGTH must be at least 1."
+#endif // INET_CONFIG_TCP_SEND_CHAIN_LENGTH < 1
+
+/**
+ * @def INET_CONFIG_ENABLE_INTERFACE_CACHE
+ *
+ * @brief
+ *   When set, and the platform provides Linux rtnetlink, InterfaceIterator
+ *   and InterfaceAddressIterator share a cached snapshot of the system's
+ *   interfaces and addresses.
+ *
+ * @details
+ *   The snapshot is taken lazily and retaken only after a netlink link or
+ *   address notification (RTM_NEWLINK, RTM_DELLINK, RTM_NEWADDR,
+ *   RTM_DELADDR) has been received, so constructing an iterator does not
+ *   normally enumerate the interfaces again.  The cost is one netlink socket
+ *   per process.
+ */
+#ifndef INET_CONFIG_ENABLE_INTERFACE_CACHE
+#define INET_CONFIG_ENABLE_INTERFACE_CACHE                 1
+#endif // INET_CONFIG_ENABLE_INTERFACE_CACHE
+
 /**
  * @def INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
  *
@@ -613,11 +846,89 @@
  *
  * @brief The maximum number of POSIX threads that would be performing
  * asynchronous DNS resolution.
+ *
+ * @details
+ *   This many threads are started unless a smaller number is passed to
+ *   the InetLayer::Init() overload that takes a DNS thread count.
  */
 #ifndef INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT
 #define INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT             2
 #endif // INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT
 
+#if INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT < 1 || INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT > 255
+#error "INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT must be between 1 and 255."
+#endif // INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT < 1 || INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT > 255
+
+/**
+ * @def INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS
+ *
+ * @brief The time, in milliseconds, after which an asynchronous DNS
+ * request that has not completed is failed with #INET_ERROR_DNS_TRY_AGAIN.
+ *
+ * @details
+ *   A timed out request that is still waiting for a worker thread is
+ *   withdrawn from the queue; one whose getaddrinfo() call is in progress
+ *   is abandoned and its result discarded.  Set to 0 to let requests wait
+ *   for as long as the system resolver takes.
+ */
+#ifndef INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS
+#define INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS           0
+#endif // INET_CONFIG_DNS_ASYNC_RESOLVE_TIMEOUT_MS
+
+/**
+ * @def INET_CONFIG_DNS_CACHE_SIZE
+ *
+ * @brief The number of host name resolution results remembered by the
+ * asynchronous DNS resolver for Linux sockets.
+ *
+ * @details
+ *   While a lookup for a host name is in progress, further requests for the
+ *   same name and address family are attached to it rather than queued for
+ *   another getaddrinfo() call.  Once it completes, successful results are
+ *   served from the cache for #INET_CONFIG_DNS_CACHE_TTL_MS and "host not
+ *   found" results for #INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS.  Transient
+ *   failures are never cached.
+ *
+ *   Set to 0 to disable the cache and request coalescing.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_SIZE
+#define INET_CONFIG_DNS_CACHE_SIZE                         8
+#endif // INET_CONFIG_DNS_CACHE_SIZE
+
+/**
+ * @def INET_CONFIG_DNS_CACHE_TTL_MS
+ *
+ * @brief The time, in milliseconds, for which a successful DNS result is
+ * served from the cache.
+ *
+ * @details
+ *   getaddrinfo() does not report record TTLs, so this acts as the TTL of
+ *   every cached record and should be kept no longer than the shortest
+ *   record TTL the application is expected to honor.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_TTL_MS
+#define INET_CONFIG_DNS_CACHE_TTL_MS                       30000
+#endif // INET_CONFIG_DNS_CACHE_TTL_MS
+
+/**
+ * @def INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS
+ *
+ * @brief The time, in milliseconds, for which a "host not found" DNS result
+ * is served from the cache.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS
+#define INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS              5000
+#endif // INET_CONFIG_DNS_CACHE_NEGATIVE_TTL_MS
+
+/**
+ * @def INET_CONFIG_DNS_CACHE_MAX_ADDRS
+ *
+ * @brief The maximum number of addresses remembered for each cached host name.
+ */
+#ifndef INET_CONFIG_DNS_CACHE_MAX_ADDRS
+#define INET_CONFIG_DNS_CACHE_MAX_ADDRS                    INET_CONFIG_MAX_DNS_ADDRS
+#endif // INET_CONFIG_DNS_CACHE_MAX_ADDRS
+
 /**
  *  @def INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
  *
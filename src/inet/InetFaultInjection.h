@@ -67,7 +67,12 @@ NL_DLL_EXPORT nl::FaultInjection::Manager &GetManager(void);
  * @param[in] aStatements   Statements to be executed if the fault is enabled.
  */
 #define INET_FAULT_INJECT( aFaultID, aStatement ) \
-        nlFAULT_INJECT(nl::Inet::FaultInjection::GetManager(), aFaultID, aStatement)
+    do { \
+        if (WEAVE_SYSTEM_FAULT_INJECTION_ARMED()) \
+        { \
+            nlFAULT_INJECT(nl::Inet::FaultInjection::GetManager(), aFaultID, aStatement); \
+        } \
+    } while (0)
 
 #else // INET_CONFIG_TEST
 
@@ -58,6 +58,11 @@
 #else // !defined(__ANDROID__)
 #include <ifaddrs.h>
 #endif // !defined(__ANDROID__)
+#if INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+#include <pthread.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#endif // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 namespace nl {
@@ -353,12 +358,257 @@ exit:
 
 #endif // __ANDROID__ && __ANDROID_API__ < 24
 
+static struct if_nameindex * GetNameIndex(void)
+{
+#if __ANDROID__ && __ANDROID_API__ < 24
+    return backport_if_nameindex();
+#else
+    return if_nameindex();
+#endif
+}
+
+static void FreeNameIndex(struct if_nameindex * inArray)
+{
+#if __ANDROID__ && __ANDROID_API__ < 24
+    backport_if_freenameindex(inArray);
+#else
+    if_freenameindex(inArray);
+#endif
+}
+
+#if INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+
+/**
+ * @brief   A reference counted, immutable snapshot of the system's network
+ *          interfaces and their addresses.
+ *
+ * @details
+ *  The iterators share the most recent snapshot rather than calling
+ *  if_nameindex(), getifaddrs() and per-interface ioctls each time one is
+ *  constructed.  A netlink socket subscribed to link and address change
+ *  notifications tells us when the snapshot has gone stale; it is drained,
+ *  without blocking, whenever an iterator starts.
+ */
+struct InterfaceSnapshot
+{
+    volatile int32_t        RefCount;
+    struct if_nameindex *   IntfArray;      ///< As returned by if_nameindex().
+    short *                 IntfFlags;      ///< SIOCGIFFLAGS result for each IntfArray entry.
+    struct ifaddrs *        AddrsList;      ///< As returned by getifaddrs().
+    InterfaceId *           AddrIntfIds;    ///< Interface index of each AddrsList entry, in list order.
+};
+
+static pthread_mutex_t sSnapshotLock = PTHREAD_MUTEX_INITIALIZER;
+static InterfaceSnapshot * sSnapshot = NULL;
+static bool sSnapshotStale = true;
+static int sNetlinkSocket = -1;
+
+static void FreeInterfaceSnapshot(InterfaceSnapshot * aSnapshot)
+{
+    if (aSnapshot->IntfArray != NULL)
+        FreeNameIndex(aSnapshot->IntfArray);
+    if (aSnapshot->AddrsList != NULL)
+        freeifaddrs(aSnapshot->AddrsList);
+    free(aSnapshot->IntfFlags);
+    free(aSnapshot->AddrIntfIds);
+    free(aSnapshot);
+}
+
+static InterfaceSnapshot * NewInterfaceSnapshot(void)
+{
+    InterfaceSnapshot * lSnapshot = static_cast<InterfaceSnapshot *>(calloc(1, sizeof(InterfaceSnapshot)));
+    size_t lNumIntfs = 0;
+    size_t lNumAddrs = 0;
+    size_t i;
+    struct ifaddrs * lAddr;
+
+    VerifyOrExit(lSnapshot != NULL, );
+
+    lSnapshot->RefCount = 1;
+
+    lSnapshot->IntfArray = GetNameIndex();
+    VerifyOrExit(lSnapshot->IntfArray != NULL, );
+
+    VerifyOrExit(getifaddrs(&lSnapshot->AddrsList) == 0, lSnapshot->AddrsList = NULL);
+
+    while (lSnapshot->IntfArray[lNumIntfs].if_index != 0)
+        lNumIntfs++;
+
+    for (lAddr = lSnapshot->AddrsList; lAddr != NULL; lAddr = lAddr->ifa_next)
+        lNumAddrs++;
+
+    lSnapshot->IntfFlags = static_cast<short *>(calloc(lNumIntfs + 1, sizeof(short)));
+    lSnapshot->AddrIntfIds = static_cast<InterfaceId *>(calloc(lNumAddrs + 1, sizeof(InterfaceId)));
+    VerifyOrExit(lSnapshot->IntfFlags != NULL && lSnapshot->AddrIntfIds != NULL, );
+
+    for (i = 0; i < lNumIntfs; i++)
+    {
+        struct ifreq intfData;
+
+        strncpy(intfData.ifr_name, lSnapshot->IntfArray[i].if_name, IFNAMSIZ);
+        intfData.ifr_name[IFNAMSIZ-1] = '\0';
+
+        if (ioctl(GetIOCTLSocket(), SIOCGIFFLAGS, &intfData) == 0)
+        {
+            lSnapshot->IntfFlags[i] = intfData.ifr_flags;
+        }
+    }
+
+    // Resolve each address's interface index against the name index taken above,
+    // rather than with an if_nametoindex() call per lookup.
+    for (lAddr = lSnapshot->AddrsList, i = 0; lAddr != NULL; lAddr = lAddr->ifa_next, i++)
+    {
+        for (size_t j = 0; j < lNumIntfs; j++)
+        {
+            if (strcmp(lAddr->ifa_name, lSnapshot->IntfArray[j].if_name) == 0)
+            {
+                lSnapshot->AddrIntfIds[i] = lSnapshot->IntfArray[j].if_index;
+                break;
+            }
+        }
+
+        if (lSnapshot->AddrIntfIds[i] == INET_NULL_INTERFACEID)
+        {
+            lSnapshot->AddrIntfIds[i] = if_nametoindex(lAddr->ifa_name);
+        }
+    }
+
+    return lSnapshot;
+
+exit:
+    if (lSnapshot != NULL)
+        FreeInterfaceSnapshot(lSnapshot);
+    return NULL;
+}
+
+/*
+ * Drain pending notifications from the netlink socket, opening it first if
+ * need be. Returns true if the interface or address configuration may have
+ * changed since the last call, which includes the case where no netlink socket
+ * could be opened. Called with sSnapshotLock held.
+ */
+static bool InterfacesChanged(void)
+{
+    bool lChanged = false;
+    uint8_t lBuf[4096];
+
+    if (sNetlinkSocket == -1)
+    {
+        struct sockaddr_nl lAddr;
+        int s = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+
+        if (s < 0)
+            return true;
+
+        memset(&lAddr, 0, sizeof(lAddr));
+        lAddr.nl_family = AF_NETLINK;
+        lAddr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+
+        if (bind(s, reinterpret_cast<struct sockaddr *>(&lAddr), sizeof(lAddr)) != 0)
+        {
+            close(s);
+            return true;
+        }
+
+        sNetlinkSocket = s;
+
+        // Anything that happened before the socket existed is unknown.
+        lChanged = true;
+    }
+
+    while (true)
+    {
+        ssize_t n = recv(sNetlinkSocket, lBuf, sizeof(lBuf), MSG_DONTWAIT);
+
+        if (n > 0)
+        {
+            // Any RTM_NEWLINK, RTM_DELLINK, RTM_NEWADDR or RTM_DELADDR message
+            // in the subscribed groups invalidates the snapshot.
+            lChanged = true;
+        }
+        else if (n < 0 && errno == ENOBUFS)
+        {
+            // Notifications were dropped, so assume the worst.
+            lChanged = true;
+        }
+        else if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    return lChanged;
+}
+
+static InterfaceSnapshot * AcquireInterfaceSnapshot(void)
+{
+    InterfaceSnapshot * lSnapshot;
+
+    pthread_mutex_lock(&sSnapshotLock);
+
+    if (InterfacesChanged())
+    {
+        sSnapshotStale = true;
+    }
+
+    if (sSnapshotStale)
+    {
+        lSnapshot = NewInterfaceSnapshot();
+
+        // If the new snapshot cannot be taken, keep serving the old one and retry next time.
+        if (lSnapshot != NULL)
+        {
+            sSnapshotStale = false;
+
+            if (sSnapshot != NULL && __sync_sub_and_fetch(&sSnapshot->RefCount, 1) == 0)
+            {
+                FreeInterfaceSnapshot(sSnapshot);
+            }
+
+            // Without a netlink socket, changes cannot be detected, so the snapshot is not kept.
+            if (sNetlinkSocket == -1)
+            {
+                sSnapshot = NULL;
+                pthread_mutex_unlock(&sSnapshotLock);
+                return lSnapshot;
+            }
+
+            sSnapshot = lSnapshot;
+        }
+    }
+
+    lSnapshot = sSnapshot;
+    if (lSnapshot != NULL)
+    {
+        __sync_add_and_fetch(&lSnapshot->RefCount, 1);
+    }
+
+    pthread_mutex_unlock(&sSnapshotLock);
+
+    return lSnapshot;
+}
+
+static void ReleaseInterfaceSnapshot(InterfaceSnapshot * aSnapshot)
+{
+    if (aSnapshot != NULL && __sync_sub_and_fetch(&aSnapshot->RefCount, 1) == 0)
+    {
+        FreeInterfaceSnapshot(aSnapshot);
+    }
+}
+
+#endif // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+
 InterfaceIterator::InterfaceIterator(void)
 {
     mIntfArray = NULL;
     mCurIntf = 0;
     mIntfFlags = 0;
     mIntfFlagsCached = 0;
+    mSnapshot = NULL;
 }
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -376,15 +626,17 @@ InterfaceIterator::InterfaceIterator(void)
 
 InterfaceIterator::~InterfaceIterator(void)
 {
+#if INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+    ReleaseInterfaceSnapshot(mSnapshot);
+    mSnapshot = NULL;
+    mIntfArray = NULL;
+#else // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
     if (mIntfArray != NULL)
     {
-#if __ANDROID__ && __ANDROID_API__ < 24
-        backport_if_freenameindex(mIntfArray);
-#else
-        if_freenameindex(mIntfArray);
-#endif
+        FreeNameIndex(mIntfArray);
         mIntfArray = NULL;
     }
+#endif // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
 }
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -435,11 +687,15 @@ bool InterfaceIterator::Next(void)
 
     if (mIntfArray == NULL)
     {
-#if __ANDROID__ && __ANDROID_API__ < 24
-        mIntfArray = backport_if_nameindex();
-#else
-        mIntfArray = if_nameindex();
-#endif
+#if INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+        if (mSnapshot == NULL)
+        {
+            mSnapshot = AcquireInterfaceSnapshot();
+        }
+        mIntfArray = (mSnapshot != NULL) ? mSnapshot->IntfArray : NULL;
+#else // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+        mIntfArray = GetNameIndex();
+#endif // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
     }
     else if (mIntfArray[mCurIntf].if_index != 0)
     {
@@ -606,6 +862,14 @@ short InterfaceIterator::GetFlags(void)
 {
     struct ifreq intfData;
 
+#if INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+    if (!mIntfFlagsCached && HasCurrent())
+    {
+        mIntfFlags = mSnapshot->IntfFlags[mCurIntf];
+        mIntfFlagsCached = true;
+    }
+#endif // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+
     if (!mIntfFlagsCached && HasCurrent())
     {
     	strncpy(intfData.ifr_name, mIntfArray[mCurIntf].if_name, IFNAMSIZ);
@@ -640,6 +904,8 @@ InterfaceAddressIterator::InterfaceAddressIterator(void)
 {
     mAddrsList = NULL;
     mCurAddr = NULL;
+    mCurAddrPos = 0;
+    mSnapshot = NULL;
 }
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -658,11 +924,17 @@ InterfaceAddressIterator::InterfaceAddressIterator(void)
 
 InterfaceAddressIterator::~InterfaceAddressIterator(void)
 {
+#if INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+    ReleaseInterfaceSnapshot(mSnapshot);
+    mSnapshot = NULL;
+    mAddrsList = mCurAddr = NULL;
+#else // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
     if (mAddrsList != NULL)
     {
         freeifaddrs(mAddrsList);
         mAddrsList = mCurAddr = NULL;
     }
+#endif // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
 }
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -714,16 +986,30 @@ bool InterfaceAddressIterator::Next(void)
     {
         if (mAddrsList == NULL)
         {
+#if INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+            if (mSnapshot == NULL)
+            {
+                mSnapshot = AcquireInterfaceSnapshot();
+            }
+            if (mSnapshot == NULL || mSnapshot->AddrsList == NULL)
+            {
+                return false;
+            }
+            mAddrsList = mSnapshot->AddrsList;
+#else // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
             int res = getifaddrs(&mAddrsList);
             if (res < 0)
             {
                 return false;
             }
+#endif // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
             mCurAddr = mAddrsList;
+            mCurAddrPos = 0;
         }
         else if (mCurAddr != NULL)
         {
             mCurAddr = mCurAddr->ifa_next;
+            mCurAddrPos++;
         }
 
         if (mCurAddr == NULL)
@@ -880,7 +1166,11 @@ InterfaceId InterfaceAddressIterator::GetInterfaceId(void)
     if (HasCurrent())
     {
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
+        return mSnapshot->AddrIntfIds[mCurAddrPos];
+#else // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
         return if_nametoindex(mCurAddr->ifa_name);
+#endif // INET_CONFIG_ENABLE_INTERFACE_CACHE && HAVE_LINUX_RTNETLINK_H
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
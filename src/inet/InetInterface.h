@@ -48,6 +48,10 @@ namespace Inet {
 class IPAddress;
 class IPPrefix;
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+struct InterfaceSnapshot;
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
 
 /**
  * @typedef     InterfaceId
@@ -122,7 +126,10 @@ extern uint8_t NetmaskToPrefixLength(const uint8_t * netmask, uint16_t netmaskLe
  *  themselves are never destroyed.
  *
  *  On sockets-based systems, iteration is always stable in the face of changes
- *  to the underlying system's interfaces.
+ *  to the underlying system's interfaces. On Linux, when
+ *  #INET_CONFIG_ENABLE_INTERFACE_CACHE is set, iterators share a cached
+ *  snapshot of the interface list that is only refreshed after netlink reports
+ *  a link or address change.
  *
  *  On LwIP systems, iteration is stable except in the case where the currently
  *  selected interface is removed from the list, in which case iteration ends
@@ -153,6 +160,7 @@ protected:
     size_t mCurIntf;
     short mIntfFlags;
     bool mIntfFlagsCached;
+    InterfaceSnapshot * mSnapshot;
 
     short GetFlags(void);
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -213,6 +221,8 @@ private:
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     struct ifaddrs * mAddrsList;
     struct ifaddrs * mCurAddr;
+    size_t mCurAddrPos;
+    InterfaceSnapshot * mSnapshot;
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 };
 
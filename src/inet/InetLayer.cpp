@@ -72,6 +72,19 @@
 #endif // __ANDROID__
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+#if HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#define INET_SOCKET_EVENT_NOTIFIER_EPOLL 1
+#elif HAVE_SYS_EVENT_H
+#include <sys/types.h>
+#include <sys/event.h>
+#define INET_SOCKET_EVENT_NOTIFIER_KQUEUE 1
+#else
+#error "INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER requires either <sys/epoll.h> or <sys/event.h>"
+#endif // HAVE_SYS_EPOLL_H
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
 #if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP && !INET_CONFIG_WILL_OVERRIDE_PLATFORM_EVENT_FUNCS
 
@@ -129,6 +142,10 @@ InetLayer::InetLayer(void)
 {
     State = kState_NotInitialized;
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+    mEventNotifierFD = INET_INVALID_SOCKET_FD;
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     if (!sInetEventHandlerDelegate.IsInitialized())
         sInetEventHandlerDelegate.Init(HandleInetLayerEvent);
@@ -296,6 +313,22 @@ INET_ERROR InetLayer::Init(Weave::System::Layer& aSystemLayer, void *aContext)
     mSystemLayer = &aSystemLayer;
     mContext = aContext;
 
+#if INET_CONFIG_ENABLE_DNS_RESOLVER
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kInetLayer_NumDNSResolvers, DNSResolver::sPool.Size());
+#endif // INET_CONFIG_ENABLE_DNS_RESOLVER
+#if INET_CONFIG_ENABLE_TCP_ENDPOINT
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kInetLayer_NumTCPEps, TCPEndPoint::sPool.Size());
+#endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kInetLayer_NumUDPEps, UDPEndPoint::sPool.Size());
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
+#if INET_CONFIG_ENABLE_RAW_ENDPOINT
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kInetLayer_NumRawEps, RawEndPoint::sPool.Size());
+#endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
+#if INET_CONFIG_ENABLE_TUN_ENDPOINT
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kInetLayer_NumTunEps, TunEndPoint::sPool.Size());
+#endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     err = InitQueueLimiter();
     SuccessOrExit(err);
@@ -303,6 +336,11 @@ INET_ERROR InetLayer::Init(Weave::System::Layer& aSystemLayer, void *aContext)
     mSystemLayer->AddEventHandlerDelegate(sInetEventHandlerDelegate);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+    err = InitSocketEventNotifier();
+    SuccessOrExit(err);
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
     State = kState_Initialized;
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -319,6 +357,41 @@ INET_ERROR InetLayer::Init(Weave::System::Layer& aSystemLayer, void *aContext)
     return err;
 }
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+/**
+ *  This is the InetLayer explicit initializer, as above, that also sets the
+ *  number of threads performing asynchronous DNS resolution.
+ *
+ *  @param[in]  aSystemLayer     A required instance of the Weave System Layer
+ *                               already successfully initialized.
+ *
+ *  @param[in]  aContext         An optional context argument which will be
+ *                               passed back to the caller via any
+ *                               platform-specific hook functions.
+ *
+ *  @param[in]  aDNSThreadCount  The number of DNS worker threads to start,
+ *                               from 1 to #INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT.
+ *                               It applies until the next Shutdown().
+ *
+ *  @retval   #INET_ERROR_BAD_ARGS               If aDNSThreadCount is out
+ *                                               of range.
+ *  @retval   other values as for Init(Weave::System::Layer&, void*).
+ *
+ */
+INET_ERROR InetLayer::Init(Weave::System::Layer& aSystemLayer, void *aContext, uint8_t aDNSThreadCount)
+{
+    if (State != kState_NotInitialized)
+        return INET_ERROR_INCORRECT_STATE;
+
+    if (aDNSThreadCount == 0 || aDNSThreadCount > INET_CONFIG_DNS_ASYNC_MAX_THREAD_COUNT)
+        return INET_ERROR_BAD_ARGS;
+
+    mAsyncDNSResolver.mNumThreads = aDNSThreadCount;
+
+    return Init(aSystemLayer, aContext);
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+
 /**
  *  This is the InetLayer explicit deinitializer and should be called
  *  prior to disposing of an instantiated InetLayer instance.
@@ -397,6 +470,10 @@ INET_ERROR InetLayer::Shutdown(void)
         }
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+        ShutdownSocketEventNotifier();
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
 #if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
         if (mSystemLayer == &mImplicitSystemLayer)
         {
@@ -997,6 +1074,36 @@ void InetLayer::CancelResolveHostAddress(DNSResolveCompleteFunct onComplete, voi
     }
 }
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+/**
+ *  Get the counters describing the asynchronous DNS request queue and
+ *  lookup latency since the InetLayer was initialized.
+ *
+ *  @param[out]   outStats     The queue depth, wait time and lookup time
+ *                             counters.
+ *
+ */
+void InetLayer::GetDNSQueueStats(DNSQueueStats &outStats)
+{
+    mAsyncDNSResolver.GetQueueStats(outStats);
+}
+
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+/**
+ *  Get the counters describing how host name resolution requests have been
+ *  satisfied by the DNS cache since the InetLayer was initialized.
+ *
+ *  @param[out]   outStats     The cache hit, negative hit, coalesced and
+ *                             miss counts.
+ *
+ */
+void InetLayer::GetDNSCacheStats(DNSCacheStats &outStats)
+{
+    mAsyncDNSResolver.GetCacheStats(outStats);
+}
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
 #if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
@@ -1434,7 +1541,13 @@ void InetLayer::PrepareSelect(int& nfds, fd_set *readfds, fd_set *writefds, fd_s
     {
         RawEndPoint* lEndPoint = RawEndPoint::sPool.Get(*mSystemLayer, i);
         if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
+        {
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+            WatchSocket(*lEndPoint, lEndPoint->PrepareIO());
+#else // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
             lEndPoint->PrepareIO().SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
+#endif // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+        }
     }
 #endif // INET_CONFIG_ENABLE_RAW_ENDPOINT
 
@@ -1443,7 +1556,13 @@ void InetLayer::PrepareSelect(int& nfds, fd_set *readfds, fd_set *writefds, fd_s
     {
         TCPEndPoint* lEndPoint = TCPEndPoint::sPool.Get(*mSystemLayer, i);
         if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
+        {
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+            WatchSocket(*lEndPoint, lEndPoint->PrepareIO());
+#else // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
             lEndPoint->PrepareIO().SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
+#endif // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+        }
     }
 #endif // INET_CONFIG_ENABLE_TCP_ENDPOINT
 
@@ -1452,7 +1571,13 @@ void InetLayer::PrepareSelect(int& nfds, fd_set *readfds, fd_set *writefds, fd_s
     {
         UDPEndPoint* lEndPoint = UDPEndPoint::sPool.Get(*mSystemLayer, i);
         if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
+        {
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+            WatchSocket(*lEndPoint, lEndPoint->PrepareIO());
+#else // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
             lEndPoint->PrepareIO().SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
+#endif // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+        }
     }
 #endif // INET_CONFIG_ENABLE_UDP_ENDPOINT
 
@@ -1461,10 +1586,23 @@ void InetLayer::PrepareSelect(int& nfds, fd_set *readfds, fd_set *writefds, fd_s
     {
         TunEndPoint* lEndPoint = TunEndPoint::sPool.Get(*mSystemLayer, i);
         if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
+        {
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+            WatchSocket(*lEndPoint, lEndPoint->PrepareIO());
+#else // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
             lEndPoint->PrepareIO().SetFDs(lEndPoint->mSocket, nfds, readfds, writefds, exceptfds);
+#endif // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+        }
     }
 #endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
 
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+    // The endpoint sockets are watched by the kernel event queue; only its descriptor need be selected upon.
+    FD_SET(mEventNotifierFD, readfds);
+    if (mEventNotifierFD + 1 > nfds)
+        nfds = mEventNotifierFD + 1;
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
 #if INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
     if (mSystemLayer == &mImplicitSystemLayer)
     {
@@ -1510,6 +1648,13 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
 
     if (selectRes > 0)
     {
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+        // Set the pending I/O field for each ready endpoint based on the events reported by the kernel event queue.
+        if (FD_ISSET(mEventNotifierFD, readfds))
+        {
+            HandleSocketEventNotifications();
+        }
+#else // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
         // Set the pending I/O field for each active endpoint based on the value returned by select.
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
         for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
@@ -1554,13 +1699,14 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
             }
         }
 #endif // INET_CONFIG_ENABLE_TUN_ENDPOINT
+#endif // !INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
 
-        // Now call each active endpoint to handle its pending I/O.
+        // Now call each active endpoint with pending I/O to handle it.
 #if INET_CONFIG_ENABLE_RAW_ENDPOINT
         for (size_t i = 0; i < RawEndPoint::sPool.Size(); i++)
         {
             RawEndPoint* lEndPoint = RawEndPoint::sPool.Get(*mSystemLayer, i);
-            if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
+            if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this) && lEndPoint->mPendingIO.IsSet())
             {
                 lEndPoint->HandlePendingIO();
             }
@@ -1571,7 +1717,7 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
         for (size_t i = 0; i < TCPEndPoint::sPool.Size(); i++)
         {
             TCPEndPoint* lEndPoint = TCPEndPoint::sPool.Get(*mSystemLayer, i);
-            if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
+            if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this) && lEndPoint->mPendingIO.IsSet())
             {
                 lEndPoint->HandlePendingIO();
             }
@@ -1582,7 +1728,7 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
         for (size_t i = 0; i < UDPEndPoint::sPool.Size(); i++)
         {
             UDPEndPoint* lEndPoint = UDPEndPoint::sPool.Get(*mSystemLayer, i);
-            if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
+            if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this) && lEndPoint->mPendingIO.IsSet())
             {
                 lEndPoint->HandlePendingIO();
             }
@@ -1593,7 +1739,7 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
         for (size_t i = 0; i < TunEndPoint::sPool.Size(); i++)
         {
             TunEndPoint* lEndPoint = TunEndPoint::sPool.Get(*mSystemLayer, i);
-            if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this))
+            if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this) && lEndPoint->mPendingIO.IsSet())
             {
                 lEndPoint->HandlePendingIO();
             }
@@ -1607,7 +1753,252 @@ void InetLayer::HandleSelectResult(int selectRes, fd_set *readfds, fd_set *write
         mSystemLayer->HandleSelectResult(selectRes, readfds, writefds, exceptfds);
     }
 #endif // INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
+
+#if INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+    // Send the messages deferred by the handlers run during this iteration of the event loop.
+    for (size_t i = 0; i < UDPEndPoint::sPool.Size(); i++)
+    {
+        UDPEndPoint* lEndPoint = UDPEndPoint::sPool.Get(*mSystemLayer, i);
+        if ((lEndPoint != NULL) && lEndPoint->IsCreatedByInetLayer(*this) && lEndPoint->HasQueuedSends())
+        {
+            lEndPoint->FlushSendQueue();
+        }
+    }
+#endif // INET_CONFIG_ENABLE_UDP_ENDPOINT && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+}
+
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+/**
+ *  Create the kernel event queue (epoll or kqueue) used to watch the
+ *  sockets of the endpoints owned by this InetLayer instance.
+ *
+ *  @return #INET_NO_ERROR on success; otherwise, the mapped POSIX error.
+ *
+ */
+INET_ERROR InetLayer::InitSocketEventNotifier(void)
+{
+    INET_ERROR err = INET_NO_ERROR;
+
+#if INET_SOCKET_EVENT_NOTIFIER_EPOLL
+#ifdef EPOLL_CLOEXEC
+    mEventNotifierFD = ::epoll_create1(EPOLL_CLOEXEC);
+#else
+    mEventNotifierFD = ::epoll_create(INET_CONFIG_SOCKET_EVENT_NOTIFIER_MAX_EVENTS);
+#endif // EPOLL_CLOEXEC
+#elif INET_SOCKET_EVENT_NOTIFIER_KQUEUE
+    mEventNotifierFD = ::kqueue();
+#endif // INET_SOCKET_EVENT_NOTIFIER_KQUEUE
+
+    VerifyOrExit(mEventNotifierFD >= 0, err = Weave::System::MapErrorPOSIX(errno));
+
+exit:
+    return err;
+}
+
+/**
+ *  Close the kernel event queue used to watch endpoint sockets.
+ *
+ */
+void InetLayer::ShutdownSocketEventNotifier(void)
+{
+    if (mEventNotifierFD != INET_INVALID_SOCKET_FD)
+    {
+        ::close(mEventNotifierFD);
+        mEventNotifierFD = INET_INVALID_SOCKET_FD;
+    }
+}
+
+/**
+ *  Bring the kernel event queue registration of an endpoint socket in line
+ *  with the I/O events the endpoint is currently interested in.
+ *
+ *  The kernel is only consulted when the socket or the requested events
+ *  differ from what was last registered. Registrations with no events of
+ *  interest are removed altogether so that hang-up conditions on idle
+ *  sockets do not repeatedly wake the event loop.
+ *
+ *  @param[in]    aEndPoint    The endpoint whose socket is to be watched.
+ *
+ *  @param[in]    aEvents      The I/O events of interest.
+ *
+ */
+void InetLayer::WatchSocket(EndPointBasis& aEndPoint, SocketEvents aEvents)
+{
+    int lOSReturn = 0;
+
+    if (aEndPoint.mSocket == INET_INVALID_SOCKET_FD)
+        return;
+
+    if (aEndPoint.mWatchedSocket == aEndPoint.mSocket && aEndPoint.mWatchedEvents.Value == aEvents.Value)
+        return;
+
+    if (aEndPoint.mWatchedSocket != INET_INVALID_SOCKET_FD && aEndPoint.mWatchedSocket != aEndPoint.mSocket)
+        UnwatchSocket(aEndPoint);
+
+    if (!aEvents.IsSet())
+    {
+        UnwatchSocket(aEndPoint);
+        return;
+    }
+
+#if INET_SOCKET_EVENT_NOTIFIER_EPOLL
+    {
+        struct epoll_event lEvent;
+        const int lOperation = (aEndPoint.mWatchedSocket == aEndPoint.mSocket) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+
+        memset(&lEvent, 0, sizeof(lEvent));
+        if (aEvents.IsReadable())
+            lEvent.events |= EPOLLIN;
+        if (aEvents.IsWriteable())
+            lEvent.events |= EPOLLOUT;
+        if (aEvents.IsError())
+            lEvent.events |= EPOLLPRI;
+        lEvent.data.ptr = &aEndPoint;
+
+        lOSReturn = ::epoll_ctl(mEventNotifierFD, lOperation, aEndPoint.mSocket, &lEvent);
+    }
+#elif INET_SOCKET_EVENT_NOTIFIER_KQUEUE
+    {
+        struct kevent lChanges[2];
+        const bool lWasWatched = (aEndPoint.mWatchedSocket == aEndPoint.mSocket);
+        int lNumChanges = 0;
+
+        // kqueue has no separate exceptional-condition filter; error interest is folded into the read filter.
+        if (aEvents.IsReadable() || aEvents.IsError())
+        {
+            EV_SET(&lChanges[lNumChanges++], aEndPoint.mSocket, EVFILT_READ, EV_ADD, 0, 0, &aEndPoint);
+        }
+        else if (lWasWatched && (aEndPoint.mWatchedEvents.IsReadable() || aEndPoint.mWatchedEvents.IsError()))
+        {
+            EV_SET(&lChanges[lNumChanges++], aEndPoint.mSocket, EVFILT_READ, EV_DELETE, 0, 0, &aEndPoint);
+        }
+
+        if (aEvents.IsWriteable())
+        {
+            EV_SET(&lChanges[lNumChanges++], aEndPoint.mSocket, EVFILT_WRITE, EV_ADD, 0, 0, &aEndPoint);
+        }
+        else if (lWasWatched && aEndPoint.mWatchedEvents.IsWriteable())
+        {
+            EV_SET(&lChanges[lNumChanges++], aEndPoint.mSocket, EVFILT_WRITE, EV_DELETE, 0, 0, &aEndPoint);
+        }
+
+        lOSReturn = ::kevent(mEventNotifierFD, lChanges, lNumChanges, NULL, 0, NULL);
+    }
+#endif // INET_SOCKET_EVENT_NOTIFIER_KQUEUE
+
+    if (lOSReturn != 0)
+    {
+        WeaveLogError(Inet, "Failed to watch socket %d: %s", aEndPoint.mSocket, ErrorStr(Weave::System::MapErrorPOSIX(errno)));
+        return;
+    }
+
+    aEndPoint.mWatchedSocket = aEndPoint.mSocket;
+    aEndPoint.mWatchedEvents = aEvents;
+}
+
+/**
+ *  Remove any kernel event queue registration held for an endpoint socket.
+ *
+ *  Endpoints call this immediately before closing their socket so that a
+ *  subsequently reused descriptor number is never mistaken for a socket
+ *  that is already registered.
+ *
+ *  @param[in]    aEndPoint    The endpoint whose socket is no longer to be watched.
+ *
+ */
+void InetLayer::UnwatchSocket(EndPointBasis& aEndPoint)
+{
+    if (aEndPoint.mWatchedSocket == INET_INVALID_SOCKET_FD)
+        return;
+
+    if (mEventNotifierFD != INET_INVALID_SOCKET_FD)
+    {
+#if INET_SOCKET_EVENT_NOTIFIER_EPOLL
+        struct epoll_event lEvent;
+
+        memset(&lEvent, 0, sizeof(lEvent));
+        ::epoll_ctl(mEventNotifierFD, EPOLL_CTL_DEL, aEndPoint.mWatchedSocket, &lEvent);
+#elif INET_SOCKET_EVENT_NOTIFIER_KQUEUE
+        struct kevent lChanges[2];
+        int lNumChanges = 0;
+
+        if (aEndPoint.mWatchedEvents.IsReadable() || aEndPoint.mWatchedEvents.IsError())
+            EV_SET(&lChanges[lNumChanges++], aEndPoint.mWatchedSocket, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+        if (aEndPoint.mWatchedEvents.IsWriteable())
+            EV_SET(&lChanges[lNumChanges++], aEndPoint.mWatchedSocket, EVFILT_WRITE, EV_DELETE, 0, 0, NULL);
+
+        ::kevent(mEventNotifierFD, lChanges, lNumChanges, NULL, 0, NULL);
+#endif // INET_SOCKET_EVENT_NOTIFIER_KQUEUE
+    }
+
+    aEndPoint.mWatchedSocket = INET_INVALID_SOCKET_FD;
+    aEndPoint.mWatchedEvents.Clear();
+}
+
+/**
+ *  Harvest the ready endpoints from the kernel event queue, without
+ *  blocking, and record the reported I/O events in the pending I/O field
+ *  of each.
+ *
+ *  @note
+ *    As with the select path, only the pending I/O fields are set here:
+ *    no endpoint callbacks are made until every ready endpoint has been
+ *    recorded.
+ *
+ */
+void InetLayer::HandleSocketEventNotifications(void)
+{
+    int lNumEvents;
+
+#if INET_SOCKET_EVENT_NOTIFIER_EPOLL
+    struct epoll_event lEvents[INET_CONFIG_SOCKET_EVENT_NOTIFIER_MAX_EVENTS];
+
+    lNumEvents = ::epoll_wait(mEventNotifierFD, lEvents, INET_CONFIG_SOCKET_EVENT_NOTIFIER_MAX_EVENTS, 0);
+
+    for (int i = 0; i < lNumEvents; i++)
+    {
+        EndPointBasis* lEndPoint = static_cast<EndPointBasis*>(lEvents[i].data.ptr);
+        const uint32_t lReady = lEvents[i].events;
+
+        // As with select, error and hang-up conditions are reported as readiness for whatever I/O was requested.
+        if (lEndPoint->mWatchedEvents.IsReadable() && (lReady & (EPOLLIN | EPOLLERR | EPOLLHUP)) != 0)
+            lEndPoint->mPendingIO.SetRead();
+        if (lEndPoint->mWatchedEvents.IsWriteable() && (lReady & (EPOLLOUT | EPOLLERR | EPOLLHUP)) != 0)
+            lEndPoint->mPendingIO.SetWrite();
+        if (lEndPoint->mWatchedEvents.IsError() && (lReady & EPOLLPRI) != 0)
+            lEndPoint->mPendingIO.SetError();
+    }
+#elif INET_SOCKET_EVENT_NOTIFIER_KQUEUE
+    struct kevent lEvents[INET_CONFIG_SOCKET_EVENT_NOTIFIER_MAX_EVENTS];
+    const struct timespec kNoWait = { 0, 0 };
+
+    lNumEvents = ::kevent(mEventNotifierFD, NULL, 0, lEvents, INET_CONFIG_SOCKET_EVENT_NOTIFIER_MAX_EVENTS, &kNoWait);
+
+    for (int i = 0; i < lNumEvents; i++)
+    {
+        EndPointBasis* lEndPoint = static_cast<EndPointBasis*>(lEvents[i].udata);
+
+        if (lEvents[i].filter == EVFILT_READ)
+        {
+            if (lEndPoint->mWatchedEvents.IsReadable())
+                lEndPoint->mPendingIO.SetRead();
+            if (lEndPoint->mWatchedEvents.IsError())
+                lEndPoint->mPendingIO.SetError();
+        }
+        else if (lEvents[i].filter == EVFILT_WRITE)
+        {
+            if (lEndPoint->mWatchedEvents.IsWriteable())
+                lEndPoint->mPendingIO.SetWrite();
+        }
+    }
+#endif // INET_SOCKET_EVENT_NOTIFIER_KQUEUE
+
+    if (lNumEvents < 0 && errno != EINTR)
+    {
+        WeaveLogError(Inet, "Failed to harvest socket events: %s", ErrorStr(Weave::System::MapErrorPOSIX(errno)));
+    }
 }
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
 
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
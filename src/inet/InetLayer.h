@@ -116,6 +116,10 @@ namespace Inet {
 
 class InetLayer;
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+class EndPointBasis;
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
 namespace Platform {
 namespace InetLayer {
 
@@ -205,6 +209,9 @@ class NL_DLL_EXPORT InetLayer
 #endif // INET_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 
     INET_ERROR Init(Weave::System::Layer& aSystemLayer, void* aContext);
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+    INET_ERROR Init(Weave::System::Layer& aSystemLayer, void* aContext, uint8_t aDNSThreadCount);
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
     INET_ERROR Shutdown(void);
 
     Weave::System::Layer* SystemLayer(void) const;
@@ -243,6 +250,13 @@ class NL_DLL_EXPORT InetLayer
             DNSResolveCompleteFunct onComplete, void *appState);
     void CancelResolveHostAddress(DNSResolveCompleteFunct onComplete, void *appState);
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+    void GetDNSQueueStats(DNSQueueStats &outStats);
+#if INET_CONFIG_DNS_CACHE_SIZE > 0
+    void GetDNSCacheStats(DNSCacheStats &outStats);
+#endif // INET_CONFIG_DNS_CACHE_SIZE > 0
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
+
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER
 
     INET_ERROR GetInterfaceFromAddr(const IPAddress& addr, InterfaceId& intfId);
@@ -372,7 +386,15 @@ private:
     AsyncDNSResolverSockets mAsyncDNSResolver;
 #endif // INET_CONFIG_ENABLE_DNS_RESOLVER && INET_CONFIG_ENABLE_ASYNC_DNS_SOCKETS
 
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+    int mEventNotifierFD;
 
+    INET_ERROR InitSocketEventNotifier(void);
+    void ShutdownSocketEventNotifier(void);
+    void WatchSocket(EndPointBasis& aEndPoint, SocketEvents aEvents);
+    void UnwatchSocket(EndPointBasis& aEndPoint);
+    void HandleSocketEventNotifications(void);
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
     friend INET_ERROR Platform::InetLayer::WillInit(Inet::InetLayer *aLayer, void *aContext);
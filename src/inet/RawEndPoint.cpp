@@ -479,6 +479,10 @@ void RawEndPoint::Close(void)
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+            Layer().UnwatchSocket(*this);
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -58,6 +58,11 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <netinet/tcp.h>
+
+#if INET_CONFIG_TCP_RECV_CHAIN_LENGTH > 1 || INET_CONFIG_TCP_SEND_CHAIN_LENGTH > 1
+#include <sys/uio.h>
+#include <limits.h>
+#endif // INET_CONFIG_TCP_RECV_CHAIN_LENGTH > 1 || INET_CONFIG_TCP_SEND_CHAIN_LENGTH > 1
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #include "arpa-inet-compatibility.h"
@@ -1309,9 +1314,36 @@ INET_ERROR TCPEndPoint::DriveSending()
 
     while (mSendQueue != NULL)
     {
+#if INET_CONFIG_TCP_SEND_CHAIN_LENGTH > 1
+#if defined(IOV_MAX) && IOV_MAX < INET_CONFIG_TCP_SEND_CHAIN_LENGTH
+        enum { kMaxSendIOVs = IOV_MAX };
+#else
+        enum { kMaxSendIOVs = INET_CONFIG_TCP_SEND_CHAIN_LENGTH };
+#endif
+        struct iovec iov[kMaxSendIOVs];
+        struct msghdr msgHeader;
+        size_t bufLen = 0;
+        int iovCount = 0;
+
+        // Gather as much of the send queue as fits into a single call.
+        for (PacketBuffer *buf = mSendQueue; buf != NULL && iovCount < kMaxSendIOVs; buf = buf->Next())
+        {
+            iov[iovCount].iov_base = buf->Start();
+            iov[iovCount].iov_len = buf->DataLength();
+            bufLen += buf->DataLength();
+            iovCount++;
+        }
+
+        memset(&msgHeader, 0, sizeof(msgHeader));
+        msgHeader.msg_iov = iov;
+        msgHeader.msg_iovlen = iovCount;
+
+        ssize_t lenSent = sendmsg(mSocket, &msgHeader, sendFlags);
+#else // INET_CONFIG_TCP_SEND_CHAIN_LENGTH <= 1
         uint16_t bufLen = mSendQueue->DataLength();
 
         ssize_t lenSent = send(mSocket, mSendQueue->Start(), (size_t) bufLen, sendFlags);
+#endif // INET_CONFIG_TCP_SEND_CHAIN_LENGTH <= 1
 
         if (lenSent == -1)
         {
@@ -1323,6 +1355,27 @@ INET_ERROR TCPEndPoint::DriveSending()
         // Mark the connection as being active.
         MarkActive();
 
+#if INET_CONFIG_TCP_SEND_CHAIN_LENGTH > 1
+        // Retire the buffers that were sent, reporting each one, or the part of one, to the app just as a send call per buffer
+        // would have done.
+        for (size_t lenRemaining = static_cast<size_t>(lenSent); lenRemaining > 0 && mSendQueue != NULL; )
+        {
+            uint16_t lenRetired = mSendQueue->DataLength();
+
+            if (lenRemaining < lenRetired)
+            {
+                lenRetired = static_cast<uint16_t>(lenRemaining);
+                mSendQueue->ConsumeHead(lenRetired);
+            }
+            else
+                mSendQueue = PacketBuffer::FreeHead(mSendQueue);
+
+            lenRemaining -= lenRetired;
+
+            if (OnDataSent != NULL)
+                OnDataSent(this, lenRetired);
+        }
+#else // INET_CONFIG_TCP_SEND_CHAIN_LENGTH <= 1
         if (lenSent < bufLen)
             mSendQueue->ConsumeHead(lenSent);
         else
@@ -1330,6 +1383,7 @@ INET_ERROR TCPEndPoint::DriveSending()
 
         if (OnDataSent != NULL)
             OnDataSent(this, (uint16_t) lenSent);
+#endif // INET_CONFIG_TCP_SEND_CHAIN_LENGTH <= 1
 
 #if INET_CONFIG_ENABLE_TCP_SEND_IDLE_CALLBACKS
         // TCP Send is not Idle; Set state and notify if needed
@@ -1364,7 +1418,7 @@ INET_ERROR TCPEndPoint::DriveSending()
         }
 #endif // INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
 
-        if (lenSent < bufLen)
+        if ((size_t) lenSent < bufLen)
             break;
     }
 
@@ -1544,6 +1598,10 @@ INET_ERROR TCPEndPoint::DoClose(INET_ERROR err, bool suppressCallback)
                     WeaveLogError(Inet, "SO_LINGER: %d", errno);
             }
 
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+            Layer().UnwatchSocket(*this);
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
             if (close(mSocket) != 0 && err == INET_NO_ERROR)
                 err = Weave::System::MapErrorPOSIX(errno);
             mSocket = INET_INVALID_SOCKET_FD;
@@ -2335,11 +2393,60 @@ void TCPEndPoint::HandlePendingIO()
 
 void TCPEndPoint::ReceiveData()
 {
+#if INET_CONFIG_TCP_RECV_CHAIN_LENGTH > 1
+    PacketBuffer *rcvBufs[INET_CONFIG_TCP_RECV_CHAIN_LENGTH];
+    struct iovec iov[INET_CONFIG_TCP_RECV_CHAIN_LENGTH + 1];
+    PacketBuffer *tailBuf = NULL;
+    size_t numNewBufs = 0;
+    int iovCount = 0;
+
+    // Receive into the space left at the end of the receive queue, as it stands, and then into a chain of new buffers.
+    if (mRcvQueue != NULL)
+    {
+        for (tailBuf = mRcvQueue; tailBuf->Next() != NULL; tailBuf = tailBuf->Next())
+            ;
+
+        if (tailBuf->AvailableDataLength() > 0)
+        {
+            iov[iovCount].iov_base = tailBuf->Start() + tailBuf->DataLength();
+            iov[iovCount].iov_len = tailBuf->AvailableDataLength();
+            iovCount++;
+        }
+        else
+            tailBuf = NULL;
+    }
+
+    for (; numNewBufs < INET_CONFIG_TCP_RECV_CHAIN_LENGTH; numNewBufs++)
+    {
+        SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_InetLayer);
+        PacketBuffer *newBuf = PacketBuffer::New(0);
+
+        if (newBuf == NULL)
+            break;
+
+        rcvBufs[numNewBufs] = newBuf;
+        iov[iovCount].iov_base = newBuf->Start();
+        iov[iovCount].iov_len = newBuf->AvailableDataLength();
+        iovCount++;
+    }
+
+    if (iovCount == 0)
+    {
+        DoClose(INET_ERROR_NO_MEMORY, false);
+        return;
+    }
+
+    // Attempt to receive data from the socket.
+    ssize_t rcvLen = readv(mSocket, iov, iovCount);
+#else // INET_CONFIG_TCP_RECV_CHAIN_LENGTH <= 1
     PacketBuffer *rcvBuf;
     bool isNewBuf = true;
 
     if (mRcvQueue == NULL)
+    {
+        SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_InetLayer);
         rcvBuf = PacketBuffer::New(0);
+    }
     else
     {
         rcvBuf = mRcvQueue;
@@ -2347,7 +2454,10 @@ void TCPEndPoint::ReceiveData()
             ;
 
         if (rcvBuf->AvailableDataLength() == 0)
+        {
+            SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_InetLayer);
             rcvBuf = PacketBuffer::New(0);
+        }
         else
         {
             isNewBuf = false;
@@ -2363,6 +2473,7 @@ void TCPEndPoint::ReceiveData()
 
     // Attempt to receive data from the socket.
     ssize_t rcvLen = recv(mSocket, rcvBuf->Start() + rcvBuf->DataLength(), rcvBuf->AvailableDataLength(), 0);
+#endif // INET_CONFIG_TCP_RECV_CHAIN_LENGTH <= 1
 
 #if INET_CONFIG_OVERRIDE_SYSTEM_TCP_USER_TIMEOUT
     INET_ERROR err;
@@ -2403,10 +2514,15 @@ void TCPEndPoint::ReceiveData()
     {
         int systemErrno = errno;
 
+#if INET_CONFIG_TCP_RECV_CHAIN_LENGTH > 1
+        while (numNewBufs > 0)
+            PacketBuffer::Free(rcvBufs[--numNewBufs]);
+#else // INET_CONFIG_TCP_RECV_CHAIN_LENGTH <= 1
         if (isNewBuf)
         {
             PacketBuffer::Free(rcvBuf);
         }
+#endif // INET_CONFIG_TCP_RECV_CHAIN_LENGTH <= 1
 
         if (systemErrno == EAGAIN)
         {
@@ -2430,8 +2546,13 @@ void TCPEndPoint::ReceiveData()
         // If the peer closed their end of the connection...
         if (rcvLen == 0)
         {
+#if INET_CONFIG_TCP_RECV_CHAIN_LENGTH > 1
+            while (numNewBufs > 0)
+                PacketBuffer::Free(rcvBufs[--numNewBufs]);
+#else // INET_CONFIG_TCP_RECV_CHAIN_LENGTH <= 1
             if (isNewBuf)
                 PacketBuffer::Free(rcvBuf);
+#endif // INET_CONFIG_TCP_RECV_CHAIN_LENGTH <= 1
 
             // If in the Connected state and the app has provided an OnPeerClose callback,
             // enter the ReceiveShutdown state.  Providing an OnPeerClose callback allows
@@ -2448,6 +2569,49 @@ void TCPEndPoint::ReceiveData()
                 OnPeerClose(this);
         }
 
+#if INET_CONFIG_TCP_RECV_CHAIN_LENGTH > 1
+        // Otherwise, account for the new data in the order it was scattered: first the end of the receive queue, then the new
+        // buffers, which are added onto the queue. Any new buffers left empty are freed.
+        else
+        {
+            size_t remainingLen = static_cast<size_t>(rcvLen);
+
+            if (tailBuf != NULL)
+            {
+                uint16_t fillLen = tailBuf->AvailableDataLength();
+
+                if (remainingLen < fillLen)
+                    fillLen = static_cast<uint16_t>(remainingLen);
+
+                tailBuf->SetDataLength(tailBuf->DataLength() + fillLen, mRcvQueue);
+                remainingLen -= fillLen;
+            }
+
+            for (size_t i = 0; i < numNewBufs; i++)
+            {
+                PacketBuffer *newBuf = rcvBufs[i];
+
+                if (remainingLen == 0)
+                {
+                    PacketBuffer::Free(newBuf);
+                    continue;
+                }
+
+                uint16_t fillLen = newBuf->AvailableDataLength();
+
+                if (remainingLen < fillLen)
+                    fillLen = static_cast<uint16_t>(remainingLen);
+
+                newBuf->SetDataLength(fillLen);
+                remainingLen -= fillLen;
+
+                if (mRcvQueue == NULL)
+                    mRcvQueue = newBuf;
+                else
+                    mRcvQueue->AddToEnd(newBuf);
+            }
+        }
+#else // INET_CONFIG_TCP_RECV_CHAIN_LENGTH <= 1
         // Otherwise, add the new data onto the receive queue.
         else if (isNewBuf)
         {
@@ -2460,6 +2624,7 @@ void TCPEndPoint::ReceiveData()
 
         else
             rcvBuf->SetDataLength(rcvBuf->DataLength() + (uint16_t) rcvLen, mRcvQueue);
+#endif // INET_CONFIG_TCP_RECV_CHAIN_LENGTH <= 1
     }
 
     // Drive any received data into the app.
@@ -457,19 +457,39 @@ INET_ERROR TunEndPoint::TunDevSendMessage(PacketBuffer *msg)
 {
     INET_ERROR ret = INET_NO_ERROR;
     ssize_t lenSent = 0;
-    uint8_t *p = NULL;
+    size_t lenTotal = 0;
+    struct iovec msgIOV[INET_CONFIG_TUN_SEND_MAX_IOV];
+    int iovCnt = 0;
 
     // no packet could be read, silently ignore this
     VerifyOrExit(msg != NULL, ret = INET_ERROR_BAD_ARGS);
 
-    p = msg->Start();
+    // A tun device accepts exactly one IP packet per write, so a packet
+    // that arrives as a buffer chain (for example, one reassembled from a
+    // tunnel message) is gathered with writev() rather than flattened.
+    for (PacketBuffer *buf = msg; buf != NULL; buf = buf->Next())
+    {
+        if (buf->DataLength() == 0)
+            continue;
+
+        VerifyOrExit(iovCnt < INET_CONFIG_TUN_SEND_MAX_IOV, ret = INET_ERROR_MESSAGE_TOO_LONG);
+
+        msgIOV[iovCnt].iov_base = buf->Start();
+        msgIOV[iovCnt].iov_len = buf->DataLength();
+        lenTotal += buf->DataLength();
+        iovCnt++;
+    }
+
+    if (iovCnt == 1)
+        lenSent = write(mSocket, msgIOV[0].iov_base, msgIOV[0].iov_len);
+    else
+        lenSent = writev(mSocket, msgIOV, iovCnt);
 
-    lenSent = write(mSocket, p, msg->DataLength());
     if (lenSent < 0)
     {
        ExitNow(ret = Weave::System::MapErrorPOSIX(errno));
     }
-    else if (lenSent < msg->DataLength())
+    else if ((size_t)lenSent < lenTotal)
     {
         ExitNow(ret = INET_ERROR_OUTBOUND_MESSAGE_TRUNCATED);
     }
@@ -662,7 +682,13 @@ INET_ERROR TunEndPoint::TunDevOpen (const char *intfName)
     int fd = INET_INVALID_SOCKET_FD;
     INET_ERROR ret = INET_NO_ERROR;
 
+#if INET_CONFIG_TUN_READ_BATCH_SIZE > 1
+    // The read path drains the device until it would block, so it must
+    // not block once the queue is empty.
+    if ((fd = open(INET_CONFIG_TUNNEL_DEVICE_NAME, O_RDWR | O_NONBLOCK | NL_O_CLOEXEC)) < 0)
+#else // INET_CONFIG_TUN_READ_BATCH_SIZE <= 1
     if ((fd = open(INET_CONFIG_TUNNEL_DEVICE_NAME, O_RDWR | NL_O_CLOEXEC)) < 0)
+#endif // INET_CONFIG_TUN_READ_BATCH_SIZE <= 1
     {
         ExitNow(ret = Weave::System::MapErrorPOSIX(errno));
     }
@@ -674,6 +700,14 @@ INET_ERROR TunEndPoint::TunDevOpen (const char *intfName)
 
     ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
 
+#if INET_CONFIG_TUN_ENABLE_MULTI_QUEUE
+#ifdef IFF_MULTI_QUEUE
+    ifr.ifr_flags |= IFF_MULTI_QUEUE;
+#else // !defined(IFF_MULTI_QUEUE)
+    ExitNow(ret = INET_ERROR_NOT_IMPLEMENTED);
+#endif // !defined(IFF_MULTI_QUEUE)
+#endif // INET_CONFIG_TUN_ENABLE_MULTI_QUEUE
+
     if (*intfName)
     {
         strncpy(ifr.ifr_name, intfName, sizeof(ifr.ifr_name) - 1);
@@ -716,6 +750,10 @@ void TunEndPoint::TunDevClose (void)
 {
     if (mSocket >= 0)
     {
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+        Layer().UnwatchSocket(*this);
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
         close(mSocket);
     }
     mSocket = INET_INVALID_SOCKET_FD;
@@ -773,33 +811,58 @@ void TunEndPoint::HandlePendingIO ()
 
     if (mState == kState_Open && OnPacketReceived != NULL && mPendingIO.IsReadable())
     {
+        // Drain up to INET_CONFIG_TUN_READ_BATCH_SIZE packets per readable
+        // event. The upper layer handler may close the endpoint, so its
+        // state is re-checked before each read.
+        for (int i = 0; i < INET_CONFIG_TUN_READ_BATCH_SIZE && mState == kState_Open && OnPacketReceived != NULL; i++)
+        {
+            PacketBuffer *buf = PacketBuffer::New(0);
+            bool readFailed = false;
 
-        PacketBuffer *buf = PacketBuffer::New(0);
+            if (buf != NULL)
+            {
+                //Read data from Tun Device
+                err = TunDevRead(buf);
+
+                // An empty queue ends the batch; it is not an error.
+                if (err == Weave::System::MapErrorPOSIX(EAGAIN))
+                {
+                    PacketBuffer::Free(buf);
+                    break;
+                }
+
+                if (err == INET_NO_ERROR)
+                {
+                    err = CheckV6Sanity(buf);
+                }
+                else
+                {
+                    readFailed = true;
+                }
+            }
+            else
+            {
+                err = INET_ERROR_NO_MEMORY;
+                readFailed = true;
+            }
 
-        if (buf != NULL)
-        {
-            //Read data from Tun Device
-            err = TunDevRead(buf);
             if (err == INET_NO_ERROR)
             {
-                err = CheckV6Sanity(buf);
+                OnPacketReceived(this, buf);
             }
-        }
-        else
-        {
-            err = INET_ERROR_NO_MEMORY;
-        }
-
-        if (err == INET_NO_ERROR)
-        {
-            OnPacketReceived(this, buf);
-        }
-        else
-        {
-            PacketBuffer::Free(buf);
-            if (OnReceiveError != NULL)
+            else
             {
-                OnReceiveError(this, err);
+                PacketBuffer::Free(buf);
+                if (OnReceiveError != NULL)
+                {
+                    OnReceiveError(this, err);
+                }
+
+                // Anything still queued is picked up on the next readable
+                // event; a packet that merely failed the sanity check does
+                // not end the batch.
+                if (readFailed)
+                    break;
             }
         }
     }
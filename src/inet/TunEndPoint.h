@@ -45,6 +45,7 @@
 #include <net/if.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <errno.h>
 #include <unistd.h>
 #include <netinet/ip6.h>
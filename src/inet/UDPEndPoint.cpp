@@ -342,6 +342,11 @@ void UDPEndPoint::Close(void)
 {
     if (mState != kState_Closed)
     {
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+        // Send any deferred messages before the socket goes away.
+        FlushSendQueue();
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 
         // Lock LwIP stack
@@ -370,6 +375,10 @@ void UDPEndPoint::Close(void)
             // Wake the thread calling select so that it recognizes the socket is closed.
             lSystemLayer.WakeSelect();
 
+#if INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+            Layer().UnwatchSocket(*this);
+#endif // INET_CONFIG_ENABLE_SOCKET_EVENT_NOTIFIER
+
             close(mSocket);
             mSocket = INET_INVALID_SOCKET_FD;
         }
@@ -655,6 +664,11 @@ INET_ERROR UDPEndPoint::SendMsg(const IPPacketInfo *pktInfo, PacketBuffer *msg,
     res = GetSocket(destAddr.Type());
     SuccessOrExit(res);
 
+#if INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+    if (sendFlags & kSendFlag_Deferred)
+        ExitNow(res = QueueMsg(pktInfo, msg, sendFlags));
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+
     res = IPEndPointBasis::SendMsg(pktInfo, msg, sendFlags);
 
     if ((sendFlags & kSendFlag_RetainBuffer) == 0)
@@ -736,6 +750,11 @@ exit:
 void UDPEndPoint::Init(InetLayer *inetLayer)
 {
     IPEndPointBasis::Init(inetLayer);
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+    mSendQueueLength = 0;
+    mUseSegmentation = true;
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
 }
 
 /**
@@ -863,10 +882,14 @@ void UDPEndPoint::LwIPReceiveUDPMessage(void *arg, struct udp_pcb *pcb, struct p
 #endif // LWIP_VERSION_MAJOR > 1 || LWIP_VERSION_MINOR >= 5
 {
     UDPEndPoint*            ep              = static_cast<UDPEndPoint*>(arg);
-    PacketBuffer*           buf             = reinterpret_cast<PacketBuffer*>(static_cast<void*>(p));
+    PacketBuffer*           buf             = PrepareReceivedBuffer(p);
     Weave::System::Layer&   lSystemLayer    = ep->SystemLayer();
     IPPacketInfo*           pktInfo     = NULL;
 
+    // Drop the message if it could not be made contiguous.
+    if (buf == NULL)
+        return;
+
     pktInfo = GetPacketInfo(buf);
     if (pktInfo != NULL)
     {
@@ -918,6 +941,92 @@ SocketEvents UDPEndPoint::PrepareIO(void)
     return (IPEndPointBasis::PrepareIO());
 }
 
+#if INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+/**
+ * @brief   Send all deferred messages.
+ *
+ * @retval  INET_NO_ERROR   success: every deferred message was sent, or none was queued.
+ *
+ * @retval  other
+ *      the error for the first deferred message that could not be sent.
+ *
+ * @details
+ *      Hands the messages queued by \c SendMsg with the \c kSendFlag_Deferred
+ *      option to the kernel in as few system calls as possible, then
+ *      releases them. The InetLayer calls this method at the end of every
+ *      \c HandleSelectResult, so applications only need to call it to
+ *      bound the latency of deferred messages sent outside the event loop.
+ */
+INET_ERROR UDPEndPoint::FlushSendQueue(void)
+{
+    INET_ERROR res = INET_NO_ERROR;
+    IPPacketInfo lPktInfos[INET_CONFIG_UDP_SEND_BATCH_SIZE];
+    const size_t lLength = mSendQueueLength;
+
+    VerifyOrExit(lLength > 0, );
+
+    mSendQueueLength = 0;
+
+    for (size_t i = 0; i < lLength; i++)
+    {
+        lPktInfos[i].Clear();
+        lPktInfos[i].SrcAddress = mSendQueueInfo[i].SrcAddress;
+        lPktInfos[i].DestAddress = mSendQueueInfo[i].DestAddress;
+        lPktInfos[i].Interface = mSendQueueInfo[i].Interface;
+        lPktInfos[i].DestPort = mSendQueueInfo[i].DestPort;
+    }
+
+    res = SendMsgBatch(lPktInfos, mSendQueueBuffers, lLength, mUseSegmentation);
+
+    for (size_t i = 0; i < lLength; i++)
+    {
+        PacketBuffer::Free(mSendQueueBuffers[i]);
+        mSendQueueBuffers[i] = NULL;
+    }
+
+exit:
+    return res;
+}
+
+/**
+ *  Queue a message for the next flush of the deferred send queue, flushing first if the queue is full.
+ *
+ *  On success, the queue owns \c msg or, with \c kSendFlag_RetainBuffer, a reference to it; the caller must then not modify the
+ *  message until the queue is flushed. On failure, \c msg is freed unless it is retained.
+ */
+INET_ERROR UDPEndPoint::QueueMsg(const IPPacketInfo *pktInfo, PacketBuffer *msg, uint16_t sendFlags)
+{
+    INET_ERROR res = INET_NO_ERROR;
+
+    // Check the arguments now, as errors found when the queue is flushed cannot be reported to the caller.
+    VerifyOrExit(mAddrType == pktInfo->DestAddress.Type(), res = INET_ERROR_BAD_ARGS);
+    VerifyOrExit(msg->Next() == NULL, res = INET_ERROR_MESSAGE_TOO_LONG);
+
+    if (mSendQueueLength == INET_CONFIG_UDP_SEND_BATCH_SIZE)
+        FlushSendQueue();
+
+    if (sendFlags & kSendFlag_RetainBuffer)
+        msg->AddRef();
+
+    mSendQueueInfo[mSendQueueLength].SrcAddress = pktInfo->SrcAddress;
+    mSendQueueInfo[mSendQueueLength].DestAddress = pktInfo->DestAddress;
+    mSendQueueInfo[mSendQueueLength].Interface = pktInfo->Interface;
+    mSendQueueInfo[mSendQueueLength].DestPort = pktInfo->DestPort;
+    mSendQueueBuffers[mSendQueueLength] = msg;
+    mSendQueueLength++;
+
+    // Make sure the event loop comes around to flush the queue if the message was sent from outside of it.
+    if (mSendQueueLength == 1)
+        SystemLayer().WakeSelect();
+
+exit:
+    if (res != INET_NO_ERROR && (sendFlags & kSendFlag_RetainBuffer) == 0)
+        PacketBuffer::Free(msg);
+
+    return res;
+}
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+
 void UDPEndPoint::HandlePendingIO(void)
 {
     if (mState == kState_Listening && OnMessageReceived != NULL && mPendingIO.IsReadable())
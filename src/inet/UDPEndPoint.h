@@ -61,6 +61,9 @@ public:
     INET_ERROR SendTo(IPAddress addr, uint16_t port, Weave::System::PacketBuffer *msg, uint16_t sendFlags = 0);
     INET_ERROR SendTo(IPAddress addr, uint16_t port, InterfaceId intfId, Weave::System::PacketBuffer *msg, uint16_t sendFlags = 0);
     INET_ERROR SendMsg(const IPPacketInfo *pktInfo, Weave::System::PacketBuffer *msg, uint16_t sendFlags = 0);
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+    INET_ERROR FlushSendQueue(void);
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
     void Close(void);
     void Free(void);
 
@@ -89,9 +92,35 @@ private:
     INET_ERROR GetSocket(IPAddressType addrType);
     SocketEvents PrepareIO(void);
     void HandlePendingIO(void);
+
+#if INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+    // The addressing of a deferred message; see IPPacketInfo, which cannot be used here as it is defined after this class.
+    struct QueuedSendInfo
+    {
+        IPAddress SrcAddress;
+        IPAddress DestAddress;
+        InterfaceId Interface;
+        uint16_t DestPort;
+    };
+
+    QueuedSendInfo mSendQueueInfo[INET_CONFIG_UDP_SEND_BATCH_SIZE];
+    Weave::System::PacketBuffer *mSendQueueBuffers[INET_CONFIG_UDP_SEND_BATCH_SIZE];
+    uint8_t mSendQueueLength;
+    bool mUseSegmentation;
+
+    INET_ERROR QueueMsg(const IPPacketInfo *pktInfo, Weave::System::PacketBuffer *msg, uint16_t sendFlags);
+    bool HasQueuedSends(void) const;
+#endif // INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 };
 
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+inline bool UDPEndPoint::HasQueuedSends(void) const
+{
+    return mSendQueueLength > 0;
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && INET_CONFIG_UDP_SEND_BATCH_SIZE > 1
+
 } // namespace Inet
 } // namespace nl
 
@@ -34,6 +34,7 @@
 
 #include <Weave/Core/WeaveCore.h>
 #include <Weave/Core/WeaveEncoding.h>
+#include <Weave/Core/WeaveStats.h>
 #include <Weave/Profiles/WeaveProfiles.h>
 #include <Weave/Profiles/common/CommonProfile.h>
 #include <Weave/Support/CodeUtils.h>
@@ -186,6 +187,18 @@ void ExchangeContext::SetMsgRcvdFromPeer(bool inMsgRcvdFromPeer)
  */
 void ExchangeContext::SetAckPending(bool inAckPending)
 {
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+    if (inAckPending != IsAckPending())
+    {
+        uint32_t now = static_cast<uint32_t>(System::Timer::GetCurrentEpoch());
+
+        if (inAckPending)
+            mAckPendingTime = now;
+        else
+            Stats::RecordAckDelay(now - mAckPendingTime);
+    }
+#endif
+
     SetFlag(mFlags, static_cast<uint16_t>(kFlagAckPending), inAckPending);
 }
 
@@ -235,7 +248,8 @@ static inline bool IsWRMPControlMessage(uint32_t profileId, uint8_t msgType)
 {
     return (profileId == nl::Weave::Profiles::kWeaveProfile_Common &&
             (msgType == nl::Weave::Profiles::Common::kMsgType_WRMP_Throttle_Flow ||
-             msgType == nl::Weave::Profiles::Common::kMsgType_WRMP_Delayed_Delivery));
+             msgType == nl::Weave::Profiles::Common::kMsgType_WRMP_Delayed_Delivery ||
+             msgType == nl::Weave::Profiles::Common::kMsgType_WRMP_Multi_Ack));
 }
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
 
@@ -533,6 +547,9 @@ WEAVE_ERROR ExchangeContext::SendMessage(uint32_t profileId, uint8_t msgType, Pa
         VerifyOrExit(!IsResponseExpected(), err = WEAVE_ERROR_INCORRECT_STATE);
 
         SetResponseExpected(true);
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+        mResponseExpectedTime = static_cast<uint32_t>(System::Timer::GetCurrentEpoch());
+#endif
 
         // Arm the response timer if a timeout has been specified.
         if (ResponseTimeout > 0)
@@ -594,12 +611,23 @@ WEAVE_ERROR ExchangeContext::SendMessage(uint32_t profileId, uint8_t msgType, Pa
             SuccessOrExit(err);
             msgBuf = NULL;
 
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+            // If the peer's send window is full, the message stays in the retransmission table and
+            // is sent once an outstanding message to the peer has been acknowledged.
+            if (!ExchangeMgr->WRMPAdmitToSendWindow(entry))
+            {
+                WeaveLogDetail(ExchangeManager, "Holding MsgId:%08" PRIX32 " for Peer %016" PRIX64 " send window",
+                               msgInfo->MessageId, PeerNodeId);
+                ExitNow();
+            }
+#endif
+
             err = ExchangeMgr->SendFromRetransTable(entry);
             sendCalled = true;
             SuccessOrExit(err);
 
             WEAVE_FAULT_INJECT(FaultInjection::kFault_WRMDoubleTx,
-                               entry->nextRetransTime = 0;
+                               ExchangeMgr->RescheduleRetransEntry(entry, 0);
                                ExchangeMgr->WRMPStartTimer()
                                );
 
@@ -671,6 +699,8 @@ exit:
  */
 WEAVE_ERROR ExchangeContext::SendCommonNullMessage(void)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_ExchangeMgr);
+
     WEAVE_ERROR  err     = WEAVE_NO_ERROR;
     PacketBuffer *msgBuf = NULL;
 
@@ -793,7 +823,7 @@ void ExchangeContext::AddRef()
 {
     mRefCount++;
 #if defined(WEAVE_EXCHANGE_CONTEXT_DETAIL_LOGGING)
-    WeaveLogProgress(ExchangeManager, "ec id: %d [%04" PRIX16 "], refCount++: %d", EXCHANGE_CONTEXT_ID(this - ExchangeMgr->ContextPool), ExchangeId, mRefCount);
+    WeaveLogProgress(ExchangeManager, "ec id: %d [%04" PRIX16 "], refCount++: %d", EXCHANGE_CONTEXT_ID(ExchangeMgr->ContextPool.GetIndex(this)), ExchangeId, mRefCount);
 #endif
 }
 
@@ -845,7 +875,7 @@ void ExchangeContext::Close()
     VerifyOrDie(ExchangeMgr != NULL && mRefCount != 0);
 
 #if defined(WEAVE_EXCHANGE_CONTEXT_DETAIL_LOGGING)
-    WeaveLogProgress(ExchangeManager, "ec id: %d [%04" PRIX16 "], %s", EXCHANGE_CONTEXT_ID(this - ExchangeMgr->ContextPool), ExchangeId, __func__);
+    WeaveLogProgress(ExchangeManager, "ec id: %d [%04" PRIX16 "], %s", EXCHANGE_CONTEXT_ID(ExchangeMgr->ContextPool.GetIndex(this)), ExchangeId, __func__);
 #endif
 
     DoClose(false);
@@ -861,7 +891,7 @@ void ExchangeContext::Abort()
     VerifyOrDie(ExchangeMgr != NULL && mRefCount != 0);
 
 #if defined(WEAVE_EXCHANGE_CONTEXT_DETAIL_LOGGING)
-    WeaveLogProgress(ExchangeManager, "ec id: %d [%04" PRIX16 "], %s", EXCHANGE_CONTEXT_ID(this - ExchangeMgr->ContextPool), ExchangeId, __func__);
+    WeaveLogProgress(ExchangeManager, "ec id: %d [%04" PRIX16 "], %s", EXCHANGE_CONTEXT_ID(ExchangeMgr->ContextPool.GetIndex(this)), ExchangeId, __func__);
 #endif
 
     DoClose(true);
@@ -904,12 +934,17 @@ void ExchangeContext::Release(void)
 
         DoClose(false);
         mRefCount = 0;
+        em->RemoveContextFromIndex(this);
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+        Stats::RecordExchangeLifetime(static_cast<uint32_t>(System::Timer::GetCurrentEpoch()) - mAllocTime);
+#endif
         ExchangeMgr = NULL;
+        em->ContextPool.Free(this);
 
         em->mContextsInUse--;
         em->MessageLayer->SignalMessageLayerActivityChanged();
 #if defined(WEAVE_EXCHANGE_CONTEXT_DETAIL_LOGGING)
-        WeaveLogProgress(ExchangeManager, "ec-- id: %d [%04" PRIX16 "], inUse: %d, addr: 0x%x", EXCHANGE_CONTEXT_ID(this - em->ContextPool), tmpid,  em->mContextsInUse, this);
+        WeaveLogProgress(ExchangeManager, "ec-- id: %d [%04" PRIX16 "], inUse: %d, addr: 0x%x", EXCHANGE_CONTEXT_ID(em->ContextPool.GetIndex(this)), tmpid,  em->mContextsInUse, this);
 #endif
         SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kExchangeMgr_NumContexts);
     }
@@ -917,7 +952,7 @@ void ExchangeContext::Release(void)
     {
         mRefCount--;
 #if defined(WEAVE_EXCHANGE_CONTEXT_DETAIL_LOGGING)
-        WeaveLogProgress(ExchangeManager, "ec id: %d [%04" PRIX16 "], refCount--: %d", EXCHANGE_CONTEXT_ID(this - ExchangeMgr->ContextPool), ExchangeId, mRefCount);
+        WeaveLogProgress(ExchangeManager, "ec id: %d [%04" PRIX16 "], refCount--: %d", EXCHANGE_CONTEXT_ID(ExchangeMgr->ContextPool.GetIndex(this)), ExchangeId, mRefCount);
 #endif
     }
 }
@@ -1173,6 +1208,25 @@ bool ExchangeContext::WRMPCheckAndRemRetransTable(uint32_t ackMsgId, void **rCtx
             //Return context value
             *rCtxt = ExchangeMgr->RetransTable[i].msgCtxt;
 
+#if WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+            // Per Karn's rule, only messages acknowledged without having been retransmitted yield an
+            // unambiguous round-trip time sample.
+            if (ExchangeMgr->RetransTable[i].sendCount == 1 && PeerNodeId != kAnyNodeId)
+            {
+                uint32_t rtt = static_cast<uint32_t>(System::Timer::GetCurrentEpoch()) - ExchangeMgr->RetransTable[i].firstSendTime;
+                ExchangeMgr->FabricState->UpdatePeerRTTEstimate(PeerNodeId, rtt);
+            }
+#endif
+
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+            ExchangeMgr->WRMPOnMessageAcked(&ExchangeMgr->RetransTable[i]);
+#endif
+
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+            if (ExchangeMgr->RetransTable[i].sendCount > 0)
+                Stats::RecordRetransmissions(ExchangeMgr->RetransTable[i].sendCount - 1);
+#endif
+
             //Clear the entry from the retransmision table.
             ExchangeMgr->ClearRetransmitTable(ExchangeMgr->RetransTable[i]);
 
@@ -1223,10 +1277,52 @@ WEAVE_ERROR ExchangeContext::WRMPFlushAcks(void)
  */
 uint32_t ExchangeContext::GetCurrentRetransmitTimeout(void)
 {
+#if WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+    uint32_t srtt, rttvar;
+
+    // Once round-trip times have been measured for the peer, the timeout is SRTT + max(G, 4 * RTTVAR), where
+    // the clock granularity G is the WRMP timer period.
+    if (PeerNodeId != kAnyNodeId && ExchangeMgr->FabricState->GetPeerRTTEstimate(PeerNodeId, srtt, rttvar))
+    {
+        uint32_t timeout = srtt + ((4 * rttvar > ExchangeMgr->mWRMPTimerInterval) ? 4 * rttvar : ExchangeMgr->mWRMPTimerInterval);
+
+        if (timeout < WEAVE_CONFIG_WRMP_MIN_RETRANS_TIMEOUT)
+            timeout = WEAVE_CONFIG_WRMP_MIN_RETRANS_TIMEOUT;
+        else if (timeout > WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT)
+            timeout = WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT;
+
+        return timeout;
+    }
+#endif // WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+
   return (HasRcvdMsgFromPeer() ? mWRMPConfig.mActiveRetransTimeout :
                                  mWRMPConfig.mInitialRetransTimeout);
 }
 
+/**
+ *  Get the timeout to wait for an acknowledgment after a message has been sent a given number of times.
+ *  When adaptive retransmission is enabled, the current retransmit timeout is doubled for each
+ *  retransmission, up to #WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT.
+ *
+ *  @param[in]    sendCount          The number of times the message has been sent.
+ *
+ *  @return the retransmit timeout, in milliseconds.
+ */
+uint32_t ExchangeContext::GetRetransmitTimeout(uint8_t sendCount)
+{
+    uint32_t timeout = GetCurrentRetransmitTimeout();
+
+#if WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+    for (uint8_t i = 1; i < sendCount && timeout < WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT; i++)
+        timeout <<= 1;
+
+    if (timeout > WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT && sendCount > 1)
+        timeout = WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT;
+#endif // WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+
+    return timeout;
+}
+
 /**
  *  Send a Throttle Flow message to the peer node requesting it to throttle its sending of messages.
  *
@@ -1252,6 +1348,8 @@ uint32_t ExchangeContext::GetCurrentRetransmitTimeout(void)
  */
 WEAVE_ERROR ExchangeContext::WRMPSendThrottleFlow(uint32_t pauseTimeMillis)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_ExchangeMgr);
+
     WEAVE_ERROR  err     = WEAVE_NO_ERROR;
     PacketBuffer *msgBuf = NULL;
     uint8_t      *p      = NULL;
@@ -1308,6 +1406,8 @@ exit:
  */
 WEAVE_ERROR ExchangeContext::WRMPSendDelayedDelivery(uint32_t pauseTimeMillis, uint64_t delayedNodeId)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_ExchangeMgr);
+
     WEAVE_ERROR  err     = WEAVE_NO_ERROR;
     PacketBuffer *msgBuf = NULL;
     uint8_t      *p      = NULL;
@@ -1478,12 +1578,14 @@ WEAVE_ERROR ExchangeContext::HandleThrottleFlow(uint32_t PauseTimeMillis)
             // Adjust the retrans timer value to account for throttling.
             if (0 != PauseTimeMillis)
             {
-                ExchangeMgr->RetransTable[i].nextRetransTime += PauseTimeMillis / ExchangeMgr->mWRMPTimerInterval;
+                ExchangeMgr->RescheduleRetransEntry(&ExchangeMgr->RetransTable[i],
+                                                    ExchangeMgr->GetRetransEntryTicks(&ExchangeMgr->RetransTable[i]) +
+                                                        PauseTimeMillis / ExchangeMgr->mWRMPTimerInterval);
             }
             // UnThrottle when PauseTimeMillis is set to 0
             else
             {
-                ExchangeMgr->RetransTable[i].nextRetransTime = 0;
+                ExchangeMgr->RescheduleRetransEntry(&ExchangeMgr->RetransTable[i], 0);
             }
             break;
         }
@@ -1590,9 +1692,10 @@ WEAVE_ERROR ExchangeContext::HandleMessage(WeaveMessageInfo *msgInfo, const Weav
         ExitNow(err = WEAVE_NO_ERROR);
 #endif
     }
-    //Return and not pass this to Application if Common::Null Msg Type
+    //Return and not pass this to Application if Common::Null or Multi-Ack Msg Type
     else if ((exchHeader->ProfileId == nl::Weave::Profiles::kWeaveProfile_Common) &&
-        (exchHeader->MessageType == nl::Weave::Profiles::Common::kMsgType_Null))
+        (exchHeader->MessageType == nl::Weave::Profiles::Common::kMsgType_Null ||
+         exchHeader->MessageType == nl::Weave::Profiles::Common::kMsgType_WRMP_Multi_Ack))
     {
         ExitNow(err = WEAVE_NO_ERROR);
     }
@@ -1601,6 +1704,12 @@ WEAVE_ERROR ExchangeContext::HandleMessage(WeaveMessageInfo *msgInfo, const Weav
         // Since we got the response, cancel the response timer.
         CancelResponseTimer();
 
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+        if (IsResponseExpected())
+            Stats::RecordResponseLatency(exchHeader->ProfileId,
+                    static_cast<uint32_t>(System::Timer::GetCurrentEpoch()) - mResponseExpectedTime);
+#endif
+
         // If the context was expecting a response to a previously sent message, this message
         // is implicitly that response.
         SetResponseExpected(false);
@@ -49,11 +49,123 @@
  *      0 will compile a version 0 BDX protocol that rejects and init messages
  *      with version != 0, and should only be used if we want a v0 only version
  *      negotiation.
+ *
+ *      2 will compile a version 2 BDX protocol that also responds to v0 and v1
+ *      nodes, and keeps up to WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE blocks in flight
+ *      when both nodes support version 2.
  */
 #ifndef WEAVE_CONFIG_BDX_VERSION
 #define WEAVE_CONFIG_BDX_VERSION 1
 #endif // WEAVE_CONFIG_BDX_VERSION
 
+/**
+ *  @def WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+ *
+ *  @brief
+ *      Maximum number of blocks a version 2 transfer keeps in flight.
+ *
+ *      The window is negotiated in the init and accept messages; each side
+ *      holds up to this many blocks, for retransmission on the sending side
+ *      and for reordering on the receiving side.  Between 1 and 32; 1 keeps
+ *      version 2 transfers stop-and-wait.
+ */
+#ifndef WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+#define WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE 8
+#endif // WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+
+#if (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE < 1) || (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 32)
+#error "WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE must be between 1 and 32"
+#endif // (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE < 1) || (WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE > 32)
+
+/**
+ *  @def WEAVE_CONFIG_BDX_MAX_TCP_BLOCK_SIZE
+ *
+ *  @brief
+ *      Maximum block size a version 2 transfer negotiates over a TCP
+ *      connection.
+ *
+ *      When WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES is enabled, blocks sent
+ *      over TCP span PacketBuffer chains, so they are not bounded by the size
+ *      of a single PacketBuffer.  This leaves room for the Weave message
+ *      header and trailer within the 16-bit TCP message length.  Note that
+ *      each side may hold up to WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE blocks of
+ *      this size.
+ */
+#ifndef WEAVE_CONFIG_BDX_MAX_TCP_BLOCK_SIZE
+#define WEAVE_CONFIG_BDX_MAX_TCP_BLOCK_SIZE 65024
+#endif // WEAVE_CONFIG_BDX_MAX_TCP_BLOCK_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+ *
+ *  @brief
+ *      Enable the BDX transfer scheduler, which paces the block sends of
+ *      concurrent transfers according to their priority class, their own
+ *      rate limit and a rate limit shared by all transfers.  See BdxScheduler.
+ */
+#ifndef WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+#define WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT 0
+#endif // WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+
+/**
+ *  @def WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES
+ *
+ *  @brief
+ *      Number of priority classes used by the BDX transfer scheduler.
+ *      Class 0 is served first.
+ */
+#ifndef WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES
+#define WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES 3
+#endif // WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES
+
+/**
+ *  @def WEAVE_CONFIG_BDX_SCHEDULER_BURST_MSEC
+ *
+ *  @brief
+ *      Time, in milliseconds, for which a rate-limited sender that has been
+ *      idle may send at full speed.  Each rate limit allows bursts of this
+ *      many milliseconds' worth of bytes, but never less than one block.
+ */
+#ifndef WEAVE_CONFIG_BDX_SCHEDULER_BURST_MSEC
+#define WEAVE_CONFIG_BDX_SCHEDULER_BURST_MSEC 100
+#endif // WEAVE_CONFIG_BDX_SCHEDULER_BURST_MSEC
+
+/**
+ *  @def WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+ *
+ *  @brief
+ *      Enable asynchronous put block handlers, with which received blocks
+ *      are written, e.g. to slow flash, without blocking the event loop.
+ *      See AsyncPutBlockHandler.
+ */
+#ifndef WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+#define WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT 0
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
+/**
+ *  @def WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS
+ *
+ *  @brief
+ *      Maximum number of received blocks a transfer holds while they wait
+ *      to be written by its asynchronous put block handler.
+ *
+ *      The peer is held off while the blocks it may send next would not
+ *      fit, so with version 2 this must be at least
+ *      WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE.  Each pending block holds on to
+ *      the PacketBuffer it was received in.
+ */
+#ifndef WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS
+#define WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE
+#endif // WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT && (WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS < 1 || WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS > 255)
+#error "WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS must be between 1 and 255"
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT && (WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS < 1 || WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS > 255)
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT && (WEAVE_CONFIG_BDX_VERSION >= 2) && (WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS < WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE)
+#error "WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS must be at least WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE"
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT && (WEAVE_CONFIG_BDX_VERSION >= 2)
+
 /**
  *  @def WEAVE_CONFIG_BDX_V0_SUPPORT
  *
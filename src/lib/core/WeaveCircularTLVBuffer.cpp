@@ -58,10 +58,13 @@ WeaveCircularTLVBuffer::WeaveCircularTLVBuffer(uint8_t *inBuffer, size_t inBuffe
     mQueue = inBuffer;
     mQueueSize = inBufferLength;
     mQueueLength = 0;
+    mHighWatermark = 0;
     mQueueHead = inHead;
 
     mProcessEvictedElement = NULL;
     mAppData = NULL;
+    mAvoidElementWrap = false;
+    mWrapPoint = NULL;
 
     // use common as opposed to unspecified, s.t. the reader that
     // skips over the elements does not complain about implicit
@@ -82,10 +85,13 @@ WeaveCircularTLVBuffer::WeaveCircularTLVBuffer(uint8_t *inBuffer, size_t inBuffe
     mQueue = inBuffer;
     mQueueSize = inBufferLength;
     mQueueLength = 0;
+    mHighWatermark = 0;
     mQueueHead = mQueue;
 
     mProcessEvictedElement = NULL;
     mAppData = NULL;
+    mAvoidElementWrap = false;
+    mWrapPoint = NULL;
 
     // use common as opposed to unspecified, s.t. the reader that
     // skips over the elements does not complain about implicit
@@ -116,7 +122,7 @@ WEAVE_ERROR WeaveCircularTLVBuffer::EvictHead(void)
 {
     CircularTLVReader reader;
     uint8_t *newHead;
-    size_t newLen;
+    size_t evictedLen;
     WEAVE_ERROR err;
 
     // find the boundaries of an event to throw away
@@ -132,7 +138,7 @@ WEAVE_ERROR WeaveCircularTLVBuffer::EvictHead(void)
     SuccessOrExit(err);
 
     // record the state of the queue post-call
-    newLen  = mQueueLength - (reader.GetLengthRead());
+    evictedLen = reader.GetLengthRead();
     newHead = const_cast<uint8_t *>(reader.GetReadPoint());
 
     // if a custom handler is installed, give it a chance to
@@ -148,8 +154,131 @@ WEAVE_ERROR WeaveCircularTLVBuffer::EvictHead(void)
     }
 
     // update queue state
-    mQueueLength = newLen;
-    mQueueHead = newHead;
+    AdvanceHead(newHead, evictedLen);
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Evicts the oldest top-level TLV elements in the WeaveCircularTLVBuffer
+ *   until at least the specified amount of space is available
+ *
+ * Elements are evicted in order, oldest first, exactly as by
+ * EvictHead(), with the #mProcessEvictedElement callback given the
+ * chance to process each one.  Each element is read once, so the
+ * cost of freeing space is proportional to the amount freed rather
+ * than to the number of calls made.  If an element cannot be
+ * evicted, the elements evicted before it remain evicted.
+ *
+ *  @param[in] inAvailableLength  The number of bytes that should be
+ *                                available on return.
+ *
+ *  @retval #WEAVE_NO_ERROR On success.
+ *
+ *  @retval #WEAVE_ERROR_BUFFER_TOO_SMALL If @a inAvailableLength
+ *                         exceeds the size of the buffer.
+ *
+ *  @retval other          On any other error returned either by the callback
+ *                         or by the TLVReader.
+ *
+ */
+WEAVE_ERROR WeaveCircularTLVBuffer::EvictHeadUntilAvailable(size_t inAvailableLength)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(inAvailableLength <= mQueueSize, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    while (AvailableDataLength() < inAvailableLength)
+    {
+        err = EvictHead();
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * This is a private method used to advance the head of the queue past
+ * @a inLength bytes of evicted elements.  Once the head reaches or
+ * passes the wrap point, the padding beyond the wrap point is
+ * released as well.
+ */
+void WeaveCircularTLVBuffer::AdvanceHead(uint8_t *inNewHead, size_t inLength)
+{
+    mQueueLength -= inLength;
+
+    if (mWrapPoint != NULL && (inNewHead >= mWrapPoint || inNewHead < mQueueHead))
+    {
+        mQueueLength -= PaddingLength();
+
+        if (inNewHead >= mWrapPoint)
+            inNewHead = mQueue;
+
+        mWrapPoint = NULL;
+    }
+
+    mQueueHead = inNewHead;
+}
+
+/**
+ * This is a private method used, when #mAvoidElementWrap is set, to
+ * keep the element being written from wrapping around the end of the
+ * backing store.  It is called when the queue runs up to the end of
+ * the backing store.
+ *
+ * The partially written element, if any, is found by skipping the
+ * complete elements that precede it, and is moved to the start of the
+ * backing store, evicting elements from the head as necessary to make
+ * room.  The space it vacated becomes padding, and the wrap point is
+ * set so that readers continue from the start of the backing store.
+ *
+ * @retval #WEAVE_NO_ERROR On success.
+ *
+ * @retval other           If the elements standing in the way of the
+ *                         relocated element could not be evicted.
+ */
+WEAVE_ERROR WeaveCircularTLVBuffer::RelocateWrappingElement(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t *elemStart = mQueueHead;
+    size_t partialLen;
+    TLVReader reader;
+
+    // find the end of the last complete element
+    reader.Init(mQueueHead, mQueueLength);
+    reader.ImplicitProfileId = mImplicitProfileId;
+
+    while (reader.Next() == WEAVE_NO_ERROR && reader.Skip() == WEAVE_NO_ERROR)
+    {
+        elemStart = const_cast<uint8_t *>(reader.GetReadPoint());
+    }
+
+    partialLen = (mQueue + mQueueSize) - elemStart;
+    VerifyOrExit(partialLen != 0, /* no-op */);
+
+    // make room for the partial element at the start of the storage
+    while (mQueueHead != elemStart && static_cast<size_t>(mQueueHead - mQueue) < partialLen)
+    {
+        err = EvictHead();
+        SuccessOrExit(err);
+    }
+
+    memmove(mQueue, elemStart, partialLen);
+
+    if (mQueueHead == elemStart)
+    {
+        // the partial element was all that remained in the queue
+        mQueueHead = mQueue;
+    }
+    else
+    {
+        // the vacated space up to the end of the storage becomes padding
+        mWrapPoint = elemStart;
+        mQueueLength += partialLen;
+    }
 
 exit:
     return err;
@@ -176,7 +305,27 @@ exit:
 WEAVE_ERROR WeaveCircularTLVBuffer::GetNewBuffer(TLVWriter& ioWriter, uint8_t *& outBufStart, uint32_t& outBufLen)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    uint8_t * tail = QueueTail();
+    uint8_t * tail;
+
+    if (mAvoidElementWrap)
+    {
+        // a head at the very end of the storage is equivalent to one at
+        // the start
+        if (mQueueHead == mQueue + mQueueSize)
+        {
+            mQueueHead = mQueue;
+        }
+
+        // if the queue runs up to the end of the storage, keep the
+        // element being written from wrapping around it.
+        if (mQueueLength != 0 && static_cast<size_t>(mQueueHead - mQueue) + mQueueLength == mQueueSize)
+        {
+            err = RelocateWrappingElement();
+            SuccessOrExit(err);
+        }
+    }
+
+    tail = QueueTail();
 
     if (mQueueLength >= mQueueSize) {
         // Queue is out of space, need to evict an element
@@ -232,6 +381,11 @@ WEAVE_ERROR WeaveCircularTLVBuffer::FinalizeBuffer(TLVWriter& ioWriter, uint8_t
         {
             mQueueLength = tail - mQueueHead;
         }
+
+        if (mQueueLength > mHighWatermark)
+        {
+            mHighWatermark = mQueueLength;
+        }
     }
     return err;
 }
@@ -263,17 +417,19 @@ WEAVE_ERROR WeaveCircularTLVBuffer::GetNextBuffer(TLVReader& ioReader, const uin
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     uint8_t * tail = QueueTail();
     const uint8_t *readerStart = outBufStart;
+    // data at the end of the storage stops short of any padding
+    const uint8_t *dataEnd = (mWrapPoint != NULL) ? mWrapPoint : mQueue + mQueueSize;
 
     if (readerStart == NULL)
     {
         outBufStart = mQueueHead;
 
-        if (outBufStart == mQueue + mQueueSize)
+        if (outBufStart == dataEnd)
         {
             outBufStart = mQueue;
         }
     }
-    else if (readerStart >= (mQueue + mQueueSize))
+    else if (readerStart >= dataEnd)
     {
         outBufStart = mQueue;
     }
@@ -291,7 +447,7 @@ WEAVE_ERROR WeaveCircularTLVBuffer::GetNextBuffer(TLVReader& ioReader, const uin
         // outBufStart until the end of the underlying storage buffer
         // (i.e. mQueue+mQueueSize).  This case tail == outBufStart
         // indicates that the buffer is completely full
-        outBufLen = (mQueue + mQueueSize) - outBufStart;
+        outBufLen = dataEnd - outBufStart;
         if ((tail == outBufStart) && (readerStart != NULL))
             outBufLen = 0;
     }
@@ -456,7 +612,7 @@ void CircularTLVReader::Init(WeaveCircularTLVBuffer *buf)
     mReadPoint = NULL;
     GetNextBuffer(*this, mBufHandle, mReadPoint, bufLen);
     mBufEnd = mReadPoint + bufLen;
-    mMaxLen = buf->DataLength();
+    mMaxLen = buf->DataLength() - buf->PaddingLength();
     mControlByte = kTLVControlByte_NotSpecified;
     mElemTag = AnonymousTag;
     mElemLenOrVal = 0;
@@ -69,11 +69,14 @@ public:
     inline size_t DataLength(void) const { return mQueueLength; };
     inline size_t AvailableDataLength(void) const { return mQueueSize - mQueueLength; };
     inline size_t GetQueueSize(void) const { return mQueueSize; };
+    inline size_t GetHighWatermark(void) const { return mHighWatermark; };
     inline uint8_t *GetQueue(void) const { return mQueue; };
-    inline void SetQueueHead(uint8_t *aQueueHead) { mQueueHead = aQueueHead; };
-    inline void SetQueueLength(size_t aQueueLength) { mQueueLength = aQueueLength; };
+    inline void SetQueueHead(uint8_t *aQueueHead) { mQueueHead = aQueueHead; mWrapPoint = NULL; };
+    inline void SetQueueLength(size_t aQueueLength) { mQueueLength = aQueueLength; mWrapPoint = NULL; };
+    inline size_t PaddingLength(void) const { return (mWrapPoint != NULL) ? (mQueue + mQueueSize) - mWrapPoint : 0; };
 
     WEAVE_ERROR EvictHead(void);
+    WEAVE_ERROR EvictHeadUntilAvailable(size_t inAvailableLength);
 
     static WEAVE_ERROR GetNewBufferFunct(TLVWriter& ioWriter, uintptr_t& inBufHandle, uint8_t *& outBufStart, uint32_t& outBufLen);
     static WEAVE_ERROR FinalizeBufferFunct(TLVWriter& ioWriter, uintptr_t inBufHandle, uint8_t *inBufStart, uint32_t inBufLen);
@@ -126,12 +129,18 @@ public:
     uint32_t mImplicitProfileId;
     void * mAppData; /**< An optional, user supplied context to be used with the callback processing the evicted element. */
     ProcessEvictedElementFunct mProcessEvictedElement; /**< An optional, user-supplied callback that processes the element prior to evicting it from the circular buffer.  See the ProcessEvictedElementFunct type definition on additional information on implementing the mProcessEvictedElement function. */
+    bool mAvoidElementWrap; /**< If true, top-level elements are never split across the end of the backing store; an element that would wrap is moved to the start of the backing store, and the space it leaves at the end is padded.  Padding occupies space in the queue (see PaddingLength()) but is never seen by readers.  Defaults to false. */
 
 private:
+    WEAVE_ERROR RelocateWrappingElement(void);
+    void AdvanceHead(uint8_t *inNewHead, size_t inLength);
+
     uint8_t *mQueue;
     size_t mQueueSize;
     uint8_t *mQueueHead;
     size_t mQueueLength;
+    size_t mHighWatermark;
+    uint8_t *mWrapPoint;
 };
 
 class NL_DLL_EXPORT CircularTLVReader : public TLVReader
@@ -187,6 +187,47 @@
 #error "Please assert one of either WEAVE_CONFIG_USE_MICRO_ECC or WEAVE_CONFIG_USE_OPENSSL_ECC, but not both."
 #endif // WEAVE_CONFIG_USE_MICRO_ECC && WEAVE_CONFIG_USE_OPENSSL_ECC
 
+/**
+ *  @def WEAVE_CONFIG_MICRO_ECC_P256_FIXED_BASE_COMB
+ *
+ *  @brief
+ *    When using the Micro ECC implementation, enable (1) or disable (0)
+ *    multiplication of the secp256r1 generator point using a fixed-base
+ *    comb table held in read-only memory.
+ *
+ *    The table occupies 960 bytes and makes ECDH key generation, ECDSA
+ *    signing and EC-JPAKE key generation on secp256r1 between two and three
+ *    times faster.  Signature verification and operations on other curves
+ *    are unaffected.
+ *
+ */
+#ifndef WEAVE_CONFIG_MICRO_ECC_P256_FIXED_BASE_COMB
+#define WEAVE_CONFIG_MICRO_ECC_P256_FIXED_BASE_COMB         0
+#endif // WEAVE_CONFIG_MICRO_ECC_P256_FIXED_BASE_COMB
+
+/**
+ *  @def WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM
+ *
+ *  @brief
+ *    When using the Micro ECC implementation, enable (1) or disable (0)
+ *    platform-specific implementations of ECDSA and ECDH on secp256r1,
+ *    typically backed by a hardware crypto accelerator.
+ *
+ *    When enabled, the platform must provide the P256_* functions declared
+ *    in EllipticCurve.h.  A platform function may return
+ *    #WEAVE_ERROR_NOT_IMPLEMENTED, in which case the Micro ECC
+ *    implementation is used for that operation.  Operations on other
+ *    curves, as well as EC-JPAKE, always use Micro ECC.
+ *
+ */
+#ifndef WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM
+#define WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM        0
+#endif // WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM
+
+#if WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM && !WEAVE_CONFIG_USE_MICRO_ECC
+#error "WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM requires WEAVE_CONFIG_USE_MICRO_ECC."
+#endif // WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM && !WEAVE_CONFIG_USE_MICRO_ECC
+
 /**
  *  @name Weave Elliptic Curve Security Configuration
  *
@@ -686,6 +727,140 @@
 #error "Please assert exactly one of WEAVE_CONFIG_RNG_IMPLEMENTATION_PLATFORM, WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG, or WEAVE_CONFIG_RNG_IMPLEMENTATION_OPENSSL."
 #endif // ((WEAVE_CONFIG_RNG_IMPLEMENTATION_PLATFORM + WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG + WEAVE_CONFIG_RNG_IMPLEMENTATION_OPENSSL) != 1)
 
+/**
+ *  @def WEAVE_CONFIG_NESTDRBG_PER_THREAD
+ *
+ *  @brief
+ *    Enable (1) or disable (0) a separate instance of the Nest DRBG
+ *    for each thread that requests random data.
+ *
+ *    Each thread's instance is created on first use, and is seeded and
+ *    reseeded from the DRBG instantiated by
+ *    nl::Weave::Platform::Security::InitSecureRandomDataSource(), which
+ *    is then only accessed under a lock.  Threads therefore do not
+ *    contend for the DRBG when generating random data.  Requires POSIX
+ *    threads.
+ *
+ *  @note This configuration is only relevant when
+ *        #WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG is set and
+ *        ignored otherwise.
+ *
+ */
+#ifndef WEAVE_CONFIG_NESTDRBG_PER_THREAD
+#define WEAVE_CONFIG_NESTDRBG_PER_THREAD                    0
+#endif // WEAVE_CONFIG_NESTDRBG_PER_THREAD
+
+/**
+ *  @def WEAVE_CONFIG_NESTDRBG_OUTPUT_BUFFER_SIZE
+ *
+ *  @brief
+ *    The size, in bytes, of a buffer of pregenerated output kept with
+ *    each instance of the Nest DRBG, or 0 to generate all requested
+ *    data on demand.
+ *
+ *    Requests smaller than the buffer are served from it, and the
+ *    buffer is refilled by a single DRBG generate request, so that
+ *    small requests (such as message ids and nonces) do not each incur
+ *    the cost of a DRBG state update.  Served output is cleared from
+ *    the buffer. Note that output held in the buffer does not benefit
+ *    from the backtracking resistance of the DRBG.
+ *
+ *  @note This configuration is only relevant when
+ *        #WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG is set and
+ *        ignored otherwise.
+ *
+ */
+#ifndef WEAVE_CONFIG_NESTDRBG_OUTPUT_BUFFER_SIZE
+#define WEAVE_CONFIG_NESTDRBG_OUTPUT_BUFFER_SIZE            0
+#endif // WEAVE_CONFIG_NESTDRBG_OUTPUT_BUFFER_SIZE
+
+/**
+ *  @name Weave Asynchronous Elliptic Curve Operation Configuration
+ *
+ *  @brief
+ *    The following definitions select one of three potential
+ *    implementations of nl::Weave::Crypto::StartAsyncECOperation():
+ *
+ *      * #WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED
+ *      * #WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD
+ *      * #WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM
+ *
+ *    Note that these options are mutually exclusive and only one of
+ *    these options should be set.
+ *
+ *  @{
+ */
+
+/**
+ *  @def WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED
+ *
+ *  @brief
+ *    Enable (1) or disable (0) an implementation of asynchronous
+ *    elliptic curve operations that performs each operation on the
+ *    Weave thread, in a work item scheduled after the event that
+ *    started it.
+ *
+ *  @note This configuration is mutual exclusive with
+ *        #WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD and
+ *        #WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM.
+ *
+ */
+#ifndef WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED
+#define WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED       1
+#endif // WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED
+
+/**
+ *  @def WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD
+ *
+ *  @brief
+ *    Enable (1) or disable (0) an implementation of asynchronous
+ *    elliptic curve operations that performs the operations on a
+ *    POSIX worker thread, posting their completion back to the
+ *    Weave thread.
+ *
+ *    This requires elliptic curve and random number generator
+ *    implementations that may be used from several threads at once,
+ *    such as those of OpenSSL.
+ *
+ *  @note This configuration is mutual exclusive with
+ *        #WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED and
+ *        #WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM.
+ *
+ */
+#ifndef WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD
+#define WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD         0
+#endif // WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD
+
+/**
+ *  @def WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM
+ *
+ *  @brief
+ *    Enable (1) or disable (0) support for a platform-specific
+ *    implementation of asynchronous elliptic curve operations, e.g.
+ *    one using a hardware crypto accelerator.  The platform must
+ *    provide nl::Weave::Crypto::StartAsyncECOperation().
+ *
+ *  @note This configuration is mutual exclusive with
+ *        #WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED and
+ *        #WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD.
+ *
+ */
+#ifndef WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM
+#define WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM       0
+#endif // WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM
+
+/**
+ *  @}
+ */
+
+#if ((WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED + WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD + WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM) != 1)
+#error "Please assert exactly one of WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED, WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD, or WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM."
+#endif // ((WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED + WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD + WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_PLATFORM) != 1)
+
+#if WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD && WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG
+#error "INVALID WEAVE CONFIG: The Weave-provided DRBG cannot be used from the asynchronous elliptic curve worker thread (WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD == 1 && WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG == 1)."
+#endif // WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD && WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG
+
 
 /**
  *  @def WEAVE_CONFIG_DEV_RANDOM_DRBG_SEED
@@ -1013,6 +1188,23 @@
 #define WEAVE_CONFIG_MAX_PEER_NODES                         128
 #endif // WEAVE_CONFIG_MAX_PEER_NODES
 
+/**
+ *  @def WEAVE_CONFIG_MAX_FABRIC_PREFIXES
+ *
+ *  @brief
+ *    The number of additional IPv6 prefixes, such as those of other
+ *    fabrics served by a gateway, that the fabric state can classify
+ *    as fabric addresses.  Lookups use a longest-prefix-match trie
+ *    holding up to 2N-1 nodes of 24 bytes each.
+ *
+ *    Zero disables the feature, leaving only the local fabric's ULA
+ *    prefix recognized.
+ *
+ */
+#ifndef WEAVE_CONFIG_MAX_FABRIC_PREFIXES
+#define WEAVE_CONFIG_MAX_FABRIC_PREFIXES                    0
+#endif // WEAVE_CONFIG_MAX_FABRIC_PREFIXES
+
 /**
  *  @def WEAVE_CONFIG_MAX_CONNECTIONS
  *
@@ -1055,6 +1247,25 @@
 #define WEAVE_CONFIG_MAX_INCOMING_TCP_CON_FROM_SINGLE_IP    2
 #endif // WEAVE_CONFIG_MAX_INCOMING_TCP_CON_FROM_SINGLE_IP
 
+/**
+ *  @def WEAVE_CONFIG_TCP_LISTEN_BACKLOG
+ *
+ *  @brief
+ *    The backlog passed to TCPEndPoint::Listen() for the Weave TCP
+ *    listening endpoints created by WeaveMessageLayer.
+ *
+ *  @details
+ *    The default of 1 suits constrained devices that accept a handful of
+ *    connections.  Servers, and in particular processes that run several
+ *    WeaveMessageLayer shards sharing one port via SO_REUSEPORT, should
+ *    raise this so that bursts of incoming connections are queued by the
+ *    kernel rather than refused.
+ *
+ */
+#ifndef WEAVE_CONFIG_TCP_LISTEN_BACKLOG
+#define WEAVE_CONFIG_TCP_LISTEN_BACKLOG                     1
+#endif // WEAVE_CONFIG_TCP_LISTEN_BACKLOG
+
 /**
  *  @def WEAVE_CONFIG_MAX_TUNNELS
  *
@@ -1077,6 +1288,65 @@
 #define WEAVE_CONFIG_MAX_SESSION_KEYS                       WEAVE_CONFIG_MAX_CONNECTIONS
 #endif // WEAVE_CONFIG_MAX_SESSION_KEYS
 
+/**
+ *  @def WEAVE_CONFIG_SESSION_KEY_RCV_WINDOW_SIZE
+ *
+ *  @brief
+ *    Number of message ids preceding the most recently received one
+ *    that are tracked for duplicate detection on messages encrypted
+ *    with a session key.
+ *
+ *  @details
+ *    A message that arrives out of order by more than this many
+ *    message ids is treated as a duplicate, so larger windows
+ *    tolerate more reordering and retransmission in the network.
+ *    Must be a multiple of 32.
+ *
+ */
+#ifndef WEAVE_CONFIG_SESSION_KEY_RCV_WINDOW_SIZE
+#define WEAVE_CONFIG_SESSION_KEY_RCV_WINDOW_SIZE            64
+#endif // WEAVE_CONFIG_SESSION_KEY_RCV_WINDOW_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_GROUP_KEY_RCV_WINDOW_SIZE
+ *
+ *  @brief
+ *    Number of message ids preceding the most recently received one
+ *    that are tracked, per peer, for duplicate detection on messages
+ *    encrypted with an application group key.
+ *
+ *  @details
+ *    Must be a multiple of 32.  See
+ *    #WEAVE_CONFIG_SESSION_KEY_RCV_WINDOW_SIZE.
+ *
+ */
+#ifndef WEAVE_CONFIG_GROUP_KEY_RCV_WINDOW_SIZE
+#define WEAVE_CONFIG_GROUP_KEY_RCV_WINDOW_SIZE              32
+#endif // WEAVE_CONFIG_GROUP_KEY_RCV_WINDOW_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_UNENCRYPTED_RCV_WINDOW_SIZE
+ *
+ *  @brief
+ *    Number of message ids preceding the most recently received one
+ *    that are tracked, per peer, for duplicate detection on
+ *    unencrypted UDP messages.
+ *
+ *  @details
+ *    Must be a multiple of 32.  See
+ *    #WEAVE_CONFIG_SESSION_KEY_RCV_WINDOW_SIZE.
+ *
+ */
+#ifndef WEAVE_CONFIG_UNENCRYPTED_RCV_WINDOW_SIZE
+#define WEAVE_CONFIG_UNENCRYPTED_RCV_WINDOW_SIZE            32
+#endif // WEAVE_CONFIG_UNENCRYPTED_RCV_WINDOW_SIZE
+
+#if (WEAVE_CONFIG_SESSION_KEY_RCV_WINDOW_SIZE % 32) != 0 || WEAVE_CONFIG_SESSION_KEY_RCV_WINDOW_SIZE == 0 || \
+    (WEAVE_CONFIG_GROUP_KEY_RCV_WINDOW_SIZE % 32) != 0 || WEAVE_CONFIG_GROUP_KEY_RCV_WINDOW_SIZE == 0 || \
+    (WEAVE_CONFIG_UNENCRYPTED_RCV_WINDOW_SIZE % 32) != 0 || WEAVE_CONFIG_UNENCRYPTED_RCV_WINDOW_SIZE == 0
+#error "Weave message id receive window sizes must be non-zero multiples of 32."
+#endif
+
 /**
  *  @def WEAVE_CONFIG_MAX_APPLICATION_EPOCH_KEYS
  *
@@ -1146,6 +1416,54 @@
 #error "Please set WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS to a value greater than zero and smaller than 256."
 #endif // !(WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS > 0 && WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS < 256)
 
+/**
+ *  @def WEAVE_CONFIG_PREDERIVE_NEXT_MSG_ENC_APP_KEYS
+ *
+ *  @brief
+ *    Enable (1) or disable (0) derivation of the next rotating message
+ *    encryption application key ahead of the epoch key rotation.
+ *
+ *    When a rotating application key is first derived, the key that
+ *    replaces it at the next epoch key rotation is also derived into a
+ *    free entry of the key cache, so that messages sent with the new
+ *    key after the rotation do not incur a key derivation.  Pre-derived
+ *    keys never displace cached keys that have been used.
+ *
+ *  @note This configuration is only relevant when
+ *        #WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC is set and
+ *        ignored otherwise.
+ *
+ */
+#ifndef WEAVE_CONFIG_PREDERIVE_NEXT_MSG_ENC_APP_KEYS
+#define WEAVE_CONFIG_PREDERIVE_NEXT_MSG_ENC_APP_KEYS        1
+#endif // WEAVE_CONFIG_PREDERIVE_NEXT_MSG_ENC_APP_KEYS
+
+/**
+ *  @def WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+ *
+ *  @brief
+ *    Enable (1) or disable (0) caching of the expanded cipher state for
+ *    each Weave message encryption key.
+ *
+ *    When enabled, each session key and cached application key also holds
+ *    the expanded AES round keys and the HMAC-SHA1 inner and outer pad
+ *    hash states derived from its key material. These are computed the
+ *    first time the key is used, so that encrypting or decrypting a
+ *    message costs only the block encryption and the hash passes over the
+ *    message itself.
+ *
+ *    This costs roughly 400 bytes of RAM per session key and per cached
+ *    application key, depending on the AES and hash implementations.
+ *
+ *  @note This requires that the platform hash context can be copied by
+ *        value, which is the case for all of the hash implementations
+ *        provided by Weave.
+ *
+ */
+#ifndef WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+#define WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES            1
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
 /**
  *  @name Weave Encrypted Passcode Configuration
  *
@@ -1232,6 +1550,66 @@
 #define WEAVE_CONFIG_DEFAULT_SECURITY_SESSION_IDLE_TIMEOUT           15000
 #endif // WEAVE_CONFIG_DEFAULT_SECURITY_SESSION_IDLE_TIMEOUT
 
+/**
+ *  @def WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS
+ *
+ *  @brief
+ *    The maximum number of session establishments (or key exports)
+ *    that the Weave Security Manager will carry out at the same time.
+ *    Each one holds its own protocol engine state, timer and exchange.
+ *
+ *    Values greater than one require the
+ *    #WEAVE_CONFIG_SECURITY_MGR_MEMORY_MGMT_PLATFORM or
+ *    #WEAVE_CONFIG_SECURITY_MGR_MEMORY_MGMT_MALLOC memory management
+ *    model, since the simple allocator is reset as a whole at the end
+ *    of each session establishment.
+ *
+ */
+#ifndef WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS
+#define WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS            1
+#endif // WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS
+
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS < 1 || WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS > 255
+#error "WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS must be between 1 and 255."
+#endif
+
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS > 1 && WEAVE_CONFIG_SECURITY_MGR_MEMORY_MGMT_SIMPLE
+#error "WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS greater than 1 is not supported with WEAVE_CONFIG_SECURITY_MGR_MEMORY_MGMT_SIMPLE."
+#endif
+
+/**
+ *  @def WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS
+ *
+ *  @brief
+ *    The maximum number of locally initiated CASE session requests
+ *    that are held, rather than failed with
+ *    #WEAVE_ERROR_SECURITY_MANAGER_BUSY, while all session slots are
+ *    in use.  Queued requests are started in the order in which they
+ *    were made, and at most one request per peer node is queued, so
+ *    that a single busy peer cannot occupy the whole queue.
+ *
+ */
+#ifndef WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS
+#define WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS           0
+#endif // WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS
+
+/**
+ *  @def WEAVE_CONFIG_DEFAULT_SESSION_ENCRYPTION_TYPE
+ *
+ *  @brief
+ *    The message encryption type proposed when initiating a CASE or PASE session.
+ *
+ *  @details
+ *    Responders accept any encryption type they support, so this only controls what a node asks
+ *    for.  kWeaveEncryptionType_AES128CCM authenticates and encrypts in a single pass using only
+ *    AES, which suits platforms with AES hardware, but it is not understood by peers that predate
+ *    it.  The default, kWeaveEncryptionType_AES128CTRSHA1, is supported by all peers.
+ *
+ */
+#ifndef WEAVE_CONFIG_DEFAULT_SESSION_ENCRYPTION_TYPE
+#define WEAVE_CONFIG_DEFAULT_SESSION_ENCRYPTION_TYPE                 (nl::Weave::kWeaveEncryptionType_AES128CTRSHA1)
+#endif // WEAVE_CONFIG_DEFAULT_SESSION_ENCRYPTION_TYPE
+
 /**
  *  @def WEAVE_CONFIG_NUM_MESSAGE_BUFS
  *
@@ -1267,6 +1645,43 @@
 #define WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS                  16
 #endif // WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS
 
+/**
+ *  @def WEAVE_CONFIG_EXCHANGE_CONTEXT_INDEX_SIZE
+ *
+ *  @brief
+ *    Number of hash buckets used by the exchange manager to look up
+ *    the active exchange context to which a received message belongs.
+ *
+ *  @details
+ *    Contexts are indexed by exchange identifier, so a received
+ *    message is only compared against the contexts that share its
+ *    bucket rather than against the whole context pool.  Must be a
+ *    power of two.  Systems that raise
+ *    #WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS substantially should raise
+ *    this value in proportion.
+ *
+ */
+#ifndef WEAVE_CONFIG_EXCHANGE_CONTEXT_INDEX_SIZE
+#define WEAVE_CONFIG_EXCHANGE_CONTEXT_INDEX_SIZE            16
+#endif // WEAVE_CONFIG_EXCHANGE_CONTEXT_INDEX_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_UNSOLICITED_MESSAGE_HANDLER_INDEX_SIZE
+ *
+ *  @brief
+ *    Number of hash buckets used by the exchange manager to look up
+ *    the unsolicited message handler for a received message.
+ *
+ *  @details
+ *    Handlers are indexed by profile identifier and message type, with
+ *    profile-wide handlers indexed under a message type of -1.  Must be
+ *    a power of two.
+ *
+ */
+#ifndef WEAVE_CONFIG_UNSOLICITED_MESSAGE_HANDLER_INDEX_SIZE
+#define WEAVE_CONFIG_UNSOLICITED_MESSAGE_HANDLER_INDEX_SIZE 16
+#endif // WEAVE_CONFIG_UNSOLICITED_MESSAGE_HANDLER_INDEX_SIZE
+
 /**
  *  @def WEAVE_CONFIG_MAX_BINDINGS
  *
@@ -1282,6 +1697,77 @@
 #define WEAVE_CONFIG_MAX_BINDINGS                           6
 #endif // WEAVE_CONFIG_MAX_BINDINGS
 
+/**
+ *  @def WEAVE_CONFIG_EXCHANGE_MGR_DYNAMIC_POOLS
+ *
+ *  @brief
+ *    If set to (1), the exchange manager's pools of exchange contexts,
+ *    bindings and unsolicited message handlers grow on demand by
+ *    allocating further slabs from the heap, rather than being limited
+ *    to fixed arrays.
+ *
+ *  @details
+ *    Each slab holds #WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS,
+ *    #WEAVE_CONFIG_MAX_BINDINGS or
+ *    #WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS objects
+ *    respectively, and the first slab of each pool is held within the
+ *    exchange manager.  Allocating and freeing objects take constant
+ *    time however large the pools grow.  Intended for systems with a
+ *    general purpose heap, such as POSIX hosts serving many peers;
+ *    resource-constrained devices should keep the default of (0), for
+ *    which only the fixed arrays are used.
+ *
+ */
+#ifndef WEAVE_CONFIG_EXCHANGE_MGR_DYNAMIC_POOLS
+#define WEAVE_CONFIG_EXCHANGE_MGR_DYNAMIC_POOLS             0
+#endif // WEAVE_CONFIG_EXCHANGE_MGR_DYNAMIC_POOLS
+
+/**
+ *  @def WEAVE_CONFIG_EXCHANGE_MGR_MAX_POOL_SLABS
+ *
+ *  @brief
+ *    When #WEAVE_CONFIG_EXCHANGE_MGR_DYNAMIC_POOLS is enabled, the
+ *    maximum number of slabs, including the first, to which each of
+ *    the exchange manager's pools may grow, or (0) for no limit.
+ *
+ */
+#ifndef WEAVE_CONFIG_EXCHANGE_MGR_MAX_POOL_SLABS
+#define WEAVE_CONFIG_EXCHANGE_MGR_MAX_POOL_SLABS            0
+#endif // WEAVE_CONFIG_EXCHANGE_MGR_MAX_POOL_SLABS
+
+/**
+ *  @def WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+ *
+ *  @brief
+ *    If set to (1), the exchange layer records latency and
+ *    retransmission histograms, which may be read with
+ *    nl::Weave::Stats::GetExchangeStats().
+ *
+ *  @details
+ *    The histograms cover response latency per profile, the number of
+ *    retransmissions of each acknowledged WRMP message, the delay
+ *    before pending acknowledgments are sent, and the lifetime of
+ *    exchange contexts.  Recording a sample costs a few integer
+ *    operations, but adds three timestamps to each exchange context.
+ *
+ */
+#ifndef WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+#define WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS                 0
+#endif // WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+
+/**
+ *  @def WEAVE_CONFIG_EXCHANGE_STATS_MAX_PROFILES
+ *
+ *  @brief
+ *    The number of profiles for which response latency histograms are
+ *    kept separately when #WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS is
+ *    enabled.  Responses for further profiles are recorded together.
+ *
+ */
+#ifndef WEAVE_CONFIG_EXCHANGE_STATS_MAX_PROFILES
+#define WEAVE_CONFIG_EXCHANGE_STATS_MAX_PROFILES            8
+#endif // WEAVE_CONFIG_EXCHANGE_STATS_MAX_PROFILES
+
 /**
  *  @def WEAVE_CONFIG_CONNECT_IP_ADDRS
  *
@@ -1294,6 +1780,43 @@
 #define WEAVE_CONFIG_CONNECT_IP_ADDRS                       4
 #endif // WEAVE_CONFIG_CONNECT_IP_ADDRS
 
+/**
+ *  @def WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS
+ *
+ *  @brief
+ *    Maximum number of TCP connection attempts a WeaveConnection keeps
+ *    in progress at once when connecting to a peer with several
+ *    addresses or host/port list entries.
+ *
+ *    Additional attempts are started, in a staggered manner (see
+ *    #WEAVE_CONFIG_CONNECT_ATTEMPT_DELAY_MSECS), to the next candidate
+ *    address while earlier ones are still in progress, and the first one
+ *    to complete wins, as described in RFC 8305 ("Happy Eyeballs").  The
+ *    resolved addresses of a host are tried alternating between the
+ *    IPv6 and IPv4 families.
+ *
+ *    The default value of (1) tries the addresses one after the other,
+ *    each with the full connect timeout.
+ *
+ */
+#ifndef WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS
+#define WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS          1
+#endif // WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS
+
+/**
+ *  @def WEAVE_CONFIG_CONNECT_ATTEMPT_DELAY_MSECS
+ *
+ *  @brief
+ *    The time, in milliseconds, a WeaveConnection waits for a TCP
+ *    connection attempt to complete before starting a parallel attempt
+ *    to the next candidate address, when
+ *    #WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS is greater than 1.
+ *
+ */
+#ifndef WEAVE_CONFIG_CONNECT_ATTEMPT_DELAY_MSECS
+#define WEAVE_CONFIG_CONNECT_ATTEMPT_DELAY_MSECS            250
+#endif // WEAVE_CONFIG_CONNECT_ATTEMPT_DELAY_MSECS
+
 /**
  *  @def WEAVE_CONFIG_DEFAULT_UDP_MTU_SIZE
  *
@@ -1439,6 +1962,23 @@
 #define WEAVE_CONFIG_ENABLE_TARGETED_LISTEN                 (!WEAVE_SYSTEM_CONFIG_USE_LWIP)
 #endif // WEAVE_CONFIG_ENABLE_TARGETED_LISTEN
 
+/**
+ *  @def WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+ *
+ *  @brief
+ *    Enable support for sending and receiving Weave messages that span
+ *    PacketBuffer chains over TCP connections.
+ *
+ *    Such messages are limited only by the 16-bit message length that
+ *    frames Weave messages on TCP, rather than by the size of a single
+ *    PacketBuffer.  Messages over UDP and BLE are always held in a single
+ *    PacketBuffer.
+ *
+ */
+#ifndef WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+#define WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES            (!WEAVE_SYSTEM_CONFIG_USE_LWIP)
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
 /**
  *  @def WEAVE_CONFIG_ENABLE_UNSECURED_TCP_LISTEN
  *
@@ -1464,6 +2004,24 @@
 #define WEAVE_CONFIG_DEBUG_CERT_VALIDATION                  1
 #endif // WEAVE_CONFIG_DEBUG_CERT_VALIDATION
 
+/**
+ *  @def WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE
+ *
+ *  @brief
+ *    The number of CA certificate signatures remembered, once verified,
+ *    by certificate validation, so that intermediate CA certificates
+ *    that are presented repeatedly (e.g. in every CASE session) are not
+ *    re-verified each time.  The usage and validity time checks of a
+ *    remembered certificate are still made on every validation, and the
+ *    signatures of leaf certificates are always verified.
+ *
+ *    Set to (0) to disable the cache.
+ *
+ */
+#ifndef WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE
+#define WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE             4
+#endif // WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE
+
 /**
  *  @def WEAVE_CONFIG_OPERATIONAL_DEVICE_CERT_CURVE_ID
  *
@@ -1617,6 +2175,68 @@
 #define WEAVE_CONFIG_LEGACY_CASE_AUTH_DELEGATE 1
 #endif
 
+/**
+ *  @def WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+ *
+ *  @brief
+ *    Enable (1) or disable (0) CASE session resumption.
+ *
+ *    When enabled, both parties to a CASE session keep a resumption
+ *    ticket once the session is established, and a later session with
+ *    the same peer is established with an abbreviated handshake, keyed
+ *    from the ticket, that involves no certificate validation,
+ *    signatures or ECDH.  Tickets are single-use: each resumed session
+ *    replaces the ticket with a new one.  The initiator falls back to
+ *    a full CASE handshake if the peer rejects the resumption attempt.
+ *
+ *    Disabled by default, as peers that predate resumption reject, and
+ *    so delay, every resumption attempt.
+ *
+ */
+#ifndef WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+#define WEAVE_CONFIG_ENABLE_CASE_RESUMPTION                 0
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+/**
+ *  @def WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+ *
+ *  @brief
+ *    The number of peer nodes for which a CASE resumption ticket is
+ *    kept.  When the cache is full, the least recently used ticket is
+ *    replaced.
+ *
+ */
+#ifndef WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+#define WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE             4
+#endif // WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_CASE_RESUMPTION_TICKET_LIFETIME
+ *
+ *  @brief
+ *    The time, in seconds, for which a CASE resumption ticket may be
+ *    used after the session from which it was derived was established.
+ *
+ */
+#ifndef WEAVE_CONFIG_CASE_RESUMPTION_TICKET_LIFETIME
+#define WEAVE_CONFIG_CASE_RESUMPTION_TICKET_LIFETIME        (24 * 60 * 60)
+#endif // WEAVE_CONFIG_CASE_RESUMPTION_TICKET_LIFETIME
+
+/**
+ *  @def WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+ *
+ *  @brief
+ *    Enable (1) or disable (0) generation of the ephemeral ECDH key
+ *    for the next CASE session, by an asynchronous elliptic curve
+ *    operation, once the key for the current session has been sent.
+ *    This takes the key generation out of the processing of CASE
+ *    messages.
+ *
+ */
+#ifndef WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+#define WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY              0
+#endif // WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+
 /**
  *  @def WEAVE_CONFIG_MAX_SHARED_SESSIONS_END_NODES
  *
@@ -1881,6 +2501,51 @@
 #define WEAVE_CONFIG_ENABLE_CONDITION_LOGGING 0
 #endif // WEAVE_CONFIG_ENABLE_CONDITION_LOGGING
 
+/**
+ *  @def WEAVE_CONFIG_BINARY_LOGGING
+ *
+ *  @brief
+ *    If asserted (1), include support for binary logging, which can be
+ *    turned on at runtime with nl::Weave::Logging::SetBinaryLogging().
+ *
+ *    In binary logging mode, Log() does not format the message.  It
+ *    records the format string and the raw arguments into a ring buffer,
+ *    and the formatting is deferred until the application calls
+ *    nl::Weave::Logging::FlushBinaryLog(), e.g. when its event loop is
+ *    otherwise idle.  This takes the cost of formatting Detail messages off
+ *    the message path.
+ *
+ *    Not available with the external logging style, which supplies its own
+ *    Log() implementation.
+ */
+#ifndef WEAVE_CONFIG_BINARY_LOGGING
+#define WEAVE_CONFIG_BINARY_LOGGING 0
+#endif // WEAVE_CONFIG_BINARY_LOGGING
+
+/**
+ *  @def WEAVE_CONFIG_BINARY_LOG_BUFFER_SIZE
+ *
+ *  @brief
+ *    Size, in bytes, of the ring buffer holding binary log records
+ *    (see #WEAVE_CONFIG_BINARY_LOGGING).  Messages logged while the buffer
+ *    is full are dropped, and counted.
+ */
+#ifndef WEAVE_CONFIG_BINARY_LOG_BUFFER_SIZE
+#define WEAVE_CONFIG_BINARY_LOG_BUFFER_SIZE 8192
+#endif // WEAVE_CONFIG_BINARY_LOG_BUFFER_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE
+ *
+ *  @brief
+ *    Maximum size, in bytes, of a single binary log record.  String
+ *    arguments are truncated to fit.  Also bounds the length of the message
+ *    formatted from the record.
+ */
+#ifndef WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE
+#define WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE 256
+#endif // WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE
+
 
 /**
  *  @def WEAVE_CONFIG_ENABLE_SERVICE_DIRECTORY
@@ -1934,6 +2599,68 @@
 #define WEAVE_CONFIG_SERVICE_DIR_CONNECT_TIMEOUT_MSECS      (10000)
 #endif // WEAVE_CONFIG_SERVICE_DIR_CONNECT_TIMEOUT_MSECS
 
+/**
+ *  @def WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+ *
+ *  @brief
+ *    The time, in seconds, for which a resolved service directory
+ *    cache is considered valid. A connect request made once the cache
+ *    has expired resolves the directory again before connecting.
+ *
+ *    The default value of (0) disables cache expiry, along with the
+ *    background refresh and the warm start validation below.
+ *
+ */
+#ifndef WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+#define WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS             0
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+
+/**
+ *  @def WEAVE_CONFIG_SERVICE_DIR_CACHE_PREFETCH_SECS
+ *
+ *  @brief
+ *    The time, in seconds, before the service directory cache expires
+ *    at which the service manager queries the directory service in
+ *    the background to refresh it.
+ *
+ */
+#ifndef WEAVE_CONFIG_SERVICE_DIR_CACHE_PREFETCH_SECS
+#define WEAVE_CONFIG_SERVICE_DIR_CACHE_PREFETCH_SECS        300
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_PREFETCH_SECS
+
+/**
+ *  @def WEAVE_CONFIG_SERVICE_DIR_CACHE_REFRESH_RETRY_SECS
+ *
+ *  @brief
+ *    The time, in seconds, after which a failed or deferred background
+ *    refresh of the service directory cache is retried.
+ *
+ */
+#ifndef WEAVE_CONFIG_SERVICE_DIR_CACHE_REFRESH_RETRY_SECS
+#define WEAVE_CONFIG_SERVICE_DIR_CACHE_REFRESH_RETRY_SECS   60
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_REFRESH_RETRY_SECS
+
+/**
+ *  @def WEAVE_CONFIG_SERVICE_DIR_WARM_START_VALIDATE_SECS
+ *
+ *  @brief
+ *    The time, in seconds, after initialization at which a service
+ *    directory restored from persistent storage is validated by a
+ *    background query. Until then, connect requests are served from
+ *    the restored directory without waiting for the directory service.
+ *
+ *    Only used when #WEAVE_CONFIG_PERSIST_SERVICE_DIRECTORY is set and
+ *    #WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS is non-zero.
+ *
+ */
+#ifndef WEAVE_CONFIG_SERVICE_DIR_WARM_START_VALIDATE_SECS
+#define WEAVE_CONFIG_SERVICE_DIR_WARM_START_VALIDATE_SECS   10
+#endif // WEAVE_CONFIG_SERVICE_DIR_WARM_START_VALIDATE_SECS
+
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS && (WEAVE_CONFIG_SERVICE_DIR_CACHE_PREFETCH_SECS >= WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS)
+#error "WEAVE_CONFIG_SERVICE_DIR_CACHE_PREFETCH_SECS must be less than WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS"
+#endif
+
 /**
  *  @def WEAVE_CONFIG_DEFAULT_INCOMING_CONNECTION_IDLE_TIMEOUT
  *
@@ -1965,6 +2692,45 @@
 #define WEAVE_CONFIG_MSG_COUNTER_SYNC_RESP_TIMEOUT          2000
 #endif // WEAVE_CONFIG_MSG_COUNTER_SYNC_RESP_TIMEOUT
 
+/**
+ *  @def WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT
+ *
+ *  @brief
+ *    The slack, as a percentage of their interval, given to the
+ *    timers of periodic protocol activities (heartbeats, tunnel
+ *    liveness and WDM subscription liveness).
+ *
+ *    The slack lets the System Layer fire timers whose windows
+ *    overlap on a single wake-up, so that a sleepy device can stay
+ *    idle longer. Timers that keep a peer informed of the local
+ *    node's liveness may fire up to this much early; timers that
+ *    detect the loss of a peer may fire up to this much late.
+ *
+ *    A value of 0 makes every such timer fire at its nominal time.
+ *
+ */
+#ifndef WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT
+#define WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT       0
+#endif // WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT
+
+#if WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT > 50
+#error "WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT must not exceed 50"
+#endif
+
+/**
+ *  @def WEAVE_CONFIG_HEARTBEAT_AGGREGATOR_MAX_NODES
+ *
+ *  @brief
+ *    The number of distinct nodes whose heartbeats a
+ *    WeaveHeartbeatAggregator can hold between flushes.  When the
+ *    table fills, the pending heartbeats are sent before the
+ *    aggregation window expires.
+ *
+ */
+#ifndef WEAVE_CONFIG_HEARTBEAT_AGGREGATOR_MAX_NODES
+#define WEAVE_CONFIG_HEARTBEAT_AGGREGATOR_MAX_NODES         32
+#endif // WEAVE_CONFIG_HEARTBEAT_AGGREGATOR_MAX_NODES
+
 /**
  *  @def WEAVE_CONFIG_TEST
  *
@@ -2242,6 +3008,41 @@
 #define WEAVE_CONFIG_PERSISTED_COUNTER_DEBUG_LOGGING 0
 #endif
 
+/**
+ * @def WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE
+ *
+ * @brief The largest factor by which a PersistedCounter may grow its
+ *   epoch when the counter advances quickly.
+ *
+ * A counter that exhausts an epoch in less than half of
+ * #WEAVE_CONFIG_PERSISTED_COUNTER_TARGET_EPOCH_DURATION_MS doubles the
+ * size of its next epoch, up to this multiple of the epoch it was
+ * initialized with, and halves it again once an epoch lasts more than
+ * twice that duration.  Larger epochs mean fewer writes to persistent
+ * storage, at the cost of a larger jump in the counter after a reboot.
+ * Must be a power of two; a value of 1 disables adaptive epochs.
+ */
+#ifndef WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE
+#define WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE 16
+#endif
+
+/**
+ * @def WEAVE_CONFIG_PERSISTED_COUNTER_TARGET_EPOCH_DURATION_MS
+ *
+ * @brief The time, in milliseconds, that a PersistedCounter with
+ *   adaptive epochs aims for each epoch to last.
+ *
+ * See #WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE.
+ */
+#ifndef WEAVE_CONFIG_PERSISTED_COUNTER_TARGET_EPOCH_DURATION_MS
+#define WEAVE_CONFIG_PERSISTED_COUNTER_TARGET_EPOCH_DURATION_MS 600000
+#endif
+
+#if (WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE < 1) || \
+    ((WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE & (WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE - 1)) != 0)
+#error "WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE must be a power of two"
+#endif
+
 /**
  * @def WEAVE_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
  *
@@ -2343,6 +3144,26 @@
 #define WEAVE_CONFIG_DEVICE_MGR_DEMAND_ENABLE_UDP     0
 #endif // WEAVE_CONFIG_DEVICE_MGR_DEMAND_ENABLE_UDP
 
+/**
+ *  @def WEAVE_CONFIG_DEVICE_MGR_MAX_IDLE_CONNECTIONS
+ *
+ *  @brief
+ *    Maximum number of idle device connections kept by each WeaveDeviceManager
+ *
+ *  When an idle connection timeout has been set on a WeaveDeviceManager, closing
+ *  a connection to a device leaves the connection, and the secure session bound to
+ *  it, open for the duration of the timeout.  A subsequent ConnectDevice() or
+ *  ReconnectDevice() to the same device, with the same credentials, then takes the
+ *  connection over without repeating the TCP connect and PASE/CASE handshake.
+ *
+ *  This option sets the number of such connections each WeaveDeviceManager keeps.
+ *  When all are in use, the oldest is closed to make room for a new one.
+ *
+ */
+#ifndef WEAVE_CONFIG_DEVICE_MGR_MAX_IDLE_CONNECTIONS
+#define WEAVE_CONFIG_DEVICE_MGR_MAX_IDLE_CONNECTIONS  2
+#endif // WEAVE_CONFIG_DEVICE_MGR_MAX_IDLE_CONNECTIONS
+
 /**
  *  @def WEAVE_CONFIG_MAX_SOFTWARE_VERSION_LENGTH
  *
@@ -2355,6 +3176,119 @@
 #define WEAVE_CONFIG_MAX_SOFTWARE_VERSION_LENGTH           32
 #endif // WEAVE_CONFIG_MAX_SOFTWARE_VERSION_LENGTH
 
+/**
+ *  @def WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE
+ *
+ *  @brief
+ *    Maximum number of software images held by a WeaveImageCache,
+ *    which serves them to the devices of a local fabric in place of
+ *    the service.
+ *
+ */
+#ifndef WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE
+#define WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE                  2
+#endif // WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_URI_LENGTH
+ *
+ *  @brief
+ *    Maximum length of the URI through which a WeaveImageCache
+ *    serves a cached image.
+ *
+ */
+#ifndef WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_URI_LENGTH
+#define WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_URI_LENGTH        128
+#endif // WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_URI_LENGTH
+
+/**
+ *  @def WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_WAITERS
+ *
+ *  @brief
+ *    Maximum number of devices a WeaveImageCache remembers as waiting
+ *    for an image it does not yet hold, to announce the image to them
+ *    once it is added.
+ *
+ */
+#ifndef WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_WAITERS
+#define WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_WAITERS           16
+#endif // WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_WAITERS
+
+/**
+ *  @def WEAVE_CONFIG_SWU_IMAGE_CACHE_MULTICAST_THRESHOLD
+ *
+ *  @brief
+ *    Number of waiting devices from which a WeaveImageCache announces
+ *    a newly added image with a single ImageAnnounce to the link-local
+ *    all-nodes multicast address, rather than one per device.
+ *    0 disables multicast announcements.
+ *
+ */
+#ifndef WEAVE_CONFIG_SWU_IMAGE_CACHE_MULTICAST_THRESHOLD
+#define WEAVE_CONFIG_SWU_IMAGE_CACHE_MULTICAST_THRESHOLD   4
+#endif // WEAVE_CONFIG_SWU_IMAGE_CACHE_MULTICAST_THRESHOLD
+
+/**
+ *  @def WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE
+ *
+ *  @brief
+ *    The number of encoded StatusReport payloads that
+ *    WeaveServerBase::SendStatusReport() keeps for reuse.  Only reports
+ *    that carry a system error are cached, as these are the ones sent
+ *    in bursts when a server rejects requests under load.  Each entry
+ *    takes 32 bytes.
+ *
+ *    Zero disables the cache.
+ *
+ */
+#ifndef WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE
+#define WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE              4
+#endif // WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_RESPONSE_JITTER
+ *
+ *  @brief
+ *    The default upper bound, in milliseconds, of the random delay the
+ *    Device Description server applies to its responses to multicast
+ *    IdentifyRequests, so that the responses of many devices do not
+ *    collide.  Zero sends responses immediately.  Servers may change
+ *    this at runtime.
+ *
+ */
+#ifndef WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_RESPONSE_JITTER
+#define WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_RESPONSE_JITTER 0
+#endif // WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_RESPONSE_JITTER
+
+/**
+ *  @def WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES
+ *
+ *  @brief
+ *    The number of delayed IdentifyResponses a Device Description
+ *    server can hold at once.  Responses beyond this are sent without
+ *    delay.  Zero compiles out response jitter.
+ *
+ */
+#ifndef WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES
+#define WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES 2
+#endif // WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES
+
+/**
+ *  @def WEAVE_CONFIG_PERF_INSTRUMENTATION
+ *
+ *  @brief
+ *    Enable counters that accumulate the time spent in the hot paths
+ *    of the stack.  See Weave/Support/PerfInstrumentation.h.
+ *
+ *    Each instrumented section reads the platform cycle counter twice,
+ *    so this is meant for performance builds only; it is set by the
+ *    --enable-perf-instrumentation configure option.
+ *
+ */
+#ifndef WEAVE_CONFIG_PERF_INSTRUMENTATION
+#define WEAVE_CONFIG_PERF_INSTRUMENTATION                  0
+#endif // WEAVE_CONFIG_PERF_INSTRUMENTATION
+
 /**
  * @def WEAVE_NON_PRODUCTION_MARKER
  *
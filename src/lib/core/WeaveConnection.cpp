@@ -1084,6 +1084,10 @@ void WeaveConnection::DoClose(WEAVE_ERROR err, uint8_t flags)
         else
 #endif
         {
+#if WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+            AbortOtherAttempts();
+#endif
+
             if (mTcpEndPoint != NULL)
             {
                 if (err == WEAVE_NO_ERROR)
@@ -1147,6 +1151,12 @@ void WeaveConnection::HandleResolveComplete(void *appState, INET_ERROR dnsRes, u
 
     WeaveLogProgress(MessageLayer, "Con DNS complete %04X %ld", con->LogId(), (long)dnsRes);
 
+#if WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+    // Alternate between address families, so that a parallel attempt doesn't wait on a broken family.
+    if (dnsRes == INET_NO_ERROR)
+        con->InterleavePeerAddrs();
+#endif
+
     // Attempt to connect to the first resolved address (if any).
     con->TryNextPeerAddress(dnsRes);
 }
@@ -1197,6 +1207,26 @@ WEAVE_ERROR WeaveConnection::TryNextPeerAddress(WEAVE_ERROR lastErr)
     }
 
 exit:
+#if WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+    if (err != WEAVE_NO_ERROR && HasOtherAttempts())
+    {
+        // Wait for the attempts still in progress; the last of them to fail closes the connection.
+        if (mTcpEndPoint != NULL)
+        {
+            mTcpEndPoint->Abort();
+            mTcpEndPoint->Free();
+            mTcpEndPoint = NULL;
+        }
+        State = kState_Connecting;
+        err = WEAVE_NO_ERROR;
+    }
+    else if (err == WEAVE_NO_ERROR && State == kState_Connecting)
+    {
+        // Start a parallel attempt to the next address if this one hasn't completed in time.
+        MessageLayer->SystemLayer->StartTimer(WEAVE_CONFIG_CONNECT_ATTEMPT_DELAY_MSECS, HandleConnectAttemptTimeout, this);
+    }
+#endif
+
     // Enter the closed state if an error occurred.
     if (err != WEAVE_NO_ERROR)
         DoClose(err, 0);
@@ -1307,6 +1337,58 @@ void WeaveConnection::HandleConnectComplete(TCPEndPoint *endPoint, INET_ERROR co
 
     WeaveLogProgress(MessageLayer, "TCP con complete %04X %ld", con->LogId(), (long)conRes);
 
+#if WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+    // If an earlier attempt, racing the current one, completed...
+    if (endPoint != con->mTcpEndPoint)
+    {
+        ConnectAttempt *attempt = NULL;
+
+        for (int i = 0; i < WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS - 1; i++)
+            if (con->mOtherAttempts[i].EndPoint == endPoint)
+                attempt = &con->mOtherAttempts[i];
+
+        VerifyOrDie(attempt != NULL);
+
+        attempt->EndPoint = NULL;
+
+        if (conRes == INET_NO_ERROR)
+        {
+            // It won the race, so make it the connection's end point, dropping the current attempt (if any).
+            if (con->mTcpEndPoint != NULL)
+            {
+                con->mTcpEndPoint->Abort();
+                con->mTcpEndPoint->Free();
+            }
+#if WEAVE_CONFIG_ENABLE_DNS_RESOLVER
+            con->MessageLayer->Inet->CancelResolveHostAddress(HandleResolveComplete, con);
+#endif
+
+            con->mTcpEndPoint = endPoint;
+            con->PeerAddr = attempt->PeerAddr;
+            con->PeerPort = attempt->PeerPort;
+            con->SendDestNodeId = (!con->PeerAddr.IsIPv6ULA() || IPv6InterfaceIdToWeaveNodeId(con->PeerAddr.InterfaceId()) != con->PeerNodeId);
+            con->State = kState_Connecting;
+        }
+        else
+        {
+            endPoint->Free();
+
+            // If an attempt is still in progress, start the next one without waiting out the delay.  Otherwise, if
+            // no other attempts nor a name resolution remain, move on as for a serial attempt.
+            if (con->mTcpEndPoint != NULL)
+                HandleConnectAttemptTimeout(con->MessageLayer->SystemLayer, con, WEAVE_NO_ERROR);
+            else if (con->State == kState_Connecting && !con->HasOtherAttempts())
+                con->TryNextPeerAddress(conRes);
+
+            return;
+        }
+    }
+
+    // The race is over once an attempt succeeds.
+    if (conRes == INET_NO_ERROR)
+        con->AbortOtherAttempts();
+#endif // WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+
     // If the connection was successful...
     if (conRes == INET_NO_ERROR)
     {
@@ -1373,6 +1455,162 @@ void WeaveConnection::HandleConnectComplete(TCPEndPoint *endPoint, INET_ERROR co
     }
 }
 
+#if WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+
+void WeaveConnection::HandleConnectAttemptTimeout(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    WeaveConnection *con = (WeaveConnection *) aAppState;
+    ConnectAttempt *attempt = NULL;
+    bool haveNextAddr = !con->mPeerHostPortList.IsEmpty();
+
+    // Only start another attempt while the current one is in progress.
+    VerifyOrExit(con->State == kState_Connecting && con->mTcpEndPoint != NULL, /* no-op */);
+
+    for (int i = 0; i < WEAVE_CONFIG_CONNECT_IP_ADDRS; i++)
+        if (con->mPeerAddrs[i] != IPAddress::Any)
+            haveNextAddr = true;
+    VerifyOrExit(haveNextAddr, /* no-op */);
+
+    for (int i = 0; i < WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS - 1 && attempt == NULL; i++)
+        if (con->mOtherAttempts[i].EndPoint == NULL)
+            attempt = &con->mOtherAttempts[i];
+    VerifyOrExit(attempt != NULL, /* no-op */);
+
+    // Set the current attempt aside, leaving it to race the next one.
+    attempt->EndPoint = con->mTcpEndPoint;
+    attempt->PeerAddr = con->PeerAddr;
+    attempt->PeerPort = con->PeerPort;
+    con->mTcpEndPoint = NULL;
+
+    WeaveLogProgress(MessageLayer, "Con parallel attempt %04X", con->LogId());
+
+    con->TryNextPeerAddress(WEAVE_ERROR_HOST_PORT_LIST_EMPTY);
+
+exit:
+    return;
+}
+
+bool WeaveConnection::HasOtherAttempts(void) const
+{
+    for (int i = 0; i < WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS - 1; i++)
+        if (mOtherAttempts[i].EndPoint != NULL)
+            return true;
+
+    return false;
+}
+
+void WeaveConnection::AbortOtherAttempts(void)
+{
+    for (int i = 0; i < WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS - 1; i++)
+        if (mOtherAttempts[i].EndPoint != NULL)
+        {
+            mOtherAttempts[i].EndPoint->Abort();
+            mOtherAttempts[i].EndPoint->Free();
+            mOtherAttempts[i].EndPoint = NULL;
+        }
+
+    MessageLayer->SystemLayer->CancelTimer(HandleConnectAttemptTimeout, this);
+}
+
+// Reorders the resolved peer addresses to alternate between the IPv6 and IPv4 families, starting with the family of
+// the address the resolver preferred, as recommended by RFC 8305.
+void WeaveConnection::InterleavePeerAddrs(void)
+{
+#if INET_CONFIG_ENABLE_IPV4
+    IPAddress addrs[WEAVE_CONFIG_CONNECT_IP_ADDRS];
+    int count = 0;
+    bool wantIPv4;
+
+    for (int i = 0; i < WEAVE_CONFIG_CONNECT_IP_ADDRS; i++)
+        if (mPeerAddrs[i] != IPAddress::Any)
+            addrs[count++] = mPeerAddrs[i];
+
+    VerifyOrExit(count > 1, /* no-op */);
+
+    wantIPv4 = addrs[0].IsIPv4();
+
+    for (int i = 0; i < count; i++)
+    {
+        int next = -1;
+
+        // Take the first remaining address of the wanted family, or else the first remaining one.
+        for (int j = 0; j < count; j++)
+            if (addrs[j] != IPAddress::Any && (next < 0 || (addrs[j].IsIPv4() == wantIPv4 && addrs[next].IsIPv4() != wantIPv4)))
+                next = j;
+
+        mPeerAddrs[i] = addrs[next];
+        addrs[next] = IPAddress::Any;
+        wantIPv4 = !mPeerAddrs[i].IsIPv4();
+    }
+
+exit:
+    return;
+#endif // INET_CONFIG_ENABLE_IPV4
+}
+
+#endif // WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+/*
+ * Detaches the first frameLen bytes of a TCP receive queue as a buffer chain of their own, copying any data
+ * that follows them within the same buffer into a new buffer at the head of the remaining queue.
+ */
+static WEAVE_ERROR DetachReceivedFrame(PacketBuffer *&queue, uint32_t frameLen, PacketBuffer *&frameBuf)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *lastBuf = queue;
+    PacketBuffer *restBuf = NULL;
+    PacketBuffer *buf;
+
+    // Find the buffer holding the end of the frame.
+    while (frameLen > lastBuf->DataLength())
+    {
+        frameLen -= lastBuf->DataLength();
+        lastBuf = lastBuf->Next();
+    }
+
+    // Copy out any data that follows the frame.
+    if (frameLen < lastBuf->DataLength())
+    {
+        const uint16_t restLen = lastBuf->DataLength() - frameLen;
+        SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_MessageLayer);
+
+        restBuf = PacketBuffer::NewWithAvailableSize(0, restLen);
+        VerifyOrExit(restBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        memcpy(restBuf->Start(), lastBuf->Start() + frameLen, restLen);
+        restBuf->SetDataLength(restLen);
+    }
+
+    // Move the buffers holding the frame from the queue to a chain of their own.
+    frameBuf = NULL;
+    do
+    {
+        buf = queue;
+        queue = queue->DetachTail();
+
+        if (frameBuf == NULL)
+            frameBuf = buf;
+        else
+            frameBuf->AddToEnd(buf);
+    } while (buf != lastBuf);
+
+    lastBuf->SetDataLength(static_cast<uint16_t>(frameLen), frameBuf);
+
+    if (restBuf != NULL)
+    {
+        if (queue != NULL)
+            restBuf->AddToEnd(queue);
+        queue = restBuf;
+    }
+
+exit:
+    return err;
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
 void WeaveConnection::HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *data)
 {
     WEAVE_ERROR err;
@@ -1406,14 +1644,70 @@ void WeaveConnection::HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *da
         // Attempt to parse an message from the head of the received queue.
         err = msgLayer->DecodeMessageWithLength(data, con->PeerNodeId, con, &msgInfo, &payload, &payloadLen, &frameLen);
 
-        // If the initial buffer in the receive queue is not big enough to hold the entirety of
-        // the incoming message...
-        if (err == WEAVE_ERROR_MESSAGE_TOO_LONG)
+        // If the initial buffer in the receive queue does not hold the entirety of the incoming
+        // message...
+        if (err == WEAVE_ERROR_MESSAGE_TOO_LONG || err == WEAVE_ERROR_MESSAGE_INCOMPLETE)
         {
+            // If the queue as a whole does not hold the message yet, wait for more data from the
+            // peer without moving any of the data already received.
+            if (data->TotalLength() < frameLen)
+            {
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+                // LwIP shares its buffer pool with the network interface, so release the small
+                // buffers holding the partial message as it arrives rather than holding them all.
+                if (data->Next() != NULL)
+                    data->CompactHead();
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+                // Open the receive window just enough to allow the remainder of the message to be received.
+                // This is necessary in the case where the message size exceeds the TCP window size to ensure
+                // the peer has enough window to send us the entire message.
+                uint16_t neededLen = frameLen - data->TotalLength();
+                err = endPoint->AckReceive(neededLen);
+                if (err == WEAVE_NO_ERROR)
+                    break;
+            }
+
             // The Weave message decoding logic expects message data to be in contiguous memory.
-            // Therefore, if the packet buffer containing the initial portion of the message is
-            // not big enough to hold the entirety of the message, the data must be moved into
-            // a new buffer that is big enough.
+            // Therefore, move only the portion of the message held by subsequent buffers into the
+            // initial buffer. Since the initial buffer then usually ends with the message, it can
+            // be handed to the application below without a further copy.
+            else if (data->PullUp(static_cast<uint16_t>(frameLen)))
+            {
+                continue;
+            }
+
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+            // If no single buffer can hold the entire message, decode it in place across the buffers
+            // of the receive queue and hand it to the application as a chain.
+            else if (frameLen > WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX)
+            {
+                PacketBuffer * frameBuf;
+
+                err = DetachReceivedFrame(data, frameLen, frameBuf);
+                if (err == WEAVE_NO_ERROR)
+                {
+                    // Move as much of the message as fits into the first buffer, which must hold the
+                    // message and exchange headers, then skip the message length field.
+                    frameBuf->CompactHead();
+                    frameBuf->SetStart(frameBuf->Start() + 2);
+
+                    err = msgLayer->DecodeMessage(frameBuf, con->PeerNodeId, con, &msgInfo, &payload, &payloadLen);
+                    if (err == WEAVE_NO_ERROR)
+                    {
+                        payloadBuf = frameBuf;
+                        payloadBuf->SetStart(payload);
+                    }
+                    else
+                    {
+                        PacketBuffer::Free(frameBuf);
+                    }
+                }
+            }
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+            // If the initial buffer is not big enough to hold the entire message, the data must be
+            // moved into a new buffer that is.
             //
             // This situation can arise, for example, when when a TCP segment arrives containing
             // part of a Weave message and the underlying network interface chooses to place the
@@ -1427,45 +1721,26 @@ void WeaveConnection::HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *da
             // in, the network interface can simply discard the packet, resulting in the peer
             // retransmitting it and the system recovering gracefully once the buffer pressure
             // subsides.
-
-            // Attempt to allocate a buffer big enough to hold the entire message.  Fail with
-            // WEAVE_ERROR_MESSAGE_TOO_LONG if no such buffer is available.
-            PacketBuffer * newBuf = PacketBuffer::NewWithAvailableSize(0, frameLen);
-            if (newBuf == NULL)
+            else
             {
-                break;
-            }
-
-            // Prepend the new buffer to the receive queue and copy the received message data into
-            // the new buffer, discarding the original buffer(s).
-            newBuf->AddToEnd(data);
-            data = newBuf;
-            data->CompactHead();
+                // Attempt to allocate a buffer big enough to hold the entire message.  Fail with
+                // WEAVE_ERROR_MESSAGE_TOO_LONG if no such buffer is available.
+                SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_MessageLayer);
+                PacketBuffer * newBuf = PacketBuffer::NewWithAvailableSize(0, frameLen);
+                if (newBuf == NULL)
+                {
+                    break;
+                }
 
-            // Try again to decode the message.
-            continue;
-        }
+                // Prepend the new buffer to the receive queue and copy the received message data into
+                // the new buffer, discarding the original buffer(s) as they empty.
+                newBuf->AddToEnd(data);
+                data = newBuf;
+                data->PullUp(static_cast<uint16_t>(frameLen));
 
-        // If the initial buffer in the receive queue contains only part of the next message...
-        if (err == WEAVE_ERROR_MESSAGE_INCOMPLETE)
-        {
-            // If there are more buffers in the queue, move as much data as possible into the head buffer
-            // and try again.
-            if (data->Next() != NULL)
-            {
-                data->CompactHead();
+                // Try again to decode the message.
                 continue;
             }
-
-            // Otherwise, we must wait for more data from the peer...
-
-            // Open the receive window just enough to allow the remainder of the message to be received.
-            // This is necessary in the case where the message size exceeds the TCP window size to ensure
-            // the peer has enough window to send us the entire message.
-            uint16_t neededLen = frameLen - data->DataLength();
-            err = endPoint->AckReceive(neededLen);
-            if (err == WEAVE_NO_ERROR)
-                break;
         }
 
         // If we successfully parsed a message, open the TCP receive window by the size of the message.
@@ -1479,7 +1754,8 @@ void WeaveConnection::HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *da
                 err = WEAVE_ERROR_INVALID_DESTINATION_NODE_ID;
         }
 
-        if (err == WEAVE_NO_ERROR)
+        // Unless the message was already detached from the receive queue as a chain...
+        if (err == WEAVE_NO_ERROR && payloadBuf == NULL)
         {
             // If there's no more data in the current buffer beyond the message that was just parsed,
             // then avoid a copy by giving the buffer to the application layer.
@@ -1498,6 +1774,7 @@ void WeaveConnection::HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *da
             // payload data into a new buffer and arrange to pass the new buffer to the application.
             else
             {
+                SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_MessageLayer);
                 payloadBuf = PacketBuffer::New(0);
                 if (payloadBuf != NULL)
                 {
@@ -1674,6 +1951,9 @@ void WeaveConnection::Init(WeaveMessageLayer *msgLayer)
     mConnectTimeout = 0;
 #if WEAVE_CONFIG_ENABLE_DNS_RESOLVER
     mDNSOptions = 0;
+#endif
+#if WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+    memset(mOtherAttempts, 0, sizeof(mOtherAttempts));
 #endif
     mFlags = 0;
 }
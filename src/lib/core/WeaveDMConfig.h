@@ -243,6 +243,25 @@
 #define WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK 1
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
+/**
+ *  @def WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK
+ *
+ *  @brief
+ *    Enable (1) or disable (0) lazy schema validation of incoming
+ *    notification requests. When enabled, instead of validating the
+ *    whole message in a pre-flight pass, each data element is
+ *    validated as it is handed to its data sink, and the event list
+ *    just before it is delivered to the application. This saves a
+ *    full extra pass over large notifies, at the cost of a malformed
+ *    element only being detected after the elements preceding it
+ *    have been stored. Only meaningful when
+ *    #WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK is enabled.
+ *
+ */
+#ifndef WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK
+#define WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK 0
+#endif // WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK
+
 /**
  *  @def WDM_MAX_NUM_SUBSCRIPTION_CLIENTS
  *
@@ -269,6 +288,46 @@
 #define WDM_MAX_NUM_SUBSCRIPTION_HANDLERS 2
 #endif // WDM_MAX_NUM_SUBSCRIPTION_HANDLERS
 
+/**
+ *  @def WDM_PUBLISHER_HANDLER_INDEX_SIZE
+ *
+ *  @brief
+ *    Number of hash buckets in the index used to find subscription
+ *    handlers by (peer node id, subscription id). Hubs and service
+ *    emulators configured with a large handler pool use the index to
+ *    avoid scanning every handler on each incoming subscription
+ *    message. 0 disables the index; by default it is only enabled for
+ *    pools of more than 16 handlers.
+ *
+ */
+#ifndef WDM_PUBLISHER_HANDLER_INDEX_SIZE
+#if WDM_MAX_NUM_SUBSCRIPTION_HANDLERS > 16
+#define WDM_PUBLISHER_HANDLER_INDEX_SIZE (WDM_MAX_NUM_SUBSCRIPTION_HANDLERS)
+#else
+#define WDM_PUBLISHER_HANDLER_INDEX_SIZE 0
+#endif
+#endif // WDM_PUBLISHER_HANDLER_INDEX_SIZE
+
+/**
+ *  @def WDM_PUBLISHER_TRAIT_INDEX_SIZE
+ *
+ *  @brief
+ *    Number of hash buckets in the index used to find the
+ *    subscriptions to a trait instance, by trait data handle, when the
+ *    trait instance is marked dirty. Without it, every change walks the
+ *    trait instance list of every subscription handler. 0 disables the
+ *    index; by default it is only enabled for pools of more than 16
+ *    handlers.
+ *
+ */
+#ifndef WDM_PUBLISHER_TRAIT_INDEX_SIZE
+#if WDM_MAX_NUM_SUBSCRIPTION_HANDLERS > 16
+#define WDM_PUBLISHER_TRAIT_INDEX_SIZE 32
+#else
+#define WDM_PUBLISHER_TRAIT_INDEX_SIZE 0
+#endif
+#endif // WDM_PUBLISHER_TRAIT_INDEX_SIZE
+
 /**
  *  @def WDM_ENABLE_SUBSCRIPTION_CANCEL
  *
@@ -416,6 +475,78 @@
 #define WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_MERGE_HANDLE_SET 4
 #endif
 
+/**
+ *  @def WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_DIRTY_TRAIT_INSTANCES
+ *
+ *  @brief
+ *    Determines the number of trait instances the intermediate solver can track dirty property handles for with a
+ *    per-instance bitset within any given evaluation cycle. Dirty handles of further trait instances, and handles within
+ *    dictionary elements, are tracked in the granular dirty store (see #WDM_PUBLISHER_MAX_ITEMS_IN_TRAIT_DIRTY_STORE).
+ */
+#ifndef WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_DIRTY_TRAIT_INSTANCES
+#define WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_DIRTY_TRAIT_INSTANCES 4
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_SCHEMA_HANDLES
+ *
+ *  @brief
+ *    Determines the size, in bits, of each per-trait-instance dirty bitset of the intermediate solver. Trait instances
+ *    whose schema has more property schema handles than this are tracked in the granular dirty store instead.
+ */
+#ifndef WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_SCHEMA_HANDLES
+#define WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_SCHEMA_HANDLES 64
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE
+ *
+ *  @brief
+ *    Size, in bytes, of the buffer the notification engine uses to hold data elements encoded during
+ *    a single evaluation cycle. Subscriptions that need the same trait instance data in that cycle
+ *    copy the cached encoding instead of re-running the graph solver and re-reading the data source.
+ *    Set to 0 to disable the cache.
+ */
+#ifndef WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE
+#define WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE 512
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+ *
+ *  @brief
+ *    Enable (1) or disable (0) support for the optional version history a trait data source can keep
+ *    (see TraitDataSource::SetVersionHistoryStore). When a subscriber reports a version that is still
+ *    covered by the history, the first notify only carries the part of the trait that changed since
+ *    that version instead of the whole trait instance.
+ */
+#ifndef WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+#define WDM_PUBLISHER_VERSION_HISTORY_SUPPORT 1
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_SNAPSHOT_SUPPORT
+ *
+ *  @brief
+ *    Enable (1) or disable (0) support for the optional snapshot a trait data source can keep of its
+ *    encoded root (see TraitDataSource::SetSnapshotStore). While the snapshot is valid, a read of the
+ *    whole trait instance copies the pre-encoded members instead of walking the schema and calling
+ *    GetLeafData for every property. The snapshot is discarded whenever the source is marked dirty.
+ */
+#ifndef WDM_PUBLISHER_SNAPSHOT_SUPPORT
+#define WDM_PUBLISHER_SNAPSHOT_SUPPORT 1
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_DATA_ELEMENT_CACHE_MAX_ENTRIES
+ *
+ *  @brief
+ *    Maximum number of encoded data elements held in the notification engine data element cache.
+ */
+#ifndef WDM_PUBLISHER_DATA_ELEMENT_CACHE_MAX_ENTRIES
+#define WDM_PUBLISHER_DATA_ELEMENT_CACHE_MAX_ENTRIES 8
+#endif
+
 /**
  *  @def WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE
  *
@@ -428,6 +559,36 @@
 #define WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE  10
 #endif
 
+/**
+ *  @def WDM_UPDATE_MAX_REQUESTS_IN_FLIGHT
+ *
+ *  @brief
+ *    Maximum number of UpdateRequests a SubscriptionClient keeps outstanding at the same time.
+ *    Pending trait instances are spread over the available requests, each with its own
+ *    in-progress path list; a trait instance is only ever part of one request at a time.
+ *    Every additional request costs one exchange context and one in-progress path store of
+ *    WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE items. The default of 1 sends one
+ *    UpdateRequest (or chain of PartialUpdateRequests) at a time.
+ */
+#ifndef WDM_UPDATE_MAX_REQUESTS_IN_FLIGHT
+#define WDM_UPDATE_MAX_REQUESTS_IN_FLIGHT 1
+#endif
+
+/**
+ *  @def WDM_UPDATE_MAX_PACKING_ATTEMPTS
+ *
+ *  @brief
+ *    When a DataElement does not fit in what is left of an UpdateRequest payload, the
+ *    UpdateEncoder tries the DataElements that follow it in the in-progress list and packs
+ *    the first one that fits in its place; the one that did not fit goes in the next payload.
+ *    This is the maximum number of such trial encodings per payload. Each trial reads the
+ *    data from the sink again, so this bounds the extra work spent to save messages.
+ *    Setting it to 0 restores strictly in-order encoding.
+ */
+#ifndef WDM_UPDATE_MAX_PACKING_ATTEMPTS
+#define WDM_UPDATE_MAX_PACKING_ATTEMPTS 8
+#endif
+
 /**
  *  @def WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT
  *
@@ -441,6 +602,34 @@
 #define WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT 4
 #endif
 
+/**
+ *  @def WDM_PUBLISHER_DEFAULT_MIN_NOTIFY_INTERVAL_MSEC
+ *
+ *  @brief
+ *    The default minimum interval, in milliseconds, between the starts of two consecutive notifies on an established
+ *    subscription. Changes made to trait data during this interval are coalesced and sent in a single notify carrying the
+ *    latest state once the interval has elapsed. The interval can be overridden per subscription through
+ *    SubscriptionHandler::SetMinNotifyInterval. A value of 0 disables coalescing.
+ *
+ */
+#ifndef WDM_PUBLISHER_DEFAULT_MIN_NOTIFY_INTERVAL_MSEC
+#define WDM_PUBLISHER_DEFAULT_MIN_NOTIFY_INTERVAL_MSEC 0
+#endif
+
+/**
+ *  @def WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+ *
+ *  @brief
+ *    Enable (1) or disable (0) sending notifies on established subscriptions after the publisher lock has been released.
+ *    When enabled, the notification engine only builds notifies while holding the lock, and hands the finished messages
+ *    to the exchange layer (encryption, retransmission bookkeeping, network send) once it has unlocked, which shortens
+ *    the time application threads updating trait data are blocked. Publishers serving many subscriptions benefit most.
+ *
+ */
+#ifndef WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+#define WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK 0
+#endif
+
 /**
  * The auto-generated schema tables key off this define to enable/disable certain fields in the tables. Enable this for now, but remove this define
  * once it has been similarly removed from the auto-generated code since all products are expected to need dictionary support, so the savings in flash/ram
@@ -478,6 +667,48 @@
 #define TDM_VERSIONING_SUPPORT 1
 #endif
 
+/**
+ * @def TDM_SCHEMA_INDEX_SUPPORT
+ *
+ * @brief Enable (1) or disable (0) support for the optional lookup
+ *   tables a schema can attach to its TraitSchemaEngine::Schema (see
+ *   TRAIT_SCHEMA_INDEX_DEFINE). With them, resolving a path tag to a child
+ *   handle is a binary search among that node's children instead of a scan
+ *   of the whole schema handle table. Schemas that don't provide the tables
+ *   are not affected; disabling this saves one pointer per schema.
+ */
+#ifndef TDM_SCHEMA_INDEX_SUPPORT
+#define TDM_SCHEMA_INDEX_SUPPORT 1
+#endif
+
+/**
+ * @def TDM_PACKED_SCHEMA_SUPPORT
+ *
+ * @brief Enable (1) or disable (0) support for the compact schema
+ *   tables a schema can attach to its TraitSchemaEngine::Schema (see
+ *   TraitSchemaEngine::PackedSchema). They hold 8-bit parent handles,
+ *   context tags and a nibble of flags per schema handle in separate
+ *   arrays, replacing the schema handle table and the per-handle
+ *   bitfields for traits with fewer than 256 schema handles. Disabling
+ *   this saves one pointer per schema and a branch per lookup.
+ */
+#ifndef TDM_PACKED_SCHEMA_SUPPORT
+#define TDM_PACKED_SCHEMA_SUPPORT 1
+#endif
+
+/**
+ * @def TDM_SINK_CHANGE_SET_SUPPORT
+ *
+ * @brief Enable (1) or disable (0) support for the change set mode of
+ *   trait data sinks (see TraitDataSink::SetChangeSetStore). A sink in
+ *   that mode gets all the data elements of a DataList in one
+ *   OnChangeSet call once the whole list has been processed, instead of
+ *   per-leaf SetLeafData calls and per-element events.
+ */
+#ifndef TDM_SINK_CHANGE_SET_SUPPORT
+#define TDM_SINK_CHANGE_SET_SUPPORT 1
+#endif
+
 /**
  *  @def WDM_PUBLISHER_ENABLE_CUSTOM_COMMAND_HANDLER
  *
@@ -563,6 +794,22 @@
 #define WDM_MAX_NOTIFICATION_SIZE 2048
 #endif /* WDM_MAX_NOTIFICATION_SIZE */
 
+/**
+ * @def WDM_VIEW_CLIENT_MAX_PATHS_PER_REQUEST
+ *
+ * @brief
+ *   Maximum number of trait paths a ViewClient puts in a single
+ *   ViewRequest. The remaining paths are sent in further requests
+ *   once the previous response has been processed, which keeps each
+ *   ViewResponse within what the publisher can send. Requests are
+ *   also split whenever the paths don't fit in
+ *   WDM_MAX_NOTIFICATION_SIZE. 0 means no limit on the number of
+ *   paths.
+ */
+#ifndef WDM_VIEW_CLIENT_MAX_PATHS_PER_REQUEST
+#define WDM_VIEW_CLIENT_MAX_PATHS_PER_REQUEST 0
+#endif /* WDM_VIEW_CLIENT_MAX_PATHS_PER_REQUEST */
+
 /**
  * @def WDM_MIN_NOTIFICATION_SIZE
  *
@@ -712,6 +959,35 @@
 #define WDM_RESUBSCRIBE_WAIT_TIME_MULTIPLIER_MS 10000
 #endif
 
+/**
+ *  @def WDM_RESUBSCRIBE_JITTER_BASE_MS
+ *
+ *  @brief
+ *    If auto resubscribe is enabled with SubscriptionClient::JitteredResubscribePolicyCallback,
+ *    the backoff window of the first retry; the window doubles at every retry, up to
+ *    WDM_RESUBSCRIBE_MAX_RETRY_WAIT_INTERVAL_MS.
+ *
+ */
+#ifndef WDM_RESUBSCRIBE_JITTER_BASE_MS
+#define WDM_RESUBSCRIBE_JITTER_BASE_MS 1000
+#endif
+
+/**
+ *  @def WDM_MAX_CONCURRENT_RESUBSCRIBES
+ *
+ *  @brief
+ *    Maximum number of SubscriptionClients that can be resubscribing at the same time,
+ *    counted from the end of a client's resubscribe holdoff until its subscription is
+ *    established or fails again. Clients whose holdoff expires while the limit is reached
+ *    wait for one of the others to finish. This keeps a device with many subscriptions
+ *    from hitting the service with all of them at once after an outage.
+ *    0 means no limit.
+ *
+ */
+#ifndef WDM_MAX_CONCURRENT_RESUBSCRIBES
+#define WDM_MAX_CONCURRENT_RESUBSCRIBES 0
+#endif
+
 /**
  *  @def WEAVE_CONFIG_DATAMANAGEMENT_CLIENT_EXPERIMENTAL
  *
@@ -232,6 +232,7 @@ bool FormatWeaveError(char * buf, uint16_t bufSize, int32_t err)
     case WEAVE_ERROR_SESSION_KEY_SUSPENDED                      : desc = "Session key suspended"; break;
     case WEAVE_ERROR_UNSUPPORTED_WIRELESS_REGULATORY_DOMAIN     : desc = "Unsupported wireless regulatory domain"; break;
     case WEAVE_ERROR_UNSUPPORTED_WIRELESS_OPERATING_LOCATION    : desc = "Unsupported wireless operating location"; break;
+    case WEAVE_ERROR_CASE_RESUMPTION_TICKET_NOT_FOUND           : desc = "CASE resumption ticket not found"; break;
     }
 #endif // !WEAVE_CONFIG_SHORT_ERROR_STR
 
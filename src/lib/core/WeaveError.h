@@ -1757,6 +1757,15 @@ typedef WEAVE_CONFIG_ERROR_TYPE WEAVE_ERROR;
  */
 #define WEAVE_ERROR_UNSUPPORTED_WIRELESS_OPERATING_LOCATION      _WEAVE_ERROR(185)
 
+/**
+ *  @def WEAVE_ERROR_CASE_RESUMPTION_TICKET_NOT_FOUND
+ *
+ *  @brief
+ *    No CASE resumption ticket matching the request was found.
+ *
+ */
+#define WEAVE_ERROR_CASE_RESUMPTION_TICKET_NOT_FOUND             _WEAVE_ERROR(186)
+
 
 /**
  *  @}
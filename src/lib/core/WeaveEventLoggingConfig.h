@@ -176,4 +176,146 @@
 #define WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT 0
 #endif
 
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE
+ *
+ * @brief
+ *   Number of external event registrations, per event buffer, kept in
+ *   a registry sorted by event ID, or 0 to disable the registry.  With
+ *   the registry, unregistering external events and notifying their
+ *   providers of delivery and eviction use a binary search of the
+ *   registry instead of scanning the event buffers, and registering
+ *   more external events than fit returns WEAVE_ERROR_NO_MEMORY.
+ *   Only used with WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT.
+ *   At most 255.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+ *
+ * @brief
+ *   Number of slots in the staging ring used by LogEventStaged(), or 0
+ *   to disable staged logging.  Must be a power of two.  Each slot
+ *   holds one event until the Weave thread moves it into the event
+ *   buffers.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS
+#define WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOT_SIZE
+ *
+ * @brief
+ *   Maximum size, in bytes, of the encoded event data of a staged
+ *   event.  Events whose data does not fit are rejected by
+ *   LogEventStaged().
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOT_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOT_SIZE 128
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE
+ *
+ * @brief
+ *   Number of entries, per event buffer, in the sparse index that
+ *   FetchEventsSince() uses to start reading near the requested event
+ *   rather than at the head of the buffers.  0 disables the index.
+ *   Worth enabling with large event buffers.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_INDEX_INTERVAL
+ *
+ * @brief
+ *   Events whose event ID is a multiple of this value are recorded in
+ *   the sparse event index (see WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE).
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_INDEX_INTERVAL
+#define WEAVE_CONFIG_EVENT_LOGGING_INDEX_INTERVAL 32
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+ *
+ * @brief
+ *   Number of entries in the schema dictionary, or 0 to disable it.
+ *   Each entry holds the trait profile ID, schema versions, event
+ *   type and event source of a kind of event; events matching an
+ *   entry are stored with a one byte reference to it instead of those
+ *   fields, and are expanded again when they are read out of the event
+ *   buffers.  Entries are added as new kinds of events are logged and
+ *   are never replaced, so the dictionary should be large enough for
+ *   the events a device logs most often.  At most 255.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE
+#define WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+ *
+ * @brief
+ *   Enable LoggingManagement::AttachPersistentState(): when the event
+ *   buffers live in memory that outlives the process (a memory-mapped
+ *   file, retained RAM), the logging subsystem keeps a crash-consistent
+ *   record of the buffer positions and event ID counters alongside
+ *   them, and restores the events from it at startup without parsing
+ *   them.  As with LoadEvents(), external events do not survive a
+ *   restart.  Not compatible with the schema dictionary.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+#define WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_MAPPED_STORAGE
+ *
+ * @brief
+ *   Enable MappedEventLogStorage, which provides event buffers and
+ *   persistent state (see WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE)
+ *   backed by a memory-mapped file.  Requires a POSIX system.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_MAPPED_STORAGE
+#define WEAVE_CONFIG_EVENT_LOGGING_MAPPED_STORAGE 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+ *
+ * @brief
+ *   Enable LoggingManagement::SetFlushPolicy(): instead of the fixed
+ *   byte thresholds, an application-supplied policy decides when the
+ *   event log is offloaded, based on how full the buffers are, how
+ *   fast they fill, the time since the last offload, how long the
+ *   consumers take to acknowledge an offload, and whether the link
+ *   to them is up.  LoggingManagement::AdaptiveFlushPolicy is a
+ *   ready-made policy.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+#define WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY 0
+#endif
+
+/**
+ * @def WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES
+ *
+ * @brief
+ *   Number of per-profile sampling rules that can be set with
+ *   LoggingManagement::SetEventSamplingRule(), or 0 to disable
+ *   sampling.  A rule keeps one in every N events of a profile at or
+ *   below a given importance and caps their rate with a token bucket;
+ *   events it rejects are counted and dropped before they are
+ *   encoded.
+ */
+#ifndef WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES
+#define WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES 0
+#endif
+
 #endif /* WEAVEEVENTLOGGINGCONFIG_H */
@@ -32,6 +32,7 @@
 #endif
 
 #include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveStats.h>
 #include <Weave/Profiles/WeaveProfiles.h>
 #include <Weave/Profiles/common/CommonProfile.h>
 #include <Weave/Profiles/security/WeaveSecurity.h>
@@ -42,6 +43,7 @@
 #include <Weave/Support/WeaveFaultInjection.h>
 #include <SystemLayer/SystemTimer.h>
 #include <SystemLayer/SystemStats.h>
+#include <SystemLayer/SystemTrace.h>
 
 namespace nl {
 namespace Weave {
@@ -86,12 +88,18 @@ WEAVE_ERROR WeaveExchangeManager::Init(WeaveMessageLayer *msgLayer)
 
     NextExchangeId = GetRandU16();
 
-    memset(ContextPool, 0, sizeof(ContextPool));
+    ContextPool.Init(WEAVE_CONFIG_EXCHANGE_MGR_MAX_POOL_SLABS);
+    memset(mContextIndex, 0, sizeof(mContextIndex));
     mContextsInUse = 0;
 
     InitBindingPool();
 
-    memset(UMHandlerPool, 0, sizeof(UMHandlerPool));
+    UMHandlerPool.Init(WEAVE_CONFIG_EXCHANGE_MGR_MAX_POOL_SLABS);
+    memset(mUMHandlerIndex, 0, sizeof(mUMHandlerIndex));
+
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kExchangeMgr_NumContexts, WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS);
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers, WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS);
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kExchangeMgr_NumBindings, WEAVE_CONFIG_MAX_BINDINGS);
     OnExchangeContextChanged = NULL;
 
     msgLayer->ExchangeMgr = this;
@@ -102,6 +110,11 @@ WEAVE_ERROR WeaveExchangeManager::Init(WeaveMessageLayer *msgLayer)
     mWRMPTimerInterval  = WEAVE_CONFIG_WRMP_TIMER_DEFAULT_PERIOD;       //WRMP Timer tick period
 
     memset(RetransTable, 0, sizeof(RetransTable));
+    mRetransQueueHead = NULL;
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kExchangeMgr_NumRetransEntries, WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE);
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+    memset(mWRMPSendWindows, 0, sizeof(mWRMPSendWindows));
+#endif
 
     mWRMPTimeStampBase = System::Timer::GetCurrentEpoch();
 
@@ -150,6 +163,10 @@ WEAVE_ERROR WeaveExchangeManager::Shutdown()
 
     OnExchangeContextChanged = NULL;
 
+    ContextPool.Shutdown();
+    BindingPool.Shutdown();
+    UMHandlerPool.Shutdown();
+
     FabricState = NULL;
 
     State = kState_NotInitialized;
@@ -216,6 +233,7 @@ ExchangeContext *WeaveExchangeManager::NewContext(const uint64_t &peerNodeId, co
     if (ec != NULL)
     {
         ec->ExchangeId = NextExchangeId++;
+        AddContextToIndex(ec);
         ec->PeerNodeId = peerNodeId;
         ec->PeerAddr = peerAddr;
         ec->PeerPort = (peerPort != 0) ? peerPort : WEAVE_PORT;
@@ -242,7 +260,7 @@ ExchangeContext *WeaveExchangeManager::NewContext(const uint64_t &peerNodeId, co
 #if WEAVE_CONFIG_ENABLE_EPHEMERAL_UDP_PORT
         ec->SetUseEphemeralUDPPort(MessageLayer->EphemeralUDPPortEnabled());
 #endif // WEAVE_CONFIG_ENABLE_EPHEMERAL_UDP_PORT
-        WeaveLogProgress(ExchangeManager, "ec id: %d, AppState: 0x%x", EXCHANGE_CONTEXT_ID(ec - ContextPool), ec->AppState);
+        WeaveLogProgress(ExchangeManager, "ec id: %d, AppState: 0x%x", EXCHANGE_CONTEXT_ID(ContextPool.GetIndex(ec)), ec->AppState);
     }
     return ec;
 }
@@ -288,8 +306,7 @@ ExchangeContext *WeaveExchangeManager::NewContext(WeaveConnection *con, void *ap
  */
 ExchangeContext *WeaveExchangeManager::FindContext(uint64_t peerNodeId, WeaveConnection *con, void *appState, bool isInitiator)
 {
-    ExchangeContext *ec = (ExchangeContext *) ContextPool;
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    for (ExchangeContext *ec = ContextPool.First(); ec != NULL; ec = ContextPool.Next(ec))
         if (ec->ExchangeMgr != NULL && ec->PeerNodeId == peerNodeId &&
             ec->Con == con && ec->AppState == appState &&
             ec->IsInitiator() == isInitiator)
@@ -498,24 +515,24 @@ void WeaveExchangeManager::HandleConnectionReceived(WeaveConnection *con)
 
 void WeaveExchangeManager::HandleConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr)
 {
-    for (int i = 0; i < WEAVE_CONFIG_MAX_BINDINGS; i++)
+    for (Binding *binding = BindingPool.First(); binding != NULL; binding = BindingPool.Next(binding))
     {
-        BindingPool[i].OnConnectionClosed(con, conErr);
+        binding->OnConnectionClosed(con, conErr);
     }
 
-    ExchangeContext *ec = (ExchangeContext *) ContextPool;
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    for (ExchangeContext *ec = ContextPool.First(); ec != NULL; ec = ContextPool.Next(ec))
         if (ec->ExchangeMgr != NULL && ec->Con == con)
         {
             ec->HandleConnectionClosed(conErr);
         }
 
-    UnsolicitedMessageHandler *umh = (UnsolicitedMessageHandler *) UMHandlerPool;
-    for (int i = 0; i < WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
+    for (UnsolicitedMessageHandler *umh = UMHandlerPool.First(); umh != NULL; umh = UMHandlerPool.Next(umh))
         if (umh->Handler != NULL && umh->Con == con)
         {
             SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers);
+            RemoveUMHFromIndex(umh);
             umh->Handler = NULL;
+            UMHandlerPool.Free(umh);
         }
 }
 
@@ -529,8 +546,7 @@ void WeaveExchangeManager::HandleConnectionClosed(WeaveConnection *con, WEAVE_ER
 size_t WeaveExchangeManager::ExpireExchangeTimers(void)
 {
     size_t retval = 0;
-    ExchangeContext *ec = (ExchangeContext *) ContextPool;
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    for (ExchangeContext *ec = ContextPool.First(); ec != NULL; ec = ContextPool.Next(ec))
     {
         if (ec->ExchangeMgr != NULL)
         {
@@ -549,33 +565,143 @@ size_t WeaveExchangeManager::ExpireExchangeTimers(void)
 
 ExchangeContext *WeaveExchangeManager::AllocContext()
 {
-    ExchangeContext *ec = (ExchangeContext *) ContextPool;
+    ExchangeContext *ec;
 
     WEAVE_FAULT_INJECT(FaultInjection::kFault_AllocExchangeContext,
                        return NULL);
 
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
-        if (ec->ExchangeMgr == NULL)
-        {
-            *ec = ExchangeContext();
-            ec->ExchangeMgr = this;
-            ec->mRefCount = 1;
-            mContextsInUse++;
-            MessageLayer->SignalMessageLayerActivityChanged();
+    ec = ContextPool.Alloc();
+    if (ec == NULL)
+    {
+        WeaveLogError(ExchangeManager, "Alloc ctxt FAILED");
+        return NULL;
+    }
+
+    *ec = ExchangeContext();
+    ec->ExchangeMgr = this;
+    ec->mRefCount = 1;
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+    ec->mAllocTime = static_cast<uint32_t>(System::Timer::GetCurrentEpoch());
+#endif
+    mContextsInUse++;
+    MessageLayer->SignalMessageLayerActivityChanged();
 #if defined(WEAVE_EXCHANGE_CONTEXT_DETAIL_LOGGING)
-            WeaveLogProgress(ExchangeManager, "ec++ id: %d, inUse: %d, addr: 0x%x", EXCHANGE_CONTEXT_ID(ec - ContextPool), mContextsInUse, ec);
+    WeaveLogProgress(ExchangeManager, "ec++ id: %d, inUse: %d, addr: 0x%x", EXCHANGE_CONTEXT_ID(ContextPool.GetIndex(ec)), mContextsInUse, ec);
 #endif
-            SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumContexts);
+    SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumContexts);
 
-            return ec;
+    return ec;
+}
+
+uint32_t WeaveExchangeManager::ContextIndexBucket(uint16_t exchangeId)
+{
+    // Exchange ids are allocated sequentially by each node, so the low-order bits spread the contexts evenly.
+    return exchangeId & (WEAVE_CONFIG_EXCHANGE_CONTEXT_INDEX_SIZE - 1);
+}
+
+void WeaveExchangeManager::AddContextToIndex(ExchangeContext *ec)
+{
+    ExchangeContext **next = &mContextIndex[ContextIndexBucket(ec->ExchangeId)];
+
+    // Keep the bucket in pool order so that lookups return the same context a scan of the pool would.
+    while (*next != NULL && ContextPool.GetIndex(*next) < ContextPool.GetIndex(ec))
+        next = &(*next)->mNextInIndex;
+
+    ec->mNextInIndex = *next;
+    *next = ec;
+}
+
+void WeaveExchangeManager::RemoveContextFromIndex(ExchangeContext *ec)
+{
+    ExchangeContext **next = &mContextIndex[ContextIndexBucket(ec->ExchangeId)];
+
+    for (; *next != NULL; next = &(*next)->mNextInIndex)
+    {
+        if (*next == ec)
+        {
+            *next = ec->mNextInIndex;
+            break;
         }
-    WeaveLogError(ExchangeManager, "Alloc ctxt FAILED");
+    }
+
+    ec->mNextInIndex = NULL;
+}
+
+ExchangeContext *WeaveExchangeManager::FindContextForMessage(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo,
+        const WeaveExchangeHeader *exchangeHeader)
+{
+    ExchangeContext *ec = mContextIndex[ContextIndexBucket(exchangeHeader->ExchangeId)];
+
+    for (; ec != NULL; ec = ec->mNextInIndex)
+        if (ec->MatchExchange(msgCon, msgInfo, exchangeHeader))
+            return ec;
+
     return NULL;
 }
 
+uint32_t WeaveExchangeManager::UMHIndexBucket(uint32_t profileId, int16_t msgType)
+{
+    uint32_t hash = profileId ^ (profileId >> 16);
+
+    hash = hash * 31 + (uint16_t) msgType;
+
+    return hash & (WEAVE_CONFIG_UNSOLICITED_MESSAGE_HANDLER_INDEX_SIZE - 1);
+}
+
+void WeaveExchangeManager::AddUMHToIndex(UnsolicitedMessageHandler *umh)
+{
+    UnsolicitedMessageHandler **next = &mUMHandlerIndex[UMHIndexBucket(umh->ProfileId, umh->MessageType)];
+
+    // Keep the bucket in pool order to preserve the precedence of earlier registrations.
+    while (*next != NULL && UMHandlerPool.GetIndex(*next) < UMHandlerPool.GetIndex(umh))
+        next = &(*next)->NextInIndex;
+
+    umh->NextInIndex = *next;
+    *next = umh;
+}
+
+void WeaveExchangeManager::RemoveUMHFromIndex(UnsolicitedMessageHandler *umh)
+{
+    UnsolicitedMessageHandler **next = &mUMHandlerIndex[UMHIndexBucket(umh->ProfileId, umh->MessageType)];
+
+    for (; *next != NULL; next = &(*next)->NextInIndex)
+    {
+        if (*next == umh)
+        {
+            *next = umh->NextInIndex;
+            break;
+        }
+    }
+
+    umh->NextInIndex = NULL;
+}
+
+WeaveExchangeManager::UnsolicitedMessageHandler *WeaveExchangeManager::FindUMH(uint32_t profileId, uint8_t msgType,
+        WeaveConnection *msgCon, bool isDupMsg)
+{
+    UnsolicitedMessageHandler *umh;
+    UnsolicitedMessageHandler *matchingUMH = NULL;
+
+    // Prefer the first handler that can explicitly handle the message type...
+    for (umh = mUMHandlerIndex[UMHIndexBucket(profileId, msgType)]; umh != NULL; umh = umh->NextInIndex)
+        if (umh->ProfileId == profileId && umh->MessageType == msgType && (umh->Con == NULL || umh->Con == msgCon)
+            && (!isDupMsg || umh->AllowDuplicateMsgs))
+            return umh;
+
+    // ... otherwise, use the last handler that handles all messages for the profile.
+    for (umh = mUMHandlerIndex[UMHIndexBucket(profileId, -1)]; umh != NULL; umh = umh->NextInIndex)
+        if (umh->ProfileId == profileId && umh->MessageType == -1 && (umh->Con == NULL || umh->Con == msgCon)
+            && (!isDupMsg || umh->AllowDuplicateMsgs))
+            matchingUMH = umh;
+
+    return matchingUMH;
+}
+
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
 void WeaveExchangeManager::WRMPProcessDDMessage(uint32_t PauseTimeMillis, uint64_t DelayedNodeId)
 {
+    uint32_t staggerTicks = 0;
+
     // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
     WRMPExpireTicks();
 
@@ -589,8 +715,10 @@ void WeaveExchangeManager::WRMPProcessDDMessage(uint32_t PauseTimeMillis, uint64
             if (DelayedNodeId == RetransTable[i].exchContext->PeerNodeId)
             {
 
-                //Paustime is specified in milliseconds; Update retrans values
-                RetransTable[i].nextRetransTime += (PauseTimeMillis / mWRMPTimerInterval);
+                //Paustime is specified in milliseconds; Update retrans values. Successive messages to the node are
+                //spread a tick apart so that they are not all retransmitted at once when the pause ends.
+                RescheduleRetransEntry(&RetransTable[i], GetRetransEntryTicks(&RetransTable[i]) + (PauseTimeMillis / mWRMPTimerInterval) + staggerTicks);
+                staggerTicks++;
 
                 //Call the application callback
                 if (RetransTable[i].exchContext->OnDDRcvd)
@@ -626,8 +754,9 @@ static void DefaultOnMessageReceived(ExchangeContext *ec, const IPPacketInfo *pk
 
 void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf)
 {
+    SYSTEM_TRACE_SCOPE("ExchangeManager", "WeaveExchangeManager::DispatchMessage");
+
     WeaveExchangeHeader exchangeHeader;
-    UnsolicitedMessageHandler *umh         = NULL;
     UnsolicitedMessageHandler *matchingUMH = NULL;
     ExchangeContext *ec                    = NULL;
     WeaveConnection *msgCon                = NULL;
@@ -723,30 +852,44 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
         //Return after processing Delayed Delivery message
         ExitNow(err = WEAVE_NO_ERROR);
     }//If delayed delivery Msg
+
+    //Received Multi-Ack Message: Process the acks it carries for other exchanges. The ack for the exchange
+    //the message was sent on, if any, is carried in the exchange header and processed by that exchange.
+    if (exchangeHeader.ProfileId == nl::Weave::Profiles::kWeaveProfile_Common &&
+        exchangeHeader.MessageType == nl::Weave::Profiles::Common::kMsgType_WRMP_Multi_Ack)
+    {
+        if ((msgInfo->Flags & kWeaveMessageFlag_DuplicateMessage) == 0)
+        {
+            WRMPProcessMultiAck(msgCon, msgInfo, msgBuf);
+        }
+
+        //Quietly drop the message if the exchange it was sent on no longer exists
+        if (FindContextForMessage(msgCon, msgInfo, &exchangeHeader) == NULL)
+        {
+            ExitNow(err = WEAVE_NO_ERROR);
+        }
+    }//If multi-ack Msg
 #endif
 
     // Search for an existing exchange that the message applies to. If a match is found...
-    ec = (ExchangeContext *) ContextPool;
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    ec = FindContextForMessage(msgCon, msgInfo, &exchangeHeader);
+    if (ec != NULL)
     {
-        if (ec->ExchangeMgr != NULL && ec->MatchExchange(msgCon, msgInfo, &exchangeHeader))
-        {
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-            // Found a matching exchange. Set flag for correct subsequent WRM
-            // retransmission timeout selection.
-            if (!ec->HasRcvdMsgFromPeer())
-            {
-                ec->SetMsgRcvdFromPeer(true);
-            }
+        // Found a matching exchange. Set flag for correct subsequent WRM
+        // retransmission timeout selection.
+        if (!ec->HasRcvdMsgFromPeer())
+        {
+            ec->SetMsgRcvdFromPeer(true);
+        }
 #endif
 
-            //Matched ExchangeContext; send to message handler.
-            ec->HandleMessage(msgInfo, &exchangeHeader, msgBuf);
+        //Matched ExchangeContext; send to message handler.
+        ec->HandleMessage(msgInfo, &exchangeHeader, msgBuf);
 
-            msgBuf = NULL;
+        msgBuf = NULL;
 
-            ExitNow(err = WEAVE_NO_ERROR);
-        }
+        ExitNow(err = WEAVE_NO_ERROR);
     }
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
@@ -762,23 +905,8 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
     {
         // Search for an unsolicited message handler that can handle the message. Prefer handlers that can explicitly
         // handle the message type over handlers that handle all messages for a profile.
-        umh = (UnsolicitedMessageHandler *) UMHandlerPool;
-
-        matchingUMH = NULL;
-
-        for (int i = 0; i < WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
-            if (umh->Handler != NULL && umh->ProfileId == exchangeHeader.ProfileId && (umh->Con == NULL || umh->Con == msgCon)
-                && (!(msgInfo->Flags & kWeaveMessageFlag_DuplicateMessage) || umh->AllowDuplicateMsgs))
-            {
-                if (umh->MessageType == exchangeHeader.MessageType)
-                {
-                    matchingUMH = umh;
-                    break;
-                }
-
-                if (umh->MessageType == -1)
-                    matchingUMH = umh;
-            }
+        matchingUMH = FindUMH(exchangeHeader.ProfileId, exchangeHeader.MessageType, msgCon,
+                              (msgInfo->Flags & kWeaveMessageFlag_DuplicateMessage) != 0);
     }
     // Discard the message if it isn't marked as being sent by an initiator and the message is not a duplicate
     // that needs to send ack to the peer.
@@ -827,6 +955,7 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
 
         ec->Con = msgCon;
         ec->ExchangeId = exchangeHeader.ExchangeId;
+        AddContextToIndex(ec);
         ec->PeerNodeId = msgInfo->SourceNodeId;
         if (msgInfo->InPacketInfo != NULL)
         {
@@ -874,7 +1003,7 @@ void WeaveExchangeManager::DispatchMessage(WeaveMessageInfo *msgInfo, PacketBuff
             ec->OnMessageReceived = DefaultOnMessageReceived;
             ec->AllowDuplicateMsgs = matchingUMH->AllowDuplicateMsgs;
 
-            WeaveLogProgress(ExchangeManager, "ec id: %d, AppState: 0x%x", EXCHANGE_CONTEXT_ID(ec - ContextPool), ec->AppState);
+            WeaveLogProgress(ExchangeManager, "ec id: %d, AppState: 0x%x", EXCHANGE_CONTEXT_ID(ContextPool.GetIndex(ec)), ec->AppState);
         }
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
         // If the exchange is created only to send ack.
@@ -925,23 +1054,19 @@ exit:
 WEAVE_ERROR WeaveExchangeManager::RegisterUMH(uint32_t profileId, int16_t msgType, WeaveConnection *con, bool allowDups,
         ExchangeContext::MessageReceiveFunct handler, void *appState)
 {
-    UnsolicitedMessageHandler *umh = (UnsolicitedMessageHandler *) UMHandlerPool;
-    UnsolicitedMessageHandler *selected = NULL;
-    for (int i = 0; i < WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
+    UnsolicitedMessageHandler *selected;
+
+    for (selected = mUMHandlerIndex[UMHIndexBucket(profileId, msgType)]; selected != NULL; selected = selected->NextInIndex)
     {
-        if (umh->Handler == NULL)
-        {
-            if (selected == NULL)
-                selected = umh;
-        }
-        else if (umh->ProfileId == profileId && umh->MessageType == msgType && umh->Con == con)
+        if (selected->ProfileId == profileId && selected->MessageType == msgType && selected->Con == con)
         {
-            umh->Handler = handler;
-            umh->AppState = appState;
+            selected->Handler = handler;
+            selected->AppState = appState;
             return WEAVE_NO_ERROR;
         }
     }
 
+    selected = UMHandlerPool.Alloc();
     if (selected == NULL)
         return WEAVE_ERROR_TOO_MANY_UNSOLICITED_MESSAGE_HANDLERS;
 
@@ -951,6 +1076,7 @@ WEAVE_ERROR WeaveExchangeManager::RegisterUMH(uint32_t profileId, int16_t msgTyp
     selected->Con = con;
     selected->MessageType = msgType;
     selected->AllowDuplicateMsgs = allowDups;
+    AddUMHToIndex(selected);
 
     SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers);
 
@@ -959,12 +1085,14 @@ WEAVE_ERROR WeaveExchangeManager::RegisterUMH(uint32_t profileId, int16_t msgTyp
 
 WEAVE_ERROR WeaveExchangeManager::UnregisterUMH(uint32_t profileId, int16_t msgType, WeaveConnection *con)
 {
-    UnsolicitedMessageHandler *umh = (UnsolicitedMessageHandler *) UMHandlerPool;
-    for (int i = 0; i < WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS; i++, umh++)
+    UnsolicitedMessageHandler *umh = mUMHandlerIndex[UMHIndexBucket(profileId, msgType)];
+    for (; umh != NULL; umh = umh->NextInIndex)
     {
-        if (umh->Handler != NULL && umh->ProfileId == profileId && umh->MessageType == msgType && umh->Con == con)
+        if (umh->ProfileId == profileId && umh->MessageType == msgType && umh->Con == con)
         {
+            RemoveUMHFromIndex(umh);
             umh->Handler = NULL;
+            UMHandlerPool.Free(umh);
             SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kExchangeMgr_NumUMHandlers);
             return WEAVE_NO_ERROR;
         }
@@ -1055,10 +1183,6 @@ WEAVE_ERROR WeaveExchangeManager::DecodeHeader(WeaveExchangeHeader *exchangeHead
 
     uint8_t *p = NULL;
     uint8_t versionFlags;
-#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    uint16_t msgLen = buf->DataLength();
-    uint8_t *msgEnd = buf->Start() + msgLen;
-#endif
 
     if (buf->DataLength() < 8)
         ExitNow(err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
@@ -1072,6 +1196,12 @@ WEAVE_ERROR WeaveExchangeManager::DecodeHeader(WeaveExchangeHeader *exchangeHead
     if (exchangeHeader->Version != kWeaveExchangeVersion_V1)
         ExitNow(err = WEAVE_ERROR_UNSUPPORTED_EXCHANGE_VERSION);
 
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    // The flags determine the length of the rest of the header, so check it once up front.
+    if ((exchangeHeader->Flags & kWeaveExchangeFlag_AckId) && buf->DataLength() < 12)
+        ExitNow(err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+#endif
+
     exchangeHeader->MessageType = Read8(p);
 
     exchangeHeader->ExchangeId = LittleEndian::Read16(p);
@@ -1081,8 +1211,6 @@ WEAVE_ERROR WeaveExchangeManager::DecodeHeader(WeaveExchangeHeader *exchangeHead
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     if ((exchangeHeader->Flags & kWeaveExchangeFlag_AckId))
     {
-        if ((p + 4) > msgEnd)
-            ExitNow(err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
         exchangeHeader->AckMsgId = LittleEndian::Read32(p);
     }
 #endif
@@ -1119,9 +1247,7 @@ void WeaveExchangeManager::AllowUnsolicitedMessages(WeaveConnection *con)
  */
 void WeaveExchangeManager::NotifyKeyFailed(uint64_t peerNodeId, uint16_t keyId, WEAVE_ERROR keyErr)
 {
-    ExchangeContext *ec = (ExchangeContext *) ContextPool;
-
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    for (ExchangeContext *ec = ContextPool.First(); ec != NULL; ec = ContextPool.Next(ec))
     {
         if (ec->ExchangeMgr != NULL && ec->KeyId == keyId && ec->PeerNodeId == peerNodeId)
         {
@@ -1144,9 +1270,9 @@ void WeaveExchangeManager::NotifyKeyFailed(uint64_t peerNodeId, uint16_t keyId,
         }
     }
 
-    for (int i = 0; i < WEAVE_CONFIG_MAX_BINDINGS; i++)
+    for (Binding *binding = BindingPool.First(); binding != NULL; binding = BindingPool.Next(binding))
     {
-        BindingPool[i].OnKeyFailed(peerNodeId, keyId, keyErr);
+        binding->OnKeyFailed(peerNodeId, keyId, keyErr);
     }
 }
 
@@ -1159,9 +1285,9 @@ void WeaveExchangeManager::NotifySecurityManagerAvailable()
     //
     // Note that this algorithm is unfair to bindings that are positioned later in the pool.
     // In practice, however, this is unlikely to cause any problems.
-    for (int i = 0; i < WEAVE_CONFIG_MAX_BINDINGS; i++)
+    for (Binding *binding = BindingPool.First(); binding != NULL; binding = BindingPool.Next(binding))
     {
-        BindingPool[i].OnSecurityManagerAvailable();
+        binding->OnSecurityManagerAvailable();
     }
 }
 
@@ -1205,6 +1331,12 @@ void WeaveExchangeManager::RetransPendingAppGroupMsgs(uint64_t peerNodeId)
     {
         if (re->exchContext != NULL && re->exchContext->PeerNodeId == peerNodeId && WeaveKeyId::IsAppGroupKey(re->exchContext->KeyId))
         {
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+            // Messages held for room in the send window have not been sent yet.
+            if (re->heldForWindow)
+                continue;
+#endif
+
             // Decrement counter to discount the first sent message, which
             // was ignored by receiver due to un-synchronized message counter.
             re->sendCount--;
@@ -1215,6 +1347,122 @@ void WeaveExchangeManager::RetransPendingAppGroupMsgs(uint64_t peerNodeId)
     }
 }
 
+/**
+ *  Process the acknowledgments carried in the payload of a received Multi-Ack message.
+ *
+ *  The payload consists of a sequence of entries, each of which acknowledges a message received on one exchange:
+ *
+ *        (2 bytes)    |  (1 byte)   |  (4 bytes)
+ *      <exchange-id>  |  <flags>    |  <ack-msg-id>
+ *
+ *  where the flags contain kWeaveExchangeFlag_Initiator if the sender of the Multi-Ack message is the initiator
+ *  of the exchange. Acknowledgments are only applied to exchanges that use the same key as the Multi-Ack message.
+ *
+ *  @param[in]    msgCon    The connection over which the message was received, or NULL if received over UDP.
+ *
+ *  @param[in]    msgInfo   General Weave message information for the Multi-Ack message.
+ *
+ *  @param[in]    msgBuf    A pointer to the PacketBuffer object holding the Multi-Ack message payload.
+ *
+ */
+void WeaveExchangeManager::WRMPProcessMultiAck(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf)
+{
+    enum { kEntryLength = 7 };
+
+    const uint8_t *p = msgBuf->Start();
+    uint16_t remainingLen = msgBuf->DataLength();
+    WeaveExchangeHeader ackHeader;
+    ExchangeContext *ec;
+
+    for (; remainingLen >= kEntryLength; remainingLen -= kEntryLength)
+    {
+        memset(&ackHeader, 0, sizeof(ackHeader));
+        ackHeader.ExchangeId = LittleEndian::Read16(p);
+        ackHeader.Flags = Read8(p) & kWeaveExchangeFlag_Initiator;
+        ackHeader.Flags |= kWeaveExchangeFlag_AckId;
+        ackHeader.AckMsgId = LittleEndian::Read32(p);
+
+        ec = FindContextForMessage(msgCon, msgInfo, &ackHeader);
+        if (ec == NULL || ec->KeyId != msgInfo->KeyId || ec->EncryptionType != msgInfo->EncryptionType)
+            continue;
+
+        // Hold a reference to the exchange in case the application closes it from its OnAckRcvd callback.
+        ec->AddRef();
+        ec->WRMPHandleRcvdAck(&ackHeader, msgInfo);
+        ec->Release();
+    }
+}
+
+#if WEAVE_CONFIG_WRMP_ENABLE_MULTI_ACK
+/**
+ *  Send the acknowledgment pending on an exchange in a Multi-Ack message, together with the acknowledgments
+ *  pending on any other exchanges with the same peer that would be sent using the same key and address.
+ *
+ *  @param[in]    ec        A pointer to an ExchangeContext object with a pending acknowledgment.
+ *
+ *  @return true if a Multi-Ack message was sent (successfully or not) and the pending acknowledgments have been
+ *          cleared; false if there were no other pending acknowledgments to combine with that of ec.
+ *
+ */
+bool WeaveExchangeManager::WRMPSendMultiAck(ExchangeContext *ec)
+{
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_ExchangeMgr);
+
+    enum { kEntryLength = 7 };
+
+    ExchangeContext *acks[WEAVE_CONFIG_WRMP_MAX_MULTI_ACK_ENTRIES];
+    ExchangeContext *otherEC;
+    PacketBuffer *msgBuf;
+    uint8_t *p;
+    uint8_t numAcks = 0;
+    WEAVE_ERROR err;
+
+    if (ec->Con != NULL || ec->PeerNodeId == kAnyNodeId)
+        return false;
+
+    for (otherEC = ContextPool.First(); otherEC != NULL && numAcks < WEAVE_CONFIG_WRMP_MAX_MULTI_ACK_ENTRIES;
+         otherEC = ContextPool.Next(otherEC))
+    {
+        if (otherEC != ec && otherEC->ExchangeMgr != NULL && otherEC->IsAckPending() && otherEC->Con == NULL &&
+            otherEC->PeerNodeId == ec->PeerNodeId && otherEC->PeerAddr == ec->PeerAddr &&
+            otherEC->PeerPort == ec->PeerPort && otherEC->PeerIntf == ec->PeerIntf &&
+            otherEC->KeyId == ec->KeyId && otherEC->EncryptionType == ec->EncryptionType)
+        {
+            acks[numAcks++] = otherEC;
+        }
+    }
+
+    if (numAcks == 0)
+        return false;
+
+    msgBuf = PacketBuffer::NewWithAvailableSize(numAcks * kEntryLength);
+    if (msgBuf == NULL)
+        return false;
+
+    p = msgBuf->Start();
+    for (uint8_t i = 0; i < numAcks; i++)
+    {
+        LittleEndian::Write16(p, acks[i]->ExchangeId);
+        Write8(p, acks[i]->IsInitiator() ? kWeaveExchangeFlag_Initiator : 0);
+        LittleEndian::Write32(p, acks[i]->mPendingPeerAckId);
+        acks[i]->SetAckPending(false);
+    }
+    msgBuf->SetDataLength(numAcks * kEntryLength);
+
+    // The ack pending on ec itself is piggybacked in the exchange header.
+    err = ec->SendMessage(nl::Weave::Profiles::kWeaveProfile_Common, nl::Weave::Profiles::Common::kMsgType_WRMP_Multi_Ack,
+                          msgBuf, ExchangeContext::kSendFlag_NoAutoRequestAck);
+    if (err != WEAVE_NO_ERROR && !WeaveMessageLayer::IsSendErrorNonCritical(err))
+    {
+        WeaveLogError(ExchangeManager, "Failed to send Multi-Ack to Peer %016" PRIX64 ":%ld", ec->PeerNodeId, (long)err);
+    }
+
+    ec->SetAckPending(false);
+
+    return true;
+}
+#endif // WEAVE_CONFIG_WRMP_ENABLE_MULTI_ACK
+
 /**
 * Return a tick counter value given a time difference and a tick interval.
 * The difference in time is not expected to exceed (2^32 - 1) within the
@@ -1251,15 +1499,15 @@ void WeaveExchangeManager::TicklessDebugDumpRetransTable(const char *log)
 {
      WeaveLogProgress(ExchangeManager, log);
 
-     for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+     uint32_t ticks = 0;
+
+     for (RetransTableEntry *entry = mRetransQueueHead; entry != NULL; entry = entry->nextInQueue)
      {
-         if (RetransTable[i].exchContext)
-         {
-             WeaveLogProgress(ExchangeManager, "EC:%04" PRIX16 " MsgId:%08" PRIX32 " NextRetransTimeCtr:%04" PRIX16,
-                              RetransTable[i].exchContext,
-                              RetransTable[i].msgId,
-                              RetransTable[i].nextRetransTime);
-         }
+         ticks += entry->retransDeltaTicks;
+         WeaveLogProgress(ExchangeManager, "EC:%04" PRIX16 " MsgId:%08" PRIX32 " NextRetransTimeCtr:%04" PRIX32,
+                          entry->exchContext,
+                          entry->msgId,
+                          ticks);
      }
 }
 #else
@@ -1276,14 +1524,12 @@ void WeaveExchangeManager::WRMPExecuteActions(void)
 {
     ExchangeContext *ec               = NULL;
 
-    //Process Ack Tables for all ExchangeContexts
-    ec = (ExchangeContext *)ContextPool;
-
 #if defined(WRMP_TICKLESS_DEBUG)
     WeaveLogProgress(ExchangeManager, "WRMPExecuteActions");
 #endif
 
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    //Process Ack Tables for all ExchangeContexts
+    for (ec = ContextPool.First(); ec != NULL; ec = ContextPool.Next(ec))
     {
         if (ec->ExchangeMgr != NULL && ec->IsAckPending())
         {
@@ -1291,6 +1537,11 @@ void WeaveExchangeManager::WRMPExecuteActions(void)
             {
 #if defined(WRMP_TICKLESS_DEBUG)
                 WeaveLogProgress(ExchangeManager, "WRMPExecuteActions sending ACK");
+#endif
+#if WEAVE_CONFIG_WRMP_ENABLE_MULTI_ACK
+                //Send the Ack along with those pending to the same peer on other exchanges in a Multi-Ack message
+                if (WRMPSendMultiAck(ec))
+                    continue;
 #endif
                 //Send the Ack in a Common::Null message
                 ec->SendCommonNullMessage();
@@ -1302,54 +1553,66 @@ void WeaveExchangeManager::WRMPExecuteActions(void)
     TicklessDebugDumpRetransTable("WRMPExecuteActions Dumping RetransTable entries before processing");
 
     // Retransmit / cancel anything in the retrans table whose retrans timeout
-    // has expired
-    for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+    // has expired. Expired entries are always at the head of the retrans queue.
+    while (mRetransQueueHead != NULL && mRetransQueueHead->retransDeltaTicks == 0)
     {
-        ec = RetransTable[i].exchContext;
-        if (ec)
+        RetransTableEntry *entry = mRetransQueueHead;
+        WEAVE_ERROR err = WEAVE_NO_ERROR;
+        uint8_t sendCount = entry->sendCount;
+        void * msgCtxt = entry->msgCtxt;
+
+        ec = entry->exchContext;
+
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+        if (entry->heldForWindow)
         {
-            WEAVE_ERROR err = WEAVE_NO_ERROR;
+            // A message that has been held for longer than its retrans queue allows is sent regardless of its window.
+            entry->heldForWindow = false;
+            entry->sendWindow->held--;
+            entry->sendWindow->inFlight++;
+        }
+        else if (sendCount > 0)
+        {
+            WRMPOnRetransTimeout(entry);
+        }
+#endif
 
-            if (0 == RetransTable[i].nextRetransTime)
-            {
-                uint8_t sendCount = RetransTable[i].sendCount;
-                void * msgCtxt = RetransTable[i].msgCtxt;
+        if (sendCount > ec->mWRMPConfig.mMaxRetrans)
+        {
+            err = WEAVE_ERROR_MESSAGE_NOT_ACKNOWLEDGED;
 
-                if (sendCount > ec->mWRMPConfig.mMaxRetrans)
-                {
-                    err = WEAVE_ERROR_MESSAGE_NOT_ACKNOWLEDGED;
+            WeaveLogError(ExchangeManager, "Failed to Send Weave MsgId:%08" PRIX32 " sendCount: %" PRIu8 " max retries: %" PRIu8,
+                          entry->msgId, sendCount, ec->mWRMPConfig.mMaxRetrans);
 
-                    WeaveLogError(ExchangeManager, "Failed to Send Weave MsgId:%08" PRIX32 " sendCount: %" PRIu8 " max retries: %" PRIu8,
-                                  RetransTable[i].msgId, sendCount, ec->mWRMPConfig.mMaxRetrans);
+            // Remove from Table
+            ClearRetransmitTable(*entry);
+        }
 
-                    // Remove from Table
-                    ClearRetransmitTable(RetransTable[i]);
-                }
+        if (err == WEAVE_NO_ERROR)
+        {
+            // Resend from Table (if the operation fails, the entry is cleared)
+            err = SendFromRetransTable(entry);
+        }
 
-                if (err == WEAVE_NO_ERROR)
-                {
-                    // Resend from Table (if the operation fails, the entry is cleared)
-                    err = SendFromRetransTable(&(RetransTable[i]));
-                }
+        if (err == WEAVE_NO_ERROR)
+        {
+            // If the retransmission was successful, requeue the entry for its next retransmission. The
+            // entry is always moved at least one tick into the future so that this loop terminates.
+            uint32_t ticks = ec->GetRetransmitTimeout(entry->sendCount) / mWRMPTimerInterval;
 
-                if (err == WEAVE_NO_ERROR)
-                {
-                    // If the retransmission was successful, update the passive timer
-                    RetransTable[i].nextRetransTime = ec->GetCurrentRetransmitTimeout() / mWRMPTimerInterval;
+            RescheduleRetransEntry(entry, (ticks > 0) ? ticks : 1);
 #if defined(DEBUG)
-                    WeaveLogProgress(ExchangeManager, "Retransmit MsgId:%08" PRIX32 " Send Cnt %d",
-                            RetransTable[i].msgId, RetransTable[i].sendCount);
+            WeaveLogProgress(ExchangeManager, "Retransmit MsgId:%08" PRIX32 " Send Cnt %d",
+                    entry->msgId, entry->sendCount);
 #endif
-                }
+        }
 
-                if (err != WEAVE_NO_ERROR)
-                {
-                    if (ec->OnSendError)
-                    {
-                        ec->OnSendError(ec, err, msgCtxt);
-                    }
-                }
-            } //nextRetransTime = 0
+        if (err != WEAVE_NO_ERROR)
+        {
+            if (ec->OnSendError)
+            {
+                ec->OnSendError(ec, err, msgCtxt);
+            }
         }
     }
 
@@ -1359,8 +1622,8 @@ void WeaveExchangeManager::WRMPExecuteActions(void)
 /**
 * Calculate number of virtual WRMP ticks that have expired since we last
 * called this function. Iterate through active exchange contexts and
-* retrans table entries, subtracting expired virtual ticks to synchronize
-* wakeup times with the current system time. Do not perform any actions
+* the expired head of the retrans queue, subtracting expired virtual ticks
+* to synchronize wakeup times with the current system time. Do not perform any actions
 * beyond updating tick counts, actions will be performed by the physical
 * WRMP timer tick expiry.
 *
@@ -1370,9 +1633,7 @@ void WeaveExchangeManager::WRMPExpireTicks(void)
     uint64_t            now         = 0;
     ExchangeContext*    ec          = NULL;
     uint32_t            deltaTicks;
-
-    //Process Ack Tables for all ExchangeContexts
-    ec = (ExchangeContext *)ContextPool;
+    uint32_t            remainingTicks;
 
     now = System::Timer::GetCurrentEpoch();
 
@@ -1392,9 +1653,13 @@ void WeaveExchangeManager::WRMPExpireTicks(void)
     WeaveLogProgress(ExchangeManager, "WRMPExpireTicks at %" PRIu64 ", %" PRIu64 ", %u", now, mWRMPTimeStampBase, deltaTicks);
 #endif
 
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    //Process Ack Tables for all ExchangeContexts
+    for (ec = ContextPool.First(); ec != NULL; ec = ContextPool.Next(ec))
     {
-        if (ec->ExchangeMgr != NULL && ec->IsAckPending())
+        if (ec->ExchangeMgr == NULL)
+            continue;
+
+        if (ec->IsAckPending())
         {
             //Decrement counter of Ack timestamp by the elapsed timer ticks
             if (ec->mWRMPNextAckTime >= deltaTicks)
@@ -1409,17 +1674,11 @@ void WeaveExchangeManager::WRMPExpireTicks(void)
             WeaveLogProgress(ExchangeManager, "WRMPExpireTicks set mWRMPNextAckTime to %u", ec->mWRMPNextAckTime);
 #endif
         }
-    }
 
-    //Process Throttle Time
-    //Check Throttle timeout stored in EC to set/unset Throttle flag
-    for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
-    {
-        ec = RetransTable[i].exchContext;
-        if (ec)
+        //Process Throttle Time
+        //Decrement Throttle timeout by elapsed timeticks
+        if (ec->mWRMPThrottleTimeout != 0)
         {
-            //Process Retransmit Table
-            //Decrement Throttle timeout by elapsed timeticks
             if (ec->mWRMPThrottleTimeout >= deltaTicks)
             {
                 ec->mWRMPThrottleTimeout -= deltaTicks;
@@ -1429,22 +1688,31 @@ void WeaveExchangeManager::WRMPExpireTicks(void)
                 ec->mWRMPThrottleTimeout = 0;
             }
 #if defined(WRMP_TICKLESS_DEBUG)
-            WeaveLogProgress(ExchangeManager, "WRMPExpireTicks set mWRMPThrottleTimeout to %u", RetransTable[i].nextRetransTime);
+            WeaveLogProgress(ExchangeManager, "WRMPExpireTicks set mWRMPThrottleTimeout to %u", ec->mWRMPThrottleTimeout);
 #endif
+        }
+    }
 
-            //Decrement Retransmit timeout by elapsed timeticks
-            if (RetransTable[i].nextRetransTime >= deltaTicks)
-            {
-                RetransTable[i].nextRetransTime -= deltaTicks;
-            }
-            else
-            {
-                RetransTable[i].nextRetransTime = 0;
-            }
+    //Process Retransmit Table
+    //Consume the elapsed timeticks from the head of the retrans queue, leaving any entries that are
+    //due with a delta of zero.
+    remainingTicks = deltaTicks;
+
+    for (RetransTableEntry *entry = mRetransQueueHead; entry != NULL && remainingTicks != 0; entry = entry->nextInQueue)
+    {
+        if (entry->retransDeltaTicks >= remainingTicks)
+        {
+            entry->retransDeltaTicks -= remainingTicks;
+            remainingTicks = 0;
+        }
+        else
+        {
+            remainingTicks -= entry->retransDeltaTicks;
+            entry->retransDeltaTicks = 0;
+        }
 #if defined(WRMP_TICKLESS_DEBUG)
-            WeaveLogProgress(ExchangeManager, "WRMPExpireTicks set nextRetransTime to %u", RetransTable[i].nextRetransTime);
+        WeaveLogProgress(ExchangeManager, "WRMPExpireTicks set retransDeltaTicks to %u", entry->retransDeltaTicks);
 #endif
-        } //ec entry is allocated
     }
 
     // Re-Adjust the base time stamp to the most recent tick boundary
@@ -1522,7 +1790,11 @@ WEAVE_ERROR WeaveExchangeManager::AddToRetransTable(ExchangeContext *ec, PacketB
             RetransTable[i].msgId = messageId;
             RetransTable[i].msgBuf = msgBuf;
             RetransTable[i].sendCount = 0;
-            RetransTable[i].nextRetransTime = GetTickCounterFromTimeDelta(ec->GetCurrentRetransmitTimeout() + System::Timer::GetCurrentEpoch(), mWRMPTimeStampBase);
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+            RetransTable[i].sendWindow = NULL;
+            RetransTable[i].heldForWindow = false;
+#endif
+            QueueRetransEntry(&RetransTable[i], GetTickCounterFromTimeDelta(ec->GetCurrentRetransmitTimeout() + System::Timer::GetCurrentEpoch(), mWRMPTimeStampBase));
 
             RetransTable[i].msgCtxt = msgCtxt;
             *rEntry = &RetransTable[i];
@@ -1530,6 +1802,8 @@ WEAVE_ERROR WeaveExchangeManager::AddToRetransTable(ExchangeContext *ec, PacketB
             ec->AddRef();
             added = true;
 
+            SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumRetransEntries);
+
             //Check if the timer needs to be started and start it.
             WRMPStartTimer();
             break;
@@ -1548,6 +1822,10 @@ WEAVE_ERROR WeaveExchangeManager::AddToRetransTable(ExchangeContext *ec, PacketB
 /**
  *  Send the specified entry from the retransmission table.
  *
+ *  The entry holds the message exactly as it was first encoded, signed and encrypted, and retransmissions
+ *  reuse its message id, so the buffer is handed to the message layer as is with the RetainBuffer flag.
+ *  Neither the first transmission nor any retransmission re-encodes the message.
+ *
  *  @param[in]    entry                A pointer to a retransmission table entry object that needs to be sent.
  *
  *  @return  #WEAVE_NO_ERROR On success, else corresponding WEAVE_ERROR returned from SendMessage.
@@ -1567,7 +1845,7 @@ WEAVE_ERROR WeaveExchangeManager::SendFromRetransTable(RetransTableEntry *entry)
 
     WEAVE_FAULT_INJECT(FaultInjection::kFault_WRMSendError,
                        entry->sendCount = (ec->mWRMPConfig.mMaxRetrans + 1);
-                       entry->nextRetransTime = 0;
+                       RescheduleRetransEntry(entry, 0);
                        WRMPStartTimer();
                        ExitNow());
 
@@ -1592,6 +1870,14 @@ WEAVE_ERROR WeaveExchangeManager::SendFromRetransTable(RetransTableEntry *entry)
         entry->msgBuf->SetDataLength(len);
 
         //Update the counters
+#if WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+        if (entry->sendCount == 0)
+            entry->firstSendTime = static_cast<uint32_t>(System::Timer::GetCurrentEpoch());
+#endif
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+        if (entry->sendCount > 0)
+            Stats::RecordRetransmission();
+#endif
         entry->sendCount++;
     }
     else
@@ -1654,9 +1940,18 @@ void WeaveExchangeManager::ClearRetransmitTable(RetransTableEntry &rEntry)
         // Expire any virtual ticks that have expired so all wakeup sources reflect the current time
         WRMPExpireTicks();
 
+        DequeueRetransEntry(&rEntry);
+
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+        // Make room in the peer's send window for any held messages.
+        WRMPRemoveFromSendWindow(&rEntry);
+#endif
+
         rEntry.exchContext->Release();
         rEntry.exchContext = NULL;
 
+        SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kExchangeMgr_NumRetransEntries);
+
         if (rEntry.msgBuf)
         {
             PacketBuffer::Free(rEntry.msgBuf);
@@ -1698,6 +1993,265 @@ void WeaveExchangeManager::FailRetransmitTableEntries(ExchangeContext *ec, WEAVE
     }
 }
 
+/**
+ *  Insert an entry into the retransmission queue.
+ *
+ *  @param[in]    entry    A pointer to a retransmission table entry that is not in the queue.
+ *
+ *  @param[in]    ticks    The number of timer ticks from the current tick until the entry is due for retransmission.
+ *
+ */
+void WeaveExchangeManager::QueueRetransEntry(RetransTableEntry *entry, uint32_t ticks)
+{
+    RetransTableEntry **link = &mRetransQueueHead;
+
+    if (ticks > UINT16_MAX)
+        ticks = UINT16_MAX;
+
+    // Skip past the entries due no later than the new entry, so that entries due at the same time are
+    // retransmitted in the order in which they were queued.
+    while (*link != NULL && (*link)->retransDeltaTicks <= ticks)
+    {
+        ticks -= (*link)->retransDeltaTicks;
+        link = &(*link)->nextInQueue;
+    }
+
+    entry->retransDeltaTicks = static_cast<uint16_t>(ticks);
+    entry->nextInQueue = *link;
+    if (entry->nextInQueue != NULL)
+        entry->nextInQueue->retransDeltaTicks -= entry->retransDeltaTicks;
+    *link = entry;
+}
+
+/**
+ *  Remove an entry from the retransmission queue.
+ *
+ *  @param[in]    entry    A pointer to a retransmission table entry in the queue.
+ *
+ */
+void WeaveExchangeManager::DequeueRetransEntry(RetransTableEntry *entry)
+{
+    RetransTableEntry **link = &mRetransQueueHead;
+
+    while (*link != NULL && *link != entry)
+        link = &(*link)->nextInQueue;
+
+    VerifyOrDie(*link == entry);
+
+    // The following entry is now due relative to the entry before the removed one.
+    if (entry->nextInQueue != NULL)
+        entry->nextInQueue->retransDeltaTicks += entry->retransDeltaTicks;
+
+    *link = entry->nextInQueue;
+    entry->nextInQueue = NULL;
+    entry->retransDeltaTicks = 0;
+}
+
+/**
+ *  Change the retransmission time of an entry in the retransmission queue.
+ *
+ *  @param[in]    entry    A pointer to a retransmission table entry in the queue.
+ *
+ *  @param[in]    ticks    The number of timer ticks from the current tick until the entry is due for retransmission.
+ *
+ */
+void WeaveExchangeManager::RescheduleRetransEntry(RetransTableEntry *entry, uint32_t ticks)
+{
+    DequeueRetransEntry(entry);
+    QueueRetransEntry(entry, ticks);
+}
+
+/**
+ *  Get the number of timer ticks from the current tick until an entry in the retransmission queue is due
+ *  for retransmission.
+ *
+ *  @param[in]    entry    A pointer to a retransmission table entry in the queue.
+ *
+ */
+uint32_t WeaveExchangeManager::GetRetransEntryTicks(const RetransTableEntry *entry) const
+{
+    uint32_t ticks = 0;
+
+    for (const RetransTableEntry *e = mRetransQueueHead; e != NULL; e = e->nextInQueue)
+    {
+        ticks += e->retransDeltaTicks;
+        if (e == entry)
+            break;
+    }
+
+    return ticks;
+}
+
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+/**
+ *  Find the send window for a peer node, allocating one if necessary.
+ *
+ *  @param[in]    peerNodeId    The node identifier of the peer.
+ *
+ *  @return A pointer to the send window, or NULL if the peer has no window and all windows are in use.
+ *
+ */
+WeaveExchangeManager::WRMPSendWindow *WeaveExchangeManager::WRMPGetSendWindow(uint64_t peerNodeId)
+{
+    WRMPSendWindow *freeWindow = NULL;
+
+    for (int i = 0; i < WEAVE_CONFIG_WRMP_SEND_WINDOW_TABLE_SIZE; i++)
+    {
+        WRMPSendWindow *window = &mWRMPSendWindows[i];
+
+        if (window->size != 0 && window->peerNodeId == peerNodeId)
+            return window;
+
+        // Prefer windows that have never been used, so that the sizes learned for other peers are kept as
+        // long as possible.
+        if (window->inFlight == 0 && window->held == 0 && (freeWindow == NULL || window->size == 0))
+            freeWindow = window;
+    }
+
+    if (freeWindow != NULL)
+    {
+        memset(freeWindow, 0, sizeof(*freeWindow));
+        freeWindow->peerNodeId = peerNodeId;
+        freeWindow->size = WEAVE_CONFIG_WRMP_INITIAL_SEND_WINDOW;
+    }
+
+    return freeWindow;
+}
+
+/**
+ *  Account for a newly added retransmission table entry in its peer's send window.
+ *
+ *  If the window is full, or other messages to the peer are already waiting, the entry is held (moved to the back
+ *  of the retrans queue) until an outstanding message is acknowledged or fails.
+ *
+ *  @param[in]    entry    A pointer to a retransmission table entry that has not been sent.
+ *
+ *  @return true if the message may be sent now; false if it has been held.
+ *
+ */
+bool WeaveExchangeManager::WRMPAdmitToSendWindow(RetransTableEntry *entry)
+{
+    WRMPSendWindow *window;
+
+    if (entry->exchContext->PeerNodeId == kAnyNodeId)
+        return true;
+
+    window = WRMPGetSendWindow(entry->exchContext->PeerNodeId);
+    if (window == NULL)
+        return true;
+
+    entry->sendWindow = window;
+
+    if (window->inFlight < window->size && window->held == 0)
+    {
+        window->inFlight++;
+        return true;
+    }
+
+    entry->heldForWindow = true;
+    window->held++;
+    RescheduleRetransEntry(entry, UINT16_MAX);
+
+    return false;
+}
+
+/**
+ *  Remove a retransmission table entry that is being cleared from its peer's send window, releasing held
+ *  messages into the room made.
+ *
+ *  @param[in]    entry    A pointer to the retransmission table entry.
+ *
+ */
+void WeaveExchangeManager::WRMPRemoveFromSendWindow(RetransTableEntry *entry)
+{
+    WRMPSendWindow *window = entry->sendWindow;
+
+    if (window == NULL)
+        return;
+
+    if (entry->heldForWindow)
+        window->held--;
+    else
+        window->inFlight--;
+
+    entry->sendWindow = NULL;
+    entry->heldForWindow = false;
+
+    WRMPReleaseHeldMessages(window);
+}
+
+/**
+ *  Schedule held messages for immediate transmission, in the order in which they were sent by the application,
+ *  while there is room in their send window.
+ *
+ *  @param[in]    window    A pointer to the send window.
+ *
+ */
+void WeaveExchangeManager::WRMPReleaseHeldMessages(WRMPSendWindow *window)
+{
+    while (window->held != 0 && window->inFlight < window->size)
+    {
+        RetransTableEntry *entry = mRetransQueueHead;
+
+        while (entry != NULL && !(entry->sendWindow == window && entry->heldForWindow))
+            entry = entry->nextInQueue;
+
+        VerifyOrDie(entry != NULL);
+
+        entry->heldForWindow = false;
+        window->held--;
+        window->inFlight++;
+
+        // The message is sent, for the first time, when the WRMP timer next fires.
+        RescheduleRetransEntry(entry, 0);
+    }
+}
+
+/**
+ *  Grow the send window of the peer of an acknowledged message.
+ *
+ *  @param[in]    entry    A pointer to the retransmission table entry of the acknowledged message.
+ *
+ */
+void WeaveExchangeManager::WRMPOnMessageAcked(RetransTableEntry *entry)
+{
+    WRMPSendWindow *window = entry->sendWindow;
+
+    // Acks of retransmitted messages do not show that the current window size is sustainable.
+    if (window == NULL || entry->sendCount != 1)
+        return;
+
+    window->inRecovery = false;
+
+    if (++window->ackCount >= window->size)
+    {
+        window->ackCount = 0;
+        if (window->size < WEAVE_CONFIG_WRMP_MAX_SEND_WINDOW)
+            window->size++;
+    }
+}
+
+/**
+ *  Shrink the send window of the peer of a message whose retransmission timeout has expired.
+ *
+ *  @param[in]    entry    A pointer to the retransmission table entry of the message.
+ *
+ */
+void WeaveExchangeManager::WRMPOnRetransTimeout(RetransTableEntry *entry)
+{
+    WRMPSendWindow *window = entry->sendWindow;
+
+    // Other messages outstanding at the time of a loss are likely to have been lost too, so the window is only
+    // reduced once until a message is acknowledged.
+    if (window == NULL || window->inRecovery)
+        return;
+
+    window->inRecovery = true;
+    window->ackCount = 0;
+    window->size = (window->size > 1) ? window->size / 2 : 1;
+}
+#endif // WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+
 /**
 * Iterate through active exchange contexts and retrans table entries.
 * Determine how many WRMP ticks we need to sleep before we need to physically
@@ -1713,9 +2267,7 @@ void WeaveExchangeManager::WRMPStartTimer()
     ExchangeContext *ec               = NULL;
 
     // When do we need to next wake up to send an ACK?
-    ec = (ExchangeContext *)ContextPool;
-
-    for (int i = 0; i < WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS; i++, ec++)
+    for (ec = ContextPool.First(); ec != NULL; ec = ContextPool.Next(ec))
     {
         if (ec->ExchangeMgr != NULL && ec->IsAckPending() && ec->mWRMPNextAckTime < nextWakeTime) {
             nextWakeTime = ec->mWRMPNextAckTime;
@@ -1726,29 +2278,25 @@ void WeaveExchangeManager::WRMPStartTimer()
         }
     }
 
-    for (int i = 0; i < WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE; i++)
+    // When do we need to next wake up for throttle retransmission?
+    for (ec = ContextPool.First(); ec != NULL; ec = ContextPool.Next(ec))
     {
-        ec = RetransTable[i].exchContext;
-        if (ec)
-        {
-            // When do we need to next wake up for throttle retransmission?
-            if (ec->mWRMPThrottleTimeout != 0 && ec->mWRMPThrottleTimeout < nextWakeTime) {
-                nextWakeTime = ec->mWRMPThrottleTimeout;
-                foundWake = true;
+        if (ec->ExchangeMgr != NULL && ec->mWRMPThrottleTimeout != 0 && ec->mWRMPThrottleTimeout < nextWakeTime) {
+            nextWakeTime = ec->mWRMPThrottleTimeout;
+            foundWake = true;
 #if defined(WRMP_TICKLESS_DEBUG)
-                WeaveLogProgress(ExchangeManager, "WRMPStartTimer throttle timeout %u", nextWakeTime);
+            WeaveLogProgress(ExchangeManager, "WRMPStartTimer throttle timeout %u", nextWakeTime);
 #endif
-            }
+        }
+    }
 
-            // When do we need to next wake up for WRMP retransmit?
-            if (RetransTable[i].nextRetransTime < nextWakeTime) {
-                nextWakeTime = RetransTable[i].nextRetransTime;
-                foundWake = true;
+    // When do we need to next wake up for WRMP retransmit?
+    if (mRetransQueueHead != NULL && mRetransQueueHead->retransDeltaTicks < nextWakeTime) {
+        nextWakeTime = mRetransQueueHead->retransDeltaTicks;
+        foundWake = true;
 #if defined(WRMP_TICKLESS_DEBUG)
-                WeaveLogProgress(ExchangeManager, "WRMPStartTimer RetransTime %u", nextWakeTime);
+        WeaveLogProgress(ExchangeManager, "WRMPStartTimer RetransTime %u", nextWakeTime);
 #endif
-            }
-        }
     }
 
     if (foundWake) {
@@ -1805,11 +2353,11 @@ void WeaveExchangeManager::WRMPStopTimer()
  */
 void WeaveExchangeManager::InitBindingPool(void)
 {
-    memset(BindingPool, 0, sizeof(BindingPool));
-    for (size_t i = 0; i < WEAVE_CONFIG_MAX_BINDINGS; ++i)
+    BindingPool.Init(WEAVE_CONFIG_EXCHANGE_MGR_MAX_POOL_SLABS);
+    for (Binding *binding = BindingPool.First(); binding != NULL; binding = BindingPool.Next(binding))
     {
-        BindingPool[i].mState = Binding::kState_NotAllocated;
-        BindingPool[i].mExchangeManager = this;
+        binding->mState = Binding::kState_NotAllocated;
+        binding->mExchangeManager = this;
     }
     mBindingsInUse = 0;
 }
@@ -1827,15 +2375,13 @@ Binding * WeaveExchangeManager::AllocBinding(void)
     WEAVE_FAULT_INJECT(FaultInjection::kFault_AllocBinding,
                            return NULL);
 
-    for (size_t i = 0; i < WEAVE_CONFIG_MAX_BINDINGS; ++i)
+    pResult = BindingPool.Alloc();
+    if (NULL != pResult)
     {
-        if (Binding::kState_NotAllocated == BindingPool[i].mState)
-        {
-            pResult = &BindingPool[i];
-            ++mBindingsInUse;
-            SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumBindings);
-            break;
-        }
+        // Bindings in slabs added to a dynamic pool have not been seen by InitBindingPool().
+        pResult->mExchangeManager = this;
+        ++mBindingsInUse;
+        SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kExchangeMgr_NumBindings);
     }
 
     return pResult;
@@ -1851,6 +2397,7 @@ Binding * WeaveExchangeManager::AllocBinding(void)
 void WeaveExchangeManager::FreeBinding(Binding * binding)
 {
     binding->mState = Binding::kState_NotAllocated;
+    BindingPool.Free(binding);
     --mBindingsInUse;
     SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kExchangeMgr_NumBindings);
 }
@@ -1884,8 +2431,7 @@ Binding * WeaveExchangeManager::NewBinding(Binding::EventCallback eventCallback,
  */
 uint16_t WeaveExchangeManager::GetBindingLogId(const Binding * const binding) const
 {
-    // note that the result of pointer subtraction should be ptrdiff_t
-    return static_cast<uint16_t>(binding - BindingPool);
+    return static_cast<uint16_t>(BindingPool.GetIndex(binding));
 }
 
 } // namespace nl
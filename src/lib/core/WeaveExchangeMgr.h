@@ -31,6 +31,7 @@
 #define WEAVE_EXCHANGE_MGR_H
 
 #include <Weave/Support/NLDLLUtil.h>
+#include <Weave/Support/SlabPool.h>
 #include <Weave/Core/WeaveWRMPConfig.h>
 #include <SystemLayer/SystemTimer.h>
 
@@ -179,6 +180,7 @@ public:
     void SetMsgRcvdFromPeer(bool inMsgRcvdFromPeer);
     WEAVE_ERROR WRMPFlushAcks(void);
     uint32_t GetCurrentRetransmitTimeout(void);
+    uint32_t GetRetransmitTimeout(uint8_t sendCount);
 #endif
     void SetResponseExpected(bool inResponseExpected);
     bool AutoRequestAck() const;
@@ -354,6 +356,12 @@ private:
 
     uint16_t mFlags;                            // Internal state flags
 
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+    uint32_t mAllocTime;                        // When the context was allocated
+    uint32_t mResponseExpectedTime;             // When the message expecting a response was sent
+    uint32_t mAckPendingTime;                   // When the pending acknowledgment became pending
+#endif
+
     WEAVE_ERROR ResendMessage(void);
     bool MatchExchange(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo, const WeaveExchangeHeader *exchangeHeader);
     static void TimerTau(System::Layer* aSystemLayer, void* aAppState, System::Error aError);
@@ -375,6 +383,8 @@ private:
                               ExchangeContext::MessageReceiveFunct umhandler);
     void HandleConnectionClosed(WEAVE_ERROR conErr);
 
+    ExchangeContext *mNextInIndex;              // Next context in the same exchange manager index bucket
+
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     bool WRMPCheckAndRemRetransTable(uint32_t msgId, void **rCtxt);
     WEAVE_ERROR WRMPHandleRcvdAck(const WeaveExchangeHeader *exchHeader, const WeaveMessageInfo *msgInfo);
@@ -393,6 +403,10 @@ private:
  *    It works on behalf of higher layers, creating ExchangeContexts and
  *    handling the registration/unregistration of unsolicited message handlers.
  *
+ *    An ExchangeContext is owned by the thread that runs the event loop of
+ *    its manager's WeaveMessageLayer, and must only be created, used and
+ *    closed on that thread; see WeaveMessageLayer for the sharding model.
+ *
  */
 class NL_DLL_EXPORT WeaveExchangeManager
 {
@@ -454,12 +468,39 @@ public:
     void ClearMsgCounterSyncReq(uint64_t peerNodeId);
 #endif
 
+    void GetContextPoolStats(PoolStats &stats) const { ContextPool.GetStats(stats); }
+    void GetBindingPoolStats(PoolStats &stats) const { BindingPool.GetStats(stats); }
+    void GetUMHandlerPoolStats(PoolStats &stats) const { UMHandlerPool.GetStats(stats); }
+
 private:
     uint16_t NextExchangeId;
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     uint64_t mWRMPTimeStampBase;    //WRMP timer base value to add offsets to evaluate timeouts
     System::Timer::Epoch mWRMPCurrentTimerExpiry; //Tracks when the WRM timer will next expire
     uint16_t mWRMPTimerInterval;    //WRMP Timer tick period
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+    /**
+     *  @class WRMPSendWindow
+     *
+     *  @brief
+     *    This class is part of the Weave Reliable Messaging Protocol and is used
+     *    to limit the number of unacknowledged messages outstanding to a peer
+     *    node. The window size is increased by one message for each window's
+     *    worth of messages acknowledged without retransmission, and is halved
+     *    (once per loss episode) when a retransmission timeout expires.
+     *
+     */
+    class WRMPSendWindow
+    {
+      public:
+       uint64_t             peerNodeId;         /**< The node identifier of the peer. */
+       uint8_t              size;               /**< The maximum number of messages that may be outstanding to the peer. */
+       uint8_t              inFlight;           /**< The number of messages sent to the peer and awaiting acknowledgment. */
+       uint8_t              held;               /**< The number of messages waiting for room in the window. */
+       uint8_t              ackCount;           /**< The number of acknowledgments received since the window last grew. */
+       bool                 inRecovery;         /**< Set when the window has been reduced and no message sent since has been acknowledged. */
+    };
+#endif // WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
     /**
      *  @class RetransTableEntry
      *
@@ -469,6 +510,12 @@ private:
      *    acknowledgment back. If the acknowledgment is not received within a
      *    specific timeout, the message would be retransmitted from this table.
      *
+     *    Allocated entries are kept in a delta queue ordered by retransmission
+     *    time, in which each entry records the number of timer ticks between
+     *    its retransmission and that of the entry before it. Expiring timer ticks
+     *    and finding the entries due for retransmission thus only visits the head
+     *    of the queue, regardless of the size of the table.
+     *
      */
     class RetransTableEntry
     {
@@ -477,14 +524,24 @@ private:
        ExchangeContext      *exchContext;       /**< The ExchangeContext for the stored Weave message. */
        PacketBuffer         *msgBuf;            /**< A pointer to the PacketBuffer object holding the Weave message. */
        void                 *msgCtxt;           /**< A pointer to an application level context object associated with the message. */
-       uint16_t             nextRetransTime;    /**< A counter representing the next retransmission time for the message. */
+       RetransTableEntry    *nextInQueue;       /**< The entry due for retransmission next after this one. */
+       uint16_t             retransDeltaTicks;  /**< The number of timer ticks between the retransmission of the preceding entry in the queue (or the current tick, for the head of the queue) and that of this entry. */
        uint8_t              sendCount;          /**< A counter representing the number of times the message has been sent. */
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+       WRMPSendWindow       *sendWindow;        /**< The send window of the peer, or NULL if the message is not subject to a send window. */
+       bool                 heldForWindow;      /**< Set while the message is waiting for room in its send window. */
+#endif
+#if WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+       uint32_t             firstSendTime;      /**< The time (in milliseconds, truncated to 32 bits) at which the message was first sent. */
+#endif
     };
     void     WRMPExecuteActions(void);
     void     WRMPExpireTicks(void);
     void     WRMPStartTimer(void);
     void     WRMPStopTimer(void);
     void     WRMPProcessDDMessage(uint32_t PauseTimeMillis, uint64_t DelayedNodeId);
+    void     WRMPProcessMultiAck(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
+    bool     WRMPSendMultiAck(ExchangeContext *ec);
     uint32_t GetTickCounterFromTimeDelta (uint64_t newTime,
                                           uint64_t oldTime);
     static void WRMPTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError);
@@ -495,12 +552,28 @@ private:
     void ClearRetransmitTable(ExchangeContext *ec);
     void ClearRetransmitTable(RetransTableEntry &rEntry);
     void FailRetransmitTableEntries(ExchangeContext *ec, WEAVE_ERROR err);
+    void QueueRetransEntry(RetransTableEntry *entry, uint32_t ticks);
+    void DequeueRetransEntry(RetransTableEntry *entry);
+    void RescheduleRetransEntry(RetransTableEntry *entry, uint32_t ticks);
+    uint32_t GetRetransEntryTicks(const RetransTableEntry *entry) const;
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+    WRMPSendWindow *WRMPGetSendWindow(uint64_t peerNodeId);
+    bool WRMPAdmitToSendWindow(RetransTableEntry *entry);
+    void WRMPRemoveFromSendWindow(RetransTableEntry *entry);
+    void WRMPReleaseHeldMessages(WRMPSendWindow *window);
+    void WRMPOnMessageAcked(RetransTableEntry *entry);
+    void WRMPOnRetransTimeout(RetransTableEntry *entry);
+#endif
     void RetransPendingAppGroupMsgs(uint64_t peerNodeId);
 
     void TicklessDebugDumpRetransTable(const char *log);
 
     //WRMP Global tables for timer context
     RetransTableEntry RetransTable[WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE];
+    RetransTableEntry *mRetransQueueHead;   //Entry in RetransTable due for retransmission soonest
+#if WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+    WRMPSendWindow mWRMPSendWindows[WEAVE_CONFIG_WRMP_SEND_WINDOW_TABLE_SIZE];
+#endif
 #endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
 
     class UnsolicitedMessageHandler
@@ -512,19 +585,41 @@ private:
         WeaveConnection *Con; // NULL means any connection, or no connection (i.e. UDP)
         int16_t MessageType; // -1 represents any message type
         bool AllowDuplicateMsgs;
+        UnsolicitedMessageHandler *NextInIndex; // Next handler in the same index bucket
     };
 
 
-    ExchangeContext ContextPool[WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS];
-    size_t mContextsInUse;
+#if WEAVE_CONFIG_EXCHANGE_MGR_DYNAMIC_POOLS
+    SlabPool<ExchangeContext, WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS> ContextPool;
+    SlabPool<Binding, WEAVE_CONFIG_MAX_BINDINGS> BindingPool;
+    SlabPool<UnsolicitedMessageHandler, WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS> UMHandlerPool;
+#else
+    StaticPool<ExchangeContext, WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS> ContextPool;
+    StaticPool<Binding, WEAVE_CONFIG_MAX_BINDINGS> BindingPool;
+    StaticPool<UnsolicitedMessageHandler, WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS> UMHandlerPool;
+#endif
 
-    Binding BindingPool[WEAVE_CONFIG_MAX_BINDINGS];
+    size_t mContextsInUse;
     size_t mBindingsInUse;
 
-    UnsolicitedMessageHandler UMHandlerPool[WEAVE_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS];
+    // Active contexts, hashed by exchange id. Each bucket is kept in pool order.
+    ExchangeContext *mContextIndex[WEAVE_CONFIG_EXCHANGE_CONTEXT_INDEX_SIZE];
+
+    // Registered handlers, hashed by profile id and message type. Each bucket is kept in pool order.
+    UnsolicitedMessageHandler *mUMHandlerIndex[WEAVE_CONFIG_UNSOLICITED_MESSAGE_HANDLER_INDEX_SIZE];
+
     void (*OnExchangeContextChanged)(size_t numContextsInUse);
 
     ExchangeContext *AllocContext(void);
+    void AddContextToIndex(ExchangeContext *ec);
+    void RemoveContextFromIndex(ExchangeContext *ec);
+    ExchangeContext *FindContextForMessage(WeaveConnection *msgCon, const WeaveMessageInfo *msgInfo,
+            const WeaveExchangeHeader *exchangeHeader);
+    void AddUMHToIndex(UnsolicitedMessageHandler *umh);
+    void RemoveUMHFromIndex(UnsolicitedMessageHandler *umh);
+    UnsolicitedMessageHandler *FindUMH(uint32_t profileId, uint8_t msgType, WeaveConnection *msgCon, bool isDupMsg);
+    static uint32_t ContextIndexBucket(uint16_t exchangeId);
+    static uint32_t UMHIndexBucket(uint32_t profileId, int16_t msgType);
 
     void HandleConnectionReceived(WeaveConnection *con);
     void HandleConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr);
@@ -105,6 +105,101 @@ enum
 // Key diversifier used for Weave message encryption key derivation.
 const uint8_t kWeaveMsgEncAppKeyDiversifier[] = { 0xB1, 0x1D, 0xAE, 0x5B };
 
+// Hash functions for the peer state and session key indexes.
+static inline size_t HashNodeId(uint64_t nodeId, size_t indexSize)
+{
+    return (size_t)((nodeId * UINT64_C(0x9E3779B97F4A7C15)) >> 32) % indexSize;
+}
+
+static inline size_t HashKeyId(uint16_t keyId, size_t indexSize)
+{
+    return (size_t)((keyId * UINT32_C(0x9E3779B1)) >> 16) % indexSize;
+}
+
+// Locates the home position of an entry in the peer state index.
+struct PeerIndexHome
+{
+    const uint64_t *NodeIds;
+    size_t IndexSize;
+
+    size_t operator()(size_t entry) const { return HashNodeId(NodeIds[entry - 1], IndexSize); }
+};
+
+// Locates the home position of an entry in the session key index.
+struct SessionKeyIndexHome
+{
+    const WeaveSessionKey *SessionKeys;
+    size_t IndexSize;
+
+    size_t operator()(size_t entry) const { return HashKeyId(SessionKeys[entry - 1].MsgEncKey.KeyId, IndexSize); }
+};
+
+// Locates the home position of an entry in the application key cache index.
+struct AppKeyIndexHome
+{
+    const WeaveMsgEncryptionKey *Keys;
+    size_t IndexSize;
+
+    size_t operator()(size_t entry) const { return HashKeyId(Keys[entry - 1].KeyId, IndexSize); }
+};
+
+/**
+ * Remove the entry at a given position of a linear-probing hash index.
+ *
+ * Entries following the removed one in the same probe sequence are shifted back to fill the gap,
+ * so that lookups never stop short at an empty position and no tombstones are needed.
+ */
+template <typename EntryType, class HomeFunct>
+static void RemoveHashIndexEntry(EntryType *index, size_t indexSize, size_t pos, const HomeFunct &home)
+{
+    size_t next = pos;
+
+    while (true)
+    {
+        index[pos] = 0;
+
+        while (true)
+        {
+            next = (next + 1) % indexSize;
+
+            if (index[next] == 0)
+                return;
+
+            // Leave the entry in place if its home position lies cyclically within (pos, next].
+            size_t nextHome = home(index[next]);
+            bool inPlace = (pos <= next) ? (pos < nextHome && nextHome <= next) : (pos < nextHome || nextHome <= next);
+            if (!inPlace)
+                break;
+        }
+
+        index[pos] = index[next];
+        pos = next;
+    }
+}
+
+/**
+ * Wipe the state of a suspended session, including its keys.
+ */
+void WeaveSuspendedSession::Clear(void)
+{
+    ClearSecretData((uint8_t *)this, sizeof(*this));
+}
+
+/**
+ * Compute the checksum (32-bit FNV-1a) over all the fields that follow the checksum field.
+ */
+uint32_t WeaveSuspendedSession::ComputeChecksum(void) const
+{
+    const uint8_t *p = (const uint8_t *)this + sizeof(Checksum);
+    const uint8_t *end = (const uint8_t *)this + sizeof(*this);
+    uint32_t hash = UINT32_C(0x811C9DC5);
+
+    for (; p < end; p++)
+        hash = (hash ^ *p) * UINT32_C(0x01000193);
+
+    return hash;
+}
+
 /**
  * Initialize a WeaveSessionKey object.
  */
@@ -115,6 +210,7 @@ void WeaveSessionKey::Init(void)
     MaxRcvdMsgId = 0;
     BoundCon = NULL;
     RcvFlags = 0;
+    memset(RcvWindow, 0, sizeof(RcvWindow));
     AuthMode = kWeaveAuthMode_NotSpecified;
     memset(&MsgEncKey, 0, sizeof(MsgEncKey));
     ReserveCount = 0;
@@ -130,6 +226,59 @@ void WeaveSessionKey::Clear(void)
     ClearSecretData((uint8_t *)&MsgEncKey.EncKey, sizeof(MsgEncKey.EncKey));
 }
 
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
+/**
+ * Get the expanded AES-128-CTR-SHA-1 cipher state for the key, computing it
+ * from the key material on first use.
+ *
+ * @return A reference to the key schedule.
+ */
+WeaveEncryptionKeySchedule_AES128CTRSHA1 &WeaveMsgEncryptionKey::GetKeySchedule_AES128CTRSHA1(void)
+{
+    if (KeyScheduleEncType != kWeaveEncryptionType_AES128CTRSHA1)
+    {
+        KeySchedule.DataKeySchedule.SetKey(EncKey.AES128CTRSHA1.DataKey);
+        KeySchedule.IntegrityKeySchedule.SetKey(EncKey.AES128CTRSHA1.IntegrityKey,
+                                                WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+        KeyScheduleEncType = kWeaveEncryptionType_AES128CTRSHA1;
+    }
+
+    return KeySchedule;
+}
+
+/**
+ * Get the expanded AES-128-CCM cipher state for the key, computing it
+ * from the key material on first use.
+ *
+ * @return A reference to the key schedule.
+ */
+WeaveEncryptionKeySchedule_AES128CCM &WeaveMsgEncryptionKey::GetKeySchedule_AES128CCM(void)
+{
+    if (KeyScheduleEncType != kWeaveEncryptionType_AES128CCM)
+    {
+        KeySchedule_AES128CCM.DataKeySchedule.SetKey(EncKey.AES128CCM.DataKey);
+        KeyScheduleEncType = kWeaveEncryptionType_AES128CCM;
+    }
+
+    return KeySchedule_AES128CCM;
+}
+
+/**
+ * Discard the expanded cipher state for the key.
+ *
+ * This must be called whenever the key material in EncKey changes or is wiped.
+ */
+void WeaveMsgEncryptionKey::ClearKeySchedule(void)
+{
+    KeySchedule.DataKeySchedule.Reset();
+    KeySchedule.IntegrityKeySchedule.Reset();
+    KeySchedule_AES128CCM.DataKeySchedule.Reset();
+    KeyScheduleEncType = kWeaveEncryptionType_None;
+}
+
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
 /**
  * @fn bool WeaveSessionKey::IsAllocated() const
  *
@@ -235,11 +384,11 @@ WEAVE_ERROR WeaveFabricState::Init(GroupKeyStoreBase *groupKeyStore)
     LocalNodeId = 1;
     PairingCode = NULL;
     DefaultSubnet = kWeaveSubnetId_PrimaryWiFi;
-    PeerCount = 0;
     NextUnencUDPMsgId.Init(GetRandU32());
     NextUnencTCPMsgId.Init(0);
     for (int i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++)
         SessionKeys[i].Init();
+    memset(SessionKeyIndex, 0, sizeof(SessionKeyIndex));
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
     WEAVE_ERROR err = NextGroupKeyMsgId.Init(WEAVE_CONFIG_PERSISTED_STORAGE_ENC_MSG_CNTR_ID, WEAVE_CONFIG_PERSISTED_STORAGE_ENC_MSG_CNTR_EPOCH);
     if (err != WEAVE_NO_ERROR)
@@ -249,9 +398,15 @@ WEAVE_ERROR WeaveFabricState::Init(GroupKeyStoreBase *groupKeyStore)
     MsgCounterSyncStatus = 0;
     AppKeyCache.Init();
 #endif
-    memset(&PeerStates, 0, sizeof(PeerStates));
+    ResetPeerStates();
     Delegate = NULL;
     memset(SharedSessionsNodes, 0, sizeof(SharedSessionsNodes));
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    memset(CASEResumptionTickets, 0, sizeof(CASEResumptionTickets));
+#endif
+#if WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 0
+    FabricPrefixes.Init(FabricPrefixNodes, sizeof(FabricPrefixNodes) / sizeof(FabricPrefixNodes[0]));
+#endif
 
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
     DebugFabricId = 0;
@@ -289,6 +444,10 @@ WEAVE_ERROR WeaveFabricState::Shutdown()
 {
     State = kState_NotInitialized;
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    ClearSecretData((uint8_t *)CASEResumptionTickets, sizeof(CASEResumptionTickets));
+#endif
+
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
     AppKeyCache.Shutdown();
 #endif
@@ -316,6 +475,7 @@ WEAVE_ERROR WeaveFabricState::AllocSessionKey(uint64_t peerNodeId, uint16_t keyI
 
     sessionKey->MsgEncKey.KeyId = keyId;
     sessionKey->NodeId = peerNodeId;
+    AddSessionKeyToIndex(sessionKey);
     sessionKey->MsgEncKey.EncType = kWeaveEncryptionType_None;
     sessionKey->NextMsgId.Init(UINT32_MAX);
     sessionKey->MaxRcvdMsgId = UINT32_MAX;
@@ -355,6 +515,9 @@ WEAVE_ERROR WeaveFabricState::SetSessionKey(WeaveSessionKey *sessionKey, uint8_t
 
     sessionKey->MsgEncKey.EncType = encType;
     sessionKey->MsgEncKey.EncKey = *encKey;
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    sessionKey->MsgEncKey.ClearKeySchedule();
+#endif
     sessionKey->NextMsgId.Init(msgId);
     sessionKey->MaxRcvdMsgId = 0;
     sessionKey->RcvFlags = 0;
@@ -396,6 +559,7 @@ void WeaveFabricState::RemoveSessionKey(WeaveSessionKey *sessionKey, bool wasIdl
             (wasIdle) ? "idle " : "", sessionKey->MsgEncKey.KeyId, sessionKey->NodeId);
 
     RemoveSharedSessionEndNodes(sessionKey);
+    RemoveSessionKeyFromIndex(sessionKey);
     sessionKey->Clear();
 }
 
@@ -626,16 +790,9 @@ WEAVE_ERROR WeaveFabricState::SuspendSession(uint16_t keyId, uint64_t peerNodeId
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSessionKey * sessionKey;
 
-    // Lookup the specified session.
-    err = GetSessionKey(keyId, peerNodeId, sessionKey);
+    err = GetSessionKeyToSuspend(keyId, peerNodeId, sessionKey);
     SuccessOrExit(err);
 
-    // Assert various requirements about the session.
-    VerifyOrExit(sessionKey->IsKeySet(), err = WEAVE_ERROR_KEY_NOT_FOUND);
-    VerifyOrExit(!sessionKey->IsSuspended(), err = WEAVE_ERROR_SESSION_KEY_SUSPENDED);
-    VerifyOrExit(sessionKey->BoundCon == NULL, err = WEAVE_ERROR_INVALID_USE_OF_SESSION_KEY);
-    VerifyOrExit(IsCertAuthMode(sessionKey->AuthMode), err = WEAVE_ERROR_INVALID_USE_OF_SESSION_KEY);
-
     {
         TLVWriter writer;
         TLVType container;
@@ -705,10 +862,26 @@ WEAVE_ERROR WeaveFabricState::SuspendSession(uint16_t keyId, uint64_t peerNodeId
                     sessionKey->MsgEncKey.EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
             SuccessOrExit(err);
             break;
+        case kWeaveEncryptionType_AES128CCM:
+            err = writer.PutBytes(ContextTag(kTag_SerializedSession_AES128CCM_DataKey),
+                    sessionKey->MsgEncKey.EncKey.AES128CCM.DataKey, WeaveEncryptionKey_AES128CCM::DataKeySize);
+            SuccessOrExit(err);
+            break;
         default:
             ExitNow(err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
         }
 
+        // Encode the message received window.
+        {
+            uint8_t rcvWindow[sizeof(sessionKey->RcvWindow)];
+
+            for (int i = 0; i < WeaveSessionState::kSessionKeyReceiveWindowWords; i++)
+                LittleEndian::Put32(rcvWindow + i * sizeof(uint32_t), sessionKey->RcvWindow[i]);
+
+            err = writer.PutBytes(ContextTag(kTag_SerializedSession_MessageRcvdWindow), rcvWindow, sizeof(rcvWindow));
+            SuccessOrExit(err);
+        }
+
         // End the Security:SerializedSession TLV structure and finalize the encoding.
         err = writer.EndContainer(container);
         SuccessOrExit(err);
@@ -718,12 +891,7 @@ WEAVE_ERROR WeaveFabricState::SuspendSession(uint16_t keyId, uint64_t peerNodeId
         serializedSessionLen = (uint16_t)writer.GetLengthWritten();
     }
 
-    // Mark the session key as suspended.
-    sessionKey->MarkSuspended();
-
-    // Wipe the key.
-    sessionKey->MsgEncKey.EncType = kWeaveEncryptionType_None;
-    ClearSecretData((uint8_t *)&sessionKey->MsgEncKey.EncKey, sizeof(sessionKey->MsgEncKey.EncKey));
+    WipeSuspendedSessionKey(sessionKey);
 
 exit:
     // If something goes wrong, make sure we don't leave any key material behind.
@@ -767,33 +935,12 @@ WEAVE_ERROR WeaveFabricState::RestoreSession(uint8_t * serializedSession, uint16
     SuccessOrExit(err);
 
     // Look for / create a session key entry for the given key id and peer node.
-    err = FindSessionKey(keyId, peerNodeId, true, sessionKey);
+    err = AllocSessionKeyToRestore(keyId, peerNodeId, sessionKey);
     SuccessOrExit(err);
-    if (!sessionKey->IsAllocated())
-    {
-        sessionKey->MsgEncKey.KeyId = keyId;
-        sessionKey->NodeId = peerNodeId;
-        sessionKey->BoundCon = NULL;
-        sessionKey->ReserveCount = 0;
-        sessionKey->Flags = 0;
-    }
-    else
-    {
-        // If the key id / peer node matches an existing session that is NOT suspended, fail with an error.
-        VerifyOrExit(sessionKey->IsSuspended(), err = WEAVE_ERROR_DUPLICATE_KEY_ID);
-    }
-    sessionKey->SetRemoveOnIdle(true);
-    sessionKey->MarkRecentlyActive();
 
     // After this point, if an error occurs, remove the session key.
     removeSessionOnError = true;
 
-    // If the key id / peer node matched a suspended session key, clear the suspended flag.
-    sessionKey->ClearSuspended();
-
-    // Clear any alternate end node ids associated with the session key.
-    RemoveSharedSessionEndNodes(sessionKey);
-
     // Read the encoded session information in tag order and restore it into the session key entry.
     {
         uint32_t nextMsgId;
@@ -867,6 +1014,10 @@ WEAVE_ERROR WeaveFabricState::RestoreSession(uint8_t * serializedSession, uint16
     err = reader.Get(sessionKey->MsgEncKey.EncType);
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    sessionKey->MsgEncKey.ClearKeySchedule();
+#endif
+
     // Based on the encryption type, restore the associated keys.
     switch (sessionKey->MsgEncKey.EncType)
     {
@@ -882,13 +1033,55 @@ WEAVE_ERROR WeaveFabricState::RestoreSession(uint8_t * serializedSession, uint16
         err = reader.GetBytes(sessionKey->MsgEncKey.EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
         SuccessOrExit(err);
         break;
+    case kWeaveEncryptionType_AES128CCM:
+        err = reader.Next(kTLVType_ByteString, ContextTag(kTag_SerializedSession_AES128CCM_DataKey));
+        SuccessOrExit(err);
+        VerifyOrExit(reader.GetLength() == WeaveEncryptionKey_AES128CCM::DataKeySize, err = WEAVE_ERROR_INVALID_ARGUMENT);
+        err = reader.GetBytes(sessionKey->MsgEncKey.EncKey.AES128CCM.DataKey, WeaveEncryptionKey_AES128CCM::DataKeySize);
+        SuccessOrExit(err);
+        break;
     default:
         ExitNow(err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
     }
 
-    // Verify no other data in the serialized session structure.
-    err = reader.VerifyEndOfContainer();
-    SuccessOrExit(err);
+    // Restore the message received window.
+    //
+    // Sessions serialized before the window was widened carry no window element. Instead, the flags
+    // for the 15 messages preceding the max received message are held in the received flags field.
+    // The history of earlier messages is unknown, so those messages are treated as already received.
+    memset(sessionKey->RcvWindow, 0xFF, sizeof(sessionKey->RcvWindow));
+    err = reader.Next();
+    if (err == WEAVE_END_OF_TLV)
+    {
+        sessionKey->RcvWindow[0] = (sessionKey->RcvWindow[0] & ~(uint32_t) WeaveSessionState::kReceiveFlags_LegacyMessageIdFlagsMask) |
+                                   (sessionKey->RcvFlags & WeaveSessionState::kReceiveFlags_LegacyMessageIdFlagsMask);
+    }
+    else
+    {
+        const uint8_t *rcvWindow;
+        uint32_t rcvWindowLen;
+
+        SuccessOrExit(err);
+        VerifyOrExit(reader.GetTag() == ContextTag(kTag_SerializedSession_MessageRcvdWindow) &&
+                     reader.GetType() == kTLVType_ByteString, err = WEAVE_ERROR_UNEXPECTED_TLV_ELEMENT);
+        rcvWindowLen = reader.GetLength();
+        VerifyOrExit(rcvWindowLen % sizeof(uint32_t) == 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+        err = reader.GetDataPtr(rcvWindow);
+        SuccessOrExit(err);
+
+        // If the serialized window is wider than the local one, only its most recent part is retained.
+        if (rcvWindowLen > sizeof(sessionKey->RcvWindow))
+            rcvWindowLen = sizeof(sessionKey->RcvWindow);
+
+        for (uint32_t i = 0; i < rcvWindowLen / sizeof(uint32_t); i++)
+            sessionKey->RcvWindow[i] = LittleEndian::Get32(rcvWindow + i * sizeof(uint32_t));
+
+        // Verify no other data in the serialized session structure.
+        err = reader.VerifyEndOfContainer();
+        SuccessOrExit(err);
+    }
+    sessionKey->RcvFlags &= ~WeaveSessionState::kReceiveFlags_LegacyMessageIdFlagsMask;
+
     err = reader.ExitContainer(container);
     SuccessOrExit(err);
 
@@ -900,6 +1093,192 @@ exit:
     return err;
 }
 
+/**
+ * Suspend an active Weave security session, capturing its state in compact form.
+ *
+ * Captures the state of an identified Weave security session into the supplied object
+ * and suspends the session such that no further messages can be sent or received.
+ *
+ * This method is intended to be used by devices that retain part of their RAM while sleeping.
+ * The session can be restored with a copy of the state and a checksum verification, which is
+ * faster than decoding the TLV serialization produced by the variant of this method that
+ * takes a buffer.
+ */
+WEAVE_ERROR WeaveFabricState::SuspendSession(uint16_t keyId, uint64_t peerNodeId, WeaveSuspendedSession & suspendedSession)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveSessionKey * sessionKey;
+    SharedSessionEndNode *endNode = SharedSessionsNodes;
+
+    // Clear the whole object, including any padding, so that its checksum is well defined.
+    suspendedSession.Clear();
+
+    err = GetSessionKeyToSuspend(keyId, peerNodeId, sessionKey);
+    SuccessOrExit(err);
+
+    VerifyOrExit(sessionKey->MsgEncKey.EncType == kWeaveEncryptionType_AES128CTRSHA1 ||
+                 sessionKey->MsgEncKey.EncType == kWeaveEncryptionType_AES128CCM, err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+
+    suspendedSession.LayoutVersion = WeaveSuspendedSession::kLayoutVersion;
+    suspendedSession.LayoutSize = sizeof(WeaveSuspendedSession);
+    suspendedSession.PeerNodeId = sessionKey->NodeId;
+    suspendedSession.NextMsgId = sessionKey->NextMsgId.GetValue();
+    suspendedSession.MaxRcvdMsgId = sessionKey->MaxRcvdMsgId;
+    memcpy(suspendedSession.RcvWindow, sessionKey->RcvWindow, sizeof(suspendedSession.RcvWindow));
+    suspendedSession.RcvFlags = sessionKey->RcvFlags;
+    suspendedSession.KeyId = sessionKey->MsgEncKey.KeyId;
+    suspendedSession.AuthMode = sessionKey->AuthMode;
+    suspendedSession.EncType = sessionKey->MsgEncKey.EncType;
+    suspendedSession.SessionFlags = sessionKey->Flags & (WeaveSessionKey::kFlag_IsLocallyInitiated | WeaveSessionKey::kFlag_IsSharedSession);
+    suspendedSession.EncKey = sessionKey->MsgEncKey.EncKey;
+
+    // If the session is shared, capture the alternate node ids for the peer.
+    if (sessionKey->IsSharedSession())
+    {
+        for (int i = 0; i < WEAVE_CONFIG_MAX_SHARED_SESSIONS_END_NODES; i++, endNode++)
+        {
+            if (endNode->SessionKey == sessionKey)
+                suspendedSession.AltNodeIds[suspendedSession.AltNodeIdCount++] = endNode->EndNodeId;
+        }
+    }
+
+    suspendedSession.Checksum = suspendedSession.ComputeChecksum();
+
+    WipeSuspendedSessionKey(sessionKey);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        suspendedSession.Clear();
+    }
+    return err;
+}
+
+/**
+ * Restore a previously suspended Weave Security Session from its compact state.
+ *
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT    If the state was not produced by this build, or has been corrupted.
+ */
+WEAVE_ERROR WeaveFabricState::RestoreSession(const WeaveSuspendedSession & suspendedSession)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveSessionKey * sessionKey = NULL;
+    bool removeSessionOnError = false;
+
+    // Verify the layout and integrity of the state before using any of it.
+    VerifyOrExit(suspendedSession.LayoutVersion == WeaveSuspendedSession::kLayoutVersion &&
+                 suspendedSession.LayoutSize == sizeof(WeaveSuspendedSession), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(suspendedSession.Checksum == suspendedSession.ComputeChecksum(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(suspendedSession.EncType == kWeaveEncryptionType_AES128CTRSHA1 ||
+                 suspendedSession.EncType == kWeaveEncryptionType_AES128CCM, err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+    VerifyOrExit(suspendedSession.AltNodeIdCount <= WEAVE_CONFIG_MAX_SHARED_SESSIONS_END_NODES, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // Look for / create a session key entry for the given key id and peer node.
+    err = AllocSessionKeyToRestore(suspendedSession.KeyId, suspendedSession.PeerNodeId, sessionKey);
+    SuccessOrExit(err);
+
+    // After this point, if an error occurs, remove the session key.
+    removeSessionOnError = true;
+
+    err = sessionKey->NextMsgId.Init(suspendedSession.NextMsgId);
+    SuccessOrExit(err);
+    sessionKey->MaxRcvdMsgId = suspendedSession.MaxRcvdMsgId;
+    memcpy(sessionKey->RcvWindow, suspendedSession.RcvWindow, sizeof(sessionKey->RcvWindow));
+    sessionKey->RcvFlags = suspendedSession.RcvFlags;
+    sessionKey->SetLocallyInitiated(GetFlag(suspendedSession.SessionFlags, (uint8_t)WeaveSessionKey::kFlag_IsLocallyInitiated));
+    sessionKey->SetSharedSession(GetFlag(suspendedSession.SessionFlags, (uint8_t)WeaveSessionKey::kFlag_IsSharedSession));
+    sessionKey->AuthMode = suspendedSession.AuthMode;
+    sessionKey->MsgEncKey.EncType = suspendedSession.EncType;
+    sessionKey->MsgEncKey.EncKey = suspendedSession.EncKey;
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    sessionKey->MsgEncKey.ClearKeySchedule();
+#endif
+
+    // If the session is a shared session, restore the list of alternate end node ids.
+    if (sessionKey->IsSharedSession())
+    {
+        for (uint8_t i = 0; i < suspendedSession.AltNodeIdCount; i++)
+        {
+            err = AddSharedSessionEndNode(sessionKey, suspendedSession.AltNodeIds[i]);
+            SuccessOrExit(err);
+        }
+    }
+
+exit:
+    if (removeSessionOnError && err != WEAVE_NO_ERROR)
+    {
+        RemoveSessionKey(sessionKey, false);
+    }
+    return err;
+}
+
+// Look up a session to be suspended and verify that it can be.
+WEAVE_ERROR WeaveFabricState::GetSessionKeyToSuspend(uint16_t keyId, uint64_t peerNodeId, WeaveSessionKey *& sessionKey)
+{
+    WEAVE_ERROR err;
+
+    // Lookup the specified session.
+    err = GetSessionKey(keyId, peerNodeId, sessionKey);
+    SuccessOrExit(err);
+
+    // Assert various requirements about the session.
+    VerifyOrExit(sessionKey->IsKeySet(), err = WEAVE_ERROR_KEY_NOT_FOUND);
+    VerifyOrExit(!sessionKey->IsSuspended(), err = WEAVE_ERROR_SESSION_KEY_SUSPENDED);
+    VerifyOrExit(sessionKey->BoundCon == NULL, err = WEAVE_ERROR_INVALID_USE_OF_SESSION_KEY);
+    VerifyOrExit(IsCertAuthMode(sessionKey->AuthMode), err = WEAVE_ERROR_INVALID_USE_OF_SESSION_KEY);
+
+exit:
+    return err;
+}
+
+// Mark a session whose state has been captured as suspended and wipe its key.
+void WeaveFabricState::WipeSuspendedSessionKey(WeaveSessionKey *sessionKey)
+{
+    // Mark the session key as suspended.
+    sessionKey->MarkSuspended();
+
+    // Wipe the key.
+    sessionKey->MsgEncKey.EncType = kWeaveEncryptionType_None;
+    ClearSecretData((uint8_t *)&sessionKey->MsgEncKey.EncKey, sizeof(sessionKey->MsgEncKey.EncKey));
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    sessionKey->MsgEncKey.ClearKeySchedule();
+#endif
+}
+
+// Find or create the session key entry into which a suspended session is restored.
+WEAVE_ERROR WeaveFabricState::AllocSessionKeyToRestore(uint16_t keyId, uint64_t peerNodeId, WeaveSessionKey *& sessionKey)
+{
+    WEAVE_ERROR err;
+
+    err = FindSessionKey(keyId, peerNodeId, true, sessionKey);
+    SuccessOrExit(err);
+    if (!sessionKey->IsAllocated())
+    {
+        sessionKey->MsgEncKey.KeyId = keyId;
+        sessionKey->NodeId = peerNodeId;
+        AddSessionKeyToIndex(sessionKey);
+        sessionKey->BoundCon = NULL;
+        sessionKey->ReserveCount = 0;
+        sessionKey->Flags = 0;
+    }
+    else
+    {
+        // If the key id / peer node matches an existing session that is NOT suspended, fail with an error.
+        VerifyOrExit(sessionKey->IsSuspended(), err = WEAVE_ERROR_DUPLICATE_KEY_ID);
+    }
+    sessionKey->SetRemoveOnIdle(true);
+    sessionKey->MarkRecentlyActive();
+
+    // If the key id / peer node matched a suspended session key, clear the suspended flag.
+    sessionKey->ClearSuspended();
+
+    // Clear any alternate end node ids associated with the session key.
+    RemoveSharedSessionEndNodes(sessionKey);
+
+exit:
+    return err;
+}
+
 WEAVE_ERROR WeaveFabricState::GetSessionState(uint64_t remoteNodeId,
                                               uint16_t keyId,
                                               uint8_t encType,
@@ -922,10 +1301,11 @@ WEAVE_ERROR WeaveFabricState::GetSessionState(uint64_t remoteNodeId,
         {
             FindOrAllocPeerEntry(remoteNodeId, true, peerIndex);
             outSessionState = WeaveSessionState(NULL, kWeaveAuthMode_Unauthenticated, &NextUnencUDPMsgId,
-                                                &PeerStates.MaxUnencUDPMsgIdRcvd[peerIndex], &PeerStates.UnencRcvFlags[peerIndex]);
+                                                &PeerStates.MaxUnencUDPMsgIdRcvd[peerIndex], &PeerStates.UnencRcvFlags[peerIndex],
+                                                PeerStates.UnencRcvWindow[peerIndex], WeaveSessionState::kUnencryptedReceiveWindowWords);
         }
         else
-            outSessionState = WeaveSessionState(NULL, kWeaveAuthMode_Unauthenticated, &NextUnencTCPMsgId, NULL, NULL);
+            outSessionState = WeaveSessionState(NULL, kWeaveAuthMode_Unauthenticated, &NextUnencTCPMsgId, NULL, NULL, NULL, 0);
         break;
 
     case WeaveKeyId::kType_Session:
@@ -939,7 +1319,8 @@ WEAVE_ERROR WeaveFabricState::GetSessionState(uint64_t remoteNodeId,
             return (sessionKey->MsgEncKey.EncType == kWeaveEncryptionType_None) ? WEAVE_ERROR_KEY_NOT_FOUND : WEAVE_ERROR_WRONG_ENCRYPTION_TYPE;
         if (sessionKey->BoundCon != NULL && sessionKey->BoundCon != con)
             return WEAVE_ERROR_INVALID_USE_OF_SESSION_KEY;
-        outSessionState = WeaveSessionState(&sessionKey->MsgEncKey, sessionKey->AuthMode, &sessionKey->NextMsgId, &sessionKey->MaxRcvdMsgId, &sessionKey->RcvFlags);
+        outSessionState = WeaveSessionState(&sessionKey->MsgEncKey, sessionKey->AuthMode, &sessionKey->NextMsgId, &sessionKey->MaxRcvdMsgId, &sessionKey->RcvFlags,
+                                            sessionKey->RcvWindow, WeaveSessionState::kSessionKeyReceiveWindowWords);
         break;
 
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
@@ -953,9 +1334,10 @@ WEAVE_ERROR WeaveFabricState::GetSessionState(uint64_t remoteNodeId,
         WeaveAuthMode authMode = GroupKeyAuthMode(keyId);
 
         if (FindOrAllocPeerEntry(remoteNodeId, false, peerIndex))
-            outSessionState = WeaveSessionState(applicationKey, authMode, &NextGroupKeyMsgId, &PeerStates.MaxGroupKeyMsgIdRcvd[peerIndex], &PeerStates.GroupKeyRcvFlags[peerIndex]);
+            outSessionState = WeaveSessionState(applicationKey, authMode, &NextGroupKeyMsgId, &PeerStates.MaxGroupKeyMsgIdRcvd[peerIndex], &PeerStates.GroupKeyRcvFlags[peerIndex],
+                                                PeerStates.GroupKeyRcvWindow[peerIndex], WeaveSessionState::kGroupKeyReceiveWindowWords);
         else
-            outSessionState = WeaveSessionState(applicationKey, authMode, &NextGroupKeyMsgId, NULL, NULL);
+            outSessionState = WeaveSessionState(applicationKey, authMode, &NextGroupKeyMsgId, NULL, NULL, NULL, 0);
         break;
     }
 #endif
@@ -993,28 +1375,92 @@ IPAddress WeaveFabricState::SelectNodeAddress(uint64_t nodeId, uint16_t subnetId
 }
 
 /**
- * Returns an IPAddress containing a Weave ULA for a specified node.
- *
- * This variant uses the local node's default subnet.
- *
- * @param[in] nodeId            The Node ID number of the node in question.
+ * Returns an IPAddress containing a Weave ULA for a specified node.
+ *
+ * This variant uses the local node's default subnet.
+ *
+ * @param[in] nodeId            The Node ID number of the node in question.
+ *
+ * @retval IPAddress            An IPAddress object.
+ */
+IPAddress WeaveFabricState::SelectNodeAddress(uint64_t nodeId) const
+{
+    return WeaveFabricState::SelectNodeAddress(nodeId, DefaultSubnet);
+}
+
+/**
+ * Determines if an IP address represents an address of a node within the local Weave fabric.
+ */
+bool WeaveFabricState::IsFabricAddress(const IPAddress &addr) const
+{
+    if (FabricId != kFabricIdNotSpecified &&
+        addr.IsIPv6ULA() &&
+        addr.GlobalId() == WeaveFabricIdToIPv6GlobalId(FabricId))
+        return true;
+
+#if WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 0
+    uint8_t classification;
+    if (FabricPrefixes.Lookup(addr, classification))
+        return true;
+#endif
+
+    return false;
+}
+
+#if WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 0
+
+#if WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 128
+#error "WEAVE_CONFIG_MAX_FABRIC_PREFIXES must not exceed 128"
+#endif
+
+/**
+ * Registers an additional IPv6 prefix whose addresses are to be treated as fabric addresses.
+ *
+ * Gateways and border routers that serve more than one fabric, or that route on behalf of
+ * particular subnets, register those prefixes here.  The local fabric's own ULA prefix is always
+ * recognized and need not be added.
+ *
+ * @param[in] prefix            The prefix to add.
+ * @param[in] classification    An application-defined value returned by ClassifyAddress() for
+ *                              addresses whose longest matching prefix is \c prefix.
+ *
+ * @retval #WEAVE_NO_ERROR      On success.
+ * @retval #INET_ERROR_NO_MEMORY
+ *                              If WEAVE_CONFIG_MAX_FABRIC_PREFIXES prefixes are already registered.
+ */
+WEAVE_ERROR WeaveFabricState::AddFabricPrefix(const IPPrefix &prefix, uint8_t classification)
+{
+    return FabricPrefixes.Add(prefix, classification);
+}
+
+/**
+ * Removes a prefix previously registered with AddFabricPrefix().
  *
- * @retval IPAddress            An IPAddress object.
+ * @retval #WEAVE_NO_ERROR      On success.
+ * @retval #INET_ERROR_ADDRESS_NOT_FOUND
+ *                              If the prefix was not registered.
  */
-IPAddress WeaveFabricState::SelectNodeAddress(uint64_t nodeId) const
+WEAVE_ERROR WeaveFabricState::RemoveFabricPrefix(const IPPrefix &prefix)
 {
-    return WeaveFabricState::SelectNodeAddress(nodeId, DefaultSubnet);
+    return FabricPrefixes.Remove(prefix);
 }
 
 /**
- * Determines if an IP address represents an address of a node within the local Weave fabric.
+ * Finds the most specific registered fabric prefix that covers an IP address.
+ *
+ * The cost of the lookup is bounded by the prefix length, not by the number of registered prefixes.
+ *
+ * @param[in]  addr             The address to classify.
+ * @param[out] classification   The value registered with the longest matching prefix.
+ *
+ * @retval true                 If a registered prefix covers \c addr.
+ * @retval false                Otherwise, in which case \c classification is unchanged.
  */
-bool WeaveFabricState::IsFabricAddress(const IPAddress &addr) const
+bool WeaveFabricState::ClassifyAddress(const IPAddress &addr, uint8_t &classification) const
 {
-    return (FabricId != kFabricIdNotSpecified &&
-            addr.IsIPv6ULA() &&
-            addr.GlobalId() == WeaveFabricIdToIPv6GlobalId(FabricId));
+    return FabricPrefixes.Lookup(addr, classification);
 }
+#endif // WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 0
 
 /**
  * Determines if an IP address represents a Weave fabric address for the local node.
@@ -1054,6 +1500,7 @@ void WeaveFabricState::OnMsgCounterSyncRespRcvd(uint64_t peerNodeId, uint32_t pe
             // Initialize group key entry in the peer state table.
             PeerStates.GroupKeyRcvFlags[peerIndex] = WeaveSessionState::kReceiveFlags_MessageIdSynchronized;
             PeerStates.MaxGroupKeyMsgIdRcvd[peerIndex] = peerMsgId;
+            memset(PeerStates.GroupKeyRcvWindow[peerIndex], 0, sizeof(PeerStates.GroupKeyRcvWindow[peerIndex]));
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
             // Clear MsgCounterSyncReq flag for all pending messages to that peer.
@@ -1226,6 +1673,154 @@ exit:
 
 #endif // WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
 
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING && WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+
+/**
+ * Fold a round-trip time measurement into the estimate maintained for a peer node.
+ *
+ * The smoothed RTT and RTT variation are updated as described in RFC 6298. Callers should apply
+ * Karn's rule and only supply samples for messages that were acknowledged without being
+ * retransmitted.
+ *
+ * @param[in] peerNodeId        The node id of the peer.
+ * @param[in] rttSample         The measured round-trip time, in milliseconds.
+ */
+void WeaveFabricState::UpdatePeerRTTEstimate(uint64_t peerNodeId, uint32_t rttSample)
+{
+    PeerIndexType peerIndex;
+    uint32_t srtt, rttvar, delta;
+
+    // Samples are kept in 16 bits, and zero is reserved to mean that no estimate is available.
+    if (rttSample > UINT16_MAX)
+        rttSample = UINT16_MAX;
+    else if (rttSample == 0)
+        rttSample = 1;
+
+    FindOrAllocPeerEntry(peerNodeId, true, peerIndex);
+
+    srtt = PeerStates.SmoothedRTT[peerIndex];
+    rttvar = PeerStates.RTTVariance[peerIndex];
+
+    if (srtt == 0)
+    {
+        srtt = rttSample;
+        rttvar = rttSample / 2;
+    }
+    else
+    {
+        // RTTVAR <- 3/4 * RTTVAR + 1/4 * |SRTT - R|, then SRTT <- 7/8 * SRTT + 1/8 * R.
+        delta = (srtt > rttSample) ? srtt - rttSample : rttSample - srtt;
+        rttvar = (3 * rttvar + delta + 2) / 4;
+        srtt = (7 * srtt + rttSample + 4) / 8;
+        if (srtt == 0)
+            srtt = 1;
+    }
+
+    PeerStates.SmoothedRTT[peerIndex] = (uint16_t)srtt;
+    PeerStates.RTTVariance[peerIndex] = (uint16_t)rttvar;
+}
+
+/**
+ * Get the round-trip time estimate for a peer node.
+ *
+ * @param[in] peerNodeId        The node id of the peer.
+ * @param[out] smoothedRTT      The smoothed round-trip time, in milliseconds.
+ * @param[out] rttVariance      The round-trip time variation, in milliseconds.
+ *
+ * @return true if an estimate is available for the peer; false otherwise.
+ */
+bool WeaveFabricState::GetPeerRTTEstimate(uint64_t peerNodeId, uint32_t& smoothedRTT, uint32_t& rttVariance)
+{
+    PeerIndexType peerIndex;
+
+    if (!FindOrAllocPeerEntry(peerNodeId, false, peerIndex) || PeerStates.SmoothedRTT[peerIndex] == 0)
+        return false;
+
+    smoothedRTT = PeerStates.SmoothedRTT[peerIndex];
+    rttVariance = PeerStates.RTTVariance[peerIndex];
+    return true;
+}
+
+#endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING && WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+/**
+ * Find the CASE resumption ticket for a peer node.
+ *
+ * An expired ticket is removed from the cache and is not returned.
+ *
+ * @param[in] peerNodeId        The node id of the peer.
+ *
+ * @return A pointer to the ticket, or NULL if there is no unexpired ticket for the peer.
+ */
+const WeaveCASEResumptionTicket *WeaveFabricState::FindCASEResumptionTicket(uint64_t peerNodeId)
+{
+    for (int i = 0; i < WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE; i++)
+    {
+        WeaveCASEResumptionTicket *ticket = &CASEResumptionTickets[i];
+
+        if (ticket->PeerNodeId == kNodeIdNotSpecified)
+            break;
+
+        if (ticket->PeerNodeId == peerNodeId)
+        {
+            if (ticket->ExpiryTimeMS <= System::Layer::GetClock_MonotonicMS())
+            {
+                RemoveCASEResumptionTicket(peerNodeId);
+                break;
+            }
+
+            return ticket;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Cache a CASE resumption ticket, replacing any existing ticket for the same peer node.
+ *
+ * If the cache is full, the least recently cached ticket is discarded.
+ *
+ * @param[in] ticket            The ticket to be cached.
+ */
+void WeaveFabricState::CacheCASEResumptionTicket(const WeaveCASEResumptionTicket& ticket)
+{
+    RemoveCASEResumptionTicket(ticket.PeerNodeId);
+
+    ClearSecretData((uint8_t *)&CASEResumptionTickets[WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE - 1], sizeof(WeaveCASEResumptionTicket));
+    memmove(&CASEResumptionTickets[1], &CASEResumptionTickets[0],
+            (WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE - 1) * sizeof(WeaveCASEResumptionTicket));
+    CASEResumptionTickets[0] = ticket;
+}
+
+/**
+ * Remove the CASE resumption ticket, if any, for a peer node.
+ *
+ * @param[in] peerNodeId        The node id of the peer.
+ */
+void WeaveFabricState::RemoveCASEResumptionTicket(uint64_t peerNodeId)
+{
+    for (int i = 0; i < WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE; i++)
+    {
+        if (CASEResumptionTickets[i].PeerNodeId == kNodeIdNotSpecified)
+            break;
+
+        if (CASEResumptionTickets[i].PeerNodeId == peerNodeId)
+        {
+            // Close up the gap, keeping the remaining tickets in order.
+            memmove(&CASEResumptionTickets[i], &CASEResumptionTickets[i + 1],
+                    (WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE - 1 - i) * sizeof(WeaveCASEResumptionTicket));
+            ClearSecretData((uint8_t *)&CASEResumptionTickets[WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE - 1],
+                            sizeof(WeaveCASEResumptionTicket));
+            break;
+        }
+    }
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 /**
  * This method finds, allocates (optional), and returns index to the peer entry in the peer state table.
  *
@@ -1241,16 +1836,17 @@ exit:
  */
 bool WeaveFabricState::FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry, PeerIndexType& retPeerIndex)
 {
-    uint16_t i;
+    size_t pos;
     bool retVal = false;
 
     // Find peer entry in the peer state table.
-    for (i = 0; i < PeerCount; i++)
+    for (pos = HashNodeId(peerNodeId, kPeerIndexSize); PeerStates.Index[pos] != 0; pos = (pos + 1) % kPeerIndexSize)
     {
-        retPeerIndex = PeerStates.MostRecentlyUsedIndexes[i];
+        retPeerIndex = PeerStates.Index[pos] - 1;
         if (PeerStates.NodeId[retPeerIndex] == peerNodeId)
         {
             retVal = true;
+            UnlinkPeerEntry(retPeerIndex);
             break;
         }
     }
@@ -1265,33 +1861,33 @@ bool WeaveFabricState::FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry
         if (PeerCount == WEAVE_CONFIG_MAX_PEER_NODES)
         {
             // Choose the least recently used peer entry by default.
-            i = WEAVE_CONFIG_MAX_PEER_NODES - 1;
+            retPeerIndex = PeerStates.LeastRecentlyUsed;
 
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
             // Try to find the least recently used peer entry that didn't use encryption.
-            for (int j = WEAVE_CONFIG_MAX_PEER_NODES - 1; j >= 0; j--)
+            for (PeerIndexType peerInd = PeerStates.LeastRecentlyUsed; peerInd != kPeerIndex_None;
+                 peerInd = PeerStates.MoreRecentlyUsed[peerInd])
             {
-                PeerIndexType peerInd = PeerStates.MostRecentlyUsedIndexes[j];
                 if ((PeerStates.GroupKeyRcvFlags[peerInd] & WeaveSessionState::kReceiveFlags_MessageIdSynchronized) == 0)
                 {
-                    i = j;
+                    retPeerIndex = peerInd;
                     break;
                 }
             }
 #endif
 
-            // The peer index chosen for replacement.
-            retPeerIndex = PeerStates.MostRecentlyUsedIndexes[i];
+            // Discard the entry chosen for replacement.
+            RemovePeerFromIndex(retPeerIndex);
+            UnlinkPeerEntry(retPeerIndex);
         }
 
-        // If PeerStates table is not full then the next available entry is "i".
+        // If PeerStates table is not full then the next available entry is used.
         // Entries in the table are allocated sequentially and never discarded until
         // the table is full. Only when table is full the least recently used entry
         // is discarded and replaced with the new entry.
         else
         {
-            PeerCount++;
-            retPeerIndex = i;
+            retPeerIndex = PeerCount++;
         }
 
         PeerStates.NodeId[retPeerIndex] = peerNodeId;
@@ -1301,21 +1897,85 @@ bool WeaveFabricState::FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry
         PeerStates.GroupKeyRcvFlags[retPeerIndex] = 0;
 #endif
         PeerStates.UnencRcvFlags[retPeerIndex] = 0;
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING && WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+        PeerStates.SmoothedRTT[retPeerIndex] = 0;
+        PeerStates.RTTVariance[retPeerIndex] = 0;
+#endif
+        AddPeerToIndex(retPeerIndex);
         retVal = true;
     }
 
-    // Move the requested entry to the top of the most recently used indexes list.
+    // Move the requested entry to the top of the most recently used list.
     if (retVal)
     {
-        memmove(&PeerStates.MostRecentlyUsedIndexes[1],
-                &PeerStates.MostRecentlyUsedIndexes[0],
-                i * sizeof(PeerIndexType));
-        PeerStates.MostRecentlyUsedIndexes[0] = retPeerIndex;
+        LinkPeerEntryAsMostRecentlyUsed(retPeerIndex);
     }
 
     return retVal;
 }
 
+void WeaveFabricState::ResetPeerStates(void)
+{
+    PeerCount = 0;
+    memset(&PeerStates, 0, sizeof(PeerStates));
+    PeerStates.MostRecentlyUsed = kPeerIndex_None;
+    PeerStates.LeastRecentlyUsed = kPeerIndex_None;
+}
+
+void WeaveFabricState::AddPeerToIndex(PeerIndexType peerIndex)
+{
+    size_t pos = HashNodeId(PeerStates.NodeId[peerIndex], kPeerIndexSize);
+
+    while (PeerStates.Index[pos] != 0)
+        pos = (pos + 1) % kPeerIndexSize;
+
+    PeerStates.Index[pos] = peerIndex + 1;
+}
+
+void WeaveFabricState::RemovePeerFromIndex(PeerIndexType peerIndex)
+{
+    const PeerIndexHome home = { PeerStates.NodeId, kPeerIndexSize };
+    size_t pos = HashNodeId(PeerStates.NodeId[peerIndex], kPeerIndexSize);
+
+    for (; PeerStates.Index[pos] != 0; pos = (pos + 1) % kPeerIndexSize)
+    {
+        if (PeerStates.Index[pos] == peerIndex + 1)
+        {
+            RemoveHashIndexEntry(PeerStates.Index, kPeerIndexSize, pos, home);
+            break;
+        }
+    }
+}
+
+void WeaveFabricState::UnlinkPeerEntry(PeerIndexType peerIndex)
+{
+    PeerIndexType moreRecent = PeerStates.MoreRecentlyUsed[peerIndex];
+    PeerIndexType lessRecent = PeerStates.LessRecentlyUsed[peerIndex];
+
+    if (moreRecent != kPeerIndex_None)
+        PeerStates.LessRecentlyUsed[moreRecent] = lessRecent;
+    else
+        PeerStates.MostRecentlyUsed = lessRecent;
+
+    if (lessRecent != kPeerIndex_None)
+        PeerStates.MoreRecentlyUsed[lessRecent] = moreRecent;
+    else
+        PeerStates.LeastRecentlyUsed = moreRecent;
+}
+
+void WeaveFabricState::LinkPeerEntryAsMostRecentlyUsed(PeerIndexType peerIndex)
+{
+    PeerStates.MoreRecentlyUsed[peerIndex] = kPeerIndex_None;
+    PeerStates.LessRecentlyUsed[peerIndex] = PeerStates.MostRecentlyUsed;
+
+    if (PeerStates.MostRecentlyUsed != kPeerIndex_None)
+        PeerStates.MoreRecentlyUsed[PeerStates.MostRecentlyUsed] = peerIndex;
+    else
+        PeerStates.LeastRecentlyUsed = peerIndex;
+
+    PeerStates.MostRecentlyUsed = peerIndex;
+}
+
 /*
  * This method is used by provisioning servers to register callbacks with the
  * WeaveFabricState to be notified when the current session is closed.
@@ -1454,6 +2114,15 @@ void WeaveFabricState::ClearFabricState()
     FabricId = kFabricIdNotSpecified;
     GroupKeyStore->Clear();
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // Sessions with the nodes of the old fabric must not be resumed.
+    ClearSecretData((uint8_t *)CASEResumptionTickets, sizeof(CASEResumptionTickets));
+#endif
+
+#if WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 0
+    FabricPrefixes.Clear();
+#endif
+
     if (oldFabricId != kFabricIdNotSpecified)
     {
         if (Delegate != NULL)
@@ -1677,16 +2346,21 @@ WeaveSessionState::WeaveSessionState(void)
     NextMsgId = NULL;
     MaxMsgIdRcvd = NULL;
     RcvFlags = NULL;
+    RcvWindow = NULL;
+    RcvWindowWords = 0;
 }
 
 WeaveSessionState::WeaveSessionState(WeaveMsgEncryptionKey *msgEncKey, WeaveAuthMode authMode,
-                                     MonotonicallyIncreasingCounter *nextMsgId, uint32_t *maxMsgIdRcvd, ReceiveFlagsType *rcvFlags)
+                                     MonotonicallyIncreasingCounter *nextMsgId, uint32_t *maxMsgIdRcvd, ReceiveFlagsType *rcvFlags,
+                                     ReceiveWindowWordType *rcvWindow, uint8_t rcvWindowWords)
 {
     MsgEncKey = msgEncKey;
     AuthMode = authMode;
     NextMsgId = nextMsgId;
     MaxMsgIdRcvd = maxMsgIdRcvd;
     RcvFlags = rcvFlags;
+    RcvWindow = rcvWindow;
+    RcvWindowWords = rcvWindowWords;
 }
 
 uint32_t WeaveSessionState::NewMessageId(void)
@@ -1707,20 +2381,21 @@ bool WeaveSessionState::IsDuplicateMessage(uint32_t msgId)
 {
     bool isDup = false;
     int32_t delta;
-    ReceiveFlagsType msgIdFlags;
+    uint32_t windowSize;
 
-    // This algorithm relies on two values to determine whether a message has been received before:
+    // This algorithm relies on three values to determine whether a message has been received before:
     //
     //    *MaxMsgIdRcvd is the maximum message id received from from the peer node.
     //
-    //    *RcvFlags is a set of flags describing the history of message reception from the peer.
-    //
-    //        The top-most bit in *RcvFlags indicates whether any messages have ever been received from the peer.
+    //    *RcvFlags is a set of flags describing the history of message reception from the peer. The
+    //        kReceiveFlags_MessageIdSynchronized flag indicates whether any messages have ever been received
+    //        from the peer.
     //
-    //            The remaining bits represent individual message ids that have been received prior to the
-    //        message identified by *MaxMsgIdRcvd.  Specifically, bit 0 represents the message immediately
-    //        prior to the max id message (i.e. *MaxMsgIdRcvd - 1), bit 1 represents the message immediately
-    //        prior to that message, and so on.
+    //    RcvWindow is a bitmap of RcvWindowWords words whose bits represent individual message ids that have
+    //        been received prior to the message identified by *MaxMsgIdRcvd.  Specifically, bit 0 of word 0
+    //        represents the message immediately prior to the max id message (i.e. *MaxMsgIdRcvd - 1), bit 1
+    //        represents the message immediately prior to that message, and so on, continuing with bit 0 of
+    //        word 1 after bit 31 of word 0.
 
     // If message Id is not synchronized.
     if (MessageIdNotSynchronized())
@@ -1748,12 +2423,12 @@ bool WeaveSessionState::IsDuplicateMessage(uint32_t msgId)
         {
             *RcvFlags = kReceiveFlags_MessageIdSynchronized;
             *MaxMsgIdRcvd = msgId;
+            memset(RcvWindow, 0, RcvWindowWords * sizeof(ReceiveWindowWordType));
             ExitNow();
         }
     }
 
-    // Extract the message id flags from the receive flags field.
-    msgIdFlags = (*RcvFlags) & kReceiveFlags_MessageIdFlagsMask;
+    windowSize = RcvWindowWords * kReceiveWindowWordBits;
 
     // Determine the difference between the id of the newly received message (msgId) and the maximum message
     // id received so far (*MaxMsgIdRcvd).
@@ -1773,12 +2448,11 @@ bool WeaveSessionState::IsDuplicateMessage(uint32_t msgId)
     // If the new message was sent after the max id message...
     if (delta > 0)
     {
-        // Shift the message received flags by the delta (or simply set the flags to zero if the delta is larger
-        // than the number of flags).
-        if (delta < kReceiveFlags_NumMessageIdFlags)
-            msgIdFlags = ((msgIdFlags << 1) | 1) << (delta - 1);
-        else
-            msgIdFlags = 0;
+        // Slide the window forward by the delta, and record the previous max id message, if it is still
+        // within the window.
+        ShiftReceiveWindow((uint32_t) delta);
+        if ((uint32_t) delta <= windowSize)
+            RcvWindow[(delta - 1) / kReceiveWindowWordBits] |= ((ReceiveWindowWordType) 1) << ((delta - 1) % kReceiveWindowWordBits);
 
         // Update the max received message id.
         *MaxMsgIdRcvd = msgId;
@@ -1794,19 +2468,20 @@ bool WeaveSessionState::IsDuplicateMessage(uint32_t msgId)
         // Make the delta positive.
         delta = -delta;
 
-        // If the delta is within the range of the message id flags, form the appropriate mask
-        // and check if the message has already been received. If not, set the corresponding flag.
-        if (delta <= kReceiveFlags_NumMessageIdFlags)
+        // If the delta is within the range of the window, check if the message has already been received.
+        // If not, set the corresponding flag.
+        if ((uint32_t) delta <= windowSize)
         {
-            ReceiveFlagsType mask = 1 << (delta - 1);
-            if ((msgIdFlags & mask) == 0)
-                msgIdFlags |= mask;
+            ReceiveWindowWordType &word = RcvWindow[(delta - 1) / kReceiveWindowWordBits];
+            ReceiveWindowWordType mask = ((ReceiveWindowWordType) 1) << ((delta - 1) % kReceiveWindowWordBits);
+            if ((word & mask) == 0)
+                word |= mask;
             else {
                 ExitNow(isDup = true);
             }
         }
 
-        // If the delta is greater than the range of the message id flags...
+        // If the delta is greater than the range of the window...
         else
         {
             // If the message was encrypted then assume the message is a duplicate.
@@ -1821,19 +2496,46 @@ bool WeaveSessionState::IsDuplicateMessage(uint32_t msgId)
             // in the network layer, we allow message ids for unencrypted messages from the same peer to go backwards.
             else
             {
-                msgIdFlags = 0;
+                memset(RcvWindow, 0, RcvWindowWords * sizeof(ReceiveWindowWordType));
                 *MaxMsgIdRcvd = msgId;
             }
         }
     }
 
-    // Update the message id flags within the receive flags value and set the MessageIdIsSynchronized flag.
-    *RcvFlags = kReceiveFlags_MessageIdSynchronized | msgIdFlags | (*RcvFlags & ~kReceiveFlags_MessageIdFlagsMask);
-
 exit:
     return isDup;
 }
 
+/**
+ * Slide the message received window towards older message ids by the given number of bits,
+ * a word at a time, discarding the bits that fall off the end.
+ */
+void WeaveSessionState::ShiftReceiveWindow(uint32_t shift)
+{
+    const uint32_t wordShift = shift / kReceiveWindowWordBits;
+    const uint32_t bitShift = shift % kReceiveWindowWordBits;
+
+    if (wordShift >= RcvWindowWords)
+    {
+        memset(RcvWindow, 0, RcvWindowWords * sizeof(ReceiveWindowWordType));
+        return;
+    }
+
+    for (int i = RcvWindowWords - 1; i >= 0; i--)
+    {
+        ReceiveWindowWordType word = 0;
+
+        if ((uint32_t) i >= wordShift)
+        {
+            word = RcvWindow[i - wordShift] << bitShift;
+            if (bitShift != 0 && (uint32_t) i > wordShift)
+                word |= RcvWindow[i - wordShift - 1] >> (kReceiveWindowWordBits - bitShift);
+        }
+
+        RcvWindow[i] = word;
+    }
+}
+
 /**
  * This method finds session key entry.
  *
@@ -1852,8 +2554,7 @@ exit:
  */
 WEAVE_ERROR WeaveFabricState::FindSessionKey(uint16_t keyId, uint64_t peerNodeId, bool create, WeaveSessionKey *& retRec)
 {
-    WeaveSessionKey *curRec = SessionKeys;
-    WeaveSessionKey *freeRec = NULL;
+    WeaveSessionKey *curRec;
 
     if (!WeaveKeyId::IsSessionKey(keyId))
         return WEAVE_ERROR_WRONG_KEY_TYPE;
@@ -1861,16 +2562,14 @@ WEAVE_ERROR WeaveFabricState::FindSessionKey(uint16_t keyId, uint64_t peerNodeId
     if (peerNodeId == kNodeIdNotSpecified || peerNodeId == kAnyNodeId)
         return WEAVE_ERROR_INVALID_ARGUMENT;
 
-    for (int i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++, curRec++)
+    // Search the keys with the given key id. The index is keyed on key id alone because a shared session
+    // can also be found by the id of any of its end nodes.
+    for (size_t pos = HashKeyId(keyId, kSessionKeyIndexSize); SessionKeyIndex[pos] != 0; pos = (pos + 1) % kSessionKeyIndexSize)
     {
-        if (!curRec->IsAllocated())
-        {
-            if (freeRec == NULL)
-                freeRec = curRec;
-        }
-        else if (curRec->MsgEncKey.KeyId == keyId &&
-                 (curRec->NodeId == peerNodeId ||
-                  (curRec->IsSharedSession() && FindSharedSessionEndNode(peerNodeId, curRec))))
+        curRec = &SessionKeys[SessionKeyIndex[pos] - 1];
+        if (curRec->MsgEncKey.KeyId == keyId &&
+            (curRec->NodeId == peerNodeId ||
+             (curRec->IsSharedSession() && FindSharedSessionEndNode(peerNodeId, curRec))))
         {
             retRec = curRec;
             return WEAVE_NO_ERROR;
@@ -1880,12 +2579,43 @@ WEAVE_ERROR WeaveFabricState::FindSessionKey(uint16_t keyId, uint64_t peerNodeId
     if (!create)
         return WEAVE_ERROR_KEY_NOT_FOUND;
 
-    if (freeRec == NULL)
-        return WEAVE_ERROR_TOO_MANY_KEYS;
+    curRec = SessionKeys;
+    for (int i = 0; i < WEAVE_CONFIG_MAX_SESSION_KEYS; i++, curRec++)
+    {
+        if (!curRec->IsAllocated())
+        {
+            retRec = curRec;
+            return WEAVE_NO_ERROR;
+        }
+    }
+
+    return WEAVE_ERROR_TOO_MANY_KEYS;
+}
+
+void WeaveFabricState::AddSessionKeyToIndex(WeaveSessionKey *sessionKey)
+{
+    size_t pos = HashKeyId(sessionKey->MsgEncKey.KeyId, kSessionKeyIndexSize);
 
-    retRec = freeRec;
+    while (SessionKeyIndex[pos] != 0)
+        pos = (pos + 1) % kSessionKeyIndexSize;
 
-    return WEAVE_NO_ERROR;
+    SessionKeyIndex[pos] = (uint16_t)(sessionKey - SessionKeys) + 1;
+}
+
+void WeaveFabricState::RemoveSessionKeyFromIndex(WeaveSessionKey *sessionKey)
+{
+    const SessionKeyIndexHome home = { SessionKeys, kSessionKeyIndexSize };
+    const uint16_t entry = (uint16_t)(sessionKey - SessionKeys) + 1;
+    size_t pos = HashKeyId(sessionKey->MsgEncKey.KeyId, kSessionKeyIndexSize);
+
+    for (; SessionKeyIndex[pos] != 0; pos = (pos + 1) % kSessionKeyIndexSize)
+    {
+        if (SessionKeyIndex[pos] == entry)
+        {
+            RemoveHashIndexEntry(SessionKeyIndex, kSessionKeyIndexSize, pos, home);
+            break;
+        }
+    }
 }
 
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
@@ -1904,6 +2634,26 @@ WEAVE_ERROR WeaveFabricState::FindMsgEncAppKey(uint16_t keyId, uint8_t encType,
         err = DeriveMsgEncAppKey(keyId, encType, *retRec, appGroupGlobalId);
         SuccessOrExit(err);
 
+        AppKeyCache.AddKeyEntry(retRec);
+
+#if WEAVE_CONFIG_PREDERIVE_NEXT_MSG_ENC_APP_KEYS
+        // Derive the key that will replace this one at the next epoch key rotation, if there is room for it.
+        if (WeaveKeyId::IsAppRotatingKey(keyId))
+        {
+            uint32_t nextKeyId;
+
+            if (GroupKeyStore->GetNextAppKeyId(keyId, nextKeyId) == WEAVE_NO_ERROR &&
+                AppKeyCache.FindKeyEntry((uint16_t)nextKeyId, encType) == NULL)
+            {
+                WeaveMsgEncryptionKey *nextRec = AppKeyCache.AllocateFreeKeyEntry();
+                uint32_t nextAppGroupGlobalId;
+
+                if (nextRec != NULL && DeriveMsgEncAppKey(nextKeyId, encType, *nextRec, nextAppGroupGlobalId) == WEAVE_NO_ERROR)
+                    AppKeyCache.AddKeyEntry(nextRec);
+            }
+        }
+#endif // WEAVE_CONFIG_PREDERIVE_NEXT_MSG_ENC_APP_KEYS
+
 #if WEAVE_CONFIG_SECURITY_TEST_MODE && WEAVE_DETAIL_LOGGING
         if (LogKeys)
         {
@@ -1957,7 +2707,7 @@ WEAVE_ERROR WeaveFabricState::DeriveMsgEncAppKey(uint32_t keyId, uint8_t encType
     keyDiversifier[sizeof(kWeaveMsgEncAppKeyDiversifier)] = encType;
 
     // Derive application key data.
-    err = GroupKeyStore->DeriveApplicationKey(keyId, NULL, 0, keyDiversifier, kWeaveMsgEncAppKeyDiversifierSize,
+    err = GroupKeyStore->DeriveApplicationKey(keyId, AppKeyCache.GetSaltKeySchedule(), keyDiversifier, kWeaveMsgEncAppKeyDiversifierSize,
                                               keyData, sizeof(keyData), WeaveEncryptionKey_AES128CTRSHA1::KeySize,
                                               appGroupGlobalId);
     SuccessOrExit(err);
@@ -1973,6 +2723,9 @@ WEAVE_ERROR WeaveFabricState::DeriveMsgEncAppKey(uint32_t keyId, uint8_t encType
     // Set key parameters.
     appKey.KeyId = keyId;
     appKey.EncType = encType;
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    appKey.ClearKeySchedule();
+#endif
 
 exit:
     ClearSecretData(keyData, sizeof(keyData));
@@ -2040,18 +2793,23 @@ bool WeaveFabricState::RemoveIdleSessionKeys()
 void WeaveMsgEncryptionKeyCache::Init()
 {
     Reset();
+    mSaltKeySchedule.SetKey(NULL, 0);
 }
 
 void WeaveMsgEncryptionKeyCache::Shutdown()
 {
     Reset();
+    mSaltKeySchedule.Reset();
 }
 
 void WeaveMsgEncryptionKeyCache::Reset()
 {
     for (uint8_t keyEntry = 0; keyEntry < WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS; keyEntry++)
+    {
         Clear(keyEntry);
-    memset(mMostRecentlyUsedKeyEntries, 0, sizeof(mMostRecentlyUsedKeyEntries));
+        mMostRecentlyUsedKeyEntries[keyEntry] = keyEntry;
+    }
+    memset(mKeyIndex, 0, sizeof(mKeyIndex));
 }
 
 // Clear key cache entry.
@@ -2062,50 +2820,163 @@ void WeaveMsgEncryptionKeyCache::Clear(uint8_t keyEntryIndex)
     mKeyCache[keyEntryIndex].EncType = kWeaveEncryptionType_None;
 }
 
-// If the key is found in the cache then function returns pointer to the key.
-// If the key is not found in the cache then function allocates and returns pointer to the empty key entry in the cache.
-WeaveMsgEncryptionKey *WeaveMsgEncryptionKeyCache::FindOrAllocateKeyEntry(uint16_t keyId, uint8_t encType)
+// Move key entry to the top (most-recently used) or to the bottom (least-recently used) of the most-recently
+// used key entries list.
+void WeaveMsgEncryptionKeyCache::MoveKeyEntry(uint8_t keyEntryIndex, bool mostRecentlyUsed)
 {
-    WeaveMsgEncryptionKey *keyEntry;
-    uint8_t retKeyEntryIndex = WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS;
     uint8_t i;
 
-    // Find if key is in the cache.
-    for (i = 0, keyEntry = mKeyCache; i < WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS; i++, keyEntry++)
+    // Find key entry index in the most-recently used list of entries.
+    for (i = 0; i < WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS; i++)
+        if (mMostRecentlyUsedKeyEntries[i] == keyEntryIndex)
+            break;
+
+    if (mostRecentlyUsed)
     {
-        if (keyEntry->KeyId == keyId && keyEntry->EncType == encType)
+        memmove(&mMostRecentlyUsedKeyEntries[1], &mMostRecentlyUsedKeyEntries[0], i * sizeof(uint8_t));
+        mMostRecentlyUsedKeyEntries[0] = keyEntryIndex;
+    }
+    else
+    {
+        memmove(&mMostRecentlyUsedKeyEntries[i], &mMostRecentlyUsedKeyEntries[i + 1],
+                (WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS - 1 - i) * sizeof(uint8_t));
+        mMostRecentlyUsedKeyEntries[WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS - 1] = keyEntryIndex;
+    }
+}
+
+// Remove key entry from the key index and clear it.
+void WeaveMsgEncryptionKeyCache::RemoveKeyEntry(uint8_t keyEntryIndex)
+{
+    const AppKeyIndexHome home = { mKeyCache, kKeyIndexSize };
+    const uint8_t entry = keyEntryIndex + 1;
+    size_t pos = HashKeyId(mKeyCache[keyEntryIndex].KeyId, kKeyIndexSize);
+
+    for (; mKeyIndex[pos] != 0; pos = (pos + 1) % kKeyIndexSize)
+    {
+        if (mKeyIndex[pos] == entry)
         {
-            retKeyEntryIndex = i;
+            RemoveHashIndexEntry(mKeyIndex, kKeyIndexSize, pos, home);
             break;
         }
-        else if (retKeyEntryIndex == WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS && keyEntry->KeyId == WeaveKeyId::kNone)
-        {
-            retKeyEntryIndex = i;
-        }
     }
 
-    // If cache is full and specified key was not found in the cache then replace the least-recently used key entry.
-    if (retKeyEntryIndex == WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS)
+    Clear(keyEntryIndex);
+}
+
+// Returns pointer to the key if it is found in the cache, or NULL otherwise.  The recently used order of the
+// cached keys is not changed.
+WeaveMsgEncryptionKey *WeaveMsgEncryptionKeyCache::FindKeyEntry(uint16_t keyId, uint8_t encType) const
+{
+    for (size_t pos = HashKeyId(keyId, kKeyIndexSize); mKeyIndex[pos] != 0; pos = (pos + 1) % kKeyIndexSize)
     {
-        // Chose the least-recently used entry in the key cache.
-        retKeyEntryIndex = mMostRecentlyUsedKeyEntries[WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS - 1];
+        const WeaveMsgEncryptionKey *keyEntry = &mKeyCache[mKeyIndex[pos] - 1];
 
-        // Clear replaced key cache entry.
-        Clear(retKeyEntryIndex);
+        if (keyEntry->KeyId == keyId && keyEntry->EncType == encType)
+            return const_cast<WeaveMsgEncryptionKey *>(keyEntry);
     }
 
-    // Find key entry index in the most-recently used list of entries.
-    for (i = 0; i < WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS; i++)
-        if (mMostRecentlyUsedKeyEntries[i] == retKeyEntryIndex)
-            break;
+    return NULL;
+}
 
-    // Mark selected key entry as most-recently used by moving it to the top of the most-recently used key entries list.
-    memmove(&mMostRecentlyUsedKeyEntries[1], &mMostRecentlyUsedKeyEntries[0], i * sizeof(uint8_t));
-    mMostRecentlyUsedKeyEntries[0] = retKeyEntryIndex;
+// If the key is found in the cache then function returns pointer to the key.
+// If the key is not found in the cache then function allocates and returns pointer to the empty key entry in the cache.
+WeaveMsgEncryptionKey *WeaveMsgEncryptionKeyCache::FindOrAllocateKeyEntry(uint16_t keyId, uint8_t encType)
+{
+    WeaveMsgEncryptionKey *keyEntry = FindKeyEntry(keyId, encType);
+    uint8_t retKeyEntryIndex;
+
+    if (keyEntry != NULL)
+        retKeyEntryIndex = (uint8_t)(keyEntry - mKeyCache);
+    else
+    {
+        // Find an empty entry in the cache.
+        for (retKeyEntryIndex = 0; retKeyEntryIndex < WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS; retKeyEntryIndex++)
+            if (mKeyCache[retKeyEntryIndex].KeyId == WeaveKeyId::kNone)
+                break;
+
+        // If cache is full then replace the least-recently used key entry.
+        if (retKeyEntryIndex == WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS)
+        {
+            retKeyEntryIndex = mMostRecentlyUsedKeyEntries[WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS - 1];
+            RemoveKeyEntry(retKeyEntryIndex);
+        }
+    }
+
+    // Mark selected key entry as most-recently used.
+    MoveKeyEntry(retKeyEntryIndex, true);
 
     return &mKeyCache[retKeyEntryIndex];
 }
 
+// Returns pointer to an empty key entry, or NULL if the cache is full.  The entry is marked as least-recently used,
+// so that a key derived into it before it is needed is the first to be replaced if it is never used.
+WeaveMsgEncryptionKey *WeaveMsgEncryptionKeyCache::AllocateFreeKeyEntry(void)
+{
+    for (uint8_t i = 0; i < WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS; i++)
+        if (mKeyCache[i].KeyId == WeaveKeyId::kNone)
+        {
+            MoveKeyEntry(i, false);
+            return &mKeyCache[i];
+        }
+
+    return NULL;
+}
+
+// Add a key entry, whose key has been derived, to the key index.
+void WeaveMsgEncryptionKeyCache::AddKeyEntry(WeaveMsgEncryptionKey *keyEntry)
+{
+    size_t pos = HashKeyId(keyEntry->KeyId, kKeyIndexSize);
+
+    while (mKeyIndex[pos] != 0)
+        pos = (pos + 1) % kKeyIndexSize;
+
+    mKeyIndex[pos] = (uint8_t)(keyEntry - mKeyCache) + 1;
+}
+
+/**
+ * Get the amount of key material used by a message encryption type.
+ *
+ * @param[in]    encType            The message encryption type.
+ *
+ * @return The key size in bytes, or 0 if the encryption type is not supported for session keys.
+ */
+uint16_t WeaveEncryptionKeySize(uint8_t encType)
+{
+    switch (encType)
+    {
+    case kWeaveEncryptionType_AES128CTRSHA1:
+        return WeaveEncryptionKey_AES128CTRSHA1::KeySize;
+    case kWeaveEncryptionType_AES128CCM:
+        return WeaveEncryptionKey_AES128CCM::KeySize;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * Initialize a message encryption key from derived key material.
+ *
+ * The key material is split into the keys used by the given encryption type in order; e.g. for
+ * AES128CTRSHA1, the data key followed by the integrity key.
+ *
+ * @param[in]    encType            A message encryption type for which WeaveEncryptionKeySize() is non-zero.
+ * @param[in]    keyData            WeaveEncryptionKeySize(encType) bytes of key material.
+ * @param[out]   key                The key to be initialized.
+ */
+void WeaveEncryptionKeyFromBytes(uint8_t encType, const uint8_t *keyData, WeaveEncryptionKey& key)
+{
+    switch (encType)
+    {
+    case kWeaveEncryptionType_AES128CTRSHA1:
+        memcpy(key.AES128CTRSHA1.DataKey, keyData, WeaveEncryptionKey_AES128CTRSHA1::DataKeySize);
+        memcpy(key.AES128CTRSHA1.IntegrityKey, keyData + WeaveEncryptionKey_AES128CTRSHA1::DataKeySize,
+               WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+        break;
+    case kWeaveEncryptionType_AES128CCM:
+        memcpy(key.AES128CCM.DataKey, keyData, WeaveEncryptionKey_AES128CCM::DataKeySize);
+        break;
+    }
+}
 
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
 
@@ -2132,6 +3003,11 @@ void WeaveEncryptionKeyToString(uint8_t encType, const WeaveEncryptionKey& key,
         *buf++ = ',';
         ToHexString(key.AES128CTRSHA1.IntegrityKey, sizeof(key.AES128CTRSHA1.IntegrityKey), buf, bufSize);
     }
+    else if (encType == kWeaveEncryptionType_AES128CCM)
+    {
+        bufSize -= 1; // Reserve size for the null terminator.
+        ToHexString(key.AES128CCM.DataKey, sizeof(key.AES128CCM.DataKey), buf, bufSize);
+    }
 
     *buf = 0;
 }
@@ -49,6 +49,17 @@
 #include <Weave/Profiles/security/WeaveSecurity.h>
 #include <Weave/Profiles/security/WeaveApplicationKeys.h>
 
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+#include <Weave/Support/crypto/WeaveCrypto.h>
+#include <Weave/Support/crypto/HMAC.h>
+#include <Weave/Support/crypto/CTRMode.h>
+#include <Weave/Support/crypto/CCMMode.h>
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
+#if WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 0
+#include <InetLayer/IPPrefixTrie.h>
+#endif
+
 namespace nl {
 namespace Weave {
 
@@ -281,12 +292,45 @@ public:
     uint8_t IntegrityKey[IntegrityKeySize];
 };
 
+// Encryption key for the AES-128-CCM message encryption type
+class WeaveEncryptionKey_AES128CCM
+{
+public:
+    enum
+    {
+        DataKeySize                                     = 16,
+        KeySize                                         = DataKeySize
+    };
+
+    uint8_t DataKey[DataKeySize];
+};
+
 // Represents a key or key set used to encrypt Weave messages.
 typedef union WeaveEncryptionKey
 {
     WeaveEncryptionKey_AES128CTRSHA1 AES128CTRSHA1;
+    WeaveEncryptionKey_AES128CCM AES128CCM;
 } WeaveEncryptionKey;
 
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
+// Expanded cipher state for an AES-128-CTR-SHA-1 message encryption key.
+class WeaveEncryptionKeySchedule_AES128CTRSHA1
+{
+public:
+    nl::Weave::Crypto::AES128CTRMode DataKeySchedule;             // AES-128 round keys, plus the per-message counter.
+    nl::Weave::Crypto::HMACSHA1KeySchedule IntegrityKeySchedule;  // HMAC-SHA-1 inner and outer pad states.
+};
+
+// Expanded cipher state for an AES-128-CCM message encryption key.
+class WeaveEncryptionKeySchedule_AES128CCM
+{
+public:
+    nl::Weave::Crypto::AES128CCMMode DataKeySchedule;             // AES-128 round keys.
+};
+
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+
 // AES128CTRSHA1 encryption and integrity test keys, which should only be used for testing purposes.
 enum
 {
@@ -307,6 +351,18 @@ public:
     uint16_t KeyId;                                     /**< The key ID. */
     uint8_t EncType;                                    /**< The encryption type supported by the key. */
     WeaveEncryptionKey EncKey;                          /**< The secret key material. */
+
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    uint8_t KeyScheduleEncType;                         /**< The encryption type for which KeySchedule has been computed,
+                                                             or kWeaveEncryptionType_None if it has not been computed. */
+    WeaveEncryptionKeySchedule_AES128CTRSHA1 KeySchedule; /**< Expanded cipher state derived from EncKey. */
+    WeaveEncryptionKeySchedule_AES128CCM KeySchedule_AES128CCM; /**< Expanded cipher state derived from EncKey,
+                                                                     for AES128CCM keys. */
+
+    WeaveEncryptionKeySchedule_AES128CTRSHA1 &GetKeySchedule_AES128CTRSHA1(void);
+    WeaveEncryptionKeySchedule_AES128CCM &GetKeySchedule_AES128CCM(void);
+    void ClearKeySchedule(void);
+#endif // WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
 };
 
 /**
@@ -320,17 +376,23 @@ class WeaveSessionState
 public:
 
     typedef uint16_t ReceiveFlagsType;
+    typedef uint32_t ReceiveWindowWordType;
 
     enum
     {
-        kReceiveFlags_NumMessageIdFlags                 = (sizeof(ReceiveFlagsType) * 8) - 1,
-        kReceiveFlags_MessageIdSynchronized             = (1 << kReceiveFlags_NumMessageIdFlags),
-        kReceiveFlags_MessageIdFlagsMask                = ~kReceiveFlags_MessageIdSynchronized
+        kReceiveFlags_MessageIdSynchronized             = 0x8000,
+        kReceiveFlags_LegacyMessageIdFlagsMask          = 0x7FFF,   // Message id flags formerly kept in the receive flags.
+
+        kReceiveWindowWordBits                          = sizeof(ReceiveWindowWordType) * 8,
+        kSessionKeyReceiveWindowWords                   = WEAVE_CONFIG_SESSION_KEY_RCV_WINDOW_SIZE / kReceiveWindowWordBits,
+        kGroupKeyReceiveWindowWords                     = WEAVE_CONFIG_GROUP_KEY_RCV_WINDOW_SIZE / kReceiveWindowWordBits,
+        kUnencryptedReceiveWindowWords                  = WEAVE_CONFIG_UNENCRYPTED_RCV_WINDOW_SIZE / kReceiveWindowWordBits
     };
 
     WeaveSessionState(void);
     WeaveSessionState(WeaveMsgEncryptionKey *msgEncKey, WeaveAuthMode authMode,
-                      MonotonicallyIncreasingCounter *nextMsgId, uint32_t *maxRcvdMsgId, ReceiveFlagsType *rcvFlags);
+                      MonotonicallyIncreasingCounter *nextMsgId, uint32_t *maxRcvdMsgId, ReceiveFlagsType *rcvFlags,
+                      ReceiveWindowWordType *rcvWindow, uint8_t rcvWindowWords);
 
     WeaveMsgEncryptionKey *MsgEncKey;
     WeaveAuthMode AuthMode;
@@ -343,6 +405,10 @@ private:
     MonotonicallyIncreasingCounter *NextMsgId;
     uint32_t *MaxMsgIdRcvd;
     ReceiveFlagsType *RcvFlags;
+    ReceiveWindowWordType *RcvWindow;
+    uint8_t RcvWindowWords;
+
+    void ShiftReceiveWindow(uint32_t shift);
 };
 
 /**
@@ -369,6 +435,8 @@ public:
     uint32_t MaxRcvdMsgId;                              /**< The maximum message id received under the session key. */
     WeaveConnection *BoundCon;                          /**< The connection to which the key is bound. */
     WeaveSessionState::ReceiveFlagsType RcvFlags;       /**< Flags tracking messages received under the key. */
+    WeaveSessionState::ReceiveWindowWordType RcvWindow[WeaveSessionState::kSessionKeyReceiveWindowWords];
+                                                        /**< Bitmap of message ids received prior to MaxRcvdMsgId. */
     WeaveAuthMode AuthMode;                             /**< The means by which the peer node was authenticated during session establishment. */
     WeaveMsgEncryptionKey MsgEncKey;                    /**< The Weave message encryption key. */
     uint8_t ReserveCount;                               /**< Number of times the session key has been reserved. */
@@ -393,11 +461,85 @@ public:
     void ClearSuspended()               { ClearFlag(Flags, kFlag_Suspended); }
 };
 
+/**
+ * @class WeaveSuspendedSession
+ *
+ * @brief
+ *   The state of a suspended Weave security session, in a compact fixed-layout form.
+ *
+ *   This form is intended to be kept in memory that is retained while a device sleeps, so that a
+ *   session can be restored by copying its state back and verifying a checksum, rather than by
+ *   parsing a TLV encoding.  Unlike the encoding produced by WeaveFabricState::SuspendSession(),
+ *   the layout depends on the build configuration and byte order of the device, and must only be
+ *   restored by the firmware that produced it.
+ *
+ *   The object holds the session keys in the clear.  Call Clear() once it is no longer needed.
+ */
+class WeaveSuspendedSession
+{
+public:
+    enum
+    {
+        kLayoutVersion               = 1,               /**< The version of the layout of this object. */
+    };
+
+    uint32_t Checksum;                                  /**< A checksum over the remainder of the object. */
+    uint16_t LayoutVersion;                             /**< The layout version, #kLayoutVersion. */
+    uint16_t LayoutSize;                                /**< The size of the object, which depends on the build configuration. */
+    uint64_t PeerNodeId;                                /**< The id of the peer node. */
+    uint32_t NextMsgId;                                 /**< The next message id to be used under the session key. */
+    uint32_t MaxRcvdMsgId;                              /**< The maximum message id received under the session key. */
+    WeaveSessionState::ReceiveWindowWordType RcvWindow[WeaveSessionState::kSessionKeyReceiveWindowWords];
+                                                        /**< Bitmap of message ids received prior to MaxRcvdMsgId. */
+    WeaveSessionState::ReceiveFlagsType RcvFlags;       /**< Flags tracking messages received under the key. */
+    uint16_t KeyId;                                     /**< The session key id. */
+    WeaveAuthMode AuthMode;                             /**< The means by which the peer node was authenticated. */
+    uint8_t EncType;                                    /**< The message encryption type. */
+    uint8_t SessionFlags;                               /**< The persistent WeaveSessionKey flags of the session. */
+    WeaveEncryptionKey EncKey;                          /**< The message encryption key(s). */
+    uint8_t AltNodeIdCount;                             /**< The number of alternate end node ids of a shared session. */
+    uint64_t AltNodeIds[WEAVE_CONFIG_MAX_SHARED_SESSIONS_END_NODES];
+                                                        /**< The alternate end node ids of a shared session. */
+
+    void Clear(void);
+    uint32_t ComputeChecksum(void) const;
+};
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+/**
+ * @class WeaveCASEResumptionTicket
+ *
+ * @brief
+ *   Contains the state needed to resume a CASE session with a peer node.
+ */
+class WeaveCASEResumptionTicket
+{
+public:
+    enum
+    {
+        kResumptionIdLength          = 8,               /**< The length of the resumption id, in bytes. */
+        kResumptionSecretLength      = 32,              /**< The length of the resumption secret, in bytes. */
+    };
+
+    uint64_t PeerNodeId;                                /**< The id of the node with which the ticket is shared. */
+    uint64_t ExpiryTimeMS;                              /**< The monotonic time, in milliseconds, at which the ticket expires. */
+    uint8_t ResumptionId[kResumptionIdLength];          /**< The id by which the peer locates the ticket. */
+    uint8_t ResumptionSecret[kResumptionSecretLength];  /**< The secret from which resumed session keys are derived. */
+    uint8_t CertType;                                   /**< The type of certificate by which the peer was authenticated. */
+};
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 /**
  * @class WeaveMsgEncryptionKeyCache
  *
  * @brief
  *   Key cache for Weave message encryption keys.
+ *
+ *   Cached keys are located through a hash index on their key IDs.  Entries returned empty by
+ *   FindOrAllocateKeyEntry() or AllocateFreeKeyEntry() must be passed to AddKeyEntry() once
+ *   their key has been derived.
  */
 class WeaveMsgEncryptionKeyCache
 {
@@ -406,15 +548,32 @@ public:
     void Reset(void);
     void Shutdown(void);
 
+    WeaveMsgEncryptionKey *FindKeyEntry(uint16_t keyId, uint8_t encType) const;
     WeaveMsgEncryptionKey *FindOrAllocateKeyEntry(uint16_t keyId, uint8_t encType);
+    WeaveMsgEncryptionKey *AllocateFreeKeyEntry(void);
+    void AddKeyEntry(WeaveMsgEncryptionKey *keyEntry);
+
+    // The HMAC key schedule of the (empty) salt used to derive message encryption application keys.
+    const nl::Weave::Crypto::HMACSHA1KeySchedule& GetSaltKeySchedule(void) const { return mSaltKeySchedule; }
 
 private:
+    enum
+    {
+        kKeyIndexSize = 2 * WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS
+    };
+
     // Array of Weave message encryption keys.
     WeaveMsgEncryptionKey mKeyCache[WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS];
     // Array of key entry indexes in sorted order from most- to least- recently used.
     uint8_t mMostRecentlyUsedKeyEntries[WEAVE_CONFIG_MAX_CACHED_MSG_ENC_APP_KEYS];
+    // Open-addressed hash index of the cached keys, by key ID (entry index + 1, or 0 if empty).
+    uint8_t mKeyIndex[kKeyIndexSize];
+    // HMAC state of the salt, computed once for all derivations.
+    nl::Weave::Crypto::HMACSHA1KeySchedule mSaltKeySchedule;
 
     void Clear(uint8_t keyEntryIndex);
+    void MoveKeyEntry(uint8_t keyEntryIndex, bool mostRecentlyUsed);
+    void RemoveKeyEntry(uint8_t keyEntryIndex);
 };
 
 /**
@@ -529,6 +688,8 @@ public:
 
     WEAVE_ERROR SuspendSession(uint16_t keyId, uint64_t peerNodeId, uint8_t * buf, uint16_t bufSize, uint16_t & serializedSessionLen);
     WEAVE_ERROR RestoreSession(uint8_t * serializedSession, uint16_t serializedSessionLen);
+    WEAVE_ERROR SuspendSession(uint16_t keyId, uint64_t peerNodeId, WeaveSuspendedSession & suspendedSession);
+    WEAVE_ERROR RestoreSession(const WeaveSuspendedSession & suspendedSession);
 
     WEAVE_ERROR GetSessionState(uint64_t remoteNodeId, uint16_t keyId, uint8_t encType, WeaveConnection *con, WeaveSessionState& outSessionState);
 
@@ -537,6 +698,12 @@ public:
     bool IsFabricAddress(const IPAddress &addr) const;
     bool IsLocalFabricAddress(const IPAddress &addr) const;
 
+#if WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 0
+    WEAVE_ERROR AddFabricPrefix(const IPPrefix &prefix, uint8_t classification);
+    WEAVE_ERROR RemoveFabricPrefix(const IPPrefix &prefix);
+    bool ClassifyAddress(const IPAddress &addr, uint8_t &classification) const;
+#endif // WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 0
+
     WEAVE_ERROR GetPassword(uint8_t pwSrc, const char *& ps, uint16_t& pwLen);
 
     WEAVE_ERROR CreateFabric(void);
@@ -567,6 +734,17 @@ public:
     WEAVE_ERROR CheckMsgEncForAppGroup(const WeaveMessageInfo *msgInfo, uint32_t appGroupGlobalId, uint32_t rootKeyId, bool requireRotatingKey);
 #endif // WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
 
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING && WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+    void UpdatePeerRTTEstimate(uint64_t peerNodeId, uint32_t rttSample);
+    bool GetPeerRTTEstimate(uint64_t peerNodeId, uint32_t& smoothedRTT, uint32_t& rttVariance);
+#endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING && WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    const WeaveCASEResumptionTicket *FindCASEResumptionTicket(uint64_t peerNodeId);
+    void CacheCASEResumptionTicket(const WeaveCASEResumptionTicket& ticket);
+    void RemoveCASEResumptionTicket(uint64_t peerNodeId);
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
     typedef void (*SessionEndCbFunct)(uint16_t keyId, uint64_t peerNodeId, void *context);
 
     // Callback context provided by provisioning servers when registering with
@@ -580,10 +758,25 @@ public:
 
     WEAVE_ERROR RegisterSessionEndCallback(SessionEndCbCtxt *sessionEndCb);
 private:
+    enum
+    {
+        // Sizes of the open-addressing hash indexes over the peer state and session key tables. Each index
+        // is kept at most half full so that probe sequences stay short.
+        kPeerIndexSize                                  = 2 * WEAVE_CONFIG_MAX_PEER_NODES,
+        kSessionKeyIndexSize                            = 2 * WEAVE_CONFIG_MAX_SESSION_KEYS,
+
+        // Value marking the end of the peer state most-recently-used list.
+        kPeerIndex_None                                 = WEAVE_CONFIG_MAX_PEER_NODES,
+    };
+
     PeerIndexType PeerCount;
     MonotonicallyIncreasingCounter NextUnencUDPMsgId;
     MonotonicallyIncreasingCounter NextUnencTCPMsgId;
     WeaveSessionKey SessionKeys[WEAVE_CONFIG_MAX_SESSION_KEYS];
+
+    // Hash index of allocated session keys, by key id. Each entry holds a SessionKeys index plus one; zero
+    // marks an empty entry.
+    uint16_t SessionKeyIndex[kSessionKeyIndexSize];
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
     PersistedCounter NextGroupKeyMsgId;
 
@@ -614,10 +807,24 @@ private:
 #if WEAVE_CONFIG_USE_APP_GROUP_KEYS_FOR_MSG_ENC
         uint32_t MaxGroupKeyMsgIdRcvd[WEAVE_CONFIG_MAX_PEER_NODES];
         WeaveSessionState::ReceiveFlagsType GroupKeyRcvFlags[WEAVE_CONFIG_MAX_PEER_NODES];
+        WeaveSessionState::ReceiveWindowWordType GroupKeyRcvWindow[WEAVE_CONFIG_MAX_PEER_NODES][WeaveSessionState::kGroupKeyReceiveWindowWords];
 #endif
         WeaveSessionState::ReceiveFlagsType UnencRcvFlags[WEAVE_CONFIG_MAX_PEER_NODES];
-        // Array of peer indexes in sorted order from most- to least- recently used.
-        PeerIndexType MostRecentlyUsedIndexes[WEAVE_CONFIG_MAX_PEER_NODES];
+        WeaveSessionState::ReceiveWindowWordType UnencRcvWindow[WEAVE_CONFIG_MAX_PEER_NODES][WeaveSessionState::kUnencryptedReceiveWindowWords];
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING && WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+        // Smoothed round-trip time and round-trip time variation (in milliseconds) of WRMP exchanges with
+        // the peer. A smoothed RTT of zero means no estimate is available.
+        uint16_t SmoothedRTT[WEAVE_CONFIG_MAX_PEER_NODES];
+        uint16_t RTTVariance[WEAVE_CONFIG_MAX_PEER_NODES];
+#endif
+        // Doubly-linked list of peer indexes in order from most- to least- recently used.
+        PeerIndexType MoreRecentlyUsed[WEAVE_CONFIG_MAX_PEER_NODES];
+        PeerIndexType LessRecentlyUsed[WEAVE_CONFIG_MAX_PEER_NODES];
+        PeerIndexType MostRecentlyUsed;
+        PeerIndexType LeastRecentlyUsed;
+        // Hash index of peer entries, by node id. Each entry holds a peer index plus one; zero marks an
+        // empty entry.
+        PeerIndexType Index[kPeerIndexSize];
     } PeerStates;
     FabricStateDelegate *Delegate;
 
@@ -630,6 +837,18 @@ private:
     // Record of all active shared session end nodes.
     SharedSessionEndNode SharedSessionsNodes[WEAVE_CONFIG_MAX_SHARED_SESSIONS_END_NODES];
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // CASE resumption tickets, in order from most- to least- recently cached. Free entries, which
+    // have a PeerNodeId of kNodeIdNotSpecified, are at the end.
+    WeaveCASEResumptionTicket CASEResumptionTickets[WEAVE_CONFIG_CASE_RESUMPTION_CACHE_SIZE];
+#endif
+
+#if WEAVE_CONFIG_MAX_FABRIC_PREFIXES > 0
+    // Additional fabric prefixes, indexed for longest-prefix match.
+    nl::Inet::IPPrefixTrie FabricPrefixes;
+    nl::Inet::IPPrefixTrie::Node FabricPrefixNodes[2 * WEAVE_CONFIG_MAX_FABRIC_PREFIXES - 1];
+#endif
+
     // Linked list of registered modules to be notified when session closes
     SessionEndCbCtxt *sessionEndCallbackList;
 
@@ -643,6 +862,16 @@ private:
 #endif
 
     bool FindOrAllocPeerEntry(uint64_t peerNodeId, bool allocEntry, PeerIndexType& retPeerIndex);
+    void ResetPeerStates(void);
+    void AddPeerToIndex(PeerIndexType peerIndex);
+    void RemovePeerFromIndex(PeerIndexType peerIndex);
+    void UnlinkPeerEntry(PeerIndexType peerIndex);
+    void LinkPeerEntryAsMostRecentlyUsed(PeerIndexType peerIndex);
+    void AddSessionKeyToIndex(WeaveSessionKey *sessionKey);
+    void RemoveSessionKeyFromIndex(WeaveSessionKey *sessionKey);
+    WEAVE_ERROR GetSessionKeyToSuspend(uint16_t keyId, uint64_t peerNodeId, WeaveSessionKey *& sessionKey);
+    void WipeSuspendedSessionKey(WeaveSessionKey *sessionKey);
+    WEAVE_ERROR AllocSessionKeyToRestore(uint16_t keyId, uint64_t peerNodeId, WeaveSessionKey *& sessionKey);
     WEAVE_ERROR FindMsgEncAppKey(uint16_t keyId, uint8_t encType, WeaveMsgEncryptionKey *& retRec);
     WEAVE_ERROR DeriveMsgEncAppKey(uint32_t keyId, uint8_t encType, WeaveMsgEncryptionKey & appKey, uint32_t& appGroupGlobalId);
 };
@@ -663,6 +892,9 @@ inline bool WeaveFabricState::IsMsgCounterSyncReqInProgress(void)
 
 
 
+extern uint16_t WeaveEncryptionKeySize(uint8_t encType);
+extern void WeaveEncryptionKeyFromBytes(uint8_t encType, const uint8_t *keyData, WeaveEncryptionKey& key);
+
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
 
 enum
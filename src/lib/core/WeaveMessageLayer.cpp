@@ -46,10 +46,13 @@
 #include <Weave/Support/crypto/HMAC.h>
 #include <Weave/Support/crypto/AESBlockCipher.h>
 #include <Weave/Support/crypto/CTRMode.h>
+#include <Weave/Support/crypto/CCMMode.h>
 #include <Weave/Support/logging/WeaveLogging.h>
 #include <Weave/Support/ErrorStr.h>
 #include <Weave/Support/CodeUtils.h>
 #include <Weave/Support/WeaveFaultInjection.h>
+#include <Weave/Support/PerfInstrumentation.h>
+#include <SystemLayer/SystemTrace.h>
 
 
 namespace nl {
@@ -88,7 +91,10 @@ using namespace nl::Weave::Encoding;
 enum
 {
     kKeyIdLen = 2,
-    kMinPayloadLen = 1
+    kMinPayloadLen = 1,
+    kAES128CCMNonceLen = 12,            // Sending node id (8 bytes) followed by message id (4 bytes).
+    kAES128CCMTagLen = 16,
+    kMaxAuthenticatedHeaderLen = 2 * sizeof(uint64_t) + sizeof(uint16_t) + sizeof(uint32_t)
 };
 
 /**
@@ -137,6 +143,10 @@ WEAVE_ERROR WeaveMessageLayer::Init(InitContext *context)
     }
 #endif // WEAVE_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 
+#if WEAVE_CONFIG_PERF_INSTRUMENTATION
+    nl::Weave::PerfInstrumentation::EnableCounter();
+#endif
+
     FabricState = context->fabricState;
     FabricState->MessageLayer = this;
     OnMessageReceived = NULL;
@@ -148,6 +158,7 @@ WEAVE_ERROR WeaveMessageLayer::Init(InitContext *context)
     OnMessageLayerActivityChange = NULL;
     memset(mConPool, 0, sizeof(mConPool));
     memset(mTunnelPool, 0, sizeof(mTunnelPool));
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kMessageLayer_NumConnections, WEAVE_CONFIG_MAX_CONNECTIONS);
     AppState = NULL;
     ExchangeMgr = NULL;
     SecurityMgr = NULL;
@@ -457,6 +468,98 @@ exit:
     return res;
 }
 
+/**
+ *  Send the same Weave message to each of a number of destinations using the underlying Inetlayer UDP endpoint.
+ *
+ *  The payload is serialized once by the caller. For each destination, it is copied into a buffer with room for the
+ *  message header, and the header (and, for encrypted messages, the payload and integrity check) is then encoded for
+ *  that destination alone; the last destination is sent the caller's buffer itself. Unicast messages are queued on
+ *  the UDP endpoint, where supported, so that the whole fan-out is handed to the network in as few system calls as
+ *  possible at the end of the current event loop iteration.
+ *
+ *  @note
+ *    Each destination is addressed as by SendMessage(): for each destination, either the address or the node
+ *    identifier may be left unspecified and is then derived from the other.
+ *
+ *  @param[in]    destAddrs     An array of the destination IP addresses, or NULL to derive each from its node
+ *                              identifier.
+ *
+ *  @param[in]    destNodeIds   An array of the destination node identifiers, or NULL to derive each from its address.
+ *
+ *  @param[in]    numDests      The number of destinations.
+ *
+ *  @param[in]    destPort      The destination port.
+ *
+ *  @param[in]    msgInfo       A pointer to a WeaveMessageInfo object containing information about the message to be
+ *                              sent. Its destination node identifier is ignored. On return, it describes the message
+ *                              sent to the last destination.
+ *
+ *  @param[in]    payload       A pointer to the PacketBuffer object holding the payload of the message. It is freed
+ *                              unless #kWeaveMessageFlag_RetainBuffer is set.
+ *
+ *  @retval  #WEAVE_NO_ERROR                on successfully sending the message to every destination.
+ *  @retval  #WEAVE_ERROR_INVALID_ARGUMENT  if neither destination addresses nor node identifiers are supplied.
+ *  @retval  #WEAVE_ERROR_NO_MEMORY         if a buffer could not be allocated for a destination.
+ *  @retval  other errors generated while encoding or sending the message, for the first destination to which the
+ *           message could not be sent. A failure to send to one destination does not prevent sending to the others.
+ *
+ */
+WEAVE_ERROR WeaveMessageLayer::SendMessageToMany(const IPAddress *destAddrs, const uint64_t *destNodeIds, size_t numDests,
+                                                 uint16_t destPort, WeaveMessageInfo *msgInfo, PacketBuffer *payload)
+{
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_MessageLayer);
+
+    WEAVE_ERROR res = WEAVE_NO_ERROR;
+    const bool retainBuffer = (msgInfo->Flags & kWeaveMessageFlag_RetainBuffer) != 0;
+    const WeaveMessageInfo msgTemplate = *msgInfo;
+    const uint16_t payloadLen = payload->DataLength();
+
+    VerifyOrExit(destAddrs != NULL || destNodeIds != NULL, res = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    for (size_t i = 0; i < numDests; i++)
+    {
+        const bool isLast = (i == numDests - 1);
+        WEAVE_ERROR sendRes;
+        PacketBuffer *msgBuf;
+
+        // Each destination is encoded from the caller's message information, as encoding updates it.
+        *msgInfo = msgTemplate;
+        msgInfo->DestNodeId = (destNodeIds != NULL) ? destNodeIds[i] : kNodeIdNotSpecified;
+        msgInfo->Flags &= ~(kWeaveMessageFlag_RetainBuffer | kWeaveMessageFlag_DelaySend);
+        msgInfo->Flags |= kWeaveMessageFlag_DeferUDPSend;
+
+        if (isLast && !retainBuffer)
+        {
+            msgBuf = payload;
+            payload = NULL;
+        }
+        else
+        {
+            msgBuf = PacketBuffer::NewWithAvailableSize(WEAVE_HEADER_RESERVE_SIZE, payloadLen + WEAVE_TRAILER_RESERVE_SIZE);
+            if (msgBuf == NULL)
+            {
+                if (res == WEAVE_NO_ERROR)
+                    res = WEAVE_ERROR_NO_MEMORY;
+                continue;
+            }
+
+            memcpy(msgBuf->Start(), payload->Start(), payloadLen);
+            msgBuf->SetDataLength(payloadLen);
+        }
+
+        // The message buffer is consumed whether or not the message is sent.
+        sendRes = SendMessage((destAddrs != NULL) ? destAddrs[i] : IPAddress::Any, destPort, INET_NULL_INTERFACEID, msgInfo, msgBuf);
+        if (res == WEAVE_NO_ERROR)
+            res = sendRes;
+    }
+
+exit:
+    if (payload != NULL && !retainBuffer)
+        PacketBuffer::Free(payload);
+
+    return res;
+}
+
 bool WeaveMessageLayer::IsIgnoredMulticastSendError(WEAVE_ERROR err)
 {
     return err == WEAVE_NO_ERROR ||
@@ -634,6 +737,8 @@ WEAVE_ERROR WeaveMessageLayer::SendMessage(const IPAddress & destAddr, uint16_t
         // Send the message once. If requested by the caller, instruct the end point code to not free the
         // message buffer. If a send interface was specified, the message is sent over that interface.
         udpSendFlags = GetFlag(msgFlags, kWeaveMessageFlag_RetainBuffer) ? UDPEndPoint::kSendFlag_RetainBuffer : 0;
+        if (sendAction == kUnicast && GetFlag(msgFlags, kWeaveMessageFlag_DeferUDPSend))
+            udpSendFlags |= UDPEndPoint::kSendFlag_Deferred;
         err = ep->SendMsg(&pktInfo, payload, udpSendFlags);
         payload = NULL; // Prevent call to Free() in exit code
         CheckForceRefreshUDPEndPointsNeeded(err);
@@ -1104,6 +1209,16 @@ static uint16_t EncodeHeaderField(const WeaveMessageInfo *msgInfo)
            ((((uint16_t)msgInfo->MessageVersion) << kMsgHeaderField_MessageVersionShift) & kMsgHeaderField_MessageVersionMask);
 }
 
+// Length of the message header, indexed by the destination node id flag (bit 0), the source node id flag
+// (bit 1) and whether the message is encrypted (bit 2), so that the header can be length-checked once.
+static const uint8_t sMsgHeaderLengths[8] = { 6, 14, 14, 22, 8, 16, 16, 24 };
+
+static inline uint8_t GetMsgHeaderLengthIndex(const uint16_t headerField)
+{
+    return static_cast<uint8_t>(((headerField & (kWeaveHeaderFlag_DestNodeId | kWeaveHeaderFlag_SourceNodeId)) >> 8) |
+                                (((headerField & kMsgHeaderField_EncryptionTypeMask) != 0) ? 4 : 0));
+}
+
 // Decode message header field value.
 static void DecodeHeaderField(const uint16_t headerField, WeaveMessageInfo *msgInfo)
 {
@@ -1112,6 +1227,66 @@ static void DecodeHeaderField(const uint16_t headerField, WeaveMessageInfo *msgI
     msgInfo->MessageVersion = (uint8_t)((headerField & kMsgHeaderField_MessageVersionMask) >> kMsgHeaderField_MessageVersionShift);
 }
 
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+/*
+ * Returns the length of the piece of a chained message held by the current buffer, starting at data and limited
+ * to the remaining length, and advances buf, data and remainingLen past it.
+ */
+static uint16_t NextChainSegment(PacketBuffer *&buf, uint8_t *&data, uint16_t &remainingLen)
+{
+    uint16_t segLen = 0;
+
+    if (buf != NULL)
+    {
+        segLen = static_cast<uint16_t>((buf->Start() + buf->DataLength()) - data);
+        if (segLen > remainingLen)
+            segLen = remainingLen;
+
+        buf = buf->Next();
+        data = (buf != NULL) ? buf->Start() : NULL;
+        remainingLen -= segLen;
+    }
+    else
+    {
+        remainingLen = 0;
+    }
+
+    return segLen;
+}
+
+/*
+ * Copies the last tailLen bytes of a chained message into tail and removes them from the chain, freeing any
+ * buffers that are left empty.
+ */
+static void RemoveChainTail(PacketBuffer *msgBuf, uint8_t *tail, uint16_t tailLen)
+{
+    uint16_t keepLen = msgBuf->TotalLength() - tailLen;
+    PacketBuffer *lastBuf = msgBuf;
+
+    // Find the last buffer that keeps any of the message.
+    while (keepLen > lastBuf->DataLength())
+    {
+        keepLen -= lastBuf->DataLength();
+        lastBuf = lastBuf->Next();
+    }
+
+    for (PacketBuffer *buf = lastBuf; buf != NULL; buf = buf->Next())
+    {
+        uint16_t offset = (buf == lastBuf) ? keepLen : 0;
+        memcpy(tail, buf->Start() + offset, buf->DataLength() - offset);
+        tail += buf->DataLength() - offset;
+    }
+
+    for (PacketBuffer *buf = lastBuf->Next(); buf != NULL; buf = buf->Next())
+        buf->SetDataLength(0, msgBuf);
+    if (lastBuf->Next() != NULL)
+        PacketBuffer::Free(lastBuf->DetachTail());
+    lastBuf->SetDataLength(keepLen, msgBuf);
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
 /**
  *  Decode a Weave Message layer header from a received Weave message.
  *
@@ -1135,7 +1310,6 @@ WEAVE_ERROR WeaveMessageLayer::DecodeHeader(PacketBuffer *msgBuf, WeaveMessageIn
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     uint8_t *msgStart = msgBuf->Start();
     uint16_t msgLen = msgBuf->DataLength();
-    uint8_t *msgEnd = msgStart + msgLen;
     uint8_t *p = msgStart;
     uint16_t headerField;
 
@@ -1148,6 +1322,9 @@ WEAVE_ERROR WeaveMessageLayer::DecodeHeader(PacketBuffer *msgBuf, WeaveMessageIn
     headerField = LittleEndian::Read16(p);
     VerifyOrExit((headerField & kMsgHeaderField_ReservedFlagsMask) == 0, err = WEAVE_ERROR_INVALID_MESSAGE_FLAG);
 
+    // The header field determines the length of the rest of the header, so check it once up front.
+    VerifyOrExit(msgLen >= sMsgHeaderLengths[GetMsgHeaderLengthIndex(headerField)], err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
     // Decode the header field.
     DecodeHeaderField(headerField, msgInfo);
 
@@ -1164,20 +1341,12 @@ WEAVE_ERROR WeaveMessageLayer::DecodeHeader(PacketBuffer *msgBuf, WeaveMessageIn
     // Decode the source node identifier if included in the message.
     if (msgInfo->Flags & kWeaveMessageFlag_SourceNodeId)
     {
-        if ((p + 8) > msgEnd)
-        {
-            ExitNow(err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
-        }
         msgInfo->SourceNodeId = LittleEndian::Read64(p);
     }
 
     // Decode the destination node identifier if included in the message.
     if (msgInfo->Flags & kWeaveMessageFlag_DestNodeId)
     {
-        if ((p + 8) > msgEnd)
-        {
-            ExitNow(err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
-        }
         msgInfo->DestNodeId = LittleEndian::Read64(p);
     }
     else
@@ -1191,10 +1360,6 @@ WEAVE_ERROR WeaveMessageLayer::DecodeHeader(PacketBuffer *msgBuf, WeaveMessageIn
     // Decode the encryption key identifier if present.
     if (msgInfo->EncryptionType != kWeaveEncryptionType_None)
     {
-        if ((p + kKeyIdLen) > msgEnd)
-        {
-            ExitNow(err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
-        }
         msgInfo->KeyId = LittleEndian::Read16(p);
     }
     else
@@ -1247,12 +1412,23 @@ WEAVE_ERROR WeaveMessageLayer::ReEncodeMessage(PacketBuffer *msgBuf)
             // TODO: re-validate MIC to ensure that no part of the message has been altered since the time it was received.
 
             // Re-encrypt the payload.
-            AES128CTRMode aes128CTR;
-            aes128CTR.SetKey(sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey);
-            aes128CTR.SetWeaveMessageCounter(msgInfo.SourceNodeId, msgInfo.MessageId);
-            aes128CTR.EncryptData(p, encryptionLen, p);
+            Encrypt_AES128CTRSHA1(&msgInfo, sessionState.MsgEncKey, p, encryptionLen, p);
+        }
+        break;
+
+    case kWeaveEncryptionType_AES128CCM:
+        {
+            if (encryptionLen < kAES128CCMTagLen)
+                return WEAVE_ERROR_INVALID_MESSAGE_LENGTH;
+            encryptionLen -= kAES128CCMTagLen;
+
+            // Re-encrypt the payload. Since the plaintext is unchanged, so is the tag that follows it.
+            err = Encrypt_AES128CCM(&msgInfo, sessionState.MsgEncKey, p, encryptionLen, p + encryptionLen);
+            if (err != WEAVE_NO_ERROR)
+                return err;
         }
         break;
+
     default:
         return WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE;
     }
@@ -1286,12 +1462,20 @@ WEAVE_ERROR WeaveMessageLayer::ReEncodeMessage(PacketBuffer *msgBuf)
  *                                                     requested maximum.
  *  @retval  #WEAVE_ERROR_BUFFER_TOO_SMALL             if there is not enough space before or after the
  *                                                     message payload.
+ *  @retval  #WEAVE_ERROR_NO_MEMORY                    if a buffer could not be appended to a chained
+ *                                                     payload to hold the message trailer.
  *  @retval  other errors generated by the fabric state object when fetching the session state.
  *
+ *  @note When #WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES is enabled and the message is sent over a TCP
+ *        connection, the payload may span a chain of buffers, with the message header prepended to the
+ *        first and the message trailer appended to the last.
+ *
  */
 WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf, WeaveConnection *con,
         uint16_t maxLen, uint16_t reserve)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_MessageLayer);
+
     WEAVE_ERROR err;
     uint8_t *p1;
     // Error if an unsupported message version requested.
@@ -1318,6 +1502,16 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
     uint16_t headLen = 6;
     uint16_t tailLen = 0;
     uint16_t payloadLen = msgBuf->DataLength();
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+    // Over a TCP connection, the payload may span a chain of buffers, the last of which receives the message trailer.
+    PacketBuffer *tailBuf = NULL;
+    if (msgBuf->Next() != NULL && con != NULL && con->NetworkType == WeaveConnection::kNetworkType_IP)
+    {
+        payloadLen = msgBuf->TotalLength();
+        for (tailBuf = msgBuf; tailBuf->Next() != NULL; tailBuf = tailBuf->Next())
+            ;
+    }
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
     if (msgInfo->Flags & kWeaveMessageFlag_SourceNodeId)
         headLen += 8;
     if (msgInfo->Flags & kWeaveMessageFlag_DestNodeId)
@@ -1333,12 +1527,19 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
         headLen += 2;
         tailLen += HMACSHA1::kDigestLength;
         break;
+    case kWeaveEncryptionType_AES128CCM:
+        // Can only encrypt non-zero length payloads.
+        if (payloadLen == 0)
+            return WEAVE_ERROR_INVALID_MESSAGE_LENGTH;
+        headLen += 2;
+        tailLen += kAES128CCMTagLen;
+        break;
     default:
         return WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE;
     }
 
     // Error if the encoded message would be longer than the requested maximum.
-    if ((headLen + msgBuf->DataLength() + tailLen) > maxLen)
+    if ((headLen + payloadLen + tailLen) > maxLen)
         return WEAVE_ERROR_MESSAGE_TOO_LONG;
 
     // Ensure there's enough room before the payload to hold the message header.
@@ -1347,6 +1548,21 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
         return WEAVE_ERROR_BUFFER_TOO_SMALL;
 
     // Error if not enough space after the message payload.
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+    if (tailBuf != NULL)
+    {
+        // If the last buffer of a chained payload has no room for the trailer, append one that does.
+        if ((tailBuf->DataLength() + tailLen) > tailBuf->MaxDataLength())
+        {
+            PacketBuffer *newBuf = PacketBuffer::NewWithAvailableSize(0, tailLen);
+            if (newBuf == NULL)
+                return WEAVE_ERROR_NO_MEMORY;
+            msgBuf->AddToEnd(newBuf);
+            tailBuf = newBuf;
+        }
+    }
+    else
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
     if ((msgBuf->DataLength() + tailLen) > msgBuf->MaxDataLength())
         return WEAVE_ERROR_BUFFER_TOO_SMALL;
 
@@ -1426,24 +1642,67 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
         // Encode the key id.
         LittleEndian::Write16(p, msgInfo->KeyId);
 
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+        if (tailBuf != NULL)
+        {
+            // Compute the integrity check value over the payload chain, then encrypt the payload and the
+            // integrity check value that follows it in the last buffer.
+            uint8_t *integrityCheck = tailBuf->Start() + tailBuf->DataLength();
+            ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey, msgBuf, payloadStart, payloadLen,
+                                                integrityCheck);
+            Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey, msgBuf, payloadStart, payloadLen, integrityCheck);
+            tailBuf->SetDataLength(tailBuf->DataLength() + tailLen, msgBuf);
+            break;
+        }
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
         // At this point we've completed encoding the head of the message (and therefore p == payloadStart),
         // so skip over the payload data.
         p += payloadLen;
 
         // Compute the integrity check value and store it immediately after the payload data.
-        ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.IntegrityKey,
+        ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey,
                                             payloadStart, payloadLen, p);
         p += HMACSHA1::kDigestLength;
 
         // Encrypt the message payload and the integrity check value that follows it, in place, in the message buffer.
-        Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey,
+        Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey,
                               payloadStart, payloadLen + HMACSHA1::kDigestLength, payloadStart);
 
         break;
+
+    case kWeaveEncryptionType_AES128CCM:
+        // Encode the key id.
+        LittleEndian::Write16(p, msgInfo->KeyId);
+
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+        if (tailBuf != NULL)
+        {
+            // Encrypt the payload chain in place and store the authentication tag in the last buffer.
+            err = Encrypt_AES128CCM(msgInfo, sessionState.MsgEncKey, msgBuf, payloadStart, payloadLen,
+                                    tailBuf->Start() + tailBuf->DataLength());
+            if (err != WEAVE_NO_ERROR)
+                return err;
+            tailBuf->SetDataLength(tailBuf->DataLength() + tailLen, msgBuf);
+            break;
+        }
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+        // Encrypt the message payload in place and store the authentication tag immediately after it.
+        err = Encrypt_AES128CCM(msgInfo, sessionState.MsgEncKey, payloadStart, payloadLen, payloadStart + payloadLen);
+        if (err != WEAVE_NO_ERROR)
+            return err;
+        p += payloadLen + kAES128CCMTagLen;
+
+        break;
     }
 
     msgInfo->Flags |= kWeaveMessageFlag_MessageEncoded;
-    // Update the buffer length to reflect the entire encoded message.
+    // Update the buffer length to reflect the entire encoded message.  (The buffers of a chained message
+    // already do.)
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+    if (tailBuf == NULL)
+#endif
     msgBuf->SetDataLength(headLen + payloadLen + tailLen);
 
     // We update the cursor (p) out of good hygiene,
@@ -1457,11 +1716,23 @@ WEAVE_ERROR WeaveMessageLayer::EncodeMessage(WeaveMessageInfo *msgInfo, PacketBu
 WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
         WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen) // TODO: use references
 {
+    SYSTEM_TRACE_SCOPE("MessageLayer", "WeaveMessageLayer::DecodeMessage");
+
     WEAVE_ERROR err;
     uint8_t *msgStart = msgBuf->Start();
     uint16_t msgLen = msgBuf->DataLength();
     uint8_t *msgEnd = msgStart + msgLen;
     uint8_t *p = msgStart;
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+    // A message received over a TCP connection may span a chain of buffers, the first of which holds the
+    // message header.
+    const bool isChained = (msgBuf->Next() != NULL && con != NULL && con->NetworkType == WeaveConnection::kNetworkType_IP);
+    if (isChained)
+    {
+        msgLen = msgBuf->TotalLength();
+        msgEnd = msgStart + msgLen;
+    }
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
     msgInfo->SourceNodeId = sourceNodeId;
     err = DecodeHeader(msgBuf, msgInfo, &p);
     sourceNodeId = msgInfo->SourceNodeId;
@@ -1498,13 +1769,31 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sour
         *rPayloadLen = payloadLen;
         *rPayload = p;
 
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+        if (isChained)
+        {
+            uint8_t integrityCheck[HMACSHA1::kDigestLength];
+            uint8_t expectedIntegrityCheck[HMACSHA1::kDigestLength];
+
+            // Move the integrity check value, which may itself span buffers, off the end of the chain, then
+            // decrypt it along with the payload and verify it.
+            RemoveChainTail(msgBuf, integrityCheck, HMACSHA1::kDigestLength);
+            Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey, msgBuf, p, payloadLen, integrityCheck);
+            ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey, msgBuf, p, payloadLen,
+                                                expectedIntegrityCheck);
+            if (!ConstantTimeCompare(integrityCheck, expectedIntegrityCheck, HMACSHA1::kDigestLength))
+                return WEAVE_ERROR_INTEGRITY_CHECK_FAILED;
+            break;
+        }
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
         // Decrypt the message payload and the integrity check value that follows it, in place, in the message buffer.
-        Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.DataKey,
+        Encrypt_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey,
                               p, payloadLen + HMACSHA1::kDigestLength, p);
 
         // Compute the expected integrity check value from the decrypted payload.
         uint8_t expectedIntegrityCheck[HMACSHA1::kDigestLength];
-        ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey->EncKey.AES128CTRSHA1.IntegrityKey,
+        ComputeIntegrityCheck_AES128CTRSHA1(msgInfo, sessionState.MsgEncKey,
                                             p, payloadLen, expectedIntegrityCheck);
         // Error if the expected integrity check doesn't match the integrity check in the message.
         if (!ConstantTimeCompare(p + payloadLen, expectedIntegrityCheck, HMACSHA1::kDigestLength))
@@ -1515,6 +1804,43 @@ WEAVE_ERROR WeaveMessageLayer::DecodeMessage(PacketBuffer *msgBuf, uint64_t sour
         break;
     }
 
+    case kWeaveEncryptionType_AES128CCM:
+    {
+        // Error if the message is short given the expected fields.
+        if ((p + kMinPayloadLen + kAES128CCMTagLen) > msgEnd)
+            return WEAVE_ERROR_INVALID_MESSAGE_LENGTH;
+
+        // Return the position and length of the payload within the message.
+        uint16_t payloadLen = msgLen - ((p - msgStart) + kAES128CCMTagLen);
+        *rPayloadLen = payloadLen;
+        *rPayload = p;
+
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+        if (isChained)
+        {
+            uint8_t tag[kAES128CCMTagLen];
+
+            // Move the tag, which may itself span buffers, off the end of the chain, then decrypt the payload
+            // chain in place, verifying it against the tag.
+            RemoveChainTail(msgBuf, tag, kAES128CCMTagLen);
+            err = Decrypt_AES128CCM(msgInfo, sessionState.MsgEncKey, msgBuf, p, payloadLen, tag);
+            if (err != WEAVE_NO_ERROR)
+                return err;
+            break;
+        }
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+        // Decrypt the message payload in place, verifying it against the tag that follows it.
+        err = Decrypt_AES128CCM(msgInfo, sessionState.MsgEncKey, p, payloadLen, p + payloadLen);
+        if (err != WEAVE_NO_ERROR)
+            return err;
+
+        // Skip past the payload and the tag.
+        p += payloadLen + kAES128CCMTagLen;
+
+        break;
+    }
+
     default:
         return WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE;
     }
@@ -2115,7 +2441,7 @@ WEAVE_ERROR WeaveMessageLayer::RefreshEndpoint(TCPEndPoint *& endPoint, bool ena
         endPoint->AppState = this;
         endPoint->OnConnectionReceived = HandleIncomingTcpConnection;
         endPoint->OnAcceptError = HandleAcceptError;
-        err = endPoint->Listen(1);
+        err = endPoint->Listen(WEAVE_CONFIG_TCP_LISTEN_BACKLOG);
         SuccessOrExit(err);
 
 #if WEAVE_BIND_DETAIL_LOGGING && WEAVE_DETAIL_LOGGING
@@ -2201,30 +2527,239 @@ exit:
     return err;
 }
 
-void WeaveMessageLayer::Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
+void WeaveMessageLayer::Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
                                               const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
 {
+    WEAVE_PERF_SCOPE(kSection_MessageEncryption);
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    // Use the cached AES round keys; only the counter needs to be set per message.
+    AES128CTRMode& aes128CTR = msgEncKey->GetKeySchedule_AES128CTRSHA1().DataKeySchedule;
+#else
     AES128CTRMode aes128CTR;
-    aes128CTR.SetKey(key);
+    aes128CTR.SetKey(msgEncKey->EncKey.AES128CTRSHA1.DataKey);
+#endif
     aes128CTR.SetWeaveMessageCounter(msgInfo->SourceNodeId, msgInfo->MessageId);
     aes128CTR.EncryptData(inData, inLen, outBuf);
 }
 
-void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
+void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
                                                             const uint8_t *inData, uint16_t inLen, uint8_t *outBuf)
 {
+    WEAVE_PERF_SCOPE(kSection_MessageEncryption);
     HMACSHA1 hmacSHA1;
-    uint8_t encodedBuf[2 * sizeof(uint64_t) + sizeof(uint16_t) + sizeof(uint32_t)];
-    uint8_t *p = encodedBuf;
+    uint8_t encodedBuf[kMaxAuthenticatedHeaderLen];
+    uint8_t encodedLen;
 
     // Initialize HMAC Key.
-    hmacSHA1.Begin(key, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    hmacSHA1.Begin(msgEncKey->GetKeySchedule_AES128CTRSHA1().IntegrityKeySchedule);
+#else
+    hmacSHA1.Begin(msgEncKey->EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+#endif
+
+    // Hash encoded message header fields.
+    encodedLen = EncodeAuthenticatedHeader(msgInfo, encodedBuf);
+    hmacSHA1.AddData(encodedBuf, encodedLen);
+
+    // Handle payload data.
+    hmacSHA1.AddData(inData, inLen);
+
+    // Generate the MAC.
+    hmacSHA1.Finish(outBuf);
+}
+
+WEAVE_ERROR WeaveMessageLayer::Encrypt_AES128CCM(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                                 uint8_t *data, uint16_t dataLen, uint8_t *tag)
+{
+    WEAVE_PERF_SCOPE(kSection_MessageEncryption);
+    uint8_t nonce[kAES128CCMNonceLen];
+    uint8_t *p = nonce;
+    uint8_t aad[kMaxAuthenticatedHeaderLen];
+    uint8_t aadLen;
+
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    AES128CCMMode& aes128CCM = msgEncKey->GetKeySchedule_AES128CCM().DataKeySchedule;
+#else
+    AES128CCMMode aes128CCM;
+    aes128CCM.SetKey(msgEncKey->EncKey.AES128CCM.DataKey);
+#endif
+
+    // The nonce is formed from the sending node id and the message id, in big-endian order, which together
+    // uniquely identify a message encrypted with a given key.
+    Encoding::BigEndian::Write64(p, msgInfo->SourceNodeId);
+    Encoding::BigEndian::Write32(p, msgInfo->MessageId);
+
+    aadLen = EncodeAuthenticatedHeader(msgInfo, aad);
+
+    return aes128CCM.Encrypt(nonce, sizeof(nonce), aad, aadLen, data, dataLen, data, tag, kAES128CCMTagLen);
+}
+
+WEAVE_ERROR WeaveMessageLayer::Decrypt_AES128CCM(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                                 uint8_t *data, uint16_t dataLen, const uint8_t *tag)
+{
+    WEAVE_PERF_SCOPE(kSection_MessageEncryption);
+    uint8_t nonce[kAES128CCMNonceLen];
+    uint8_t *p = nonce;
+    uint8_t aad[kMaxAuthenticatedHeaderLen];
+    uint8_t aadLen;
+
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    AES128CCMMode& aes128CCM = msgEncKey->GetKeySchedule_AES128CCM().DataKeySchedule;
+#else
+    AES128CCMMode aes128CCM;
+    aes128CCM.SetKey(msgEncKey->EncKey.AES128CCM.DataKey);
+#endif
+
+    Encoding::BigEndian::Write64(p, msgInfo->SourceNodeId);
+    Encoding::BigEndian::Write32(p, msgInfo->MessageId);
+
+    aadLen = EncodeAuthenticatedHeader(msgInfo, aad);
+
+    return aes128CCM.Decrypt(nonce, sizeof(nonce), aad, aadLen, data, dataLen, data, tag, kAES128CCMTagLen);
+}
+
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+void WeaveMessageLayer::Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                              PacketBuffer *buf, uint8_t *data, uint16_t dataLen, uint8_t *integrityCheck)
+{
+    WEAVE_PERF_SCOPE(kSection_MessageEncryption);
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    AES128CTRMode& aes128CTR = msgEncKey->GetKeySchedule_AES128CTRSHA1().DataKeySchedule;
+#else
+    AES128CTRMode aes128CTR;
+    aes128CTR.SetKey(msgEncKey->EncKey.AES128CTRSHA1.DataKey);
+#endif
+    aes128CTR.SetWeaveMessageCounter(msgInfo->SourceNodeId, msgInfo->MessageId);
+
+    // The key stream carries over from one piece of the message to the next.
+    while (dataLen > 0)
+    {
+        uint8_t *seg = data;
+        uint16_t segLen = NextChainSegment(buf, data, dataLen);
+        aes128CTR.EncryptData(seg, segLen, seg);
+    }
+    aes128CTR.EncryptData(integrityCheck, HMACSHA1::kDigestLength, integrityCheck);
+}
+
+void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                                            PacketBuffer *buf, uint8_t *data, uint16_t dataLen, uint8_t *outBuf)
+{
+    WEAVE_PERF_SCOPE(kSection_MessageEncryption);
+    HMACSHA1 hmacSHA1;
+    uint8_t encodedBuf[kMaxAuthenticatedHeaderLen];
+    uint8_t encodedLen;
+
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    hmacSHA1.Begin(msgEncKey->GetKeySchedule_AES128CTRSHA1().IntegrityKeySchedule);
+#else
+    hmacSHA1.Begin(msgEncKey->EncKey.AES128CTRSHA1.IntegrityKey, WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+#endif
+
+    encodedLen = EncodeAuthenticatedHeader(msgInfo, encodedBuf);
+    hmacSHA1.AddData(encodedBuf, encodedLen);
+
+    while (dataLen > 0)
+    {
+        uint8_t *seg = data;
+        uint16_t segLen = NextChainSegment(buf, data, dataLen);
+        hmacSHA1.AddData(seg, segLen);
+    }
+
+    hmacSHA1.Finish(outBuf);
+}
+
+WEAVE_ERROR WeaveMessageLayer::Encrypt_AES128CCM(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                                 PacketBuffer *buf, uint8_t *data, uint16_t dataLen, uint8_t *tag)
+{
+    WEAVE_PERF_SCOPE(kSection_MessageEncryption);
+    WEAVE_ERROR err;
+    uint8_t nonce[kAES128CCMNonceLen];
+    uint8_t *p = nonce;
+    uint8_t aad[kMaxAuthenticatedHeaderLen];
+    uint8_t aadLen;
+
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    AES128CCMMode& aes128CCM = msgEncKey->GetKeySchedule_AES128CCM().DataKeySchedule;
+#else
+    AES128CCMMode aes128CCM;
+    aes128CCM.SetKey(msgEncKey->EncKey.AES128CCM.DataKey);
+#endif
+
+    Encoding::BigEndian::Write64(p, msgInfo->SourceNodeId);
+    Encoding::BigEndian::Write32(p, msgInfo->MessageId);
+
+    aadLen = EncodeAuthenticatedHeader(msgInfo, aad);
+
+    err = aes128CCM.Begin(nonce, sizeof(nonce), aad, aadLen, dataLen, kAES128CCMTagLen);
+    if (err != WEAVE_NO_ERROR)
+        return err;
+
+    while (dataLen > 0)
+    {
+        uint8_t *seg = data;
+        uint16_t segLen = NextChainSegment(buf, data, dataLen);
+        aes128CCM.EncryptData(seg, segLen, seg);
+    }
+
+    aes128CCM.Finish(tag);
+
+    return WEAVE_NO_ERROR;
+}
+
+WEAVE_ERROR WeaveMessageLayer::Decrypt_AES128CCM(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                                 PacketBuffer *buf, uint8_t *data, uint16_t dataLen, const uint8_t *tag)
+{
+    WEAVE_PERF_SCOPE(kSection_MessageEncryption);
+    WEAVE_ERROR err;
+    uint8_t nonce[kAES128CCMNonceLen];
+    uint8_t *p = nonce;
+    uint8_t aad[kMaxAuthenticatedHeaderLen];
+    uint8_t aadLen;
+
+#if WEAVE_CONFIG_CACHE_MSG_ENC_KEY_SCHEDULES
+    AES128CCMMode& aes128CCM = msgEncKey->GetKeySchedule_AES128CCM().DataKeySchedule;
+#else
+    AES128CCMMode aes128CCM;
+    aes128CCM.SetKey(msgEncKey->EncKey.AES128CCM.DataKey);
+#endif
+
+    Encoding::BigEndian::Write64(p, msgInfo->SourceNodeId);
+    Encoding::BigEndian::Write32(p, msgInfo->MessageId);
+
+    aadLen = EncodeAuthenticatedHeader(msgInfo, aad);
+
+    err = aes128CCM.Begin(nonce, sizeof(nonce), aad, aadLen, dataLen, kAES128CCMTagLen);
+    if (err != WEAVE_NO_ERROR)
+        return err;
+
+    while (dataLen > 0)
+    {
+        uint8_t *seg = data;
+        uint16_t segLen = NextChainSegment(buf, data, dataLen);
+        aes128CCM.DecryptData(seg, segLen, seg);
+    }
+
+    // Unlike the single buffer form, the decrypted payload is left in place if verification fails; the caller
+    // discards the message.
+    return aes128CCM.FinishDecrypt(tag);
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+/**
+ * Encode the message header fields that are covered by the message integrity check, returning the encoded
+ * length. The buffer must be at least kMaxAuthenticatedHeaderLen bytes.
+ */
+uint8_t WeaveMessageLayer::EncodeAuthenticatedHeader(const WeaveMessageInfo *msgInfo, uint8_t *buf)
+{
+    uint8_t *p = buf;
 
     // Encode the source and destination node identifiers in a little-endian format.
     Encoding::LittleEndian::Write64(p, msgInfo->SourceNodeId);
     Encoding::LittleEndian::Write64(p, msgInfo->DestNodeId);
 
-    // Hash the message header field and the message Id for the message version V2.
+    // Include the message header field and the message Id for the message version V2.
     if (msgInfo->MessageVersion == kWeaveMessageVersion_V2)
     {
         // Encode message header field value.
@@ -2238,14 +2773,7 @@ void WeaveMessageLayer::ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageIn
         Encoding::LittleEndian::Write32(p, msgInfo->MessageId);
     }
 
-    // Hash encoded message header fields.
-    hmacSHA1.AddData(encodedBuf, p - encodedBuf);
-
-    // Handle payload data.
-    hmacSHA1.AddData(inData, inLen);
-
-    // Generate the MAC.
-    hmacSHA1.Finish(outBuf);
+    return (uint8_t)(p - buf);
 }
 
 /**
@@ -140,6 +140,8 @@ typedef enum WeaveMessageFlags
 	kWeaveMessageFlag_FromInitiator                     = 0x00020000, /**< Indicates that the source of the message is the initiator of the
 																		   Weave exchange. */
     kWeaveMessageFlag_ViaEphemeralUDPPort               = 0x00040000, /**< Indicates that message is being sent/received via the local ephemeral UDP port. */
+    kWeaveMessageFlag_DeferUDPSend                      = 0x00080000, /**< Indicates that a unicast UDP message may be queued and sent with others at the end of
+                                                                           the current event loop iteration. */
 
     kWeaveMessageFlag_MulticastFromLinkLocal            = kWeaveMessageFlag_DefaultMulticastSourceAddress,
                                                                       /**< Deprecated alias for \c kWeaveMessageFlag_DefaultMulticastSourceAddress */
@@ -167,8 +169,10 @@ typedef enum WeaveMessageFlags
 typedef enum WeaveEncryptionType
 {
     kWeaveEncryptionType_None                           = 0, /**< Message not encrypted. */
-    kWeaveEncryptionType_AES128CTRSHA1                  = 1  /**< Message encrypted using AES-128-CTR
+    kWeaveEncryptionType_AES128CTRSHA1                  = 1, /**< Message encrypted using AES-128-CTR
                                                                   encryption with HMAC-SHA-1 message integrity. */
+    kWeaveEncryptionType_AES128CCM                      = 2  /**< Message encrypted and authenticated in a single
+                                                                  pass using AES-128-CCM with a 16 byte tag. */
 } WeaveEncryptionType;
 
 /**
@@ -390,6 +394,15 @@ private:
 #if WEAVE_CONFIG_ENABLE_DNS_RESOLVER
     uint8_t mDNSOptions;
 #endif
+#if WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+    struct ConnectAttempt
+    {
+        TCPEndPoint *EndPoint;
+        IPAddress PeerAddr;
+        uint16_t PeerPort;
+    };
+    ConnectAttempt mOtherAttempts[WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS - 1];   /**< Earlier connection attempts still racing the one in mTcpEndPoint. */
+#endif
 
     enum FlagsEnum
     {
@@ -411,6 +424,12 @@ private:
 
     static void HandleResolveComplete(void *appState, INET_ERROR err, uint8_t addrCount, IPAddress *addrArray);
     static void HandleConnectComplete(TCPEndPoint *endPoint, INET_ERROR conRes);
+#if WEAVE_CONFIG_CONNECT_MAX_PARALLEL_ATTEMPTS > 1
+    static void HandleConnectAttemptTimeout(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+    bool HasOtherAttempts(void) const;
+    void AbortOtherAttempts(void);
+    void InterleavePeerAddrs(void);
+#endif
     static void HandleDataReceived(TCPEndPoint *endPoint, PacketBuffer *data);
     static void HandleTcpConnectionClosed(TCPEndPoint *endPoint, INET_ERROR err);
     static void HandleSecureSessionEstablished(WeaveSecurityManager *sm, WeaveConnection *con, void *reqState, uint16_t sessionKeyId, uint64_t peerNodeId, uint8_t encType);
@@ -484,6 +503,20 @@ private:
  *    with other Weave nodes. It employs one of several InetLayer endpoints
  *    to establish a communication channel with other Weave nodes.
  *
+ *  @par Threading and sharding
+ *    A WeaveMessageLayer, together with the System::Layer, InetLayer,
+ *    WeaveFabricState and WeaveExchangeManager it is initialized with,
+ *    forms a shard that must only be used from the thread running that
+ *    System::Layer's event loop.  A process may run several shards, one per
+ *    thread, bound to the same listening address and port: on sockets
+ *    platforms the UDP and TCP listening endpoints are opened with
+ *    SO_REUSEPORT, so the kernel distributes incoming datagrams and
+ *    connections across the shards.  Endpoint and timer objects are drawn
+ *    from process-wide pools but are tagged with their owning layer, and the
+ *    PacketBuffer pool is shared and thread-safe, so buffers may be handed
+ *    between shards.  Any other cross-shard interaction should be posted to
+ *    the target shard with System::Layer::ScheduleWork().
+ *
  */
 class NL_DLL_EXPORT WeaveMessageLayer
 {
@@ -575,6 +608,8 @@ public:
     WEAVE_ERROR SendMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
     WEAVE_ERROR SendMessage(const IPAddress &destAddr, WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
     WEAVE_ERROR SendMessage(const IPAddress &destAddr, uint16_t destPort, InterfaceId sendIntfId, WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
+    WEAVE_ERROR SendMessageToMany(const IPAddress *destAddrs, const uint64_t *destNodeIds, size_t numDests, uint16_t destPort,
+            WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
     WEAVE_ERROR ResendMessage(WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
     WEAVE_ERROR ResendMessage(const IPAddress &destAddr, WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
     WEAVE_ERROR ResendMessage(const IPAddress &destAddr, uint16_t destPort, WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
@@ -788,10 +823,25 @@ private:
     static void HandleIncomingTcpConnection(TCPEndPoint *listeningEndPoint, TCPEndPoint *conEndPoint, const IPAddress &peerAddr,
             uint16_t peerPort);
     static void HandleAcceptError(TCPEndPoint *endPoint, INET_ERROR err);
-    static void Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
+    static void Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
                                       const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
-    static void ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, const uint8_t *key,
+    static void ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
                                                     const uint8_t *inData, uint16_t inLen, uint8_t *outBuf);
+    static WEAVE_ERROR Encrypt_AES128CCM(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                         uint8_t *data, uint16_t dataLen, uint8_t *tag);
+    static WEAVE_ERROR Decrypt_AES128CCM(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                         uint8_t *data, uint16_t dataLen, const uint8_t *tag);
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+    static void Encrypt_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                      PacketBuffer *buf, uint8_t *data, uint16_t dataLen, uint8_t *integrityCheck);
+    static void ComputeIntegrityCheck_AES128CTRSHA1(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                                    PacketBuffer *buf, uint8_t *data, uint16_t dataLen, uint8_t *outBuf);
+    static WEAVE_ERROR Encrypt_AES128CCM(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                         PacketBuffer *buf, uint8_t *data, uint16_t dataLen, uint8_t *tag);
+    static WEAVE_ERROR Decrypt_AES128CCM(const WeaveMessageInfo *msgInfo, WeaveMsgEncryptionKey *msgEncKey,
+                                         PacketBuffer *buf, uint8_t *data, uint16_t dataLen, const uint8_t *tag);
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+    static uint8_t EncodeAuthenticatedHeader(const WeaveMessageInfo *msgInfo, uint8_t *buf);
     static WEAVE_ERROR FilterUDPSendError(WEAVE_ERROR err, bool isMulticast);
     static bool IsIgnoredMulticastSendError(WEAVE_ERROR err);
 
@@ -77,6 +77,7 @@ WeaveSecurityManager::WeaveSecurityManager(void)
 {
     State = kState_NotInitialized;
     mSystemLayer = NULL;
+    mSession = &mSessions[0];
 }
 
 WEAVE_ERROR WeaveSecurityManager::Init(WeaveExchangeManager& aExchangeMgr, System::Layer& aSystemLayer)
@@ -94,17 +95,17 @@ WEAVE_ERROR WeaveSecurityManager::Init(WeaveExchangeManager& aExchangeMgr, Syste
     OnSessionEstablished = NULL;
     OnSessionError = NULL;
     OnKeyErrorMsgRcvd = NULL;
-    mEC = NULL;
-    mCon = NULL;
-#if WEAVE_CONFIG_ENABLE_PASE_INITIATOR || WEAVE_CONFIG_ENABLE_PASE_RESPONDER
-    mPASEEngine = NULL;
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+        InitSession(&mSessions[i]);
+    mSession = &mSessions[0];
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+    mNumQueuedCASERequests = 0;
 #endif
 #if WEAVE_CONFIG_ENABLE_PASE_RESPONDER
     mPASERateLimiterTimeout = 0;
     mPASERateLimiterCount = 0;
 #endif
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
-    mCASEEngine = NULL;
     mDefaultAuthDelegate = NULL;
 #endif
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR
@@ -117,9 +118,6 @@ WEAVE_ERROR WeaveSecurityManager::Init(WeaveExchangeManager& aExchangeMgr, Syste
     ResponderAllowedCASEConfigs = CASE::kCASEAllowedConfig_Config2|CASE::kCASEAllowedConfig_Config1;
     ResponderAllowedCASECurves = WEAVE_CONFIG_DEFAULT_CASE_ALLOWED_CURVES;
 #endif
-#if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR || WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
-    mTAKEEngine = NULL;
-#endif
 #if WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
     mDefaultTAKETokenAuthDelegate = NULL;
 #endif
@@ -127,7 +125,6 @@ WEAVE_ERROR WeaveSecurityManager::Init(WeaveExchangeManager& aExchangeMgr, Syste
     mDefaultTAKEChallengerAuthDelegate = NULL;
 #endif
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-    mKeyExport = NULL;
     InitiatorKeyExportConfig = KeyExport::kKeyExportConfig_Config1;
     InitiatorAllowedKeyExportConfigs = KeyExport::kKeyExportSupportedConfig_All;
 #endif
@@ -140,15 +137,14 @@ WEAVE_ERROR WeaveSecurityManager::Init(WeaveExchangeManager& aExchangeMgr, Syste
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR || WEAVE_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
     mDefaultKeyExportDelegate = NULL;
 #endif
-    mStartSecureSession_OnComplete = NULL;
-    mStartSecureSession_OnError = NULL;
-    mStartSecureSession_ReqState = NULL;
-    mRequestedAuthMode = kWeaveAuthMode_NotSpecified;
-    mSessionKeyId = WeaveKeyId::kNone;
-    mEncType = kWeaveEncryptionType_None;
 
     mFlags = 0;
 
+#if (WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER) && WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+    // Prepare the ephemeral key for the first CASE session.
+    WeaveCASEEngine::PregenerateECDHKey(aSystemLayer, WEAVE_CONFIG_DEFAULT_CASE_CURVE_ID);
+#endif
+
     err = ExchangeManager->RegisterUnsolicitedMessageHandler(kWeaveProfile_Security, HandleUnsolicitedMessage, this);
     SuccessOrExit(err);
 
@@ -179,7 +175,19 @@ WEAVE_ERROR WeaveSecurityManager::Shutdown(void)
 
         // TODO: clean-up in-progress session establishment
 
-        Reset();
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+        mNumQueuedCASERequests = 0;
+#endif
+
+        for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+        {
+            mSession = &mSessions[i];
+            Reset();
+        }
+
+#if (WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER) && WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+        WeaveCASEEngine::ClearPregeneratedECDHKey();
+#endif
 
         State = kState_NotInitialized;
     }
@@ -190,8 +198,11 @@ WEAVE_ERROR WeaveSecurityManager::Shutdown(void)
 void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
         uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
+    SessionContext *session;
 
     // Handle Key Error Messages.
     if (profileId == kWeaveProfile_Security && msgType == kMsgType_KeyError)
@@ -203,8 +214,30 @@ void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const I
         ExitNow();
     }
 
-    // Verify that we don't already have a session establishment in progress.
-    VerifyOrExit(secMgr->State == kState_Idle, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+#if WEAVE_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
+    // Handle messages that requests the secret key export.  A key export request is answered before this call returns
+    // and keeps no state between messages, so it does not take a session; key export requests are served while the
+    // maximum number of sessions are being established, and while other key export requests are being answered.
+    if (profileId == kWeaveProfile_Security && msgType == kMsgType_KeyExportRequest)
+    {
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+        if (!ec->HasPeerRequestedAck())
+#endif
+        {
+            // Reject the request if it did not arrive over a connection.
+            VerifyOrExit(ec->Con != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+        }
+
+        secMgr->HandleKeyExportRequest(ec, pktInfo, msgInfo, msgBuf);
+        msgBuf = NULL;
+        ExitNow();
+    }
+#endif
+
+    // Verify that there is room for another session establishment, and select the session that will handle it.
+    session = secMgr->FindFreeSession();
+    VerifyOrExit(session != NULL, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    secMgr->mSession = session;
 
     WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_SecMgrBusy,
         {
@@ -254,6 +287,15 @@ void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const I
 #endif
     }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESPONDER && WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // Handle messages that mark the beginning of a CASE session resumption...
+    else if (profileId == kWeaveProfile_Security && msgType == kMsgType_CASEResumeSessionRequest)
+    {
+        secMgr->HandleCASEResumeSessionStart(ec, pktInfo, msgInfo, msgBuf);
+        msgBuf = NULL;
+    }
+#endif
+
     // Handle messages that mark the beginning of a TAKE interaction...
     else if (profileId == kWeaveProfile_Security && msgType == kMsgType_TAKEIdentifyToken)
     {
@@ -269,16 +311,13 @@ void WeaveSecurityManager::HandleUnsolicitedMessage(ExchangeContext *ec, const I
 #endif
     }
 
+#if !WEAVE_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
     // Handle messages that requests the secret key export...
     else if (profileId == kWeaveProfile_Security && msgType == kMsgType_KeyExportRequest)
     {
-#if WEAVE_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
-        secMgr->HandleKeyExportRequest(ec, pktInfo, msgInfo, msgBuf);
-        msgBuf = NULL;
-#else
         ExitNow(err = WEAVE_ERROR_NOT_IMPLEMENTED);
-#endif
     }
+#endif
 
     // Reject all other message types.
     else
@@ -320,13 +359,16 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSessionKey *sessionKey;
+    SessionContext *session;
     bool clearStateOnError = false;
 
     // Verify security manager has been initialized.
     VerifyOrExit(State != kState_NotInitialized, err = WEAVE_ERROR_INCORRECT_STATE);
 
-    // Verify there is no session in process.
-    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify there is room for another session.
+    session = FindFreeSession();
+    VerifyOrExit(session != NULL, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    mSession = session;
 
     WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_SecMgrBusy,
         {
@@ -341,14 +383,14 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
     // PASE is not yet supported over WRMP.
     VerifyOrExit(con != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    State = kState_PASEInProgress;
-    mRequestedAuthMode = requestedAuthMode;
-    mEncType = kWeaveEncryptionType_AES128CTRSHA1;
-    mCon = con;
-    mStartSecureSession_OnComplete = onComplete;
-    mStartSecureSession_OnError = onError;
-    mStartSecureSession_ReqState = reqState;
-    mSessionKeyId = WeaveKeyId::kNone;
+    BeginSession(kState_PASEInProgress);
+    mSession->mRequestedAuthMode = requestedAuthMode;
+    mSession->mEncType = WEAVE_CONFIG_DEFAULT_SESSION_ENCRYPTION_TYPE;
+    mSession->mCon = con;
+    mSession->mStartSecureSession_OnComplete = onComplete;
+    mSession->mStartSecureSession_OnError = onError;
+    mSession->mStartSecureSession_ReqState = reqState;
+    mSession->mSessionKeyId = WeaveKeyId::kNone;
 
     // Any error after this point requires call to the Reset() function.
     clearStateOnError = true;
@@ -358,10 +400,10 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
     err = FabricState->AllocSessionKey(con->PeerNodeId, WeaveKeyId::kNone, con, sessionKey);
     SuccessOrExit(err);
     sessionKey->SetLocallyInitiated(true);
-    mSessionKeyId = sessionKey->MsgEncKey.KeyId;
+    mSession->mSessionKeyId = sessionKey->MsgEncKey.KeyId;
 
     // Create a new exchange context.
-    err = NewSessionExchange(mCon->PeerNodeId, mCon->PeerAddr, mCon->PeerPort);
+    err = NewSessionExchange(mSession->mCon->PeerNodeId, mSession->mCon->PeerAddr, mSession->mCon->PeerPort);
     SuccessOrExit(err);
 
     // Initialize Weave platform memory.
@@ -369,15 +411,15 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
     SuccessOrExit(err);
 
     // Allocate and initialize PASE engine object.
-    mPASEEngine = (WeavePASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeavePASEEngine), true);
-    VerifyOrExit(mPASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mPASEEngine->Init();
+    mSession->mPASEEngine = (WeavePASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeavePASEEngine), true);
+    VerifyOrExit(mSession->mPASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    mSession->mPASEEngine->Init();
 
     // Initialize PASE password if provided.
     if (pw != NULL)
     {
-        mPASEEngine->Pw = pw;
-        mPASEEngine->PwLen = pwLen;
+        mSession->mPASEEngine->Pw = pw;
+        mSession->mPASEEngine->PwLen = pwLen;
     }
 
     // Start PASE session.
@@ -386,8 +428,8 @@ WEAVE_ERROR WeaveSecurityManager::StartPASESession(WeaveConnection *con, WeaveAu
 exit:
     if (err != WEAVE_NO_ERROR && clearStateOnError)
     {
-        if (mSessionKeyId != WeaveKeyId::kNone)
-            FabricState->RemoveSessionKey(mSessionKeyId, con->PeerNodeId);
+        if (mSession->mSessionKeyId != WeaveKeyId::kNone)
+            FabricState->RemoveSessionKey(mSession->mSessionKeyId, con->PeerNodeId);
 
         Reset();
     }
@@ -397,13 +439,15 @@ exit:
 
 void WeaveSecurityManager::StartPASESession(void)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err;
 
     err = SendPASEInitiatorStep1(kPASEConfig_ConfigDefault);
     SuccessOrExit(err);
 
-    mEC->OnMessageReceived = HandlePASEMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    mSession->mEC->OnMessageReceived = HandlePASEMessageInitiator;
+    mSession->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Time limit overall PASE duration.
     StartSessionTimer();
@@ -416,10 +460,13 @@ exit:
 void WeaveSecurityManager::HandlePASEMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
         uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    secMgr->mSession = secMgr->FindSession(ec);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the PASE interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -486,7 +533,7 @@ void WeaveSecurityManager::HandlePASEMessageInitiator(ExchangeContext *ec, const
         err = secMgr->SendPASEInitiatorStep2();
         SuccessOrExit(err);
 
-        if (secMgr->mPASEEngine->State == WeavePASEEngine::kState_InitiatorDone)
+        if (secMgr->mSession->mPASEEngine->State == WeavePASEEngine::kState_InitiatorDone)
         {
             err = secMgr->HandleSessionEstablished();
             SuccessOrExit(err);
@@ -533,16 +580,16 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEInitiatorStep1(uint32_t paseConfig)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     // Extract the password source from the requested auth mode.
-    pwSource = PasswordSourceFromAuthMode(mRequestedAuthMode);
+    pwSource = PasswordSourceFromAuthMode(mSession->mRequestedAuthMode);
 
     // Generate and encode PASE step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateInitiatorStep1(msgBuf, paseConfig, FabricState->LocalNodeId, mEC->PeerNodeId, mSessionKeyId, kWeaveEncryptionType_AES128CTRSHA1, pwSource, FabricState, true);
+    err = mSession->mPASEEngine->GenerateInitiatorStep1(msgBuf, paseConfig, FabricState->LocalNodeId, mSession->mEC->PeerNodeId, mSession->mSessionKeyId, mSession->mEncType, pwSource, FabricState, true);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 1 message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEInitiatorStep1, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEInitiatorStep1, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -558,7 +605,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderReconfigure(PacketBuffer*
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Decode and process the responder's reconfigure message.
-    err = mPASEEngine->ProcessResponderReconfigure(msgBuf, newConfig);
+    err = mSession->mPASEEngine->ProcessResponderReconfigure(msgBuf, newConfig);
     SuccessOrExit(err);
 
 exit:
@@ -572,7 +619,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderStep1(PacketBuffer* msgBuf
 
     // Decode and process the responder's step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessResponderStep1(msgBuf);
+    err = mSession->mPASEEngine->ProcessResponderStep1(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -587,7 +634,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderStep2(PacketBuffer* msgBuf
 
     // Decode and process the responder's step 2 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessResponderStep2(msgBuf);
+    err = mSession->mPASEEngine->ProcessResponderStep2(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -607,12 +654,12 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEInitiatorStep2(void)
 
     // Generate and encode PASE step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateInitiatorStep2(msgBuf);
+    err = mSession->mPASEEngine->GenerateInitiatorStep2(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 2 message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEInitiatorStep2, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEInitiatorStep2, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -628,7 +675,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessPASEResponderKeyConfirm(PacketBuffer* m
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Decode and process the responder's key confirmation message.
-    err = mPASEEngine->ProcessResponderKeyConfirm(msgBuf);
+    err = mSession->mPASEEngine->ProcessResponderKeyConfirm(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -653,9 +700,9 @@ void WeaveSecurityManager::HandlePASESessionStart(ExchangeContext *ec, const IPP
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Setup state for the new PASE exchange.
-    State = kState_PASEInProgress;
-    mEC = ec;
-    mCon = ec->Con;
+    BeginSession(kState_PASEInProgress);
+    mSession->mEC = ec;
+    mSession->mCon = ec->Con;
     ec->OnMessageReceived = HandlePASEMessageResponder;
     ec->OnConnectionClosed = HandleConnectionClosed;
 
@@ -672,9 +719,9 @@ void WeaveSecurityManager::HandlePASESessionStart(ExchangeContext *ec, const IPP
     SuccessOrExit(err);
 
     // Prepare PASE engine and start session
-    mPASEEngine = (WeavePASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeavePASEEngine), true);
-    VerifyOrExit(mPASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mPASEEngine->Init();
+    mSession->mPASEEngine = (WeavePASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeavePASEEngine), true);
+    VerifyOrExit(mSession->mPASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    mSession->mPASEEngine->Init();
 
     err = ProcessPASEInitiatorStep1(ec, msgBuf);
 
@@ -712,10 +759,13 @@ exit:
 void WeaveSecurityManager::HandlePASEMessageResponder(ExchangeContext *ec, const IPPacketInfo *pktInfo,
         const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    secMgr->mSession = secMgr->FindSession(ec);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the PASE interaction immediately if we receive a status report message from the initiator.
     // This is a signal that the initiator does not want to continue.
@@ -734,14 +784,14 @@ void WeaveSecurityManager::HandlePASEMessageResponder(ExchangeContext *ec, const
     msgBuf = NULL;
 
     // If performing key confirmation send a responder key confirmation message.
-    if (secMgr->mPASEEngine->PerformKeyConfirmation)
+    if (secMgr->mSession->mPASEEngine->PerformKeyConfirmation)
     {
         err = secMgr->SendPASEResponderKeyConfirm();
         SuccessOrExit(err);
     }
 
     // If we've successfully establish a session, go perform the appropriate actions.
-    if (secMgr->mPASEEngine->State == WeavePASEEngine::kState_ResponderDone)
+    if (secMgr->mSession->mPASEEngine->State == WeavePASEEngine::kState_ResponderDone)
     {
         err = secMgr->HandleSessionEstablished();
         SuccessOrExit(err);
@@ -764,7 +814,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessPASEInitiatorStep1(ExchangeContext *ec,
 
     // Generate and encode PASE step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessInitiatorStep1(msgBuf, FabricState->LocalNodeId, ec->PeerNodeId, FabricState);
+    err = mSession->mPASEEngine->ProcessInitiatorStep1(msgBuf, FabricState->LocalNodeId, ec->PeerNodeId, FabricState);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -774,14 +824,14 @@ WEAVE_ERROR WeaveSecurityManager::ProcessPASEInitiatorStep1(ExchangeContext *ec,
     //
     // If the initiator has proposed a key id that already exists, make sure we don't remove the
     // existing key during the error clean-up process.
-    err = FabricState->AllocSessionKey(ec->PeerNodeId, mPASEEngine->SessionKeyId, ec->Con, sessionKey);
+    err = FabricState->AllocSessionKey(ec->PeerNodeId, mSession->mPASEEngine->SessionKeyId, ec->Con, sessionKey);
     SuccessOrExit(err);
     sessionKey->SetLocallyInitiated(false);
     sessionKey->SetRemoveOnIdle(false); // TODO FUTURE: Set this to true when support for PASE over WRM is implemented.
 
     // Save the proposed session key id and encryption type.
-    mSessionKeyId = mPASEEngine->SessionKeyId;
-    mEncType = mPASEEngine->EncryptionType;
+    mSession->mSessionKeyId = mSession->mPASEEngine->SessionKeyId;
+    mSession->mEncType = mSession->mPASEEngine->EncryptionType;
 
 exit:
     return err;
@@ -798,11 +848,11 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEResponderReconfigure(void)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     // Generate PASE reconfigure message.
-    err = mPASEEngine->GenerateResponderReconfigure(msgBuf);
+    err = mSession->mPASEEngine->GenerateResponderReconfigure(msgBuf);
     SuccessOrExit(err);
 
     // Send PASE reconfigure message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderReconfigure, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderReconfigure, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -824,12 +874,12 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEResponderStep1(void)
 
     // Generate PASE step 1 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateResponderStep1(msgBuf);
+    err = mSession->mPASEEngine->GenerateResponderStep1(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 1 message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderStep1, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderStep1, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -851,12 +901,12 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEResponderStep2(void)
 
     // Generate PASE step 2 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->GenerateResponderStep2(msgBuf);
+    err = mSession->mPASEEngine->GenerateResponderStep2(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
     // Send PASE step 2 message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderStep2, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderStep2, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -873,7 +923,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessPASEInitiatorStep2(PacketBuffer* msgBuf
 
     // Decode and process the initiator's step 2 message.
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mPASEEngine->ProcessInitiatorStep2(msgBuf);
+    err = mSession->mPASEEngine->ProcessInitiatorStep2(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -892,11 +942,11 @@ WEAVE_ERROR WeaveSecurityManager::SendPASEResponderKeyConfirm(void)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     // Generate and encode a key confirmation message.
-    err = mPASEEngine->GenerateResponderKeyConfirm(msgBuf);
+    err = mSession->mPASEEngine->GenerateResponderKeyConfirm(msgBuf);
     SuccessOrExit(err);
 
     // Send a key confirmation message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderKeyConfirm, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_PASEResponderKeyConfirm, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -929,7 +979,18 @@ exit:
  *                                When this input is different from kNodeIdNotSpecified that
  *                                indicates that shared secure session was requested.
  *
+ * If #WEAVE_CONFIG_ENABLE_CASE_RESUMPTION is enabled and a resumption ticket is held for the peer
+ * (or the terminating node) whose authentication mode satisfies the request, the session is
+ * resumed from the ticket, falling back to a full CASE exchange if the peer rejects the ticket.
+ *
+ * If #WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS sessions are already being established,
+ * the request is held and started once a session completes, provided that
+ * #WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS allows it and no other request to the same
+ * peer is already held.  Otherwise #WEAVE_ERROR_SECURITY_MANAGER_BUSY is returned.
+ *
  * @retval #WEAVE_NO_ERROR         On success.
+ * @retval #WEAVE_ERROR_SECURITY_MANAGER_BUSY
+ *                                 If no more sessions can be established, or held, at this time.
  *
  */
 WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_t peerNodeId, const IPAddress &peerAddr,
@@ -939,9 +1000,10 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSessionKey *sessionKey = NULL;
+    SessionContext *session = NULL;
     bool clearStateOnError = false;
     bool isSharedSession = (terminatingNodeId != kNodeIdNotSpecified);
-    const uint8_t encType = kWeaveEncryptionType_AES128CTRSHA1; // Only one encryption type supported for now.
+    const uint8_t encType = WEAVE_CONFIG_DEFAULT_SESSION_ENCRYPTION_TYPE;
 
     // Verify security manager has been initialized.
     VerifyOrExit(State != kState_NotInitialized, err = WEAVE_ERROR_INCORRECT_STATE);
@@ -962,11 +1024,11 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
             // the initiator has sent a KeyConfirm message it waits for a WRM ACK from the responder.
             // During this time, the session exists in the session table but is not yet considered
             // ready for use.  Until the ACK is received, additional requests to establish the same
-            // shared session should be denied with a SECURITY_MANAGER_BUSY error, which will force
-            // the concurrent request to wait until the session is fully established.
+            // shared session should be denied with a SECURITY_MANAGER_BUSY error (or queued), which
+            // will force the concurrent request to wait until the session is fully established.
             //
             // If the located shared session is NOT in the process of being established...
-            if (State != kState_CASEInProgress || mEC->PeerNodeId != terminatingNodeId || mSessionKeyId != sessionKey->MsgEncKey.KeyId)
+            if (!IsCASESessionInProgress(terminatingNodeId, sessionKey->MsgEncKey.KeyId))
             {
                 // Add a new end node to the list of end nodes associated with the session.
                 err = FabricState->AddSharedSessionEndNode(sessionKey, peerNodeId);
@@ -981,10 +1043,25 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
                 ExitNow();
             }
         }
+        else
+            session = FindFreeSession();
     }
+    else
+        session = FindFreeSession();
 
-    // Verify there is no session in process.
-    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    // If there is no room for another session, or the requested shared session is still being established, hold
+    // the request until the security manager becomes available, or fail it if there is no room to hold it.
+    if (session == NULL)
+    {
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+        err = QueueCASERequest(con, peerNodeId, peerAddr, peerPort, requestedAuthMode, reqState, onComplete, onError,
+                               authDelegate, terminatingNodeId);
+        ExitNow();
+#else
+        ExitNow(err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+#endif
+    }
+    mSession = session;
 
     WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_SecMgrBusy,
         {
@@ -992,14 +1069,14 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
             ExitNow(err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
         });
 
-    State = kState_CASEInProgress;
-    mRequestedAuthMode = requestedAuthMode;
-    mEncType = encType;
-    mCon = con;
-    mStartSecureSession_OnComplete = onComplete;
-    mStartSecureSession_OnError = onError;
-    mStartSecureSession_ReqState = reqState;
-    mSessionKeyId = WeaveKeyId::kNone;
+    BeginSession(kState_CASEInProgress);
+    mSession->mRequestedAuthMode = requestedAuthMode;
+    mSession->mEncType = encType;
+    mSession->mCon = con;
+    mSession->mStartSecureSession_OnComplete = onComplete;
+    mSession->mStartSecureSession_OnError = onError;
+    mSession->mStartSecureSession_ReqState = reqState;
+    mSession->mSessionKeyId = WeaveKeyId::kNone;
 
     // Any error after that would require state clearing in case of error.
     clearStateOnError = true;
@@ -1011,7 +1088,7 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
     SuccessOrExit(err);
     sessionKey->SetLocallyInitiated(true);
     sessionKey->SetSharedSession(isSharedSession);
-    mSessionKeyId = sessionKey->MsgEncKey.KeyId;
+    mSession->mSessionKeyId = sessionKey->MsgEncKey.KeyId;
 
     // If requested session is shared.
     if (isSharedSession)
@@ -1030,25 +1107,39 @@ WEAVE_ERROR WeaveSecurityManager::StartCASESession(WeaveConnection *con, uint64_
     SuccessOrExit(err);
 
     // Allocate and Initialize CASE Engine object
-    mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
-    VerifyOrExit(mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mCASEEngine->Init();
+    mSession->mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
+    VerifyOrExit(mSession->mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    mSession->mCASEEngine->Init();
 
     // Initialize CASE Authentication Delegate
     if (authDelegate == NULL)
         authDelegate = mDefaultAuthDelegate;
     VerifyOrExit(authDelegate != NULL, err = WEAVE_ERROR_NO_CASE_AUTH_DELEGATE);
-    mCASEEngine->AuthDelegate = authDelegate;
+    mSession->mCASEEngine->AuthDelegate = authDelegate;
 
     // Set the allowed CASE configs and ECDH curves.
-    mCASEEngine->SetAllowedConfigs(InitiatorAllowedCASEConfigs);
-    mCASEEngine->SetAllowedCurves(InitiatorAllowedCASECurves);
+    mSession->mCASEEngine->SetAllowedConfigs(InitiatorAllowedCASEConfigs);
+    mSession->mCASEEngine->SetAllowedCurves(InitiatorAllowedCASECurves);
 
     // Set the expected peer certificate type based on the requested authentication mode.
-    mCASEEngine->SetCertType(CertTypeFromAuthMode(requestedAuthMode));
+    mSession->mCASEEngine->SetCertType(CertTypeFromAuthMode(requestedAuthMode));
 
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
-    mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
+    mSession->mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
+#endif
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // Resume a previous session with the peer if a ticket for it satisfies the requested authentication mode.
+    {
+        const WeaveCASEResumptionTicket *ticket = FabricState->FindCASEResumptionTicket(mSession->mEC->PeerNodeId);
+
+        if (ticket != NULL &&
+            (requestedAuthMode == kWeaveAuthMode_CASE_AnyCert || CASEAuthMode(ticket->CertType) == requestedAuthMode))
+        {
+            StartCASEResumption(*ticket);
+            ExitNow();
+        }
+    }
 #endif
 
     // Start CASE Session using specified initiator parameters.
@@ -1068,6 +1159,8 @@ exit:
 
 void WeaveSecurityManager::StartCASESession(uint32_t config, uint32_t curveId)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err;
     PacketBuffer * msgBuf = NULL;
     uint16_t sendFlags = 0;
@@ -1082,35 +1175,83 @@ void WeaveSecurityManager::StartCASESession(uint32_t config, uint32_t curveId)
 
         reqCtx.Reset();
         reqCtx.SetIsInitiator(true);
-        reqCtx.PeerNodeId = mEC->PeerNodeId;
+        reqCtx.PeerNodeId = mSession->mEC->PeerNodeId;
         reqCtx.ProtocolConfig = config;
-        mCASEEngine->SetAlternateConfigs(reqCtx);
+        mSession->mCASEEngine->SetAlternateConfigs(reqCtx);
         reqCtx.CurveId = curveId;
-        mCASEEngine->SetAlternateCurves(reqCtx);
+        mSession->mCASEEngine->SetAlternateCurves(reqCtx);
         reqCtx.SetPerformKeyConfirm(true);
-        reqCtx.SessionKeyId = mSessionKeyId;
-        reqCtx.EncryptionType = mEncType;
+        reqCtx.SessionKeyId = mSession->mSessionKeyId;
+        reqCtx.EncryptionType = mSession->mEncType;
 
         Platform::Security::OnTimeConsumingCryptoStart();
-        err = mCASEEngine->GenerateBeginSessionRequest(reqCtx, msgBuf);
+        err = mSession->mCASEEngine->GenerateBeginSessionRequest(reqCtx, msgBuf);
         Platform::Security::OnTimeConsumingCryptoDone();
         SuccessOrExit(err);
     }
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (mSession->mCon == NULL)
+    {
+        sendFlags = ExchangeContext::kSendFlag_RequestAck;
+    }
+#endif
+
+    // Send the message.
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEBeginSessionRequest, msgBuf, sendFlags);
+    msgBuf = NULL;
+    SuccessOrExit(err);
+
+#if WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+    // Replace the ephemeral key just used, while waiting for the peer's response.
+    WeaveCASEEngine::PregenerateECDHKey(*mSystemLayer, mSession->mCASEEngine->SelectedCurve());
+#endif
+
+    mSession->mEC->OnMessageReceived = HandleCASEMessageInitiator;
+    mSession->mEC->OnConnectionClosed = HandleConnectionClosed;
+
+    // Time limit overall CASE duration.
+    StartSessionTimer();
+
+exit:
+    if (msgBuf != NULL)
+        PacketBuffer::Free(msgBuf);
+    if (err != WEAVE_NO_ERROR)
+        HandleSessionError(err, NULL);
+}
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+void WeaveSecurityManager::StartCASEResumption(const WeaveCASEResumptionTicket& ticket)
+{
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
+    WEAVE_ERROR err;
+    PacketBuffer * msgBuf = NULL;
+    uint16_t sendFlags = 0;
+
+    // Allocate a buffer to hold the Resume Session message.
+    msgBuf = PacketBuffer::New();
+    VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    // Generate the CASE Resume Session message.
+    err = mSession->mCASEEngine->GenerateResumeSessionRequest(ticket, mSession->mSessionKeyId, mSession->mEncType, msgBuf);
+    SuccessOrExit(err);
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    if (mSession->mCon == NULL)
     {
         sendFlags = ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
     // Send the message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEBeginSessionRequest, msgBuf, sendFlags);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEResumeSessionRequest, msgBuf, sendFlags);
     msgBuf = NULL;
     SuccessOrExit(err);
 
-    mEC->OnMessageReceived = HandleCASEMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    mSession->mEC->OnMessageReceived = HandleCASEMessageInitiator;
+    mSession->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Time limit overall CASE duration.
     StartSessionTimer();
@@ -1122,14 +1263,49 @@ exit:
         HandleSessionError(err, NULL);
 }
 
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo,
         const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
     uint16_t sendFlags = 0;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    secMgr->mSession = secMgr->FindSession(ec);
+    VerifyOrDie(secMgr->mSession != NULL);
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // If the responder rejected an attempt to resume a session for any reason other than being busy, discard the
+    // ticket and fall back to a full CASE exchange.
+    if (profileId == kWeaveProfile_Common && msgType == kMsgType_StatusReport &&
+        secMgr->mSession->mCASEEngine->State == CASE::WeaveCASEEngine::kState_ResumeRequestGenerated)
+    {
+        StatusReport statusReport;
+
+        if (StatusReport::parse(msgBuf, statusReport) == WEAVE_NO_ERROR &&
+            !(statusReport.mProfileId == kWeaveProfile_Common && statusReport.mStatusCode == kStatus_Busy))
+        {
+            WeaveLogProgress(SecurityManager, "CASE resumption rejected; starting full CASE");
+
+            PacketBuffer::Free(msgBuf);
+            msgBuf = NULL;
+
+            secMgr->FabricState->RemoveCASEResumptionTicket(ec->PeerNodeId);
+            secMgr->mSession->mCASEEngine->AbandonResumption();
+            secMgr->mSession->mCASEEngine->SetCertType(CertTypeFromAuthMode(secMgr->mSession->mRequestedAuthMode));
+
+            // As with a Reconfigure, the peer believes the exchange has ended, so a new one is needed.
+            err = secMgr->NewSessionExchange(ec->PeerNodeId, ec->PeerAddr, ec->PeerPort);
+            SuccessOrExit(err);
+
+            secMgr->StartCASESession(secMgr->InitiatorCASEConfig, secMgr->InitiatorCASECurveId);
+            ExitNow();
+        }
+    }
+#endif
 
     // Abort the CASE interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -1145,7 +1321,7 @@ void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
         // Flush any pending WRM ACKs before we begin the long crypto operation,
         // to prevent the peer from re-transmitting the Begin Session response.
-        err = secMgr->mEC->WRMPFlushAcks();
+        err = secMgr->mSession->mEC->WRMPFlushAcks();
         SuccessOrExit(err);
 #endif
 
@@ -1159,7 +1335,7 @@ void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const
             respCtx.MsgInfo = msgInfo;
 
             Platform::Security::OnTimeConsumingCryptoStart();
-            err = secMgr->mCASEEngine->ProcessBeginSessionResponse(msgBuf, respCtx);
+            err = secMgr->mSession->mCASEEngine->ProcessBeginSessionResponse(msgBuf, respCtx);
             Platform::Security::OnTimeConsumingCryptoDone();
             SuccessOrExit(err);
         }
@@ -1169,23 +1345,23 @@ void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const
         msgBuf = NULL;
 
         // If performing key confirmation...
-        if (secMgr->mCASEEngine->PerformingKeyConfirm())
+        if (secMgr->mSession->mCASEEngine->PerformingKeyConfirm())
         {
             // Generate and encode an InitiatorKeyConfirm message.
             msgBuf = PacketBuffer::New();
             VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
-            err = secMgr->mCASEEngine->GenerateInitiatorKeyConfirm(msgBuf);
+            err = secMgr->mSession->mCASEEngine->GenerateInitiatorKeyConfirm(msgBuf);
             SuccessOrExit(err);
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-            if (secMgr->mCon == NULL)
+            if (secMgr->mSession->mCon == NULL)
             {
                 sendFlags = ExchangeContext::kSendFlag_RequestAck;
             }
 #endif
 
             // Send the InitiatorKeyConfirm message to the peer.
-            err = secMgr->mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEInitiatorKeyConfirm, msgBuf, sendFlags);
+            err = secMgr->mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_CASEInitiatorKeyConfirm, msgBuf, sendFlags);
             msgBuf = NULL;
             SuccessOrExit(err);
         }
@@ -1201,8 +1377,8 @@ void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const
         // For WRMP when key confirmation is required, the session will be completed
         // on one of these events:
         //     - Received Ack from the peer for the last message on this exchange (CASEInitiatorKeyConfirm)
-        //     - Received first message from the peer encrypted with established session key (mSessionKeyId)
-        if (secMgr->mCon || !secMgr->mCASEEngine->PerformingKeyConfirm())
+        //     - Received first message from the peer encrypted with established session key (mSession->mSessionKeyId)
+        if (secMgr->mSession->mCon || !secMgr->mSession->mCASEEngine->PerformingKeyConfirm())
 #endif
         {
             secMgr->HandleSessionComplete();
@@ -1215,7 +1391,7 @@ void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const
         // Process the reconfigure message.  If this proposed alternate configuration is not acceptable,
         // the call will fail with an error.
         CASE::ReconfigureContext reconfCtx;
-        err = secMgr->mCASEEngine->ProcessReconfigure(msgBuf, reconfCtx);
+        err = secMgr->mSession->mCASEEngine->ProcessReconfigure(msgBuf, reconfCtx);
         SuccessOrExit(err);
 
         // Release the buffer containing the response.
@@ -1232,6 +1408,27 @@ void WeaveSecurityManager::HandleCASEMessageInitiator(ExchangeContext *ec, const
         secMgr->StartCASESession(reconfCtx.ProtocolConfig, reconfCtx.CurveId);
     }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    // Otherwise, if the message is a ResumeSessionResponse...
+    else if (msgType == kMsgType_CASEResumeSessionResponse)
+    {
+        // Verify the response and derive the keys for the resumed session.
+        err = secMgr->mSession->mCASEEngine->ProcessResumeSessionResponse(msgBuf);
+        SuccessOrExit(err);
+
+        // Release the buffer containing the response.
+        PacketBuffer::Free(msgBuf);
+        msgBuf = NULL;
+
+        // Initialize the newly established security session.
+        err = secMgr->HandleSessionEstablished();
+        SuccessOrExit(err);
+
+        // The response proves that the responder holds the session keys, so the session is complete.
+        secMgr->HandleSessionComplete();
+    }
+#endif
+
     // Fail if the message is unrecognized.
     else
         ExitNow(err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
@@ -1266,9 +1463,9 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
     PacketBuffer * respMsgBuf = NULL;
     uint16_t sendFlags = 0;
 
-    State = kState_CASEInProgress;
-    mEC = ec;
-    mCon = ec->Con;
+    BeginSession(kState_CASEInProgress);
+    mSession->mEC = ec;
+    mSession->mCon = ec->Con;
     ec->OnMessageReceived = HandleCASEMessageResponder;
     ec->OnConnectionClosed = HandleConnectionClosed;
 
@@ -1276,14 +1473,14 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
     ec->AddRef();
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (mSession->mCon == NULL)
     {
-        mEC->OnAckRcvd = WRMPHandleAckRcvd;
-        mEC->OnSendError = WRMPHandleSendError;
+        mSession->mEC->OnAckRcvd = WRMPHandleAckRcvd;
+        mSession->mEC->OnSendError = WRMPHandleSendError;
 
         // Flush any pending WRM ACKs before we begin the long crypto operation,
         // to prevent the peer from re-transmitting the Begin Session request.
-        err = mEC->WRMPFlushAcks();
+        err = mSession->mEC->WRMPFlushAcks();
         SuccessOrExit(err);
 
         sendFlags |= ExchangeContext::kSendFlag_RequestAck;
@@ -1295,22 +1492,22 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
     SuccessOrExit(err);
 
     // Allocate and initialize a CASE engine.
-    mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
-    VerifyOrExit(mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mCASEEngine->Init();
+    mSession->mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
+    VerifyOrExit(mSession->mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    mSession->mCASEEngine->Init();
 
     // Since this session is being initiated by a remote node, use the default auth delegate.
     // Reject the request if no auth delegate has been set.
     VerifyOrExit(mDefaultAuthDelegate != NULL, err = WEAVE_ERROR_NO_CASE_AUTH_DELEGATE);
-    mCASEEngine->AuthDelegate = mDefaultAuthDelegate;
+    mSession->mCASEEngine->AuthDelegate = mDefaultAuthDelegate;
 
     // Set the allowed protocol options for a responder.
-    mCASEEngine->SetAllowedConfigs(ResponderAllowedCASEConfigs);
-    mCASEEngine->SetAllowedCurves(ResponderAllowedCASECurves);
-    mCASEEngine->SetResponderRequiresKeyConfirm(true);
+    mSession->mCASEEngine->SetAllowedConfigs(ResponderAllowedCASEConfigs);
+    mSession->mCASEEngine->SetAllowedCurves(ResponderAllowedCASECurves);
+    mSession->mCASEEngine->SetResponderRequiresKeyConfirm(true);
 
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
-    mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
+    mSession->mCASEEngine->SetUseKnownECDHKey(CASEUseKnownECDHKey);
 #endif
 
     // Process the BeginSessionRequest
@@ -1319,7 +1516,7 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
     reqCtx.MsgInfo = msgInfo;
     reconfCtx.Reset();
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mCASEEngine->ProcessBeginSessionRequest(msgBuf, reqCtx, reconfCtx);
+    err = mSession->mCASEEngine->ProcessBeginSessionRequest(msgBuf, reqCtx, reconfCtx);
     Platform::Security::OnTimeConsumingCryptoDone();
     if (err != WEAVE_ERROR_CASE_RECONFIG_REQUIRED)
         SuccessOrExit(err);
@@ -1360,8 +1557,8 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
         sessionKey->SetRemoveOnIdle(true);
 
         // Save the proposed session key id and encryption type.
-        mSessionKeyId = reqCtx.SessionKeyId;
-        mEncType = reqCtx.EncryptionType;
+        mSession->mSessionKeyId = reqCtx.SessionKeyId;
+        mSession->mEncType = reqCtx.EncryptionType;
 
         // Allocate a buffer to hold the encoded BeginSessionResponse message.
         respMsgBuf = PacketBuffer::New();
@@ -1379,7 +1576,7 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
             respCtx.SetPerformKeyConfirm(true);
 
             Platform::Security::OnTimeConsumingCryptoStart();
-            err = mCASEEngine->GenerateBeginSessionResponse(respCtx, respMsgBuf, reqCtx);
+            err = mSession->mCASEEngine->GenerateBeginSessionResponse(respCtx, respMsgBuf, reqCtx);
             Platform::Security::OnTimeConsumingCryptoDone();
             SuccessOrExit(err);
         }
@@ -1389,12 +1586,17 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
         respMsgBuf = NULL;
         SuccessOrExit(err);
 
+#if WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+        // Replace the ephemeral key just used, while waiting for the peer's key confirmation.
+        WeaveCASEEngine::PregenerateECDHKey(*mSystemLayer, mSession->mCASEEngine->SelectedCurve());
+#endif
+
         // Start a timer to limit the overall duration of session establishment.
         StartSessionTimer();
 
         // If the CASE interaction is complete...
         // (NOTE: this will only be true if the initiator didn't request key confirmation).
-        if (mCASEEngine->State == CASE::WeaveCASEEngine::kState_Complete)
+        if (mSession->mCASEEngine->State == CASE::WeaveCASEEngine::kState_Complete)
         {
             // Initialize the new session.
             err = HandleSessionEstablished();
@@ -1404,8 +1606,8 @@ void WeaveSecurityManager::HandleCASESessionStart(ExchangeContext *ec, const IPP
             // 1. Complete the session now if it was established over a connection.
             // 2. For WRMP the session will be completed on one of these events:
             //     - Received Ack from the peer for the last message on this exchange (CASEBeginSessionResponse)
-            //     - Received first message from the peer encrypted with established session key (mSessionKeyId)
-            if (mCon)
+            //     - Received first message from the peer encrypted with established session key (mSession->mSessionKeyId)
+            if (mSession->mCon)
 #endif
             {
                 HandleSessionComplete();
@@ -1422,13 +1624,117 @@ exit:
         PacketBuffer::Free(respMsgBuf);
 }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+void WeaveSecurityManager::HandleCASEResumeSessionStart(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
+        PacketBuffer* msgBuf)
+{
+    WEAVE_ERROR err;
+    WeaveSessionKey * sessionKey;
+    const WeaveCASEResumptionTicket * ticket;
+    PacketBuffer * respMsgBuf = NULL;
+    uint16_t sendFlags = 0;
+
+    BeginSession(kState_CASEInProgress);
+    mSession->mEC = ec;
+    mSession->mCon = ec->Con;
+    ec->OnMessageReceived = HandleCASEMessageResponder;
+    ec->OnConnectionClosed = HandleConnectionClosed;
+
+    // Ensure the exchange context stays around until we're done with it.
+    ec->AddRef();
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    if (mSession->mCon == NULL)
+    {
+        mSession->mEC->OnAckRcvd = WRMPHandleAckRcvd;
+        mSession->mEC->OnSendError = WRMPHandleSendError;
+
+        sendFlags |= ExchangeContext::kSendFlag_RequestAck;
+    }
+#endif
+
+    // Reject the request if no ticket is held for the peer. The initiator will fall back to a full CASE exchange.
+    ticket = FabricState->FindCASEResumptionTicket(ec->PeerNodeId);
+    VerifyOrExit(ticket != NULL, err = WEAVE_ERROR_CASE_RESUMPTION_TICKET_NOT_FOUND);
+
+    // Initialize Weave Platform Memory
+    err = Platform::Security::MemoryInit();
+    SuccessOrExit(err);
+
+    // Allocate and initialize a CASE engine.
+    mSession->mCASEEngine = (WeaveCASEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveCASEEngine), true);
+    VerifyOrExit(mSession->mCASEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    mSession->mCASEEngine->Init();
+
+    // Verify the request against the ticket.
+    err = mSession->mCASEEngine->ProcessResumeSessionRequest(msgBuf, *ticket);
+    SuccessOrExit(err);
+
+    // Discard the request buffer.
+    PacketBuffer::Free(msgBuf);
+    msgBuf = NULL;
+
+    // Allocate an entry in the session key table using the key id proposed by the peer, as for a full CASE exchange.
+    err = FabricState->AllocSessionKey(ec->PeerNodeId, mSession->mCASEEngine->SessionKeyId, ec->Con, sessionKey);
+    SuccessOrExit(err);
+    sessionKey->SetLocallyInitiated(false);
+    sessionKey->SetRemoveOnIdle(true);
+
+    // Save the proposed session key id and encryption type.
+    mSession->mSessionKeyId = mSession->mCASEEngine->SessionKeyId;
+    mSession->mEncType = mSession->mCASEEngine->EncryptionType;
+
+    // Generate the ResumeSessionResponse message, deriving the keys for the resumed session.
+    respMsgBuf = PacketBuffer::New();
+    VerifyOrExit(respMsgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    err = mSession->mCASEEngine->GenerateResumeSessionResponse(respMsgBuf);
+    SuccessOrExit(err);
+
+    // Send the ResumeSessionResponse message to the peer.
+    err = ec->SendMessage(kWeaveProfile_Security, kMsgType_CASEResumeSessionResponse, respMsgBuf, sendFlags);
+    respMsgBuf = NULL;
+    SuccessOrExit(err);
+
+    // Start a timer to limit the overall duration of session establishment.
+    StartSessionTimer();
+
+    // Initialize the new session.  This also replaces the ticket with the one derived for the new session.
+    err = HandleSessionEstablished();
+    SuccessOrExit(err);
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    // 1. Complete the session now if it was established over a connection.
+    // 2. For WRMP the session will be completed on one of these events:
+    //     - Received Ack from the peer for the last message on this exchange (CASEResumeSessionResponse)
+    //     - Received first message from the peer encrypted with established session key (mSession->mSessionKeyId)
+    if (mSession->mCon)
+#endif
+    {
+        HandleSessionComplete();
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        HandleSessionError(err, NULL);
+    if (msgBuf != NULL)
+        PacketBuffer::Free(msgBuf);
+    if (respMsgBuf != NULL)
+        PacketBuffer::Free(respMsgBuf);
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 void WeaveSecurityManager::HandleCASEMessageResponder(ExchangeContext *ec, const IPPacketInfo *pktInfo,
         const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    secMgr->mSession = secMgr->FindSession(ec);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the CASE interaction immediately if we receive a status report message from the initiator.
     // This is a signal that the initiator does not want to continue.
@@ -1442,13 +1748,13 @@ void WeaveSecurityManager::HandleCASEMessageResponder(ExchangeContext *ec, const
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     // Flush any pending WRM ACKs to give sooner notification to the peer that current
     // CASE session establishment can be finalized.
-    err = secMgr->mEC->WRMPFlushAcks();
+    err = secMgr->mSession->mEC->WRMPFlushAcks();
     SuccessOrExit(err);
 #endif
 
     // Process the initiator's key confirm message.
     // NOTE: No need to initialize crypto memory for this call.
-    err = secMgr->mCASEEngine->ProcessInitiatorKeyConfirm(msgBuf);
+    err = secMgr->mSession->mCASEEngine->ProcessInitiatorKeyConfirm(msgBuf);
     SuccessOrExit(err);
 
     // At this point the session is established.
@@ -1502,13 +1808,16 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     bool useSessionKeyID = encryptAuthPhase || encryptCommPhase;
+    SessionContext *session;
     bool clearStateOnError = false;
 
     // Verify security manager has been initialized.
     VerifyOrExit(State != kState_NotInitialized, err = WEAVE_ERROR_INCORRECT_STATE);
 
-    // Verify there is no session in process.
-    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    // Verify there is room for another session.
+    session = FindFreeSession();
+    VerifyOrExit(session != NULL, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    mSession = session;
 
     WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_SecMgrBusy,
         {
@@ -1522,14 +1831,14 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
     // Reject the request if no connection has been specified.
     VerifyOrExit(con != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    State = kState_TAKEInProgress;
-    mRequestedAuthMode = requestedAuthMode;
-    mEncType = kWeaveEncryptionType_AES128CTRSHA1;
-    mCon = con;
-    mStartSecureSession_OnComplete = onComplete;
-    mStartSecureSession_OnError = onError;
-    mStartSecureSession_ReqState = reqState;
-    mSessionKeyId = WeaveKeyId::kNone;
+    BeginSession(kState_TAKEInProgress);
+    mSession->mRequestedAuthMode = requestedAuthMode;
+    mSession->mEncType = kWeaveEncryptionType_AES128CTRSHA1;
+    mSession->mCon = con;
+    mSession->mStartSecureSession_OnComplete = onComplete;
+    mSession->mStartSecureSession_OnError = onError;
+    mSession->mStartSecureSession_ReqState = reqState;
+    mSession->mSessionKeyId = WeaveKeyId::kNone;
 
     // Any error after this point requires call to the Reset() function.
     clearStateOnError = true;
@@ -1542,11 +1851,11 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
         err = FabricState->AllocSessionKey(con->PeerNodeId, WeaveKeyId::kNone, con, sessionKey);
         SuccessOrExit(err);
         sessionKey->SetLocallyInitiated(true);
-        mSessionKeyId = sessionKey->MsgEncKey.KeyId;
+        mSession->mSessionKeyId = sessionKey->MsgEncKey.KeyId;
     }
 
     // Create a new exchange context.
-    err = NewSessionExchange(mCon->PeerNodeId, mCon->PeerAddr, mCon->PeerPort);
+    err = NewSessionExchange(mSession->mCon->PeerNodeId, mSession->mCon->PeerAddr, mSession->mCon->PeerPort);
     SuccessOrExit(err);
 
     // Initialize Weave platform memory.
@@ -1554,14 +1863,14 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
     SuccessOrExit(err);
 
     // Allocate and initialize TAKE engine object.
-    mTAKEEngine = (WeaveTAKEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveTAKEEngine), true);
-    VerifyOrExit(mTAKEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mTAKEEngine->Init();
+    mSession->mTAKEEngine = (WeaveTAKEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveTAKEEngine), true);
+    VerifyOrExit(mSession->mTAKEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    mSession->mTAKEEngine->Init();
 
     if (authDelegate == NULL)
         authDelegate = mDefaultTAKEChallengerAuthDelegate;
     VerifyOrExit(authDelegate != NULL, err = WEAVE_ERROR_NO_TAKE_AUTH_DELEGATE);
-    mTAKEEngine->ChallengerAuthDelegate = authDelegate;
+    mSession->mTAKEEngine->ChallengerAuthDelegate = authDelegate;
 
     // Start TAKE session.
     StartTAKESession(encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId);
@@ -1569,7 +1878,7 @@ WEAVE_ERROR WeaveSecurityManager::StartTAKESession(WeaveConnection *con, WeaveAu
 exit:
     if (err != WEAVE_NO_ERROR && clearStateOnError)
     {
-        FabricState->RemoveSessionKey(mSessionKeyId, con->PeerNodeId);
+        FabricState->RemoveSessionKey(mSession->mSessionKeyId, con->PeerNodeId);
 
         Reset();
     }
@@ -1579,15 +1888,17 @@ exit:
 
 void WeaveSecurityManager::StartTAKESession(bool encryptAuthPhase, bool encryptCommPhase, bool timeLimitedIK, bool sendChallengerId)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err;
 
     err = SendTAKEIdentifyToken(TAKE::kTAKEConfig_Config1, encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId);
     SuccessOrExit(err);
 
-    mEncType = mTAKEEngine->GetEncryptionType();
+    mSession->mEncType = mSession->mTAKEEngine->GetEncryptionType();
 
-    mEC->OnMessageReceived = HandleTAKEMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    mSession->mEC->OnMessageReceived = HandleTAKEMessageInitiator;
+    mSession->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Using a smaller timeout may help prevent Relay Attack.
     // TODO: consider reducing the timeout, and using different values of timeout
@@ -1603,10 +1914,13 @@ exit:
 void WeaveSecurityManager::HandleTAKEMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
         uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    secMgr->mSession = secMgr->FindSession(ec);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the TAKE interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -1629,7 +1943,7 @@ void WeaveSecurityManager::HandleTAKEMessageInitiator(ExchangeContext *ec, const
         if (!doReauth)
             SuccessOrExit(err);
 
-        if (secMgr->mTAKEEngine->IsEncryptAuthPhase())
+        if (secMgr->mSession->mTAKEEngine->IsEncryptAuthPhase())
         {
             err = secMgr->CreateTAKESecureSession();
             SuccessOrExit(err);
@@ -1660,8 +1974,8 @@ void WeaveSecurityManager::HandleTAKEMessageInitiator(ExchangeContext *ec, const
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->SendTAKEIdentifyToken(newConfig, secMgr->mTAKEEngine->IsEncryptAuthPhase(),
-                secMgr->mTAKEEngine->IsEncryptCommPhase(), secMgr->mTAKEEngine->IsTimeLimitedIK(), secMgr->mTAKEEngine->HasSentChallengerId());
+        err = secMgr->SendTAKEIdentifyToken(newConfig, secMgr->mSession->mTAKEEngine->IsEncryptAuthPhase(),
+                secMgr->mSession->mTAKEEngine->IsEncryptCommPhase(), secMgr->mSession->mTAKEEngine->IsTimeLimitedIK(), secMgr->mSession->mTAKEEngine->HasSentChallengerId());
         SuccessOrExit(err);
         break;
 
@@ -1714,11 +2028,11 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEIdentifyToken(uint8_t takeConfig, bool
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateIdentifyTokenMessage(mSessionKeyId, takeConfig, encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId, kWeaveEncryptionType_AES128CTRSHA1, FabricState->LocalNodeId, msgBuf);
+    err = mSession->mTAKEEngine->GenerateIdentifyTokenMessage(mSession->mSessionKeyId, takeConfig, encryptAuthPhase, encryptCommPhase, timeLimitedIK, sendChallengerId, kWeaveEncryptionType_AES128CTRSHA1, FabricState->LocalNodeId, msgBuf);
     SuccessOrExit(err);
 
     // Send the message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEIdentifyToken, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEIdentifyToken, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -1733,7 +2047,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessTAKEIdentifyTokenResponse(const PacketB
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = mTAKEEngine->ProcessIdentifyTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessIdentifyTokenResponseMessage(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -1744,7 +2058,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessTAKETokenReconfigure(uint8_t& config, c
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = mTAKEEngine->ProcessTokenReconfigureMessage(config, msgBuf);
+    err = mSession->mTAKEEngine->ProcessTokenReconfigureMessage(config, msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -1760,11 +2074,11 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEAuthenticateToken(void)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->GenerateAuthenticateTokenMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateAuthenticateTokenMessage(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEAuthenticateToken, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEAuthenticateToken, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -1777,7 +2091,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessTAKEAuthenticateTokenResponse(const Pac
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->ProcessAuthenticateTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessAuthenticateTokenResponseMessage(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -1793,10 +2107,10 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEReAuthenticateToken(void)
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateReAuthenticateTokenMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateReAuthenticateTokenMessage(msgBuf);
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEReAuthenticateToken, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEReAuthenticateToken, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -1808,7 +2122,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessTAKEReAuthenticateTokenResponse(const P
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = mTAKEEngine->ProcessReAuthenticateTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessReAuthenticateTokenResponseMessage(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -1838,9 +2152,9 @@ void WeaveSecurityManager::HandleTAKESessionStart(ExchangeContext *ec, const IPP
     VerifyOrExit(mDefaultTAKETokenAuthDelegate != NULL, err = WEAVE_ERROR_NO_TAKE_AUTH_DELEGATE);
 
     // Setup state for the new TAKE exchange.
-    State = kState_TAKEInProgress;
-    mEC = ec;
-    mCon = ec->Con;
+    BeginSession(kState_TAKEInProgress);
+    mSession->mEC = ec;
+    mSession->mCon = ec->Con;
 
     ec->OnMessageReceived = HandleTAKEMessageResponder;
     ec->OnConnectionClosed = HandleConnectionClosed;
@@ -1855,13 +2169,13 @@ void WeaveSecurityManager::HandleTAKESessionStart(ExchangeContext *ec, const IPP
     SuccessOrExit(err);
 
     // Prepare TAKE engine and start session
-    mTAKEEngine = (WeaveTAKEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveTAKEEngine), true);
-    VerifyOrExit(mTAKEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mTAKEEngine->Init();
+    mSession->mTAKEEngine = (WeaveTAKEEngine *)Platform::Security::MemoryAlloc(sizeof(WeaveTAKEEngine), true);
+    VerifyOrExit(mSession->mTAKEEngine != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    mSession->mTAKEEngine->Init();
 
-    mTAKEEngine->TokenAuthDelegate = mDefaultTAKETokenAuthDelegate;
+    mSession->mTAKEEngine->TokenAuthDelegate = mDefaultTAKETokenAuthDelegate;
 
-    err = mTAKEEngine->ProcessIdentifyTokenMessage(ec->PeerNodeId, msgBuf);
+    err = mSession->mTAKEEngine->ProcessIdentifyTokenMessage(ec->PeerNodeId, msgBuf);
     PacketBuffer::Free(msgBuf);
     msgBuf = NULL;
 
@@ -1878,28 +2192,28 @@ void WeaveSecurityManager::HandleTAKESessionStart(ExchangeContext *ec, const IPP
 
     SuccessOrExit(err);
 
-    if (mTAKEEngine->UseSessionKey())
+    if (mSession->mTAKEEngine->UseSessionKey())
     {
         WeaveSessionKey *sessionKey;
-        err = FabricState->AllocSessionKey(ec->PeerNodeId, mTAKEEngine->SessionKeyId, ec->Con, sessionKey);
+        err = FabricState->AllocSessionKey(ec->PeerNodeId, mSession->mTAKEEngine->SessionKeyId, ec->Con, sessionKey);
         SuccessOrExit(err);
         sessionKey->SetLocallyInitiated(false);
         sessionKey->SetRemoveOnIdle(true);
-        mSessionKeyId = mTAKEEngine->SessionKeyId;
-        mEncType = mTAKEEngine->GetEncryptionType();
+        mSession->mSessionKeyId = mSession->mTAKEEngine->SessionKeyId;
+        mSession->mEncType = mSession->mTAKEEngine->GetEncryptionType();
     }
 
     respMsgBuf = PacketBuffer::New();
     VerifyOrExit(respMsgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateIdentifyTokenResponseMessage(respMsgBuf);
+    err = mSession->mTAKEEngine->GenerateIdentifyTokenResponseMessage(respMsgBuf);
     SuccessOrExit(err);
 
     err = ec->SendMessage(kWeaveProfile_Security, kMsgType_TAKEIdentifyTokenResponse, respMsgBuf);
     respMsgBuf = NULL;
     SuccessOrExit(err);
 
-    if (mTAKEEngine->IsEncryptAuthPhase())
+    if (mSession->mTAKEEngine->IsEncryptAuthPhase())
     {
         err = CreateTAKESecureSession();
         SuccessOrExit(err);
@@ -1917,10 +2231,13 @@ exit:
 void WeaveSecurityManager::HandleTAKEMessageResponder(ExchangeContext *ec, const IPPacketInfo *pktInfo,
         const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer* msgBuf)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    secMgr->mSession = secMgr->FindSession(ec);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the TAKE interaction immediately if we receive a status report message from the initiator.
     // This is a signal that the initiator does not want to continue.
@@ -1986,7 +2303,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessTAKEAuthenticateToken(const PacketBuffe
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->ProcessAuthenticateTokenMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessAuthenticateTokenMessage(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
@@ -2003,10 +2320,10 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKETokenReconfigure(void)
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateTokenReconfigureMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateTokenReconfigureMessage(msgBuf);
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKETokenReconfigure, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKETokenReconfigure, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2025,11 +2342,11 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEAuthenticateTokenResponse(void)
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     Platform::Security::OnTimeConsumingCryptoStart();
-    err = mTAKEEngine->GenerateAuthenticateTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateAuthenticateTokenResponseMessage(msgBuf);
     Platform::Security::OnTimeConsumingCryptoDone();
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEAuthenticateTokenResponse, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEAuthenticateTokenResponse, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2043,7 +2360,7 @@ WEAVE_ERROR WeaveSecurityManager::ProcessTAKEReAuthenticateToken(const PacketBuf
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = mTAKEEngine->ProcessReAuthenticateTokenMessage(msgBuf);
+    err = mSession->mTAKEEngine->ProcessReAuthenticateTokenMessage(msgBuf);
     SuccessOrExit(err);
 
 exit:
@@ -2059,10 +2376,10 @@ WEAVE_ERROR WeaveSecurityManager::SendTAKEReAuthenticateTokenResponse(void)
     msgBuf = PacketBuffer::New();
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-    err = mTAKEEngine->GenerateReAuthenticateTokenResponseMessage(msgBuf);
+    err = mSession->mTAKEEngine->GenerateReAuthenticateTokenResponseMessage(msgBuf);
     SuccessOrExit(err);
 
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEReAuthenticateTokenResponse, msgBuf, 0);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_TAKEReAuthenticateTokenResponse, msgBuf, 0);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2083,14 +2400,14 @@ WEAVE_ERROR WeaveSecurityManager::CreateTAKESecureSession(void)
     err = HandleSessionEstablished();
     SuccessOrExit(err);
 
-    mEC->KeyId = mSessionKeyId;
-    mEC->EncryptionType = mEncType;
+    mSession->mEC->KeyId = mSession->mSessionKeyId;
+    mSession->mEC->EncryptionType = mSession->mEncType;
 
     // Add a reservation for the new session key and configure the ExchangeContext to automatically release
     // the key when the context is freed.  This will ensure the key is not removed until rest of the TAKE
     // exchange completes.
-    ReserveKey(mEC->PeerNodeId, mEC->KeyId);
-    mEC->SetAutoReleaseKey(true);
+    ReserveKey(mSession->mEC->PeerNodeId, mSession->mEC->KeyId);
+    mSession->mEC->SetAutoReleaseKey(true);
 
 exit:
     return err;
@@ -2100,20 +2417,20 @@ WEAVE_ERROR WeaveSecurityManager::FinishTAKESetUp(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    if (mTAKEEngine->IsEncryptCommPhase())
+    if (mSession->mTAKEEngine->IsEncryptCommPhase())
     {
         err = HandleSessionEstablished();
         SuccessOrExit(err);
     }
     else
     {
-        if (mTAKEEngine->IsEncryptAuthPhase())
+        if (mSession->mTAKEEngine->IsEncryptAuthPhase())
         {
-            err = FabricState->RemoveSessionKey(mSessionKeyId, mEC->PeerNodeId);
+            err = FabricState->RemoveSessionKey(mSession->mSessionKeyId, mSession->mEC->PeerNodeId);
             SuccessOrExit(err);
         }
-        mEncType = kWeaveEncryptionType_None;
-        mSessionKeyId = WeaveKeyId::kNone;
+        mSession->mEncType = kWeaveEncryptionType_None;
+        mSession->mSessionKeyId = WeaveKeyId::kNone;
     }
 
 exit:
@@ -2129,16 +2446,19 @@ WEAVE_ERROR WeaveSecurityManager::StartKeyExport(WeaveConnection *con, uint64_t
         KeyExportCompleteFunct onComplete, KeyExportErrorFunct onError, WeaveKeyExportDelegate *keyExportDelegate)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
+    SessionContext *session;
 
-    // Verify we've been initialized and that we don't already have a session in process.
+    // Verify we've been initialized and that there is room for another session.
     if (State == kState_NotInitialized)
         return WEAVE_ERROR_INCORRECT_STATE;
-    if (State != kState_Idle)
+    session = FindFreeSession();
+    if (session == NULL)
         return WEAVE_ERROR_SECURITY_MANAGER_BUSY;
 
-    State = kState_KeyExportInProgress;
+    mSession = session;
+    BeginSession(kState_KeyExportInProgress);
 
-    mCon = con;
+    mSession->mCon = con;
 
     // Create a new exchange context.
     err = NewSessionExchange(peerNodeId, peerAddr, peerPort);
@@ -2153,23 +2473,23 @@ WEAVE_ERROR WeaveSecurityManager::StartKeyExport(WeaveConnection *con, uint64_t
     SuccessOrExit(err);
 
     // Allocate and initialize KeyExport object.
-    mKeyExport = (WeaveKeyExport *)Platform::Security::MemoryAlloc(sizeof(WeaveKeyExport), true);
-    VerifyOrExit(mKeyExport != NULL, err = WEAVE_ERROR_NO_MEMORY);
-    mKeyExport->Init(keyExportDelegate);
+    mSession->mKeyExport = (WeaveKeyExport *)Platform::Security::MemoryAlloc(sizeof(WeaveKeyExport), true);
+    VerifyOrExit(mSession->mKeyExport != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    mSession->mKeyExport->Init(keyExportDelegate);
 
     // Set the allowed key export protocol configurations.
-    mKeyExport->SetAllowedConfigs(InitiatorAllowedKeyExportConfigs);
+    mSession->mKeyExport->SetAllowedConfigs(InitiatorAllowedKeyExportConfigs);
 
     // Send key export request message.
     err = SendKeyExportRequest(InitiatorKeyExportConfig, keyId, signMessage);
     SuccessOrExit(err);
 
-    mStartKeyExport_OnComplete = onComplete;
-    mStartKeyExport_OnError = onError;
-    mStartKeyExport_ReqState = reqState;
+    mSession->mStartKeyExport_OnComplete = onComplete;
+    mSession->mStartKeyExport_OnError = onError;
+    mSession->mStartKeyExport_ReqState = reqState;
 
-    mEC->OnMessageReceived = HandleKeyExportMessageInitiator;
-    mEC->OnConnectionClosed = HandleConnectionClosed;
+    mSession->mEC->OnMessageReceived = HandleKeyExportMessageInitiator;
+    mSession->mEC->OnConnectionClosed = HandleConnectionClosed;
 
     // Time limit overall Key Export duration.
     StartSessionTimer();
@@ -2184,10 +2504,13 @@ exit:
 void WeaveSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
         uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
 
-    VerifyOrDie(ec == secMgr->mEC);
+    secMgr->mSession = secMgr->FindSession(ec);
+    VerifyOrDie(secMgr->mSession != NULL);
 
     // Abort the key export interaction immediately if we receive a status report message from the responder.
     // This is a signal that the responder does not want to continue.
@@ -2202,7 +2525,7 @@ void WeaveSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext *ec,
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
     // Flush any pending WRM ACKs before we begin the long crypto operation,
     // to prevent the peer from re-transmitting message.
-    err = secMgr->mEC->WRMPFlushAcks();
+    err = secMgr->mSession->mEC->WRMPFlushAcks();
     SuccessOrExit(err);
 #endif
 
@@ -2212,14 +2535,14 @@ void WeaveSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext *ec,
     case kMsgType_KeyExportReconfigure:
         uint8_t newConfig;
 
-        err = secMgr->mKeyExport->ProcessKeyExportReconfigure(msgBuf->Start(), msgBuf->DataLength(), newConfig);
+        err = secMgr->mSession->mKeyExport->ProcessKeyExportReconfigure(msgBuf->Start(), msgBuf->DataLength(), newConfig);
         SuccessOrExit(err);
 
         // Free the received message buffer so that it can be reused to send the outgoing message.
         PacketBuffer::Free(msgBuf);
         msgBuf = NULL;
 
-        err = secMgr->SendKeyExportRequest(newConfig, secMgr->mKeyExport->KeyId(), secMgr->mKeyExport->SignMessages());
+        err = secMgr->SendKeyExportRequest(newConfig, secMgr->mSession->mKeyExport->KeyId(), secMgr->mSession->mKeyExport->SignMessages());
         SuccessOrExit(err);
 
         break;
@@ -2229,14 +2552,19 @@ void WeaveSecurityManager::HandleKeyExportMessageInitiator(ExchangeContext *ec,
         uint16_t exportedKeyLen;
         uint8_t exportedKey[kWeaveFabricSecretSize];
 
-        err = secMgr->mKeyExport->ProcessKeyExportResponse(msgBuf->Start(), msgBuf->DataLength(), msgInfo,
+        err = secMgr->mSession->mKeyExport->ProcessKeyExportResponse(msgBuf->Start(), msgBuf->DataLength(), msgInfo,
                                                            exportedKey, sizeof(exportedKey), exportedKeyLen, exportedKeyId);
         SuccessOrExit(err);
 
         // Call the user's completion function.
-        if (secMgr->mStartKeyExport_OnComplete != NULL)
+        if (secMgr->mSession->mStartKeyExport_OnComplete != NULL)
         {
-            secMgr->mStartKeyExport_OnComplete(secMgr, secMgr->mCon, secMgr->mStartKeyExport_ReqState, exportedKeyId, exportedKey, exportedKeyLen);
+            SessionContext *session = secMgr->mSession;
+
+            secMgr->mSession->mStartKeyExport_OnComplete(secMgr, secMgr->mSession->mCon, secMgr->mSession->mStartKeyExport_ReqState, exportedKeyId, exportedKey, exportedKeyLen);
+
+            // The callback may have started another session.
+            secMgr->mSession = session;
         }
 
         // Reset state.
@@ -2269,11 +2597,12 @@ void WeaveSecurityManager::HandleKeyExportError(WEAVE_ERROR err, PacketBuffer *s
     // Then when SendMessage() returns, the function that called it will also call this
     // function with the error returned by SendMessage().
     //
-    if (State != kState_Idle)
+    if (mSession->mState != kState_Idle)
     {
-        WeaveConnection *con = mCon;
-        KeyExportErrorFunct userOnError = mStartKeyExport_OnError;
-        void *reqState = mStartKeyExport_ReqState;
+        SessionContext *session = mSession;
+        WeaveConnection *con = mSession->mCon;
+        KeyExportErrorFunct userOnError = mSession->mStartKeyExport_OnError;
+        void *reqState = mSession->mStartKeyExport_ReqState;
         StatusReport rcvdStatusReport;
         StatusReport *statusReportPtr = NULL;
 
@@ -2294,12 +2623,16 @@ void WeaveSecurityManager::HandleKeyExportError(WEAVE_ERROR err, PacketBuffer *s
         // Call the user's error handler.
         if (userOnError != NULL)
             userOnError(this, con, reqState, err, statusReportPtr);
+
+        mSession = session;
     }
 }
 
 __attribute__((noinline))
 WEAVE_ERROR WeaveSecurityManager::SendKeyExportRequest(uint8_t keyExportConfig, uint32_t keyId, bool signMessage)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     PacketBuffer *msgBuf = NULL;
     uint16_t dataLen;
@@ -2310,21 +2643,21 @@ WEAVE_ERROR WeaveSecurityManager::SendKeyExportRequest(uint8_t keyExportConfig,
     VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
     // Generate key export request.
-    err = mKeyExport->GenerateKeyExportRequest(msgBuf->Start(), msgBuf->AvailableDataLength(), dataLen, keyExportConfig, keyId, signMessage);
+    err = mSession->mKeyExport->GenerateKeyExportRequest(msgBuf->Start(), msgBuf->AvailableDataLength(), dataLen, keyExportConfig, keyId, signMessage);
     SuccessOrExit(err);
 
     // Set message length.
     msgBuf->SetDataLength(dataLen);
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (mSession->mCon == NULL)
     {
         sendFlags = ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
     // Send key export request message.
-    err = mEC->SendMessage(kWeaveProfile_Security, kMsgType_KeyExportRequest, msgBuf, sendFlags);
+    err = mSession->mEC->SendMessage(kWeaveProfile_Security, kMsgType_KeyExportRequest, msgBuf, sendFlags);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2344,24 +2677,23 @@ void WeaveSecurityManager::HandleKeyExportRequest(ExchangeContext *ec, const IPP
     WEAVE_ERROR err;
     WeaveKeyExport keyExport;
 
-    State = kState_KeyExportInProgress;
-    mEC = ec;
-    mCon = ec->Con;
+    // Each request is answered with its own key export engine and exchange, independently of the sessions being
+    // established and without changing the security manager state.
 
     // Ensure the exchange context stays around until we're done with it.
     ec->AddRef();
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (ec->Con == NULL)
     {
         // Do nothing on the Ack received from the requestor.
-        // mEC->OnAckRcvd is not initialized.
+        // ec->OnAckRcvd is not initialized.
         // Do nothing on the message send error.
-        // mEC->OnSendError is not initialized.
+        // ec->OnSendError is not initialized.
 
         // Flush any pending WRM ACKs before we begin the long crypto operation,
         // to prevent the peer from re-transmitting the Key Export request.
-        err = mEC->WRMPFlushAcks();
+        err = ec->WRMPFlushAcks();
         SuccessOrExit(err);
     }
 #endif
@@ -2386,11 +2718,11 @@ void WeaveSecurityManager::HandleKeyExportRequest(ExchangeContext *ec, const IPP
     // Check if reconfiguration was requested.
     if (err == WEAVE_ERROR_KEY_EXPORT_RECONFIGURE_REQUIRED)
     {
-        err = SendKeyExportResponse(keyExport, kMsgType_KeyExportReconfigure, msgInfo);
+        err = SendKeyExportResponse(ec, keyExport, kMsgType_KeyExportReconfigure, msgInfo);
     }
     else if (err == WEAVE_NO_ERROR)
     {
-        err = SendKeyExportResponse(keyExport, kMsgType_KeyExportResponse, msgInfo);
+        err = SendKeyExportResponse(ec, keyExport, kMsgType_KeyExportResponse, msgInfo);
     }
     SuccessOrExit(err);
 
@@ -2405,12 +2737,15 @@ exit:
     // Shutdown and clean key export engine memory.
     keyExport.Shutdown();
 
-    // Reset state.
-    Reset();
+    ec->Abort();
+
+    // Release the platform security memory if no session is using it.
+    if (State == kState_Idle)
+        Platform::Security::MemoryShutdown();
 }
 
 __attribute__((noinline))
-WEAVE_ERROR WeaveSecurityManager::SendKeyExportResponse(WeaveKeyExport& keyExport, uint8_t msgType, const WeaveMessageInfo *msgInfo)
+WEAVE_ERROR WeaveSecurityManager::SendKeyExportResponse(ExchangeContext *ec, WeaveKeyExport& keyExport, uint8_t msgType, const WeaveMessageInfo *msgInfo)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     PacketBuffer *msgBuf = NULL;
@@ -2434,14 +2769,14 @@ WEAVE_ERROR WeaveSecurityManager::SendKeyExportResponse(WeaveKeyExport& keyExpor
     msgBuf->SetDataLength(dataLen);
 
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
-    if (mCon == NULL)
+    if (ec->Con == NULL)
     {
         sendFlags = ExchangeContext::kSendFlag_RequestAck;
     }
 #endif
 
     // Send key export response message.
-    err = mEC->SendMessage(kWeaveProfile_Security, msgType, msgBuf, sendFlags);
+    err = ec->SendMessage(kWeaveProfile_Security, msgType, msgBuf, sendFlags);
     msgBuf = NULL;
     SuccessOrExit(err);
 
@@ -2500,6 +2835,8 @@ bool WeaveSecurityManager::IsKeyError(WEAVE_ERROR err)
  */
 WEAVE_ERROR WeaveSecurityManager::SendKeyErrorMsg(WeaveMessageInfo *rcvdMsgInfo, const IPPacketInfo *rcvdMsgPacketInfo, WeaveConnection *con, WEAVE_ERROR keyErr)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR         err         = WEAVE_NO_ERROR;
     ExchangeContext*    ec          = NULL;
     PacketBuffer*       msgBuf      = NULL;
@@ -2700,28 +3037,28 @@ WEAVE_ERROR WeaveSecurityManager::NewSessionExchange(uint64_t peerNodeId, IPAddr
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    if (mEC != NULL)
+    if (mSession->mEC != NULL)
     {
-        mEC->Close();
-        mEC = NULL;
+        mSession->mEC->Close();
+        mSession->mEC = NULL;
     }
 
     // Create a new exchange context.
-    if (mCon)
+    if (mSession->mCon)
     {
-        mEC = ExchangeManager->NewContext(mCon, this);
-        VerifyOrExit(mEC != NULL, err = WEAVE_ERROR_NO_MEMORY);
+        mSession->mEC = ExchangeManager->NewContext(mSession->mCon, this);
+        VerifyOrExit(mSession->mEC != NULL, err = WEAVE_ERROR_NO_MEMORY);
     }
     else
     {
 #if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
         VerifyOrExit(peerNodeId != kNodeIdNotSpecified && peerNodeId != kAnyNodeId, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-        mEC = ExchangeManager->NewContext(peerNodeId, peerAddr, peerPort, INET_NULL_INTERFACEID, this);
-        VerifyOrExit(mEC != NULL, err = WEAVE_ERROR_NO_MEMORY);
+        mSession->mEC = ExchangeManager->NewContext(peerNodeId, peerAddr, peerPort, INET_NULL_INTERFACEID, this);
+        VerifyOrExit(mSession->mEC != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
-        mEC->OnAckRcvd = WRMPHandleAckRcvd;
-        mEC->OnSendError = WRMPHandleSendError;
+        mSession->mEC->OnAckRcvd = WRMPHandleAckRcvd;
+        mSession->mEC->OnSendError = WRMPHandleSendError;
 #else
         // Reject the request if no connection has been specified.
         ExitNow(err = WEAVE_ERROR_INVALID_ARGUMENT);
@@ -2811,6 +3148,8 @@ exit:
  */
 WEAVE_ERROR WeaveSecurityManager::SendMsgCounterSyncResp(const WeaveMessageInfo *rcvdMsgInfo, const IPPacketInfo *rcvdMsgPacketInfo)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_Security);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     ExchangeContext *ec = NULL;
     PacketBuffer *msgBuf = NULL;
@@ -2878,9 +3217,9 @@ void WeaveSecurityManager::UpdatePASERateLimiter(WEAVE_ERROR err)
     // Update PASE rate limiter parameters in the following cases:
     //   -- PASE with key confirmation: count only PASE attempts that fail with key confirmation error.
     //   -- PASE without key confirmation: every PASE attempt counts as failure.
-    if (State == kState_PASEInProgress && mPASEEngine->IsResponder() &&
-        ((mPASEEngine->PerformKeyConfirmation && err == WEAVE_ERROR_KEY_CONFIRMATION_FAILED) ||
-         (!mPASEEngine->PerformKeyConfirmation && err == WEAVE_NO_ERROR)))
+    if (mSession->mState == kState_PASEInProgress && mSession->mPASEEngine->IsResponder() &&
+        ((mSession->mPASEEngine->PerformKeyConfirmation && err == WEAVE_ERROR_KEY_CONFIRMATION_FAILED) ||
+         (!mSession->mPASEEngine->PerformKeyConfirmation && err == WEAVE_NO_ERROR)))
     {
         uint64_t nowTimeMS = System::Layer::GetClock_MonotonicMS();
 
@@ -2902,19 +3241,19 @@ void WeaveSecurityManager::UpdatePASERateLimiter(WEAVE_ERROR err)
 WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
-    uint64_t peerNodeId = mEC->PeerNodeId;
-    uint16_t sessionKeyId = mSessionKeyId;
-    uint8_t encType = mEncType;
+    uint64_t peerNodeId = mSession->mEC->PeerNodeId;
+    uint16_t sessionKeyId = mSession->mSessionKeyId;
+    uint8_t encType = mSession->mEncType;
     const WeaveEncryptionKey *sessionKey;
     WeaveAuthMode authMode;
 
-    switch (State)
+    switch (mSession->mState)
     {
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
     case kState_CASEInProgress:
 
         // Get the derived session key.
-        err = mCASEEngine->GetSessionKey(sessionKey);
+        err = mSession->mCASEEngine->GetSessionKey(sessionKey);
         SuccessOrExit(err);
 
         // Form the key auth mode based on the type of certificate that was used by the peer.
@@ -2923,7 +3262,24 @@ WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(void)
         // was requested by the application.  For example, if the app requested kWeaveAuthMode_CASE_AnyCert
         // then the final key auth mode will reflect the actual certificate type used by the peer.
         //
-        authMode = CASEAuthMode(mCASEEngine->CertType());
+        authMode = CASEAuthMode(mSession->mCASEEngine->CertType());
+
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+        // Keep a ticket from which a later session with the peer can be resumed.  This replaces the ticket, if
+        // any, from which this session was resumed, so that each ticket is used only once.
+        {
+            WeaveCASEResumptionTicket ticket;
+
+            err = mSession->mCASEEngine->GetResumptionTicket(ticket);
+            SuccessOrExit(err);
+
+            ticket.PeerNodeId = peerNodeId;
+            ticket.ExpiryTimeMS = System::Layer::GetClock_MonotonicMS() + WEAVE_CONFIG_CASE_RESUMPTION_TICKET_LIFETIME * 1000ULL;
+            FabricState->CacheCASEResumptionTicket(ticket);
+
+            ClearSecretData((uint8_t *)&ticket, sizeof(ticket));
+        }
+#endif
 
         break;
 #endif
@@ -2932,11 +3288,11 @@ WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(void)
     case kState_PASEInProgress:
 
         // Get the derived session key.
-        err = mPASEEngine->GetSessionKey(sessionKey);
+        err = mSession->mPASEEngine->GetSessionKey(sessionKey);
         SuccessOrExit(err);
 
         // Form the key auth mode based on the password source.
-        authMode = PASEAuthMode(mPASEEngine->PwSource);
+        authMode = PASEAuthMode(mSession->mPASEEngine->PwSource);
 
 #if WEAVE_CONFIG_ENABLE_PASE_RESPONDER
         UpdatePASERateLimiter(WEAVE_NO_ERROR);
@@ -2949,7 +3305,7 @@ WEAVE_ERROR WeaveSecurityManager::HandleSessionEstablished(void)
     case kState_TAKEInProgress:
 
         // Get the derived session key.
-        err = mTAKEEngine->GetSessionKey(sessionKey);
+        err = mSession->mTAKEEngine->GetSessionKey(sessionKey);
         SuccessOrExit(err);
 
         // Currently only one key auth mode is supported for TAKE.
@@ -2972,12 +3328,13 @@ exit:
 
 void WeaveSecurityManager::HandleSessionComplete(void)
 {
-    WeaveConnection *con = mCon;
-    uint64_t peerNodeId = mEC->PeerNodeId;
-    uint16_t sessionKeyId = mSessionKeyId;
-    uint8_t encType = mEncType;
-    SessionEstablishedFunct userOnComplete = mStartSecureSession_OnComplete;
-    void *reqState = mStartSecureSession_ReqState;
+    SessionContext *session = mSession;
+    WeaveConnection *con = mSession->mCon;
+    uint64_t peerNodeId = mSession->mEC->PeerNodeId;
+    uint16_t sessionKeyId = mSession->mSessionKeyId;
+    uint8_t encType = mSession->mEncType;
+    SessionEstablishedFunct userOnComplete = mSession->mStartSecureSession_OnComplete;
+    void *reqState = mSession->mStartSecureSession_ReqState;
 
     // Reset state.
     Reset();
@@ -2990,6 +3347,9 @@ void WeaveSecurityManager::HandleSessionComplete(void)
     if (userOnComplete != NULL)
         userOnComplete(this, con, reqState, sessionKeyId, peerNodeId, encType);
 
+    // The callbacks may have started other sessions; leave the caller acting on the one that completed.
+    mSession = session;
+
     // If the session was initiated the remote party, release the reservation that was
     // made when the session key record was allocated.  Provided that the application
     // hasn't increased the reservation count during one of the above callbacks,
@@ -3020,13 +3380,14 @@ void WeaveSecurityManager::HandleSessionError(WEAVE_ERROR err, PacketBuffer* sta
     // Then when SendMessage() returns, the function that called it will also call this
     // function with the error returned by SendMessage().
     //
-    if (State != kState_Idle)
+    if (mSession->mState != kState_Idle)
     {
-        WeaveConnection *con = mCon;
-        uint64_t peerNodeId = mEC->PeerNodeId;
-        uint16_t sessionKeyId = mSessionKeyId;
-        SessionErrorFunct userOnError = mStartSecureSession_OnError;
-        void *reqState = mStartSecureSession_ReqState;
+        SessionContext *session = mSession;
+        WeaveConnection *con = mSession->mCon;
+        uint64_t peerNodeId = mSession->mEC->PeerNodeId;
+        uint16_t sessionKeyId = mSession->mSessionKeyId;
+        SessionErrorFunct userOnError = mSession->mStartSecureSession_OnError;
+        void *reqState = mSession->mStartSecureSession_ReqState;
         StatusReport rcvdStatusReport;
         StatusReport *statusReportPtr = NULL;
 
@@ -3047,7 +3408,7 @@ void WeaveSecurityManager::HandleSessionError(WEAVE_ERROR err, PacketBuffer* sta
 
         // Otherwise, send a status report to the peer with our reason for the failure.
         else
-            SendStatusReport(err, mEC);
+            SendStatusReport(err, mSession->mEC);
 
         // Remove the session key from the key table.
         FabricState->RemoveSessionKey(sessionKeyId, peerNodeId);
@@ -3063,6 +3424,10 @@ void WeaveSecurityManager::HandleSessionError(WEAVE_ERROR err, PacketBuffer* sta
         if (userOnError != NULL)
             userOnError(this, con, reqState, err, peerNodeId, statusReportPtr);
 
+        // The callbacks may have started other sessions; leave the caller acting on the one that failed, so
+        // that a repeated call for the same failure is ignored.
+        mSession = session;
+
         // Asynchronously notify other subsystems that the security manager is now available
         // for initiating another session.
         AsyncNotifySecurityManagerAvailable();
@@ -3076,9 +3441,14 @@ void WeaveSecurityManager::HandleConnectionClosed(ExchangeContext *ec, WeaveConn
     if (conErr == WEAVE_NO_ERROR)
         conErr = WEAVE_ERROR_CONNECTION_CLOSED_UNEXPECTEDLY;
 
+    // Find the session to which the exchange belongs.
+    secMgr->mSession = secMgr->FindSession(ec);
+    if (secMgr->mSession == NULL)
+        return;
+
     // Clean-up the local state and invoke the appropriate callbacks.
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-    if (secMgr->State == kState_KeyExportInProgress)
+    if (secMgr->mSession->mState == kState_KeyExportInProgress)
         secMgr->HandleKeyExportError(conErr, NULL);
     else
 #endif
@@ -3178,6 +3548,10 @@ WEAVE_ERROR WeaveSecurityManager::SendStatusReport(WEAVE_ERROR localErr, Exchang
         profileId = kWeaveProfile_Security;
         statusCode = kStatusCode_UnsupportedCertificate;
         break;
+    case WEAVE_ERROR_CASE_RESUMPTION_TICKET_NOT_FOUND:
+        profileId = kWeaveProfile_Security;
+        statusCode = kStatusCode_ResumptionTicketNotFound;
+        break;
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_RESPONDER
     case WEAVE_ERROR_NO_COMMON_KEY_EXPORT_CONFIGURATIONS:
         profileId = kWeaveProfile_Security;
@@ -3207,51 +3581,51 @@ exit:
 
 void WeaveSecurityManager::Reset(void)
 {
-    if (mEC != NULL)
+    if (mSession->mEC != NULL)
     {
-        mEC->Abort();
-        mEC = NULL;
+        mSession->mEC->Abort();
+        mSession->mEC = NULL;
     }
 
-    switch (State)
+    switch (mSession->mState)
     {
 #if WEAVE_CONFIG_ENABLE_PASE_INITIATOR || WEAVE_CONFIG_ENABLE_PASE_RESPONDER
     case kState_PASEInProgress:
-        if (mPASEEngine != NULL)
+        if (mSession->mPASEEngine != NULL)
         {
-            mPASEEngine->Shutdown();
-            Platform::Security::MemoryFree(mPASEEngine);
-            mPASEEngine = NULL;
+            mSession->mPASEEngine->Shutdown();
+            Platform::Security::MemoryFree(mSession->mPASEEngine);
+            mSession->mPASEEngine = NULL;
         }
         break;
 #endif
 #if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR || WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
     case kState_TAKEInProgress:
-        if (mTAKEEngine != NULL)
+        if (mSession->mTAKEEngine != NULL)
         {
-            mTAKEEngine->Shutdown();
-            Platform::Security::MemoryFree(mTAKEEngine);
-            mTAKEEngine = NULL;
+            mSession->mTAKEEngine->Shutdown();
+            Platform::Security::MemoryFree(mSession->mTAKEEngine);
+            mSession->mTAKEEngine = NULL;
         }
         break;
 #endif
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
     case kState_CASEInProgress:
-        if (mCASEEngine != NULL)
+        if (mSession->mCASEEngine != NULL)
         {
-            mCASEEngine->Shutdown();
-            Platform::Security::MemoryFree(mCASEEngine);
-            mCASEEngine = NULL;
+            mSession->mCASEEngine->Shutdown();
+            Platform::Security::MemoryFree(mSession->mCASEEngine);
+            mSession->mCASEEngine = NULL;
         }
         break;
 #endif
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
     case kState_KeyExportInProgress:
-        if (mKeyExport != NULL)
+        if (mSession->mKeyExport != NULL)
         {
-            mKeyExport->Shutdown();
-            Platform::Security::MemoryFree(mKeyExport);
-            mKeyExport = NULL;
+            mSession->mKeyExport->Shutdown();
+            Platform::Security::MemoryFree(mSession->mKeyExport);
+            mSession->mKeyExport = NULL;
         }
         break;
 #endif
@@ -3259,43 +3633,193 @@ void WeaveSecurityManager::Reset(void)
         break;
     }
 
-    Platform::Security::MemoryShutdown();
-
     CancelSessionTimer();
 
+    InitSession(mSession);
+
+    // Report the state of a session that is still in progress, if any.
     State = kState_Idle;
-    mCon = NULL;
-    mRequestedAuthMode = kWeaveAuthMode_NotSpecified;
-    mSessionKeyId = WeaveKeyId::kNone;
-    mEncType = kWeaveEncryptionType_None;
-    mStartSecureSession_OnComplete = NULL;
-    mStartSecureSession_OnError = NULL;
-    mStartSecureSession_ReqState = NULL;
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+    {
+        if (mSessions[i].mState != kState_Idle)
+            State = mSessions[i].mState;
+    }
+
+    // Release the platform security memory once no session is using it.
+    if (State == kState_Idle)
+        Platform::Security::MemoryShutdown();
+
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+    // Start any held CASE requests in the room that has been made.
+    if (mNumQueuedCASERequests > 0)
+        AsyncNotifySecurityManagerAvailable();
+#endif
 }
 
+void WeaveSecurityManager::InitSession(SessionContext *session)
+{
+    session->mSecMgr = this;
+    session->mState = kState_Idle;
+    session->mEC = NULL;
+    session->mCon = NULL;
+#if WEAVE_CONFIG_ENABLE_PASE_INITIATOR || WEAVE_CONFIG_ENABLE_PASE_RESPONDER
+    session->mPASEEngine = NULL;
+#endif
+#if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
+    session->mCASEEngine = NULL;
+#endif
+#if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR || WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
+    session->mTAKEEngine = NULL;
+#endif
+#if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
+    session->mKeyExport = NULL;
+#endif
+    session->mStartSecureSession_OnComplete = NULL;
+    session->mStartSecureSession_OnError = NULL;
+    session->mStartSecureSession_ReqState = NULL;
+    session->mRequestedAuthMode = kWeaveAuthMode_NotSpecified;
+    session->mSessionKeyId = WeaveKeyId::kNone;
+    session->mEncType = kWeaveEncryptionType_None;
+}
+
+WeaveSecurityManager::SessionContext *WeaveSecurityManager::FindFreeSession(void)
+{
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+    {
+        if (mSessions[i].mState == kState_Idle)
+            return &mSessions[i];
+    }
+
+    return NULL;
+}
+
+WeaveSecurityManager::SessionContext *WeaveSecurityManager::FindSession(const ExchangeContext *ec)
+{
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+    {
+        if (mSessions[i].mState != kState_Idle && mSessions[i].mEC == ec)
+            return &mSessions[i];
+    }
+
+    return NULL;
+}
+
+void WeaveSecurityManager::BeginSession(uint8_t state)
+{
+    mSession->mState = state;
+    State = state;
+}
+
+bool WeaveSecurityManager::IsCASESessionInProgress(uint64_t peerNodeId, uint16_t keyId)
+{
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
+    {
+        const SessionContext &session = mSessions[i];
+
+        if (session.mState == kState_CASEInProgress && session.mEC != NULL &&
+            session.mEC->PeerNodeId == peerNodeId && session.mSessionKeyId == keyId)
+            return true;
+    }
+
+    return false;
+}
+
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+
+WEAVE_ERROR WeaveSecurityManager::QueueCASERequest(WeaveConnection *con, uint64_t peerNodeId, const IPAddress &peerAddr,
+                                                   uint16_t peerPort, WeaveAuthMode requestedAuthMode, void *reqState,
+                                                   SessionEstablishedFunct onComplete, SessionErrorFunct onError,
+                                                   WeaveCASEAuthDelegate *authDelegate, uint64_t terminatingNodeId)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const uint64_t destNodeId = (terminatingNodeId != kNodeIdNotSpecified) ? terminatingNodeId : peerNodeId;
+    QueuedCASERequest *req;
+
+    VerifyOrExit(mNumQueuedCASERequests < WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS,
+                 err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+
+    // Hold at most one request per destination node, so that a single node with many pending requests cannot
+    // keep the requests of other nodes out of the queue.
+    for (int i = 0; i < mNumQueuedCASERequests; i++)
+    {
+        const QueuedCASERequest &other = mQueuedCASERequests[i];
+        const uint64_t otherDestNodeId =
+            (other.TerminatingNodeId != kNodeIdNotSpecified) ? other.TerminatingNodeId : other.PeerNodeId;
+
+        VerifyOrExit(otherDestNodeId != destNodeId, err = WEAVE_ERROR_SECURITY_MANAGER_BUSY);
+    }
+
+    req = &mQueuedCASERequests[mNumQueuedCASERequests++];
+    req->Con = con;
+    req->PeerNodeId = peerNodeId;
+    req->PeerAddr = peerAddr;
+    req->PeerPort = peerPort;
+    req->RequestedAuthMode = requestedAuthMode;
+    req->ReqState = reqState;
+    req->OnComplete = onComplete;
+    req->OnError = onError;
+    req->AuthDelegate = authDelegate;
+    req->TerminatingNodeId = terminatingNodeId;
+
+    WeaveLogDetail(SecurityManager, "CASE request held: Peer=%016" PRIX64 " Queued=%d", destNodeId,
+                   (int)mNumQueuedCASERequests);
+
+exit:
+    return err;
+}
+
+void WeaveSecurityManager::StartQueuedCASERequests(void)
+{
+    // A request that has to be held again (because the shared session it needs is still being established) goes
+    // to the back of the queue, so each request present on entry is tried at most once.
+    uint8_t numToStart = mNumQueuedCASERequests;
+
+    while (numToStart > 0 && mNumQueuedCASERequests > 0 && FindFreeSession() != NULL)
+    {
+        QueuedCASERequest req = mQueuedCASERequests[0];
+        WEAVE_ERROR err;
+
+        numToStart--;
+        mNumQueuedCASERequests--;
+        memmove(&mQueuedCASERequests[0], &mQueuedCASERequests[1], mNumQueuedCASERequests * sizeof(QueuedCASERequest));
+
+        err = StartCASESession(req.Con, req.PeerNodeId, req.PeerAddr, req.PeerPort, req.RequestedAuthMode, req.ReqState,
+                               req.OnComplete, req.OnError, req.AuthDelegate, req.TerminatingNodeId);
+
+        // The requester was told that the session was started, so report the failure through its error handler.
+        if (err != WEAVE_NO_ERROR && req.OnError != NULL)
+            req.OnError(this, req.Con, req.ReqState, err, req.PeerNodeId, NULL);
+    }
+}
+
+#endif // WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+
 void WeaveSecurityManager::StartSessionTimer(void)
 {
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
 
     if (SessionEstablishTimeout != 0)
     {
-        mSystemLayer->StartTimer(SessionEstablishTimeout, HandleSessionTimeout, this);
+        mSystemLayer->StartTimer(SessionEstablishTimeout, HandleSessionTimeout, mSession);
     }
 }
 
 void WeaveSecurityManager::CancelSessionTimer(void)
 {
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
-    mSystemLayer->CancelTimer(HandleSessionTimeout, this);
+    mSystemLayer->CancelTimer(HandleSessionTimeout, mSession);
 }
 
 void WeaveSecurityManager::HandleSessionTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError)
 {
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
 
-    WeaveSecurityManager* securityMgr = reinterpret_cast<WeaveSecurityManager*>(aAppState);
-    if (securityMgr)
+    SessionContext* session = reinterpret_cast<SessionContext*>(aAppState);
+    if (session)
     {
+        WeaveSecurityManager* securityMgr = session->mSecMgr;
+
+        securityMgr->mSession = session;
         securityMgr->HandleSessionError(WEAVE_ERROR_TIMEOUT, NULL);
     }
 }
@@ -3344,13 +3868,20 @@ void WeaveSecurityManager::OnEncryptedMsgRcvd(uint16_t sessionKeyId, uint64_t pe
     // is received before the Ack for the last message on the session establishment exchange.
     // In that case there is no need to wait for the Ack and the session can be completed.
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
-    if (State == kState_CASEInProgress &&
-        mCASEEngine->State == WeaveCASEEngine::kState_Complete &&
-        mSessionKeyId == sessionKeyId &&
-        mEC->PeerNodeId == peerNodeId &&
-        mEncType == encType)
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
     {
-        HandleSessionComplete();
+        SessionContext *session = &mSessions[i];
+
+        if (session->mState == kState_CASEInProgress &&
+            session->mCASEEngine->State == WeaveCASEEngine::kState_Complete &&
+            session->mSessionKeyId == sessionKeyId &&
+            session->mEC->PeerNodeId == peerNodeId &&
+            session->mEncType == encType)
+        {
+            mSession = session;
+            HandleSessionComplete();
+            break;
+        }
     }
 #endif
 }
@@ -3362,8 +3893,12 @@ void WeaveSecurityManager::WRMPHandleAckRcvd(ExchangeContext *ec, void *msgCtxt)
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
 
-    if (secMgr->State == kState_CASEInProgress &&
-        secMgr->mCASEEngine->State == WeaveCASEEngine::kState_Complete)
+    secMgr->mSession = secMgr->FindSession(ec);
+    if (secMgr->mSession == NULL)
+        return;
+
+    if (secMgr->mSession->mState == kState_CASEInProgress &&
+        secMgr->mSession->mCASEEngine->State == WeaveCASEEngine::kState_Complete)
     {
         secMgr->HandleSessionComplete();
     }
@@ -3374,8 +3909,12 @@ void WeaveSecurityManager::WRMPHandleSendError(ExchangeContext *ec, WEAVE_ERROR
     WeaveLogProgress(SecurityManager, "%s", __FUNCTION__);
     WeaveSecurityManager *secMgr = (WeaveSecurityManager *)ec->AppState;
 
+    secMgr->mSession = secMgr->FindSession(ec);
+    if (secMgr->mSession == NULL)
+        return;
+
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-    if (secMgr->State == kState_KeyExportInProgress)
+    if (secMgr->mSession->mState == kState_KeyExportInProgress)
     {
         secMgr->HandleKeyExportError(err, NULL);
     }
@@ -3396,7 +3935,16 @@ void WeaveSecurityManager::AsyncNotifySecurityManagerAvailable()
 void WeaveSecurityManager::DoNotifySecurityManagerAvailable(System::Layer *systemLayer, void *appState, System::Error err)
 {
     WeaveSecurityManager *_this = (WeaveSecurityManager *)appState;
-    if (_this->State == kState_Idle)
+
+    if (_this->State == kState_NotInitialized)
+        return;
+
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+    // Held requests are started before others are invited to retry, so that they keep their place.
+    _this->StartQueuedCASERequests();
+#endif
+
+    if (_this->FindFreeSession() != NULL)
     {
         _this->ExchangeManager->NotifySecurityManagerAvailable();
     }
@@ -3408,32 +3956,52 @@ void WeaveSecurityManager::DoNotifySecurityManagerAvailable(System::Layer *syste
  * @param[in]  reqState         A pointer value that matches the value supplied by the application
  *                              when the session was started.
  *
- * @retval #WEAVE_NO_ERROR      If a matching in-progress session establishment was found and canceled.
+ * @retval #WEAVE_NO_ERROR      If a matching in-progress or held session establishment was found and canceled.
  *
- * @retval #WEAVE_ERROR_INCORRECT_STATE   If there was no session establishment in progress, or the
- *                              in-progress session did not match the supplied request state pointer.
+ * @retval #WEAVE_ERROR_INCORRECT_STATE   If there was no session establishment in progress, or no
+ *                              in-progress session matched the supplied request state pointer.
  */
 WEAVE_ERROR WeaveSecurityManager::CancelSessionEstablishment(void *reqState)
 {
-    // If a session establishment is in progress and the supplied request state matches what was provided
-    // when the session was started...
-    if ((State == kState_CASEInProgress || State == kState_PASEInProgress || State == kState_TAKEInProgress) &&
-        reqState == mStartSecureSession_ReqState)
+    for (int i = 0; i < WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS; i++)
     {
-        // Clear the application's OnError handler to prevent a callback.
-        mStartSecureSession_OnError = NULL;
+        SessionContext *session = &mSessions[i];
+
+        // If a session establishment is in progress and the supplied request state matches what was provided
+        // when the session was started...
+        if ((session->mState == kState_CASEInProgress || session->mState == kState_PASEInProgress ||
+             session->mState == kState_TAKEInProgress) &&
+            reqState == session->mStartSecureSession_ReqState)
+        {
+            mSession = session;
 
-        // Fail the session with a canceled error.
-        HandleSessionError(WEAVE_ERROR_TRANSACTION_CANCELED, NULL);
+            // Clear the application's OnError handler to prevent a callback.
+            mSession->mStartSecureSession_OnError = NULL;
 
-        return WEAVE_NO_ERROR;
+            // Fail the session with a canceled error.
+            HandleSessionError(WEAVE_ERROR_TRANSACTION_CANCELED, NULL);
+
+            return WEAVE_NO_ERROR;
+        }
     }
 
-    // Otherwise, tell the caller there was no match.
-    else
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+    // A held request has not been started, so it is simply dropped.
+    for (int i = 0; i < mNumQueuedCASERequests; i++)
     {
-        return WEAVE_ERROR_INCORRECT_STATE;
+        if (mQueuedCASERequests[i].ReqState == reqState)
+        {
+            mNumQueuedCASERequests--;
+            memmove(&mQueuedCASERequests[i], &mQueuedCASERequests[i + 1],
+                    (mNumQueuedCASERequests - i) * sizeof(QueuedCASERequest));
+
+            return WEAVE_NO_ERROR;
+        }
     }
+#endif
+
+    // Otherwise, tell the caller there was no match.
+    return WEAVE_ERROR_INCORRECT_STATE;
 }
 
 /**
@@ -194,7 +194,8 @@ public:
 
     WeaveFabricState *FabricState;                      // [READ ONLY] Associated Fabric State object.
     WeaveExchangeManager *ExchangeManager;              // [READ ONLY] Associated Exchange Manager object.
-    uint8_t State;                                      // [READ ONLY] State of the Weave Message Layer object
+    uint8_t State;                                      // [READ ONLY] State of the Weave Security Manager object: idle unless
+                                                        // a session establishment is in progress
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR
     uint32_t InitiatorCASEConfig;                       // CASE configuration proposed when initiating a CASE session
     uint32_t InitiatorCASECurveId;                      // ECDH curve proposed when initiating a CASE session
@@ -363,48 +364,85 @@ private:
         kFlag_IdleSessionTimerRunning   = 0x01
     };
 
-    ExchangeContext *mEC;
-    WeaveConnection *mCon;
-    union
+    /**
+     * The state of a single in-progress session establishment or key export.
+     */
+    struct SessionContext
     {
+        WeaveSecurityManager *mSecMgr;
+        uint8_t mState;
+        ExchangeContext *mEC;
+        WeaveConnection *mCon;
+        union
+        {
 #if WEAVE_CONFIG_ENABLE_PASE_INITIATOR || WEAVE_CONFIG_ENABLE_PASE_RESPONDER
-        WeavePASEEngine *mPASEEngine;
+            WeavePASEEngine *mPASEEngine;
 #endif
 #if WEAVE_CONFIG_ENABLE_CASE_INITIATOR || WEAVE_CONFIG_ENABLE_CASE_RESPONDER
-        WeaveCASEEngine *mCASEEngine;
+            WeaveCASEEngine *mCASEEngine;
 #endif
 #if WEAVE_CONFIG_ENABLE_TAKE_INITIATOR || WEAVE_CONFIG_ENABLE_TAKE_RESPONDER
-        WeaveTAKEEngine *mTAKEEngine;
+            WeaveTAKEEngine *mTAKEEngine;
 #endif
 #if WEAVE_CONFIG_ENABLE_KEY_EXPORT_INITIATOR
-        WeaveKeyExport *mKeyExport;
+            WeaveKeyExport *mKeyExport;
 #endif
+        };
+        union
+        {
+            SessionEstablishedFunct mStartSecureSession_OnComplete;
+
+            /**
+             * The key export protocol complete callback function. This function is
+             * called when the secret key export process is complete.
+             */
+            KeyExportCompleteFunct mStartKeyExport_OnComplete;
+        };
+        union
+        {
+            SessionErrorFunct mStartSecureSession_OnError;
+
+            /**
+             * The key export protocol error callback function. This function is
+             * called when an error is encountered during key export process.
+             */
+            KeyExportErrorFunct mStartKeyExport_OnError;
+        };
+        union
+        {
+            void *mStartSecureSession_ReqState;
+            void *mStartKeyExport_ReqState;
+        };
+        uint16_t mSessionKeyId;
+        WeaveAuthMode mRequestedAuthMode;
+        uint8_t mEncType;
     };
-    union
-    {
-        SessionEstablishedFunct mStartSecureSession_OnComplete;
-
-        /**
-         * The key export protocol complete callback function. This function is
-         * called when the secret key export process is complete.
-         */
-        KeyExportCompleteFunct mStartKeyExport_OnComplete;
-    };
-    union
-    {
-        SessionErrorFunct mStartSecureSession_OnError;
 
-        /**
-         * The key export protocol error callback function. This function is
-         * called when an error is encountered during key export process.
-         */
-        KeyExportErrorFunct mStartKeyExport_OnError;
-    };
-    union
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+    /**
+     * A CASE session request that arrived while the security manager was busy.
+     */
+    struct QueuedCASERequest
     {
-        void *mStartSecureSession_ReqState;
-        void *mStartKeyExport_ReqState;
+        WeaveConnection *Con;
+        uint64_t PeerNodeId;
+        IPAddress PeerAddr;
+        uint16_t PeerPort;
+        WeaveAuthMode RequestedAuthMode;
+        void *ReqState;
+        SessionEstablishedFunct OnComplete;
+        SessionErrorFunct OnError;
+        WeaveCASEAuthDelegate *AuthDelegate;
+        uint64_t TerminatingNodeId;
     };
+
+    QueuedCASERequest mQueuedCASERequests[WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS];
+    uint8_t mNumQueuedCASERequests;
+#endif
+
+    SessionContext mSessions[WEAVE_CONFIG_SECURITY_MGR_MAX_CONCURRENT_SESSIONS];
+    SessionContext *mSession;               // The session on which the security manager is currently acting.
+
 #if WEAVE_CONFIG_ENABLE_PASE_RESPONDER
     uint32_t mPASERateLimiterTimeout;
     uint8_t mPASERateLimiterCount;
@@ -423,9 +461,6 @@ private:
     WeaveKeyExportDelegate *mDefaultKeyExportDelegate;
 #endif
 
-    uint16_t        mSessionKeyId;
-    WeaveAuthMode   mRequestedAuthMode;
-    uint8_t         mEncType;
     System::Layer*  mSystemLayer;
     uint8_t         mFlags;
 
@@ -461,6 +496,10 @@ private:
 
     void StartCASESession(uint32_t config, uint32_t curveId);
     void HandleCASESessionStart(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    void StartCASEResumption(const WeaveCASEResumptionTicket& ticket);
+    void HandleCASEResumeSessionStart(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
+#endif
     static void HandleCASEMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
             uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
     static void HandleCASEMessageResponder(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
@@ -502,7 +541,7 @@ private:
 
     void HandleKeyExportRequest(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, PacketBuffer *msgBuf);
     WEAVE_ERROR SendKeyExportRequest(uint8_t keyExportConfig, uint32_t keyId, bool signMessage);
-    WEAVE_ERROR SendKeyExportResponse(WeaveKeyExport& keyExport, uint8_t msgType, const WeaveMessageInfo *msgInfo);
+    WEAVE_ERROR SendKeyExportResponse(ExchangeContext *ec, WeaveKeyExport& keyExport, uint8_t msgType, const WeaveMessageInfo *msgInfo);
     static void HandleKeyExportMessageInitiator(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
                                                 uint32_t profileId, uint8_t msgType, PacketBuffer *msgBuf);
     void HandleKeyExportError(WEAVE_ERROR err, PacketBuffer *statusReportMsgBuf);
@@ -514,6 +553,19 @@ private:
 
     void Reset(void);
 
+    void InitSession(SessionContext *session);
+    SessionContext *FindFreeSession(void);
+    SessionContext *FindSession(const ExchangeContext *ec);
+    void BeginSession(uint8_t state);
+    bool IsCASESessionInProgress(uint64_t peerNodeId, uint16_t keyId);
+
+#if WEAVE_CONFIG_SECURITY_MGR_MAX_QUEUED_CASE_REQUESTS > 0
+    WEAVE_ERROR QueueCASERequest(WeaveConnection *con, uint64_t peerNodeId, const IPAddress &peerAddr, uint16_t peerPort,
+                                 WeaveAuthMode requestedAuthMode, void *reqState, SessionEstablishedFunct onComplete,
+                                 SessionErrorFunct onError, WeaveCASEAuthDelegate *authDelegate, uint64_t terminatingNodeId);
+    void StartQueuedCASERequests(void);
+#endif
+
     void AsyncNotifySecurityManagerAvailable();
     static void DoNotifySecurityManagerAvailable(System::Layer *systemLayer, void *appState, System::Error err);
 
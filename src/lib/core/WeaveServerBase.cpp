@@ -26,6 +26,8 @@
  *
  */
 
+#include <string.h>
+
 #include <Weave/Core/WeaveCore.h>
 #include "WeaveServerBase.h"
 #include <Weave/Core/WeaveTLV.h>
@@ -148,26 +150,68 @@ WEAVE_ERROR WeaveServerBase::SendStatusReport(ExchangeContext *ec, uint32_t stat
  */
 WEAVE_ERROR WeaveServerBase::SendStatusReport(ExchangeContext *ec, uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError, uint16_t sendFlags)
 {
-    WEAVE_ERROR     err;
+    WEAVE_ERROR     err = WEAVE_NO_ERROR;
     PacketBuffer*   respBuf;
-    uint8_t*        p;
-    uint8_t         respLen = 18; // sizeof(statusProfileId) + sizeof(statusCode) + StartContainer(1) + kTag_SystemErrorCode TLV Len (10), EndContainer (1)
 
-    respBuf = PacketBuffer::NewWithAvailableSize(respLen);
+    respBuf = PacketBuffer::NewWithAvailableSize(kMaxStatusReportLen);
     VerifyOrExit(respBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
     VerifyOrDie(ec != NULL);
 
-    p = respBuf->Start();
+#if WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE > 0
+    // Status reports that carry a system error are typically sent in bursts, e.g. while the server is rejecting
+    // requests for lack of resources.  Copy those from the cache rather than encoding their TLV each time.
+    if (sysError != WEAVE_NO_ERROR)
+    {
+        const CachedStatusReport *cached = FindCachedStatusReport(statusProfileId, statusCode, sysError);
+
+        if (cached != NULL)
+        {
+            memcpy(respBuf->Start(), cached->Payload, cached->Len);
+            respBuf->SetDataLength(cached->Len);
+        }
+        else
+        {
+            err = EncodeStatusReport(respBuf, statusProfileId, statusCode, sysError);
+            SuccessOrExit(err);
+
+            CacheStatusReport(respBuf, statusProfileId, statusCode, sysError);
+        }
+    }
+    else
+#endif // WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE > 0
+    {
+        err = EncodeStatusReport(respBuf, statusProfileId, statusCode, sysError);
+        SuccessOrExit(err);
+    }
+
+    err = ec->SendMessage(kWeaveProfile_Common, Common::kMsgType_StatusReport, respBuf, sendFlags);
+    respBuf = NULL;
+
+exit:
+    if (respBuf != NULL)
+        PacketBuffer::Free(respBuf);
+    return err;
+}
+
+/**
+ *  Encode the payload of a Weave status report into an empty buffer.
+ */
+WEAVE_ERROR WeaveServerBase::EncodeStatusReport(PacketBuffer *buf, uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError)
+{
+    WEAVE_ERROR     err = WEAVE_NO_ERROR;
+    uint8_t*        p;
+
+    p = buf->Start();
     LittleEndian::Write32(p, statusProfileId);
     LittleEndian::Write16(p, statusCode);
-    respBuf->SetDataLength(6);
+    buf->SetDataLength(6);
 
     if (sysError != WEAVE_NO_ERROR)
     {
         TLVWriter statusWriter;
         TLVType outerContainerType;
 
-        statusWriter.Init(respBuf);
+        statusWriter.Init(buf);
 
         err = statusWriter.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
         SuccessOrExit(err);
@@ -182,15 +226,93 @@ WEAVE_ERROR WeaveServerBase::SendStatusReport(ExchangeContext *ec, uint32_t stat
         SuccessOrExit(err);
     }
 
-    err = ec->SendMessage(kWeaveProfile_Common, Common::kMsgType_StatusReport, respBuf, sendFlags);
-    respBuf = NULL;
+exit:
+    return err;
+}
+
+#if WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE > 0
+
+WeaveServerBase::CachedStatusReport WeaveServerBase::sStatusReportCache[WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE];
+uint8_t WeaveServerBase::sNextStatusReportCacheEntry;
+
+/**
+ *  Encode a Weave status report ahead of time, so that sending it later
+ *  costs no more than copying it into a new message.
+ *
+ *  Servers call this during initialization for the status reports they
+ *  send when overloaded, such as Common/Busy with a resource error.
+ *  Status reports are otherwise cached the first time they are sent.
+ *  Reports without a system error are cheap to encode and are never
+ *  cached.
+ *
+ *  @param[in]    statusProfileId  The profile for the specified status code.
+ *
+ *  @param[in]    statusCode       The status code.
+ *
+ *  @param[in]    sysError         The system error associated or correlated
+ *                                 with the status code.
+ *
+ *  @retval #WEAVE_NO_ERROR             On success, or if \c sysError is #WEAVE_NO_ERROR.
+ *  @retval #WEAVE_ERROR_NO_MEMORY      If no buffer was available for encoding.
+ */
+WEAVE_ERROR WeaveServerBase::PreencodeStatusReport(uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError)
+{
+    WEAVE_ERROR     err = WEAVE_NO_ERROR;
+    PacketBuffer*   buf = NULL;
+
+    VerifyOrExit(sysError != WEAVE_NO_ERROR, );
+    VerifyOrExit(FindCachedStatusReport(statusProfileId, statusCode, sysError) == NULL, );
+
+    buf = PacketBuffer::NewWithAvailableSize(kMaxStatusReportLen);
+    VerifyOrExit(buf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = EncodeStatusReport(buf, statusProfileId, statusCode, sysError);
+    SuccessOrExit(err);
+
+    CacheStatusReport(buf, statusProfileId, statusCode, sysError);
 
 exit:
-    if (respBuf != NULL)
-        PacketBuffer::Free(respBuf);
+    if (buf != NULL)
+        PacketBuffer::Free(buf);
     return err;
 }
 
+const WeaveServerBase::CachedStatusReport *WeaveServerBase::FindCachedStatusReport(uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError)
+{
+    for (int i = 0; i < WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE; i++)
+    {
+        const CachedStatusReport &entry = sStatusReportCache[i];
+
+        if (entry.Len != 0 && entry.StatusCode == statusCode && entry.StatusProfileId == statusProfileId &&
+            entry.SysError == sysError)
+            return &entry;
+    }
+
+    return NULL;
+}
+
+void WeaveServerBase::CacheStatusReport(const PacketBuffer *buf, uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError)
+{
+    // Entries are replaced in turn once the cache is full.
+    CachedStatusReport &entry = sStatusReportCache[sNextStatusReportCacheEntry];
+
+    sNextStatusReportCacheEntry = (sNextStatusReportCacheEntry + 1) % WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE;
+
+    if (buf->DataLength() > sizeof(entry.Payload))
+    {
+        entry.Len = 0;
+        return;
+    }
+
+    entry.StatusProfileId = statusProfileId;
+    entry.StatusCode = statusCode;
+    entry.SysError = sysError;
+    entry.Len = static_cast<uint8_t>(buf->DataLength());
+    memcpy(entry.Payload, buf->Start(), entry.Len);
+}
+
+#endif // WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE > 0
+
 /**
  * Virtual method for determining message-level access control policy for incoming server request messages.
  *
@@ -59,6 +59,10 @@ public:
 
     static WEAVE_ERROR SendStatusReport(ExchangeContext *ec, uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError, uint16_t sendFlags);
 
+#if WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE > 0
+    static WEAVE_ERROR PreencodeStatusReport(uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError);
+#endif
+
 protected:
     WeaveServerBase(void) { }
 
@@ -67,6 +71,31 @@ protected:
 
 private:
     WeaveServerBase(const WeaveServerBase&); // not defined
+
+    enum
+    {
+        kMaxStatusReportLen = 18    ///< sizeof(statusProfileId) + sizeof(statusCode) + StartContainer(1) + kTag_SystemErrorCode TLV Len (10), EndContainer (1)
+    };
+
+    static WEAVE_ERROR EncodeStatusReport(PacketBuffer *buf, uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError);
+
+#if WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE > 0
+    // A StatusReport payload that has already been encoded, ready to be copied into a new message.
+    struct CachedStatusReport
+    {
+        uint32_t StatusProfileId;
+        WEAVE_ERROR SysError;
+        uint16_t StatusCode;
+        uint8_t Len;                            ///< Length of the encoded payload; zero marks a free entry.
+        uint8_t Payload[kMaxStatusReportLen];
+    };
+
+    static CachedStatusReport sStatusReportCache[WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE];
+    static uint8_t sNextStatusReportCacheEntry;
+
+    static const CachedStatusReport *FindCachedStatusReport(uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError);
+    static void CacheStatusReport(const PacketBuffer *buf, uint32_t statusProfileId, uint16_t statusCode, WEAVE_ERROR sysError);
+#endif // WEAVE_CONFIG_STATUS_REPORT_CACHE_SIZE > 0
 };
 
 
@@ -23,6 +23,8 @@
  *
  */
 
+#include <string.h>
+
 #include <Weave/Core/WeaveCore.h>
 #include <Weave/Support/CodeUtils.h>
 #include <Weave/Core/WeaveExchangeMgr.h>
@@ -67,6 +69,127 @@ void UpdateSnapshot(nl::Weave::System::Stats::Snapshot &aSnapshot)
     }
 }
 
+/**
+ * Discard all samples.
+ */
+void Histogram::Clear(void)
+{
+    memset(this, 0, sizeof(*this));
+}
+
+/**
+ * Add a sample to the histogram.
+ *
+ * @param[in] aValue        The sample.
+ */
+void Histogram::Record(uint32_t aValue)
+{
+    uint8_t bucket = 0;
+
+    Count++;
+    Sum += aValue;
+    if (aValue > Max)
+        Max = aValue;
+
+    for (uint32_t v = aValue; v != 0 && bucket < kNumBuckets - 1; v >>= 1)
+        bucket++;
+
+    Buckets[bucket]++;
+}
+
+/**
+ * Get the smallest sample counted by a bucket.
+ *
+ * @param[in] aBucket       The bucket index, less than kNumBuckets.
+ *
+ * @return The smallest sample counted by the bucket.
+ */
+uint32_t Histogram::GetBucketLowerBound(uint8_t aBucket)
+{
+    return (aBucket == 0) ? 0 : (static_cast<uint32_t>(1) << (aBucket - 1));
+}
+
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+
+static ExchangeStats sExchangeStats;
+
+/**
+ * Copy the current exchange layer statistics.
+ *
+ * @param[out] aSnapshot    The ExchangeStats object to be updated.
+ */
+void GetExchangeStats(ExchangeStats &aSnapshot)
+{
+    aSnapshot = sExchangeStats;
+}
+
+/**
+ * Discard all exchange layer statistics.
+ */
+void ResetExchangeStats(void)
+{
+    memset(&sExchangeStats, 0, sizeof(sExchangeStats));
+}
+
+/**
+ * Record the time taken for a response to arrive.
+ *
+ * @param[in] aProfileId    The profile of the response.
+ * @param[in] aLatency      The time since the message expecting the response was sent.
+ */
+void RecordResponseLatency(uint32_t aProfileId, uint32_t aLatency)
+{
+    for (size_t i = 0; i < WEAVE_CONFIG_EXCHANGE_STATS_MAX_PROFILES; i++)
+    {
+        ExchangeStats::ProfileLatency &entry = sExchangeStats.ResponseLatency[i];
+
+        if (entry.Latency.Count == 0)
+            entry.ProfileId = aProfileId;
+
+        if (entry.ProfileId == aProfileId)
+        {
+            entry.Latency.Record(aLatency);
+            return;
+        }
+    }
+
+    sExchangeStats.OtherResponseLatency.Record(aLatency);
+}
+
+/**
+ * Record the number of times an acknowledged message was retransmitted.
+ */
+void RecordRetransmissions(uint8_t aCount)
+{
+    sExchangeStats.Retransmissions.Record(aCount);
+}
+
+/**
+ * Count a retransmission.
+ */
+void RecordRetransmission(void)
+{
+    sExchangeStats.NumRetransmissions++;
+}
+
+/**
+ * Record the time for which an acknowledgment was pending.
+ */
+void RecordAckDelay(uint32_t aDelay)
+{
+    sExchangeStats.AckDelay.Record(aDelay);
+}
+
+/**
+ * Record the lifetime of an exchange context.
+ */
+void RecordExchangeLifetime(uint32_t aLifetime)
+{
+    sExchangeStats.ExchangeLifetime.Record(aLifetime);
+}
+
+#endif // WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+
 } // namespace Stats
 } // namespace Weave
 } // namespace nl
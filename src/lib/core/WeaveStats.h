@@ -39,6 +39,66 @@ void UpdateSnapshot(nl::Weave::System::Stats::Snapshot &aSnapshot);
 
 void SetObjects(WeaveMessageLayer *aMessageLayer);
 
+/**
+ * A histogram of samples in logarithmically sized buckets.
+ *
+ * Bucket 0 counts samples of 0, and bucket i, for i > 0, counts samples
+ * from 2^(i-1) up to 2^i - 1, except that the last bucket also counts all
+ * larger samples.
+ */
+class Histogram
+{
+public:
+    enum
+    {
+        kNumBuckets = 16
+    };
+
+    uint32_t Buckets[kNumBuckets];  /**< The number of samples in each bucket. */
+    uint32_t Count;                 /**< The total number of samples. */
+    uint32_t Max;                   /**< The largest sample. */
+    uint64_t Sum;                   /**< The sum of all samples. */
+
+    void Clear(void);
+    void Record(uint32_t aValue);
+
+    static uint32_t GetBucketLowerBound(uint8_t aBucket);
+};
+
+/**
+ * Latency and retransmission statistics for the exchange layer. All times are in
+ * milliseconds.
+ */
+class ExchangeStats
+{
+public:
+    struct ProfileLatency
+    {
+        uint32_t ProfileId;         /**< The profile; only meaningful if Latency.Count is non-zero. */
+        Histogram Latency;          /**< Time from sending a message that expects a response to receiving it. */
+    };
+
+    ProfileLatency ResponseLatency[WEAVE_CONFIG_EXCHANGE_STATS_MAX_PROFILES];
+    Histogram OtherResponseLatency; /**< Response latency of profiles for which there was no room above. */
+    Histogram Retransmissions;      /**< The number of retransmissions of each acknowledged WRMP message. */
+    Histogram AckDelay;             /**< Time from receiving a message that requests an ack to sending the ack. */
+    Histogram ExchangeLifetime;     /**< Time from allocating an exchange context to freeing it. */
+    uint32_t NumRetransmissions;    /**< The total number of WRMP retransmissions sent. */
+};
+
+#if WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+
+void GetExchangeStats(ExchangeStats &aSnapshot);
+void ResetExchangeStats(void);
+
+void RecordResponseLatency(uint32_t aProfileId, uint32_t aLatency);
+void RecordRetransmissions(uint8_t aCount);
+void RecordRetransmission(void);
+void RecordAckDelay(uint32_t aDelay);
+void RecordExchangeLifetime(uint32_t aLifetime);
+
+#endif // WEAVE_CONFIG_PROVIDE_EXCHANGE_STATS
+
 } // namespace Stats
 } // namespace Weave
 } // namespace nl
@@ -30,6 +30,7 @@
 
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 
 #include <Weave/Support/NLDLLUtil.h>
 #include <Weave/Core/WeaveError.h>
@@ -66,6 +67,39 @@ enum {
     kTLVControlByte_NotSpecified = 0xFFFF
 };
 
+/**
+ * Provides a fixed buffer from which a TLVReader can allocate copies of string values.
+ *
+ * A TLVArena is a simple bump allocator over a caller-supplied buffer.  Allocations are
+ * byte-aligned and are never freed individually; instead the arena is rewound or reset as a
+ * whole, typically once the message from which the values were read has been processed.
+ */
+class NL_DLL_EXPORT TLVArena
+{
+public:
+    void Init(uint8_t *buf, uint32_t bufLen) { mBuf = buf; mBufLen = bufLen; mUsedLen = 0; }
+
+    void *Alloc(uint32_t size)
+    {
+        if (mBuf == NULL || size > mBufLen - mUsedLen)
+            return NULL;
+        void *p = mBuf + mUsedLen;
+        mUsedLen += size;
+        return p;
+    }
+
+    void Rewind(uint32_t usedLen) { if (usedLen < mUsedLen) mUsedLen = usedLen; }
+    void Reset(void) { mUsedLen = 0; }
+
+    uint32_t GetUsedLength(void) const { return mUsedLen; }
+    uint32_t GetRemainingLength(void) const { return mBufLen - mUsedLen; }
+
+private:
+    uint8_t *mBuf;
+    uint32_t mBufLen;
+    uint32_t mUsedLen;
+};
+
 /**
  * Provides a memory efficient parser for data encoded in Weave TLV format.
  *
@@ -96,6 +130,7 @@ class NL_DLL_EXPORT TLVReader
 {
 friend class TLVWriter;
 friend class TLVUpdater;
+friend class TLVIndex;
 
 public:
     // *** See WeaveTLVReader.cpp file for API documentation ***
@@ -126,9 +161,12 @@ public:
     WEAVE_ERROR Get(double& v);
     WEAVE_ERROR GetBytes(uint8_t *buf, uint32_t bufSize);
     WEAVE_ERROR DupBytes(uint8_t *& buf, uint32_t& dataLen);
+    WEAVE_ERROR DupBytes(TLVArena& arena, uint8_t *& buf, uint32_t& dataLen);
     WEAVE_ERROR GetString(char *buf, uint32_t bufSize);
     WEAVE_ERROR DupString(char *& buf);
+    WEAVE_ERROR DupString(TLVArena& arena, char *& buf);
     WEAVE_ERROR GetDataPtr(const uint8_t *& data);
+    WEAVE_ERROR GetDataView(TLVArena& arena, const uint8_t *& data, uint32_t& dataLen);
 
     WEAVE_ERROR EnterContainer(TLVType& outerContainerType);
     WEAVE_ERROR ExitContainer(TLVType outerContainerType);
@@ -174,10 +212,13 @@ protected:
     void ClearElementState(void);
     WEAVE_ERROR SkipData(void);
     WEAVE_ERROR SkipToEndOfContainer(void);
+    void SkipElementsInBuffer(uint32_t& nestLevel);
     WEAVE_ERROR VerifyElement(void);
     uint64_t ReadTag(TLVTagControl tagControl, const uint8_t *& p);
-    WEAVE_ERROR EnsureData(WEAVE_ERROR noDataErr);
-    WEAVE_ERROR ReadData(uint8_t *buf, uint32_t len);
+    inline WEAVE_ERROR EnsureData(WEAVE_ERROR noDataErr);
+    inline WEAVE_ERROR ReadData(uint8_t *buf, uint32_t len);
+    WEAVE_ERROR ReadNextBuffer(WEAVE_ERROR noDataErr);
+    WEAVE_ERROR ReadDataAcrossBuffers(uint8_t *buf, uint32_t len);
     WEAVE_ERROR GetElementHeadLength(uint8_t& elemHeadBytes) const;
     TLVElementType ElementType(void) const;
 
@@ -192,6 +233,37 @@ protected:
 #endif // WEAVE_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 };
 
+/**
+ * Ensures that input data is available at the current read point, fetching the next input buffer
+ * if the current one has been exhausted.
+ *
+ * The check against the end of the current buffer is made inline, so that readers over a single
+ * contiguous buffer (the common case) never leave the caller.
+ */
+inline WEAVE_ERROR TLVReader::EnsureData(WEAVE_ERROR noDataErr)
+{
+    return (mReadPoint != mBufEnd) ? WEAVE_NO_ERROR : ReadNextBuffer(noDataErr);
+}
+
+/**
+ * Reads (or, if @p buf is NULL, skips) @p len bytes of input.
+ *
+ * Data that lies entirely within the current input buffer is consumed inline with a single bounds
+ * check; only data that spans input buffers is read through the GetNextBuffer callback.
+ */
+inline WEAVE_ERROR TLVReader::ReadData(uint8_t *buf, uint32_t len)
+{
+    if (len > (uint32_t)(mBufEnd - mReadPoint))
+        return ReadDataAcrossBuffers(buf, len);
+
+    if (buf != NULL)
+        memcpy(buf, mReadPoint, len);
+    mReadPoint += len;
+    mLenRead += len;
+
+    return WEAVE_NO_ERROR;
+}
+
 #if WEAVE_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 inline WEAVE_ERROR TLVReader::GetNextInetBuffer(TLVReader& reader, uintptr_t& bufHandle, const uint8_t *& bufStart,
     uint32_t& bufLen)
@@ -248,6 +320,7 @@ public:
     WEAVE_ERROR Put(uint64_t tag, double v);
     WEAVE_ERROR PutBoolean(uint64_t tag, bool v);
     WEAVE_ERROR PutBytes(uint64_t tag, const uint8_t *buf, uint32_t len);
+    WEAVE_ERROR PutBytes(uint64_t tag, PacketBuffer *data);
     WEAVE_ERROR StartPutBytes(uint64_t tag, uint32_t totalLen);
     WEAVE_ERROR ContinuePutBytes(const uint8_t *buf, uint32_t len);
     WEAVE_ERROR PutString(uint64_t tag, const char *buf);
@@ -263,6 +336,7 @@ public:
     WEAVE_ERROR OpenContainer(uint64_t tag, TLVType containerType, TLVWriter& containerWriter);
     WEAVE_ERROR CloseContainer(TLVWriter& containerWriter);
     WEAVE_ERROR PutPreEncodedContainer(uint64_t tag, TLVType containerType, const uint8_t *data, uint32_t dataLen);
+    WEAVE_ERROR PutPreEncodedContainer(uint64_t tag, TLVType containerType, PacketBuffer *data);
     WEAVE_ERROR CopyContainer(TLVReader& container);
     WEAVE_ERROR CopyContainer(uint64_t tag, TLVReader& container);
     WEAVE_ERROR CopyContainer(uint64_t tag, const uint8_t * encodedContainer, uint16_t encodedContainerLen);
@@ -337,6 +411,7 @@ protected:
     WEAVE_ERROR WriteElementHead(TLVElementType elemType, uint64_t tag, uint64_t lenOrVal);
     WEAVE_ERROR WriteElementWithData(TLVType type, uint64_t tag, const uint8_t *data, uint32_t dataLen);
     WEAVE_ERROR WriteData(const uint8_t *p, uint32_t len);
+    WEAVE_ERROR WriteData(PacketBuffer *data, uint32_t dataLen);
 };
 
 #if WEAVE_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
@@ -390,6 +465,7 @@ class NL_DLL_EXPORT TLVUpdater
 public:
     WEAVE_ERROR Init(uint8_t *buf, uint32_t dataLen, uint32_t maxLen);
     WEAVE_ERROR Init(TLVReader& aReader, uint32_t freeLen);
+    WEAVE_ERROR InitInPlace(uint8_t *buf, uint32_t dataLen, uint32_t maxLen);
     WEAVE_ERROR Finalize(void) { return mUpdaterWriter.Finalize(); }
 
     // Common methods
@@ -458,15 +534,17 @@ public:
     WEAVE_ERROR StartContainer(uint64_t tag, TLVType containerType, TLVType& outerContainerType) { return mUpdaterWriter.StartContainer(tag, containerType, outerContainerType); }
     WEAVE_ERROR EndContainer(TLVType outerContainerType) { return mUpdaterWriter.EndContainer(outerContainerType); }
     uint32_t GetLengthWritten(void) { return mUpdaterWriter.GetLengthWritten(); }
-    uint32_t GetRemainingFreeLength(void) { return mUpdaterWriter.mRemainingLen; }
+    uint32_t GetRemainingFreeLength(void) { return mUpdaterWriter.mRemainingLen + mDeferredFreeLen; }
 
 private:
     void AdjustInternalWriterFreeSpace(void);
+    static WEAVE_ERROR OpenDeferredGap(TLVWriter& writer, uintptr_t& bufHandle, uint8_t *& bufStart, uint32_t& bufLen);
 
 private:
     TLVWriter       mUpdaterWriter;
     TLVReader       mUpdaterReader;
     const uint8_t * mElementStartAddr;
+    uint32_t        mDeferredFreeLen;
 };
 
 } // namespace TLV
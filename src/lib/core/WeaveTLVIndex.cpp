@@ -0,0 +1,295 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the TLVIndex class, a structural index over a
+ *      Weave TLV encoding.
+ *
+ */
+
+#include <Weave/Core/WeaveTLVIndex.hpp>
+#include <Weave/Support/CodeUtils.h>
+
+namespace nl {
+
+namespace Weave {
+
+namespace TLV {
+
+/**
+ * Build an index of the TLV encoding in the supplied buffer.
+ *
+ * The buffer may contain any number of top-level elements.  The index refers to, but does not
+ * copy, the buffer, which must remain unchanged for as long as the index is in use.
+ *
+ * @param[in] data                      A pointer to the TLV encoding to be indexed.
+ * @param[in] dataLen                   The length of the TLV encoding.
+ * @param[in] entries                   An array that will receive one entry for each element.
+ * @param[in] maxEntries                The number of entries in the @p entries array.
+ * @param[in] implicitProfileId         The profile id used to decode implicit profile tags.
+ *
+ * @retval #WEAVE_NO_ERROR              If the index was built.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL
+ *                                      If the encoding contains more than @p maxEntries elements.
+ * @retval other                        Errors returned by TLVReader if the encoding is malformed.
+ *
+ */
+WEAVE_ERROR TLVIndex::Init(const uint8_t *data, uint32_t dataLen, Entry *entries, uint32_t maxEntries,
+                           uint32_t implicitProfileId)
+{
+    WEAVE_ERROR err;
+    TLVReader reader;
+
+    mData = data;
+    mDataLen = dataLen;
+    mEntries = entries;
+    mMaxEntries = maxEntries;
+    mEntryCount = 0;
+
+    reader.Init(data, dataLen);
+    reader.ImplicitProfileId = implicitProfileId;
+
+    err = IndexElements(reader);
+    if (err == WEAVE_END_OF_TLV)
+        err = WEAVE_NO_ERROR;
+    SuccessOrExit(err);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        Reset();
+    return err;
+}
+
+/**
+ * Discard the contents of the index.
+ */
+void TLVIndex::Reset(void)
+{
+    mData = NULL;
+    mDataLen = 0;
+    mEntries = NULL;
+    mMaxEntries = 0;
+    mEntryCount = 0;
+}
+
+/**
+ * Find a member of a container by tag.
+ *
+ * On success, @p aResult is positioned on the first member of the container with the
+ * specified tag, exactly as if it had been supplied to @p aContainer.OpenContainer() and
+ * advanced with Next() until the member was reached.  Unlike OpenContainer(), @p aContainer
+ * is not modified, and @p aResult need not be closed.  Only direct members of the container
+ * are considered.
+ *
+ * @param[in]  aContainer               A reader positioned on a container element.
+ * @param[in]  aTag                     The tag of the member to find.
+ * @param[out] aResult                  A reader that will be positioned on the member.
+ *
+ * @retval #WEAVE_NO_ERROR              If the member was found.
+ * @retval #WEAVE_ERROR_TLV_TAG_NOT_FOUND
+ *                                      If the container has no member with the specified tag.
+ * @retval #WEAVE_ERROR_INCORRECT_STATE If @p aContainer is not positioned on a container element.
+ * @retval other                        Errors returned by TLVReader if the encoding is malformed.
+ *
+ */
+WEAVE_ERROR TLVIndex::Find(const TLVReader &aContainer, uint64_t aTag, TLVReader &aResult) const
+{
+    WEAVE_ERROR err;
+    uint32_t containerIndex;
+    TLVElementType elemType = aContainer.ElementType();
+
+    VerifyOrExit(TLVTypeIsContainer(elemType), err = WEAVE_ERROR_INCORRECT_STATE);
+
+    if (LookupElement(aContainer, containerIndex))
+    {
+        const uint32_t endIndex = containerIndex + mEntries[containerIndex].DescendantCount;
+        uint32_t i;
+        uint32_t delta;
+
+        for (i = containerIndex + 1; i <= endIndex; i += 1 + mEntries[i].DescendantCount)
+        {
+            if (mEntries[i].Tag == aTag)
+                break;
+        }
+        VerifyOrExit(i <= endIndex, err = WEAVE_ERROR_TLV_TAG_NOT_FOUND);
+
+        // Set up the result as a container reader (as per OpenContainer()) and move it directly to the member.
+        delta = mEntries[i].Offset - (uint32_t)(aContainer.mReadPoint - mData);
+
+        aResult.Init(aContainer);
+        aResult.ClearElementState();
+        aResult.mContainerType = (TLVType) elemType;
+        aResult.SetContainerOpen(false);
+        aResult.mReadPoint += delta;
+        aResult.mLenRead += delta;
+
+        err = aResult.ReadElement();
+    }
+
+    else
+    {
+        TLVReader parent;
+
+        parent.Init(aContainer);
+
+        err = parent.OpenContainer(aResult);
+        SuccessOrExit(err);
+
+        while ((err = aResult.Next()) == WEAVE_NO_ERROR)
+        {
+            if (aResult.GetTag() == aTag)
+                break;
+        }
+        if (err == WEAVE_END_OF_TLV)
+            err = WEAVE_ERROR_TLV_TAG_NOT_FOUND;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * Advance a reader to immediately after its current element.
+ *
+ * This has the same effect as TLVReader::Skip(), but when the reader is positioned on an
+ * indexed element the reader is moved directly past the element, including all members
+ * of a container, without parsing it.
+ *
+ * @param[in] aReader                   The reader to advance.
+ *
+ * @retval #WEAVE_NO_ERROR              If the reader was advanced.
+ * @retval #WEAVE_END_OF_TLV            If the reader is positioned at the end of a container.
+ * @retval other                        Errors returned by TLVReader::Skip().
+ *
+ */
+WEAVE_ERROR TLVIndex::Skip(TLVReader &aReader) const
+{
+    uint32_t entryIndex;
+    uint32_t delta;
+
+    if (!LookupElement(aReader, entryIndex))
+        return aReader.Skip();
+
+    delta = mEntries[entryIndex].EndOffset - (uint32_t)(aReader.mReadPoint - mData);
+
+    aReader.mReadPoint += delta;
+    aReader.mLenRead += delta;
+    aReader.ClearElementState();
+    aReader.SetContainerOpen(false);
+
+    return WEAVE_NO_ERROR;
+}
+
+WEAVE_ERROR TLVIndex::IndexElements(TLVReader &aReader)
+{
+    WEAVE_ERROR err;
+
+    while ((err = aReader.Next()) == WEAVE_NO_ERROR)
+    {
+        const uint32_t entryIndex = mEntryCount;
+        Entry *entry;
+        uint8_t headLen;
+
+        VerifyOrExit(entryIndex < mMaxEntries, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+        err = aReader.GetElementHeadLength(headLen);
+        SuccessOrExit(err);
+
+        entry = &mEntries[entryIndex];
+        entry->Tag = aReader.GetTag();
+        entry->Offset = (uint32_t)(aReader.mReadPoint - mData) - headLen;
+        entry->HeadLength = headLen;
+        mEntryCount++;
+
+        if (TLVTypeIsContainer(aReader.ElementType()))
+        {
+            TLVType outerContainerType;
+
+            err = aReader.EnterContainer(outerContainerType);
+            SuccessOrExit(err);
+
+            err = IndexElements(aReader);
+            if (err != WEAVE_END_OF_TLV)
+                ExitNow();
+
+            err = aReader.ExitContainer(outerContainerType);
+            SuccessOrExit(err);
+        }
+        else
+        {
+            err = aReader.Skip();
+            SuccessOrExit(err);
+        }
+
+        entry->EndOffset = (uint32_t)(aReader.mReadPoint - mData);
+        entry->DescendantCount = mEntryCount - entryIndex - 1;
+    }
+
+exit:
+    return err;
+}
+
+// Find the entry for the element on which a reader is positioned.  This fails if the reader is
+// not reading the indexed buffer, or if part of the element's data has already been read.
+bool TLVIndex::LookupElement(const TLVReader &aReader, uint32_t &aEntryIndex) const
+{
+    TLVElementType elemType = aReader.ElementType();
+    uint32_t dataOffset;
+    uint32_t lo, hi;
+
+    if (mEntryCount == 0 || elemType == kTLVElementType_NotSpecified || elemType == kTLVElementType_EndOfContainer)
+        return false;
+
+    if (aReader.mReadPoint < mData || aReader.mReadPoint > mData + mDataLen)
+        return false;
+
+    dataOffset = (uint32_t)(aReader.mReadPoint - mData);
+
+    // Entries are in encoding order, so the offsets of the elements' data are ascending.
+    lo = 0;
+    hi = mEntryCount;
+    while (lo < hi)
+    {
+        const uint32_t mid = lo + (hi - lo) / 2;
+        const uint32_t midDataOffset = mEntries[mid].Offset + mEntries[mid].HeadLength;
+
+        if (midDataOffset < dataOffset)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo == mEntryCount || mEntries[lo].Offset + mEntries[lo].HeadLength != dataOffset ||
+        mEntries[lo].Tag != aReader.mElemTag)
+        return false;
+
+    // The element must lie within the reader's current buffer and length limit.
+    if (mData + mEntries[lo].EndOffset > aReader.mBufEnd ||
+        mEntries[lo].EndOffset - dataOffset > aReader.mMaxLen - aReader.mLenRead)
+        return false;
+
+    aEntryIndex = lo;
+    return true;
+}
+
+} // namespace TLV
+
+} // namespace Weave
+
+} // namespace nl
@@ -0,0 +1,95 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the TLVIndex class, a structural index over a
+ *      Weave TLV encoding that allows TLVReader objects to find and
+ *      skip elements without parsing the intervening encoding.
+ *
+ */
+
+#ifndef WEAVETLVINDEX_HPP
+#define WEAVETLVINDEX_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Weave/Core/WeaveError.h>
+#include <Weave/Core/WeaveTLV.h>
+
+namespace nl {
+
+namespace Weave {
+
+namespace TLV {
+
+/**
+ * Provides a one-pass structural index of a TLV encoding held in a contiguous buffer.
+ *
+ * The index records, for every element in the encoding, its tag, its position, the position
+ * immediately following it (for containers, following the end-of-container marker) and the
+ * number of elements nested within it.  The entries are stored in caller-provided memory, in
+ * the order in which the elements appear in the encoding.
+ *
+ * Once built, the index can be used to position a TLVReader that is reading the same buffer:
+ * Find() locates a member of a container by tag by visiting only the entries of the
+ * container's direct members, and Skip() moves past an element, however large, in constant
+ * time.  Readers that are not positioned on an indexed element fall back to the equivalent
+ * TLVReader operations.
+ */
+class NL_DLL_EXPORT TLVIndex
+{
+public:
+    struct Entry
+    {
+        uint64_t Tag;                   ///< The element's tag.
+        uint32_t Offset;                ///< Offset of the element's control byte.
+        uint32_t EndOffset;             ///< Offset immediately following the element.
+        uint32_t DescendantCount;       ///< Number of elements nested within the element.
+        uint8_t HeadLength;             ///< Length of the element's control byte, tag and length or value fields.
+    };
+
+    WEAVE_ERROR Init(const uint8_t *data, uint32_t dataLen, Entry *entries, uint32_t maxEntries,
+                     uint32_t implicitProfileId = kProfileIdNotSpecified);
+    void Reset(void);
+
+    uint32_t GetEntryCount(void) const { return mEntryCount; }
+    const Entry *GetEntries(void) const { return mEntries; }
+
+    WEAVE_ERROR Find(const TLVReader &aContainer, uint64_t aTag, TLVReader &aResult) const;
+    WEAVE_ERROR Skip(TLVReader &aReader) const;
+
+private:
+    const uint8_t *mData;
+    uint32_t mDataLen;
+    Entry *mEntries;
+    uint32_t mMaxEntries;
+    uint32_t mEntryCount;
+
+    WEAVE_ERROR IndexElements(TLVReader &aReader);
+    bool LookupElement(const TLVReader &aReader, uint32_t &aEntryIndex) const;
+};
+
+} // namespace TLV
+
+} // namespace Weave
+
+} // namespace nl
+
+#endif // WEAVETLVINDEX_HPP
@@ -0,0 +1,934 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements streaming conversion between Weave TLV and
+ *      JSON.
+ *
+ */
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Weave/Core/WeaveTLV.h>
+#include <Weave/Core/WeaveTLVJson.hpp>
+#include <Weave/Support/Base64.h>
+#include <Weave/Support/CodeUtils.h>
+
+namespace nl {
+
+namespace Weave {
+
+namespace TLV {
+
+namespace Json {
+
+namespace {
+
+// Number of bytes of a byte string base-64 encoded at a time.  Must be a multiple of 3.
+enum
+{
+    kBase64ChunkLen = 48
+};
+
+static const char sHexDigits[] = "0123456789abcdef";
+
+/**
+ *  Accumulates JSON text in a fixed-size buffer and passes it to the
+ *  application output function whenever the buffer fills.
+ */
+class JsonOutput
+{
+public:
+    JsonOutput(const ConvertContext &aContext) : mContext(aContext), mLen(0) { }
+
+    WEAVE_ERROR Put(char aChar);
+    WEAVE_ERROR Put(const char *aStr, size_t aLen);
+    WEAVE_ERROR Put(const char *aStr) { return Put(aStr, strlen(aStr)); }
+    WEAVE_ERROR PutString(const uint8_t *aStr, size_t aLen);
+    WEAVE_ERROR Flush(void);
+
+    WEAVE_ERROR WriteElement(TLVReader &aReader, size_t aDepth);
+
+private:
+    const ConvertContext &mContext;
+    size_t mLen;
+    char mBuf[256];
+
+    WEAVE_ERROR WriteMemberName(uint64_t aTag);
+    WEAVE_ERROR WriteBytes(const uint8_t *aData, uint32_t aLen);
+    WEAVE_ERROR WriteContainer(TLVReader &aReader, size_t aDepth);
+};
+
+WEAVE_ERROR JsonOutput::Put(char aChar)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    if (mLen == sizeof(mBuf))
+    {
+        err = Flush();
+        SuccessOrExit(err);
+    }
+
+    mBuf[mLen++] = aChar;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR JsonOutput::Put(const char *aStr, size_t aLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    while (aLen > 0)
+    {
+        size_t copyLen = sizeof(mBuf) - mLen;
+
+        if (copyLen == 0)
+        {
+            err = Flush();
+            SuccessOrExit(err);
+            copyLen = sizeof(mBuf);
+        }
+
+        if (copyLen > aLen)
+            copyLen = aLen;
+
+        memcpy(mBuf + mLen, aStr, copyLen);
+        mLen += copyLen;
+        aStr += copyLen;
+        aLen -= copyLen;
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR JsonOutput::PutString(const uint8_t *aStr, size_t aLen)
+{
+    WEAVE_ERROR err;
+    const uint8_t *runStart = aStr;
+    const uint8_t *end = aStr + aLen;
+
+    err = Put('"');
+    SuccessOrExit(err);
+
+    // Copy runs of characters that need no escaping directly.
+    for (const uint8_t *p = aStr; p < end; p++)
+    {
+        char escape[7] = { '\\', 0, 0, 0, 0, 0, 0 };
+        size_t escapeLen = 2;
+
+        switch (*p)
+        {
+        case '"':   escape[1] = '"';  break;
+        case '\\':  escape[1] = '\\'; break;
+        case '\b':  escape[1] = 'b';  break;
+        case '\f':  escape[1] = 'f';  break;
+        case '\n':  escape[1] = 'n';  break;
+        case '\r':  escape[1] = 'r';  break;
+        case '\t':  escape[1] = 't';  break;
+        default:
+            if (*p >= 0x20)
+                continue;
+            escape[1] = 'u';
+            escape[2] = '0';
+            escape[3] = '0';
+            escape[4] = sHexDigits[*p >> 4];
+            escape[5] = sHexDigits[*p & 0xF];
+            escapeLen = 6;
+            break;
+        }
+
+        err = Put((const char *) runStart, p - runStart);
+        SuccessOrExit(err);
+
+        err = Put(escape, escapeLen);
+        SuccessOrExit(err);
+
+        runStart = p + 1;
+    }
+
+    err = Put((const char *) runStart, end - runStart);
+    SuccessOrExit(err);
+
+    err = Put('"');
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR JsonOutput::Flush(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    if (mLen > 0)
+    {
+        err = mContext.mOutput(mBuf, mLen, mContext.mContext);
+        mLen = 0;
+    }
+
+    return err;
+}
+
+WEAVE_ERROR JsonOutput::WriteMemberName(uint64_t aTag)
+{
+    WEAVE_ERROR err;
+    const char *name = NULL;
+    char canonicalName[24];
+
+    if (mContext.mTagName != NULL)
+        name = mContext.mTagName(aTag, mContext.mContext);
+
+    if (name == NULL)
+    {
+        if (aTag == AnonymousTag)
+            canonicalName[0] = 0;
+        else if (IsContextTag(aTag))
+            snprintf(canonicalName, sizeof(canonicalName), "%" PRIu32, TagNumFromTag(aTag));
+        else
+            snprintf(canonicalName, sizeof(canonicalName), "0x%08" PRIX32 ":%" PRIu32, ProfileIdFromTag(aTag), TagNumFromTag(aTag));
+        name = canonicalName;
+    }
+
+    err = PutString((const uint8_t *) name, strlen(name));
+    SuccessOrExit(err);
+
+    err = Put(':');
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR JsonOutput::WriteBytes(const uint8_t *aData, uint32_t aLen)
+{
+    WEAVE_ERROR err;
+    char encoded[BASE64_ENCODED_LEN(kBase64ChunkLen)];
+
+    err = Put('"');
+    SuccessOrExit(err);
+
+    while (aLen > 0)
+    {
+        uint16_t chunkLen = (aLen > kBase64ChunkLen) ? kBase64ChunkLen : aLen;
+        uint16_t encodedLen = Base64Encode(aData, chunkLen, encoded);
+
+        err = Put(encoded, encodedLen);
+        SuccessOrExit(err);
+
+        aData += chunkLen;
+        aLen -= chunkLen;
+    }
+
+    err = Put('"');
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR JsonOutput::WriteContainer(TLVReader &aReader, size_t aDepth)
+{
+    WEAVE_ERROR err;
+    TLVType outerContainerType;
+    const bool isArray = (aReader.GetType() == kTLVType_Array);
+    bool first = true;
+
+    VerifyOrExit(aDepth < kMaxNestingDepth, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = Put(isArray ? '[' : '{');
+    SuccessOrExit(err);
+
+    err = aReader.EnterContainer(outerContainerType);
+    SuccessOrExit(err);
+
+    while ((err = aReader.Next()) == WEAVE_NO_ERROR)
+    {
+        if (!first)
+        {
+            err = Put(',');
+            SuccessOrExit(err);
+        }
+        first = false;
+
+        if (!isArray)
+        {
+            err = WriteMemberName(aReader.GetTag());
+            SuccessOrExit(err);
+        }
+
+        err = WriteElement(aReader, aDepth + 1);
+        SuccessOrExit(err);
+    }
+    if (err != WEAVE_END_OF_TLV)
+        ExitNow();
+
+    err = aReader.ExitContainer(outerContainerType);
+    SuccessOrExit(err);
+
+    err = Put(isArray ? ']' : '}');
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR JsonOutput::WriteElement(TLVReader &aReader, size_t aDepth)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    char numBuf[32];
+    const uint8_t *data = NULL;
+    const uint32_t len = aReader.GetLength();
+
+    switch (aReader.GetType())
+    {
+    case kTLVType_SignedInteger:
+    {
+        int64_t v;
+        err = aReader.Get(v);
+        SuccessOrExit(err);
+        snprintf(numBuf, sizeof(numBuf), "%" PRId64, v);
+        err = Put(numBuf);
+        break;
+    }
+
+    case kTLVType_UnsignedInteger:
+    {
+        uint64_t v;
+        err = aReader.Get(v);
+        SuccessOrExit(err);
+        snprintf(numBuf, sizeof(numBuf), "%" PRIu64, v);
+        err = Put(numBuf);
+        break;
+    }
+
+    case kTLVType_FloatingPointNumber:
+    {
+        double v;
+        err = aReader.Get(v);
+        SuccessOrExit(err);
+
+        // JSON has no representation for infinities or NaN.
+        if (v != v || v - v != 0)
+        {
+            err = Put("null");
+            break;
+        }
+
+        // Print single-precision values with just enough digits to be read back exactly.
+        if ((aReader.GetControlByte() & kTLVTypeMask) == kTLVElementType_FloatingPointNumber32)
+            snprintf(numBuf, sizeof(numBuf), "%.9g", v);
+        else
+            snprintf(numBuf, sizeof(numBuf), "%.17g", v);
+        err = Put(numBuf);
+        break;
+    }
+
+    case kTLVType_Boolean:
+    {
+        bool v;
+        err = aReader.Get(v);
+        SuccessOrExit(err);
+        err = Put(v ? "true" : "false");
+        break;
+    }
+
+    case kTLVType_Null:
+        err = Put("null");
+        break;
+
+    case kTLVType_UTF8String:
+    case kTLVType_ByteString:
+        if (len > 0)
+        {
+            err = aReader.GetDataPtr(data);
+            SuccessOrExit(err);
+        }
+        if (aReader.GetType() == kTLVType_UTF8String)
+            err = PutString(data, len);
+        else
+            err = WriteBytes(data, len);
+        break;
+
+    case kTLVType_Structure:
+    case kTLVType_Array:
+    case kTLVType_Path:
+        err = WriteContainer(aReader, aDepth);
+        break;
+
+    default:
+        err = WEAVE_ERROR_INVALID_TLV_ELEMENT;
+        break;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ *  Parses JSON text in place and writes the equivalent TLV encoding.
+ */
+class JsonParser
+{
+public:
+    JsonParser(const char *aJson, size_t aJsonLen, TLVWriter &aWriter, const ConvertContext &aContext,
+               char *aScratchBuf, size_t aScratchBufLen) :
+        mCur(aJson), mEnd(aJson + aJsonLen), mWriter(aWriter), mContext(aContext),
+        mScratchBuf(aScratchBuf), mScratchBufLen(aScratchBufLen)
+    { }
+
+    bool SkipWhitespace(void);
+    WEAVE_ERROR ParseValue(uint64_t aTag, size_t aDepth);
+
+private:
+    const char *mCur;
+    const char *mEnd;
+    TLVWriter &mWriter;
+    const ConvertContext &mContext;
+    char *mScratchBuf;
+    size_t mScratchBufLen;
+
+    bool Expect(char aChar);
+    bool ExpectLiteral(const char *aLiteral);
+    WEAVE_ERROR ParseString(const char *& aStr, size_t& aLen);
+    WEAVE_ERROR ParseMemberTag(uint64_t &aTag);
+    WEAVE_ERROR ParseNumber(uint64_t aTag);
+    WEAVE_ERROR ParseContainer(uint64_t aTag, size_t aDepth);
+};
+
+// Skip whitespace, returning true if there is input remaining.
+bool JsonParser::SkipWhitespace(void)
+{
+    while (mCur < mEnd && (*mCur == ' ' || *mCur == '\t' || *mCur == '\n' || *mCur == '\r'))
+        mCur++;
+    return mCur < mEnd;
+}
+
+bool JsonParser::Expect(char aChar)
+{
+    if (!SkipWhitespace() || *mCur != aChar)
+        return false;
+    mCur++;
+    return true;
+}
+
+bool JsonParser::ExpectLiteral(const char *aLiteral)
+{
+    size_t len = strlen(aLiteral);
+
+    if ((size_t)(mEnd - mCur) < len || memcmp(mCur, aLiteral, len) != 0)
+        return false;
+    mCur += len;
+    return true;
+}
+
+static int HexDigitValue(char aChar)
+{
+    if (aChar >= '0' && aChar <= '9')
+        return aChar - '0';
+    if (aChar >= 'a' && aChar <= 'f')
+        return aChar - 'a' + 10;
+    if (aChar >= 'A' && aChar <= 'F')
+        return aChar - 'A' + 10;
+    return -1;
+}
+
+// Parse a JSON string at the current position.  On return, aStr refers either to the input, if the
+// string contains no escape sequences, or to the decoded string in the scratch buffer.
+WEAVE_ERROR JsonParser::ParseString(const char *& aStr, size_t& aLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const char *start;
+    size_t outLen = 0;
+
+    VerifyOrExit(Expect('"'), err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    start = mCur;
+    while (mCur < mEnd && *mCur != '"' && *mCur != '\\')
+        mCur++;
+    VerifyOrExit(mCur < mEnd, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    if (*mCur == '"')
+    {
+        aStr = start;
+        aLen = mCur - start;
+        mCur++;
+        ExitNow();
+    }
+
+    // The string contains escape sequences; decode it into the scratch buffer.
+    VerifyOrExit((size_t)(mCur - start) <= mScratchBufLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+    memcpy(mScratchBuf, start, mCur - start);
+    outLen = mCur - start;
+
+    while (true)
+    {
+        uint32_t codePoint;
+
+        VerifyOrExit(mCur < mEnd, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+        if (*mCur == '"')
+        {
+            mCur++;
+            break;
+        }
+
+        if (*mCur != '\\')
+        {
+            VerifyOrExit(outLen < mScratchBufLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+            mScratchBuf[outLen++] = *mCur++;
+            continue;
+        }
+
+        VerifyOrExit(mEnd - mCur >= 2, err = WEAVE_ERROR_INVALID_ARGUMENT);
+        mCur++;
+
+        switch (*mCur++)
+        {
+        case '"':   codePoint = '"';  break;
+        case '\\':  codePoint = '\\'; break;
+        case '/':   codePoint = '/';  break;
+        case 'b':   codePoint = '\b'; break;
+        case 'f':   codePoint = '\f'; break;
+        case 'n':   codePoint = '\n'; break;
+        case 'r':   codePoint = '\r'; break;
+        case 't':   codePoint = '\t'; break;
+        case 'u':
+            VerifyOrExit(mEnd - mCur >= 4, err = WEAVE_ERROR_INVALID_ARGUMENT);
+            codePoint = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                int digit = HexDigitValue(*mCur++);
+                VerifyOrExit(digit >= 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+                codePoint = (codePoint << 4) | digit;
+            }
+
+            // Combine a UTF-16 surrogate pair.
+            if (codePoint >= 0xD800 && codePoint < 0xDC00 && mEnd - mCur >= 6 && mCur[0] == '\\' && mCur[1] == 'u')
+            {
+                uint32_t low = 0;
+                for (int i = 2; i < 6; i++)
+                {
+                    int digit = HexDigitValue(mCur[i]);
+                    VerifyOrExit(digit >= 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+                    low = (low << 4) | digit;
+                }
+                if (low >= 0xDC00 && low < 0xE000)
+                {
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    mCur += 6;
+                }
+            }
+            break;
+        default:
+            ExitNow(err = WEAVE_ERROR_INVALID_ARGUMENT);
+        }
+
+        // Encode the code point as UTF-8.
+        VerifyOrExit(outLen + 4 <= mScratchBufLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+        if (codePoint < 0x80)
+        {
+            mScratchBuf[outLen++] = (char) codePoint;
+        }
+        else if (codePoint < 0x800)
+        {
+            mScratchBuf[outLen++] = (char) (0xC0 | (codePoint >> 6));
+            mScratchBuf[outLen++] = (char) (0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            mScratchBuf[outLen++] = (char) (0xE0 | (codePoint >> 12));
+            mScratchBuf[outLen++] = (char) (0x80 | ((codePoint >> 6) & 0x3F));
+            mScratchBuf[outLen++] = (char) (0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            mScratchBuf[outLen++] = (char) (0xF0 | (codePoint >> 18));
+            mScratchBuf[outLen++] = (char) (0x80 | ((codePoint >> 12) & 0x3F));
+            mScratchBuf[outLen++] = (char) (0x80 | ((codePoint >> 6) & 0x3F));
+            mScratchBuf[outLen++] = (char) (0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    aStr = mScratchBuf;
+    aLen = outLen;
+
+exit:
+    return err;
+}
+
+static bool ParseUnsigned(const char *aStr, const char *aEnd, uint32_t aMax, uint32_t &aVal, int aBase)
+{
+    uint64_t val = 0;
+
+    if (aStr == aEnd)
+        return false;
+
+    for (; aStr < aEnd; aStr++)
+    {
+        int digit = HexDigitValue(*aStr);
+        if (digit < 0 || digit >= aBase)
+            return false;
+        val = val * aBase + digit;
+        if (val > aMax)
+            return false;
+    }
+
+    aVal = (uint32_t) val;
+    return true;
+}
+
+WEAVE_ERROR JsonParser::ParseMemberTag(uint64_t &aTag)
+{
+    WEAVE_ERROR err;
+    const char *name;
+    size_t nameLen;
+    const char *sep;
+    uint32_t profileId;
+    uint32_t tagNum;
+
+    err = ParseString(name, nameLen);
+    SuccessOrExit(err);
+
+    VerifyOrExit(Expect(':'), err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    if (mContext.mTagLookup != NULL)
+    {
+        err = mContext.mTagLookup(name, nameLen, aTag, mContext.mContext);
+        if (err != WEAVE_ERROR_INVALID_TLV_TAG)
+            ExitNow();
+    }
+
+    err = WEAVE_NO_ERROR;
+
+    sep = (const char *) memchr(name, ':', nameLen);
+    if (sep == NULL)
+    {
+        VerifyOrExit(ParseUnsigned(name, name + nameLen, kContextTagMaxNum - 1, tagNum, 10),
+                     err = WEAVE_ERROR_INVALID_TLV_TAG);
+        aTag = ContextTag(tagNum);
+    }
+    else
+    {
+        VerifyOrExit(sep - name > 2 && name[0] == '0' && (name[1] == 'x' || name[1] == 'X') &&
+                     ParseUnsigned(name + 2, sep, UINT32_MAX, profileId, 16) &&
+                     ParseUnsigned(sep + 1, name + nameLen, UINT32_MAX, tagNum, 10),
+                     err = WEAVE_ERROR_INVALID_TLV_TAG);
+        aTag = ProfileTag(profileId, tagNum);
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR JsonParser::ParseNumber(uint64_t aTag)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const char *start = mCur;
+    const char *digits;
+    bool isNegative = false;
+    bool isFloat = false;
+    uint64_t val = 0;
+
+    if (*mCur == '-')
+    {
+        isNegative = true;
+        mCur++;
+    }
+
+    digits = mCur;
+    while (mCur < mEnd && *mCur >= '0' && *mCur <= '9')
+        mCur++;
+    VerifyOrExit(mCur > digits, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    while (mCur < mEnd && (*mCur == '.' || *mCur == 'e' || *mCur == 'E' || *mCur == '+' || *mCur == '-' ||
+                           (*mCur >= '0' && *mCur <= '9')))
+    {
+        isFloat = true;
+        mCur++;
+    }
+
+    if (isFloat)
+    {
+        // strtod() requires a NUL-terminated string.
+        char numBuf[64];
+        char *numEnd;
+        double v;
+
+        VerifyOrExit((size_t)(mCur - start) < sizeof(numBuf), err = WEAVE_ERROR_INVALID_ARGUMENT);
+        memcpy(numBuf, start, mCur - start);
+        numBuf[mCur - start] = 0;
+
+        v = strtod(numBuf, &numEnd);
+        VerifyOrExit(*numEnd == 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+        ExitNow(err = mWriter.Put(aTag, v));
+    }
+
+    for (const char *p = digits; p < mCur; p++)
+    {
+        VerifyOrExit(val <= (UINT64_MAX - (*p - '0')) / 10, err = WEAVE_ERROR_INVALID_ARGUMENT);
+        val = val * 10 + (*p - '0');
+    }
+
+    if (isNegative)
+    {
+        VerifyOrExit(val <= (uint64_t) INT64_MAX + 1, err = WEAVE_ERROR_INVALID_ARGUMENT);
+        err = mWriter.Put(aTag, (int64_t) (0 - val));
+    }
+    else
+    {
+        err = mWriter.Put(aTag, val);
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR JsonParser::ParseContainer(uint64_t aTag, size_t aDepth)
+{
+    WEAVE_ERROR err;
+    TLVType outerContainerType;
+    const bool isArray = (*mCur == '[');
+    const char close = isArray ? ']' : '}';
+
+    VerifyOrExit(aDepth < kMaxNestingDepth, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    mCur++;
+
+    err = mWriter.StartContainer(aTag, isArray ? kTLVType_Array : kTLVType_Structure, outerContainerType);
+    SuccessOrExit(err);
+
+    if (!Expect(close))
+    {
+        do
+        {
+            uint64_t memberTag = AnonymousTag;
+
+            if (!isArray)
+            {
+                err = ParseMemberTag(memberTag);
+                SuccessOrExit(err);
+            }
+
+            err = ParseValue(memberTag, aDepth + 1);
+            SuccessOrExit(err);
+        } while (Expect(','));
+
+        VerifyOrExit(Expect(close), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    }
+
+    err = mWriter.EndContainer(outerContainerType);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR JsonParser::ParseValue(uint64_t aTag, size_t aDepth)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(SkipWhitespace(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    switch (*mCur)
+    {
+    case '{':
+    case '[':
+        err = ParseContainer(aTag, aDepth);
+        break;
+
+    case '"':
+    {
+        const char *str;
+        size_t len;
+
+        err = ParseString(str, len);
+        SuccessOrExit(err);
+
+        VerifyOrExit(len <= UINT32_MAX, err = WEAVE_ERROR_INVALID_STRING_LENGTH);
+        err = mWriter.PutString(aTag, str, (uint32_t) len);
+        break;
+    }
+
+    case 't':
+        VerifyOrExit(ExpectLiteral("true"), err = WEAVE_ERROR_INVALID_ARGUMENT);
+        err = mWriter.PutBoolean(aTag, true);
+        break;
+
+    case 'f':
+        VerifyOrExit(ExpectLiteral("false"), err = WEAVE_ERROR_INVALID_ARGUMENT);
+        err = mWriter.PutBoolean(aTag, false);
+        break;
+
+    case 'n':
+        VerifyOrExit(ExpectLiteral("null"), err = WEAVE_ERROR_INVALID_ARGUMENT);
+        err = mWriter.PutNull(aTag);
+        break;
+
+    default:
+        err = ParseNumber(aTag);
+        break;
+    }
+
+exit:
+    return err;
+}
+
+} // namespace
+
+/**
+ *  Convert TLV elements to JSON.
+ *
+ *  Each element that follows the current position of @a aReader, within the
+ *  reader's current containment context, is converted to a JSON value followed
+ *  by a newline.  Output is passed in chunks to the output function in
+ *  @a aContext.
+ *
+ *  @param[in,out] aReader   A TLV reader.  On success the reader is positioned
+ *                           after the last element converted.
+ *  @param[in]     aContext  The conversion context.
+ *
+ *  @retval #WEAVE_NO_ERROR                   On success.
+ *  @retval #WEAVE_ERROR_INVALID_ARGUMENT     If containers are nested more than
+ *                                            #kMaxNestingDepth deep.
+ *  @retval #WEAVE_ERROR_TLV_UNDERRUN         If a string is split across input
+ *                                            buffers, or the encoding ended
+ *                                            prematurely.
+ *  @retval other                             Other errors returned by the
+ *                                            reader or the output function.
+ *
+ */
+WEAVE_ERROR TLVToJson(TLVReader &aReader, const ConvertContext &aContext)
+{
+    WEAVE_ERROR err;
+    JsonOutput output(aContext);
+
+    while ((err = aReader.Next()) == WEAVE_NO_ERROR)
+    {
+        err = output.WriteElement(aReader, 0);
+        SuccessOrExit(err);
+
+        err = output.Put('\n');
+        SuccessOrExit(err);
+    }
+    if (err != WEAVE_END_OF_TLV)
+        ExitNow();
+
+    err = output.Flush();
+
+exit:
+    return err;
+}
+
+/**
+ *  Convert a single TLV element to JSON.
+ *
+ *  The element on which @a aReader is positioned, and its contents, are
+ *  converted to a JSON value followed by a newline.  This allows elements
+ *  located deep within an encoding to be converted on their own.
+ *
+ *  @param[in]     aReader   A TLV reader positioned on an element.  The reader
+ *                           itself is not advanced.
+ *  @param[in]     aContext  The conversion context.
+ *
+ *  @retval #WEAVE_NO_ERROR                   On success.
+ *  @retval other                             As for TLVToJson().
+ *
+ */
+WEAVE_ERROR ElementToJson(const TLVReader &aReader, const ConvertContext &aContext)
+{
+    WEAVE_ERROR err;
+    JsonOutput output(aContext);
+    TLVReader reader;
+
+    reader.Init(aReader);
+
+    err = output.WriteElement(reader, 0);
+    SuccessOrExit(err);
+
+    err = output.Put('\n');
+    SuccessOrExit(err);
+
+    err = output.Flush();
+
+exit:
+    return err;
+}
+
+/**
+ *  Convert JSON values to TLV.
+ *
+ *  Each JSON value in @a aJson is encoded as an anonymous TLV element using
+ *  @a aWriter.  JSON objects are encoded as structures, and member names are
+ *  mapped to tags by the tag lookup function in @a aContext, or else must be in
+ *  canonical form.  Negative integers are encoded as signed integers, other
+ *  integers as unsigned integers and numbers with a fraction or exponent as
+ *  double-precision floating point numbers.  Strings are encoded as UTF-8
+ *  strings.
+ *
+ *  @param[in]  aJson           The JSON text.
+ *  @param[in]  aJsonLen        The length of the JSON text.
+ *  @param[in]  aWriter         The writer used to encode the TLV.
+ *  @param[in]  aContext        The conversion context.
+ *  @param[in]  aScratchBuf     A buffer in which to decode strings containing
+ *                              escape sequences.
+ *  @param[in]  aScratchBufLen  The length of @a aScratchBuf.
+ *
+ *  @retval #WEAVE_NO_ERROR                   On success.
+ *  @retval #WEAVE_ERROR_INVALID_ARGUMENT     If the JSON text is malformed, or
+ *                                            nested more than
+ *                                            #kMaxNestingDepth deep.
+ *  @retval #WEAVE_ERROR_INVALID_TLV_TAG      If a member name could not be
+ *                                            mapped to a tag.
+ *  @retval #WEAVE_ERROR_BUFFER_TOO_SMALL     If a decoded string does not fit in
+ *                                            the scratch buffer, or the TLV
+ *                                            encoding does not fit in the
+ *                                            writer's buffer.
+ *  @retval other                             Other errors returned by the
+ *                                            writer or the tag lookup
+ *                                            function.
+ *
+ */
+WEAVE_ERROR JsonToTLV(const char *aJson, size_t aJsonLen, TLVWriter &aWriter, const ConvertContext &aContext,
+                      char *aScratchBuf, size_t aScratchBufLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    JsonParser parser(aJson, aJsonLen, aWriter, aContext, aScratchBuf, aScratchBufLen);
+
+    while (parser.SkipWhitespace())
+    {
+        err = parser.ParseValue(AnonymousTag, 0);
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+} // namespace Json
+
+} // namespace TLV
+
+} // namespace Weave
+
+} // namespace nl
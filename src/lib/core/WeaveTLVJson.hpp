@@ -0,0 +1,115 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines interfaces for streaming conversion between
+ *      Weave TLV and JSON.
+ *
+ */
+
+#ifndef WEAVETLVJSON_HPP
+#define WEAVETLVJSON_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Weave/Core/WeaveError.h>
+#include <Weave/Core/WeaveTLV.h>
+
+namespace nl {
+
+namespace Weave {
+
+namespace TLV {
+
+/**
+ *   @namespace nl::Weave::TLV::Json
+ *
+ *   @brief
+ *     This namespace includes interfaces for streaming conversion between
+ *     Weave TLV and JSON.
+ *
+ *   TLV structures and paths map to JSON objects, arrays to JSON arrays,
+ *   UTF-8 strings to JSON strings, byte strings to base-64 encoded JSON
+ *   strings, and null, boolean and numeric values to their JSON
+ *   equivalents.  Each top-level TLV element maps to one JSON value on a line
+ *   of its own.
+ *
+ *   Member names are produced and interpreted by application-supplied
+ *   functions, falling back to a canonical form: "N" for context tag N, and
+ *   "0xPPPPPPPP:N" for tag N of profile PPPPPPPP.
+ *
+ *   Neither direction allocates memory.  Conversion to JSON uses a small
+ *   fixed-size output buffer; conversion from JSON reads the input in place,
+ *   except for strings containing escape sequences, which are decoded into a
+ *   caller-supplied scratch buffer.
+ */
+namespace Json {
+
+/**
+ *  Receives a chunk of JSON output.
+ *
+ *  @param[in]  aData       The JSON text; not NUL-terminated.
+ *  @param[in]  aDataLen    The length of the JSON text.
+ *  @param[in]  aContext    The application context.
+ *
+ *  @return #WEAVE_NO_ERROR on success, or an error that stops the conversion.
+ */
+typedef WEAVE_ERROR (*OutputFunct)(const char *aData, size_t aDataLen, void *aContext);
+
+/**
+ *  Returns the JSON member name for a TLV tag, or NULL to use the canonical form.
+ */
+typedef const char *(*TagNameFunct)(uint64_t aTag, void *aContext);
+
+/**
+ *  Looks up the TLV tag for a JSON member name.
+ *
+ *  @return #WEAVE_NO_ERROR if @a aTag was set, or #WEAVE_ERROR_INVALID_TLV_TAG
+ *  to interpret the name in canonical form.
+ */
+typedef WEAVE_ERROR (*TagLookupFunct)(const char *aName, size_t aNameLen, uint64_t &aTag, void *aContext);
+
+struct ConvertContext {
+    OutputFunct     mOutput;        ///< Receives output when converting to JSON.
+    TagNameFunct    mTagName;       ///< Optional; maps tags to member names.
+    TagLookupFunct  mTagLookup;     ///< Optional; maps member names to tags.
+    void *          mContext;       ///< Application context passed to the above.
+};
+
+enum
+{
+    kMaxNestingDepth = 32           ///< Maximum depth of nested containers supported.
+};
+
+extern WEAVE_ERROR TLVToJson(TLVReader &aReader, const ConvertContext &aContext);
+extern WEAVE_ERROR ElementToJson(const TLVReader &aReader, const ConvertContext &aContext);
+
+extern WEAVE_ERROR JsonToTLV(const char *aJson, size_t aJsonLen, TLVWriter &aWriter, const ConvertContext &aContext,
+                             char *aScratchBuf, size_t aScratchBufLen);
+
+} // namespace Json
+
+} // namespace TLV
+
+} // namespace Weave
+
+} // namespace nl
+
+#endif // WEAVETLVJSON_HPP
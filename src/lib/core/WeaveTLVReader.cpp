@@ -28,6 +28,7 @@
 #include <Weave/Core/WeaveEncoding.h>
 #include <Weave/Core/WeaveTLV.h>
 #include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/PerfInstrumentation.h>
 
 namespace nl {
 namespace Weave {
@@ -37,6 +38,33 @@ using namespace nl::Weave::Encoding;
 
 static const uint8_t sTagSizes[] = { 0, 1, 2, 4, 2, 4, 6, 8 };
 
+// Properties of each element type, used to skip over elements without fully decoding them.
+enum
+{
+    kElemInfo_FieldSizeMask     = 0x0F,     // Number of bytes in the length/value field
+    kElemInfo_HasLength         = 0x10,
+    kElemInfo_Container         = 0x20,
+    kElemInfo_EndOfContainer    = 0x40,
+    kElemInfo_Valid             = 0x80,
+};
+
+static const uint8_t sElemTypeInfo[] =
+{
+    kElemInfo_Valid | 1, kElemInfo_Valid | 2, kElemInfo_Valid | 4, kElemInfo_Valid | 8,         // Int8 .. Int64
+    kElemInfo_Valid | 1, kElemInfo_Valid | 2, kElemInfo_Valid | 4, kElemInfo_Valid | 8,         // UInt8 .. UInt64
+    kElemInfo_Valid, kElemInfo_Valid,                                                           // BooleanFalse, BooleanTrue
+    kElemInfo_Valid | 4, kElemInfo_Valid | 8,                                                   // FloatingPointNumber32, 64
+    kElemInfo_Valid | kElemInfo_HasLength | 1, kElemInfo_Valid | kElemInfo_HasLength | 2,       // UTF8String
+    kElemInfo_Valid | kElemInfo_HasLength | 4, kElemInfo_Valid | kElemInfo_HasLength | 8,
+    kElemInfo_Valid | kElemInfo_HasLength | 1, kElemInfo_Valid | kElemInfo_HasLength | 2,       // ByteString
+    kElemInfo_Valid | kElemInfo_HasLength | 4, kElemInfo_Valid | kElemInfo_HasLength | 8,
+    kElemInfo_Valid,                                                                            // Null
+    kElemInfo_Valid | kElemInfo_Container, kElemInfo_Valid | kElemInfo_Container,               // Structure, Array
+    kElemInfo_Valid | kElemInfo_Container,                                                      // Path
+    kElemInfo_Valid | kElemInfo_EndOfContainer,                                                 // EndOfContainer
+    0, 0, 0, 0, 0, 0, 0                                                                         // Invalid
+};
+
 /**
  * @fn uint32_t TLVReader::GetLengthRead() const
  *
@@ -758,6 +786,165 @@ WEAVE_ERROR TLVReader::DupString(char *& buf)
 #endif // HAVE_MALLOC && HAVE_FREE
 }
 
+/**
+ * Returns a copy of the value of the current byte or UTF8 string, allocated from an arena.
+ *
+ * This method behaves like DupBytes(uint8_t *&, uint32_t&), except that the memory for the copy is
+ * taken from @p arena rather than the heap.  The copy remains valid until the arena is rewound or
+ * reset.
+ *
+ * @note The data returned by this method is NOT null-terminated.
+ *
+ * @param[in]  arena                    The arena from which to allocate the copy.
+ * @param[out] buf                      A reference to a pointer to which a buffer of @p dataLen bytes
+ *                                      will be assigned on success.
+ * @param[out] dataLen                  A reference to storage for the size, in bytes, of @p buf on
+ *                                      success.
+ *
+ * @retval #WEAVE_NO_ERROR              If the method succeeded.
+ * @retval #WEAVE_ERROR_WRONG_TLV_TYPE  If the current element is not a TLV byte or UTF8 string, or
+ *                                      the reader is not positioned on an element.
+ * @retval #WEAVE_ERROR_NO_MEMORY       If the arena has insufficient space for the copy.
+ * @retval #WEAVE_ERROR_TLV_UNDERRUN    If the underlying TLV encoding ended prematurely.
+ * @retval other                        Other Weave or platform error codes returned by the configured
+ *                                      GetNextBuffer() function. Only possible when GetNextBuffer
+ *                                      is non-NULL.
+ *
+ */
+WEAVE_ERROR TLVReader::DupBytes(TLVArena& arena, uint8_t *& buf, uint32_t& dataLen)
+{
+    if (!TLVTypeIsString(ElementType()))
+        return WEAVE_ERROR_WRONG_TLV_TYPE;
+
+    uint32_t arenaMark = arena.GetUsedLength();
+
+    buf = (uint8_t *) arena.Alloc((uint32_t) mElemLenOrVal);
+    if (buf == NULL)
+        return WEAVE_ERROR_NO_MEMORY;
+
+    WEAVE_ERROR err = ReadData(buf, (uint32_t) mElemLenOrVal);
+    if (err != WEAVE_NO_ERROR)
+    {
+        arena.Rewind(arenaMark);
+        return err;
+    }
+
+    dataLen = mElemLenOrVal;
+    mElemLenOrVal = 0;
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ * Returns a null-terminated copy of the value of the current byte or UTF8 string, allocated from
+ * an arena.
+ *
+ * This method behaves like DupString(char *&), except that the memory for the copy is taken from
+ * @p arena rather than the heap.  The copy remains valid until the arena is rewound or reset.
+ *
+ * @param[in]  arena                    The arena from which to allocate the copy.
+ * @param[out] buf                      A reference to a pointer to which a null-terminated copy of
+ *                                      the string will be assigned on success.
+ *
+ * @retval #WEAVE_NO_ERROR              If the method succeeded.
+ * @retval #WEAVE_ERROR_WRONG_TLV_TYPE  If the current element is not a TLV byte or UTF8 string, or
+ *                                      the reader is not positioned on an element.
+ * @retval #WEAVE_ERROR_NO_MEMORY       If the arena has insufficient space for the copy.
+ * @retval #WEAVE_ERROR_TLV_UNDERRUN    If the underlying TLV encoding ended prematurely.
+ * @retval other                        Other Weave or platform error codes returned by the configured
+ *                                      GetNextBuffer() function. Only possible when GetNextBuffer
+ *                                      is non-NULL.
+ *
+ */
+WEAVE_ERROR TLVReader::DupString(TLVArena& arena, char *& buf)
+{
+    if (!TLVTypeIsString(ElementType()))
+        return WEAVE_ERROR_WRONG_TLV_TYPE;
+
+    // Check the space for the value and its terminator here, so that the length cannot overflow.
+    if (mElemLenOrVal >= arena.GetRemainingLength())
+        return WEAVE_ERROR_NO_MEMORY;
+
+    uint32_t arenaMark = arena.GetUsedLength();
+
+    buf = (char *) arena.Alloc((uint32_t) mElemLenOrVal + 1);
+    if (buf == NULL)
+        return WEAVE_ERROR_NO_MEMORY;
+
+    WEAVE_ERROR err = ReadData((uint8_t *) buf, (uint32_t) mElemLenOrVal);
+    if (err != WEAVE_NO_ERROR)
+    {
+        arena.Rewind(arenaMark);
+        return err;
+    }
+
+    buf[mElemLenOrVal] = 0;
+    mElemLenOrVal = 0;
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ * Returns a read-only view of the value of the current byte or UTF8 string, copying it only when
+ * necessary.
+ *
+ * If the entirety of the string value is present in the current input buffer, this method returns
+ * a pointer directly into that buffer, as GetDataPtr() does, and nothing is allocated.  Otherwise
+ * the value is copied into memory allocated from @p arena.  In either case the reader's position is
+ * unchanged.
+ *
+ * A view into the input buffer remains valid only as long as the input buffer itself, so this
+ * method is appropriate only where the input buffer outlives the use of the value.
+ *
+ * @note The data returned by this method is NOT null-terminated.
+ *
+ * @param[in]  arena                    The arena from which to allocate a copy, if one is required.
+ * @param[out] data                     A reference to a const pointer that will receive a pointer to
+ *                                      the string data.
+ * @param[out] dataLen                  A reference to storage for the length, in bytes, of the string
+ *                                      data.
+ *
+ * @retval #WEAVE_NO_ERROR              If the method succeeded.
+ * @retval #WEAVE_ERROR_WRONG_TLV_TYPE  If the current element is not a TLV byte or UTF8 string, or
+ *                                      the reader is not positioned on an element.
+ * @retval #WEAVE_ERROR_NO_MEMORY       If a copy was required and the arena has insufficient space
+ *                                      for it.
+ * @retval #WEAVE_ERROR_TLV_UNDERRUN    If the underlying TLV encoding ended prematurely.
+ * @retval other                        Other Weave or platform error codes returned by the configured
+ *                                      GetNextBuffer() function. Only possible when GetNextBuffer
+ *                                      is non-NULL.
+ *
+ */
+WEAVE_ERROR TLVReader::GetDataView(TLVArena& arena, const uint8_t *& data, uint32_t& dataLen)
+{
+    WEAVE_ERROR err;
+    TLVReader copyReader;
+    uint8_t *copy;
+
+    if (!TLVTypeIsString(ElementType()))
+        return WEAVE_ERROR_WRONG_TLV_TYPE;
+
+    dataLen = (uint32_t) mElemLenOrVal;
+
+    // Return a pointer into the input buffer if the value lies entirely within it.
+    if (dataLen <= (uint32_t)(mBufEnd - mReadPoint))
+    {
+        data = mReadPoint;
+        return WEAVE_NO_ERROR;
+    }
+
+    // Otherwise copy the value using a copy of the reader, leaving this reader's position unchanged.
+    copyReader.Init(*this);
+
+    err = copyReader.DupBytes(arena, copy, dataLen);
+    if (err != WEAVE_NO_ERROR)
+        return err;
+
+    data = copy;
+
+    return WEAVE_NO_ERROR;
+}
+
 /**
  * Get a pointer to the initial encoded byte of a TLV byte or UTF8 string element.
  *
@@ -1093,6 +1280,7 @@ TLVType TLVReader::GetContainerType() const
  */
 WEAVE_ERROR TLVReader::Next()
 {
+    WEAVE_PERF_SCOPE(kSection_TLVDecode);
     WEAVE_ERROR err;
     TLVElementType elemType = ElementType();
 
@@ -1275,12 +1463,107 @@ WEAVE_ERROR TLVReader::SkipToEndOfContainer()
         if (err != WEAVE_NO_ERROR)
             return err;
 
+        SkipElementsInBuffer(nestLevel);
+
         err = ReadElement();
         if (err != WEAVE_NO_ERROR)
             return err;
     }
 }
 
+/**
+ * This is a private method used to quickly skip over the elements of the container being skipped
+ * that lie entirely within the current input buffer.
+ *
+ * Each element is sized from its control byte and, for strings, its length field, without being
+ * decoded.  Skipping stops before the end of the container being skipped, and before any element
+ * that would be rejected by VerifyElement() or that extends beyond the current buffer, all of which
+ * are left to be read by ReadElement() as usual.
+ *
+ * On return, mReadPoint points at the head of the next element, and @p nestLevel and mContainerType
+ * are as they would have been had each of the skipped elements been read by SkipToEndOfContainer().
+ */
+void TLVReader::SkipElementsInBuffer(uint32_t& nestLevel)
+{
+    const uint8_t *p = mReadPoint;
+    TLVType containerType = mContainerType;
+
+    if (nestLevel == 0)
+        return;
+
+    while (p < mBufEnd)
+    {
+        const uint8_t controlByte = *p;
+        const uint8_t tagControl = controlByte & kTLVTagControlMask;
+        const uint8_t elemInfo = sElemTypeInfo[controlByte & kTLVTypeMask];
+        const uint8_t fieldBytes = elemInfo & kElemInfo_FieldSizeMask;
+        const uint8_t headBytes = 1 + sTagSizes[tagControl >> kTLVTagControlShift] + fieldBytes;
+        const uint32_t remainingLen = mBufEnd - p;
+
+        if ((elemInfo & kElemInfo_Valid) == 0 || headBytes > remainingLen)
+            break;
+
+        if ((elemInfo & kElemInfo_EndOfContainer) != 0)
+        {
+            if (nestLevel == 1 || tagControl != kTLVTagControl_Anonymous)
+                break;
+
+            nestLevel--;
+            containerType = kTLVType_UnknownContainer;
+            p += headBytes;
+            continue;
+        }
+
+        // Mirror the tag checks made by VerifyElement().
+        if ((containerType == kTLVType_Structure && tagControl == kTLVTagControl_Anonymous) ||
+            (containerType == kTLVType_Array && tagControl != kTLVTagControl_Anonymous) ||
+            (ImplicitProfileId == kProfileIdNotSpecified &&
+             (tagControl == kTLVTagControl_ImplicitProfile_2Bytes || tagControl == kTLVTagControl_ImplicitProfile_4Bytes)))
+            break;
+
+        if ((elemInfo & kElemInfo_Container) != 0)
+        {
+            nestLevel++;
+            containerType = (TLVType)(controlByte & kTLVTypeMask);
+            p += headBytes;
+        }
+
+        else if ((elemInfo & kElemInfo_HasLength) != 0)
+        {
+            const uint8_t *lenField = p + headBytes - fieldBytes;
+            uint64_t dataLen;
+
+            switch (fieldBytes)
+            {
+            case 1:
+                dataLen = Read8(lenField);
+                break;
+            case 2:
+                dataLen = LittleEndian::Read16(lenField);
+                break;
+            case 4:
+                dataLen = LittleEndian::Read32(lenField);
+                break;
+            default:
+                dataLen = LittleEndian::Read64(lenField);
+                break;
+            }
+
+            if (dataLen > remainingLen - headBytes)
+                break;
+
+            p += headBytes + (uint32_t)dataLen;
+        }
+
+        else
+            p += headBytes;
+    }
+
+    mLenRead += p - mReadPoint;
+    mReadPoint = p;
+    mContainerType = containerType;
+}
+
 WEAVE_ERROR TLVReader::ReadElement()
 {
     WEAVE_ERROR err;
@@ -1450,7 +1733,10 @@ uint64_t TLVReader::ReadTag(TLVTagControl tagControl, const uint8_t *& p)
     }
 }
 
-WEAVE_ERROR TLVReader::ReadData(uint8_t *buf, uint32_t len)
+/**
+ * This is a private method used to read data that spans input buffers.  See ReadData().
+ */
+WEAVE_ERROR TLVReader::ReadDataAcrossBuffers(uint8_t *buf, uint32_t len)
 {
     WEAVE_ERROR err;
 
@@ -1479,33 +1765,34 @@ WEAVE_ERROR TLVReader::ReadData(uint8_t *buf, uint32_t len)
     return WEAVE_NO_ERROR;
 }
 
-WEAVE_ERROR TLVReader::EnsureData(WEAVE_ERROR noDataErr)
+/**
+ * This is a private method used to fetch the next input buffer once the current one has been
+ * exhausted.  See EnsureData().
+ */
+WEAVE_ERROR TLVReader::ReadNextBuffer(WEAVE_ERROR noDataErr)
 {
     WEAVE_ERROR err;
 
-    if (mReadPoint == mBufEnd)
-    {
-        if (mLenRead == mMaxLen)
-            return noDataErr;
+    if (mLenRead == mMaxLen)
+        return noDataErr;
 
-        if (GetNextBuffer == NULL)
-            return noDataErr;
+    if (GetNextBuffer == NULL)
+        return noDataErr;
 
-        uint32_t bufLen;
-        err = GetNextBuffer(*this, mBufHandle, mReadPoint, bufLen);
-        if (err != WEAVE_NO_ERROR)
-            return err;
-        if (bufLen == 0)
-            return noDataErr;
+    uint32_t bufLen;
+    err = GetNextBuffer(*this, mBufHandle, mReadPoint, bufLen);
+    if (err != WEAVE_NO_ERROR)
+        return err;
+    if (bufLen == 0)
+        return noDataErr;
 
-        // Cap mBufEnd so that we don't read beyond the user's specified maximum length, even
-        // if the underlying buffer is larger.
-        uint32_t overallLenRemaining = mMaxLen - mLenRead;
-        if (overallLenRemaining < bufLen)
-            bufLen = overallLenRemaining;
+    // Cap mBufEnd so that we don't read beyond the user's specified maximum length, even
+    // if the underlying buffer is larger.
+    uint32_t overallLenRemaining = mMaxLen - mLenRead;
+    if (overallLenRemaining < bufLen)
+        bufLen = overallLenRemaining;
 
-        mBufEnd = mReadPoint + bufLen;
-    }
+    mBufEnd = mReadPoint + bufLen;
 
     return WEAVE_NO_ERROR;
 }
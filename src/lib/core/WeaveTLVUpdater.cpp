@@ -73,6 +73,66 @@ WEAVE_ERROR TLVUpdater::Init(uint8_t *buf, uint32_t dataLen, uint32_t maxLen)
     mUpdaterWriter.Init(buf, freeLen);
     mUpdaterWriter.SetCloseContainerReserved(false);
     mElementStartAddr = buf + freeLen;
+    mDeferredFreeLen = 0;
+
+exit:
+    return err;
+}
+
+/**
+ * Initialize a TLVUpdater object to edit a single input buffer in place.
+ *
+ * Unlike Init(uint8_t *, uint32_t, uint32_t), this method leaves the TLV data
+ * where it is. The free space at the end of the buffer is only moved to the
+ * updater's current position the first time the application writes more data
+ * than has been freed by skipping elements. Until then, calls to Move() and
+ * MoveUntilEnd() do not copy any data.
+ *
+ * This makes small edits to large encodings cheap:
+ *
+ *   - Replacing an element with one of the same encoded size (e.g. skipping a
+ *     scalar with Next() and writing its new value with one of the Put()
+ *     methods that accept a @p preserveSize argument) touches only the bytes
+ *     of that element.
+ *
+ *   - A run of insertions at the same position moves the remainder of the
+ *     encoding once, rather than once per edit. Subsequent calls to Move()
+ *     then carry the free space forward element by element, as a gap buffer.
+ *
+ * Applications use the resulting TLVUpdater object exactly as one initialized
+ * with Init(uint8_t *, uint32_t, uint32_t).
+ *
+ * @param[in]   buf     A pointer to a buffer containing the TLV data to be edited.
+ * @param[in]   dataLen The length of the TLV data in the buffer.
+ * @param[in]   maxLen  The total length of the buffer.
+ *
+ * @retval #WEAVE_NO_ERROR                  If the method succeeded.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT    If the buffer address is invalid.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL    If the buffer is too small.
+ *
+ */
+WEAVE_ERROR TLVUpdater::InitInPlace(uint8_t *buf, uint32_t dataLen, uint32_t maxLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(buf != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    VerifyOrExit(maxLen >= dataLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    // Init reader
+    mUpdaterReader.Init(buf, dataLen);
+
+    // Init writer with no free space of its own. The free space at the end of
+    // the buffer is counted against the writer's maximum length, and is moved
+    // to the write point by OpenDeferredGap() when the writer first runs out of
+    // space.
+    mUpdaterWriter.Init(buf, maxLen - dataLen);
+    mUpdaterWriter.mRemainingLen = 0;
+    mUpdaterWriter.SetCloseContainerReserved(false);
+    mUpdaterWriter.GetNewBuffer = OpenDeferredGap;
+    mUpdaterWriter.AppData = this;
+    mElementStartAddr = buf;
+    mDeferredFreeLen = maxLen - dataLen;
 
 exit:
     return err;
@@ -170,6 +230,7 @@ WEAVE_ERROR TLVUpdater::Init(TLVReader& aReader, uint32_t freeLen)
 
     // Cache element start address for internal use
     mElementStartAddr = buf + freeLen;
+    mDeferredFreeLen = 0;
 
     // Clear the input reader object before returning. The user can no longer
     // use the original TLVReader object anymore.
@@ -304,8 +365,9 @@ WEAVE_ERROR TLVUpdater::Move()
 
     copyLen = elementEnd - mElementStartAddr;
 
-    // Move the element to output TLV
-    memmove(mUpdaterWriter.mWritePoint, mElementStartAddr, copyLen);
+    // Move the element to output TLV, unless there is no free space before it
+    if (mUpdaterWriter.mWritePoint != mElementStartAddr)
+        memmove(mUpdaterWriter.mWritePoint, mElementStartAddr, copyLen);
 
     // Adjust the updater state
     mElementStartAddr += copyLen;
@@ -340,8 +402,10 @@ void TLVUpdater::MoveUntilEnd()
 
     uint32_t copyLen = buffEnd - mElementStartAddr;
 
-    // Move all elements till end to output TLV
-    memmove(mUpdaterWriter.mWritePoint, mElementStartAddr, copyLen);
+    // Move all elements till end to output TLV, unless there is no free space
+    // before them
+    if (mUpdaterWriter.mWritePoint != mElementStartAddr)
+        memmove(mUpdaterWriter.mWritePoint, mElementStartAddr, copyLen);
 
     // Adjust the updater state
     mElementStartAddr += copyLen;
@@ -500,6 +564,40 @@ void TLVUpdater::AdjustInternalWriterFreeSpace()
     }
 }
 
+/**
+ * This is a private TLVWriter GetNewBuffer function used by updaters
+ * initialized with InitInPlace(). It is called when the internal writer has
+ * used all of the free space before the current element, and moves the unread
+ * remainder of the input TLV to the end of the buffer so that the deferred free
+ * space at the end of the buffer becomes available at the write point.
+ */
+WEAVE_ERROR TLVUpdater::OpenDeferredGap(TLVWriter& writer, uintptr_t& bufHandle, uint8_t *& bufStart, uint32_t& bufLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TLVUpdater *updater = static_cast<TLVUpdater *>(writer.AppData);
+    uint8_t *elementStart = const_cast<uint8_t *>(updater->mElementStartAddr);
+    uint32_t gapLen = updater->mDeferredFreeLen;
+
+    VerifyOrExit(gapLen != 0, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    // Move the unread input TLV to the end of the buffer
+    memmove(elementStart + gapLen, elementStart, updater->mUpdaterReader.mBufEnd - elementStart);
+
+    // Adjust the updater state
+    updater->mElementStartAddr += gapLen;
+    updater->mUpdaterReader.mReadPoint += gapLen;
+    updater->mUpdaterReader.mBufEnd += gapLen;
+    updater->mDeferredFreeLen = 0;
+
+    // The free space now lies between the write point and the next element
+    writer.GetNewBuffer = NULL;
+    bufStart = writer.mWritePoint;
+    bufLen = gapLen;
+
+exit:
+    return err;
+}
+
 } // namespace TLV
 } // namespace Weave
 } // namespace nl
@@ -32,6 +32,7 @@
 #include <Weave/Core/WeaveEncoding.h>
 #include <Weave/Core/WeaveTLV.h>
 #include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/PerfInstrumentation.h>
 #include <stdlib.h>
 
 namespace nl {
@@ -687,6 +688,65 @@ WEAVE_ERROR TLVWriter::PutBytes(uint64_t tag, const uint8_t *buf, uint32_t len)
     return WriteElementWithData(kTLVType_ByteString, tag, (const uint8_t *) buf, len);
 }
 
+/**
+ * Encodes a TLV byte string value contained in a chain of PacketBuffers.
+ *
+ * When the writer is writing to a chain of PacketBuffers (see Init(PacketBuffer *, uint32_t, bool)),
+ * and the value does not fit within the space remaining in the current output buffer, the supplied
+ * buffers are linked into the output chain by reference rather than copied.  Otherwise the value is
+ * copied into the output and the supplied buffers are freed.
+ *
+ * In all cases the writer takes ownership of the supplied buffer chain, including when an error
+ * occurs.  The buffers must not be part of any other chain, and the caller must not write to them
+ * after the call.  A caller wishing to retain access to the data after the call can do so by taking
+ * an additional reference on the buffers with PacketBuffer::AddRef().
+ *
+ * @param[in]   tag             The TLV tag to be encoded with the value, or @p AnonymousTag if the
+ *                              value should be encoded without a tag.  Tag values should be
+ *                              constructed with one of the tag definition functions ProfileTag(),
+ *                              ContextTag() or CommonTag().
+ * @param[in]   data            A chain of PacketBuffers containing the bytes string to be encoded.
+ *
+ * @retval #WEAVE_NO_ERROR      If the method succeeded.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT
+ *                              If @p data is NULL.
+ * @retval #WEAVE_ERROR_TLV_CONTAINER_OPEN
+ *                              If a container writer has been opened on the current writer and not
+ *                              yet closed.
+ * @retval #WEAVE_ERROR_INVALID_TLV_TAG
+ *                              If the specified tag value is invalid or inappropriate in the context
+ *                              in which the value is being written.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL
+ *                              If writing the value would exceed the limit on the maximum number of
+ *                              bytes specified when the writer was initialized.
+ * @retval #WEAVE_ERROR_NO_MEMORY
+ *                              If an attempt to allocate an output buffer failed due to lack of
+ *                              memory.
+ * @retval other                Other Weave or platform-specific errors returned by the configured
+ *                              GetNewBuffer() or FinalizeBuffer() functions.
+ *
+ */
+WEAVE_ERROR TLVWriter::PutBytes(uint64_t tag, PacketBuffer *data)
+{
+    WEAVE_ERROR err;
+    uint32_t dataLen;
+
+    VerifyOrExit(data != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    dataLen = data->TotalLength();
+
+    err = StartPutBytes(tag, dataLen);
+    SuccessOrExit(err);
+
+    err = WriteData(data, dataLen);
+    data = NULL;
+
+exit:
+    if (data != NULL)
+        PacketBuffer::Free(data);
+    return err;
+}
+
 /**
  * Encodes a TLV byte string in multiple chunks. This should be used with ContinuePutBytes.
  *
@@ -1556,6 +1616,64 @@ WEAVE_ERROR TLVWriter::PutPreEncodedContainer(uint64_t tag, TLVType containerTyp
     return WriteData(data, dataLen);
 }
 
+/**
+ * Encodes a TLV container element from a pre-encoded set of member elements contained in a chain
+ * of PacketBuffers.
+ *
+ * This method behaves like PutPreEncodedContainer(uint64_t, TLVType, const uint8_t *, uint32_t),
+ * except that, when the writer is writing to a chain of PacketBuffers, the supplied buffers are
+ * linked into the output chain by reference rather than copied.  See PutBytes(uint64_t, PacketBuffer *)
+ * for details of when the data is linked rather than copied, and for the ownership rules that apply
+ * to the supplied buffers.
+ *
+ * @param[in]   tag             The TLV tag to be encoded with the container, or @p AnonymousTag if
+ *                              the container should be encoded without a tag.  Tag values should be
+ *                              constructed with one of the tag definition functions ProfileTag(),
+ *                              ContextTag() or CommonTag().
+ * @param[in]   containerType   The type of container to encode.  Must be one of @p kTLVType_Structure,
+ *                              @p kTLVType_Array or @p kTLVType_Path.
+ * @param[in]   data            A chain of PacketBuffers containing zero of more encoded TLV elements
+ *                              that will become the members of the new container.
+ *
+ * @retval #WEAVE_NO_ERROR      If the method succeeded.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT
+ *                              If @p data is NULL, or the value specified for containerType is
+ *                              incorrect.
+ * @retval #WEAVE_ERROR_TLV_CONTAINER_OPEN
+ *                              If a container writer has been opened on the current writer and not
+ *                              yet closed.
+ * @retval #WEAVE_ERROR_INVALID_TLV_TAG
+ *                              If the specified tag value is invalid or inappropriate in the context
+ *                              in which the value is being written.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL
+ *                              If writing the value would exceed the limit on the maximum number of
+ *                              bytes specified when the writer was initialized.
+ * @retval #WEAVE_ERROR_NO_MEMORY
+ *                              If an attempt to allocate an output buffer failed due to lack of
+ *                              memory.
+ * @retval other                Other Weave or platform-specific errors returned by the configured
+ *                              GetNewBuffer() or FinalizeBuffer() functions.
+ *
+ */
+WEAVE_ERROR TLVWriter::PutPreEncodedContainer(uint64_t tag, TLVType containerType, PacketBuffer *data)
+{
+    WEAVE_ERROR err;
+
+    VerifyOrExit(data != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(TLVTypeIsContainer(containerType), err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = WriteElementHead((TLVElementType)containerType, tag, 0);
+    SuccessOrExit(err);
+
+    err = WriteData(data, data->TotalLength());
+    data = NULL;
+
+exit:
+    if (data != NULL)
+        PacketBuffer::Free(data);
+    return err;
+}
+
 /**
  * Copies a TLV container element from TLVReader object
  *
@@ -1753,6 +1871,7 @@ TLVType TLVWriter::GetContainerType() const
 
 WEAVE_ERROR TLVWriter::WriteElementHead(TLVElementType elemType, uint64_t tag, uint64_t lenOrVal)
 {
+    WEAVE_PERF_SCOPE(kSection_TLVEncode);
     uint8_t *p;
     uint8_t stagingBuf[17]; // 17 = 1 control byte + 8 tag bytes + 8 length/value bytes
 
@@ -1932,6 +2051,56 @@ exit:
     return err;
 }
 
+// Write the contents of a chain of PacketBuffers to the output, taking ownership of the chain.
+//
+// When writing to a chain of PacketBuffers, data that does not fit in the current output buffer is
+// linked into the output chain following the current buffer, and writing resumes in a new buffer
+// following the linked data.  In all other cases the data is copied and the chain is freed.
+WEAVE_ERROR TLVWriter::WriteData(PacketBuffer *data, uint32_t dataLen)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *curBuf;
+    PacketBuffer *spareBufs;
+    PacketBuffer *lastBuf;
+
+    VerifyOrExit((mLenWritten + dataLen) <= mMaxLen, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    if (dataLen <= mRemainingLen || GetNewBuffer != GetNewPacketBuffer || FinalizeBuffer != FinalizePacketBuffer)
+    {
+        for (PacketBuffer *buf = data; buf != NULL && err == WEAVE_NO_ERROR; buf = buf->Next())
+            err = WriteData(buf->Start(), buf->DataLength());
+        ExitNow();
+    }
+
+    // Close out the current output buffer and set aside any unused buffers that follow it.
+    err = FinalizeBuffer(*this, mBufHandle, mBufStart, mWritePoint - mBufStart);
+    SuccessOrExit(err);
+
+    curBuf = (PacketBuffer *) mBufHandle;
+    spareBufs = (curBuf->Next() != NULL) ? curBuf->DetachTail() : NULL;
+
+    // Link the data into the output chain.
+    for (lastBuf = data; lastBuf->Next() != NULL; lastBuf = lastBuf->Next())
+        ;
+    curBuf->AddToEnd(data);
+    if (spareBufs != NULL)
+        lastBuf->AddToEnd(spareBufs);
+    data = NULL;
+
+    // Make the last buffer of the linked data the current output buffer, with no space remaining,
+    // so that further writes proceed in a new buffer.  The linked buffers may be shared with the
+    // caller and must never be written to.
+    mBufHandle = (uintptr_t) lastBuf;
+    mBufStart = mWritePoint = lastBuf->Start() + lastBuf->DataLength();
+    mRemainingLen = 0;
+    mLenWritten += dataLen;
+
+exit:
+    if (data != NULL)
+        PacketBuffer::Free(data);
+    return err;
+}
+
 /**
  * An implementation of a TLVWriter GetNewBuffer function for writing to a chain of PacketBuffers.
  *
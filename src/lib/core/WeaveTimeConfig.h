@@ -119,6 +119,23 @@
 #define WEAVE_CONFIG_TIME_SERVER_TIMER_UNRELIABLE_AFTER_BOOT_MSEC (30 * 1000)
 #endif // WEAVE_CONFIG_TIME_SERVER_TIMER_UNRELIABLE_AFTER_BOOT_MSEC
 
+/**
+ *  @def WEAVE_CONFIG_TIME_SERVER_RESPONSE_CACHE_MSEC
+ *
+ *  @brief
+ *    This only applies to Time Sync Server/Coordinator roles. Number of
+ *    msec for which the sync status fields of a response (time since the
+ *    last sync with a server and the number of contributors) are reused
+ *    for subsequent requests, so that a burst of requests from many clients
+ *    is served without recomputing them. The time of response is always
+ *    read afresh. Set to 0 to compute the fields for every request.
+ *    Default is 1 second.
+ *
+ */
+#ifndef WEAVE_CONFIG_TIME_SERVER_RESPONSE_CACHE_MSEC
+#define WEAVE_CONFIG_TIME_SERVER_RESPONSE_CACHE_MSEC (1 * 1000)
+#endif // WEAVE_CONFIG_TIME_SERVER_RESPONSE_CACHE_MSEC
+
 /**
  *  @def WEAVE_CONFIG_TIME_CLIENT_SYNC_PERIOD_MSEC
  *
@@ -234,6 +251,36 @@
 #define WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS 4
 #endif // WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS
 
+/**
+ *  @def WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+ *
+ *  @brief
+ *    This only applies to Time Sync Client/Coordinator roles. When
+ *    enabled, each round of a local sync sends unicast requests to all
+ *    known contacts at once, each on its own exchange context, instead of
+ *    contacting them one after another. A round then takes about one
+ *    response timeout regardless of the number of contacts, at the cost
+ *    of up to WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS exchange contexts.
+ *
+ */
+#ifndef WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+#define WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC 1
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+
+/**
+ *  @def WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC_MIN_RESPONSES
+ *
+ *  @brief
+ *    This only applies when WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC is
+ *    enabled. Number of usable responses after which a round of a local
+ *    sync completes, cancelling the requests still outstanding. Set to 0
+ *    to wait for every contact to respond or time out.
+ *
+ */
+#ifndef WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC_MIN_RESPONSES
+#define WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC_MIN_RESPONSES 0
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC_MIN_RESPONSES
+
 /**
  *  @def WEAVE_CONFIG_TIME_CLIENT_FABRIC_LOCAL_DISCOVERY
  *
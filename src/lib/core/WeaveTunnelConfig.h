@@ -68,15 +68,96 @@
  *  @def WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED
  *
  *  @brief
- *    This defines the default queue depth for queueing data packets
- *    destined for the Service when the connection to the Service
- *    is not yet established.
+ *    This defines the default queue depth of each traffic class
+ *    for queueing data packets destined for the Service when the
+ *    connection to the Service is not yet established.
+ *
+ *    The queue of each class is further bounded in bytes by the
+ *    WEAVE_CONFIG_TUNNELING_*_QUEUE_MAX_BYTES settings.
  *
  */
 #ifndef WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED
 #define WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED              (8)
 #endif // WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED
 
+/**
+ *  @def WEAVE_CONFIG_TUNNELING_CONTROL_QUEUE_MAX_BYTES
+ *
+ *  @brief
+ *    This defines the maximum number of bytes of control traffic
+ *    (ICMPv6, and Weave messages of profiles other than Data
+ *    Management and Bulk Data Transfer) that are queued for the
+ *    Service while the connection to the Service is not established.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNELING_CONTROL_QUEUE_MAX_BYTES
+#define WEAVE_CONFIG_TUNNELING_CONTROL_QUEUE_MAX_BYTES             (2048)
+#endif // WEAVE_CONFIG_TUNNELING_CONTROL_QUEUE_MAX_BYTES
+
+/**
+ *  @def WEAVE_CONFIG_TUNNELING_WDM_QUEUE_MAX_BYTES
+ *
+ *  @brief
+ *    This defines the maximum number of bytes of Data Management
+ *    traffic that are queued for the Service while the connection
+ *    to the Service is not established.
+ *
+ *    Packets whose Weave profile cannot be determined, e.g. those
+ *    carrying encrypted Weave messages, are accounted to this class.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNELING_WDM_QUEUE_MAX_BYTES
+#define WEAVE_CONFIG_TUNNELING_WDM_QUEUE_MAX_BYTES                 (4096)
+#endif // WEAVE_CONFIG_TUNNELING_WDM_QUEUE_MAX_BYTES
+
+/**
+ *  @def WEAVE_CONFIG_TUNNELING_BULK_QUEUE_MAX_BYTES
+ *
+ *  @brief
+ *    This defines the maximum number of bytes of Bulk Data Transfer
+ *    traffic that are queued for the Service while the connection
+ *    to the Service is not established.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNELING_BULK_QUEUE_MAX_BYTES
+#define WEAVE_CONFIG_TUNNELING_BULK_QUEUE_MAX_BYTES                (2048)
+#endif // WEAVE_CONFIG_TUNNELING_BULK_QUEUE_MAX_BYTES
+
+/**
+ *  @def WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_BURST
+ *
+ *  @brief
+ *    This defines the maximum number of queued packets that are sent
+ *    to the Service at a time once the connection to the Service is
+ *    established.  The rest are sent in further bursts, every
+ *    WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_INTERVAL_MSEC milliseconds.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_BURST
+#define WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_BURST                   (4)
+#endif // WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_BURST
+
+/**
+ *  @def WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_INTERVAL_MSEC
+ *
+ *  @brief
+ *    This defines the interval (in milliseconds) between the bursts
+ *    of queued packets sent to the Service once the connection to the
+ *    Service is established.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_INTERVAL_MSEC
+#define WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_INTERVAL_MSEC           (20)
+#endif // WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_INTERVAL_MSEC
+
+#if WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED < 1 || WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED > 255
+#error "WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED must be between 1 and 255"
+#endif
+
+#if WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_BURST < 1
+#error "WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_BURST must be at least 1"
+#endif
+
 /**
  *  @def WEAVE_CONFIG_TUNNELING_MAX_NUM_SHORTCUT_TUNNEL_PEERS
  *
@@ -89,6 +170,28 @@
 #define WEAVE_CONFIG_TUNNELING_MAX_NUM_SHORTCUT_TUNNEL_PEERS       (8)
 #endif // WEAVE_CONFIG_TUNNELING_MAX_NUM_SHORTCUT_TUNNEL_PEERS
 
+/**
+ *  @def WEAVE_CONFIG_TUNNELING_SHORTCUT_ROUTE_CACHE_SIZE
+ *
+ *  @brief
+ *    This defines the number of entries in the route cache, in which
+ *    the decision to send a tunneled packet over a shortcut tunnel or to
+ *    the Service is remembered per destination address, so that it is
+ *    not looked up in the nexthop table for every packet.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNELING_SHORTCUT_ROUTE_CACHE_SIZE
+#define WEAVE_CONFIG_TUNNELING_SHORTCUT_ROUTE_CACHE_SIZE           (16)
+#endif // WEAVE_CONFIG_TUNNELING_SHORTCUT_ROUTE_CACHE_SIZE
+
+#if WEAVE_CONFIG_TUNNELING_SHORTCUT_ROUTE_CACHE_SIZE < 1
+#error "WEAVE_CONFIG_TUNNELING_SHORTCUT_ROUTE_CACHE_SIZE must be at least 1"
+#endif
+
+#if WEAVE_CONFIG_TUNNELING_MAX_NUM_SHORTCUT_TUNNEL_PEERS > 127
+#error "WEAVE_CONFIG_TUNNELING_MAX_NUM_SHORTCUT_TUNNEL_PEERS must be at most 127"
+#endif
+
 /**
  *  @def WEAVE_TUNNEL_CONFIG_WILL_OVERRIDE_ADDR_ROUTING_FUNCS
  *
@@ -280,6 +383,64 @@
 #define WEAVE_CONFIG_TUNNEL_LIVENESS_SUPPORTED                   (1)
 #endif // WEAVE_CONFIG_TUNNEL_LIVENESS_SUPPORTED
 
+/**
+ *  @def WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+ *
+ *  @brief
+ *    This defines whether support for keeping the backup tunnel
+ *    open as a hot standby for the primary tunnel is present.
+ *
+ *    In hot standby, the backup tunnel is kept open, authenticated
+ *    and liveness-probed alongside the primary, so that a failure of
+ *    the primary tunnel is detected within one liveness interval and
+ *    handled as a mode change to the backup tunnel rather than as a
+ *    loss of the Service tunnel.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+#define WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED                (0)
+#endif // WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+
+/**
+ *  @def WEAVE_CONFIG_TUNNEL_HOT_STANDBY_LIVENESS_INTERVAL_SECS
+ *
+ *  @brief
+ *    This defines the default interval (in seconds) at which both
+ *    the primary and the backup tunnels are liveness-probed in hot
+ *    standby.  It bounds the time to detect a failure of the primary
+ *    tunnel and fail over to the backup tunnel.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNEL_HOT_STANDBY_LIVENESS_INTERVAL_SECS
+#define WEAVE_CONFIG_TUNNEL_HOT_STANDBY_LIVENESS_INTERVAL_SECS   (15)
+#endif // WEAVE_CONFIG_TUNNEL_HOT_STANDBY_LIVENESS_INTERVAL_SECS
+
+#if WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED && !(WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED && WEAVE_CONFIG_TUNNEL_LIVENESS_SUPPORTED)
+#error "WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED requires WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED and WEAVE_CONFIG_TUNNEL_LIVENESS_SUPPORTED"
+#endif
+
+/**
+ *  @def WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS
+ *
+ *  @brief
+ *    This defines the maximum number of tunnels, the primary tunnel
+ *    included, that are opened in parallel over the primary interface.
+ *
+ *    Each tunnel resolves and connects to a Service frontend on its
+ *    own, and outbound traffic is spread across the open tunnels by a
+ *    hash of the flow (source, destination, next header and ports) of
+ *    the inner IPv6 packet, so that packets of one flow stay in order
+ *    on one tunnel.  The agent state follows the primary tunnel only.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS
+#define WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS                 (1)
+#endif // WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS < 1
+#error "WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS must be at least 1"
+#endif
+
 /**
  *  @def WEAVE_CONFIG_TUNNEL_TCP_KEEPALIVE_SUPPORTED
  *
@@ -331,6 +492,49 @@
 #define WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED                   (0)
 #endif // WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
 
+/**
+ *  @def WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+ *
+ *  @brief
+ *    This defines whether support for aggregating several
+ *    tunneled IPv6 packets into a single Weave message to the
+ *    Service is present.
+ *
+ *    When present, aggregated tunnel messages are always accepted
+ *    from the Service, and are sent to it once the application has
+ *    enabled aggregation with WeaveTunnelAgent::EnableTunnelAggregation().
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+#define WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED                (0)
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+
+/**
+ *  @def WEAVE_CONFIG_TUNNEL_AGGREGATION_MAX_BYTES
+ *
+ *  @brief
+ *    This defines the maximum size (in bytes) of the payload of an
+ *    aggregated tunnel message.  IPv6 packets too large to fit in
+ *    it are sent to the Service on their own.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNEL_AGGREGATION_MAX_BYTES
+#define WEAVE_CONFIG_TUNNEL_AGGREGATION_MAX_BYTES                (1024)
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_MAX_BYTES
+
+/**
+ *  @def WEAVE_CONFIG_TUNNEL_AGGREGATION_DELAY_MSEC
+ *
+ *  @brief
+ *    This defines the maximum time (in milliseconds) that an IPv6
+ *    packet is held waiting for others to be aggregated with it
+ *    before being sent to the Service.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNEL_AGGREGATION_DELAY_MSEC
+#define WEAVE_CONFIG_TUNNEL_AGGREGATION_DELAY_MSEC               (10)
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_DELAY_MSEC
+
 /**
  *  @def WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
  *
@@ -343,6 +547,37 @@
 #define WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS                    (1)
 #endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
 
+/**
+ *  @def WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS
+ *
+ *  @brief
+ *    This defines the number of buckets of the histogram of the delay
+ *    between the time packets are queued for the Service and the time
+ *    they are sent.  The buckets double in width, from
+ *    #WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BASE_MSEC; the last one
+ *    counts all the longer delays.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS
+#define WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS        (8)
+#endif // WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS
+
+/**
+ *  @def WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BASE_MSEC
+ *
+ *  @brief
+ *    This defines the upper bound (in milliseconds) of the first
+ *    bucket of the queueing delay histogram.
+ *
+ */
+#ifndef WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BASE_MSEC
+#define WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BASE_MSEC      (10)
+#endif // WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BASE_MSEC
+
+#if WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS < 2 || WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS > 16
+#error "WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS must be between 2 and 16"
+#endif
+
 /**
  *  @def WEAVE_CONFIG_TUNNEL_ENABLE_TRANSIT_CALLBACK
  *
@@ -93,10 +93,16 @@ namespace Weave {
  *  @brief
  *    The default size of the WRMP retransmission table.
  *
+ *    This defaults to the number of packet buffers, or, where packet
+ *    buffers are allocated from the heap, to the number of exchange
+ *    contexts.
+ *
  */
 #ifndef WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE
 #ifdef PBUF_POOL_SIZE
 #define WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE                (PBUF_POOL_SIZE)
+#elif WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#define WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE                (WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS)
 #else
 #define WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE                (WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC)
 #endif // PBUF_POOL_SIZE
@@ -113,6 +119,131 @@ namespace Weave {
 #define WEAVE_CONFIG_WRMP_DEFAULT_MAX_RETRANS               (3)
 #endif // WEAVE_CONFIG_WRMP_DEFAULT_MAX_RETRANS
 
+/**
+ *  @def WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+ *
+ *  @brief
+ *    If set to (1), retransmission timeouts are derived from a smoothed
+ *    round-trip time estimate maintained for each peer node, and are
+ *    doubled on each successive retransmission of a message.  Until an
+ *    estimate is available for a peer, the configured initial or active
+ *    retransmission timeout is used as the base timeout.
+ *
+ *    If set to (0), the configured retransmission timeouts are used for
+ *    every transmission.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+#define WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS           1
+#endif // WEAVE_CONFIG_WRMP_ENABLE_ADAPTIVE_RETRANS
+
+/**
+ *  @def WEAVE_CONFIG_WRMP_MIN_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    The lower bound, in milliseconds, of a retransmission timeout
+ *    computed from a peer's round-trip time estimate.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_MIN_RETRANS_TIMEOUT
+#define WEAVE_CONFIG_WRMP_MIN_RETRANS_TIMEOUT               (2 * WEAVE_CONFIG_WRMP_TIMER_DEFAULT_PERIOD)
+#endif // WEAVE_CONFIG_WRMP_MIN_RETRANS_TIMEOUT
+
+/**
+ *  @def WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT
+ *
+ *  @brief
+ *    The upper bound, in milliseconds, of a retransmission timeout,
+ *    including any exponential backoff.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT
+#define WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT               (30000)
+#endif // WEAVE_CONFIG_WRMP_MAX_RETRANS_TIMEOUT
+
+/**
+ *  @def WEAVE_CONFIG_WRMP_ENABLE_MULTI_ACK
+ *
+ *  @brief
+ *    If set to (1), when a solitary acknowledgment falls due on an
+ *    exchange, the acknowledgments pending on all other exchanges
+ *    with the same peer are sent along with it in a single Multi-Ack
+ *    message, rather than in one Common::Null message per exchange.
+ *
+ *    Multi-Ack messages are always accepted on receipt; this only
+ *    controls whether they are sent, and so should only be enabled
+ *    when all peers are known to support them. Default value is (0)
+ *    or disabled.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_ENABLE_MULTI_ACK
+#define WEAVE_CONFIG_WRMP_ENABLE_MULTI_ACK                  0
+#endif // WEAVE_CONFIG_WRMP_ENABLE_MULTI_ACK
+
+/**
+ *  @def WEAVE_CONFIG_WRMP_MAX_MULTI_ACK_ENTRIES
+ *
+ *  @brief
+ *    The maximum number of additional acknowledgments carried by a
+ *    single Multi-Ack message.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_MAX_MULTI_ACK_ENTRIES
+#define WEAVE_CONFIG_WRMP_MAX_MULTI_ACK_ENTRIES             (16)
+#endif // WEAVE_CONFIG_WRMP_MAX_MULTI_ACK_ENTRIES
+
+/**
+ *  @def WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+ *
+ *  @brief
+ *    If set to (1), the number of unacknowledged reliable messages
+ *    outstanding to each peer node is limited by a send window that
+ *    grows additively as messages are acknowledged and is halved
+ *    when a message has to be retransmitted.  Messages sent while the
+ *    window is full are held in the retransmission table and sent as
+ *    outstanding messages are acknowledged.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+#define WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW                1
+#endif // WEAVE_CONFIG_WRMP_ENABLE_SEND_WINDOW
+
+/**
+ *  @def WEAVE_CONFIG_WRMP_SEND_WINDOW_TABLE_SIZE
+ *
+ *  @brief
+ *    The number of peer nodes for which send windows are maintained.
+ *    Messages to peers beyond this number, while the table is full of
+ *    peers with outstanding messages, are not subject to a send window.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_SEND_WINDOW_TABLE_SIZE
+#define WEAVE_CONFIG_WRMP_SEND_WINDOW_TABLE_SIZE            (8)
+#endif // WEAVE_CONFIG_WRMP_SEND_WINDOW_TABLE_SIZE
+
+/**
+ *  @def WEAVE_CONFIG_WRMP_INITIAL_SEND_WINDOW
+ *
+ *  @brief
+ *    The initial size, in messages, of the send window for a peer.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_INITIAL_SEND_WINDOW
+#define WEAVE_CONFIG_WRMP_INITIAL_SEND_WINDOW               (4)
+#endif // WEAVE_CONFIG_WRMP_INITIAL_SEND_WINDOW
+
+/**
+ *  @def WEAVE_CONFIG_WRMP_MAX_SEND_WINDOW
+ *
+ *  @brief
+ *    The maximum size, in messages, of the send window for a peer.
+ *    Must be no greater than 255.
+ *
+ */
+#ifndef WEAVE_CONFIG_WRMP_MAX_SEND_WINDOW
+#define WEAVE_CONFIG_WRMP_MAX_SEND_WINDOW                   (16)
+#endif // WEAVE_CONFIG_WRMP_MAX_SEND_WINDOW
+
 /**
  *  @brief
  *    The WRMP configuration.
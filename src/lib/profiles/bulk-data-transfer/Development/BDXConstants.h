@@ -64,6 +64,8 @@ enum
     kMsgType_BlockEOFV1 =                   0x12,
     kMsgType_BlockAckV1 =                   0x13,
     kMsgType_BlockEOFAckV1 =                0x14,
+    kMsgType_BlockQueryV2 =                 0x15,
+    kMsgType_BlockAckV2 =                   0x16,
 };
 
 /*
@@ -97,6 +99,17 @@ enum
     kRangeCtl_WideRange =                   0x10,
 };
 
+/*
+ * tags of the elements that BDX itself appends to the metadata of
+ * version 2 SendInit and ReceiveInit messages.  they are profile tags
+ * so that v0/v1 nodes, which hand the metadata to the application
+ * as is, see an element they can skip.
+ */
+enum
+{
+    kTag_WindowSize =                       0x01,
+};
+
 /*
  * status/error codes for BDX
  */
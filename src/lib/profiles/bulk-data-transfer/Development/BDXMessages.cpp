@@ -26,6 +26,7 @@
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXMessages.h>
 #include <Weave/Core/WeaveCore.h>
 #include <Weave/Core/WeaveMessageLayer.h>
+#include <Weave/Core/WeaveTLV.h>
 #include <Weave/Profiles/ProfileCommon.h>
 #include <Weave/Support/CodeUtils.h>
 
@@ -38,6 +39,75 @@ using namespace ::nl::Weave::Profiles::StatusReporting;
 
 #define VERSION_MASK 0x0F
 
+// A window size element is a fully-qualified profile tag and a 1 byte integer
+#define WINDOW_SIZE_ELEMENT_LENGTH (1 + 6 + 1)
+
+/*
+ * append the proposed window size of a version 2 init message to its
+ * metadata, as a TLV element in the BDX profile.
+ */
+static WEAVE_ERROR PackWindowSize(MessageIterator &i, uint8_t aWindowSize)
+{
+    PacketBuffer *buffer = i.GetBuffer();
+    TLV::TLVWriter writer;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    writer.Init(buffer->Start() + buffer->DataLength(), buffer->AvailableDataLength());
+
+    err = writer.Put(TLV::ProfileTag(kWeaveProfile_BDX, kTag_WindowSize), aWindowSize);
+    SuccessOrExit(err);
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    buffer->SetDataLength(buffer->DataLength() + writer.GetLengthWritten());
+    i.thePoint = buffer->Start() + buffer->DataLength();
+
+exit:
+    return err;
+}
+
+/*
+ * find the window size element of a version 2 init message in its
+ * metadata, and hide it from the application.
+ */
+static void ParseWindowSize(ReferencedTLVData &aMetaData, uint8_t &aWindowSize)
+{
+    TLV::TLVReader reader;
+    uint32_t elementStart = 0;
+
+    reader.Init(aMetaData.theData, aMetaData.theLength);
+
+    while (reader.Next() == WEAVE_NO_ERROR)
+    {
+        if (reader.GetTag() == TLV::ProfileTag(kWeaveProfile_BDX, kTag_WindowSize))
+        {
+            if (reader.Get(aWindowSize) == WEAVE_NO_ERROR)
+            {
+                // A window holds at least one block
+                if (aWindowSize == 0)
+                {
+                    aWindowSize = 1;
+                }
+
+                aMetaData.theLength = elementStart;
+                if (aMetaData.theLength == 0)
+                {
+                    aMetaData.theData = NULL;
+                }
+            }
+
+            break;
+        }
+
+        if (reader.Skip() != WEAVE_NO_ERROR)
+        {
+            break;
+        }
+
+        elementStart = reader.GetLengthRead();
+    }
+}
+
 /*
  * -- definitions for SendInit and its supporting classes --
  *
@@ -58,6 +128,7 @@ SendInit::SendInit()
     , mLength(0)
     , mMetaDataWriteCallback(NULL)
     , mMetaDataAppState(NULL)
+    , mWindowSize(1)
 {
 }
 
@@ -310,6 +381,14 @@ WEAVE_ERROR SendInit::pack(PacketBuffer *aBuffer)
         mMetaData.pack(i);
     }
 
+    // Version 1 nodes see the window size as part of the metadata, so
+    // leave it out unless there is something to negotiate.
+    if (mVersion >= 2 && mWindowSize > 1)
+    {
+        err = PackWindowSize(i, mWindowSize);
+        SuccessOrExit(err);
+    }
+
 exit:
     return err;
 }
@@ -356,9 +435,11 @@ uint16_t SendInit::GetWrittenMetaDataCallbackLength(void)
 uint16_t SendInit::packedLength()
 {
     // <xfer cctl>+<range ctl>+<max block>+<start offset (optional)>+<length (optional)>+<designator>+<metadata (optional)>
+    //  +<window size (optional)>
     uint16_t startOffsetLength = mStartOffsetPresent ? (mWideRange ? 8 : 4) : 0;
     uint16_t lengthLength = mDefiniteLength ? (mWideRange ? 8 : 4) : 0;
     uint16_t metaDataLength = 0;
+    uint16_t windowSizeLength = (mVersion >= 2 && mWindowSize > 1) ? WINDOW_SIZE_ELEMENT_LENGTH : 0;
 
     if (mMetaDataWriteCallback)
     {
@@ -369,7 +450,7 @@ uint16_t SendInit::packedLength()
         metaDataLength = mMetaData.packedLength();
     }
 
-    return 1 + 1 + 2 + startOffsetLength + lengthLength + (2 + mFileDesignator.theLength) + metaDataLength;
+    return 1 + 1 + 2 + startOffsetLength + lengthLength + (2 + mFileDesignator.theLength) + metaDataLength + windowSizeLength;
 }
 
 /**
@@ -443,6 +524,12 @@ WEAVE_ERROR SendInit::parse(PacketBuffer *aBuffer, SendInit &aRequest)
     SuccessOrExit(err);
     ReferencedTLVData::parse(i, aRequest.mMetaData);
 
+    aRequest.mWindowSize = 1;
+    if (aRequest.mVersion >= 2)
+    {
+        ParseWindowSize(aRequest.mMetaData, aRequest.mWindowSize);
+    }
+
 exit:
     return err;
 }
@@ -467,7 +554,8 @@ bool SendInit::operator == (const SendInit &another) const
             mMaxBlockSize == another.mMaxBlockSize &&
             mStartOffset == another.mStartOffset &&
             mFileDesignator == another.mFileDesignator &&
-            mMetaData == another.mMetaData);
+            mMetaData == another.mMetaData &&
+            mWindowSize == another.mWindowSize);
 }
 
 // -- definitions for SendAccept and its supporting classes --
@@ -479,6 +567,7 @@ SendAccept::SendAccept()
     : mVersion(0)
     , mTransferMode(kMode_SenderDrive)
     , mMaxBlockSize(0)
+    , mWindowSize(1)
 {
 }
 
@@ -537,6 +626,12 @@ WEAVE_ERROR SendAccept::pack(PacketBuffer *aBuffer)
     err = i.write16(mMaxBlockSize);
     SuccessOrExit(err);
 
+    if (mVersion >= 2)
+    {
+        err = i.writeByte(mWindowSize);
+        SuccessOrExit(err);
+    }
+
     mMetaData.pack(i);
 
 exit:
@@ -551,8 +646,8 @@ exit:
  */
 uint16_t SendAccept::packedLength()
 {
-    // <transfer mode>+<max block size>+<meta data (optional)>
-    return 1 + 2 + mMetaData.packedLength();
+    // <transfer mode>+<max block size>+<window size (version 2)>+<meta data (optional)>
+    return 1 + 2 + (mVersion >= 2 ? 1 : 0) + mMetaData.packedLength();
 }
 
 /**
@@ -581,6 +676,13 @@ WEAVE_ERROR SendAccept::parse(PacketBuffer *aBuffer, SendAccept &aResponse)
     err = i.read16(&aResponse.mMaxBlockSize);
     SuccessOrExit(err);
 
+    aResponse.mWindowSize = 1;
+    if (aResponse.mVersion >= 2)
+    {
+        err = i.readByte(&aResponse.mWindowSize);
+        SuccessOrExit(err);
+    }
+
     ReferencedTLVData::parse(i, aResponse.mMetaData);
 
 exit:
@@ -600,6 +702,7 @@ bool SendAccept::operator == (const SendAccept &another) const
     return (mVersion == another.mVersion &&
             mTransferMode == another.mTransferMode &&
             mMaxBlockSize == another.mMaxBlockSize &&
+            mWindowSize == another.mWindowSize &&
             mMetaData == another.mMetaData);
 }
 
@@ -622,6 +725,7 @@ ReceiveInit::ReceiveInit()
     mMaxBlockSize = 32;
     mStartOffset = 0;
     mLength = 0;
+    mWindowSize = 1;
 }
 
 // -- definitions for ReceiveAccept and its supporting classes --
@@ -637,6 +741,7 @@ ReceiveAccept::ReceiveAccept()
     mTransferMode = kMode_ReceiverDrive;
     mVersion = 0;
     mMaxBlockSize = 0;
+    mWindowSize = 1;
 }
 
 /**
@@ -723,6 +828,12 @@ WEAVE_ERROR ReceiveAccept::pack(PacketBuffer *aBuffer)
     err = i.write16(mMaxBlockSize);
     SuccessOrExit(err);
 
+    if (mVersion >= 2)
+    {
+        err = i.writeByte(mWindowSize);
+        SuccessOrExit(err);
+    }
+
     // and the length, if any
     if (mDefiniteLength)
     {
@@ -752,8 +863,8 @@ exit:
  */
 uint16_t ReceiveAccept::packedLength()
 {
-    // <transfer mode>+<range control>+<max block size>+<length (optional)>+<meta data (optional)>
-    return 1 + 1 + 2 + (mDefiniteLength ? (mWideRange ? 8 : 4) : 0) + mMetaData.packedLength();
+    // <transfer mode>+<range control>+<max block size>+<window size (version 2)>+<length (optional)>+<meta data (optional)>
+    return 1 + 1 + 2 + (mVersion >= 2 ? 1 : 0) + (mDefiniteLength ? (mWideRange ? 8 : 4) : 0) + mMetaData.packedLength();
 }
 
 /**
@@ -791,6 +902,13 @@ WEAVE_ERROR ReceiveAccept::parse(PacketBuffer *aBuffer, ReceiveAccept &aResponse
     err = i.read16(&aResponse.mMaxBlockSize);
     SuccessOrExit(err);
 
+    aResponse.mWindowSize = 1;
+    if (aResponse.mVersion >= 2)
+    {
+        err = i.readByte(&aResponse.mWindowSize);
+        SuccessOrExit(err);
+    }
+
     if (aResponse.mDefiniteLength)
     {
         if (aResponse.mWideRange)
@@ -826,6 +944,7 @@ bool ReceiveAccept::operator == (const ReceiveAccept &another) const
             mDefiniteLength == another.mDefiniteLength &&
             mWideRange == another.mWideRange &&
             mMaxBlockSize == another.mMaxBlockSize &&
+            mWindowSize == another.mWindowSize &&
             mLength == another.mLength &&
             mMetaData == another.mMetaData);
 }
@@ -1212,6 +1331,109 @@ bool BlockSendV1::operator == (const BlockSendV1 &another) const
             memcmp(mData, another.mData, mLength) == 0);
 }
 
+// -- definitions for BlockQueryV2 and its supporting classes --
+
+/**
+ * The no-arg constructor with defaults for the block query message.
+ */
+BlockQueryV2::BlockQueryV2()
+    : mBlockCounter(0)
+    , mReceivedMask(0)
+{
+}
+
+/**
+ * @brief
+ *  Initialize a BlockQueryV2 message
+ *
+ * @param[in]   aCounter        Counter of the first block that has not been received
+ * @param[in]   aReceivedMask   Mask of the later blocks that have been received,
+ *                              bit n standing for block aCounter + 1 + n
+ *
+ * @return #WEAVE_NO_ERROR if successful
+ */
+WEAVE_ERROR BlockQueryV2::init(uint32_t aCounter, uint32_t aReceivedMask)
+{
+    mBlockCounter = aCounter;
+    mReceivedMask = aReceivedMask;
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ * @brief
+ *  Pack a block query message into an PacketBuffer
+ *
+ * @param[out]  aBuffer         An PacketBuffer to pack the BlockQueryV2 message in
+ *
+ * @retval  #WEAVE_NO_ERROR                 If successful
+ * @retval  #WEAVE_ERROR_BUFFER_TOO_SMALL   If buffer is too small
+ */
+WEAVE_ERROR BlockQueryV2::pack(PacketBuffer *aBuffer)
+{
+    MessageIterator i(aBuffer);
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    i.append();
+    err = i.write32(mBlockCounter);
+    SuccessOrExit(err);
+
+    err = i.write32(mReceivedMask);
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *  Returns the packed length of this block query message
+ *
+ * @return length of the message when packed
+ */
+uint16_t BlockQueryV2::packedLength()
+{
+    // <block counter>+<received mask>
+    return sizeof(mBlockCounter) + sizeof(mReceivedMask);
+}
+
+/**
+ * @brief
+ *  Parse data from an PacketBuffer into a BlockQueryV2 message format
+ *
+ * @param[in]   aBuffer     Pointer to an PacketBuffer which has the data we want to parse out
+ * @param[out]  aQuery      Pointer to a BlockQueryV2 object where we should store the results
+ *
+ * @retval  #WEAVE_NO_ERROR                 If successful
+ * @retval  #WEAVE_ERROR_BUFFER_TOO_SMALL   If buffer is too small
+ */
+WEAVE_ERROR BlockQueryV2::parse(PacketBuffer *aBuffer, BlockQueryV2 &aQuery)
+{
+    MessageIterator i(aBuffer);
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    err = i.read32(&aQuery.mBlockCounter);
+    SuccessOrExit(err);
+
+    err = i.read32(&aQuery.mReceivedMask);
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *  Equality comparison between BlockQueryV2 messages
+ *
+ * @param[in]   another     Another BlockQueryV2 message to compare this one to
+ *
+ * @return true iff they have all the same fields.
+ */
+bool BlockQueryV2::operator == (const BlockQueryV2 &another) const
+{
+    return (mBlockCounter == another.mBlockCounter &&
+            mReceivedMask == another.mReceivedMask);
+}
+
 } // namespace BulkDataTransfer
 } // namespace Profiles
 } // namespace Weave
@@ -154,6 +154,8 @@ public:
     ReferencedTLVData mMetaData;        /**< Optional TLV Metadata. */
     MetaDataTLVWriteCallback mMetaDataWriteCallback; /**< Optional function to write out TLV Metadata. */
     void *mMetaDataAppState;            /**< Optional app state for TLV Metadata. */
+    // Windowing (version 2 and up)
+    uint8_t mWindowSize;                /**< Proposed number of blocks in flight, 1 for stop-and-wait. */
 };
 
 /**
@@ -180,6 +182,7 @@ public:
     uint8_t mVersion;               /**< Version of the BDX protocol we decided on. */
     uint8_t mTransferMode;          /**< Transfer mode that we decided on. */
     uint16_t mMaxBlockSize;         /**< Maximum block size we decided on. */
+    uint8_t mWindowSize;            /**< Number of blocks in flight we decided on (version 2 and up). */
     ReferencedTLVData mMetaData;    /**< Optional TLV Metadata. */
 };
 
@@ -421,6 +424,52 @@ class BlockAckV1 : public BlockQueryV1 { };
  */
 class BlockEOFAckV1 : public BlockQueryV1 { };
 
+/**
+ * @class BlockQueryV2
+ *
+ * @brief
+ *   The BlockQueryV2 message is used by a version 2 receiver that drives
+ *   the transfer to request the next window of blocks.  It carries the
+ *   counter of the first block the receiver is missing, all earlier
+ *   blocks having been received, and a mask of the later blocks it
+ *   already holds; the sender sends the blocks of the window that are
+ *   not in the mask.
+ */
+class NL_DLL_EXPORT BlockQueryV2
+{
+public:
+    BlockQueryV2(void);
+
+    WEAVE_ERROR init(uint32_t aCounter, uint32_t aReceivedMask);
+
+    WEAVE_ERROR pack(PacketBuffer *aBuffer);
+    uint16_t packedLength(void);
+    static WEAVE_ERROR parse(PacketBuffer *aBuffer, BlockQueryV2 &aQuery);
+
+    // BlockQueryV2 payload length
+    enum
+    {
+        kPayloadLen = 8,
+    };
+
+public:
+    bool operator == (const BlockQueryV2&) const;
+
+    uint32_t mBlockCounter;     /**< Counter of the first block that has not been received. */
+    uint32_t mReceivedMask;     /**< Bit n is set if block mBlockCounter + 1 + n has been received. */
+};
+
+/**
+ * @class BlockAckV2
+ *
+ * @brief
+ *   The BlockAckV2 message is used by a version 2 receiver to selectively
+ *   acknowledge the blocks of the window when the sender drives the
+ *   transfer.  The sender retransmits the blocks missing below the
+ *   highest acknowledged one.
+ */
+class BlockAckV2 : public BlockQueryV2 { };
+
 } // namespace WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesignation_Development)
 } // namespace Profiles
 } // namespace Weave
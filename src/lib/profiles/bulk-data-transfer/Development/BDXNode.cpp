@@ -721,6 +721,17 @@ void BdxNode::HandleReceiveInit(ExchangeContext *anEc, const IPPacketInfo *aPktI
     xfer->mAmSender = true;
     xfer->mMaxBlockSize = receiveInit.mMaxBlockSize;
     xfer->mVersion = (receiveInit.mVersion > WEAVE_CONFIG_BDX_VERSION) ? WEAVE_CONFIG_BDX_VERSION : receiveInit.mVersion;
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    // Grant at most the window the initiator proposed; the application may lower it further
+    if (xfer->mVersion < 2)
+    {
+        xfer->mWindowSize = 1;
+    }
+    else if (receiveInit.mWindowSize < xfer->mWindowSize)
+    {
+        xfer->mWindowSize = receiveInit.mWindowSize;
+    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
 
     // Verify we have a legitimate block size or reject
     VerifyOrExit(receiveInit.mMaxBlockSize > 0,
@@ -744,6 +755,12 @@ void BdxNode::HandleReceiveInit(ExchangeContext *anEc, const IPPacketInfo *aPktI
         //TODO: merge this up one line when async supported: && !receiveInit.mAsynchronousModeSupported)
                  err = WEAVE_ERROR_INVALID_TRANSFER_MODE; statusCode = kStatus_ServerBadState);
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    // Validate the window, which the application may only have lowered
+    VerifyOrExit(xfer->mWindowSize >= 1 && xfer->mWindowSize <= receiveInit.mWindowSize,
+                 err = WEAVE_ERROR_INVALID_ARGUMENT; statusCode = kStatus_ServerBadState);
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
     // TODO: validate max block size?  anything else?
     WeaveLogDetail(BDX, "HandleReceiveInit validated request\n");
 
@@ -867,6 +884,23 @@ void BdxNode::HandleSendInit(ExchangeContext *anEc, const IPPacketInfo *aPktInfo
     xfer->mAmInitiator = false;
     xfer->mAmSender = false;
     xfer->mVersion = (sendInit.mVersion > WEAVE_CONFIG_BDX_VERSION) ? WEAVE_CONFIG_BDX_VERSION : sendInit.mVersion;
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    // Grant at most the window the initiator proposed; the application may lower it further
+    if (xfer->mVersion < 2)
+    {
+        xfer->mWindowSize = 1;
+    }
+    else if (sendInit.mWindowSize < xfer->mWindowSize)
+    {
+        xfer->mWindowSize = sendInit.mWindowSize;
+    }
+
+    // Accept no larger blocks than can be received in one message
+    if (xfer->mVersion >= 2 && xfer->mMaxBlockSize > xfer->GetMaxReceiveBlockSize())
+    {
+        xfer->mMaxBlockSize = xfer->GetMaxReceiveBlockSize();
+    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
 
     // Fire application callback to validate request and setup transfer
     // Application should set the transfer mode and accept the transfer.
@@ -883,6 +917,12 @@ void BdxNode::HandleSendInit(ExchangeContext *anEc, const IPPacketInfo *aPktInfo
         //TODO: merge this up one line when async supported: && !sendInit.mAsynchronousModeSupported)
                  err = WEAVE_ERROR_INVALID_TRANSFER_MODE; statusCode = kStatus_ServerBadState);
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    // Validate the window, which the application may only have lowered
+    VerifyOrExit(xfer->mWindowSize >= 1 && xfer->mWindowSize <= sendInit.mWindowSize,
+                 err = WEAVE_ERROR_INVALID_ARGUMENT; statusCode = kStatus_ServerBadState);
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
     WeaveLogDetail(BDX, "HandleSendInit validated request\n");
 
     err = SendSendAccept(anEc, xfer);
@@ -969,7 +1009,7 @@ WEAVE_ERROR BdxNode::SendReject(ExchangeContext *anEc, uint8_t aVersion, uint16_
         err = anEc->SendMessage(kWeaveProfile_BDX, aMsgType, responsePayload, flags);
         responsePayload = NULL;
     }
-    else if (aVersion == 1)
+    else if (aVersion <= WEAVE_CONFIG_BDX_VERSION)
     {
         err = anEc->SendMessage(kWeaveProfile_Common, Common::kMsgType_StatusReport, responsePayload, flags);
         responsePayload = NULL;
@@ -1006,6 +1046,10 @@ WEAVE_ERROR BdxNode::SendReceiveAccept(ExchangeContext *anEc, BDXTransfer *aXfer
     VerifyOrExit(err == WEAVE_NO_ERROR,
                  WeaveLogDetail(BDX, "SendReceiveAccept error calling Init on receiveAccept: %d", err));
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    receiveAccept.mWindowSize = aXfer->mWindowSize;
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
     payload = PacketBuffer::New();
     VerifyOrExit(payload != NULL,
                  err = WEAVE_ERROR_NO_MEMORY;
@@ -1029,14 +1073,21 @@ WEAVE_ERROR BdxNode::SendReceiveAccept(ExchangeContext *anEc, BDXTransfer *aXfer
     if (aXfer->IsDriver())
     {
         WeaveLogDetail(BDX, "ReceiveAccept sent: Am driving so sending first block");
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+        if (aXfer->mVersion == 2)
+        {
+            err = BdxProtocol::ScheduleBlockSend(*aXfer, BdxProtocol::SendWindowV2);
+        }
+        else
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
         if (aXfer->mVersion == 1)
         {
-            err = BdxProtocol::SendNextBlockV1(*aXfer);
+            err = BdxProtocol::ScheduleBlockSend(*aXfer, BdxProtocol::SendNextBlockV1);
         }
 #if WEAVE_CONFIG_BDX_V0_SUPPORT
         else if (aXfer->mVersion == 0)
         {
-            err = BdxProtocol::SendNextBlock(*aXfer);
+            err = BdxProtocol::ScheduleBlockSend(*aXfer, BdxProtocol::SendNextBlock);
         }
 #endif // WEAVE_CONFIG_BDX_V0_SUPPORT
         else
@@ -1072,6 +1123,10 @@ WEAVE_ERROR BdxNode::SendSendAccept(ExchangeContext *anEc, BDXTransfer *aXfer)
     VerifyOrExit(err == WEAVE_NO_ERROR,
                  WeaveLogDetail(BDX, "SendSendAccept error calling Init on sendAccept: %d", err));
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    sendAccept.mWindowSize = aXfer->mWindowSize;
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
     payload = PacketBuffer::New();
     VerifyOrExit(payload != NULL,
                  err = WEAVE_ERROR_NO_MEMORY;
@@ -1096,6 +1151,13 @@ WEAVE_ERROR BdxNode::SendSendAccept(ExchangeContext *anEc, BDXTransfer *aXfer)
     if (aXfer->IsDriver())
     {
         WeaveLogDetail(BDX, "SendAccept sent: Am driving so sending first block query");
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+        if (aXfer->mVersion == 2)
+        {
+            err = BdxProtocol::SendBlockQueryV2(*aXfer);
+        }
+        else
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
         if (aXfer->mVersion == 1)
         {
             err = BdxProtocol::SendBlockQueryV1(*aXfer);
@@ -31,6 +31,7 @@
 #include <Weave/Core/WeaveEncoding.h>
 #include <Weave/Core/WeaveServerBase.h>
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXProtocol.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXScheduler.h>
 #include <Weave/Support/WeaveFaultInjection.h>
 
 namespace nl {
@@ -67,6 +68,14 @@ WEAVE_ERROR InitBdxReceive(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
 
     VerifyOrExit(buffer != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    // Don't propose blocks larger than can be received in one message
+    if (aXfer.mMaxBlockSize > aXfer.GetMaxReceiveBlockSize())
+    {
+        aXfer.mMaxBlockSize = aXfer.GetMaxReceiveBlockSize();
+    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
     if (aXfer.mIsWideRange)
     {
         err = msg.init(WEAVE_CONFIG_BDX_VERSION, aUCanDrive, aICanDrive, aAsyncOk, aXfer.mMaxBlockSize, aXfer.mStartOffset, aXfer.mLength, aXfer.mFileDesignator, aMetaData);
@@ -78,6 +87,11 @@ WEAVE_ERROR InitBdxReceive(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
         SuccessOrExit(err);
     }
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    VerifyOrExit(aXfer.mWindowSize >= 1 && aXfer.mWindowSize <= WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    msg.mWindowSize = aXfer.mWindowSize;
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
     err = msg.pack(buffer);
     SuccessOrExit(err);
 
@@ -134,6 +148,11 @@ WEAVE_ERROR InitBdxSend(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
         SuccessOrExit(err);
     }
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    VerifyOrExit(aXfer.mWindowSize >= 1 && aXfer.mWindowSize <= WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    msg.mWindowSize = aXfer.mWindowSize;
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
     err = msg.pack(buffer);
     SuccessOrExit(err);
 
@@ -190,6 +209,11 @@ WEAVE_ERROR InitBdxSend(BDXTransfer &aXfer, bool aICanDrive, bool aUCanDrive,
         SuccessOrExit(err);
     }
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    VerifyOrExit(aXfer.mWindowSize >= 1 && aXfer.mWindowSize <= WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    msg.mWindowSize = aXfer.mWindowSize;
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
     err = msg.pack(buffer);
     SuccessOrExit(err);
 
@@ -637,6 +661,646 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+/*
+ * Returns the window slot holding the block with the given counter.  The
+ * negotiated window never exceeds WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE, so the
+ * blocks of one window always map to distinct slots.
+ */
+static inline PacketBuffer *& WindowSlot(BDXTransfer &aXfer, uint32_t aCounter)
+{
+    return aXfer.mWindowBlocks[aCounter % WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE];
+}
+
+/*
+ * Retrieves the block following the window by calling the BDXTransfer's
+ * GetBlockHandler and keeps it in the window until it is acknowledged.
+ */
+static WEAVE_ERROR FetchWindowBlock(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR     err         = WEAVE_NO_ERROR;
+    uint64_t        length;
+    uint8_t*        data;
+    bool            isLast      = false;
+    PacketBuffer*   buffer      = NULL;
+    uint32_t        blockCounter;
+
+    VerifyOrExit(aXfer.mHandlers.mGetBlockHandler != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    buffer = PacketBuffer::New();
+    VerifyOrExit(buffer != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    data = buffer->Start();
+
+    blockCounter = aXfer.mWindowEnd;
+    WEAVE_FAULT_INJECT(FaultInjection::kFault_BDXBadBlockCounter, blockCounter++);
+
+    nl::Weave::Encoding::LittleEndian::Write32(data, blockCounter);
+
+    length = buffer->AvailableDataLength() - sizeof(blockCounter);
+
+    if (length > aXfer.mMaxBlockSize)
+    {
+        length = aXfer.mMaxBlockSize;
+    }
+
+    aXfer.DispatchGetBlockHandler(&length, &data, &isLast);
+
+    VerifyOrExit((length + sizeof(blockCounter)) <= buffer->AvailableDataLength(), err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    if (data != (buffer->Start() + sizeof(blockCounter)))
+    {
+        memcpy(buffer->Start() + sizeof(blockCounter), data, length);
+    }
+
+    buffer->SetDataLength(length + sizeof(blockCounter));
+
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+    // Over TCP, carry on filling chained buffers up to the negotiated block size.
+    if (aXfer.CanChainBlocks())
+    {
+        const uint64_t maxBlockSize = min<uint64_t>(aXfer.mMaxBlockSize, WEAVE_CONFIG_BDX_MAX_TCP_BLOCK_SIZE);
+        uint64_t blockLength = length;
+
+        while (!isLast && blockLength < maxBlockSize)
+        {
+            PacketBuffer *next = PacketBuffer::New(0);
+            uint64_t requested;
+
+            VerifyOrExit(next != NULL, err = WEAVE_ERROR_NO_MEMORY);
+            buffer->AddToEnd(next);
+
+            requested = min<uint64_t>(next->AvailableDataLength(), maxBlockSize - blockLength);
+            length = requested;
+            data = next->Start();
+
+            aXfer.DispatchGetBlockHandler(&length, &data, &isLast);
+
+            VerifyOrExit(length <= requested, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+            if (data != next->Start())
+            {
+                memcpy(next->Start(), data, length);
+            }
+
+            next->SetDataLength(length, buffer);
+            blockLength += length;
+
+            // A short read means the application has no more data at hand.
+            if (length < requested)
+            {
+                break;
+            }
+        }
+    }
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+    WindowSlot(aXfer, aXfer.mWindowEnd) = buffer;
+    buffer = NULL;
+
+    if (isLast)
+    {
+        aXfer.mLastBlockKnown = true;
+        aXfer.mLastBlockCounter = aXfer.mWindowEnd;
+    }
+
+    aXfer.mWindowEnd++;
+
+exit:
+    if (buffer != NULL)
+    {
+        PacketBuffer::Free(buffer);
+    }
+
+    return err;
+}
+
+/*
+ * Sends a copy of a block held in the window, as a BlockEOFV1 if it is the
+ * last block and as a BlockSendV1 otherwise.  The held block stays in the
+ * window so that it can be sent again.
+ */
+static WEAVE_ERROR SendWindowBlock(BDXTransfer &aXfer, uint32_t aCounter)
+{
+    WEAVE_ERROR     err         = WEAVE_NO_ERROR;
+    PacketBuffer*   block       = WindowSlot(aXfer, aCounter);
+    PacketBuffer*   buffer      = NULL;
+    uint8_t         msgType;
+    uint16_t        flags;
+
+    WeaveLogDetail(BDX, "Sending block # %d\n", aCounter);
+
+    VerifyOrExit(block != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    buffer = PacketBuffer::NewWithAvailableSize(block->DataLength());
+    VerifyOrExit(buffer != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    memcpy(buffer->Start(), block->Start(), block->DataLength());
+    buffer->SetDataLength(block->DataLength());
+
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+    // Copy the rest of a block that spans a chain, a buffer at a time.
+    for (PacketBuffer *piece = block->Next(); piece != NULL; piece = piece->Next())
+    {
+        PacketBuffer *copy = PacketBuffer::New(0);
+
+        VerifyOrExit(copy != NULL, err = WEAVE_ERROR_NO_MEMORY);
+        buffer->AddToEnd(copy);
+
+        memcpy(copy->Start(), piece->Start(), piece->DataLength());
+        copy->SetDataLength(piece->DataLength(), buffer);
+    }
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+    if (aXfer.mLastBlockKnown && aCounter == aXfer.mLastBlockCounter)
+    {
+        msgType = kMsgType_BlockEOFV1;
+    }
+    else
+    {
+        msgType = kMsgType_BlockSendV1;
+    }
+
+    flags = aXfer.GetDefaultFlags(true);
+
+    err = aXfer.mExchangeContext->SendMessage(kWeaveProfile_BDX, msgType, buffer, flags);
+    buffer = NULL;
+
+exit:
+    if (buffer != NULL)
+    {
+        PacketBuffer::Free(buffer);
+    }
+
+    return err;
+}
+
+/*
+ * Sends again the blocks among the first aLimit blocks of the window that
+ * the receiver does not hold and that have not been retransmitted since the
+ * window last moved.
+ */
+static WEAVE_ERROR RetransmitWindow(BDXTransfer &aXfer, uint32_t aLimit)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    for (uint32_t i = 0; i < aLimit; i++)
+    {
+        const uint32_t bit = static_cast<uint32_t>(1) << i;
+
+        if ((aXfer.mWindowMask & bit) == 0 && (aXfer.mRetransmitMask & bit) == 0)
+        {
+            aXfer.mRetransmitMask |= bit;
+
+            err = SendWindowBlock(aXfer, aXfer.mBlockCounter + i);
+            SuccessOrExit(err);
+        }
+    }
+
+exit:
+    return err;
+}
+
+/*
+ * Moves the window of a version 2 sender to the first block the receiver is
+ * missing, freeing the blocks it no longer needs to hold.  aReceivedMask is
+ * the selective acknowledgement of a BlockAckV2 or BlockQueryV2: its bit n
+ * reports block aCounter + 1 + n as received.
+ */
+static void MoveWindow(BDXTransfer &aXfer, uint32_t aCounter, uint32_t aReceivedMask)
+{
+    const uint32_t shift = aCounter - aXfer.mBlockCounter;
+    uint32_t inFlight;
+
+    while (aXfer.mBlockCounter < aCounter)
+    {
+        PacketBuffer *& slot = WindowSlot(aXfer, aXfer.mBlockCounter);
+
+        if (slot != NULL)
+        {
+            PacketBuffer::Free(slot);
+            slot = NULL;
+        }
+
+        aXfer.mBlockCounter++;
+    }
+
+    if (shift > 0)
+    {
+        aXfer.mWindowMask = (shift < 32) ? aXfer.mWindowMask >> shift : 0;
+        aXfer.mRetransmitMask = (shift < 32) ? aXfer.mRetransmitMask >> shift : 0;
+    }
+
+    aXfer.mWindowMask |= aReceivedMask << 1;
+
+    // Ignore acknowledgements of blocks that were never sent
+    inFlight = aXfer.mWindowEnd - aXfer.mBlockCounter;
+    if (inFlight < 32)
+    {
+        aXfer.mWindowMask &= (static_cast<uint32_t>(1) << inFlight) - 1;
+    }
+
+    // Blocks the receiver holds will not be sent again
+    for (uint32_t i = 0; i < inFlight; i++)
+    {
+        if (aXfer.mWindowMask & (static_cast<uint32_t>(1) << i))
+        {
+            PacketBuffer *& slot = WindowSlot(aXfer, aXfer.mBlockCounter + i);
+
+            if (slot != NULL)
+            {
+                PacketBuffer::Free(slot);
+                slot = NULL;
+            }
+        }
+    }
+}
+
+/**
+ * @brief
+ *  This function sends blocks for a version 2 transfer.  It first sends again,
+ *  once, every block that was overtaken by a block the receiver acknowledged,
+ *  then sends new blocks, retrieved by calling the BDXTransfer's GetBlockHandler,
+ *  until the window is full or the last block has been sent.
+ *
+ * @param[in]       aXfer   The BDXTransfer whose window is to be filled
+ *
+ * @retval          #WEAVE_ERROR_INCORRECT_STATE    If the GetBlockHandler is NULL
+ * @retval          #WEAVE_ERROR_NO_MEMORY          If no available PacketBuffers
+ */
+WEAVE_ERROR SendWindowV2(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR err     = WEAVE_NO_ERROR;
+    uint32_t    limit   = 0;
+
+    // Only the blocks below the highest acknowledged one are known to be lost
+    for (uint32_t mask = aXfer.mWindowMask; mask != 0; mask >>= 1)
+    {
+        limit++;
+    }
+
+    err = RetransmitWindow(aXfer, limit);
+    SuccessOrExit(err);
+
+    while (!aXfer.mLastBlockKnown && (aXfer.mWindowEnd - aXfer.mBlockCounter) < aXfer.mWindowSize)
+    {
+        err = FetchWindowBlock(aXfer);
+        SuccessOrExit(err);
+
+        err = SendWindowBlock(aXfer, aXfer.mWindowEnd - 1);
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+/*
+ * Answers a BlockQueryV2: sends again every block in flight the receiver
+ * does not hold, then fills the window.
+ */
+static WEAVE_ERROR ResendWindowV2(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    err = RetransmitWindow(aXfer, aXfer.mWindowEnd - aXfer.mBlockCounter);
+    SuccessOrExit(err);
+
+    err = SendWindowV2(aXfer);
+
+exit:
+    return err;
+}
+
+/*
+ * Packs and sends a BlockQueryV2 or BlockAckV2 reporting the next block the
+ * receiver expects and the blocks after it that it holds.
+ */
+static WEAVE_ERROR SendWindowStatus(BDXTransfer &aXfer, uint8_t aMsgType, bool aExpectResponse)
+{
+    WEAVE_ERROR     err     = WEAVE_NO_ERROR;
+    PacketBuffer*   buffer  = PacketBuffer::NewWithAvailableSize(BlockQueryV2::kPayloadLen);
+    BlockQueryV2    outMsg;
+    uint16_t        flags;
+
+    VerifyOrExit(buffer != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    SuccessOrExit(err = outMsg.init(aXfer.mBlockCounter, aXfer.mWindowMask >> 1));
+    SuccessOrExit(err = outMsg.pack(buffer));
+
+    flags = aXfer.GetDefaultFlags(aExpectResponse);
+
+    err = aXfer.mExchangeContext->SendMessage(kWeaveProfile_BDX, aMsgType, buffer, flags);
+    buffer = NULL;
+
+exit:
+    if (buffer != NULL)
+    {
+        PacketBuffer::Free(buffer);
+    }
+
+    return err;
+}
+
+/**
+ * @brief
+ *  This function sends a BlockQueryV2 message for the given BDXTransfer,
+ *  requesting the window of blocks starting at aXfer.mBlockCounter along with
+ *  any block of it the receiver does not hold yet.
+ *
+ * @param[in]      aXfer        The BDXTransfer we're sending a BlockQueryV2 for.
+ *
+ * @retval         #WEAVE_NO_ERROR          If we successfully sent the message.
+ * @retval         #WEAVE_ERROR_NO_MEMORY   If no available PacketBuffers.
+ */
+WEAVE_ERROR SendBlockQueryV2(BDXTransfer &aXfer)
+{
+    aXfer.mWindowEnd = aXfer.mBlockCounter + aXfer.mWindowSize;
+
+    return SendWindowStatus(aXfer, kMsgType_BlockQueryV2, true);
+}
+
+/*
+ * Acknowledges the blocks a version 2 receiver has, without asking for more.
+ */
+static WEAVE_ERROR SendBlockAckV2(BDXTransfer &aXfer)
+{
+    return SendWindowStatus(aXfer, kMsgType_BlockAckV2, false);
+}
+
+/*
+ * Handles a block received by a version 2 receiver.  The next expected block
+ * is handed to the application along with the blocks held after it; a later
+ * block within the window is held until the blocks before it arrive.
+ */
+static WEAVE_ERROR HandleWindowBlock(BDXTransfer &aXfer, bool aIsEOF, PacketBuffer *aPacketBuffer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    BlockSendV1 block;
+    uint32_t    offset;
+    bool        isLast;
+
+    err = BlockSendV1::parse(aPacketBuffer, block);
+    SuccessOrExit(err);
+
+    if (block.mBlockCounter < aXfer.mBlockCounter)
+    {
+        // A duplicate: the sender may have missed our acknowledgement
+        WeaveLogDetail(BDX, "Received duplicate block: %d", block.mBlockCounter);
+        aXfer.mNext = aXfer.IsDriver() ? NULL : SendBlockAckV2;
+        ExitNow();
+    }
+
+    offset = block.mBlockCounter - aXfer.mBlockCounter;
+
+    if (offset >= aXfer.mWindowSize ||
+        (aXfer.mLastBlockKnown && block.mBlockCounter > aXfer.mLastBlockCounter) ||
+        (aIsEOF && (aXfer.mWindowMask >> offset) > 1))
+    {
+        WeaveLogDetail(BDX, "Received bad block counter: %d, expected: %d", block.mBlockCounter, aXfer.mBlockCounter);
+        aXfer.mNext = SendBadBlockCounterStatusReport;
+        ExitNow();
+    }
+
+    if (aIsEOF)
+    {
+        aXfer.mLastBlockKnown = true;
+        aXfer.mLastBlockCounter = block.mBlockCounter;
+    }
+
+    if (offset > 0)
+    {
+        // Hold the block until the blocks before it arrive
+        if ((aXfer.mWindowMask & (static_cast<uint32_t>(1) << offset)) == 0)
+        {
+            aPacketBuffer->AddRef();
+            WindowSlot(aXfer, block.mBlockCounter) = aPacketBuffer;
+            aXfer.mWindowMask |= static_cast<uint32_t>(1) << offset;
+        }
+
+        if (!aXfer.IsDriver())
+        {
+            aXfer.mNext = SendBlockAckV2;
+        }
+        else if (aIsEOF || block.mBlockCounter + 1 >= aXfer.mWindowEnd)
+        {
+            // The end of the queried window arrived ahead of the blocks before it
+            aXfer.mNext = SendBlockQueryV2;
+        }
+
+        ExitNow();
+    }
+
+    isLast = aIsEOF;
+    aXfer.DispatchPutBlockHandler(aPacketBuffer, block.mLength, block.mData, isLast);
+
+    // Deliver the held blocks that are now in order
+    while (!isLast)
+    {
+        PacketBuffer *& slot = WindowSlot(aXfer, aXfer.mBlockCounter + 1);
+        BlockSendV1 held;
+
+        aXfer.mBlockCounter++;
+        aXfer.mWindowMask >>= 1;
+
+        if ((aXfer.mWindowMask & 1) == 0)
+        {
+            break;
+        }
+
+        err = BlockSendV1::parse(slot, held);
+        PacketBuffer::Free(slot);
+        slot = NULL;
+        aXfer.mWindowMask &= ~static_cast<uint32_t>(1);
+        SuccessOrExit(err);
+
+        isLast = aXfer.mLastBlockKnown && held.mBlockCounter == aXfer.mLastBlockCounter;
+        aXfer.DispatchPutBlockHandler(held.GetBuffer(), held.mLength, held.mData, isLast);
+    }
+
+    if (isLast)
+    {
+        // SendBlockEOFAckV1 acknowledges aXfer.mBlockCounter, the last block
+        aXfer.mNext = SendBlockEOFAckV1;
+    }
+    else if (!aXfer.IsDriver())
+    {
+        aXfer.mNext = SendBlockAckV2;
+    }
+    else if (aXfer.mBlockCounter >= aXfer.mWindowEnd)
+    {
+        aXfer.mNext = SendBlockQueryV2;
+    }
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
+/**
+ * @brief
+ *  Makes a block send, as allowed by the BDX transfer scheduler when it is
+ *  enabled, or immediately otherwise.
+ *
+ * @param[in]   aXfer   The sending BDXTransfer
+ * @param[in]   aSend   The function that sends the block(s): SendNextBlock,
+ *                      SendNextBlockV1 or SendWindowV2
+ *
+ * @return  The error returned by aSend if it ran immediately, or
+ *          WEAVE_NO_ERROR if the send was deferred.
+ */
+WEAVE_ERROR ScheduleBlockSend(BDXTransfer &aXfer, WEAVE_ERROR (*aSend)(BDXTransfer &))
+{
+#if WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+    return BdxScheduler::Schedule(aXfer, aSend);
+#else
+    return aSend(aXfer);
+#endif // WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+}
+
+/*
+ * Returns true if the given next action sends data blocks.
+ */
+static bool IsBlockSend(WEAVE_ERROR (*aAction)(BDXTransfer &))
+{
+    bool isBlockSend = (aAction == SendNextBlockV1);
+
+#if WEAVE_CONFIG_BDX_V0_SUPPORT
+    isBlockSend = isBlockSend || (aAction == SendNextBlock);
+#endif // WEAVE_CONFIG_BDX_V0_SUPPORT
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    isBlockSend = isBlockSend || (aAction == SendWindowV2) || (aAction == ResendWindowV2);
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
+    return isBlockSend;
+}
+
+/*
+ * Takes the next action of a transfer, unless the transfer is paused or
+ * waiting for received blocks to be written, in which case the action is
+ * held back until the transfer can go on.
+ */
+static WEAVE_ERROR RunNext(BDXTransfer &aXfer, WEAVE_ERROR (*aNext)(BDXTransfer &))
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    if (aXfer.mIsPaused || aXfer.IsWaitingForStorage())
+    {
+        aXfer.mPausedNext = aNext;
+    }
+    // Block sends are paced by the transfer scheduler.
+    else if (IsBlockSend(aNext))
+    {
+        err = ScheduleBlockSend(aXfer, aNext);
+    }
+    else
+    {
+        err = aNext(aXfer);
+    }
+
+    return err;
+}
+
+/*
+ * Takes the action held back while the transfer was paused or waiting for
+ * storage, once it is neither.
+ */
+static WEAVE_ERROR RunHeldBack(BDXTransfer &aXfer)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WEAVE_ERROR (*next)(BDXTransfer &) = aXfer.mPausedNext;
+
+    VerifyOrExit(next != NULL && !aXfer.mIsPaused && !aXfer.IsWaitingForStorage(), );
+
+    aXfer.mPausedNext = NULL;
+
+    err = RunNext(aXfer, next);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        aXfer.DispatchErrorHandler(err);
+    }
+
+    return err;
+}
+
+/**
+ * @brief
+ *  Pauses a transfer: the message that would normally follow the message
+ *  being handled (e.g. the BlockQuery or BlockAck for a received block) is
+ *  held back until ResumeTransfer() is called.
+ *
+ *  This lets an application that can't yet take more data, such as one
+ *  still writing earlier blocks to storage, hold off the peer.  It is
+ *  typically called from a PutBlockHandler.  Note that a paused transfer is
+ *  still subject to the peer's response timeout.
+ *
+ * @param[in]   aXfer   The BDXTransfer to pause
+ */
+void PauseTransfer(BDXTransfer &aXfer)
+{
+    aXfer.mIsPaused = true;
+}
+
+/**
+ * @brief
+ *  Resumes a transfer paused by PauseTransfer(), taking any action held back,
+ *  unless the transfer is still waiting for received blocks to be written.
+ *
+ * @param[in]   aXfer   The BDXTransfer to resume
+ *
+ * @return  The error from the action held back, which has also been
+ *          dispatched to the transfer's ErrorHandler, or WEAVE_NO_ERROR.
+ */
+WEAVE_ERROR ResumeTransfer(BDXTransfer &aXfer)
+{
+    aXfer.mIsPaused = false;
+
+    return RunHeldBack(aXfer);
+}
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+/**
+ * @brief
+ *  Reports that the AsyncPutBlockHandler of a transfer has finished writing
+ *  the block it returned true for.  The blocks queued meanwhile are then
+ *  handed to the handler, and the BlockQuery, BlockAck or BlockEOFAck held
+ *  off while waiting for storage is sent once there is room for more blocks.
+ *
+ * @param[in]   aXfer   The BDXTransfer the block was received on
+ * @param[in]   aError  WEAVE_NO_ERROR if the block was written, else the error
+ *                      that prevented it, which is dispatched to the transfer's
+ *                      ErrorHandler
+ *
+ * @retval  #WEAVE_ERROR_INCORRECT_STATE    If no block is being written.
+ * @return  aError, or the error from the action held back, which has also been
+ *          dispatched to the transfer's ErrorHandler, or WEAVE_NO_ERROR.
+ */
+WEAVE_ERROR PutBlockComplete(BDXTransfer &aXfer, WEAVE_ERROR aError)
+{
+    WEAVE_ERROR err = aError;
+
+    VerifyOrExit(aXfer.mIsWritingBlock, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    aXfer.CompletePendingBlock();
+
+    if (err != WEAVE_NO_ERROR)
+    {
+        aXfer.DispatchErrorHandler(err);
+        ExitNow();
+    }
+
+    aXfer.WritePendingBlocks();
+
+    err = RunHeldBack(aXfer);
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
 /**
  * @brief
  *  The main handler for messages arriving on the BDX exchange.  It essentially
@@ -688,7 +1352,7 @@ void HandleResponse(ExchangeContext *anEc, const IPPacketInfo *aPktInfo, const W
 
     if (xfer->mNext)
     {
-        err = xfer->mNext(*xfer);
+        err = RunNext(*xfer, xfer->mNext);
         xfer->mNext = NULL;
     }
 
@@ -1024,6 +1688,61 @@ WEAVE_ERROR HandleResponseTransmit(BDXTransfer &aXfer, uint32_t aProfileId, uint
 
                 break;
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+            case kMsgType_BlockAckV2:
+                {
+                    BlockAckV2 ackV2;
+
+                    VerifyOrExit(aXfer.IsDriver() && !aXfer.IsAsync() && aXfer.mVersion >= 2, err = WEAVE_NO_ERROR);
+
+                    err = BlockAckV2::parse(aPacketBuffer, ackV2);
+                    VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockAckV2 parse failed."));
+
+                    rcvdCounter = ackV2.mBlockCounter;
+
+                    if (rcvdCounter > aXfer.mWindowEnd)
+                    {
+                        WeaveLogDetail(BDX, "Received bad block counter: %d, expected at most: %d", rcvdCounter, aXfer.mWindowEnd);
+                        aXfer.mNext = SendBadBlockCounterStatusReport;
+                    }
+                    else if (rcvdCounter >= aXfer.mBlockCounter)
+                    {
+                        // Acknowledgements older than the window are ignored, as they may be duplicates
+                        MoveWindow(aXfer, rcvdCounter, ackV2.mReceivedMask);
+                        aXfer.mNext = SendWindowV2;
+                    }
+                }
+
+                break;
+
+            case kMsgType_BlockQueryV2:
+                {
+                    BlockQueryV2 queryV2;
+
+                    VerifyOrExit(!aXfer.IsDriver() && !aXfer.IsAsync() && aXfer.mVersion >= 2, err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
+
+                    err = BlockQueryV2::parse(aPacketBuffer, queryV2);
+                    VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockQueryV2 parse failed."));
+
+                    rcvdCounter = queryV2.mBlockCounter;
+
+                    if (rcvdCounter > aXfer.mWindowEnd)
+                    {
+                        WeaveLogDetail(BDX, "Received bad block counter: %d, expected at most: %d", rcvdCounter, aXfer.mWindowEnd);
+                        aXfer.mNext = SendBadBlockCounterStatusReport;
+                    }
+                    else if (rcvdCounter >= aXfer.mBlockCounter)
+                    {
+                        // The receiver asks for every block it is missing again
+                        MoveWindow(aXfer, rcvdCounter, queryV2.mReceivedMask);
+                        aXfer.mRetransmitMask = 0;
+                        aXfer.mNext = ResendWindowV2;
+                    }
+                }
+
+                break;
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
 #if WEAVE_CONFIG_BDX_V0_SUPPORT
             case kMsgType_BlockEOFAck:
                 // TODO: should we bother parsing the message here just
@@ -1046,6 +1765,18 @@ WEAVE_ERROR HandleResponseTransmit(BDXTransfer &aXfer, uint32_t aProfileId, uint
 
                     rcvdCounter = EOFAckV1.mBlockCounter;
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+                    if (aXfer.mVersion >= 2)
+                    {
+                        // Version 2 senders move their window past the last block on its acknowledgement
+                        if (aXfer.mLastBlockKnown && rcvdCounter == aXfer.mLastBlockCounter)
+                        {
+                            aXfer.ReleaseWindow();
+                            aXfer.mBlockCounter = rcvdCounter;
+                        }
+                    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
                     if (rcvdCounter == aXfer.mBlockCounter)
                     {
                         aXfer.mIsCompletedSuccessfully = true;
@@ -1124,7 +1855,7 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId, uint8
                     err = BlockSend::parse(aPacketBuffer, blockSend);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockSend parse failed."));
 
-                    aXfer.DispatchPutBlockHandler(blockSend.mLength, blockSend.mData, false);
+                    aXfer.DispatchPutBlockHandler(aPacketBuffer, blockSend.mLength, blockSend.mData, false);
 
                     aXfer.mBlockCounter++;
                     // SendBlockAck will by design send out the ack for mBlockCounter - 1
@@ -1137,6 +1868,16 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId, uint8
             case kMsgType_BlockSendV1:
                 {
                     BlockSendV1 blockSendV1;
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+                    if (aXfer.mVersion >= 2)
+                    {
+                        err = HandleWindowBlock(aXfer, false, aPacketBuffer);
+                        VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockSendV1 parse failed."));
+                        break;
+                    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
                     err = BlockSendV1::parse(aPacketBuffer, blockSendV1);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockSendV1 parse failed."));
 
@@ -1144,7 +1885,7 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId, uint8
 
                     if (rcvdCounter == aXfer.mBlockCounter)
                     {
-                        aXfer.DispatchPutBlockHandler(blockSendV1.mLength, blockSendV1.mData, false);
+                        aXfer.DispatchPutBlockHandler(aPacketBuffer, blockSendV1.mLength, blockSendV1.mData, false);
                     }
 
                     if (rcvdCounter == aXfer.mBlockCounter)
@@ -1182,7 +1923,7 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId, uint8
                         err = BlockEOF::parse(aPacketBuffer, blockEOF);
                         VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockEOF parse failed."));
 
-                        aXfer.DispatchPutBlockHandler(blockEOF.mLength, blockEOF.mData, true);
+                        aXfer.DispatchPutBlockHandler(aPacketBuffer, blockEOF.mLength, blockEOF.mData, true);
                     }
 
                     // ACK the EOF and clean up transfer
@@ -1195,6 +1936,16 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId, uint8
             case kMsgType_BlockEOFV1:
                 {
                     BlockEOFV1 blockEOFV1;
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+                    if (aXfer.mVersion >= 2)
+                    {
+                        err = HandleWindowBlock(aXfer, true, aPacketBuffer);
+                        VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockEOFV1 parse failed."));
+                        break;
+                    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
                     err = BlockEOFV1::parse(aPacketBuffer, blockEOFV1);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "BlockEOFV1 parse failed."));
 
@@ -1202,7 +1953,7 @@ WEAVE_ERROR HandleResponseReceive(BDXTransfer &aXfer, uint32_t aProfileId, uint8
 
                     if (rcvdCounter == aXfer.mBlockCounter)
                     {
-                        aXfer.DispatchPutBlockHandler(blockEOFV1.mLength, blockEOFV1.mData, true);
+                        aXfer.DispatchPutBlockHandler(aPacketBuffer, blockEOFV1.mLength, blockEOFV1.mData, true);
                     }
 
                     if (rcvdCounter == aXfer.mBlockCounter)
@@ -1306,6 +2057,17 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
                     aXfer.mMaxBlockSize = inMsg.mMaxBlockSize;
                     aXfer.mTransferMode = inMsg.mTransferMode;
                     aXfer.mVersion = inMsg.mVersion;
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+                    // The responder never grants a larger window than proposed
+                    if (aXfer.mVersion >= 2 && inMsg.mWindowSize >= 1 && inMsg.mWindowSize < aXfer.mWindowSize)
+                    {
+                        aXfer.mWindowSize = inMsg.mWindowSize;
+                    }
+                    else if (aXfer.mVersion < 2)
+                    {
+                        aXfer.mWindowSize = 1;
+                    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
                     err = aXfer.DispatchSendAccept(&inMsg);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "DispatchSendAccept failed."));
 
@@ -1315,7 +2077,15 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
                     {
                         case kMode_SenderDrive:
                             // Try and send the first block
-                            VerifyOrExit(aXfer.mVersion < 2, err = WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+                            VerifyOrExit(aXfer.mVersion <= 2, err = WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+                            if (aXfer.mVersion == 2)
+                            {
+                                aXfer.mNext = SendWindowV2;
+                                break;
+                            }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
 
 #if WEAVE_CONFIG_BDX_V0_SUPPORT
                             aXfer.mNext = aXfer.mVersion == 1 ? SendNextBlockV1 : SendNextBlock;
@@ -1381,6 +2151,17 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
                     aXfer.mTransferMode = inMsg.mTransferMode;
                     aXfer.mVersion = inMsg.mVersion;
                     aXfer.mLength = inMsg.mLength;
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+                    // The responder never grants a larger window than proposed
+                    if (aXfer.mVersion >= 2 && inMsg.mWindowSize >= 1 && inMsg.mWindowSize < aXfer.mWindowSize)
+                    {
+                        aXfer.mWindowSize = inMsg.mWindowSize;
+                    }
+                    else if (aXfer.mVersion < 2)
+                    {
+                        aXfer.mWindowSize = 1;
+                    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
                     err = aXfer.DispatchReceiveAccept(&inMsg);
                     VerifyOrExit(err == WEAVE_NO_ERROR, WeaveLogDetail(BDX, "DispatchReceiveAccept failed."));
                     xferMode = inMsg.mTransferMode;
@@ -1394,7 +2175,15 @@ WEAVE_ERROR HandleResponseNotAccepted(BDXTransfer &aXfer, uint32_t aProfileId, u
 
                         case kMode_ReceiverDrive:
                             WeaveLogDetail(BDX, "Receive accepted: am driving, so sending first query");
-                            VerifyOrExit(aXfer.mVersion < 2, err = WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+                            VerifyOrExit(aXfer.mVersion <= 2, err = WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+                            if (aXfer.mVersion == 2)
+                            {
+                                aXfer.mNext = SendBlockQueryV2;
+                                break;
+                            }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
 
 #if WEAVE_CONFIG_BDX_V0_SUPPORT
                             aXfer.mNext = aXfer.mVersion == 1 ? SendBlockQueryV1 : SendBlockQuery;
@@ -66,6 +66,24 @@ WEAVE_ERROR SendNextBlock(BDXTransfer &aXfer);
 
 WEAVE_ERROR SendNextBlockV1(BDXTransfer &aXfer);
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+WEAVE_ERROR SendBlockQueryV2(BDXTransfer &aXfer);
+
+WEAVE_ERROR SendWindowV2(BDXTransfer &aXfer);
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
+WEAVE_ERROR ScheduleBlockSend(BDXTransfer &aXfer, WEAVE_ERROR (*aSend)(BDXTransfer &));
+
+// Flow control of a transfer by its application
+
+void PauseTransfer(BDXTransfer &aXfer);
+
+WEAVE_ERROR ResumeTransfer(BDXTransfer &aXfer);
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+WEAVE_ERROR PutBlockComplete(BDXTransfer &aXfer, WEAVE_ERROR aError);
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
 // The following handlers are stateless callbacks meant to be passed to the
 // ExchangeContext in order to handle incoming BDX messages.
 // They handle the actual BDX protocol interaction and defer to the previously
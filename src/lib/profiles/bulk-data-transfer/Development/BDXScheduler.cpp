@@ -0,0 +1,372 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the BDX transfer scheduler.
+ */
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXScheduler.h>
+
+#if WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesignation_Development) {
+
+BDXTransfer *BdxScheduler::sQueueHead[WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES];
+BDXTransfer *BdxScheduler::sQueueTail[WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES];
+System::Layer *BdxScheduler::sSystemLayer = NULL;
+uint32_t BdxScheduler::sAggregateRate = 0;
+int32_t BdxScheduler::sAggregateTokens = 0;
+uint64_t BdxScheduler::sAggregateTokensTime = 0;
+bool BdxScheduler::sIsRunning = false;
+
+/**
+ * @brief
+ *      Sets the rate limit shared by all of the sending transfers.
+ *
+ * @param[in]   aBytesPerSec    The limit in bytes per second, or 0 to lift it
+ */
+void BdxScheduler::SetAggregateRateLimit(uint32_t aBytesPerSec)
+{
+    sAggregateRate = aBytesPerSec;
+    sAggregateTokensTime = 0;
+
+    // Sends may be waiting on the previous limit.
+    Run();
+}
+
+/**
+ * @brief
+ *      Returns the rate limit shared by all of the sending transfers, in
+ *      bytes per second, or 0 if there is none.
+ */
+uint32_t BdxScheduler::GetAggregateRateLimit(void)
+{
+    return sAggregateRate;
+}
+
+/**
+ * @brief
+ *      Runs a block send of a transfer as soon as its priority class and rate
+ *      limits allow.
+ *
+ * If the transfer already has a send waiting, that send is replaced, as the
+ * latest BlockQuery or BlockAck supersedes the earlier ones.
+ *
+ * @param[in]   aXfer       The transfer making the send
+ * @param[in]   aAction     The protocol function that makes the send
+ *
+ * @return  The error returned by aAction, if it was run immediately, or
+ *          WEAVE_NO_ERROR.  Errors from a deferred send are dispatched to the
+ *          transfer's error handler.
+ */
+WEAVE_ERROR BdxScheduler::Schedule(BDXTransfer &aXfer, Action aAction)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t priority;
+
+    // With no limit to apply, the send runs right away.
+    if (aXfer.mRateLimit == 0 && sAggregateRate == 0 && aXfer.mScheduledAction == NULL)
+    {
+        ExitNow(err = aAction(aXfer));
+    }
+
+    if (aXfer.mExchangeContext != NULL)
+    {
+        sSystemLayer = aXfer.mExchangeContext->ExchangeMgr->MessageLayer->SystemLayer;
+    }
+
+    if (aXfer.mScheduledAction == NULL)
+    {
+        priority = (aXfer.mPriority < WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES) ? aXfer.mPriority : kPriority_Low;
+
+        aXfer.mNextScheduled = NULL;
+
+        if (sQueueTail[priority] != NULL)
+        {
+            sQueueTail[priority]->mNextScheduled = &aXfer;
+        }
+        else
+        {
+            sQueueHead[priority] = &aXfer;
+        }
+
+        sQueueTail[priority] = &aXfer;
+    }
+
+    aXfer.mScheduledAction = aAction;
+
+    Run();
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *      Drops the waiting block send of a transfer, if any.  Called when the
+ *      transfer is shut down.
+ */
+void BdxScheduler::Cancel(BDXTransfer &aXfer)
+{
+    VerifyOrExit(aXfer.mScheduledAction != NULL, );
+
+    for (int priority = 0; priority < WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES; priority++)
+    {
+        BDXTransfer *prev = NULL;
+
+        for (BDXTransfer *xfer = sQueueHead[priority]; xfer != NULL; prev = xfer, xfer = xfer->mNextScheduled)
+        {
+            if (xfer == &aXfer)
+            {
+                Dequeue(priority, prev, aXfer);
+                ExitNow();
+            }
+        }
+    }
+
+exit:
+    aXfer.mScheduledAction = NULL;
+    aXfer.mNextScheduled = NULL;
+}
+
+/*
+ * Removes a transfer from the queue of a priority class, given the transfer
+ * ahead of it.
+ */
+void BdxScheduler::Dequeue(uint8_t aPriority, BDXTransfer *aPrev, BDXTransfer &aXfer)
+{
+    if (aPrev != NULL)
+    {
+        aPrev->mNextScheduled = aXfer.mNextScheduled;
+    }
+    else
+    {
+        sQueueHead[aPriority] = aXfer.mNextScheduled;
+    }
+
+    if (sQueueTail[aPriority] == &aXfer)
+    {
+        sQueueTail[aPriority] = aPrev;
+    }
+
+    aXfer.mNextScheduled = NULL;
+}
+
+/*
+ * Runs every waiting send whose limits allow it, highest priority class
+ * first, then arms a timer for when the next waiting send will be allowed.
+ */
+void BdxScheduler::Run(void)
+{
+    WEAVE_ERROR err;
+    uint32_t waitMs = UINT32_MAX;
+    bool isPending = false;
+
+    // A send that fails may lead the application to shut down transfers;
+    // the loop below picks up any change to the queues.
+    VerifyOrExit(!sIsRunning, );
+    sIsRunning = true;
+
+    while (true)
+    {
+        uint64_t now = System::Layer::GetClock_MonotonicMS();
+        BDXTransfer *xfer = NULL;
+        BDXTransfer *prev = NULL;
+        uint8_t priority;
+        uint32_t cost;
+        Action action;
+
+        waitMs = UINT32_MAX;
+
+        if (sAggregateRate != 0)
+        {
+            Refill(sAggregateTokens, sAggregateTokensTime, sAggregateRate, Capacity(sAggregateRate, 0), now);
+
+            if (sAggregateTokens <= 0)
+            {
+                waitMs = TimeUntilTokens(sAggregateTokens, sAggregateRate);
+                break;
+            }
+        }
+
+        // Find the first transfer, in priority order, that its own limit allows to send.
+        for (priority = 0; priority < WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES && xfer == NULL; priority++)
+        {
+            for (prev = NULL, xfer = sQueueHead[priority]; xfer != NULL; prev = xfer, xfer = xfer->mNextScheduled)
+            {
+                if (xfer->mRateLimit == 0)
+                {
+                    break;
+                }
+
+                Refill(xfer->mTokens, xfer->mTokensTime, xfer->mRateLimit, Capacity(xfer->mRateLimit, Cost(*xfer)), now);
+
+                if (xfer->mTokens > 0)
+                {
+                    break;
+                }
+
+                waitMs = min(waitMs, TimeUntilTokens(xfer->mTokens, xfer->mRateLimit));
+            }
+        }
+
+        if (xfer == NULL)
+        {
+            break;
+        }
+
+        // The search above stepped past the class of the transfer found.
+        Dequeue(priority - 1, prev, *xfer);
+
+        cost = Cost(*xfer);
+
+        if (xfer->mRateLimit != 0)
+        {
+            xfer->mTokens -= cost;
+        }
+
+        if (sAggregateRate != 0)
+        {
+            sAggregateTokens -= cost;
+        }
+
+        action = xfer->mScheduledAction;
+        xfer->mScheduledAction = NULL;
+
+        err = action(*xfer);
+        if (err != WEAVE_NO_ERROR)
+        {
+            xfer->DispatchErrorHandler(err);
+        }
+    }
+
+    sIsRunning = false;
+
+    for (int i = 0; i < WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES; i++)
+    {
+        isPending = isPending || (sQueueHead[i] != NULL);
+    }
+
+    if (isPending && waitMs != UINT32_MAX && sSystemLayer != NULL)
+    {
+        err = sSystemLayer->StartTimer(waitMs, HandleTimer, NULL);
+        if (err != WEAVE_NO_ERROR)
+        {
+            WeaveLogError(BDX, "BdxScheduler failed to start timer: %s", ErrorStr(err));
+        }
+    }
+
+exit:
+    return;
+}
+
+void BdxScheduler::HandleTimer(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    Run();
+}
+
+/*
+ * Adds the tokens earned at aRate since aTokensTime, up to aCapacity.  A
+ * bucket that has never been used starts full.
+ */
+void BdxScheduler::Refill(int32_t &aTokens, uint64_t &aTokensTime, uint32_t aRate, int32_t aCapacity, uint64_t aNow)
+{
+    uint64_t added;
+
+    if (aTokensTime == 0 || aNow < aTokensTime)
+    {
+        aTokens = aCapacity;
+        aTokensTime = aNow;
+        ExitNow();
+    }
+
+    added = (aNow - aTokensTime) * aRate / 1000;
+
+    if (static_cast<int64_t>(aTokens) + static_cast<int64_t>(min<uint64_t>(added, INT32_MAX)) >= aCapacity)
+    {
+        aTokens = aCapacity;
+        aTokensTime = aNow;
+    }
+    else if (added > 0)
+    {
+        // Only advance the time by what the tokens added account for, so
+        // that low rates aren't rounded away.
+        aTokens += static_cast<int32_t>(added);
+        aTokensTime += added * 1000 / aRate;
+    }
+
+exit:
+    return;
+}
+
+/*
+ * Returns the time, in milliseconds, until a bucket holding aTokens (at most
+ * 0) will hold a positive number of tokens.
+ */
+uint32_t BdxScheduler::TimeUntilTokens(int32_t aTokens, uint32_t aRate)
+{
+    uint64_t needed = static_cast<uint64_t>(1 - static_cast<int64_t>(aTokens));
+
+    return static_cast<uint32_t>(min<uint64_t>((needed * 1000 + aRate - 1) / aRate, UINT32_MAX));
+}
+
+/*
+ * Returns the size of the bucket for aRate: WEAVE_CONFIG_BDX_SCHEDULER_BURST_MSEC
+ * worth of bytes, but at least aCost.
+ */
+int32_t BdxScheduler::Capacity(uint32_t aRate, uint32_t aCost)
+{
+    uint64_t capacity = static_cast<uint64_t>(aRate) * WEAVE_CONFIG_BDX_SCHEDULER_BURST_MSEC / 1000;
+
+    capacity = max<uint64_t>(capacity, max<uint32_t>(aCost, 1));
+
+    return static_cast<int32_t>(min<uint64_t>(capacity, INT32_MAX));
+}
+
+/*
+ * Returns the number of bytes a single send of the transfer is charged: one
+ * block, or a window of blocks in version 2.
+ */
+uint32_t BdxScheduler::Cost(const BDXTransfer &aXfer)
+{
+    uint32_t cost = aXfer.mMaxBlockSize;
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    if (aXfer.mVersion == 2)
+    {
+        cost *= aXfer.mWindowSize;
+    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
+    return cost;
+}
+
+} // namespace BulkDataTransfer
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
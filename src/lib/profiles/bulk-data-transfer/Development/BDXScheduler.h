@@ -0,0 +1,104 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file declares the BDX transfer scheduler, which paces the block
+ *      sends of concurrent BDX transfers.
+ */
+
+#ifndef _WEAVE_BDX_SCHEDULER_H
+#define _WEAVE_BDX_SCHEDULER_H
+
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXManagedNamespace.hpp>
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXTransferState.h>
+
+#if WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesignation_Development) {
+
+/**
+ * @class BdxScheduler
+ *
+ * @brief
+ *      Decides when the block sends of the sending BDX transfers in this
+ *      process may go out.
+ *
+ * Each block send (a BlockSend, or a window of blocks in version 2) that the
+ * protocol is about to make in response to a BlockQuery or BlockAck is handed
+ * to the scheduler, which runs it once both the transfer's own rate limit
+ * (BDXTransfer::mRateLimit) and the aggregate rate limit allow it.  Waiting
+ * transfers are served in strict order of their priority class
+ * (BDXTransfer::mPriority), and round-robin within a class: a transfer leaves
+ * its class once its send has run, and joins the back of it again with its
+ * next send.
+ *
+ * Rate limits are token buckets in bytes per second, charged the maximum
+ * size of the blocks sent.  When no limit applies to a transfer, its sends
+ * run immediately, exactly as without the scheduler.
+ *
+ * The application sets BDXTransfer::mPriority and BDXTransfer::mRateLimit
+ * when it accepts or initiates a transfer.
+ */
+class NL_DLL_EXPORT BdxScheduler
+{
+public:
+    enum
+    {
+        kPriority_High      = 0,
+        kPriority_Default   = (WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES - 1) / 2,
+        kPriority_Low       = WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES - 1
+    };
+
+    typedef WEAVE_ERROR (*Action)(BDXTransfer &aXfer);
+
+    static void SetAggregateRateLimit(uint32_t aBytesPerSec);
+    static uint32_t GetAggregateRateLimit(void);
+
+    static WEAVE_ERROR Schedule(BDXTransfer &aXfer, Action aAction);
+    static void Cancel(BDXTransfer &aXfer);
+
+private:
+    static void Dequeue(uint8_t aPriority, BDXTransfer *aPrev, BDXTransfer &aXfer);
+    static void Run(void);
+    static void HandleTimer(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+    static void Refill(int32_t &aTokens, uint64_t &aTokensTime, uint32_t aRate, int32_t aCapacity, uint64_t aNow);
+    static uint32_t TimeUntilTokens(int32_t aTokens, uint32_t aRate);
+    static int32_t Capacity(uint32_t aRate, uint32_t aCost);
+    static uint32_t Cost(const BDXTransfer &aXfer);
+
+    static BDXTransfer *sQueueHead[WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES];
+    static BDXTransfer *sQueueTail[WEAVE_CONFIG_BDX_SCHEDULER_NUM_PRIORITIES];
+    static System::Layer *sSystemLayer;
+    static uint32_t sAggregateRate;
+    static int32_t sAggregateTokens;
+    static uint64_t sAggregateTokensTime;
+    static bool sIsRunning;
+};
+
+} // namespace BulkDataTransfer
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+
+#endif // _WEAVE_BDX_SCHEDULER_H
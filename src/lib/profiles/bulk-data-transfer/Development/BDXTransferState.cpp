@@ -25,6 +25,7 @@
 #include <Weave/Support/logging/WeaveLogging.h>
 
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXTransferState.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BDXScheduler.h>
 
 namespace nl {
 namespace Weave {
@@ -65,6 +66,18 @@ void BDXTransfer::Shutdown(void)
         }
     }
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    ReleaseWindow();
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
+#if WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+    BdxScheduler::Cancel(*this);
+#endif // WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+    ReleasePendingBlocks();
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
     Reset();
 }
 
@@ -86,6 +99,38 @@ void BDXTransfer::Reset(void)
     mIsWideRange                    = false;
     mIsCompletedSuccessfully        = false;
     mAmInitiator                    = false;
+    mIsPaused                       = false;
+    mPausedNext                     = NULL;
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    mWindowSize                     = WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE;
+    mLastBlockKnown                 = false;
+    mLastBlockCounter               = 0;
+    mWindowEnd                      = 0;
+    mWindowMask                     = 0;
+    mRetransmitMask                 = 0;
+
+    for (int i = 0; i < WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE; i++)
+    {
+        mWindowBlocks[i]            = NULL;
+    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
+#if WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+    mPriority                       = BdxScheduler::kPriority_Default;
+    mRateLimit                      = 0;
+    mTokens                         = 0;
+    mTokensTime                     = 0;
+    mScheduledAction                = NULL;
+    mNextScheduled                  = NULL;
+#endif // WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+    mPendingHead                    = 0;
+    mNumPendingBlocks               = 0;
+    mIsWritingBlock                 = false;
+    mLastBlockPending               = false;
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
 
     mHandlers.mSendAcceptHandler    = NULL;
     mHandlers.mReceiveAcceptHandler = NULL;
@@ -95,7 +140,28 @@ void BDXTransfer::Reset(void)
     mHandlers.mXferErrorHandler     = NULL;
     mHandlers.mXferDoneHandler      = NULL;
     mHandlers.mErrorHandler         = NULL;
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+    mHandlers.mAsyncPutBlockHandler = NULL;
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+}
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+/**
+ * @brief
+ *      Frees the blocks held in the window of a version 2 transfer.
+ */
+void BDXTransfer::ReleaseWindow(void)
+{
+    for (int i = 0; i < WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE; i++)
+    {
+        if (mWindowBlocks[i] != NULL)
+        {
+            PacketBuffer::Free(mWindowBlocks[i]);
+            mWindowBlocks[i] = NULL;
+        }
+    }
 }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
 
 /**
  * @brief
@@ -155,6 +221,39 @@ uint16_t BDXTransfer::GetDefaultFlags(bool aExpectResponse)
             (GetBDXAckFlag(mExchangeContext)));
 }
 
+/**
+ * @brief
+ *  This function returns whether the blocks of this transfer may span a
+ *  chain of PacketBuffers, which is the case for transfers over an IP
+ *  WeaveConnection when WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES is set.
+ *
+ * @return true iff blocks may be chained
+ */
+bool BDXTransfer::CanChainBlocks(void)
+{
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+    return (mExchangeContext != NULL && mExchangeContext->Con != NULL &&
+            mExchangeContext->Con->NetworkType == WeaveConnection::kNetworkType_IP);
+#else
+    return false;
+#endif
+}
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+/**
+ * @brief
+ *  This function returns the largest block size this transfer can receive,
+ *  which bounds the block size proposed to, or accepted from, the sender.
+ *  Chained blocks are bounded by the 16-bit length of a TCP message frame.
+ *
+ * @return The largest block size that can be received
+ */
+uint16_t BDXTransfer::GetMaxReceiveBlockSize(void)
+{
+    return CanChainBlocks() ? WEAVE_CONFIG_BDX_MAX_TCP_BLOCK_SIZE : UINT16_MAX;
+}
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
 /**
  * @brief
  *  If the receive accept handler has been set, call it.
@@ -229,6 +328,169 @@ void BDXTransfer::DispatchPutBlockHandler(uint64_t aLength,
     }
 }
 
+/**
+ * @brief
+ *  Hand a received block that may continue in the buffers chained after the
+ *  one holding its start to the put block handler, one piece per buffer.
+ *  Only the final piece is flagged as the last block.
+ *
+ * @param[in]   aBuffer             The buffer holding the start of the block
+ * @param[in]   aLength             Length of the part of the block in aBuffer
+ * @param[in]   aDataBlock          Pointer to the start of the block
+ * @param[in]   aLastBlock          True if this is the last block in the transfer
+ */
+void BDXTransfer::DispatchPutBlockHandler(PacketBuffer *aBuffer,
+                                          uint64_t aLength,
+                                          uint8_t *aDataBlock,
+                                          bool aLastBlock)
+{
+    PacketBuffer *next = aBuffer->Next();
+
+    // Skip empty trailing buffers so that the last piece carries aLastBlock.
+    while (next != NULL && next->DataLength() == 0)
+    {
+        next = next->Next();
+    }
+
+    DispatchPutBlockPiece(aBuffer, aLength, aDataBlock, aLastBlock && next == NULL);
+
+    while (next != NULL)
+    {
+        PacketBuffer *piece = next;
+
+        next = next->Next();
+        while (next != NULL && next->DataLength() == 0)
+        {
+            next = next->Next();
+        }
+
+        DispatchPutBlockPiece(piece, piece->DataLength(), piece->Start(), aLastBlock && next == NULL);
+    }
+}
+
+/**
+ * @brief
+ *  Hand a received block, held in a single buffer, to the async put block
+ *  handler if one has been set, queueing it behind the blocks still being
+ *  written, or else to the put block handler.
+ *
+ * @param[in]   aBuffer             The buffer holding the block
+ * @param[in]   aLength             Length of block
+ * @param[in]   aDataBlock          Pointer to the data block
+ * @param[in]   aLastBlock          True if this is the last block in the transfer
+ */
+void BDXTransfer::DispatchPutBlockPiece(PacketBuffer *aBuffer,
+                                        uint64_t aLength,
+                                        uint8_t *aDataBlock,
+                                        bool aLastBlock)
+{
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+    if (mHandlers.mAsyncPutBlockHandler)
+    {
+        BDXPendingBlock *block;
+
+        // The protocol holds off the peer before the queue can overflow.
+        if (mNumPendingBlocks == WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS)
+        {
+            DispatchErrorHandler(WEAVE_ERROR_NO_MEMORY);
+            return;
+        }
+
+        block = &mPendingBlocks[(mPendingHead + mNumPendingBlocks) % WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS];
+        aBuffer->AddRef();
+        block->mBuffer = aBuffer;
+        block->mData = aDataBlock;
+        block->mLength = static_cast<uint32_t>(aLength);
+        block->mLastBlock = aLastBlock;
+        mNumPendingBlocks++;
+        mLastBlockPending = mLastBlockPending || aLastBlock;
+
+        WritePendingBlocks();
+        return;
+    }
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
+    DispatchPutBlockHandler(aLength, aDataBlock, aLastBlock);
+}
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+/**
+ * @brief
+ *      Hands the pending blocks, oldest first, to the async put block
+ *      handler, until one is being written asynchronously.
+ */
+void BDXTransfer::WritePendingBlocks(void)
+{
+    while (mNumPendingBlocks > 0 && !mIsWritingBlock)
+    {
+        BDXPendingBlock &block = mPendingBlocks[mPendingHead];
+
+        mIsWritingBlock = true;
+
+        // Unless the handler shut the transfer down, a block it has written
+        // synchronously is done with.
+        if (!mHandlers.mAsyncPutBlockHandler(this, block.mLength, block.mData, block.mLastBlock) && mIsWritingBlock)
+        {
+            CompletePendingBlock();
+        }
+    }
+}
+
+/**
+ * @brief
+ *      Releases the oldest pending block, once it has been written.
+ */
+void BDXTransfer::CompletePendingBlock(void)
+{
+    PacketBuffer::Free(mPendingBlocks[mPendingHead].mBuffer);
+    mPendingBlocks[mPendingHead].mBuffer = NULL;
+
+    mPendingHead = (mPendingHead + 1) % WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS;
+    mNumPendingBlocks--;
+    mIsWritingBlock = false;
+}
+
+/**
+ * @brief
+ *      Frees the blocks that are still waiting to be written.
+ */
+void BDXTransfer::ReleasePendingBlocks(void)
+{
+    while (mNumPendingBlocks > 0)
+    {
+        CompletePendingBlock();
+    }
+}
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
+/**
+ * @brief
+ *      Returns true if the transfer must hold off the peer until more of
+ *      the received blocks have been written: when the blocks the peer may
+ *      send next would not fit in the queue of pending blocks, or when the
+ *      last block has yet to be written.
+ */
+bool BDXTransfer::IsWaitingForStorage(void)
+{
+    bool isWaiting = false;
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+    uint8_t window = 1;
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    if (mVersion >= 2)
+    {
+        window = mWindowSize;
+    }
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
+    isWaiting = mNumPendingBlocks > 0 &&
+                (mLastBlockPending || mNumPendingBlocks + window > WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS);
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
+    return isWaiting;
+}
+
 /**
  * @brief
  *  If the get block handler has been set, call it.
@@ -173,6 +173,33 @@ typedef void (*GetBlockHandler)(BDXTransfer *aXfer,
 typedef void (*PutBlockHandler)(BDXTransfer *aXfer, uint64_t aLength,
                                 uint8_t *aDataBlock, bool aLastBlock);
 
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+/**
+ * @brief
+ *  Handle the block of data pointed to by aDataBlock of length aLength,
+ *  possibly asynchronously, e.g. when it has to be written to slow storage.
+ *
+ *  When set, this handler is used instead of the PutBlockHandler.  A handler
+ *  that can't write the block right away starts writing it and returns true;
+ *  the block stays valid until the application reports the write done with
+ *  BdxProtocol::PutBlockComplete(), which must not be called from within the
+ *  handler.  Until then, the blocks received meanwhile are queued, up to
+ *  WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS of them, and handed to the handler
+ *  in order once the write completes.  The BlockQuery or BlockAck that
+ *  would bring more blocks than the queue has room for, and the BlockEOFAck
+ *  that ends the transfer, are held off until enough blocks are written.
+ *
+ * @param[in]   aXfer       The BDXTransfer associated with this ongoing transfer
+ * @param[in]   aLength     The length of data read and stored in the specified block
+ * @param[in]   aDataBlock  The actual block of data
+ * @param[in]   aLastBlock  True if this is the last block of the transfer
+ *
+ * @return  true if the block is being written asynchronously, false if it has been written.
+ */
+typedef bool (*AsyncPutBlockHandler)(BDXTransfer *aXfer, uint64_t aLength,
+                                     uint8_t *aDataBlock, bool aLastBlock);
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
 /**
  * @brief
  *  Handle TransferError messages received or sent by BDX.
@@ -237,8 +264,23 @@ struct BDXHandlers
     XferErrorHandler        mXferErrorHandler;
     XferDoneHandler         mXferDoneHandler;
     ErrorHandler            mErrorHandler;
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+    AsyncPutBlockHandler    mAsyncPutBlockHandler; // Used instead of mPutBlockHandler if set
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
 };
 
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+/** A received block waiting to be written by an AsyncPutBlockHandler.
+ */
+struct BDXPendingBlock
+{
+    PacketBuffer *      mBuffer; // Reference held on the buffer holding the block
+    uint8_t *           mData;
+    uint32_t            mLength;
+    bool                mLastBlock;
+};
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
 /** This structure contains data members representing an active BDX transfer.
  * These objects are used by the BdxProtocol to maintain protocol state.
  * They are managed by the BdxServer, which handles creating and initializing
@@ -290,6 +332,30 @@ struct BDXTransfer
      */
     uint32_t            mBlockCounter;
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    /** Window related data members, used by version 2 transfers.
+     * The window starts at mBlockCounter: when sending, that is the oldest
+     * block that has not been acknowledged; when receiving, it is the next
+     * block to hand to the application.
+     */
+    uint8_t             mWindowSize; // Blocks in flight; the proposal until accepted, then the negotiated size
+    bool                mLastBlockKnown; // true once the last block has been read (sending) or received
+    uint32_t            mLastBlockCounter; // Counter of the last block, if known
+    uint32_t            mWindowEnd; // Sending: the next new block. Receiving: the end of the last queried window
+    uint32_t            mWindowMask; // Bit n: block mBlockCounter + n was acknowledged (sending) or is held (receiving)
+    uint32_t            mRetransmitMask; // Bit n: block mBlockCounter + n was retransmitted since the window last moved
+    PacketBuffer *      mWindowBlocks[WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE]; // Held blocks, indexed by counter modulo the size
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
+#if WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+    uint8_t             mPriority; // Scheduling class of the block sends, 0 being served first
+    uint32_t            mRateLimit; // Limit on the send rate in bytes per second, 0 if unlimited
+    int32_t             mTokens; // Bytes that may be sent before waiting for mRateLimit
+    uint64_t            mTokensTime; // Time in ms up to which mTokens has been refilled, 0 if never
+    WEAVE_ERROR         (*mScheduledAction)(BDXTransfer &); // Block send waiting for the scheduler
+    BDXTransfer *       mNextScheduled; // Next transfer waiting in the same scheduling class
+#endif // WEAVE_CONFIG_BDX_SCHEDULER_SUPPORT
+
     // application-supplied handlers
     //TODO: make these private when BdxProtocol doesn't inspect them directly
     //before calling DispatchGetBlockHandler().  We'll have to remove that check
@@ -298,10 +364,33 @@ struct BDXTransfer
 
     WEAVE_ERROR (*mNext)(BDXTransfer &); // Next action to take after the processing of the response
 
+    bool                mIsPaused; // true while BdxProtocol::PauseTransfer() holds back the next action
+    WEAVE_ERROR         (*mPausedNext)(BDXTransfer &); // Next action held back while paused
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+    BDXPendingBlock     mPendingBlocks[WEAVE_CONFIG_BDX_MAX_PENDING_BLOCKS]; // Received blocks not yet written, a ring from mPendingHead
+    uint8_t             mPendingHead; // Index of the oldest pending block
+    uint8_t             mNumPendingBlocks;
+    bool                mIsWritingBlock; // true while the AsyncPutBlockHandler writes the oldest pending block
+    bool                mLastBlockPending; // true once the last block is among the pending blocks
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
     void Shutdown(void);
 
     void Reset(void);
 
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    void ReleaseWindow(void);
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
+#if WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+    void ReleasePendingBlocks(void);
+    void WritePendingBlocks(void);
+    void CompletePendingBlock(void);
+#endif // WEAVE_CONFIG_BDX_ASYNC_PUT_BLOCK_SUPPORT
+
+    bool IsWaitingForStorage(void);
+
     bool IsAsync(void);
 
     bool IsDriver(void);
@@ -310,6 +399,12 @@ struct BDXTransfer
 
     uint16_t GetDefaultFlags(bool aExpectResponse);
 
+    bool CanChainBlocks(void);
+
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    uint16_t GetMaxReceiveBlockSize(void);
+#endif // WEAVE_CONFIG_BDX_VERSION >= 2
+
     /**
      * Dispatchers simply check whether a handler has been set and then call it if so.
      * Therefore, these should be used as the public interface for calling callbacks,
@@ -324,6 +419,14 @@ struct BDXTransfer
     void DispatchPutBlockHandler(uint64_t aLength,
                                  uint8_t *aDataBlock,
                                  bool aLastBlock);
+    void DispatchPutBlockHandler(PacketBuffer *aBuffer,
+                                 uint64_t aLength,
+                                 uint8_t *aDataBlock,
+                                 bool aLastBlock);
+    void DispatchPutBlockPiece(PacketBuffer *aBuffer,
+                               uint64_t aLength,
+                               uint8_t *aDataBlock,
+                               bool aLastBlock);
     void DispatchGetBlockHandler(uint64_t *aLength,
                                  uint8_t **aDataBlock,
                                  bool *aLastBlock);
@@ -255,6 +255,8 @@ exit:
  */
 WEAVE_ERROR Command::SendInProgress(void)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // Drop the Send if the Command was OneWay.
@@ -302,6 +304,8 @@ exit:
  */
 WEAVE_ERROR Command::SendResponse(uint32_t traitInstanceVersion, nl::Weave::System::PacketBuffer * respBuf)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     const uint8_t * appRespData;
     uint16_t appRespDataLen;
@@ -209,6 +209,8 @@ void CommandSender::Close(bool aAbortNow)
 
 WEAVE_ERROR CommandSender::SendCommand(nl::Weave::PacketBuffer *aPayload, nl::Weave::Binding *aBinding, ResourceIdentifier &aResourceId, uint32_t aProfileId, uint32_t aCommandType)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     SendParams sendParams;
 
     memset(&sendParams, 0, sizeof(sendParams));
@@ -234,6 +236,8 @@ WEAVE_ERROR CommandSender::SendCommand(nl::Weave::PacketBuffer *aPayload, nl::We
  */
 WEAVE_ERROR CommandSender::SendCommand(PacketBuffer *aRequestBuf, Binding *aBinding, SendParams &aSendParams)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     Binding *binding = aBinding ? aBinding : mBinding;
     const uint8_t *appReqData;
@@ -401,6 +405,144 @@ exit:
     return err;
 }
 
+/**
+ * Initializes the pool.
+ *
+ * @param[in] aBinding          Binding all the commands are sent over. Should be initialized already.
+ * @param[in] aSenders          The CommandSender objects making up the pool; the pool initializes them,
+ *                              and they must outlive it.
+ * @param[in] aNumSenders       The number of CommandSender objects in aSenders, which is also the maximum
+ *                              number of commands awaiting a response at any time.
+ *
+ * @retval WEAVE_ERROR          WEAVE_ERROR_INVALID_ARGUMENT if any of the arguments is NULL or 0;
+ *                              otherwise, any error from CommandSender::Init.
+ */
+WEAVE_ERROR CommandSenderPool::Init(Binding *aBinding, CommandSender *aSenders, size_t aNumSenders)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(aBinding != NULL && aSenders != NULL && aNumSenders > 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    for (size_t i = 0; i < aNumSenders; i++)
+    {
+        err = aSenders[i].Init(NULL, NULL, NULL);
+        SuccessOrExit(err);
+    }
+
+    mBinding = aBinding;
+    mBinding->AddRef();
+
+    mSenders = aSenders;
+    mNumSenders = aNumSenders;
+    mNextSender = 0;
+
+exit:
+    WeaveLogFunctError(err);
+
+    return err;
+}
+
+/**
+ * Sends a command over the pool's Binding using the first CommandSender that is not awaiting a response.
+ * The CommandSenders are tried round-robin.
+ *
+ * @param[in] aPayload          Buffer containing arguments, as for CommandSender::SendCommand. Can be NULL if
+ *                              there are no arguments. It is freed in case of error.
+ * @param[in] aSendParams       Arguments to the command header.
+ * @param[in] aEventCallback    Callback receiving the events of this command. If NULL, the events are
+ *                              dropped through CommandSender::DefaultEventHandler.
+ * @param[in] aAppState         App context passed to aEventCallback.
+ * @param[in] aTraitState       Optional SynchronizedTraitState to be filled in for this command.
+ *
+ * @retval WEAVE_ERROR          WEAVE_ERROR_INCORRECT_STATE if the pool is not initialized;
+ *                              WEAVE_ERROR_NO_MEMORY if all the CommandSenders are awaiting a response;
+ *                              otherwise, any error from CommandSender::SendCommand.
+ */
+WEAVE_ERROR CommandSenderPool::SendCommand(PacketBuffer *aPayload, CommandSender::SendParams &aSendParams,
+                                           const CommandSender::EventCallback aEventCallback, void * const aAppState,
+                                           CommandSender::SynchronizedTraitState *aTraitState)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    CommandSender *sender = NULL;
+
+    VerifyOrExit(mBinding != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    for (size_t i = 0; i < mNumSenders; i++)
+    {
+        CommandSender &candidate = mSenders[(mNextSender + i) % mNumSenders];
+
+        if (!IsCommandInFlight(candidate))
+        {
+            sender = &candidate;
+            break;
+        }
+    }
+
+    VerifyOrExit(sender != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    mNextSender = (static_cast<size_t>(sender - mSenders) + 1) % mNumSenders;
+
+    sender->mEventCallback = aEventCallback ? aEventCallback : CommandSender::DefaultEventHandler;
+    sender->mAppState = aAppState;
+    sender->mSyncronizedTraitState = aTraitState;
+
+    err = sender->SendCommand(aPayload, mBinding, aSendParams);
+    aPayload = NULL;
+
+exit:
+    if (aPayload != NULL)
+    {
+        PacketBuffer::Free(aPayload);
+    }
+
+    WeaveLogFunctError(err);
+
+    return err;
+}
+
+/**
+ * @return The number of commands sent through the pool that are still awaiting a response.
+ */
+size_t CommandSenderPool::GetNumCommandsInFlight(void) const
+{
+    size_t numInFlight = 0;
+
+    for (size_t i = 0; i < mNumSenders; i++)
+    {
+        if (IsCommandInFlight(mSenders[i]))
+        {
+            numInFlight++;
+        }
+    }
+
+    return numInFlight;
+}
+
+/**
+ * Closes the exchanges of all the commands in flight, without delivering any event, and releases the Binding.
+ *
+ * @param[in] aAbortNow         Abort the exchanges instead of closing them.
+ */
+void CommandSenderPool::Close(bool aAbortNow)
+{
+    for (size_t i = 0; i < mNumSenders; i++)
+    {
+        mSenders[i].Close(aAbortNow);
+    }
+
+    if (mBinding)
+    {
+        mBinding->Release();
+        mBinding = NULL;
+    }
+}
+
+bool CommandSenderPool::IsCommandInFlight(const CommandSender &aSender)
+{
+    // One-way commands keep their exchange only to report send errors; they don't wait for anything.
+    return (aSender.mEC != NULL) && !(aSender.mFlags & kCommandFlag_IsOneWay);
+}
+
 void CommandSender::DefaultEventHandler(void *aAppState, EventType aEvent, const InEventParam& aInParam, OutEventParam& aOutParam)
 {
     // No actions required for current implementation
@@ -208,6 +208,8 @@ private:
     nl::Weave::PacketBuffer *mPacketBuf = NULL;
     nl::Weave::ExchangeContext *mEC = NULL;
     uint8_t mFlags = 0;
+
+    friend class CommandSenderPool;
 };
 
 /**
@@ -266,6 +268,39 @@ private:
     friend class TestTdm;
 };
 
+/**
+ *  @class CommandSenderPool
+ *
+ *  @note A CommandSender has a single exchange, so the commands sent through it are serialized behind
+ *        each other's response. This class multiplexes commands over a set of CommandSender objects
+ *        provided by the application, all sending over the same Binding, so that as many commands as
+ *        there are CommandSenders can be awaiting a response at the same time.
+ *
+ *        Each command gets its own EventCallback and app state, which receive the events for that
+ *        command only; the response timeout can be set per command through
+ *        SendParams::ResponseTimeoutMsOverride. A CommandSender goes back to the pool once the
+ *        command is complete (response, status report, or communication error); one-way commands
+ *        don't hold one past SendCommand().
+ */
+class CommandSenderPool
+{
+public:
+    WEAVE_ERROR Init(nl::Weave::Binding *aBinding, CommandSender *aSenders, size_t aNumSenders);
+    WEAVE_ERROR SendCommand(nl::Weave::PacketBuffer *aPayload, CommandSender::SendParams &aSendParams,
+                            const CommandSender::EventCallback aEventCallback, void * const aAppState,
+                            CommandSender::SynchronizedTraitState *aTraitState = NULL);
+    size_t GetNumCommandsInFlight(void) const;
+    void Close(bool aAbortNow = false);
+
+private:
+    static bool IsCommandInFlight(const CommandSender &aSender);
+
+    nl::Weave::Binding *mBinding = NULL;
+    CommandSender *mSenders = NULL;
+    size_t mNumSenders = 0;
+    size_t mNextSender = 0;
+};
+
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 }; // namespace Profiles
 }; // namespace Weave
@@ -82,6 +82,16 @@ event_id_t LogEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter
     return logManager.LogEvent(inSchema, inEventWriter, inAppData, inOptions);
 }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+WEAVE_ERROR LogEventStaged(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                           const EventOptions * inOptions)
+{
+    LoggingManagement & logManager = LoggingManagement::GetInstance();
+
+    return logManager.LogEventStaged(inSchema, inEventWriter, inAppData, inOptions);
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+
 struct DebugLogContext
 {
     const char * mRegion;
@@ -209,6 +209,34 @@ event_id_t LogEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter
  */
 event_id_t LogEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData, const EventOptions * inOptions);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+/**
+ * @brief
+ *   Log an event via a callback, without blocking on the logging lock.
+ *
+ * The event data is serialized immediately into a staging slot, and
+ * the Weave thread later appends the event to the event log and
+ * assigns its event ID.  This is meant for application threads that
+ * log at a high rate; see LoggingManagement::LogEventStaged() for the
+ * constraints on the event data.
+ *
+ * @param[in] inSchema     Schema defining importance, profile ID, and
+ *                         structure type of this event.
+ *
+ * @param[in] inEventWriter The callback to invoke to actually
+ *                         serialize the event data
+ *
+ * @param[in] inAppData    Application context for the callback.
+ *
+ * @param[in] inOptions    The options for the event metadata. May be NULL.
+ *
+ * @retval #WEAVE_NO_ERROR On success.
+ * @retval other           The event could not be staged.
+ */
+WEAVE_ERROR LogEventStaged(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                           const EventOptions * inOptions);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+
 /**
  * @brief
  *   LogFreeform emits a freeform string to the default event stream.
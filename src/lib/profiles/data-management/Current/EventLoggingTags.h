@@ -146,6 +146,9 @@ enum
 
     kTag_EventDeltaSystemTime    = 31, ///< WDM internal tag, time difference from the previous event in the encoding
 
+    kTag_EventSchemaRef          = 32, ///< WDM internal tag, index of the schema dictionary entry holding the trait profile ID,
+                                       ///<  resource ID, trait instance ID and event type of the event
+
     kTag_EventData               = 50, ///< Optional.  Event data itself.  If empty, it defaults to an empty structure.
 
     kTag_ExternalEventStructure  = 99, ///< Internal tag for external events.  Never transmitted across the wire, should never be used outside of Weave library
@@ -209,7 +212,9 @@ enum
     kTag_PersistEvent_LastEventId                   = 6,
     kTag_PersistEvent_FirstEventTimestamp           = 7,
     kTag_PersistEvent_LastEventTimestamp            = 8,
-    kTag_PersistEvent_EventIdCounter                = 9
+    kTag_PersistEvent_EventIdCounter                = 9,
+    kTag_PersistEvent_DataSchemaVersion             = 13,
+    kTag_PersistEvent_MinCompatibleDataSchemaVersion = 14
 
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     ,
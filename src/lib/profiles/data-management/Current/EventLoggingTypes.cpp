@@ -80,7 +80,7 @@ EventLoadOutContext::EventLoadOutContext(nl::Weave::TLV::TLVWriter & inWriter, I
                                          uint32_t inStartingEventID, ExternalEvents * ioExternalEvents) :
     mWriter(inWriter),
     mImportance(inImportance), mStartingEventID(inStartingEventID), mCurrentTime(0), mCurrentEventID(0),
-    mExternalEvents(ioExternalEvents),
+    mExternalEvents(ioExternalEvents), mCursor(NULL),
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     mCurrentUTCTime(0), mFirstUtc(true),
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
@@ -139,6 +139,7 @@ typedef uint64_t utc_timestamp_t;
 // forward declaration
 
 struct ExternalEvents;
+struct EventFetchCursor;
 
 // Structures used to describe in detail additional options for event encoding
 
@@ -243,6 +244,7 @@ struct EventLoadOutContext
     uint32_t mCurrentTime;
     uint32_t mCurrentEventID;
     ExternalEvents *mExternalEvents;
+    EventFetchCursor *mCursor;
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     uint64_t mCurrentUTCTime;
     bool mFirstUtc;
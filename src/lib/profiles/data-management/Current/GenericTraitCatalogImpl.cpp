@@ -17,7 +17,6 @@
  */
 
 #if WEAVE_CONFIG_DATA_MANAGEMENT_CLIENT_EXPERIMENTAL
-#include <map>
 #include <limits>
 #include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
 #include <Weave/Profiles/data-management/Current/GenericTraitCatalogImpl.h>
@@ -27,8 +27,8 @@
 #ifndef _WEAVE_DATA_MANAGEMENT_GENERIC_TRAIT_CATALOG_IMPL_CURRENT_H
 #define _WEAVE_DATA_MANAGEMENT_GENERIC_TRAIT_CATALOG_IMPL_CURRENT_H
 
-#include <map>
 #include <queue>
+#include <vector>
 #include <limits>
 #include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
 #include <Weave/Profiles/data-management/TraitCatalog.h>
@@ -41,7 +41,9 @@ namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNames
  *  @class GenericTraitCatalogImpl
  *
  *  @brief A Weave provided implementation of the TraitCatalogBase interface for a collection of trait data instances
- *         that all refer to the same resource. It provides a c++ map-backed storage for these instances.
+ *         that all refer to the same resource. It provides a flat, vector-backed storage for these instances:
+ *         items are stored densely by TraitDataHandle and a secondary index of handles sorted by
+ *         (profile id, instance id, resource id) serves address lookups with a binary search.
  */
 template <typename T>
 class GenericTraitCatalogImpl : public TraitCatalogBase<T>
@@ -94,9 +96,16 @@ private:
     };
 
     TraitDataHandle GetNextHandle();
+    const CatalogItem * GetItem(TraitDataHandle aHandle) const;
+    size_t LowerBound(uint32_t aProfileId, uint64_t aInstanceId, const ResourceIdentifier & aResourceId) const;
+    static int CompareAddress(const CatalogItem & aItem, uint32_t aProfileId, uint64_t aInstanceId,
+                              const ResourceIdentifier & aResourceId);
 
     uint64_t mNodeId;
-    std::map<TraitDataHandle, CatalogItem *> mItemStore;
+    // Indexed by TraitDataHandle; a slot with a NULL mItem is free.
+    std::vector<CatalogItem> mItemStore;
+    // Handles of all in-use items, sorted by (profile id, instance id, resource id).
+    std::vector<TraitDataHandle> mAddressIndex;
     std::queue<TraitDataHandle> mRecycledHandles;
 };
 
@@ -19,8 +19,8 @@
 #ifndef GENERIC_TRAIT_CATALOG_IMPL_IPP
 #define GENERIC_TRAIT_CATALOG_IMPL_IPP
 
-#include <map>
 #include <queue>
+#include <vector>
 #include <limits>
 #include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
 #include <Weave/Profiles/data-management/TraitCatalog.h>
@@ -52,37 +52,38 @@ template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::Add(const ResourceIdentifier & aResourceId, const uint64_t & aInstanceId,
                                             PropertyPathHandle basePathHandle, T * traitInstance, TraitDataHandle & aHandle)
 {
-    WEAVE_ERROR err    = WEAVE_NO_ERROR;
-    CatalogItem * item = NULL;
-    TraitDataHandle handle;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    CatalogItem item;
+    size_t position;
 
     // Make sure there is space
-    VerifyOrExit(mItemStore.size() < std::numeric_limits<TraitDataHandle>::max(), err = WEAVE_ERROR_NO_MEMORY);
-
-    // Create the CatalogItem
-    item = new CatalogItem();
-    VerifyOrExit(item != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    VerifyOrExit(mAddressIndex.size() < std::numeric_limits<TraitDataHandle>::max(), err = WEAVE_ERROR_NO_MEMORY);
 
-    item->mProfileId      = traitInstance->GetSchemaEngine()->GetProfileId();
-    item->mInstanceId     = aInstanceId;
-    item->mResourceId     = aResourceId;
-    item->mItem           = traitInstance;
-    item->mBasePathHandle = basePathHandle;
+    item.mProfileId      = traitInstance->GetSchemaEngine()->GetProfileId();
+    item.mInstanceId     = aInstanceId;
+    item.mResourceId     = aResourceId;
+    item.mItem           = traitInstance;
+    item.mBasePathHandle = basePathHandle;
 
     // Stop if this path already exists
-    err = Locate(item->mProfileId, item->mInstanceId, item->mResourceId, handle);
-    VerifyOrExit(err != WEAVE_NO_ERROR, err = WEAVE_ERROR_DUPLICATE_KEY_ID);
-    err                 = WEAVE_NO_ERROR;
-    // Store the item
-    aHandle             = GetNextHandle();
-    mItemStore[aHandle] = item;
+    position = LowerBound(item.mProfileId, item.mInstanceId, item.mResourceId);
+    VerifyOrExit(position == mAddressIndex.size() ||
+                     CompareAddress(mItemStore[mAddressIndex[position]], item.mProfileId, item.mInstanceId, item.mResourceId) != 0,
+                 err = WEAVE_ERROR_DUPLICATE_KEY_ID);
 
-exit:
-    if (err != WEAVE_NO_ERROR && item != NULL)
+    // Store the item
+    aHandle = GetNextHandle();
+    if (aHandle == mItemStore.size())
+    {
+        mItemStore.push_back(item);
+    }
+    else
     {
-        delete item;
+        mItemStore[aHandle] = item;
     }
+    mAddressIndex.insert(mAddressIndex.begin() + position, aHandle);
 
+exit:
     return err;
 }
 
@@ -104,17 +105,19 @@ exit:
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::Remove(TraitDataHandle aHandle)
 {
-    WEAVE_ERROR err    = WEAVE_NO_ERROR;
-    CatalogItem * item = NULL;
+    WEAVE_ERROR err          = WEAVE_NO_ERROR;
+    const CatalogItem * item = GetItem(aHandle);
+    size_t position;
 
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // Remove the item from the address index and free its slot
+    position = LowerBound(item->mProfileId, item->mInstanceId, item->mResourceId);
+    VerifyOrDie(position < mAddressIndex.size() && mAddressIndex[position] == aHandle);
+    mAddressIndex.erase(mAddressIndex.begin() + position);
 
-    // Remove the item and delete it
-    item = itemIterator->second;
-    mItemStore.erase(itemIterator);
-    delete item;
+    mItemStore[aHandle].mItem = NULL;
     mRecycledHandles.push(aHandle);
 exit:
     return err;
@@ -133,26 +136,86 @@ TraitDataHandle GenericTraitCatalogImpl<T>::GetNextHandle(void)
         rv = mRecycledHandles.front();
         mRecycledHandles.pop();
     }
-    // assert correctness: returned handle must not be an existing key in the map
-    VerifyOrDie(mItemStore.find(rv) == mItemStore.end());
+    // assert correctness: returned handle must not refer to an item in use
+    VerifyOrDie(GetItem(rv) == NULL);
 
     return rv;
 }
 
 template <typename T>
-WEAVE_ERROR GenericTraitCatalogImpl<T>::Clear(void)
+const typename GenericTraitCatalogImpl<T>::CatalogItem * GenericTraitCatalogImpl<T>::GetItem(TraitDataHandle aHandle) const
 {
-    WEAVE_ERROR err    = WEAVE_NO_ERROR;
-    CatalogItem * item = NULL;
-    std::queue<TraitDataHandle> empty;
+    const CatalogItem * item = NULL;
 
-    // Loop through the items and remove them all
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    if (aHandle < mItemStore.size() && mItemStore[aHandle].mItem != NULL)
     {
-        item = itemIterator->second;
-        delete item;
+        item = &mItemStore[aHandle];
     }
+
+    return item;
+}
+
+/**
+ * Order a catalog item relative to a (profile id, instance id, resource id) address.
+ *
+ * @return A negative value, zero or a positive value if the item sorts before, at or after the address.
+ */
+template <typename T>
+int GenericTraitCatalogImpl<T>::CompareAddress(const CatalogItem & aItem, uint32_t aProfileId, uint64_t aInstanceId,
+                                               const ResourceIdentifier & aResourceId)
+{
+    if (aItem.mProfileId != aProfileId)
+        return (aItem.mProfileId < aProfileId) ? -1 : 1;
+
+    if (aItem.mInstanceId != aInstanceId)
+        return (aItem.mInstanceId < aInstanceId) ? -1 : 1;
+
+    if (aItem.mResourceId.GetResourceType() != aResourceId.GetResourceType())
+        return (aItem.mResourceId.GetResourceType() < aResourceId.GetResourceType()) ? -1 : 1;
+
+    if (aItem.mResourceId.GetResourceId() != aResourceId.GetResourceId())
+        return (aItem.mResourceId.GetResourceId() < aResourceId.GetResourceId()) ? -1 : 1;
+
+    return 0;
+}
+
+/**
+ * Binary search the address index.
+ *
+ * @return The position of the first handle in mAddressIndex whose item does not sort before the given address.
+ */
+template <typename T>
+size_t GenericTraitCatalogImpl<T>::LowerBound(uint32_t aProfileId, uint64_t aInstanceId,
+                                              const ResourceIdentifier & aResourceId) const
+{
+    size_t low  = 0;
+    size_t high = mAddressIndex.size();
+
+    while (low < high)
+    {
+        size_t mid = low + (high - low) / 2;
+
+        if (CompareAddress(mItemStore[mAddressIndex[mid]], aProfileId, aInstanceId, aResourceId) < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+template <typename T>
+WEAVE_ERROR GenericTraitCatalogImpl<T>::Clear(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    std::queue<TraitDataHandle> empty;
+
     mItemStore.clear();
+    mAddressIndex.clear();
 
     std::swap(mRecycledHandles, empty);
 
@@ -214,15 +277,12 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::HandleToAddress(TraitDataHandle aHandle,
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     TLV::TLVType type;
-    CatalogItem * item = NULL;
+    const CatalogItem * item = GetItem(aHandle);
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     VerifyOrExit(aSchemaVersionRange.IsValid(), err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    item = itemIterator->second;
-
     err = aWriter.StartContainer(TLV::ContextTag(Path::kCsTag_InstanceLocator), TLV::kTLVType_Structure, type);
     SuccessOrExit(err);
 
@@ -278,13 +338,13 @@ exit:
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::Locate(TraitDataHandle aHandle, T ** aTraitInstance) const
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WEAVE_ERROR err          = WEAVE_NO_ERROR;
+    const CatalogItem * item = GetItem(aHandle);
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     // Return the trait instance
-    *aTraitInstance = itemIterator->second->mItem;
+    *aTraitInstance = item->mItem;
 
 exit:
     return err;
@@ -295,12 +355,11 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::Locate(T * aTraitInstance, TraitDataHand
 {
     WEAVE_ERROR err = WEAVE_ERROR_INVALID_ARGUMENT;
     // Iterate and find this trait instance
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    for (size_t i = 0; i < mItemStore.size(); i++)
     {
-        CatalogItem * item = itemIterator->second;
-        if (aTraitInstance == item->mItem)
+        if (aTraitInstance != NULL && aTraitInstance == mItemStore[i].mItem)
         {
-            aHandle = itemIterator->first;
+            aHandle = static_cast<TraitDataHandle>(i);
             err     = WEAVE_NO_ERROR;
             break;
         }
@@ -314,16 +373,14 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::Locate(uint32_t aProfileId, uint64_t aIn
                                                TraitDataHandle & aHandle) const
 {
     WEAVE_ERROR err = WEAVE_ERROR_INVALID_PROFILE_ID;
-    // Loop through the items and check if the path matches
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    // Binary search the address index for the path
+    size_t position = LowerBound(aProfileId, aInstanceId, aResourceId);
+
+    if (position < mAddressIndex.size() &&
+        CompareAddress(mItemStore[mAddressIndex[position]], aProfileId, aInstanceId, aResourceId) == 0)
     {
-        CatalogItem * item = itemIterator->second;
-        if (item->mProfileId == aProfileId && item->mResourceId == aResourceId && item->mInstanceId == aInstanceId)
-        {
-            aHandle = itemIterator->first;
-            err     = WEAVE_NO_ERROR;
-            break;
-        }
+        aHandle = mAddressIndex[position];
+        err     = WEAVE_NO_ERROR;
     }
 
     return err;
@@ -333,17 +390,13 @@ template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::Locate(uint32_t aProfileId, uint64_t aInstanceId, ResourceIdentifier aResourceId,
                                                T ** aTraitInstance) const
 {
-    WEAVE_ERROR err = WEAVE_ERROR_INVALID_PROFILE_ID;
-    // Loop through the items and check if the path matches
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    WEAVE_ERROR err;
+    TraitDataHandle handle;
+
+    err = Locate(aProfileId, aInstanceId, aResourceId, handle);
+    if (err == WEAVE_NO_ERROR)
     {
-        CatalogItem * item = itemIterator->second;
-        if (item->mProfileId == aProfileId && item->mResourceId == aResourceId && item->mInstanceId == aInstanceId)
-        {
-            *aTraitInstance = itemIterator->second->mItem;
-            err             = WEAVE_NO_ERROR;
-            break;
-        }
+        *aTraitInstance = mItemStore[handle].mItem;
     }
 
     return err;
@@ -354,10 +407,12 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::DispatchEvent(uint16_t aEvent, void * aC
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     // Send the event to all the items
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    for (size_t i = 0; i < mItemStore.size(); i++)
     {
-        CatalogItem * item = itemIterator->second;
-        item->mItem->OnEvent(aEvent, aContext);
+        if (mItemStore[i].mItem != NULL)
+        {
+            mItemStore[i].mItem->OnEvent(aEvent, aContext);
+        }
     }
 
     return err;
@@ -367,9 +422,12 @@ template <typename T>
 void GenericTraitCatalogImpl<T>::Iterate(IteratorCallback aCallback, void * aContext)
 {
     // Send the event to all the items
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    for (size_t i = 0; i < mItemStore.size(); i++)
     {
-        aCallback(itemIterator->second->mItem, itemIterator->first, aContext);
+        if (mItemStore[i].mItem != NULL)
+        {
+            aCallback(mItemStore[i].mItem, static_cast<TraitDataHandle>(i), aContext);
+        }
     }
 }
 
@@ -377,13 +435,13 @@ void GenericTraitCatalogImpl<T>::Iterate(IteratorCallback aCallback, void * aCon
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::GetInstanceId(TraitDataHandle aHandle, uint64_t & aInstanceId) const
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WEAVE_ERROR err          = WEAVE_NO_ERROR;
+    const CatalogItem * item = GetItem(aHandle);
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     // Return the trait mInstanceId
-    aInstanceId = itemIterator->second->mInstanceId;
+    aInstanceId = item->mInstanceId;
 
 exit:
     return err;
@@ -392,13 +450,13 @@ exit:
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::GetResourceId(TraitDataHandle aHandle, ResourceIdentifier & aResourceId) const
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WEAVE_ERROR err          = WEAVE_NO_ERROR;
+    const CatalogItem * item = GetItem(aHandle);
     // Make sure the handle exists
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     // Return the trait mResourceId
-    aResourceId = itemIterator->second->mResourceId;
+    aResourceId = item->mResourceId;
 
 exit:
     return err;
@@ -408,20 +466,20 @@ exit:
 template <typename T>
 uint32_t GenericTraitCatalogImpl<T>::Size(void) const
 {
-    return mItemStore.size();
+    return mAddressIndex.size();
 }
 
 template <typename T>
 WEAVE_ERROR GenericTraitCatalogImpl<T>::PrepareSubscriptionSpecificPathList(TraitPath * pathList, uint16_t pathListSize,
                                                                             TraitDataHandle aHandle)
 {
-    WEAVE_ERROR err   = WEAVE_NO_ERROR;
-    auto itemIterator = mItemStore.find(aHandle);
-    VerifyOrExit(itemIterator != mItemStore.end(), err = WEAVE_ERROR_INVALID_ARGUMENT);
+    WEAVE_ERROR err          = WEAVE_NO_ERROR;
+    const CatalogItem * item = GetItem(aHandle);
+    VerifyOrExit(item != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
     VerifyOrExit(pathListSize == 1, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    *pathList = TraitPath(aHandle, itemIterator->second->mBasePathHandle);
+    *pathList = TraitPath(aHandle, item->mBasePathHandle);
 
 exit:
     return err;
@@ -434,13 +492,15 @@ WEAVE_ERROR GenericTraitCatalogImpl<T>::PrepareSubscriptionPathList(TraitPath *
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     pathListLen     = 0;
 
-    VerifyOrExit(mItemStore.size() <= pathListSize, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+    VerifyOrExit(mAddressIndex.size() <= pathListSize, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
 
-    for (auto itemIterator = mItemStore.begin(); itemIterator != mItemStore.end(); itemIterator++)
+    for (size_t i = 0; i < mItemStore.size(); i++)
     {
-        CatalogItem * item = itemIterator->second;
-        *pathList++        = TraitPath(itemIterator->first, item->mBasePathHandle);
-        pathListLen++;
+        if (mItemStore[i].mItem != NULL)
+        {
+            *pathList++ = TraitPath(static_cast<TraitDataHandle>(i), mItemStore[i].mBasePathHandle);
+            pathListLen++;
+        }
     }
 
 exit:
@@ -106,7 +106,11 @@ void LogBDXUpload::BlockHandler(nl::Weave::Profiles::BulkDataTransfer::BDXTransf
             ThrottleIfNeeded();
         }
 
-        err = mLogger->FetchEventsSince(writer, mCurrentImportance, mCurrentEventID);
+        // Each block picks up where the previous one stopped, so
+        // the log is not scanned again for the first event of every
+        // block.  The events are copied straight into the block,
+        // which BDX hands us in the packet buffer it sends.
+        err = mLogger->FetchEventsSince(writer, mCurrentImportance, mCurrentEventID, &mCursor);
 
         // Reached the end of the current importance
         if ((err == WEAVE_END_OF_TLV) || (err == WEAVE_ERROR_TLV_UNDERRUN))
@@ -239,6 +243,7 @@ WEAVE_ERROR LogBDXUpload::StartUpload(nl::Weave::Binding * aBinding)
     mCurrentImportance = kImportanceType_First;
     mCurrentEventID    = mLastScheduledEventId[mCurrentImportance - kImportanceType_First];
     mFirstXfer         = true;
+    mCursor.Reset();
 
     // create a transfer object
     xfer = NULL;
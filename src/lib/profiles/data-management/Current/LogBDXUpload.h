@@ -77,6 +77,7 @@ private:
     nl::Weave::Profiles::BulkDataTransfer::BdxNode mBdxNode;
     ImportanceType mCurrentImportance;
     event_id_t mCurrentEventID;
+    EventFetchCursor mCursor; ///< Where the last block stopped within mCurrentImportance
     event_id_t mLastScheduledEventId[kImportanceType_Last - kImportanceType_First + 1];
     event_id_t mLastTransmittedEventId[kImportanceType_Last - kImportanceType_First + 1];
     uint32_t mUploadPosition;
@@ -33,6 +33,8 @@
 #include <Weave/Profiles/bulk-data-transfer/Development/BDXMessages.h>
 
 #include <SystemLayer/SystemTimer.h>
+#include <SystemLayer/SystemTrace.h>
+#include <Weave/Support/PerfInstrumentation.h>
 
 #if HAVE_NEW
 #include <new>
@@ -109,6 +111,19 @@ WEAVE_ERROR LoggingManagement::CopyToNextBuffer(CircularEventBuffer * inEventBuf
     err = writer.Finalize();
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    {
+        // If the event is indexed, its entry follows it into the next buffer.
+        EventIndexEntry entry;
+
+        if (inEventBuffer->RemoveIndexEntryAtHead(entry))
+        {
+            entry.mEventStart = checkpoint.QueueTail();
+            inEventBuffer->mNext->AddIndexEntry(entry);
+        }
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 exit:
     if (err != WEAVE_NO_ERROR)
     {
@@ -117,12 +132,139 @@ exit:
     return err;
 }
 
+/**
+ * @brief
+ *   Move events from the head of an event buffer to the next buffer in one step.
+ *
+ * Starting with the head event, takes the run of events that are not at their final destination in `inEventBuffer`,
+ * until the run is at least `inSpaceNeeded` bytes long or the next event would not fit in the next buffer.  The run is
+ * moved with a single copy of the underlying bytes -- events are stored the same way in every buffer -- after which
+ * the head of `inEventBuffer` is advanced past it.
+ *
+ * The caller has checked that the head event is not at its final destination and fits in the next buffer.
+ *
+ * @param[in] inEventBuffer The buffer to move events from.
+ *
+ * @param[in] inSpaceNeeded The space that needs to be freed in `inEventBuffer`.
+ */
+WEAVE_ERROR LoggingManagement::MoveEventsToNextBuffer(CircularEventBuffer * inEventBuffer, size_t inSpaceNeeded)
+{
+    WeaveCircularTLVBuffer & buffer     = inEventBuffer->mBuffer;
+    WeaveCircularTLVBuffer & nextBuffer = inEventBuffer->mNext->mBuffer;
+    uint8_t * const nextTail            = nextBuffer.QueueTail();
+    const uint8_t * src;
+    uint8_t * dst;
+    CircularTLVReader reader;
+    size_t moveLength = 0;
+    size_t remaining;
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    if ((buffer.PaddingLength() != 0) || (nextBuffer.PaddingLength() != 0))
+    {
+        // Padding is not part of any element, so the bytes of a padded
+        // buffer cannot be moved as they are.  Move the head event on
+        // its own.
+        err = CopyToNextBuffer(inEventBuffer);
+        SuccessOrExit(err);
+
+        buffer.mProcessEvictedElement = NULL;
+        err                           = buffer.EvictHead();
+        ExitNow();
+    }
+
+    reader.Init(&buffer);
+
+    while (moveLength < inSpaceNeeded)
+    {
+        TLVReader eventReader;
+        TLVType containerType;
+        EventEnvelopeContext context;
+        const bool recurse = false;
+
+        err = reader.Next();
+        if (err == WEAVE_END_OF_TLV)
+        {
+            err = WEAVE_NO_ERROR;
+            break;
+        }
+        SuccessOrExit(err);
+
+        eventReader.Init(reader);
+        err = eventReader.EnterContainer(containerType);
+        SuccessOrExit(err);
+
+        nl::Weave::TLV::Utilities::Iterate(eventReader, FetchEventParameters, &context, recurse);
+
+        // events that end their life in this buffer are left to EvictEvent
+        if (inEventBuffer->IsFinalDestinationForImportance(static_cast<ImportanceType>(context.mImportance)))
+            break;
+
+        err = reader.Skip();
+        SuccessOrExit(err);
+
+        if (reader.GetLengthRead() > nextBuffer.AvailableDataLength())
+            break;
+
+        moveLength = reader.GetLengthRead();
+    }
+
+    VerifyOrExit(moveLength > 0, err = WEAVE_ERROR_NO_MEMORY);
+
+    // Copy the bytes, wrapping around the end of either backing store
+    src       = buffer.QueueHead();
+    dst       = nextTail;
+    remaining = moveLength;
+    while (remaining > 0)
+    {
+        size_t chunk = remaining;
+
+        if (src == buffer.GetQueue() + buffer.GetQueueSize())
+            src = buffer.GetQueue();
+        if (dst == nextBuffer.GetQueue() + nextBuffer.GetQueueSize())
+            dst = nextBuffer.GetQueue();
+
+        if (chunk > static_cast<size_t>(buffer.GetQueue() + buffer.GetQueueSize() - src))
+            chunk = buffer.GetQueue() + buffer.GetQueueSize() - src;
+        if (chunk > static_cast<size_t>(nextBuffer.GetQueue() + nextBuffer.GetQueueSize() - dst))
+            chunk = nextBuffer.GetQueue() + nextBuffer.GetQueueSize() - dst;
+
+        memcpy(dst, src, chunk);
+
+        src += chunk;
+        dst += chunk;
+        remaining -= chunk;
+    }
+
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    {
+        // Index entries of the moved events follow them into the next buffer.
+        EventIndexEntry entry;
+        size_t offset;
+
+        while (inEventBuffer->RemoveIndexEntryWithin(moveLength, entry, offset))
+        {
+            entry.mEventStart = nextBuffer.GetQueue() + ((nextTail - nextBuffer.GetQueue()) + offset) % nextBuffer.GetQueueSize();
+            inEventBuffer->mNext->AddIndexEntry(entry);
+        }
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
+    nextBuffer.SetQueueLength(nextBuffer.DataLength() + moveLength);
+
+    buffer.SetQueueHead(buffer.GetQueue() + ((buffer.QueueHead() - buffer.GetQueue()) + moveLength) % buffer.GetQueueSize());
+    buffer.SetQueueLength(buffer.DataLength() - moveLength);
+
+exit:
+    return err;
+}
+
 WEAVE_ERROR LoggingManagement::EnsureSpace(size_t inRequiredSpace)
 {
     WEAVE_ERROR err                   = WEAVE_NO_ERROR;
     size_t requiredSpace              = inRequiredSpace;
     CircularEventBuffer * eventBuffer = mEventBuffer;
     WeaveCircularTLVBuffer * circularBuffer;
+    size_t shortfall;
     ReclaimEventCtx ctx;
 
     // check whether we actually need to do anything, exit if we don't
@@ -143,6 +285,15 @@ WEAVE_ERROR LoggingManagement::EnsureSpace(size_t inRequiredSpace)
             circularBuffer->mAppData               = &ctx;
             err                                    = circularBuffer->EvictHead();
 
+            if (err == WEAVE_NO_ERROR)
+            {
+                eventBuffer->mEvictionCount++;
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+                // the space of the evicted event is about to be reused
+                CommitPersistentState();
+#endif
+            }
+
             // one of two things happened: either the element was evicted,
             // or we figured out how much space we need to evict it into
             // the next buffer
@@ -152,30 +303,32 @@ WEAVE_ERROR LoggingManagement::EnsureSpace(size_t inRequiredSpace)
                 VerifyOrExit(ctx.mSpaceNeededForEvent != 0, /* no-op, return err */);
                 if (ctx.mSpaceNeededForEvent <= eventBuffer->mNext->mBuffer.AvailableDataLength())
                 {
-                    // we can copy the event outright.  copy event and
-                    // subsequently evict head s.t. evicting the head
-                    // element always succeeds.
-                    // Since we're calling CopyElement and we've checked
-                    // that there is space in the next buffer, we don't expect
-                    // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
-                    SuccessOrExit(err);
-
-                    // success; evict head unconditionally
-                    circularBuffer->mProcessEvictedElement = NULL;
-                    err                                    = circularBuffer->EvictHead();
-                    // if unconditional eviction failed, this
-                    // means that we have no way of further
-                    // clearing the buffer.  fail out and let the
-                    // caller know that we could not honor the
-                    // request
+                    // we can move the event outright, along with as
+                    // many of the events following it as are needed
+                    // to make the required space and fit in the next
+                    // buffer.  We've checked that there is space in
+                    // the next buffer for the head event, so we don't
+                    // expect this to fail.
+                    err = MoveEventsToNextBuffer(eventBuffer, requiredSpace - circularBuffer->AvailableDataLength());
+                    eventBuffer->mEvictionCount++;
+                    // if the move failed, this means that we have no
+                    // way of further clearing the buffer.  fail out
+                    // and let the caller know that we could not honor
+                    // the request
                     SuccessOrExit(err);
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+                    CommitPersistentState();
+#endif
                     continue;
                 }
                 // we cannot copy event outright. We remember the
                 // current required space in mAppData, we note the
                 // space requirements for the event in the current
                 // buffer and make that space in the next buffer.
+                // Where possible, we make space in the next buffer for
+                // all the bytes the current buffer is short of, so
+                // that the events can then be moved in one step.
+                shortfall                = requiredSpace - circularBuffer->AvailableDataLength();
                 circularBuffer->mAppData = reinterpret_cast<void *>(requiredSpace);
                 eventBuffer              = eventBuffer->mNext;
 
@@ -186,6 +339,10 @@ WEAVE_ERROR LoggingManagement::EnsureSpace(size_t inRequiredSpace)
                 VerifyOrDie(eventBuffer != NULL);
 
                 requiredSpace = ctx.mSpaceNeededForEvent;
+                if ((shortfall > requiredSpace) && (shortfall <= eventBuffer->mBuffer.GetQueueSize()))
+                {
+                    requiredSpace = shortfall;
+                }
             }
         }
         else
@@ -206,6 +363,74 @@ exit:
     return err;
 }
 
+/**
+ * @brief Helper function for writing the trait profile ID, resource and
+ *   type of an event.
+ *
+ * @param[in] aWriter       The writer, positioned within the event structure.
+ *
+ * @param[in] inSchema      Schema defining profile ID, schema versions and
+ *                          structure type of the event.
+ *
+ * @param[in] inEventSource Resource ID and trait instance ID of the event,
+ *                          or NULL.
+ *
+ */
+WEAVE_ERROR LoggingManagement::BlitEventSchema(TLVWriter & aWriter, const EventSchema & inSchema,
+                                               const DetailedRootSection * inEventSource)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    // Event Trait Profile ID
+    if (inSchema.mMinCompatibleDataSchemaVersion != 1 || inSchema.mDataSchemaVersion != 1)
+    {
+        TLV::TLVType type;
+
+        err = aWriter.StartContainer(ContextTag(kTag_EventTraitProfileID), kTLVType_Array, type);
+        SuccessOrExit(err);
+
+        err = aWriter.Put(TLV::AnonymousTag, inSchema.mProfileId);
+        SuccessOrExit(err);
+
+        if (inSchema.mDataSchemaVersion != 1)
+        {
+            err = aWriter.Put(TLV::AnonymousTag, inSchema.mDataSchemaVersion);
+            SuccessOrExit(err);
+        }
+
+        if (inSchema.mMinCompatibleDataSchemaVersion != 1)
+        {
+            err = aWriter.Put(TLV::AnonymousTag, inSchema.mMinCompatibleDataSchemaVersion);
+            SuccessOrExit(err);
+        }
+
+        err = aWriter.EndContainer(type);
+        SuccessOrExit(err);
+    }
+    else
+    {
+        err = aWriter.Put(ContextTag(kTag_EventTraitProfileID), inSchema.mProfileId);
+        SuccessOrExit(err);
+    }
+
+    // Event resource
+    if (inEventSource != NULL)
+    {
+        err = inEventSource->ResourceID.ToTLV(aWriter, ContextTag(kTag_EventResourceID));
+        SuccessOrExit(err);
+
+        err = aWriter.Put(ContextTag(kTag_EventTraitInstanceID), inEventSource->TraitInstanceID);
+        SuccessOrExit(err);
+    }
+
+    // Event Type (aka Event Message ID)
+    err = aWriter.Put(ContextTag(kTag_EventType), inSchema.mStructureType);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
 /**
  * @brief Helper function for writing event header and data according to event
  *   logging protocol.
@@ -232,6 +457,9 @@ WEAVE_ERROR LoggingManagement::BlitEvent(EventLoadOutContext * aContext, const E
     WEAVE_ERROR err      = WEAVE_NO_ERROR;
     TLVWriter checkpoint = aContext->mWriter;
     TLVType containerType;
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+    int dictionaryIndex;
+#endif
 
     VerifyOrExit(aContext->mCurrentEventID >= aContext->mStartingEventID,
                  /* no-op: don't write event, but advance current event ID */);
@@ -300,52 +528,21 @@ WEAVE_ERROR LoggingManagement::BlitEvent(EventLoadOutContext * aContext, const E
         }
     }
 
-    // Event Trait Profile ID
-    if (inSchema.mMinCompatibleDataSchemaVersion != 1 || inSchema.mDataSchemaVersion != 1)
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+    // Event trait profile ID, resource and type, by reference if they are in the schema dictionary
+    dictionaryIndex = FindSchemaDictionaryEntry(inSchema, inOptions->eventSource);
+    if (dictionaryIndex >= 0)
     {
-        TLV::TLVType type;
-
-        err = aContext->mWriter.StartContainer(ContextTag(kTag_EventTraitProfileID), kTLVType_Array, type);
-        SuccessOrExit(err);
-
-        err = aContext->mWriter.Put(TLV::AnonymousTag, inSchema.mProfileId);
-        SuccessOrExit(err);
-
-        if (inSchema.mDataSchemaVersion != 1)
-        {
-            err = aContext->mWriter.Put(TLV::AnonymousTag, inSchema.mDataSchemaVersion);
-            SuccessOrExit(err);
-        }
-
-        if (inSchema.mMinCompatibleDataSchemaVersion != 1)
-        {
-            err = aContext->mWriter.Put(TLV::AnonymousTag, inSchema.mMinCompatibleDataSchemaVersion);
-            SuccessOrExit(err);
-        }
-
-        err = aContext->mWriter.EndContainer(type);
+        err = aContext->mWriter.Put(ContextTag(kTag_EventSchemaRef), static_cast<uint8_t>(dictionaryIndex));
         SuccessOrExit(err);
     }
     else
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
     {
-        err = aContext->mWriter.Put(ContextTag(kTag_EventTraitProfileID), inSchema.mProfileId);
+        err = BlitEventSchema(aContext->mWriter, inSchema, inOptions->eventSource);
         SuccessOrExit(err);
     }
 
-    // Event resource
-    if (inOptions->eventSource != NULL)
-    {
-        err = inOptions->eventSource->ResourceID.ToTLV(aContext->mWriter, ContextTag(kTag_EventResourceID));
-        SuccessOrExit(err);
-
-        err = aContext->mWriter.Put(ContextTag(kTag_EventTraitInstanceID), inOptions->eventSource->TraitInstanceID);
-        SuccessOrExit(err);
-    }
-
-    // Event Type (aka Event Message ID)
-    err = aContext->mWriter.Put(ContextTag(kTag_EventType), inSchema.mStructureType);
-    SuccessOrExit(err);
-
     // Callback to write the EventData
     err = inEventWriter(aContext->mWriter, kTag_EventData, inAppData);
     SuccessOrExit(err);
@@ -434,6 +631,9 @@ void LoggingManagement::DestroyLoggingManagement(void)
     Platform::CriticalSectionEnter();
     sInstance.mState       = kLoggingManagementState_Shutdown;
     sInstance.mEventBuffer = NULL;
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+    sInstance.mPersistedState = NULL;
+#endif
     Platform::CriticalSectionExit();
 }
 
@@ -467,6 +667,12 @@ WEAVE_ERROR LoggingManagement::SerializeEvents(TLVWriter & writer)
         eventBuffer = eventBuffer->mNext;
     }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+    // The persisted events may refer to the schema dictionary
+    err = SerializeSchemaDictionary(writer);
+    SuccessOrExit(err);
+#endif
+
     err = writer.EndContainer(container);
     SuccessOrExit(err);
 
@@ -502,17 +708,227 @@ WEAVE_ERROR LoggingManagement::LoadEvents(TLVReader & reader)
         eventBuffer = eventBuffer->mNext;
     }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+    err = LoadSchemaDictionary(reader);
+    SuccessOrExit(err);
+#endif
+
     err = reader.VerifyEndOfContainer();
     SuccessOrExit(err);
     err = reader.ExitContainer(container);
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+    CommitPersistentState();
+#endif
+
+exit:
+    Platform::CriticalSectionExit();
+
+    return err;
+}
+
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+
+#define PERSISTED_EVENT_LOG_STATE_MAGIC 0x57454c31 // "WEL1"
+
+static uint32_t PersistedStateChecksum(const PersistedEventLogState::Copy & inCopy)
+{
+    // FNV-1a over everything following the checksum
+    const uint8_t * p   = reinterpret_cast<const uint8_t *>(&inCopy.mNumBuffers);
+    const uint8_t * end = reinterpret_cast<const uint8_t *>(&inCopy + 1);
+    uint32_t hash       = 2166136261u ^ inCopy.mSequence;
+
+    for (; p < end; p++)
+    {
+        hash = (hash ^ *p) * 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief
+ *   Keep the state of the event buffers in persistent memory, restoring the events from it if possible.
+ *
+ * Meant for event buffers placed, through the LogStorageResources, in memory that outlives the process or the system:
+ * a memory-mapped file (see MappedEventLogStorage) or retained RAM.  Call after CreateLoggingManagement(), before any
+ * events are logged.  If `inState` holds a valid state for buffers of the same sizes and importance levels, the
+ * events in the buffers are restored from it at once, with no parsing; otherwise it is initialized with the current,
+ * empty, state.
+ *
+ * From then on, the state is updated whenever the buffers change.  The updates are ordered s.t. the state always
+ * describes events that are intact in the buffers, and are written to one of two copies in turn, so that the events
+ * logged before a crash can be restored.
+ *
+ * As with LoadEvents(), external events do not survive a restart.
+ *
+ * @param[in] inState The persistent state, stored along with the event buffers.
+ *
+ * @retval #WEAVE_NO_ERROR               The state was attached.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT `inState` was NULL.
+ * @retval #WEAVE_ERROR_INCORRECT_STATE  The logging subsystem is not initialized.
+ */
+WEAVE_ERROR LoggingManagement::AttachPersistentState(PersistedEventLogState * inState)
+{
+    WEAVE_ERROR err                            = WEAVE_NO_ERROR;
+    const PersistedEventLogState::Copy * state = NULL;
+    CircularEventBuffer * eventBuffer;
+    uint32_t numBuffers = 0;
+    uint32_t i;
+
+    Platform::CriticalSectionEnter();
+
+    VerifyOrExit(inState != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(mEventBuffer != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    for (eventBuffer = mEventBuffer; eventBuffer != NULL; eventBuffer = eventBuffer->mNext)
+    {
+        numBuffers++;
+    }
+
+    // Pick the current copy of the state
+    if (inState->mMagic == PERSISTED_EVENT_LOG_STATE_MAGIC)
+    {
+        for (i = 0; i < 2; i++)
+        {
+            const PersistedEventLogState::Copy & copy = inState->mCopies[i];
+
+            if ((copy.mChecksum == PersistedStateChecksum(copy)) &&
+                ((state == NULL) || (static_cast<int32_t>(copy.mSequence - state->mSequence) > 0)))
+            {
+                state = &copy;
+            }
+        }
+    }
+
+    // Check that it describes the same buffers
+    if ((state != NULL) && (state->mNumBuffers == numBuffers))
+    {
+        for (eventBuffer = mEventBuffer, i = 0; eventBuffer != NULL; eventBuffer = eventBuffer->mNext, i++)
+        {
+            const PersistedEventBufferState & bufferState = state->mBuffers[i];
+
+            if ((bufferState.mQueueSize != eventBuffer->mBuffer.GetQueueSize()) ||
+                (bufferState.mImportance != eventBuffer->mImportance) || (bufferState.mHeadOffset >= bufferState.mQueueSize) ||
+                (bufferState.mDataLength > bufferState.mQueueSize))
+            {
+                state = NULL;
+                break;
+            }
+        }
+    }
+    else
+    {
+        state = NULL;
+    }
+
+    if (state != NULL)
+    {
+        for (eventBuffer = mEventBuffer, i = 0; eventBuffer != NULL; eventBuffer = eventBuffer->mNext, i++)
+        {
+            const PersistedEventBufferState & bufferState = state->mBuffers[i];
+
+            eventBuffer->mBuffer.SetQueueHead(eventBuffer->mBuffer.GetQueue() + bufferState.mHeadOffset);
+            eventBuffer->mBuffer.SetQueueLength(bufferState.mDataLength);
+            eventBuffer->mEvictionCount++;
+
+            eventBuffer->mFirstEventID        = bufferState.mFirstEventID;
+            eventBuffer->mLastEventID         = bufferState.mLastEventID;
+            eventBuffer->mFirstEventTimestamp = bufferState.mFirstEventTimestamp;
+            eventBuffer->mLastEventTimestamp  = bufferState.mLastEventTimestamp;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+            eventBuffer->mFirstEventUTCTimestamp = bufferState.mFirstEventUTCTimestamp;
+            eventBuffer->mLastEventUTCTimestamp  = bufferState.mLastEventUTCTimestamp;
+            eventBuffer->mUTCInitialized         = (bufferState.mUTCInitialized != 0);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+            // event IDs are implied by the position of the events, so the counter resumes exactly where it stopped
+            if (eventBuffer->mEventIdCounter == &eventBuffer->mNonPersistedCounter)
+            {
+                eventBuffer->mNonPersistedCounter.Init(bufferState.mEventIdCounter);
+            }
+            else
+            {
+                static_cast<PersistedCounter *>(eventBuffer->mEventIdCounter)->SetValue(bufferState.mEventIdCounter);
+            }
+        }
+
+        WeaveLogProgress(EventLogging, "Restored persisted event log state");
+    }
+    else
+    {
+        memset(inState, 0, sizeof(*inState));
+        inState->mMagic = PERSISTED_EVENT_LOG_STATE_MAGIC;
+    }
+
+    mPersistedState = inState;
+    CommitPersistentState();
+
 exit:
     Platform::CriticalSectionExit();
 
     return err;
 }
 
+/**
+ * @brief
+ *   Record the current state of the event buffers in the persistent state, if one is attached.
+ *
+ * Called whenever the buffers change, with the logging lock held.  Must be called after events are evicted and
+ * before their space is reused.
+ */
+void LoggingManagement::CommitPersistentState(void)
+{
+    PersistedEventLogState::Copy * current;
+    PersistedEventLogState::Copy * next;
+    PersistedEventLogState::Copy copy;
+    CircularEventBuffer * eventBuffer;
+    uint32_t i = 0;
+
+    VerifyOrExit(mPersistedState != NULL, );
+
+    current = &mPersistedState->mCopies[0];
+    next    = &mPersistedState->mCopies[1];
+    if (static_cast<int32_t>(next->mSequence - current->mSequence) > 0)
+    {
+        current = &mPersistedState->mCopies[1];
+        next    = &mPersistedState->mCopies[0];
+    }
+
+    // Build the copy in full, padding included, s.t. the checksum is well defined
+    memset(&copy, 0, sizeof(copy));
+    copy.mSequence = current->mSequence + 1;
+
+    for (eventBuffer = mEventBuffer; eventBuffer != NULL; eventBuffer = eventBuffer->mNext, i++)
+    {
+        PersistedEventBufferState & bufferState = copy.mBuffers[i];
+
+        bufferState.mQueueSize           = eventBuffer->mBuffer.GetQueueSize();
+        bufferState.mHeadOffset          = (eventBuffer->mBuffer.QueueHead() - eventBuffer->mBuffer.GetQueue()) % bufferState.mQueueSize;
+        bufferState.mDataLength          = eventBuffer->mBuffer.DataLength();
+        bufferState.mEventIdCounter      = eventBuffer->mEventIdCounter->GetValue();
+        bufferState.mFirstEventID        = eventBuffer->mFirstEventID;
+        bufferState.mLastEventID         = eventBuffer->mLastEventID;
+        bufferState.mFirstEventTimestamp = eventBuffer->mFirstEventTimestamp;
+        bufferState.mLastEventTimestamp  = eventBuffer->mLastEventTimestamp;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        bufferState.mFirstEventUTCTimestamp = eventBuffer->mFirstEventUTCTimestamp;
+        bufferState.mLastEventUTCTimestamp  = eventBuffer->mLastEventUTCTimestamp;
+        bufferState.mUTCInitialized         = eventBuffer->mUTCInitialized;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        bufferState.mImportance = static_cast<uint8_t>(eventBuffer->mImportance);
+    }
+    copy.mNumBuffers = i;
+    copy.mChecksum   = PersistedStateChecksum(copy);
+
+    memcpy(next, &copy, sizeof(copy));
+
+exit:
+    return;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+
 /**
  * @brief Set mShutdownInProgress flag to true.
  */
@@ -579,8 +995,9 @@ LoggingManagement::LoggingManagement(nl::Weave::WeaveExchangeManager * inMgr,
 
     VerifyOrDie(inNumBuffers > 0);
 
-    mThrottled   = 0;
-    mExchangeMgr = inMgr;
+    mThrottled             = 0;
+    mExchangeMgr           = inMgr;
+    mCounterWriteRequested = false;
 
     for (j = 0; j < inNumBuffers; j++)
     {
@@ -610,6 +1027,12 @@ LoggingManagement::LoggingManagement(nl::Weave::WeaveExchangeManager * inMgr,
             {
                 WeaveLogError(EventLogging, "%s PersistedCounter[%d]->Init() failed with %d", __FUNCTION__, j, err);
             }
+
+            // With a System Layer to schedule them on, counter writes are deferred out of LogEvent().
+            if ((inMgr != NULL) && (inMgr->MessageLayer != NULL) && (inMgr->MessageLayer->SystemLayer != NULL))
+            {
+                inLogStorageResources[i].mCounterStorage->SetDeferredWrites(true);
+            }
             current->mEventIdCounter = inLogStorageResources[i].mCounterStorage;
         }
         else
@@ -629,6 +1052,22 @@ LoggingManagement::LoggingManagement(nl::Weave::WeaveExchangeManager * inMgr,
     mBytesWritten        = 0;
     mUploadRequested     = false;
     mMaxImportanceBuffer = kImportanceType_Last;
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+    InitStaging();
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+    mSchemaDictionaryCount = 0;
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+    mPersistedState = NULL;
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+    InitFlushPolicy();
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
+    InitSamplingRules();
+#endif
 }
 
 /**
@@ -641,7 +1080,23 @@ LoggingManagement::LoggingManagement(nl::Weave::WeaveExchangeManager * inMgr,
 LoggingManagement::LoggingManagement(void) :
     mEventBuffer(NULL), mExchangeMgr(NULL), mState(kLoggingManagementState_Idle), mBDXUploader(NULL), mBytesWritten(0),
     mThrottled(0), mMaxImportanceBuffer(kImportanceType_Invalid), mUploadRequested(false)
-{ }
+{
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+    InitStaging();
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+    mSchemaDictionaryCount = 0;
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+    mPersistedState = NULL;
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+    InitFlushPolicy();
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
+    InitSamplingRules();
+#endif
+}
 
 /**
  * @brief
@@ -715,6 +1170,12 @@ event_id_t CircularEventBuffer::VendEventID(void)
         WeaveLogError(EventLogging, "%s Advance() for importance %d failed with %d", __FUNCTION__, mImportance, err);
     }
 
+    // Starting a new epoch leaves the reservation of the next one to be written later, off the logging path.
+    if ((mEventIdCounter != &mNonPersistedCounter) && static_cast<PersistedCounter *>(mEventIdCounter)->IsWritePending())
+    {
+        LoggingManagement::GetInstance().ScheduleEventIdCounterWrite();
+    }
+
     return retval;
 }
 
@@ -744,6 +1205,26 @@ event_id_t LoggingManagement::GetFirstEventID(ImportanceType inImportance)
     return GetImportanceBuffer(inImportance)->mFirstEventID;
 }
 
+/**
+ * @brief
+ *   Report how much of the buffer holding events of a particular importance
+ *   level is in use, to help size the event log backing stores.
+ *
+ * @param[in]  inImportance      Importance level
+ * @param[out] outInUse          The number of bytes currently occupied by events
+ * @param[out] outHighWatermark  The largest number of bytes occupied at once since the buffer was initialized
+ * @param[out] outSize           The size of the buffer, in bytes
+ */
+void LoggingManagement::GetBufferUsage(ImportanceType inImportance, size_t & outInUse, size_t & outHighWatermark,
+                                       size_t & outSize) const
+{
+    const CircularEventBuffer * buf = GetImportanceBuffer(inImportance);
+
+    outInUse         = buf->mBuffer.DataLength();
+    outHighWatermark = buf->mBuffer.GetHighWatermark();
+    outSize          = buf->mBuffer.GetQueueSize();
+}
+
 CircularEventBuffer * LoggingManagement::GetImportanceBuffer(ImportanceType inImportance) const
 {
     CircularEventBuffer * buf = mEventBuffer;
@@ -923,6 +1404,9 @@ WEAVE_ERROR LoggingManagement::RegisterEventCallbackForImportance(ImportanceType
 
     VerifyOrExit(inFetchCallback != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(inNumEvents > 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0
+    VerifyOrExit(buf->mExternalEventsCount < WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE, err = WEAVE_ERROR_NO_MEMORY);
+#endif
 
     ev.mFirstEventID = buf->VendEventID();
     ev.mLastEventID  = ev.mFirstEventID;
@@ -960,6 +1444,13 @@ exit:
     }
     else
     {
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0
+        // Making room above may only have removed registrations, so this one fits.
+        (void) buf->AddExternalEvents(ev);
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+        CommitPersistentState();
+#endif
         if (outLastEventID != NULL)
         {
             *outLastEventID = ev.mLastEventID;
@@ -1021,6 +1512,16 @@ exit:
  */
 void LoggingManagement::UnregisterEventCallbackForImportance(ImportanceType inImportance, event_id_t inEventID)
 {
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0
+    ExternalEvents ev;
+
+    Platform::CriticalSectionEnter();
+
+    // The placeholder stays in the event buffers; without a registration it no longer has callbacks.
+    (void) GetImportanceBuffer(inImportance)->RemoveExternalEvents(inEventID, ev);
+
+    Platform::CriticalSectionExit();
+#else
     ExternalEvents ev;
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     TLVReader reader;
@@ -1081,10 +1582,212 @@ void LoggingManagement::UnregisterEventCallbackForImportance(ImportanceType inIm
 
 exit:
     Platform::CriticalSectionExit();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0
 }
 
 #endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+/**
+ * @brief
+ *   Find the schema dictionary entry for an event, adding one if there is none and the dictionary is not full.
+ *
+ * @param[in] inSchema      Schema of the event.
+ *
+ * @param[in] inEventSource Resource ID and trait instance ID of the event, or NULL.
+ *
+ * @return The index of the entry, or -1 if the event has to be stored with its full metadata.
+ */
+int LoggingManagement::FindSchemaDictionaryEntry(const EventSchema & inSchema, const DetailedRootSection * inEventSource)
+{
+    int index;
+
+    for (index = 0; index < mSchemaDictionaryCount; index++)
+    {
+        const EventSchemaDictionaryEntry & entry = mSchemaDictionary[index];
+
+        if ((entry.mSchema.mProfileId == inSchema.mProfileId) && (entry.mSchema.mStructureType == inSchema.mStructureType) &&
+            (entry.mSchema.mDataSchemaVersion == inSchema.mDataSchemaVersion) &&
+            (entry.mSchema.mMinCompatibleDataSchemaVersion == inSchema.mMinCompatibleDataSchemaVersion) &&
+            (entry.mHasEventSource == (inEventSource != NULL)) &&
+            ((inEventSource == NULL) ||
+             ((entry.mEventSource.ResourceID == inEventSource->ResourceID) &&
+              (entry.mEventSource.TraitInstanceID == inEventSource->TraitInstanceID))))
+        {
+            ExitNow();
+        }
+    }
+
+    VerifyOrExit(index < WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE, index = -1);
+
+    mSchemaDictionary[index].mSchema         = inSchema;
+    mSchemaDictionary[index].mHasEventSource = (inEventSource != NULL);
+    if (inEventSource != NULL)
+    {
+        mSchemaDictionary[index].mEventSource = *inEventSource;
+    }
+    mSchemaDictionaryCount++;
+
+exit:
+    return index;
+}
+
+/**
+ * @brief
+ *   Write the metadata a kTag_EventSchemaRef element refers to.
+ *
+ * @param[in] aReader A reader positioned on the kTag_EventSchemaRef element.
+ *
+ * @param[in] aWriter The writer the expanded metadata is written to.
+ */
+WEAVE_ERROR LoggingManagement::ExpandSchemaRef(TLVReader & aReader, TLVWriter & aWriter) const
+{
+    WEAVE_ERROR err;
+    uint8_t index;
+
+    err = aReader.Get(index);
+    SuccessOrExit(err);
+
+    VerifyOrExit(index < mSchemaDictionaryCount, err = WEAVE_ERROR_INVALID_TLV_ELEMENT);
+
+    err = BlitEventSchema(aWriter, mSchemaDictionary[index].mSchema,
+                          mSchemaDictionary[index].mHasEventSource ? &mSchemaDictionary[index].mEventSource : NULL);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR LoggingManagement::SerializeSchemaDictionary(TLVWriter & aWriter) const
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TLVType arrayType;
+    TLVType entryType;
+
+    err = aWriter.StartContainer(AnonymousTag, kTLVType_Array, arrayType);
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < mSchemaDictionaryCount; i++)
+    {
+        const EventSchemaDictionaryEntry & entry = mSchemaDictionary[i];
+
+        err = aWriter.StartContainer(AnonymousTag, kTLVType_Structure, entryType);
+        SuccessOrExit(err);
+
+        err = aWriter.Put(ContextTag(kTag_EventTraitProfileID), entry.mSchema.mProfileId);
+        SuccessOrExit(err);
+
+        err = aWriter.Put(ContextTag(kTag_EventType), entry.mSchema.mStructureType);
+        SuccessOrExit(err);
+
+        err = aWriter.Put(ContextTag(kTag_PersistEvent_DataSchemaVersion), entry.mSchema.mDataSchemaVersion);
+        SuccessOrExit(err);
+
+        err = aWriter.Put(ContextTag(kTag_PersistEvent_MinCompatibleDataSchemaVersion), entry.mSchema.mMinCompatibleDataSchemaVersion);
+        SuccessOrExit(err);
+
+        if (entry.mHasEventSource)
+        {
+            err = entry.mEventSource.ResourceID.ToTLV(aWriter, ContextTag(kTag_EventResourceID));
+            SuccessOrExit(err);
+
+            err = aWriter.Put(ContextTag(kTag_EventTraitInstanceID), entry.mEventSource.TraitInstanceID);
+            SuccessOrExit(err);
+        }
+
+        err = aWriter.EndContainer(entryType);
+        SuccessOrExit(err);
+    }
+
+    err = aWriter.EndContainer(arrayType);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Load the schema dictionary persisted by SerializeSchemaDictionary().  A persisted state without a dictionary
+ *   leaves the dictionary empty.
+ */
+WEAVE_ERROR LoggingManagement::LoadSchemaDictionary(TLVReader & aReader)
+{
+    WEAVE_ERROR err;
+    TLVType arrayType;
+    TLVType entryType;
+
+    mSchemaDictionaryCount = 0;
+
+    err = aReader.Next(kTLVType_Array, AnonymousTag);
+    if (err == WEAVE_END_OF_TLV)
+    {
+        ExitNow(err = WEAVE_NO_ERROR);
+    }
+    SuccessOrExit(err);
+
+    err = aReader.EnterContainer(arrayType);
+    SuccessOrExit(err);
+
+    while ((err = aReader.Next(kTLVType_Structure, AnonymousTag)) == WEAVE_NO_ERROR)
+    {
+        VerifyOrExit(mSchemaDictionaryCount < WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+        EventSchemaDictionaryEntry & entry = mSchemaDictionary[mSchemaDictionaryCount];
+
+        entry.mHasEventSource = false;
+        entry.mEventSource    = DetailedRootSection();
+
+        err = aReader.EnterContainer(entryType);
+        SuccessOrExit(err);
+
+        while ((err = aReader.Next()) == WEAVE_NO_ERROR)
+        {
+            const uint64_t tag = aReader.GetTag();
+
+            if (tag == ContextTag(kTag_EventTraitProfileID))
+            {
+                err = aReader.Get(entry.mSchema.mProfileId);
+            }
+            else if (tag == ContextTag(kTag_EventType))
+            {
+                err = aReader.Get(entry.mSchema.mStructureType);
+            }
+            else if (tag == ContextTag(kTag_PersistEvent_DataSchemaVersion))
+            {
+                err = aReader.Get(entry.mSchema.mDataSchemaVersion);
+            }
+            else if (tag == ContextTag(kTag_PersistEvent_MinCompatibleDataSchemaVersion))
+            {
+                err = aReader.Get(entry.mSchema.mMinCompatibleDataSchemaVersion);
+            }
+            else if (tag == ContextTag(kTag_EventResourceID))
+            {
+                err = entry.mEventSource.ResourceID.FromTLV(aReader);
+            }
+            else if (tag == ContextTag(kTag_EventTraitInstanceID))
+            {
+                err                   = aReader.Get(entry.mEventSource.TraitInstanceID);
+                entry.mHasEventSource = true;
+            }
+            SuccessOrExit(err);
+        }
+        VerifyOrExit(err == WEAVE_END_OF_TLV, );
+
+        err = aReader.ExitContainer(entryType);
+        SuccessOrExit(err);
+
+        mSchemaDictionaryCount++;
+    }
+    VerifyOrExit(err == WEAVE_END_OF_TLV, );
+
+    err = aReader.ExitContainer(arrayType);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+
 // Internal API used in copying an event out of the event buffers
 
 WEAVE_ERROR LoggingManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader, size_t aDepth, void * aContext)
@@ -1118,6 +1821,12 @@ WEAVE_ERROR LoggingManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader,
         }
     }
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+    else if (aReader.GetTag() == ContextTag(kTag_EventSchemaRef))
+    {
+        err = GetInstance().ExpandSchemaRef(reader, *ctx->mWriter);
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
     else
     {
         err = ctx->mWriter->CopyElement(reader);
@@ -1184,16 +1893,26 @@ WEAVE_ERROR LoggingManagement::CopyAndAdjustDeltaTime(const TLVReader & aReader,
 event_id_t LoggingManagement::LogEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
                                        const EventOptions * inOptions)
 {
+    WEAVE_PERF_SCOPE(kSection_EventLogging);
     event_id_t event_id = 0;
 
     Platform::CriticalSectionEnter();
 
+    // Traced inside the critical section, since events may be logged from any thread.
+    SYSTEM_TRACE_BEGIN("EventLogging", "LoggingManagement::LogEvent");
+
     // Make sure we're alive.
     VerifyOrExit(mState != kLoggingManagementState_Shutdown, /* no-op */);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
+    // Drop sampled out events before spending any time encoding them.
+    VerifyOrExit(AdmitSampledEvent(inSchema), /* no-op */);
+#endif
+
     event_id = LogEventPrivate(inSchema, inEventWriter, inAppData, inOptions);
 
 exit:
+    SYSTEM_TRACE_END("EventLogging", "LoggingManagement::LogEvent");
     Platform::CriticalSectionExit();
     return event_id;
 }
@@ -1216,6 +1935,9 @@ inline event_id_t LoggingManagement::LogEventPrivate(const EventSchema & inSchem
     EventLoadOutContext ctxt =
         EventLoadOutContext(writer, inSchema.mImportance, GetImportanceBuffer(inSchema.mImportance)->mLastEventID, NULL);
     EventOptions opts = EventOptions(static_cast<timestamp_t>(System::Timer::GetCurrentEpoch()));
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    EventIndexEntry indexEntry;
+#endif
 
     // check whether the entry is to be logged or discarded silently
     VerifyOrExit(inSchema.mImportance <= GetCurrentImportance(inSchema.mProfileId), /* no-op */);
@@ -1273,6 +1995,13 @@ inline event_id_t LoggingManagement::LogEventPrivate(const EventSchema & inSchem
     ctxt.mCurrentUTCTime = GetImportanceBuffer(inSchema.mImportance)->mLastEventUTCTimestamp;
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
 
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    indexEntry.mTimeBefore = ctxt.mCurrentTime;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    indexEntry.mUTCTimeBefore = ctxt.mCurrentUTCTime;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+#endif // WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
     // Begin writing
     while (!didWriteEvent)
     {
@@ -1334,6 +2063,17 @@ exit:
     {
         event_id = GetImportanceBuffer(inSchema.mImportance)->VendEventID();
 
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+        if ((event_id % WEAVE_CONFIG_EVENT_LOGGING_INDEX_INTERVAL) == 0)
+        {
+            // The event was written at the tail of the first buffer, as it stood before the write.
+            indexEntry.mEventStart = checkpoint.QueueTail();
+            indexEntry.mEventID    = event_id;
+            indexEntry.mImportance = inSchema.mImportance;
+            mEventBuffer->AddIndexEntry(indexEntry);
+        }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
         if (opts.timestampType == kTimestampType_UTC)
         {
@@ -1357,6 +2097,10 @@ exit:
 #endif // WEAVE_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
         }
 
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+        CommitPersistentState();
+#endif
+
         ScheduleFlushIfNeeded(inOptions == NULL ? false : inOptions->urgent);
     }
 
@@ -1365,102 +2109,373 @@ exit:
 
 /**
  * @brief
- *   ThrottleLogger elevates the effective logging level to the Production level.
+ *   Schedule the pending writes of the persisted event ID counters on the Weave thread.
  *
+ * Called when vending an event ID started a new counter epoch.  The epoch was reserved ahead of time, so the write that reserves
+ * the following one can run after the current LogEvent() call returns.
  */
-void LoggingManagement::ThrottleLogger(void)
+void LoggingManagement::ScheduleEventIdCounterWrite(void)
 {
-    WeaveLogProgress(EventLogging, "LogThrottle on");
-
-    __sync_add_and_fetch(&mThrottled, 1);
+    if (__sync_bool_compare_and_swap(&mCounterWriteRequested, false, true))
+    {
+        if ((mExchangeMgr != NULL) && (mExchangeMgr->MessageLayer != NULL) && (mExchangeMgr->MessageLayer->SystemLayer != NULL))
+        {
+            mExchangeMgr->MessageLayer->SystemLayer->ScheduleWork(LoggingCounterWriteHandler, this);
+        }
+        else
+        {
+            // The counter writes synchronously once its reservation runs out.
+            mCounterWriteRequested = false;
+        }
+    }
 }
 
 /**
  * @brief
- *   UnthrottleLogger restores the effective logging level to the configured logging level.
- *
+ *   Perform the pending writes of the persisted event ID counters.  Takes the logging lock.
  */
-void LoggingManagement::UnthrottleLogger(void)
-{
-    uint32_t throttled = __sync_sub_and_fetch(&mThrottled, 1);
-
-    if (throttled == 0)
-    {
-        WeaveLogProgress(EventLogging, "LogThrottle off");
-    }
-}
-
-// internal API, used to copy events to external buffers
-WEAVE_ERROR LoggingManagement::CopyEvent(const TLVReader & aReader, TLVWriter & aWriter, EventLoadOutContext * aContext)
+void LoggingManagement::WritePendingEventIdCounters(void)
 {
-    TLVReader reader;
-    TLVType containerType;
-    CopyAndAdjustDeltaTimeContext context(&aWriter, aContext);
-    const bool recurse = false;
-    WEAVE_ERROR err    = WEAVE_NO_ERROR;
-
-    reader.Init(aReader);
-    err = reader.EnterContainer(containerType);
-    SuccessOrExit(err);
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = aWriter.StartContainer(AnonymousTag, kTLVType_Structure, containerType);
-    SuccessOrExit(err);
+    Platform::CriticalSectionEnter();
 
-    err = nl::Weave::TLV::Utilities::Iterate(reader, CopyAndAdjustDeltaTime, &context, recurse);
-    VerifyOrExit(err == WEAVE_NO_ERROR || err == WEAVE_END_OF_TLV, );
+    // Cleared first, so epochs started from here on schedule another write.
+    mCounterWriteRequested = false;
 
-    err = aWriter.EndContainer(containerType);
-    SuccessOrExit(err);
+    VerifyOrExit(mState != kLoggingManagementState_Shutdown, );
 
-    err = aWriter.Finalize();
+    for (CircularEventBuffer * buffer = mEventBuffer; buffer != NULL; buffer = buffer->mNext)
+    {
+        if (buffer->mEventIdCounter != &buffer->mNonPersistedCounter)
+        {
+            err = static_cast<PersistedCounter *>(buffer->mEventIdCounter)->WritePending();
+            if (err != WEAVE_NO_ERROR)
+            {
+                WeaveLogError(EventLogging, "%s WritePending() for importance %d failed with %d", __FUNCTION__,
+                              buffer->mImportance, err);
+            }
+        }
+    }
 
 exit:
-    return err;
+    Platform::CriticalSectionExit();
 }
 
-#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+void LoggingManagement::LoggingCounterWriteHandler(System::Layer * systemLayer, void * appState, INET_ERROR err)
+{
+    LoggingManagement * logger = static_cast<LoggingManagement *>(appState);
+    logger->WritePendingEventIdCounters();
+}
 
-WEAVE_ERROR LoggingManagement::FindExternalEvents(const TLVReader & aReader, size_t aDepth, void * aContext)
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+void LoggingManagement::InitStaging(void)
 {
-    WEAVE_ERROR err;
-    EventLoadOutContext * context = static_cast<EventLoadOutContext *>(aContext);
+    mDrainRequested    = false;
+    mStagingEnqueuePos = 0;
+    mStagingDequeuePos = 0;
 
-    err = EventIterator(aReader, aDepth, aContext);
-    if (err == WEAVE_EVENT_ID_FOUND)
-    {
-        err = WEAVE_NO_ERROR;
-    }
-    if ((err == WEAVE_END_OF_TLV) && context->mExternalEvents->IsValid())
+    for (uint32_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS; i++)
     {
-        err = WEAVE_ERROR_MAX;
+        mStagedEvents[i].mSequence = i;
     }
-    return err;
 }
 
-#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
-
 /**
- * @brief Internal iterator function used to scan and filter though event logs
+ * @brief
+ *   Stage an event for logging without taking the logging lock.
  *
- * The function is used to scan through the event log to find events matching the spec in the supplied context.
+ * The event data is encoded right away, on the calling thread, into a
+ * slot of a fixed staging ring; the timestamp is taken at the same
+ * time.  The Weave thread later moves staged events into the event
+ * buffers (see DrainStagedEvents()), which is when they are assigned
+ * their event IDs and when eviction happens.  Any number of threads
+ * may stage events concurrently: claiming a slot is a single
+ * compare-and-swap on the ring position, and the producers never
+ * wait for the Weave thread or for each other.
+ *
+ * The event data must fit in WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOT_SIZE
+ * bytes.  The event source in `inOptions`, if any, is copied.
+ *
+ * @param[in] inSchema      Schema defining importance, profile ID, and
+ *                          structure type of this event.  It must stay
+ *                          valid until the event has been drained.
+ *
+ * @param[in] inEventWriter The callback to invoke to serialize the
+ *                          event data.
+ *
+ * @param[in] inAppData     Application context for the callback.
+ *
+ * @param[in] inOptions     The options for the event metadata. May be NULL.
+ *
+ * @retval #WEAVE_NO_ERROR              The event was staged, or dropped because of its importance or sampling rule.
+ * @retval #WEAVE_ERROR_NO_MEMORY       All the staging slots are in use.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL The event data does not fit in a staging slot.
+ * @retval #WEAVE_ERROR_INCORRECT_STATE The logging subsystem is shutting down.
  */
-
-WEAVE_ERROR LoggingManagement::EventIterator(const TLVReader & aReader, size_t aDepth, void * aContext)
+WEAVE_ERROR LoggingManagement::LogEventStaged(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                                              const EventOptions * inOptions)
 {
-    WEAVE_ERROR err    = WEAVE_NO_ERROR;
-    const bool recurse = false;
-    TLVReader innerReader;
-    TLVType tlvType;
-    EventEnvelopeContext event;
-    EventLoadOutContext * loadOutContext = static_cast<EventLoadOutContext *>(aContext);
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    StagedEvent * slot;
+    TLVWriter writer;
+    uint32_t pos;
 
-#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
-    event.mExternalEvents = loadOutContext->mExternalEvents;
-    if (event.mExternalEvents != NULL)
-    {
-        event.mExternalEvents->Invalidate();
-    }
-#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    VerifyOrExit(mState != kLoggingManagementState_Shutdown, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // check whether the entry is to be logged or discarded silently
+    VerifyOrExit(inSchema.mImportance <= GetCurrentImportance(inSchema.mProfileId), /* no-op */);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
+    // Sampling happens here rather than when the slot is drained, so that
+    // sampled out events do not take up a slot.
+    VerifyOrExit(AdmitSampledEvent(inSchema), /* no-op */);
+#endif
+
+    // Claim the slot at the current enqueue position. A slot is free for position pos once its sequence number equals pos;
+    // a smaller sequence number means the Weave thread has not drained it yet, i.e. the ring is full.
+    pos = mStagingEnqueuePos;
+    while (true)
+    {
+        slot                = &mStagedEvents[pos % WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS];
+        const int32_t delta = static_cast<int32_t>(slot->mSequence - pos);
+
+        if (delta == 0)
+        {
+            if (__sync_bool_compare_and_swap(&mStagingEnqueuePos, pos, pos + 1))
+            {
+                break;
+            }
+        }
+        else if (delta < 0)
+        {
+            ExitNow(err = WEAVE_ERROR_NO_MEMORY);
+        }
+
+        pos = mStagingEnqueuePos;
+    }
+
+    slot->mSchema  = &inSchema;
+    slot->mOptions = (inOptions != NULL) ? *inOptions : EventOptions();
+
+    if (slot->mOptions.timestampType == kTimestampType_Invalid)
+    {
+        slot->mOptions.timestamp.systemTimestamp = static_cast<timestamp_t>(System::Timer::GetCurrentEpoch());
+        slot->mOptions.timestampType             = kTimestampType_System;
+    }
+
+    if (slot->mOptions.eventSource != NULL)
+    {
+        slot->mEventSource         = *slot->mOptions.eventSource;
+        slot->mOptions.eventSource = &slot->mEventSource;
+    }
+
+    writer.Init(slot->mData, sizeof(slot->mData));
+
+    err = inEventWriter(writer, kTag_EventData, inAppData);
+    if (err == WEAVE_NO_ERROR)
+    {
+        err = writer.Finalize();
+    }
+
+    if (err == WEAVE_ERROR_NO_MEMORY)
+    {
+        err = WEAVE_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (err == WEAVE_NO_ERROR)
+    {
+        slot->mDataLength = static_cast<uint16_t>(writer.GetLengthWritten());
+    }
+    else
+    {
+        // The slot is claimed and must still be handed over; the Weave thread skips it.
+        slot->mSchema = NULL;
+    }
+
+    // Publish the slot only once its contents are visible to the Weave thread.
+    __sync_synchronize();
+    slot->mSequence = pos + 1;
+
+    if (__sync_bool_compare_and_swap(&mDrainRequested, false, true))
+    {
+        if ((mExchangeMgr != NULL) && (mExchangeMgr->MessageLayer != NULL) && (mExchangeMgr->MessageLayer->SystemLayer != NULL))
+        {
+            mExchangeMgr->MessageLayer->SystemLayer->ScheduleWork(LoggingDrainHandler, this);
+        }
+        else
+        {
+            // Drained on the next fetch instead.
+            mDrainRequested = false;
+        }
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Move all the events staged by LogEventStaged() into the event buffers, in the order they were staged.
+ *
+ * This is run on the Weave thread after events have been staged, and before events are fetched, but may be called from any
+ * thread; it takes the logging lock.
+ */
+void LoggingManagement::DrainStagedEvents(void)
+{
+    Platform::CriticalSectionEnter();
+
+    // Cleared first, so events staged from here on schedule another drain.
+    mDrainRequested = false;
+    __sync_synchronize();
+
+    while (true)
+    {
+        StagedEvent * slot = &mStagedEvents[mStagingDequeuePos % WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS];
+
+        if (slot->mSequence != mStagingDequeuePos + 1)
+        {
+            break;
+        }
+
+        __sync_synchronize();
+
+        if ((mState != kLoggingManagementState_Shutdown) && (slot->mSchema != NULL))
+        {
+            LogEventPrivate(*slot->mSchema, StagedEventWriter, slot, &slot->mOptions);
+        }
+
+        // Hand the slot back to the producers for the next lap of the ring.
+        __sync_synchronize();
+        slot->mSequence = mStagingDequeuePos + WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS;
+        mStagingDequeuePos++;
+    }
+
+    Platform::CriticalSectionExit();
+}
+
+void LoggingManagement::LoggingDrainHandler(System::Layer * systemLayer, void * appState, INET_ERROR err)
+{
+    LoggingManagement * logger = static_cast<LoggingManagement *>(appState);
+    logger->DrainStagedEvents();
+}
+
+WEAVE_ERROR LoggingManagement::StagedEventWriter(TLVWriter & ioWriter, uint8_t inDataTag, void * appData)
+{
+    WEAVE_ERROR err          = WEAVE_NO_ERROR;
+    const StagedEvent * slot = static_cast<const StagedEvent *>(appData);
+    TLVReader reader;
+
+    reader.Init(slot->mData, slot->mDataLength);
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = ioWriter.CopyElement(ContextTag(inDataTag), reader);
+
+exit:
+    return err;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+
+/**
+ * @brief
+ *   ThrottleLogger elevates the effective logging level to the Production level.
+ *
+ */
+void LoggingManagement::ThrottleLogger(void)
+{
+    WeaveLogProgress(EventLogging, "LogThrottle on");
+
+    __sync_add_and_fetch(&mThrottled, 1);
+}
+
+/**
+ * @brief
+ *   UnthrottleLogger restores the effective logging level to the configured logging level.
+ *
+ */
+void LoggingManagement::UnthrottleLogger(void)
+{
+    uint32_t throttled = __sync_sub_and_fetch(&mThrottled, 1);
+
+    if (throttled == 0)
+    {
+        WeaveLogProgress(EventLogging, "LogThrottle off");
+    }
+}
+
+// internal API, used to copy events to external buffers
+WEAVE_ERROR LoggingManagement::CopyEvent(const TLVReader & aReader, TLVWriter & aWriter, EventLoadOutContext * aContext)
+{
+    TLVReader reader;
+    TLVType containerType;
+    CopyAndAdjustDeltaTimeContext context(&aWriter, aContext);
+    const bool recurse = false;
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+
+    reader.Init(aReader);
+    err = reader.EnterContainer(containerType);
+    SuccessOrExit(err);
+
+    err = aWriter.StartContainer(AnonymousTag, kTLVType_Structure, containerType);
+    SuccessOrExit(err);
+
+    err = nl::Weave::TLV::Utilities::Iterate(reader, CopyAndAdjustDeltaTime, &context, recurse);
+    VerifyOrExit(err == WEAVE_NO_ERROR || err == WEAVE_END_OF_TLV, );
+
+    err = aWriter.EndContainer(containerType);
+    SuccessOrExit(err);
+
+    err = aWriter.Finalize();
+
+exit:
+    return err;
+}
+
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+WEAVE_ERROR LoggingManagement::FindExternalEvents(const TLVReader & aReader, size_t aDepth, void * aContext)
+{
+    WEAVE_ERROR err;
+    EventLoadOutContext * context = static_cast<EventLoadOutContext *>(aContext);
+
+    err = EventIterator(aReader, aDepth, aContext);
+    if (err == WEAVE_EVENT_ID_FOUND)
+    {
+        err = WEAVE_NO_ERROR;
+    }
+    if ((err == WEAVE_END_OF_TLV) && context->mExternalEvents->IsValid())
+    {
+        err = WEAVE_ERROR_MAX;
+    }
+    return err;
+}
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+
+/**
+ * @brief Internal iterator function used to scan and filter though event logs
+ *
+ * The function is used to scan through the event log to find events matching the spec in the supplied context.
+ */
+
+WEAVE_ERROR LoggingManagement::EventIterator(const TLVReader & aReader, size_t aDepth, void * aContext)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    const bool recurse = false;
+    TLVReader innerReader;
+    TLVType tlvType;
+    EventEnvelopeContext event;
+    EventLoadOutContext * loadOutContext = static_cast<EventLoadOutContext *>(aContext);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    event.mExternalEvents = loadOutContext->mExternalEvents;
+    if (event.mExternalEvents != NULL)
+    {
+        event.mExternalEvents->Invalidate();
+    }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 
     innerReader.Init(aReader);
     err = innerReader.EnterContainer(tlvType);
@@ -1542,7 +2557,39 @@ WEAVE_ERROR LoggingManagement::CopyEventsSince(const TLVReader & aReader, size_t
         // successful copy.  In all other cases, roll back the
         // writer state back to the checkpoint, i.e., the state
         // before we began the copy operation.
-        VerifyOrExit((err == WEAVE_NO_ERROR) || (err == WEAVE_END_OF_TLV), loadOutContext->mWriter = checkpoint);
+        if ((err != WEAVE_NO_ERROR) && (err != WEAVE_END_OF_TLV))
+        {
+            loadOutContext->mWriter = checkpoint;
+
+            // The next fetch starts from this event; record where it
+            // is.  The timestamps of the previous event are only
+            // known once an event has been copied; otherwise, the
+            // cursor still holds the position the fetch started from.
+            if ((loadOutContext->mCursor != NULL) && !loadOutContext->mFirst)
+            {
+                EventFetchCursor * cursor = loadOutContext->mCursor;
+
+                cursor->mBuffer = reinterpret_cast<CircularEventBuffer *>(aReader.GetBufHandle());
+                // Events are anonymous structures, whose element head is a single control byte.
+                cursor->mEvent.mEventStart = aReader.GetReadPoint() - 1;
+                cursor->mEvent.mEventID    = loadOutContext->mCurrentEventID;
+                cursor->mEvent.mImportance = loadOutContext->mImportance;
+                cursor->mEvictionCount     = cursor->mBuffer->mEvictionCount;
+            }
+            ExitNow();
+        }
+
+        if (loadOutContext->mCursor != NULL)
+        {
+            EventFetchCursor * cursor = loadOutContext->mCursor;
+
+            // The first event copied is timestamped in full, the others relative to the previous one
+            cursor->mBuffer            = NULL;
+            cursor->mEvent.mTimeBefore = (loadOutContext->mFirst ? 0 : cursor->mEvent.mTimeBefore) + loadOutContext->mCurrentTime;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+            cursor->mEvent.mUTCTimeBefore = loadOutContext->mCurrentUTCTime;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+        }
 
         loadOutContext->mCurrentTime = 0;
         loadOutContext->mFirst       = false;
@@ -1586,6 +2633,37 @@ exit:
  *
  */
 WEAVE_ERROR LoggingManagement::FetchEventsSince(TLVWriter & ioWriter, ImportanceType inImportance, event_id_t & ioEventID)
+{
+    return FetchEventsSince(ioWriter, inImportance, ioEventID, NULL);
+}
+
+/**
+ * @brief
+ *   A function to retrieve events of specified importance since a specified event ID, resuming from a cursor.
+ *
+ * Behaves like FetchEventsSince(TLVWriter &, ImportanceType, event_id_t &), and additionally records in `ioCursor`
+ * where the fetch stopped when it runs out of space in `ioWriter`.  A subsequent call that passes the event ID and
+ * cursor returned by this one reads on from that point, rather than scanning the log for its starting event.  This
+ * keeps the cost of draining the log in blocks, e.g. in a BDX upload, proportional to the size of the log.
+ *
+ * @param[in] ioWriter     The writer to use for event storage
+ *
+ * @param[in] inImportance The importance of events to be fetched
+ *
+ * @param[inout] ioEventID On input, the ID of the event immediately
+ *                         prior to the one we're fetching.  On
+ *                         completion, the ID of the last event
+ *                         fetched.
+ *
+ * @param[inout] ioCursor  The cursor recorded by the previous fetch, or
+ *                         NULL.  A cursor that does not match
+ *                         `inImportance` and `ioEventID`, or whose
+ *                         position is no longer valid, is ignored.
+ *
+ * @return The same values as FetchEventsSince(TLVWriter &, ImportanceType, event_id_t &).
+ */
+WEAVE_ERROR LoggingManagement::FetchEventsSince(TLVWriter & ioWriter, ImportanceType inImportance, event_id_t & ioEventID,
+                                                EventFetchCursor * ioCursor)
 {
     WEAVE_ERROR err    = WEAVE_NO_ERROR;
     const bool recurse = false;
@@ -1598,6 +2676,11 @@ WEAVE_ERROR LoggingManagement::FetchEventsSince(TLVWriter & ioWriter, Importance
     EventLoadOutContext aContext(ioWriter, inImportance, ioEventID, NULL);
 #endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+    // Staged events become visible to the readers once they have been assigned their event IDs.
+    DrainStagedEvents();
+#endif
+
     CircularEventBuffer * buf = mEventBuffer;
     Platform::CriticalSectionEnter();
 
@@ -1611,14 +2694,42 @@ WEAVE_ERROR LoggingManagement::FetchEventsSince(TLVWriter & ioWriter, Importance
     aContext.mCurrentUTCTime = buf->mFirstEventUTCTimestamp;
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     aContext.mCurrentEventID = buf->mFirstEventID;
-    err                      = GetEventReader(reader, inImportance);
-    SuccessOrExit(err);
+    aContext.mCursor         = ioCursor;
+
+    if ((ioCursor != NULL) && SeekEventReader(reader, *ioCursor, aContext))
+    {
+        // resuming where the previous fetch stopped
+    }
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    else if (SeekEventReader(reader, buf, aContext))
+    {
+        // starting at the closest indexed event
+    }
+#endif
+    else
+    {
+        err = GetEventReader(reader, inImportance);
+        SuccessOrExit(err);
+    }
 
     err = nl::Weave::TLV::Utilities::Iterate(reader, CopyEventsSince, &aContext, recurse);
 
 #if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
     if ((err == WEAVE_END_OF_TLV) && (ev.IsValid()))
     {
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0
+        // The callbacks in the placeholder are only valid while the events are registered.
+        const ExternalEvents * registered = buf->LookupExternalEvents(ev.mFirstEventID);
+
+        if ((registered != NULL) && (registered->mFirstEventID == ev.mFirstEventID))
+        {
+            ev = *registered;
+        }
+        else
+        {
+            ev.mFetchEventsFunct = NULL;
+        }
+#endif
         if (ev.mFetchEventsFunct != NULL)
         {
             err = ev.mFetchEventsFunct(&aContext);
@@ -1634,10 +2745,94 @@ WEAVE_ERROR LoggingManagement::FetchEventsSince(TLVWriter & ioWriter, Importance
 exit:
     ioEventID = aContext.mCurrentEventID;
 
+    // Only a fetch that ran out of space leaves a position to resume from.
+    if ((ioCursor != NULL) && (err != WEAVE_ERROR_BUFFER_TOO_SMALL) && (err != WEAVE_ERROR_NO_MEMORY))
+    {
+        ioCursor->Reset();
+    }
+
     Platform::CriticalSectionExit();
     return err;
 }
 
+/**
+ * @brief
+ *   Position an event reader at the event recorded in a fetch cursor.
+ *
+ * The cursor is used if it holds a position for the importance and starting event ID of `ioContext`, and no events
+ * have left the buffer holding that position since it was recorded.  The current event ID and timestamps of
+ * `ioContext` are then set to what iterating up to that event would have produced.  A cursor that cannot be used is
+ * reset.
+ *
+ * @retval true  The reader was positioned using the cursor.
+ * @retval false The cursor could not be used; the reader was not touched.
+ */
+bool LoggingManagement::SeekEventReader(TLVReader & ioReader, EventFetchCursor & ioCursor, EventLoadOutContext & ioContext)
+{
+    CircularEventReader reader;
+    bool found = (ioCursor.mBuffer != NULL) && (ioCursor.mEvictionCount == ioCursor.mBuffer->mEvictionCount) &&
+        (ioCursor.mEvent.mImportance == ioContext.mImportance) && (ioCursor.mEvent.mEventID == ioContext.mStartingEventID);
+
+    VerifyOrExit(found, ioCursor.Reset());
+
+    ioContext.mCurrentEventID = ioCursor.mEvent.mEventID;
+    ioContext.mCurrentTime    = ioCursor.mEvent.mTimeBefore;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    ioContext.mCurrentUTCTime = ioCursor.mEvent.mUTCTimeBefore;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+    reader.Init(ioCursor.mBuffer, ioCursor.mEvent.mEventStart);
+    ioReader.Init(reader);
+
+exit:
+    return found;
+}
+
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+/**
+ * @brief
+ *   Position an event reader near the event a fetch starts from, using the sparse event index.
+ *
+ * Looks through the buffers a reader for the importance of `ioContext` traverses, starting at `inBuffer`, for the
+ * closest indexed event at or before the starting event ID.  If there is one, the reader is positioned on it, and the
+ * current event ID and timestamps of `ioContext` are set to what iterating up to that event would have produced.
+ *
+ * @retval true  The reader was positioned using the index.
+ * @retval false No suitable index entry; the reader was not touched.
+ */
+bool LoggingManagement::SeekEventReader(TLVReader & ioReader, CircularEventBuffer * inBuffer, EventLoadOutContext & ioContext)
+{
+    const EventIndexEntry * best      = NULL;
+    CircularEventBuffer * bestBuffer = NULL;
+    CircularEventReader reader;
+
+    for (CircularEventBuffer * buffer = inBuffer; buffer != NULL; buffer = buffer->mPrev)
+    {
+        const EventIndexEntry * entry = buffer->FindIndexEntry(ioContext.mImportance, ioContext.mStartingEventID);
+
+        if (entry != NULL && (best == NULL || entry->mEventID > best->mEventID))
+        {
+            best       = entry;
+            bestBuffer = buffer;
+        }
+    }
+
+    VerifyOrExit(best != NULL && best->mEventID > ioContext.mCurrentEventID, best = NULL);
+
+    ioContext.mCurrentEventID = best->mEventID;
+    ioContext.mCurrentTime    = best->mTimeBefore;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    ioContext.mCurrentUTCTime = best->mUTCTimeBefore;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+
+    reader.Init(bestBuffer, best->mEventStart);
+    ioReader.Init(reader);
+
+exit:
+    return (best != NULL);
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
 /**
  * @brief
  *   A helper method useful for examining the in-memory log buffers
@@ -1768,6 +2963,12 @@ WEAVE_ERROR LoggingManagement::EvictEvent(WeaveCircularTLVBuffer & inBuffer, voi
         {
             numEventsToDrop = ev.mLastEventID - ev.mFirstEventID + 1;
 
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0
+            if (!eventBuffer->RemoveExternalEvents(ev.mFirstEventID, ev))
+            {
+                ev.mNotifyEventsEvictedFunct = NULL;
+            }
+#endif
             if (ev.mNotifyEventsEvictedFunct != NULL)
             {
                 ev.mNotifyEventsEvictedFunct(&ev);
@@ -1776,6 +2977,12 @@ WEAVE_ERROR LoggingManagement::EvictEvent(WeaveCircularTLVBuffer & inBuffer, voi
 #endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 
         eventBuffer->RemoveEvent(numEventsToDrop);
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+        {
+            EventIndexEntry entry;
+            (void) eventBuffer->RemoveIndexEntryAtHead(entry);
+        }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
         eventBuffer->mFirstEventTimestamp += context.mDeltaTime;
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
         eventBuffer->mFirstEventUTCTimestamp += context.mDeltaUtc;
@@ -1827,6 +3034,10 @@ void LoggingManagement::FlushHandler(System::Layer * inSystemLayer, INET_ERROR i
             err    = mBDXUploader->StartUpload(config.GetDestNodeId(), config.GetDestNodeIPAddress());
             if (err != WEAVE_NO_ERROR)
                 WeaveLogError(EventLogging, "Failed to start BDX (err: %d)", err);
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+            else
+                NoteFlushStarted();
+#endif
         }
         else
         {
@@ -1842,6 +3053,9 @@ void LoggingManagement::FlushHandler(System::Layer * inSystemLayer, INET_ERROR i
         {
             nl::Weave::Profiles::DataManagement::SubscriptionEngine::GetInstance()->GetNotificationEngine()->Run();
             mUploadRequested = false;
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+            NoteFlushStarted();
+#endif
         }
 #endif // WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
 
@@ -1878,6 +3092,9 @@ void LoggingManagement::SignalUploadDone(void)
     const LoggingConfiguration & config = LoggingConfiguration::GetInstance();
     if (mState == kLoggingManagementState_InProgress)
     {
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+        NoteFlushAcknowledged();
+#endif
         mState = kLoggingManagementState_Holdoff;
         if (mExchangeMgr != NULL)
         {
@@ -1929,139 +3146,548 @@ WEAVE_ERROR LoggingManagement::ScheduleFlushIfNeeded(bool inRequestFlush)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+    if (mFlushPolicy != NULL)
+    {
+        inRequestFlush = CheckFlushPolicy(inRequestFlush);
+    }
+    else
+#endif // WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+    {
+#if WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
+        inRequestFlush |= CheckShouldRunBDX();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
+#if WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
+        inRequestFlush |= CheckShouldRunWDM();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
+    }
+
+    if (inRequestFlush && __sync_bool_compare_and_swap(&mUploadRequested, false, true))
+    {
+        if ((mExchangeMgr != NULL) && (mExchangeMgr->MessageLayer != NULL) && (mExchangeMgr->MessageLayer->SystemLayer != NULL))
+        {
+            mExchangeMgr->MessageLayer->SystemLayer->ScheduleWork(LoggingFlushHandler, this);
+        }
+        else
+        {
+            err              = WEAVE_ERROR_INCORRECT_STATE;
+            mUploadRequested = false;
+        }
+    }
+
+    return err;
+}
+
+#if WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
+bool LoggingManagement::CheckShouldRunBDX(void)
+{
+    const LoggingConfiguration & config = LoggingConfiguration::GetInstance();
+    return ((mBDXUploader != NULL) && ((mBytesWritten - mBDXUploader->GetUploadPosition()) > config.mUploadThreshold));
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
+
+#if WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
+/**
+ * @brief
+ *  Decide whether to offload events based on the number of bytes in event buffers unscheduled for upload.
+ *
+ * The behavior of the function is controlled via
+ * #WEAVE_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD constant.  If the system
+ * wrote more than that number of bytes since the last time a WDM
+ * Notification was sent, the function will indicate it is time to
+ * trigger the NotificationEngine.
+ *
+ * @retval true   Events should be offloaded
+ * @retval false  Otherwise
+ */
+bool LoggingManagement::CheckShouldRunWDM(void)
+{
+    WEAVE_ERROR err              = WEAVE_NO_ERROR;
+    size_t minimalBytesOffloaded = mBytesWritten;
+    bool ret                     = false;
+
+    // Get the minimal log position (in bytes) across all subscribers
+    err = nl::Weave::Profiles::DataManagement::SubscriptionEngine::GetInstance()->GetMinEventLogPosition(minimalBytesOffloaded);
+    SuccessOrExit(err);
+
+    // return true if we can offload more than the threshold bytes to a subscription
+    ret = ((minimalBytesOffloaded + WEAVE_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD) < mBytesWritten);
+
+exit:
+    return ret;
+}
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
+
+WEAVE_ERROR LoggingManagement::SetLoggingEndpoint(event_id_t * inEventEndpoints, size_t inNumImportanceLevels,
+                                                  size_t & outBytesOffloaded)
+{
+    WEAVE_ERROR err                   = WEAVE_NO_ERROR;
+    CircularEventBuffer * eventBuffer = mEventBuffer;
+
+    Platform::CriticalSectionEnter();
+
+    outBytesOffloaded = mBytesWritten;
+
+    while (eventBuffer != NULL && inNumImportanceLevels > 0)
+    {
+        if ((eventBuffer->mImportance >= kImportanceType_First) &&
+            ((static_cast<size_t>(eventBuffer->mImportance - kImportanceType_First)) < inNumImportanceLevels))
+        {
+            inEventEndpoints[eventBuffer->mImportance - kImportanceType_First] = eventBuffer->mLastEventID;
+        }
+        eventBuffer = eventBuffer->mNext;
+    }
+
+    Platform::CriticalSectionExit();
+    return err;
+}
+
+/**
+ * @brief
+ *   Get the total number of bytes written (across all event
+ *   importances) to this log since its instantiation
+ *
+ * @returns The number of bytes written to the log.
+ */
+uint32_t LoggingManagement::GetBytesWritten(void) const
+{
+    return mBytesWritten;
+}
+
+void LoggingManagement::NotifyEventsDelivered(ImportanceType inImportance, event_id_t inLastDeliveredEventID,
+                                              uint64_t inRecipientNodeID)
+{
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+    NoteFlushAcknowledged();
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    ExternalEvents ev;
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0
+    CircularEventBuffer * buf = GetImportanceBuffer(inImportance);
+    const ExternalEvents * registered;
+#else
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TLVReader reader;
+#endif
+    event_id_t currentId;
+
+    Platform::CriticalSectionEnter();
+    currentId = GetFirstEventID(inImportance);
+    while (currentId <= inLastDeliveredEventID)
+    {
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0
+        // Look the events up again on every pass, the handler may have unregistered some.
+        registered = buf->LookupExternalEvents(currentId);
+        VerifyOrExit(registered != NULL, );
+
+        ev = *registered;
+#else
+        err = GetExternalEventsFromEventId(inImportance, currentId, &ev, reader);
+        SuccessOrExit(err);
+#endif
+
+        VerifyOrExit(ev.IsValid(), );
+
+        VerifyOrExit(ev.mFirstEventID <= inLastDeliveredEventID, );
+
+        if (ev.mNotifyEventsDeliveredFunct != NULL)
+        {
+            ev.mNotifyEventsDeliveredFunct(&ev, inLastDeliveredEventID, inRecipientNodeID);
+        }
+
+        currentId = ev.mLastEventID + 1;
+    }
+
+exit:
+    Platform::CriticalSectionExit();
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+}
+
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+/**
+ * @brief
+ *   Set the policy that decides when the event log is offloaded.
+ *
+ * While a policy is set, it replaces the byte thresholds checked by ScheduleFlushIfNeeded(), including the handling of
+ * explicit flush requests.  Pass NULL to go back to the thresholds.
+ *
+ * @param[in] inPolicy   The policy, e.g. #AdaptiveFlushPolicy, or NULL.
+ * @param[in] inAppState Application state passed to the policy.
+ */
+void LoggingManagement::SetFlushPolicy(EventFlushPolicyFunct inPolicy, void * inAppState)
+{
+    Platform::CriticalSectionEnter();
+    mFlushPolicy         = inPolicy;
+    mFlushPolicyAppState = inAppState;
+    Platform::CriticalSectionExit();
+}
+
+/**
+ * @brief
+ *   Tell the flush policy whether the link to the event consumers is up.
+ *
+ * The link is assumed to be up until told otherwise.  A policy can hold back small offloads while it is down, rather
+ * than waking the radio for them.  On the Weave Device Layer, this follows the service connectivity reported by the
+ * ConnectivityManager.
+ *
+ * @param[in] inActive Whether the link is up.
+ */
+void LoggingManagement::SetOffloadLinkActive(bool inActive)
+{
+    mOffloadLinkActive = inActive;
+}
+
+/**
+ * @brief
+ *   A flush policy that adapts the size of offloads to the conditions of the device.
+ *
+ * The policy offloads:
+ *
+ * -- on explicit request,
+ *
+ * -- when, at the current fill rate, the buffers would fill up within
+ *    twice the time an offload takes to be acknowledged, or are three
+ *    quarters full with events not yet offloaded,
+ *
+ * -- when the maximum upload interval has passed since the last offload,
+ *
+ * -- otherwise, no sooner than the minimum upload interval after the
+ *    last offload, once #WEAVE_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD bytes
+ *    are pending while the link is up, or four times that, up to half
+ *    the buffers, while it is down.
+ *
+ * A device that logs in bursts thus offloads early enough not to lose
+ * events, and one whose radio sleeps sends fewer, larger batches.
+ *
+ * @param[in] inContext  The state of the event log and its consumers.
+ * @param[in] inAppState Unused.
+ *
+ * @retval true  Start an offload.
+ * @retval false Keep the events for now.
+ */
+bool LoggingManagement::AdaptiveFlushPolicy(const EventFlushContext & inContext, void * inAppState)
+{
+    const LoggingConfiguration & config = LoggingConfiguration::GetInstance();
+    uint32_t headroom;
+    uint32_t threshold = WEAVE_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD;
+    bool flush;
+
+    VerifyOrExit(!inContext.mFlushRequested, flush = true);
+    VerifyOrExit(inContext.mBytesPending > 0, flush = false);
+
+    // Offload before pending events get evicted
+    headroom = (inContext.mBytesCapacity > inContext.mBytesPending) ? (inContext.mBytesCapacity - inContext.mBytesPending) : 0;
+    VerifyOrExit(headroom > inContext.mBytesCapacity / 4, flush = true);
+    VerifyOrExit((static_cast<uint64_t>(inContext.mFillRate) * 2 * inContext.mAckLatency) / 1000 < headroom, flush = true);
+
+    VerifyOrExit(inContext.mTimeSinceFlush < config.mMaximumLogUploadInterval, flush = true);
+    VerifyOrExit(inContext.mTimeSinceFlush >= config.mMinimumLogUploadInterval, flush = false);
+
+    if (!inContext.mLinkActive)
+    {
+        threshold *= 4;
+        if (threshold > inContext.mBytesCapacity / 2)
+        {
+            threshold = inContext.mBytesCapacity / 2;
+        }
+    }
+
+    flush = (inContext.mBytesPending >= threshold);
+
+exit:
+    return flush;
+}
+
+void LoggingManagement::InitFlushPolicy(void)
+{
+    mFlushPolicy         = NULL;
+    mFlushPolicyAppState = NULL;
+    mOffloadLinkActive   = true;
+    mFlushAckPending     = false;
+    mFillRate            = 0;
+    mFillRateBytes       = 0;
+    mAckLatency          = 0;
+    mFillRateTime        = System::Timer::GetCurrentEpoch();
+    mLastFlushTime       = mFillRateTime;
+}
+
+// Gather the state of the log and run the flush policy on it
+bool LoggingManagement::CheckFlushPolicy(bool inFlushRequested)
+{
+    EventFlushContext context;
+    System::Timer::Epoch now = System::Timer::GetCurrentEpoch();
+    uint32_t bytesWritten;
+
+    context.mFlushRequested = inFlushRequested;
+    context.mLinkActive     = mOffloadLinkActive;
+    context.mBytesPending   = 0;
+    context.mBytesCapacity  = 0;
+
+    Platform::CriticalSectionEnter();
+
+    bytesWritten = mBytesWritten;
+
+    // Fold the bytes logged since the last sample into the fill rate
+    // about once a second, weighing the new sample by a quarter.
+    if (now - mFillRateTime >= 1000)
+    {
+        uint32_t rate = static_cast<uint32_t>((static_cast<uint64_t>(bytesWritten - mFillRateBytes) * 1000) / (now - mFillRateTime));
+
+        mFillRate      = mFillRate - (mFillRate / 4) + (rate / 4);
+        mFillRateBytes = bytesWritten;
+        mFillRateTime  = now;
+    }
+
+    for (CircularEventBuffer * buffer = mEventBuffer; buffer != NULL; buffer = buffer->mNext)
+    {
+        context.mBytesCapacity += buffer->mBuffer.GetQueueSize();
+    }
+
+    context.mFillRate       = mFillRate;
+    context.mAckLatency     = mAckLatency;
+    context.mTimeSinceFlush = static_cast<uint32_t>(now - mLastFlushTime);
+
+    Platform::CriticalSectionExit();
+
 #if WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
-    inRequestFlush |= CheckShouldRunBDX();
+    if (mBDXUploader != NULL)
+    {
+        context.mBytesPending = bytesWritten - mBDXUploader->GetUploadPosition();
+    }
 #endif // WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
 #if WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
-    inRequestFlush |= CheckShouldRunWDM();
-#endif // WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
-
-    if (inRequestFlush && __sync_bool_compare_and_swap(&mUploadRequested, false, true))
     {
-        if ((mExchangeMgr != NULL) && (mExchangeMgr->MessageLayer != NULL) && (mExchangeMgr->MessageLayer->SystemLayer != NULL))
-        {
-            mExchangeMgr->MessageLayer->SystemLayer->ScheduleWork(LoggingFlushHandler, this);
-        }
-        else
+        size_t minimalBytesOffloaded = bytesWritten;
+
+        if ((nl::Weave::Profiles::DataManagement::SubscriptionEngine::GetInstance()->GetMinEventLogPosition(minimalBytesOffloaded) ==
+             WEAVE_NO_ERROR) &&
+            (bytesWritten - minimalBytesOffloaded > context.mBytesPending))
         {
-            err              = WEAVE_ERROR_INCORRECT_STATE;
-            mUploadRequested = false;
+            context.mBytesPending = bytesWritten - minimalBytesOffloaded;
         }
     }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
 
-    return err;
+    return mFlushPolicy(context, mFlushPolicyAppState);
 }
 
-#if WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
-bool LoggingManagement::CheckShouldRunBDX(void)
+// Called on the Weave thread when an offload starts
+void LoggingManagement::NoteFlushStarted(void)
 {
-    const LoggingConfiguration & config = LoggingConfiguration::GetInstance();
-    return ((mBDXUploader != NULL) && ((mBytesWritten - mBDXUploader->GetUploadPosition()) > config.mUploadThreshold));
+    mLastFlushTime   = System::Timer::GetCurrentEpoch();
+    mFlushAckPending = true;
 }
-#endif // WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
 
-#if WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
+// Called on the Weave thread when a consumer acknowledges events; the
+// first acknowledgement after an offload starts gives a latency sample.
+void LoggingManagement::NoteFlushAcknowledged(void)
+{
+    if (mFlushAckPending)
+    {
+        uint32_t latency = static_cast<uint32_t>(System::Timer::GetCurrentEpoch() - mLastFlushTime);
+
+        mAckLatency      = (mAckLatency == 0) ? latency : (mAckLatency - (mAckLatency / 4) + (latency / 4));
+        mFlushAckPending = false;
+    }
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
 /**
  * @brief
- *  Decide whether to offload events based on the number of bytes in event buffers unscheduled for upload.
- *
- * The behavior of the function is controlled via
- * #WEAVE_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD constant.  If the system
- * wrote more than that number of bytes since the last time a WDM
- * Notification was sent, the function will indicate it is time to
- * trigger the NotificationEngine.
- *
- * @retval true   Events should be offloaded
- * @retval false  Otherwise
+ *   Sample and rate limit the events of a profile.
+ *
+ * The rule applies to the events of the profile at or below `inImportance`; more important events are always logged.
+ * Of those events, only one in every `inSampleInterval` is kept, and the kept events are limited to
+ * `inMaxEventsPerSecond` on average with bursts of up to `inBurst` events.  Rejected events are dropped before they are
+ * encoded and counted, see GetDroppedEventCount().  Setting a rule for a profile that already has one replaces it but
+ * keeps its dropped event count.
+ *
+ * @param[in] inProfileId          The profile of the events.
+ * @param[in] inImportance         The most important events the rule applies to.
+ * @param[in] inSampleInterval     Keep one in every inSampleInterval events; 0 or 1 keeps all of them.
+ * @param[in] inMaxEventsPerSecond The maximum average rate of the kept events, or 0 for no limit.
+ * @param[in] inBurst              The number of events that may be logged back to back at the maximum rate.
+ *
+ * @retval #WEAVE_NO_ERROR               The rule was set.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT The importance is invalid, or the burst lasts too long at the given rate.
+ * @retval #WEAVE_ERROR_NO_MEMORY        All WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES rules are in use.
  */
-bool LoggingManagement::CheckShouldRunWDM(void)
+WEAVE_ERROR LoggingManagement::SetEventSamplingRule(uint32_t inProfileId, ImportanceType inImportance, uint16_t inSampleInterval,
+                                                    uint16_t inMaxEventsPerSecond, uint16_t inBurst)
 {
-    WEAVE_ERROR err              = WEAVE_NO_ERROR;
-    size_t minimalBytesOffloaded = mBytesWritten;
-    bool ret                     = false;
+    WEAVE_ERROR err           = WEAVE_NO_ERROR;
+    EventSamplingRule * rule  = NULL;
+    uint32_t emissionInterval = 0;
+    uint64_t burstTolerance   = 0;
 
-    // Get the minimal log position (in bytes) across all subscribers
-    err = nl::Weave::Profiles::DataManagement::SubscriptionEngine::GetInstance()->GetMinEventLogPosition(minimalBytesOffloaded);
-    SuccessOrExit(err);
+    VerifyOrExit(inImportance >= kImportanceType_First && inImportance <= kImportanceType_Last,
+                 err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    // return true if we can offload more than the threshold bytes to a subscription
-    ret = ((minimalBytesOffloaded + WEAVE_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD) < mBytesWritten);
+    if (inMaxEventsPerSecond != 0)
+    {
+        emissionInterval = 1000000 / inMaxEventsPerSecond;
+        burstTolerance   = static_cast<uint64_t>(inBurst > 0 ? inBurst - 1 : 0) * emissionInterval;
+
+        // The times are compared as signed 32-bit microsecond offsets.
+        VerifyOrExit(burstTolerance + emissionInterval <= INT32_MAX, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    }
+
+    Platform::CriticalSectionEnter();
+
+    for (size_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES; i++)
+    {
+        if (mSamplingRules[i].mImportance != kImportanceType_Invalid && mSamplingRules[i].mProfileId == inProfileId)
+        {
+            rule = &mSamplingRules[i];
+            break;
+        }
+
+        if (rule == NULL && mSamplingRules[i].mImportance == kImportanceType_Invalid)
+        {
+            rule                = &mSamplingRules[i];
+            rule->mDroppedCount = 0;
+        }
+    }
+
+    if (rule != NULL)
+    {
+        // Clear the importance while the rule changes so that concurrent loggers skip it.
+        rule->mImportance = kImportanceType_Invalid;
+        __sync_synchronize();
+        rule->mProfileId          = inProfileId;
+        rule->mSampleInterval     = inSampleInterval;
+        rule->mEmissionInterval   = emissionInterval;
+        rule->mBurstTolerance     = static_cast<uint32_t>(burstTolerance);
+        rule->mTheoreticalArrival = static_cast<uint32_t>(System::Timer::GetCurrentEpoch() * 1000);
+        rule->mSampleCount        = 0;
+        __sync_synchronize();
+        rule->mImportance = inImportance;
+    }
+
+    Platform::CriticalSectionExit();
+
+    VerifyOrExit(rule != NULL, err = WEAVE_ERROR_NO_MEMORY);
 
 exit:
-    return ret;
+    return err;
 }
 
-#endif // WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
-
-WEAVE_ERROR LoggingManagement::SetLoggingEndpoint(event_id_t * inEventEndpoints, size_t inNumImportanceLevels,
-                                                  size_t & outBytesOffloaded)
+/**
+ * @brief
+ *   Remove the sampling rule of a profile, if any.
+ *
+ * @param[in] inProfileId The profile of the events.
+ */
+void LoggingManagement::ClearEventSamplingRule(uint32_t inProfileId)
 {
-    WEAVE_ERROR err                   = WEAVE_NO_ERROR;
-    CircularEventBuffer * eventBuffer = mEventBuffer;
-
     Platform::CriticalSectionEnter();
 
-    outBytesOffloaded = mBytesWritten;
-
-    while (eventBuffer != NULL && inNumImportanceLevels > 0)
+    for (size_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES; i++)
     {
-        if ((eventBuffer->mImportance >= kImportanceType_First) &&
-            ((static_cast<size_t>(eventBuffer->mImportance - kImportanceType_First)) < inNumImportanceLevels))
+        if (mSamplingRules[i].mImportance != kImportanceType_Invalid && mSamplingRules[i].mProfileId == inProfileId)
         {
-            inEventEndpoints[eventBuffer->mImportance - kImportanceType_First] = eventBuffer->mLastEventID;
+            mSamplingRules[i].mImportance = kImportanceType_Invalid;
         }
-        eventBuffer = eventBuffer->mNext;
     }
 
     Platform::CriticalSectionExit();
-    return err;
 }
 
 /**
  * @brief
- *   Get the total number of bytes written (across all event
- *   importances) to this log since its instantiation
+ *   Get the number of events of a profile dropped by its sampling rule.
  *
- * @returns The number of bytes written to the log.
+ * @param[in] inProfileId The profile of the events.
+ *
+ * @return The number of events dropped since the rule was first set, or 0 if the profile has no rule.
  */
-uint32_t LoggingManagement::GetBytesWritten(void) const
+uint32_t LoggingManagement::GetDroppedEventCount(uint32_t inProfileId) const
 {
-    return mBytesWritten;
+    for (size_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES; i++)
+    {
+        if (mSamplingRules[i].mImportance != kImportanceType_Invalid && mSamplingRules[i].mProfileId == inProfileId)
+        {
+            return mSamplingRules[i].mDroppedCount;
+        }
+    }
+
+    return 0;
 }
 
-void LoggingManagement::NotifyEventsDelivered(ImportanceType inImportance, event_id_t inLastDeliveredEventID,
-                                              uint64_t inRecipientNodeID)
+void LoggingManagement::InitSamplingRules(void)
 {
+    memset(mSamplingRules, 0, sizeof(mSamplingRules));
 
-#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
-    ExternalEvents ev;
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
-    TLVReader reader;
-    event_id_t currentId;
+    for (size_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES; i++)
+    {
+        mSamplingRules[i].mImportance = kImportanceType_Invalid;
+    }
+}
 
-    Platform::CriticalSectionEnter();
-    currentId = GetFirstEventID(inImportance);
-    while (currentId <= inLastDeliveredEventID)
+// Decide whether an event passes the sampling rule of its profile.  May
+// be called from any thread, so the rule is only updated atomically.
+bool LoggingManagement::AdmitSampledEvent(const EventSchema & inSchema)
+{
+    EventSamplingRule * rule = NULL;
+    uint32_t now;
+    uint32_t previous;
+    uint32_t arrival;
+
+    for (size_t i = 0; i < WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES; i++)
     {
-        err = GetExternalEventsFromEventId(inImportance, currentId, &ev, reader);
-        SuccessOrExit(err);
+        if (mSamplingRules[i].mImportance != kImportanceType_Invalid && mSamplingRules[i].mProfileId == inSchema.mProfileId)
+        {
+            rule = &mSamplingRules[i];
+            break;
+        }
+    }
 
-        VerifyOrExit(ev.IsValid(), );
+    // Events that the rule does not cover, or that are discarded by
+    // their importance anyway, are left alone.
+    VerifyOrExit(rule != NULL, /* no-op */);
+    VerifyOrExit(inSchema.mImportance >= rule->mImportance, rule = NULL);
+    VerifyOrExit(inSchema.mImportance <= GetCurrentImportance(inSchema.mProfileId), rule = NULL);
 
-        VerifyOrExit(ev.mFirstEventID <= inLastDeliveredEventID, );
+    if (rule->mSampleInterval > 1 && __sync_add_and_fetch(&rule->mSampleCount, 1) % rule->mSampleInterval != 0)
+    {
+        ExitNow();
+    }
 
-        if (ev.mNotifyEventsDeliveredFunct != NULL)
+    if (rule->mEmissionInterval != 0)
+    {
+        now = static_cast<uint32_t>(System::Timer::GetCurrentEpoch() * 1000);
+
+        do
         {
-            ev.mNotifyEventsDeliveredFunct(&ev, inLastDeliveredEventID, inRecipientNodeID);
-        }
+            previous = rule->mTheoreticalArrival;
+            arrival  = previous;
 
-        currentId = ev.mLastEventID + 1;
+            // A schedule in the past, or too far in the future to be
+            // genuine after the clock wrapped, restarts from now.
+            if (static_cast<int32_t>(arrival - now) < 0 ||
+                static_cast<int32_t>(arrival - now) > static_cast<int32_t>(rule->mBurstTolerance + rule->mEmissionInterval))
+            {
+                arrival = now;
+            }
+
+            VerifyOrExit(static_cast<int32_t>(arrival - now) <= static_cast<int32_t>(rule->mBurstTolerance), /* no-op */);
+        } while (!__sync_bool_compare_and_swap(&rule->mTheoreticalArrival, previous, arrival + rule->mEmissionInterval));
     }
 
+    rule = NULL;
+
 exit:
-    Platform::CriticalSectionExit();
-#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
+    if (rule != NULL)
+    {
+        __sync_add_and_fetch(&rule->mDroppedCount, 1);
+    }
+
+    return (rule == NULL);
 }
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
 
 #if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT
 /**
@@ -2157,9 +3783,15 @@ CircularEventBuffer::CircularEventBuffer(uint8_t * inBuffer, size_t inBufferLeng
 #if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
     mFirstEventUTCTimestamp(0), mLastEventUTCTimestamp(0), mUTCInitialized(false),
 #endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
-    mEventIdCounter(NULL)
+    mEventIdCounter(NULL), mEvictionCount(0)
 {
     // TODO: hook up the platform-specific persistent event ID.
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    ClearIndex();
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT && (WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0)
+    ClearExternalEvents();
+#endif
 }
 
 /**
@@ -2232,6 +3864,228 @@ void CircularEventBuffer::RemoveEvent(size_t aNumEvents)
  * @param[in] inBuf A pointer to a fully initialized CircularEventBuffer
  *
  */
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+void CircularEventBuffer::AddIndexEntry(const EventIndexEntry & inEntry)
+{
+    if (mIndexCount == WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE)
+    {
+        // Full; the oldest entry makes room.
+        mIndexFirst = static_cast<uint8_t>((mIndexFirst + 1) % WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE);
+        mIndexCount--;
+    }
+
+    mIndex[(mIndexFirst + mIndexCount) % WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE] = inEntry;
+    mIndexCount++;
+}
+
+/**
+ * @brief
+ *   Remove the index entry of the event at the head of the buffer, if that event is indexed.  Called before the head
+ *   event leaves the buffer.
+ *
+ * Entries are kept in the order of their events, so only the oldest entry can refer to the head event.
+ */
+bool CircularEventBuffer::RemoveIndexEntryAtHead(EventIndexEntry & outEntry)
+{
+    bool removed = false;
+
+    if ((mIndexCount > 0) && (mIndex[mIndexFirst].mEventStart == mBuffer.QueueHead()))
+    {
+        outEntry    = mIndex[mIndexFirst];
+        mIndexFirst = static_cast<uint8_t>((mIndexFirst + 1) % WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE);
+        mIndexCount--;
+        removed = true;
+    }
+
+    return removed;
+}
+
+/**
+ * @brief
+ *   Remove the oldest index entry if its event starts within the first `inLength` bytes of the buffer.  Called before
+ *   those bytes leave the buffer.
+ *
+ * @param[in]  inLength  The number of bytes, from the head of the buffer, that are leaving it.
+ * @param[out] outEntry  The removed entry.
+ * @param[out] outOffset The offset of the event of the removed entry from the head of the buffer.
+ */
+bool CircularEventBuffer::RemoveIndexEntryWithin(size_t inLength, EventIndexEntry & outEntry, size_t & outOffset)
+{
+    bool removed = false;
+
+    if (mIndexCount > 0)
+    {
+        const size_t queueSize = mBuffer.GetQueueSize();
+
+        outOffset = ((mIndex[mIndexFirst].mEventStart - mBuffer.GetQueue()) + queueSize - (mBuffer.QueueHead() - mBuffer.GetQueue())) %
+            queueSize;
+        if (outOffset < inLength)
+        {
+            outEntry    = mIndex[mIndexFirst];
+            mIndexFirst = static_cast<uint8_t>((mIndexFirst + 1) % WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE);
+            mIndexCount--;
+            removed = true;
+        }
+    }
+
+    return removed;
+}
+
+void CircularEventBuffer::ClearIndex(void)
+{
+    mIndexFirst = 0;
+    mIndexCount = 0;
+}
+
+/**
+ * @brief
+ *   Find the index entry with the highest event ID not above `inEventID` among the events of importance `inImportance`
+ *   held in this buffer, or NULL if there is none.
+ */
+const EventIndexEntry * CircularEventBuffer::FindIndexEntry(ImportanceType inImportance, event_id_t inEventID) const
+{
+    const EventIndexEntry * found = NULL;
+
+    for (uint8_t i = 0; i < mIndexCount; i++)
+    {
+        const EventIndexEntry * entry = &mIndex[(mIndexFirst + i) % WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE];
+
+        if (entry->mImportance == inImportance && entry->mEventID <= inEventID)
+        {
+            found = entry;
+        }
+    }
+
+    return found;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT && (WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0)
+/**
+ * @brief
+ *   Add a registration of external events to the registry of this buffer.
+ *
+ * Event IDs are vended in increasing order, so a new registration always goes at the end.
+ *
+ * @retval true  The registration was added.
+ * @retval false The registry is full.
+ */
+bool CircularEventBuffer::AddExternalEvents(const ExternalEvents & inEvents)
+{
+    bool added = false;
+
+    if (mExternalEventsCount < WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE)
+    {
+        mExternalEvents[(mExternalEventsFirst + mExternalEventsCount) % WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE] =
+            inEvents;
+        mExternalEventsCount++;
+        added = true;
+    }
+
+    return added;
+}
+
+/**
+ * @brief
+ *   Remove the registration of the external events containing `inEventID` from the registry of this buffer.
+ *
+ * @param[in]  inEventID  Any event ID of the external events.
+ * @param[out] outEvents  The removed registration.
+ *
+ * @retval true  The registration was removed.
+ * @retval false No registered external events contain `inEventID`.
+ */
+bool CircularEventBuffer::RemoveExternalEvents(event_id_t inEventID, ExternalEvents & outEvents)
+{
+    ExternalEvents * entry = LookupExternalEvents(inEventID);
+    bool removed           = false;
+
+    if ((entry != NULL) && (entry->mFirstEventID <= inEventID))
+    {
+        uint8_t i = static_cast<uint8_t>((entry - mExternalEvents + WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE -
+                                          mExternalEventsFirst) %
+                                         WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE);
+
+        outEvents = *entry;
+
+        // Close the gap, keeping the entries in event ID order.
+        for (; i + 1 < mExternalEventsCount; i++)
+        {
+            mExternalEvents[(mExternalEventsFirst + i) % WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE] =
+                mExternalEvents[(mExternalEventsFirst + i + 1) % WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE];
+        }
+        mExternalEventsCount--;
+        removed = true;
+    }
+
+    return removed;
+}
+
+void CircularEventBuffer::ClearExternalEvents(void)
+{
+    mExternalEventsFirst = 0;
+    mExternalEventsCount = 0;
+}
+
+/**
+ * @brief
+ *   Binary search the registry of this buffer for the first registered external events whose last event ID is not
+ *   below `inEventID`, or NULL if there are none.
+ *
+ * The external events returned contain `inEventID` if their first event ID is not above it.
+ */
+ExternalEvents * CircularEventBuffer::LookupExternalEvents(event_id_t inEventID)
+{
+    uint8_t low  = 0;
+    uint8_t high = mExternalEventsCount;
+
+    while (low < high)
+    {
+        uint8_t mid = static_cast<uint8_t>(low + (high - low) / 2);
+
+        if (mExternalEvents[(mExternalEventsFirst + mid) % WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE].mLastEventID <
+            inEventID)
+        {
+            low = static_cast<uint8_t>(mid + 1);
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return (low < mExternalEventsCount)
+        ? &mExternalEvents[(mExternalEventsFirst + low) % WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE]
+        : NULL;
+}
+#endif // WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT && (WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0)
+
+/**
+ * @brief
+ *   Initialize the reader to start at a given event within `inBuf`, and continue through the less important buffers
+ *   like a reader set up by Init(CircularEventBuffer *).
+ *
+ * @param[in] inBuf   The buffer holding the event.
+ * @param[in] inStart The start of the event, within the storage of `inBuf`.
+ */
+void CircularEventReader::Init(CircularEventBuffer * inBuf, const uint8_t * inStart)
+{
+    const WeaveCircularTLVBuffer & buffer = inBuf->mBuffer;
+    const uint8_t * tail                  = buffer.QueueTail();
+    const uint8_t * dataEnd               = buffer.GetQueue() + buffer.GetQueueSize() - buffer.PaddingLength();
+    CircularEventBuffer * prev;
+
+    // Read up to the tail, or up to the end of the storage if the data wraps around after the event.
+    TLVReader::Init(inStart, static_cast<uint32_t>((tail > inStart) ? (tail - inStart) : (dataEnd - inStart)));
+    mBufHandle    = (uintptr_t) inBuf;
+    GetNextBuffer = CircularEventBuffer::GetNextBufferFunct;
+    mMaxLen       = buffer.DataLength();
+    for (prev = inBuf->mPrev; prev != NULL; prev = prev->mPrev)
+    {
+        mMaxLen += prev->mBuffer.DataLength();
+    }
+}
+
 void CircularEventReader::Init(CircularEventBuffer * inBuf)
 {
     CircularTLVReader reader;
@@ -2344,6 +4198,14 @@ WEAVE_ERROR CircularEventBuffer::LoadEvents(TLVReader & reader)
     VerifyOrExit(reader.GetLength() <= mBuffer.GetQueueSize(), err = WEAVE_ERROR_BUFFER_TOO_SMALL);
     mBuffer.SetQueueLength(reader.GetLength());
     mBuffer.SetQueueHead(mBuffer.GetQueue());
+    mEvictionCount++;
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    ClearIndex();
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT && (WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0)
+    // The callbacks of the loaded external events are not valid any more; they count as unregistered.
+    ClearExternalEvents();
+#endif
     err = reader.GetBytes(mBuffer.GetQueue(), mBuffer.DataLength());
     SuccessOrExit(err);
 
@@ -2426,6 +4288,18 @@ exit:
     return err;
 }
 
+EventFetchCursor::EventFetchCursor(void)
+{
+    Reset();
+}
+
+void EventFetchCursor::Reset(void)
+{
+    mBuffer        = NULL;
+    mEvictionCount = 0;
+    memset(&mEvent, 0, sizeof(mEvent));
+}
+
 CopyAndAdjustDeltaTimeContext::CopyAndAdjustDeltaTimeContext(TLVWriter * inWriter, EventLoadOutContext * inContext) :
     mWriter(inWriter), mContext(inContext)
 { }
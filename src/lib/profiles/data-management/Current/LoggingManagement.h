@@ -40,6 +40,22 @@ namespace Weave {
 namespace Profiles {
 namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
 
+/**
+ * @brief
+ *   An entry of the sparse event index: where an event starts in the event buffer holding it, and the state an event
+ *   iterator needs to resume from there.  Also used as the position of an EventFetchCursor.
+ */
+struct EventIndexEntry
+{
+    const uint8_t * mEventStart; ///< Start of the event in the circular buffer storage.
+    event_id_t mEventID;         ///< ID of the event.
+    timestamp_t mTimeBefore;     ///< Timestamp of the previous event of the same importance.
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    utc_timestamp_t mUTCTimeBefore; ///< UTC timestamp of the previous event of the same importance.
+#endif
+    ImportanceType mImportance; ///< Importance of the event.
+};
+
 /**
  * @brief
  *   Internal event buffer, built around the nl::Weave::TLV::WeaveCircularTLVBuffer
@@ -96,8 +112,36 @@ struct CircularEventBuffer
     // The backup counter to use if no counter is provided for us.
     nl::Weave::MonotonicallyIncreasingCounter mNonPersistedCounter;
 
+    uint32_t mEvictionCount; ///< Incremented whenever events leave the head of the buffer, or the buffer is reloaded
+
     static WEAVE_ERROR GetNextBufferFunct(nl::Weave::TLV::TLVReader & ioReader, uintptr_t & inBufHandle,
                                           const uint8_t *& outBufStart, uint32_t & outBufLen);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    // Index entries for events held in this buffer, oldest first, in a ring starting at mIndexFirst.
+    EventIndexEntry mIndex[WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE];
+    uint8_t mIndexFirst;
+    uint8_t mIndexCount;
+
+    void AddIndexEntry(const EventIndexEntry & inEntry);
+    bool RemoveIndexEntryAtHead(EventIndexEntry & outEntry);
+    bool RemoveIndexEntryWithin(size_t inLength, EventIndexEntry & outEntry, size_t & outOffset);
+    void ClearIndex(void);
+    const EventIndexEntry * FindIndexEntry(ImportanceType inImportance, event_id_t inEventID) const;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+
+#if WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_SUPPORT && (WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE > 0)
+    // Registered external events whose final destination is this buffer, in event ID order, in a ring starting at
+    // mExternalEventsFirst.  External event placeholders without an entry here have been unregistered.
+    ExternalEvents mExternalEvents[WEAVE_CONFIG_EVENT_LOGGING_EXTERNAL_EVENT_REGISTRY_SIZE];
+    uint8_t mExternalEventsFirst;
+    uint8_t mExternalEventsCount;
+
+    bool AddExternalEvents(const ExternalEvents & inEvents);
+    bool RemoveExternalEvents(event_id_t inEventID, ExternalEvents & outEvents);
+    void ClearExternalEvents(void);
+    ExternalEvents * LookupExternalEvents(event_id_t inEventID);
+#endif
 };
 
 /**
@@ -110,7 +154,43 @@ class CircularEventReader : public nl::Weave::TLV::TLVReader
 
 public:
     void Init(CircularEventBuffer * inBuf);
+    void Init(CircularEventBuffer * inBuf, const uint8_t * inStart);
+};
+
+/**
+ * @brief
+ *   Where a fetch of events stopped for lack of space, so that the next fetch can resume there.
+ *
+ * A fetch that is passed a cursor records in it the event that did not fit.  When the next fetch starts from that
+ * event, it reads on from the recorded position instead of scanning the buffers for it.  The position is dropped once
+ * events leave the buffer that holds it; the fetch then falls back to the scan.
+ */
+struct EventFetchCursor
+{
+    EventFetchCursor(void);
+    void Reset(void);
+
+    CircularEventBuffer * mBuffer; ///< The buffer holding the event, or NULL if the cursor holds no position.
+    uint32_t mEvictionCount;       ///< The CircularEventBuffer::mEvictionCount of mBuffer when the position was recorded.
+    EventIndexEntry mEvent;        ///< The event to resume from.
+};
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 255
+#error "WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE must be at most 255"
+#endif
+
+/**
+ * @brief
+ *  An entry of the schema dictionary: the event metadata shared by a kind of event.
+ */
+struct EventSchemaDictionaryEntry
+{
+    EventSchema mSchema;              ///< Profile ID, event type and schema versions; the importance is not used.
+    bool mHasEventSource;             ///< Whether the events carry a resource ID and trait instance ID.
+    DetailedRootSection mEventSource; ///< Resource ID and trait instance ID, if mHasEventSource.
 };
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
 
 /**
  * @brief
@@ -152,6 +232,131 @@ enum LoggingManagementStates
 // forward class declaration
 class LogBDXUpload;
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+#if (WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS & (WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS - 1)) != 0
+#error "WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS must be a power of two"
+#endif
+
+/**
+ * @brief
+ *   One slot of the staging ring filled by LoggingManagement::LogEventStaged.
+ */
+struct StagedEvent
+{
+    volatile uint32_t mSequence;       ///< Ring position at which the slot may next be claimed, plus one once it is filled.
+    const EventSchema * mSchema;       ///< Schema of the staged event, or NULL if encoding the event failed.
+    EventOptions mOptions;             ///< Options of the staged event, with the timestamp taken when it was staged.
+    DetailedRootSection mEventSource;  ///< Copy of the event source, if one was given.
+    uint16_t mDataLength;              ///< Length of the encoded event data.
+    uint8_t mData[WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOT_SIZE]; ///< The event data, encoded as a single TLV element.
+};
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+#error "WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE cannot be used with the schema dictionary"
+#endif
+
+/**
+ * @brief
+ *   The state of one event buffer, as kept in a PersistedEventLogState.  Positions are offsets into the storage of the
+ *   buffer, so that the state remains valid wherever the storage is mapped.
+ */
+struct PersistedEventBufferState
+{
+    uint32_t mQueueSize;
+    uint32_t mHeadOffset;
+    uint32_t mDataLength;
+    uint32_t mEventIdCounter;
+    event_id_t mFirstEventID;
+    event_id_t mLastEventID;
+    timestamp_t mFirstEventTimestamp;
+    timestamp_t mLastEventTimestamp;
+#if WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    utc_timestamp_t mFirstEventUTCTimestamp;
+    utc_timestamp_t mLastEventUTCTimestamp;
+    uint8_t mUTCInitialized;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS
+    uint8_t mImportance;
+};
+
+/**
+ * @brief
+ *   The state of the event buffers, kept in memory that outlives the process along with the buffers themselves.  See
+ *   LoggingManagement::AttachPersistentState().
+ *
+ * There are two copies of the state.  Each update is written to the older copy, which becomes the current one once it
+ * is complete; a copy left incomplete by a crash fails its checksum and is ignored.
+ */
+struct PersistedEventLogState
+{
+    struct Copy
+    {
+        uint32_t mSequence;   ///< Incremented with every update; the valid copy with the highest sequence is current.
+        uint32_t mChecksum;   ///< Checksum over the rest of the copy.
+        uint32_t mNumBuffers; ///< The number of event buffers.
+        PersistedEventBufferState mBuffers[kImportanceType_Last];
+    };
+
+    uint32_t mMagic;
+    Copy mCopies[2];
+};
+#endif // WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+/**
+ * @brief
+ *   The state of the event log and its consumers on which a flush policy decides.  See
+ *   LoggingManagement::SetFlushPolicy().
+ */
+struct EventFlushContext
+{
+    bool mFlushRequested;     ///< An offload was explicitly requested, e.g. for an urgent event.
+    bool mLinkActive;         ///< The link to the consumers is up; see LoggingManagement::SetOffloadLinkActive().
+    uint32_t mBytesPending;   ///< Bytes logged and not yet offloaded to the consumer furthest behind.
+    uint32_t mBytesCapacity;  ///< Total size of the event buffers.
+    uint32_t mFillRate;       ///< Smoothed rate at which events are logged, in bytes per second.
+    uint32_t mTimeSinceFlush; ///< Milliseconds since the last offload was started.
+    uint32_t mAckLatency;     ///< Smoothed milliseconds from starting an offload to its acknowledgement; 0 until measured.
+};
+
+/**
+ * @brief
+ *   A function that decides whether to offload the event log now.
+ *
+ * The function is called, possibly on any thread that logs events, each time LoggingManagement would have checked its
+ * upload thresholds.
+ *
+ * @param[in] inContext  The state of the event log and its consumers.
+ * @param[in] inAppState The application state passed to LoggingManagement::SetFlushPolicy().
+ *
+ * @retval true  Start an offload.
+ * @retval false Keep the events for now.
+ */
+typedef bool (*EventFlushPolicyFunct)(const EventFlushContext & inContext, void * inAppState);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
+/**
+ * @brief
+ *   A sampling and rate limit rule for the events of one profile.  See LoggingManagement::SetEventSamplingRule().
+ *
+ * The rate limit is a token bucket kept as the time at which the bucket would be full again (the generic cell rate
+ * algorithm), so that a single compare-and-swap updates it.
+ */
+struct EventSamplingRule
+{
+    uint32_t mProfileId;           ///< The profile the rule applies to.
+    ImportanceType mImportance;    ///< The most important events the rule applies to, or kImportanceType_Invalid if unused.
+    uint16_t mSampleInterval;      ///< Keep one in every mSampleInterval events; 0 or 1 keeps all of them.
+    uint32_t mEmissionInterval;    ///< Microseconds between events at the maximum rate, or 0 for no rate limit.
+    uint32_t mBurstTolerance;      ///< Microseconds by which events may run ahead of the maximum rate.
+    uint32_t mTheoreticalArrival;  ///< When the next event would be on schedule at the maximum rate, in microseconds.
+    uint32_t mSampleCount;         ///< Events considered by the sampling.
+    uint32_t mDroppedCount;        ///< Events dropped by the sampling or the rate limit.
+};
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
+
 /**
  * @brief
  *   A helper class used in initializing logging management.
@@ -187,6 +392,7 @@ struct LogStorageResources
 class LoggingManagement
 {
     friend class LogBDXUpload;
+    friend struct CircularEventBuffer;
 
 public:
     LoggingManagement(nl::Weave::WeaveExchangeManager * inMgr, size_t inNumBuffers, const LogStorageResources * const inLogStorageResources);
@@ -202,6 +408,10 @@ public:
 
     WEAVE_ERROR SerializeEvents(TLVWriter & writer);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+    WEAVE_ERROR AttachPersistentState(PersistedEventLogState * inState);
+#endif
+
     void MarkShutdownInProgress(void);
 
     void CancelShutdownInProgress(void);
@@ -213,9 +423,18 @@ public:
     event_id_t LogEvent(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
                         const EventOptions * inOptions);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+    WEAVE_ERROR LogEventStaged(const EventSchema & inSchema, EventWriterFunct inEventWriter, void * inAppData,
+                               const EventOptions * inOptions);
+
+    void DrainStagedEvents(void);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+
     WEAVE_ERROR GetEventReader(nl::Weave::TLV::TLVReader & ioReader, ImportanceType inImportance);
 
     WEAVE_ERROR FetchEventsSince(nl::Weave::TLV::TLVWriter & ioWriter, ImportanceType inImportance, event_id_t & ioEventID);
+    WEAVE_ERROR FetchEventsSince(nl::Weave::TLV::TLVWriter & ioWriter, ImportanceType inImportance, event_id_t & ioEventID,
+                                 EventFetchCursor * ioCursor);
 
     WEAVE_ERROR ScheduleFlushIfNeeded(bool inFlushRequested);
 
@@ -225,6 +444,20 @@ public:
 
     void NotifyEventsDelivered(ImportanceType inImportance, event_id_t inLastDeliveredEventID, uint64_t inRecipientNodeID);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+    void SetFlushPolicy(EventFlushPolicyFunct inPolicy, void * inAppState);
+    void SetOffloadLinkActive(bool inActive);
+
+    static bool AdaptiveFlushPolicy(const EventFlushContext & inContext, void * inAppState);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
+    WEAVE_ERROR SetEventSamplingRule(uint32_t inProfileId, ImportanceType inImportance, uint16_t inSampleInterval,
+                                     uint16_t inMaxEventsPerSecond, uint16_t inBurst);
+    void ClearEventSamplingRule(uint32_t inProfileId);
+    uint32_t GetDroppedEventCount(uint32_t inProfileId) const;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
+
     /**
      * @brief
      *   IsValid returns whether the LoggingManagement instance is valid
@@ -236,6 +469,7 @@ public:
 
     event_id_t GetLastEventID(ImportanceType inImportance);
     event_id_t GetFirstEventID(ImportanceType inImportance);
+    void GetBufferUsage(ImportanceType inImportance, size_t & outInUse, size_t & outHighWatermark, size_t & outSize) const;
 
     void ThrottleLogger(void);
     void UnthrottleLogger(void);
@@ -268,9 +502,11 @@ private:
     void FlushHandler(System::Layer * inSystemLayer, INET_ERROR inErr);
     void SignalUploadDone(void);
     WEAVE_ERROR CopyToNextBuffer(CircularEventBuffer * inEventBuffer);
+    WEAVE_ERROR MoveEventsToNextBuffer(CircularEventBuffer * inEventBuffer, size_t inSpaceNeeded);
     WEAVE_ERROR EnsureSpace(size_t inRequiredSpace);
 
     static WEAVE_ERROR CopyEventsSince(const nl::Weave::TLV::TLVReader & aReader, size_t aDepth, void * aContext);
+    static bool SeekEventReader(TLVReader & ioReader, EventFetchCursor & ioCursor, EventLoadOutContext & ioContext);
     static WEAVE_ERROR EventIterator(const nl::Weave::TLV::TLVReader & aReader, size_t aDepth, void * aContext);
     static WEAVE_ERROR FetchEventParameters(const nl::Weave::TLV::TLVReader & aReader, size_t aDepth, void * aContext);
     static WEAVE_ERROR CopyAndAdjustDeltaTime(const nl::Weave::TLV::TLVReader & aReader, size_t aDepth, void * aContext);
@@ -280,8 +516,25 @@ private:
                                   nl::Weave::TLV::TLVReader & inReader);
     static WEAVE_ERROR CopyEvent(const nl::Weave::TLV::TLVReader & aReader, nl::Weave::TLV::TLVWriter & aWriter,
                                  EventLoadOutContext * aContext);
+    static WEAVE_ERROR BlitEventSchema(nl::Weave::TLV::TLVWriter & aWriter, const EventSchema & inSchema,
+                                       const DetailedRootSection * inEventSource);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+    int FindSchemaDictionaryEntry(const EventSchema & inSchema, const DetailedRootSection * inEventSource);
+    WEAVE_ERROR ExpandSchemaRef(nl::Weave::TLV::TLVReader & aReader, nl::Weave::TLV::TLVWriter & aWriter) const;
+    WEAVE_ERROR SerializeSchemaDictionary(nl::Weave::TLV::TLVWriter & aWriter) const;
+    WEAVE_ERROR LoadSchemaDictionary(nl::Weave::TLV::TLVReader & aReader);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
 
     static void LoggingFlushHandler(System::Layer * systemLayer, void * appState, INET_ERROR err);
+    static void LoggingCounterWriteHandler(System::Layer * systemLayer, void * appState, INET_ERROR err);
+    void ScheduleEventIdCounterWrite(void);
+    void WritePendingEventIdCounters(void);
+
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+    static void LoggingDrainHandler(System::Layer * systemLayer, void * appState, INET_ERROR err);
+    static WEAVE_ERROR StagedEventWriter(nl::Weave::TLV::TLVWriter & ioWriter, uint8_t inDataTag, void * appData);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
 
 #if WEAVE_CONFIG_EVENT_LOGGING_BDX_OFFLOAD
     bool CheckShouldRunBDX(void);
@@ -290,6 +543,21 @@ private:
     ImportanceType GetMaxImportance(void);
     ImportanceType GetCurrentImportance(uint32_t profileId);
 
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+    void CommitPersistentState(void);
+#endif
+
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+    void InitFlushPolicy(void);
+    bool CheckFlushPolicy(bool inFlushRequested);
+    void NoteFlushStarted(void);
+    void NoteFlushAcknowledged(void);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+
+#if WEAVE_CONFIG_EVENT_LOGGING_INDEX_SIZE > 0
+    bool SeekEventReader(TLVReader & ioReader, CircularEventBuffer * inBuffer, EventLoadOutContext & ioContext);
+#endif
+
 private:
     CircularEventBuffer * GetImportanceBuffer(ImportanceType inImportance) const;
 
@@ -308,6 +576,39 @@ private:
     uint32_t mThrottled;
     ImportanceType mMaxImportanceBuffer;
     bool mUploadRequested;
+    bool mCounterWriteRequested;
+#if WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+    bool mDrainRequested;
+    uint32_t mStagingEnqueuePos;
+    uint32_t mStagingDequeuePos;
+    StagedEvent mStagedEvents[WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS];
+
+    void InitStaging(void);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_STAGING_SLOTS > 0
+#if WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+    EventSchemaDictionaryEntry mSchemaDictionary[WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE];
+    uint8_t mSchemaDictionaryCount;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SCHEMA_DICTIONARY_SIZE > 0
+#if WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+    PersistedEventLogState * mPersistedState;
+#endif
+#if WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+    EventFlushPolicyFunct mFlushPolicy;
+    void * mFlushPolicyAppState;
+    bool mOffloadLinkActive;
+    bool mFlushAckPending;
+    uint32_t mFillRate;
+    uint32_t mFillRateBytes;
+    uint32_t mAckLatency;
+    System::Timer::Epoch mFillRateTime;
+    System::Timer::Epoch mLastFlushTime;
+#endif // WEAVE_CONFIG_EVENT_LOGGING_FLUSH_POLICY
+#if WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
+    EventSamplingRule mSamplingRules[WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES];
+
+    void InitSamplingRules(void);
+    bool AdmitSampledEvent(const EventSchema & inSchema);
+#endif // WEAVE_CONFIG_EVENT_LOGGING_SAMPLING_RULES > 0
 };
 
 namespace Platform {
@@ -0,0 +1,177 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief
+ *   Implementation of event log storage in a memory-mapped file.
+ *
+ */
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/DataManagement.h>
+#include <Weave/Profiles/data-management/Current/MappedEventLogStorage.h>
+
+#if WEAVE_CONFIG_EVENT_LOGGING_MAPPED_STORAGE
+
+#include <SystemLayer/SystemError.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+
+// Buffers start on an 8-byte boundary so that a change of layout never straddles the state header.
+#define MAPPED_EVENT_LOG_STORAGE_ALIGN(x) (((x) + 7) & ~static_cast<size_t>(7))
+
+MappedEventLogStorage::MappedEventLogStorage(void) :
+    mBase(NULL), mLength(0), mNumBuffers(0), mFd(-1)
+{
+    memset(mBufferOffsets, 0, sizeof(mBufferOffsets));
+}
+
+/**
+ * @brief
+ *   Open or create the backing file and map it into memory.
+ *
+ * A file left behind by a previous run keeps its contents; LoggingManagement::AttachPersistentState() discards them
+ * when the buffer sizes no longer match.
+ *
+ * @param[in] inPath          Path of the backing file.
+ * @param[in] inBufferSizes   Sizes of the event buffers, in the order they are passed to CreateLoggingManagement().
+ * @param[in] inNumBuffers    Number of event buffers.
+ *
+ * @retval #WEAVE_ERROR_INCORRECT_STATE  The storage is already open.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT inNumBuffers is 0 or exceeds the number of importance levels.
+ * @retval other                         The POSIX error of the failed file operation.
+ */
+WEAVE_ERROR MappedEventLogStorage::Open(const char * inPath, const size_t * inBufferSizes, size_t inNumBuffers)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    size_t length;
+    void * base;
+
+    VerifyOrExit(mBase == NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(inNumBuffers > 0 && inNumBuffers <= kImportanceType_Last, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    length = MAPPED_EVENT_LOG_STORAGE_ALIGN(sizeof(PersistedEventLogState));
+    for (size_t i = 0; i < inNumBuffers; i++)
+    {
+        mBufferOffsets[i] = length;
+        length += MAPPED_EVENT_LOG_STORAGE_ALIGN(inBufferSizes[i]);
+    }
+
+    mFd = open(inPath, O_RDWR | O_CREAT, 0600);
+    VerifyOrExit(mFd >= 0, err = System::MapErrorPOSIX(errno));
+
+    VerifyOrExit(ftruncate(mFd, static_cast<off_t>(length)) == 0, err = System::MapErrorPOSIX(errno));
+
+    base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+    VerifyOrExit(base != MAP_FAILED, err = System::MapErrorPOSIX(errno));
+
+    mBase       = static_cast<uint8_t *>(base);
+    mLength     = length;
+    mNumBuffers = inNumBuffers;
+
+exit:
+    if (err != WEAVE_NO_ERROR && mBase == NULL && mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+    return err;
+}
+
+/**
+ * @brief
+ *   Write the mapped events and state through to the backing file.
+ *
+ * @retval #WEAVE_ERROR_INCORRECT_STATE  The storage is not open.
+ * @retval other                         The POSIX error of the failed msync().
+ */
+WEAVE_ERROR MappedEventLogStorage::Flush(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mBase != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(msync(mBase, mLength, MS_SYNC) == 0, err = System::MapErrorPOSIX(errno));
+
+exit:
+    return err;
+}
+
+/**
+ * @brief
+ *   Unmap and close the backing file.
+ *
+ * The buffers and state must no longer be in use by LoggingManagement.
+ */
+void MappedEventLogStorage::Close(void)
+{
+    if (mBase != NULL)
+    {
+        munmap(mBase, mLength);
+        mBase = NULL;
+    }
+
+    if (mFd >= 0)
+    {
+        close(mFd);
+        mFd = -1;
+    }
+
+    mLength     = 0;
+    mNumBuffers = 0;
+}
+
+/**
+ * @brief
+ *   Get the mapped memory of an event buffer.
+ *
+ * @param[in] inIndex  Index of the buffer, as passed to Open().
+ *
+ * @return The buffer, or NULL if the storage is not open or inIndex is out of range.
+ */
+void * MappedEventLogStorage::GetBuffer(size_t inIndex) const
+{
+    return (mBase != NULL && inIndex < mNumBuffers) ? mBase + mBufferOffsets[inIndex] : NULL;
+}
+
+/**
+ * @brief
+ *   Get the mapped persistent state of the event buffers.
+ *
+ * @return The state, or NULL if the storage is not open.
+ */
+PersistedEventLogState * MappedEventLogStorage::GetState(void) const
+{
+    return reinterpret_cast<PersistedEventLogState *>(mBase);
+}
+
+} // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_MAPPED_STORAGE
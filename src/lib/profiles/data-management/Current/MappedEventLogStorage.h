@@ -0,0 +1,95 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief
+ *   Event log storage in a memory-mapped file.
+ *
+ */
+#ifndef _WEAVE_DATA_MANAGEMENT_MAPPED_EVENT_LOG_STORAGE_CURRENT_H
+#define _WEAVE_DATA_MANAGEMENT_MAPPED_EVENT_LOG_STORAGE_CURRENT_H
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/Current/LoggingManagement.h>
+
+#if WEAVE_CONFIG_EVENT_LOGGING_MAPPED_STORAGE
+
+#if !WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE
+#error "WEAVE_CONFIG_EVENT_LOGGING_MAPPED_STORAGE requires WEAVE_CONFIG_EVENT_LOGGING_PERSISTENT_STATE"
+#endif
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+
+/**
+ * @brief
+ *   Event buffers and their persistent state in a memory-mapped file.
+ *
+ * Lays out a PersistedEventLogState followed by the event buffers in a single file, and maps the file into memory.
+ * The buffers are handed to CreateLoggingManagement() and the state to LoggingManagement::AttachPersistentState():
+ *
+ * @code
+ *   static const size_t sBufferSizes[] = { 2048, 2048, 4096, 4096 };
+ *
+ *   err = sStorage.Open("/var/lib/weave/events", sBufferSizes, 4);
+ *   for (i = 0; i < 4; i++)
+ *   {
+ *       resources[i].mBuffer     = sStorage.GetBuffer(i);
+ *       resources[i].mBufferSize = sBufferSizes[i];
+ *       ...
+ *   }
+ *   LoggingManagement::CreateLoggingManagement(exchangeMgr, 4, resources);
+ *   err = LoggingManagement::GetInstance().AttachPersistentState(sStorage.GetState());
+ * @endcode
+ *
+ * Events then persist as they are logged, and are back in the buffers as soon as the state is attached after a
+ * restart.  Since the file is shared with the kernel page cache, logged events survive a crash of the process as is;
+ * Flush() them to also survive a crash of the system.
+ */
+class MappedEventLogStorage
+{
+public:
+    MappedEventLogStorage(void);
+
+    WEAVE_ERROR Open(const char * inPath, const size_t * inBufferSizes, size_t inNumBuffers);
+    WEAVE_ERROR Flush(void);
+    void Close(void);
+
+    void * GetBuffer(size_t inIndex) const;
+    PersistedEventLogState * GetState(void) const;
+
+private:
+    uint8_t * mBase;
+    size_t mLength;
+    size_t mNumBuffers;
+    size_t mBufferOffsets[kImportanceType_Last];
+    int mFd;
+};
+
+} // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_EVENT_LOGGING_MAPPED_STORAGE
+
+#endif // _WEAVE_DATA_MANAGEMENT_MAPPED_EVENT_LOG_STORAGE_CURRENT_H
@@ -347,6 +347,307 @@ WEAVE_ERROR ListBuilderBase::Init(nl::Weave::TLV::TLVWriter * const apWriter)
     return mError;
 }
 
+namespace MessageSchema {
+
+// A reader over the encoding of a single element, set up as if it were positioned within the element's container
+class ElementReader : public nl::Weave::TLV::TLVReader
+{
+public:
+    void Init(const Element & aElement)
+    {
+        TLVReader::Init(aElement.mData, aElement.mLen);
+        ImplicitProfileId = aElement.mImplicitProfileId;
+        mContainerType    = static_cast<nl::Weave::TLV::TLVType>(aElement.mContainerType);
+    }
+};
+
+WEAVE_ERROR Element::GetReader(nl::Weave::TLV::TLVReader & aReader) const
+{
+    ElementReader reader;
+
+    reader.Init(*this);
+    aReader.Init(reader);
+
+    return aReader.Next();
+}
+
+static bool IsElementField(const FieldDescriptor & aField)
+{
+    return (kFieldType_Structure == aField.mType) || (kFieldType_Array == aField.mType) || (kFieldType_Any == aField.mType);
+}
+
+// Check the type of the current element against the field and, for scalar fields, store its value
+static WEAVE_ERROR DecodeScalarField(nl::Weave::TLV::TLVReader & aReader, const FieldDescriptor & aField, uint8_t * const apMember)
+{
+    WEAVE_ERROR err                  = WEAVE_NO_ERROR;
+    const nl::Weave::TLV::TLVType type = aReader.GetType();
+
+    switch (aField.mType)
+    {
+    case kFieldType_UnsignedInteger:
+    {
+        uint64_t value;
+
+        VerifyOrExit(nl::Weave::TLV::kTLVType_UnsignedInteger == type, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+
+        err = aReader.Get(value);
+        SuccessOrExit(err);
+
+        switch (aField.mSize)
+        {
+        case 1:
+            VerifyOrExit(value <= UINT8_MAX, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+            *reinterpret_cast<uint8_t *>(apMember) = static_cast<uint8_t>(value);
+            break;
+        case 2:
+            VerifyOrExit(value <= UINT16_MAX, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+            *reinterpret_cast<uint16_t *>(apMember) = static_cast<uint16_t>(value);
+            break;
+        case 4:
+            VerifyOrExit(value <= UINT32_MAX, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+            *reinterpret_cast<uint32_t *>(apMember) = static_cast<uint32_t>(value);
+            break;
+        case 8:
+            *reinterpret_cast<uint64_t *>(apMember) = value;
+            break;
+        default:
+            ExitNow(err = WEAVE_ERROR_INVALID_ARGUMENT);
+        }
+        break;
+    }
+
+    case kFieldType_SignedInteger:
+    {
+        int64_t value;
+
+        VerifyOrExit(nl::Weave::TLV::kTLVType_SignedInteger == type, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+
+        err = aReader.Get(value);
+        SuccessOrExit(err);
+
+        switch (aField.mSize)
+        {
+        case 1:
+            VerifyOrExit(value >= INT8_MIN && value <= INT8_MAX, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+            *reinterpret_cast<int8_t *>(apMember) = static_cast<int8_t>(value);
+            break;
+        case 2:
+            VerifyOrExit(value >= INT16_MIN && value <= INT16_MAX, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+            *reinterpret_cast<int16_t *>(apMember) = static_cast<int16_t>(value);
+            break;
+        case 4:
+            VerifyOrExit(value >= INT32_MIN && value <= INT32_MAX, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+            *reinterpret_cast<int32_t *>(apMember) = static_cast<int32_t>(value);
+            break;
+        case 8:
+            *reinterpret_cast<int64_t *>(apMember) = value;
+            break;
+        default:
+            ExitNow(err = WEAVE_ERROR_INVALID_ARGUMENT);
+        }
+        break;
+    }
+
+    case kFieldType_Boolean:
+        VerifyOrExit(nl::Weave::TLV::kTLVType_Boolean == type, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+        VerifyOrExit(sizeof(bool) == aField.mSize, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+        err = aReader.Get(*reinterpret_cast<bool *>(apMember));
+        break;
+
+    case kFieldType_Structure:
+        VerifyOrExit(nl::Weave::TLV::kTLVType_Structure == type, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+        break;
+
+    case kFieldType_Array:
+        VerifyOrExit(nl::Weave::TLV::kTLVType_Array == type, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+        break;
+
+    case kFieldType_Any:
+        break;
+
+    default:
+        err = WEAVE_ERROR_INVALID_ARGUMENT;
+        break;
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR DecodeStructure(const nl::Weave::TLV::TLVReader & aReader, const StructDescriptor & aDescriptor, void * aStruct)
+{
+    WEAVE_ERROR err         = WEAVE_NO_ERROR;
+    uint8_t * const base    = static_cast<uint8_t *>(aStruct);
+    uint32_t & presenceMask = *reinterpret_cast<uint32_t *>(base + aDescriptor.mPresenceMaskOffset);
+    nl::Weave::TLV::TLVReader reader;
+
+    presenceMask = 0;
+
+    // make a copy of the reader
+    reader.Init(aReader);
+
+    while (true)
+    {
+        // Every element is skipped over once it has been handled, so the read point is now at the head of the next one
+        const uint8_t * const elementStart = reader.GetReadPoint();
+        const uint32_t lenReadBefore       = reader.GetLengthRead();
+        const FieldDescriptor * field      = NULL;
+        uint8_t fieldIndex                 = 0;
+
+        err = reader.Next();
+        if (WEAVE_END_OF_TLV == err)
+        {
+            err = WEAVE_NO_ERROR;
+            break;
+        }
+        SuccessOrExit(err);
+
+        if (nl::Weave::TLV::IsContextTag(reader.GetTag()))
+        {
+            const uint32_t tagNum = nl::Weave::TLV::TagNumFromTag(reader.GetTag());
+
+            for (fieldIndex = 0; fieldIndex < aDescriptor.mNumFields; fieldIndex++)
+            {
+                if (aDescriptor.mFields[fieldIndex].mContextTag == tagNum)
+                {
+                    field = &aDescriptor.mFields[fieldIndex];
+                    break;
+                }
+            }
+        }
+
+        // Unknown tags are ignored for forward compatibility
+        if (NULL != field)
+        {
+            VerifyOrExit(!(presenceMask & (1U << fieldIndex)), err = WEAVE_ERROR_INVALID_TLV_TAG);
+            presenceMask |= (1U << fieldIndex);
+
+            err = DecodeScalarField(reader, *field, base + field->mOffset);
+            SuccessOrExit(err);
+        }
+
+        err = reader.Skip();
+        SuccessOrExit(err);
+
+        if ((NULL != field) && IsElementField(*field))
+        {
+            Element & element = *reinterpret_cast<Element *>(base + field->mOffset);
+
+            element.mData              = elementStart;
+            element.mLen               = reader.GetLengthRead() - lenReadBefore;
+            element.mImplicitProfileId = reader.ImplicitProfileId;
+            element.mContainerType     = static_cast<uint8_t>(reader.GetContainerType());
+
+            // Elements recorded by location must not span buffers
+            VerifyOrExit(reader.GetReadPoint() == elementStart + element.mLen, err = WEAVE_ERROR_INVALID_TLV_ELEMENT);
+        }
+    }
+
+    for (uint8_t i = 0; i < aDescriptor.mNumFields; i++)
+    {
+        if (aDescriptor.mFields[i].mFlags & kFieldFlag_Mandatory)
+        {
+            VerifyOrExit(presenceMask & (1U << i), err = WEAVE_ERROR_MISSING_TLV_ELEMENT);
+        }
+    }
+
+exit:
+    WeaveLogFunctError(err);
+
+    if (WEAVE_NO_ERROR != err)
+    {
+        presenceMask = 0;
+    }
+
+    return err;
+}
+
+static WEAVE_ERROR EncodeField(nl::Weave::TLV::TLVWriter & aWriter, const FieldDescriptor & aField, const uint8_t * const apMember)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    const uint64_t tag = nl::Weave::TLV::ContextTag(aField.mContextTag);
+
+    switch (aField.mType)
+    {
+    case kFieldType_UnsignedInteger:
+        switch (aField.mSize)
+        {
+        case 1: err = aWriter.Put(tag, *reinterpret_cast<const uint8_t *>(apMember)); break;
+        case 2: err = aWriter.Put(tag, *reinterpret_cast<const uint16_t *>(apMember)); break;
+        case 4: err = aWriter.Put(tag, *reinterpret_cast<const uint32_t *>(apMember)); break;
+        case 8: err = aWriter.Put(tag, *reinterpret_cast<const uint64_t *>(apMember)); break;
+        default: err = WEAVE_ERROR_INVALID_ARGUMENT; break;
+        }
+        break;
+
+    case kFieldType_SignedInteger:
+        switch (aField.mSize)
+        {
+        case 1: err = aWriter.Put(tag, *reinterpret_cast<const int8_t *>(apMember)); break;
+        case 2: err = aWriter.Put(tag, *reinterpret_cast<const int16_t *>(apMember)); break;
+        case 4: err = aWriter.Put(tag, *reinterpret_cast<const int32_t *>(apMember)); break;
+        case 8: err = aWriter.Put(tag, *reinterpret_cast<const int64_t *>(apMember)); break;
+        default: err = WEAVE_ERROR_INVALID_ARGUMENT; break;
+        }
+        break;
+
+    case kFieldType_Boolean:
+        err = aWriter.PutBoolean(tag, *reinterpret_cast<const bool *>(apMember));
+        break;
+
+    case kFieldType_Structure:
+    case kFieldType_Array:
+    case kFieldType_Any:
+    {
+        nl::Weave::TLV::TLVReader reader;
+
+        err = reinterpret_cast<const Element *>(apMember)->GetReader(reader);
+        SuccessOrExit(err);
+
+        err = aWriter.CopyElement(tag, reader);
+        break;
+    }
+
+    default:
+        err = WEAVE_ERROR_INVALID_ARGUMENT;
+        break;
+    }
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR EncodeStructure(nl::Weave::TLV::TLVWriter & aWriter, const uint64_t aTag, const StructDescriptor & aDescriptor,
+                            const void * aStruct)
+{
+    WEAVE_ERROR err               = WEAVE_NO_ERROR;
+    const uint8_t * const base    = static_cast<const uint8_t *>(aStruct);
+    const uint32_t presenceMask   = *reinterpret_cast<const uint32_t *>(base + aDescriptor.mPresenceMaskOffset);
+    nl::Weave::TLV::TLVType outerContainerType;
+
+    err = aWriter.StartContainer(aTag, nl::Weave::TLV::kTLVType_Structure, outerContainerType);
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < aDescriptor.mNumFields; i++)
+    {
+        if (presenceMask & (1U << i))
+        {
+            err = EncodeField(aWriter, aDescriptor.mFields[i], base + aDescriptor.mFields[i].mOffset);
+            SuccessOrExit(err);
+        }
+    }
+
+    err = aWriter.EndContainer(outerContainerType);
+
+exit:
+    WeaveLogFunctError(err);
+
+    return err;
+}
+
+}; // namespace MessageSchema
+
 WEAVE_ERROR Path::Parser::Init(const nl::Weave::TLV::TLVReader & aReader)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -3124,6 +3425,30 @@ WEAVE_ERROR SubscribeRequest::Parser::GetVersionList(VersionList::Parser * const
     return apVersionList->InitIfPresent(mReader, kCsTag_VersionList);
 }
 
+static const MessageSchema::FieldDescriptor sSubscribeRequestFields[] = {
+    WDM_SCHEMA_FIELD(SubscribeRequest::Contents, mSubscriptionId, SubscribeRequest::kCsTag_SubscriptionId,
+                     MessageSchema::kFieldType_UnsignedInteger, 0),
+    WDM_SCHEMA_FIELD(SubscribeRequest::Contents, mSubscribeTimeOutMin, SubscribeRequest::kCsTag_SubscribeTimeOutMin,
+                     MessageSchema::kFieldType_UnsignedInteger, 0),
+    WDM_SCHEMA_FIELD(SubscribeRequest::Contents, mSubscribeTimeOutMax, SubscribeRequest::kCsTag_SubscribeTimeOutMax,
+                     MessageSchema::kFieldType_UnsignedInteger, 0),
+    WDM_SCHEMA_FIELD(SubscribeRequest::Contents, mSubscribeToAllEvents, SubscribeRequest::kCsTag_SubscribeToAllEvents,
+                     MessageSchema::kFieldType_Boolean, 0),
+    WDM_SCHEMA_FIELD(SubscribeRequest::Contents, mLastObservedEventIdList, SubscribeRequest::kCsTag_LastObservedEventIdList,
+                     MessageSchema::kFieldType_Array, 0),
+    WDM_SCHEMA_FIELD(SubscribeRequest::Contents, mPathList, SubscribeRequest::kCsTag_PathList, MessageSchema::kFieldType_Array, 0),
+    WDM_SCHEMA_FIELD(SubscribeRequest::Contents, mVersionList, SubscribeRequest::kCsTag_VersionList,
+                     MessageSchema::kFieldType_Array, 0),
+};
+
+const MessageSchema::StructDescriptor SubscribeRequest::Contents::sDescriptor =
+    WDM_SCHEMA_STRUCT(SubscribeRequest::Contents, sSubscribeRequestFields);
+
+WEAVE_ERROR SubscribeRequest::Parser::Decode(Contents & aContents) const
+{
+    return MessageSchema::Decode(mReader, aContents);
+}
+
 SubscribeRequest::Builder & SubscribeRequest::Builder::SubscriptionID(const uint64_t aSubscriptionID)
 {
     SetSubscriptionID(aSubscriptionID);
@@ -3681,6 +4006,29 @@ WEAVE_ERROR NotificationRequest::Parser::GetEventList(EventList::Parser * const
     return apEventList->InitIfPresent(mReader, kCsTag_EventList);
 }
 
+static const MessageSchema::FieldDescriptor sNotificationRequestFields[] = {
+    WDM_SCHEMA_FIELD(NotificationRequest::Contents, mSubscriptionId, NotificationRequest::kCsTag_SubscriptionId,
+                     MessageSchema::kFieldType_UnsignedInteger, 0),
+    WDM_SCHEMA_FIELD(NotificationRequest::Contents, mDataList, NotificationRequest::kCsTag_DataList,
+                     MessageSchema::kFieldType_Array, 0),
+    WDM_SCHEMA_FIELD(NotificationRequest::Contents, mPossibleLossOfEvent, NotificationRequest::kCsTag_PossibleLossOfEvent,
+                     MessageSchema::kFieldType_Boolean, 0),
+    WDM_SCHEMA_FIELD(NotificationRequest::Contents, mUTCTimestamp, NotificationRequest::kCsTag_UTCTimestamp,
+                     MessageSchema::kFieldType_UnsignedInteger, 0),
+    WDM_SCHEMA_FIELD(NotificationRequest::Contents, mSystemTimestamp, NotificationRequest::kCsTag_SystemTimestamp,
+                     MessageSchema::kFieldType_UnsignedInteger, 0),
+    WDM_SCHEMA_FIELD(NotificationRequest::Contents, mEventList, NotificationRequest::kCsTag_EventList,
+                     MessageSchema::kFieldType_Array, 0),
+};
+
+const MessageSchema::StructDescriptor NotificationRequest::Contents::sDescriptor =
+    WDM_SCHEMA_STRUCT(NotificationRequest::Contents, sNotificationRequestFields);
+
+WEAVE_ERROR NotificationRequest::Parser::Decode(Contents & aContents) const
+{
+    return MessageSchema::Decode(mReader, aContents);
+}
+
 WEAVE_ERROR CustomCommand::Parser::Init(const nl::Weave::TLV::TLVReader & aReader)
 {
 
@@ -4427,6 +4775,23 @@ WEAVE_ERROR UpdateRequest::Parser::GetDataList (DataList::Parser * const apDataL
     return apDataList->InitIfPresent(mReader, kCsTag_DataList);
 }
 
+static const MessageSchema::FieldDescriptor sUpdateRequestFields[] = {
+    WDM_SCHEMA_FIELD(UpdateRequest::Contents, mExpiryTimeMicroSecond, UpdateRequest::kCsTag_ExpiryTime,
+                     MessageSchema::kFieldType_UnsignedInteger, 0),
+    WDM_SCHEMA_FIELD(UpdateRequest::Contents, mArgument, UpdateRequest::kCsTag_Argument, MessageSchema::kFieldType_Structure, 0),
+    WDM_SCHEMA_FIELD(UpdateRequest::Contents, mDataList, UpdateRequest::kCsTag_DataList, MessageSchema::kFieldType_Array, 0),
+    WDM_SCHEMA_FIELD(UpdateRequest::Contents, mUpdateRequestIndex, UpdateRequest::kCsTag_UpdateRequestIndex,
+                     MessageSchema::kFieldType_UnsignedInteger, 0),
+};
+
+const MessageSchema::StructDescriptor UpdateRequest::Contents::sDescriptor =
+    WDM_SCHEMA_STRUCT(UpdateRequest::Contents, sUpdateRequestFields);
+
+WEAVE_ERROR UpdateRequest::Parser::Decode(Contents & aContents) const
+{
+    return MessageSchema::Decode(mReader, aContents);
+}
+
 // aReader has to be on the element of anonymous container
 WEAVE_ERROR UpdateResponse::Parser::Init(const nl::Weave::TLV::TLVReader & aReader)
 {
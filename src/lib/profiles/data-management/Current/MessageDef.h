@@ -30,6 +30,8 @@
 #include <Weave/Core/WeaveTLV.h>
 #include <Weave/Profiles/data-management/Current/ResourceIdentifier.h>
 
+#include <stddef.h>
+
 namespace nl {
 namespace Weave {
 namespace Profiles {
@@ -134,6 +136,16 @@ enum
     kStatus_InvalidTLVInUpdate            = 0x2E,
 };
 
+/**
+ *  @brief
+ *    WDM-specific profile tags that can appear in the metadata structure of a StatusReport.
+ *
+ */
+enum {
+    kTag_StatusRetryAfterMsec             = 0x01, ///< Unsigned integer: how long the receiver should wait
+                                                  ///< before retrying the rejected request, in milliseconds.
+};
+
 // TODO: The type is only used in a few places. We should use it everywhere.
 // TODO: A typedef like this should come with the relative PRIDataVersion define
 typedef uint64_t DataVersion;
@@ -278,6 +290,133 @@ public:
     WEAVE_ERROR Init(nl::Weave::TLV::TLVWriter * const apWriter);
 };
 
+/**
+ *  @brief
+ *    Table-driven decoding and encoding of WDM messages into plain C++ structures
+ *
+ *  A message schema is a static table of field descriptors, each giving the context tag, the
+ *  expected TLV type and the location of the corresponding member in a plain structure.  Decoding
+ *  visits every member of the message exactly once, checking for duplicate tags, wrong types and
+ *  missing mandatory fields in the same pass in which the values are stored.  Unknown tags are
+ *  ignored for forward compatibility, as in the hand-written parsers.
+ *
+ *  Scalar fields are stored by value.  Container fields (and fields of any type) are recorded as
+ *  an Element, which refers to the encoding of the element within the message buffer, so that
+ *  the message buffer must remain valid while the decoded structure is in use.
+ */
+namespace MessageSchema {
+
+enum FieldType
+{
+    kFieldType_UnsignedInteger = 0,   ///< Unsigned integer, stored in an unsigned member of 1, 2, 4 or 8 bytes
+    kFieldType_SignedInteger,         ///< Signed integer, stored in a signed member of 1, 2, 4 or 8 bytes
+    kFieldType_Boolean,               ///< Boolean, stored in a bool member
+    kFieldType_Structure,             ///< Structure, stored in an Element member
+    kFieldType_Array,                 ///< Array, stored in an Element member
+    kFieldType_Any,                   ///< Element of any type, stored in an Element member
+};
+
+enum FieldFlags
+{
+    kFieldFlag_Mandatory = 0x01,      ///< Decoding fails if the field is absent
+};
+
+/**
+ *  @brief A field in a message schema
+ */
+struct FieldDescriptor
+{
+    uint16_t mOffset;                 ///< Offset of the member within the structure
+    uint8_t mContextTag;              ///< Context tag of the field
+    uint8_t mType;                    ///< One of FieldType
+    uint8_t mSize;                    ///< Size of the member, in bytes
+    uint8_t mFlags;                   ///< Combination of FieldFlags
+};
+
+/**
+ *  @brief A message schema; the mask of decoded fields, indexed by field position, is at mPresenceMaskOffset
+ */
+struct StructDescriptor
+{
+    const FieldDescriptor * mFields;
+    uint8_t mNumFields;
+    uint16_t mPresenceMaskOffset;
+};
+
+/**
+ *  @brief The location of an encoded TLV element within a contiguous message buffer
+ */
+struct Element
+{
+    const uint8_t * mData;
+    uint32_t mLen;
+    uint32_t mImplicitProfileId;
+    uint8_t mContainerType;           ///< TLVType of the container in which the element was found
+
+    /**
+     *  @brief Initialize a TLVReader positioned on the element, as if Next() had returned it
+     *
+     *  @param [out] aReader    The reader to initialize
+     *
+     *  @retval #WEAVE_NO_ERROR on success
+     */
+    WEAVE_ERROR GetReader(nl::Weave::TLV::TLVReader & aReader) const;
+};
+
+#define WDM_SCHEMA_FIELD(aStruct, aMember, aContextTag, aType, aFlags)                                                             \
+    {                                                                                                                              \
+        static_cast<uint16_t>(offsetof(aStruct, aMember)), (aContextTag), (aType),                                                 \
+            static_cast<uint8_t>(sizeof(static_cast<aStruct *>(0)->aMember)), (aFlags)                                             \
+    }
+
+#define WDM_SCHEMA_STRUCT(aStruct, aFields)                                                                                        \
+    {                                                                                                                              \
+        (aFields), static_cast<uint8_t>(sizeof(aFields) / sizeof((aFields)[0])),                                                   \
+            static_cast<uint16_t>(offsetof(aStruct, mPresenceMask))                                                                \
+    }
+
+/**
+ *  @brief Decode the members of a container into a structure
+ *
+ *  @param [in]  aReader        A reader positioned inside the container, before its first member,
+ *                              as left by EnterContainer()
+ *  @param [in]  aDescriptor    The schema of the structure
+ *  @param [out] aStruct        The structure to fill in
+ *
+ *  @retval #WEAVE_NO_ERROR on success
+ *  @retval #WEAVE_ERROR_INVALID_TLV_TAG if a field appears more than once
+ *  @retval #WEAVE_ERROR_WRONG_TLV_TYPE if a field has an unexpected type or does not fit its member
+ *  @retval #WEAVE_ERROR_MISSING_TLV_ELEMENT if a mandatory field is missing
+ */
+WEAVE_ERROR DecodeStructure(const nl::Weave::TLV::TLVReader & aReader, const StructDescriptor & aDescriptor, void * aStruct);
+
+/**
+ *  @brief Encode the fields present in a structure as a TLV structure
+ *
+ *  @param [in] aWriter         The writer to encode to
+ *  @param [in] aTag            The tag of the structure
+ *  @param [in] aDescriptor     The schema of the structure
+ *  @param [in] aStruct         The structure to encode
+ *
+ *  @retval #WEAVE_NO_ERROR on success
+ */
+WEAVE_ERROR EncodeStructure(nl::Weave::TLV::TLVWriter & aWriter, const uint64_t aTag, const StructDescriptor & aDescriptor,
+                            const void * aStruct);
+
+template <class T>
+inline WEAVE_ERROR Decode(const nl::Weave::TLV::TLVReader & aReader, T & aStruct)
+{
+    return DecodeStructure(aReader, T::sDescriptor, &aStruct);
+}
+
+template <class T>
+inline WEAVE_ERROR Encode(nl::Weave::TLV::TLVWriter & aWriter, const uint64_t aTag, const T & aStruct)
+{
+    return EncodeStructure(aWriter, aTag, T::sDescriptor, &aStruct);
+}
+
+}; // namespace MessageSchema
+
 /**
  *  @brief
  *    WDM Path definition
@@ -833,8 +972,40 @@ enum
 
 class Parser;
 class Builder;
+struct Contents;
 }; // namespace SubscribeRequest
 
+/**
+ *  @brief
+ *    Decoded form of a WDM Subscribe Request
+ */
+struct SubscribeRequest::Contents
+{
+    enum
+    {
+        kField_SubscriptionId,
+        kField_SubscribeTimeOutMin,
+        kField_SubscribeTimeOutMax,
+        kField_SubscribeToAllEvents,
+        kField_LastObservedEventIdList,
+        kField_PathList,
+        kField_VersionList,
+    };
+
+    uint32_t mPresenceMask;
+    uint64_t mSubscriptionId;
+    uint32_t mSubscribeTimeOutMin;
+    uint32_t mSubscribeTimeOutMax;
+    bool mSubscribeToAllEvents;
+    MessageSchema::Element mLastObservedEventIdList;
+    MessageSchema::Element mPathList;
+    MessageSchema::Element mVersionList;
+
+    bool IsPresent(const uint8_t aField) const { return (mPresenceMask & (1U << aField)) != 0; }
+
+    static const MessageSchema::StructDescriptor sDescriptor;
+};
+
 /**
  *  @brief
  *    WDM Path parser definition
@@ -880,6 +1051,9 @@ public:
     // WEAVE_END_OF_TLV if there is no such element
     // WEAVE_ERROR_WRONG_TLV_TYPE if there is such element but it's not one of the right types
     WEAVE_ERROR GetVersionList(VersionList::Parser * const apVersionList) const;
+
+    // Decode and validate all fields in a single pass
+    WEAVE_ERROR Decode(Contents & aContents) const;
 };
 
 // Note that in theory this class can be derived from SubscribeCancelRequest, but we are anticipating the tags to be changed
@@ -1117,8 +1291,38 @@ enum
 };
 
 class Parser;
+struct Contents;
 }; // namespace NotificationRequest
 
+/**
+ *  @brief
+ *    Decoded form of a WDM Notification Request
+ */
+struct NotificationRequest::Contents
+{
+    enum
+    {
+        kField_SubscriptionId,
+        kField_DataList,
+        kField_PossibleLossOfEvent,
+        kField_UTCTimestamp,
+        kField_SystemTimestamp,
+        kField_EventList,
+    };
+
+    uint32_t mPresenceMask;
+    uint64_t mSubscriptionId;
+    MessageSchema::Element mDataList;
+    bool mPossibleLossOfEvent;
+    uint64_t mUTCTimestamp;
+    uint64_t mSystemTimestamp;
+    MessageSchema::Element mEventList;
+
+    bool IsPresent(const uint8_t aField) const { return (mPresenceMask & (1U << aField)) != 0; }
+
+    static const MessageSchema::StructDescriptor sDescriptor;
+};
+
 class NotificationRequest::Parser : public BaseMessageWithSubscribeId::Parser
 {
 public:
@@ -1146,6 +1350,9 @@ public:
 
     // Get a TLVReader for the events. Next() must be called before accessing them.
     WEAVE_ERROR GetEventList(EventList::Parser * const apEventList) const;
+
+    // Decode and validate all fields in a single pass
+    WEAVE_ERROR Decode(Contents & aContents) const;
 };
 
 /**
@@ -1496,8 +1703,36 @@ namespace UpdateRequest {
     };
 
     class Parser;
+    struct Contents;
 }; // namespace UpdateRequest
 
+/**
+ *  @brief
+ *    Decoded form of a WDM Update Request
+ *
+ *  The authenticator, which is profile-tagged, is not part of the decoded form.
+ */
+struct UpdateRequest::Contents
+{
+    enum
+    {
+        kField_ExpiryTime,
+        kField_Argument,
+        kField_DataList,
+        kField_UpdateRequestIndex,
+    };
+
+    uint32_t mPresenceMask;
+    uint64_t mExpiryTimeMicroSecond;
+    MessageSchema::Element mArgument;
+    MessageSchema::Element mDataList;
+    uint32_t mUpdateRequestIndex;
+
+    bool IsPresent(const uint8_t aField) const { return (mPresenceMask & (1U << aField)) != 0; }
+
+    static const MessageSchema::StructDescriptor sDescriptor;
+};
+
 /**
  *  @brief
  *    WDM Update Request parser definition
@@ -1562,6 +1797,15 @@ public:
      *  @retval #WEAVE_ERROR_WRONG_TLV_TYPE if there is such element but it's not a unsigned integer
      */
     WEAVE_ERROR GetUpdateRequestIndex(uint32_t * const apUpdateRequestIndex) const;
+
+    /**
+     *  @brief Decode and validate all context-tagged fields of this request in a single pass
+     *
+     *  @param [out] aContents  The decoded request
+     *
+     *  @retval #WEAVE_NO_ERROR on success
+     */
+    WEAVE_ERROR Decode(Contents & aContents) const;
 };
 
 namespace UpdateResponse {
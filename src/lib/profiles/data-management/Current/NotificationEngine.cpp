@@ -37,6 +37,8 @@
 
 #include <Weave/Profiles/status-report/StatusReportProfile.h>
 #include <Weave/Profiles/time/WeaveTime.h>
+#include <SystemLayer/SystemTrace.h>
+#include <Weave/Support/PerfInstrumentation.h>
 
 using namespace ::nl::Weave;
 using namespace ::nl::Weave::TLV;
@@ -78,6 +80,23 @@ WEAVE_ERROR NotificationEngine::BasicGraphSolver::SetDirty(TraitDataHandle aData
 {
     SubscriptionEngine * subEngine = SubscriptionEngine::GetInstance();
 
+#if WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+    // Only visit the trait instance infos hashed under this trait data handle
+    for (uint16_t traitRef = subEngine->mTraitIndex[aDataHandle % WDM_PUBLISHER_TRAIT_INDEX_SIZE]; traitRef != 0;)
+    {
+        SubscriptionHandler::TraitInstanceInfo * traitInstance = &subEngine->mTraitInfoPool[traitRef - 1];
+        SubscriptionHandler * subHandler                       = &subEngine->mHandlers[traitInstance->mHandlerId];
+
+        traitRef = traitInstance->mNextInTraitIndex;
+
+        if (traitInstance->mTraitDataHandle == aDataHandle && subHandler->IsActive())
+        {
+            WeaveLogDetail(DataManagement, "<BSolver:SetD> Set S%u:T%u dirty", traitInstance->mHandlerId,
+                           static_cast<unsigned int>(traitInstance - subHandler->GetTraitInstanceInfoList()));
+            subHandler->SetTraitInstanceDirty(traitInstance);
+        }
+    }
+#else
     // Iterate over all subscriptions and their trait instance info lists and mark them dirty as appropriate
     for (int i = 0; i < SubscriptionEngine::kMaxNumSubscriptionHandlers; ++i)
     {
@@ -89,14 +108,17 @@ WEAVE_ERROR NotificationEngine::BasicGraphSolver::SetDirty(TraitDataHandle aData
 
             for (size_t j = 0; j < subHandler->GetNumTraitInstances(); j++)
             {
+                // A subscription holds at most one trait instance info per trait instance.
                 if (traitInstance[j].mTraitDataHandle == aDataHandle)
                 {
                     WeaveLogDetail(DataManagement, "<BSolver:SetD> Set S%u:T%u dirty", i, j);
-                    traitInstance[j].SetDirty();
+                    subHandler->SetTraitInstanceDirty(&traitInstance[j]);
+                    break;
                 }
             }
         }
     }
+#endif // WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
 
     return WEAVE_NO_ERROR;
 }
@@ -188,12 +210,108 @@ bool NotificationEngine::IntermediateGraphSolver::Store::IsPresent(TraitPath aIt
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // IntermediateGraphSolver
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+NotificationEngine::IntermediateGraphSolver::IntermediateGraphSolver()
+{
+    mNumDirtySets = 0;
+}
+
 bool NotificationEngine::IntermediateGraphSolver::IsPropertyPathSupported(PropertyPathHandle aHandle)
 {
     // The intermediate solver also only supports subscribing to root.
     return BasicGraphSolver::IsPropertyPathSupported(aHandle);
 }
 
+NotificationEngine::IntermediateGraphSolver::DirtySet *
+NotificationEngine::IntermediateGraphSolver::FindDirtySet(TraitDataHandle aDataHandle)
+{
+    for (uint32_t i = 0; i < mNumDirtySets; i++)
+    {
+        if (mDirtySets[i].mTraitDataHandle == aDataHandle)
+        {
+            return &mDirtySets[i];
+        }
+    }
+
+    return NULL;
+}
+
+bool NotificationEngine::IntermediateGraphSolver::SetDirtyInDirtySet(TraitDataSource * aDataSource, TraitDataHandle aDataHandle,
+                                                                     PropertyPathHandle aPropertyHandle)
+{
+    const TraitSchemaEngine * schemaEngine = aDataSource->GetSchemaEngine();
+    DirtySet * dirtySet;
+
+    // Handles within dictionary elements carry a dictionary key that a schema handle bitset cannot represent.
+    if (GetPropertyDictionaryKey(aPropertyHandle) != 0)
+    {
+        return false;
+    }
+
+    if (schemaEngine->mSchema.mNumSchemaHandleEntries + TraitSchemaEngine::kHandleTableOffset >
+        WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_SCHEMA_HANDLES)
+    {
+        return false;
+    }
+
+    dirtySet = FindDirtySet(aDataHandle);
+
+    if (dirtySet == NULL)
+    {
+        if (mNumDirtySets >= WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_DIRTY_TRAIT_INSTANCES)
+        {
+            WeaveLogDetail(DataManagement, "<ISolver:SetDirty> No more dirty sets, using granular store");
+            return false;
+        }
+
+        dirtySet                   = &mDirtySets[mNumDirtySets++];
+        dirtySet->mTraitDataHandle = aDataHandle;
+        memset(dirtySet->mBits, 0, sizeof(dirtySet->mBits));
+    }
+
+    if (dirtySet->IsSet(GetPropertySchemaHandle(aPropertyHandle)))
+    {
+        WeaveLogDetail(DataManagement, "<ISolver:SetDirty> Previously dirty");
+    }
+
+    dirtySet->Set(GetPropertySchemaHandle(aPropertyHandle));
+
+    return true;
+}
+
+void NotificationEngine::IntermediateGraphSolver::RemoveDirtySet(TraitDataHandle aDataHandle)
+{
+    DirtySet * dirtySet = FindDirtySet(aDataHandle);
+
+    if (dirtySet != NULL)
+    {
+        *dirtySet = mDirtySets[--mNumDirtySets];
+    }
+}
+
+/**
+ * Returns true if a strict ancestor of the given handle is marked dirty in the given dirty set. The data element generated for
+ * that ancestor already includes the handle, so the handle need not be considered separately.
+ */
+bool NotificationEngine::IntermediateGraphSolver::IsCoveredByDirtySet(const DirtySet * aDirtySet,
+                                                                      const TraitSchemaEngine * aSchemaEngine,
+                                                                      PropertyPathHandle aHandle)
+{
+    if (aDirtySet == NULL)
+    {
+        return false;
+    }
+
+    while ((aHandle = aSchemaEngine->GetParent(aHandle)) != kNullPropertyPathHandle)
+    {
+        if (GetPropertyDictionaryKey(aHandle) == 0 && aDirtySet->IsSet(GetPropertySchemaHandle(aHandle)))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 #if TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
 WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::DeleteKey(TraitDataHandle aDataHandle, PropertyPathHandle aPropertyHandle)
 {
@@ -232,6 +350,7 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::DeleteKey(TraitDataHand
         WeaveLogDetail(DataManagement, "<ISolver:DeleteKey> No more space in granular store!");
 
         mDeleteStore.RemoveItem(aDataHandle);
+        RemoveDirtySet(aDataHandle);
 
         // Mark the data source is being entirely dirty.
         dataSource->SetRootDirty();
@@ -284,6 +403,10 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::SetDirty(TraitDataHandl
     VerifyOrExit(!dataSource->IsRootDirty(), WeaveLogDetail(DataManagement, "<ISolver:SetDirty> Already root dirty!");
                  err = WEAVE_NO_ERROR);
 
+    // Handles outside of dictionary elements are recorded in the trait instance's dirty set if one is available. Such handles
+    // never match an entry in the delete store, which only holds dictionary elements.
+    VerifyOrExit(!SetDirtyInDirtySet(dataSource, aDataHandle, aPropertyHandle), /* no-op */);
+
     // if previously present in the delete store, nothing more to be done!
     if (mDirtyStore.IsPresent(TraitPath(aDataHandle, aPropertyHandle)))
     {
@@ -298,6 +421,7 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::SetDirty(TraitDataHandl
         WeaveLogDetail(DataManagement, "<ISolver:SetDirty> No more space in granular store!");
 
         mDirtyStore.RemoveItem(aDataHandle);
+        RemoveDirtySet(aDataHandle);
 
         // Mark the data source is being entirely dirty.
         dataSource->SetRootDirty();
@@ -338,17 +462,52 @@ exit:
     return err;
 }
 
+/**
+ * Returns the next dirty or deleted handle of the given trait instance, starting at the given cursor. The cursor first walks the
+ * trait instance's dirty set, then the dirty store and finally the delete store. Handles that have a dirty ancestor in the dirty
+ * set are skipped since the data element for that ancestor already covers them.
+ */
 PropertyPathHandle NotificationEngine::IntermediateGraphSolver::GetNextCandidateHandle(uint32_t & aChangeStoreCursor,
                                                                                        TraitDataHandle aTargetDataHandle,
+                                                                                       const TraitSchemaEngine * aSchemaEngine,
+                                                                                       const DirtySet * aDirtySet,
                                                                                        bool & aCandidateHandleIsDelete)
 {
+    const uint32_t dirtySetSize        = WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_SCHEMA_HANDLES;
     PropertyPathHandle candidateHandle = kNullPropertyPathHandle;
 
-    while (aChangeStoreCursor < mDirtyStore.GetStoreSize())
+    if (aDirtySet == NULL && aChangeStoreCursor < dirtySetSize)
+    {
+        aChangeStoreCursor = dirtySetSize;
+    }
+
+    while (aChangeStoreCursor < dirtySetSize)
+    {
+        PropertySchemaHandle schemaHandle = static_cast<PropertySchemaHandle>(aChangeStoreCursor);
+
+        // Skip over clean bytes of the bitset a byte at a time.
+        if ((schemaHandle % 8) == 0 && aDirtySet->mBits[schemaHandle / 8] == 0)
+        {
+            aChangeStoreCursor = (aChangeStoreCursor + 8 < dirtySetSize) ? aChangeStoreCursor + 8 : dirtySetSize;
+            continue;
+        }
+
+        aChangeStoreCursor++;
+
+        if (aDirtySet->IsSet(schemaHandle) && !IsCoveredByDirtySet(aDirtySet, aSchemaEngine, schemaHandle))
+        {
+            candidateHandle          = CreatePropertyPathHandle(schemaHandle);
+            aCandidateHandleIsDelete = false;
+            return candidateHandle;
+        }
+    }
+
+    while (aChangeStoreCursor >= dirtySetSize && aChangeStoreCursor < (dirtySetSize + mDirtyStore.GetStoreSize()))
     {
-        TraitPath dirtyPath = mDirtyStore.mStore[aChangeStoreCursor];
+        TraitPath dirtyPath = mDirtyStore.mStore[aChangeStoreCursor - dirtySetSize];
 
-        if (mDirtyStore.mValidFlags[aChangeStoreCursor] && (dirtyPath.mTraitDataHandle == aTargetDataHandle))
+        if (mDirtyStore.mValidFlags[aChangeStoreCursor - dirtySetSize] && (dirtyPath.mTraitDataHandle == aTargetDataHandle) &&
+            !IsCoveredByDirtySet(aDirtySet, aSchemaEngine, dirtyPath.mPropertyPathHandle))
         {
             candidateHandle          = dirtyPath.mPropertyPathHandle;
             aCandidateHandleIsDelete = false;
@@ -360,13 +519,14 @@ PropertyPathHandle NotificationEngine::IntermediateGraphSolver::GetNextCandidate
     }
 
 #if TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
-    while (aChangeStoreCursor >= mDirtyStore.GetStoreSize() &&
-           aChangeStoreCursor < (mDeleteStore.GetStoreSize() + mDirtyStore.GetStoreSize()))
+    while (candidateHandle == kNullPropertyPathHandle &&
+           aChangeStoreCursor >= (dirtySetSize + mDirtyStore.GetStoreSize()) &&
+           aChangeStoreCursor < (dirtySetSize + mDirtyStore.GetStoreSize() + mDeleteStore.GetStoreSize()))
     {
-        TraitPath deletePath = mDeleteStore.mStore[aChangeStoreCursor - mDirtyStore.GetStoreSize()];
+        uint32_t deleteStoreIndex = aChangeStoreCursor - dirtySetSize - mDirtyStore.GetStoreSize();
+        TraitPath deletePath      = mDeleteStore.mStore[deleteStoreIndex];
 
-        if (mDeleteStore.mValidFlags[aChangeStoreCursor - mDirtyStore.GetStoreSize()] &&
-            (deletePath.mTraitDataHandle == aTargetDataHandle))
+        if (mDeleteStore.mValidFlags[deleteStoreIndex] && (deletePath.mTraitDataHandle == aTargetDataHandle))
         {
             candidateHandle          = deletePath.mPropertyPathHandle;
             aCandidateHandleIsDelete = true;
@@ -393,13 +553,16 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::RetrieveTraitInstanceDa
     PropertyPathHandle currentCommonHandle                                                     = kNullPropertyPathHandle;
     TraitDataSource * dataSource;
     const TraitSchemaEngine * schemaEngine;
+    const DirtySet * dirtySet;
 
     err = SubscriptionEngine::GetInstance()->mPublisherCatalog->Locate(aTraitDataHandle, &dataSource);
     SuccessOrExit(err);
 
     schemaEngine = dataSource->GetSchemaEngine();
-    WeaveLogDetail(DataManagement, "<ISolver::Retr> CurDirtyItems = %u/%u", mDirtyStore.GetNumItems(),
-                   WDM_PUBLISHER_MAX_ITEMS_IN_TRAIT_DIRTY_STORE);
+    dirtySet     = FindDirtySet(aTraitDataHandle);
+    WeaveLogDetail(DataManagement, "<ISolver::Retr> CurDirtyItems = %u/%u, CurDirtySets = %u/%u", mDirtyStore.GetNumItems(),
+                   WDM_PUBLISHER_MAX_ITEMS_IN_TRAIT_DIRTY_STORE, mNumDirtySets,
+                   WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_DIRTY_TRAIT_INSTANCES);
 
 #if TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
     WeaveLogDetail(DataManagement, "<ISolver::Retr> CurDeleteItems = %u/%u", mDeleteStore.GetNumItems(),
@@ -468,8 +631,8 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::RetrieveTraitInstanceDa
         //      mergeHandleSet = set of handles that will be merged in relative to the currentCommonHandle. If empty, all children
         //                   under the commonHandle will be included.
         //
-        while ((candidateHandle = GetNextCandidateHandle(changeStoreCursor, aTraitDataHandle, candidateHandleIsDelete)) !=
-               kNullPropertyPathHandle)
+        while ((candidateHandle = GetNextCandidateHandle(changeStoreCursor, aTraitDataHandle, schemaEngine, dirtySet,
+                                                         candidateHandleIsDelete)) != kNullPropertyPathHandle)
         {
             oldCandidateHandleIsDelete = candidateHandleIsDelete;
 
@@ -713,6 +876,7 @@ WEAVE_ERROR NotificationEngine::IntermediateGraphSolver::ClearDirty()
 
     // Clear out our granular dirty store.
     mDirtyStore.Clear();
+    mNumDirtySets = 0;
 
 #if TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
     mDeleteStore.Clear();
@@ -956,6 +1120,19 @@ exit:
     return err;
 }
 
+WEAVE_ERROR NotificationEngine::NotifyRequestBuilder::WriteEncodedDataElement(const uint8_t * aData, uint16_t aDataLen)
+{
+    WEAVE_ERROR err;
+
+    VerifyOrExit(mState == kNotifyRequestBuilder_BuildDataList, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    err = mWriter->CopyContainer(AnonymousTag, aData, aDataLen);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
 WEAVE_ERROR NotificationEngine::NotifyRequestBuilder::MoveToState(NotifyRequestBuilderState aDesiredState)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -1024,6 +1201,68 @@ WEAVE_ERROR NotificationEngine::NotifyRequestBuilder::Rollback(TLVWriter & aPoin
     *mWriter        = aPoint;
     return err;
 }
+
+#if WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE > 0
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DataElementCache
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+NotificationEngine::DataElementCache::DataElementCache()
+{
+    Clear();
+}
+
+void NotificationEngine::DataElementCache::Clear()
+{
+    mNumEntries = 0;
+    mUsedLength = 0;
+}
+
+bool NotificationEngine::DataElementCache::Lookup(TraitDataHandle aTraitDataHandle, SchemaVersion aSchemaVersion,
+                                                  bool aRetrieveAll, DataVersion aVersion, const uint8_t *& aData,
+                                                  uint16_t & aDataLen) const
+{
+    for (uint16_t i = 0; i < mNumEntries; i++)
+    {
+        const Entry & entry = mEntries[i];
+
+        if (entry.mTraitDataHandle == aTraitDataHandle && entry.mSchemaVersion == aSchemaVersion &&
+            entry.mRetrieveAll == aRetrieveAll && entry.mVersion == aVersion)
+        {
+            aData    = mBuffer + entry.mOffset;
+            aDataLen = entry.mLength;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void NotificationEngine::DataElementCache::Add(TraitDataHandle aTraitDataHandle, SchemaVersion aSchemaVersion, bool aRetrieveAll,
+                                               DataVersion aVersion, const uint8_t * aData, uint32_t aDataLen)
+{
+    Entry * entry;
+
+    // Data elements that do not fit are not cached; they are simply regenerated for every subscription.
+    VerifyOrExit(mNumEntries < WDM_PUBLISHER_DATA_ELEMENT_CACHE_MAX_ENTRIES, /* no-op */);
+    VerifyOrExit(aDataLen <= static_cast<uint32_t>(sizeof(mBuffer) - mUsedLength), /* no-op */);
+
+    entry                   = &mEntries[mNumEntries++];
+    entry->mVersion         = aVersion;
+    entry->mTraitDataHandle = aTraitDataHandle;
+    entry->mSchemaVersion   = aSchemaVersion;
+    entry->mRetrieveAll     = aRetrieveAll;
+    entry->mOffset          = mUsedLength;
+    entry->mLength          = static_cast<uint16_t>(aDataLen);
+
+    memcpy(mBuffer + mUsedLength, aData, aDataLen);
+    mUsedLength += static_cast<uint16_t>(aDataLen);
+
+exit:
+    return;
+}
+#endif // WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE > 0
+
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // NotificationEngine
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1033,6 +1272,9 @@ WEAVE_ERROR NotificationEngine::Init()
     mCurSubscriptionHandlerIdx = 0;
     mCurTraitInstanceIdx       = 0;
     mNumNotifiesInFlight       = 0;
+#if WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+    mNumPendingNotifies        = 0;
+#endif
 
     return WEAVE_NO_ERROR;
 }
@@ -1097,16 +1339,79 @@ WEAVE_ERROR NotificationEngine::RetrieveTraitInstanceData(SubscriptionHandler *
                                                           SubscriptionHandler::TraitInstanceInfo * aTraitInfo,
                                                           NotifyRequestBuilder * aBuilder, bool * aPacketFull)
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WEAVE_ERROR err   = WEAVE_NO_ERROR;
+    bool retrieveAll  = aSubHandler->IsSubscribing();
+#if WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE > 0
+    TraitDataSource * dataSource;
+    const uint8_t * encodedData;
+    uint16_t encodedDataLen;
+    uint32_t startLen;
+#endif
 
     *aPacketFull = false;
 
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    // If the subscriber already holds an older version of this trait instance that the data source still has history for, only
+    // the part that changed since needs to be sent.
+    if (retrieveAll && aTraitInfo->mSubscriberVersion != 0)
+    {
+        TraitDataSource * historySource;
+        PropertyPathHandle changedHandle;
+
+        err = SubscriptionEngine::GetInstance()->mPublisherCatalog->Locate(aTraitInfo->mTraitDataHandle, &historySource);
+        SuccessOrExit(err);
+
+        if (historySource->GetChangedHandleSince(aTraitInfo->mSubscriberVersion, changedHandle) &&
+            changedHandle != kRootPropertyPathHandle)
+        {
+            WeaveLogDetail(DataManagement, "Syncing trait[%u] from path[%u] only", aTraitInfo->mTraitDataHandle, changedHandle);
+
+            err = aBuilder->WriteDataElement(aTraitInfo->mTraitDataHandle, changedHandle, aTraitInfo->mRequestedVersion, NULL, 0,
+                                             NULL, 0);
+            SuccessOrExit(err);
+
+            aTraitInfo->mSubscriberVersion = 0;
+            aSubHandler->ClearTraitInstanceDirty(aTraitInfo);
+            ExitNow();
+        }
+    }
+#endif // WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+
+#if WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE > 0
+    err = SubscriptionEngine::GetInstance()->mPublisherCatalog->Locate(aTraitInfo->mTraitDataHandle, &dataSource);
+    SuccessOrExit(err);
+
+    // Another subscription may already have had this data element generated in the current evaluation cycle.
+    if (mDataElementCache.Lookup(aTraitInfo->mTraitDataHandle, aTraitInfo->mRequestedVersion, retrieveAll,
+                                 dataSource->GetVersion(), encodedData, encodedDataLen))
+    {
+        err = aBuilder->WriteEncodedDataElement(encodedData, encodedDataLen);
+        SuccessOrExit(err);
+    }
+    else
+    {
+        encodedData = aBuilder->GetWritePoint();
+        startLen    = aBuilder->GetWriter()->GetLengthWritten();
+
+        err = mGraphSolver.RetrieveTraitInstanceData(aBuilder, aTraitInfo->mTraitDataHandle, aTraitInfo->mRequestedVersion,
+                                                     retrieveAll);
+        SuccessOrExit(err);
+
+        mDataElementCache.Add(aTraitInfo->mTraitDataHandle, aTraitInfo->mRequestedVersion, retrieveAll, dataSource->GetVersion(),
+                              encodedData, aBuilder->GetWriter()->GetLengthWritten() - startLen);
+    }
+#else
     err = mGraphSolver.RetrieveTraitInstanceData(aBuilder, aTraitInfo->mTraitDataHandle, aTraitInfo->mRequestedVersion,
-                                                 aSubHandler->IsSubscribing());
+                                                 retrieveAll);
     SuccessOrExit(err);
+#endif // WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE > 0
 
     // Clear out the dirty bit since we're done processing this trait instance.
-    aTraitInfo->ClearDirty();
+    aSubHandler->ClearTraitInstanceDirty(aTraitInfo);
+
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    aTraitInfo->mSubscriberVersion = 0;
+#endif
 
 exit:
     if ((err == WEAVE_ERROR_BUFFER_TOO_SMALL) || (err == WEAVE_ERROR_NO_MEMORY))
@@ -1136,6 +1441,54 @@ exit:
     return err;
 }
 
+#if WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+/**
+ * Hold on to a built notify until the end of the current Run, when SendPendingNotifies sends it without the publisher lock
+ * held. The notify counts as in flight, and the subscription stays out of the evaluation until it has been sent.
+ */
+void NotificationEngine::QueueNotify(PacketBuffer * aBuffer, SubscriptionHandler * aSubHandler)
+{
+    VerifyOrDie(mNumPendingNotifies < WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT);
+
+    mNumNotifiesInFlight++;
+
+    aSubHandler->_AddRef();
+    aSubHandler->mIsNotifySendPending = true;
+
+    mPendingNotifies[mNumPendingNotifies].mSubHandler = aSubHandler;
+    mPendingNotifies[mNumPendingNotifies].mBuf        = aBuffer;
+    mNumPendingNotifies++;
+}
+
+void NotificationEngine::SendPendingNotifies(void)
+{
+    WEAVE_ERROR err;
+
+    for (uint32_t i = 0; i < mNumPendingNotifies; i++)
+    {
+        SubscriptionHandler * const subHandler = mPendingNotifies[i].mSubHandler;
+
+        subHandler->mIsNotifySendPending = false;
+
+        // SendNotify accounts for the notify in flight again.
+        mNumNotifiesInFlight--;
+
+        WeaveLogDetail(DataManagement, "<NE:Run> Sending notify...");
+
+        err = SendNotify(mPendingNotifies[i].mBuf, subHandler);
+        if (err != WEAVE_NO_ERROR)
+        {
+            WeaveLogError(DataManagement, "<NE:Run> Error sending out notify!");
+            subHandler->TerminateSubscription(err, NULL, false);
+        }
+
+        subHandler->_Release();
+    }
+
+    mNumPendingNotifies = 0;
+}
+#endif // WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+
 void NotificationEngine::OnNotifyConfirm(SubscriptionHandler * aSubHandler, bool aNotifyDelivered)
 {
     VerifyOrDie(mNumNotifiesInFlight > 0);
@@ -1406,7 +1759,8 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequestDataList(SubscriptionHan
     SubscriptionHandler::TraitInstanceInfo * traitInfo =
         aSubHandler->GetTraitInstanceInfoList() + aSubHandler->mCurProcessingTraitInstanceIdx;
 
-    while (aSubHandler->mCurProcessingTraitInstanceIdx < aSubHandler->GetNumTraitInstances())
+    // Stop as soon as no dirty trait instances remain rather than walking the rest of the list.
+    while (aSubHandler->IsTraitDataDirty() && aSubHandler->mCurProcessingTraitInstanceIdx < aSubHandler->GetNumTraitInstances())
     {
         if (traitInfo->IsDirty())
         {
@@ -1436,7 +1790,7 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequestDataList(SubscriptionHan
                 if (!aNeWriteInProgress)
                 {
                     WeaveLogDetail(DataManagement, "<NE:Run> trait property is too big so that it fails to fit in the packet");
-                    traitInfo->ClearDirty();
+                    aSubHandler->ClearTraitInstanceDirty(traitInfo);
                 }
                 else
                 {
@@ -1454,7 +1808,11 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequestDataList(SubscriptionHan
     }
 
     // Only do this if our sub handler is still valid at this point (which it may not be)
-    if (aSubHandler->GetNumTraitInstances())
+    if (!aSubHandler->IsTraitDataDirty())
+    {
+        aSubHandler->mCurProcessingTraitInstanceIdx = 0;
+    }
+    else if (aSubHandler->GetNumTraitInstances())
     {
         aSubHandler->mCurProcessingTraitInstanceIdx %= aSubHandler->GetNumTraitInstances();
     }
@@ -1515,6 +1873,7 @@ exit:
 WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequest(SubscriptionHandler * aSubHandler, bool & aSubscriptionHandled,
                                                          bool & aIsSubscriptionClean)
 {
+    WEAVE_PERF_SCOPE(kSection_WDMNotifyBuild);
     WEAVE_ERROR err    = WEAVE_NO_ERROR;
     PacketBuffer * buf = NULL;
     TLVWriter writer;
@@ -1534,6 +1893,16 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequest(SubscriptionHandler * a
         aSubscriptionHandled = false;
     }
 
+    // Don't allocate a buffer for a subscription that has nothing to send.
+    if (aIsSubscriptionClean && !aSubHandler->IsTraitDataDirty())
+    {
+#if WEAVE_CONFIG_EVENT_LOGGING_WDM_OFFLOAD
+        VerifyOrExit(aSubHandler->mSubscribeToAllEvents, /* no-op */);
+#else
+        ExitNow();
+#endif
+    }
+
     maxNotificationSize = aSubHandler->GetMaxNotificationSize();
 
     err = aSubHandler->mBinding->AllocateRightSizedBuffer(buf, maxNotificationSize, WDM_MIN_NOTIFICATION_SIZE, maxPayloadSize);
@@ -1574,6 +1943,17 @@ WEAVE_ERROR NotificationEngine::BuildSingleNotifyRequest(SubscriptionHandler * a
     // request builder should be dead.
     if (neWriteInProgress && buf)
     {
+#if WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+        // Notifies that are part of establishing a subscription are sent right away, since whether the subscribe response
+        // goes out next depends on the handler state they leave behind.
+        if (aSubHandler->IsEstablishedIdle())
+        {
+            QueueNotify(buf, aSubHandler);
+            buf = NULL;
+            ExitNow();
+        }
+#endif // WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+
         WeaveLogDetail(DataManagement, "<NE:Run> Sending notify...");
 
         err = SendNotify(buf, aSubHandler);
@@ -1719,6 +2099,8 @@ void NotificationEngine::ScheduleRun()
 
 void NotificationEngine::Run()
 {
+    SYSTEM_TRACE_SCOPE("DataManagement", "NotificationEngine::Run");
+
     WEAVE_ERROR err                  = WEAVE_NO_ERROR;
     uint32_t numSubscriptionsHandled = 0;
     SubscriptionEngine * subEngine   = SubscriptionEngine::GetInstance();
@@ -1733,6 +2115,11 @@ void NotificationEngine::Run()
 
     isLocked = true;
 
+#if WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE > 0
+    // Data elements cached during a previous cycle may predate changes made since.
+    mDataElementCache.Clear();
+#endif
+
     WeaveLogDetail(DataManagement, "<NE:Run> NotifiesInFlight = %u", mNumNotifiesInFlight);
 
     while ((mNumNotifiesInFlight < WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT) &&
@@ -1747,7 +2134,13 @@ void NotificationEngine::Run()
                            mCurSubscriptionHandlerIdx, subHandler->GetStateStr(), subHandler->GetNumTraitInstances());
         }
 
-        if (subHandler->IsNotifiable())
+        if (subHandler->IsNotifiable() && subHandler->IsTraitDataDirty() && subHandler->ShouldHoldOffNotify())
+        {
+            // Leave the subscription dirty. Its hold-off timer runs the engine again once the minimum notify interval has
+            // elapsed, and the changes accumulated until then go out in a single notify.
+            WeaveLogDetail(DataManagement, "<NE:Run> Subscription %u notify held off", mCurSubscriptionHandlerIdx);
+        }
+        else if (subHandler->IsNotifiable())
         {
             // This is needed because some error could trigger abort on subscription, which leads to destroy of the handler
             subHandler->_AddRef();
@@ -1779,24 +2172,16 @@ void NotificationEngine::Run()
     subHandler = subEngine->mHandlers;
     isClean    = true;
 
-    // We only wipe our granular dirty stores if all the subscriptions are clean. To do so, we iterate over
-    // all of them and check each of their dirty flags.
+    // We only wipe our granular dirty stores if all the subscriptions are clean. Each subscription tracks how many of its trait
+    // instances are dirty, so there is no need to walk their trait instance lists.
     for (int i = 0; i < SubscriptionEngine::kMaxNumSubscriptionHandlers; i++)
     {
-        if (subHandler->IsActive())
+        if (subHandler->IsActive() && subHandler->IsTraitDataDirty())
         {
-            SubscriptionHandler::TraitInstanceInfo * traitInfo = subHandler->GetTraitInstanceInfoList();
-            for (size_t j = 0; j < subHandler->GetNumTraitInstances(); j++)
-            {
-                if (traitInfo->IsDirty())
-                {
-                    WeaveLogDetail(DataManagement, "<NE:Run> S%u:T%u still dirty", i, j);
-                    isClean = false;
-                    break;
-                }
-
-                traitInfo++;
-            }
+            WeaveLogDetail(DataManagement, "<NE:Run> S%u still dirty (%u trait instances)", i,
+                           subHandler->mNumDirtyTraitInstances);
+            isClean = false;
+            break;
         }
 
         subHandler++;
@@ -1814,5 +2199,9 @@ exit:
         subEngine->Unlock();
     }
 
+#if WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+    SendPendingNotifies();
+#endif
+
     return;
 }
@@ -249,6 +249,24 @@ public:
 
         TLV::TLVWriter * GetWriter(void) { return mWriter; }
 
+        /**
+         * Returns a pointer to the location in the notify buffer where the next element will be written. Only valid while the
+         * notify is being built, i.e. before it is closed out by EndNotifyRequest().
+         */
+        const uint8_t * GetWritePoint(void) { return mBuf->Start() + mBuf->DataLength() + mWriter->GetLengthWritten(); }
+
+        /**
+         * Write out a data element that was previously encoded by WriteDataElement().
+         *
+         * @param[in] aData     The encoded data element.
+         * @param[in] aDataLen  The length of the encoded data element.
+         *
+         * @retval #WEAVE_NO_ERROR On success.
+         * @retval #WEAVE_ERROR_INCORRECT_STATE If the request is not at the DataList container.
+         * @retval other           Unable to write the data element.
+         */
+        WEAVE_ERROR WriteEncodedDataElement(const uint8_t * aData, uint16_t aDataLen);
+
         /**
          * The main state transition function. The function takes the desired state (i.e., the phase of the notify request builder
          * that we would like to reach), and transitions the request into that state. If the desired state is the same as the
@@ -323,6 +341,11 @@ public:
      *         of WDM to only include child trees of that LCA that contain dirty elements. This is pretty efficient given the
      *         reasonably flat, shallow structure of our IDLs.
      *
+     *         Dirty handles outside of dictionary elements are recorded in a per-trait-instance bitset indexed by property schema
+     *         handle, which makes marking and testing a handle O(1) and lets the solver skip handles already covered by a dirty
+     *         ancestor. Handles within dictionary elements (which carry a dictionary key), and handles of trait instances for which
+     *         no bitset is available, go into the granular store.
+     *
      *         If it is unable to store anymore dirty items in the granular store, it will degrade to marking the entire trait
      *         instance as dirty. In addition, if it runs out of space in the merge handle set, it will degrade to including all
      *         child trees of the LCA'ed node.
@@ -331,6 +354,7 @@ public:
     class IntermediateGraphSolver
     {
     public:
+        IntermediateGraphSolver(void);
         static bool IsPropertyPathSupported(PropertyPathHandle aHandle);
         WEAVE_ERROR RetrieveTraitInstanceData(NotifyRequestBuilder * aBuilder, TraitDataHandle aTraitDataHandle,
                                               SchemaVersion aSchemaVersion, bool aRetrieveAll);
@@ -360,23 +384,82 @@ public:
             uint32_t mNumItems;
         };
 
+        struct DirtySet
+        {
+        public:
+            bool IsSet(PropertySchemaHandle aHandle) const { return (mBits[aHandle / 8] & (1 << (aHandle % 8))) != 0; }
+            void Set(PropertySchemaHandle aHandle) { mBits[aHandle / 8] |= static_cast<uint8_t>(1 << (aHandle % 8)); }
+
+            TraitDataHandle mTraitDataHandle;
+            uint8_t mBits[(WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_SCHEMA_HANDLES + 7) / 8];
+        };
+
     private:
         static void ClearTraitInstanceDirty(void * aDataSource, TraitDataHandle aDataHandle, void * aContext);
         PropertyPathHandle GetNextCandidateHandle(uint32_t & aChangeStoreCursor, TraitDataHandle aTargetDataHandle,
+                                                  const TraitSchemaEngine * aSchemaEngine, const DirtySet * aDirtySet,
                                                   bool & aCandidateHandleIsDelete);
 
+        DirtySet * FindDirtySet(TraitDataHandle aDataHandle);
+        bool SetDirtyInDirtySet(TraitDataSource * aDataSource, TraitDataHandle aDataHandle, PropertyPathHandle aPropertyHandle);
+        void RemoveDirtySet(TraitDataHandle aDataHandle);
+        static bool IsCoveredByDirtySet(const DirtySet * aDirtySet, const TraitSchemaEngine * aSchemaEngine,
+                                        PropertyPathHandle aHandle);
+
         Store mDirtyStore;
+        DirtySet mDirtySets[WDM_PUBLISHER_INTERMEDIATE_SOLVER_MAX_DIRTY_TRAIT_INSTANCES];
+        uint32_t mNumDirtySets;
 
 #if TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
         Store mDeleteStore;
 #endif
     };
 
+#if WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE > 0
+    /*
+     *  @class DataElementCache
+     *
+     *  @brief Holds the data elements encoded during a single evaluation cycle of the engine. Within a cycle, the dirty stores
+     *         and trait data are stable (both are only modified with the subscription engine locked), so the data element the
+     *         solver generates for a trait instance depends only on the trait instance, the requested schema version, whether
+     *         the whole instance was requested, and the data version. Subscriptions that share those copy the cached encoding.
+     *
+     *         Entries are never evicted; once the cache is full, further data elements are simply not cached.
+     */
+    class DataElementCache
+    {
+    public:
+        DataElementCache(void);
+        void Clear(void);
+        bool Lookup(TraitDataHandle aTraitDataHandle, SchemaVersion aSchemaVersion, bool aRetrieveAll, DataVersion aVersion,
+                    const uint8_t *& aData, uint16_t & aDataLen) const;
+        void Add(TraitDataHandle aTraitDataHandle, SchemaVersion aSchemaVersion, bool aRetrieveAll, DataVersion aVersion,
+                 const uint8_t * aData, uint32_t aDataLen);
+
+    private:
+        struct Entry
+        {
+            DataVersion mVersion;
+            TraitDataHandle mTraitDataHandle;
+            SchemaVersion mSchemaVersion;
+            bool mRetrieveAll;
+            uint16_t mOffset;
+            uint16_t mLength;
+        };
+
+        Entry mEntries[WDM_PUBLISHER_DATA_ELEMENT_CACHE_MAX_ENTRIES];
+        uint8_t mBuffer[WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE];
+        uint16_t mNumEntries;
+        uint16_t mUsedLength;
+    };
+#endif // WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE > 0
+
 private:
     friend class SubscriptionHandler;
     friend class UpdateClient;
     friend class TestTdm;
     friend class TestWdm;
+    friend class BenchWdm;
 
     /**
      * Should be invoked when the device receives a NotifyConfirm, or when the Notify request times out.
@@ -398,6 +481,22 @@ private:
                                           NotifyRequestBuilder * aBuilder, bool * aPacketFull);
     WEAVE_ERROR SendNotify(PacketBuffer * aBuf, SubscriptionHandler * aSubHandler);
 
+#if WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+    struct PendingNotify
+    {
+        SubscriptionHandler * mSubHandler;
+        PacketBuffer * mBuf;
+    };
+
+    void QueueNotify(PacketBuffer * aBuf, SubscriptionHandler * aSubHandler);
+    void SendPendingNotifies(void);
+
+    // Notifies built during Run and sent once the publisher lock is released. Every queued notify counts as in flight,
+    // so there can be no more of them than WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT.
+    PendingNotify mPendingNotifies[WDM_PUBLISHER_MAX_NOTIFIES_IN_FLIGHT];
+    uint32_t mNumPendingNotifies;
+#endif // WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+
     WEAVE_ERROR SendNotifyRequest();
 
     static void Run(System::Layer * aSystemLayer, void * aAppState, System::Error);
@@ -411,6 +510,9 @@ private:
     uint32_t mNumNotifiesInFlight;
     nl::Weave::TLV::TLVType mOuterContainerType;
     WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER mGraphSolver;
+#if WDM_PUBLISHER_DATA_ELEMENT_CACHE_SIZE > 0
+    DataElementCache mDataElementCache;
+#endif
 };
 
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
@@ -85,15 +85,21 @@ void SubscriptionClient::Reset(void)
     mSubscriptionId                         = 0;
     mConfig                                 = kConfig_Down;
     mRetryCounter                           = 0;
+    mRetryAfterHintMsec                     = 0;
+#if WDM_MAX_CONCURRENT_RESUBSCRIBES
+    mHoldsResubscribeSlot                   = false;
+    mWaitingForResubscribeSlot              = false;
+#endif // WDM_MAX_CONCURRENT_RESUBSCRIBES
 
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
     mUpdateMutex                            = NULL;
-    mUpdateInFlight                         = false;
     mMaxUpdateSize                          = 0;
-    mUpdateRequestContext.Reset();
     mPendingSetState = kPendingSetEmpty;
     mPendingUpdateSet.Init(mPendingStore, ArraySize(mPendingStore));
-    mInProgressUpdateList.Init(mInProgressStore, ArraySize(mInProgressStore));
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        mUpdateSlots[i].Reset();
+    }
     mUpdateRetryCounter                     = 0;
     mUpdateRetryScheduled                   = false;
     mUpdateFlushScheduled                   = false;
@@ -143,8 +149,11 @@ WEAVE_ERROR SubscriptionClient::Init(Binding * const apBinding, void * const apA
 
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
     mUpdateMutex                            = aUpdateMutex;
-    mUpdateInFlight                         = false;
     mMaxUpdateSize                          = 0;
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        mUpdateSlots[i].mInFlight = false;
+    }
 
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
     MoveToState(kState_Initialized);
@@ -153,8 +162,11 @@ WEAVE_ERROR SubscriptionClient::Init(Binding * const apBinding, void * const apA
 
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
 
-    err = mUpdateClient.Init(mBinding, this, UpdateEventCallback);
-    SuccessOrExit(err);
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        err = mUpdateSlots[i].mUpdateClient.Init(mBinding, this, UpdateEventCallback);
+        SuccessOrExit(err);
+    }
 
     ConfigureUpdatableSinks();
 
@@ -207,6 +219,22 @@ const char * SubscriptionClient::GetStateStr() const
 void SubscriptionClient::MoveToState(const ClientState aTargetState)
 {
     mCurrentState = aTargetState;
+
+#if WDM_MAX_CONCURRENT_RESUBSCRIBES
+    if (aTargetState != kState_Resubscribe_Holdoff)
+    {
+        mWaitingForResubscribeSlot = false;
+    }
+
+    // A resubscribe attempt goes through Initialized (while the binding is prepared) and the
+    // Subscribing states; any other state means the attempt is over.
+    if (mHoldsResubscribeSlot && aTargetState != kState_Initialized && aTargetState != kState_Subscribing &&
+        aTargetState != kState_Subscribing_IdAssigned)
+    {
+        SubscriptionEngine::GetInstance()->ReleaseResubscribeSlot(this);
+    }
+#endif // WDM_MAX_CONCURRENT_RESUBSCRIBES
+
     WeaveLogDetail(DataManagement, "Client[%u] moving to [%5.5s] Ref(%d)", SubscriptionEngine::GetInstance()->GetClientId(this),
                    GetStateStr(), mRefCount);
 
@@ -355,6 +383,10 @@ void SubscriptionClient::DefaultResubscribePolicyCallback(void * const aAppState
         waitTimeInMsec    = minWaitTimeInMsec + (GetRandU32() % (maxWaitTimeInMsec - minWaitTimeInMsec));
     }
 
+    // Wait at least as long as the publisher asked; randomizing on top of that keeps
+    // the clients that received the same hint from coming back all at once.
+    waitTimeInMsec += aInParam.mRetryAfterMsec;
+
     aOutIntervalMsec = waitTimeInMsec;
 
     WeaveLogDetail(DataManagement,
@@ -366,6 +398,92 @@ void SubscriptionClient::DefaultResubscribePolicyCallback(void * const aAppState
     return;
 }
 
+/**
+ * @brief A policy implementing exponential backoff with "full jitter":
+ * the wait time is picked at random between 0 and a window that starts at
+ * WDM_RESUBSCRIBE_JITTER_BASE_MS and doubles at every retry, up to
+ * WDM_RESUBSCRIBE_MAX_RETRY_WAIT_INTERVAL_MS.
+ * Unlike the default policy, which never waits less than
+ * WDM_RESUBSCRIBE_MIN_WAIT_TIME_INTERVAL_PERCENT_PER_STEP percent of the window,
+ * this spreads the clients that failed together over the whole window.
+ * A retry-after hint received from the publisher is added to the random wait.
+ */
+void SubscriptionClient::JitteredResubscribePolicyCallback(void * const aAppState, ResubscribeParam & aInParam,
+                                                           uint32_t & aOutIntervalMsec)
+{
+    IgnoreUnusedVariable(aAppState);
+
+    uint64_t maxWaitTimeInMsec = WDM_RESUBSCRIBE_MAX_RETRY_WAIT_INTERVAL_MS;
+    uint32_t waitTimeInMsec    = 0;
+
+    if (aInParam.mNumRetries < 32)
+    {
+        maxWaitTimeInMsec = static_cast<uint64_t>(WDM_RESUBSCRIBE_JITTER_BASE_MS) << aInParam.mNumRetries;
+        if (maxWaitTimeInMsec > WDM_RESUBSCRIBE_MAX_RETRY_WAIT_INTERVAL_MS)
+        {
+            maxWaitTimeInMsec = WDM_RESUBSCRIBE_MAX_RETRY_WAIT_INTERVAL_MS;
+        }
+    }
+
+    if (maxWaitTimeInMsec != 0)
+    {
+        waitTimeInMsec = static_cast<uint32_t>(GetRandU32() % (maxWaitTimeInMsec + 1));
+    }
+
+    waitTimeInMsec += aInParam.mRetryAfterMsec;
+
+    aOutIntervalMsec = waitTimeInMsec;
+
+    WeaveLogDetail(DataManagement,
+                   "Computing jittered %s policy: attempts %" PRIu32 ", max wait time %" PRIu32 " ms, retry-after %" PRIu32
+                   " ms, selected wait time %" PRIu32 " ms",
+                   aInParam.mRequestType == ResubscribeParam::kSubscription ? "resubscribe" : "update",
+                   aInParam.mNumRetries, static_cast<uint32_t>(maxWaitTimeInMsec), aInParam.mRetryAfterMsec, waitTimeInMsec);
+}
+
+/**
+ * Extracts the retry-after hint (see kTag_StatusRetryAfterMsec) from the metadata of a StatusReport.
+ * Hints longer than WDM_RESUBSCRIBE_MAX_RETRY_WAIT_INTERVAL_MS are capped to it.
+ *
+ * @return the hint in milliseconds, or 0 if the StatusReport does not carry one.
+ */
+static uint32_t GetRetryAfterHint(const StatusReporting::StatusReport & aStatusReport)
+{
+    WEAVE_ERROR err         = WEAVE_NO_ERROR;
+    uint32_t retryAfterMsec = 0;
+    nl::Weave::TLV::TLVReader reader;
+    nl::Weave::TLV::TLVType containerType;
+
+    VerifyOrExit(aStatusReport.mAdditionalInfo.theLength > 0, );
+
+    reader.Init(aStatusReport.mAdditionalInfo.theData, aStatusReport.mAdditionalInfo.theLength);
+
+    err = reader.Next();
+    SuccessOrExit(err);
+    VerifyOrExit(reader.GetType() == nl::Weave::TLV::kTLVType_Structure, );
+
+    err = reader.EnterContainer(containerType);
+    SuccessOrExit(err);
+
+    while ((err = reader.Next()) == WEAVE_NO_ERROR)
+    {
+        if (reader.GetTag() == nl::Weave::TLV::ProfileTag(nl::Weave::Profiles::kWeaveProfile_WDM, kTag_StatusRetryAfterMsec))
+        {
+            err = reader.Get(retryAfterMsec);
+            SuccessOrExit(err);
+
+            if (retryAfterMsec > WDM_RESUBSCRIBE_MAX_RETRY_WAIT_INTERVAL_MS)
+            {
+                retryAfterMsec = WDM_RESUBSCRIBE_MAX_RETRY_WAIT_INTERVAL_MS;
+            }
+            break;
+        }
+    }
+
+exit:
+    return retryAfterMsec;
+}
+
 void SubscriptionClient::_InitiateSubscription(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -458,6 +576,8 @@ exit:
 
 WEAVE_ERROR SubscriptionClient::SendSubscribeRequest(void)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err       = WEAVE_NO_ERROR;
     PacketBuffer * msgBuf = NULL;
     uint8_t msgType       = kMsgType_SubscribeRequest;
@@ -873,6 +993,8 @@ void SubscriptionClient::FlushExistingExchangeContext(const bool aAbortNow)
  */
 WEAVE_ERROR SubscriptionClient::EndSubscription()
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WeaveLogDetail(DataManagement, "Client[%u] [%5.5s] %s Ref(%d)", SubscriptionEngine::GetInstance()->GetClientId(this),
                    GetStateStr(), __func__, mRefCount);
 
@@ -970,7 +1092,10 @@ void SubscriptionClient::_Cleanup(void)
     }
 
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
-    mUpdateClient.Shutdown();
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        mUpdateSlots[i].mUpdateClient.Shutdown();
+    }
 
     mDataSinkCatalog->Iterate(CleanupUpdatableSinkTrait, this);
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
@@ -1002,6 +1127,11 @@ void SubscriptionClient::AbortSubscription(void)
     // to the application (but not the SubscriptionTerminated event to the trait handlers).
     mConfig = kConfig_Down;
     TerminateSubscription(WEAVE_NO_ERROR, NULL, true);
+
+#if WDM_MAX_CONCURRENT_RESUBSCRIBES
+    // A resubscribe attempt aborted while the binding was being prepared is over too.
+    SubscriptionEngine::GetInstance()->ReleaseResubscribeSlot(this);
+#endif // WDM_MAX_CONCURRENT_RESUBSCRIBES
 }
 
 void SubscriptionClient::TerminateSubscription(WEAVE_ERROR aReason, StatusReporting::StatusReport * aStatusReport, bool suppressAppCallback)
@@ -1025,6 +1155,8 @@ void SubscriptionClient::TerminateSubscription(WEAVE_ERROR aReason, StatusReport
 
         MoveToState(kState_Terminated);
 
+        mRetryAfterHintMsec = (aStatusReport != NULL) ? GetRetryAfterHint(*aStatusReport) : 0;
+
         if (prevState >= kState_Subscribing && prevState <= kState_Canceling)
         {
 #if WDM_ENABLE_SUBSCRIPTION_PUBLISHER
@@ -1102,6 +1234,9 @@ void SubscriptionClient::SetRetryTimer(WEAVE_ERROR aReason)
         param.mNumRetries = mRetryCounter;
         param.mReason     = aReason;
         param.mRequestType = ResubscribeParam::kSubscription;
+        param.mRetryAfterMsec = mRetryAfterHintMsec;
+
+        mRetryAfterHintMsec = 0;
 
         mResubscribePolicyCallback(mAppState, param, timeoutMsec);
 
@@ -1129,6 +1264,26 @@ void SubscriptionClient::CancelSubscriptionTimer(void)
     SubscriptionEngine::GetInstance()->GetExchangeManager()->MessageLayer->SystemLayer->CancelTimer(OnTimerCallback, this);
 }
 
+#if WDM_MAX_CONCURRENT_RESUBSCRIBES
+/**
+ * Called by the SubscriptionEngine when a resubscribe slot this client was waiting for
+ * is released; ends the holdoff right away.
+ */
+void SubscriptionClient::OnResubscribeSlotAvailable(void)
+{
+    WEAVE_ERROR err;
+
+    mWaitingForResubscribeSlot = false;
+
+    err = SubscriptionEngine::GetInstance()->GetExchangeManager()->MessageLayer->SystemLayer->StartTimer(0, OnTimerCallback, this);
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(DataManagement, "Client[%u] failed to resume resubscribe: %s", SubscriptionEngine::GetInstance()->GetClientId(this),
+                      ErrorStr(err));
+    }
+}
+#endif // WDM_MAX_CONCURRENT_RESUBSCRIBES
+
 /**
  * Free a \c SubscriptionClient object.
  *
@@ -1172,7 +1327,7 @@ void SubscriptionClient::BindingEventCallback(void * const aAppState, const Bind
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
         if (pClient->IsUpdatePendingOrInProgress())
         {
-            if (false == pClient->IsUpdateInFlight())
+            if (pClient->HasIdleUpdateSlot())
             {
                 pClient->StartUpdateRetryTimer(WEAVE_NO_ERROR);
             }
@@ -1211,7 +1366,10 @@ void SubscriptionClient::BindingEventCallback(void * const aAppState, const Bind
 
         // Cancel any in-progress Update request and arrange to re-try it after a delay.
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
-        pClient->mUpdateClient.CancelUpdate();
+        for (size_t i = 0; i < ArraySize(pClient->mUpdateSlots); i++)
+        {
+            pClient->mUpdateSlots[i].mUpdateClient.CancelUpdate();
+        }
         if (pClient->IsUpdatePendingOrInProgress())
         {
             pClient->StartUpdateRetryTimer(aInParam.BindingFailed.Reason);
@@ -1320,8 +1478,17 @@ WEAVE_ERROR SubscriptionClient::RefreshTimer(void)
 
     if (isTimerNeeded)
     {
-        err = SubscriptionEngine::GetInstance()->GetExchangeManager()->MessageLayer->SystemLayer->StartTimer(timeoutMsec,
-                                                                                                             OnTimerCallback, this);
+        uint32_t toleranceMsec = 0;
+
+        // While idle, the liveness confirmation may go out early by up to the periodic timer tolerance, so that its timer can
+        // be coalesced with others.
+        if (kState_SubscriptionEstablished_Idle == mCurrentState)
+        {
+            toleranceMsec = timeoutMsec / 100 * WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT;
+        }
+
+        err = SubscriptionEngine::GetInstance()->GetExchangeManager()->MessageLayer->SystemLayer->StartTimer(
+            timeoutMsec - toleranceMsec, toleranceMsec, OnTimerCallback, this);
 
         VerifyOrExit(WEAVE_SYSTEM_NO_ERROR == err, /* no-op */);
     }
@@ -1334,6 +1501,8 @@ exit:
 
 void SubscriptionClient::TimerEventHandler(void)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err       = WEAVE_NO_ERROR;
     PacketBuffer * msgBuf = NULL;
     bool skipTimerCheck   = false;
@@ -1408,6 +1577,14 @@ void SubscriptionClient::TimerEventHandler(void)
         break;
 
     case kState_Resubscribe_Holdoff:
+#if WDM_MAX_CONCURRENT_RESUBSCRIBES
+        // Stay in holdoff until the engine hands over a slot.
+        if (!SubscriptionEngine::GetInstance()->AcquireResubscribeSlot(this))
+        {
+            break;
+        }
+#endif // WDM_MAX_CONCURRENT_RESUBSCRIBES
+
         mRetryCounter++;
 
         MoveToState(kState_Initialized);
@@ -1483,10 +1660,13 @@ exit:
 void SubscriptionClient::NotificationRequestHandler(nl::Weave::ExchangeContext * aEC, const nl::Inet::IPPacketInfo * aPktInfo,
                                                     const nl::Weave::WeaveMessageInfo * aMsgInfo, PacketBuffer * aPayload)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     InEventParam inParam;
     OutEventParam outParam;
     NotificationRequest::Parser notify;
+    NotificationRequest::Contents contents;
     const ClientState StateWhenEntered = mCurrentState;
     nl::Weave::TLV::TLVReader reader;
     bool isDataListPresent = false;
@@ -1569,26 +1749,25 @@ void SubscriptionClient::NotificationRequestHandler(nl::Weave::ExchangeContext *
     err = notify.Init(reader);
     SuccessOrExit(err);
 
-#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK && !WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK
     // simple schema checking
     err = notify.CheckSchemaValidity();
     SuccessOrExit(err);
-#endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+#endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK && !WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK
+
+    // locate all top-level fields of the notification in a single pass
+    err = notify.Decode(contents);
+    SuccessOrExit(err);
 
-    // TODO: use the new GetReaderOnXYZ pattern to locate the data list, instead creating a data list parser object
+    isDataListPresent = contents.IsPresent(NotificationRequest::Contents::kField_DataList);
+    if (isDataListPresent)
     {
         DataList::Parser dataList;
 
-        err = notify.GetDataList(&dataList);
-        if (WEAVE_NO_ERROR == err)
-        {
-            isDataListPresent = true;
-        }
-        else if (WEAVE_END_OF_TLV == err)
-        {
-            isDataListPresent = false;
-            err               = WEAVE_NO_ERROR;
-        }
+        err = contents.mDataList.GetReader(reader);
+        SuccessOrExit(err);
+
+        err = dataList.Init(reader);
         SuccessOrExit(err);
 
         // re-initialize the reader to point to individual data element (reuse to save stack depth).
@@ -1602,20 +1781,22 @@ void SubscriptionClient::NotificationRequestHandler(nl::Weave::ExchangeContext *
     }
 
 #if WEAVE_CONFIG_SERIALIZATION_ENABLE_DESERIALIZATION
+    isEventListPresent = contents.IsPresent(NotificationRequest::Contents::kField_EventList);
+    if (isEventListPresent)
     {
         EventList::Parser eventList;
 
-        err = notify.GetEventList(&eventList);
-        if (WEAVE_NO_ERROR == err)
-        {
-            isEventListPresent = true;
-        }
-        else if (WEAVE_END_OF_TLV == err)
-        {
-            isEventListPresent = false;
-            err                = WEAVE_NO_ERROR;
-        }
+        err = contents.mEventList.GetReader(reader);
+        SuccessOrExit(err);
+
+        err = eventList.Init(reader);
+        SuccessOrExit(err);
+
+#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK && WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK
+        // Data elements are validated as they are stored; the event list goes to the application as a whole.
+        err = eventList.CheckSchemaValidity();
         SuccessOrExit(err);
+#endif
 
         // re-initialize the reader (reuse to save stack depth).
         eventList.GetReader(&reader);
@@ -1688,6 +1869,8 @@ exit:
 void SubscriptionClient::CancelRequestHandler(nl::Weave::ExchangeContext * aEC, const nl::Inet::IPPacketInfo * aPktInfo,
                                               const nl::Weave::WeaveMessageInfo * aMsgInfo, PacketBuffer * aPayload)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err         = WEAVE_NO_ERROR;
     uint8_t statusReportLen = 6;
     PacketBuffer * msgBuf   = PacketBuffer::NewWithAvailableSize(statusReportLen);
@@ -2074,6 +2257,7 @@ void SubscriptionClient::StartUpdateRetryTimer(WEAVE_ERROR aReason)
     mUpdateRetryCounter++;
     param.mReason     = aReason;
     param.mRequestType = ResubscribeParam::kUpdate;
+    param.mRetryAfterMsec = 0;
 
     mResubscribePolicyCallback(mAppState, param, timeoutMsec);
 
@@ -2144,23 +2328,24 @@ void SubscriptionClient::SetMaxUpdateSize(const uint32_t aMaxSize)
 }
 
 /**
- * Move paths from the dispatched store back to the pending one.
+ * Move paths from the dispatched store of an UpdateSlot back to the pending one.
  * Skip the private ones, as they will be re-added during the recursion.
  */
-WEAVE_ERROR SubscriptionClient::MoveInProgressToPending(void)
+WEAVE_ERROR SubscriptionClient::MoveInProgressToPending(UpdateSlot & aSlot)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     uint32_t count = 0;
     TraitDataSink *dataSink;
     TraitPath traitPath;
+    TraitPathStore & inProgressUpdateList = aSlot.mInProgressUpdateList;
 
-    for (size_t i = mInProgressUpdateList.GetFirstValidItem();
-            i < mInProgressUpdateList.GetPathStoreSize();
-            i = mInProgressUpdateList.GetNextValidItem(i))
+    for (size_t i = inProgressUpdateList.GetFirstValidItem();
+            i < inProgressUpdateList.GetPathStoreSize();
+            i = inProgressUpdateList.GetNextValidItem(i))
     {
-        mInProgressUpdateList.GetItemAt(i, traitPath);
+        inProgressUpdateList.GetItemAt(i, traitPath);
 
-        if ( ! mInProgressUpdateList.AreFlagsSet(i, kFlag_Private))
+        if ( ! inProgressUpdateList.AreFlagsSet(i, kFlag_Private))
         {
             // Locate() can return an error if the sink has been removed from the catalog. In that case,
             // skip this path
@@ -2172,7 +2357,7 @@ WEAVE_ERROR SubscriptionClient::MoveInProgressToPending(void)
                 count++;
             }
 
-            mInProgressUpdateList.RemoveItemAt(i);
+            inProgressUpdateList.RemoveItemAt(i);
         }
     }
 
@@ -2184,9 +2369,9 @@ WEAVE_ERROR SubscriptionClient::MoveInProgressToPending(void)
     }
 
     // Call clear to remove the private ones as well and anything else.
-    mInProgressUpdateList.Clear();
+    inProgressUpdateList.Clear();
 
-    mUpdateRequestContext.Reset();
+    aSlot.mRequestContext.Reset();
 
 exit:
     WeaveLogDetail(DataManagement, "Moved %" PRIu32 " items from InProgress to Pending; err %" PRId32 "", count, err);
@@ -2194,32 +2379,80 @@ exit:
     return err;
 }
 
-// Move the pending set to the in-progress list, grouping the
-// paths by trait instance
-WEAVE_ERROR SubscriptionClient::MovePendingToInProgress(void)
+// Move up to aMaxTraitInstances trait instances from the pending set to the
+// in-progress list of an idle UpdateSlot, grouping the paths by trait instance.
+// Trait instances that are in progress in another slot stay pending until that
+// request completes, so that their version bookkeeping is never shared.
+WEAVE_ERROR SubscriptionClient::MovePendingToInProgress(UpdateSlot & aSlot, size_t aMaxTraitInstances)
 {
-    VerifyOrDie(mInProgressUpdateList.IsEmpty());
+    MovePendingContext context = { this, &aSlot, 0, aMaxTraitInstances };
+    TraitPath traitPath;
+
+    VerifyOrDie(aSlot.mInProgressUpdateList.IsEmpty());
 
     if (mDataSinkCatalog)
     {
-        mDataSinkCatalog->Iterate(MovePendingToInProgressUpdatableSinkTrait, this);
+        mDataSinkCatalog->Iterate(MovePendingToInProgressUpdatableSinkTrait, &context);
+
+        // Drop whatever refers to sinks that are not in the catalog or not updatable.
+        for (size_t i = mPendingUpdateSet.GetFirstValidItem();
+                i < mPendingUpdateSet.GetPathStoreSize();
+                i = mPendingUpdateSet.GetNextValidItem(i))
+        {
+            mPendingUpdateSet.GetItemAt(i, traitPath);
+
+            if (NULL == Locate(traitPath.mTraitDataHandle, mDataSinkCatalog))
+            {
+                mPendingUpdateSet.RemoveItemAt(i);
+            }
+        }
     }
 
-    mPendingUpdateSet.Clear();
-    SetPendingSetState(kPendingSetEmpty);
+    if (NULL == mDataSinkCatalog || mPendingUpdateSet.IsEmpty())
+    {
+        mPendingUpdateSet.Clear();
+        SetPendingSetState(kPendingSetEmpty);
+    }
 
     return WEAVE_NO_ERROR;
 }
 
+/**
+ * Count the trait instances with pending paths that are not in progress in
+ * any UpdateSlot, i.e. the ones MovePendingToInProgress can move right now.
+ */
+size_t SubscriptionClient::GetNumPendingTraitInstances(void)
+{
+    MovePendingContext context = { this, NULL, 0, SIZE_MAX };
+
+    if (mDataSinkCatalog)
+    {
+        mDataSinkCatalog->Iterate(MovePendingToInProgressUpdatableSinkTrait, &context);
+    }
+
+    return context.mNumTraitInstances;
+}
+
 void SubscriptionClient::MovePendingToInProgressUpdatableSinkTrait(void * aDataSink, TraitDataHandle aDataHandle, void * aContext)
 {
-    SubscriptionClient * subClient = static_cast<SubscriptionClient *>(aContext);
+    MovePendingContext * context = static_cast<MovePendingContext *>(aContext);
+    SubscriptionClient * subClient = context->mClient;
     TraitDataSink * dataSink = static_cast<TraitDataSink *>(aDataSink);
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     int count = 0;
 
     VerifyOrExit(dataSink->IsUpdatableDataSink() == true, /* no error */);
 
+    VerifyOrExit(context->mNumTraitInstances < context->mMaxTraitInstances, /* no error */);
+
+    VerifyOrExit(subClient->mPendingUpdateSet.IsTraitPresent(aDataHandle), /* no error */);
+
+    VerifyOrExit(false == subClient->IsTraitInProgress(aDataHandle), /* no error */);
+
+    context->mNumTraitInstances++;
+
+    VerifyOrExit(NULL != context->mSlot, /* counting only */);
+
     for (size_t i = subClient->mPendingUpdateSet.GetFirstValidItem(aDataHandle);
             i < subClient->mPendingUpdateSet.GetPathStoreSize();
             i = subClient->mPendingUpdateSet.GetNextValidItem(i, aDataHandle))
@@ -2228,13 +2461,19 @@ void SubscriptionClient::MovePendingToInProgressUpdatableSinkTrait(void * aDataS
 
         subClient->mPendingUpdateSet.GetItemAt(i, traitPath);
 
-        err = subClient->mInProgressUpdateList.AddItem(traitPath);
+        err = context->mSlot->mInProgressUpdateList.AddItem(traitPath);
         SuccessOrExit(err);
+
+        subClient->mPendingUpdateSet.RemoveItemAt(i);
         count++;
     }
 
 exit:
-    WeaveLogDetail(DataManagement, "Moved %d items from Pending to InProgress; err %" PRId32 "", count, err);
+    if (count > 0 || err != WEAVE_NO_ERROR)
+    {
+        WeaveLogDetail(DataManagement, "Moved %d items from Pending to InProgress; err %" PRId32 "", count, err);
+    }
+
     return;
 }
 
@@ -2294,9 +2533,12 @@ void SubscriptionClient::PurgeAndNotifyFailedPaths(WEAVE_ERROR aErr, TraitPathSt
     {
         SetPendingSetState(kPendingSetEmpty);
     }
-    if (&aPathStore == &mInProgressUpdateList)
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
     {
-        mUpdateRequestContext.Reset();
+        if (&aPathStore == &mUpdateSlots[i].mInProgressUpdateList)
+        {
+            mUpdateSlots[i].mRequestContext.Reset();
+        }
     }
 
     return;
@@ -2349,8 +2591,12 @@ bool SubscriptionClient::FilterNotifiedPath(TraitDataHandle aTraitDataHandle,
 {
     bool retval = false;
 
-    retval = mInProgressUpdateList.Includes(TraitPath(aTraitDataHandle, aLeafPathHandle), aSchemaEngine) ||
-             mPendingUpdateSet.Includes(TraitPath(aTraitDataHandle, aLeafPathHandle), aSchemaEngine);
+    retval = mPendingUpdateSet.Includes(TraitPath(aTraitDataHandle, aLeafPathHandle), aSchemaEngine);
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && false == retval; i++)
+    {
+        retval = mUpdateSlots[i].mInProgressUpdateList.Includes(TraitPath(aTraitDataHandle, aLeafPathHandle), aSchemaEngine);
+    }
 
     if (retval)
     {
@@ -2454,7 +2700,7 @@ void SubscriptionClient::SetPendingSetState(PendingSetState aState)
 }
 
 // TODO: Break this method down into smaller methods.
-void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profiles::StatusReporting::StatusReport * apStatus)
+void SubscriptionClient::OnUpdateResponse(UpdateSlot & aSlot, WEAVE_ERROR aReason, nl::Weave::Profiles::StatusReporting::StatusReport * apStatus)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WEAVE_ERROR callbackerr;
@@ -2482,9 +2728,9 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
     LockUpdateMutex();
 
     additionalInfo = apStatus->mAdditionalInfo;
-    ClearUpdateInFlight();
+    aSlot.mInFlight = false;
 
-    if (mUpdateRequestContext.mIsPartialUpdate)
+    if (aSlot.mRequestContext.mIsPartialUpdate)
     {
         WeaveLogDetail(DataManagement, "Got StatusReport in the middle of a long update");
     }
@@ -2560,9 +2806,9 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
     // TODO: validate that the version and status lists are either empty or contain
     // the same number of items as the dispatched list
 
-    for (size_t j = mInProgressUpdateList.GetFirstValidItem();
-            j < mInProgressUpdateList.GetPathStoreSize();
-            j = mInProgressUpdateList.GetNextValidItem(j))
+    for (size_t j = aSlot.mInProgressUpdateList.GetFirstValidItem();
+            j < aSlot.mInProgressUpdateList.GetPathStoreSize();
+            j = aSlot.mInProgressUpdateList.GetNextValidItem(j))
     {
         if (IsVersionListPresent)
         {
@@ -2596,9 +2842,9 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
 
         willRetryPath = WillRetryUpdate(callbackerr, profileID, statusCode);
 
-        isPathPrivate = mInProgressUpdateList.AreFlagsSet(j, kFlag_Private);
+        isPathPrivate = aSlot.mInProgressUpdateList.AreFlagsSet(j, kFlag_Private);
 
-        mInProgressUpdateList.GetItemAt(j, traitPath);
+        aSlot.mInProgressUpdateList.GetItemAt(j, traitPath);
 
         updatableDataSink = Locate(traitPath.mTraitDataHandle, mDataSinkCatalog);
 
@@ -2607,7 +2853,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
             // Locate() can return an error if the sink has been removed from the catalog. In that case, ignore this path
             WeaveLogDetail(DataManagement, "item: %zu, traitDataHandle: % potentially removed from the catalog" PRIu16 ", pathHandle: %" PRIu32 "",
                     j, traitPath.mTraitDataHandle, traitPath.mPropertyPathHandle);
-            mInProgressUpdateList.RemoveItemAt(j);
+            aSlot.mInProgressUpdateList.RemoveItemAt(j);
             continue;
         }
 
@@ -2618,7 +2864,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
 
         if (isPathSuccessful)
         {
-            mInProgressUpdateList.RemoveItemAt(j);
+            aSlot.mInProgressUpdateList.RemoveItemAt(j);
 
             if (updatableDataSink->IsConditionalUpdate())
             {
@@ -2652,7 +2898,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
             if (profileID == nl::Weave::Profiles::kWeaveProfile_WDM &&
                     statusCode == nl::Weave::Profiles::DataManagement::kStatus_VersionMismatch)
             {
-                mInProgressUpdateList.RemoveItemAt(j);
+                aSlot.mInProgressUpdateList.RemoveItemAt(j);
 
                 // Fail all pending ones as well for VersionMismatch and force resubscribe
                 if (mPendingUpdateSet.IsTraitPresent(traitPath.mTraitDataHandle))
@@ -2670,7 +2916,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
                 // Else, throw away all updates in the trait instance.
                 if (false == willRetryPath)
                 {
-                    mInProgressUpdateList.RemoveItemAt(j);
+                    aSlot.mInProgressUpdateList.RemoveItemAt(j);
 
                     if (updatableDataSink->IsConditionalUpdate() &&
                             mPendingUpdateSet.IsTraitPresent(traitPath.mTraitDataHandle))
@@ -2700,7 +2946,7 @@ void SubscriptionClient::OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profil
             // the next item in the list will be invalid, and the loop will terminate.
             // Either this method or DiscardUpdates will trigger a resubscription.
         }
-    } // for all paths in mInProgressUpdateList
+    } // for all paths in aSlot.mInProgressUpdateList
 
 exit:
 
@@ -2711,25 +2957,27 @@ exit:
         // If the loop above exited early for an error, the application
         // is notified for any remaining path by the following method.
         // These paths are not retried.
-        mInProgressUpdateList.SetFailed();
-        PurgeAndNotifyFailedPaths(err, mInProgressUpdateList, count);
+        aSlot.mInProgressUpdateList.SetFailed();
+        PurgeAndNotifyFailedPaths(err, aSlot.mInProgressUpdateList, count);
         needToResubscribe = true;
     }
     else
     {
         // Whatever was not discarded above should be retried
-        err = MoveInProgressToPending();
+        err = MoveInProgressToPending(aSlot);
         if (err != WEAVE_NO_ERROR)
         {
             AbortUpdates(err);
         }
     }
 
-    mUpdateRequestContext.Reset();
+    aSlot.mRequestContext.Reset();
 
     PurgePendingUpdate();
 
-    if (mPendingSetState == kPendingSetEmpty)
+    // Other UpdateRequests may still be outstanding; the application is told there
+    // is nothing left to send only when the last one completes.
+    if (mPendingSetState == kPendingSetEmpty && false == IsUpdateInProgress())
     {
         mUpdateRetryCounter = 0;
 
@@ -2764,7 +3012,7 @@ exit:
  * This handler is optimized for the case that the request never reached the
  * responder: the dispatched paths are put back in the pending queue and retried.
  */
-void SubscriptionClient::OnUpdateNoResponse(WEAVE_ERROR aError)
+void SubscriptionClient::OnUpdateNoResponse(UpdateSlot & aSlot, WEAVE_ERROR aError)
 {
     TraitPath traitPath;
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -2773,16 +3021,16 @@ void SubscriptionClient::OnUpdateNoResponse(WEAVE_ERROR aError)
 
     LockUpdateMutex();
 
-    ClearUpdateInFlight();
+    aSlot.mInFlight = false;
 
     // Notify the app for all dispatched paths.
-    for (size_t j = mInProgressUpdateList.GetFirstValidItem();
-            j < mInProgressUpdateList.GetPathStoreSize();
-            j = mInProgressUpdateList.GetNextValidItem(j))
+    for (size_t j = aSlot.mInProgressUpdateList.GetFirstValidItem();
+            j < aSlot.mInProgressUpdateList.GetPathStoreSize();
+            j = aSlot.mInProgressUpdateList.GetNextValidItem(j))
     {
-        if (! mInProgressUpdateList.AreFlagsSet(j, kFlag_Private))
+        if (! aSlot.mInProgressUpdateList.AreFlagsSet(j, kFlag_Private))
         {
-            mInProgressUpdateList.GetItemAt(j, traitPath);
+            aSlot.mInProgressUpdateList.GetItemAt(j, traitPath);
 
             UpdateCompleteEventCbHelper(traitPath,
                                         nl::Weave::Profiles::kWeaveProfile_Common,
@@ -2793,7 +3041,7 @@ void SubscriptionClient::OnUpdateNoResponse(WEAVE_ERROR aError)
     }
 
     //Move paths from DispatchedUpdates to PendingUpdates for all TIs.
-    err = MoveInProgressToPending();
+    err = MoveInProgressToPending(aSlot);
     if (err != WEAVE_NO_ERROR)
     {
         AbortUpdates(err);
@@ -2803,13 +3051,13 @@ void SubscriptionClient::OnUpdateNoResponse(WEAVE_ERROR aError)
         PurgePendingUpdate();
     }
 
-    if (mPendingUpdateSet.IsEmpty())
+    if (false == mPendingUpdateSet.IsEmpty())
     {
-        NoMorePendingEventCbHelper();
+        StartUpdateRetryTimer(aError);
     }
-    else
+    else if (false == IsUpdateInProgress())
     {
-        StartUpdateRetryTimer(aError);
+        NoMorePendingEventCbHelper();
     }
 
     UnlockUpdateMutex();
@@ -2823,6 +3071,9 @@ void SubscriptionClient::UpdateEventCallback (void * const aAppState,
                                               UpdateClient::OutEventParam & aOutParam)
 {
     SubscriptionClient * const pSubClient = reinterpret_cast<SubscriptionClient *>(aAppState);
+    UpdateSlot * const pSlot = pSubClient->GetUpdateSlot(aInParam.Source);
+
+    VerifyOrExit(pSlot != NULL, WeaveLogDetail(DataManagement, "UpdateClient event %d from unknown source", aEvent));
 
     switch (aEvent)
     {
@@ -2831,17 +3082,17 @@ void SubscriptionClient::UpdateEventCallback (void * const aAppState,
 
         if (aInParam.UpdateComplete.Reason == WEAVE_NO_ERROR)
         {
-            pSubClient->OnUpdateResponse(aInParam.UpdateComplete.Reason, aInParam.UpdateComplete.StatusReportPtr);
+            pSubClient->OnUpdateResponse(*pSlot, aInParam.UpdateComplete.Reason, aInParam.UpdateComplete.StatusReportPtr);
         }
         else
         {
-            pSubClient->OnUpdateNoResponse(aInParam.UpdateComplete.Reason);
+            pSubClient->OnUpdateNoResponse(*pSlot, aInParam.UpdateComplete.Reason);
         }
 
         break;
     case UpdateClient::kEvent_UpdateContinue:
         WeaveLogDetail(DataManagement, "UpdateContinue event: %d", aEvent);
-        pSubClient->ClearUpdateInFlight();
+        pSlot->mInFlight = false;
         pSubClient->FormAndSendUpdate();
         break;
     default:
@@ -2849,6 +3100,7 @@ void SubscriptionClient::UpdateEventCallback (void * const aAppState,
         break;
     }
 
+exit:
     return;
 }
 
@@ -2878,7 +3130,7 @@ WEAVE_ERROR SubscriptionClient::SetUpdated(TraitUpdatableDataSink * aDataSink, P
     SuccessOrExit(err);
 
     isTraitInstanceInUpdate = mPendingUpdateSet.IsTraitPresent(dataHandle) ||
-                              mInProgressUpdateList.IsTraitPresent(dataHandle);
+                              IsTraitInProgress(dataHandle);
 
     // It is not supported to mix conditional and non-conditional updates
     // in the same trait.
@@ -2980,9 +3232,11 @@ void SubscriptionClient::AbortUpdates(WEAVE_ERROR aErr)
 
     mUpdateFlushScheduled = false;
 
-    ClearUpdateInFlight();
-
-    mUpdateClient.CancelUpdate();
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        mUpdateSlots[i].mInFlight = false;
+        mUpdateSlots[i].mUpdateClient.CancelUpdate();
+    }
 
     if (mDataSinkCatalog)
     {
@@ -3001,8 +3255,11 @@ void SubscriptionClient::AbortUpdates(WEAVE_ERROR aErr)
         mPendingUpdateSet.Clear();
         SetPendingSetState(kPendingSetEmpty);
 
-        numInProgress = mInProgressUpdateList.GetNumItems();
-        mInProgressUpdateList.Clear();
+        for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+        {
+            numInProgress += mUpdateSlots[i].mInProgressUpdateList.GetNumItems();
+            mUpdateSlots[i].mInProgressUpdateList.Clear();
+        }
     }
     else
     {
@@ -3014,9 +3271,20 @@ void SubscriptionClient::AbortUpdates(WEAVE_ERROR aErr)
         // unless SetUpdated() has been by a callback for an earlier element.
 
         mPendingUpdateSet.SetFailed();
-        mInProgressUpdateList.SetFailed();
+        for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+        {
+            mUpdateSlots[i].mInProgressUpdateList.SetFailed();
+        }
+
         PurgeAndNotifyFailedPaths(aErr, mPendingUpdateSet, numPending);
-        PurgeAndNotifyFailedPaths(aErr, mInProgressUpdateList, numInProgress);
+
+        for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+        {
+            size_t numPurged;
+
+            PurgeAndNotifyFailedPaths(aErr, mUpdateSlots[i].mInProgressUpdateList, numPurged);
+            numInProgress += numPurged;
+        }
     }
 
     WeaveLogDetail(DataManagement, "Discarded %" PRIu32 " pending  and %" PRIu32 " inProgress paths",
@@ -3043,7 +3311,7 @@ void SubscriptionClient::RefreshUpdatableSinkTrait(void * aDataSink, TraitDataHa
         refreshTraitInstance = true;
     }
 
-    if (subClient->mInProgressUpdateList.IsTraitPresent(aDataHandle))
+    if (subClient->IsTraitInProgress(aDataHandle))
     {
         refreshTraitInstance = true;
     }
@@ -3136,16 +3404,16 @@ exit:
     return;
 }
 
-void SubscriptionClient::SetUpdateStartVersions(void)
+void SubscriptionClient::SetUpdateStartVersions(UpdateSlot & aSlot)
 {
     TraitPath traitPath;
     TraitUpdatableDataSink *updatableSink;
 
-    for (size_t i = mInProgressUpdateList.GetFirstValidItem();
-            i < mInProgressUpdateList.GetPathStoreSize();
-            i = mInProgressUpdateList.GetNextValidItem(i))
+    for (size_t i = aSlot.mInProgressUpdateList.GetFirstValidItem();
+            i < aSlot.mInProgressUpdateList.GetPathStoreSize();
+            i = aSlot.mInProgressUpdateList.GetNextValidItem(i))
     {
-        mInProgressUpdateList.GetItemAt(i, traitPath);
+        aSlot.mInProgressUpdateList.GetItemAt(i, traitPath);
 
         updatableSink = Locate(traitPath.mTraitDataHandle, mDataSinkCatalog);
         if (NULL != updatableSink)
@@ -3155,7 +3423,7 @@ void SubscriptionClient::SetUpdateStartVersions(void)
     }
 }
 
-WEAVE_ERROR SubscriptionClient::SendSingleUpdateRequest(void)
+WEAVE_ERROR SubscriptionClient::SendSingleUpdateRequest(UpdateSlot & aSlot)
 {
     WEAVE_ERROR err   = WEAVE_NO_ERROR;
     uint32_t maxUpdateSize;
@@ -3164,58 +3432,58 @@ WEAVE_ERROR SubscriptionClient::SendSingleUpdateRequest(void)
     UpdateEncoder::Context context;
 
     maxUpdateSize = GetMaxUpdateSize();
-    err = mUpdateClient.mpBinding->AllocateRightSizedBuffer(pBuf, maxUpdateSize, WDM_MIN_UPDATE_SIZE, maxPayloadSize);
+    err = aSlot.mUpdateClient.mpBinding->AllocateRightSizedBuffer(pBuf, maxUpdateSize, WDM_MIN_UPDATE_SIZE, maxPayloadSize);
     SuccessOrExit(err);
 
-    mUpdateRequestContext.mIsPartialUpdate = false;
+    aSlot.mRequestContext.mIsPartialUpdate = false;
 
     context.mBuf = pBuf;
     context.mMaxPayloadSize = maxPayloadSize;
-    context.mUpdateRequestIndex = mUpdateRequestContext.mUpdateRequestIndex;
+    context.mUpdateRequestIndex = aSlot.mRequestContext.mUpdateRequestIndex;
     context.mExpiryTimeMicroSecond = 0;
-    context.mItemInProgress = mUpdateRequestContext.mItemInProgress;
-    context.mNextDictionaryElementPathHandle = mUpdateRequestContext.mNextDictionaryElementPathHandle;
-    context.mInProgressUpdateList = &mInProgressUpdateList;
+    context.mItemInProgress = aSlot.mRequestContext.mItemInProgress;
+    context.mNextDictionaryElementPathHandle = aSlot.mRequestContext.mNextDictionaryElementPathHandle;
+    context.mInProgressUpdateList = &aSlot.mInProgressUpdateList;
     context.mDataSinkCatalog = mDataSinkCatalog;
 
     err = mUpdateEncoder.EncodeRequest(context);
     SuccessOrExit(err);
 
-    mUpdateRequestContext.mNextDictionaryElementPathHandle = context.mNextDictionaryElementPathHandle;
+    aSlot.mRequestContext.mNextDictionaryElementPathHandle = context.mNextDictionaryElementPathHandle;
 
-    if (context.mItemInProgress < mInProgressUpdateList.GetPathStoreSize())
+    if (context.mItemInProgress < aSlot.mInProgressUpdateList.GetPathStoreSize())
     {
         // This is a PartialUpdateRequest; increase the index for the next one
-        mUpdateRequestContext.mIsPartialUpdate = true;
-        mUpdateRequestContext.mUpdateRequestIndex++;
+        aSlot.mRequestContext.mIsPartialUpdate = true;
+        aSlot.mRequestContext.mUpdateRequestIndex++;
     }
 
 
     if (context.mNumDataElementsAddedToPayload > 0)
     {
-        if (false == mUpdateRequestContext.mIsPartialUpdate)
+        if (false == aSlot.mRequestContext.mIsPartialUpdate)
         {
             // TODO: Should this happen at the first PartialUpdateRequest, or at the final UpdateRequest?
-            SetUpdateStartVersions();
+            SetUpdateStartVersions(aSlot);
         }
 
         WeaveLogDetail(DataManagement, "Sending %sUpdateRequest with %" PRIu16 " DEs",
-                mUpdateRequestContext.mIsPartialUpdate ? "Partial" : "",
+                aSlot.mRequestContext.mIsPartialUpdate ? "Partial" : "",
                 context.mNumDataElementsAddedToPayload);
 
-        // TODO: SetUpdateInFlight is here instead of after SendUpdate
+        // TODO: mInFlight is set here instead of after SendUpdate
         // to be able to inject timeouts; must improve this..
-        SetUpdateInFlight();
+        aSlot.mInFlight = true;
 
-        err = mUpdateClient.SendUpdate(mUpdateRequestContext.mIsPartialUpdate, pBuf, context.mUpdateRequestIndex == 0);
+        err = aSlot.mUpdateClient.SendUpdate(aSlot.mRequestContext.mIsPartialUpdate, pBuf, context.mUpdateRequestIndex == 0);
         pBuf = NULL;
         SuccessOrExit(err);
 
-        mUpdateRequestContext.mItemInProgress = context.mItemInProgress;
+        aSlot.mRequestContext.mItemInProgress = context.mItemInProgress;
     }
     else
     {
-        mUpdateClient.CancelUpdate();
+        aSlot.mUpdateClient.CancelUpdate();
     }
 
 exit:
@@ -3237,22 +3505,67 @@ exit:
 void SubscriptionClient::FormAndSendUpdate()
 {
     WEAVE_ERROR err                  = WEAVE_NO_ERROR;
+    UpdateSlot * slot                = NULL;
+    size_t maxTraitInstancesPerSlot  = SIZE_MAX;
 
     LockUpdateMutex();
 
-    VerifyOrExit(!IsUpdateInFlight(), WeaveLogDetail(DataManagement, "Update request in flight"));
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && slot == NULL; i++)
+    {
+        if (mUpdateSlots[i].IsIdle())
+        {
+            slot = &mUpdateSlots[i];
+        }
+    }
+
+    VerifyOrExit(slot != NULL, WeaveLogDetail(DataManagement, "Update request in flight"));
 
     WeaveLogDetail(DataManagement, "Eval Subscription: (state = %s)!", GetStateStr());
 
     if (mBinding->IsReady())
     {
-        if (mInProgressUpdateList.IsEmpty() && mPendingSetState == kPendingSetReady)
+        // Spread the pending trait instances evenly over the slots that are free to
+        // start a new request, so that they all go out in the same round trip.
+        if (ArraySize(mUpdateSlots) > 1 && mPendingSetState == kPendingSetReady)
         {
-            MovePendingToInProgress();
+            size_t numEmptySlots = 0;
+
+            for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+            {
+                if (mUpdateSlots[i].IsIdle() && mUpdateSlots[i].mInProgressUpdateList.IsEmpty())
+                {
+                    numEmptySlots++;
+                }
+            }
+
+            if (numEmptySlots > 1)
+            {
+                maxTraitInstancesPerSlot = (GetNumPendingTraitInstances() + numEmptySlots - 1) / numEmptySlots;
+            }
         }
 
-        err = SendSingleUpdateRequest();
-        SuccessOrExit(err);
+        for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+        {
+            if (false == mUpdateSlots[i].IsIdle())
+            {
+                continue;
+            }
+
+            slot = &mUpdateSlots[i];
+
+            if (slot->mInProgressUpdateList.IsEmpty() && mPendingSetState == kPendingSetReady)
+            {
+                MovePendingToInProgress(*slot, maxTraitInstancesPerSlot);
+            }
+
+            if (slot->mInProgressUpdateList.IsEmpty())
+            {
+                continue;
+            }
+
+            err = SendSingleUpdateRequest(*slot);
+            SuccessOrExit(err);
+        }
 
         WeaveLogDetail(DataManagement, "Done update processing!");
     }
@@ -3268,7 +3581,7 @@ exit:
     {
         // If anything failed, the UpdateRequest payload was not sent.
         // Move paths back to pending and retry later.
-        OnUpdateNoResponse(err);
+        OnUpdateNoResponse(*slot, err);
     }
 
     UnlockUpdateMutex();
@@ -3312,7 +3625,7 @@ WEAVE_ERROR SubscriptionClient::FlushUpdate(bool aForce)
     VerifyOrExit(mPendingSetState == kPendingSetReady,
             WeaveLogDetail(DataManagement, "%s: PendingSetState: %d; err = %s", __func__, mPendingSetState, nl::ErrorStr(err)));
 
-    VerifyOrExit(false == IsUpdateInFlight(),
+    VerifyOrExit(HasIdleUpdateSlot(),
             WeaveLogDetail(DataManagement, "%s: update already in flight", __func__));
 
     if (aForce)
@@ -3452,6 +3765,79 @@ void SubscriptionClient::UpdateRequestContext::Reset()
     mIsPartialUpdate = false;
 }
 
+void SubscriptionClient::UpdateSlot::Reset()
+{
+    mRequestContext.Reset();
+    mInProgressUpdateList.Init(mInProgressStore, ArraySize(mInProgressStore));
+    mInFlight = false;
+}
+
+SubscriptionClient::UpdateSlot * SubscriptionClient::GetUpdateSlot(const UpdateClient * aUpdateClient)
+{
+    UpdateSlot * slot = NULL;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots); i++)
+    {
+        if (&mUpdateSlots[i].mUpdateClient == aUpdateClient)
+        {
+            slot = &mUpdateSlots[i];
+            break;
+        }
+    }
+
+    return slot;
+}
+
+// True if any UpdateRequest payload is awaiting a response.
+bool SubscriptionClient::IsUpdateInFlight(void)
+{
+    bool retval = false;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && false == retval; i++)
+    {
+        retval = mUpdateSlots[i].mInFlight;
+    }
+
+    return retval;
+}
+
+// True if another UpdateRequest payload can be sent right now.
+bool SubscriptionClient::HasIdleUpdateSlot(void)
+{
+    bool retval = false;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && false == retval; i++)
+    {
+        retval = mUpdateSlots[i].IsIdle();
+    }
+
+    return retval;
+}
+
+bool SubscriptionClient::IsUpdateInProgress(void)
+{
+    bool retval = false;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && false == retval; i++)
+    {
+        retval = (false == mUpdateSlots[i].mInProgressUpdateList.IsEmpty());
+    }
+
+    return retval;
+}
+
+bool SubscriptionClient::IsTraitInProgress(TraitDataHandle aDataHandle)
+{
+    bool retval = false;
+
+    for (size_t i = 0; i < ArraySize(mUpdateSlots) && false == retval; i++)
+    {
+        retval = mUpdateSlots[i].mInProgressUpdateList.IsTraitPresent(aDataHandle);
+    }
+
+    return retval;
+}
+
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 }; // namespace Profiles
@@ -285,6 +285,7 @@ public:
         WEAVE_ERROR mReason;      ///< Error received on most recent failure
         uint32_t mNumRetries;     ///< Number of retries, reset on a successful attempt
         RequestType mRequestType; ///< Request being backed off
+        uint32_t mRetryAfterMsec; ///< Minimum wait requested by the publisher in its StatusReport, or 0
     };
 
     /**
@@ -319,6 +320,8 @@ public:
 
     static void DefaultResubscribePolicyCallback(void * const aAppState, ResubscribeParam & aInParam, uint32_t & aOutIntervalMsec);
 
+    static void JitteredResubscribePolicyCallback(void * const aAppState, ResubscribeParam & aInParam, uint32_t & aOutIntervalMsec);
+
     void InitiateSubscription(void);
     void InitiateCounterSubscription(const uint32_t aLivenessTimeoutSec);
 
@@ -402,6 +405,7 @@ private:
     friend class SubscriptionEngine;
     friend class TestTdm;
     friend class TestWdm;
+    friend class BenchWdm;
     friend class WdmUpdateEncoderTest;
     friend class MockWdmSubscriptionInitiatorImpl;
     friend class TraitDataSink;
@@ -480,6 +484,14 @@ private:
 
     // retry params
     uint32_t mRetryCounter;
+    uint32_t mRetryAfterHintMsec;
+
+#if WDM_MAX_CONCURRENT_RESUBSCRIBES
+    bool mHoldsResubscribeSlot;
+    bool mWaitingForResubscribeSlot;
+
+    void OnResubscribeSlotAvailable(void);
+#endif // WDM_MAX_CONCURRENT_RESUBSCRIBES
 
     // Do nothing
     SubscriptionClient(void);
@@ -553,6 +565,34 @@ private:
         uint32_t mUpdateRequestIndex;
         bool mIsPartialUpdate;
     };
+
+    /**
+     * The state of one outstanding UpdateRequest: the exchange, the list of
+     * paths being sent in it and the encoding progress through that list.
+     * Up to WDM_UPDATE_MAX_REQUESTS_IN_FLIGHT of these are in use at the same
+     * time; a trait instance is only ever in one of them.
+     */
+    struct UpdateSlot
+    {
+        void Reset();
+        bool IsIdle() const { return (false == mInFlight); }
+
+        UpdateClient mUpdateClient;
+        UpdateRequestContext mRequestContext;
+        TraitPathStore mInProgressUpdateList;
+        TraitPathStore::Record mInProgressStore[WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE];
+        bool mInFlight;
+    };
+
+    // Argument of MovePendingToInProgressUpdatableSinkTrait; with a NULL mSlot,
+    // the trait instances that could be moved are only counted.
+    struct MovePendingContext
+    {
+        SubscriptionClient * mClient;
+        UpdateSlot * mSlot;
+        size_t mNumTraitInstances;
+        size_t mMaxTraitInstances;
+    };
     uint32_t mUpdateRetryCounter;
     bool mSuspendUpdateRetries;
     bool mUpdateRetryScheduled;
@@ -568,13 +608,13 @@ private:
 
     // Methods to encode and send update requests
     void FormAndSendUpdate();
-    WEAVE_ERROR SendSingleUpdateRequest(void);
+    WEAVE_ERROR SendSingleUpdateRequest(UpdateSlot & aSlot);
     static WEAVE_ERROR AddElementFunc(UpdateEncoder * aEncoder, void * apCallState, TLV::TLVWriter & aOuterWriter);
-    void SetUpdateStartVersions(void);
+    void SetUpdateStartVersions(UpdateSlot & aSlot);
 
     // Methods to handle update response and exchange failures (OnResponseTimeout, OnSendError)
-    void OnUpdateResponse(WEAVE_ERROR aReason, nl::Weave::Profiles::StatusReporting::StatusReport * apStatus);
-    void OnUpdateNoResponse(WEAVE_ERROR aReason);
+    void OnUpdateResponse(UpdateSlot & aSlot, WEAVE_ERROR aReason, nl::Weave::Profiles::StatusReporting::StatusReport * apStatus);
+    void OnUpdateNoResponse(UpdateSlot & aSlot, WEAVE_ERROR aReason);
     static bool WillRetryUpdate(WEAVE_ERROR aErr, uint32_t aStatusProfileId, uint16_t aStatusCode);
 
     // Methods to purge obsolete pending paths
@@ -601,18 +641,20 @@ private:
         kPendingSetReady
     };
     void SetPendingSetState(PendingSetState aState);
-    WEAVE_ERROR MovePendingToInProgress(void);
+    WEAVE_ERROR MovePendingToInProgress(UpdateSlot & aSlot, size_t aMaxTraitInstances);
+    size_t GetNumPendingTraitInstances(void);
     WEAVE_ERROR AddItemPendingUpdateSet(const TraitPath & aItem, const TraitSchemaEngine * const aSchemaEngine);
-    WEAVE_ERROR MoveInProgressToPending(void);
+    WEAVE_ERROR MoveInProgressToPending(UpdateSlot & aSlot);
 
-    // Tracking if a payload is in flight
-    bool IsUpdateInFlight() { return mUpdateInFlight; }
-    void SetUpdateInFlight() { mUpdateInFlight = true; }
-    void ClearUpdateInFlight() { mUpdateInFlight = false; }
+    // Tracking the outstanding UpdateRequests
+    UpdateSlot * GetUpdateSlot(const UpdateClient * aUpdateClient);
+    bool IsUpdateInFlight(void);
+    bool HasIdleUpdateSlot(void);
+    bool IsTraitInProgress(TraitDataHandle aDataHandle);
 
     // Knowing if an update is pending or in progress
-    bool IsUpdateInProgress() { return (false == mInProgressUpdateList.IsEmpty()); }
-    bool IsReadyToSendNewUpdate() { return (mPendingSetState == kPendingSetReady && false == IsUpdateInProgress()); }
+    bool IsUpdateInProgress(void);
+    bool IsReadyToSendNewUpdate() { return (mPendingSetState == kPendingSetReady && HasIdleUpdateSlot()); }
 
     // Methods to notify the application
     void UpdateCompleteEventCbHelper(const TraitPath & aTraitPath, uint32_t aStatusProfileId, uint16_t aStatusCode,
@@ -633,11 +675,9 @@ private:
     static void CleanupUpdatableSinkTrait(void * aDataSink, TraitDataHandle aDataHandle, void * aContext);
 
     bool mResubscribeNeeded;
-    UpdateRequestContext mUpdateRequestContext;
     uint16_t mMaxUpdateSize;
-    bool mUpdateInFlight;
 
-    // Flags used with mInProgressUpdateList
+    // Flags used with the in-progress lists of the UpdateSlots
     enum
     {
         kFlag_ForceMerge = 0x4, /**< In UpdateRequest, DataElements are encoded with the "replace" format by
@@ -656,10 +696,8 @@ private:
     TraitPathStore mPendingUpdateSet;
     TraitPathStore::Record mPendingStore[WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE];
 
-    TraitPathStore mInProgressUpdateList;
-    TraitPathStore::Record mInProgressStore[WDM_UPDATE_MAX_ITEMS_IN_TRAIT_DIRTY_PATH_STORE];
+    UpdateSlot mUpdateSlots[WDM_UPDATE_MAX_REQUESTS_IN_FLIGHT];
 
-    UpdateClient mUpdateClient;
     UpdateEncoder mUpdateEncoder;
 #endif // WEAVE_CONFIG_ENABLE_WDM_UPDATE
 };
@@ -37,6 +37,7 @@
 #include <Weave/Support/crypto/WeaveCrypto.h>
 #include <Weave/Support/WeaveFaultInjection.h>
 #include <SystemLayer/SystemStats.h>
+#include <SystemLayer/SystemTrace.h>
 
 #ifndef WEAVE_WDM_ALIGNED_TYPE
 #define WEAVE_WDM_ALIGNED_TYPE(address, type) reinterpret_cast<type *> WEAVE_SYSTEM_ALIGN_SIZE((size_t)(address), 4)
@@ -87,6 +88,12 @@ WEAVE_ERROR SubscriptionEngine::Init(nl::Weave::WeaveExchangeManager * const apE
         mClients[i].InitAsFree();
     }
 
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kWDM_NumSubscriptionClients, kMaxNumSubscriptionClients);
+
+#if WDM_MAX_CONCURRENT_RESUBSCRIBES
+    mNumResubscribesInProgress = 0;
+#endif // WDM_MAX_CONCURRENT_RESUBSCRIBES
+
 #endif // WDM_ENABLE_SUBSCRIPTION_CLIENT
 
 #if WDM_ENABLE_SUBSCRIPTION_PUBLISHER
@@ -98,6 +105,13 @@ WEAVE_ERROR SubscriptionEngine::Init(nl::Weave::WeaveExchangeManager * const apE
         mHandlers[i].InitAsFree();
     }
 
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kWDM_NumSubscriptionHandlers, kMaxNumSubscriptionHandlers);
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kWDM_NumTraits, kMaxNumPathGroups);
+
+#if WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+    memset(mHandlerIndex, 0, sizeof(mHandlerIndex));
+#endif
+
     // erase everything
     DisablePublisher();
 
@@ -105,6 +119,14 @@ WEAVE_ERROR SubscriptionEngine::Init(nl::Weave::WeaveExchangeManager * const apE
 
     mNumTraitInfosInPool = 0;
 
+#if WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+    memset(mTraitIndex, 0, sizeof(mTraitIndex));
+#endif
+
+#if WDM_PUBLISHER_ENABLE_CUSTOM_COMMAND_HANDLER
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kWDM_NumCommands, kMaxNumCommandObjs);
+#endif
+
 exit:
     WeaveLogFunctError(err);
 
@@ -283,6 +305,72 @@ WEAVE_ERROR SubscriptionEngine::NewClient(SubscriptionClient ** const appClient,
     return NewClient(appClient, apBinding, apAppState, aEventCallback, apCatalog, aInactivityTimeoutDuringSubscribingMsec, NULL);
 }
 
+#if WDM_MAX_CONCURRENT_RESUBSCRIBES
+/**
+ * Called by a SubscriptionClient whose resubscribe holdoff has expired, to get one of the
+ * WDM_MAX_CONCURRENT_RESUBSCRIBES resubscribe slots. If none is available, the client is
+ * recorded as waiting and gets OnResubscribeSlotAvailable() once one is released.
+ *
+ * @param[in]   apClient    The client about to resubscribe.
+ *
+ * @return      true if the client can go ahead and resubscribe.
+ */
+bool SubscriptionEngine::AcquireResubscribeSlot(SubscriptionClient * const apClient)
+{
+    if (apClient->mHoldsResubscribeSlot)
+    {
+        return true;
+    }
+
+    if (mNumResubscribesInProgress >= WDM_MAX_CONCURRENT_RESUBSCRIBES)
+    {
+        apClient->mWaitingForResubscribeSlot = true;
+
+        WeaveLogDetail(DataManagement, "Client[%u] waiting for one of %u resubscribes to complete", GetClientId(apClient),
+                       mNumResubscribesInProgress);
+
+        return false;
+    }
+
+    mNumResubscribesInProgress++;
+    apClient->mHoldsResubscribeSlot       = true;
+    apClient->mWaitingForResubscribeSlot = false;
+
+    return true;
+}
+
+/**
+ * Called by a SubscriptionClient when its resubscribe attempt is over, whatever the outcome.
+ * Hands the slot to the next waiting client, if any; clients are scanned starting after
+ * the one releasing the slot so that none of them is starved.
+ *
+ * @param[in]   apClient    The client that was resubscribing.
+ */
+void SubscriptionEngine::ReleaseResubscribeSlot(SubscriptionClient * const apClient)
+{
+    const size_t releasingClientId = GetClientId(apClient);
+
+    if (!apClient->mHoldsResubscribeSlot)
+    {
+        return;
+    }
+
+    apClient->mHoldsResubscribeSlot = false;
+    mNumResubscribesInProgress--;
+
+    for (size_t i = 1; i <= kMaxNumSubscriptionClients; ++i)
+    {
+        SubscriptionClient * const pClient = &mClients[(releasingClientId + i) % kMaxNumSubscriptionClients];
+
+        if (pClient->mWaitingForResubscribeSlot && pClient->IsInResubscribeHoldoff())
+        {
+            pClient->OnResubscribeSlotAvailable();
+            break;
+        }
+    }
+}
+#endif // WDM_MAX_CONCURRENT_RESUBSCRIBES
+
 /**
  * Reply to a request with a StatuReport message.
  *
@@ -482,6 +570,8 @@ WEAVE_ERROR SubscriptionEngine::ProcessDataList(nl::Weave::TLV::TLVReader & aRea
                                                 TraitDataHandle & aOutTraitDataHandle,
                                                 IDataElementAccessControlDelegate & acDelegate)
 {
+    SYSTEM_TRACE_SCOPE("DataManagement", "SubscriptionEngine::ProcessDataList");
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     // TODO: We currently don't support changes that span multiple notifies, nor changes
@@ -501,6 +591,12 @@ WEAVE_ERROR SubscriptionEngine::ProcessDataList(nl::Weave::TLV::TLVReader & aRea
             err = element.Init(aReader);
             SuccessOrExit(err);
 
+#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK && WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK
+            // The notify was not validated up front; check each element just before it is stored.
+            err = element.CheckSchemaValidity();
+            SuccessOrExit(err);
+#endif
+
             err = element.GetReaderOnPath(&pathReader);
             SuccessOrExit(err);
 
@@ -605,6 +701,11 @@ WEAVE_ERROR SubscriptionEngine::ProcessDataList(nl::Weave::TLV::TLVReader & aRea
     }
 
 exit:
+#if TDM_SINK_CHANGE_SET_SUPPORT
+    // Sinks in change set mode get what they have received, even if the rest of the DataList could not be processed.
+    TraitDataSink::DeliverPendingChangeSets();
+#endif
+
     return err;
 }
 
@@ -659,11 +760,11 @@ void SubscriptionEngine::OnSubscriptionlessNotification(nl::Weave::ExchangeConte
     err = notify.Init(reader);
     SuccessOrExit(err);
 
-#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+#if WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK && !WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK
     // simple schema checking
     err = notify.CheckSchemaValidity();
     SuccessOrExit(err);
-#endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
+#endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK && !WEAVE_CONFIG_DATA_MANAGEMENT_LAZY_NOTIFY_SCHEMA_CHECK
 
     {
         DataList::Parser dataList;
@@ -899,26 +1000,130 @@ bool SubscriptionEngine::UpdateHandlerLiveness(const uint64_t aPeerNodeId, const
     return found;
 }
 
+bool SubscriptionEngine::IsMatchingHandler(const SubscriptionHandler & aHandler, const uint64_t aPeerNodeId,
+                                           const uint64_t aSubscriptionId)
+{
+    return (aHandler.mCurrentState >= SubscriptionHandler::kState_SubscriptionInfoValid_Begin) &&
+        (aHandler.mCurrentState <= SubscriptionHandler::kState_SubscriptionInfoValid_End) &&
+        (aPeerNodeId == aHandler.mBinding->GetPeerNodeId()) && (aSubscriptionId == aHandler.mSubscriptionId);
+}
+
 SubscriptionHandler * SubscriptionEngine::FindHandler(const uint64_t aPeerNodeId, const uint64_t aSubscriptionId)
 {
     SubscriptionHandler * result = NULL;
 
+#if WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+    uint16_t next = mHandlerIndex[GetHandlerIndexBucket(aPeerNodeId, aSubscriptionId)];
+
+    while (next != 0)
+    {
+        SubscriptionHandler * const pHandler = &mHandlers[next - 1];
+
+        if (IsMatchingHandler(*pHandler, aPeerNodeId, aSubscriptionId))
+        {
+            result = pHandler;
+            break;
+        }
+
+        next = pHandler->mNextInIndexBucket;
+    }
+#else
     for (size_t i = 0; i < kMaxNumSubscriptionHandlers; ++i)
     {
-        if ((mHandlers[i].mCurrentState >= SubscriptionHandler::kState_SubscriptionInfoValid_Begin) &&
-            (mHandlers[i].mCurrentState <= SubscriptionHandler::kState_SubscriptionInfoValid_End))
+        if (IsMatchingHandler(mHandlers[i], aPeerNodeId, aSubscriptionId))
         {
-            if ((aPeerNodeId == mHandlers[i].mBinding->GetPeerNodeId()) && (aSubscriptionId == mHandlers[i].mSubscriptionId))
-            {
-                result = &mHandlers[i];
-                break;
-            }
+            result = &mHandlers[i];
+            break;
         }
     }
+#endif // WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
 
     return result;
 }
 
+#if WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+uint16_t SubscriptionEngine::GetHandlerIndexBucket(const uint64_t aPeerNodeId, const uint64_t aSubscriptionId)
+{
+    // Subscription ids are random, so folding them with the peer node id spreads handlers evenly
+    uint64_t key = aPeerNodeId ^ aSubscriptionId;
+
+    key ^= key >> 32;
+    key ^= key >> 16;
+
+    return static_cast<uint16_t>(key % WDM_PUBLISHER_HANDLER_INDEX_SIZE);
+}
+
+/**
+ * Link a handler into the handler index under its peer node id and subscription id, so FindHandler can locate it without
+ * scanning the handler pool. Neither may change until the handler is removed from the index.
+ */
+void SubscriptionEngine::AddHandlerToIndex(SubscriptionHandler * const apHandler)
+{
+    if (apHandler->mIndexBucket == SubscriptionHandler::kNotIndexed)
+    {
+        apHandler->mIndexBucket                = GetHandlerIndexBucket(apHandler->mBinding->GetPeerNodeId(), apHandler->mSubscriptionId);
+        apHandler->mNextInIndexBucket          = mHandlerIndex[apHandler->mIndexBucket];
+        mHandlerIndex[apHandler->mIndexBucket] = static_cast<uint16_t>(GetHandlerId(apHandler) + 1);
+    }
+}
+
+void SubscriptionEngine::RemoveHandlerFromIndex(SubscriptionHandler * const apHandler)
+{
+    const uint16_t handlerRef = static_cast<uint16_t>(GetHandlerId(apHandler) + 1);
+    uint16_t * pLink;
+
+    VerifyOrExit(apHandler->mIndexBucket != SubscriptionHandler::kNotIndexed, );
+
+    for (pLink = &mHandlerIndex[apHandler->mIndexBucket]; *pLink != 0; pLink = &mHandlers[*pLink - 1].mNextInIndexBucket)
+    {
+        if (*pLink == handlerRef)
+        {
+            *pLink = apHandler->mNextInIndexBucket;
+            break;
+        }
+    }
+
+    apHandler->mNextInIndexBucket = 0;
+    apHandler->mIndexBucket       = SubscriptionHandler::kNotIndexed;
+
+exit:
+    return;
+}
+#endif // WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+
+#if WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+/**
+ * Link a trait instance info from the pool into the trait index under its trait data handle, so the subscriptions to a
+ * trait instance can be marked dirty without walking every handler. The trait data handle must be set first.
+ */
+void SubscriptionEngine::AddTraitInstanceToIndex(const SubscriptionHandler * const apHandler,
+                                                 SubscriptionHandler::TraitInstanceInfo * const apTraitInstance)
+{
+    const uint16_t bucket = apTraitInstance->mTraitDataHandle % WDM_PUBLISHER_TRAIT_INDEX_SIZE;
+
+    apTraitInstance->mHandlerId        = GetHandlerId(apHandler);
+    apTraitInstance->mNextInTraitIndex = mTraitIndex[bucket];
+    mTraitIndex[bucket]                = static_cast<uint16_t>(apTraitInstance - mTraitInfoPool + 1);
+}
+
+/**
+ * Relink every trait instance info in the pool. Needed whenever entries leave the pool, since the entries behind them move.
+ */
+void SubscriptionEngine::RebuildTraitIndex(void)
+{
+    memset(mTraitIndex, 0, sizeof(mTraitIndex));
+
+    for (size_t i = 0; i < mNumTraitInfosInPool; ++i)
+    {
+        SubscriptionHandler::TraitInstanceInfo * const traitInstance = mTraitInfoPool + i;
+        const uint16_t bucket = traitInstance->mTraitDataHandle % WDM_PUBLISHER_TRAIT_INDEX_SIZE;
+
+        traitInstance->mNextInTraitIndex = mTraitIndex[bucket];
+        mTraitIndex[bucket]              = static_cast<uint16_t>(i + 1);
+    }
+}
+#endif // WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+
 WEAVE_ERROR SubscriptionEngine::GetMinEventLogPosition(size_t & outLogPosition) const
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -946,8 +1151,9 @@ void SubscriptionEngine::ReclaimTraitInfo(SubscriptionHandler * const aHandlerTo
     const uint16_t numTraitInstances                             = aHandlerToBeReclaimed->mNumTraitInstances;
     size_t numTraitInstancesToBeAffected;
 
-    aHandlerToBeReclaimed->mTraitInstanceList = NULL;
-    aHandlerToBeReclaimed->mNumTraitInstances = 0;
+    aHandlerToBeReclaimed->mTraitInstanceList      = NULL;
+    aHandlerToBeReclaimed->mNumTraitInstances      = 0;
+    aHandlerToBeReclaimed->mNumDirtyTraitInstances = 0;
 
     if (!numTraitInstances)
     {
@@ -991,6 +1197,13 @@ void SubscriptionEngine::ReclaimTraitInfo(SubscriptionHandler * const aHandlerTo
     }
 
 exit:
+#if WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+    if (numTraitInstances)
+    {
+        RebuildTraitIndex();
+    }
+#endif // WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+
     WeaveLogDetail(DataManagement, "Number of allocated trait instances: %u", mNumTraitInfosInPool);
 }
 
@@ -1528,6 +1741,8 @@ exit:
 WEAVE_ERROR SubscriptionEngine::AllocateRightSizedBuffer(PacketBuffer *& buf, const uint32_t desiredSize, const uint32_t minSize,
                                                          uint32_t & outMaxPayloadSize)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err          = WEAVE_NO_ERROR;
     uint32_t bufferAllocSize = 0;
     uint32_t maxWeavePayloadSize;
@@ -1774,6 +1989,8 @@ exit:
  */
 WEAVE_ERROR SubscriptionEngine::SendFaultyUpdateResponse(Weave::ExchangeContext * apEC)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     uint8_t * p;
     uint8_t statusReportLen = 6;
@@ -2134,22 +2351,25 @@ void SubscriptionEngine::OnUpdateRequest(Weave::ExchangeContext * apEC, const In
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_ENABLE_SCHEMA_CHECK
 
     {
-        DataList::Parser dataList;
+        UpdateRequest::Contents contents;
 
-        err = update.GetDataList(&dataList);
-        if (WEAVE_NO_ERROR == err)
-        {
-            isDataListPresent = true;
-        }
-        else if (WEAVE_END_OF_TLV == err)
-        {
-            isDataListPresent = false;
-            err               = WEAVE_NO_ERROR;
-        }
+        err = update.Decode(contents);
         SuccessOrExit(err);
 
-        // re-initialize the reader to point to individual date element (reuse to save stack depth).
-        dataList.GetReader(&reader);
+        isDataListPresent = contents.IsPresent(UpdateRequest::Contents::kField_DataList);
+        if (isDataListPresent)
+        {
+            DataList::Parser dataList;
+
+            err = contents.mDataList.GetReader(reader);
+            SuccessOrExit(err);
+
+            err = dataList.Init(reader);
+            SuccessOrExit(err);
+
+            // re-initialize the reader to point to individual date element (reuse to save stack depth).
+            dataList.GetReader(&reader);
+        }
     }
 
     if (isDataListPresent)
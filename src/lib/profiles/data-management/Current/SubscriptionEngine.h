@@ -331,6 +331,17 @@ public:
 
     SubscriptionHandler * FindHandler(const uint64_t aPeerNodeId, const uint64_t aSubscriptionId);
 
+#if WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+    void AddHandlerToIndex(SubscriptionHandler * const apHandler);
+    void RemoveHandlerFromIndex(SubscriptionHandler * const apHandler);
+#endif // WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+
+#if WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+    void AddTraitInstanceToIndex(const SubscriptionHandler * const apHandler,
+                                 SubscriptionHandler::TraitInstanceInfo * const apTraitInstance);
+    void RebuildTraitIndex(void);
+#endif // WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+
     bool UpdateHandlerLiveness(const uint64_t aPeerNodeId, const uint64_t aSubscriptionId, const bool aKill = false);
 
     uint16_t GetHandlerId(const SubscriptionHandler * const apHandler) const;
@@ -356,6 +367,7 @@ private:
     friend class NotificationEngine;
     friend class TestTdm;
     friend class TestWdm;
+    friend class BenchWdm;
 
     nl::Weave::WeaveExchangeManager * mExchangeMgr;
     void * mAppState;
@@ -420,6 +432,13 @@ private:
 
     SubscriptionClient mClients[kMaxNumSubscriptionClients];
 
+#if WDM_MAX_CONCURRENT_RESUBSCRIBES
+    uint16_t mNumResubscribesInProgress;
+
+    bool AcquireResubscribeSlot(SubscriptionClient * const apClient);
+    void ReleaseResubscribeSlot(SubscriptionClient * const apClient);
+#endif // WDM_MAX_CONCURRENT_RESUBSCRIBES
+
     static void OnNotificationRequest(nl::Weave::ExchangeContext * aEC, const nl::Inet::IPPacketInfo * aPktInfo,
                                       const nl::Weave::WeaveMessageInfo * aMsgInfo, uint32_t aProfileId, uint8_t aMsgType,
                                       PacketBuffer * aPayload);
@@ -515,11 +534,25 @@ private:
     SubscriptionHandler::TraitInstanceInfo mTraitInfoPool[kMaxNumPathGroups];
 
     uint16_t mNumOfPropertyPathHandlesAllocated;
+
+#if WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+    // Heads (handler id + 1, or 0 if empty) of the handler chains hashed by (peer node id, subscription id)
+    uint16_t mHandlerIndex[WDM_PUBLISHER_HANDLER_INDEX_SIZE];
+
+    static uint16_t GetHandlerIndexBucket(const uint64_t aPeerNodeId, const uint64_t aSubscriptionId);
+#endif // WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+
+#if WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+    // Heads (trait info pool index + 1, or 0 if empty) of the trait instance info chains hashed by trait data handle
+    uint16_t mTraitIndex[WDM_PUBLISHER_TRAIT_INDEX_SIZE];
+#endif // WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
     // PropertyPathHandle mPropertyPathHandlePool[kMaxNumPropertyPathHandles];
     // ******************* end protected by lock   **************************
 
     void ReclaimTraitInfo(SubscriptionHandler * const aHandlerToBeReclaimed);
 
+    static bool IsMatchingHandler(const SubscriptionHandler & aHandler, const uint64_t aPeerNodeId, const uint64_t aSubscriptionId);
+
     static void OnSubscribeRequest(nl::Weave::ExchangeContext * aEC, const nl::Inet::IPPacketInfo * aPktInfo,
                                    const nl::Weave::WeaveMessageInfo * aMsgInfo, uint32_t aProfileId, uint8_t aMsgType,
                                    PacketBuffer * aPayload);
@@ -67,11 +67,22 @@ void SubscriptionHandler::InitAsFree()
     mIsInitiator                   = false;
     mTraitInstanceList             = NULL;
     mNumTraitInstances             = 0;
+    mNumDirtyTraitInstances        = 0;
     mMaxNotificationSize           = 0;
     mSubscribeToAllEvents          = false;
     mCurProcessingTraitInstanceIdx = 0;
     mCurrentImportance             = kImportanceType_Invalid;
     mBytesOffloaded                = 0;
+    mMinNotifyIntervalMsec         = WDM_PUBLISHER_DEFAULT_MIN_NOTIFY_INTERVAL_MSEC;
+    mLastNotifyTime                = 0;
+    mIsNotifyHoldOffTimerArmed     = false;
+#if WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+    mNextInIndexBucket             = 0;
+    mIndexBucket                   = kNotIndexed;
+#endif
+#if WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+    mIsNotifySendPending           = false;
+#endif
 
     memset(mSelfVendedEvents, 0, sizeof(mSelfVendedEvents));
     memset(mLastScheduledEventId, 0, sizeof(mLastScheduledEventId));
@@ -113,6 +124,11 @@ WEAVE_ERROR SubscriptionHandler::AcceptSubscribeRequest(const uint32_t aLiveness
     // walk through the path list, prime the client
     MoveToState(kState_Subscribing);
 
+#if WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+    // The subscription id is final from here on, and FindHandler starts matching this handler
+    SubscriptionEngine::GetInstance()->AddHandlerToIndex(this);
+#endif
+
     // Note that the call to NotificationEngine::Run could actually cause this particular handler to be aborted
     SubscriptionEngine::GetInstance()->GetNotificationEngine()->Run();
 
@@ -170,6 +186,8 @@ void SubscriptionHandler::DefaultEventHandler(EventID aEvent, const InEventParam
  */
 WEAVE_ERROR SubscriptionHandler::EndSubscription(const uint32_t aReasonProfileId, const uint16_t aReasonStatusCode)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err   = WEAVE_NO_ERROR;
     bool abortOnError = true;
 
@@ -365,6 +383,11 @@ WEAVE_ERROR SubscriptionHandler::ParsePathVersionEventLists(SubscribeRequest::Pa
                 SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kWDM_NumTraits);
 
                 traitInstance->Init();
+
+#if WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+                traitInstance->mTraitDataHandle = traitDataHandle;
+                SubscriptionEngine::GetInstance()->AddTraitInstanceToIndex(this, traitInstance);
+#endif // WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
             }
             else
             {
@@ -392,7 +415,10 @@ WEAVE_ERROR SubscriptionHandler::ParsePathVersionEventLists(SubscribeRequest::Pa
             WeaveLogDetail(DataManagement, "Handler[%u] Syncing is requested for trait[%u].path[%u]",
                            SubscriptionEngine::GetInstance()->GetHandlerId(this), traitDataHandle, propertyPathHandle);
 
-            traitInstance->SetDirty();
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+            traitInstance->mSubscriberVersion = 0;
+#endif
+            SetTraitInstanceDirty(traitInstance);
         }
         else
         {
@@ -403,7 +429,10 @@ WEAVE_ERROR SubscriptionHandler::ParsePathVersionEventLists(SubscribeRequest::Pa
                 WeaveLogDetail(DataManagement, "Handler[%u] Syncing is requested for trait[%u].path[%u]",
                                SubscriptionEngine::GetInstance()->GetHandlerId(this), traitDataHandle, propertyPathHandle);
 
-                traitInstance->SetDirty();
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+                traitInstance->mSubscriberVersion = 0;
+#endif
+                SetTraitInstanceDirty(traitInstance);
             }
             else
             {
@@ -418,7 +447,13 @@ WEAVE_ERROR SubscriptionHandler::ParsePathVersionEventLists(SubscribeRequest::Pa
                                    SubscriptionEngine::GetInstance()->GetHandlerId(this), traitDataHandle, propertyPathHandle);
 
                     WeaveLogIfFalse(existingVersion < datasourceVersion);
-                    traitInstance->SetDirty();
+
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+                    // The first notify may only carry what changed since the subscriber's version, unless another path to
+                    // this trait instance already asked for all of it.
+                    traitInstance->mSubscriberVersion = traitInstance->IsDirty() ? 0 : existingVersion;
+#endif
+                    SetTraitInstanceDirty(traitInstance);
                 }
                 else
                 {
@@ -790,7 +825,8 @@ WEAVE_ERROR SubscriptionHandler::SendNotificationRequest(PacketBuffer * aMsgBuf)
     aMsgBuf = NULL;
     SuccessOrExit(err);
 
-    mCurrentState = (mCurrentState == kState_Subscribing) ? kState_Subscribing_Notifying : kState_SubscriptionEstablished_Notifying;
+    mCurrentState   = (mCurrentState == kState_Subscribing) ? kState_Subscribing_Notifying : kState_SubscriptionEstablished_Notifying;
+    mLastNotifyTime = System::Timer::GetCurrentEpoch();
 
 exit:
     WeaveLogFunctError(err);
@@ -824,6 +860,8 @@ WEAVE_ERROR SubscriptionHandler::SendSubscribeResponse(const bool aPossibleLossO
                                                        const LastVendedEvent aLastVendedEventList[],
                                                        const size_t aLastVendedEventListSize)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err       = WEAVE_NO_ERROR;
     PacketBuffer * msgBuf = NULL;
     nl::Weave::TLV::TLVWriter writer;
@@ -988,6 +1026,8 @@ void SubscriptionHandler::FlushExistingExchangeContext(const bool aAbortNow)
 #if WDM_ENABLE_SUBSCRIPTION_CANCEL
 WEAVE_ERROR SubscriptionHandler::Cancel()
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err       = WEAVE_NO_ERROR;
     PacketBuffer * msgBuf = NULL;
     bool cancel           = false;
@@ -1109,6 +1149,10 @@ void SubscriptionHandler::_Release()
         mRefCount = 0;
         MoveToState(kState_Free);
 
+#if WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+        SubscriptionEngine::GetInstance()->RemoveHandlerFromIndex(this);
+#endif
+
         // Re-initialize all state data.
         InitAsFree();
 
@@ -1140,6 +1184,7 @@ void SubscriptionHandler::TerminateSubscription(WEAVE_ERROR aReason, StatusRepor
 
         // Clear any outstanding timer.
         (void)RefreshTimer();
+        CancelNotifyHoldOffTimer();
 
         // If a notify was in progress, inform the notification engine that the notify message
         // wasn't delivered, so that it can do some clean-up.
@@ -1215,6 +1260,8 @@ void SubscriptionHandler::AbortSubscription()
 void SubscriptionHandler::CancelRequestHandler(nl::Weave::ExchangeContext * aEC, const nl::Inet::IPPacketInfo * aPktInfo,
                                                const nl::Weave::WeaveMessageInfo * aMsgInfo, PacketBuffer * aPayload)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err         = WEAVE_NO_ERROR;
     uint8_t statusReportLen = 6;
     PacketBuffer * msgBuf   = PacketBuffer::NewWithAvailableSize(statusReportLen);
@@ -1329,8 +1376,11 @@ WEAVE_ERROR SubscriptionHandler::RefreshTimer(void)
                            SubscriptionEngine::GetInstance()->GetHandlerId(this), GetStateStr(), __func__, mRefCount,
                            mLivenessTimeoutMsec);
 
+            // Declaring the subscriber lost may be deferred by up to the periodic timer tolerance, so that the timer can be
+            // coalesced with others.
             err = SubscriptionEngine::GetInstance()->GetExchangeManager()->MessageLayer->SystemLayer->StartTimer(
-                mLivenessTimeoutMsec, OnTimerCallback, this);
+                mLivenessTimeoutMsec, mLivenessTimeoutMsec / 100 * WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT,
+                OnTimerCallback, this);
 
             VerifyOrExit(WEAVE_SYSTEM_NO_ERROR == err, /* no-op */);
         }
@@ -1753,6 +1803,62 @@ void SubscriptionHandler::SetMaxNotificationSize(const uint32_t aMaxSize)
         mMaxNotificationSize = aMaxSize;
 }
 
+/**
+ * Decide whether a notify on this subscription should wait for the minimum notify interval to elapse. If so, a timer is armed
+ * to re-run the notification engine at the end of the interval, by which time all changes made in the meantime are coalesced
+ * into the dirty state of the subscription. Notifies that are part of establishing the subscription are never held off.
+ *
+ * @retval true if the notify should be deferred, false if it can be sent now.
+ */
+bool SubscriptionHandler::ShouldHoldOffNotify(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    bool holdOff    = false;
+    System::Timer::Epoch elapsed;
+
+    VerifyOrExit(mMinNotifyIntervalMsec > 0 && kState_SubscriptionEstablished_Idle == mCurrentState, );
+
+    elapsed = System::Timer::GetCurrentEpoch() - mLastNotifyTime;
+    VerifyOrExit(elapsed < mMinNotifyIntervalMsec, );
+
+    if (!mIsNotifyHoldOffTimerArmed)
+    {
+        err = SubscriptionEngine::GetInstance()->GetExchangeManager()->MessageLayer->SystemLayer->StartTimer(
+            mMinNotifyIntervalMsec - static_cast<uint32_t>(elapsed), OnNotifyHoldOffTimerCallback, this);
+
+        // Without a timer nothing would wake the engine up again, so send the notify right away instead.
+        SuccessOrExit(err);
+
+        mIsNotifyHoldOffTimerArmed = true;
+    }
+
+    holdOff = true;
+
+exit:
+    WeaveLogFunctError(err);
+
+    return holdOff;
+}
+
+void SubscriptionHandler::CancelNotifyHoldOffTimer(void)
+{
+    if (mIsNotifyHoldOffTimerArmed)
+    {
+        SubscriptionEngine::GetInstance()->GetExchangeManager()->MessageLayer->SystemLayer->CancelTimer(
+            OnNotifyHoldOffTimerCallback, this);
+        mIsNotifyHoldOffTimerArmed = false;
+    }
+}
+
+void SubscriptionHandler::OnNotifyHoldOffTimerCallback(System::Layer * aSystemLayer, void * aAppState, System::Error)
+{
+    SubscriptionHandler * const pHandler = reinterpret_cast<SubscriptionHandler *>(aAppState);
+
+    pHandler->mIsNotifyHoldOffTimerArmed = false;
+
+    SubscriptionEngine::GetInstance()->GetNotificationEngine()->ScheduleRun();
+}
+
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 }; // namespace Profiles
 }; // namespace Weave
@@ -55,14 +55,30 @@ public:
 
     struct TraitInstanceInfo
     {
-        void Init(void) { this->ClearDirty(); }
+        void Init(void)
+        {
+            this->ClearDirty();
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+            mSubscriberVersion = 0;
+#endif
+        }
         bool IsDirty(void) { return mDirty; }
         void SetDirty(void) { mDirty = true; }
         void ClearDirty(void) { mDirty = false; }
 
         TraitDataHandle mTraitDataHandle;
         uint16_t mRequestedVersion;
+#if WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
+        // Next trait instance info (pool index + 1, or 0) in the same trait index bucket, and the id of the handler that
+        // owns this one. Maintained by the SubscriptionEngine.
+        uint16_t mNextInTraitIndex;
+        uint16_t mHandlerId;
+#endif // WDM_PUBLISHER_TRAIT_INDEX_SIZE > 0
         bool mDirty;
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+        // Older version of the trait instance the subscriber said it holds, or 0 if it needs the whole trait instance.
+        uint64_t mSubscriberVersion;
+#endif
     };
 
     enum EventID
@@ -187,12 +203,33 @@ public:
 
     void SetMaxNotificationSize(const uint32_t aMaxPayload);
 
+    /**
+     * @brief Set the minimum interval between the starts of two consecutive notifies on this subscription once it is
+     * established. Trait data changes made within the interval are coalesced and sent in a single notify carrying the latest
+     * state when the interval elapses. Defaults to WDM_PUBLISHER_DEFAULT_MIN_NOTIFY_INTERVAL_MSEC; 0 disables coalescing.
+     *
+     * @param[in] aIntervalMsec     Minimum notify interval in milliseconds
+     */
+    void SetMinNotifyInterval(const uint32_t aIntervalMsec) { mMinNotifyIntervalMsec = aIntervalMsec; }
+
+    uint32_t GetMinNotifyInterval(void) const { return mMinNotifyIntervalMsec; }
+
+    /**
+     * @brief Return the number of bytes of engine memory held by this subscription: the handler object itself plus its entries
+     * in the shared trait instance pool. Useful for sizing the handler and path group pools.
+     */
+    size_t GetMemoryUsage(void) const
+    {
+        return sizeof(SubscriptionHandler) + (mNumTraitInstances * sizeof(TraitInstanceInfo));
+    }
+
 private:
     friend class SubscriptionEngine;
     friend class NotificationEngine;
     friend class TestSubscriptionHandler;
     friend class TestTdm;
     friend class TestWdm;
+    friend class BenchWdm;
 
     struct LastVendedEvent
     {
@@ -221,6 +258,10 @@ private:
 
     bool IsNotifiable(void)
     {
+#if WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+        if (mIsNotifySendPending)
+            return false;
+#endif
         return (mCurrentState == kState_Subscribing || mCurrentState == kState_SubscriptionEstablished_Idle);
     }
     bool IsSubscribing(void)
@@ -250,12 +291,59 @@ private:
     uint16_t mMaxNotificationSize;
     uint32_t mCurProcessingTraitInstanceIdx;
 
+    // Number of entries in mTraitInstanceList that are dirty. Lets the notification engine skip clean subscriptions without
+    // walking their trait instance lists; only change the dirty flags through the two functions below.
+    uint16_t mNumDirtyTraitInstances;
+
     TraitInstanceInfo * GetTraitInstanceInfoList(void) { return mTraitInstanceList; }
     uint32_t GetNumTraitInstances(void) { return mNumTraitInstances; }
 
+    bool IsTraitDataDirty(void) const { return mNumDirtyTraitInstances > 0; }
+    void SetTraitInstanceDirty(TraitInstanceInfo * aTraitInfo)
+    {
+        if (!aTraitInfo->IsDirty())
+        {
+            aTraitInfo->SetDirty();
+            mNumDirtyTraitInstances++;
+        }
+    }
+    void ClearTraitInstanceDirty(TraitInstanceInfo * aTraitInfo)
+    {
+        if (aTraitInfo->IsDirty())
+        {
+            aTraitInfo->ClearDirty();
+            mNumDirtyTraitInstances--;
+        }
+    }
+
     void OnNotifyProcessingComplete(const bool aPossibleLossOfEvent, const LastVendedEvent aLastVendedEventList[],
                                     const size_t aLastVendedEventListSize);
 
+#if WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+    // Link to the next handler (id + 1, or 0 at the end) in the same SubscriptionEngine handler index bucket, and the bucket
+    // this handler is linked into (kNotIndexed if none). Maintained by the SubscriptionEngine.
+    enum
+    {
+        kNotIndexed = UINT16_MAX,
+    };
+    uint16_t mNextInIndexBucket;
+    uint16_t mIndexBucket;
+#endif // WDM_PUBLISHER_HANDLER_INDEX_SIZE > 0
+
+    // Notify coalescing: the start time of the last notify sent and whether a timer is pending to re-run the notification
+    // engine once mMinNotifyIntervalMsec has elapsed since then.
+    uint32_t mMinNotifyIntervalMsec;
+    System::Timer::Epoch mLastNotifyTime;
+    bool mIsNotifyHoldOffTimerArmed;
+
+    bool ShouldHoldOffNotify(void);
+    void CancelNotifyHoldOffTimer(void);
+
+#if WDM_PUBLISHER_SEND_NOTIFIES_OUTSIDE_LOCK
+    // A notify has been built for this subscription and is waiting for the notification engine to send it.
+    bool mIsNotifySendPending;
+#endif
+
     bool mSubscribeToAllEvents;
     // TODO: WEAV-1426 in this incarnation, we do not account for event aggregation.
     event_id_t mSelfVendedEvents[kImportanceType_Last - kImportanceType_First + 1];
@@ -315,6 +403,7 @@ private:
     static void BindingEventCallback(void * const apAppState, const Binding::EventType aEvent,
                                      const Binding::InEventParam & aInParam, Binding::OutEventParam & aOutParam);
     static void OnTimerCallback(System::Layer * aSystemLayer, void * aAppState, System::Error aErrorCode);
+    static void OnNotifyHoldOffTimerCallback(System::Layer * aSystemLayer, void * aAppState, System::Error aErrorCode);
     static void OnAckReceived(ExchangeContext * aEC, void * aMsgSpecificContext);
     static void OnSendError(ExchangeContext * aEC, WEAVE_ERROR aErrorCode, void * aMsgSpecificContext);
     static void OnResponseTimeout(nl::Weave::ExchangeContext * aEC);
@@ -37,6 +37,7 @@
 #include <Weave/Profiles/data-management/DataManagement.h>
 #include <Weave/Support/WeaveFaultInjection.h>
 #include <Weave/Support/RandUtils.h>
+#include <SystemLayer/SystemTrace.h>
 #if WEAVE_CONFIG_DATA_MANAGEMENT_CLIENT_EXPERIMENTAL
 #include <string>
 #endif // WEAVE_CONFIG_DATA_MANAGEMENT_CLIENT_EXPERIMENTAL
@@ -283,7 +284,7 @@ uint64_t TraitSchemaEngine::GetTag(PropertyPathHandle aHandle) const
     }
     else
     {
-        return ContextTag(GetMap(aHandle)->mContextTag);
+        return ContextTag(GetContextTag(GetPropertySchemaHandle(aHandle)));
     }
 }
 
@@ -381,9 +382,8 @@ WEAVE_ERROR TraitSchemaEngine::RetrieveData(PropertyPathHandle aHandle, uint64_t
             for (childProperty = GetFirstChild(aHandle); !IsNullPropertyPathHandle(childProperty);
                  childProperty = GetNextChild(aHandle, childProperty))
             {
-                const PropertyInfo * childInfo = GetMap(childProperty);
-
-                err = RetrieveData(childProperty, ContextTag(childInfo->mContextTag), aWriter, aDelegate, updateDirtyPathCut);
+                err = RetrieveData(childProperty, ContextTag(GetContextTag(GetPropertySchemaHandle(childProperty))), aWriter,
+                                   aDelegate, updateDirtyPathCut);
                 SuccessOrExit(err);
             }
         }
@@ -708,15 +708,14 @@ PropertyPathHandle TraitSchemaEngine::GetParent(PropertyPathHandle aHandle) cons
 {
     PropertySchemaHandle schemaHandle   = GetPropertySchemaHandle(aHandle);
     PropertyDictionaryKey dictionaryKey = GetPropertyDictionaryKey(aHandle);
-    const PropertyInfo * handleMap      = GetMap(schemaHandle);
 
-    if (!handleMap)
+    if (schemaHandle < kHandleTableOffset || (schemaHandle >= (mSchema.mNumSchemaHandleEntries + kHandleTableOffset)))
     {
         return kNullPropertyPathHandle;
     }
 
     // update the schema handle to point to the parent handle.
-    schemaHandle = handleMap->mParentHandle;
+    schemaHandle = GetParentSchemaHandle(schemaHandle);
 
     // if the parent is a dictionary, just return the schema handle with the key cleared out since the key doesn't make sense
     // anymore at this level or higher.
@@ -743,7 +742,7 @@ PropertyPathHandle TraitSchemaEngine::GetNextChild(PropertyPathHandle aParentHan
     // Starting from 1 node after the child node that's been passed in, iterate till we find the next child belonging to aParentId.
     for (i = (childSchemaHandle - 1); i < mSchema.mNumSchemaHandleEntries; i++)
     {
-        if (mSchema.mSchemaHandleTbl[i].mParentHandle == parentSchemaHandle)
+        if (GetParentSchemaHandle(i + kHandleTableOffset) == parentSchemaHandle)
         {
             break;
         }
@@ -771,10 +770,51 @@ PropertyPathHandle TraitSchemaEngine::GetChildHandle(PropertyPathHandle aParentH
 
 PropertyPathHandle TraitSchemaEngine::_GetChildHandle(PropertyPathHandle aParentHandle, uint8_t aContextTag) const
 {
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+    const SchemaIndex * index = GetIndex();
+
+    if (index != NULL)
+    {
+        PropertySchemaHandle parentSchemaHandle = GetPropertySchemaHandle(aParentHandle);
+        uint32_t low, high;
+
+        if (parentSchemaHandle >= (mSchema.mNumSchemaHandleEntries + kHandleTableOffset))
+        {
+            return kNullPropertyPathHandle;
+        }
+
+        // The children of each node are sorted by context tag.
+        low  = index->mFirstChild[parentSchemaHandle];
+        high = index->mFirstChild[parentSchemaHandle + 1];
+
+        while (low < high)
+        {
+            uint32_t mid                     = (low + high) / 2;
+            PropertySchemaHandle childHandle = index->mChildren[mid];
+            uint8_t childTag                 = GetContextTag(childHandle);
+
+            if (childTag == aContextTag)
+            {
+                return CreatePropertyPathHandle(childHandle, GetPropertyDictionaryKey(aParentHandle));
+            }
+            else if (childTag < aContextTag)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        return kNullPropertyPathHandle;
+    }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
     for (PropertyPathHandle childProperty = GetFirstChild(aParentHandle); !IsNullPropertyPathHandle(childProperty);
          childProperty                    = GetNextChild(aParentHandle, childProperty))
     {
-        if (mSchema.mSchemaHandleTbl[GetPropertySchemaHandle(childProperty) - kHandleTableOffset].mContextTag == aContextTag)
+        if (GetContextTag(GetPropertySchemaHandle(childProperty)) == aContextTag)
         {
             return childProperty;
         }
@@ -805,9 +845,18 @@ bool TraitSchemaEngine::IsLeaf(PropertyPathHandle aHandle) const
     }
     else
     {
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+        const SchemaIndex * index = GetIndex();
+
+        if (index != NULL && schemaHandle < (mSchema.mNumSchemaHandleEntries + kHandleTableOffset))
+        {
+            return index->mFirstChild[schemaHandle] == index->mFirstChild[schemaHandle + 1];
+        }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
         for (unsigned int i = 0; i < mSchema.mNumSchemaHandleEntries; i++)
         {
-            if (mSchema.mSchemaHandleTbl[i].mParentHandle == schemaHandle)
+            if (GetParentSchemaHandle(i + kHandleTableOffset) == schemaHandle)
             {
                 return false;
             }
@@ -827,10 +876,19 @@ int32_t TraitSchemaEngine::GetDepth(PropertyPathHandle aHandle) const
         return -1;
     }
 
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+    const SchemaIndex * index = GetIndex();
+
+    if (index != NULL)
+    {
+        return index->mDepth[schemaHandle];
+    }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
     while (schemaHandle != kRootPropertyPathHandle)
     {
         depth++;
-        schemaHandle = mSchema.mSchemaHandleTbl[schemaHandle - kHandleTableOffset].mParentHandle;
+        schemaHandle = GetParentSchemaHandle(schemaHandle);
     }
 
     return depth;
@@ -890,11 +948,106 @@ PropertyPathHandle TraitSchemaEngine::FindLowestCommonAncestor(PropertyPathHandl
     return aHandle1;
 }
 
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+/**
+ * Returns the lookup tables of the schema, building them if this is the first time
+ * they are used; returns NULL if the schema doesn't provide any.
+ */
+const TraitSchemaEngine::SchemaIndex * TraitSchemaEngine::GetIndex(void) const
+{
+    SchemaIndex * index = mSchema.mIndex;
+
+#if (TDM_EXTENSION_SUPPORT)
+    // The handles of an extended schema can refer to its parent schema's table.
+    if (mSchema.mParentSchema != NULL)
+    {
+        return NULL;
+    }
+#endif
+
+    if (index != NULL && !index->mIsBuilt)
+    {
+        BuildIndex(*index);
+    }
+
+    return index;
+}
+
+void TraitSchemaEngine::BuildIndex(SchemaIndex & aIndex) const
+{
+    const uint32_t numEntries = mSchema.mNumSchemaHandleEntries;
+    const uint32_t numHandles = numEntries + kHandleTableOffset;
+    uint32_t i;
+
+    // Count the children of each node, then turn the counts into the offsets at which each group of
+    // children ends; filling the groups from the back leaves each offset at the start of its group.
+    memset(aIndex.mFirstChild, 0, (numHandles + 1) * sizeof(aIndex.mFirstChild[0]));
+
+    for (i = 0; i < numEntries; i++)
+    {
+        aIndex.mFirstChild[GetParentSchemaHandle(i + kHandleTableOffset)]++;
+    }
+
+    for (i = 1; i < numHandles; i++)
+    {
+        aIndex.mFirstChild[i] = static_cast<uint16_t>(aIndex.mFirstChild[i] + aIndex.mFirstChild[i - 1]);
+    }
+
+    aIndex.mFirstChild[numHandles] = static_cast<uint16_t>(numEntries);
+
+    for (i = numEntries; i > 0; i--)
+    {
+        PropertySchemaHandle parentHandle = GetParentSchemaHandle(i - 1 + kHandleTableOffset);
+
+        aIndex.mChildren[--aIndex.mFirstChild[parentHandle]] = static_cast<PropertySchemaHandle>(i - 1 + kHandleTableOffset);
+    }
+
+    // Sort each group of children by context tag; groups are small, so insertion sort it is.
+    for (i = 0; i < numHandles; i++)
+    {
+        for (uint32_t j = aIndex.mFirstChild[i] + 1U; j < aIndex.mFirstChild[i + 1]; j++)
+        {
+            PropertySchemaHandle child = aIndex.mChildren[j];
+            uint8_t tag                = GetContextTag(child);
+            uint32_t k                 = j;
+
+            while (k > aIndex.mFirstChild[i] && GetContextTag(aIndex.mChildren[k - 1]) > tag)
+            {
+                aIndex.mChildren[k] = aIndex.mChildren[k - 1];
+                k--;
+            }
+
+            aIndex.mChildren[k] = child;
+        }
+    }
+
+    aIndex.mDepth[0]                       = 0;
+    aIndex.mDepth[kRootPropertyPathHandle] = 0;
+
+    for (i = kHandleTableOffset; i < numHandles; i++)
+    {
+        PropertySchemaHandle schemaHandle = static_cast<PropertySchemaHandle>(i);
+        uint8_t depth                     = 0;
+
+        while (schemaHandle != kRootPropertyPathHandle)
+        {
+            depth++;
+            schemaHandle = GetParentSchemaHandle(schemaHandle);
+        }
+
+        aIndex.mDepth[i] = depth;
+    }
+
+    aIndex.mIsBuilt = true;
+}
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
 const TraitSchemaEngine::PropertyInfo * TraitSchemaEngine::GetMap(PropertyPathHandle aHandle) const
 {
     PropertySchemaHandle schemaHandle = GetPropertySchemaHandle(aHandle);
 
-    if (schemaHandle < 2 || (schemaHandle >= (mSchema.mNumSchemaHandleEntries + kHandleTableOffset)))
+    if (schemaHandle < 2 || (schemaHandle >= (mSchema.mNumSchemaHandleEntries + kHandleTableOffset)) ||
+        mSchema.mSchemaHandleTbl == NULL)
     {
         return NULL;
     }
@@ -902,11 +1055,35 @@ const TraitSchemaEngine::PropertyInfo * TraitSchemaEngine::GetMap(PropertyPathHa
     return &mSchema.mSchemaHandleTbl[schemaHandle - kHandleTableOffset];
 }
 
+PropertySchemaHandle TraitSchemaEngine::GetParentSchemaHandle(PropertySchemaHandle aHandle) const
+{
+#if (TDM_PACKED_SCHEMA_SUPPORT)
+    if (mSchema.mPackedSchema != NULL)
+    {
+        return mSchema.mPackedSchema->mParentHandles[aHandle - kHandleTableOffset];
+    }
+#endif
+
+    return mSchema.mSchemaHandleTbl[aHandle - kHandleTableOffset].mParentHandle;
+}
+
+uint8_t TraitSchemaEngine::GetContextTag(PropertySchemaHandle aHandle) const
+{
+#if (TDM_PACKED_SCHEMA_SUPPORT)
+    if (mSchema.mPackedSchema != NULL)
+    {
+        return mSchema.mPackedSchema->mContextTags[aHandle - kHandleTableOffset];
+    }
+#endif
+
+    return mSchema.mSchemaHandleTbl[aHandle - kHandleTableOffset].mContextTag;
+}
+
 bool TraitSchemaEngine::IsDictionary(PropertyPathHandle aHandle) const
 {
     // The 'mIsDictionaryBitfield' is only populated by code-gen on traits that do have dictionaries. Otherwise, it defaults
     // to NULL.
-    return GetBitFromPathHandleBitfield(mSchema.mIsDictionaryBitfield, aHandle);
+    return GetPropertyFlag(mSchema.mIsDictionaryBitfield, kPackedPropertyFlag_IsDictionary, aHandle);
 }
 
 bool TraitSchemaEngine::IsInDictionary(PropertyPathHandle aHandle, PropertyPathHandle & aDictionaryItemHandle) const
@@ -929,17 +1106,17 @@ bool TraitSchemaEngine::IsInDictionary(PropertyPathHandle aHandle, PropertyPathH
 
 bool TraitSchemaEngine::IsOptional(PropertyPathHandle aHandle) const
 {
-    return GetBitFromPathHandleBitfield(mSchema.mIsOptionalBitfield, aHandle);
+    return GetPropertyFlag(mSchema.mIsOptionalBitfield, kPackedPropertyFlag_IsOptional, aHandle);
 }
 
 bool TraitSchemaEngine::IsNullable(PropertyPathHandle aHandle) const
 {
-    return GetBitFromPathHandleBitfield(mSchema.mIsNullableBitfield, aHandle);
+    return GetPropertyFlag(mSchema.mIsNullableBitfield, kPackedPropertyFlag_IsNullable, aHandle);
 }
 
 bool TraitSchemaEngine::IsEphemeral(PropertyPathHandle aHandle) const
 {
-    return GetBitFromPathHandleBitfield(mSchema.mIsEphemeralBitfield, aHandle);
+    return GetPropertyFlag(mSchema.mIsEphemeralBitfield, kPackedPropertyFlag_IsEphemeral, aHandle);
 }
 
 bool TraitSchemaEngine::GetBitFromPathHandleBitfield(uint8_t * aBitfield, PropertyPathHandle aPathHandle) const
@@ -953,6 +1130,29 @@ bool TraitSchemaEngine::GetBitFromPathHandleBitfield(uint8_t * aBitfield, Proper
     return retval;
 }
 
+bool TraitSchemaEngine::GetPropertyFlag(uint8_t * aBitfield, uint8_t aPackedFlag, PropertyPathHandle aPathHandle) const
+{
+#if (TDM_PACKED_SCHEMA_SUPPORT)
+    if (mSchema.mPackedSchema != NULL)
+    {
+        const uint8_t * flags = mSchema.mPackedSchema->mFlags;
+        bool retval           = false;
+
+        if (flags != NULL && !IsRootPropertyPathHandle(aPathHandle) && !IsNullPropertyPathHandle(aPathHandle))
+        {
+            PropertySchemaHandle adjustedSchemaHandle = GetPropertySchemaHandle(aPathHandle) - kHandleTableOffset;
+            retval = ((flags[adjustedSchemaHandle / 2] >> ((adjustedSchemaHandle % 2) * 4)) & aPackedFlag) != 0;
+        }
+
+        return retval;
+    }
+#else
+    IgnoreUnusedVariable(aPackedFlag);
+#endif
+
+    return GetBitFromPathHandleBitfield(aBitfield, aPathHandle);
+}
+
 bool TraitSchemaEngine::MatchesProfileId(uint32_t aProfileId) const
 {
     return (aProfileId == mSchema.mProfileId);
@@ -1085,11 +1285,21 @@ TraitDataSink::TraitDataSink(const TraitSchemaEngine * aEngine)
     mVersion           = 0;
     mLastNotifyVersion = 0;
     mHasValidVersion   = 0;
+
+#if TDM_SINK_CHANGE_SET_SUPPORT
+    mChangeSet            = NULL;
+    mChangeSetSize        = 0;
+    mNumChangeSetEntries  = 0;
+    mChangeSetPending     = false;
+    mNextPendingChangeSet = NULL;
+#endif
 }
 
 WEAVE_ERROR TraitDataSink::StoreDataElement(PropertyPathHandle aHandle, TLVReader & aReader, uint8_t aFlags,
                                             OnChangeRejection aFunc, void * aContext, TraitDataHandle aDatahandle)
 {
+    SYSTEM_TRACE_SCOPE("DataManagement", "TraitDataSink::StoreDataElement");
+
     DataElement::Parser parser;
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     DataVersion versionInDE;
@@ -1117,69 +1327,50 @@ WEAVE_ERROR TraitDataSink::StoreDataElement(PropertyPathHandle aHandle, TLVReade
         err = parser.CheckPresence(&dataPresent, &deletePresent);
         SuccessOrExit(err);
 
-        if (aFlags & kFirstElementInChange)
+#if TDM_SINK_CHANGE_SET_SUPPORT
+        if (mChangeSet != NULL)
         {
-            OnEvent(kEventChangeBegin, NULL);
-        }
+            // The application gets this data element in OnChangeSet, once the rest of the DataList has been processed.
+            AddChangeSetEntry(aHandle, aReader, aFlags);
 
-        // Signal to the app we're about to process a data element.
-        OnEvent(kEventDataElementBegin, NULL);
-
-        // TODO: we need to check if there are pending updates for paths
-        // being deleted
-        if (deletePresent)
+            if (aFlags & kLastElementInChange)
+            {
+                SetVersion(versionInDE);
+            }
+        }
+        else
+#endif // TDM_SINK_CHANGE_SET_SUPPORT
         {
-            err = parser.GetDeletedDictionaryKeys(&aReader);
-            SuccessOrExit(err);
+            UpdateDirtyPathFilter pathFilter(GetSubscriptionClient(), aDatahandle, mSchemaEngine);
 
-            while ((err = aReader.Next()) == WEAVE_NO_ERROR)
+            if (aFlags & kFirstElementInChange)
             {
-                PropertyDictionaryKey key;
-                PropertyPathHandle handle;
-
-                err = aReader.Get(key);
-                SuccessOrExit(err);
-
-                // In the case of a delete, the path is usually directed to the dictionary itself. We
-                // need to get the handle to the child dictionary element handle first before we can
-                // pass it up to the application.
-                handle = mSchemaEngine->GetFirstChild(aHandle);
-                VerifyOrExit(handle != kNullPropertyPathHandle, err = WEAVE_ERROR_INVALID_ARGUMENT);
-
-                handle = CreatePropertyPathHandle(GetPropertySchemaHandle(handle), key);
-                OnEvent(kEventDictionaryItemDelete, &handle);
+                OnEvent(kEventChangeBegin, NULL);
             }
 
-            VerifyOrExit(err == WEAVE_NO_ERROR || err == WEAVE_END_OF_TLV, );
-            err = WEAVE_NO_ERROR;
-        }
-
-        if (aHandle != kNullPropertyPathHandle && dataPresent)
-        {
-            err = parser.GetData(&aReader);
-            SuccessOrExit(err);
+            // Signal to the app we're about to process a data element.
+            OnEvent(kEventDataElementBegin, NULL);
 
-            UpdateDirtyPathFilter pathFilter(GetSubscriptionClient(), aDatahandle, mSchemaEngine);
-            err = mSchemaEngine->StoreData(aHandle, aReader, this, &pathFilter);
-        }
+            err = ApplyDataElement(aHandle, parser, aReader, dataPresent, deletePresent, &pathFilter);
 
-        OnEvent(kEventDataElementEnd, NULL);
+            OnEvent(kEventDataElementEnd, NULL);
 
-        // Only update the version number if the StoreData succeeded
-        if (err == WEAVE_NO_ERROR)
-        {
-            // Only update our internal version tracker if this is indeed the last element in the change.
-            if (aFlags & kLastElementInChange)
+            // Only update the version number if the StoreData succeeded
+            if (err == WEAVE_NO_ERROR)
             {
-                SetVersion(versionInDE);
+                // Only update our internal version tracker if this is indeed the last element in the change.
+                if (aFlags & kLastElementInChange)
+                {
+                    SetVersion(versionInDE);
 
-                OnEvent(kEventChangeEnd, NULL);
+                    OnEvent(kEventChangeEnd, NULL);
+                }
+            }
+            else
+            {
+                // We need to clear this since we don't have a good version of data anymore.
+                ClearVersion();
             }
-        }
-        else
-        {
-            // We need to clear this since we don't have a good version of data anymore.
-            ClearVersion();
         }
     }
     else
@@ -1197,6 +1388,172 @@ exit:
     return err;
 }
 
+WEAVE_ERROR TraitDataSink::ApplyDataElement(PropertyPathHandle aHandle, DataElement::Parser & aParser, TLVReader & aReader,
+                                            bool aDataPresent, bool aDeletePresent, IPathFilter * apPathFilter)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    // TODO: we need to check if there are pending updates for paths
+    // being deleted
+    if (aDeletePresent)
+    {
+        err = aParser.GetDeletedDictionaryKeys(&aReader);
+        SuccessOrExit(err);
+
+        while ((err = aReader.Next()) == WEAVE_NO_ERROR)
+        {
+            PropertyDictionaryKey key;
+            PropertyPathHandle handle;
+
+            err = aReader.Get(key);
+            SuccessOrExit(err);
+
+            // In the case of a delete, the path is usually directed to the dictionary itself. We
+            // need to get the handle to the child dictionary element handle first before we can
+            // pass it up to the application.
+            handle = mSchemaEngine->GetFirstChild(aHandle);
+            VerifyOrExit(handle != kNullPropertyPathHandle, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+            handle = CreatePropertyPathHandle(GetPropertySchemaHandle(handle), key);
+            OnEvent(kEventDictionaryItemDelete, &handle);
+        }
+
+        VerifyOrExit(err == WEAVE_NO_ERROR || err == WEAVE_END_OF_TLV, );
+        err = WEAVE_NO_ERROR;
+    }
+
+    if (aHandle != kNullPropertyPathHandle && aDataPresent)
+    {
+        err = aParser.GetData(&aReader);
+        SuccessOrExit(err);
+
+        err = mSchemaEngine->StoreData(aHandle, aReader, this, apPathFilter);
+    }
+
+exit:
+    return err;
+}
+
+#if TDM_SINK_CHANGE_SET_SUPPORT
+TraitDataSink * TraitDataSink::sPendingChangeSetsHead = NULL;
+TraitDataSink * TraitDataSink::sPendingChangeSetsTail = NULL;
+
+WEAVE_ERROR TraitDataSink::SetChangeSetStore(ChangeSetEntry * aEntries, uint16_t aNumEntries)
+{
+    WEAVE_ERROR err  = WEAVE_NO_ERROR;
+    bool isUpdatable = false;
+
+#if WEAVE_CONFIG_ENABLE_WDM_UPDATE
+    isUpdatable = IsUpdatableDataSink();
+#endif
+
+    VerifyOrExit(aEntries == NULL || !isUpdatable, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    if (mNumChangeSetEntries > 0)
+    {
+        DeliverChangeSet();
+    }
+
+    mChangeSet     = (aNumEntries > 0) ? aEntries : NULL;
+    mChangeSetSize = (mChangeSet != NULL) ? aNumEntries : 0;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR TraitDataSink::ApplyChangeSetEntry(const ChangeSetEntry & aEntry)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    DataElement::Parser parser;
+    TLVReader reader;
+    bool dataPresent = false, deletePresent = false;
+
+    reader.Init(aEntry.mReader);
+
+    err = parser.Init(reader);
+    SuccessOrExit(err);
+
+    err = parser.CheckPresence(&dataPresent, &deletePresent);
+    SuccessOrExit(err);
+
+    err = ApplyDataElement(aEntry.mHandle, parser, reader, dataPresent, deletePresent, NULL);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+void TraitDataSink::AddChangeSetEntry(PropertyPathHandle aHandle, const TLVReader & aReader, uint8_t aFlags)
+{
+    // Out of room: hand over what has been received so far.
+    if (mNumChangeSetEntries == mChangeSetSize)
+    {
+        DeliverChangeSet();
+    }
+
+    mChangeSet[mNumChangeSetEntries].mHandle = aHandle;
+    mChangeSet[mNumChangeSetEntries].mFlags  = aFlags;
+    mChangeSet[mNumChangeSetEntries].mReader.Init(aReader);
+    mNumChangeSetEntries++;
+
+    if (!mChangeSetPending)
+    {
+        mChangeSetPending     = true;
+        mNextPendingChangeSet = NULL;
+
+        if (sPendingChangeSetsTail != NULL)
+        {
+            sPendingChangeSetsTail->mNextPendingChangeSet = this;
+        }
+        else
+        {
+            sPendingChangeSetsHead = this;
+        }
+
+        sPendingChangeSetsTail = this;
+    }
+}
+
+void TraitDataSink::DeliverChangeSet(void)
+{
+    WEAVE_ERROR err;
+    uint16_t numEntries = mNumChangeSetEntries;
+
+    mNumChangeSetEntries = 0;
+
+    err = OnChangeSet(mChangeSet, numEntries);
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(DataManagement, "<OnChangeSet> [Trait %08x] failed: %d", mSchemaEngine->GetProfileId(), err);
+
+        // We need to clear this since we don't have a good version of data anymore.
+        ClearVersion();
+    }
+}
+
+void TraitDataSink::DeliverPendingChangeSets(void)
+{
+    while (sPendingChangeSetsHead != NULL)
+    {
+        TraitDataSink * sink = sPendingChangeSetsHead;
+
+        sPendingChangeSetsHead = sink->mNextPendingChangeSet;
+        if (sPendingChangeSetsHead == NULL)
+        {
+            sPendingChangeSetsTail = NULL;
+        }
+
+        sink->mNextPendingChangeSet = NULL;
+        sink->mChangeSetPending     = false;
+
+        if (sink->mNumChangeSetEntries > 0)
+        {
+            sink->DeliverChangeSet();
+        }
+    }
+}
+#endif // TDM_SINK_CHANGE_SET_SUPPORT
+
 void TraitDataSink::OnSetDataEvent(SetDataEventType aEventType, PropertyPathHandle aHandle)
 {
     EventType event;
@@ -1265,6 +1622,14 @@ TraitDataSource::TraitDataSource(const TraitSchemaEngine * aEngine)
 #if (WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER == IntermediateGraphSolver)
     ClearRootDirty();
 #endif
+
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    SetVersionHistoryStore(NULL, 0);
+#endif
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+    SetSnapshotStore(NULL, 0);
+#endif
 }
 
 uint64_t TraitDataSource::GetVersion(void)
@@ -1353,7 +1718,29 @@ WEAVE_ERROR TraitDataSource::ReadData(PropertyPathHandle aHandle, uint64_t aTagT
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     Lock();
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+    if (aHandle == kRootPropertyPathHandle && mSnapshotBuf != NULL)
+    {
+        if (!mSnapshotValid)
+        {
+            // On failure, fall through to the schema walk, which reports the error if there is one.
+            UpdateSnapshot();
+        }
+
+        if (mSnapshotValid)
+        {
+            err = aWriter.PutPreEncodedContainer(aTagToWrite, kTLVType_Structure, mSnapshotBuf + mSnapshotDataOffset,
+                                                 mSnapshotDataLen);
+            ExitNow();
+        }
+    }
+#endif // WDM_PUBLISHER_SNAPSHOT_SUPPORT
+
     err = mSchemaEngine->RetrieveData(aHandle, aTagToWrite, aWriter, this);
+    SuccessOrExit(err);
+
+exit:
     Unlock();
 
     return err;
@@ -1365,6 +1752,20 @@ void TraitDataSource::SetDirty(PropertyPathHandle aPropertyHandle)
     {
         mSetDirtyCalled = true;
         SubscriptionEngine::GetInstance()->GetNotificationEngine()->SetDirty(this, aPropertyHandle);
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+        InvalidateSnapshot();
+#endif
+
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+        // A dirty dictionary may have lost items, which only a replace of the dictionary (i.e. a path to its parent) conveys.
+        if (mSchemaEngine->IsDictionary(aPropertyHandle))
+        {
+            aPropertyHandle = mSchemaEngine->GetParent(aPropertyHandle);
+        }
+
+        RecordChange(aPropertyHandle);
+#endif
     }
 }
 
@@ -1376,6 +1777,14 @@ void TraitDataSource::DeleteKey(PropertyPathHandle aPropertyHandle)
     {
         mSetDirtyCalled = true;
         SubscriptionEngine::GetInstance()->GetNotificationEngine()->DeleteKey(this, aPropertyHandle);
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+        InvalidateSnapshot();
+#endif
+
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+        RecordChange(mSchemaEngine->GetParent(mSchemaEngine->GetParent(aPropertyHandle)));
+#endif
     }
 }
 #endif // TDM_ENABLE_PUBLISHER_DICTIONARY_SUPPORT
@@ -1394,6 +1803,10 @@ WEAVE_ERROR TraitDataSource::Unlock()
         IncrementVersion();
     }
 
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    CommitVersionHistory(mManagedVersion && mSetDirtyCalled);
+#endif
+
     VerifyOrDie(SubscriptionEngine::GetInstance());
     return SubscriptionEngine::GetInstance()->Unlock();
 }
@@ -1406,11 +1819,176 @@ WEAVE_ERROR TraitDataSource::Unlock(bool aSkipVersionIncrement)
         IncrementVersion();
     }
 
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    CommitVersionHistory(mManagedVersion && mSetDirtyCalled && !aSkipVersionIncrement);
+#endif
+
     VerifyOrDie(SubscriptionEngine::GetInstance());
     return SubscriptionEngine::GetInstance()->Unlock();
 }
 #endif // WDM_ENABLE_PUBLISHER_UPDATE_SERVER_SUPPORT
 
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+void TraitDataSource::SetSnapshotStore(uint8_t * aBuf, uint16_t aBufSize)
+{
+    mSnapshotBuf        = (aBufSize != 0) ? aBuf : NULL;
+    mSnapshotBufSize    = (aBuf != NULL) ? aBufSize : 0;
+    mSnapshotDataOffset = 0;
+    mSnapshotDataLen    = 0;
+    mSnapshotValid      = false;
+}
+
+/**
+ * Encode the whole trait instance into the snapshot store and locate the members of the root structure, so that
+ * later reads of the root can re-emit them under any tag. Must be called with the source locked.
+ */
+WEAVE_ERROR TraitDataSource::UpdateSnapshot(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainerType;
+    const uint8_t * membersStart;
+
+    writer.Init(mSnapshotBuf, mSnapshotBufSize);
+
+    err = mSchemaEngine->RetrieveData(kRootPropertyPathHandle, AnonymousTag, writer, this);
+    if (err == WEAVE_ERROR_BUFFER_TOO_SMALL)
+    {
+        // The trait does not fit; stop trying rather than encode it twice on every read.
+        WeaveLogError(DataManagement, "Snapshot store of %" PRIu16 " bytes too small; snapshot disabled", mSnapshotBufSize);
+        SetSnapshotStore(NULL, 0);
+    }
+    SuccessOrExit(err);
+
+    err = writer.Finalize();
+    SuccessOrExit(err);
+
+    reader.Init(mSnapshotBuf, writer.GetLengthWritten());
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    // A null root cannot be re-emitted as a container.
+    VerifyOrExit(reader.GetType() == kTLVType_Structure, err = WEAVE_ERROR_WRONG_TLV_TYPE);
+
+    err = reader.EnterContainer(outerContainerType);
+    SuccessOrExit(err);
+
+    membersStart = reader.GetReadPoint();
+
+    err = reader.ExitContainer(outerContainerType);
+    SuccessOrExit(err);
+
+    mSnapshotDataOffset = static_cast<uint16_t>(membersStart - mSnapshotBuf);
+    mSnapshotDataLen    = static_cast<uint16_t>(reader.GetReadPoint() - membersStart);
+    mSnapshotValid      = true;
+
+exit:
+    return err;
+}
+#endif // WDM_PUBLISHER_SNAPSHOT_SUPPORT
+
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+void TraitDataSource::SetVersionHistoryStore(VersionHistoryEntry * aEntries, uint16_t aNumEntries)
+{
+    mVersionHistory           = aEntries;
+    mVersionHistorySize       = (aEntries != NULL) ? aNumEntries : 0;
+    mVersionHistoryHead       = 0;
+    mNumVersionHistoryEntries = 0;
+    mPendingChangedHandle     = kNullPropertyPathHandle;
+}
+
+bool TraitDataSource::GetChangedHandleSince(uint64_t aVersion, PropertyPathHandle & aChangedHandle)
+{
+    bool found                       = false;
+    uint64_t curVersion              = GetVersion();
+    PropertyPathHandle changedHandle = kNullPropertyPathHandle;
+    uint16_t newest                  = (mVersionHistoryHead + mVersionHistorySize - 1) % mVersionHistorySize;
+
+    VerifyOrExit(mNumVersionHistoryEntries > 0 && aVersion < curVersion, );
+
+    // The entries are for consecutive versions; they're only usable if they end at the current one.
+    VerifyOrExit(mVersionHistory[newest].mVersion == curVersion, );
+    VerifyOrExit(curVersion - aVersion <= mNumVersionHistoryEntries, );
+
+    for (uint16_t i = 0; i < curVersion - aVersion; i++)
+    {
+        const VersionHistoryEntry & entry = mVersionHistory[(newest + mVersionHistorySize - i) % mVersionHistorySize];
+
+        if (changedHandle == kNullPropertyPathHandle)
+        {
+            changedHandle = entry.mChangedHandle;
+        }
+        else
+        {
+            changedHandle = mSchemaEngine->FindLowestCommonAncestor(changedHandle, entry.mChangedHandle, NULL, NULL);
+        }
+    }
+
+    VerifyOrExit(changedHandle != kNullPropertyPathHandle, );
+
+    aChangedHandle = changedHandle;
+    found          = true;
+
+exit:
+    return found;
+}
+
+void TraitDataSource::RecordChange(PropertyPathHandle aChangedHandle)
+{
+    if (mVersionHistorySize == 0)
+    {
+        return;
+    }
+
+    if (mPendingChangedHandle == kNullPropertyPathHandle)
+    {
+        mPendingChangedHandle = aChangedHandle;
+    }
+    else
+    {
+        mPendingChangedHandle = mSchemaEngine->FindLowestCommonAncestor(mPendingChangedHandle, aChangedHandle, NULL, NULL);
+    }
+}
+
+void TraitDataSource::CommitVersionHistory(bool aVersionIncremented)
+{
+    if (mVersionHistorySize == 0 || !mSetDirtyCalled)
+    {
+        return;
+    }
+
+    if (aVersionIncremented && mPendingChangedHandle != kNullPropertyPathHandle)
+    {
+        uint64_t version = GetVersion();
+        uint16_t newest  = (mVersionHistoryHead + mVersionHistorySize - 1) % mVersionHistorySize;
+
+        // A gap in the versions (e.g. the app called SetVersion) invalidates what was recorded before it.
+        if (mNumVersionHistoryEntries > 0 && mVersionHistory[newest].mVersion + 1 != version)
+        {
+            mNumVersionHistoryEntries = 0;
+        }
+
+        mVersionHistory[mVersionHistoryHead].mVersion       = version;
+        mVersionHistory[mVersionHistoryHead].mChangedHandle = mPendingChangedHandle;
+        mVersionHistoryHead                                 = (mVersionHistoryHead + 1) % mVersionHistorySize;
+
+        if (mNumVersionHistoryEntries < mVersionHistorySize)
+        {
+            mNumVersionHistoryEntries++;
+        }
+    }
+    else
+    {
+        // The data changed without a version we know about; nothing recorded so far can be relied on.
+        mNumVersionHistoryEntries = 0;
+    }
+
+    mPendingChangedHandle = kNullPropertyPathHandle;
+}
+#endif // WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+
 #if WEAVE_CONFIG_ENABLE_WDM_UPDATE
 TraitUpdatableDataSink::TraitUpdatableDataSink(const TraitSchemaEngine * aEngine) :
     TraitDataSink(aEngine), mUpdateRequiredVersion(0), mUpdateStartVersion(0), mConditionalUpdate(false), mPotentialDataLoss(false),
@@ -178,6 +178,51 @@ public:
         uint8_t mContextTag;
     };
 
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+    /**
+     *  @brief
+     *    Lookup tables derived from the schema handle table, built by the schema engine on first use.
+     *    The storage is provided by the schema (see TRAIT_SCHEMA_INDEX_DEFINE); the arrays are indexed by
+     *    PropertySchemaHandle.
+     */
+    struct SchemaIndex
+    {
+        bool mIsBuilt;                    ///< True once the arrays below have been filled in.
+        uint16_t * mFirstChild;           ///< The children of handle h are mChildren[mFirstChild[h]] to
+                                          ///< mChildren[mFirstChild[h + 1] - 1].
+        PropertySchemaHandle * mChildren; ///< All schema handles but the root, grouped by parent and sorted by context tag.
+        uint8_t * mDepth;                 ///< The depth of each schema handle in the schema tree.
+    };
+
+#endif
+    /**
+     * Flags stored per schema handle in PackedSchema::mFlags.
+     */
+    enum PackedPropertyFlags
+    {
+        kPackedPropertyFlag_IsDictionary = 0x1,
+        kPackedPropertyFlag_IsOptional   = 0x2,
+        kPackedPropertyFlag_IsNullable   = 0x4,
+        kPackedPropertyFlag_IsEphemeral  = 0x8,
+    };
+
+#if (TDM_PACKED_SCHEMA_SUPPORT)
+    /**
+     *  @brief
+     *    A compact form of the schema handle table and the per-handle bitfields for traits with fewer than 256 schema
+     *    handles. Each array holds one entry per schema handle, indexed by (schema handle - kHandleTableOffset), so a lookup
+     *    touches one small array instead of a table of padded PropertyInfo structs plus up to four bitfields. As the arrays
+     *    are independent, code-gen may point several traits at the same parent or tag array when their contents match.
+     */
+    struct PackedSchema
+    {
+        const uint8_t * mParentHandles; ///< The parent schema handle of each schema handle.
+        const uint8_t * mContextTags;   ///< The context tag of each schema handle.
+        const uint8_t * mFlags;         ///< kPackedPropertyFlag_* bits, two schema handles per byte (low nibble first); may be
+                                        ///< NULL if no handle has any flag set (see TRAIT_SCHEMA_PACKED_FLAGS).
+    };
+
+#endif
     /**
      *  @brief
      *    The main schema structure that houses the schema information.
@@ -202,6 +247,13 @@ public:
 #endif
 #if (TDM_VERSIONING_SUPPORT)
         const ConstSchemaVersionRange * mVersionRange; ///< Range of versions supported by this trait
+#endif
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+        SchemaIndex * mIndex; ///< Optional lookup tables; if NULL, lookups scan mSchemaHandleTbl.
+#endif
+#if (TDM_PACKED_SCHEMA_SUPPORT)
+        const PackedSchema * mPackedSchema; ///< Optional compact tables; if set, they are used instead of mSchemaHandleTbl
+                                            ///< and the dictionary, optional, nullable and ephemeral bitfields.
 #endif
     };
 
@@ -424,6 +476,7 @@ public:
 
     /**
      * Returns a pointer to the PropertyInfo structure describing a particular path handle.
+     * Schemas that only provide packed tables (see PackedSchema) have no such structure, and NULL is returned.
      *
      * @retval PropertyInfo*
      */
@@ -551,7 +604,14 @@ public:
 
 private:
     PropertyPathHandle _GetChildHandle(PropertyPathHandle aParentHandle, uint8_t aContextTag) const;
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+    const SchemaIndex * GetIndex(void) const;
+    void BuildIndex(SchemaIndex & aIndex) const;
+#endif
     bool GetBitFromPathHandleBitfield(uint8_t * aBitfield, PropertyPathHandle aPathHandle) const;
+    bool GetPropertyFlag(uint8_t * aBitfield, uint8_t aPackedFlag, PropertyPathHandle aPathHandle) const;
+    PropertySchemaHandle GetParentSchemaHandle(PropertySchemaHandle aHandle) const;
+    uint8_t GetContextTag(PropertySchemaHandle aHandle) const;
 
     /*
      * the path MUST begin with a leading `/` and MUST NOT contain a trailing slash
@@ -565,6 +625,28 @@ public:
     const Schema mSchema;
 };
 
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+/**
+ * Defines the storage for the lookup tables of a schema with aNumSchemaHandleEntries
+ * entries in its schema handle table, and a TraitSchemaEngine::SchemaIndex called aName
+ * pointing to it. Pass &aName as the mIndex field of the schema.
+ */
+#define TRAIT_SCHEMA_INDEX_DEFINE(aName, aNumSchemaHandleEntries)                                                                  \
+    static uint16_t aName##FirstChild[(aNumSchemaHandleEntries) + ::nl::Weave::Profiles::DataManagement::TraitSchemaEngine::kHandleTableOffset + 1]; \
+    static ::nl::Weave::Profiles::DataManagement::PropertySchemaHandle aName##Children[(aNumSchemaHandleEntries) + 1];                        \
+    static uint8_t aName##Depth[(aNumSchemaHandleEntries) + ::nl::Weave::Profiles::DataManagement::TraitSchemaEngine::kHandleTableOffset];    \
+    static ::nl::Weave::Profiles::DataManagement::TraitSchemaEngine::SchemaIndex aName = { false, aName##FirstChild, aName##Children,       \
+                                                                                           aName##Depth }
+#endif // TDM_SCHEMA_INDEX_SUPPORT
+
+#if (TDM_PACKED_SCHEMA_SUPPORT)
+/**
+ * Packs the kPackedPropertyFlag_* bits of two consecutive schema handles into one byte of a
+ * TraitSchemaEngine::PackedSchema flags array.
+ */
+#define TRAIT_SCHEMA_PACKED_FLAGS(aFlagsOfFirst, aFlagsOfSecond) static_cast<uint8_t>((aFlagsOfFirst) | ((aFlagsOfSecond) << 4))
+#endif // TDM_PACKED_SCHEMA_SUPPORT
+
 /*
  * @class  TraitDataSink
  *
@@ -736,6 +818,39 @@ public:
     /* Subclass can invoke this to clear out their version */
     void ClearVersion(void);
 
+#if TDM_SINK_CHANGE_SET_SUPPORT
+    /**
+     * A data element received for this sink in change set mode.
+     */
+    struct ChangeSetEntry
+    {
+        PropertyPathHandle mHandle; ///< Handle the data element's path maps to (null if the path is not in the schema)
+        uint8_t mFlags;             ///< ChangeFlags of the data element
+        TLV::TLVReader mReader;     ///< Reader on the data element; only valid until OnChangeSet returns
+    };
+
+    /**
+     * Switch this sink to change set mode, with room for aNumEntries data elements per change set, or back to the
+     * per-leaf mode if aEntries is NULL.
+     *
+     * In change set mode, StoreDataElement does not call SetLeafData or signal any event. The data elements are
+     * instead handed over all at once through OnChangeSet, after the whole DataList of the notify (or view response)
+     * has been processed, or earlier if there are more than aNumEntries of them. The sink's version is updated as
+     * the data elements are received, and cleared if OnChangeSet fails.
+     *
+     * Updatable sinks can't use this mode, since the data they're updating has to be filtered out of notifies.
+     *
+     * @retval #WEAVE_ERROR_INCORRECT_STATE if this is an updatable sink.
+     */
+    WEAVE_ERROR SetChangeSetStore(ChangeSetEntry * aEntries, uint16_t aNumEntries);
+
+    /**
+     * Call OnChangeSet on every sink with data elements waiting in its change set. Invoked by the WDM client code at
+     * the end of each DataList.
+     */
+    static void DeliverPendingChangeSets(void);
+#endif // TDM_SINK_CHANGE_SET_SUPPORT
+
 protected: // ISetDataDelegate
     virtual WEAVE_ERROR SetLeafData(PropertyPathHandle aLeafHandle, nl::Weave::TLV::TLVReader & aReader) __OVERRIDE = 0;
 
@@ -752,6 +867,17 @@ protected: // ISetDataDelegate
     /* Subclass can invoke this if they desire to reject a particular data change */
     void RejectChange(uint16_t aRejectionStatusCode);
 
+#if TDM_SINK_CHANGE_SET_SUPPORT
+    /*
+     * Invoked in change set mode with the data elements received since the last call, in the order they were received.
+     * Sub-classes can decode the entries themselves, or pass them to ApplyChangeSetEntry to get the usual SetLeafData
+     * calls and dictionary events.
+     */
+    virtual WEAVE_ERROR OnChangeSet(const ChangeSetEntry * aEntries, uint16_t aNumEntries) { return WEAVE_NO_ERROR; }
+
+    WEAVE_ERROR ApplyChangeSetEntry(const ChangeSetEntry & aEntry);
+#endif
+
 #if WDM_ENABLE_SUBSCRIPTIONLESS_NOTIFICATION
     /**
      * Returns a boolean value that indicates if this sink accepts
@@ -771,6 +897,22 @@ protected: // ISetDataDelegate
     const TraitSchemaEngine * mSchemaEngine;
 
 private:
+    WEAVE_ERROR ApplyDataElement(PropertyPathHandle aHandle, DataElement::Parser & aParser, TLV::TLVReader & aReader,
+                                 bool aDataPresent, bool aDeletePresent, IPathFilter * apPathFilter);
+
+#if TDM_SINK_CHANGE_SET_SUPPORT
+    void AddChangeSetEntry(PropertyPathHandle aHandle, const TLV::TLVReader & aReader, uint8_t aFlags);
+    void DeliverChangeSet(void);
+
+    ChangeSetEntry * mChangeSet;
+    uint16_t mChangeSetSize;
+    uint16_t mNumChangeSetEntries;
+    bool mChangeSetPending;
+    TraitDataSink * mNextPendingChangeSet;
+    static TraitDataSink * sPendingChangeSetsHead;
+    static TraitDataSink * sPendingChangeSetsTail;
+#endif
+
     // Current version of the data in this sink.
     uint64_t mVersion;
     uint64_t mLastNotifyVersion;
@@ -901,6 +1043,50 @@ public:
     void DeleteKey(PropertyPathHandle aPropertyHandle);
 #endif
 
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    /**
+     * One version of the data source, along with the handle of the lowest node in the schema under which all the
+     * changes made in that version happened.
+     */
+    struct VersionHistoryEntry
+    {
+        uint64_t mVersion;
+        PropertyPathHandle mChangedHandle;
+    };
+
+    /**
+     * Provide storage for the last aNumEntries versions of this source. Only sources with a managed version
+     * (the default) record their history. Passing NULL disables the history.
+     */
+    void SetVersionHistoryStore(VersionHistoryEntry * aEntries, uint16_t aNumEntries);
+
+    /**
+     * Find the lowest handle under which all the changes made after aVersion happened.
+     *
+     * @retval true     if all the versions after aVersion are in the history; aChangedHandle is then set.
+     * @retval false    otherwise.
+     */
+    bool GetChangedHandleSince(uint64_t aVersion, PropertyPathHandle & aChangedHandle);
+#endif // WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+    /**
+     * Provide storage for a pre-encoded copy of the whole trait instance. The snapshot is built on the first
+     * read of the root after it was invalidated, and is used by every later read of the root, which then
+     * costs a copy of the encoded members rather than a walk of the schema.
+     *
+     * Only sources that call SetDirty (or InvalidateSnapshot) for every change to their data may use a
+     * snapshot. Passing NULL disables the snapshot. A snapshot that does not fit in the supplied storage
+     * is disabled as well.
+     */
+    void SetSnapshotStore(uint8_t * aBuf, uint16_t aBufSize);
+
+    /**
+     * Discard the snapshot, e.g. after a change to data the source reads from elsewhere.
+     */
+    void InvalidateSnapshot(void) { mSnapshotValid = false; }
+#endif // WDM_PUBLISHER_SNAPSHOT_SUPPORT
+
     // This API has been deprecated.
     virtual void OnCustomCommand(Command * aCommand, const nl::Weave::WeaveMessageInfo * aMsgInfo,
                                  nl::Weave::PacketBuffer * aPayload, const uint64_t & aCommandType, const bool aIsExpiryTimeValid,
@@ -965,10 +1151,37 @@ protected: // IGetDataDelegate
     const TraitSchemaEngine * mSchemaEngine;
 
 private:
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    void RecordChange(PropertyPathHandle aChangedHandle);
+    void CommitVersionHistory(bool aVersionIncremented);
+#endif
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+    WEAVE_ERROR UpdateSnapshot(void);
+#endif
+
     // Current version of the data in this source.
     uint64_t mVersion;
     // Tracks whether SetDirty was called within a Lock/Unlock 'session'
     bool mSetDirtyCalled;
+
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    VersionHistoryEntry * mVersionHistory;
+    uint16_t mVersionHistorySize;
+    uint16_t mVersionHistoryHead;
+    uint16_t mNumVersionHistoryEntries;
+    // Lowest common ancestor of the handles changed within the current Lock/Unlock 'session'
+    PropertyPathHandle mPendingChangedHandle;
+#endif
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+    uint8_t * mSnapshotBuf;
+    uint16_t mSnapshotBufSize;
+    // Location of the members of the encoded root structure within mSnapshotBuf
+    uint16_t mSnapshotDataOffset;
+    uint16_t mSnapshotDataLen;
+    bool mSnapshotValid;
+#endif
 };
 
 #if WDM_ENABLE_PUBLISHER_UPDATE_SERVER_SUPPORT
@@ -47,6 +47,7 @@ using namespace ::nl::Weave::Profiles::DataManagement_Current;
 TraitPathStore::TraitPathStore()
     : mStore(NULL), mStoreSize(0), mNumItems(0)
 {
+    memset(mTraitIndex, 0, sizeof(mTraitIndex));
 }
 
 /**
@@ -142,7 +143,8 @@ WEAVE_ERROR TraitPathStore::AddItemDedup(const TraitPath &aItem, const TraitSche
             i < GetPathStoreSize();
             i = GetNextValidItem(i, aItem.mTraitDataHandle))
     {
-        if (aSchemaEngine->IsParent(mStore[i].mTraitPath.mPropertyPathHandle, aItem.mPropertyPathHandle))
+        if ((GetAncestorMask(i, aSchemaEngine) & GetHandleBit(aItem.mPropertyPathHandle)) &&
+                aSchemaEngine->IsParent(mStore[i].mTraitPath.mPropertyPathHandle, aItem.mPropertyPathHandle))
         {
             WeaveLogDetail(DataManagement, "Removing item %u t%u p%u while adding p%u", i,
                     mStore[i].mTraitPath.mTraitDataHandle,
@@ -312,6 +314,38 @@ void TraitPathStore::Compact()
     }
 }
 
+/**
+ * Moves an item to a different index, shifting the items in between
+ * by one position to make room for it; the relative order of all
+ * other items is preserved.
+ * Like InsertItemAt, this is meant for stores used as lists, and
+ * assumes the store has no gaps.
+ *
+ * @param[in] aFromIndex    The index of the item to move.
+ * @param[in] aToIndex      The index the item should end up at.
+ */
+void TraitPathStore::MoveItem(size_t aFromIndex, size_t aToIndex)
+{
+    Record record;
+
+    VerifyOrDie(aFromIndex < mNumItems && aToIndex < mNumItems);
+
+    record = mStore[aFromIndex];
+
+    if (aFromIndex > aToIndex)
+    {
+        memmove(&mStore[aToIndex+1], &mStore[aToIndex],
+                (aFromIndex - aToIndex) * sizeof(mStore[0]));
+    }
+    else if (aFromIndex < aToIndex)
+    {
+        memmove(&mStore[aFromIndex], &mStore[aFromIndex+1],
+                (aToIndex - aFromIndex) * sizeof(mStore[0]));
+    }
+
+    mStore[aToIndex] = record;
+}
+
 /**
  * Checks if a given TraitPath is already in the store.
  *
@@ -321,7 +355,9 @@ void TraitPathStore::Compact()
  */
 bool TraitPathStore::IsPresent(const TraitPath &aItem) const
 {
-    for (size_t i = GetFirstValidItem(); i < mStoreSize; i = GetNextValidItem(i))
+    for (size_t i = GetFirstValidItem(aItem.mTraitDataHandle);
+            i < mStoreSize;
+            i = GetNextValidItem(i, aItem.mTraitDataHandle))
     {
         if (mStore[i].mTraitPath == aItem)
         {
@@ -349,18 +385,28 @@ bool TraitPathStore::Intersects(const TraitPath &aTraitPath, const TraitSchemaEn
     bool intersects = false;
     TraitDataHandle dataHandle = aTraitPath.mTraitDataHandle;
     PropertyPathHandle pathHandle = aTraitPath.mPropertyPathHandle;
+    uint32_t ancestorMask;
+
+    VerifyOrExit(MayContainTrait(dataHandle), /* no-op */);
+
+    ancestorMask = ComputeAncestorMask(pathHandle, aSchemaEngine);
 
     for (size_t i = GetFirstValidItem(dataHandle); i < mStoreSize; i = GetNextValidItem(i, dataHandle))
     {
-        if (pathHandle == mStore[i].mTraitPath.mPropertyPathHandle ||
-                aSchemaEngine->IsParent(pathHandle, mStore[i].mTraitPath.mPropertyPathHandle) ||
-                aSchemaEngine->IsParent(mStore[i].mTraitPath.mPropertyPathHandle, pathHandle))
+        PropertyPathHandle storedHandle = mStore[i].mTraitPath.mPropertyPathHandle;
+
+        // The ancestor masks rule out most unrelated paths without walking the schema.
+        if (pathHandle == storedHandle ||
+                ((ancestorMask & GetHandleBit(storedHandle)) && aSchemaEngine->IsParent(pathHandle, storedHandle)) ||
+                ((GetAncestorMask(i, aSchemaEngine) & GetHandleBit(pathHandle)) &&
+                 aSchemaEngine->IsParent(storedHandle, pathHandle)))
         {
             intersects = true;
             break;
         }
     }
 
+exit:
     return intersects;
 }
 
@@ -381,17 +427,25 @@ bool TraitPathStore::Includes(const TraitPath &aItem, const TraitSchemaEngine *
     bool found = false;
     TraitDataHandle dataHandle = aItem.mTraitDataHandle;
     PropertyPathHandle pathHandle = aItem.mPropertyPathHandle;
+    uint32_t ancestorMask;
+
+    VerifyOrExit(MayContainTrait(dataHandle), /* no-op */);
+
+    ancestorMask = ComputeAncestorMask(pathHandle, aSchemaEngine);
 
     for (size_t i = GetFirstValidItem(dataHandle); i < mStoreSize; i = GetNextValidItem(i, dataHandle))
     {
-        if (pathHandle == mStore[i].mTraitPath.mPropertyPathHandle ||
-                aSchemaEngine->IsParent(pathHandle, mStore[i].mTraitPath.mPropertyPathHandle))
+        PropertyPathHandle storedHandle = mStore[i].mTraitPath.mPropertyPathHandle;
+
+        if (pathHandle == storedHandle ||
+                ((ancestorMask & GetHandleBit(storedHandle)) && aSchemaEngine->IsParent(pathHandle, storedHandle)))
         {
             found = true;
             break;
         }
     }
 
+exit:
     return found;
 }
 
@@ -406,6 +460,8 @@ void TraitPathStore::Clear()
     {
         ClearItem(i);
     }
+
+    memset(mTraitIndex, 0, sizeof(mTraitIndex));
 }
 
 /**
@@ -456,7 +512,13 @@ size_t TraitPathStore::GetNextValidItem(size_t aIndex) const
  */
 size_t TraitPathStore::GetFirstValidItem(TraitDataHandle aTDH) const
 {
-    size_t i = GetFirstValidItem();
+    size_t i = mStoreSize;
+
+    // The trait index tells us without a scan when no item refers to the trait instance.
+    if (MayContainTrait(aTDH))
+    {
+        i = GetFirstValidItem();
+    }
 
     while (i < mStoreSize && mStore[i].mTraitPath.mTraitDataHandle != aTDH)
     {
@@ -513,11 +575,20 @@ void TraitPathStore::SetItem(size_t aIndex, const TraitPath &aItem, Flags aFlags
 {
     mStore[aIndex].mTraitPath = aItem;
     mStore[aIndex].mFlags = aFlags;
+    mStore[aIndex].mAncestorMask = 0;
     SetFlags(aIndex, kFlag_InUse, true);
+
+    mTraitIndex[GetTraitIndexBucket(aItem.mTraitDataHandle)]++;
 }
 
 void TraitPathStore::ClearItem(size_t aIndex)
 {
+    if (IsItemInUse(aIndex))
+    {
+        mTraitIndex[GetTraitIndexBucket(mStore[aIndex].mTraitPath.mTraitDataHandle)]--;
+    }
+
+    mStore[aIndex].mAncestorMask                  = 0;
     mStore[aIndex].mFlags                         = 0x0;
     mStore[aIndex].mTraitPath.mPropertyPathHandle = kNullPropertyPathHandle;
     mStore[aIndex].mTraitPath.mTraitDataHandle    = UINT16_MAX;
@@ -531,3 +602,37 @@ void TraitPathStore::SetFlags(size_t aIndex, Flags aFlags, bool aValue)
         mStore[aIndex].mFlags |= aFlags;
     }
 }
+
+/**
+ * Computes a mask with one bit set for the schema handle of each of the given
+ * path and its ancestors, up to the root. The bit for a schema handle is the handle
+ * modulo 32, so a set bit only means that a path with that schema handle may be an
+ * ancestor; a clear bit means it definitely is not.
+ */
+uint32_t TraitPathStore::ComputeAncestorMask(PropertyPathHandle aHandle, const TraitSchemaEngine * const aSchemaEngine)
+{
+    uint32_t mask = 0;
+
+    while (aHandle != kNullPropertyPathHandle)
+    {
+        mask |= GetHandleBit(aHandle);
+        aHandle = aSchemaEngine->GetParent(aHandle);
+    }
+
+    return mask;
+}
+
+/**
+ * Returns the ancestor mask of the item at the given index, computing and caching
+ * it the first time. All the paths of a trait instance share the same schema, so
+ * the cached mask stays valid for as long as the item is in the store.
+ */
+uint32_t TraitPathStore::GetAncestorMask(size_t aIndex, const TraitSchemaEngine * const aSchemaEngine) const
+{
+    if (mStore[aIndex].mAncestorMask == 0)
+    {
+        mStore[aIndex].mAncestorMask = ComputeAncestorMask(mStore[aIndex].mTraitPath.mPropertyPathHandle, aSchemaEngine);
+    }
+
+    return mStore[aIndex].mAncestorMask;
+}
@@ -52,6 +52,8 @@ struct TraitPathStore
         struct Record {
             Flags mFlags;
             TraitPath mTraitPath;
+            uint32_t mAncestorMask; /**< Private to the store: a cache of the item's ancestor mask, or 0 if not computed yet.
+                                      */
         };
 
         TraitPathStore();
@@ -85,6 +87,7 @@ struct TraitPathStore
         void RemoveItemAt(size_t aIndex);
 
         void Compact();
+        void MoveItem(size_t aFromIndex, size_t aToIndex);
 
         void Clear();
 
@@ -101,14 +104,26 @@ struct TraitPathStore
         Record *mStore;
 
    private:
+        enum {
+            kTraitIndexSize = 16,
+        };
+
         size_t FindFirstAvailableItem() const;
         void SetItem(size_t aIndex, const TraitPath &aItem, Flags aFlags);
         void ClearItem(size_t aIndex);
         void SetFlags(size_t aIndex, Flags aFlags, bool aValue);
         bool AreFlagsSet_private(size_t aIndex, Flags aFlags) const { return ((mStore[aIndex].mFlags & aFlags) == aFlags); }
 
+        static size_t GetTraitIndexBucket(TraitDataHandle aDataHandle) { return aDataHandle % kTraitIndexSize; }
+        bool MayContainTrait(TraitDataHandle aDataHandle) const { return mTraitIndex[GetTraitIndexBucket(aDataHandle)] != 0; }
+
+        static uint32_t GetHandleBit(PropertyPathHandle aHandle) { return 1UL << (GetPropertySchemaHandle(aHandle) % 32); }
+        static uint32_t ComputeAncestorMask(PropertyPathHandle aHandle, const TraitSchemaEngine * const aSchemaEngine);
+        uint32_t GetAncestorMask(size_t aIndex, const TraitSchemaEngine * const aSchemaEngine) const;
+
         size_t mStoreSize;
         size_t mNumItems;
+        uint16_t mTraitIndex[kTraitIndexSize]; /**< Number of items in use whose TraitDataHandle falls in each bucket. */
 };
 
 }; // namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
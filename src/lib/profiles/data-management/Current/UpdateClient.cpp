@@ -355,10 +355,12 @@ void UpdateClient::OnMessageReceived(nl::Weave::ExchangeContext * aEC, const nl:
     else if ((nl::Weave::Profiles::kWeaveProfile_WDM == aProfileId) && (kMsgType_UpdateContinue == aMsgType))
     {
         pUpdateClient->MoveToState(kState_Initialized);
+        inParam.Source = pUpdateClient;
         CallbackFunc(pAppState, kEvent_UpdateContinue, inParam, outParam);
     }
     else
     {
+        inParam.Source = pUpdateClient;
         inParam.UpdateComplete.Reason = WEAVE_ERROR_INVALID_MESSAGE_TYPE;
         CallbackFunc(pAppState, kEvent_UpdateComplete, inParam, outParam);
     }
@@ -204,6 +204,7 @@ WEAVE_ERROR UpdateEncoder::EncodeDataElements()
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     bool dictionaryOverflowed = false;
+    uint32_t packingAttemptsLeft = WDM_UPDATE_MAX_PACKING_ATTEMPTS;
     TraitPathStore &traitPathList = *(mContext->mInProgressUpdateList);
 
     WeaveLogDetail(DataManagement, "Num items in progress = %u/%u; current: %u",
@@ -230,6 +231,12 @@ WEAVE_ERROR UpdateEncoder::EncodeDataElements()
         }
 
         err = EncodeDataElement();
+
+        if (err == WEAVE_ERROR_BUFFER_TOO_SMALL && mContext->mNumDataElementsAddedToPayload > 0)
+        {
+            RemoveInProgressPrivateItemsAfter(traitPathList, i);
+            err = EncodeNextFittingDataElement(packingAttemptsLeft);
+        }
         SuccessOrExit(err);
 
         dictionaryOverflowed = (mContext->mNextDictionaryElementPathHandle != kNullPropertyPathHandle);
@@ -259,6 +266,52 @@ exit:
 
 }
 
+/**
+ * Called when the DataElement at mItemInProgress does not fit in what is left of the payload:
+ * tries the DataElements that follow it in the list, and encodes the first one that fits
+ * in its place. The DataElement being tried is moved to mItemInProgress, so that the items
+ * encoded in a payload are always the ones that precede mItemInProgress, in encoding order;
+ * the items skipped over keep their relative order and are encoded in a later payload.
+ *
+ * @param[inout] aAttemptsLeft  The number of trial encodings left for this payload.
+ *
+ * @retval #WEAVE_NO_ERROR if a DataElement was encoded at mItemInProgress.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL if none of the DataElements tried fits in the buffer.
+ * @retval other Other errors from EncodeDataElement.
+ */
+WEAVE_ERROR UpdateEncoder::EncodeNextFittingDataElement(uint32_t &aAttemptsLeft)
+{
+    WEAVE_ERROR err = WEAVE_ERROR_BUFFER_TOO_SMALL;
+    TraitPathStore &traitPathList = *(mContext->mInProgressUpdateList);
+    const size_t itemInProgress = mContext->mItemInProgress;
+    size_t candidate;
+
+    for (candidate = traitPathList.GetNextValidItem(itemInProgress);
+            candidate < traitPathList.GetPathStoreSize() && aAttemptsLeft > 0;
+            candidate = traitPathList.GetNextValidItem(candidate))
+    {
+        aAttemptsLeft--;
+
+        traitPathList.MoveItem(candidate, itemInProgress);
+
+        err = EncodeDataElement();
+        if (err != WEAVE_ERROR_BUFFER_TOO_SMALL)
+        {
+            break;
+        }
+
+        RemoveInProgressPrivateItemsAfter(traitPathList, itemInProgress);
+        traitPathList.MoveItem(itemInProgress, candidate);
+    }
+
+    if (err == WEAVE_NO_ERROR)
+    {
+        WeaveLogDetail(DataManagement, "Packed item %u in place of item %u", candidate, itemInProgress);
+    }
+
+    return err;
+}
+
 /**
  * Encodes a DataElement.
  * If the DataElement is a dictionary, it resumes encoding from mContext->mNextDictionaryElementPathHandle.
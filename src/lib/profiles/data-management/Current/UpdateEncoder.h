@@ -152,6 +152,7 @@ private:
     WEAVE_ERROR EncodeDataList(void);
     WEAVE_ERROR EncodeDataElements();
     WEAVE_ERROR EncodeDataElement();
+    WEAVE_ERROR EncodeNextFittingDataElement(uint32_t &aAttemptsLeft);
     static WEAVE_ERROR EncodeElementPath(const DataElementPathContext &aElementContext, TLV::TLVWriter &aWriter);
     static WEAVE_ERROR EncodeElementData(DataElementDataContext &aElementContext, TLV::TLVWriter &aWriter);
     WEAVE_ERROR EndUpdateRequest(void);
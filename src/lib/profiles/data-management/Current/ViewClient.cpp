@@ -59,6 +59,9 @@ WEAVE_ERROR ViewClient::Init(Binding * const apBinding, void * const apAppState,
     mAppState            = apAppState;
     mEventCallback       = aEventCallback;
     mPrevIsPartialChange = false;
+    mPathList            = NULL;
+    mPathListSize        = 0;
+    mNextPathIndex       = 0;
 #if WDM_ENABLE_PROTOCOL_CHECKS
     mPrevTraitDataHandle = -1;
 #endif
@@ -71,22 +74,85 @@ WEAVE_ERROR ViewClient::Init(Binding * const apBinding, void * const apAppState,
 WEAVE_ERROR ViewClient::SendRequest(TraitCatalogBase<TraitDataSink> * apCatalog, const TraitPath aPathList[],
                                     const size_t aPathListSize)
 {
-    WEAVE_ERROR err       = WEAVE_NO_ERROR;
-    PacketBuffer * MsgBuf = NULL;
-    SchemaVersionRange requestedSchemaVersionRange;
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
 
     VerifyOrExit(kMode_Initialized == mCurrentMode, err = WEAVE_ERROR_INCORRECT_STATE);
 
     mCurrentMode     = kMode_DataSink;
     mDataSinkCatalog = apCatalog;
+    mPathList        = aPathList;
+    mPathListSize    = aPathListSize;
+    mNextPathIndex   = 0;
+
+    err = SendDataSinkRequest(false);
+    SuccessOrExit(err);
+
+exit:
+    WeaveLogFunctError(err);
+
+    if (WEAVE_NO_ERROR != err)
+    {
+        Cancel();
+    }
+
+    return err;
+}
+
+// Encode one path of the data sink mode path list. Returns WEAVE_ERROR_INVALID_ARGUMENT if the sink is not in the catalog
+// anymore, in which case the writer is left in an unspecified state.
+WEAVE_ERROR ViewClient::EncodePath(nl::Weave::TLV::TLVWriter & aWriter, const TraitPath & aPath)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TraitDataSink * pDataSink;
+    nl::Weave::TLV::TLVType dummyContainerType;
+    SchemaVersionRange requestedSchemaVersionRange;
+
+    // Start the TLV Path
+    err = aWriter.StartContainer(nl::Weave::TLV::AnonymousTag, nl::Weave::TLV::kTLVType_Path, dummyContainerType);
+    SuccessOrExit(err);
+
+    // Start, fill, and close the TLV Structure that contains ResourceID, ProfileID, and InstanceID
+    err = mDataSinkCatalog->HandleToAddress(aPath.mTraitDataHandle, aWriter, requestedSchemaVersionRange);
+    SuccessOrExit(err);
+
+    // Ideally, this will not fail as HandleToAddress() has found the entry in the catalog. However, keeping this check
+    // here for consistency and code safety
+    VerifyOrExit(mDataSinkCatalog->Locate(aPath.mTraitDataHandle, &pDataSink) == WEAVE_NO_ERROR,
+                 err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // Append zero or more TLV tags based on the Path Handle
+    err = pDataSink->GetSchemaEngine()->MapHandleToPath(aPath.mPropertyPathHandle, aWriter);
+    SuccessOrExit(err);
+
+    // Close the TLV Path
+    err = aWriter.EndContainer(dummyContainerType);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+// Send a ViewRequest with as many of the remaining paths in mPathList as fit, starting at mNextPathIndex. Failing to get an
+// exchange context is always reported through kEvent_RequestFailed; other failures only if aReportAllFailures is true, which
+// is the case for the requests after the first one, sent without the application calling in.
+WEAVE_ERROR ViewClient::SendDataSinkRequest(bool aReportAllFailures)
+{
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
+    WEAVE_ERROR err       = WEAVE_NO_ERROR;
+    PacketBuffer * MsgBuf = NULL;
+    size_t numPaths       = 0;
 
     MsgBuf = PacketBuffer::New();
     VerifyOrExit(NULL != MsgBuf, err = WEAVE_ERROR_NO_MEMORY);
 
     {
         nl::Weave::TLV::TLVWriter writer;
+        nl::Weave::TLV::TLVWriter checkpoint;
         nl::Weave::TLV::TLVType dummyContainerType;
-        writer.Init(MsgBuf);
+        writer.Init(MsgBuf, WDM_MAX_NOTIFICATION_SIZE);
 
         err = writer.StartContainer(nl::Weave::TLV::AnonymousTag, nl::Weave::TLV::kTLVType_Structure, dummyContainerType);
         SuccessOrExit(err);
@@ -95,43 +161,39 @@ WEAVE_ERROR ViewClient::SendRequest(TraitCatalogBase<TraitDataSink> * apCatalog,
         err = pathList.Init(&writer, ViewRequest::kCsTag_PathList);
         SuccessOrExit(err);
 
-        for (size_t i = 0; i < aPathListSize; ++i)
+        for (; mNextPathIndex < mPathListSize; ++mNextPathIndex)
         {
-            TraitDataSink * pDataSink;
-            nl::Weave::TLV::TLVType dummyContainerType2;
+#if WDM_VIEW_CLIENT_MAX_PATHS_PER_REQUEST > 0
+            if (numPaths == WDM_VIEW_CLIENT_MAX_PATHS_PER_REQUEST)
+            {
+                break;
+            }
+#endif
 
-            // Start the TLV Path
-            err = writer.StartContainer(nl::Weave::TLV::AnonymousTag, nl::Weave::TLV::kTLVType_Path, dummyContainerType2);
-            SuccessOrExit(err);
+            checkpoint = writer;
 
-            // Start, fill, and close the TLV Structure that contains ResourceID, ProfileID, and InstanceID
-            err = mDataSinkCatalog->HandleToAddress(aPathList[i].mTraitDataHandle, writer, requestedSchemaVersionRange);
+            err = EncodePath(writer, mPathList[mNextPathIndex]);
 
             if (err == WEAVE_ERROR_INVALID_ARGUMENT)
             {
                 // HandleToAddress() can return an error if the sink has been removed from the catalog. In that case,
                 // continue to next entry
-                err = WEAVE_NO_ERROR;
+                writer = checkpoint;
+                err    = WEAVE_NO_ERROR;
                 continue;
             }
 
-            SuccessOrExit(err);
-
-            if (mDataSinkCatalog->Locate(aPathList[i].mTraitDataHandle, &pDataSink) != WEAVE_NO_ERROR)
+            if ((err == WEAVE_ERROR_BUFFER_TOO_SMALL || err == WEAVE_ERROR_NO_MEMORY) && numPaths > 0)
             {
-                // Ideally, this code will not be reached as Locate() should find the entry in the catalog.
-                // Otherwise, the earlier HandleToAddress() call would have continued.
-                // However, keeping this check here for consistency and code safety
-                continue;
+                // The rest of the paths go in the next request
+                writer = checkpoint;
+                err    = WEAVE_NO_ERROR;
+                break;
             }
 
-            // Append zero or more TLV tags based on the Path Handle
-            err = pDataSink->GetSchemaEngine()->MapHandleToPath(aPathList[i].mPropertyPathHandle, writer);
             SuccessOrExit(err);
 
-            // Close the TLV Path
-            err = writer.EndContainer(dummyContainerType2);
-            SuccessOrExit(err);
+            ++numPaths;
         }
 
         err = pathList.EndOfPathList().GetError();
@@ -144,12 +206,16 @@ WEAVE_ERROR ViewClient::SendRequest(TraitCatalogBase<TraitDataSink> * apCatalog,
         SuccessOrExit(err);
     }
 
+    if (mNextPathIndex < mPathListSize)
+    {
+        WeaveLogDetail(DataManagement, "ViewClient: %u paths in request, %u left", static_cast<unsigned>(numPaths),
+                       static_cast<unsigned>(mPathListSize - mNextPathIndex));
+    }
+
     err = mBinding->NewExchangeContext(mEC);
     if (WEAVE_NO_ERROR != err)
     {
-        EventParam Param;
-        // Nothing to initialize in Param.mRequestFailureEventParam
-        mEventCallback(mAppState, kEvent_RequestFailed, err, Param);
+        aReportAllFailures = true;
         ExitNow();
     }
 
@@ -173,7 +239,17 @@ exit:
 
     if (WEAVE_NO_ERROR != err)
     {
+        void * const pAppState     = mAppState;
+        EventCallback CallbackFunc = mEventCallback;
+
         Cancel();
+
+        if (aReportAllFailures)
+        {
+            EventParam Param;
+            // Nothing to initialize in Param.mRequestFailureEventParam
+            CallbackFunc(pAppState, kEvent_RequestFailed, err, Param);
+        }
     }
 
     return err;
@@ -182,6 +258,8 @@ exit:
 // acquire EC from binding, kick off send message
 WEAVE_ERROR ViewClient::SendRequest(AppendToPathList const aAppendToPathList, HandleDataElement const aHandleDataElement)
 {
+    SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(nl::Weave::System::Stats::kPacketBufferOwner_WDM);
+
     WEAVE_ERROR err       = WEAVE_NO_ERROR;
     PacketBuffer * MsgBuf = NULL;
 
@@ -342,6 +420,7 @@ void ViewClient::OnMessageReceived(nl::Weave::ExchangeContext * aEC, const nl::I
     ViewClient * pViewClient   = reinterpret_cast<ViewClient *>(aEC->AppState);
     void * const pAppState     = pViewClient->mAppState;
     EventCallback CallbackFunc = pViewClient->mEventCallback;
+    bool requestSent           = false;
     EventParam Param;
 
     VerifyOrExit((kMode_DataSink == pViewClient->mCurrentMode) || (kMode_WithoutDataSink == pViewClient->mCurrentMode),
@@ -530,9 +609,25 @@ void ViewClient::OnMessageReceived(nl::Weave::ExchangeContext * aEC, const nl::I
             err = WEAVE_NO_ERROR;
         }
 
+#if TDM_SINK_CHANGE_SET_SUPPORT
+        TraitDataSink::DeliverPendingChangeSets();
+#endif
+
         err = reader.ExitContainer(dummyContainerType);
         SuccessOrExit(err);
 
+        if ((kMode_DataSink == pViewClient->mCurrentMode) && (pViewClient->mNextPathIndex < pViewClient->mPathListSize))
+        {
+            // This response is complete; request the paths that didn't fit in the previous request
+            pViewClient->mEC->Close();
+            pViewClient->mEC = NULL;
+            aEC              = NULL;
+
+            // Failures are reported to the application by SendDataSinkRequest
+            requestSent = (WEAVE_NO_ERROR == pViewClient->SendDataSinkRequest(true));
+            ExitNow();
+        }
+
         pViewClient->Cancel();
 
         Param.mViewResponseConsumedEventParam.mMessage = aPayload;
@@ -551,7 +646,10 @@ exit:
 
     // aEC should be the same as pViewClient->mEC and be closed in InternalCancel
     // If they are not the same, we're in big trouble
-    pViewClient->Cancel();
+    if (!requestSent)
+    {
+        pViewClient->Cancel();
+    }
     aEC = NULL;
 
     if (NULL != aPayload)
@@ -57,10 +57,12 @@ public:
         kEvent_AboutToSendRequest = 2,
 
         // Response just arrived, mEC is valid
+        // When the path list has been split over several requests, this is delivered for every response
         kEvent_ViewResponseReceived = 3,
 
         // Cancel is already called when this callback happens
         // Response processing has been completed, InternalCancel will be called upon return
+        // When the path list has been split over several requests, this is only delivered for the last response
         kEvent_ViewResponseConsumed = 4,
 
         // Cancel is already called when this callback happens
@@ -124,6 +126,9 @@ public:
     // acquire EC from binding, kick off send message
     WEAVE_ERROR SendRequest(AppendToPathList const aAppendToPathList, HandleDataElement const aHandleDataElement);
 
+    // The paths can span several resources in the catalog. They are sent in as few requests as possible (see
+    // WDM_VIEW_CLIENT_MAX_PATHS_PER_REQUEST), one after the other, and each data element received is stored in its sink
+    // as the response is parsed. aPathList must remain valid until kEvent_ViewResponseConsumed or kEvent_RequestFailed.
     WEAVE_ERROR SendRequest(TraitCatalogBase<TraitDataSink> * apCatalog, const TraitPath aPathList[], const size_t aPathListSize);
 
     // InternalCancel(false)
@@ -149,6 +154,11 @@ protected:
     // We need to keep this for canceling before we receive a response
     nl::Weave::ExchangeContext * mEC;
 
+    // Paths requested in data sink mode, and the first one that hasn't been sent yet
+    const TraitPath * mPathList;
+    size_t mPathListSize;
+    size_t mNextPathIndex;
+
     union
     {
         // Only needed if we want to use this View Client without data sinks
@@ -160,6 +170,9 @@ protected:
 
     static void DataSinkOperation_NoMoreData(void * const apOpState, TraitDataSink * const apDataSink);
 
+    WEAVE_ERROR SendDataSinkRequest(bool aReportAllFailures);
+    WEAVE_ERROR EncodePath(nl::Weave::TLV::TLVWriter & aWriter, const TraitPath & aPath);
+
     static void OnSendError(ExchangeContext * aEC, WEAVE_ERROR aErrorCode, void * aMsgSpecificContext);
     static void OnResponseTimeout(nl::Weave::ExchangeContext * aEC);
     static void OnMessageReceived(nl::Weave::ExchangeContext * aEC, const nl::Inet::IPPacketInfo * aPktInfo,
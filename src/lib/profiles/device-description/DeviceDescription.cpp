@@ -1089,6 +1089,12 @@ exit:
     return err;
 }
 
+IdentifyResponseMessage::IdentifyResponseMessage()
+{
+    EncodedDeviceDesc = NULL;
+    EncodedDeviceDescLen = 0;
+}
+
 /**
  * Encodes this IdentifyResponseMessage object into the provided message buffer.
  *
@@ -1104,6 +1110,16 @@ WEAVE_ERROR IdentifyResponseMessage::Encode(PacketBuffer *msgBuf)
     WEAVE_ERROR err;
     uint32_t msgLen;
 
+    if (EncodedDeviceDesc != NULL)
+    {
+        if (EncodedDeviceDescLen > msgBuf->AvailableDataLength())
+            return WEAVE_ERROR_BUFFER_TOO_SMALL;
+
+        memcpy(msgBuf->Start(), EncodedDeviceDesc, EncodedDeviceDescLen);
+        msgBuf->SetDataLength(EncodedDeviceDescLen);
+        return WEAVE_NO_ERROR;
+    }
+
     err = WeaveDeviceDescriptor::EncodeTLV(DeviceDesc, msgBuf->Start(), msgBuf->AvailableDataLength(), msgLen);
     if (err == WEAVE_NO_ERROR)
         msgBuf->SetDataLength(msgLen);
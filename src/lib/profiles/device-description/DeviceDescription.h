@@ -259,12 +259,48 @@ public:
      */
     HandleIdentifyRequestFunct OnIdentifyRequestReceived;
 
+    uint32_t GetMaxResponseJitter(void) const;
+    void SetMaxResponseJitter(uint32_t jitterMS);
+
 private:
+    // A response to a multicast IdentifyRequest, waiting out its random delay.
+    struct PendingResponse
+    {
+        DeviceDescriptionServer *Server;
+        ExchangeContext *EC;
+        PacketBuffer *Payload;
+    };
+
+    uint32_t mMaxResponseJitter;
+#if WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES > 0
+    PendingResponse mPendingResponses[WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES];
+#endif
+
     static void HandleRequest(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer *payload);
+    static void HandleResponseTimer(System::Layer *systemLayer, void *appState, System::Error err);
 
     DeviceDescriptionServer(const DeviceDescriptionServer&);   // not defined
 };
 
+/**
+ * Get the upper bound of the random delay, in milliseconds, applied to responses to multicast IdentifyRequests.
+ */
+inline uint32_t DeviceDescriptionServer::GetMaxResponseJitter(void) const
+{
+    return mMaxResponseJitter;
+}
+
+/**
+ * Set the upper bound of the random delay, in milliseconds, applied to responses to multicast IdentifyRequests.
+ *
+ * Spreading out the responses of the many devices that match a multicast IdentifyRequest keeps them from colliding on
+ * the network.  Zero sends responses immediately.  Responses to unicast requests are never delayed.
+ */
+inline void DeviceDescriptionServer::SetMaxResponseJitter(uint32_t jitterMS)
+{
+    mMaxResponseJitter = jitterMS;
+}
+
 
 /**
  * Special target fabric IDs.
@@ -359,11 +395,20 @@ public:
 class NL_DLL_EXPORT IdentifyResponseMessage
 {
 public:
+    IdentifyResponseMessage(void);
+
     /**
      * A device descriptor describing the responding device.
      */
     WeaveDeviceDescriptor DeviceDesc;
 
+    /**
+     * Optionally, the device descriptor already encoded in TLV form, which Encode() then sends in place of DeviceDesc.
+     * The data must remain valid until Encode() returns.  Never set by Decode().
+     */
+    const uint8_t *EncodedDeviceDesc;
+    uint16_t EncodedDeviceDescLen;              /**< Length of #EncodedDeviceDesc. */
+
     WEAVE_ERROR Encode(PacketBuffer *msgBuf);
     static WEAVE_ERROR Decode(PacketBuffer *msgBuf, IdentifyResponseMessage& msg);
 };
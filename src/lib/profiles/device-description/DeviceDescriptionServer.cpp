@@ -30,6 +30,7 @@
 #include <Weave/Core/WeaveEncoding.h>
 #include <Weave/Profiles/device-description/DeviceDescription.h>
 #include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/RandUtils.h>
 
 namespace nl {
 namespace Weave {
@@ -41,6 +42,10 @@ DeviceDescriptionServer::DeviceDescriptionServer()
     FabricState = NULL;
     ExchangeMgr = NULL;
     AppState = NULL;
+    mMaxResponseJitter = WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_RESPONSE_JITTER;
+#if WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES > 0
+    memset(mPendingResponses, 0, sizeof(mPendingResponses));
+#endif
 }
 
 /**
@@ -81,6 +86,24 @@ WEAVE_ERROR DeviceDescriptionServer::Shutdown()
     if (ExchangeMgr != NULL)
     {
         ExchangeMgr->UnregisterUnsolicitedMessageHandler(kWeaveProfile_DeviceDescription, kMessageType_IdentifyRequest);
+
+#if WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES > 0
+        // Drop any responses still waiting to be sent.
+        for (int i = 0; i < WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES; i++)
+        {
+            PendingResponse &pending = mPendingResponses[i];
+
+            if (pending.EC != NULL)
+            {
+                ExchangeMgr->MessageLayer->SystemLayer->CancelTimer(HandleResponseTimer, &pending);
+                pending.EC->Close();
+                PacketBuffer::Free(pending.Payload);
+                pending.EC = NULL;
+                pending.Payload = NULL;
+            }
+        }
+#endif // WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES > 0
+
         ExchangeMgr = NULL;
     }
 
@@ -126,6 +149,32 @@ void DeviceDescriptionServer::HandleRequest(ExchangeContext *ec, const IPPacketI
     err = respMsg.Encode(payload);
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES > 0
+    // Every matching device answers a multicast request, so delay the response by a random amount to keep the
+    // responses from colliding.  If too many responses are already waiting, send this one immediately.
+    if (server->mMaxResponseJitter > 0 && pktInfo != NULL && pktInfo->DestAddress.IsMulticast())
+    {
+        for (int i = 0; i < WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES; i++)
+        {
+            PendingResponse &pending = server->mPendingResponses[i];
+
+            if (pending.EC == NULL)
+            {
+                uint32_t delay = GetRandU32() % (server->mMaxResponseJitter + 1);
+
+                err = server->ExchangeMgr->MessageLayer->SystemLayer->StartTimer(delay, HandleResponseTimer, &pending);
+                if (err != WEAVE_NO_ERROR)
+                    break;
+
+                pending.Server = server;
+                pending.EC = ec;
+                pending.Payload = payload;
+                return;
+            }
+        }
+    }
+#endif // WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES > 0
+
     // Send the response back to the requestor.
     ec->SendMessage(kWeaveProfile_DeviceDescription, kMessageType_IdentifyResponse, payload);
     payload = NULL;
@@ -140,6 +189,27 @@ exit:
         PacketBuffer::Free(payload);
 }
 
+/**
+ * Send a response to a multicast IdentifyRequest once its random delay has expired.
+ */
+void DeviceDescriptionServer::HandleResponseTimer(System::Layer *systemLayer, void *appState, System::Error err)
+{
+#if WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES > 0
+    PendingResponse *pending = static_cast<PendingResponse *>(appState);
+    ExchangeContext *ec = pending->EC;
+    PacketBuffer *payload = pending->Payload;
+
+    pending->EC = NULL;
+    pending->Payload = NULL;
+
+    if (ec != NULL)
+    {
+        ec->SendMessage(kWeaveProfile_DeviceDescription, kMessageType_IdentifyResponse, payload);
+        ec->Close();
+    }
+#endif // WEAVE_CONFIG_DEVICE_DESCRIPTION_MAX_PENDING_RESPONSES > 0
+}
+
 
 } // namespace DeviceDescription
 } // namespace Profiles
@@ -56,12 +56,20 @@ using ::nl::Weave::System::PacketBuffer;
 enum
 {
     kHeartbeatMessageType_Heartbeat             = 1,
+    kHeartbeatMessageType_AggregatedHeartbeat   = 2,    ///< Heartbeats relayed on behalf of other nodes.
 };
 
 
+/**
+ * An AggregatedHeartbeat message is a 16-bit little-endian entry count, followed
+ * by that many entries of a 64-bit little-endian node id and the node's 8-bit
+ * subscription state.
+ */
 enum
 {
-    kHeartbeatMessageLength                     = 1
+    kHeartbeatMessageLength                     = 1,
+    kAggregatedHeartbeatHeaderLength            = 2,
+    kAggregatedHeartbeatEntryLength             = 9,
 };
 
 
@@ -170,6 +178,61 @@ struct WeaveHeartbeatSender::OutEventParam
 
 
 
+/**
+ * Weave Heartbeat Aggregator class
+ *
+ * Collects heartbeats that a node, typically a gateway, relays on behalf of
+ * other nodes and sends them to a peer in AggregatedHeartbeat messages, one
+ * per aggregation window rather than one per heartbeat.  A node that
+ * heartbeats more than once within a window is reported once, with its most
+ * recent subscription state.
+ */
+class NL_DLL_EXPORT WeaveHeartbeatAggregator
+{
+public:
+    typedef void (*FlushCompleteHandler)(void *appState, uint16_t numHeartbeats, WEAVE_ERROR err);
+
+    void *AppState;
+    FlushCompleteHandler OnFlushComplete;   ///< Called after each flush with the number of heartbeats sent.
+
+    WeaveHeartbeatAggregator(void);
+
+    WEAVE_ERROR Init(WeaveExchangeManager *exchangeMgr, Binding *binding, uint32_t window);
+    WEAVE_ERROR Shutdown(void);
+
+    WEAVE_ERROR AddHeartbeat(uint64_t nodeId, uint8_t subscriptionState);
+    WEAVE_ERROR Flush(void);
+
+    uint16_t GetPendingCount(void) const;
+
+    uint32_t GetWindow(void) const;
+    void SetWindow(uint32_t window);
+
+    bool GetRequestAck(void) const;
+    void SetRequestAck(bool val);
+
+private:
+    struct Entry
+    {
+        uint64_t NodeId;
+        uint8_t SubscriptionState;
+    };
+
+    WEAVE_ERROR SendPending(void);
+    void FlushFailed(WEAVE_ERROR err);
+    static void HandleWindowTimer(System::Layer* aSystemLayer, void* aAppState, System::Error aError);
+    static void BindingEventCallback(void *appState, Binding::EventType eventType, const Binding::InEventParam& inParam, Binding::OutEventParam& outParam);
+    WeaveHeartbeatAggregator(const WeaveHeartbeatAggregator&); // Not defined.
+
+    WeaveExchangeManager *      mExchangeMgr;
+    Binding *                   mBinding;
+    uint32_t                    mWindow_msec;
+    uint16_t                    mNumEntries;
+    bool                        mRequestAck;
+    Entry                       mEntries[WEAVE_CONFIG_HEARTBEAT_AGGREGATOR_MAX_NODES];
+};
+
+
 /**
  * Weave Heartbeat Receiver class
  */
@@ -183,8 +246,12 @@ public:
     typedef void (*OnHeartbeatReceivedHandler)(const WeaveMessageInfo *aMsgInfo, uint8_t nodeState, WEAVE_ERROR err);
     OnHeartbeatReceivedHandler OnHeartbeatReceived;
 
+    typedef void (*OnAggregatedHeartbeatReceivedHandler)(const WeaveMessageInfo *aMsgInfo, uint64_t nodeId, uint8_t nodeState, WEAVE_ERROR err);
+    OnAggregatedHeartbeatReceivedHandler OnAggregatedHeartbeatReceived;
+
 private:
     static void HandleHeartbeat(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer *payload);
+    static void HandleAggregatedHeartbeat(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer *payload);
     WeaveHeartbeatReceiver(const WeaveHeartbeatReceiver&);
 };
 
@@ -230,6 +297,31 @@ inline void WeaveHeartbeatSender::SetEventCallback(EventCallback eventCallback)
     mEventCallback = eventCallback;
 }
 
+inline uint16_t WeaveHeartbeatAggregator::GetPendingCount() const
+{
+    return mNumEntries;
+}
+
+inline uint32_t WeaveHeartbeatAggregator::GetWindow() const
+{
+    return mWindow_msec;
+}
+
+inline void WeaveHeartbeatAggregator::SetWindow(uint32_t window)
+{
+    mWindow_msec = window;
+}
+
+inline bool WeaveHeartbeatAggregator::GetRequestAck() const
+{
+    return mRequestAck;
+}
+
+inline void WeaveHeartbeatAggregator::SetRequestAck(bool val)
+{
+    mRequestAck = val;
+}
+
 
 } // namespace Heartbeat
 } // namespace Profiles
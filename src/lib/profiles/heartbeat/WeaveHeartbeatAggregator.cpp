@@ -0,0 +1,355 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements Weave Heartbeat Aggregator.
+ *
+ */
+
+#include "WeaveHeartbeat.h"
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/ErrorStr.h>
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace Heartbeat {
+
+WeaveHeartbeatAggregator::WeaveHeartbeatAggregator()
+{
+    AppState = NULL;
+    OnFlushComplete = NULL;
+    mExchangeMgr = NULL;
+    mBinding = NULL;
+    mWindow_msec = 0;
+    mNumEntries = 0;
+    mRequestAck = false;
+}
+
+/**
+ * Initialize the Weave Heartbeat Aggregator.
+ *
+ * @param[in] exchangeMgr   A pointer to the system Weave Exchange Manager.
+ * @param[in] binding       A pointer to a Weave binding object which will be used to address the peer node.
+ * @param[in] window        The time, in milliseconds, for which heartbeats are collected before they are sent.
+ *
+ * @retval #WEAVE_ERROR_INCORRECT_STATE     If the WeaveHeartbeatAggregator object has already been initialized.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT    If any of the supplied pointers is null.
+ * @retval #WEAVE_NO_ERROR                  On success.
+ */
+WEAVE_ERROR WeaveHeartbeatAggregator::Init(WeaveExchangeManager *exchangeMgr, Binding *binding, uint32_t window)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mExchangeMgr == NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    VerifyOrExit(exchangeMgr != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(binding != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    mExchangeMgr = exchangeMgr;
+    mBinding = binding;
+    binding->AddRef();
+    mWindow_msec = window;
+    mNumEntries = 0;
+    mRequestAck = false;
+
+    mBinding->SetProtocolLayerCallback(BindingEventCallback, this);
+
+exit:
+    return err;
+}
+
+/**
+ * Shutdown the Weave Heartbeat Aggregator, discarding any heartbeats that have not been sent.
+ *
+ * @retval #WEAVE_NO_ERROR  On success.
+ */
+WEAVE_ERROR WeaveHeartbeatAggregator::Shutdown()
+{
+    if (mExchangeMgr != NULL)
+    {
+        mExchangeMgr->MessageLayer->SystemLayer->CancelTimer(HandleWindowTimer, this);
+    }
+
+    if (mBinding != NULL)
+    {
+        mBinding->Release();
+        mBinding = NULL;
+    }
+
+    mExchangeMgr = NULL;
+    mNumEntries = 0;
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ * Queue a heartbeat received from, or on behalf of, another node.
+ *
+ * The first heartbeat queued after a flush starts the aggregation window; the queued heartbeats are sent when it
+ * expires, or as soon as the queue is full.
+ *
+ * @param[in] nodeId                The node that sent the heartbeat.
+ * @param[in] subscriptionState     The subscription state conveyed by the heartbeat.
+ *
+ * @retval #WEAVE_ERROR_INCORRECT_STATE     If the WeaveHeartbeatAggregator is not initialized.
+ * @retval #WEAVE_ERROR_NO_MEMORY           If the queue is full and could not be flushed.
+ * @retval #WEAVE_NO_ERROR                  On success.
+ */
+WEAVE_ERROR WeaveHeartbeatAggregator::AddHeartbeat(uint64_t nodeId, uint8_t subscriptionState)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mExchangeMgr != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    // A node that heartbeats again within the window is reported once, with its latest state.
+    for (uint16_t i = 0; i < mNumEntries; i++)
+    {
+        if (mEntries[i].NodeId == nodeId)
+        {
+            mEntries[i].SubscriptionState = subscriptionState;
+            ExitNow();
+        }
+    }
+
+    VerifyOrExit(mNumEntries < WEAVE_CONFIG_HEARTBEAT_AGGREGATOR_MAX_NODES, err = WEAVE_ERROR_NO_MEMORY);
+
+    mEntries[mNumEntries].NodeId = nodeId;
+    mEntries[mNumEntries].SubscriptionState = subscriptionState;
+    mNumEntries++;
+
+    if (mNumEntries == WEAVE_CONFIG_HEARTBEAT_AGGREGATOR_MAX_NODES)
+    {
+        Flush();
+    }
+    else if (mNumEntries == 1)
+    {
+        err = mExchangeMgr->MessageLayer->SystemLayer->StartTimer(mWindow_msec, HandleWindowTimer, this);
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * Send all queued heartbeats now, without waiting for the aggregation window to expire.
+ *
+ * If the binding must first be prepared, the heartbeats are sent once it is ready.  The outcome is reported through
+ * #OnFlushComplete; heartbeats that could not be sent remain queued and are retried after another window.
+ *
+ * @retval #WEAVE_ERROR_INCORRECT_STATE     If the WeaveHeartbeatAggregator is not initialized, or the binding cannot be used.
+ * @retval #WEAVE_NO_ERROR                  On success.
+ */
+WEAVE_ERROR WeaveHeartbeatAggregator::Flush()
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mExchangeMgr != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    mExchangeMgr->MessageLayer->SystemLayer->CancelTimer(HandleWindowTimer, this);
+
+    VerifyOrExit(mNumEntries > 0, );
+
+    // If the binding is not ready but can be prepared, ask the application to prepare it; the heartbeats are sent
+    // from BindingEventCallback() once it is ready.
+    if (mBinding->CanBePrepared())
+    {
+        err = mBinding->RequestPrepare();
+        ExitNow();
+    }
+
+    if (mBinding->IsPreparing())
+    {
+        ExitNow();
+    }
+
+    VerifyOrExit(mBinding->IsReady(), err = WEAVE_ERROR_INCORRECT_STATE);
+
+    err = SendPending();
+
+exit:
+    if (err != WEAVE_NO_ERROR && mExchangeMgr != NULL)
+    {
+        FlushFailed(err);
+    }
+    return err;
+}
+
+/**
+ * Send the queued heartbeats in as few AggregatedHeartbeat messages as the packet buffers allow.
+ */
+WEAVE_ERROR WeaveHeartbeatAggregator::SendPending()
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *payload = NULL;
+    ExchangeContext *ec = NULL;
+    uint16_t numSent = 0;
+
+    while (numSent < mNumEntries)
+    {
+        uint16_t count;
+        uint8_t *p;
+
+        payload = PacketBuffer::New();
+        VerifyOrExit(payload != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        count = static_cast<uint16_t>((payload->AvailableDataLength() - kAggregatedHeartbeatHeaderLength) / kAggregatedHeartbeatEntryLength);
+        if (count > mNumEntries - numSent)
+            count = mNumEntries - numSent;
+
+        p = payload->Start();
+        nl::Weave::Encoding::LittleEndian::Write16(p, count);
+        for (uint16_t i = numSent; i < numSent + count; i++)
+        {
+            nl::Weave::Encoding::LittleEndian::Write64(p, mEntries[i].NodeId);
+            nl::Weave::Encoding::Write8(p, mEntries[i].SubscriptionState);
+        }
+        payload->SetDataLength(static_cast<uint16_t>(p - payload->Start()));
+
+        err = mBinding->NewExchangeContext(ec);
+        SuccessOrExit(err);
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+        if (mRequestAck)
+            ec->SetAutoRequestAck(true);
+#endif
+
+        err = ec->SendMessage(kWeaveProfile_Heartbeat, kHeartbeatMessageType_AggregatedHeartbeat, payload);
+        payload = NULL;
+
+        // Any retransmissions hold their own reference to the exchange.
+        ec->Close();
+        ec = NULL;
+        SuccessOrExit(err);
+
+        numSent += count;
+    }
+
+exit:
+    if (payload != NULL)
+    {
+        PacketBuffer::Free(payload);
+    }
+
+    // Keep whatever could not be sent for the next attempt.
+    mNumEntries -= numSent;
+    memmove(mEntries, mEntries + numSent, mNumEntries * sizeof(mEntries[0]));
+
+    if (err == WEAVE_NO_ERROR && OnFlushComplete != NULL)
+    {
+        OnFlushComplete(AppState, numSent, err);
+    }
+
+    return err;
+}
+
+/**
+ * Report a failed flush and arrange to retry the remaining heartbeats after another window.
+ */
+void WeaveHeartbeatAggregator::FlushFailed(WEAVE_ERROR err)
+{
+    WeaveLogError(Heartbeat, "Aggregated heartbeat flush failed: %s", ErrorStr(err));
+
+    if (mNumEntries > 0)
+    {
+        mExchangeMgr->MessageLayer->SystemLayer->StartTimer(mWindow_msec, HandleWindowTimer, this);
+    }
+
+    if (OnFlushComplete != NULL)
+    {
+        OnFlushComplete(AppState, 0, err);
+    }
+}
+
+/**
+ * Send the queued heartbeats when the aggregation window expires.
+ */
+void WeaveHeartbeatAggregator::HandleWindowTimer(System::Layer* aSystemLayer, void* aAppState, System::Error aError)
+{
+    WeaveHeartbeatAggregator *aggregator = reinterpret_cast<WeaveHeartbeatAggregator *>(aAppState);
+
+    aggregator->Flush();
+}
+
+/**
+ * Handle events from the binding object associated with the WeaveHeartbeatAggregator.
+ */
+void WeaveHeartbeatAggregator::BindingEventCallback(void *appState, Binding::EventType eventType, const Binding::InEventParam& inParam, Binding::OutEventParam& outParam)
+{
+    WeaveHeartbeatAggregator *aggregator = (WeaveHeartbeatAggregator *)appState;
+    WEAVE_ERROR err;
+
+    switch (eventType)
+    {
+    case Binding::kEvent_BindingReady:
+        if (aggregator->mNumEntries > 0)
+        {
+            err = aggregator->SendPending();
+            if (err != WEAVE_NO_ERROR)
+                aggregator->FlushFailed(err);
+        }
+        break;
+
+    case Binding::kEvent_PrepareFailed:
+        aggregator->FlushFailed(inParam.PrepareFailed.Reason);
+        break;
+
+    default:
+        Binding::DefaultEventHandler(appState, eventType, inParam, outParam);
+    }
+}
+
+/**
+ * @fn uint16_t WeaveHeartbeatAggregator::GetPendingCount() const
+ *
+ * Get the number of heartbeats waiting to be sent.
+ */
+
+/**
+ * @fn uint32_t WeaveHeartbeatAggregator::GetWindow() const
+ *
+ * Get the aggregation window, in milliseconds.
+ */
+
+/**
+ * @fn void WeaveHeartbeatAggregator::SetWindow(uint32_t window)
+ *
+ * Set the aggregation window, in milliseconds.  The new window applies from the next heartbeat queued after a flush.
+ *
+ * @param[in] window            The time for which heartbeats are collected before they are sent.
+ */
+
+/**
+ * @fn bool WeaveHeartbeatAggregator::GetRequestAck() const
+ *
+ * Returns a flag indicating whether aggregated heartbeat messages will be sent reliably using Weave Reliable Messaging.
+ */
+
+/**
+ * @fn void WeaveHeartbeatAggregator::SetRequestAck(bool val)
+ *
+ * Sets a flag indicating whether aggregated heartbeat messages should be sent reliably using Weave Reliable Messaging.
+ *
+ * @param[in] val               True if aggregated heartbeat messages should be sent reliably.
+ */
+
+} // namespace Heartbeat
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
@@ -24,6 +24,7 @@
 
 #include "WeaveHeartbeat.h"
 #include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/ErrorStr.h>
 
 namespace nl {
 namespace Weave {
@@ -35,6 +36,7 @@ WeaveHeartbeatReceiver::WeaveHeartbeatReceiver()
     FabricState = NULL;
     ExchangeMgr = NULL;
     OnHeartbeatReceived = NULL;
+    OnAggregatedHeartbeatReceived = NULL;
 }
 
 /**
@@ -59,8 +61,17 @@ WEAVE_ERROR WeaveHeartbeatReceiver::Init(WeaveExchangeManager *exchangeMgr)
     ExchangeMgr = exchangeMgr;
     FabricState = exchangeMgr->FabricState;
     OnHeartbeatReceived = NULL;
+    OnAggregatedHeartbeatReceived = NULL;
 
     err = ExchangeMgr->RegisterUnsolicitedMessageHandler(kWeaveProfile_Heartbeat, kHeartbeatMessageType_Heartbeat, HandleHeartbeat, this);
+    SuccessOrExit(err);
+
+    err = ExchangeMgr->RegisterUnsolicitedMessageHandler(kWeaveProfile_Heartbeat, kHeartbeatMessageType_AggregatedHeartbeat,
+            HandleAggregatedHeartbeat, this);
+    if (err != WEAVE_NO_ERROR)
+    {
+        ExchangeMgr->UnregisterUnsolicitedMessageHandler(kWeaveProfile_Heartbeat, kHeartbeatMessageType_Heartbeat);
+    }
 
 exit:
     return err;
@@ -77,6 +88,7 @@ WEAVE_ERROR WeaveHeartbeatReceiver::Shutdown()
     if (ExchangeMgr != NULL)
     {
         ExchangeMgr->UnregisterUnsolicitedMessageHandler(kWeaveProfile_Heartbeat, kHeartbeatMessageType_Heartbeat);
+        ExchangeMgr->UnregisterUnsolicitedMessageHandler(kWeaveProfile_Heartbeat, kHeartbeatMessageType_AggregatedHeartbeat);
         ExchangeMgr = NULL;
     }
 
@@ -130,6 +142,74 @@ exit:
     }
 }
 
+/**
+ * Handle Weave AggregatedHeartbeat messages when received.
+ *
+ * Each heartbeat in the message is delivered to #OnAggregatedHeartbeatReceived if it is set.  Otherwise it is
+ * delivered to #OnHeartbeatReceived as if it had come directly from the relayed node, i.e. with the source node id
+ * of the message information replaced by that node's id.  The relayed node ids are those asserted by the sender of
+ * the message.
+ *
+ * @param[in] ec            A pointer to the exchange context of the message.
+ * @param[in] pktInfo       A pointer to the IP package info.
+ * @param[in] msgInfo       A pointer to Weave message information.
+ * @param[in] profileId     32-bit unsigned profile ID.
+ * @param[in] msgType       8-bit unsigned message type.
+ * @param[in] payload       A pointer to the PacketBuffer of the message payload.
+ */
+void WeaveHeartbeatReceiver::HandleAggregatedHeartbeat(ExchangeContext *ec, const IPPacketInfo *pktInfo,
+        const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer *payload)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveHeartbeatReceiver *receiver;
+    const uint8_t *p;
+    uint16_t count;
+
+    VerifyOrExit(ec != NULL,        err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(payload != NULL,   err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    receiver = static_cast<WeaveHeartbeatReceiver *>(ec->AppState);
+
+    VerifyOrExit(payload->DataLength() >= kAggregatedHeartbeatHeaderLength, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+    p       = payload->Start();
+    count   = nl::Weave::Encoding::LittleEndian::Read16(p);
+
+    VerifyOrExit(payload->DataLength() == kAggregatedHeartbeatHeaderLength + count * kAggregatedHeartbeatEntryLength,
+                 err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint64_t nodeId = nl::Weave::Encoding::LittleEndian::Read64(p);
+        uint8_t state   = nl::Weave::Encoding::Read8(p);
+
+        if (receiver->OnAggregatedHeartbeatReceived != NULL)
+        {
+            receiver->OnAggregatedHeartbeatReceived(msgInfo, nodeId, state, err);
+        }
+        else if (receiver->OnHeartbeatReceived != NULL)
+        {
+            WeaveMessageInfo relayedMsgInfo = *msgInfo;
+
+            relayedMsgInfo.SourceNodeId = nodeId;
+            receiver->OnHeartbeatReceived(&relayedMsgInfo, state, err);
+        }
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        WeaveLogError(Heartbeat, "Invalid aggregated heartbeat: %s", ErrorStr(err));
+
+    if (payload != NULL)
+        PacketBuffer::Free(payload);
+
+    if (ec != NULL)
+    {
+        ec->Close();
+        ec = NULL;
+    }
+}
+
 } // namespace Heartbeat
 } // namespace Profiles
 } // namespace Weave
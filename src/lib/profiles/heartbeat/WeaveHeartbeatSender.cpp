@@ -224,7 +224,13 @@ WEAVE_ERROR WeaveHeartbeatSender::ScheduleHeartbeat()
     if (interval < 0)
         interval = 0;
 
-    return mExchangeMgr->MessageLayer->SystemLayer->StartTimer(static_cast<uint32_t>(interval), HandleHeartbeatTimer, this);
+    // Let the heartbeat go out early by up to the periodic timer tolerance, so that its timer can be coalesced with others.
+    uint32_t tolerance = mHeartbeatInterval_msec / 100 * WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT;
+    if (tolerance > static_cast<uint32_t>(interval))
+        tolerance = static_cast<uint32_t>(interval);
+
+    return mExchangeMgr->MessageLayer->SystemLayer->StartTimer(static_cast<uint32_t>(interval) - tolerance, tolerance,
+                                                               HandleHeartbeatTimer, this);
 }
 
 /**
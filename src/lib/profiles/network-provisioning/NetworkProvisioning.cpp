@@ -72,6 +72,7 @@ WEAVE_ERROR NetworkProvisioningServer::Init(WeaveExchangeManager *exchangeMgr)
     FabricState = exchangeMgr->FabricState;
     mCurOp = NULL;
     mDelegate = NULL;
+    mScanFlags = 0;
     mLastOpResult.StatusProfileId = kWeaveProfile_Common;
     mLastOpResult.StatusCode = Common::kStatus_Success;
     mLastOpResult.SysError = WEAVE_NO_ERROR;
@@ -132,6 +133,45 @@ WEAVE_ERROR NetworkProvisioningServer::SendNetworkScanComplete(uint8_t resultCou
     return SendCompleteWithNetworkList(kMsgType_NetworkScanComplete, resultCount, scanResultsTLV);
 }
 
+/**
+ * Send a Network Scan Results message containing some of the results of a scan still in progress.
+ *
+ * This may be called any number of times before SendNetworkScanComplete(), but only if the client requested
+ * streamed results (see #kScanNetworksFlag_StreamResults).  Unlike SendNetworkScanComplete(), it leaves the
+ * ScanNetworks request outstanding, even on failure; the caller must still complete the request.
+ *
+ * @param[in]   resultCount     The number of scan results.
+ * @param[in]   scanResultsTLV  The scan results.  Ownership passes to this method, success or fail.
+ *
+ * @retval #WEAVE_ERROR_INCORRECT_STATE     If there is no outstanding ScanNetworks request that accepts streamed results.
+ * @retval #WEAVE_ERROR_BUFFER_TOO_SMALL    If the results buffer is not large enough.
+ * @retval #WEAVE_NO_ERROR                  On success.
+ * @retval other                            Other Weave or platform-specific error codes indicating that an error
+ *                                          occurred preventing the device from sending the Scan Results message.
+ */
+WEAVE_ERROR NetworkProvisioningServer::SendNetworkScanResults(uint8_t resultCount, PacketBuffer *scanResultsTLV)
+{
+    WEAVE_ERROR err;
+
+    VerifyOrExit(IsStreamingScanResults(), err = WEAVE_ERROR_INCORRECT_STATE);
+
+    err = SendCompleteWithNetworkList(kMsgType_NetworkScanResults, resultCount, scanResultsTLV, false);
+    scanResultsTLV = NULL;
+
+exit:
+    if (scanResultsTLV != NULL)
+        PacketBuffer::Free(scanResultsTLV);
+    return err;
+}
+
+/**
+ * Returns \c true if there is an outstanding ScanNetworks request whose client accepts streamed results.
+ */
+bool NetworkProvisioningServer::IsStreamingScanResults(void) const
+{
+    return mCurOp != NULL && mCurOpType == kMsgType_ScanNetworks && (mScanFlags & kScanNetworksFlag_StreamResults) != 0;
+}
+
 /**
  * Send a Get Networks Complete message containing the previously scanned networks.
  *
@@ -149,7 +189,7 @@ WEAVE_ERROR NetworkProvisioningServer::SendGetNetworksComplete(uint8_t resultCou
     return SendCompleteWithNetworkList(kMsgType_GetNetworksComplete, resultCount, scanResultsTLV);
 }
 
-WEAVE_ERROR NetworkProvisioningServer::SendCompleteWithNetworkList(uint8_t msgType, int8_t resultCount, PacketBuffer *resultTLV)
+WEAVE_ERROR NetworkProvisioningServer::SendCompleteWithNetworkList(uint8_t msgType, int8_t resultCount, PacketBuffer *resultTLV, bool endOp)
 {
     WEAVE_ERROR err;
     uint8_t *p;
@@ -168,12 +208,16 @@ WEAVE_ERROR NetworkProvisioningServer::SendCompleteWithNetworkList(uint8_t msgTy
     err = mCurOp->SendMessage(kWeaveProfile_NetworkProvisioning, msgType, resultTLV, 0);
     resultTLV = NULL;
 
-    mLastOpResult.StatusProfileId = kWeaveProfile_Common;
-    mLastOpResult.StatusCode = Common::kStatus_Success;
-    mLastOpResult.SysError = WEAVE_NO_ERROR;
+    if (endOp)
+    {
+        mLastOpResult.StatusProfileId = kWeaveProfile_Common;
+        mLastOpResult.StatusCode = Common::kStatus_Success;
+        mLastOpResult.SysError = WEAVE_NO_ERROR;
+    }
 
 exit:
-    if (mCurOp != NULL)
+    // Partial results leave the request outstanding.
+    if (endOp && mCurOp != NULL)
     {
         mCurOp->Close();
         mCurOp = NULL;
@@ -422,6 +466,7 @@ void NetworkProvisioningServer::HandleRequest(ExchangeContext *ec, const IPPacke
     case kMsgType_ScanNetworks:
         VerifyOrExit(dataLen >= 1, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
         networkType = Get8(p);
+        server->mScanFlags = (dataLen >= 2) ? Get8(p) : 0;
         PacketBuffer::Free(payload);
         payload = NULL;
         err = delegate->HandleScanNetworks(networkType);
@@ -112,6 +112,7 @@ enum
     kMsgType_SetWirelessRegulatoryConfig            = 15,
     kMsgType_GetWirelessRegulatoryConfig            = 16,
     kMgrType_GetWirelessRegulatoryConfigComplete    = 17,
+    kMsgType_NetworkScanResults                     = 18,
 };
 
 /**
@@ -233,6 +234,21 @@ enum RendezvousModeFlags
     kRendezvousMode_EnableThreadRendezvous      = 0x0002
 };
 
+/**
+ * Scan Networks Flags.
+ *
+ * Carried in the optional second byte of a ScanNetworks request.  Servers that predate the flags ignore the byte.
+ */
+enum ScanNetworksFlags
+{
+    /**
+     * The client accepts results in NetworkScanResults messages sent before the final NetworkScanComplete.  The
+     * client must merge the results of all the messages, and be prepared to see a network more than once, e.g. when
+     * the server first sends cached results of an earlier scan.
+     */
+    kScanNetworksFlag_StreamResults             = 0x01
+};
+
 /**
  * Get Network Flags.
  */
@@ -407,6 +423,7 @@ public:
     void SetDelegate(NetworkProvisioningDelegate *delegate);
 
     virtual WEAVE_ERROR SendNetworkScanComplete(uint8_t resultCount, PacketBuffer *scanResultsTLV);
+    virtual WEAVE_ERROR SendNetworkScanResults(uint8_t resultCount, PacketBuffer *scanResultsTLV);
     virtual WEAVE_ERROR SendAddNetworkComplete(uint32_t networkId);
     virtual WEAVE_ERROR SendGetNetworksComplete(uint8_t resultCount, PacketBuffer *resultsTLV);
     virtual WEAVE_ERROR SendGetWirelessRegulatoryConfigComplete(PacketBuffer *resultsTLV);
@@ -423,11 +440,14 @@ protected:
         WEAVE_ERROR SysError;
     } mLastOpResult;
     uint8_t mCurOpType;
+    uint8_t mScanFlags;
+
+    bool IsStreamingScanResults(void) const;
 
 private:
     static void HandleRequest(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, uint32_t profileId,
             uint8_t msgType, PacketBuffer *payload);
-    WEAVE_ERROR SendCompleteWithNetworkList(uint8_t msgType, int8_t resultCount, PacketBuffer *resultTLV);
+    WEAVE_ERROR SendCompleteWithNetworkList(uint8_t msgType, int8_t resultCount, PacketBuffer *resultTLV, bool endOp = true);
 
     // Utility functions for managing registration with/notification from WeaveFabricState about whether the
     // current security session is privileged to access network credential information.
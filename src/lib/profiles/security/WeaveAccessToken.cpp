@@ -31,6 +31,8 @@
 #include <Weave/Profiles/security/WeaveSecurity.h>
 #include <Weave/Profiles/security/WeaveCert.h>
 #include <Weave/Support/CodeUtils.h>
+#include <Weave/Core/WeaveSecurityMgr.h>
+#include <Weave/Support/crypto/WeaveCrypto.h>
 #include "WeaveAccessToken.h"
 
 namespace nl {
@@ -431,7 +433,122 @@ exit:
     return err;
 }
 
+DecodedAccessToken::DecodedAccessToken(void)
+{
+    mCertInfo = NULL;
+    mPrivKey = NULL;
+    mBufSize = 0;
+    mCertInfoLen = 0;
+    mPrivKeyLen = 0;
+}
+
+DecodedAccessToken::~DecodedAccessToken(void)
+{
+    Clear();
+}
 
+/**
+ * @brief
+ *   Decode a Weave Access Token for later use.
+ *
+ * @details
+ *   Any token previously decoded by this object is cleared first.  The access token itself is not
+ *   referenced after this method returns.
+ *
+ * @param accessToken                       A pointer to a buffer containing an encoded Weave Access Token.
+ * @param accessTokenLen                    The length of the encoded access token.
+ *
+ * @retval #WEAVE_NO_ERROR                  If the access token was successfully decoded.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT    If the access token is longer than 65535 bytes.
+ * @retval #WEAVE_ERROR_NO_MEMORY           If memory could not be allocated for the decoded token.
+ * @retval tlv-errors                       Weave errors related to reading or writing TLV.
+ */
+WEAVE_ERROR DecodedAccessToken::Init(const uint8_t *accessToken, uint32_t accessTokenLen)
+{
+    WEAVE_ERROR err;
+
+    Clear();
+
+    VerifyOrExit(accessTokenLen <= UINT16_MAX, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // Neither the certificate information nor the private key can be larger than the access token that contains them.
+    mCertInfo = static_cast<uint8_t *>(Platform::Security::MemoryAlloc(accessTokenLen, true));
+    VerifyOrExit(mCertInfo != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    mPrivKey = static_cast<uint8_t *>(Platform::Security::MemoryAlloc(accessTokenLen, true));
+    VerifyOrExit(mPrivKey != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    mBufSize = static_cast<uint16_t>(accessTokenLen);
+
+    err = CASECertInfoFromAccessToken(accessToken, accessTokenLen, mCertInfo, mBufSize, mCertInfoLen);
+    SuccessOrExit(err);
+
+    err = ExtractPrivateKeyFromAccessToken(accessToken, accessTokenLen, mPrivKey, mBufSize, mPrivKeyLen);
+    SuccessOrExit(err);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        Clear();
+    return err;
+}
+
+/**
+ * @brief
+ *   Release the decoded access token, clearing its private key.
+ */
+void DecodedAccessToken::Clear(void)
+{
+    if (mPrivKey != NULL)
+    {
+        // The buffer may hold part of a key if extraction failed, so clear all of it.
+        Crypto::ClearSecretData(mPrivKey, mBufSize);
+        Platform::Security::MemoryFree(mPrivKey);
+        mPrivKey = NULL;
+    }
+
+    if (mCertInfo != NULL)
+    {
+        Platform::Security::MemoryFree(mCertInfo);
+        mCertInfo = NULL;
+    }
+
+    mBufSize = 0;
+    mCertInfoLen = 0;
+    mPrivKeyLen = 0;
+}
+
+/**
+ * @brief
+ *   Write the CASE Certificate Info structure of the decoded access token to a TLVWriter.
+ *
+ * @details
+ *   The output is the same as that of CASECertInfoFromAccessToken(TLVReader&, TLVWriter&) for the original token.
+ *
+ * @param[in] writer                        A TLVWriter to be used to record the output CASE certificate info.
+ *
+ * @retval #WEAVE_NO_ERROR                  If the certificate info structure was successfully written.
+ * @retval #WEAVE_ERROR_INCORRECT_STATE     If no access token has been decoded.
+ * @retval tlv-errors                       Weave errors related to writing TLV.
+ */
+WEAVE_ERROR DecodedAccessToken::WriteCertInfo(TLVWriter& writer) const
+{
+    WEAVE_ERROR err;
+    TLVReader reader;
+
+    VerifyOrExit(IsInitialized(), err = WEAVE_ERROR_INCORRECT_STATE);
+
+    reader.Init(mCertInfo, mCertInfoLen);
+    reader.ImplicitProfileId = kWeaveProfile_Security;
+
+    err = reader.Next();
+    SuccessOrExit(err);
+
+    err = writer.CopyElement(reader);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
 
 } // namespace Security
 } // namespace Profiles
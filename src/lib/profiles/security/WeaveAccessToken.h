@@ -22,6 +22,9 @@
  *
  */
 
+#ifndef WEAVEACCESSTOKEN_H_
+#define WEAVEACCESSTOKEN_H_
+
 #include <Weave/Core/WeaveCore.h>
 #include <Weave/Profiles/WeaveProfiles.h>
 #include <Weave/Core/WeaveTLV.h>
@@ -46,8 +49,47 @@ extern WEAVE_ERROR CASECertInfoFromAccessToken(TLVReader& reader, TLVWriter& wri
 extern WEAVE_ERROR ExtractPrivateKeyFromAccessToken(const uint8_t *accessToken, uint32_t accessTokenLen, uint8_t *privKeyBuf, uint16_t privKeyBufSize, uint16_t& privKeyLen);
 extern WEAVE_ERROR ExtractPrivateKeyFromAccessToken(TLVReader& reader, TLVWriter& writer);
 
+/**
+ * A Weave Access Token decoded once for use in any number of CASE sessions.
+ *
+ * Init() reads the access token and keeps the CASE certificate information structure and the private key
+ * extracted from it, in the forms returned by CASECertInfoFromAccessToken() and ExtractPrivateKeyFromAccessToken(),
+ * so that establishing a session requires no further parsing of the token.  Both are held in memory obtained from
+ * Platform::Security::MemoryAlloc(), and the private key is cleared before that memory is released by Clear() or
+ * the destructor.
+ */
+class NL_DLL_EXPORT DecodedAccessToken
+{
+public:
+    DecodedAccessToken(void);
+    ~DecodedAccessToken(void);
+
+    WEAVE_ERROR Init(const uint8_t *accessToken, uint32_t accessTokenLen);
+    void Clear(void);
+
+    bool IsInitialized(void) const { return mCertInfo != NULL; }
+
+    const uint8_t *GetCertInfo(void) const { return mCertInfo; }
+    uint16_t GetCertInfoLength(void) const { return mCertInfoLen; }
+    WEAVE_ERROR WriteCertInfo(TLVWriter& writer) const;
+
+    const uint8_t *GetPrivateKey(void) const { return mPrivKey; }
+    uint16_t GetPrivateKeyLength(void) const { return mPrivKeyLen; }
+
+private:
+    uint8_t *mCertInfo;
+    uint8_t *mPrivKey;
+    uint16_t mBufSize;
+    uint16_t mCertInfoLen;
+    uint16_t mPrivKeyLen;
+
+    DecodedAccessToken(const DecodedAccessToken&);   // not defined
+};
+
 
 } // namespace Security
 } // namespace Profiles
 } // namespace Weave
 } // namespace nl
+
+#endif /* WEAVEACCESSTOKEN_H_ */
@@ -77,36 +77,13 @@ const uint8_t kWeaveAppIntermediateKeyDiversifier[] = { 0xBC, 0xAA, 0x95, 0xAD }
 WEAVE_ERROR GetAppGroupMasterKeyId(uint32_t groupGlobalId, GroupKeyStoreBase *groupKeyStore, uint32_t& groupMasterKeyId)
 {
     WEAVE_ERROR err;
-    uint32_t groupMasterKeyIds[WEAVE_CONFIG_MAX_APPLICATION_GROUPS];
-    uint8_t groupMasterKeyCount;
-    WeaveGroupKey groupMasterKey;
 
     // Verify the group key store object is provided.
     VerifyOrExit(groupKeyStore != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    // Enumerate all application group master keys.
-    err = groupKeyStore->EnumerateGroupKeys(WeaveKeyId::kType_AppGroupMasterKey, groupMasterKeyIds, sizeof(groupMasterKeyIds) / sizeof(uint32_t), groupMasterKeyCount);
-    SuccessOrExit(err);
-
-    for (int i = 0; i < groupMasterKeyCount; i++)
-    {
-        // Get application group master key.
-        err = groupKeyStore->RetrieveGroupKey(groupMasterKeyIds[i], groupMasterKey);
-        SuccessOrExit(err);
-
-        // If group global Id matches.
-        if (groupMasterKey.GlobalId == groupGlobalId)
-        {
-            groupMasterKeyId = groupMasterKey.KeyId;
-            ExitNow();
-        }
-    }
-
-    ExitNow(err = WEAVE_ERROR_KEY_NOT_FOUND);
+    err = groupKeyStore->FindGroupMasterKeyId(groupGlobalId, groupMasterKeyId);
 
 exit:
-    ClearSecretData(groupMasterKey.Key, groupMasterKey.MaxKeySize);
-
     return err;
 }
 
@@ -178,6 +155,7 @@ void GroupKeyStoreBase::Init(void)
 {
     LastUsedEpochKeyId = WeaveKeyId::kNone;
     NextEpochKeyStartTime = UINT32_MAX;
+    NextEpochKeyId = WeaveKeyId::kNone;
 }
 
 /**
@@ -191,6 +169,98 @@ void GroupKeyStoreBase::OnEpochKeysChange(void)
 {
     LastUsedEpochKeyId = WeaveKeyId::kNone;
     NextEpochKeyStartTime = UINT32_MAX;
+    NextEpochKeyId = WeaveKeyId::kNone;
+}
+
+/**
+ * Enumerate the application epoch keys in the key store, along with their start times.
+ *
+ * The default implementation retrieves each epoch key from the key store in turn.  Key stores
+ * that keep the start times of their keys in memory should override it, so that selecting the
+ * current epoch key does not read key material.
+ *
+ * @param[out]   keyIds          An array of key IDs of the epoch keys.
+ * @param[out]   startTimes      An array of start times of the epoch keys, in the same order.
+ * @param[in]    arraySize       The number of elements in the keyIds and startTimes arrays.
+ * @param[out]   keyCount        The number of epoch keys returned.  If the key store holds more
+ *                               epoch keys than fit in the arrays, the list is truncated.
+ *
+ * @retval #WEAVE_NO_ERROR       On success.
+ * @retval other                 Other platform-specific errors returned by the platform
+ *                               key store APIs.
+ *
+ */
+WEAVE_ERROR GroupKeyStoreBase::EnumerateEpochKeys(uint32_t *keyIds, uint32_t *startTimes, uint8_t arraySize, uint8_t& keyCount)
+{
+    WEAVE_ERROR err;
+    WeaveGroupKey epochKey;
+
+    err = EnumerateGroupKeys(WeaveKeyId::kType_AppEpochKey, keyIds, arraySize, keyCount);
+    SuccessOrExit(err);
+
+    for (int i = 0; i < keyCount; i++)
+    {
+        err = RetrieveGroupKey(keyIds[i], epochKey);
+        SuccessOrExit(err);
+
+        startTimes[i] = epochKey.StartTime;
+    }
+
+exit:
+    ClearSecretData(epochKey.Key, epochKey.MaxKeySize);
+
+    return err;
+}
+
+/**
+ * Find the application group master key with the specified global ID.
+ *
+ * The default implementation retrieves each group master key from the key store in turn.  Key
+ * stores that keep the global IDs of their keys in memory should override it, as it is called
+ * for every group-keyed message.
+ *
+ * @param[in]    groupGlobalId    The application group global ID.
+ * @param[out]   groupMasterKeyId The application group master key ID.
+ *
+ * @retval #WEAVE_NO_ERROR       On success.
+ * @retval #WEAVE_ERROR_KEY_NOT_FOUND
+ *                               If a group key with specified global ID is not found
+ *                               in the platform key store.
+ * @retval other                 Other platform-specific errors returned by the platform
+ *                               key store APIs.
+ *
+ */
+WEAVE_ERROR GroupKeyStoreBase::FindGroupMasterKeyId(uint32_t groupGlobalId, uint32_t& groupMasterKeyId)
+{
+    WEAVE_ERROR err;
+    uint32_t groupMasterKeyIds[WEAVE_CONFIG_MAX_APPLICATION_GROUPS];
+    uint8_t groupMasterKeyCount;
+    WeaveGroupKey groupMasterKey;
+
+    // Enumerate all application group master keys.
+    err = EnumerateGroupKeys(WeaveKeyId::kType_AppGroupMasterKey, groupMasterKeyIds, sizeof(groupMasterKeyIds) / sizeof(uint32_t), groupMasterKeyCount);
+    SuccessOrExit(err);
+
+    for (int i = 0; i < groupMasterKeyCount; i++)
+    {
+        // Get application group master key.
+        err = RetrieveGroupKey(groupMasterKeyIds[i], groupMasterKey);
+        SuccessOrExit(err);
+
+        // If group global Id matches.
+        if (groupMasterKey.GlobalId == groupGlobalId)
+        {
+            groupMasterKeyId = groupMasterKey.KeyId;
+            ExitNow();
+        }
+    }
+
+    ExitNow(err = WEAVE_ERROR_KEY_NOT_FOUND);
+
+exit:
+    ClearSecretData(groupMasterKey.Key, groupMasterKey.MaxKeySize);
+
+    return err;
 }
 
 /**
@@ -242,7 +312,6 @@ WEAVE_ERROR GroupKeyStoreBase::GetCurrentAppKeyId(uint32_t keyId, uint32_t& curK
     uint8_t epochKeyCount;
     uint32_t curUTCTime;
     int curEpochKeyIdIdx;
-    WeaveGroupKey epochKey;
 
     // If current application key is not used to derive this application key.
     if (!WeaveKeyId::UsesCurrentEpochKey(keyId))
@@ -278,21 +347,12 @@ WEAVE_ERROR GroupKeyStoreBase::GetCurrentAppKeyId(uint32_t keyId, uint32_t& curK
     // Update LastUsedEpochKeyId and NextEpochKeyStartTime values if needed.
     if (LastUsedEpochKeyId == WeaveKeyId::kNone || curUTCTime > NextEpochKeyStartTime)
     {
-        // Enumerate all application epoch keys.
-        err = EnumerateGroupKeys(WeaveKeyId::kType_AppEpochKey, epochKeyIds, sizeof(epochKeyIds) / sizeof(uint32_t), epochKeyCount);
+        // Enumerate all application epoch keys, with their start times.
+        err = EnumerateEpochKeys(epochKeyIds, epochKeyStartTimes, sizeof(epochKeyIds) / sizeof(uint32_t), epochKeyCount);
         SuccessOrExit(err);
 
         VerifyOrExit(epochKeyCount > 0, err = WEAVE_ERROR_KEY_NOT_FOUND);
 
-        // Get start time for each epoch key.
-        for (int i = 0; i < epochKeyCount; i++)
-        {
-            err = RetrieveGroupKey(epochKeyIds[i], epochKey);
-            SuccessOrExit(err);
-
-            epochKeyStartTimes[i] = epochKey.StartTime;
-        }
-
         // Search the list of epoch keys for the "current" epoch key.  The current epoch key is defined
         // as the newest epoch key (i.e. the key with the greatest start time) that has a start time that
         // is less than or equal to the current time.  In the case that the current time is unknown
@@ -316,11 +376,14 @@ WEAVE_ERROR GroupKeyStoreBase::GetCurrentAppKeyId(uint32_t keyId, uint32_t& curK
         // key.  In the case where there is no next key (e.g. when the current key is the only key in the
         // list) use an end time of "indefinite" (UINT32_MAX), implying that the current key should remain
         // current until a new set of epoch keys is received.
+        NextEpochKeyStartTime = UINT32_MAX;
+        NextEpochKeyId = WeaveKeyId::kNone;
         for (int i = 0; i < epochKeyCount; i++)
         {
             if ((epochKeyStartTimes[i] > epochKeyStartTimes[curEpochKeyIdIdx] && epochKeyStartTimes[i] < NextEpochKeyStartTime))
             {
                 NextEpochKeyStartTime = epochKeyStartTimes[i];
+                NextEpochKeyId = epochKeyIds[i];
             }
         }
 
@@ -335,8 +398,45 @@ WEAVE_ERROR GroupKeyStoreBase::GetCurrentAppKeyId(uint32_t keyId, uint32_t& curK
     curKeyId = WeaveKeyId::UpdateEpochKeyId(keyId, LastUsedEpochKeyId);
 
 exit:
-    ClearSecretData(epochKey.Key, epochKey.MaxKeySize);
+    return err;
+}
 
+/**
+ * Returns the key ID that replaces a current application key at the next epoch key rotation.
+ * The next epoch key is the one with the earliest start time after that of the current epoch
+ * key, as found by GetCurrentAppKeyId().  Knowing it allows the application key that becomes
+ * current at the next rotation to be derived before it is first used.
+ *
+ * @param[in]    keyId           The application rotating key ID, which must use the current
+ *                               epoch key.
+ * @param[out]   nextKeyId       The application rotating key ID that incorporates the next
+ *                               epoch key.
+ *
+ * @retval #WEAVE_NO_ERROR       On success.
+ * @retval #WEAVE_ERROR_INVALID_KEY_ID
+ *                               If the input key ID does not incorporate an epoch key.
+ * @retval #WEAVE_ERROR_KEY_NOT_FOUND
+ *                               If the input key does not use the current epoch key or if
+ *                               no epoch key is scheduled to follow it.
+ * @retval other                 Other errors returned by GetCurrentAppKeyId().
+ *
+ */
+WEAVE_ERROR GroupKeyStoreBase::GetNextAppKeyId(uint32_t keyId, uint32_t& nextKeyId)
+{
+    WEAVE_ERROR err;
+    uint32_t curKeyId;
+
+    VerifyOrExit(WeaveKeyId::IsAppRotatingKey(keyId) && !WeaveKeyId::UsesCurrentEpochKey(keyId), err = WEAVE_ERROR_INVALID_KEY_ID);
+
+    // Bring the current and next epoch key selection up to date.
+    err = GetCurrentAppKeyId(WeaveKeyId::ConvertToCurrentAppKeyId(keyId), curKeyId);
+    SuccessOrExit(err);
+
+    VerifyOrExit(curKeyId == keyId && NextEpochKeyId != WeaveKeyId::kNone, err = WEAVE_ERROR_KEY_NOT_FOUND);
+
+    nextKeyId = WeaveKeyId::UpdateEpochKeyId(keyId, NextEpochKeyId);
+
+exit:
     return err;
 }
 
@@ -563,6 +663,85 @@ WEAVE_ERROR GroupKeyStoreBase::DeriveApplicationKey(uint32_t& keyId,
     WEAVE_ERROR err;
     WeaveGroupKey intermediateKey;
     WeaveGroupKey groupMasterKey;
+
+    err = GetApplicationKeyMaterial(keyId, intermediateKey, groupMasterKey);
+    SuccessOrExit(err);
+
+    // Derive application key material.
+    err = HKDFSHA1::DeriveKey(keySalt, saltLen,
+                              intermediateKey.Key, intermediateKey.KeyLen,
+                              groupMasterKey.Key, groupMasterKey.KeyLen,
+                              keyDiversifier, diversifierLen,
+                              appKey, keyBufSize, keyLen);
+    SuccessOrExit(err);
+
+    // Return the global id of the associated application group.
+    appGroupGlobalId = groupMasterKey.GlobalId;
+
+exit:
+    ClearSecretData(intermediateKey.Key, intermediateKey.MaxKeySize);
+    ClearSecretData(groupMasterKey.Key, groupMasterKey.MaxKeySize);
+
+    return err;
+}
+
+/**
+ * Get application group key, using a precomputed HMAC key schedule for the key salt.
+ * This function is equivalent to the variant that accepts the salt value, but avoids
+ * hashing the salt on every derivation when many keys are derived with the same salt.
+ *
+ * @param[inout] keyId              A reference to the requested key ID. When current application
+ *                                  key is requested this field is updated to reflect the new
+ *                                  type (rotating application key) and the actual epoch key ID
+ *                                  that was used to generate application key.
+ * @param[in]    saltKeySchedule    The HMAC-SHA1 key schedule of the application key salt.
+ * @param[in]    keyDiversifier     A pointer to a buffer with application key diversifier value.
+ * @param[in]    diversifierLen     The length of the application key diversifier.
+ * @param[out]   appKey             A pointer to a buffer where the derived key will be written.
+ * @param[in]    keyBufSize         The length of the supplied key buffer.
+ * @param[in]    keyLen             The length of the requested key material.
+ * @param[out]   appGroupGlobalId   The application group global ID of the associated key.
+ *
+ * @retval #WEAVE_NO_ERROR          On success.
+ * @retval other                    The errors returned by the variant that accepts the salt value.
+ *
+ */
+WEAVE_ERROR GroupKeyStoreBase::DeriveApplicationKey(uint32_t& keyId,
+                                                    const nl::Weave::Crypto::HMACSHA1KeySchedule& saltKeySchedule,
+                                                    const uint8_t *keyDiversifier, uint8_t diversifierLen,
+                                                    uint8_t *appKey, uint8_t keyBufSize, uint8_t keyLen,
+                                                    uint32_t& appGroupGlobalId)
+{
+    WEAVE_ERROR err;
+    WeaveGroupKey intermediateKey;
+    WeaveGroupKey groupMasterKey;
+
+    err = GetApplicationKeyMaterial(keyId, intermediateKey, groupMasterKey);
+    SuccessOrExit(err);
+
+    // Derive application key material.
+    err = HKDFSHA1::DeriveKey(saltKeySchedule,
+                              intermediateKey.Key, intermediateKey.KeyLen,
+                              groupMasterKey.Key, groupMasterKey.KeyLen,
+                              keyDiversifier, diversifierLen,
+                              appKey, keyBufSize, keyLen);
+    SuccessOrExit(err);
+
+    // Return the global id of the associated application group.
+    appGroupGlobalId = groupMasterKey.GlobalId;
+
+exit:
+    ClearSecretData(intermediateKey.Key, intermediateKey.MaxKeySize);
+    ClearSecretData(groupMasterKey.Key, groupMasterKey.MaxKeySize);
+
+    return err;
+}
+
+// Resolves the current key Id and retrieves the root or intermediate key and the application
+// group master key from which the application key is derived.
+WEAVE_ERROR GroupKeyStoreBase::GetApplicationKeyMaterial(uint32_t& keyId, WeaveGroupKey& intermediateKey, WeaveGroupKey& groupMasterKey)
+{
+    WEAVE_ERROR err;
     uint32_t localKeyId;
 
     // Verify that key identifier has correct type.
@@ -596,21 +775,7 @@ WEAVE_ERROR GroupKeyStoreBase::DeriveApplicationKey(uint32_t& keyId,
     // Verify correct key size.
     VerifyOrExit(groupMasterKey.KeyLen == kWeaveAppGroupMasterKeySize, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
-    // Derive application key material.
-    err = HKDFSHA1::DeriveKey(keySalt, saltLen,
-                              intermediateKey.Key, intermediateKey.KeyLen,
-                              groupMasterKey.Key, groupMasterKey.KeyLen,
-                              keyDiversifier, diversifierLen,
-                              appKey, keyBufSize, keyLen);
-    SuccessOrExit(err);
-
-    // Return the global id of the associated application group.
-    appGroupGlobalId = groupMasterKey.GlobalId;
-
 exit:
-    ClearSecretData(intermediateKey.Key, intermediateKey.MaxKeySize);
-    ClearSecretData(groupMasterKey.Key, groupMasterKey.MaxKeySize);
-
     return err;
 }
 
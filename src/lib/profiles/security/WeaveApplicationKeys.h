@@ -27,6 +27,7 @@
 #define WEAVEAPPLICATIONKEYS_H_
 
 #include <Weave/Core/WeaveCore.h>
+#include <Weave/Support/crypto/HMAC.h>
 
 /**
  *   @namespace nl::Weave::Profiles::Security::AppKeys
@@ -131,12 +132,20 @@ public:
     virtual WEAVE_ERROR EnumerateGroupKeys(uint32_t keyType, uint32_t *keyIds, uint8_t keyIdsArraySize, uint8_t & keyCount) = 0;
     virtual WEAVE_ERROR Clear(void) = 0;
 
+    // Look up key metadata without retrieving key material. Key stores that keep an index of
+    // their keys can override these to avoid reading each key from storage.
+    virtual WEAVE_ERROR EnumerateEpochKeys(uint32_t *keyIds, uint32_t *startTimes, uint8_t arraySize, uint8_t & keyCount);
+    virtual WEAVE_ERROR FindGroupMasterKeyId(uint32_t groupGlobalId, uint32_t & groupMasterKeyId);
+
     // Get the current time.
     virtual WEAVE_ERROR GetCurrentUTCTime(uint32_t& utcTime);
 
     // Get current application key Id.
     WEAVE_ERROR GetCurrentAppKeyId(uint32_t keyId, uint32_t& curKeyId);
 
+    // Get the application key Id that will replace the current one at the next epoch key rotation.
+    WEAVE_ERROR GetNextAppKeyId(uint32_t keyId, uint32_t& nextKeyId);
+
     // Get/Derive group key.
     WEAVE_ERROR GetGroupKey(uint32_t keyId, WeaveGroupKey& groupKey);
 
@@ -146,10 +155,16 @@ public:
                                      const uint8_t *keyDiversifier, uint8_t diversifierLen,
                                      uint8_t *appKey, uint8_t keyBufSize, uint8_t keyLen,
                                      uint32_t& appGroupGlobalId);
+    WEAVE_ERROR DeriveApplicationKey(uint32_t& appKeyId,
+                                     const nl::Weave::Crypto::HMACSHA1KeySchedule& saltKeySchedule,
+                                     const uint8_t *keyDiversifier, uint8_t diversifierLen,
+                                     uint8_t *appKey, uint8_t keyBufSize, uint8_t keyLen,
+                                     uint32_t& appGroupGlobalId);
 
 protected:
     uint32_t LastUsedEpochKeyId;
     uint32_t NextEpochKeyStartTime;
+    uint32_t NextEpochKeyId;
 
     void Init(void);
     void OnEpochKeysChange(void);
@@ -164,6 +179,9 @@ private:
 
     // Derive intermediate key.
     WEAVE_ERROR DeriveIntermediateKey(uint32_t keyId, WeaveGroupKey& intermediateKey);
+
+    // Get the key material from which an application key is derived.
+    WEAVE_ERROR GetApplicationKeyMaterial(uint32_t& keyId, WeaveGroupKey& intermediateKey, WeaveGroupKey& groupMasterKey);
 };
 
 
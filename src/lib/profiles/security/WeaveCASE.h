@@ -37,6 +37,7 @@
 #include <Weave/Support/CodeUtils.h>
 #include <Weave/Support/crypto/EllipticCurve.h>
 #include <Weave/Support/crypto/HashAlgos.h>
+#include <Weave/Support/crypto/HMAC.h>
 
 /**
  *   @namespace nl::Weave::Profiles::Security::CASE
@@ -60,6 +61,7 @@ using nl::Weave::Platform::Security::SHA256;
 using nl::Weave::Crypto::EncodedECPublicKey;
 using nl::Weave::Crypto::EncodedECPrivateKey;
 using nl::Weave::Crypto::EncodedECDSASignature;
+using nl::Weave::Crypto::HMACSHA256;
 
 class WeaveCASEEngine;
 
@@ -113,6 +115,24 @@ enum
     kCASEHeader_KeyConfirmHashLengthMask        = 0xC0
 };
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+// CASE Session Resumption Message Field Definitions
+enum
+{
+    kCASEResumption_RandomLength                = 16,
+    kCASEResumption_MACLength                   = HMACSHA256::kDigestLength,
+
+    // Control Header (1), Session Key Id (2), Resumption Id, Initiator Random, MAC
+    kCASEResumeSessionRequestLength             = 3 + WeaveCASEResumptionTicket::kResumptionIdLength +
+                                                  kCASEResumption_RandomLength + kCASEResumption_MACLength,
+
+    // Responder Random, MAC
+    kCASEResumeSessionResponseLength            = kCASEResumption_RandomLength + kCASEResumption_MACLength
+};
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 
 /**
  * Holds context information related to the generation or processing of a CASE begin session messages.
@@ -404,7 +424,9 @@ public:
         kState_BeginRequestProcessed            = 3,
         kState_BeginResponseGenerated           = 4,
         kState_Complete                         = 5,
-        kState_Failed                           = 6
+        kState_Failed                           = 6,
+        kState_ResumeRequestGenerated           = 7,
+        kState_ResumeRequestProcessed           = 8
     };
 
     WeaveCASEAuthDelegate *AuthDelegate;                // Authentication delegate object
@@ -437,6 +459,21 @@ public:
 
     WEAVE_ERROR GetSessionKey(const WeaveEncryptionKey *& encKey);
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    WEAVE_ERROR GenerateResumeSessionRequest(const WeaveCASEResumptionTicket & ticket, uint16_t sessionKeyId, uint8_t encType,
+                                             PacketBuffer * msgBuf);
+
+    WEAVE_ERROR ProcessResumeSessionRequest(PacketBuffer * msgBuf, const WeaveCASEResumptionTicket & ticket);
+
+    WEAVE_ERROR GenerateResumeSessionResponse(PacketBuffer * msgBuf);
+
+    WEAVE_ERROR ProcessResumeSessionResponse(PacketBuffer * msgBuf);
+
+    void AbandonResumption(void);
+
+    WEAVE_ERROR GetResumptionTicket(WeaveCASEResumptionTicket & ticket);
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
     bool IsInitiator() const;
     uint32_t SelectedConfig() const;
     uint32_t SelectedCurve() const;
@@ -461,6 +498,11 @@ public:
     void SetUseKnownECDHKey(bool val);
 #endif
 
+#if WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+    static void PregenerateECDHKey(System::Layer & systemLayer, uint32_t curveId);
+    static void ClearPregeneratedECDHKey(void);
+#endif
+
 private:
     enum
     {
@@ -496,7 +538,19 @@ private:
         {
             WeaveEncryptionKey EncryptionKey;
             uint8_t InitiatorKeyConfirmHash[kMaxHashLength];
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+            uint8_t ResumptionId[WeaveCASEResumptionTicket::kResumptionIdLength];
+            uint8_t ResumptionSecret[WeaveCASEResumptionTicket::kResumptionSecretLength];
+#endif
         } AfterKeyGen;
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+        struct
+        {
+            uint8_t ResumptionSecret[WeaveCASEResumptionTicket::kResumptionSecretLength];
+            uint8_t InitiatorRandom[kCASEResumption_RandomLength];
+            uint8_t RequestMAC[kCASEResumption_MACLength];
+        } BeforeResumeKeyGen;
+#endif
     } mSecureState;
     uint32_t mCurveId;
     uint8_t mAllowedCurves;
@@ -522,6 +576,10 @@ private:
     static WEAVE_ERROR DecodeCertificateInfo(BeginSessionContext & msgCtx, WeaveCertificateSet & certSet,
             WeaveDN & entityCertDN, CertificateKeyId & entityCertSubjectKeyId);
     WEAVE_ERROR DeriveSessionKeys(EncodedECPublicKey & pubKey, const uint8_t * respMsgHash, uint8_t * responderKeyConfirmHash);
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+    WEAVE_ERROR DeriveResumedSessionKeys(const uint8_t * responderRandom);
+    void GenerateResumptionMAC(const uint8_t * inData, uint16_t inDataLen, const uint8_t * responderRandom, uint8_t * mac);
+#endif
     void GenerateHash(const uint8_t * inData, uint16_t inDataLen, uint8_t * hash);
     void GenerateKeyConfirmHashes(const uint8_t * keyConfirmKey, uint8_t * singleHash, uint8_t * doubleHash);
 };
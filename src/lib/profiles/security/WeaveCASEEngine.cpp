@@ -43,6 +43,7 @@
 #include <Weave/Support/crypto/EllipticCurve.h>
 #include <Weave/Support/CodeUtils.h>
 #include <Weave/Support/WeaveFaultInjection.h>
+#include <SystemLayer/SystemTrace.h>
 
 
 namespace nl {
@@ -57,6 +58,116 @@ using namespace nl::Weave::TLV;
 using namespace nl::Weave::ASN1;
 
 #undef CASE_PRINT_CRYPTO_DATA
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+// HKDF info labels that separate the keys derived for resumption from the session keys.
+static const uint8_t sResumptionTicketInfo[] = { 'C', 'A', 'S', 'E', ' ', 'T', 'i', 'c', 'k', 'e', 't' };
+static const uint8_t sResumedSessionKeyInfo[] = { 'C', 'A', 'S', 'E', ' ', 'R', 'e', 's', 'u', 'm', 'e' };
+#endif
+
+#if WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+
+// An ephemeral ECDH key generated in advance, by an asynchronous operation, for the next CASE session.
+static struct
+{
+    AsyncECOperation Op;
+    uint32_t CurveId;
+    uint8_t State;
+    uint8_t PubKey[EncodedECPublicKey::kMaxValueLength];
+    uint8_t PrivKey[EncodedECPrivateKey::kMaxValueLength];
+} sPregeneratedECDHKey;
+
+enum
+{
+    kPregeneratedKeyState_None          = 0,
+    kPregeneratedKeyState_Generating    = 1,
+    kPregeneratedKeyState_Ready         = 2,
+    kPregeneratedKeyState_Discarding    = 3    // Generating, but to be discarded on completion.
+};
+
+static void ClearPregeneratedKeyData(void)
+{
+    ClearSecretData(sPregeneratedECDHKey.PrivKey, sizeof(sPregeneratedECDHKey.PrivKey));
+    sPregeneratedECDHKey.State = kPregeneratedKeyState_None;
+}
+
+static void HandleECDHKeyPregenerated(AsyncECOperation *op)
+{
+    if (op->Result == WEAVE_NO_ERROR && sPregeneratedECDHKey.State == kPregeneratedKeyState_Generating)
+        sPregeneratedECDHKey.State = kPregeneratedKeyState_Ready;
+    else
+        ClearPregeneratedKeyData();
+}
+
+// Hand the pregenerated key, if there is one for the given curve, over to the caller. Each key is used only once.
+static bool TakePregeneratedECDHKey(uint32_t curveId, EncodedECPublicKey & pubKey, EncodedECPrivateKey & privKey)
+{
+    const AsyncECOperation & op = sPregeneratedECDHKey.Op;
+
+    if (sPregeneratedECDHKey.State != kPregeneratedKeyState_Ready || sPregeneratedECDHKey.CurveId != curveId ||
+        op.PubKey.ECPointLen > pubKey.ECPointLen || op.PrivKey.PrivKeyLen > privKey.PrivKeyLen)
+        return false;
+
+    memcpy(pubKey.ECPoint, op.PubKey.ECPoint, op.PubKey.ECPointLen);
+    pubKey.ECPointLen = op.PubKey.ECPointLen;
+    memcpy(privKey.PrivKey, op.PrivKey.PrivKey, op.PrivKey.PrivKeyLen);
+    privKey.PrivKeyLen = op.PrivKey.PrivKeyLen;
+
+    ClearPregeneratedKeyData();
+
+    return true;
+}
+
+/**
+ * Start generating, off the processing of CASE messages, the ephemeral ECDH key for the next CASE session.
+ *
+ * The key is used by the next session, on either side, that uses the given curve; other sessions generate
+ * their keys synchronously, as usual.
+ *
+ * @param[in] systemLayer   The system layer on which the completion of the key generation is reported.
+ * @param[in] curveId       The Weave id of the elliptic curve of the key.
+ */
+void WeaveCASEEngine::PregenerateECDHKey(System::Layer & systemLayer, uint32_t curveId)
+{
+    AsyncECOperation & op = sPregeneratedECDHKey.Op;
+
+    // Only one key is generated at a time, and a ready key for the same curve is kept.
+    if (sPregeneratedECDHKey.State == kPregeneratedKeyState_Generating ||
+        sPregeneratedECDHKey.State == kPregeneratedKeyState_Discarding)
+        return;
+    if (sPregeneratedECDHKey.State == kPregeneratedKeyState_Ready && sPregeneratedECDHKey.CurveId == curveId)
+        return;
+
+    ClearPregeneratedKeyData();
+
+    op.Reset();
+    op.Type = AsyncECOperation::kOperation_GenerateECDHKey;
+    op.CurveOID = WeaveCurveIdToOID(curveId);
+    op.PubKey.ECPoint = sPregeneratedECDHKey.PubKey;
+    op.PubKey.ECPointLen = sizeof(sPregeneratedECDHKey.PubKey);
+    op.PrivKey.PrivKey = sPregeneratedECDHKey.PrivKey;
+    op.PrivKey.PrivKeyLen = sizeof(sPregeneratedECDHKey.PrivKey);
+    op.OnComplete = HandleECDHKeyPregenerated;
+
+    sPregeneratedECDHKey.CurveId = curveId;
+    sPregeneratedECDHKey.State = kPregeneratedKeyState_Generating;
+
+    if (StartAsyncECOperation(systemLayer, op) != WEAVE_NO_ERROR)
+        ClearPregeneratedKeyData();
+}
+
+/**
+ * Discard the pregenerated ephemeral ECDH key, if any.
+ */
+void WeaveCASEEngine::ClearPregeneratedECDHKey(void)
+{
+    if (sPregeneratedECDHKey.State == kPregeneratedKeyState_Generating)
+        sPregeneratedECDHKey.State = kPregeneratedKeyState_Discarding;
+    else if (sPregeneratedECDHKey.State != kPregeneratedKeyState_Discarding)
+        ClearPregeneratedKeyData();
+}
+
+#endif // WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+
 #ifdef CASE_PRINT_CRYPTO_DATA
 static void PrintHex(const uint8_t *data, uint16_t len)
 {
@@ -119,6 +230,8 @@ void WeaveCASEEngine::SetAlternateCurves(BeginSessionRequestContext & reqCtx)
 
 WEAVE_ERROR WeaveCASEEngine::GenerateBeginSessionRequest(BeginSessionRequestContext & reqCtx, PacketBuffer * msgBuf)
 {
+    SYSTEM_TRACE_SCOPE("CASE", "WeaveCASEEngine::GenerateBeginSessionRequest");
+
     WEAVE_ERROR err;
 
     // Verify there isn't a begin session already outstanding.
@@ -147,7 +260,7 @@ WEAVE_ERROR WeaveCASEEngine::GenerateBeginSessionRequest(BeginSessionRequestCont
     VerifyOrExit(WeaveKeyId::IsSessionKey(reqCtx.SessionKeyId), err = WEAVE_ERROR_WRONG_KEY_TYPE);
 
     // Verify the requested encryption type.
-    VerifyOrExit(reqCtx.EncryptionType == kWeaveEncryptionType_AES128CTRSHA1,
+    VerifyOrExit(WeaveEncryptionKeySize(reqCtx.EncryptionType) != 0,
             err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
 
     // Record that we are acting as the initiator.
@@ -196,6 +309,8 @@ exit:
 
 WEAVE_ERROR WeaveCASEEngine::ProcessBeginSessionRequest(PacketBuffer * msgBuf, BeginSessionRequestContext & reqCtx, ReconfigureContext & reconfCtx)
 {
+    SYSTEM_TRACE_SCOPE("CASE", "WeaveCASEEngine::ProcessBeginSessionRequest");
+
     WEAVE_ERROR err;
     bool reconfigRequired = false;
 
@@ -245,7 +360,7 @@ WEAVE_ERROR WeaveCASEEngine::ProcessBeginSessionRequest(PacketBuffer * msgBuf, B
     VerifyOrExit(WeaveKeyId::IsSessionKey(reqCtx.SessionKeyId), err = WEAVE_ERROR_WRONG_KEY_TYPE);
 
     // Verify the requested encryption type.
-    VerifyOrExit(reqCtx.EncryptionType == kWeaveEncryptionType_AES128CTRSHA1,
+    VerifyOrExit(WeaveEncryptionKeySize(reqCtx.EncryptionType) != 0,
                  err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
 
     State = kState_BeginRequestProcessed;
@@ -259,6 +374,8 @@ exit:
 WEAVE_ERROR WeaveCASEEngine::GenerateBeginSessionResponse(BeginSessionResponseContext & respCtx, PacketBuffer * msgBuf,
                                                           BeginSessionRequestContext & reqCtx)
 {
+    SYSTEM_TRACE_SCOPE("CASE", "WeaveCASEEngine::GenerateBeginSessionResponse");
+
     WEAVE_ERROR err;
     uint8_t respMsgHash[kMaxHashLength];
 
@@ -339,6 +456,8 @@ exit:
 
 WEAVE_ERROR WeaveCASEEngine::ProcessBeginSessionResponse(PacketBuffer * msgBuf, BeginSessionResponseContext & respCtx)
 {
+    SYSTEM_TRACE_SCOPE("CASE", "WeaveCASEEngine::ProcessBeginSessionResponse");
+
     WEAVE_ERROR err;
     uint8_t respMsgHash[kMaxHashLength];
 
@@ -399,6 +518,8 @@ exit:
 
 WEAVE_ERROR WeaveCASEEngine::GenerateInitiatorKeyConfirm(PacketBuffer * msgBuf)
 {
+    SYSTEM_TRACE_SCOPE("CASE", "WeaveCASEEngine::GenerateInitiatorKeyConfirm");
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     uint8_t keyConfirmHashLen = ConfigHashLength();
 
@@ -419,6 +540,8 @@ exit:
 
 WEAVE_ERROR WeaveCASEEngine::ProcessInitiatorKeyConfirm(PacketBuffer * msgBuf)
 {
+    SYSTEM_TRACE_SCOPE("CASE", "WeaveCASEEngine::ProcessInitiatorKeyConfirm");
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     uint8_t expectedKeyConfirmHashLen = ConfigHashLength();
 
@@ -479,6 +602,229 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+/**
+ * Generate a CASE ResumeSessionRequest message from a resumption ticket shared with the peer.
+ *
+ * The message consists of a control header carrying the proposed encryption type, the proposed
+ * session key id, the resumption id of the ticket, a fresh random value and a MAC, computed with
+ * the resumption secret, over the preceding fields.
+ *
+ * @param[in] ticket            The resumption ticket for the peer.
+ * @param[in] sessionKeyId      The proposed session key id.
+ * @param[in] encType           The proposed encryption type.
+ * @param[in] msgBuf            The buffer into which the message is encoded.
+ *
+ * @retval #WEAVE_NO_ERROR      On success.
+ */
+WEAVE_ERROR WeaveCASEEngine::GenerateResumeSessionRequest(const WeaveCASEResumptionTicket & ticket, uint16_t sessionKeyId,
+                                                         uint8_t encType, PacketBuffer * msgBuf)
+{
+    WEAVE_ERROR err;
+    uint8_t * p = msgBuf->Start();
+    uint8_t * initiatorRandom;
+
+    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(msgBuf->AvailableDataLength() >= kCASEResumeSessionRequestLength, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    WeaveLogDetail(SecurityManager, "CASE:GenerateResumeSessionRequest");
+
+    SetIsInitiator(true);
+    EncryptionType = encType;
+    SessionKeyId = sessionKeyId;
+    mCertType = ticket.CertType;
+
+    memcpy(mSecureState.BeforeResumeKeyGen.ResumptionSecret, ticket.ResumptionSecret, sizeof(ticket.ResumptionSecret));
+
+    *p++ = encType & kCASEHeader_EncryptionTypeMask;
+    LittleEndian::Write16(p, sessionKeyId);
+    memcpy(p, ticket.ResumptionId, sizeof(ticket.ResumptionId));
+    p += sizeof(ticket.ResumptionId);
+
+    initiatorRandom = p;
+    err = Platform::Security::GetSecureRandomData(initiatorRandom, kCASEResumption_RandomLength);
+    SuccessOrExit(err);
+    memcpy(mSecureState.BeforeResumeKeyGen.InitiatorRandom, initiatorRandom, kCASEResumption_RandomLength);
+    p += kCASEResumption_RandomLength;
+
+    GenerateResumptionMAC(msgBuf->Start(), p - msgBuf->Start(), NULL, mSecureState.BeforeResumeKeyGen.RequestMAC);
+    memcpy(p, mSecureState.BeforeResumeKeyGen.RequestMAC, kCASEResumption_MACLength);
+    p += kCASEResumption_MACLength;
+
+    msgBuf->SetDataLength(p - msgBuf->Start());
+
+    State = kState_ResumeRequestGenerated;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        State = kState_Failed;
+    return err;
+}
+
+/**
+ * Process a CASE ResumeSessionRequest message against the resumption ticket held for the peer.
+ *
+ * @param[in] msgBuf            The buffer containing the message.
+ * @param[in] ticket            The resumption ticket held for the peer.
+ *
+ * @retval #WEAVE_NO_ERROR      On success.
+ * @retval #WEAVE_ERROR_CASE_RESUMPTION_TICKET_NOT_FOUND
+ *                              If the message names a different ticket.
+ * @retval #WEAVE_ERROR_INVALID_SIGNATURE
+ *                              If the MAC in the message is incorrect.
+ */
+WEAVE_ERROR WeaveCASEEngine::ProcessResumeSessionRequest(PacketBuffer * msgBuf, const WeaveCASEResumptionTicket & ticket)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const uint8_t * p = msgBuf->Start();
+    uint8_t controlHeader;
+
+    VerifyOrExit(State == kState_Idle, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(msgBuf->DataLength() == kCASEResumeSessionRequestLength, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+    WeaveLogDetail(SecurityManager, "CASE:ProcessResumeSessionRequest");
+
+    SetIsInitiator(false);
+
+    controlHeader = *p++;
+    VerifyOrExit((controlHeader & ~kCASEHeader_EncryptionTypeMask) == 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    EncryptionType = controlHeader & kCASEHeader_EncryptionTypeMask;
+    SessionKeyId = LittleEndian::Read16(p);
+
+    VerifyOrExit(ConstantTimeCompare(p, ticket.ResumptionId, sizeof(ticket.ResumptionId)),
+                 err = WEAVE_ERROR_CASE_RESUMPTION_TICKET_NOT_FOUND);
+    p += sizeof(ticket.ResumptionId);
+
+    memcpy(mSecureState.BeforeResumeKeyGen.ResumptionSecret, ticket.ResumptionSecret, sizeof(ticket.ResumptionSecret));
+    memcpy(mSecureState.BeforeResumeKeyGen.InitiatorRandom, p, kCASEResumption_RandomLength);
+    p += kCASEResumption_RandomLength;
+
+    GenerateResumptionMAC(msgBuf->Start(), p - msgBuf->Start(), NULL, mSecureState.BeforeResumeKeyGen.RequestMAC);
+    VerifyOrExit(ConstantTimeCompare(p, mSecureState.BeforeResumeKeyGen.RequestMAC, kCASEResumption_MACLength),
+                 err = WEAVE_ERROR_INVALID_SIGNATURE);
+
+    mCertType = ticket.CertType;
+
+    State = kState_ResumeRequestProcessed;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        State = kState_Failed;
+    return err;
+}
+
+/**
+ * Generate a CASE ResumeSessionResponse message and derive the keys for the resumed session.
+ *
+ * The message consists of a fresh random value and a MAC, computed with the resumption secret,
+ * over the MAC of the request and the random value.
+ *
+ * @param[in] msgBuf            The buffer into which the message is encoded.
+ *
+ * @retval #WEAVE_NO_ERROR      On success.
+ */
+WEAVE_ERROR WeaveCASEEngine::GenerateResumeSessionResponse(PacketBuffer * msgBuf)
+{
+    WEAVE_ERROR err;
+    uint8_t * responderRandom = msgBuf->Start();
+
+    VerifyOrExit(State == kState_ResumeRequestProcessed, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(msgBuf->AvailableDataLength() >= kCASEResumeSessionResponseLength, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    WeaveLogDetail(SecurityManager, "CASE:GenerateResumeSessionResponse");
+
+    err = Platform::Security::GetSecureRandomData(responderRandom, kCASEResumption_RandomLength);
+    SuccessOrExit(err);
+
+    GenerateResumptionMAC(mSecureState.BeforeResumeKeyGen.RequestMAC, kCASEResumption_MACLength, responderRandom,
+                          responderRandom + kCASEResumption_RandomLength);
+
+    msgBuf->SetDataLength(kCASEResumeSessionResponseLength);
+
+    err = DeriveResumedSessionKeys(responderRandom);
+    SuccessOrExit(err);
+
+    State = kState_Complete;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        State = kState_Failed;
+    return err;
+}
+
+/**
+ * Process a CASE ResumeSessionResponse message and derive the keys for the resumed session.
+ *
+ * @param[in] msgBuf            The buffer containing the message.
+ *
+ * @retval #WEAVE_NO_ERROR      On success.
+ * @retval #WEAVE_ERROR_INVALID_SIGNATURE
+ *                              If the MAC in the message is incorrect.
+ */
+WEAVE_ERROR WeaveCASEEngine::ProcessResumeSessionResponse(PacketBuffer * msgBuf)
+{
+    WEAVE_ERROR err;
+    const uint8_t * responderRandom = msgBuf->Start();
+    uint8_t expectedMAC[kCASEResumption_MACLength];
+
+    VerifyOrExit(State == kState_ResumeRequestGenerated, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(msgBuf->DataLength() == kCASEResumeSessionResponseLength, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+    WeaveLogDetail(SecurityManager, "CASE:ProcessResumeSessionResponse");
+
+    GenerateResumptionMAC(mSecureState.BeforeResumeKeyGen.RequestMAC, kCASEResumption_MACLength, responderRandom, expectedMAC);
+    VerifyOrExit(ConstantTimeCompare(responderRandom + kCASEResumption_RandomLength, expectedMAC, kCASEResumption_MACLength),
+                 err = WEAVE_ERROR_INVALID_SIGNATURE);
+
+    err = DeriveResumedSessionKeys(responderRandom);
+    SuccessOrExit(err);
+
+    State = kState_Complete;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+        State = kState_Failed;
+    return err;
+}
+
+/**
+ * Abandon a resumption attempt that the peer has rejected, so that the engine can be used for a full
+ * CASE exchange.
+ */
+void WeaveCASEEngine::AbandonResumption(void)
+{
+    ClearSecretData((uint8_t *)&mSecureState, sizeof(mSecureState));
+    State = kState_Idle;
+}
+
+/**
+ * Get the resumption ticket derived for the session that has been established.
+ *
+ * Only the resumption id, resumption secret and certificate type of the ticket are set.
+ *
+ * @param[out] ticket           The ticket to be filled in.
+ *
+ * @retval #WEAVE_NO_ERROR      On success.
+ * @retval #WEAVE_ERROR_INCORRECT_STATE
+ *                              If the session has not been established.
+ */
+WEAVE_ERROR WeaveCASEEngine::GetResumptionTicket(WeaveCASEResumptionTicket & ticket)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(State == kState_Complete, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    memcpy(ticket.ResumptionId, mSecureState.AfterKeyGen.ResumptionId, sizeof(ticket.ResumptionId));
+    memcpy(ticket.ResumptionSecret, mSecureState.AfterKeyGen.ResumptionSecret, sizeof(ticket.ResumptionSecret));
+    ticket.CertType = mCertType;
+
+exit:
+    return err;
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 WEAVE_ERROR WeaveCASEEngine::VerifyProposedConfig(BeginSessionRequestContext & reqCtx, uint32_t & selectedAltConfig)
 {
     WEAVE_ERROR err = WEAVE_ERROR_UNSUPPORTED_CASE_CONFIGURATION;
@@ -557,6 +903,11 @@ WEAVE_ERROR WeaveCASEEngine::AppendNewECDHKey(BeginSessionContext & msgCtx, Pack
     msgCtx.ECDHPublicKey.ECPointLen = msgBuf->AvailableDataLength(); // GenerateECDHKey() will update with final length.
     privKey.PrivKey = mSecureState.BeforeKeyGen.ECDHPrivateKey;
     privKey.PrivKeyLen = sizeof(mSecureState.BeforeKeyGen.ECDHPrivateKey);
+#if WEAVE_CONFIG_CASE_PREGENERATE_ECDH_KEY
+    if (TakePregeneratedECDHKey(msgCtx.CurveId, msgCtx.ECDHPublicKey, privKey))
+        err = WEAVE_NO_ERROR;
+    else
+#endif
     err = GenerateECDHKey(WeaveCurveIdToOID(msgCtx.CurveId), msgCtx.ECDHPublicKey, privKey);
     SuccessOrExit(err);
 
@@ -649,6 +1000,8 @@ exit:
 // Generate a signature for an encoded CASE message (in the supplied buffer) and append it to the message.
 WEAVE_ERROR WeaveCASEEngine::AppendSignature(BeginSessionContext & msgCtx, PacketBuffer * msgBuf, uint8_t * msgHash)
 {
+    SYSTEM_TRACE_SCOPE("CASE", "WeaveCASEEngine::AppendSignature");
+
     WEAVE_ERROR err;
     uint8_t * msgStart = msgBuf->Start();
     uint16_t tbsDataLen = msgBuf->DataLength();
@@ -687,6 +1040,8 @@ exit:
 // Returns a hash of the signed portion of the message in the supplied bufer.
 WEAVE_ERROR WeaveCASEEngine::VerifySignature(BeginSessionContext & msgCtx, PacketBuffer * msgBuf, uint8_t * msgHash)
 {
+    SYSTEM_TRACE_SCOPE("CASE", "WeaveCASEEngine::VerifySignature");
+
     WEAVE_ERROR err, validRes;
     WeaveCertificateSet certSet;
     ValidationContext validCtx;
@@ -871,6 +1226,7 @@ WEAVE_ERROR WeaveCASEEngine::DeriveSessionKeys(EncodedECPublicKey & pubKey, cons
 {
     WEAVE_ERROR err;
     uint8_t hashLen = ConfigHashLength();
+    uint16_t encKeyLen = WeaveEncryptionKeySize(EncryptionType);
 #if WEAVE_CONFIG_SUPPORT_CASE_CONFIG1
     HKDFSHA1Or256 hkdf(IsUsingConfig1());
 #else
@@ -879,8 +1235,7 @@ WEAVE_ERROR WeaveCASEEngine::DeriveSessionKeys(EncodedECPublicKey & pubKey, cons
 
     WeaveLogDetail(SecurityManager, "CASE:DeriveSessionKeys");
 
-    // Only AES128CTRSHA1 keys supported for now.
-    VerifyOrExit(EncryptionType == kWeaveEncryptionType_AES128CTRSHA1, err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+    VerifyOrExit(encKeyLen != 0, err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
 
     // Prepare a salt value to be used in the generation of the master key. The salt value
     // is composed from the hashes of the signed portions of the CASE request and response
@@ -933,27 +1288,40 @@ WEAVE_ERROR WeaveCASEEngine::DeriveSessionKeys(EncodedECPublicKey & pubKey, cons
         uint16_t keyLen;
 
         // If performing key confirmation, arrange to generate enough key data for the session
-        // keys (data encryption and integrity) as well as a key to be used in key confirmation.
+        // keys (data encryption and, where used, integrity) as well as a key to be used in key confirmation.
+        // (AES128CTRSHA1 has the largest key size of the supported encryption types.)
         if (PerformingKeyConfirm())
-            keyLen = WeaveEncryptionKey_AES128CTRSHA1::KeySize + hashLen;
+            keyLen = encKeyLen + hashLen;
         else
-            keyLen = WeaveEncryptionKey_AES128CTRSHA1::KeySize;
+            keyLen = encKeyLen;
 
         // Perform HKDF-based key expansion to produce the desired key data.
         err = hkdf.ExpandKey(NULL, 0, keyLen, sessionKeyData);
         SuccessOrExit(err);
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+        // Derive the resumption id and secret of the ticket from which a later session can be resumed.
+        {
+            uint8_t ticketData[WeaveCASEResumptionTicket::kResumptionIdLength + WeaveCASEResumptionTicket::kResumptionSecretLength];
+
+            err = hkdf.ExpandKey(sResumptionTicketInfo, sizeof(sResumptionTicketInfo), sizeof(ticketData), ticketData);
+            if (err == WEAVE_NO_ERROR)
+            {
+                memcpy(mSecureState.AfterKeyGen.ResumptionId, ticketData, WeaveCASEResumptionTicket::kResumptionIdLength);
+                memcpy(mSecureState.AfterKeyGen.ResumptionSecret, ticketData + WeaveCASEResumptionTicket::kResumptionIdLength,
+                       WeaveCASEResumptionTicket::kResumptionSecretLength);
+            }
+            ClearSecretData(ticketData, sizeof(ticketData));
+            SuccessOrExit(err);
+        }
+#endif
+
 #ifdef CASE_PRINT_CRYPTO_DATA
         printf("Session Key Data: "); PrintHex(sessionKeyData, keyLen); printf("\n");
 #endif
 
         // Copy the generated key data to the appropriate destinations.
-        memcpy(mSecureState.AfterKeyGen.EncryptionKey.AES128CTRSHA1.DataKey,
-               sessionKeyData,
-               WeaveEncryptionKey_AES128CTRSHA1::DataKeySize);
-        memcpy(mSecureState.AfterKeyGen.EncryptionKey.AES128CTRSHA1.IntegrityKey,
-               sessionKeyData + WeaveEncryptionKey_AES128CTRSHA1::DataKeySize,
-               WeaveEncryptionKey_AES128CTRSHA1::IntegrityKeySize);
+        WeaveEncryptionKeyFromBytes(EncryptionType, sessionKeyData, mSecureState.AfterKeyGen.EncryptionKey);
 
         // If performing key confirmation...
         if (PerformingKeyConfirm())
@@ -961,7 +1329,7 @@ WEAVE_ERROR WeaveCASEEngine::DeriveSessionKeys(EncodedECPublicKey & pubKey, cons
             // Use the key confirmation key to generate key confirmation hashes. Store the initiator hash
             // (the single hash) in state data for later use.  Return the responder hash (the double hash)
             // to the caller.
-            uint8_t *keyConfirmKey = sessionKeyData + WeaveEncryptionKey_AES128CTRSHA1::KeySize;
+            uint8_t *keyConfirmKey = sessionKeyData + encKeyLen;
             GenerateKeyConfirmHashes(keyConfirmKey, mSecureState.AfterKeyGen.InitiatorKeyConfirmHash,
                                      responderKeyConfirmHash);
         }
@@ -973,6 +1341,67 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
+WEAVE_ERROR WeaveCASEEngine::DeriveResumedSessionKeys(const uint8_t * responderRandom)
+{
+    WEAVE_ERROR err;
+    uint16_t encKeyLen = WeaveEncryptionKeySize(EncryptionType);
+    HKDFSHA256 hkdf;
+    uint8_t sessionKeyData[WeaveEncryptionKey_AES128CTRSHA1::KeySize];
+    uint8_t ticketData[WeaveCASEResumptionTicket::kResumptionIdLength + WeaveCASEResumptionTicket::kResumptionSecretLength];
+
+    WeaveLogDetail(SecurityManager, "CASE:DeriveResumedSessionKeys");
+
+    VerifyOrExit(encKeyLen != 0, err = WEAVE_ERROR_UNSUPPORTED_ENCRYPTION_TYPE);
+
+    // Extract a master key from the resumption secret, salted with the random values contributed
+    // by both parties, so that every resumed session has fresh keys.
+    {
+        uint8_t keySalt[2 * kCASEResumption_RandomLength];
+
+        memcpy(keySalt, mSecureState.BeforeResumeKeyGen.InitiatorRandom, kCASEResumption_RandomLength);
+        memcpy(keySalt + kCASEResumption_RandomLength, responderRandom, kCASEResumption_RandomLength);
+
+        hkdf.BeginExtractKey(keySalt, sizeof(keySalt));
+        hkdf.AddKeyMaterial(mSecureState.BeforeResumeKeyGen.ResumptionSecret, WeaveCASEResumptionTicket::kResumptionSecretLength);
+        err = hkdf.FinishExtractKey();
+        SuccessOrExit(err);
+    }
+
+    // Derive the session keys, and the replacement ticket, from the master key.
+    err = hkdf.ExpandKey(sResumedSessionKeyInfo, sizeof(sResumedSessionKeyInfo), encKeyLen, sessionKeyData);
+    SuccessOrExit(err);
+    err = hkdf.ExpandKey(sResumptionTicketInfo, sizeof(sResumptionTicketInfo), sizeof(ticketData), ticketData);
+    SuccessOrExit(err);
+
+    // The resumption state is no longer needed, and is overwritten by the derived keys.
+    ClearSecretData((uint8_t *)&mSecureState, sizeof(mSecureState));
+    WeaveEncryptionKeyFromBytes(EncryptionType, sessionKeyData, mSecureState.AfterKeyGen.EncryptionKey);
+    memcpy(mSecureState.AfterKeyGen.ResumptionId, ticketData, WeaveCASEResumptionTicket::kResumptionIdLength);
+    memcpy(mSecureState.AfterKeyGen.ResumptionSecret, ticketData + WeaveCASEResumptionTicket::kResumptionIdLength,
+           WeaveCASEResumptionTicket::kResumptionSecretLength);
+
+exit:
+    ClearSecretData(sessionKeyData, sizeof(sessionKeyData));
+    ClearSecretData(ticketData, sizeof(ticketData));
+    return err;
+}
+
+void WeaveCASEEngine::GenerateResumptionMAC(const uint8_t * inData, uint16_t inDataLen, const uint8_t * responderRandom,
+                                            uint8_t * mac)
+{
+    HMACSHA256 hmac;
+
+    hmac.Begin(mSecureState.BeforeResumeKeyGen.ResumptionSecret, WeaveCASEResumptionTicket::kResumptionSecretLength);
+    hmac.AddData(inData, inDataLen);
+    if (responderRandom != NULL)
+        hmac.AddData(responderRandom, kCASEResumption_RandomLength);
+    hmac.Finish(mac);
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CASE_RESUMPTION
+
 void WeaveCASEEngine::GenerateHash(const uint8_t * inData, uint16_t inDataLen, uint8_t * hash)
 {
     if (IsUsingConfig1())
@@ -51,6 +51,66 @@ using namespace nl::Weave::Crypto;
 
 extern WEAVE_ERROR DecodeConvertTBSCert(TLVReader& reader, ASN1Writer& writer, WeaveCertificateData& certData);
 
+#if WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE > 0
+
+// Cache of CA certificates whose signatures have been verified.  Each entry is a digest over the subject key id
+// and TBS hash of a certificate and the public key of the CA certificate that verified its signature.  Since the
+// TBS hash covers the entire signed content of the certificate, a certificate matching an entry is known to have
+// been signed by the same key, without repeating the signature verification.
+static uint8_t sCertValidationCache[WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE][Platform::Security::SHA256::kHashLength];
+static uint8_t sCertValidationCacheCount;
+static uint8_t sCertValidationCacheNext;
+
+static void ComputeCertValidationCacheKey(const WeaveCertificateData& cert, uint8_t hashLen, const WeaveCertificateData& caCert,
+                                          uint8_t *key)
+{
+    Platform::Security::SHA256 sha256;
+    uint8_t curveId[4];
+    uint8_t *p = curveId;
+
+    nl::Weave::Encoding::LittleEndian::Write32(p, caCert.PubKeyCurveId);
+
+    sha256.Begin();
+    sha256.AddData(cert.SubjectKeyId.Id, cert.SubjectKeyId.Len);
+    sha256.AddData(cert.TBSHash, hashLen);
+    sha256.AddData(curveId, sizeof(curveId));
+    sha256.AddData(caCert.PublicKey.EC.ECPoint, caCert.PublicKey.EC.ECPointLen);
+    sha256.Finish(key);
+}
+
+static bool IsInCertValidationCache(const uint8_t *key)
+{
+    for (uint8_t i = 0; i < sCertValidationCacheCount; i++)
+        if (memcmp(sCertValidationCache[i], key, Platform::Security::SHA256::kHashLength) == 0)
+            return true;
+    return false;
+}
+
+static void AddToCertValidationCache(const uint8_t *key)
+{
+    memcpy(sCertValidationCache[sCertValidationCacheNext], key, Platform::Security::SHA256::kHashLength);
+    sCertValidationCacheNext = (sCertValidationCacheNext + 1) % WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE;
+    if (sCertValidationCacheCount < WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE)
+        sCertValidationCacheCount++;
+}
+
+#endif // WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE > 0
+
+/**
+ * Forget all CA certificates whose signatures have been verified by certificate validation.
+ *
+ * Applications should call this function whenever their trusted certificates change, e.g. when a
+ * trusted root is revoked.
+ */
+void ClearCertValidationCache(void)
+{
+#if WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE > 0
+    memset(sCertValidationCache, 0, sizeof(sCertValidationCache));
+    sCertValidationCacheCount = 0;
+    sCertValidationCacheNext = 0;
+#endif
+}
+
 #if HAVE_MALLOC && HAVE_FREE
 static void *DefaultAlloc(size_t size)
 {
@@ -132,6 +192,21 @@ void WeaveCertificateSet::Clear()
     CertCount = 0;
 }
 
+/**
+ * Remove all but the first certCount certificates from the set.
+ *
+ * This allows a set of CA certificates to be loaded once and then used to validate a series
+ * of certificates, each of which is loaded after the CA certificates and removed once validated.
+ */
+void WeaveCertificateSet::Truncate(uint8_t certCount)
+{
+    if (certCount < CertCount)
+    {
+        memset(&Certs[certCount], 0, sizeof(WeaveCertificateData) * (CertCount - certCount));
+        CertCount = certCount;
+    }
+}
+
 WeaveCertificateData *WeaveCertificateSet::FindCert(const CertificateKeyId& subjectKeyId) const
 {
     for (uint8_t i = 0; i < CertCount; i++)
@@ -481,6 +556,9 @@ WEAVE_ERROR WeaveCertificateSet::ValidateCert(WeaveCertificateData& cert, Valida
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     WeaveCertificateData *caCert = NULL;
     uint8_t hashLen;
+#if WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE > 0
+    uint8_t cacheKey[Platform::Security::SHA256::kHashLength];
+#endif
     enum { kLastSecondOfDay = kSecondsPerDay - 1 };
 
     // If the depth is greater than 0 then the certificate is required to be a CA certificate...
@@ -580,9 +658,26 @@ WEAVE_ERROR WeaveCertificateSet::ValidateCert(WeaveCertificateData& cert, Valida
     hashLen = (cert.SigAlgoOID == kOID_SigAlgo_ECDSAWithSHA256)
               ? (uint8_t)Platform::Security::SHA256::kHashLength
               : (uint8_t)Platform::Security::SHA1::kHashLength;
+
+#if WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE > 0
+    // Skip the signature verification of a CA certificate that has already been verified against the same key.
+    // Leaf certificates are not cached, since they are typically seen only once.
+    if (depth > 0)
+    {
+        ComputeCertValidationCacheKey(cert, hashLen, *caCert, cacheKey);
+        if (IsInCertValidationCache(cacheKey))
+            ExitNow(err = WEAVE_NO_ERROR);
+    }
+#endif
+
     err = VerifyECDSASignature(cert.TBSHash, hashLen, cert.Signature.EC, *caCert);
     SuccessOrExit(err);
 
+#if WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE > 0
+    if (depth > 0)
+        AddToCertValidationCache(cacheKey);
+#endif
+
 exit:
 
 #if WEAVE_CONFIG_DEBUG_CERT_VALIDATION
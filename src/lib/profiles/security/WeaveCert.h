@@ -237,6 +237,7 @@ public:
     WEAVE_ERROR Init(WeaveCertificateData *certBuf, uint8_t certBufSize, uint8_t *decodeBuf, uint16_t decodeBufSize);
     void Release(void);
     void Clear(void);
+    void Truncate(uint8_t certCount);
 
     WEAVE_ERROR LoadCert(const uint8_t *weaveCert, uint32_t weaveCertLen, uint16_t decodeFlags, WeaveCertificateData *& cert);
     WEAVE_ERROR LoadCert(TLVReader& reader, uint16_t decodeFlags, WeaveCertificateData *& cert);
@@ -300,6 +301,8 @@ extern WEAVE_ERROR ConvertWeaveCertToX509Cert(const uint8_t *weaveCert, uint32_t
 
 extern WEAVE_ERROR DetermineCertType(WeaveCertificateData& cert);
 
+extern void ClearCertValidationCache(void);
+
 extern WEAVE_ERROR PackCertTime(const nl::Weave::ASN1::ASN1UniversalTime& time, uint32_t& packedTime);
 extern WEAVE_ERROR UnpackCertTime(uint32_t packedTime, nl::Weave::ASN1::ASN1UniversalTime& time);
 extern uint16_t PackedCertTimeToDate(uint32_t packedTime);
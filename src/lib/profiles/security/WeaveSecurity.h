@@ -61,6 +61,8 @@ enum
     kMsgType_CASEBeginSessionResponse           = 11,
     kMsgType_CASEInitiatorKeyConfirm            = 12,
     kMsgType_CASEReconfigure                    = 13,
+    kMsgType_CASEResumeSessionRequest           = 14,
+    kMsgType_CASEResumeSessionResponse          = 15,
 
     // ---- TAKE Protocol Messages ----
     kMsgType_TAKEIdentifyToken                  = 20,
@@ -113,6 +115,7 @@ enum
     kStatusCode_OperationalNodeIdInUse          = 20, // The specified operational node Id is already used by another Weave node (indication of node id collision).
     kStatusCode_InvalidOperationalNodeId        = 21, // The specified operational node Id is invalid.
     kStatusCode_InvalidOperationalCertificate   = 22, // The specified operational certificate is invalid.
+    kStatusCode_ResumptionTicketNotFound        = 23, // No CASE resumption ticket matching the request was found.
 };
 
 // Weave Key Error Message Size
@@ -343,6 +346,10 @@ enum
                                                               //    message encryption, the data encryption key.
     kTag_SerializedSession_AES128CTRSHA1_IntegrityKey   = 12, // [ BYTE STRING, len 20 ] For sessions supporting AES128CTRSHA1
                                                               //    message encryption, the data integrity key.
+    kTag_SerializedSession_AES128CCM_DataKey            = 13, // [ BYTE STRING, len 16 ] For sessions supporting AES128CCM
+                                                              //    message encryption, the data encryption key.
+    kTag_SerializedSession_MessageRcvdWindow            = 14, // [ BYTE STRING ] Bitmap of message ids received prior to the
+                                                              //    max received message id, as little-endian 32-bit words.
 };
 
 // Weave-defined elliptic curve ids
@@ -262,6 +262,10 @@ WeaveServiceManager::WeaveServiceManager()
     mExchangeContext = NULL;
     mServiceEndpointQueryBegin = NULL;
     mServiceEndpointQueryEndWithTimeInfo = NULL;
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+    mCacheFetchTime = 0;
+    mRefreshing = false;
+#endif
 
     freeConnectRequests();
 
@@ -358,6 +362,10 @@ WEAVE_ERROR WeaveServiceManager::init(WeaveExchangeManager *aExchangeMgr,
 
     clearCacheState();
 
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+    stopRefresh();
+#endif
+
 #if WEAVE_CONFIG_PERSIST_SERVICE_DIRECTORY
 
     if (Platform::IsPersistentServiceDirPresent(kPersistedServiceDirVersion))
@@ -376,6 +384,18 @@ WEAVE_ERROR WeaveServiceManager::init(WeaveExchangeManager *aExchangeMgr,
         {
             mCacheState = kServiceMgrState_Resolved;
             WeaveLogProgress(ServiceDirectory, "Persistent service directory successfully restored");
+
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+            /*
+             * the restored directory is used right away so that connect
+             * requests need not wait for the directory service. as its
+             * age is unknown though, validate it with a background query
+             * shortly after start up.
+             */
+
+            mCacheFetchTime = System::Layer::GetClock_MonotonicMS();
+            scheduleRefresh(WEAVE_CONFIG_SERVICE_DIR_WARM_START_VALIDATE_SECS);
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
         }
 
     }
@@ -441,6 +461,26 @@ WEAVE_ERROR WeaveServiceManager::connect(uint64_t aServiceEp,
 
     WeaveLogProgress(ServiceDirectory, "connect(%llx...)", aServiceEp);
 
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+    if (mCacheState == kServiceMgrState_Resolved && isCacheExpired() && !hasActiveConnectRequests())
+    {
+        WeaveLogProgress(ServiceDirectory, "cache expired");
+
+        /*
+         * the background refresh hasn't managed to renew the cache in
+         * time. go back to "resolving" so that the directory is queried
+         * before connecting. this is only safe while no request is
+         * using the cache, otherwise keep serving from it and leave the
+         * refresh to the background.
+         */
+
+        stopRefresh();
+        cleanupExchangeContext();
+
+        mCacheState = kServiceMgrState_Resolving;
+    }
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+
     if (mCacheState == kServiceMgrState_Initial)
     {
         WeaveLogProgress(ServiceDirectory, "initial");
@@ -883,9 +923,13 @@ void WeaveServiceManager::cancel(uint64_t aServiceEp, void *aAppState)
 
         /*
          * now clean up the exchange state being used to request
-         * service directory info.
+         * service directory info, unless it belongs to a background
+         * refresh, which no connect request is waiting on.
          */
 
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+        if (!mRefreshing)
+#endif
         cleanupExchangeContext(WEAVE_ERROR_CONNECTION_CLOSED_UNEXPECTEDLY);
     }
 }
@@ -936,6 +980,10 @@ void WeaveServiceManager::unresolve(void)
         Platform::ClearPersistentServiceDir();
 #endif //WEAVE_CONFIG_PERSIST_SERVICE_DIRECTORY
 
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+        stopRefresh();
+#endif
+
         cleanupExchangeContext();
 
         mCacheState = kServiceMgrState_Resolving;
@@ -977,6 +1025,10 @@ void WeaveServiceManager::reset(void)
 {
     WeaveLogProgress(ServiceDirectory, "reset()");
 
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+    stopRefresh();
+#endif
+
     cleanupExchangeContext();
 
     clearWorkingState();
@@ -1149,6 +1201,16 @@ void WeaveServiceManager::onResponseReceived(uint32_t aProfileId, uint8_t aMsgTy
 
         WeaveLogProgress(ServiceDirectory, "status: %lx, %x", report.mProfileId, report.mStatusCode);
 
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+        if (mRefreshing)
+        {
+            // the cache is still usable, so just try again later.
+
+            refreshFailed(WEAVE_ERROR_STATUS_REPORT_RECEIVED);
+            ExitNow();
+        }
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+
         clearWorkingState();
 
 #if WEAVE_CONFIG_PERSIST_SERVICE_DIRECTORY
@@ -1172,6 +1234,32 @@ void WeaveServiceManager::onResponseReceived(uint32_t aProfileId, uint8_t aMsgTy
          */
 
         VerifyOrExit(aMsgType == kMsgType_ServiceEndpointResponse, err = WEAVE_ERROR_INVALID_MESSAGE_TYPE);
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+        if (mRefreshing)
+        {
+            VerifyOrExit(mCacheState == kServiceMgrState_Resolved, err = WEAVE_ERROR_INCORRECT_STATE);
+
+            /*
+             * the response is unpacked over the current cache, which the
+             * host port lists of connect requests in progress point into.
+             * if there are any, leave the cache alone and try again later.
+             */
+
+            if (hasActiveConnectRequests())
+            {
+                refreshFailed(WEAVE_ERROR_INCORRECT_STATE);
+                ExitNow();
+            }
+
+            /*
+             * from here on the cache is being overwritten, so any failure
+             * is a hard one, like for a foreground query.
+             */
+
+            mRefreshing = false;
+        }
+        else
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
         VerifyOrExit(mCacheState == kServiceMgrState_Waiting, err = WEAVE_ERROR_INCORRECT_STATE);
 
         err = unpackPacketBuffer(aMsg, true, &redir);
@@ -1200,6 +1288,14 @@ void WeaveServiceManager::onResponseReceived(uint32_t aProfileId, uint8_t aMsgTy
         {
             // send out yet another query using this directory server.
 
+            /*
+             * if this was a background refresh, the cache now holds the
+             * redirect rather than a directory, so new connect requests
+             * have to wait for the query to complete.
+             */
+
+            mCacheState = kServiceMgrState_Waiting;
+
             mConnection = mExchangeManager->MessageLayer->NewConnection();
             VerifyOrExit(mConnection, err = WEAVE_ERROR_NO_MEMORY);
 
@@ -1219,6 +1315,11 @@ void WeaveServiceManager::onResponseReceived(uint32_t aProfileId, uint8_t aMsgTy
 
             WeaveLogProgress(ServiceDirectory, "onResponseReceived(): ->resolved");
 
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+            mCacheFetchTime = System::Layer::GetClock_MonotonicMS();
+            scheduleRefresh(WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS - WEAVE_CONFIG_SERVICE_DIR_CACHE_PREFETCH_SECS);
+#endif
+
             // now we gotta process all the pending transactions (see below)
 
             for (uint8_t j = 0; j < ARRAY_SIZE(mConnectRequestPool); j++)
@@ -1861,6 +1962,18 @@ void WeaveServiceManager::fail(WEAVE_ERROR aError)
 {
     WeaveLogProgress(ServiceDirectory, "fail() <= %s", ErrorStr(aError));
 
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+    if (mRefreshing)
+    {
+        // a failed background refresh leaves the cache as it is.
+
+        refreshFailed(aError);
+        return;
+    }
+
+    stopRefresh();
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+
     cleanupExchangeContext(aError);
 
     clearWorkingState();
@@ -2027,6 +2140,11 @@ void WeaveServiceManager::clearCache(void)
 
     if (mCacheState == kServiceMgrState_Resolved)
     {
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+        stopRefresh();
+        cleanupExchangeContext();
+#endif
+
         clearWorkingState();
         clearCacheState();
 
@@ -2035,4 +2153,137 @@ void WeaveServiceManager::clearCache(void)
 #endif
     }
 }
+
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+
+/**
+ *  @brief
+ *    This method is the timer callback which starts a background refresh
+ *    of the service directory cache.
+ */
+void WeaveServiceManager::handleRefreshTimer(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    WeaveServiceManager *manager = static_cast<WeaveServiceManager *>(aAppState);
+
+    manager->startRefresh();
+}
+
+/**
+ *  @brief
+ *    This method arms the timer for the next background refresh of the
+ *    service directory cache.
+ *
+ *  @param [in] aDelaySecs The time, in seconds, until the refresh.
+ */
+void WeaveServiceManager::scheduleRefresh(uint32_t aDelaySecs)
+{
+    WEAVE_ERROR err;
+
+    err = mExchangeManager->MessageLayer->SystemLayer->StartTimer(aDelaySecs * 1000, handleRefreshTimer, this);
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(ServiceDirectory, "scheduleRefresh: %s", ErrorStr(err));
+    }
+}
+
+/**
+ *  @brief
+ *    This method queries the directory service in the background to
+ *    refresh a resolved cache, which remains in use in the meantime.
+ */
+void WeaveServiceManager::startRefresh(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    WeaveLogProgress(ServiceDirectory, "startRefresh()");
+
+    /*
+     * a query already in progress, or a cache that isn't resolved,
+     * is taken care of by the foreground path.
+     */
+
+    VerifyOrExit(mCacheState == kServiceMgrState_Resolved && !mRefreshing && mConnection == NULL, /* no-op */);
+
+    mConnection = mExchangeManager->MessageLayer->NewConnection();
+    VerifyOrExit(mConnection, err = WEAVE_ERROR_NO_MEMORY);
+
+    mRefreshing = true;
+
+    err = lookupAndConnect(mConnection,
+                           kServiceEndpoint_Directory,
+                           mDirAuthMode,
+                           this,
+                           handleSDConnectionComplete,
+                           WEAVE_CONFIG_SERVICE_DIR_CONNECT_TIMEOUT_MSECS);
+
+exit:
+
+    if (err != WEAVE_NO_ERROR)
+    {
+        refreshFailed(err);
+    }
+}
+
+/**
+ *  @brief
+ *    This method cleans up after a failed background refresh, keeping the
+ *    cache, and schedules another attempt.
+ *
+ *  @param [in] aError The error that caused the refresh to fail.
+ */
+void WeaveServiceManager::refreshFailed(WEAVE_ERROR aError)
+{
+    WeaveLogProgress(ServiceDirectory, "refreshFailed() <= %s", ErrorStr(aError));
+
+    mRefreshing = false;
+
+    cleanupExchangeContext(aError);
+
+    scheduleRefresh(WEAVE_CONFIG_SERVICE_DIR_CACHE_REFRESH_RETRY_SECS);
+}
+
+/**
+ *  @brief
+ *    This method cancels any pending background refresh. The caller is
+ *    responsible for cleaning up the exchange of a refresh in progress.
+ */
+void WeaveServiceManager::stopRefresh(void)
+{
+    mRefreshing = false;
+
+    if (mExchangeManager)
+    {
+        mExchangeManager->MessageLayer->SystemLayer->CancelTimer(handleRefreshTimer, this);
+    }
+}
+
+/**
+ *  @brief
+ *    This method tests if the cache has outlived its time to live.
+ *
+ *  @return true if the cache has expired, false otherwise.
+ */
+bool WeaveServiceManager::isCacheExpired(void) const
+{
+    return (System::Layer::GetClock_MonotonicMS() - mCacheFetchTime) >= (WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS * 1000ULL);
+}
+
+/**
+ *  @brief
+ *    This method tests if any connect request is currently allocated.
+ *
+ *  @return true if the test passes, false otherwise.
+ */
+bool WeaveServiceManager::hasActiveConnectRequests(void)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(mConnectRequestPool); i++)
+    {
+        if (!mConnectRequestPool[i].isFree())
+            return true;
+    }
+
+    return false;
+}
+
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
 #endif //WEAVE_CONFIG_ENABLE_SERVICE_DIRECTORY
@@ -466,6 +466,21 @@ private:
 
     WEAVE_ERROR handleTimeInfo(MessageIterator &itMsg);
 
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+    /*
+     *  A group of methods that keep the cache fresh by querying the
+     *  directory service in the background before it expires.
+     */
+
+    static void handleRefreshTimer(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+    void scheduleRefresh(uint32_t aDelaySecs);
+    void startRefresh(void);
+    void refreshFailed(WEAVE_ERROR aError);
+    void stopRefresh(void);
+    bool isCacheExpired(void) const;
+    bool hasActiveConnectRequests(void);
+#endif // WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+
     // data members
 
     ConnectRequest          mConnectRequestPool[kConnectRequestPoolSize];
@@ -480,6 +495,10 @@ private:
     bool                    mWasRelocated;                ///< true iff the service manager has been relocated once.
     WeaveAuthMode           mDirAuthMode;                 ///< the authentication mode to use when talking to the directory service.
     uint32_t                mDirAndSuffTableSize;         ///< the size of the directory and suffix table  in the cache.
+#if WEAVE_CONFIG_SERVICE_DIR_CACHE_TTL_SECS
+    uint64_t                mCacheFetchTime;              ///< the monotonic time, in milliseconds, at which the cache was last resolved.
+    bool                    mRefreshing;                  ///< true iff the directory query in progress is a background refresh.
+#endif
 
     /**
      *  Callback happens right before we send out the service endpoint query request
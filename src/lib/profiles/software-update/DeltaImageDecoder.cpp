@@ -0,0 +1,311 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the streaming decoder for software update
+ *      delta images.
+ */
+
+#include <string.h>
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveEncoding.h>
+#include <Weave/Support/CodeUtils.h>
+
+#include "DeltaImageDecoder.h"
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace SoftwareUpdate {
+
+using namespace ::nl::Weave::Encoding;
+
+DeltaImageDecoder::DeltaImageDecoder(void)
+{
+    Init(NULL, NULL, NULL, NULL, 0);
+}
+
+/**
+ * Prepares the decoder to decode a new delta image.
+ *
+ * @param[in]   aAppState       Application state passed to the callbacks
+ * @param[in]   aReadBaseImage  The callback that reads the base image
+ * @param[in]   aWriteImage     The callback that writes the new image
+ * @param[in]   aBuf            A work buffer for the base image data being copied
+ * @param[in]   aBufSize        The size of the work buffer, which must not be 0
+ */
+void DeltaImageDecoder::Init(void * aAppState, ReadBaseImageFunct aReadBaseImage, WriteImageFunct aWriteImage, uint8_t * aBuf,
+                             uint32_t aBufSize)
+{
+    mAppState = aAppState;
+    mReadBaseImage = aReadBaseImage;
+    mWriteImage = aWriteImage;
+    mBuf = aBuf;
+    mBufSize = aBufSize;
+
+    mImageLength = 0;
+    mDecodedLength = 0;
+    mBaseOffset = 0;
+    mDataRemaining = 0;
+
+    mFieldsLength = 0;
+    mFieldsNeeded = kHeaderLength;
+    mOpcode = kOpcode_End;
+    mState = kState_Header;
+}
+
+/**
+ * Decodes the next piece of the delta image, writing out the new image it
+ * describes.
+ *
+ * @param[in]   aData       The next piece of the delta image
+ * @param[in]   aLength     The length of the piece
+ *
+ * @retval WEAVE_NO_ERROR                           On success.
+ * @retval WEAVE_ERROR_INVALID_ARGUMENT             If the delta image is malformed.
+ * @retval WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION  If the delta image has an unsupported format version.
+ * @retval WEAVE_ERROR_INVALID_MESSAGE_LENGTH       If the delta image describes more, or less, than the new image, or
+ *                                                  continues past its End command.
+ * @retval other                                    Errors returned by the callbacks.
+ */
+WEAVE_ERROR DeltaImageDecoder::Decode(uint8_t * aData, uint32_t aLength)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint32_t len;
+
+    while (aLength > 0)
+    {
+        switch (mState)
+        {
+        case kState_Header:
+        case kState_Opcode:
+        case kState_Fields:
+            // Collect the fixed-size fields, which may be split across pieces.
+            len = min<uint32_t>(aLength, mFieldsNeeded - mFieldsLength);
+            memcpy(mFields + mFieldsLength, aData, len);
+            mFieldsLength += len;
+
+            if (mFieldsLength == mFieldsNeeded)
+            {
+                err = HandleFields();
+                SuccessOrExit(err);
+            }
+            break;
+
+        case kState_Data:
+            len = min(aLength, mDataRemaining);
+
+            if (mOpcode == kOpcode_Add)
+            {
+                err = AddBaseImage(aData, len);
+            }
+            else
+            {
+                err = WriteImage(aData, len);
+            }
+            SuccessOrExit(err);
+
+            mDataRemaining -= len;
+            if (mDataRemaining == 0)
+            {
+                mState = kState_Opcode;
+                mFieldsNeeded = 1;
+                mFieldsLength = 0;
+            }
+            break;
+
+        default:
+            ExitNow(err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+        }
+
+        aData += len;
+        aLength -= len;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * Checks that the whole of the delta image has been decoded.
+ *
+ * @retval WEAVE_NO_ERROR                   If the delta image ended with its End command.
+ * @retval WEAVE_ERROR_MESSAGE_INCOMPLETE   If the delta image is incomplete.
+ */
+WEAVE_ERROR DeltaImageDecoder::Finish(void)
+{
+    return (mState == kState_Done) ? WEAVE_NO_ERROR : WEAVE_ERROR_MESSAGE_INCOMPLETE;
+}
+
+/*
+ * Acts on the header, an opcode, or the fields of a command, once all of
+ * their bytes have been collected.
+ */
+WEAVE_ERROR DeltaImageDecoder::HandleFields(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    State nextState = kState_Opcode;
+    uint8_t nextFieldsNeeded = 1;
+
+    switch (mState)
+    {
+    case kState_Header:
+        VerifyOrExit(mFields[0] == 'W' && mFields[1] == 'D' && mFields[2] == 'L' && mFields[3] == 'T',
+                     err = WEAVE_ERROR_INVALID_ARGUMENT);
+        VerifyOrExit(mFields[4] == kFormatVersion, err = WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+        mImageLength = LittleEndian::Get32(&mFields[5]);
+        break;
+
+    case kState_Opcode:
+        mOpcode = mFields[0];
+
+        switch (mOpcode)
+        {
+        case kOpcode_End:
+            VerifyOrExit(mDecodedLength == mImageLength, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+            nextState = kState_Done;
+            break;
+
+        case kOpcode_Copy:
+        case kOpcode_Add:
+            nextState = kState_Fields;
+            nextFieldsNeeded = 8;
+            break;
+
+        case kOpcode_Insert:
+            nextState = kState_Fields;
+            nextFieldsNeeded = 4;
+            break;
+
+        default:
+            ExitNow(err = WEAVE_ERROR_INVALID_ARGUMENT);
+        }
+        break;
+
+    default:
+        if (mOpcode == kOpcode_Insert)
+        {
+            mDataRemaining = LittleEndian::Get32(&mFields[0]);
+        }
+        else
+        {
+            mBaseOffset = LittleEndian::Get32(&mFields[0]);
+            mDataRemaining = LittleEndian::Get32(&mFields[4]);
+            VerifyOrExit(mDataRemaining <= UINT32_MAX - mBaseOffset, err = WEAVE_ERROR_INVALID_ARGUMENT);
+        }
+
+        VerifyOrExit(mDataRemaining <= mImageLength - mDecodedLength, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+        if (mOpcode == kOpcode_Copy)
+        {
+            err = CopyBaseImage(mDataRemaining);
+            SuccessOrExit(err);
+            mDataRemaining = 0;
+        }
+
+        if (mDataRemaining != 0)
+        {
+            nextState = kState_Data;
+        }
+        break;
+    }
+
+    mState = nextState;
+    mFieldsNeeded = nextFieldsNeeded;
+    mFieldsLength = 0;
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR DeltaImageDecoder::WriteImage(uint8_t * aData, uint32_t aLength)
+{
+    WEAVE_ERROR err;
+
+    err = mWriteImage(mAppState, aData, aLength);
+    SuccessOrExit(err);
+
+    mDecodedLength += aLength;
+
+exit:
+    return err;
+}
+
+/*
+ * Writes out the next aLength bytes of the base image, a buffer at a time.
+ */
+WEAVE_ERROR DeltaImageDecoder::CopyBaseImage(uint32_t aLength)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    while (aLength > 0)
+    {
+        uint32_t len = min(aLength, mBufSize);
+
+        err = mReadBaseImage(mAppState, mBaseOffset, mBuf, len);
+        SuccessOrExit(err);
+
+        err = WriteImage(mBuf, len);
+        SuccessOrExit(err);
+
+        mBaseOffset += len;
+        aLength -= len;
+    }
+
+exit:
+    return err;
+}
+
+/*
+ * Writes out the next aLength bytes of the base image, each added to the
+ * corresponding byte of aData, a buffer at a time.
+ */
+WEAVE_ERROR DeltaImageDecoder::AddBaseImage(const uint8_t * aData, uint32_t aLength)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    while (aLength > 0)
+    {
+        uint32_t len = min(aLength, mBufSize);
+
+        err = mReadBaseImage(mAppState, mBaseOffset, mBuf, len);
+        SuccessOrExit(err);
+
+        for (uint32_t i = 0; i < len; i++)
+        {
+            mBuf[i] += aData[i];
+        }
+
+        err = WriteImage(mBuf, len);
+        SuccessOrExit(err);
+
+        mBaseOffset += len;
+        aData += len;
+        aLength -= len;
+    }
+
+exit:
+    return err;
+}
+
+} // namespace SoftwareUpdate
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
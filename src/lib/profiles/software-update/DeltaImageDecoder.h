@@ -0,0 +1,151 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a streaming decoder for software update delta
+ *      images, which reconstructs a new software image from the image
+ *      installed on a device and a delta downloaded by it.
+ */
+
+#ifndef _WEAVE_DELTA_IMAGE_DECODER_H
+#define _WEAVE_DELTA_IMAGE_DECODER_H
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Support/NLDLLUtil.h>
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace SoftwareUpdate {
+
+/**
+ * A streaming decoder for software update delta images.
+ *
+ * A delta image describes a new image in terms of the base image it is
+ * applied to.  All integers are little-endian.  It starts with a header:
+ *
+ * Length | Field Name
+ * -------|------------
+ * 4 bytes | magic, 'W' 'D' 'L' 'T'
+ * 1 byte | format version, 1
+ * 4 bytes | length of the new image
+ *
+ * followed by a sequence of commands, each an opcode byte and its fields,
+ * that produce the new image in order:
+ *
+ * Opcode | Fields | Output
+ * -------|--------|-------
+ * 0 End | | None; the new image is complete.
+ * 1 Copy | offset (4 bytes), length (4 bytes) | length bytes of the base image, starting at offset.
+ * 2 Add | offset (4 bytes), length (4 bytes), length bytes of data | length bytes of the base image, starting at offset, each added (modulo 256) to the corresponding data byte.
+ * 3 Insert | length (4 bytes), length bytes of data | The data.
+ *
+ * Add commands carry code that has moved, or that refers to code that has
+ * moved, as mostly zero bytes, which compress well.
+ *
+ * The delta image may be fed to the decoder in pieces of any size, as it is
+ * downloaded.  The decoder reads the base image, and writes the new image,
+ * through callbacks, the latter in pieces no larger than the work buffer
+ * given to it, or the Insert data of a piece of the delta image.
+ */
+class NL_DLL_EXPORT DeltaImageDecoder
+{
+public:
+    enum
+    {
+        kFormatVersion  = 1,
+        kHeaderLength   = 9
+    };
+
+    enum
+    {
+        kOpcode_End     = 0,
+        kOpcode_Copy    = 1,
+        kOpcode_Add     = 2,
+        kOpcode_Insert  = 3
+    };
+
+    /**
+     * Reads a range of the base image.
+     *
+     * @param[in]   aAppState   The application state given to Init()
+     * @param[in]   aOffset     The offset of the range within the base image
+     * @param[out]  aBuf        A buffer to read the range into
+     * @param[in]   aLength     The length of the range
+     */
+    typedef WEAVE_ERROR (*ReadBaseImageFunct)(void * aAppState, uint32_t aOffset, uint8_t * aBuf, uint32_t aLength);
+
+    /**
+     * Writes the next piece of the new image.
+     *
+     * @param[in]   aAppState   The application state given to Init()
+     * @param[in]   aData       The piece of the new image
+     * @param[in]   aLength     The length of the piece
+     */
+    typedef WEAVE_ERROR (*WriteImageFunct)(void * aAppState, uint8_t * aData, uint32_t aLength);
+
+    DeltaImageDecoder(void);
+
+    void Init(void * aAppState, ReadBaseImageFunct aReadBaseImage, WriteImageFunct aWriteImage, uint8_t * aBuf,
+              uint32_t aBufSize);
+    WEAVE_ERROR Decode(uint8_t * aData, uint32_t aLength);
+    WEAVE_ERROR Finish(void);
+
+    uint32_t GetImageLength(void) const { return mImageLength; }
+    uint32_t GetDecodedLength(void) const { return mDecodedLength; }
+
+private:
+    enum State
+    {
+        kState_Header,
+        kState_Opcode,
+        kState_Fields,
+        kState_Data,
+        kState_Done
+    };
+
+    WEAVE_ERROR HandleFields(void);
+    WEAVE_ERROR WriteImage(uint8_t * aData, uint32_t aLength);
+    WEAVE_ERROR CopyBaseImage(uint32_t aLength);
+    WEAVE_ERROR AddBaseImage(const uint8_t * aData, uint32_t aLength);
+
+    void * mAppState;
+    ReadBaseImageFunct mReadBaseImage;
+    WriteImageFunct mWriteImage;
+    uint8_t * mBuf;
+    uint32_t mBufSize;
+
+    uint32_t mImageLength;
+    uint32_t mDecodedLength;
+    uint32_t mBaseOffset;
+    uint32_t mDataRemaining;
+
+    uint8_t mFields[kHeaderLength];
+    uint8_t mFieldsLength;
+    uint8_t mFieldsNeeded;
+    uint8_t mOpcode;
+    State mState;
+};
+
+} // namespace SoftwareUpdate
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // _WEAVE_DELTA_IMAGE_DECODER_H
@@ -287,6 +287,7 @@ ImageQuery::ImageQuery()
     localeSpec.theLength     = 0;
     localeSpec.isShort       = true;
     targetNodeId             = 0;
+    hasInstalledImageSpec    = false;
 }
 /**
  * Explicitly initialize the ImageQuery object with the provided values.
@@ -299,12 +300,13 @@ ImageQuery::ImageQuery()
  * @param[in] aLocale An optional locale spec requested by the client.
  * @param[in] aTargetNodeId An optional target node ID.
  * @param[in] aMetaData An optional TLV-encoded vendor data blob.
+ * @param[in] aInstalledImage An optional integrity spec of the installed image, given by clients that can apply delta images.
  *
  * @return WEAVE_NO_ERROR Unconditionally.
  */
 WEAVE_ERROR ImageQuery::init(ProductSpec & aProductSpec, ReferencedString & aVersion, IntegrityTypeList & aTypeList,
                              UpdateSchemeList & aSchemeList, ReferencedString * aPackage, ReferencedString * aLocale,
-                             uint64_t aTargetNodeId, ReferencedTLVData * aMetaData)
+                             uint64_t aTargetNodeId, ReferencedTLVData * aMetaData, IntegritySpec * aInstalledImage)
 {
     productSpec     = aProductSpec;
     version         = aVersion;
@@ -321,6 +323,9 @@ WEAVE_ERROR ImageQuery::init(ProductSpec & aProductSpec, ReferencedString & aVer
     targetNodeId = aTargetNodeId;
     if (aMetaData != NULL)
         theMetaData = *aMetaData;
+    hasInstalledImageSpec = (aInstalledImage != NULL);
+    if (aInstalledImage != NULL)
+        installedImageSpec = *aInstalledImage;
 
     return WEAVE_NO_ERROR;
 }
@@ -344,6 +349,8 @@ WEAVE_ERROR ImageQuery::pack(PacketBuffer * aBuffer)
         frameCtl |= kFlag_LocaleSpecPresent;
     if (targetNodeId != 0)
         frameCtl |= kFlag_TargetNodeIdPresent;
+    if (hasInstalledImageSpec)
+        frameCtl |= kFlag_InstalledImagePresent;
     // now write it
     TRY(i.writeByte(frameCtl));
     // write the product spec
@@ -362,6 +369,8 @@ WEAVE_ERROR ImageQuery::pack(PacketBuffer * aBuffer)
         TRY(localeSpec.pack(i));
     if (targetNodeId != 0)
         TRY(i.write64(targetNodeId));
+    if (hasInstalledImageSpec)
+        TRY(installedImageSpec.pack(i));
     TRY(theMetaData.pack(i));
 
     return WEAVE_NO_ERROR;
@@ -401,6 +410,10 @@ WEAVE_ERROR ImageQuery::parse(PacketBuffer * aBuffer, ImageQuery & aQuery)
     // if a target node id is provided then get it
     if (frameCtl & kFlag_TargetNodeIdPresent)
         TRY(i.read64(&aQuery.targetNodeId));
+    // if the installed image is identified then get its integrity spec
+    aQuery.hasInstalledImageSpec = (frameCtl & kFlag_InstalledImagePresent) != 0;
+    if (aQuery.hasInstalledImageSpec)
+        TRY(IntegritySpec::parse(i, aQuery.installedImageSpec));
     // and maybe the metadata
     ReferencedTLVData::parse(i, aQuery.theMetaData);
 
@@ -419,7 +432,8 @@ bool ImageQuery::operator ==(const ImageQuery & another) const
             (productSpec.productRev == another.productSpec.productRev) && (version == another.version) &&
             (integrityTypes == another.integrityTypes) && (updateSchemes == another.updateSchemes) &&
             (packageSpec == another.packageSpec) && (localeSpec == another.localeSpec) && (targetNodeId == another.targetNodeId) &&
-            (theMetaData == another.theMetaData));
+            (hasInstalledImageSpec == another.hasInstalledImageSpec) &&
+            (!hasInstalledImageSpec || (installedImageSpec == another.installedImageSpec)) && (theMetaData == another.theMetaData));
 }
 
 /**
@@ -538,11 +552,13 @@ bool IntegritySpec::operator ==(const IntegritySpec & another) const
  * @param[in] aPriority The update priority associated with this update.
  * @param[in] aCondition The condition under which to update.
  * @param[in] aReportStatus If true requests the client to report after download and update, otherwise the client will not report.
+ * @param[in] aBaseImage If not NULL, the image is a delta image based on the image with this integrity spec.
  *
  * @return WEAVE_NO_ERROR Unconditionally.
  */
 WEAVE_ERROR ImageQueryResponse::init(ReferencedString & aUri, ReferencedString & aVersion, IntegritySpec & aIntegrity,
-                                     uint8_t aScheme, UpdatePriority aPriority, UpdateCondition aCondition, bool aReportStatus)
+                                     uint8_t aScheme, UpdatePriority aPriority, UpdateCondition aCondition, bool aReportStatus,
+                                     IntegritySpec * aBaseImage)
 {
     uri                 = aUri;
     versionSpec         = aVersion;
@@ -552,6 +568,9 @@ WEAVE_ERROR ImageQueryResponse::init(ReferencedString & aUri, ReferencedString &
     updatePriority      = aPriority;
     updateCondition     = aCondition;
     reportStatus        = aReportStatus;
+    isDeltaImage        = (aBaseImage != NULL);
+    if (aBaseImage != NULL)
+        baseImageSpec = *aBaseImage;
 
     return WEAVE_NO_ERROR;
 }
@@ -565,6 +584,7 @@ ImageQueryResponse::ImageQueryResponse() : uri()
     versionSpec.isShort   = true;
     updateScheme          = kUpdateScheme_HTTP;
     reportStatus          = false;
+    isDeltaImage          = false;
 }
 /**
  * Serialize the ImageQueryResponse into the provided PacketBuffer
@@ -585,7 +605,11 @@ WEAVE_ERROR ImageQueryResponse::pack(PacketBuffer * aBuffer)
     uint8_t updateOptions = (uint8_t) updatePriority | ((uint8_t) updateCondition << kOffset_UpdateCondition);
     if (reportStatus)
         updateOptions |= kMask_ReportStatus;
+    if (isDeltaImage)
+        updateOptions |= kMask_DeltaImage;
     TRY(i.writeByte(updateOptions));
+    if (isDeltaImage)
+        TRY(baseImageSpec.pack(i));
 
     return WEAVE_NO_ERROR;
 }
@@ -612,6 +636,9 @@ WEAVE_ERROR ImageQueryResponse::parse(PacketBuffer * aBuffer, ImageQueryResponse
     aResponse.updatePriority  = (UpdatePriority)(updateOptions & kMask_UpdatePriority);
     aResponse.updateCondition = (UpdateCondition)((updateOptions & kMask_UpdateCondition) >> kOffset_UpdateCondition);
     aResponse.reportStatus    = (updateOptions & kMask_ReportStatus) == kMask_ReportStatus;
+    aResponse.isDeltaImage    = (updateOptions & kMask_DeltaImage) == kMask_DeltaImage;
+    if (aResponse.isDeltaImage)
+        TRY(IntegritySpec::parse(i, aResponse.baseImageSpec));
 
     return WEAVE_NO_ERROR;
 }
@@ -625,7 +652,8 @@ bool ImageQueryResponse::operator ==(const ImageQueryResponse & another) const
 {
     return ((uri == another.uri) && (versionSpec == another.versionSpec) && (integritySpec == another.integritySpec) &&
             (updateScheme == another.updateScheme) && (updatePriority == another.updatePriority) &&
-            (updateCondition == another.updateCondition) && (reportStatus == another.reportStatus));
+            (updateCondition == another.updateCondition) && (reportStatus == another.reportStatus) &&
+            (isDeltaImage == another.isDeltaImage) && (!isDeltaImage || (baseImageSpec == another.baseImageSpec)));
 }
 
 } // namespace SoftwareUpdate
@@ -100,6 +100,7 @@ enum
     kFlag_PackageSpecPresent  = 1, /**< Package specification is present in the ImageQuery. */
     kFlag_LocaleSpecPresent   = 2, /**< Locale specification is present in the ImageQuery. */
     kFlag_TargetNodeIdPresent = 4, /**< Target node ID is present in the ImageQuery. */
+    kFlag_InstalledImagePresent = 8, /**< Integrity specification of the installed image is present in the ImageQuery. */
 };
 
 /**
@@ -110,6 +111,7 @@ enum
     kMask_UpdatePriority  = 0x03, // 0b00000011
     kMask_UpdateCondition = 0x1C, // 0b00011100
     kMask_ReportStatus    = 0x20, // 0b00100000
+    kMask_DeltaImage      = 0x40, // 0b01000000
 };
 
 /**
@@ -120,6 +122,7 @@ enum
     kOffset_UpdatePriority  = 0,
     kOffset_UpdateCondition = 2,
     kOffset_ReportStatus    = 5,
+    kOffset_DeltaImage      = 6,
 };
 
 /**
@@ -260,6 +263,35 @@ public:
     uint16_t productRev; /**< A 16-bit product revision drawn from a vendor managed namespace. */
 };
 
+/**
+ * An auxiliary class holding the integrity type and the actual hash of the software update image.
+ *
+ * The object holds the @ref IntegrityTypes field specifying the type of the
+ * hash, and the actual hash of the software update image.  The length of the hash is
+ * fixed based on the type of the hash.  The object is sized to hold the largest
+ * of the supported hashes.
+ */
+class NL_DLL_EXPORT IntegritySpec
+{
+public:
+    // constructor
+    IntegritySpec();
+    // initializer
+    WEAVE_ERROR init(uint8_t, uint8_t *);
+    // packing and parsing
+    WEAVE_ERROR pack(MessageIterator &);
+    static WEAVE_ERROR parse(MessageIterator &, IntegritySpec &);
+    // comparison
+    bool operator ==(const IntegritySpec &) const;
+    // data members
+    uint8_t type; /**< Type of the hash, value to be drawn from @ref IntegrityTypes */
+    uint8_t
+        value[64]; /**< A variable length sequence of bytes containing the integrity value for the software image identified by the
+                      URI field. The integrity value is computed by applying the integrity function specified by the integrity type
+                      to the contents of the software update image accessed at the URI specified above.  The integrity specification
+                      allows the client to confirm that the image downloaded matches the image specified in this response.*/
+};
+
 /**
  * A class to support creation and decoding of image query messages.
  *
@@ -275,6 +307,7 @@ public:
  * 2..5 bytes | update scheme list
  * variable | locale specification (optional)
  * 8 bytes | target node ID
+ * 1..65 bytes | installed image integrity specification (optional)
  * variable | vendor specific data (optional)
  *
  * where the frame control field has bit-fields as follows:
@@ -284,13 +317,17 @@ public:
  *  0 | 1 - vendor-specific data present, 0 - not present
  *  1 | 1 - locale specification present, 0 - not present
  *  2 | 1 - target node id present, 0 - not present
- *  3..7 | Reserved
+ *  3 | 1 - installed image integrity specification present, 0 - not present
+ *  4..7 | Reserved
  *
  * The ImageQuery, as a structure reads slightly differently from the in-flight
  * representation. In particular, the version and locale are null-terminated
  * c-strings (as opposed to (length, characters) tuples) and both of the optional
  * items are represented as nullable pointers so there isn't a separate boolean
  * to check.
+ *
+ * A client that can apply delta images includes the integrity specification
+ * of its installed image, which identifies the image a delta must be based on.
  */
 class NL_DLL_EXPORT ImageQuery
 {
@@ -303,7 +340,8 @@ public:
                      IntegrityTypeList & aTypeList, UpdateSchemeList & aSchemeList,
                      ReferencedString * aPackage = NULL, // 1 byte length
                      ReferencedString * aLocale = NULL, uint64_t aTargetNodeId = 0,
-                     ReferencedTLVData * aMetaData = NULL); // 2 byte length
+                     ReferencedTLVData * aMetaData = NULL, // 2 byte length
+                     IntegritySpec * aInstalledImage = NULL);
     WEAVE_ERROR pack(PacketBuffer *);
     static WEAVE_ERROR parse(PacketBuffer *, ImageQuery &);
     // comparison
@@ -327,6 +365,10 @@ software update proxy for another node. */
     ReferencedString localeSpec;  /**< A variable length UTF-8 string containing the POSIX locale in effect on the device for which
                                      the image query is being made.  The contents of the string must conform to the POSIX locale
                                      identifier format, as specified in ISO/IEC 15897, e.g. en_AU.UTF-8 for Australian English.*/
+    bool hasInstalledImageSpec;   /**< True if the installed image integrity specification is present. */
+    IntegritySpec installedImageSpec; /**< An optional integrity specification of the software image installed on the device.  It is
+                                         present when the device can apply delta images, and identifies the image that a delta image
+                                         offered in response must be based on. */
     ReferencedTLVData theMetaData; /**< The vendor-specific data field is variable in length and occupies the remainder of the Weave
                                       message payload, beyond the fields described above.  The field encodes vendor-specific
                                       information about the device for which the query is being made. The vendor-specific data field
@@ -356,35 +398,6 @@ enum UpdateCondition
     OnOptIn          /**< download and install the image on some trigger provided by an on-site user. */
 };
 
-/**
- * An auxiliary class holding the integrity type and the actual hash of the software update image.
- *
- * The object holds the @ref IntegrityTypes field specifying the type of the
- * hash, and the actual hash of the software update image.  The length of the hash is
- * fixed based on the type of the hash.  The object is sized to hold the largest
- * of the supported hashes.
- */
-class NL_DLL_EXPORT IntegritySpec
-{
-public:
-    // constructor
-    IntegritySpec();
-    // initializer
-    WEAVE_ERROR init(uint8_t, uint8_t *);
-    // packing and parsing
-    WEAVE_ERROR pack(MessageIterator &);
-    static WEAVE_ERROR parse(MessageIterator &, IntegritySpec &);
-    // comparison
-    bool operator ==(const IntegritySpec &) const;
-    // data members
-    uint8_t type; /**< Type of the hash, value to be drawn from @ref IntegrityTypes */
-    uint8_t
-        value[64]; /**< A variable length sequence of bytes containing the integrity value for the software image identified by the
-                      URI field. The integrity value is computed by applying the integrity function specified by the integrity type
-                      to the contents of the software update image accessed at the URI specified above.  The integrity specification
-                      allows the client to confirm that the image downloaded matches the image specified in this response.*/
-};
-
 /**
  * A class to support creation and decoding of the image query response messages.
  *
@@ -397,6 +410,7 @@ public:
  * variable | Integrity specification
  * 1 byte | Update scheme
  * 1 byte | Update options
+ * 1..65 bytes | Base image integrity specification (delta images only)
  *
  * The format of the (optional) update options field is as follows:
  *
@@ -405,13 +419,20 @@ public:
  * 0..2 | Update priority
  * 3..4 | Update condition
  * 5 | Report status.  When set, the client is requested to generate the optional DownloadNotify and UpdateNotify messages.
- * 5..7 | Reserved
+ * 6 | Delta image.  When set, the image at the URI is a delta image, and the update options are followed by the integrity
+ *   | specification of the image it is based on.
+ * 7 | Reserved
  *
  * The image query response is only sent in the case where the image query is
  * processed successfully and produces an image to download.  The message
  * constitutes download instructions for the node the submitted the query. Note
  * that in cases where the server fails to process the image query, it shall
  * generate an image query status.
+ *
+ * A delta image (see DeltaImageDecoder) may only be offered to a client whose
+ * image query included the integrity specification of its installed image, and
+ * must be based on that image.  The integrity specification of the response
+ * then covers the image reconstructed from the delta, not the delta itself.
  */
 class NL_DLL_EXPORT ImageQueryResponse
 {
@@ -419,7 +440,8 @@ public:
     // constructor
     ImageQueryResponse();
     // initializers
-    WEAVE_ERROR init(ReferencedString &, ReferencedString &, IntegritySpec &, uint8_t, UpdatePriority, UpdateCondition, bool);
+    WEAVE_ERROR init(ReferencedString &, ReferencedString &, IntegritySpec &, uint8_t, UpdatePriority, UpdateCondition, bool,
+                     IntegritySpec * aBaseImage = NULL);
     // packing and parsing
     WEAVE_ERROR pack(PacketBuffer *);
     static WEAVE_ERROR parse(PacketBuffer *, ImageQueryResponse &);
@@ -443,6 +465,9 @@ public:
     UpdateCondition updateCondition; /**< Instructions as to the conditions under which to proceed with software update. */
     bool reportStatus; /**< Request to inform the server about the progress of software update via the optional DownloadNotify and
                           UpdateNotify messages. */
+    bool isDeltaImage; /**< True if the image at the URI is a delta image, to be applied to the image identified by baseImageSpec. */
+    IntegritySpec baseImageSpec; /**< The integrity specification of the installed image a delta image is based on.  Present only
+                                    if isDeltaImage is set. */
 };
 } // namespace SoftwareUpdate
 } // namespace Profiles
@@ -0,0 +1,575 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the software image cache, which answers the
+ *      image queries of the devices on a local fabric for the images it
+ *      holds, serves those images over BDX, and announces newly added
+ *      images to the devices waiting for them.
+ */
+
+#include <string.h>
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveServerBase.h>
+#include <Weave/Profiles/common/CommonProfile.h>
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+
+#include "WeaveImageCache.h"
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace SoftwareUpdate {
+
+using namespace ::nl::Weave::Profiles::BulkDataTransfer;
+using ::nl::Weave::Profiles::StatusReporting::StatusReport;
+
+WeaveImageCache::WeaveImageCache(void)
+{
+    mExchangeMgr = NULL;
+    mDelegate    = NULL;
+    mNumWaiters  = 0;
+
+    for (size_t i = 0; i < WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE; i++)
+    {
+        mImages[i].mCache           = NULL;
+        mImages[i].mActiveTransfers = 0;
+        mImages[i].mInUse           = false;
+    }
+}
+
+/**
+ * Registers the cache to answer the image queries received by an exchange
+ * manager.
+ *
+ * @param[in] exchangeManager   The exchange manager to receive image queries from
+ * @param[in] delegate          The delegate storing the images, which may be set later
+ *
+ * @retval WEAVE_NO_ERROR               On success.
+ * @retval WEAVE_ERROR_INVALID_ARGUMENT If the exchange manager is null.
+ * @retval other                        Errors registering the image query handler.
+ */
+WEAVE_ERROR WeaveImageCache::Init(WeaveExchangeManager * exchangeManager, IWeaveImageCacheDelegate * delegate)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(exchangeManager != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    err = exchangeManager->RegisterUnsolicitedMessageHandler(kWeaveProfile_SWU, kMsgType_ImageQuery, HandleImageQuery, this);
+    SuccessOrExit(err);
+
+    mExchangeMgr = exchangeManager;
+    mDelegate    = delegate;
+    mNumWaiters  = 0;
+
+exit:
+    return err;
+}
+
+/**
+ * Stops answering image queries.  The cached images are kept.
+ */
+WEAVE_ERROR WeaveImageCache::Shutdown(void)
+{
+    if (mExchangeMgr != NULL)
+    {
+        mExchangeMgr->UnregisterUnsolicitedMessageHandler(kWeaveProfile_SWU, kMsgType_ImageQuery);
+        mExchangeMgr = NULL;
+    }
+
+    mNumWaiters = 0;
+
+    return WEAVE_NO_ERROR;
+}
+
+/**
+ * Sets the delegate storing the cached images.
+ */
+void WeaveImageCache::SetDelegate(IWeaveImageCacheDelegate * delegate)
+{
+    mDelegate = delegate;
+}
+
+/**
+ * Adds an image to the cache, in place of any image cached for the same
+ * product, and announces it to the devices waiting for an image for that
+ * product.
+ *
+ * @param[in] productSpec       The product the image is for
+ * @param[in] version           The software version of the image
+ * @param[in] integritySpec     The integrity specification of the image
+ * @param[in] uri               The URI to offer the image at, which is also its BDX file designator
+ * @param[in] length            The length of the image
+ * @param[in] appState          Application state identifying the stored image, passed back to
+ *                              IWeaveImageCacheDelegate::ReadCachedImage()
+ *
+ * @retval WEAVE_NO_ERROR               On success.
+ * @retval WEAVE_ERROR_INVALID_ARGUMENT If the version or URI is too long.
+ * @retval WEAVE_ERROR_INCORRECT_STATE  If the image it replaces is being served.
+ * @retval WEAVE_ERROR_NO_MEMORY        If the cache is full.
+ */
+WEAVE_ERROR WeaveImageCache::AddImage(const ProductSpec & productSpec, const char * version, const IntegritySpec & integritySpec,
+                                      const char * uri, uint64_t length, void * appState)
+{
+    WEAVE_ERROR err          = WEAVE_NO_ERROR;
+    WeaveCachedImage * image = NULL;
+
+    VerifyOrExit(strlen(version) <= WEAVE_CONFIG_MAX_SOFTWARE_VERSION_LENGTH, err = WEAVE_ERROR_INVALID_ARGUMENT);
+    VerifyOrExit(strlen(uri) <= WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_URI_LENGTH, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    // Replace the image cached for the product, if any, or else take a free entry.
+    for (size_t i = 0; i < WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE; i++)
+    {
+        if (mImages[i].mInUse && mImages[i].productSpec == productSpec)
+        {
+            image = &mImages[i];
+            break;
+        }
+
+        if (!mImages[i].mInUse && image == NULL)
+        {
+            image = &mImages[i];
+        }
+    }
+
+    VerifyOrExit(image != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    VerifyOrExit(image->mActiveTransfers == 0, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    image->productSpec   = productSpec;
+    image->integritySpec = integritySpec;
+    image->length        = length;
+    image->appState      = appState;
+    strcpy(image->version, version);
+    strcpy(image->uri, uri);
+    image->mCache = this;
+    image->mInUse = true;
+
+    AnnounceImage(productSpec);
+
+exit:
+    return err;
+}
+
+/**
+ * Removes an image from the cache.
+ *
+ * @param[in] uri   The URI the image is offered at
+ *
+ * @retval WEAVE_NO_ERROR               On success.
+ * @retval WEAVE_ERROR_KEY_NOT_FOUND    If no image is cached at the URI.
+ * @retval WEAVE_ERROR_INCORRECT_STATE  If the image is being served.
+ */
+WEAVE_ERROR WeaveImageCache::RemoveImage(const char * uri)
+{
+    WEAVE_ERROR err          = WEAVE_NO_ERROR;
+    WeaveCachedImage * image = const_cast<WeaveCachedImage *>(FindImage(uri, static_cast<uint16_t>(strlen(uri))));
+
+    VerifyOrExit(image != NULL, err = WEAVE_ERROR_KEY_NOT_FOUND);
+    VerifyOrExit(image->mActiveTransfers == 0, err = WEAVE_ERROR_INCORRECT_STATE);
+
+    image->mInUse = false;
+
+exit:
+    return err;
+}
+
+/**
+ * Finds the cached image that can be offered in response to an image query:
+ * one for the product of the query, with an integrity type the query lists,
+ * if the query lists BDX among its update schemes.  The image may be the
+ * version already installed.
+ *
+ * @param[in] query     The image query
+ *
+ * @return The cached image, or NULL if there is none
+ */
+const WeaveCachedImage * WeaveImageCache::FindImage(const ImageQuery & query) const
+{
+    bool bdxSupported = false;
+
+    for (uint8_t i = 0; i < query.updateSchemes.theLength; i++)
+    {
+        if (query.updateSchemes.theList[i] == kUpdateScheme_BDX)
+        {
+            bdxSupported = true;
+        }
+    }
+
+    if (!bdxSupported)
+    {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE; i++)
+    {
+        const WeaveCachedImage & image = mImages[i];
+
+        if (!image.mInUse || !(image.productSpec == query.productSpec))
+        {
+            continue;
+        }
+
+        for (uint8_t j = 0; j < query.integrityTypes.theLength; j++)
+        {
+            if (query.integrityTypes.theList[j] == image.integritySpec.type)
+            {
+                return &image;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Finds the cached image offered at a URI.
+ *
+ * @param[in] uri       The URI, which need not be NUL-terminated
+ * @param[in] uriLen    The length of the URI
+ *
+ * @return The cached image, or NULL if there is none
+ */
+const WeaveCachedImage * WeaveImageCache::FindImage(const char * uri, uint16_t uriLen) const
+{
+    for (size_t i = 0; i < WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE; i++)
+    {
+        const WeaveCachedImage & image = mImages[i];
+
+        if (image.mInUse && strlen(image.uri) == uriLen && memcmp(image.uri, uri, uriLen) == 0)
+        {
+            return &image;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Accepts a BDX ReceiveInit for a cached image and sets up the transfer to
+ * serve it.  The application calls this from the ReceiveInitHandler of its
+ * BdxServer, and may handle the file designators of the images the cache
+ * does not hold itself.
+ *
+ * @param[in] xfer          The transfer being set up
+ * @param[in] receiveInit   The ReceiveInit message
+ *
+ * @retval kStatus_NoError                  If the transfer was accepted.
+ * @retval kStatus_UnknownFile              If no image is cached at the file designator.
+ * @retval kStatus_StartOffsetNotSupported  If the start offset is beyond the end of the image.
+ */
+uint16_t WeaveImageCache::HandleReceiveInit(BDXTransfer * xfer, ReceiveInit * receiveInit)
+{
+    uint16_t status          = kStatus_NoError;
+    WeaveCachedImage * image = const_cast<WeaveCachedImage *>(
+        FindImage(receiveInit->mFileDesignator.theString, receiveInit->mFileDesignator.theLength));
+    BDXHandlers handlers = { NULL, NULL, NULL, HandleGetBlock, NULL, HandleXferError, HandleXferDone, HandleError };
+
+    VerifyOrExit(image != NULL, status = kStatus_UnknownFile);
+    VerifyOrExit(receiveInit->mStartOffset <= image->length, status = kStatus_StartOffsetNotSupported);
+
+    xfer->mStartOffset = receiveInit->mStartOffset;
+    xfer->mLength      = image->length - receiveInit->mStartOffset;
+    xfer->mBytesSent   = 0;
+
+    if (receiveInit->mLength != 0 && receiveInit->mLength < xfer->mLength)
+    {
+        xfer->mLength = receiveInit->mLength;
+    }
+
+    xfer->mAppState     = image;
+    xfer->mIsAccepted   = true;
+    xfer->mTransferMode = receiveInit->mReceiverDriveSupported ? kMode_ReceiverDrive : kMode_SenderDrive;
+    xfer->SetHandlers(handlers);
+
+    image->mActiveTransfers++;
+
+    WeaveLogProgress(SoftwareUpdate, "Serving cached image %s from offset %" PRIu64, image->uri, receiveInit->mStartOffset);
+
+exit:
+    return status;
+}
+
+void WeaveImageCache::HandleImageQuery(ExchangeContext * ec, const IPPacketInfo * pktInfo, const WeaveMessageInfo * msgInfo,
+                                       uint32_t profileId, uint8_t msgType, PacketBuffer * payload)
+{
+    WEAVE_ERROR err                = WEAVE_NO_ERROR;
+    WeaveImageCache * cache        = static_cast<WeaveImageCache *>(ec->AppState);
+    const WeaveCachedImage * image = NULL;
+    ImageQuery query;
+
+    err = ImageQuery::parse(payload, query);
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveServerBase::SendStatusReport(ec, kWeaveProfile_Common, Common::kStatus_BadRequest, err);
+        ExitNow();
+    }
+
+    image = cache->FindImage(query);
+
+    if (image != NULL)
+    {
+        if (strlen(image->version) == query.version.theLength &&
+            memcmp(image->version, query.version.theString, query.version.theLength) == 0)
+        {
+            err = WeaveServerBase::SendStatusReport(ec, kWeaveProfile_SWU, kStatus_NoUpdateAvailable, WEAVE_NO_ERROR);
+        }
+        else
+        {
+            err = cache->SendImageQueryResponse(ec, *image);
+        }
+
+        if (err != WEAVE_NO_ERROR)
+        {
+            WeaveLogError(SoftwareUpdate, "Failed to answer image query: %s", ErrorStr(err));
+        }
+
+        ExitNow();
+    }
+
+    // Announce the image to the device once it is added.  A proxied query is for its target node.
+    cache->AddWaiter((query.targetNodeId != 0) ? query.targetNodeId : msgInfo->SourceNodeId, query.productSpec);
+
+    if (cache->mDelegate == NULL)
+    {
+        WeaveServerBase::SendStatusReport(ec, kWeaveProfile_SWU, kStatus_NoUpdateAvailable, WEAVE_NO_ERROR);
+        ExitNow();
+    }
+
+    // The delegate closes the exchange and frees the payload.
+    cache->mDelegate->OnImageQueryMiss(ec, msgInfo, payload);
+    ec      = NULL;
+    payload = NULL;
+
+exit:
+    if (payload != NULL)
+    {
+        PacketBuffer::Free(payload);
+    }
+
+    if (ec != NULL)
+    {
+        ec->Close();
+    }
+}
+
+WEAVE_ERROR WeaveImageCache::SendImageQueryResponse(ExchangeContext * ec, const WeaveCachedImage & image)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    ImageQueryResponse response;
+    ReferencedString uri;
+    ReferencedString version;
+    IntegritySpec integritySpec = image.integritySpec;
+    PacketBuffer * buffer       = NULL;
+
+    err = uri.init(static_cast<uint16_t>(strlen(image.uri)), const_cast<char *>(image.uri));
+    SuccessOrExit(err);
+
+    err = version.init(static_cast<uint8_t>(strlen(image.version)), const_cast<char *>(image.version));
+    SuccessOrExit(err);
+
+    err = response.init(uri, version, integritySpec, kUpdateScheme_BDX, Normal, IfUnmatched, false);
+    SuccessOrExit(err);
+
+    buffer = PacketBuffer::New();
+    VerifyOrExit(buffer != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = response.pack(buffer);
+    SuccessOrExit(err);
+
+    err    = ec->SendMessage(kWeaveProfile_SWU, kMsgType_ImageQueryResponse, buffer);
+    buffer = NULL;
+
+exit:
+    if (buffer != NULL)
+    {
+        PacketBuffer::Free(buffer);
+    }
+
+    return err;
+}
+
+/*
+ * Remembers a device waiting for an image for a product.  When the table is
+ * full the device is not remembered; it finds the image at its next query.
+ */
+void WeaveImageCache::AddWaiter(uint64_t nodeId, const ProductSpec & productSpec)
+{
+    for (uint8_t i = 0; i < mNumWaiters; i++)
+    {
+        if (mWaiters[i].nodeId == nodeId)
+        {
+            mWaiters[i].productSpec = productSpec;
+            return;
+        }
+    }
+
+    if (mNumWaiters < WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_WAITERS)
+    {
+        mWaiters[mNumWaiters].nodeId      = nodeId;
+        mWaiters[mNumWaiters].productSpec = productSpec;
+        mNumWaiters++;
+    }
+}
+
+/*
+ * Sends an ImageAnnounce to the devices waiting for an image for a product,
+ * or multicasts a single one if there are many of them, and forgets them.
+ */
+void WeaveImageCache::AnnounceImage(const ProductSpec & productSpec)
+{
+    WEAVE_ERROR err    = WEAVE_NO_ERROR;
+    uint8_t numWaiting = 0;
+    uint8_t numKept    = 0;
+    bool multicast;
+
+    if (mExchangeMgr == NULL)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < mNumWaiters; i++)
+    {
+        if (mWaiters[i].productSpec == productSpec)
+        {
+            numWaiting++;
+        }
+    }
+
+    multicast = (WEAVE_CONFIG_SWU_IMAGE_CACHE_MULTICAST_THRESHOLD != 0 &&
+                 numWaiting >= WEAVE_CONFIG_SWU_IMAGE_CACHE_MULTICAST_THRESHOLD);
+
+    if (multicast)
+    {
+        err = SendImageAnnounce(kAnyNodeId);
+        if (err != WEAVE_NO_ERROR)
+        {
+            WeaveLogError(SoftwareUpdate, "Failed to multicast ImageAnnounce: %s", ErrorStr(err));
+        }
+    }
+
+    for (uint8_t i = 0; i < mNumWaiters; i++)
+    {
+        if (!(mWaiters[i].productSpec == productSpec))
+        {
+            mWaiters[numKept++] = mWaiters[i];
+            continue;
+        }
+
+        if (!multicast)
+        {
+            err = SendImageAnnounce(mWaiters[i].nodeId);
+            if (err != WEAVE_NO_ERROR)
+            {
+                WeaveLogError(SoftwareUpdate, "Failed to send ImageAnnounce to %" PRIX64 ": %s", mWaiters[i].nodeId, ErrorStr(err));
+            }
+        }
+    }
+
+    mNumWaiters = numKept;
+}
+
+WEAVE_ERROR WeaveImageCache::SendImageAnnounce(uint64_t nodeId)
+{
+    WEAVE_ERROR err       = WEAVE_NO_ERROR;
+    ExchangeContext * ec  = NULL;
+    PacketBuffer * buffer = NULL;
+
+    ec = mExchangeMgr->NewContext(nodeId, this);
+    VerifyOrExit(ec != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    buffer = PacketBuffer::New();
+    VerifyOrExit(buffer != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err    = ec->SendMessage(kWeaveProfile_SWU, kMsgType_ImageAnnounce, buffer);
+    buffer = NULL;
+
+exit:
+    if (buffer != NULL)
+    {
+        PacketBuffer::Free(buffer);
+    }
+
+    if (ec != NULL)
+    {
+        ec->Close();
+    }
+
+    return err;
+}
+
+void WeaveImageCache::HandleGetBlock(BDXTransfer * xfer, uint64_t * length, uint8_t ** dataBlock, bool * isLastBlock)
+{
+    WEAVE_ERROR err                = WEAVE_NO_ERROR;
+    const WeaveCachedImage * image = static_cast<const WeaveCachedImage *>(xfer->mAppState);
+    uint64_t remaining             = xfer->mLength - xfer->mBytesSent;
+    uint32_t blockLength           = static_cast<uint32_t>((*length < remaining) ? *length : remaining);
+
+    // The block is read in place, into the message being sent.
+    VerifyOrExit(image->mCache->mDelegate != NULL, err = WEAVE_ERROR_INCORRECT_STATE);
+    err = image->mCache->mDelegate->ReadCachedImage(*image, xfer->mStartOffset + xfer->mBytesSent, *dataBlock, blockLength);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        // End the image short; the device then fails its integrity check.
+        WeaveLogError(SoftwareUpdate, "Failed to read cached image %s: %s", image->uri, ErrorStr(err));
+        blockLength = 0;
+        xfer->mBytesSent = xfer->mLength;
+    }
+
+    xfer->mBytesSent += blockLength;
+
+    *length      = blockLength;
+    *isLastBlock = (xfer->mBytesSent == xfer->mLength);
+}
+
+void WeaveImageCache::HandleXferError(BDXTransfer * xfer, StatusReport * xferError)
+{
+    WeaveLogError(SoftwareUpdate, "Cached image transfer failed: %d", xferError->mStatusCode);
+
+    EndTransfer(xfer);
+}
+
+void WeaveImageCache::HandleXferDone(BDXTransfer * xfer)
+{
+    EndTransfer(xfer);
+}
+
+void WeaveImageCache::HandleError(BDXTransfer * xfer, WEAVE_ERROR errorCode)
+{
+    WeaveLogError(SoftwareUpdate, "Cached image transfer error: %s", ErrorStr(errorCode));
+
+    EndTransfer(xfer);
+}
+
+void WeaveImageCache::EndTransfer(BDXTransfer * xfer)
+{
+    WeaveCachedImage * image = static_cast<WeaveCachedImage *>(xfer->mAppState);
+
+    image->mActiveTransfers--;
+
+    xfer->Shutdown();
+}
+
+} // namespace SoftwareUpdate
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
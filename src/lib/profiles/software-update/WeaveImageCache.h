@@ -0,0 +1,157 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a software image cache, with which a gateway
+ *      serves the software images it holds to the devices of its local
+ *      fabric, rather than each device fetching them from the service.
+ */
+
+#ifndef _WEAVE_IMAGE_CACHE_H
+#define _WEAVE_IMAGE_CACHE_H
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BulkDataTransfer.h>
+#include <Weave/Support/NLDLLUtil.h>
+#include "SoftwareUpdateProfile.h"
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace SoftwareUpdate {
+
+class WeaveImageCache;
+
+/**
+ * An image held by a WeaveImageCache.
+ */
+struct WeaveCachedImage
+{
+    ProductSpec productSpec;     /**< The product the image is for. */
+    IntegritySpec integritySpec; /**< The integrity specification of the image. */
+    uint64_t length;             /**< The length of the image. */
+    void * appState;             /**< Application state identifying the stored image, e.g. its file. */
+    char version[WEAVE_CONFIG_MAX_SOFTWARE_VERSION_LENGTH + 1];   /**< The software version of the image. */
+    char uri[WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_URI_LENGTH + 1];     /**< The URI, and BDX file designator, it is served at. */
+
+private:
+    friend class WeaveImageCache;
+
+    WeaveImageCache * mCache;
+    uint8_t mActiveTransfers;
+    bool mInUse;
+};
+
+/**
+ * Interface for the WeaveImageCache delegate, which stores the cached
+ * images and handles the image queries the cache cannot answer.
+ */
+class IWeaveImageCacheDelegate
+{
+public:
+    /**
+     * Called for an image query the cache has no image for.
+     *
+     * The delegate typically forwards the query to the service and, once
+     * it has downloaded the image offered in response, adds it to the
+     * cache, which then announces it to the devices waiting for it.
+     *
+     * @param[in] ec        The exchange the query was received on, which the delegate must close.
+     * @param[in] msgInfo   The message information of the query.
+     * @param[in] payload   The image query payload, which the delegate must free.
+     */
+    virtual void OnImageQueryMiss(ExchangeContext * ec, const WeaveMessageInfo * msgInfo, PacketBuffer * payload) = 0;
+
+    /**
+     * Reads part of a cached image, to serve it over BDX.
+     *
+     * @param[in]   image   The cached image
+     * @param[in]   offset  The offset of the part within the image
+     * @param[out]  buf     A buffer to read the part into
+     * @param[in]   length  The length of the part
+     */
+    virtual WEAVE_ERROR ReadCachedImage(const WeaveCachedImage & image, uint64_t offset, uint8_t * buf, uint32_t length) = 0;
+};
+
+/**
+ * A cache of software images, with which a gateway answers the image queries
+ * of the devices on its local fabric and serves them the images over BDX.
+ *
+ * The cache answers the image queries for the products it holds an image for,
+ * offering the image at its URI.  The queries it cannot answer go to its
+ * delegate, and the devices that sent them are remembered; when an image for
+ * their product is added, they are sent an ImageAnnounce, so that they query
+ * again and download the image from the gateway.  When many devices wait for
+ * the same image, a single ImageAnnounce is multicast to all the nodes of the
+ * link instead.
+ *
+ * The application serves the images with its BdxServer, by calling
+ * HandleReceiveInit() from its ReceiveInitHandler.
+ */
+class NL_DLL_EXPORT WeaveImageCache
+{
+public:
+    WeaveImageCache(void);
+
+    WEAVE_ERROR Init(WeaveExchangeManager * exchangeManager, IWeaveImageCacheDelegate * delegate);
+    WEAVE_ERROR Shutdown(void);
+    void SetDelegate(IWeaveImageCacheDelegate * delegate);
+
+    WEAVE_ERROR AddImage(const ProductSpec & productSpec, const char * version, const IntegritySpec & integritySpec,
+                         const char * uri, uint64_t length, void * appState);
+    WEAVE_ERROR RemoveImage(const char * uri);
+
+    const WeaveCachedImage * FindImage(const ImageQuery & query) const;
+    const WeaveCachedImage * FindImage(const char * uri, uint16_t uriLen) const;
+
+    uint16_t HandleReceiveInit(BulkDataTransfer::BDXTransfer * xfer, BulkDataTransfer::ReceiveInit * receiveInit);
+
+private:
+    struct Waiter
+    {
+        uint64_t nodeId;
+        ProductSpec productSpec;
+    };
+
+    static void HandleImageQuery(ExchangeContext * ec, const IPPacketInfo * pktInfo, const WeaveMessageInfo * msgInfo,
+                                 uint32_t profileId, uint8_t msgType, PacketBuffer * payload);
+    static void HandleGetBlock(BulkDataTransfer::BDXTransfer * xfer, uint64_t * length, uint8_t ** dataBlock, bool * isLastBlock);
+    static void HandleXferError(BulkDataTransfer::BDXTransfer * xfer, StatusReporting::StatusReport * xferError);
+    static void HandleXferDone(BulkDataTransfer::BDXTransfer * xfer);
+    static void HandleError(BulkDataTransfer::BDXTransfer * xfer, WEAVE_ERROR errorCode);
+    static void EndTransfer(BulkDataTransfer::BDXTransfer * xfer);
+
+    WEAVE_ERROR SendImageQueryResponse(ExchangeContext * ec, const WeaveCachedImage & image);
+    void AddWaiter(uint64_t nodeId, const ProductSpec & productSpec);
+    void AnnounceImage(const ProductSpec & productSpec);
+    WEAVE_ERROR SendImageAnnounce(uint64_t nodeId);
+
+    WeaveExchangeManager * mExchangeMgr;
+    IWeaveImageCacheDelegate * mDelegate;
+    WeaveCachedImage mImages[WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE];
+    Waiter mWaiters[WEAVE_CONFIG_SWU_IMAGE_CACHE_MAX_WAITERS];
+    uint8_t mNumWaiters;
+};
+
+} // namespace SoftwareUpdate
+} // namespace Profiles
+} // namespace Weave
+} // namespace nl
+
+#endif // _WEAVE_IMAGE_CACHE_H
@@ -420,6 +420,16 @@ struct NL_DLL_EXPORT Contact
     /// this is the timestamp when the response was received.
     /// only valid if response is not kResponseStatus_Invalid
     timesync_t mUnadjTimestampLastContact_usec;
+
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+    /// exchange context of the request outstanding to this contact during a parallel sync.
+    /// only valid when mCommState is kCommState_Active
+    ExchangeContext * mExchangeContext;
+
+    /// unadjusted timestamp of the request outstanding to this contact during a parallel sync.
+    /// only valid when mExchangeContext is not NULL
+    timesync_t mUnadjTimestampLastSent_usec;
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
 };
 
 /// used to specify contacts for calling SyncWithNodes
@@ -889,6 +899,20 @@ protected:
     /// note it has to be boot time as we need compensation for sleep time
     timesync_t mTimestampLastLocalSync_usec;
 
+    /// boot time at which the sync status fields of responses were last computed,
+    /// or TIMESYNC_INVALID if they have to be computed for the next request
+    timesync_t mTimestampResponseCache_usec;
+
+    /// time since last sync with server, as computed at mTimestampResponseCache_usec
+    uint16_t mCachedTimeSinceLastSyncWithServer_min;
+
+    /// compute the time since last sync with server to be reported in a response,
+    /// and expire the number of contributors if the last local sync is too old
+    uint16_t ComputeTimeSinceLastSyncWithServer(const timesync_t aUnadjTimestamp_usec);
+
+    /// force the sync status fields of the next response to be computed afresh
+    void InvalidateResponseCache(void);
+
     /**
      * initialize for the Server role.
      * Intended to be used internally by Init family of public functions.
@@ -958,6 +982,11 @@ protected:
     timesync_t mUnadjTimestampLastSent_usec;
     //@}
 
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+    /// number of usable responses collected in the current round of a parallel sync
+    int16_t mNumParallelResponses;
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+
 #if WEAVE_CONFIG_TIME_CLIENT_FABRIC_LOCAL_DISCOVERY
     int8_t mLastLikelihoodSent;
 #endif // WEAVE_CONFIG_TIME_CLIENT_FABRIC_LOCAL_DISCOVERY
@@ -1069,6 +1098,28 @@ protected:
     /// so caller shall check both the return code and *rIsMessageSent.
     WEAVE_ERROR SendSyncRequest(bool * const rIsMessageSent, Contact * const aContact);
 
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+    /// send unicast sync requests to all idle contacts at once, each on its own exchange context.
+    /// running out of exchange contexts is not an error as long as some request is outstanding;
+    /// the remaining contacts are left idle and contacted when a response or timeout frees a context.
+    WEAVE_ERROR SendParallelSyncRequests(void);
+
+    /// get the number of contacts with a parallel sync request outstanding
+    int16_t GetNumActiveContacts(void);
+
+    /// find the contact whose parallel sync request is carried by an exchange context
+    Contact * FindContactByExchange(const ExchangeContext * const aEC);
+
+    /// close the exchange context of a parallel sync request
+    void CloseParallelCommContext(Contact * const aContact);
+
+    /// cancel all outstanding parallel sync requests, and consider all contacts done for this round
+    void CancelParallelSyncRequests(void);
+
+    /// decide the next step after a parallel sync request has completed in state Sync_1 or Sync_2
+    void ContinueParallelSync(const ClientState aState);
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+
     void SetClientState(const ClientState state);
     const char * const GetClientStateName(void) const;
 
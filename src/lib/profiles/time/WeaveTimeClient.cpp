@@ -120,6 +120,9 @@ WEAVE_ERROR TimeSyncNode::_InitClient(const uint8_t aEncryptionType,
     mActiveContact = NULL;
     mExchangeContext = NULL;
     mUnadjTimestampLastSent_usec = 0;
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+    mNumParallelResponses = 0;
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
 
 exit:
     WeaveLogFunctError(err);
@@ -271,6 +274,9 @@ void TimeSyncNode::InvalidateAllContacts(void)
     {
         mContacts[i].mCommState = uint8_t(kCommState_Invalid);
         mContacts[i].mResponseStatus = uint8_t(kResponseStatus_Invalid);
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+        mContacts[i].mExchangeContext = NULL;
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
     }
 
 #if WEAVE_CONFIG_TIME_CLIENT_CONNECTION_FOR_SERVICE
@@ -556,6 +562,9 @@ WEAVE_ERROR TimeSyncNode::Abort(void)
 #endif // WEAVE_CONFIG_TIME_CLIENT_FABRIC_LOCAL_DISCOVERY
 
         DestroyCommContext();
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+        CancelParallelSyncRequests();
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
 
         if (IsOperationalState(state))
         {
@@ -717,12 +726,153 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+WEAVE_ERROR TimeSyncNode::SendParallelSyncRequests(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    Contact * contact = NULL;
+    bool isMessageSent = false;
+
+    while (NULL != (contact = GetNextIdleContact()))
+    {
+        err = SendSyncRequest(&isMessageSent, contact);
+        if ((WEAVE_NO_ERROR != err) && (GetNumActiveContacts() > 0))
+        {
+            // we're out of resources, but some requests are already on their way.
+            // leave this contact idle, so it can be contacted once one of them completes
+            WeaveLogDetail(TimeService, "Deferring request to node %" PRIX64, contact->mNodeId);
+            contact->mCommState = uint8_t(kCommState_Idle);
+            ExitNow(err = WEAVE_NO_ERROR);
+        }
+        SuccessOrExit(err);
+
+        if (isMessageSent)
+        {
+            // hand the exchange context over to the contact, so the next request can have its own
+            contact->mExchangeContext = mExchangeContext;
+            contact->mUnadjTimestampLastSent_usec = mUnadjTimestampLastSent_usec;
+            mExchangeContext = NULL;
+            mActiveContact = NULL;
+            mUnadjTimestampLastSent_usec = TIMESYNC_INVALID;
+        }
+    }
+
+exit:
+    WeaveLogFunctError(err);
+
+    return err;
+}
+
+int16_t TimeSyncNode::GetNumActiveContacts(void)
+{
+    int16_t rCountActiveContact = 0;
+
+    for (int i = 0; i < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++i)
+    {
+        if (NULL != mContacts[i].mExchangeContext)
+        {
+            ++rCountActiveContact;
+        }
+    }
+
+    return rCountActiveContact;
+}
+
+Contact * TimeSyncNode::FindContactByExchange(const ExchangeContext * const aEC)
+{
+    Contact * rContact = NULL;
+
+    for (int i = 0; i < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++i)
+    {
+        if (aEC == mContacts[i].mExchangeContext)
+        {
+            rContact = &mContacts[i];
+
+            break;
+        }
+    }
+
+    return rContact;
+}
+
+void TimeSyncNode::CloseParallelCommContext(Contact * const aContact)
+{
+    if (NULL != aContact->mExchangeContext)
+    {
+        aContact->mExchangeContext->Close();
+        aContact->mExchangeContext = NULL;
+    }
+    aContact->mUnadjTimestampLastSent_usec = TIMESYNC_INVALID;
+}
+
+void TimeSyncNode::CancelParallelSyncRequests(void)
+{
+    for (int i = 0; i < WEAVE_CONFIG_TIME_CLIENT_MAX_NUM_CONTACTS; ++i)
+    {
+        CloseParallelCommContext(&mContacts[i]);
+
+        // cancelled requests are not held against the contact
+        if ((uint8_t(kCommState_Idle) == mContacts[i].mCommState)
+            || (uint8_t(kCommState_Active) == mContacts[i].mCommState))
+        {
+            mContacts[i].mCommState = uint8_t(kCommState_Completed);
+        }
+    }
+}
+
+void TimeSyncNode::ContinueParallelSync(const ClientState aState)
+{
+    if ((WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC_MIN_RESPONSES > 0)
+        && (mNumParallelResponses >= WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC_MIN_RESPONSES))
+    {
+        WeaveLogDetail(TimeService, "Collected %d responses, cancelling the rest", mNumParallelResponses);
+        CancelParallelSyncRequests();
+    }
+
+    if (0 == GetNumNotYetCompletedContacts())
+    {
+        if (kClientState_Sync_1 == aState)
+        {
+            // every contact has responded or timed out, move to Sync_2
+            SetAllCompletedContactsToIdle();
+            EnterState_Sync_2();
+        }
+        else
+        {
+            // we have no more nodes to contact, try to calculate a time fix
+            EndLocalSyncAndTryCalculateTimeFix();
+        }
+    }
+    else if ((NULL != GetNextIdleContact()) || (0 == GetNumActiveContacts()))
+    {
+        // some contacts could not be reached for lack of exchange contexts.
+        // re-enter the same state to send them requests now that one is free,
+        // or to move on if there is nothing left to wait for
+        if (kClientState_Sync_1 == aState)
+        {
+            EnterState_Sync_1();
+        }
+        else
+        {
+            EnterState_Sync_2();
+        }
+    }
+    else
+    {
+        // keep waiting for the outstanding requests to complete
+    }
+}
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+
 void TimeSyncNode::EnterState_Sync_1(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
+#if !WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
     Contact * contact = NULL;
     bool isMessageSent = false;
+#endif // !WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
 
     switch (GetClientState())
     {
@@ -735,11 +885,25 @@ void TimeSyncNode::EnterState_Sync_1(void)
     case kClientState_Sync_Discovery:
 #endif // WEAVE_CONFIG_TIME_CLIENT_FABRIC_LOCAL_DISCOVERY
         SetClientState(kClientState_Sync_1);
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+        mNumParallelResponses = 0;
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
         break;
     default:
         ExitNow(err = WEAVE_ERROR_INCORRECT_STATE);
     }
 
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+    err = SendParallelSyncRequests();
+    SuccessOrExit(err);
+
+    if (0 == GetNumActiveContacts())
+    {
+        // no one left for us to wait for, move to Sync_2 anyways
+        SetAllCompletedContactsToIdle();
+        EnterState_Sync_2();
+    }
+#else // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
     do
     {
         contact = GetNextIdleContact();
@@ -756,6 +920,7 @@ void TimeSyncNode::EnterState_Sync_1(void)
         SuccessOrExit(err);
     }
     while (!isMessageSent);
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
 
 exit:
     WeaveLogFunctError(err);
@@ -768,8 +933,10 @@ void TimeSyncNode::EnterState_Sync_2(void)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
+#if !WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
     Contact * contact = NULL;
     bool isMessageSent = false;
+#endif // !WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
 
     switch (GetClientState())
     {
@@ -782,11 +949,24 @@ void TimeSyncNode::EnterState_Sync_2(void)
     case kClientState_Sync_Discovery:
 #endif // WEAVE_CONFIG_TIME_CLIENT_FABRIC_LOCAL_DISCOVERY
         SetClientState(kClientState_Sync_2);
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+        mNumParallelResponses = 0;
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
         break;
     default:
         ExitNow(err = WEAVE_ERROR_INCORRECT_STATE);
     }
 
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+    err = SendParallelSyncRequests();
+    SuccessOrExit(err);
+
+    if (0 == GetNumActiveContacts())
+    {
+        // we have no more nodes to wait for, try to calculate a time fix or fail
+        EndLocalSyncAndTryCalculateTimeFix();
+    }
+#else // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
     do
     {
         // try to get the next contact to reach
@@ -803,6 +983,7 @@ void TimeSyncNode::EnterState_Sync_2(void)
         SuccessOrExit(err);
 
     } while (!isMessageSent);
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
 
 exit:
     WeaveLogFunctError(err);
@@ -1731,6 +1912,9 @@ void TimeSyncNode::HandleUnicastSyncResponse(ExchangeContext *ec, const IPPacket
     TimeSyncNode * const client = reinterpret_cast<TimeSyncNode *>(ec->AppState);
     TimeSyncResponse response;
     const TimeSyncNode::ClientState ClientStateAtEntry(client->GetClientState());
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+    Contact * contact = NULL;
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
 
     if (kTimeMessageType_TimeSyncResponse != msgType)
     {
@@ -1750,6 +1934,37 @@ void TimeSyncNode::HandleUnicastSyncResponse(ExchangeContext *ec, const IPPacket
             ExitNow(err = WEAVE_ERROR_UNSUPPORTED_AUTH_MODE);
         }
 
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+        contact = client->FindContactByExchange(ec);
+        if (NULL != contact)
+        {
+            // the response is to one of the parallel requests
+            client->mActiveContact = contact;
+            client->mUnadjTimestampLastSent_usec = contact->mUnadjTimestampLastSent_usec;
+            client->UpdateUnicastSyncResponse(response);
+            client->mActiveContact = NULL;
+            client->mUnadjTimestampLastSent_usec = TIMESYNC_INVALID;
+
+            if (uint8_t(kCommState_Active) == contact->mCommState)
+            {
+                // the response could not be used, but this contact is done for this round
+                contact->mCommState = uint8_t(kCommState_Completed);
+            }
+
+            if ((uint8_t(kResponseStatus_ReliableResponse) == contact->mResponseStatus)
+                || (uint8_t(kResponseStatus_LessReliableResponse) == contact->mResponseStatus))
+            {
+                ++client->mNumParallelResponses;
+            }
+
+            client->CloseParallelCommContext(contact);
+            ec = NULL;
+
+            client->ContinueParallelSync(ClientStateAtEntry);
+            ExitNow();
+        }
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+
         // now we believe we have received a response from the node we intend to hear from
         // update the record now
         client->UpdateUnicastSyncResponse(response);
@@ -2085,6 +2300,22 @@ void TimeSyncNode::HandleUnicastResponseTimeout(ExchangeContext * const ec)
     WeaveLogDetail(TimeService, "Unicast just timed out at client state: %d (%s)", client->GetClientState(),
         client->GetClientStateName());
 
+#if WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+    if ((kClientState_Sync_1 == ClientStateAtEntry) || (kClientState_Sync_2 == ClientStateAtEntry))
+    {
+        Contact * const parallelContact = client->FindContactByExchange(ec);
+
+        if (NULL != parallelContact)
+        {
+            // one of the parallel requests timed out
+            client->CloseParallelCommContext(parallelContact);
+            client->RegisterCommError(parallelContact);
+            client->ContinueParallelSync(ClientStateAtEntry);
+            return;
+        }
+    }
+#endif // WEAVE_CONFIG_TIME_CLIENT_PARALLEL_SYNC
+
     // close this context as timeout
     client->DestroyCommContext();
 
@@ -84,7 +84,9 @@ TimeSyncNode::TimeSyncNode() :
     mIsAlwaysFresh(false),
     mNumContributorInLastLocalSync(0),
     mTimestampLastCorrectionFromServerOrNtp_usec(TIMESYNC_INVALID),
-    mTimestampLastLocalSync_usec(TIMESYNC_INVALID)
+    mTimestampLastLocalSync_usec(TIMESYNC_INVALID),
+    mTimestampResponseCache_usec(TIMESYNC_INVALID),
+    mCachedTimeSinceLastSyncWithServer_min(TimeSyncResponse::kTimeSinceLastSyncWithServer_Invalid)
 #endif // WEAVE_CONFIG_TIME_ENABLE_SERVER
 
 #if WEAVE_CONFIG_TIME_ENABLE_CLIENT
@@ -215,6 +217,7 @@ void TimeSyncNode::ClearState(void)
     mNumContributorInLastLocalSync = 0;
     mTimestampLastCorrectionFromServerOrNtp_usec = TIMESYNC_INVALID;
     mTimestampLastLocalSync_usec = TIMESYNC_INVALID;
+    InvalidateResponseCache();
 #endif // WEAVE_CONFIG_TIME_ENABLE_SERVER
 
 #if WEAVE_CONFIG_TIME_ENABLE_CLIENT
@@ -310,6 +313,7 @@ WEAVE_ERROR TimeSyncNode::_InitServer(const bool aIsAlwaysFresh)
     mNumContributorInLastLocalSync = 0;
     mTimestampLastCorrectionFromServerOrNtp_usec = TIMESYNC_INVALID;
     mTimestampLastLocalSync_usec = TIMESYNC_INVALID;
+    InvalidateResponseCache();
 
     // Register to receive unsolicited time sync request messages from the exchange manager.
     err = GetExchangeMgr()->RegisterUnsolicitedMessageHandler(kWeaveProfile_Time, kTimeMessageType_TimeSyncRequest,
@@ -383,6 +387,7 @@ void TimeSyncNode::HandleUnreliableAfterBootTimer(System::Layer* aSystemLayer, v
     }
 
     server->mServerState = kServerState_Idle;
+    server->InvalidateResponseCache();
 
     WEAVE_TIME_PROGRESS_LOG(TimeService, "Server entered IDLE state, reason 2");
 
@@ -451,56 +456,24 @@ void TimeSyncNode::HandleSyncRequest(ExchangeContext *ec, const IPPacketInfo *pk
     if (shouldReply)
     {
         TimeSyncResponse response;
-        uint16_t timeSinceLastSyncWithServer_min = TimeSyncResponse::kTimeSinceLastSyncWithServer_Invalid;
-        timesync_t timeSinceLastLocaSync_usec;
+        uint16_t timeSinceLastSyncWithServer_min;
 
         // note it has to be monotonic time as we need compensation for sleep time
         timesync_t unadjTimestamp_usec = GetClock_Monotonic();
 
-        timeSinceLastLocaSync_usec = unadjTimestamp_usec - server->mTimestampLastLocalSync_usec;
-        if ((TIMESYNC_INVALID == server->mTimestampLastLocalSync_usec) ||
-            (timeSinceLastLocaSync_usec >= (3600 * 1000000LL)))
+#if WEAVE_CONFIG_TIME_SERVER_RESPONSE_CACHE_MSEC > 0
+        // when many clients sync at once, reuse the status fields computed for the first of them.
+        // the time of response itself is never cached
+        if ((TIMESYNC_INVALID != server->mTimestampResponseCache_usec) &&
+            ((unadjTimestamp_usec - server->mTimestampResponseCache_usec) <
+                (timesync_t(WEAVE_CONFIG_TIME_SERVER_RESPONSE_CACHE_MSEC) * 1000)))
         {
-            server->mNumContributorInLastLocalSync = 0;
-        }
-
-        if (server->mIsAlwaysFresh)
-        {
-            if (kServerState_UnreliableAfterBoot != server->mServerState)
-            {
-                timeSinceLastSyncWithServer_min = 0;
-                WeaveLogDetail(TimeService, "Server is always fresh and has passed initial phase");
-            }
-            else
-            {
-                // invalid age
-                WeaveLogDetail(TimeService, "Server is still unreliable after boot");
-            }
+            timeSinceLastSyncWithServer_min = server->mCachedTimeSinceLastSyncWithServer_min;
         }
         else
+#endif // WEAVE_CONFIG_TIME_SERVER_RESPONSE_CACHE_MSEC > 0
         {
-            if (TIMESYNC_INVALID != server->mTimestampLastCorrectionFromServerOrNtp_usec)
-            {
-                const timesync_t age_min = Platform::Divide(
-                    (unadjTimestamp_usec - server->mTimestampLastCorrectionFromServerOrNtp_usec), (60 * 1000000));
-
-                if (age_min < TimeSyncResponse::kTimeSinceLastSyncWithServer_Max)
-                {
-                    timeSinceLastSyncWithServer_min = uint16_t(age_min);
-
-                    WeaveLogDetail(TimeService, "Returning age %d min", timeSinceLastSyncWithServer_min);
-                }
-                else
-                {
-                    // invalid age
-                    WeaveLogDetail(TimeService, "Server synced with reliable source too long ago");
-                }
-            }
-            else
-            {
-                // invalid age;
-                WeaveLogDetail(TimeService, "Server hasn't synced with reliable source");
-            }
+            timeSinceLastSyncWithServer_min = server->ComputeTimeSinceLastSyncWithServer(unadjTimestamp_usec);
         }
 
         // obtain real time (note zero-initializer is skipped to save code space)
@@ -556,12 +529,75 @@ TimeSyncNode::ServerState TimeSyncNode::GetServerState(void) const
 void TimeSyncNode::RegisterCorrectionFromServerOrNtp(void)
 {
     mTimestampLastCorrectionFromServerOrNtp_usec = GetClock_Monotonic();
+    InvalidateResponseCache();
 }
 
 void TimeSyncNode::RegisterLocalSyncOperation(const uint8_t aNumContributor)
 {
     mTimestampLastLocalSync_usec = GetClock_Monotonic();
     mNumContributorInLastLocalSync = aNumContributor;
+    InvalidateResponseCache();
+}
+
+uint16_t TimeSyncNode::ComputeTimeSinceLastSyncWithServer(const timesync_t aUnadjTimestamp_usec)
+{
+    uint16_t timeSinceLastSyncWithServer_min = TimeSyncResponse::kTimeSinceLastSyncWithServer_Invalid;
+    const timesync_t timeSinceLastLocaSync_usec = aUnadjTimestamp_usec - mTimestampLastLocalSync_usec;
+
+    if ((TIMESYNC_INVALID == mTimestampLastLocalSync_usec) ||
+        (timeSinceLastLocaSync_usec >= (3600 * 1000000LL)))
+    {
+        mNumContributorInLastLocalSync = 0;
+    }
+
+    if (mIsAlwaysFresh)
+    {
+        if (kServerState_UnreliableAfterBoot != mServerState)
+        {
+            timeSinceLastSyncWithServer_min = 0;
+            WeaveLogDetail(TimeService, "Server is always fresh and has passed initial phase");
+        }
+        else
+        {
+            // invalid age
+            WeaveLogDetail(TimeService, "Server is still unreliable after boot");
+        }
+    }
+    else
+    {
+        if (TIMESYNC_INVALID != mTimestampLastCorrectionFromServerOrNtp_usec)
+        {
+            const timesync_t age_min = Platform::Divide(
+                (aUnadjTimestamp_usec - mTimestampLastCorrectionFromServerOrNtp_usec), (60 * 1000000));
+
+            if (age_min < TimeSyncResponse::kTimeSinceLastSyncWithServer_Max)
+            {
+                timeSinceLastSyncWithServer_min = uint16_t(age_min);
+
+                WeaveLogDetail(TimeService, "Returning age %d min", timeSinceLastSyncWithServer_min);
+            }
+            else
+            {
+                // invalid age
+                WeaveLogDetail(TimeService, "Server synced with reliable source too long ago");
+            }
+        }
+        else
+        {
+            // invalid age;
+            WeaveLogDetail(TimeService, "Server hasn't synced with reliable source");
+        }
+    }
+
+    mCachedTimeSinceLastSyncWithServer_min = timeSinceLastSyncWithServer_min;
+    mTimestampResponseCache_usec = aUnadjTimestamp_usec;
+
+    return timeSinceLastSyncWithServer_min;
+}
+
+void TimeSyncNode::InvalidateResponseCache(void)
+{
+    mTimestampResponseCache_usec = TIMESYNC_INVALID;
 }
 
 void TimeSyncNode::MulticastTimeChangeNotification(const uint8_t aEncryptionType, const uint16_t aKeyId) const
@@ -69,8 +69,16 @@ WeaveTunnelAgent::WeaveTunnelAgent()
 #endif
 
     mPeerNodeId               = 0;
-    qFront                    = TUNNEL_PACKET_QUEUE_INVALID_INDEX;
-    qRear                     = TUNNEL_PACKET_QUEUE_INVALID_INDEX;
+    memset(mQueues, 0, sizeof(mQueues));
+#if WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+    mSavedPrimaryLivenessInterval = 0;
+    mSavedBackupLivenessInterval  = 0;
+#endif // WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+    mAggregateMsg             = NULL;
+    mAggregateConnMgr         = NULL;
+    mNumAggregatedPkts        = 0;
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
     mTunAgentState            = kState_NotInitialized;
     mPeerNodeId               = kNodeIdNotSpecified;
     mServiceAddress           = IPAddress::Any;
@@ -173,9 +181,13 @@ WEAVE_ERROR WeaveTunnelAgent::ConfigureAndInit (InetLayer *inet, WeaveExchangeMa
     mRole                    = role;
     mAuthMode                = authMode;
     mAppContext              = appContext;
-    memset(queuedMsgs, 0, sizeof(queuedMsgs));
-    qFront                   = TUNNEL_PACKET_QUEUE_INVALID_INDEX;
-    qRear                    = TUNNEL_PACKET_QUEUE_INVALID_INDEX;
+    memset(mQueues, 0, sizeof(mQueues));
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+    mAggregateMsg            = NULL;
+    mAggregateConnMgr        = NULL;
+    mNumAggregatedPkts       = 0;
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+    mTunnelFlags             = 0;
 #if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
     memset(&mWeaveTunnelStats, 0, sizeof(mWeaveTunnelStats));
 #endif
@@ -212,6 +224,8 @@ WEAVE_ERROR WeaveTunnelAgent::ConfigureAndInit (InetLayer *inet, WeaveExchangeMa
 
     err = mTunShortcutControl.Init(this);
     SuccessOrExit(err);
+
+    InvalidateRouteCache();
 #endif
 
     // Initialize the WeaveTunnelConnectionMgr
@@ -229,6 +243,19 @@ WEAVE_ERROR WeaveTunnelAgent::ConfigureAndInit (InetLayer *inet, WeaveExchangeMa
 
 #endif // WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
 
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    // The parallel tunnels are primary tunnels over the same interface as the Primary tunnel.
+
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+    {
+#if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
+        mParallelTunConnMgrs[i].Init(this, kType_TunnelPrimary, kSrcInterface_WiFi, PRIMARY_TUNNEL_DEFAULT_INTF_NAME);
+#else
+        mParallelTunConnMgrs[i].Init(this, kType_TunnelPrimary, kSrcInterface_WiFi);
+#endif
+    }
+#endif // WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+
     // Register Recv function for TunEndPoint
 
     mTunEP->OnPacketReceived = RecvdFromTunnelEndPoint;
@@ -319,6 +346,13 @@ void WeaveTunnelAgent::SetTunnelingDeviceRole(const Role role)
 void WeaveTunnelAgent::SetPrimaryTunnelInterface(const char *primaryIntfName)
 {
     mPrimaryTunConnMgr.SetInterfaceName(primaryIntfName);
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+    {
+        mParallelTunConnMgrs[i].SetInterfaceName(primaryIntfName);
+    }
+#endif
 }
 
 /**
@@ -329,6 +363,13 @@ void WeaveTunnelAgent::SetPrimaryTunnelInterface(const char *primaryIntfName)
 void WeaveTunnelAgent::SetPrimaryTunnelInterfaceType (const SrcInterfaceType primaryIntfType)
 {
     mPrimaryTunConnMgr.SetInterfaceType(primaryIntfType);
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+    {
+        mParallelTunConnMgrs[i].SetInterfaceType(primaryIntfType);
+    }
+#endif
 }
 
 /**
@@ -393,6 +434,13 @@ WEAVE_ERROR WeaveTunnelAgent::Shutdown(void)
     // Shutdown the Primary Tunnel ConnectionManager.
     mPrimaryTunConnMgr.Shutdown();
 
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+    {
+        mParallelTunConnMgrs[i].Shutdown();
+    }
+#endif
+
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
 
     mBackupTunConnMgr.Shutdown();
@@ -401,6 +449,14 @@ WEAVE_ERROR WeaveTunnelAgent::Shutdown(void)
 
     SetState(kState_NotInitialized);
 
+    // Free any messages still queued for the Service
+
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+    SendAggregatedPackets();
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+
+    DumpQueuedMessages();
+
     // Tear down the tun endpoint setup
 
     err = TeardownTunEndPoint();
@@ -423,6 +479,13 @@ exit:
  */
 WEAVE_ERROR WeaveTunnelAgent::ResetPrimaryReconnectBackoff(bool reconnectImmediately)
 {
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+    {
+        mParallelTunConnMgrs[i].ResetReconnectBackoff(reconnectImmediately);
+    }
+#endif
+
     return mPrimaryTunConnMgr.ResetReconnectBackoff(reconnectImmediately);
 }
 
@@ -499,6 +562,13 @@ WEAVE_ERROR WeaveTunnelAgent::ConfigureAndEnablePrimaryTunnelTCPKeepAlive(uint16
 void WeaveTunnelAgent::ConfigurePrimaryTunnelLivenessInterval(uint16_t livenessIntervalSecs)
 {
     mPrimaryTunConnMgr.ConfigureTunnelLivenessInterval(livenessIntervalSecs);
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+    {
+        mParallelTunConnMgrs[i].ConfigureTunnelLivenessInterval(livenessIntervalSecs);
+    }
+#endif
 }
 #endif // WEAVE_CONFIG_TUNNEL_LIVENESS_SUPPORTED
 
@@ -549,6 +619,47 @@ bool WeaveTunnelAgent::IsPrimaryTunnelRoutingRestricted(void)
            GetFlag(mTunnelFlags, kTunnelFlag_PrimaryRestricted);
 }
 
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+/**
+ *  Check if tunneled packets are aggregated when sent to the Service.
+ *
+ *  @return true if aggregation is enabled, else false.
+ */
+bool WeaveTunnelAgent::IsTunnelAggregationEnabled(void) const
+{
+    return GetFlag(mTunnelFlags, kTunnelFlag_AggregationEnabled);
+}
+
+/**
+ *  Enable aggregation of the tunneled packets sent to the Service.
+ *
+ *  Once enabled, the IPv6 packets sent to the Service within
+ *  WEAVE_CONFIG_TUNNEL_AGGREGATION_DELAY_MSEC of each other are packed,
+ *  up to WEAVE_CONFIG_TUNNEL_AGGREGATION_MAX_BYTES, into a single
+ *  tunnel message of version kWeaveTunnelVersion_V2.
+ *
+ *  @note
+ *    Aggregation must only be enabled when the Service is known to
+ *    accept aggregated tunnel messages.
+ */
+void WeaveTunnelAgent::EnableTunnelAggregation(void)
+{
+    SetFlag(mTunnelFlags, kTunnelFlag_AggregationEnabled, true);
+}
+
+/**
+ *  Disable aggregation of the tunneled packets sent to the Service.
+ *
+ *  Any packets being aggregated are sent immediately.
+ */
+void WeaveTunnelAgent::DisableTunnelAggregation(void)
+{
+    SetFlag(mTunnelFlags, kTunnelFlag_AggregationEnabled, false);
+
+    SendAggregatedPackets();
+}
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
 
 /**
@@ -601,6 +712,13 @@ void WeaveTunnelAgent::StartPrimaryTunnel(void)
     // Try establishing the primary tunnel.
 
     mPrimaryTunConnMgr.ScheduleConnect(CONNECT_NO_DELAY);
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+    {
+        mParallelTunConnMgrs[i].ScheduleConnect(CONNECT_NO_DELAY);
+    }
+#endif
 }
 
 /**
@@ -614,6 +732,13 @@ void WeaveTunnelAgent::StopPrimaryTunnel(void)
     // Abort the primary tunnel if there is an outstanding connection.
 
     mPrimaryTunConnMgr.ServiceTunnelClose(WEAVE_ERROR_TUNNEL_FORCE_ABORT);
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+    {
+        mParallelTunConnMgrs[i].ServiceTunnelClose(WEAVE_ERROR_TUNNEL_FORCE_ABORT);
+    }
+#endif
 }
 
 /**
@@ -713,6 +838,88 @@ void WeaveTunnelAgent::ConfigureBackupTunnelLivenessInterval(uint16_t livenessIn
     mBackupTunConnMgr.ConfigureTunnelLivenessInterval(livenessIntervalSecs);
 }
 #endif // WEAVE_CONFIG_TUNNEL_LIVENESS_SUPPORTED
+
+#if WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+/**
+ *  Check if the backup tunnel is kept open as a hot standby.
+ *
+ *  @return true if hot standby is enabled, else false.
+ */
+bool WeaveTunnelAgent::IsBackupHotStandbyEnabled(void) const
+{
+    return GetFlag(mTunnelFlags, kTunnelFlag_BackupHotStandby);
+}
+
+/**
+ *  Keep the backup tunnel open as a hot standby for the primary tunnel.
+ *
+ *  The backup tunnel is started if it is not already and, unless stopped
+ *  with StopBackupTunnel(), is reconnected whenever the primary tunnel
+ *  comes up without it.  Both tunnels are
+ *  liveness-probed at the given interval, so that a failure of the
+ *  primary tunnel is detected within one interval (plus the control
+ *  response timeout) and handled as a mode change to the backup tunnel,
+ *  which is already open, rather than as a loss of the Service tunnel.
+ *
+ *  @param[in]  livenessIntervalSecs
+ *    The liveness interval (in seconds) of both tunnels while in hot standby.
+ *    It takes effect from the next liveness probe of each tunnel.
+ *
+ *  @retval  #WEAVE_NO_ERROR                 On success.
+ *  @retval  #WEAVE_ERROR_INCORRECT_STATE    If the Tunnel Agent is not initialized.
+ *  @retval  #WEAVE_ERROR_INVALID_ARGUMENT   If the liveness interval is zero.
+ */
+WEAVE_ERROR WeaveTunnelAgent::EnableBackupHotStandby(uint16_t livenessIntervalSecs)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mTunAgentState != kState_NotInitialized, err = WEAVE_ERROR_INCORRECT_STATE);
+    VerifyOrExit(livenessIntervalSecs != 0, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    if (!IsBackupHotStandbyEnabled())
+    {
+        mSavedPrimaryLivenessInterval = mPrimaryTunConnMgr.mTunnelLivenessInterval;
+        mSavedBackupLivenessInterval  = mBackupTunConnMgr.mTunnelLivenessInterval;
+    }
+
+    ConfigurePrimaryTunnelLivenessInterval(livenessIntervalSecs);
+    ConfigureBackupTunnelLivenessInterval(livenessIntervalSecs);
+
+    if (mBackupTunConnMgr.mConnectionState == WeaveTunnelConnectionMgr::kState_NotConnected)
+    {
+        EnableBackupTunnel();
+
+        mBackupTunConnMgr.ScheduleConnect(CONNECT_NO_DELAY);
+    }
+
+    SetFlag(mTunnelFlags, kTunnelFlag_BackupHotStandby, true);
+
+exit:
+    return err;
+}
+
+/**
+ *  Stop keeping the backup tunnel open as a hot standby.
+ *
+ *  The liveness intervals in effect before hot standby are restored.
+ *
+ *  @note
+ *    The backup tunnel is left open; it needs to be explicitly stopped
+ *    by calling StopBackupTunnel().
+ */
+void WeaveTunnelAgent::DisableBackupHotStandby(void)
+{
+    VerifyOrExit(IsBackupHotStandbyEnabled(), /* no-op */);
+
+    SetFlag(mTunnelFlags, kTunnelFlag_BackupHotStandby, false);
+
+    ConfigurePrimaryTunnelLivenessInterval(mSavedPrimaryLivenessInterval);
+    ConfigureBackupTunnelLivenessInterval(mSavedBackupLivenessInterval);
+
+exit:
+    return;
+}
+#endif // WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
 #endif // WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
 
 /**
@@ -759,6 +966,13 @@ WEAVE_ERROR WeaveTunnelAgent::StartServiceTunnel(uint64_t dstNodeId,
     {
         mPrimaryTunConnMgr.ReleaseResourcesAndStopTunnelConn(WEAVE_ERROR_TUNNEL_FORCE_ABORT);
 
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+        for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+        {
+            mParallelTunConnMgrs[i].ReleaseResourcesAndStopTunnelConn(WEAVE_ERROR_TUNNEL_FORCE_ABORT);
+        }
+#endif
+
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
         mBackupTunConnMgr.ReleaseResourcesAndStopTunnelConn(WEAVE_ERROR_TUNNEL_FORCE_ABORT);
 #endif // WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
@@ -769,6 +983,13 @@ WEAVE_ERROR WeaveTunnelAgent::StartServiceTunnel(uint64_t dstNodeId,
     if (IsPrimaryTunnelEnabled())
     {
         mPrimaryTunConnMgr.ScheduleConnect(CONNECT_NO_DELAY);
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+        for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+        {
+            mParallelTunConnMgrs[i].ScheduleConnect(CONNECT_NO_DELAY);
+        }
+#endif
     }
 
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
@@ -807,6 +1028,13 @@ void WeaveTunnelAgent::StopServiceTunnel(WEAVE_ERROR err)
     if (IsPrimaryTunnelEnabled())
     {
         mPrimaryTunConnMgr.ServiceTunnelClose(err);
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+        for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+        {
+            mParallelTunConnMgrs[i].ServiceTunnelClose(err);
+        }
+#endif
     }
 
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
@@ -846,6 +1074,10 @@ WEAVE_ERROR WeaveTunnelAgent::GetWeaveTunnelStatistics(WeaveTunnelStatistics &tu
 {
     memcpy(&tunnelStats, &mWeaveTunnelStats, sizeof(WeaveTunnelStatistics));
 
+    // Track the peak queue occupancy over the interval between two reads.
+
+    mWeaveTunnelStats.mPeakQueuedPacketsCount = mWeaveTunnelStats.mQueuedPacketsCount;
+
     return WEAVE_NO_ERROR;
 }
 #endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
@@ -856,6 +1088,10 @@ void WeaveTunnelAgent::SetState(AgentState toState)
     WeaveLogDetail(WeaveTunnel, "FromState:%s ToState:%s\n", GetAgentStateName(mTunAgentState),
                                  GetAgentStateName(toState));
     mTunAgentState = toState;
+
+#if WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
+    InvalidateRouteCache();
+#endif
 }
 
 /**
@@ -926,7 +1162,7 @@ void WeaveTunnelAgent::RecvdFromTunnelEndPoint(TunEndPoint *tunEP, PacketBuffer
             // Decide based on lookup of nexthop table and send locally
             // via UDP tunnel or remotely via Service TCP connection.
 
-            err = tAgent->DecideAndSendShortcutOrRemoteTunnel(nodeId, msg);
+            err = tAgent->DecideAndSendShortcutOrRemoteTunnel(destIP6Addr, nodeId, msg);
             msg = NULL;
             SuccessOrExit(err);
         }
@@ -941,7 +1177,8 @@ void WeaveTunnelAgent::RecvdFromTunnelEndPoint(TunEndPoint *tunEP, PacketBuffer
             // Decide based on lookup of nexthop table and send locally
             // via UDP tunnel or remotely via Service TCP connection.
 
-            err = tAgent->DecideAndSendShortcutOrRemoteTunnel(tAgent->mExchangeMgr->FabricState->FabricId, msg);
+            err = tAgent->DecideAndSendShortcutOrRemoteTunnel(destIP6Addr, tAgent->mExchangeMgr->FabricState->FabricId,
+                                                              msg);
             msg = NULL;
             SuccessOrExit(err);
         }
@@ -1015,6 +1252,13 @@ void WeaveTunnelAgent::NetworkOnlineCheckResult(TunnelType tunType, bool isOnlin
     {
       case kType_TunnelPrimary:
         mPrimaryTunConnMgr.HandleOnlineCheckResult(isOnline);
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+        for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+        {
+            mParallelTunConnMgrs[i].HandleOnlineCheckResult(isOnline);
+        }
+#endif
         break;
 
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
@@ -1165,7 +1409,8 @@ WEAVE_ERROR WeaveTunnelAgent::SendMessageUponPktTransitAnalysis(const WeaveTunne
                                                                 TunnelType tunType,
                                                                 WeaveMessageInfo *msgInfo,
                                                                 PacketBuffer *msg,
-                                                                bool &dropPacket)
+                                                                bool &dropPacket,
+                                                                uint32_t queueDelayMsec)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     uint32_t msgLen = 0;
@@ -1181,11 +1426,20 @@ WEAVE_ERROR WeaveTunnelAgent::SendMessageUponPktTransitAnalysis(const WeaveTunne
     if (!dropPacket)
     {
         msgLen = msg->DataLength();
-        err = connMgr->mServiceCon->SendTunneledMessage(msgInfo, msg);
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+        if (pktDir == kDir_Outbound && IsTunnelAggregationEnabled())
+        {
+            err = AggregateAndSend(connMgr, msgInfo, msg);
+        }
+        else
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+        {
+            err = connMgr->mServiceCon->SendTunneledMessage(msgInfo, msg);
+        }
         SuccessOrExit(err);
 
 #if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
-        UpdateOutboundMessageStatistics(connMgr->mTunType, msgLen);
+        UpdateOutboundMessageStatistics(connMgr->mTunType, msgLen, queueDelayMsec);
         mWeaveTunnelStats.mCurrentActiveTunnel = connMgr->mTunType;
 #endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
 
@@ -1212,6 +1466,271 @@ exit:
     return err;
 }
 
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+/**
+ * Add a tunneled IPv6 packet to the aggregated tunnel message being built
+ * for the Service, sending the message built so far first if the packet is
+ * for another tunnel or does not fit in it.
+ *
+ * Packets too large to be aggregated are sent on their own.
+ *
+ * @param[in] connMgr   The connection manager of the tunnel to send the packet over.
+ * @param[in] msgInfo   The Weave message information to send the packet on its own with.
+ * @param[in] msg       The packet, with its Tunnel header; it is freed in all cases.
+ *
+ * @return WEAVE_NO_ERROR on success, else a corresponding WEAVE_ERROR type.
+ */
+WEAVE_ERROR WeaveTunnelAgent::AggregateAndSend(const WeaveTunnelConnectionMgr *connMgr,
+                                               WeaveMessageInfo *msgInfo,
+                                               PacketBuffer *msg)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveTunnelHeader tunHeader;
+    uint16_t pktLen = msg->DataLength() - TUN_HDR_SIZE_IN_BYTES;
+    uint16_t entryLen = TUN_AGG_PKT_LEN_FIELD_SIZE_IN_BYTES + pktLen;
+    uint8_t *p;
+
+    if (mAggregateMsg != NULL &&
+        (mAggregateConnMgr != connMgr ||
+         mAggregateMsg->DataLength() - TUN_HDR_SIZE_IN_BYTES + entryLen > WEAVE_CONFIG_TUNNEL_AGGREGATION_MAX_BYTES ||
+         mAggregateMsg->AvailableDataLength() < entryLen))
+    {
+        SendAggregatedPackets();
+    }
+
+    if (msg->Next() == NULL && entryLen <= WEAVE_CONFIG_TUNNEL_AGGREGATION_MAX_BYTES && mAggregateMsg == NULL)
+    {
+        mAggregateMsg = PacketBuffer::New();
+        VerifyOrExit(mAggregateMsg != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        tunHeader.Version = kWeaveTunnelVersion_V2;
+        WeaveTunnelHeader::EncodeTunnelHeader(&tunHeader, mAggregateMsg);
+
+        mAggregateConnMgr = connMgr;
+        mNumAggregatedPkts = 0;
+
+        mExchangeMgr->MessageLayer->SystemLayer->StartTimer(WEAVE_CONFIG_TUNNEL_AGGREGATION_DELAY_MSEC,
+                                                            HandleAggregationTimeout, this);
+    }
+
+    if (msg->Next() != NULL || entryLen > WEAVE_CONFIG_TUNNEL_AGGREGATION_MAX_BYTES ||
+        mAggregateMsg->AvailableDataLength() < entryLen)
+    {
+        // Send the packet on its own
+
+        err = connMgr->mServiceCon->SendTunneledMessage(msgInfo, msg);
+        msg = NULL;
+        ExitNow();
+    }
+
+    p = mAggregateMsg->Start() + mAggregateMsg->DataLength();
+    Encoding::LittleEndian::Write16(p, pktLen);
+    memcpy(p, msg->Start() + TUN_HDR_SIZE_IN_BYTES, pktLen);
+    mAggregateMsg->SetDataLength(mAggregateMsg->DataLength() + entryLen);
+    mNumAggregatedPkts++;
+
+exit:
+    PacketBuffer::Free(msg);
+
+    return err;
+}
+
+/**
+ * Send the aggregated tunnel message being built, if any, to the Service.
+ *
+ * The packets in it are dropped if its tunnel has gone down in the meantime.
+ */
+void WeaveTunnelAgent::SendAggregatedPackets(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveMessageInfo msgInfo;
+    PacketBuffer *msg = mAggregateMsg;
+
+    VerifyOrExit(msg != NULL, /* no-op */);
+
+    mAggregateMsg = NULL;
+    mExchangeMgr->MessageLayer->SystemLayer->CancelTimer(HandleAggregationTimeout, this);
+
+    VerifyOrExit(mAggregateConnMgr->mConnectionState == WeaveTunnelConnectionMgr::kState_TunnelOpen,
+                 err = WEAVE_ERROR_INCORRECT_STATE);
+
+    PopulateTunnelMsgHeader(&msgInfo, mAggregateConnMgr);
+
+    err = mAggregateConnMgr->mServiceCon->SendTunneledMessage(&msgInfo, msg);
+    msg = NULL;
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogError(WeaveTunnel, "Aggregated msg Tx Err %d", err);
+
+        PacketBuffer::Free(msg);
+
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+        // Update tunnel statistics
+        mWeaveTunnelStats.mDroppedMessagesCount += mNumAggregatedPkts;
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    }
+}
+
+void WeaveTunnelAgent::HandleAggregationTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError)
+{
+    WeaveTunnelAgent *tAgent = static_cast<WeaveTunnelAgent *>(aAppState);
+
+    tAgent->SendAggregatedPackets();
+}
+
+/**
+ * Unpack an aggregated tunnel message received over tunnel and handle each
+ * of the IPv6 packets in it as if it had been received on its own.
+ */
+WEAVE_ERROR WeaveTunnelAgent::HandleAggregatedReceive(PacketBuffer *msg, TunnelType tunType)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveTunnelHeader tunHeader;
+    PacketBuffer *pkt = NULL;
+    const uint8_t *p;
+    const uint8_t *end;
+    uint16_t pktLen;
+
+    err = WeaveTunnelHeader::DecodeTunnelHeader(&tunHeader, msg);
+    SuccessOrExit(err);
+
+    p = msg->Start();
+    end = p + msg->DataLength();
+
+    while (p < end)
+    {
+        VerifyOrExit(end - p >= TUN_AGG_PKT_LEN_FIELD_SIZE_IN_BYTES, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+        pktLen = Encoding::LittleEndian::Read16(p);
+        VerifyOrExit(pktLen <= end - p, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+        pkt = PacketBuffer::NewWithAvailableSize(pktLen);
+        VerifyOrExit(pkt != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        memcpy(pkt->Start(), p, pktLen);
+        pkt->SetDataLength(pktLen);
+        p += pktLen;
+
+        err = AddTunnelHdrToMsg(pkt);
+        SuccessOrExit(err);
+
+        ReceiveTunneledPacket(pkt, tunType);
+        pkt = NULL;
+    }
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        WeaveLogProgress(WeaveTunnel, "Aggregated msg Rx Err %d", err);
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+        // Update tunnel statistics
+        mWeaveTunnelStats.mDroppedMessagesCount++;
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    }
+
+    PacketBuffer::Free(pkt);
+    PacketBuffer::Free(msg);
+
+    return err;
+}
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+/**
+ * Check whether a connection manager is one of the tunnels opened in parallel
+ * with the Primary tunnel, whose state changes are not reflected in the agent state.
+ */
+bool WeaveTunnelAgent::IsParallelTunnel(const WeaveTunnelConnectionMgr *connMgr) const
+{
+    return (connMgr >= &mParallelTunConnMgrs[0] &&
+            connMgr < &mParallelTunConnMgrs[WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1]);
+}
+
+/**
+ * Select the primary tunnel to send a packet on, among the Primary tunnel and
+ * the open parallel tunnels, by the hash of its flow.
+ *
+ * @note
+ *   The Primary tunnel must be open.  A flow moves to another tunnel only when
+ *   a parallel tunnel opens or closes.
+ *
+ * @param[in] pkt   The tunneled packet, including its Tunnel header.
+ *
+ * @return The connection manager of the selected tunnel.
+ */
+WeaveTunnelConnectionMgr *WeaveTunnelAgent::SelectPrimaryTunnelForFlow(const PacketBuffer *pkt)
+{
+    WeaveTunnelConnectionMgr *openTunnels[WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS];
+    uint8_t numOpen = 0;
+
+    openTunnels[numOpen++] = &mPrimaryTunConnMgr;
+
+    for (int i = 0; i < WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1; i++)
+    {
+        if (mParallelTunConnMgrs[i].mConnectionState == WeaveTunnelConnectionMgr::kState_TunnelOpen)
+        {
+            openTunnels[numOpen++] = &mParallelTunConnMgrs[i];
+        }
+    }
+
+    return (numOpen == 1) ? openTunnels[0] : openTunnels[HashFlow(pkt) % numOpen];
+}
+
+/**
+ * Hash the flow of a tunneled packet: the source and destination addresses and
+ * the next header of its IPv6 header, and the ports of its TCP or UDP header.
+ *
+ * @param[in] pkt   The tunneled packet, including its Tunnel header.
+ *
+ * @return The FNV-1a hash of the flow, or 0 if the packet is too short.
+ */
+uint32_t WeaveTunnelAgent::HashFlow(const PacketBuffer *pkt)
+{
+    enum
+    {
+        kIPv6HeaderLength       = 40,
+        kIPv6NextHeaderOffset   = 6,
+        kIPv6SrcAddrOffset      = 8,
+        kIPv6AddrsLength        = 32,
+        kPortsLength            = 4,
+        kIPProtocol_TCP         = 6,
+        kIPProtocol_UDP         = 17,
+    };
+
+    uint32_t hash       = 2166136261UL;
+    const uint8_t *p    = pkt->Start() + TUN_HDR_SIZE_IN_BYTES;
+    const uint8_t *end  = pkt->Start() + pkt->DataLength();
+    uint8_t nextHeader;
+
+    VerifyOrExit(p + kIPv6HeaderLength <= end, hash = 0);
+
+    nextHeader = p[kIPv6NextHeaderOffset];
+
+    hash = (hash ^ nextHeader) * 16777619UL;
+
+    for (int i = 0; i < kIPv6AddrsLength; i++)
+    {
+        hash = (hash ^ p[kIPv6SrcAddrOffset + i]) * 16777619UL;
+    }
+
+    // Packets with extension headers are hashed by addresses only.
+
+    VerifyOrExit(nextHeader == kIPProtocol_TCP || nextHeader == kIPProtocol_UDP, /* no-op */);
+    p += kIPv6HeaderLength;
+    VerifyOrExit(p + kPortsLength <= end, /* no-op */);
+
+    for (int i = 0; i < kPortsLength; i++)
+    {
+        hash = (hash ^ p[i]) * 16777619UL;
+    }
+
+exit:
+    return hash;
+}
+#endif // WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+
 /**
  * Prepare message and send to Service via Remote tunnel.
  */
@@ -1219,6 +1738,7 @@ WEAVE_ERROR WeaveTunnelAgent::HandleSendingToService(PacketBuffer *msg)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
     bool dropPacket = false;
+    QueueClass qClass = ClassifyPacket(msg);
 
     if (mPrimaryTunConnMgr.mConnectionState != WeaveTunnelConnectionMgr::kState_TunnelOpen
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
@@ -1229,7 +1749,22 @@ WEAVE_ERROR WeaveTunnelAgent::HandleSendingToService(PacketBuffer *msg)
         // Enqueue message until Service tunnel established
 
         WeaveLogDetail(WeaveTunnel, "Tunnel connection not up: Enqueuing message\n");
-        err = EnQueuePacket(msg);
+        err = EnQueuePacket(msg, qClass);
+
+        if (err != WEAVE_NO_ERROR)
+        {
+            dropPacket = true;
+        }
+
+        ExitNow();
+    }
+
+    if (mQueues[qClass].mCount != 0)
+    {
+        // Messages of the same class queued during the outage are still
+        // being drained; enqueue behind them so as to keep their order.
+
+        err = EnQueuePacket(msg, qClass);
 
         if (err != WEAVE_NO_ERROR)
         {
@@ -1244,10 +1779,17 @@ WEAVE_ERROR WeaveTunnelAgent::HandleSendingToService(PacketBuffer *msg)
     if (mPrimaryTunConnMgr.mConnectionState == WeaveTunnelConnectionMgr::kState_TunnelOpen)
     {
         WeaveMessageInfo msgInfo;
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+        // Spread the flows across the open primary tunnels.
 
-        PopulateTunnelMsgHeader(&msgInfo, &mPrimaryTunConnMgr);
+        WeaveTunnelConnectionMgr *connMgr = SelectPrimaryTunnelForFlow(msg);
+#else
+        WeaveTunnelConnectionMgr *connMgr = &mPrimaryTunConnMgr;
+#endif
+
+        PopulateTunnelMsgHeader(&msgInfo, connMgr);
 
-        err = SendMessageUponPktTransitAnalysis(&mPrimaryTunConnMgr, kDir_Outbound, kType_TunnelPrimary,
+        err = SendMessageUponPktTransitAnalysis(connMgr, kDir_Outbound, kType_TunnelPrimary,
                                                 &msgInfo, msg, dropPacket);
     }
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
@@ -1284,16 +1826,18 @@ exit:
 /**
  * Prepare message and send to Service via Remote tunnel.
  */
-WEAVE_ERROR WeaveTunnelAgent::DecideAndSendShortcutOrRemoteTunnel(uint64_t peerId, PacketBuffer *msg)
+WEAVE_ERROR WeaveTunnelAgent::DecideAndSendShortcutOrRemoteTunnel(const IPAddress &destAddr, uint64_t peerId, PacketBuffer *msg)
 {
     WEAVE_ERROR err =  WEAVE_NO_ERROR;
     bool dropPacket = false;
 
 #if WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
+    int nextHopIndex;
 
-    // Lookup nexthop table
+    // Lookup the route cache, falling back to the nexthop table
 
-    if (mTunShortcutControl.IsPeerInShortcutTunnelCache(peerId))
+    nextHopIndex = LookupShortcutRoute(destAddr, peerId);
+    if (nextHopIndex >= 0)
     {
         WeaveMessageInfo msgInfo;
 
@@ -1311,8 +1855,21 @@ WEAVE_ERROR WeaveTunnelAgent::DecideAndSendShortcutOrRemoteTunnel(uint64_t peerI
 
         if (!dropPacket)
         {
-            err = mTunShortcutControl.SendMessageOverTunnelShortcut(peerId, &msgInfo, msg);
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+            uint16_t msgLen = msg->DataLength();
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+
+            err = mTunShortcutControl.SendMessageToShortcutTunnelPeer(nextHopIndex, &msgInfo, msg);
             msg = NULL;
+
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+            if (err == WEAVE_NO_ERROR)
+            {
+                // Update tunnel statistics
+                mWeaveTunnelStats.mTxMessagesToShortcut++;
+                mWeaveTunnelStats.mTxBytesToShortcut += msgLen;
+            }
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
         }
     }
     else
@@ -1337,6 +1894,54 @@ WEAVE_ERROR WeaveTunnelAgent::DecideAndSendShortcutOrRemoteTunnel(uint64_t peerI
     return err;
 }
 
+#if WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
+/**
+ * Look up the route to a destination in the route cache and, on a miss,
+ * in the nexthop table, caching the result.
+ *
+ * @param[in] destAddr     The destination address of the tunneled packet.
+ *
+ * @param[in] peerId       The shortcut tunnel peer the destination is reachable through.
+ *
+ * @return the index of the peer in the nexthop table, or -1 if the packet is to be
+ *         sent to the Service.
+ */
+int WeaveTunnelAgent::LookupShortcutRoute(const IPAddress &destAddr, uint64_t peerId)
+{
+    uint32_t hash = destAddr.Addr[0] ^ destAddr.Addr[1] ^ destAddr.Addr[2] ^ destAddr.Addr[3];
+    RouteCacheEntry &entry = mRouteCache[(hash ^ (hash >> 16)) % WEAVE_CONFIG_TUNNELING_SHORTCUT_ROUTE_CACHE_SIZE];
+
+    if (entry.mValid && entry.mDestAddr == destAddr)
+    {
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+        mWeaveTunnelStats.mRouteCacheHits++;
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    }
+    else
+    {
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+        mWeaveTunnelStats.mRouteCacheMisses++;
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+
+        entry.mDestAddr     = destAddr;
+        entry.mNextHopIndex = static_cast<int8_t>(mTunShortcutControl.LookupShortcutTunnelPeer(peerId));
+        entry.mValid        = true;
+    }
+
+    return entry.mNextHopIndex;
+}
+
+/**
+ * Invalidate the route cache, for the routes to be looked up again in the
+ * nexthop table.  Called whenever the nexthop table or the state of the
+ * tunnels changes.
+ */
+void WeaveTunnelAgent::InvalidateRouteCache(void)
+{
+    memset(mRouteCache, 0, sizeof(mRouteCache));
+}
+#endif // WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
+
 /**
  * Handle a message received over tunnel and decode tunnel header and send
  * via appropriate interface.
@@ -1344,9 +1949,6 @@ WEAVE_ERROR WeaveTunnelAgent::DecideAndSendShortcutOrRemoteTunnel(uint64_t peerI
 WEAVE_ERROR WeaveTunnelAgent::HandleTunneledReceive(PacketBuffer *msg, TunnelType tunType)
 {
     WEAVE_ERROR err =  WEAVE_NO_ERROR;
-    IPAddress destIP6Addr;
-    WeaveTunnelHeader tunHeader;
-    bool dropPacket = false;
 
 #if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
     WeaveTunnelCommonStatistics *tunStats = NULL;
@@ -1363,6 +1965,31 @@ WEAVE_ERROR WeaveTunnelAgent::HandleTunneledReceive(PacketBuffer *msg, TunnelTyp
     mWeaveTunnelStats.mCurrentActiveTunnel = tunType;
 #endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
 
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+    if (msg->DataLength() >= TUN_HDR_SIZE_IN_BYTES && msg->Start()[0] == kWeaveTunnelVersion_V2)
+    {
+        err = HandleAggregatedReceive(msg, tunType);
+    }
+    else
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+    {
+        err = ReceiveTunneledPacket(msg, tunType);
+    }
+
+    return err;
+}
+
+/**
+ * Decode the tunnel header of a tunneled IPv6 packet and send it
+ * via appropriate interface.
+ */
+WEAVE_ERROR WeaveTunnelAgent::ReceiveTunneledPacket(PacketBuffer *msg, TunnelType tunType)
+{
+    WEAVE_ERROR err =  WEAVE_NO_ERROR;
+    IPAddress destIP6Addr;
+    WeaveTunnelHeader tunHeader;
+    bool dropPacket = false;
+
 #if WEAVE_CONFIG_TUNNEL_ENABLE_TRANSIT_CALLBACK
     if (OnTunneledPacketTransit)
     {
@@ -1432,9 +2059,11 @@ WeaveTunnelCommonStatistics *WeaveTunnelAgent::GetCommonTunnelStatistics(const T
     return tunStats;
 }
 
-void WeaveTunnelAgent::UpdateOutboundMessageStatistics(const TunnelType tunType, const uint64_t msgLen)
+void WeaveTunnelAgent::UpdateOutboundMessageStatistics(const TunnelType tunType, const uint64_t msgLen,
+                                                       const uint32_t queueDelayMsec)
 {
     WeaveTunnelCommonStatistics *tunStats = NULL;
+    int bucket = 0;
 
     // Update tunnel statistics
     tunStats = GetCommonTunnelStatistics(tunType);
@@ -1444,6 +2073,35 @@ void WeaveTunnelAgent::UpdateOutboundMessageStatistics(const TunnelType tunType,
         tunStats->mTxBytesToService += msgLen;
         tunStats->mTxMessagesToService++;
     }
+
+    // Bucket the queueing delay; the buckets double in width.
+
+    while (bucket < WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS - 1 &&
+           queueDelayMsec >= (static_cast<uint32_t>(WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BASE_MSEC) << bucket))
+    {
+        bucket++;
+    }
+
+    mWeaveTunnelStats.mQueueDelayHistogram[bucket]++;
+}
+
+/**
+ * Record the time taken to establish a tunnel, on receipt of the TunnelOpen
+ * acknowledgement.
+ */
+void WeaveTunnelAgent::UpdateTunnelEstablishStatistics(const WeaveTunnelConnectionMgr *connMgr)
+{
+    WeaveTunnelCommonStatistics *tunStats = NULL;
+    uint64_t now = System::Layer::GetClock_MonotonicMS();
+
+    // Update tunnel statistics
+    tunStats = GetCommonTunnelStatistics(connMgr->mTunType);
+
+    if (tunStats != NULL && connMgr->mConnectCompleteTime != 0 && connMgr->mConnectCompleteTime >= connMgr->mConnectStartTime)
+    {
+        tunStats->mLastConnectLatencyMsec    = static_cast<uint32_t>(connMgr->mConnectCompleteTime - connMgr->mConnectStartTime);
+        tunStats->mLastTunnelOpenLatencyMsec = static_cast<uint32_t>(now - connMgr->mConnectCompleteTime);
+    }
 }
 
 void WeaveTunnelAgent::UpdateTunnelDownStatistics(const TunnelType tunType, const WEAVE_ERROR conErr)
@@ -1461,33 +2119,133 @@ void WeaveTunnelAgent::UpdateTunnelDownStatistics(const TunnelType tunType, cons
 }
 #endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
 
+/**
+ * Classify a packet destined for the Service by the Weave profile of the message it carries.
+ *
+ * ICMPv6 packets, and Weave messages of profiles other than Data Management and
+ * Bulk Data Transfer, are control traffic.  Packets whose Weave profile cannot be
+ * determined, such as those carrying encrypted Weave messages or TCP segments,
+ * are accounted as Data Management traffic.
+ *
+ * @param[in] pkt   The tunneled packet, including its Tunnel header.
+ *
+ * @return The class of the packet.
+ */
+WeaveTunnelAgent::QueueClass WeaveTunnelAgent::ClassifyPacket(const PacketBuffer *pkt)
+{
+    enum
+    {
+        kIPv6HeaderLength       = 40,
+        kIPv6NextHeaderOffset   = 6,
+        kUDPHeaderLength        = 8,
+        kUDPDestPortOffset      = 2,
+        kIPProtocol_UDP         = 17,
+        kIPProtocol_ICMPv6      = 58,
+        kMsgHeaderMinLength     = 6,
+        kExchHeaderProfileOffset = 4,
+    };
+
+    QueueClass qClass   = kQueueClass_WDM;
+    const uint8_t *p    = pkt->Start() + TUN_HDR_SIZE_IN_BYTES;
+    const uint8_t *end  = pkt->Start() + pkt->DataLength();
+    uint16_t msgHeader;
+    uint32_t profileId;
+
+    VerifyOrExit(p + kIPv6HeaderLength <= end, /* no-op */);
+
+    if (p[kIPv6NextHeaderOffset] == kIPProtocol_ICMPv6)
+    {
+        ExitNow(qClass = kQueueClass_Control);
+    }
+
+    VerifyOrExit(p[kIPv6NextHeaderOffset] == kIPProtocol_UDP, /* no-op */);
+    p += kIPv6HeaderLength;
+
+    VerifyOrExit(p + kUDPHeaderLength + kMsgHeaderMinLength <= end, /* no-op */);
+    VerifyOrExit(Encoding::BigEndian::Get16(p + kUDPDestPortOffset) == WEAVE_PORT, /* no-op */);
+    p += kUDPHeaderLength;
+
+    // Skip the Weave message header; the exchange header of an encrypted message cannot be read.
+
+    msgHeader = Encoding::LittleEndian::Get16(p);
+    VerifyOrExit(((msgHeader & kMsgHeaderField_EncryptionTypeMask) >> kMsgHeaderField_EncryptionTypeShift) ==
+                 kWeaveEncryptionType_None, /* no-op */);
+    p += kMsgHeaderMinLength;
+
+    if (msgHeader & kWeaveHeaderFlag_SourceNodeId)
+    {
+        p += 8;
+    }
+
+    if (msgHeader & kWeaveHeaderFlag_DestNodeId)
+    {
+        p += 8;
+    }
+
+    VerifyOrExit(p + kExchHeaderProfileOffset + 4 <= end, /* no-op */);
+    profileId = Encoding::LittleEndian::Get32(p + kExchHeaderProfileOffset);
+
+    if (profileId == kWeaveProfile_WDM)
+    {
+        qClass = kQueueClass_WDM;
+    }
+    else if (profileId == kWeaveProfile_BDX)
+    {
+        qClass = kQueueClass_Bulk;
+    }
+    else
+    {
+        qClass = kQueueClass_Control;
+    }
+
+exit:
+    return qClass;
+}
+
 /**
  * Queue packet for Remote tunnel connection to get established.
+ *
+ * Each class of traffic is queued separately, up to its own byte budget;
+ * a packet that does not fit is dropped rather than any packet already queued.
  */
-WEAVE_ERROR WeaveTunnelAgent::EnQueuePacket(PacketBuffer *pkt)
+WEAVE_ERROR WeaveTunnelAgent::EnQueuePacket(PacketBuffer *pkt, QueueClass qClass)
 {
+    static const uint32_t kMaxQueueBytes[kQueueClass_Count] =
+    {
+        WEAVE_CONFIG_TUNNELING_CONTROL_QUEUE_MAX_BYTES,
+        WEAVE_CONFIG_TUNNELING_WDM_QUEUE_MAX_BYTES,
+        WEAVE_CONFIG_TUNNELING_BULK_QUEUE_MAX_BYTES
+    };
+
     WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketQueue &queue = mQueues[qClass];
+    uint32_t pktLen = pkt->TotalLength();
 
     WEAVE_FAULT_INJECT(nl::Weave::FaultInjection::kFault_TunnelQueueFull,
                        ExitNow(err = WEAVE_ERROR_TUNNEL_SERVICE_QUEUE_FULL);
                       );
 
-    if ((qFront == qRear + 1) || (qFront == 0 && qRear == WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED - 1))
-    {
-        // Queue full;
+    VerifyOrExit(queue.mCount < WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED &&
+                 queue.mNumBytes + pktLen <= kMaxQueueBytes[qClass],
+                 err = WEAVE_ERROR_TUNNEL_SERVICE_QUEUE_FULL);
 
-        err = WEAVE_ERROR_TUNNEL_SERVICE_QUEUE_FULL;
-        ExitNow();
-    }
-    else
+    queue.mPkts[(queue.mHead + queue.mCount) % WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED] = pkt;
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    queue.mEnqueueTimes[(queue.mHead + queue.mCount) % WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED] =
+        static_cast<uint32_t>(System::Layer::GetClock_MonotonicMS());
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    queue.mCount++;
+    queue.mNumBytes += pktLen;
+
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    // Update tunnel statistics
+    mWeaveTunnelStats.mQueuedPacketsCount++;
+    mWeaveTunnelStats.mQueuedBytes += pktLen;
+    if (mWeaveTunnelStats.mQueuedPacketsCount > mWeaveTunnelStats.mPeakQueuedPacketsCount)
     {
-        if (qFront == TUNNEL_PACKET_QUEUE_INVALID_INDEX)
-        {
-            qFront = 0;
-        }
-        qRear = (qRear + 1) % WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED;
-        queuedMsgs[qRear] = pkt;
+        mWeaveTunnelStats.mPeakQueuedPacketsCount = mWeaveTunnelStats.mQueuedPacketsCount;
     }
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
 
 exit:
 
@@ -1498,66 +2256,103 @@ void WeaveTunnelAgent::DumpQueuedMessages(void)
 {
     PacketBuffer *queuedPkt = NULL;
 
-    while (qFront != TUNNEL_PACKET_QUEUE_INVALID_INDEX)
+    if (mExchangeMgr != NULL)
     {
-        queuedPkt = DeQueuePacket();
-        if (queuedPkt)
-        {
-            PacketBuffer::Free(queuedPkt);
+        mExchangeMgr->MessageLayer->SystemLayer->CancelTimer(HandleQueueDrainTimeout, this);
+    }
+
+    while ((queuedPkt = DeQueuePacket()) != NULL)
+    {
+        PacketBuffer::Free(queuedPkt);
 
 #if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
-            // Update tunnel statistics
-            mWeaveTunnelStats.mDroppedMessagesCount++;
+        // Update tunnel statistics
+        mWeaveTunnelStats.mDroppedMessagesCount++;
 #endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
-
-            queuedPkt = NULL;
-        }
     }
 }
 
 /**
- * Dequeue a packet for sending via Service tunnel.
+ * Dequeue a packet for sending via Service tunnel, taking the classes in order of priority.
+ *
+ * @param[out] outQueueDelayMsec   If not NULL, set to the time the packet spent in the queue.
  */
-PacketBuffer *WeaveTunnelAgent::DeQueuePacket(void)
+PacketBuffer *WeaveTunnelAgent::DeQueuePacket(uint32_t *outQueueDelayMsec)
 {
     PacketBuffer *retPkt = NULL;
-    if (qFront != TUNNEL_PACKET_QUEUE_INVALID_INDEX)
+
+    if (outQueueDelayMsec != NULL)
     {
-        retPkt = queuedMsgs[qFront];
-        if (qFront == qRear) // Only one packet in queue
+        *outQueueDelayMsec = 0;
+    }
+
+    for (int i = 0; i < kQueueClass_Count; i++)
+    {
+        PacketQueue &queue = mQueues[i];
+
+        if (queue.mCount != 0)
         {
-            qFront = TUNNEL_PACKET_QUEUE_INVALID_INDEX;
-            qRear  = TUNNEL_PACKET_QUEUE_INVALID_INDEX;
+            retPkt = queue.mPkts[queue.mHead];
+            queue.mPkts[queue.mHead] = NULL;
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+            if (outQueueDelayMsec != NULL)
+            {
+                *outQueueDelayMsec = static_cast<uint32_t>(System::Layer::GetClock_MonotonicMS()) - queue.mEnqueueTimes[queue.mHead];
+            }
+
+            // Update tunnel statistics
+            mWeaveTunnelStats.mQueuedPacketsCount--;
+            mWeaveTunnelStats.mQueuedBytes -= retPkt->TotalLength();
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+            queue.mHead = (queue.mHead + 1) % WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED;
+            queue.mCount--;
+            queue.mNumBytes -= retPkt->TotalLength();
+            break;
         }
-        else
+    }
+
+    return retPkt;
+}
+
+bool WeaveTunnelAgent::IsQueueEmpty(void) const
+{
+    for (int i = 0; i < kQueueClass_Count; i++)
+    {
+        if (mQueues[i].mCount != 0)
         {
-            qFront = (qFront + 1) % WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED;
+            return false;
         }
     }
 
-    return retPkt;
+    return true;
 }
 
 /**
  * Flush queued messages that were pending because Service tunnel
  * was not setup.
+ *
+ * The messages are sent in bursts of WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_BURST,
+ * so that a reconnect after a long outage does not flood the link.
  */
 void WeaveTunnelAgent::SendQueuedMessages(const WeaveTunnelConnectionMgr *connMgr)
 {
     WeaveMessageInfo  msgInfo;
     PacketBuffer*     queuedPkt   = NULL;
     bool dropPacket;
+    int numSent = 0;
+    uint32_t queueDelayMsec;
 
-    while ((queuedPkt = DeQueuePacket()) != NULL)
+    while (numSent < WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_BURST && (queuedPkt = DeQueuePacket(&queueDelayMsec)) != NULL)
     {
         dropPacket = false;
+        numSent++;
         PopulateTunnelMsgHeader(&msgInfo, connMgr);
 
         // Send over TCP Connection
 
         msgInfo.DestNodeId = connMgr->mServiceCon->PeerNodeId;
         SendMessageUponPktTransitAnalysis(connMgr, kDir_Outbound, connMgr->mTunType,
-                                          &msgInfo, queuedPkt, dropPacket);
+                                          &msgInfo, queuedPkt, dropPacket, queueDelayMsec);
 
         if (dropPacket)
         {
@@ -1572,19 +2367,40 @@ void WeaveTunnelAgent::SendQueuedMessages(const WeaveTunnelConnectionMgr *connMg
 
             PacketBuffer::Free(queuedPkt);
         }
-        else
-        {
-#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
-            UpdateOutboundMessageStatistics(connMgr->mTunType, queuedPkt->DataLength());
-#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
-        }
 
         queuedPkt = NULL;
     }
 
+    // Pace the rest of the queue
+
+    if (!IsQueueEmpty())
+    {
+        mExchangeMgr->MessageLayer->SystemLayer->StartTimer(WEAVE_CONFIG_TUNNELING_QUEUE_DRAIN_INTERVAL_MSEC,
+                                                            HandleQueueDrainTimeout, this);
+    }
+
     return;
 }
 
+/**
+ * Send the next burst of queued messages over whichever Service tunnel is open.
+ */
+void WeaveTunnelAgent::HandleQueueDrainTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError)
+{
+    WeaveTunnelAgent *tAgent = static_cast<WeaveTunnelAgent *>(aAppState);
+
+    if (tAgent->mPrimaryTunConnMgr.mConnectionState == WeaveTunnelConnectionMgr::kState_TunnelOpen)
+    {
+        tAgent->SendQueuedMessages(&tAgent->mPrimaryTunConnMgr);
+    }
+#if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
+    else if (tAgent->mBackupTunConnMgr.mConnectionState == WeaveTunnelConnectionMgr::kState_TunnelOpen)
+    {
+        tAgent->SendQueuedMessages(&tAgent->mBackupTunConnMgr);
+    }
+#endif // WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
+}
+
 /**
  * Post processing function after Tunnel has been opened.
  */
@@ -1592,6 +2408,21 @@ void WeaveTunnelAgent::WeaveTunnelConnectionUp(const WeaveMessageInfo *msgInfo,
                                                const WeaveTunnelConnectionMgr *connMgr,
                                                const bool isRoutingRestricted)
 {
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    // A parallel tunnel only adds capacity to the Primary tunnel; it is used
+    // for sending as soon as it is open, without changing the agent mode.
+
+    if (IsParallelTunnel(connMgr))
+    {
+        WeaveLogDetail(WeaveTunnel, "Parallel primary tunnel %d up\n", static_cast<int>(connMgr - mParallelTunConnMgrs));
+        return;
+    }
+#endif // WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    UpdateTunnelEstablishStatistics(connMgr);
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+
    // Update the Weave Tunnel Agent mode on tunnel establishment.
 
     switch (mTunAgentState)
@@ -1692,6 +2523,18 @@ void WeaveTunnelAgent::WeaveTunnelConnectionUp(const WeaveMessageInfo *msgInfo,
       default:
         break;
     }
+
+#if WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+    // Bring the hot standby back up alongside the primary tunnel, so that
+    // the next failure of the primary tunnel is a mode change to it.
+
+    if (connMgr->mTunType == kType_TunnelPrimary && IsBackupHotStandbyEnabled() &&
+        IsBackupTunnelEnabled() &&
+        mBackupTunConnMgr.mConnectionState == WeaveTunnelConnectionMgr::kState_NotConnected)
+    {
+        mBackupTunConnMgr.ScheduleConnect(CONNECT_NO_DELAY);
+    }
+#endif // WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
 }
 
 /**
@@ -1699,6 +2542,12 @@ void WeaveTunnelAgent::WeaveTunnelConnectionUp(const WeaveMessageInfo *msgInfo,
  */
 void WeaveTunnelAgent::WeaveTunnelConnectionErrorNotify(const WeaveTunnelConnectionMgr *connMgr, WEAVE_ERROR conErr)
 {
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    // Errors of a parallel tunnel are handled by its own reconnect.
+
+    VerifyOrExit(!IsParallelTunnel(connMgr), /* no-op */);
+#endif // WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+
     if (OnServiceTunStatusNotify)
     {
         if (connMgr->mTunType == kType_TunnelPrimary)
@@ -1712,6 +2561,11 @@ void WeaveTunnelAgent::WeaveTunnelConnectionErrorNotify(const WeaveTunnelConnect
         }
 #endif // WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
     }
+
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+exit:
+    return;
+#endif // WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
 }
 
 #if WEAVE_CONFIG_TUNNEL_ENABLE_TCP_IDLE_CALLBACK
@@ -1744,6 +2598,17 @@ void WeaveTunnelAgent::WeaveTunnelServiceReconnectRequested(const WeaveTunnelCon
  */
 void WeaveTunnelAgent::WeaveTunnelConnectionDown(const WeaveTunnelConnectionMgr *connMgr, WEAVE_ERROR conErr)
 {
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    // Flows on a closed parallel tunnel move to the remaining open primary tunnels.
+
+    if (IsParallelTunnel(connMgr))
+    {
+        WeaveLogDetail(WeaveTunnel, "Parallel primary tunnel %d down: %s\n", static_cast<int>(connMgr - mParallelTunConnMgrs),
+                       ErrorStr(conErr));
+        return;
+    }
+#endif // WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+
     // Update the Weave Tunnel mode and the Agent state upon tunnel closure.
 
     switch (mTunAgentState)
@@ -1850,6 +2715,10 @@ void WeaveTunnelAgent::WeaveTunnelDownNotifyAndSetState(WEAVE_ERROR conErr)
 
     // When tunnel is down dump all queued messages
 
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+    SendAggregatedPackets();
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+
     DumpQueuedMessages();
 
     // Call application handler to report connection closing.
@@ -1936,7 +2805,7 @@ void WeaveTunnelAgent::WeaveTunnelUpNotifyAndSetState(AgentState state,
     // on behalf of a Thread device or its own packets. So, it is better to send these
     // across and have the Service decide to throw or accept.
 
-    if (qFront != TUNNEL_PACKET_QUEUE_INVALID_INDEX)
+    if (!IsQueueEmpty())
     {
         SendQueuedMessages(connMgr);
     }
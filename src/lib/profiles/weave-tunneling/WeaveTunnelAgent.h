@@ -39,8 +39,6 @@
 #define TUN_INTF_NAME_MAX_LEN                 (64)
 #define WEAVE_ULA_FABRIC_DEFAULT_PREFIX_LEN   (48)
 
-#define TUNNEL_PACKET_QUEUE_INVALID_INDEX     (-1)
-
 namespace nl {
 namespace Weave {
 namespace Profiles {
@@ -114,6 +112,8 @@ typedef struct WeaveTunnelCommonStatistics
     WEAVE_ERROR  mLastTunnelDownError;                                     /**< The Weave error encountered when the tunnel last went down. */
     uint64_t     mLastTimeTunnelWentDown;                                  /**< Last time Weave Tunnel went Down. */
     uint64_t     mLastTimeTunnelEstablished;                               /**< Last time Weave Tunnel was Established. */
+    uint32_t     mLastConnectLatencyMsec;                                  /**< Time taken by the last connection to the Service, including the TCP connect and the CASE session establishment. */
+    uint32_t     mLastTunnelOpenLatencyMsec;                               /**< Time taken by the last TunnelOpen exchange with the Service. */
 } WeaveTunnelCommonStatistics;
 
 /**
@@ -124,6 +124,10 @@ typedef struct WeaveTunnelStatistics
     WeaveTunnelCommonStatistics mPrimaryStats;                             /**< Primary Weave Tunnel statistics counters. */
     uint32_t     mDroppedMessagesCount;                                    /**< Number of dropped messages by the WeaveTunnelAgent. */
     TunnelType   mCurrentActiveTunnel;                                     /**< The Weave tunnel that is currently being used for data traffic. */
+    uint16_t     mQueuedPacketsCount;                                      /**< Number of packets currently queued for the Service. */
+    uint16_t     mPeakQueuedPacketsCount;                                  /**< Highest number of packets queued for the Service since the statistics were last read. */
+    uint32_t     mQueuedBytes;                                             /**< Number of bytes currently queued for the Service. */
+    uint32_t     mQueueDelayHistogram[WEAVE_CONFIG_TUNNEL_QUEUE_DELAY_HISTOGRAM_BUCKETS]; /**< Histogram of the delay of the messages sent to the Service between being queued and sent. */
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
     WeaveTunnelCommonStatistics mBackupStats;                              /**< Backup Weave Tunnel statistics counters. */
     uint32_t     mTunnelFailoverCount;                                     /**< Counter for the Weave Tunnel Failover events. */
@@ -131,6 +135,12 @@ typedef struct WeaveTunnelStatistics
     uint64_t     mLastTimeForTunnelFailover;                               /**< Last time Weave Tunnel failed over to Backup. */
     uint64_t     mLastTimeWhenPrimaryAndBackupWentDown;                    /**< Last time when both Primary and Backup Weave Tunnel went down. */
 #endif // WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
+#if WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
+    uint32_t     mTxMessagesToShortcut;                                    /**< Number of messages sent over shortcut tunnels. */
+    uint64_t     mTxBytesToShortcut;                                       /**< Number of bytes sent over shortcut tunnels. */
+    uint32_t     mRouteCacheHits;                                          /**< Number of tunneled packets routed from the route cache. */
+    uint32_t     mRouteCacheMisses;                                        /**< Number of tunneled packets routed by a lookup of the nexthop table. */
+#endif // WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
 } WeaveTunnelStatistics;
 #endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
 
@@ -159,6 +169,8 @@ public:
         kTunnelFlag_BackupEnabled       = 0x02,  ///< Set when the backup tunnel is enabled.
         kTunnelFlag_PrimaryRestricted   = 0x04,  ///< Set when the primary tunnel is routing restricted.
         kTunnelFlag_BackupRestricted    = 0x08,  ///< Set when the backup tunnel is routing restricted.
+        kTunnelFlag_AggregationEnabled  = 0x10,  ///< Set when tunneled packets are aggregated when sent to the Service.
+        kTunnelFlag_BackupHotStandby    = 0x20,  ///< Set when the backup tunnel is kept open as a hot standby.
     } WeaveTunnelFlags;
 
 #if WEAVE_CONFIG_ENABLE_SERVICE_DIRECTORY
@@ -265,6 +277,23 @@ public:
  */
     WEAVE_ERROR ResetPrimaryReconnectBackoff(bool reconnectImmediately);
 
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+/**
+ *  Check if tunneled packets are aggregated when sent to the Service.
+ */
+    bool IsTunnelAggregationEnabled(void) const;
+
+/**
+ * Enable aggregation of the tunneled packets sent to the Service.
+ */
+    void EnableTunnelAggregation(void);
+
+/**
+ * Disable aggregation of the tunneled packets sent to the Service.
+ */
+    void DisableTunnelAggregation(void);
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+
 #if WEAVE_CONFIG_TUNNEL_FAILOVER_SUPPORTED
 
 /**
@@ -337,6 +366,23 @@ public:
     void ConfigureBackupTunnelLivenessInterval(uint16_t livenessIntervalSecs);
 #endif // WEAVE_CONFIG_TUNNEL_LIVENESS_SUPPORTED
 
+#if WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+/**
+ *  Check if the backup tunnel is kept open as a hot standby.
+ */
+    bool IsBackupHotStandbyEnabled(void) const;
+
+/**
+ * Keep the backup tunnel open as a hot standby for the primary tunnel.
+ */
+    WEAVE_ERROR EnableBackupHotStandby(uint16_t livenessIntervalSecs = WEAVE_CONFIG_TUNNEL_HOT_STANDBY_LIVENESS_INTERVAL_SECS);
+
+/**
+ * Stop keeping the backup tunnel open as a hot standby.
+ */
+    void DisableBackupHotStandby(void);
+#endif // WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+
 /**
  * Set the primary tunnel interface name
  *
@@ -554,10 +600,49 @@ private:
 
     WeaveAuthMode mAuthMode;
 
+    // Classes of the messages queued for Service, in the order in which they are sent.
+
+    enum QueueClass
+    {
+        kQueueClass_Control = 0,
+        kQueueClass_WDM     = 1,
+        kQueueClass_Bulk    = 2,
+
+        kQueueClass_Count
+    };
+
+    // Queue of the messages of one class, bounded both in packets and in bytes.
+
+    struct PacketQueue
+    {
+        PacketBuffer *mPkts[WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED];
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+        uint32_t mEnqueueTimes[WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED];
+#endif
+        uint32_t mNumBytes;
+        uint8_t mHead;
+        uint8_t mCount;
+    };
+
     // Queued messages for Service; pending until connection established.
 
-    PacketBuffer *queuedMsgs[WEAVE_CONFIG_TUNNELING_MAX_NUM_PACKETS_QUEUED];
-    int qFront, qRear;
+    PacketQueue mQueues[kQueueClass_Count];
+
+#if WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+    // Liveness intervals of the primary and backup tunnels outside of hot standby.
+
+    uint16_t mSavedPrimaryLivenessInterval;
+    uint16_t mSavedBackupLivenessInterval;
+#endif // WEAVE_CONFIG_TUNNEL_HOT_STANDBY_SUPPORTED
+
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+    // Aggregated tunnel message being built for Service, the tunnel it is
+    // to be sent over and the number of packets in it.
+
+    PacketBuffer *mAggregateMsg;
+    const WeaveTunnelConnectionMgr *mAggregateConnMgr;
+    uint16_t mNumAggregatedPkts;
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
 
     // Role; Border gateway or Mobile device
 
@@ -591,10 +676,30 @@ private:
     WeaveTunnelConnectionMgr mBackupTunConnMgr;
 #endif
 
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    // Weave Tunnel Connection Manager objects for the tunnels opened over the
+    // primary interface in parallel with the Primary tunnel
+
+    WeaveTunnelConnectionMgr mParallelTunConnMgrs[WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS - 1];
+#endif
+
 #if WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
     // Weave Tunnel Control for Tunnel shortcut
 
     WeaveTunnelControl mTunShortcutControl;
+
+    // Route cache, indexed by a hash of the destination address, remembering
+    // whether packets to the destination go over a shortcut tunnel, and to
+    // which nexthop, or to the Service.
+
+    struct RouteCacheEntry
+    {
+        IPAddress mDestAddr;
+        int8_t mNextHopIndex;   // Index in the nexthop table; -1 when sent to the Service.
+        bool mValid;
+    };
+
+    RouteCacheEntry mRouteCache[WEAVE_CONFIG_TUNNELING_SHORTCUT_ROUTE_CACHE_SIZE];
 #endif
 
     // WeaveTunnelAgent state
@@ -607,7 +712,8 @@ private:
 #if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
     WeaveTunnelStatistics mWeaveTunnelStats;
 
-    void UpdateOutboundMessageStatistics(const TunnelType tunType, const uint64_t msgLen);
+    void UpdateOutboundMessageStatistics(const TunnelType tunType, const uint64_t msgLen, const uint32_t queueDelayMsec = 0);
+    void UpdateTunnelEstablishStatistics(const WeaveTunnelConnectionMgr *connMgr);
     void UpdateTunnelDownStatistics(const TunnelType tunType, const WEAVE_ERROR conErr);
     WeaveTunnelCommonStatistics *GetCommonTunnelStatistics(const TunnelType tunType);
 #endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
@@ -633,14 +739,39 @@ private:
     WEAVE_ERROR AddTunnelHdrToMsg(PacketBuffer *msg);
     WEAVE_ERROR HandleSendingToService(PacketBuffer *msg);
     WEAVE_ERROR HandleTunneledReceive(PacketBuffer *msg, TunnelType tunType);
+    WEAVE_ERROR ReceiveTunneledPacket(PacketBuffer *msg, TunnelType tunType);
+
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+    // Aggregation of tunneled packets in one Weave message
+
+    WEAVE_ERROR AggregateAndSend(const WeaveTunnelConnectionMgr *connMgr, WeaveMessageInfo *msgInfo, PacketBuffer *msg);
+    void SendAggregatedPackets(void);
+    static void HandleAggregationTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError);
+    WEAVE_ERROR HandleAggregatedReceive(PacketBuffer *msg, TunnelType tunType);
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
 
     /// Decide based on lookup of nexthop table and send locally
     /// via UDP tunnel or remotely via Service TCP connection.
 
-    WEAVE_ERROR DecideAndSendShortcutOrRemoteTunnel(uint64_t nodeId, PacketBuffer *msg);
+    WEAVE_ERROR DecideAndSendShortcutOrRemoteTunnel(const IPAddress &destAddr, uint64_t nodeId, PacketBuffer *msg);
+
+#if WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
+    // Route cache of the shortcut or remote tunnel decisions per destination
+
+    int LookupShortcutRoute(const IPAddress &destAddr, uint64_t nodeId);
+    void InvalidateRouteCache(void);
+#endif // WEAVE_CONFIG_TUNNEL_SHORTCUT_SUPPORTED
 
     void PopulateTunnelMsgHeader(WeaveMessageInfo *msgInfo, const WeaveTunnelConnectionMgr *connMgr);
 
+#if WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+    // Load balancing of flows across the parallel primary tunnels
+
+    bool IsParallelTunnel(const WeaveTunnelConnectionMgr *connMgr) const;
+    WeaveTunnelConnectionMgr *SelectPrimaryTunnelForFlow(const PacketBuffer *pkt);
+    static uint32_t HashFlow(const PacketBuffer *pkt);
+#endif // WEAVE_CONFIG_TUNNEL_MAX_PARALLEL_TUNNELS > 1
+
     void ParseDestinationIPAddress(const PacketBuffer &inMsg, IPAddress &outDest);
 
     WEAVE_ERROR SendMessageUponPktTransitAnalysis(const WeaveTunnelConnectionMgr *connMgr,
@@ -648,15 +779,19 @@ private:
                                                   TunnelType tunType,
                                                   WeaveMessageInfo *msgInfo,
                                                   PacketBuffer *msg,
-                                                  bool &dropPacket);
+                                                  bool &dropPacket,
+                                                  uint32_t queueDelayMsec = 0);
 
     static void ServiceMgrStatusHandler(void* appState, WEAVE_ERROR err, StatusReport *report);
 
     // Service queue management functions
 
     void SendQueuedMessages(const WeaveTunnelConnectionMgr *connMgr);
-    WEAVE_ERROR EnQueuePacket(PacketBuffer *pkt);
-    PacketBuffer *DeQueuePacket(void);
+    static void HandleQueueDrainTimeout(System::Layer* aSystemLayer, void* aAppState, System::Error aError);
+    static QueueClass ClassifyPacket(const PacketBuffer *pkt);
+    WEAVE_ERROR EnQueuePacket(PacketBuffer *pkt, QueueClass qClass);
+    PacketBuffer *DeQueuePacket(uint32_t *outQueueDelayMsec = NULL);
+    bool IsQueueEmpty(void) const;
     void DumpQueuedMessages(void);
 
     // Tunnel Control post-processing functions
@@ -61,7 +61,7 @@ WEAVE_ERROR WeaveTunnelHeader::EncodeTunnelHeader (WeaveTunnelHeader *tunHeader,
 
     // Verify the right tunnel version is selected.
 
-    if (tunHeader->Version != kWeaveTunnelVersion_V1)
+    if (!IsSupportedVersion(tunHeader->Version))
         ExitNow(err = WEAVE_ERROR_UNSUPPORTED_TUNNEL_VERSION);
 
     p = msg->Start();
@@ -104,9 +104,11 @@ WEAVE_ERROR WeaveTunnelHeader::DecodeTunnelHeader (WeaveTunnelHeader *tunHeader,
 
     p = msg->Start();
 
+    VerifyOrExit(msgLen >= TUN_HDR_SIZE_IN_BYTES, err = WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
     tunHeader->Version = Read8(p);
     // Verify the right tunnel version is selected.
-    if (tunHeader->Version != kWeaveTunnelVersion_V1)
+    if (!IsSupportedVersion(tunHeader->Version))
         ExitNow(err = WEAVE_ERROR_UNSUPPORTED_TUNNEL_VERSION);
 
     if (p > msgEnd)
@@ -121,6 +123,22 @@ exit:
     return err;
 }
 
+/**
+ * Check whether a version of the Tunnel header is supported.
+ *
+ * @param[in] version         The Tunnel header version.
+ *
+ * @return true if the version is supported, else false.
+ */
+bool WeaveTunnelHeader::IsSupportedVersion (uint8_t version)
+{
+    return (version == kWeaveTunnelVersion_V1
+#if WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+            || version == kWeaveTunnelVersion_V2
+#endif // WEAVE_CONFIG_TUNNEL_AGGREGATION_SUPPORTED
+           );
+}
+
 /**
  * Encode Tunnel route containing the set of prefixes into the PacketBuffer containing
  * the Tunnel Control message being sent.
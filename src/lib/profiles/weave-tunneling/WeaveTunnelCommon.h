@@ -47,6 +47,7 @@
 #define NL_TUNNEL_LIVENESS_TYPE_SIZE_IN_BYTES          (1)
 #define NL_TUNNEL_LIVENESS_MAX_TIMEOUT_SIZE_IN_BYTES   (2)
 #define TUN_HDR_SIZE_IN_BYTES                          (TUN_HDR_VERSION_FIELD_SIZE_IN_BYTES)
+#define TUN_AGG_PKT_LEN_FIELD_SIZE_IN_BYTES            (2)
 
 // clang-format on
 
@@ -141,6 +142,11 @@ public:
  */
     static WEAVE_ERROR DecodeTunnelHeader(WeaveTunnelHeader *tunHeader,
                                           PacketBuffer *message);
+
+/**
+ * Check whether a version of the Tunnel header is supported.
+ */
+    static bool IsSupportedVersion(uint8_t version);
 };
 
 // Weave Tunnel Route
@@ -196,7 +202,8 @@ public:
 // Version of the Weave Tunnel Subsystem
 typedef enum WeaveTunnelVersion
 {
-    kWeaveTunnelVersion_V1 = 1
+    kWeaveTunnelVersion_V1 = 1,
+    kWeaveTunnelVersion_V2 = 2  // Aggregated: a sequence of IPv6 packets, each preceded by its 2-byte length.
 } WeaveTunnelVersion;
 
 }
@@ -78,6 +78,10 @@ WEAVE_ERROR WeaveTunnelConnectionMgr::Init(WeaveTunnelAgent *tunAgent,
     mSrcInterfaceType                 = srcIntfType;
     mMaxFailedConAttemptsBeforeNotify = WEAVE_CONFIG_TUNNELING_MAX_NUM_CONNECT_BEFORE_NOTIFY;
     mServiceConnDelayPolicyCallback   = DefaultReconnectPolicyCallback;
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    mConnectStartTime                 = 0;
+    mConnectCompleteTime              = 0;
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
     mResetReconnectArmed              = false;
     if (connIntfName)
     {
@@ -324,6 +328,9 @@ WEAVE_ERROR WeaveTunnelConnectionMgr::TryConnectingNow(void)
     {
         tunStats->mTunnelConnAttemptCount++;
     }
+
+    mConnectStartTime = System::Layer::GetClock_MonotonicMS();
+    mConnectCompleteTime = 0;
 #endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
 exit:
     return err;
@@ -725,6 +732,10 @@ void WeaveTunnelConnectionMgr::HandleServiceConnectionComplete(WeaveConnection *
 
     // Set here the Tunneled Data handler and ConnectionClosed handler.
 
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    tConnMgr->mConnectCompleteTime = System::Layer::GetClock_MonotonicMS();
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+
     tConnMgr->mServiceCon->OnConnectionClosed = HandleServiceConnectionClosed;
     tConnMgr->mServiceCon->OnTunneledMessageReceived = RecvdFromService;
 
@@ -962,7 +973,12 @@ void WeaveTunnelConnectionMgr::TunnelLivenessTimeout(System::Layer* aSystemLayer
 /* Schedule a timer for sending a Tunnel Liveness control message */
 void WeaveTunnelConnectionMgr::StartLivenessTimer(void)
 {
-    mTunAgent->mExchangeMgr->MessageLayer->SystemLayer->StartTimer(mTunnelLivenessInterval * nl::Weave::System::kTimerFactor_milli_per_unit, TunnelLivenessTimeout, this);
+    // The liveness message may go out early by up to the periodic timer tolerance, so that its timer can be coalesced with
+    // others.
+    const uint32_t interval = mTunnelLivenessInterval * nl::Weave::System::kTimerFactor_milli_per_unit;
+    const uint32_t tolerance = interval / 100 * WEAVE_CONFIG_PERIODIC_TIMER_TOLERANCE_PERCENT;
+
+    mTunAgent->mExchangeMgr->MessageLayer->SystemLayer->StartTimer(interval - tolerance, tolerance, TunnelLivenessTimeout, this);
 }
 
 /* Stop the Tunnel Liveness timer for sending a Tunnel Liveness control message */
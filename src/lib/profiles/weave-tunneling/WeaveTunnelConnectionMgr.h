@@ -294,6 +294,14 @@ class NL_DLL_EXPORT WeaveTunnelConnectionMgr
 
     WeaveConnection *mServiceCon;
 
+#if WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+    // Monotonic times at which the last connection to the Service was
+    // started and completed, for the tunnel establishment statistics.
+
+    uint64_t mConnectStartTime;
+    uint64_t mConnectCompleteTime;
+#endif // WEAVE_CONFIG_TUNNEL_ENABLE_STATISTICS
+
 #if WEAVE_CONFIG_TUNNEL_TCP_KEEPALIVE_SUPPORTED
     // TCP connection keepalive interval (in secs)
 
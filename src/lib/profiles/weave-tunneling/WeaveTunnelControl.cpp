@@ -449,6 +449,8 @@ void WeaveTunnelControl::DisableShortcutTunneling (void)
     }
 
     StopNextHopTableMonitor();
+
+    mTunnelAgent->InvalidateRouteCache();
 }
 
 /**
@@ -458,12 +460,35 @@ WEAVE_ERROR WeaveTunnelControl::SendMessageOverTunnelShortcut(uint64_t peerId,
                                                               WeaveMessageInfo *msgInfo,
                                                               PacketBuffer *msg)
 {
-    WEAVE_ERROR err = WEAVE_NO_ERROR;
-    int nextHopTableIndex  = -1;
+    return SendMessageToShortcutTunnelPeer(FindTunnelPeerEntry(peerId), msgInfo, msg);
+}
 
-    nextHopTableIndex = FindTunnelPeerEntry(peerId);
+/**
+ * Look up the index of a peer in the tunnel shortcut cache.
+ *
+ * @param[in] peerId         The identifier of the peer; the NodeId of a Mobile client or the
+ *                           FabricId of a Border gateway.
+ *
+ * @return the index of the peer's entry, or -1 if the peer is not present.
+ */
+int WeaveTunnelControl::LookupShortcutTunnelPeer(uint64_t peerId)
+{
+    return FindTunnelPeerEntry(peerId);
+}
+
+/**
+ * Send message over the tunnel shortcut to the peer at an index in the
+ * tunnel shortcut cache, as returned by LookupShortcutTunnelPeer().
+ */
+WEAVE_ERROR WeaveTunnelControl::SendMessageToShortcutTunnelPeer(int nextHopTableIndex,
+                                                                WeaveMessageInfo *msgInfo,
+                                                                PacketBuffer *msg)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    VerifyOrExit(nextHopTableIndex >= 0, err = WEAVE_ERROR_TUNNEL_PEER_ENTRY_NOT_FOUND);
+    VerifyOrExit(nextHopTableIndex >= 0 && nextHopTableIndex < WEAVE_CONFIG_TUNNELING_MAX_NUM_SHORTCUT_TUNNEL_PEERS &&
+                 ShortcutTunnelPeerCache[nextHopTableIndex].peerIdentifier != 0,
+                 err = WEAVE_ERROR_TUNNEL_PEER_ENTRY_NOT_FOUND);
 
     // For shortcut tunneling explicitly set the destination node id from neighbor cache
 
@@ -657,6 +682,10 @@ WEAVE_ERROR WeaveTunnelControl::FreeNextHopEntry (int index)
 
     memset(&ShortcutTunnelPeerCache[index], 0, sizeof(ShortcutTunnelPeerEntry));
 
+    // Routes cached for the peer are no longer valid.
+
+    mTunnelAgent->InvalidateRouteCache();
+
 exit:
 
     return err;
@@ -679,6 +708,10 @@ WEAVE_ERROR WeaveTunnelControl::UpdateOrAddTunnelPeerEntry (uint64_t peerId, IPA
         {
             ExitNow(err = WEAVE_ERROR_TUNNEL_NEXTHOP_TABLE_FULL);
         }
+
+        // Destinations cached as going to the Service may now have a shortcut.
+
+        mTunnelAgent->InvalidateRouteCache();
     }
 
     // Update the fields in the cache.
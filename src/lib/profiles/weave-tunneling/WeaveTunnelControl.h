@@ -154,6 +154,16 @@ public:
  */
     WEAVE_ERROR SendMessageOverTunnelShortcut(uint64_t peerId, WeaveMessageInfo *msgHdr, PacketBuffer *msg);
 
+/**
+ * Look up the index of the peer in the tunnel shortcut cache; -1 if not present.
+ */
+    int LookupShortcutTunnelPeer(uint64_t peerId);
+
+/**
+ * Send message over the tunnel shortcut to the peer at an index in the tunnel shortcut cache.
+ */
+    WEAVE_ERROR SendMessageToShortcutTunnelPeer(int peerIndex, WeaveMessageInfo *msgHdr, PacketBuffer *msg);
+
 private:
 
     WEAVE_ERROR CreateContext(WeaveConnection *aConnection,
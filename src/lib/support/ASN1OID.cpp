@@ -38,30 +38,65 @@ namespace nl {
 namespace Weave {
 namespace ASN1 {
 
+// Hash function used by the perfect hash tables in ASN1OID.h.  MUST match oidHash() in gen-oid-table.py.
+static uint32_t OIDHash(const uint8_t *key, uint16_t keyLen, uint8_t seed)
+{
+    uint32_t h = 2166136261UL ^ (seed * 16777619UL);
+
+    for (uint16_t i = 0; i < keyLen; i++)
+        h = (h ^ key[i]) * 16777619UL;
+
+    return h ^ (h >> 16);
+}
+
+// Return the only sOIDTable index at which the given key could appear, or -1 if it cannot appear in the table.
+// Callers must confirm the match against the table entry.
+static int LookupOIDTableIndex(const uint8_t *key, uint16_t keyLen, const uint8_t *seeds, const uint8_t *slots)
+{
+    uint8_t seed = seeds[OIDHash(key, keyLen, 0) % kOIDHashBucketCount];
+    uint8_t index;
+
+    if (seed == 0)
+        return -1;
+
+    index = slots[OIDHash(key, keyLen, seed) & (kOIDHashSlotCount - 1)];
+
+    return (index != kOIDHashEmptySlot) ? index : -1;
+}
+
+static int LookupOIDTableIndex(OID oid)
+{
+    uint8_t key[2] = { (uint8_t)(oid >> 8), (uint8_t)oid };
+    int index = LookupOIDTableIndex(key, sizeof(key), sOIDEnumHashSeeds, sOIDEnumHashSlots);
+
+    return (index >= 0 && sOIDTable[index].EnumVal == oid) ? index : -1;
+}
+
 NL_DLL_EXPORT OID ParseObjectID(const uint8_t *encodedOID, uint16_t encodedOIDLen)
 {
+    int index;
+
     if (encodedOID == NULL or encodedOIDLen == 0)
         return kOID_NotSpecified;
 
-    for (uint32_t i = 0; i < sOIDTableSize; i++)
-        if (encodedOIDLen == sOIDTable[i].EncodedOIDLen &&
-            memcmp(encodedOID, sOIDTable[i].EncodedOID, encodedOIDLen) == 0)
-            return sOIDTable[i].EnumVal;
+    index = LookupOIDTableIndex(encodedOID, encodedOIDLen, sOIDHashSeeds, sOIDHashSlots);
+    if (index >= 0 && encodedOIDLen == sOIDTable[index].EncodedOIDLen &&
+        memcmp(encodedOID, sOIDTable[index].EncodedOID, encodedOIDLen) == 0)
+        return sOIDTable[index].EnumVal;
 
     return kOID_Unknown;
 }
 
 bool GetEncodedObjectID(OID oid, const uint8_t *& encodedOID, uint16_t& encodedOIDLen)
 {
-    for (uint32_t i = 0; i < sOIDTableSize; i++)
-        if (oid == sOIDTable[i].EnumVal)
-        {
-            encodedOID = sOIDTable[i].EncodedOID;
-            encodedOIDLen = sOIDTable[i].EncodedOIDLen;
-            return true;
-        }
-
-    return false;
+    int index = LookupOIDTableIndex(oid);
+
+    if (index < 0)
+        return false;
+
+    encodedOID = sOIDTable[index].EncodedOID;
+    encodedOIDLen = sOIDTable[index].EncodedOIDLen;
+    return true;
 }
 
 OIDCategory GetOIDCategory(OID oid)
@@ -79,10 +114,10 @@ const char *GetOIDName(OID oid)
         return "Unknown";
     if (oid == kOID_NotSpecified)
         return "NotSpecified";
-    for (uint32_t i = 0; i < sOIDTableSize; i++)
-        if (oid == sOIDNameTable[i].EnumVal)
-            return sOIDNameTable[i].Name;
-    return "Unknown";
+
+    // sOIDNameTable is in the same order as sOIDTable.
+    int index = LookupOIDTableIndex(oid);
+    return (index >= 0) ? sOIDNameTable[index].Name : "Unknown";
 }
 
 ASN1_ERROR ASN1Reader::GetObjectId(OID& oid)
@@ -26,12 +26,48 @@
 #define __STDC_LIMIT_MACROS
 #endif
 #include <ctype.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "Base64.h"
 
+#include <Weave/Support/CodeUtils.h>
+
 namespace nl {
 
+// Alphabets and reverse lookup tables used by the block-at-a-time fast paths below.  The reverse tables cover
+// 7-bit characters only; any entry >= 64 marks a character that is not part of the alphabet (including '=').
+static const char sBase64Alphabet[64 + 1]    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char sBase64URLAlphabet[64 + 1] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+#define X 0xFF
+static const uint8_t sBase64DecodeTable[128] = {
+    X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+    X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+    X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  62, X,  X,  X,  63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, X,  X,  X,  X,  X,  X,
+    X,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, X,  X,  X,  X,  X,
+    X,  26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, X,  X,  X,  X,  X
+};
+static const uint8_t sBase64URLDecodeTable[128] = {
+    X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+    X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,
+    X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  X,  62, X,  X,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, X,  X,  X,  X,  X,  X,
+    X,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, X,  X,  X,  X,  63,
+    X,  26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, X,  X,  X,  X,  X
+};
+#undef X
+
+static inline uint8_t TableCharToVal(const uint8_t *table, uint8_t c)
+{
+    return (c < 128) ? table[c] : UINT8_MAX;
+}
+
 // Convert a value in the range 0..63 to its equivalent base64 character.
 // Return '=' for any value >= 64.
 static char Base64ValToChar(uint8_t val)
@@ -110,10 +146,71 @@ static uint8_t Base64URLCharToVal(uint8_t c)
     return UINT8_MAX;
 }
 
-uint16_t Base64Encode(const uint8_t *in, uint16_t inLen, char *out, Base64ValToCharFunct valToCharFunct)
+// Encode complete 3-byte groups using a lookup table, returning the number of input bytes consumed.
+static uint32_t EncodeGroups(const uint8_t *in, uint32_t inLen, char *out, const char *alphabet)
+{
+    const uint8_t *inStart = in;
+
+    while (inLen >= 3)
+    {
+        uint32_t group = ((uint32_t)in[0] << 16) | ((uint32_t)in[1] << 8) | in[2];
+
+        out[0] = alphabet[(group >> 18) & 0x3F];
+        out[1] = alphabet[(group >> 12) & 0x3F];
+        out[2] = alphabet[(group >> 6) & 0x3F];
+        out[3] = alphabet[group & 0x3F];
+
+        in += 3;
+        inLen -= 3;
+        out += 4;
+    }
+
+    return in - inStart;
+}
+
+// Decode complete 4-character groups that contain no padding or invalid characters using a lookup table,
+// returning the number of input characters consumed.  Decoding stops at the first group that does not qualify,
+// leaving it to the character-at-a-time decoder.  Safe for in-place use, since output never overtakes input.
+static uint32_t DecodeGroups(const char *in, uint32_t inLen, uint8_t *out, const uint8_t *table)
+{
+    const char *inStart = in;
+
+    while (inLen >= 4)
+    {
+        uint8_t a = TableCharToVal(table, in[0]);
+        uint8_t b = TableCharToVal(table, in[1]);
+        uint8_t c = TableCharToVal(table, in[2]);
+        uint8_t d = TableCharToVal(table, in[3]);
+
+        if ((a | b | c | d) & 0xC0)
+            break;
+
+        out[0] = (a << 2) | (b >> 4);
+        out[1] = (b << 4) | (c >> 2);
+        out[2] = (c << 6) | d;
+
+        in += 4;
+        inLen -= 4;
+        out += 3;
+    }
+
+    return in - inStart;
+}
+
+static uint16_t Base64Encode(const uint8_t *in, uint16_t inLen, char *out, const char *alphabet,
+                             Base64ValToCharFunct valToCharFunct)
 {
     char *outStart = out;
 
+    if (alphabet != NULL)
+    {
+        uint16_t consumed = static_cast<uint16_t>(EncodeGroups(in, inLen, out, alphabet));
+
+        in += consumed;
+        inLen -= consumed;
+        out += consumed / 3 * 4;
+    }
+
     while (inLen > 0)
     {
         uint8_t val1, val2, val3, val4;
@@ -150,17 +247,23 @@ uint16_t Base64Encode(const uint8_t *in, uint16_t inLen, char *out, Base64ValToC
     return out - outStart;
 }
 
+uint16_t Base64Encode(const uint8_t *in, uint16_t inLen, char *out, Base64ValToCharFunct valToCharFunct)
+{
+    return Base64Encode(in, inLen, out, NULL, valToCharFunct);
+}
+
 uint16_t Base64Encode(const uint8_t *in, uint16_t inLen, char *out)
 {
-    return Base64Encode(in, inLen, out, Base64ValToChar);
+    return Base64Encode(in, inLen, out, sBase64Alphabet, Base64ValToChar);
 }
 
 uint16_t Base64URLEncode(const uint8_t *in, uint16_t inLen, char *out)
 {
-    return Base64Encode(in, inLen, out, Base64URLValToChar);
+    return Base64Encode(in, inLen, out, sBase64URLAlphabet, Base64URLValToChar);
 }
 
-uint32_t Base64Encode32(const uint8_t *in, uint32_t inLen, char *out, Base64ValToCharFunct valToCharFunct)
+static uint32_t Base64Encode32(const uint8_t *in, uint32_t inLen, char *out, const char *alphabet,
+                               Base64ValToCharFunct valToCharFunct)
 {
     uint32_t outLen = 0;
 
@@ -173,7 +276,7 @@ uint32_t Base64Encode32(const uint8_t *in, uint32_t inLen, char *out, Base64ValT
     {
         uint16_t inChunkLen = (inLen > kMaxConvert) ? (uint16_t)kMaxConvert : (uint16_t)inLen;
 
-        uint16_t outChunkLen = Base64Encode(in, inChunkLen, out, valToCharFunct);
+        uint16_t outChunkLen = Base64Encode(in, inChunkLen, out, alphabet, valToCharFunct);
 
         inLen -= inChunkLen;
         outLen += outChunkLen;
@@ -188,15 +291,30 @@ uint32_t Base64Encode32(const uint8_t *in, uint32_t inLen, char *out, Base64ValT
     return outLen;
 }
 
+uint32_t Base64Encode32(const uint8_t *in, uint32_t inLen, char *out, Base64ValToCharFunct valToCharFunct)
+{
+    return Base64Encode32(in, inLen, out, NULL, valToCharFunct);
+}
+
 uint32_t Base64Encode32(const uint8_t *in, uint32_t inLen, char *out)
 {
-    return Base64Encode32(in, inLen, out, Base64ValToChar);
+    return Base64Encode32(in, inLen, out, sBase64Alphabet, Base64ValToChar);
 }
 
-uint16_t Base64Decode(const char *in, uint16_t inLen, uint8_t *out, Base64CharToValFunct charToValFunct)
+static uint16_t Base64Decode(const char *in, uint16_t inLen, uint8_t *out, const uint8_t *table,
+                             Base64CharToValFunct charToValFunct)
 {
     uint8_t *outStart = out;
 
+    if (table != NULL)
+    {
+        uint16_t consumed = static_cast<uint16_t>(DecodeGroups(in, inLen, out, table));
+
+        in += consumed;
+        inLen -= consumed;
+        out += consumed / 4 * 3;
+    }
+
     // isgraph() returns false for space and ctrl chars
     while (inLen > 0 && isgraph(*in))
     {
@@ -241,17 +359,23 @@ fail:
     return UINT16_MAX;
 }
 
+uint16_t Base64Decode(const char *in, uint16_t inLen, uint8_t *out, Base64CharToValFunct charToValFunct)
+{
+    return Base64Decode(in, inLen, out, NULL, charToValFunct);
+}
+
 uint16_t Base64Decode(const char *in, uint16_t inLen, uint8_t *out)
 {
-    return Base64Decode(in, inLen, out, Base64CharToVal);
+    return Base64Decode(in, inLen, out, sBase64DecodeTable, Base64CharToVal);
 }
 
 uint16_t Base64URLDecode(const char *in, uint16_t inLen, uint8_t *out)
 {
-    return Base64Decode(in, inLen, out, Base64URLCharToVal);
+    return Base64Decode(in, inLen, out, sBase64URLDecodeTable, Base64URLCharToVal);
 }
 
-uint32_t Base64Decode32(const char *in, uint32_t inLen, uint8_t *out, Base64CharToValFunct charToValFunct)
+static uint32_t Base64Decode32(const char *in, uint32_t inLen, uint8_t *out, const uint8_t *table,
+                               Base64CharToValFunct charToValFunct)
 {
     uint32_t outLen = 0;
 
@@ -263,7 +387,7 @@ uint32_t Base64Decode32(const char *in, uint32_t inLen, uint8_t *out, Base64Char
     {
         uint16_t inChunkLen = (inLen > kMaxConvert) ? (uint16_t)kMaxConvert : (uint16_t)inLen;
 
-        uint16_t outChunkLen = Base64Decode(in, inChunkLen, out, charToValFunct);
+        uint16_t outChunkLen = Base64Decode(in, inChunkLen, out, table, charToValFunct);
         if (outChunkLen == UINT16_MAX)
             return UINT32_MAX;
 
@@ -280,9 +404,187 @@ uint32_t Base64Decode32(const char *in, uint32_t inLen, uint8_t *out, Base64Char
     return outLen;
 }
 
+uint32_t Base64Decode32(const char *in, uint32_t inLen, uint8_t *out, Base64CharToValFunct charToValFunct)
+{
+    return Base64Decode32(in, inLen, out, NULL, charToValFunct);
+}
+
 uint32_t Base64Decode32(const char *in, uint32_t inLen, uint8_t *out)
 {
-    return Base64Decode32(in, inLen, out, Base64CharToVal);
+    return Base64Decode32(in, inLen, out, sBase64DecodeTable, Base64CharToVal);
+}
+
+void Base64Encoder::Init(void)
+{
+    mAlphabet = sBase64Alphabet;
+    mNumPending = 0;
+}
+
+void Base64Encoder::InitURL(void)
+{
+    mAlphabet = sBase64URLAlphabet;
+    mNumPending = 0;
+}
+
+uint32_t Base64Encoder::Update(const uint8_t *in, uint32_t inLen, char *out)
+{
+    char *outStart = out;
+    uint32_t consumed;
+
+    // Complete any group left over from the previous call.
+    if (mNumPending > 0)
+    {
+        while (mNumPending < 3 && inLen > 0)
+        {
+            mPending[mNumPending++] = *in++;
+            inLen--;
+        }
+
+        if (mNumPending < 3)
+            return 0;
+
+        EncodeGroups(mPending, 3, out, mAlphabet);
+        out += 4;
+        mNumPending = 0;
+    }
+
+    consumed = EncodeGroups(in, inLen, out, mAlphabet);
+    out += consumed / 3 * 4;
+
+    // Hold back the remainder until more input arrives or the stream is finished.
+    while (consumed < inLen)
+        mPending[mNumPending++] = in[consumed++];
+
+    return out - outStart;
+}
+
+uint32_t Base64Encoder::Finalize(char *out)
+{
+    uint32_t outLen = 0;
+
+    if (mNumPending > 0)
+    {
+        uint8_t val2 = (mPending[0] << 4) & 0x3F;
+
+        out[0] = mAlphabet[mPending[0] >> 2];
+        if (mNumPending == 2)
+        {
+            out[1] = mAlphabet[val2 | (mPending[1] >> 4)];
+            out[2] = mAlphabet[(mPending[1] << 2) & 0x3F];
+        }
+        else
+        {
+            out[1] = mAlphabet[val2];
+            out[2] = '=';
+        }
+        out[3] = '=';
+
+        outLen = 4;
+        mNumPending = 0;
+    }
+
+    return outLen;
+}
+
+void Base64Decoder::Init(void)
+{
+    mTable = sBase64DecodeTable;
+    mNumPending = 0;
+    mState = kState_Data;
+}
+
+void Base64Decoder::InitURL(void)
+{
+    mTable = sBase64URLDecodeTable;
+    mNumPending = 0;
+    mState = kState_Data;
+}
+
+uint32_t Base64Decoder::Update(const char *in, uint32_t inLen, uint8_t *out)
+{
+    uint8_t *outStart = out;
+
+    VerifyOrExit(mState != kState_Error, );
+
+    while (inLen > 0)
+    {
+        uint8_t c;
+        uint8_t val;
+
+        // Decode whole groups directly from the input whenever possible.
+        if (mNumPending == 0 && mState == kState_Data)
+        {
+            uint32_t consumed = DecodeGroups(in, inLen, out, mTable);
+
+            in += consumed;
+            inLen -= consumed;
+            out += consumed / 4 * 3;
+
+            if (inLen == 0)
+                break;
+        }
+
+        c = *in++;
+        inLen--;
+
+        if (isspace(c))
+            continue;
+
+        if (c == '=')
+        {
+            // Padding may only complete a group of two or three characters, and nothing but further padding
+            // may follow it.
+            if (mState == kState_Data)
+            {
+                VerifyOrExit(mNumPending >= 2, mState = kState_Error);
+                out += DecodePending(out);
+                mState = kState_Padding;
+            }
+            continue;
+        }
+
+        VerifyOrExit(mState == kState_Data, mState = kState_Error);
+
+        val = TableCharToVal(mTable, c);
+        VerifyOrExit(val < 64, mState = kState_Error);
+
+        mPending[mNumPending++] = val;
+        if (mNumPending == 4)
+            out += DecodePending(out);
+    }
+
+exit:
+    return (mState == kState_Error) ? UINT32_MAX : (uint32_t)(out - outStart);
+}
+
+uint32_t Base64Decoder::Finalize(uint8_t *out)
+{
+    uint32_t outLen = 0;
+
+    VerifyOrExit(mState != kState_Error, );
+
+    // Accept a final group that has been left unpadded, as Base64Decode() does.
+    VerifyOrExit(mNumPending != 1, mState = kState_Error);
+    outLen = DecodePending(out);
+
+exit:
+    return (mState == kState_Error) ? UINT32_MAX : outLen;
+}
+
+uint8_t Base64Decoder::DecodePending(uint8_t *out)
+{
+    uint8_t outLen = 0;
+
+    if (mNumPending >= 2)
+        out[outLen++] = (mPending[0] << 2) | (mPending[1] >> 4);
+    if (mNumPending >= 3)
+        out[outLen++] = (mPending[1] << 4) | (mPending[2] >> 2);
+    if (mNumPending == 4)
+        out[outLen++] = (mPending[2] << 6) | mPending[3];
+
+    mNumPending = 0;
+
+    return outLen;
 }
 
 
@@ -77,6 +77,83 @@ extern uint32_t Base64Decode32(const char *in, uint32_t inLen, uint8_t *out, Bas
  */
 #define BASE64_MAX_DECODED_LEN(LEN) ((LEN) * 3 / 4)
 
+/**
+ * Incremental base-64 encoder, for inputs that are produced or consumed in pieces.
+ *
+ * Produces the same output as Base64Encode32() (or Base64URLEncode(), when initialized with InitURL()) would
+ * for the concatenation of all input passed to Update().
+ */
+class Base64Encoder
+{
+public:
+    void Init(void);
+    void InitURL(void);
+
+    // Encode the next piece of input.
+    //
+    // Returns the number of characters written, which covers only complete 3-byte groups; up to 2 bytes
+    // are held back until the next call to Update() or Finalize().
+    // Output buffer must be at least BASE64_ENCODED_LEN(inLen) bytes long.
+    // Input and output buffers CANNOT overlap.
+    //
+    uint32_t Update(const uint8_t *in, uint32_t inLen, char *out);
+
+    // Encode any held-back input, followed by padding.
+    //
+    // Returns the number of characters written (0 or 4). Output buffer must be at least 4 bytes long.
+    //
+    uint32_t Finalize(char *out);
+
+private:
+    const char *mAlphabet;
+    uint8_t mPending[3];
+    uint8_t mNumPending;
+};
+
+/**
+ * Incremental base-64 decoder, for inputs that are produced or consumed in pieces.
+ *
+ * Unlike Base64Decode(), whitespace anywhere in the input (e.g. line breaks in PEM data) is skipped rather than
+ * ending the input.  As with Base64Decode(), the final group may be left unpadded.  Once an error has been reported
+ * all subsequent calls fail until the decoder is re-initialized.
+ */
+class Base64Decoder
+{
+public:
+    void Init(void);
+    void InitURL(void);
+
+    // Decode the next piece of input.
+    //
+    // Returns the number of bytes written, or UINT32_MAX if the input could not be decoded.
+    // Output buffer must be at least BASE64_MAX_DECODED_LEN(inLen + 3) bytes long.
+    // Input and output buffers CANNOT overlap.
+    //
+    uint32_t Update(const char *in, uint32_t inLen, uint8_t *out);
+
+    // Decode any trailing unpadded group.
+    //
+    // Returns the number of bytes written (0 to 2), or UINT32_MAX if the input was invalid or truncated.
+    // Output buffer must be at least 2 bytes long.
+    //
+    uint32_t Finalize(uint8_t *out);
+
+private:
+    enum
+    {
+        kState_Data,
+        kState_Padding,
+        kState_Error
+    };
+
+    uint8_t DecodePending(uint8_t *out);
+
+    const uint8_t *mTable;
+    uint8_t mPending[4];
+    uint8_t mNumPending;
+    uint8_t mState;
+};
+
 
 } // namespace nl
 
@@ -0,0 +1,120 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements the reporting side of the Weave performance
+ *      instrumentation counters.
+ *
+ */
+
+#ifndef __STDC_FORMAT_MACROS
+#define __STDC_FORMAT_MACROS
+#endif
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <Weave/Support/PerfInstrumentation.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+
+#if WEAVE_CONFIG_PERF_INSTRUMENTATION
+
+namespace nl {
+namespace Weave {
+namespace PerfInstrumentation {
+
+SectionStats gStats[kSection_Max];
+
+static const char * const sSectionNames[kSection_Max] =
+{
+    "MessageEncryption",
+    "TLVEncode",
+    "TLVDecode",
+    "WDMNotifyBuild",
+    "EventLogging",
+};
+
+/**
+ * Start the counter running, if the platform requires it.
+ *
+ * On Cortex-M this enables the DWT cycle counter, which is otherwise stopped out of reset.  It is called from
+ * WeaveMessageLayer::Init(); applications that time sections before the message layer is initialized should call it
+ * first.  On other platforms it does nothing.
+ */
+void EnableCounter(void)
+{
+#if WEAVE_PERF_COUNTER_DWT
+    // Set DEMCR.TRCENA to power the DWT unit, then DWT_CTRL.CYCCNTENA to start the cycle counter.
+    *reinterpret_cast<volatile uint32_t *>(0xE000EDFC) |= (1UL << 24);
+    *reinterpret_cast<volatile uint32_t *>(0xE0001000) |= 1UL;
+#endif
+}
+
+/**
+ * Zero the statistics of all sections.
+ */
+void ResetStats(void)
+{
+    memset(gStats, 0, sizeof(gStats));
+}
+
+/**
+ * Get the name of a section, as used by DumpStats().
+ */
+const char *GetSectionName(Section section)
+{
+    return (section < kSection_Max) ? sSectionNames[section] : "(unknown)";
+}
+
+/**
+ * Get the unit in which the counter, and so SectionStats::TotalCount, is measured.
+ */
+const char *GetCounterUnits(void)
+{
+#if WEAVE_PERF_COUNTER_DWT || WEAVE_PERF_COUNTER_TSC
+    return "cycles";
+#elif WEAVE_PERF_COUNTER_CLOCK_GETTIME
+    return "ns";
+#else
+    return "us";
+#endif
+}
+
+/**
+ * Log the cumulative statistics of every section.
+ */
+void DumpStats(void)
+{
+    WeaveLogProgress(Support, "Perf counters (%s):", GetCounterUnits());
+
+    for (int i = 0; i < kSection_Max; i++)
+    {
+        const SectionStats &stats = gStats[i];
+
+        WeaveLogProgress(Support, "  %-18s total %" PRIu64 " entries %" PRIu32 " avg %" PRIu64,
+                         sSectionNames[i], stats.TotalCount, stats.Entries,
+                         (stats.Entries != 0) ? stats.TotalCount / stats.Entries : 0);
+    }
+}
+
+} // namespace PerfInstrumentation
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_PERF_INSTRUMENTATION
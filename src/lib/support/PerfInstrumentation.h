@@ -0,0 +1,175 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines cycle counters that accumulate the time spent in
+ *      the hot paths of the Weave stack, for use in performance builds.
+ *
+ *      The counters are compiled in only when
+ *      #WEAVE_CONFIG_PERF_INSTRUMENTATION is set, which the
+ *      --enable-perf-instrumentation configure option does.  Otherwise
+ *      #WEAVE_PERF_SCOPE expands to nothing.
+ *
+ *      The counters are updated without locking; sections timed
+ *      concurrently on several threads may lose updates.
+ */
+
+#ifndef PERF_INSTRUMENTATION_H_
+#define PERF_INSTRUMENTATION_H_
+
+#include <stdint.h>
+
+#include <Weave/Core/WeaveConfig.h>
+#include <Weave/Support/NLDLLUtil.h>
+
+#if WEAVE_CONFIG_PERF_INSTRUMENTATION
+
+#if defined(__arm__) && (defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__))
+#define WEAVE_PERF_COUNTER_DWT 1
+#elif defined(__x86_64__) || defined(__i386__)
+#define WEAVE_PERF_COUNTER_TSC 1
+#elif HAVE_CLOCK_GETTIME
+#include <time.h>
+#define WEAVE_PERF_COUNTER_CLOCK_GETTIME 1
+#else
+#include <SystemLayer/SystemClock.h>
+#endif
+
+namespace nl {
+namespace Weave {
+namespace PerfInstrumentation {
+
+/**
+ * The instrumented sections of the stack.
+ *
+ * Different sections may nest, in which case each is charged the full time spent within it; the TLV encoding done
+ * while building a WDM notification, for example, is counted both as TLV encoding and as building the notification.
+ */
+enum Section
+{
+    kSection_MessageEncryption          = 0,    /**< Encryption, decryption and integrity checks of Weave messages. */
+    kSection_TLVEncode,                         /**< Writing of individual TLV element heads. */
+    kSection_TLVDecode,                         /**< Reading of individual TLV elements. */
+    kSection_WDMNotifyBuild,                    /**< Building of WDM notify requests. */
+    kSection_EventLogging,                      /**< Logging of WDM events. */
+
+    kSection_Max
+};
+
+/**
+ * The raw value of the counter.  On Cortex-M the 32-bit DWT cycle counter wraps; differences remain correct for
+ * sections shorter than the wrap period.
+ */
+#if WEAVE_PERF_COUNTER_DWT
+typedef uint32_t CounterValue;
+#else
+typedef uint64_t CounterValue;
+#endif
+
+/**
+ * Cumulative statistics for one section.
+ */
+struct SectionStats
+{
+    uint64_t TotalCount;                        /**< Total counter ticks spent in the section. */
+    uint32_t Entries;                           /**< Number of times the section was entered, not counting re-entry. */
+    uint16_t Depth;                             /**< Current nesting depth of the section. */
+};
+
+extern NL_DLL_EXPORT SectionStats gStats[kSection_Max];
+
+/**
+ * Read the free-running counter used to time sections.
+ *
+ * The counter ticks CPU cycles where the processor provides a cycle counter (DWT on Cortex-M, the time stamp counter on
+ * x86), otherwise nanoseconds (clock_gettime()) or, failing that, microseconds (the system layer's high-resolution
+ * monotonic clock).  GetCounterUnits() names the unit.
+ */
+inline CounterValue ReadCounter(void)
+{
+#if WEAVE_PERF_COUNTER_DWT
+    return *reinterpret_cast<volatile uint32_t *>(0xE0001004);
+#elif WEAVE_PERF_COUNTER_TSC
+    uint32_t lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+#elif WEAVE_PERF_COUNTER_CLOCK_GETTIME
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else
+    return System::Platform::Layer::GetClock_MonotonicHiRes();
+#endif
+}
+
+/**
+ * Charge a number of counter ticks to a section.
+ */
+inline void Record(Section section, CounterValue ticks)
+{
+    gStats[section].TotalCount += ticks;
+    gStats[section].Entries++;
+}
+
+/**
+ * Times the enclosing block and charges it to a section when the block exits.  Use #WEAVE_PERF_SCOPE rather than
+ * naming this class directly.
+ */
+class Scope
+{
+public:
+    inline explicit Scope(Section section) : mStart(ReadCounter()), mSection(section) { gStats[section].Depth++; }
+    inline ~Scope(void)
+    {
+        // When a section re-enters itself, as TLV decoding does when skipping containers, only the outermost entry is
+        // charged so that no time is counted twice.
+        if (--gStats[mSection].Depth == 0)
+            Record(mSection, ReadCounter() - mStart);
+    }
+
+private:
+    CounterValue mStart;
+    Section mSection;
+};
+
+extern void EnableCounter(void);
+extern void ResetStats(void);
+extern const char *GetSectionName(Section section);
+extern const char *GetCounterUnits(void);
+extern void DumpStats(void);
+
+} // namespace PerfInstrumentation
+} // namespace Weave
+} // namespace nl
+
+/**
+ * Charge the time from this point to the end of the enclosing block to the named section.
+ *
+ * @param[in] aSection  The unqualified name of a nl::Weave::PerfInstrumentation::Section value, e.g. kSection_TLVEncode.
+ */
+#define WEAVE_PERF_SCOPE(aSection) \
+    ::nl::Weave::PerfInstrumentation::Scope _weavePerfScope(::nl::Weave::PerfInstrumentation::aSection)
+
+#else // WEAVE_CONFIG_PERF_INSTRUMENTATION
+
+#define WEAVE_PERF_SCOPE(aSection) do { } while (0)
+
+#endif // WEAVE_CONFIG_PERF_INSTRUMENTATION
+
+#endif // PERF_INSTRUMENTATION_H_
@@ -19,6 +19,7 @@
 #include <Weave/Support/logging/WeaveLogging.h>
 #include <Weave/Support/PersistedCounter.h>
 #include <Weave/Support/platform/PersistedStorage.h>
+#include <SystemLayer/SystemLayer.h>
 
 #include <stdlib.h>
 #include <string.h>
@@ -26,10 +27,20 @@
 namespace nl {
 namespace Weave {
 
+// With deferred writes, the room reserved past the current epoch, in units
+// of the current epoch size.  This leaves room for the next epoch to grow.
+static const uint32_t kLookaheadEpochs = (WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE > 1) ? 2 : 1;
+
 PersistedCounter::PersistedCounter(void) :
     MonotonicallyIncreasingCounter(),
     mStartingCounterValue(0),
-    mEpoch(0)
+    mEpoch(0),
+    mEpochSize(0),
+    mPersistedValue(0),
+    mPendingValue(0),
+    mEpochStartTime(0),
+    mDeferWrites(false),
+    mWritePending(false)
 {
     memset(&mId, 0, sizeof(mId));
 }
@@ -49,7 +60,8 @@ PersistedCounter::Init(const nl::Weave::Platform::PersistedStorage::Key aId,
 
     // Check and store the epoch.
     VerifyOrExit(aEpoch > 0, err = WEAVE_ERROR_INVALID_INTEGER_VALUE);
-    mEpoch = aEpoch;
+    mEpoch = mEpochSize = aEpoch;
+    mWritePending = false;
 
     // Read our previously-stored starting value.
     err = ReadStartValue(mStartingCounterValue);
@@ -68,6 +80,13 @@ PersistedCounter::Init(const nl::Weave::Platform::PersistedStorage::Key aId,
     err = MonotonicallyIncreasingCounter::Init(mStartingCounterValue);
     SuccessOrExit(err);
 
+    mEpochStartTime = System::Layer::GetClock_MonotonicMS();
+
+    if (mDeferWrites)
+    {
+        SetDeferredWrites(true);
+    }
+
 exit:
     return err;
 }
@@ -77,10 +96,43 @@ PersistedCounter::SetValue(uint32_t value)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
 
-    err = WriteStartValue(value + mEpoch);
+    err = WriteStartValue(value + mEpochSize);
     SuccessOrExit(err);
 
     mCounterValue = mStartingCounterValue = value;
+    mWritePending = false;
+    mEpochStartTime = System::Layer::GetClock_MonotonicMS();
+
+    if (mDeferWrites)
+    {
+        SetDeferredWrites(true);
+    }
+
+exit:
+    return err;
+}
+
+void
+PersistedCounter::SetDeferredWrites(bool aEnable)
+{
+    mDeferWrites = aEnable;
+
+    // Reserve the epoch following the current one, so the next epoch can start without writing to storage.
+    mPendingValue = mStartingCounterValue + (1 + kLookaheadEpochs) * mEpochSize;
+    mWritePending = aEnable && static_cast<int32_t>(mPendingValue - mPersistedValue) > 0;
+}
+
+WEAVE_ERROR
+PersistedCounter::WritePending(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    VerifyOrExit(mWritePending, );
+
+    err = WriteStartValue(mPendingValue);
+    SuccessOrExit(err);
+
+    mWritePending = false;
 
 exit:
     return err;
@@ -97,6 +149,7 @@ PersistedCounter::AdvanceEpochRelative(uint32_t aValue)
 {
     WEAVE_ERROR ret;
 
+    mEpochSize = mEpoch;
     mStartingCounterValue = (aValue / mEpoch) * mEpoch;  // Start of enclosing epoch
     mCounterValue = mStartingCounterValue + mEpoch - 1;  // Move to end of enclosing epoch
     ret = IncrementCount(); // Force to next epoch
@@ -115,17 +168,44 @@ PersistedCounter::GetNextValue(uint32_t &aValue)
     // Increment aValue.
     aValue++;
 
-    // If we've exceeded the value with which we started by aEpoch or
-    // more, we need to start a new epoch.
-    if ((aValue - mStartingCounterValue) >= mEpoch)
+    // If we've exceeded the value with which we started by the size of
+    // the epoch or more, we need to start a new epoch.
+    if ((aValue - mStartingCounterValue) >= mEpochSize)
     {
-        aValue = mStartingCounterValue + mEpoch;
+        aValue = mStartingCounterValue + mEpochSize;
         startNewEpoch = true;
     }
 
     return startNewEpoch;
 }
 
+uint32_t
+PersistedCounter::GetNextEpochSize(void) const
+{
+    uint32_t epochSize = mEpochSize;
+
+#if WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE > 1
+    const uint64_t elapsed = System::Layer::GetClock_MonotonicMS() - mEpochStartTime;
+
+    if (elapsed < WEAVE_CONFIG_PERSISTED_COUNTER_TARGET_EPOCH_DURATION_MS / 2)
+    {
+        if ((epochSize / mEpoch) < WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE && epochSize <= UINT32_MAX / 4)
+        {
+            epochSize *= 2;
+        }
+    }
+    else if (elapsed > static_cast<uint64_t>(WEAVE_CONFIG_PERSISTED_COUNTER_TARGET_EPOCH_DURATION_MS) * 2)
+    {
+        if (epochSize > mEpoch)
+        {
+            epochSize /= 2;
+        }
+    }
+#endif // WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE > 1
+
+    return epochSize;
+}
+
 WEAVE_ERROR
 PersistedCounter::IncrementCount(void)
 {
@@ -134,11 +214,30 @@ PersistedCounter::IncrementCount(void)
     // Get the incremented value.
     if (GetNextValue(mCounterValue))
     {
-        // Started a new epoch, so write out the next one.
-        err = WriteStartValue(mCounterValue + mEpoch);
-        SuccessOrExit(err);
+        // Started a new epoch, sized by how quickly the last one was exhausted.
+        const uint32_t epochSize = GetNextEpochSize();
+        const uint32_t epochEnd = mCounterValue + epochSize;
+
+        if (mDeferWrites && static_cast<int32_t>(mPersistedValue - epochEnd) >= 0)
+        {
+            // The new epoch was reserved ahead of time; the owner reserves
+            // the one after it when convenient.
+            mPendingValue = epochEnd + kLookaheadEpochs * epochSize;
+            mWritePending = true;
+        }
+        else
+        {
+            // Write out the next starting value, reserving one more epoch
+            // ahead when writes are deferred.
+            err = WriteStartValue(mDeferWrites ? epochEnd + kLookaheadEpochs * epochSize : epochEnd);
+            SuccessOrExit(err);
+
+            mWritePending = false;
+        }
 
         mStartingCounterValue = mCounterValue;
+        mEpochSize = epochSize;
+        mEpochStartTime = System::Layer::GetClock_MonotonicMS();
     }
 
 exit:
@@ -152,7 +251,14 @@ PersistedCounter::WriteStartValue(uint32_t aStartValue)
     WeaveLogDetail(EventLogging, "PersistedCounter::WriteStartValue() aStartValue 0x%x", aStartValue);
 #endif
 
-    return nl::Weave::Platform::PersistedStorage::Write(mId, aStartValue);
+    WEAVE_ERROR err = nl::Weave::Platform::PersistedStorage::Write(mId, aStartValue);
+
+    if (err == WEAVE_NO_ERROR)
+    {
+        mPersistedValue = aStartValue;
+    }
+
+    return err;
 }
 
 WEAVE_ERROR
@@ -39,6 +39,20 @@ namespace Weave {
  * @brief
  *   A class for managing a counter as an integer value intended to persist
  *   across reboots.
+ *
+ *   The counter reserves its values an epoch at a time: persistent storage
+ *   holds the value the counter will restart from after a reboot, which is
+ *   always past every value vended so far.  Storage is only written when an
+ *   epoch is exhausted.  When the counter exhausts its epochs quickly, the
+ *   epoch grows (see #WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE) so
+ *   that storage is written less often.
+ *
+ *   With deferred writes enabled, the counter reserves one epoch ahead of
+ *   the current one.  Starting a new epoch then only marks a write as
+ *   pending, which the owner performs later, outside of the caller of
+ *   Advance(), by calling WritePending().  Advance() only writes storage
+ *   itself if the pending write has not been performed by the time the
+ *   reserved epochs are exhausted.
  */
 
 class PersistedCounter : public MonotonicallyIncreasingCounter
@@ -88,6 +102,32 @@ public:
      */
     WEAVE_ERROR SetValue(uint32_t value);
 
+    /**
+     *  @brief
+     *    Enable or disable deferred writes to persistent storage.
+     *
+     *    Enabling deferred writes makes a write pending, to reserve the epoch
+     *    following the current one.
+     *
+     *  @param[in] aEnable  true to defer writes, false to write synchronously.
+     */
+    void SetDeferredWrites(bool aEnable);
+
+    /**
+     *  @brief
+     *    Returns true if a deferred write to persistent storage is pending.
+     */
+    bool IsWritePending(void) const { return mWritePending; }
+
+    /**
+     *  @brief
+     *    Perform the pending deferred write, if any.
+     *
+     *  @return Any error returned by a write to persistent storage.  The
+     *          write stays pending on failure.
+     */
+    WEAVE_ERROR WritePending(void);
+
 private:
     /**
      *  @brief
@@ -99,6 +139,15 @@ private:
      */
     bool GetNextValue(uint32_t &aValue);
 
+    /**
+     *  @brief
+     *    Compute the size of the epoch to start, based on how quickly the
+     *    current one was exhausted.
+     *
+     *  @return The size of the next epoch.
+     */
+    uint32_t GetNextEpochSize(void) const;
+
     /**
      *  @brief
      *    Increment the value of the counter by one.  May perform a write to
@@ -131,7 +180,13 @@ private:
 
     nl::Weave::Platform::PersistedStorage::Key mId;
     uint32_t mStartingCounterValue;
-    uint32_t mEpoch;
+    uint32_t mEpoch;                // The epoch the counter was initialized with.
+    uint32_t mEpochSize;            // The size of the current epoch, a power-of-two multiple of mEpoch.
+    uint32_t mPersistedValue;       // The value last written to persistent storage.
+    uint32_t mPendingValue;         // The value to write when a deferred write is pending.
+    uint64_t mEpochStartTime;       // When the current epoch started, in milliseconds.
+    bool mDeferWrites;
+    bool mWritePending;
 };
 
 } // Weave
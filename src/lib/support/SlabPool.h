@@ -0,0 +1,330 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief
+ *   Class templates for fixed-size and growable pools of objects.
+ *
+ *   Both templates provide the same interface, so that the storage behind a
+ *   pool can be selected at build time.  Objects are handed out uninitialized
+ *   (zero-filled on first use) and the caller remains responsible for marking
+ *   its objects as free, so that objects that are not allocated can still be
+ *   visited while iterating over the pool.
+ */
+
+#ifndef SLAB_POOL_H
+#define SLAB_POOL_H
+
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+namespace nl {
+namespace Weave {
+
+/**
+ * @brief
+ *   Usage statistics of a pool of objects.
+ */
+struct PoolStats
+{
+    size_t InUse;               /**< The number of objects currently allocated. */
+    size_t HighWaterMark;       /**< The greatest number of objects ever allocated at once. */
+    size_t Capacity;            /**< The number of objects for which space is currently reserved. */
+};
+
+/**
+ * @class StaticPool
+ *
+ * @brief
+ *   A pool of N objects of type T held in a fixed array.
+ */
+template <class T, size_t N>
+class StaticPool
+{
+public:
+    void Init(size_t maxSlabs = 0);
+    void Shutdown(void) { }
+
+    T *Alloc(void);
+    void Free(T *obj);
+
+    T *First(void) { return mObjects; }
+    T *Next(T *obj) { return (obj + 1 < mObjects + N) ? obj + 1 : NULL; }
+    size_t GetIndex(const T *obj) const { return static_cast<size_t>(obj - mObjects); }
+
+    void GetStats(PoolStats &stats) const;
+
+private:
+    enum { kNumWords = (N + 31) / 32 };
+
+    T mObjects[N];
+    uint32_t mAllocated[kNumWords];
+    size_t mInUse;
+    size_t mHighWaterMark;
+};
+
+/**
+ *  Initialize the pool.
+ *
+ *  @param[in] maxSlabs     Ignored; accepted for compatibility with SlabPool::Init().
+ */
+template <class T, size_t N>
+void StaticPool<T, N>::Init(size_t maxSlabs)
+{
+    memset(mObjects, 0, sizeof(mObjects));
+    memset(mAllocated, 0, sizeof(mAllocated));
+    mInUse = 0;
+    mHighWaterMark = 0;
+}
+
+template <class T, size_t N>
+T *StaticPool<T, N>::Alloc(void)
+{
+    for (size_t i = 0; i < N; i++)
+    {
+        const uint32_t mask = static_cast<uint32_t>(1) << (i % 32);
+
+        if ((mAllocated[i / 32] & mask) == 0)
+        {
+            mAllocated[i / 32] |= mask;
+            if (++mInUse > mHighWaterMark)
+                mHighWaterMark = mInUse;
+            return &mObjects[i];
+        }
+    }
+
+    return NULL;
+}
+
+template <class T, size_t N>
+void StaticPool<T, N>::Free(T *obj)
+{
+    const size_t i = GetIndex(obj);
+
+    mAllocated[i / 32] &= ~(static_cast<uint32_t>(1) << (i % 32));
+    mInUse--;
+}
+
+template <class T, size_t N>
+void StaticPool<T, N>::GetStats(PoolStats &stats) const
+{
+    stats.InUse = mInUse;
+    stats.HighWaterMark = mHighWaterMark;
+    stats.Capacity = N;
+}
+
+/**
+ * @class SlabPool
+ *
+ * @brief
+ *   A pool of objects of type T that grows, N objects at a time, by allocating
+ *   slabs from the heap.
+ *
+ *   The first slab is held within the pool itself.  Further slabs are allocated
+ *   when the pool is exhausted, up to an optional limit, and are released when
+ *   the pool is shut down.  Free objects are kept on a list, so that allocating
+ *   and freeing objects take constant time however large the pool has grown.
+ */
+template <class T, size_t N>
+class SlabPool
+{
+public:
+    void Init(size_t maxSlabs = 0);
+    void Shutdown(void);
+
+    T *Alloc(void);
+    void Free(T *obj);
+
+    T *First(void) { return &mFirstSlab.Slots[0].Object; }
+    T *Next(T *obj);
+    size_t GetIndex(const T *obj) const;
+
+    void GetStats(PoolStats &stats) const;
+
+private:
+    struct Slab;
+
+    // The object must be the first member, so that a pointer to it may be converted to a pointer to its slot.
+    struct Slot
+    {
+        T Object;
+        Slot *NextFree;
+        Slab *Owner;
+    };
+
+    struct Slab
+    {
+        Slot Slots[N];
+        Slab *Next;
+        size_t BaseIndex;
+    };
+
+    Slab mFirstSlab;
+    Slab *mLastSlab;
+    Slot *mFreeList;
+    size_t mNumSlabs;
+    size_t mMaxSlabs;
+    size_t mInUse;
+    size_t mHighWaterMark;
+
+    static Slot *ToSlot(T *obj) { return reinterpret_cast<Slot *>(obj); }
+    static const Slot *ToSlot(const T *obj) { return reinterpret_cast<const Slot *>(obj); }
+
+    void InitSlab(Slab *slab);
+    bool Grow(void);
+};
+
+/**
+ *  Initialize the pool.
+ *
+ *  @param[in] maxSlabs     The maximum number of slabs, including the first, that the pool may grow to, or 0 for no
+ *                          limit.
+ */
+template <class T, size_t N>
+void SlabPool<T, N>::Init(size_t maxSlabs)
+{
+    mFreeList = NULL;
+    mFirstSlab.BaseIndex = 0;
+    InitSlab(&mFirstSlab);
+    mLastSlab = &mFirstSlab;
+    mNumSlabs = 1;
+    mMaxSlabs = maxSlabs;
+    mInUse = 0;
+    mHighWaterMark = 0;
+}
+
+/**
+ *  Release the slabs allocated from the heap. All objects in them must have been freed.
+ */
+template <class T, size_t N>
+void SlabPool<T, N>::Shutdown(void)
+{
+    Slab *slab = mFirstSlab.Next;
+
+    while (slab != NULL)
+    {
+        Slab *next = slab->Next;
+        delete slab;
+        slab = next;
+    }
+
+    Init(mMaxSlabs);
+}
+
+template <class T, size_t N>
+T *SlabPool<T, N>::Alloc(void)
+{
+    Slot *slot;
+
+    if (mFreeList == NULL && !Grow())
+        return NULL;
+
+    slot = mFreeList;
+    mFreeList = slot->NextFree;
+    slot->NextFree = NULL;
+
+    if (++mInUse > mHighWaterMark)
+        mHighWaterMark = mInUse;
+
+    return &slot->Object;
+}
+
+template <class T, size_t N>
+void SlabPool<T, N>::Free(T *obj)
+{
+    Slot *slot = ToSlot(obj);
+
+    slot->NextFree = mFreeList;
+    mFreeList = slot;
+    mInUse--;
+}
+
+template <class T, size_t N>
+T *SlabPool<T, N>::Next(T *obj)
+{
+    Slot *slot = ToSlot(obj);
+    Slab *slab = slot->Owner;
+
+    if (slot + 1 < slab->Slots + N)
+        return &slot[1].Object;
+
+    return (slab->Next != NULL) ? &slab->Next->Slots[0].Object : NULL;
+}
+
+template <class T, size_t N>
+size_t SlabPool<T, N>::GetIndex(const T *obj) const
+{
+    const Slot *slot = ToSlot(obj);
+
+    return slot->Owner->BaseIndex + static_cast<size_t>(slot - slot->Owner->Slots);
+}
+
+template <class T, size_t N>
+void SlabPool<T, N>::GetStats(PoolStats &stats) const
+{
+    stats.InUse = mInUse;
+    stats.HighWaterMark = mHighWaterMark;
+    stats.Capacity = mNumSlabs * N;
+}
+
+template <class T, size_t N>
+void SlabPool<T, N>::InitSlab(Slab *slab)
+{
+    memset(slab->Slots, 0, sizeof(slab->Slots));
+    slab->Next = NULL;
+
+    // Push the slots in reverse so that they are allocated in order.
+    for (size_t i = N; i > 0; i--)
+    {
+        Slot *slot = &slab->Slots[i - 1];
+
+        slot->Owner = slab;
+        slot->NextFree = mFreeList;
+        mFreeList = slot;
+    }
+}
+
+template <class T, size_t N>
+bool SlabPool<T, N>::Grow(void)
+{
+    Slab *slab;
+
+    if (mMaxSlabs != 0 && mNumSlabs >= mMaxSlabs)
+        return false;
+
+    slab = new (std::nothrow) Slab;
+    if (slab == NULL)
+        return false;
+
+    slab->BaseIndex = mNumSlabs * N;
+    InitSlab(slab);
+    mLastSlab->Next = slab;
+    mLastSlab = slab;
+    mNumSlabs++;
+
+    return true;
+}
+
+} // namespace Weave
+} // namespace nl
+
+#endif // SLAB_POOL_H
@@ -36,6 +36,8 @@
 
 #include <nlfaultinjection.hpp>
 
+#include <SystemLayer/SystemFaultInjection.h>
+
 #include <Weave/Support/NLDLLUtil.h>
 
 namespace nl {
@@ -126,7 +128,12 @@ NL_DLL_EXPORT void FuzzExchangeHeader(uint8_t *p, int32_t arg);
  * @param[in] aStatements   Statements to be executed if the fault is enabled.
  */
 #define WEAVE_FAULT_INJECT( aFaultID, aStatements ) \
-        nlFAULT_INJECT(nl::Weave::FaultInjection::GetManager(), aFaultID, aStatements)
+    do { \
+        if (WEAVE_SYSTEM_FAULT_INJECTION_ARMED()) \
+        { \
+            nlFAULT_INJECT(nl::Weave::FaultInjection::GetManager(), aFaultID, aStatements); \
+        } \
+    } while (0)
 
 /**
  * Execute the statements included if the Weave fault is
@@ -143,14 +150,17 @@ NL_DLL_EXPORT void FuzzExchangeHeader(uint8_t *p, int32_t arg);
  */
 #define WEAVE_FAULT_INJECT_MAX_ARG( aFaultID, aMaxArg, aProtectedStatements, aUnprotectedStatements ) \
     do { \
-        nl::FaultInjection::Manager &mgr = nl::Weave::FaultInjection::GetManager(); \
-        const nl::FaultInjection::Record *records = mgr.GetFaultRecords(); \
-        if (records[aFaultID].mNumArguments == 0) \
+        if (WEAVE_SYSTEM_FAULT_INJECTION_ARMED()) \
         { \
-            int32_t arg = aMaxArg; \
-            mgr.StoreArgsAtFault(aFaultID, 1, &arg); \
+            nl::FaultInjection::Manager &mgr = nl::Weave::FaultInjection::GetManager(); \
+            const nl::FaultInjection::Record *records = mgr.GetFaultRecords(); \
+            if (records[aFaultID].mNumArguments == 0) \
+            { \
+                int32_t arg = aMaxArg; \
+                mgr.StoreArgsAtFault(aFaultID, 1, &arg); \
+            } \
+            nlFAULT_INJECT_WITH_ARGS(mgr, aFaultID, aProtectedStatements, aUnprotectedStatements ); \
         } \
-        nlFAULT_INJECT_WITH_ARGS(mgr, aFaultID, aProtectedStatements, aUnprotectedStatements ); \
     } while (0)
 
 /**
@@ -164,8 +174,13 @@ NL_DLL_EXPORT void FuzzExchangeHeader(uint8_t *p, int32_t arg);
  *                          Manager's lock
  */
 #define WEAVE_FAULT_INJECT_WITH_ARGS( aFaultID, aProtectedStatements, aUnprotectedStatements ) \
-        nlFAULT_INJECT_WITH_ARGS(nl::Weave::FaultInjection::GetManager(), aFaultID,  \
-                                 aProtectedStatements, aUnprotectedStatements );
+    do { \
+        if (WEAVE_SYSTEM_FAULT_INJECTION_ARMED()) \
+        { \
+            nlFAULT_INJECT_WITH_ARGS(nl::Weave::FaultInjection::GetManager(), aFaultID,  \
+                                     aProtectedStatements, aUnprotectedStatements ); \
+        } \
+    } while (0)
 
 #define WEAVE_FAULT_INJECTION_EXCH_HEADER_NUM_FIELDS 4
 #define WEAVE_FAULT_INJECTION_EXCH_HEADER_NUM_FIELDS_WRMP 5
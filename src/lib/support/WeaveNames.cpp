@@ -152,6 +152,7 @@ const char *GetMessageName(uint32_t profileId, uint8_t msgType)
         case Common::kMsgType_Null                                          : return "Null";
         case Common::kMsgType_WRMP_Delayed_Delivery                         : return "DelayedDelivery";
         case Common::kMsgType_WRMP_Throttle_Flow                            : return "ThrottleFlow";
+        case Common::kMsgType_WRMP_Multi_Ack                                : return "MultiAck";
         }
         break;
     case kWeaveProfile_Echo:
@@ -192,6 +193,8 @@ const char *GetMessageName(uint32_t profileId, uint8_t msgType)
         case Security::kMsgType_CASEBeginSessionResponse                    : return "CASEBeginSessionResponse";
         case Security::kMsgType_CASEInitiatorKeyConfirm                     : return "CASEInitiatorKeyConfirm";
         case Security::kMsgType_CASEReconfigure                             : return "CASEReconfigure";
+        case Security::kMsgType_CASEResumeSessionRequest                    : return "CASEResumeSessionRequest";
+        case Security::kMsgType_CASEResumeSessionResponse                   : return "CASEResumeSessionResponse";
         case Security::kMsgType_TAKEIdentifyToken                           : return "TAKEIdentifyToken";
         case Security::kMsgType_TAKEIdentifyTokenResponse                   : return "TAKEIdentifyTokenResponse";
         case Security::kMsgType_TAKETokenReconfigure                        : return "TAKETokenReconfigure";
@@ -318,6 +321,7 @@ const char *GetMessageName(uint32_t profileId, uint8_t msgType)
     case kWeaveProfile_Heartbeat:
         switch (msgType) {
         case Heartbeat::kHeartbeatMessageType_Heartbeat                     : return "Heartbeat";
+        case Heartbeat::kHeartbeatMessageType_AggregatedHeartbeat           : return "AggregatedHeartbeat";
         }
         break;
     case kWeaveProfile_TokenPairing:
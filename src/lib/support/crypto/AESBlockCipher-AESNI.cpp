@@ -40,6 +40,52 @@ namespace Security {
 
 using namespace nl::Weave::Crypto;
 
+// Encrypt a run of independent blocks with an expanded key of (roundCount + 1) round keys.
+// The round count is a template parameter so that the round loops are fully unrolled.
+//
+// Each AESENC instruction has a latency of several cycles but can be issued every cycle,
+// so blocks are processed four at a time with their rounds interleaved, which keeps the
+// AES unit busy instead of waiting on each block in turn.
+template <int roundCount>
+static inline void EncryptBlocksAESNI(const __m128i *roundKeys, const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    __m128i b0 = _mm_setzero_si128(), b1 = b0, b2 = b0, b3 = b0;
+
+    for (; numBlocks >= 4; numBlocks -= 4, inBlocks += 64, outBlocks += 64)
+    {
+        b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inBlocks +  0)), roundKeys[0]);
+        b1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inBlocks + 16)), roundKeys[0]);
+        b2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inBlocks + 32)), roundKeys[0]);
+        b3 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(inBlocks + 48)), roundKeys[0]);
+
+        for (int round = 1; round < roundCount; round++)
+        {
+            b0 = _mm_aesenc_si128(b0, roundKeys[round]);
+            b1 = _mm_aesenc_si128(b1, roundKeys[round]);
+            b2 = _mm_aesenc_si128(b2, roundKeys[round]);
+            b3 = _mm_aesenc_si128(b3, roundKeys[round]);
+        }
+
+        _mm_storeu_si128((__m128i *)(outBlocks +  0), _mm_aesenclast_si128(b0, roundKeys[roundCount]));
+        _mm_storeu_si128((__m128i *)(outBlocks + 16), _mm_aesenclast_si128(b1, roundKeys[roundCount]));
+        _mm_storeu_si128((__m128i *)(outBlocks + 32), _mm_aesenclast_si128(b2, roundKeys[roundCount]));
+        _mm_storeu_si128((__m128i *)(outBlocks + 48), _mm_aesenclast_si128(b3, roundKeys[roundCount]));
+    }
+
+    for (; numBlocks > 0; numBlocks--, inBlocks += 16, outBlocks += 16)
+    {
+        b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)inBlocks), roundKeys[0]);
+        for (int round = 1; round < roundCount; round++)
+            b0 = _mm_aesenc_si128(b0, roundKeys[round]);
+        _mm_storeu_si128((__m128i *)outBlocks, _mm_aesenclast_si128(b0, roundKeys[roundCount]));
+    }
+
+    ClearSecretData((uint8_t *)&b0, sizeof(b0));
+    ClearSecretData((uint8_t *)&b1, sizeof(b1));
+    ClearSecretData((uint8_t *)&b2, sizeof(b2));
+    ClearSecretData((uint8_t *)&b3, sizeof(b3));
+}
+
 AES128BlockCipher::AES128BlockCipher()
 {
     memset(&mKey, 0, sizeof(mKey));
@@ -108,6 +154,11 @@ void AES128BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBloc
     ClearSecretData((uint8_t *)&block, sizeof(block));
 }
 
+void AES128BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    EncryptBlocksAESNI<kRoundCount>(mKey, inBlocks, outBlocks, numBlocks);
+}
+
 void AES128BlockCipherDec::SetKey(const uint8_t *key)
 {
     __m128i tmp;
@@ -234,6 +285,11 @@ void AES256BlockCipherEnc::EncryptBlock(const uint8_t *inBlock, uint8_t *outBloc
     ClearSecretData((uint8_t *)&block, sizeof(block));
 }
 
+void AES256BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    EncryptBlocksAESNI<kRoundCount>(mKey, inBlocks, outBlocks, numBlocks);
+}
+
 void AES256BlockCipherDec::SetKey(const uint8_t *key)
 {
     __m128i tmp;
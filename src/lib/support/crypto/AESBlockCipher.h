@@ -32,6 +32,13 @@
  *      the #WEAVE_AES_128_CTX_PLATFORM and #WEAVE_AES_256_CTX_PLATFORM macros
  *      accordingly.
  *
+ *      Platforms whose AES implementation can encrypt several independent
+ *      blocks faster than one at a time (for example, by pipelining them
+ *      through dedicated instructions) may define
+ *      #WEAVE_AES_ENCRYPT_BLOCKS_PLATFORM and provide EncryptBlocks() for
+ *      the encrypting ciphers. Otherwise EncryptBlocks() simply calls
+ *      EncryptBlock() for each block.
+ *
  */
 
 #ifndef AES_H_
@@ -105,6 +112,7 @@ class NL_DLL_EXPORT AES128BlockCipherEnc : public AES128BlockCipher
 public:
     void SetKey(const uint8_t *key);
     void EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
+    void EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks);
 };
 
 class NL_DLL_EXPORT AES128BlockCipherDec : public AES128BlockCipher
@@ -151,6 +159,7 @@ class NL_DLL_EXPORT AES256BlockCipherEnc : public AES256BlockCipher
 public:
     void SetKey(const uint8_t *key);
     void EncryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
+    void EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks);
 };
 
 class NL_DLL_EXPORT AES256BlockCipherDec : public AES256BlockCipher
@@ -160,6 +169,22 @@ public:
     void DecryptBlock(const uint8_t *inBlock, uint8_t *outBlock);
 };
 
+#if !WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI && !defined(WEAVE_AES_ENCRYPT_BLOCKS_PLATFORM)
+
+inline void AES128BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    for (; numBlocks > 0; numBlocks--, inBlocks += kBlockLength, outBlocks += kBlockLength)
+        EncryptBlock(inBlocks, outBlocks);
+}
+
+inline void AES256BlockCipherEnc::EncryptBlocks(const uint8_t *inBlocks, uint8_t *outBlocks, size_t numBlocks)
+{
+    for (; numBlocks > 0; numBlocks--, inBlocks += kBlockLength, outBlocks += kBlockLength)
+        EncryptBlock(inBlocks, outBlocks);
+}
+
+#endif // !WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI && !defined(WEAVE_AES_ENCRYPT_BLOCKS_PLATFORM)
+
 } // namespace Security
 } // namespace Platform
 } // namespace Weave
@@ -0,0 +1,436 @@
+/*
+ *
+ *    Copyright (c) 2013-2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a template object for doing counter with
+ *      CBC-MAC (CCM) mode authenticated encryption and a specialized
+ *      object for CCM mode AES-128.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "WeaveCrypto.h"
+#include "CCMMode.h"
+#include <Weave/Support/CodeUtils.h>
+
+namespace nl {
+namespace Weave {
+namespace Crypto {
+
+// XOR len bytes of data with the given key stream, a word at a time where possible.
+static inline void XorKeyStream(const uint8_t *inData, const uint8_t *keyStream, uint8_t *outData, size_t len)
+{
+    size_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t))
+    {
+        uint64_t data, key;
+        memcpy(&data, inData + i, sizeof(data));
+        memcpy(&key, keyStream + i, sizeof(key));
+        data ^= key;
+        memcpy(outData + i, &data, sizeof(data));
+    }
+
+    for (; i < len; i++)
+        outData[i] = inData[i] ^ keyStream[i];
+}
+
+template <class BlockCipher>
+CCMMode<BlockCipher>::CCMMode()
+{
+    memset(this, 0, sizeof(*this));
+}
+
+template <class BlockCipher>
+CCMMode<BlockCipher>::~CCMMode()
+{
+    Reset();
+}
+
+template <class BlockCipher>
+void CCMMode<BlockCipher>::SetKey(const uint8_t *key)
+{
+    mBlockCipher.SetKey(key);
+}
+
+/**
+ * Encrypt and authenticate a message.
+ *
+ * @param[in] nonce         The nonce, which must never be reused with the same key.
+ * @param[in] nonceLen      The length of the nonce (7 to 13 bytes).
+ * @param[in] aad           Additional data that is authenticated but not encrypted.
+ * @param[in] aadLen        The length of the additional data.
+ * @param[in] inData        The plaintext.
+ * @param[in] dataLen       The length of the plaintext.
+ * @param[out] outData      A buffer receiving dataLen bytes of ciphertext. May be the same as inData.
+ * @param[out] tag          A buffer receiving the authentication tag.
+ * @param[in] tagLen        The length of the tag (an even number from 4 to 16).
+ *
+ * @retval #WEAVE_NO_ERROR                  On success.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT    If the nonce, additional data or tag length is not supported.
+ */
+template <class BlockCipher>
+WEAVE_ERROR CCMMode<BlockCipher>::Encrypt(const uint8_t *nonce, uint8_t nonceLen, const uint8_t *aad, uint16_t aadLen,
+                                          const uint8_t *inData, uint16_t dataLen, uint8_t *outData,
+                                          uint8_t *tag, uint8_t tagLen)
+{
+    WEAVE_ERROR err;
+
+    err = Begin(nonce, nonceLen, aad, aadLen, dataLen, tagLen);
+    SuccessOrExit(err);
+
+    EncryptData(inData, dataLen, outData);
+    Finish(tag);
+
+exit:
+    return err;
+}
+
+/**
+ * Decrypt a message and verify its authenticity.
+ *
+ * On failure, the contents of outData are cleared.
+ *
+ * @param[in] nonce         The nonce used to encrypt the message.
+ * @param[in] nonceLen      The length of the nonce (7 to 13 bytes).
+ * @param[in] aad           Additional data that is authenticated but not encrypted.
+ * @param[in] aadLen        The length of the additional data.
+ * @param[in] inData        The ciphertext.
+ * @param[in] dataLen       The length of the ciphertext.
+ * @param[out] outData      A buffer receiving dataLen bytes of plaintext. May be the same as inData.
+ * @param[in] tag           The authentication tag received with the message.
+ * @param[in] tagLen        The length of the tag (an even number from 4 to 16).
+ *
+ * @retval #WEAVE_NO_ERROR                      On success.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT        If the nonce, additional data or tag length is not supported.
+ * @retval #WEAVE_ERROR_INTEGRITY_CHECK_FAILED  If the tag does not match the message.
+ */
+template <class BlockCipher>
+WEAVE_ERROR CCMMode<BlockCipher>::Decrypt(const uint8_t *nonce, uint8_t nonceLen, const uint8_t *aad, uint16_t aadLen,
+                                          const uint8_t *inData, uint16_t dataLen, uint8_t *outData,
+                                          const uint8_t *tag, uint8_t tagLen)
+{
+    WEAVE_ERROR err;
+
+    err = Begin(nonce, nonceLen, aad, aadLen, dataLen, tagLen);
+    SuccessOrExit(err);
+
+    DecryptData(inData, dataLen, outData);
+
+    err = FinishDecrypt(tag);
+    if (err != WEAVE_NO_ERROR)
+    {
+        ClearSecretData(outData, dataLen);
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * Begin encrypting or decrypting a message incrementally.
+ *
+ * The message data is then passed, in order and in pieces of any size, to EncryptData() or DecryptData(),
+ * followed by a call to Finish() or FinishDecrypt() respectively.
+ *
+ * @param[in] nonce         The nonce, which must never be reused with the same key to encrypt.
+ * @param[in] nonceLen      The length of the nonce (7 to 13 bytes).
+ * @param[in] aad           Additional data that is authenticated but not encrypted.
+ * @param[in] aadLen        The length of the additional data.
+ * @param[in] dataLen       The total length of the message data.
+ * @param[in] tagLen        The length of the tag (an even number from 4 to 16).
+ *
+ * @retval #WEAVE_NO_ERROR                  On success.
+ * @retval #WEAVE_ERROR_INVALID_ARGUMENT    If the nonce, additional data or tag length is not supported.
+ */
+template <class BlockCipher>
+WEAVE_ERROR CCMMode<BlockCipher>::Begin(const uint8_t *nonce, uint8_t nonceLen, const uint8_t *aad, uint16_t aadLen,
+                                        uint16_t dataLen, uint8_t tagLen)
+{
+    WEAVE_ERROR err;
+
+    err = CheckParams(nonceLen, aadLen, tagLen);
+    SuccessOrExit(err);
+
+    memcpy(mNonce, nonce, nonceLen);
+    mNonceLen = nonceLen;
+    mTagLen = tagLen;
+
+    // Form the first CBC-MAC block, B_0:
+    //
+    //      (1 byte)   | (nonceLen bytes) | (lenFieldLen bytes)
+    //    <flags>      |     <nonce>      |  <data-length>
+    //
+    FormBlock((uint8_t)(((aadLen > 0) ? 0x40 : 0) | (((tagLen - 2) / 2) << 3)), dataLen, mMac);
+    MacBlock();
+
+    // If present, MAC the additional data, preceded by its length and zero-padded to a whole number of blocks.
+    if (aadLen > 0)
+    {
+        mMac[0] ^= (uint8_t)(aadLen >> 8);
+        mMac[1] ^= (uint8_t)(aadLen);
+        mMacIndex = 2;
+
+        MacData(aad, aadLen);
+
+        if (mMacIndex != 0)
+        {
+            MacBlock();
+        }
+    }
+
+    // The key stream used for the data starts with the block for counter value 1; that for 0, S_0, is
+    // reserved for the tag.
+    mCounter = 1;
+    mKeyStreamIndex = kBlockLength;
+
+exit:
+    return err;
+}
+
+/**
+ * Encrypt the next piece of a message begun with Begin().
+ *
+ * @param[in] inData        The plaintext.
+ * @param[in] dataLen       The length of the plaintext.
+ * @param[out] outData      A buffer receiving dataLen bytes of ciphertext. May be the same as inData.
+ */
+template <class BlockCipher>
+void CCMMode<BlockCipher>::EncryptData(const uint8_t *inData, uint16_t dataLen, uint8_t *outData)
+{
+    // The tag covers the plaintext, so MAC the data before it is (possibly) encrypted in place.
+    MacData(inData, dataLen);
+    CryptData(inData, dataLen, outData);
+}
+
+/**
+ * Decrypt the next piece of a message begun with Begin().
+ *
+ * The plaintext must not be trusted until FinishDecrypt() has verified the message.
+ *
+ * @param[in] inData        The ciphertext.
+ * @param[in] dataLen       The length of the ciphertext.
+ * @param[out] outData      A buffer receiving dataLen bytes of plaintext. May be the same as inData.
+ */
+template <class BlockCipher>
+void CCMMode<BlockCipher>::DecryptData(const uint8_t *inData, uint16_t dataLen, uint8_t *outData)
+{
+    CryptData(inData, dataLen, outData);
+    MacData(outData, dataLen);
+}
+
+/**
+ * Finish encrypting a message, producing its authentication tag.
+ *
+ * @param[out] tag          A buffer receiving the tag, of the length given to Begin().
+ */
+template <class BlockCipher>
+void CCMMode<BlockCipher>::Finish(uint8_t *tag)
+{
+    uint8_t block[kBlockLength];
+    uint8_t keyStream[kBlockLength];
+
+    // MAC the final, zero-padded, block of data.
+    if (mMacIndex != 0)
+    {
+        MacBlock();
+    }
+
+    // Encrypt the MAC with the first key stream block, S_0, to produce the tag.
+    FormBlock(0, 0, block);
+    mBlockCipher.EncryptBlock(block, keyStream);
+    XorKeyStream(mMac, keyStream, tag, mTagLen);
+
+    ClearSecretData(keyStream, sizeof(keyStream));
+    ClearSecretData(mMac, sizeof(mMac));
+    ClearSecretData(mKeyStream, sizeof(mKeyStream));
+}
+
+/**
+ * Finish decrypting a message, verifying it against its authentication tag.
+ *
+ * On failure, the caller must discard the plaintext.
+ *
+ * @param[in] tag           The authentication tag received with the message.
+ *
+ * @retval #WEAVE_NO_ERROR                      If the message is authentic.
+ * @retval #WEAVE_ERROR_INTEGRITY_CHECK_FAILED  If the tag does not match the message.
+ */
+template <class BlockCipher>
+WEAVE_ERROR CCMMode<BlockCipher>::FinishDecrypt(const uint8_t *tag)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t expectedTag[kMaxTagLength];
+
+    Finish(expectedTag);
+
+    if (!ConstantTimeCompare(expectedTag, tag, mTagLen))
+        err = WEAVE_ERROR_INTEGRITY_CHECK_FAILED;
+
+    ClearSecretData(expectedTag, sizeof(expectedTag));
+    return err;
+}
+
+template <class BlockCipher>
+WEAVE_ERROR CCMMode<BlockCipher>::CheckParams(uint8_t nonceLen, uint16_t aadLen, uint8_t tagLen)
+{
+    // The nonce length determines the size of the message length field (15 - nonceLen bytes), which is always
+    // at least 2 bytes, and thus large enough for any uint16_t data length.
+    if (nonceLen < kMinNonceLength || nonceLen > kMaxNonceLength)
+        return WEAVE_ERROR_INVALID_ARGUMENT;
+
+    if (tagLen < kMinTagLength || tagLen > kMaxTagLength || (tagLen % 2) != 0)
+        return WEAVE_ERROR_INVALID_ARGUMENT;
+
+    // Only the two byte encoding of the additional data length is supported.
+    if (aadLen >= 0xFF00)
+        return WEAVE_ERROR_INVALID_ARGUMENT;
+
+    return WEAVE_NO_ERROR;
+}
+
+/*
+ * Forms a block consisting of the given flags, the nonce and a big-endian value filling the rest of the block.
+ * The flags also encode the size of the value field.
+ */
+template <class BlockCipher>
+void CCMMode<BlockCipher>::FormBlock(uint8_t flags, uint16_t value, uint8_t *block)
+{
+    const uint8_t lenFieldLen = (kBlockLength - 1) - mNonceLen;
+
+    block[0] = (uint8_t)(flags | (lenFieldLen - 1));
+    memcpy(block + 1, mNonce, mNonceLen);
+    memset(block + 1 + mNonceLen, 0, lenFieldLen);
+    block[kBlockLength - 2] = (uint8_t)(value >> 8);
+    block[kBlockLength - 1] = (uint8_t)(value);
+}
+
+/*
+ * Encrypts the CBC-MAC state, once a block of data has been XORed into it.
+ */
+template <class BlockCipher>
+void CCMMode<BlockCipher>::MacBlock()
+{
+    uint8_t block[kBlockLength];
+
+    memcpy(block, mMac, kBlockLength);
+    mBlockCipher.EncryptBlock(block, mMac);
+    mMacIndex = 0;
+
+    ClearSecretData(block, sizeof(block));
+}
+
+/*
+ * MACs the next piece of data.  Since padding with zeros leaves the MAC state unchanged, the bytes are simply
+ * XORed into the state, which is encrypted each time a block is filled.
+ */
+template <class BlockCipher>
+void CCMMode<BlockCipher>::MacData(const uint8_t *data, size_t dataLen)
+{
+    size_t i = 0;
+
+    while (i < dataLen)
+    {
+        // MAC whole blocks a word at a time.
+        if (mMacIndex == 0 && dataLen - i >= kBlockLength)
+        {
+            XorKeyStream(mMac, data + i, mMac, kBlockLength);
+            MacBlock();
+            i += kBlockLength;
+            continue;
+        }
+
+        mMac[mMacIndex++] ^= data[i++];
+        if (mMacIndex == kBlockLength)
+        {
+            MacBlock();
+        }
+    }
+}
+
+/*
+ * Encrypts or decrypts the next piece of data, continuing the key stream from where the previous piece ended.
+ */
+template <class BlockCipher>
+void CCMMode<BlockCipher>::CryptData(const uint8_t *inData, uint16_t dataLen, uint8_t *outData)
+{
+    uint8_t counterBlocks[kParallelBlocks * kBlockLength];
+    uint8_t keyStream[kParallelBlocks * kBlockLength];
+    size_t dataIndex = 0;
+
+    // Use up the rest of the key stream block left over from the previous piece.
+    for (; dataIndex < dataLen && mKeyStreamIndex < kBlockLength; dataIndex++)
+        outData[dataIndex] = inData[dataIndex] ^ mKeyStream[mKeyStreamIndex++];
+
+    // Form the counter blocks, A_i:
+    //
+    //      (1 byte)   | (nonceLen bytes) | (lenFieldLen bytes)
+    //    <flags>      |     <nonce>      |       <i>
+    //
+    // Since the data length is less than 2^16 bytes, the block counter, which starts at 1, never exceeds the
+    // two least-significant bytes.
+    for (size_t i = 0; i < kParallelBlocks; i++)
+        FormBlock(0, 0, counterBlocks + i * kBlockLength);
+
+    while (dataIndex < dataLen)
+    {
+        size_t chunkLen = dataLen - dataIndex;
+        if (chunkLen > sizeof(keyStream))
+            chunkLen = sizeof(keyStream);
+
+        size_t numBlocks = (chunkLen + kBlockLength - 1) / kBlockLength;
+
+        for (size_t i = 0; i < numBlocks; i++, mCounter++)
+        {
+            uint8_t *counterBlock = counterBlocks + i * kBlockLength;
+            counterBlock[kBlockLength - 2] = (uint8_t)(mCounter >> 8);
+            counterBlock[kBlockLength - 1] = (uint8_t)(mCounter);
+        }
+
+        mBlockCipher.EncryptBlocks(counterBlocks, keyStream, numBlocks);
+
+        XorKeyStream(inData + dataIndex, keyStream, outData + dataIndex, chunkLen);
+
+        dataIndex += chunkLen;
+
+        // Keep the unused part of a final, partially used, key stream block for the next piece.
+        if ((chunkLen % kBlockLength) != 0)
+        {
+            size_t lastBlock = (numBlocks - 1) * kBlockLength;
+            memcpy(mKeyStream, keyStream + lastBlock, kBlockLength);
+            mKeyStreamIndex = (uint8_t)(chunkLen - lastBlock);
+        }
+    }
+
+    ClearSecretData(keyStream, sizeof(keyStream));
+}
+
+template <class BlockCipher>
+void CCMMode<BlockCipher>::Reset()
+{
+    mBlockCipher.Reset();
+}
+
+template class CCMMode<Platform::Security::AES128BlockCipherEnc>;
+
+} /* namespace Crypto */
+} /* namespace Weave */
+} /* namespace nl */
@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2013-2017 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines a template object for doing counter with
+ *      CBC-MAC (CCM) mode authenticated encryption, as specified in
+ *      RFC 3610 and NIST SP 800-38C, and a specialized object for CCM
+ *      mode AES-128.
+ *
+ */
+
+#include <Weave/Support/NLDLLUtil.h>
+
+#include "WeaveCrypto.h"
+#include "AESBlockCipher.h"
+
+#ifndef CCMMODE_H_
+#define CCMMODE_H_
+
+namespace nl {
+namespace Weave {
+namespace Crypto {
+
+template <class BlockCipher>
+class NL_DLL_EXPORT CCMMode
+{
+public:
+    enum
+    {
+        kKeyLength      = BlockCipher::kKeyLength,
+        kBlockLength    = BlockCipher::kBlockLength,
+        kMinNonceLength = 7,
+        kMaxNonceLength = 13,
+        kMinTagLength   = 4,
+        kMaxTagLength   = 16
+    };
+
+    CCMMode(void);
+    ~CCMMode(void);
+
+    void SetKey(const uint8_t *key);
+
+    WEAVE_ERROR Encrypt(const uint8_t *nonce, uint8_t nonceLen, const uint8_t *aad, uint16_t aadLen,
+                        const uint8_t *inData, uint16_t dataLen, uint8_t *outData, uint8_t *tag, uint8_t tagLen);
+    WEAVE_ERROR Decrypt(const uint8_t *nonce, uint8_t nonceLen, const uint8_t *aad, uint16_t aadLen,
+                        const uint8_t *inData, uint16_t dataLen, uint8_t *outData, const uint8_t *tag, uint8_t tagLen);
+
+    // Incremental interface, for messages that are not held in contiguous memory.
+    WEAVE_ERROR Begin(const uint8_t *nonce, uint8_t nonceLen, const uint8_t *aad, uint16_t aadLen,
+                      uint16_t dataLen, uint8_t tagLen);
+    void EncryptData(const uint8_t *inData, uint16_t dataLen, uint8_t *outData);
+    void DecryptData(const uint8_t *inData, uint16_t dataLen, uint8_t *outData);
+    void Finish(uint8_t *tag);
+    WEAVE_ERROR FinishDecrypt(const uint8_t *tag);
+
+    void Reset(void);
+
+private:
+    enum
+    {
+        kParallelBlocks = 4     // Number of counter blocks encrypted together by CryptData().
+    };
+
+    BlockCipher mBlockCipher;
+    uint8_t mNonce[kMaxNonceLength];
+    uint8_t mNonceLen;
+    uint8_t mTagLen;
+    uint8_t mMac[kBlockLength];             // CBC-MAC state.
+    uint8_t mMacIndex;                      // Number of bytes XORed into the current CBC-MAC block.
+    uint8_t mKeyStream[kBlockLength];       // Key stream block partially used by CryptData().
+    uint8_t mKeyStreamIndex;                // Index of the next unused byte of mKeyStream.
+    uint16_t mCounter;                      // Counter value of the next key stream block.
+
+    WEAVE_ERROR CheckParams(uint8_t nonceLen, uint16_t aadLen, uint8_t tagLen);
+    void FormBlock(uint8_t flags, uint16_t value, uint8_t *block);
+    void MacBlock(void);
+    void MacData(const uint8_t *data, size_t dataLen);
+    void CryptData(const uint8_t *inData, uint16_t dataLen, uint8_t *outData);
+};
+
+typedef CCMMode<Platform::Security::AES128BlockCipherEnc> AES128CCMMode;
+
+} /* namespace Crypto */
+} /* namespace Weave */
+} /* namespace nl */
+
+#endif /* CCMMODE_H_ */
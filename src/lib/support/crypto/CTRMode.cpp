@@ -86,6 +86,10 @@ void CTRMode<BlockCipher>::SetWeaveMessageCounter(uint64_t sendingNodeId, uint32
     Counter[13] = 0;
     Counter[14] = 0;
     Counter[15] = 0;
+
+    // Start from the first byte of the first block, so that a CTRMode object (and the key schedule
+    // of its block cipher) can be reused across messages.
+    mMsgIndex = 0;
 }
 
 template <class BlockCipher>
@@ -93,31 +97,81 @@ void CTRMode<BlockCipher>::EncryptData(const uint8_t *inData, uint16_t dataLen,
 {
     // Index to next byte of encrypted counter to be used.
     uint32_t encryptedCounterIndex = mMsgIndex % kCounterLength;
+    uint16_t dataIndex = 0;
 
-    // For each byte of input data...
-    for (uint16_t dataIndex = 0; dataIndex < dataLen && mMsgIndex < UINT32_MAX; dataIndex++, mMsgIndex++)
+    // When positioned at a block boundary, encrypt whole blocks several counter values at a time. This
+    // lets block ciphers that can pipeline independent blocks do so, and allows the data to be XORed a
+    // word, rather than a byte, at a time.
+    if (encryptedCounterIndex == 0 && dataLen >= kCounterLength)
+    {
+        uint8_t counterBlocks[kParallelBlocks * kCounterLength];
+        uint8_t encryptedBlocks[kParallelBlocks * kCounterLength];
+        uint32_t msgIndex = mMsgIndex;
+
+        // Only the four least-significant bytes of the counter change within a message (see
+        // IncrementCounter()), so they are tracked as an integer and the rest copied as is.
+        uint32_t counterLow = ((uint32_t)Counter[kCounterLength-4] << 24) | ((uint32_t)Counter[kCounterLength-3] << 16) |
+                              ((uint32_t)Counter[kCounterLength-2] << 8)  |  (uint32_t)Counter[kCounterLength-1];
+
+        for (size_t i = 0; i < kParallelBlocks; i++)
+            memcpy(counterBlocks + i * kCounterLength, Counter, kCounterLength - 4);
+
+        while (dataLen - dataIndex >= kCounterLength)
+        {
+            size_t numBlocks = (dataLen - dataIndex) / kCounterLength;
+            if (numBlocks > kParallelBlocks)
+                numBlocks = kParallelBlocks;
+
+            size_t chunkLen = numBlocks * kCounterLength;
+
+            // Stop short of the maximum message size; the remainder is handled one byte at a time below.
+            if (msgIndex > UINT32_MAX - chunkLen)
+                break;
+
+            for (size_t i = 0; i < numBlocks; i++, counterLow++)
+            {
+                uint8_t *counterBlock = counterBlocks + i * kCounterLength;
+                counterBlock[kCounterLength-4] = (uint8_t)(counterLow >> 24);
+                counterBlock[kCounterLength-3] = (uint8_t)(counterLow >> 16);
+                counterBlock[kCounterLength-2] = (uint8_t)(counterLow >> 8);
+                counterBlock[kCounterLength-1] = (uint8_t)(counterLow);
+            }
+
+            mBlockCipher.EncryptBlocks(counterBlocks, encryptedBlocks, numBlocks);
+
+            const uint8_t *in = inData + dataIndex;
+            uint8_t *out = outData + dataIndex;
+            for (size_t i = 0; i < chunkLen; i += sizeof(uint64_t))
+            {
+                uint64_t data, key;
+                memcpy(&data, in + i, sizeof(data));
+                memcpy(&key, encryptedBlocks + i, sizeof(key));
+                data ^= key;
+                memcpy(out + i, &data, sizeof(data));
+            }
+
+            dataIndex += chunkLen;
+            msgIndex += chunkLen;
+        }
+
+        Counter[kCounterLength-4] = (uint8_t)(counterLow >> 24);
+        Counter[kCounterLength-3] = (uint8_t)(counterLow >> 16);
+        Counter[kCounterLength-2] = (uint8_t)(counterLow >> 8);
+        Counter[kCounterLength-1] = (uint8_t)(counterLow);
+        mMsgIndex = msgIndex;
+
+        ClearSecretData(encryptedBlocks, sizeof(encryptedBlocks));
+    }
+
+    // For each remaining byte of input data...
+    for (; dataIndex < dataLen && mMsgIndex < UINT32_MAX; dataIndex++, mMsgIndex++)
     {
         // If we need more encrypted counter bytes...
         if (encryptedCounterIndex == 0)
         {
             // Encrypt the next counter value.
             mBlockCipher.EncryptBlock(Counter, mEncryptedCounter);
-
-            // Bump the counter. Since the message size is at most UINT32_MAX (and the counter counts blocks)
-            // we will never need to update more than the four least-significant bytes.
-            Counter[kCounterLength-1]++;
-            if (Counter[kCounterLength-1] == 0)
-            {
-                Counter[kCounterLength-2]++;
-                if (Counter[kCounterLength-2] == 0)
-                {
-                    Counter[kCounterLength-3]++;
-                    if (Counter[kCounterLength-3] == 0)
-                    {
-                        Counter[kCounterLength-4]++;
-                    }
-                }
-            }
+            IncrementCounter();
         }
 
         // XOR the data with the corresponding byte of the encrypted counter.
@@ -130,6 +184,26 @@ void CTRMode<BlockCipher>::EncryptData(const uint8_t *inData, uint16_t dataLen,
     }
 }
 
+template <class BlockCipher>
+void CTRMode<BlockCipher>::IncrementCounter()
+{
+    // Bump the counter. Since the message size is at most UINT32_MAX (and the counter counts blocks)
+    // we will never need to update more than the four least-significant bytes.
+    Counter[kCounterLength-1]++;
+    if (Counter[kCounterLength-1] == 0)
+    {
+        Counter[kCounterLength-2]++;
+        if (Counter[kCounterLength-2] == 0)
+        {
+            Counter[kCounterLength-3]++;
+            if (Counter[kCounterLength-3] == 0)
+            {
+                Counter[kCounterLength-4]++;
+            }
+        }
+    }
+}
+
 template <class BlockCipher>
 void CTRMode<BlockCipher>::Reset()
 {
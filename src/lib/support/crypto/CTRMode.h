@@ -60,9 +60,16 @@ public:
     void Reset(void);
 
 private:
+    enum
+    {
+        kParallelBlocks = 4     // Number of counter blocks encrypted together by EncryptData().
+    };
+
     BlockCipher mBlockCipher;
     uint32_t mMsgIndex;
     uint8_t mEncryptedCounter[kCounterLength];
+
+    void IncrementCounter(void);
 };
 
 typedef CTRMode<Platform::Security::AES128BlockCipherEnc> AES128CTRMode;
@@ -0,0 +1,227 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements asynchronous elliptic curve operations, which
+ *      are performed without blocking the Weave event loop.
+ *
+ */
+
+#include "WeaveCrypto.h"
+#include "EllipticCurve.h"
+#include <SystemLayer/SystemLayer.h>
+#include <Weave/Support/CodeUtils.h>
+#include <Weave/Support/logging/WeaveLogging.h>
+
+#if WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+namespace nl {
+namespace Weave {
+namespace Crypto {
+
+void AsyncECOperation::Reset(void)
+{
+    memset(this, 0, sizeof(*this));
+}
+
+/**
+ * Perform the operation synchronously, on the calling thread.
+ *
+ * @return The result of the operation.
+ */
+WEAVE_ERROR AsyncECOperation::Perform(void)
+{
+    switch (Type)
+    {
+    case kOperation_GenerateECDHKey:
+        return GenerateECDHKey(CurveOID, PubKey, PrivKey);
+    case kOperation_ECDHComputeSharedSecret:
+        return ECDHComputeSharedSecret(CurveOID, PubKey, PrivKey, SharedSecretBuf, SharedSecretBufSize, SharedSecretLen);
+    case kOperation_GenerateECDSASignature:
+        return GenerateECDSASignature(CurveOID, MsgHash, MsgHashLen, PrivKey, Signature);
+    case kOperation_VerifyECDSASignature:
+        return VerifyECDSASignature(CurveOID, MsgHash, MsgHashLen, Signature, PubKey);
+    default:
+        return WEAVE_ERROR_INVALID_ARGUMENT;
+    }
+}
+
+#if WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED
+
+static void PerformDeferredOperation(System::Layer *systemLayer, void *appState, System::Error error)
+{
+    AsyncECOperation *op = static_cast<AsyncECOperation *>(appState);
+
+    op->SystemLayer = NULL;
+    op->Result = op->Perform();
+    op->OnComplete(op);
+}
+
+/**
+ * Start an elliptic curve operation.
+ *
+ * The operation is performed on the Weave thread, after the current event has been handled.
+ *
+ * @param[in] systemLayer   The system layer of the Weave thread, on which the completion is reported.
+ * @param[in] op            The operation to perform.
+ *
+ * @retval #WEAVE_NO_ERROR  If the operation was started, in which case its OnComplete function will be called.
+ */
+WEAVE_ERROR StartAsyncECOperation(System::Layer& systemLayer, AsyncECOperation& op)
+{
+    WEAVE_ERROR err;
+
+    VerifyOrExit(op.OnComplete != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    op.SystemLayer = &systemLayer;
+
+    err = systemLayer.ScheduleWork(PerformDeferredOperation, &op);
+    if (err != WEAVE_NO_ERROR)
+        op.SystemLayer = NULL;
+
+exit:
+    return err;
+}
+
+#endif // WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_DEFERRED
+
+#if WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD
+
+// Operations waiting for the worker thread, in the order in which they were started.
+static pthread_mutex_t sQueueLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sQueueCond = PTHREAD_COND_INITIALIZER;
+static AsyncECOperation *sQueueHead;
+static AsyncECOperation *sQueueTail;
+static bool sWorkerStarted;
+
+enum
+{
+    kCompletionRetryInterval = 1000     // microseconds
+};
+
+static void HandleOperationComplete(System::Layer *systemLayer, void *appState, System::Error error)
+{
+    AsyncECOperation *op = static_cast<AsyncECOperation *>(appState);
+
+    op->SystemLayer = NULL;
+    op->OnComplete(op);
+}
+
+static void *WorkerMain(void *arg)
+{
+    while (true)
+    {
+        AsyncECOperation *op;
+
+        pthread_mutex_lock(&sQueueLock);
+        while (sQueueHead == NULL)
+            pthread_cond_wait(&sQueueCond, &sQueueLock);
+        op = sQueueHead;
+        sQueueHead = op->Next;
+        if (sQueueHead == NULL)
+            sQueueTail = NULL;
+        pthread_mutex_unlock(&sQueueLock);
+
+        op->Next = NULL;
+        op->Result = op->Perform();
+
+        // Layer::ScheduleWork() may be called from any thread.  Wait for a timer to be freed if none is available.
+        while (true)
+        {
+            System::Error err = op->SystemLayer->ScheduleWork(HandleOperationComplete, op);
+
+            if (err == WEAVE_SYSTEM_NO_ERROR)
+                break;
+
+            if (err != WEAVE_SYSTEM_ERROR_NO_MEMORY)
+            {
+                WeaveLogError(Crypto, "Failed to post async EC operation completion: %ld", (long)err);
+                break;
+            }
+
+            usleep(kCompletionRetryInterval);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Start an elliptic curve operation.
+ *
+ * The operation is performed on a worker thread, which is created when the first operation is started.
+ *
+ * @param[in] systemLayer   The system layer of the Weave thread, on which the completion is reported.
+ * @param[in] op            The operation to perform.
+ *
+ * @retval #WEAVE_NO_ERROR  If the operation was started, in which case its OnComplete function will be called.
+ */
+WEAVE_ERROR StartAsyncECOperation(System::Layer& systemLayer, AsyncECOperation& op)
+{
+    WEAVE_ERROR err;
+
+    VerifyOrExit(op.OnComplete != NULL, err = WEAVE_ERROR_INVALID_ARGUMENT);
+
+    op.SystemLayer = &systemLayer;
+    op.Next = NULL;
+    err = WEAVE_NO_ERROR;
+
+    pthread_mutex_lock(&sQueueLock);
+
+    if (!sWorkerStarted)
+    {
+        pthread_t thread;
+        int res = pthread_create(&thread, NULL, WorkerMain, NULL);
+
+        if (res == 0)
+        {
+            pthread_detach(thread);
+            sWorkerStarted = true;
+        }
+        else
+            err = System::MapErrorPOSIX(res);
+    }
+
+    if (err == WEAVE_NO_ERROR)
+    {
+        if (sQueueTail != NULL)
+            sQueueTail->Next = &op;
+        else
+            sQueueHead = &op;
+        sQueueTail = &op;
+        pthread_cond_signal(&sQueueCond);
+    }
+
+    pthread_mutex_unlock(&sQueueLock);
+
+    if (err != WEAVE_NO_ERROR)
+        op.SystemLayer = NULL;
+
+exit:
+    return err;
+}
+
+#endif // WEAVE_CONFIG_ASYNC_EC_IMPLEMENTATION_THREAD
+
+} // namespace Crypto
+} // namespace Weave
+} // namespace nl
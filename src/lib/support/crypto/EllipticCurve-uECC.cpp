@@ -39,6 +39,9 @@ namespace Crypto {
 using namespace nl::Weave::ASN1;
 using namespace nl::Weave::Platform::Security;
 
+#define WEAVE_USE_P256_FIXED_BASE_COMB (WEAVE_CONFIG_MICRO_ECC_P256_FIXED_BASE_COMB && WEAVE_CONFIG_SUPPORT_ELLIPTIC_CURVE_SECP256R1)
+#define WEAVE_USE_P256_PLATFORM (WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM && WEAVE_CONFIG_SUPPORT_ELLIPTIC_CURVE_SECP256R1)
+
 static uECC_Curve CurveOID2uECC_Curve(OID curveOID)
 {
     switch (curveOID)
@@ -86,6 +89,418 @@ static int GetSecureRandomData_uECC(uint8_t *buf, unsigned len)
     return 0;
 }
 
+#if WEAVE_USE_P256_FIXED_BASE_COMB
+
+#if uECC_WORD_SIZE != 4
+#error "WEAVE_CONFIG_MICRO_ECC_P256_FIXED_BASE_COMB requires uECC_WORD_SIZE == 4"
+#endif
+
+enum
+{
+    kP256_NumWords              = 8,
+    kP256_NumBytes              = kP256_NumWords * uECC_WORD_SIZE,
+    kP256Comb_Teeth             = 4,
+    kP256Comb_Spacing           = 256 / kP256Comb_Teeth,
+    kP256Comb_TableSize         = (1 << kP256Comb_Teeth) - 1,
+    kP256Comb_MaxSignTries      = 64
+};
+
+// Fixed-base comb table for the secp256r1 generator G.
+//
+// Entry j - 1 holds the affine point sum(b_t * 2^(64 * t) * G), t = 0..3, where b_t is bit t of j, in micro-ecc
+// native form (x then y, least significant word first).
+static const uECC_word_t sP256CombTable[kP256Comb_TableSize][2 * kP256_NumWords] =
+{
+    { // 1
+        0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81,
+        0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2,
+        0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357,
+        0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2
+    },
+    { // 2
+        0x8E14DB63, 0x90E75CB4, 0xAD651F7E, 0x29493BAA,
+        0x326E25DE, 0x8492592E, 0x2811AAA5, 0x0FA822BC,
+        0x5F462EE7, 0xE4112454, 0x50FE82F5, 0x34B1A650,
+        0xB3DF188B, 0x6F4AD4BC, 0xF5DBA80D, 0xBFF44AE8
+    },
+    { // 3
+        0x097992AF, 0x93391CE2, 0x0D35F1FA, 0xE96C98FD,
+        0x95E02789, 0xB257C0DE, 0x89D6726F, 0x300A4BBC,
+        0xC08127A0, 0xAA54A291, 0xA9D806A5, 0x5BB1EEAD,
+        0xFF1E3C6F, 0x7F1DDB25, 0xD09B4644, 0x72AAC7E0
+    },
+    { // 4
+        0xD789BD85, 0x57C84FC9, 0xC297EAC3, 0xFC35FF7D,
+        0x88C6766E, 0xFB982FD5, 0xEEDB5E67, 0x447D739B,
+        0x72E25B32, 0x0C7E33C9, 0xA7FAE500, 0x3D349B95,
+        0x3A4AAFF7, 0xE12E9D95, 0x834131EE, 0x2D4825AB
+    },
+    { // 5
+        0x2A1D367F, 0x13949C93, 0x1A0A11B7, 0xEF7FBD2B,
+        0xB91DFC60, 0xDDC6068B, 0x8A9C72FF, 0xEF951932,
+        0x7376D8A8, 0x196035A7, 0x95CA1740, 0x23183B08,
+        0x022C219C, 0xC1EE9807, 0x7DBB2C9B, 0x611E9FC3
+    },
+    { // 6
+        0x0B57F4BC, 0xCAE2B192, 0xC6C9BC36, 0x2936DF5E,
+        0xE11238BF, 0x7DEA6482, 0x7B51F5D8, 0x55066379,
+        0x348A964C, 0x44FFE216, 0xDBDEFBE1, 0x9FB3D576,
+        0x8D9D50E5, 0x0AFA4001, 0x8AECB851, 0x15716484
+    },
+    { // 7
+        0xFC5CDE01, 0xE48ECAFF, 0x0D715F26, 0x7CCD84E7,
+        0xF43E4391, 0xA2E8F483, 0xB21141EA, 0xEB5D7745,
+        0x731A3479, 0xCAC917E2, 0x2844B645, 0x85F22CFE,
+        0x58006CEE, 0x0990E6A1, 0xDBECC17B, 0xEAFD72EB
+    },
+    { // 8
+        0x313728BE, 0x6CF20FFB, 0xA3C6B94A, 0x96439591,
+        0x44315FC5, 0x2736FF83, 0xA7849276, 0xA6D39677,
+        0xC357F5F4, 0xF2BAB833, 0x2284059B, 0x824A920C,
+        0x2D27ECDF, 0x66B8BABD, 0x9B0B8816, 0x674F8474
+    },
+    { // 9
+        0x677C8A3E, 0x2DF48C04, 0x0203A56B, 0x74E02F08,
+        0xB8C7FEDB, 0x31855F7D, 0x72C9DDAD, 0x4E769E76,
+        0xB824BBB0, 0xA4C36165, 0x3B9122A5, 0xFB9AE16F,
+        0x06947281, 0x1EC00572, 0xDE830663, 0x42B99082
+    },
+    { // 10
+        0xDDA868B9, 0x6EF95150, 0x9C0CE131, 0xD1F89E79,
+        0x08A1C478, 0x7FDC1CA0, 0x1C6CE04D, 0x78878EF6,
+        0x1FE0D976, 0x9C62B912, 0xBDE08D4F, 0x6ACE570E,
+        0x12309DEF, 0xDE53142C, 0x7B72C321, 0xB6CB3F5D
+    },
+    { // 11
+        0xC31A3573, 0x7F991ED2, 0xD54FB496, 0x5B82DD5B,
+        0x812FFCAE, 0x595C5220, 0x716B1287, 0x0C88BC4D,
+        0x5F48ACA8, 0x3A57BF63, 0xDF2564F3, 0x7C8181F4,
+        0x9C04E6AA, 0x18D1B5B3, 0xF3901DC6, 0xDD5DDEA3
+    },
+    { // 12
+        0x3E72AD0C, 0xE96A79FB, 0x42BA792F, 0x43A0A28C,
+        0x083E49F3, 0xEFE0A423, 0x6B317466, 0x68F344AF,
+        0x3FB24D4A, 0xCDFE17DB, 0x71F5C626, 0x668BFC22,
+        0x24D67FF3, 0x604ED93C, 0xF8540A20, 0x31B9C405
+    },
+    { // 13
+        0xA2582E7F, 0xD36B4789, 0x4EC39C28, 0x0D1A1014,
+        0xEDBAD7A0, 0x663C62C3, 0x6F461DB9, 0x4052BF4B,
+        0x188D25EB, 0x235A27C3, 0x99BFCC5B, 0xE724F339,
+        0x71D70CC8, 0x862BE6BD, 0x90B0FC61, 0xFECF4D51
+    },
+    { // 14
+        0xA1D4CFAC, 0x74346C10, 0x8526A7A4, 0xAFDF5CC0,
+        0xF62BFF7A, 0x123202A8, 0xC802E41A, 0x1EDDBAE2,
+        0xD603F844, 0x8FA0AF2D, 0x4C701917, 0x36E06B7E,
+        0x73DB33A0, 0x0C45F452, 0x560EBCFC, 0x43104D86
+    },
+    { // 15
+        0x0D1D78E5, 0x9615B511, 0x25C4744B, 0x66B0DE32,
+        0x6AAF363A, 0x0A4A46FB, 0x84F7A21C, 0xB48E26B4,
+        0x21A01B2D, 0x06EBB0F6, 0x8B7B0F98, 0xC004E404,
+        0xFED6F668, 0x64131BCD, 0x4D4D3DAB, 0xFAC01540
+    }
+};
+
+// A secp256r1 point in Jacobian coordinates, representing the affine point (X / Z^2, Y / Z^3).
+struct P256JacobianPoint
+{
+    uECC_word_t X[kP256_NumWords];
+    uECC_word_t Y[kP256_NumWords];
+    uECC_word_t Z[kP256_NumWords];
+};
+
+// Returns all ones if a == b, otherwise zero, without branching.
+static inline uECC_word_t P256Comb_EqualMask(uint32_t a, uint32_t b)
+{
+    return (uECC_word_t)0 - (uECC_word_t)(((a ^ b) - 1) >> 31);
+}
+
+// Copies src to dest if mask is all ones, leaves dest unchanged if mask is zero, without branching.
+static inline void P256Comb_Select(uECC_word_t *dest, const uECC_word_t *src, uECC_word_t mask)
+{
+    for (wordcount_t i = 0; i < kP256_NumWords; i++)
+        dest[i] = (dest[i] & ~mask) | (src[i] & mask);
+}
+
+// Loads table entry `index` (0 for the point at infinity, which yields zeros), reading every entry so that the memory
+// access pattern does not depend on the index.
+static void P256Comb_Lookup(uECC_word_t *point, uint32_t index)
+{
+    uECC_vli_clear(point, 2 * kP256_NumWords);
+
+    for (uint32_t j = 1; j <= kP256Comb_TableSize; j++)
+    {
+        const uECC_word_t mask = P256Comb_EqualMask(j, index);
+
+        for (wordcount_t i = 0; i < 2 * kP256_NumWords; i++)
+            point[i] |= sP256CombTable[j - 1][i] & mask;
+    }
+}
+
+// R = 2 * R, for a curve with a = -3 (dbl-2001-b).
+static void P256Comb_Double(P256JacobianPoint& R, uECC_Curve curve)
+{
+    const uECC_word_t *curve_p = uECC_curve_p(curve);
+    uECC_word_t delta[kP256_NumWords];
+    uECC_word_t gamma[kP256_NumWords];
+    uECC_word_t beta[kP256_NumWords];
+    uECC_word_t alpha[kP256_NumWords];
+    uECC_word_t t[kP256_NumWords];
+
+    uECC_vli_modSquare_fast(delta, R.Z, curve);                             /* delta = Z^2 */
+    uECC_vli_modSquare_fast(gamma, R.Y, curve);                             /* gamma = Y^2 */
+    uECC_vli_modMult_fast(beta, R.X, gamma, curve);                         /* beta = X * gamma */
+
+    uECC_vli_modSub(t, R.X, delta, curve_p, kP256_NumWords);
+    uECC_vli_modAdd(alpha, R.X, delta, curve_p, kP256_NumWords);
+    uECC_vli_modMult_fast(alpha, alpha, t, curve);
+    uECC_vli_modAdd(t, alpha, alpha, curve_p, kP256_NumWords);
+    uECC_vli_modAdd(alpha, alpha, t, curve_p, kP256_NumWords);              /* alpha = 3 * (X - delta) * (X + delta) */
+
+    uECC_vli_modAdd(R.Z, R.Y, R.Z, curve_p, kP256_NumWords);
+    uECC_vli_modSquare_fast(R.Z, R.Z, curve);
+    uECC_vli_modSub(R.Z, R.Z, gamma, curve_p, kP256_NumWords);
+    uECC_vli_modSub(R.Z, R.Z, delta, curve_p, kP256_NumWords);              /* Z3 = (Y + Z)^2 - gamma - delta */
+
+    uECC_vli_modAdd(beta, beta, beta, curve_p, kP256_NumWords);
+    uECC_vli_modAdd(beta, beta, beta, curve_p, kP256_NumWords);             /* beta = 4 * beta */
+    uECC_vli_modSquare_fast(R.X, alpha, curve);
+    uECC_vli_modSub(R.X, R.X, beta, curve_p, kP256_NumWords);
+    uECC_vli_modSub(R.X, R.X, beta, curve_p, kP256_NumWords);               /* X3 = alpha^2 - 8 * beta */
+
+    uECC_vli_modSub(t, beta, R.X, curve_p, kP256_NumWords);
+    uECC_vli_modMult_fast(R.Y, alpha, t, curve);
+    uECC_vli_modSquare_fast(gamma, gamma, curve);
+    uECC_vli_modAdd(gamma, gamma, gamma, curve_p, kP256_NumWords);
+    uECC_vli_modAdd(gamma, gamma, gamma, curve_p, kP256_NumWords);
+    uECC_vli_modAdd(gamma, gamma, gamma, curve_p, kP256_NumWords);
+    uECC_vli_modSub(R.Y, R.Y, gamma, curve_p, kP256_NumWords);              /* Y3 = alpha * (4 * beta - X3) - 8 * gamma^2 */
+}
+
+// S = R + Q, where Q is affine (madd-2004-hmv).  Returns false if R and Q have the same x coordinate, in which
+// case S is not the sum.
+static bool P256Comb_AddAffine(P256JacobianPoint& S, const P256JacobianPoint& R, const uECC_word_t *Q, uECC_Curve curve)
+{
+    const uECC_word_t *curve_p = uECC_curve_p(curve);
+    uECC_word_t t[kP256_NumWords];
+    uECC_word_t H[kP256_NumWords];
+    uECC_word_t r[kP256_NumWords];
+    uECC_word_t HHH[kP256_NumWords];
+    uECC_word_t V[kP256_NumWords];
+
+    uECC_vli_modSquare_fast(t, R.Z, curve);
+    uECC_vli_modMult_fast(H, Q, t, curve);
+    uECC_vli_modSub(H, H, R.X, curve_p, kP256_NumWords);                    /* H = x2 * Z1^2 - X1 */
+    uECC_vli_modMult_fast(t, t, R.Z, curve);
+    uECC_vli_modMult_fast(r, Q + kP256_NumWords, t, curve);
+    uECC_vli_modSub(r, r, R.Y, curve_p, kP256_NumWords);                    /* r = y2 * Z1^3 - Y1 */
+
+    uECC_vli_modSquare_fast(t, H, curve);
+    uECC_vli_modMult_fast(HHH, H, t, curve);                                /* HHH = H^3 */
+    uECC_vli_modMult_fast(V, R.X, t, curve);                                /* V = X1 * H^2 */
+
+    uECC_vli_modSquare_fast(S.X, r, curve);
+    uECC_vli_modSub(S.X, S.X, HHH, curve_p, kP256_NumWords);
+    uECC_vli_modSub(S.X, S.X, V, curve_p, kP256_NumWords);
+    uECC_vli_modSub(S.X, S.X, V, curve_p, kP256_NumWords);                  /* X3 = r^2 - HHH - 2 * V */
+
+    uECC_vli_modSub(V, V, S.X, curve_p, kP256_NumWords);
+    uECC_vli_modMult_fast(V, V, r, curve);
+    uECC_vli_modMult_fast(t, R.Y, HHH, curve);
+    uECC_vli_modSub(S.Y, V, t, curve_p, kP256_NumWords);                    /* Y3 = r * (V - X3) - Y1 * HHH */
+
+    uECC_vli_modMult_fast(S.Z, R.Z, H, curve);                              /* Z3 = Z1 * H */
+
+    return !uECC_vli_isZero(H, kP256_NumWords);
+}
+
+/**
+ * Computes result = k * G on secp256r1 using the fixed-base comb table.
+ *
+ * One doubling, one table scan and one addition are performed for each of the 64 comb columns, whatever the value of
+ * k; the only data-dependent branch is taken with negligible probability for a random k.  The result is randomized
+ * in projective form before the final inversion.
+ *
+ * @param[out] result   The affine result, in micro-ecc native form; zeros for the point at infinity.
+ * @param[in]  k        The scalar, in micro-ecc native form.
+ *
+ * @return 1 on success, 0 if random data could not be generated.
+ */
+static int P256Comb_Mult(uECC_word_t *result, const uECC_word_t *k)
+{
+    const uECC_Curve curve = uECC_secp256r1();
+    const uECC_word_t *curve_p = uECC_curve_p(curve);
+    P256JacobianPoint R;
+    P256JacobianPoint S;
+    P256JacobianPoint Qj;
+    uECC_word_t Q[2 * kP256_NumWords];
+    uECC_word_t lambda2[kP256_NumWords];
+    uECC_word_t lambda3[kP256_NumWords];
+    uECC_word_t isInfinity = (uECC_word_t)-1;
+
+    // Points loaded into an empty accumulator are given the random Z coordinate lambda.
+    if (!uECC_generate_random_int(Qj.Z, curve_p, kP256_NumWords))
+        return 0;
+    uECC_vli_modSquare_fast(lambda2, Qj.Z, curve);
+    uECC_vli_modMult_fast(lambda3, lambda2, Qj.Z, curve);
+
+    memset(&R, 0, sizeof(R));
+
+    for (int i = kP256Comb_Spacing - 1; i >= 0; i--)
+    {
+        uint32_t index = 0;
+        uECC_word_t isZeroIndex;
+        uECC_word_t wasInfinity;
+
+        // Gather bit i of each 64-bit quarter of k.
+        for (int tooth = kP256Comb_Teeth - 1; tooth >= 0; tooth--)
+        {
+            const int bit = i + tooth * kP256Comb_Spacing;
+
+            index = (index << 1) | (uint32_t)((k[bit / uECC_WORD_BITS] >> (bit % uECC_WORD_BITS)) & 1);
+        }
+        isZeroIndex = P256Comb_EqualMask(index, 0);
+        wasInfinity = isInfinity;
+        isInfinity &= isZeroIndex;
+
+        P256Comb_Double(R, curve);
+
+        P256Comb_Lookup(Q, index);
+        uECC_vli_modMult_fast(Qj.X, Q, lambda2, curve);
+        uECC_vli_modMult_fast(Qj.Y, Q + kP256_NumWords, lambda3, curve);
+
+        if (!P256Comb_AddAffine(S, R, Q, curve) && !wasInfinity && !isZeroIndex)
+        {
+            uECC_word_t t[kP256_NumWords];
+
+            // R = +/-Q: the sum is 2 * Q if the y coordinates match (Y1 = y2 * Z1^3), otherwise the point at infinity.
+            uECC_vli_modSquare_fast(t, R.Z, curve);
+            uECC_vli_modMult_fast(t, t, R.Z, curve);
+            uECC_vli_modMult_fast(t, t, Q + kP256_NumWords, curve);
+
+            S = Qj;
+            if (uECC_vli_equal(t, R.Y, kP256_NumWords))
+                P256Comb_Double(S, curve);
+            else
+                isInfinity = (uECC_word_t)-1;
+        }
+
+        // R = (R == infinity) ? Q : ((index == 0) ? R : R + Q)
+        P256Comb_Select(R.X, S.X, ~isZeroIndex);
+        P256Comb_Select(R.Y, S.Y, ~isZeroIndex);
+        P256Comb_Select(R.Z, S.Z, ~isZeroIndex);
+
+        P256Comb_Select(R.X, Qj.X, wasInfinity);
+        P256Comb_Select(R.Y, Qj.Y, wasInfinity);
+        P256Comb_Select(R.Z, Qj.Z, wasInfinity);
+    }
+
+    // Convert to affine coordinates.
+    uECC_vli_modInv(S.Z, R.Z, curve_p, kP256_NumWords);
+    uECC_vli_modSquare_fast(S.X, S.Z, curve);
+    uECC_vli_modMult_fast(S.Y, S.X, S.Z, curve);
+    uECC_vli_modMult_fast(result, R.X, S.X, curve);
+    uECC_vli_modMult_fast(result + kP256_NumWords, R.Y, S.Y, curve);
+
+    for (wordcount_t i = 0; i < 2 * kP256_NumWords; i++)
+        result[i] &= ~isInfinity;
+
+    ClearSecretData((uint8_t *)&R, sizeof(R));
+    ClearSecretData((uint8_t *)&S, sizeof(S));
+    ClearSecretData((uint8_t *)&Qj, sizeof(Qj));
+    ClearSecretData((uint8_t *)Q, sizeof(Q));
+
+    return 1;
+}
+
+// Generates a secp256r1 key pair, in the same byte format as uECC_make_key().
+static int P256Comb_MakeKey(uint8_t *pubKey, uint8_t *privKey)
+{
+    uECC_word_t priv[kP256_NumWords];
+    uECC_word_t pub[2 * kP256_NumWords];
+    int res;
+
+    res = uECC_generate_random_int(priv, uECC_curve_n(uECC_secp256r1()), kP256_NumWords);
+    if (res)
+        res = P256Comb_Mult(pub, priv);
+
+    if (res)
+    {
+        uECC_vli_nativeToBytes(privKey, kP256_NumBytes, priv);
+        uECC_vli_nativeToBytes(pubKey, kP256_NumBytes, pub);
+        uECC_vli_nativeToBytes(pubKey + kP256_NumBytes, kP256_NumBytes, pub + kP256_NumWords);
+    }
+
+    ClearSecretData((uint8_t *)priv, sizeof(priv));
+
+    return res;
+}
+
+// Generates a secp256r1 ECDSA signature, in the same byte format as uECC_sign().
+static int P256Comb_Sign(const uint8_t *privKey, const uint8_t *msgHash, unsigned msgHashLen, uint8_t *sig)
+{
+    const uECC_Curve curve = uECC_secp256r1();
+    const uECC_word_t *curve_n = uECC_curve_n(curve);
+    uECC_word_t d[kP256_NumWords];
+    uECC_word_t e[kP256_NumWords];
+    uECC_word_t k[kP256_NumWords];
+    uECC_word_t r[kP256_NumWords];
+    uECC_word_t s[kP256_NumWords];
+    uECC_word_t blind[kP256_NumWords];
+    uECC_word_t R[2 * kP256_NumWords];
+    int res = 0;
+
+    uECC_vli_bytesToNative(d, privKey, kP256_NumBytes);
+
+    // e = the leftmost 256 bits of the hash, reduced mod n.
+    uECC_vli_clear(e, kP256_NumWords);
+    uECC_vli_bytesToNative(e, msgHash, (msgHashLen > kP256_NumBytes) ? (int)kP256_NumBytes : (int)msgHashLen);
+    if (uECC_vli_cmp(curve_n, e, kP256_NumWords) != 1)
+        uECC_vli_sub(e, e, curve_n, kP256_NumWords);
+
+    for (int tries = 0; tries < kP256Comb_MaxSignTries; tries++)
+    {
+        if (!uECC_generate_random_int(k, curve_n, kP256_NumWords) ||
+            !uECC_generate_random_int(blind, curve_n, kP256_NumWords) ||
+            !P256Comb_Mult(R, k))
+            break;
+
+        // r = R.x mod n
+        uECC_vli_set(r, R, kP256_NumWords);
+        if (uECC_vli_cmp(curve_n, r, kP256_NumWords) != 1)
+            uECC_vli_sub(r, r, curve_n, kP256_NumWords);
+        if (uECC_vli_isZero(r, kP256_NumWords))
+            continue;
+
+        // k = 1 / k, computed as blind / (k * blind) so that the inversion does not operate on k directly.
+        uECC_vli_modMult(k, k, blind, curve_n, kP256_NumWords);
+        uECC_vli_modInv(k, k, curve_n, kP256_NumWords);
+        uECC_vli_modMult(k, k, blind, curve_n, kP256_NumWords);
+
+        // s = (e + r * d) / k
+        uECC_vli_modMult(s, r, d, curve_n, kP256_NumWords);
+        uECC_vli_modAdd(s, s, e, curve_n, kP256_NumWords);
+        uECC_vli_modMult(s, s, k, curve_n, kP256_NumWords);
+        if (uECC_vli_isZero(s, kP256_NumWords))
+            continue;
+
+        uECC_vli_nativeToBytes(sig, kP256_NumBytes, r);
+        uECC_vli_nativeToBytes(sig + kP256_NumBytes, kP256_NumBytes, s);
+        res = 1;
+        break;
+    }
+
+    ClearSecretData((uint8_t *)d, sizeof(d));
+    ClearSecretData((uint8_t *)k, sizeof(k));
+    ClearSecretData((uint8_t *)blind, sizeof(blind));
+
+    return res;
+}
+
+#endif // WEAVE_USE_P256_FIXED_BASE_COMB
+
 static WEAVE_ERROR DecodeDERInt(const uint8_t *derInt, uint16_t derIntLen, uint8_t *eccInt, const uint16_t eccIntLen)
 {
     if ( derIntLen == 0 )
@@ -190,6 +605,9 @@ WEAVE_ERROR GenerateECDSASignature(OID curveOID,
     int res;
     uECC_Curve curve;
     uint16_t privKeyLen;
+#if WEAVE_USE_P256_PLATFORM
+    WEAVE_ERROR platformErr;
+#endif
 
     curve = CurveOID2uECC_Curve(curveOID);
     VerifyOrExit(curve != NULL, err = WEAVE_ERROR_UNSUPPORTED_ELLIPTIC_CURVE);
@@ -205,6 +623,18 @@ WEAVE_ERROR GenerateECDSASignature(OID curveOID,
 
     // Attempt to sign the message, producing the R and S values in the process.
     // uECC_sign repeats the process several times if the generated random number was not suitable for signing.
+#if WEAVE_USE_P256_PLATFORM
+    platformErr = (curve == uECC_secp256r1()) ? P256_GenerateECDSASignature(privKey, msgHash, msgHashLen, fixedLenSig)
+                                              : WEAVE_ERROR_NOT_IMPLEMENTED;
+    if (platformErr != WEAVE_ERROR_NOT_IMPLEMENTED)
+        res = (platformErr == WEAVE_NO_ERROR);
+    else
+#endif
+#if WEAVE_USE_P256_FIXED_BASE_COMB
+    if (curve == uECC_secp256r1())
+        res = P256Comb_Sign(privKey, msgHash, msgHashLen, fixedLenSig);
+    else
+#endif
     res = uECC_sign(privKey, msgHash, msgHashLen, fixedLenSig, curve);
     VerifyOrExit(res == 1, err = WEAVE_ERROR_RANDOM_DATA_UNAVAILABLE);
 
@@ -225,6 +655,9 @@ WEAVE_ERROR VerifyECDSASignature(OID curveOID,
     int res;
     uECC_Curve curve;
     uint16_t curveLen;
+#if WEAVE_USE_P256_PLATFORM
+    WEAVE_ERROR platformErr;
+#endif
 
     curve = CurveOID2uECC_Curve(curveOID);
     VerifyOrExit(curve != NULL, err = WEAVE_ERROR_UNSUPPORTED_ELLIPTIC_CURVE);
@@ -242,6 +675,13 @@ WEAVE_ERROR VerifyECDSASignature(OID curveOID,
     VerifyOrExit(encodedPubKey.ECPointLen == 2 * curveLen + 1, err = WEAVE_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(*encodedPubKey.ECPoint == kX963EncodedPointFormat_Uncompressed, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
+#if WEAVE_USE_P256_PLATFORM
+    platformErr = (curve == uECC_secp256r1()) ? P256_VerifyECDSASignature(encodedPubKey.ECPoint + 1, msgHash, msgHashLen, l_sig)
+                                              : WEAVE_ERROR_NOT_IMPLEMENTED;
+    if (platformErr != WEAVE_ERROR_NOT_IMPLEMENTED)
+        res = (platformErr == WEAVE_NO_ERROR);
+    else
+#endif
     res = uECC_verify(encodedPubKey.ECPoint + 1, msgHash, msgHashLen, l_sig, curve);
     VerifyOrExit(res == 1, err = WEAVE_ERROR_INVALID_SIGNATURE);
 
@@ -259,6 +699,9 @@ WEAVE_ERROR VerifyECDSASignature(OID curveOID,
     int res;
     uECC_Curve curve;
     uint16_t curveLen;
+#if WEAVE_USE_P256_PLATFORM
+    WEAVE_ERROR platformErr;
+#endif
 
     curve = CurveOID2uECC_Curve(curveOID);
     VerifyOrExit(curve != NULL, err = WEAVE_ERROR_UNSUPPORTED_ELLIPTIC_CURVE);
@@ -270,6 +713,13 @@ WEAVE_ERROR VerifyECDSASignature(OID curveOID,
     VerifyOrExit(encodedPubKey.ECPointLen == 2 * curveLen + 1, err = WEAVE_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(*encodedPubKey.ECPoint == kX963EncodedPointFormat_Uncompressed, err = WEAVE_ERROR_INVALID_ARGUMENT);
 
+#if WEAVE_USE_P256_PLATFORM
+    platformErr = (curve == uECC_secp256r1()) ? P256_VerifyECDSASignature(encodedPubKey.ECPoint + 1, msgHash, msgHashLen, fixedLenSig)
+                                              : WEAVE_ERROR_NOT_IMPLEMENTED;
+    if (platformErr != WEAVE_ERROR_NOT_IMPLEMENTED)
+        res = (platformErr == WEAVE_NO_ERROR);
+    else
+#endif
     res = uECC_verify(encodedPubKey.ECPoint + 1, msgHash, msgHashLen, fixedLenSig, curve);
     VerifyOrExit(res == 1, err = WEAVE_ERROR_INVALID_SIGNATURE);
 
@@ -300,6 +750,9 @@ WEAVE_ERROR ECDHComputeSharedSecret(OID curveOID, const EncodedECPublicKey& enco
     uECC_Curve curve;
     uint16_t curveLen;
     int res;
+#if WEAVE_USE_P256_PLATFORM
+    WEAVE_ERROR platformErr;
+#endif
 
     curve = CurveOID2uECC_Curve(curveOID);
     VerifyOrExit(curve != NULL, err = WEAVE_ERROR_UNSUPPORTED_ELLIPTIC_CURVE);
@@ -320,6 +773,13 @@ WEAVE_ERROR ECDHComputeSharedSecret(OID curveOID, const EncodedECPublicKey& enco
     err = DecodeECPrivateKey(encodedPrivKey, privKey, curveLen);
     SuccessOrExit(err);
 
+#if WEAVE_USE_P256_PLATFORM
+    platformErr = (curve == uECC_secp256r1()) ? P256_ECDHComputeSharedSecret(encodedPubKey.ECPoint + 1, privKey, sharedSecretBuf)
+                                              : WEAVE_ERROR_NOT_IMPLEMENTED;
+    if (platformErr != WEAVE_ERROR_NOT_IMPLEMENTED)
+        res = (platformErr == WEAVE_NO_ERROR);
+    else
+#endif
     res = uECC_shared_secret(encodedPubKey.ECPoint + 1, privKey, sharedSecretBuf, curve);
 #if WEAVE_CONFIG_SECURITY_TEST_MODE
     // uECC does not handle multiplying a point by 1.  So if the private key is the well-known
@@ -348,6 +808,9 @@ WEAVE_ERROR GenerateECDHKey(OID curveOID, EncodedECPublicKey& encodedPubKey, Enc
     int res;
     uECC_Curve curve;
     uint16_t curveLen;
+#if WEAVE_USE_P256_PLATFORM
+    WEAVE_ERROR platformErr;
+#endif
 
     curve = CurveOID2uECC_Curve(curveOID);
     VerifyOrExit(curve != NULL, err = WEAVE_ERROR_UNSUPPORTED_ELLIPTIC_CURVE);
@@ -361,6 +824,18 @@ WEAVE_ERROR GenerateECDHKey(OID curveOID, EncodedECPublicKey& encodedPubKey, Enc
     uECC_set_rng(GetSecureRandomData_uECC);
 
     // uECC_make_key repeats the process 16 times if the generated random number was not suitable for signing
+#if WEAVE_USE_P256_PLATFORM
+    platformErr = (curve == uECC_secp256r1()) ? P256_GenerateECDHKey(encodedPubKey.ECPoint + 1, privKey)
+                                              : WEAVE_ERROR_NOT_IMPLEMENTED;
+    if (platformErr != WEAVE_ERROR_NOT_IMPLEMENTED)
+        res = (platformErr == WEAVE_NO_ERROR);
+    else
+#endif
+#if WEAVE_USE_P256_FIXED_BASE_COMB
+    if (curve == uECC_secp256r1())
+        res = P256Comb_MakeKey(encodedPubKey.ECPoint + 1, privKey);
+    else
+#endif
     res = uECC_make_key(encodedPubKey.ECPoint + 1, privKey, curve);
     VerifyOrExit(res == 1, err = WEAVE_ERROR_RANDOM_DATA_UNAVAILABLE);
 
@@ -499,6 +974,16 @@ extern void uECC_point_add(uECC_word_t *result,
 }
 
 /* Converts long integer in big-endian form (input) into uECC native VLI form (modulo n) */
+/* result = point * scalar, using the fixed-base comb when point is the secp256r1 generator */
+static void PointMult(uECC_word_t *result, const uECC_word_t *point, const uECC_word_t *scalar, uECC_Curve curve)
+{
+#if WEAVE_USE_P256_FIXED_BASE_COMB
+    if (curve == uECC_secp256r1() && point == uECC_curve_G(curve) && P256Comb_Mult(result, scalar))
+        return;
+#endif
+    uECC_point_mult(result, point, scalar, curve);
+}
+
 static void uECC_vli_bytesToNative_mod_n(uECC_word_t *result,
                                          const uint8_t *input,
                                          wordcount_t input_len,
@@ -622,7 +1107,7 @@ WEAVE_ERROR EllipticCurveJPAKE::VerifyZeroKnowledgeProof(const ECJPAKEStepPart *
     /* Convert ZKP Hash result into VLI format */
     uECC_vli_bytesToNative_mod_n(hashVLI, hash, kECJPAKE_HashLength, Curve);
     /* ecPoint1 = G*b */
-    uECC_point_mult(ecPoint1, zkpG, stepPart->b, Curve);
+    PointMult(ecPoint1, zkpG, stepPart->b, Curve);
     /* ecPoint2 = (G*x)*h = G*{h*x} */
     uECC_point_mult(ecPoint2, stepPart->Gx, hashVLI, Curve);
     /* ecPoint2 = ecPoint1 + ecPoint2 = G*{hx} + G*b = G*{hx+b} = G*r (allegedly) */
@@ -651,7 +1136,7 @@ WEAVE_ERROR EllipticCurveJPAKE::GenerateZeroKnowledgeProof(ECJPAKEStepPart *step
     VerifyOrExit(uECC_generate_random_int(stepPart->b, curve_n, num_n_words),
                      err = WEAVE_ERROR_RANDOM_DATA_UNAVAILABLE);
     /* G*r */
-    uECC_point_mult(stepPart->Gr, zkpG, stepPart->b, Curve);
+    PointMult(stepPart->Gr, zkpG, stepPart->b, Curve);
     /* hash = hash(G, G*r, G*x, name) */
     ZeroKnowledgeProofHash(uECC_curve_num_words(Curve), hash, zkpG, stepPart, name, nameLen);
     /* Convert ZKP Hash result into VLI format */
@@ -666,7 +1151,7 @@ exit:
 
 WEAVE_ERROR EllipticCurveJPAKE::GenerateStepPart(ECJPAKEStepPart *stepPart, const uECC_word_t *x, const EccPoint G, const uint8_t *name, const uint16_t nameLen)
 {
-    uECC_point_mult(stepPart->Gx, G, x, Curve);
+    PointMult(stepPart->Gx, G, x, Curve);
     return GenerateZeroKnowledgeProof(stepPart, x, G, name, nameLen);
 }
 
@@ -61,6 +61,11 @@ struct ECJPAKE_CTX;
 
 namespace nl {
 namespace Weave {
+
+namespace System {
+class Layer;
+} // namespace System
+
 namespace Crypto {
 
 using nl::Weave::ASN1::OID;
@@ -177,6 +182,54 @@ extern WEAVE_ERROR ECDHComputeSharedSecret(OID curveOID, const EncodedECPublicKe
 
 extern WEAVE_ERROR GetCurveG(OID curveOID, EncodedECPublicKey& encodedPubKey);
 
+// ============================================================
+// Asynchronous elliptic curve operations.
+// ============================================================
+
+/**
+ * An elliptic curve operation to be performed without blocking the Weave event loop.
+ *
+ * The caller fills in the inputs of the operation and starts it with StartAsyncECOperation().
+ * The object, and all buffers it refers to, must remain valid until the OnComplete function
+ * is called, on the Weave thread, with the result of the operation in the Result member.
+ */
+class NL_DLL_EXPORT AsyncECOperation
+{
+public:
+    enum OperationType
+    {
+        kOperation_GenerateECDHKey,         /**< Generate PubKey and PrivKey. */
+        kOperation_ECDHComputeSharedSecret, /**< Compute SharedSecretBuf from PubKey and PrivKey. */
+        kOperation_GenerateECDSASignature,  /**< Generate Signature over MsgHash with PrivKey. */
+        kOperation_VerifyECDSASignature,    /**< Verify Signature over MsgHash with PubKey. */
+    };
+
+    typedef void (*CompleteFunct)(AsyncECOperation *op);
+
+    OperationType Type;
+    OID CurveOID;
+    EncodedECPublicKey PubKey;
+    EncodedECPrivateKey PrivKey;
+    EncodedECDSASignature Signature;
+    const uint8_t *MsgHash;
+    uint8_t MsgHashLen;
+    uint8_t *SharedSecretBuf;
+    uint16_t SharedSecretBufSize;
+    uint16_t SharedSecretLen;
+    WEAVE_ERROR Result;
+    CompleteFunct OnComplete;
+    void *AppState;
+
+    void Reset(void);
+    WEAVE_ERROR Perform(void);
+
+    // Owned by the implementation of StartAsyncECOperation() while the operation is in progress.
+    System::Layer *SystemLayer;
+    AsyncECOperation *Next;
+};
+
+extern WEAVE_ERROR StartAsyncECOperation(System::Layer& systemLayer, AsyncECOperation& op);
+
 // ============================================================
 // OpenSSL-specific elliptic curve utility functions.
 // ============================================================
@@ -307,4 +360,40 @@ private:
 } // namespace Weave
 } // namespace nl
 
+#if WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM
+
+namespace nl {
+namespace Weave {
+namespace Platform {
+namespace Security {
+
+// Platform-specific implementations of the secp256r1 operations, e.g. using a hardware crypto accelerator.
+//
+// Public keys are the uncompressed point coordinates X || Y (64 bytes, without the X9.63 format byte), private
+// keys are 32-byte big-endian integers and signatures are the fixed-length R || S values (64 bytes).
+//
+// Each function may return WEAVE_ERROR_NOT_IMPLEMENTED, in which case the software implementation is used.
+
+enum
+{
+    kP256_PrivateKeyLength      = 32,
+    kP256_PublicKeyLength       = 64,
+    kP256_FixedLenSigLength     = 64,
+    kP256_SharedSecretLength    = 32
+};
+
+extern WEAVE_ERROR P256_GenerateECDSASignature(const uint8_t *privKey, const uint8_t *msgHash, uint8_t msgHashLen,
+                                               uint8_t *fixedLenSig);
+extern WEAVE_ERROR P256_VerifyECDSASignature(const uint8_t *pubKey, const uint8_t *msgHash, uint8_t msgHashLen,
+                                             const uint8_t *fixedLenSig);
+extern WEAVE_ERROR P256_GenerateECDHKey(uint8_t *pubKey, uint8_t *privKey);
+extern WEAVE_ERROR P256_ECDHComputeSharedSecret(const uint8_t *pubKey, const uint8_t *privKey, uint8_t *sharedSecret);
+
+} // namespace Security
+} // namespace Platform
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_CONFIG_EC_P256_IMPLEMENTATION_PLATFORM
+
 #endif /* ELLIPTICCURVE_H_ */
@@ -57,6 +57,18 @@ void HKDF<H>::BeginExtractKey(const uint8_t *salt, uint16_t saltLen)
     mHMAC.Begin(salt, saltLen);
 }
 
+/**
+ * Begin the extract step using a precomputed key schedule for the salt.
+ *
+ * Useful when many keys are derived with the same salt.  The key schedule must remain valid
+ * until FinishExtractKey() is called.
+ */
+template <class H>
+void HKDF<H>::BeginExtractKey(const HMACKeySchedule<H>& saltKeySchedule)
+{
+    mHMAC.Begin(saltKeySchedule);
+}
+
 template <class H>
 void HKDF<H>::AddKeyMaterial(const uint8_t *keyData, uint16_t keyDataLen)
 {
@@ -82,15 +94,17 @@ template <class H>
 WEAVE_ERROR HKDF<H>::ExpandKey(const uint8_t *info, uint16_t infoLen, uint16_t keyLen, uint8_t *outKey)
 {
     uint8_t hashNum = 1;
+    HMACKeySchedule<H> prkKeySchedule;
 
     if (keyLen < 1 || keyLen > 255 * H::kHashLength)
         return WEAVE_ERROR_INVALID_ARGUMENT;
 
+    // Every output block is keyed with the pseudo-random key, so absorb its pads only once.
+    prkKeySchedule.SetKey(PseudoRandomKey, kPseudoRandomKeyLength);
+
     while (true)
     {
-        mHMAC.Reset();
-
-        mHMAC.Begin(PseudoRandomKey, kPseudoRandomKeyLength);
+        mHMAC.Begin(prkKeySchedule);
 
         if (hashNum > 1)
             mHMAC.AddData(outKey - H::kHashLength, H::kHashLength);
@@ -105,7 +119,7 @@ WEAVE_ERROR HKDF<H>::ExpandKey(const uint8_t *info, uint16_t infoLen, uint16_t k
             uint8_t finalHash[H::kHashLength];
             mHMAC.Finish(finalHash);
             memcpy(outKey, finalHash, keyLen);
-            memset(finalHash, 0, sizeof(H::kHashLength));
+            ClearSecretData(finalHash, sizeof(finalHash));
             break;
         }
 
@@ -115,6 +129,9 @@ WEAVE_ERROR HKDF<H>::ExpandKey(const uint8_t *info, uint16_t infoLen, uint16_t k
         hashNum++;
     }
 
+    // Do not leave the HMAC referring to the local key schedule.
+    mHMAC.Reset();
+
     return WEAVE_NO_ERROR;
 }
 
@@ -125,23 +142,50 @@ WEAVE_ERROR HKDF<H>::DeriveKey(const uint8_t *salt, uint16_t saltLen,
                                const uint8_t *info, uint16_t infoLen,
                                uint8_t *outKey, uint16_t outKeyBufSize, uint16_t outKeyLen)
 {
-    WEAVE_ERROR err;
     HKDF<H> hkdf;
 
+    hkdf.BeginExtractKey(salt, saltLen);
+
+    return hkdf.FinishDeriveKey(keyMaterial1, keyMaterial1Len, keyMaterial2, keyMaterial2Len, info, infoLen,
+                                outKey, outKeyBufSize, outKeyLen);
+}
+
+template <class H>
+WEAVE_ERROR HKDF<H>::DeriveKey(const HMACKeySchedule<H>& saltKeySchedule,
+                               const uint8_t *keyMaterial1, uint16_t keyMaterial1Len,
+                               const uint8_t *keyMaterial2, uint16_t keyMaterial2Len,
+                               const uint8_t *info, uint16_t infoLen,
+                               uint8_t *outKey, uint16_t outKeyBufSize, uint16_t outKeyLen)
+{
+    HKDF<H> hkdf;
+
+    hkdf.BeginExtractKey(saltKeySchedule);
+
+    return hkdf.FinishDeriveKey(keyMaterial1, keyMaterial1Len, keyMaterial2, keyMaterial2Len, info, infoLen,
+                                outKey, outKeyBufSize, outKeyLen);
+}
+
+template <class H>
+WEAVE_ERROR HKDF<H>::FinishDeriveKey(const uint8_t *keyMaterial1, uint16_t keyMaterial1Len,
+                                     const uint8_t *keyMaterial2, uint16_t keyMaterial2Len,
+                                     const uint8_t *info, uint16_t infoLen,
+                                     uint8_t *outKey, uint16_t outKeyBufSize, uint16_t outKeyLen)
+{
+    WEAVE_ERROR err;
+
     VerifyOrExit(outKeyLen <= outKeyBufSize, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
 
-    hkdf.BeginExtractKey(salt, saltLen);
-    hkdf.AddKeyMaterial(keyMaterial1, keyMaterial1Len);
-    hkdf.AddKeyMaterial(keyMaterial2, keyMaterial2Len);
+    AddKeyMaterial(keyMaterial1, keyMaterial1Len);
+    AddKeyMaterial(keyMaterial2, keyMaterial2Len);
 
-    err = hkdf.FinishExtractKey();
+    err = FinishExtractKey();
     SuccessOrExit(err);
 
-    err = hkdf.ExpandKey(info, infoLen, outKeyLen, outKey);
+    err = ExpandKey(info, infoLen, outKeyLen, outKey);
     SuccessOrExit(err);
 
 exit:
-    hkdf.Reset();
+    Reset();
 
     return err;
 }
@@ -47,6 +47,7 @@ public:
     ~HKDF(void);
 
     void BeginExtractKey(const uint8_t *salt, uint16_t saltLen);
+    void BeginExtractKey(const HMACKeySchedule<H>& saltKeySchedule);
     void AddKeyMaterial(const uint8_t *keyData, uint16_t keyDataLen);
 #if WEAVE_WITH_OPENSSL
     void AddKeyMaterial(const BIGNUM& num);
@@ -60,11 +61,21 @@ public:
                                  const uint8_t *keyMaterial2, uint16_t keyMaterial2Len,
                                  const uint8_t *info, uint16_t infoLen,
                                  uint8_t *outKey, uint16_t outKeyBufSize, uint16_t outKeyLen);
+    static WEAVE_ERROR DeriveKey(const HMACKeySchedule<H>& saltKeySchedule,
+                                 const uint8_t *keyMaterial1, uint16_t keyMaterial1Len,
+                                 const uint8_t *keyMaterial2, uint16_t keyMaterial2Len,
+                                 const uint8_t *info, uint16_t infoLen,
+                                 uint8_t *outKey, uint16_t outKeyBufSize, uint16_t outKeyLen);
 
     void Reset(void);
 
 private:
     HMAC<H> mHMAC;
+
+    WEAVE_ERROR FinishDeriveKey(const uint8_t *keyMaterial1, uint16_t keyMaterial1Len,
+                                const uint8_t *keyMaterial2, uint16_t keyMaterial2Len,
+                                const uint8_t *info, uint16_t infoLen,
+                                uint8_t *outKey, uint16_t outKeyBufSize, uint16_t outKeyLen);
 };
 
 typedef HKDF<Platform::Security::SHA1> HKDFSHA1;
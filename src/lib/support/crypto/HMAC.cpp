@@ -88,6 +88,24 @@ void HMAC<H>::Begin(const uint8_t *key, uint16_t keyLen)
     ClearSecretData(pad, sizeof(kBlockLength));
 }
 
+/**
+ * Begin computing an HMAC using a precomputed key schedule.
+ *
+ * @note The key schedule must remain valid, and must not be modified,
+ *       until Finish() has been called.
+ *
+ * @param[in] keySchedule       The key schedule to use.
+ */
+template <class H>
+void HMAC<H>::Begin(const HMACKeySchedule<H>& keySchedule)
+{
+    Reset();
+
+    // Resume from the state of the inner hash after the inner pad.
+    mHash = keySchedule.mInnerHash;
+    mKeySchedule = &keySchedule;
+}
+
 template <class H>
 void HMAC<H>::AddData(const uint8_t *msgData, uint16_t dataLen)
 {
@@ -113,6 +131,19 @@ void HMAC<H>::Finish(uint8_t *hashBuf)
     // Finalize the inner hash.
     mHash.Finish(innerHash);
 
+    // If started from a key schedule, resume from the state of the outer hash after
+    // the outer pad.
+    if (mKeySchedule != NULL)
+    {
+        mHash = mKeySchedule->mOuterHash;
+        mHash.AddData(innerHash, kDigestLength);
+        mHash.Finish(hashBuf);
+
+        Reset();
+        ClearSecretData(innerHash, sizeof(innerHash));
+        return;
+    }
+
     // Form the pad for the outer hash.
     memcpy(pad, mKey, mKeyLen);
     if (mKeyLen < kBlockLength)
@@ -138,11 +169,75 @@ void HMAC<H>::Reset()
     mHash.Reset();
     ClearSecretData(mKey, sizeof(mKey));
     mKeyLen = 0;
+    mKeySchedule = NULL;
 }
 
 template class HMAC<Platform::Security::SHA1>;
 template class HMAC<Platform::Security::SHA256>;
 
+template <class H>
+HMACKeySchedule<H>::HMACKeySchedule()
+{
+}
+
+template <class H>
+HMACKeySchedule<H>::~HMACKeySchedule()
+{
+    Reset();
+}
+
+/**
+ * Precompute the inner and outer pad hash states for a key.
+ *
+ * @param[in] key               A buffer containing the HMAC key.
+ * @param[in] keyLen            The length in bytes of the key.
+ */
+template <class H>
+void HMACKeySchedule<H>::SetKey(const uint8_t *key, uint16_t keyLen)
+{
+    uint8_t keyHash[H::kHashLength];
+    uint8_t innerPad[H::kBlockLength];
+    uint8_t outerPad[H::kBlockLength];
+
+    // If the key is larger than a block, hash it and use the result as the key.
+    if (keyLen > H::kBlockLength)
+    {
+        mInnerHash.Begin();
+        mInnerHash.AddData(key, keyLen);
+        mInnerHash.Finish(keyHash);
+        key = keyHash;
+        keyLen = H::kHashLength;
+    }
+
+    // Form the pads for the inner and outer hashes.
+    for (size_t i = 0; i < H::kBlockLength; i++)
+    {
+        uint8_t keyByte = (i < keyLen) ? key[i] : 0;
+        innerPad[i] = keyByte ^ 0x36;
+        outerPad[i] = keyByte ^ 0x5c;
+    }
+
+    mInnerHash.Begin();
+    mInnerHash.AddData(innerPad, H::kBlockLength);
+
+    mOuterHash.Begin();
+    mOuterHash.AddData(outerPad, H::kBlockLength);
+
+    ClearSecretData(keyHash, sizeof(keyHash));
+    ClearSecretData(innerPad, sizeof(innerPad));
+    ClearSecretData(outerPad, sizeof(outerPad));
+}
+
+template <class H>
+void HMACKeySchedule<H>::Reset()
+{
+    mInnerHash.Reset();
+    mOuterHash.Reset();
+}
+
+template class HMACKeySchedule<Platform::Security::SHA1>;
+template class HMACKeySchedule<Platform::Security::SHA256>;
+
 
 /**
  * Compares with another HMAC signature.
@@ -41,6 +41,33 @@ using nl::Weave::TLV::TLVReader;
 using nl::Weave::TLV::TLVWriter;
 using nl::Weave::ASN1::OID;
 
+template <class H> class HMAC;
+
+/**
+ * Precomputed HMAC key state.
+ *
+ * Holds the hash states that result from absorbing the inner and outer key
+ * pads for a given key. An HMAC started from a key schedule skips both pad
+ * hash blocks, which otherwise dominate the cost of authenticating a short
+ * message.
+ */
+template <class H>
+class NL_DLL_EXPORT HMACKeySchedule
+{
+public:
+    HMACKeySchedule(void);
+    ~HMACKeySchedule(void);
+
+    void SetKey(const uint8_t *keyData, uint16_t keyLen);
+    void Reset(void);
+
+private:
+    friend class HMAC<H>;
+
+    H mInnerHash;
+    H mOuterHash;
+};
+
 template <class H>
 class NL_DLL_EXPORT HMAC
 {
@@ -54,6 +81,7 @@ public:
     ~HMAC(void);
 
     void Begin(const uint8_t *keyData, uint16_t keyLen);
+    void Begin(const HMACKeySchedule<H>& keySchedule);
     void AddData(const uint8_t *msgData, uint16_t dataLen);
 #if WEAVE_WITH_OPENSSL
     void AddData(const BIGNUM& num);
@@ -70,11 +98,14 @@ private:
     H mHash;
     uint8_t mKey[kBlockLength];
     uint16_t mKeyLen;
+    const HMACKeySchedule<H> *mKeySchedule;
 };
 
 typedef HMAC<Platform::Security::SHA1> HMACSHA1;
+typedef HMACKeySchedule<Platform::Security::SHA1> HMACSHA1KeySchedule;
 
 typedef HMAC<Platform::Security::SHA256> HMACSHA256;
+typedef HMACKeySchedule<Platform::Security::SHA256> HMACSHA256KeySchedule;
 
 
 class EncodedHMACSignature
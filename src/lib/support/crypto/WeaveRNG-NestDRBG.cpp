@@ -31,11 +31,17 @@
 #include "AESBlockCipher.h"
 #include <Weave/Support/CodeUtils.h>
 
+#include <string.h>
+
 #if WEAVE_CONFIG_DEV_RANDOM_DRBG_SEED
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
-#include <string.h>
+#endif
+
+#if WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG && WEAVE_CONFIG_NESTDRBG_PER_THREAD
+#include <pthread.h>
+#include <new>
 #endif
 
 namespace nl {
@@ -96,21 +102,183 @@ exit:
 
 #if WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG
 
-AES128CTRDRBG CtrDRBG;
+/**
+ * An instance of the DRBG, together with any output generated ahead of need.
+ */
+class DRBGInstance
+{
+public:
+    AES128CTRDRBG DRBG;
+
+    DRBGInstance(void);
+    ~DRBGInstance(void);
+
+    WEAVE_ERROR Generate(uint8_t *buf, uint16_t len);
+
+private:
+#if WEAVE_CONFIG_NESTDRBG_OUTPUT_BUFFER_SIZE > 0
+    uint8_t mOutput[WEAVE_CONFIG_NESTDRBG_OUTPUT_BUFFER_SIZE];
+    uint16_t mOutputAvail;  // Bytes of unused output, at the end of mOutput.
+#endif
+};
+
+DRBGInstance::DRBGInstance(void)
+{
+#if WEAVE_CONFIG_NESTDRBG_OUTPUT_BUFFER_SIZE > 0
+    mOutputAvail = 0;
+#endif
+}
+
+DRBGInstance::~DRBGInstance(void)
+{
+#if WEAVE_CONFIG_NESTDRBG_OUTPUT_BUFFER_SIZE > 0
+    ClearSecretData(mOutput, sizeof(mOutput));
+    mOutputAvail = 0;
+#endif
+}
+
+WEAVE_ERROR DRBGInstance::Generate(uint8_t *buf, uint16_t len)
+{
+#if WEAVE_CONFIG_NESTDRBG_OUTPUT_BUFFER_SIZE > 0
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t *output;
+
+    // Generate large requests directly.
+    if (len >= sizeof(mOutput))
+        return DRBG.Generate(buf, len);
+
+    // Refill the buffer if it cannot satisfy the request, discarding the remaining output.
+    if (len > mOutputAvail)
+    {
+        err = DRBG.Generate(mOutput, sizeof(mOutput));
+        SuccessOrExit(err);
+        mOutputAvail = sizeof(mOutput);
+    }
+
+    // Hand out the output and remove it from the buffer.
+    output = mOutput + sizeof(mOutput) - mOutputAvail;
+    memcpy(buf, output, len);
+    ClearSecretData(output, len);
+    mOutputAvail -= len;
+
+exit:
+    return err;
+#else
+    return DRBG.Generate(buf, len);
+#endif
+}
+
+DRBGInstance CtrDRBG;
+
+#if WEAVE_CONFIG_NESTDRBG_PER_THREAD
+
+enum
+{
+    kThreadDRBGEntropyLength = AES128CTRDRBG::kSeedLength
+};
+
+// Guards CtrDRBG, which seeds the per-thread instances.
+static pthread_mutex_t sCtrDRBGLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t sThreadDRBGKey;
+static pthread_once_t sThreadDRBGKeyOnce = PTHREAD_ONCE_INIT;
+static bool sThreadDRBGKeyCreated;
+
+static int GetEntropyFromCtrDRBG(uint8_t *buf, size_t bufSize)
+{
+    WEAVE_ERROR err;
+
+    pthread_mutex_lock(&sCtrDRBGLock);
+    err = CtrDRBG.DRBG.Generate(buf, (uint16_t)bufSize);
+    pthread_mutex_unlock(&sCtrDRBGLock);
+
+    return (err == WEAVE_NO_ERROR) ? 0 : 1;
+}
+
+static void DeleteThreadDRBG(void *threadDRBG)
+{
+    delete static_cast<DRBGInstance *>(threadDRBG);
+}
+
+static void CreateThreadDRBGKey(void)
+{
+    sThreadDRBGKeyCreated = (pthread_key_create(&sThreadDRBGKey, DeleteThreadDRBG) == 0);
+}
+
+/**
+ * Get the DRBG instance of the calling thread, instantiating it on first use.
+ *
+ * @return The instance, or NULL if it could not be created, in which case the shared instance is used.
+ */
+static DRBGInstance *GetThreadDRBG(void)
+{
+    DRBGInstance *threadDRBG;
+    pthread_t self = pthread_self();
+
+    pthread_once(&sThreadDRBGKeyOnce, CreateThreadDRBGKey);
+    if (!sThreadDRBGKeyCreated)
+        return NULL;
+
+    threadDRBG = static_cast<DRBGInstance *>(pthread_getspecific(sThreadDRBGKey));
+    if (threadDRBG != NULL)
+        return threadDRBG;
+
+    threadDRBG = new (std::nothrow) DRBGInstance();
+    if (threadDRBG == NULL)
+        return NULL;
+
+    // Personalize the instance with the thread identity so that instances are distinct even if seeded alike.
+    if (threadDRBG->DRBG.Instantiate(GetEntropyFromCtrDRBG, kThreadDRBGEntropyLength,
+                                     reinterpret_cast<const uint8_t *>(&self), sizeof(self)) != WEAVE_NO_ERROR ||
+        pthread_setspecific(sThreadDRBGKey, threadDRBG) != 0)
+    {
+        delete threadDRBG;
+        return NULL;
+    }
+
+    return threadDRBG;
+}
+
+#endif // WEAVE_CONFIG_NESTDRBG_PER_THREAD
 
 WEAVE_ERROR InitSecureRandomDataSource(EntropyFunct entropyFunct, uint16_t entropyLen, const uint8_t *personalizationData, uint16_t perDataLen)
 {
+    WEAVE_ERROR err;
+
 #if WEAVE_CONFIG_DEV_RANDOM_DRBG_SEED
     if (entropyFunct == NULL)
         entropyFunct = GetDRBGSeedDevRandom;
 #endif
 
-    return CtrDRBG.Instantiate(entropyFunct, entropyLen, personalizationData, perDataLen);
+#if WEAVE_CONFIG_NESTDRBG_PER_THREAD
+    pthread_mutex_lock(&sCtrDRBGLock);
+#endif
+
+    err = CtrDRBG.DRBG.Instantiate(entropyFunct, entropyLen, personalizationData, perDataLen);
+
+#if WEAVE_CONFIG_NESTDRBG_PER_THREAD
+    pthread_mutex_unlock(&sCtrDRBGLock);
+#endif
+
+    return err;
 }
 
 WEAVE_ERROR GetSecureRandomData(uint8_t *buf, uint16_t len)
 {
+#if WEAVE_CONFIG_NESTDRBG_PER_THREAD
+    WEAVE_ERROR err;
+    DRBGInstance *threadDRBG = GetThreadDRBG();
+
+    if (threadDRBG != NULL)
+        return threadDRBG->Generate(buf, len);
+
+    pthread_mutex_lock(&sCtrDRBGLock);
+    err = CtrDRBG.Generate(buf, len);
+    pthread_mutex_unlock(&sCtrDRBGLock);
+
+    return err;
+#else
     return CtrDRBG.Generate(buf, len);
+#endif
 }
 
 #endif // WEAVE_CONFIG_RNG_IMPLEMENTATION_NESTDRBG
@@ -223,6 +223,67 @@ def encodeOID(oid):
 
     return encodedOID
 
+# Hash function used to build the perfect hash tables below.  MUST match OIDHash() in ASN1OID.cpp.
+def oidHash(key, seed):
+    h = (2166136261 ^ (seed * 16777619)) & 0xFFFFFFFF
+    for byte in key:
+        h = ((h ^ byte) * 16777619) & 0xFFFFFFFF
+    return h ^ (h >> 16)
+
+# Build a two-level (hash and displace) perfect hash table for the given keys.  Keys are first distributed
+# into buckets using seed 0; each bucket is then assigned the first seed (1-255) that places all of its keys
+# in distinct, unused slots.  Returns the per-bucket seeds and the slot table, or None if no assignment exists.
+def buildPerfectHash(keys, bucketCount, slotCount):
+    buckets = [ [] for _ in range(bucketCount) ]
+    for (index, key) in enumerate(keys):
+        buckets[oidHash(key, 0) % bucketCount].append(index)
+
+    seeds = [ 0 ] * bucketCount
+    slots = [ 0xFF ] * slotCount
+    for bucket in sorted(range(bucketCount), key=lambda b: -len(buckets[b])):
+        if len(buckets[bucket]) == 0:
+            continue
+        for seed in range(1, 256):
+            positions = [ oidHash(keys[index], seed) & (slotCount - 1) for index in buckets[bucket] ]
+            if len(set(positions)) == len(positions) and all(slots[pos] == 0xFF for pos in positions):
+                for (pos, index) in zip(positions, buckets[bucket]):
+                    slots[pos] = index
+                seeds[bucket] = seed
+                break
+        else:
+            return None
+
+    return (seeds, slots)
+
+oidEnumVals = dict(oidCategories)
+
+encodedOIDKeys = [ encodeOID(oid) for (catName, oidName, oidEnum, oid) in oids ]
+enumKeys = [ [ (oidEnumVals[catName] + oidEnum) >> 8, (oidEnumVals[catName] + oidEnum) & 0xFF ] for (catName, oidName, oidEnum, oid) in oids ]
+
+assert len(oids) < 0xFF
+
+hashSlotCount = 8
+while hashSlotCount < len(oids) * 5 // 4:
+    hashSlotCount *= 2
+hashBucketCount = hashSlotCount // 4
+while True:
+    encodedOIDHash = buildPerfectHash(encodedOIDKeys, hashBucketCount, hashSlotCount)
+    enumHash = buildPerfectHash(enumKeys, hashBucketCount, hashSlotCount)
+    if encodedOIDHash is not None and enumHash is not None:
+        break
+    if hashBucketCount < hashSlotCount:
+        hashBucketCount *= 2
+    else:
+        hashSlotCount *= 2
+
+def printByteArray(name, vals):
+    print("static const uint8_t %s[] =" % (name))
+    print("{")
+    for i in range(0, len(vals), 16):
+        print("    %s," % (", ".join([ "0x%02X" % (x) for x in vals[i:i+16] ])))
+    print("};")
+    print("")
+
 print("/*")
 print(" *")
 print(" *    Copyright (c) 2019 Google LLC.")
@@ -326,6 +387,19 @@ print("")
 
 print("const size_t sOIDTableSize = %d;" % (oidTableSize))
 print("")
+print("// Perfect hash tables mapping encoded object ids, and OID enum values (as 2 big-endian bytes), to their")
+print("// index in sOIDTable.  See gen-oid-table.py for how they are built.")
+print("enum")
+print("{")
+print("    kOIDHashBucketCount = %d," % (hashBucketCount))
+print("    kOIDHashSlotCount = %d," % (hashSlotCount))
+print("    kOIDHashEmptySlot = 0xFF")
+print("};")
+print("")
+printByteArray("sOIDHashSeeds", encodedOIDHash[0])
+printByteArray("sOIDHashSlots", encodedOIDHash[1])
+printByteArray("sOIDEnumHashSeeds", enumHash[0])
+printByteArray("sOIDEnumHashSlots", enumHash[1])
 
 print("#endif // ASN1_DEFINE_OID_TABLE")
 print("")
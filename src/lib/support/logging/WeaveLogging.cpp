@@ -24,8 +24,10 @@
  */
 
 #include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
+#include <inttypes.h>
 
 #include <Weave/Support/NLDLLUtil.h>
 #include <Weave/Core/WeaveCore.h>
@@ -227,6 +229,540 @@ static void DefaultLogMessage(uint8_t module, uint8_t category, const char *msg,
 static LogMessageFunct gLogFunct = DefaultLogMessage;
 #endif
 
+static void LogV(uint8_t module, uint8_t category, const char *msg, va_list ap)
+{
+#if WEAVE_LOG_ENABLE_DYNAMIC_LOGING_FUNCTION
+    gLogFunct(module, category, msg, ap);
+#else
+    DefaultLogMessage(module, category, msg, ap);
+#endif
+}
+
+#if WEAVE_CONFIG_BINARY_LOGGING
+
+/*
+ * Binary logging.
+ *
+ * Each message is recorded as a header, holding the address of the
+ * format string, followed by the raw value of each argument the
+ * format string consumes, in order.  String arguments are copied,
+ * NUL-terminated, since the caller's buffer will not outlive the
+ * call.  Records are stored contiguously in a ring buffer; when a
+ * record does not fit at the end of the buffer, the rest of the
+ * buffer is skipped, marked by a zero length if there is room for
+ * one.
+ *
+ * To format a record, the format string is split into one
+ * conversion specification at a time, each passed to snprintf()
+ * with its recorded argument(s).
+ */
+
+enum BinaryLogArgType
+{
+    kBinaryLogArg_None          = 0,    // %%
+    kBinaryLogArg_Int,
+    kBinaryLogArg_Long,
+    kBinaryLogArg_LongLong,
+    kBinaryLogArg_SizeT,
+    kBinaryLogArg_IntMax,
+    kBinaryLogArg_PtrDiff,
+    kBinaryLogArg_Double,
+    kBinaryLogArg_LongDouble,
+    kBinaryLogArg_String,
+    kBinaryLogArg_Pointer,
+    kBinaryLogArg_Unsupported
+};
+
+enum
+{
+    kBinaryLogMaxSpecLength = 31
+};
+
+struct BinaryLogConversion
+{
+    uint8_t SpecLen;
+    uint8_t ArgType;
+    uint8_t StarCount;                  // Number of '*' width/precision arguments.
+    bool PrecisionIsStar;
+};
+
+struct BinaryLogRecordHeader
+{
+    uint16_t Length;                    // Including the header; 0 marks the skipped end of the buffer.
+    uint8_t Module;
+    uint8_t Category;
+    const char *Format;
+};
+
+static bool sBinaryLoggingEnabled = false;
+static uint8_t sBinaryLogBuffer[WEAVE_CONFIG_BINARY_LOG_BUFFER_SIZE];
+static size_t sBinaryLogReadPos = 0;
+static size_t sBinaryLogWritePos = 0;
+static size_t sBinaryLogUsed = 0;
+static uint32_t sBinaryLogDropped = 0;
+
+/*
+ * Parse the conversion specification at fmt, which must point at a
+ * '%', and return a pointer past it.
+ */
+static const char *ParseConversion(const char *fmt, BinaryLogConversion &conv)
+{
+    const char *p = fmt + 1;
+    char length = 0;
+
+    conv.ArgType = kBinaryLogArg_Unsupported;
+    conv.StarCount = 0;
+    conv.PrecisionIsStar = false;
+
+    // Flags and field width.
+    while (*p != 0 && strchr("-+ #0'", *p) != NULL)
+        p++;
+    if (*p == '*')
+    {
+        conv.StarCount++;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9')
+        p++;
+
+    // Precision.
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            conv.StarCount++;
+            conv.PrecisionIsStar = true;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9')
+            p++;
+    }
+
+    // Length modifier.
+    switch (*p)
+    {
+    case 'h':
+        length = *p++;
+        if (*p == 'h')
+            p++;
+        break;
+    case 'l':
+        length = *p++;
+        if (*p == 'l')
+        {
+            length = 'q';
+            p++;
+        }
+        break;
+    case 'q':
+    case 'j':
+    case 'z':
+    case 't':
+    case 'L':
+        length = *p++;
+        break;
+    }
+
+    // Conversion.
+    switch (*p)
+    {
+    case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+        switch (length)
+        {
+        case 'l':   conv.ArgType = kBinaryLogArg_Long; break;
+        case 'q':
+        case 'L':   conv.ArgType = kBinaryLogArg_LongLong; break;
+        case 'j':   conv.ArgType = kBinaryLogArg_IntMax; break;
+        case 'z':   conv.ArgType = kBinaryLogArg_SizeT; break;
+        case 't':   conv.ArgType = kBinaryLogArg_PtrDiff; break;
+        default:    conv.ArgType = kBinaryLogArg_Int; break;
+        }
+        break;
+    case 'c':
+        if (length == 0)
+            conv.ArgType = kBinaryLogArg_Int;
+        break;
+    case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+        conv.ArgType = (length == 'L') ? kBinaryLogArg_LongDouble : kBinaryLogArg_Double;
+        break;
+    case 's':
+        if (length == 0)
+            conv.ArgType = kBinaryLogArg_String;
+        break;
+    case 'p':
+        conv.ArgType = kBinaryLogArg_Pointer;
+        break;
+    case '%':
+        if (p == fmt + 1)
+            conv.ArgType = kBinaryLogArg_None;
+        break;
+    }
+
+    if (*p != 0)
+        p++;
+
+    if (p - fmt > kBinaryLogMaxSpecLength)
+    {
+        conv.ArgType = kBinaryLogArg_Unsupported;
+        conv.SpecLen = kBinaryLogMaxSpecLength;
+    }
+    else
+        conv.SpecLen = static_cast<uint8_t>(p - fmt);
+
+    return p;
+}
+
+template <typename T>
+static bool AppendArg(uint8_t *record, size_t &len, T value)
+{
+    if (len + sizeof(value) > WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE)
+        return false;
+    memcpy(record + len, &value, sizeof(value));
+    len += sizeof(value);
+    return true;
+}
+
+template <typename T>
+static T ReadArg(const uint8_t *&arg)
+{
+    T value;
+    memcpy(&value, arg, sizeof(value));
+    arg += sizeof(value);
+    return value;
+}
+
+template <typename T>
+static int FormatArg(char *buf, size_t bufSize, const char *spec, const int *stars, uint8_t starCount, T value)
+{
+    switch (starCount)
+    {
+    case 0:
+        return snprintf(buf, bufSize, spec, value);
+    case 1:
+        return snprintf(buf, bufSize, spec, stars[0], value);
+    default:
+        return snprintf(buf, bufSize, spec, stars[0], stars[1], value);
+    }
+}
+
+/*
+ * Encode the message into a record and append it to the ring buffer.
+ * Returns false if the message cannot be recorded, and so must be
+ * formatted right away, because its format string uses a conversion
+ * not supported here (e.g. %n or %ls), or its arguments do not fit
+ * in a record.
+ */
+static bool RecordBinaryLogMessage(uint8_t module, uint8_t category, const char *msg, va_list ap)
+{
+    uint8_t record[WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE];
+    BinaryLogRecordHeader header;
+    size_t len = sizeof(header);
+    size_t contiguous;
+    bool recorded = false;
+    va_list args;
+
+    va_copy(args, ap);
+
+    for (const char *p = strchr(msg, '%'); p != NULL; p = strchr(p, '%'))
+    {
+        BinaryLogConversion conv;
+        int precision = -1;
+
+        p = ParseConversion(p, conv);
+        VerifyOrExit(conv.ArgType != kBinaryLogArg_Unsupported, );
+
+        for (uint8_t i = 0; i < conv.StarCount; i++)
+        {
+            int star = va_arg(args, int);
+            VerifyOrExit(AppendArg(record, len, star), );
+            if (conv.PrecisionIsStar && i == conv.StarCount - 1)
+                precision = star;
+        }
+
+        switch (conv.ArgType)
+        {
+        case kBinaryLogArg_Int:
+            VerifyOrExit(AppendArg(record, len, va_arg(args, int)), );
+            break;
+        case kBinaryLogArg_Long:
+            VerifyOrExit(AppendArg(record, len, va_arg(args, long)), );
+            break;
+        case kBinaryLogArg_LongLong:
+            VerifyOrExit(AppendArg(record, len, va_arg(args, long long)), );
+            break;
+        case kBinaryLogArg_SizeT:
+            VerifyOrExit(AppendArg(record, len, va_arg(args, size_t)), );
+            break;
+        case kBinaryLogArg_IntMax:
+            VerifyOrExit(AppendArg(record, len, va_arg(args, intmax_t)), );
+            break;
+        case kBinaryLogArg_PtrDiff:
+            VerifyOrExit(AppendArg(record, len, va_arg(args, ptrdiff_t)), );
+            break;
+        case kBinaryLogArg_Double:
+            VerifyOrExit(AppendArg(record, len, va_arg(args, double)), );
+            break;
+        case kBinaryLogArg_LongDouble:
+            VerifyOrExit(AppendArg(record, len, va_arg(args, long double)), );
+            break;
+        case kBinaryLogArg_Pointer:
+            VerifyOrExit(AppendArg(record, len, va_arg(args, void *)), );
+            break;
+        case kBinaryLogArg_String:
+        {
+            const char *str = va_arg(args, const char *);
+            size_t strLen;
+
+            VerifyOrExit(len < WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE, );
+
+            if (str == NULL)
+                str = "(null)";
+
+            // Truncate the string to the precision, if any (the string need not be NUL-terminated
+            // then), and to the room left in the record.
+            strLen = WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE - len - 1;
+            if (precision >= 0 && static_cast<size_t>(precision) < strLen)
+                strLen = precision;
+            strLen = strnlen(str, strLen);
+
+            memcpy(record + len, str, strLen);
+            record[len + strLen] = 0;
+            len += strLen + 1;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    // From here on the message is accounted for, whether stored or dropped.
+    recorded = true;
+
+    // If the record does not fit at the end of the buffer, skip to the start.
+    contiguous = sizeof(sBinaryLogBuffer) - sBinaryLogWritePos;
+    if (len > contiguous)
+    {
+        VerifyOrExit(sBinaryLogUsed + contiguous + len <= sizeof(sBinaryLogBuffer), sBinaryLogDropped++);
+
+        if (contiguous >= sizeof(header.Length))
+            memset(sBinaryLogBuffer + sBinaryLogWritePos, 0, sizeof(header.Length));
+        sBinaryLogUsed += contiguous;
+        sBinaryLogWritePos = 0;
+    }
+
+    VerifyOrExit(sBinaryLogUsed + len <= sizeof(sBinaryLogBuffer), sBinaryLogDropped++);
+
+    header.Length = static_cast<uint16_t>(len);
+    header.Module = module;
+    header.Category = category;
+    header.Format = msg;
+    memcpy(record, &header, sizeof(header));
+
+    memcpy(sBinaryLogBuffer + sBinaryLogWritePos, record, len);
+    sBinaryLogWritePos = (sBinaryLogWritePos + len) % sizeof(sBinaryLogBuffer);
+    sBinaryLogUsed += len;
+
+exit:
+    va_end(args);
+    return recorded;
+}
+
+/*
+ * Remove the oldest record from the ring buffer, copying it into record.
+ */
+static bool DequeueBinaryLogRecord(uint8_t *record, BinaryLogRecordHeader &header)
+{
+    while (sBinaryLogUsed > 0)
+    {
+        size_t contiguous = sizeof(sBinaryLogBuffer) - sBinaryLogReadPos;
+
+        if (contiguous >= sizeof(header.Length))
+            memcpy(&header.Length, sBinaryLogBuffer + sBinaryLogReadPos, sizeof(header.Length));
+
+        // Skip the unused end of the buffer.
+        if (contiguous < sizeof(header.Length) || header.Length == 0)
+        {
+            sBinaryLogUsed -= contiguous;
+            sBinaryLogReadPos = 0;
+            continue;
+        }
+
+        memcpy(record, sBinaryLogBuffer + sBinaryLogReadPos, header.Length);
+        memcpy(&header, record, sizeof(header));
+        sBinaryLogReadPos = (sBinaryLogReadPos + header.Length) % sizeof(sBinaryLogBuffer);
+        sBinaryLogUsed -= header.Length;
+        return true;
+    }
+
+    return false;
+}
+
+static void FormatBinaryLogRecord(const uint8_t *record, char *buf, size_t bufSize)
+{
+    BinaryLogRecordHeader header;
+    const uint8_t *arg = record + sizeof(header);
+    size_t len = 0;
+
+    memcpy(&header, record, sizeof(header));
+
+    for (const char *p = header.Format; *p != 0 && len + 1 < bufSize; )
+    {
+        BinaryLogConversion conv;
+        char spec[kBinaryLogMaxSpecLength + 1];
+        int stars[2] = { 0, 0 };
+        const char *next;
+        int res = 0;
+
+        // Copy literal text up to the next conversion.
+        if (*p != '%')
+        {
+            size_t textLen = strcspn(p, "%");
+            if (textLen > bufSize - len - 1)
+                textLen = bufSize - len - 1;
+            memcpy(buf + len, p, textLen);
+            len += textLen;
+            p += textLen;
+            continue;
+        }
+
+        next = ParseConversion(p, conv);
+        memcpy(spec, p, conv.SpecLen);
+        spec[conv.SpecLen] = 0;
+
+        for (uint8_t i = 0; i < conv.StarCount; i++)
+            stars[i] = ReadArg<int>(arg);
+
+        switch (conv.ArgType)
+        {
+        case kBinaryLogArg_None:
+            buf[len] = '%';
+            res = 1;
+            break;
+        case kBinaryLogArg_Int:
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, ReadArg<int>(arg));
+            break;
+        case kBinaryLogArg_Long:
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, ReadArg<long>(arg));
+            break;
+        case kBinaryLogArg_LongLong:
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, ReadArg<long long>(arg));
+            break;
+        case kBinaryLogArg_SizeT:
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, ReadArg<size_t>(arg));
+            break;
+        case kBinaryLogArg_IntMax:
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, ReadArg<intmax_t>(arg));
+            break;
+        case kBinaryLogArg_PtrDiff:
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, ReadArg<ptrdiff_t>(arg));
+            break;
+        case kBinaryLogArg_Double:
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, ReadArg<double>(arg));
+            break;
+        case kBinaryLogArg_LongDouble:
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, ReadArg<long double>(arg));
+            break;
+        case kBinaryLogArg_Pointer:
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, ReadArg<void *>(arg));
+            break;
+        case kBinaryLogArg_String:
+        {
+            const char *str = reinterpret_cast<const char *>(arg);
+            arg += strlen(str) + 1;
+            res = FormatArg(buf + len, bufSize - len, spec, stars, conv.StarCount, str);
+            break;
+        }
+        default:
+            break;
+        }
+
+        if (res < 0)
+            break;
+        len += (static_cast<size_t>(res) < bufSize - len) ? res : bufSize - len - 1;
+        p = next;
+    }
+
+    buf[len] = 0;
+}
+
+static void LogFormatted(uint8_t module, uint8_t category, const char *msg, ...)
+{
+    va_list ap;
+    va_start(ap, msg);
+    LogV(module, category, msg, ap);
+    va_end(ap);
+}
+
+/**
+ * Enable or disable binary logging.
+ *
+ * While enabled, Log() records messages in the categories enabled by the
+ * log filter into a ring buffer, without formatting them, and they are
+ * passed on to the logging function by FlushBinaryLog().  Messages whose
+ * format string cannot be recorded are still formatted immediately.
+ *
+ * Disabling binary logging flushes any messages still buffered.
+ *
+ * @note Like the rest of the Weave stack, binary logging is not thread-safe:
+ *       Log() and FlushBinaryLog() must be called from the same thread, or
+ *       with the same lock held.
+ *
+ * @param[in] enabled   true to enable binary logging, false to disable it.
+ *
+ */
+NL_DLL_EXPORT void SetBinaryLogging(bool enabled)
+{
+    sBinaryLoggingEnabled = enabled;
+
+    if (!enabled)
+        FlushBinaryLog(UINT32_MAX);
+}
+
+NL_DLL_EXPORT bool IsBinaryLoggingEnabled(void)
+{
+    return sBinaryLoggingEnabled;
+}
+
+/**
+ * Format messages recorded in binary logging mode and pass them on to the
+ * logging function, oldest first.
+ *
+ * Once the buffer is empty, a count of any messages dropped because the
+ * buffer was full is logged.
+ *
+ * @param[in] maxMessages   The maximum number of messages to format,
+ *                          to bound the time spent in the call.
+ *
+ * @return The number of messages formatted.
+ *
+ */
+NL_DLL_EXPORT uint32_t FlushBinaryLog(uint32_t maxMessages)
+{
+    uint8_t record[WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE];
+    char msg[WEAVE_CONFIG_BINARY_LOG_MAX_RECORD_SIZE];
+    BinaryLogRecordHeader header;
+    uint32_t count = 0;
+
+    while (count < maxMessages && DequeueBinaryLogRecord(record, header))
+    {
+        FormatBinaryLogRecord(record, msg, sizeof(msg));
+        LogFormatted(header.Module, header.Category, "%s", msg);
+        count++;
+    }
+
+    if (sBinaryLogUsed == 0 && sBinaryLogDropped != 0)
+    {
+        uint32_t dropped = sBinaryLogDropped;
+        sBinaryLogDropped = 0;
+        LogFormatted(kLogModule_Support, kLogCategory_Error, "%" PRIu32 " binary log messages dropped", dropped);
+    }
+
+    return count;
+}
+
+#endif // WEAVE_CONFIG_BINARY_LOGGING
+
 /* If so configured, apply weak linkage to the Log function.
  */
 #if WEAVE_LOGGING_STYLE_STDIO_WEAK || WEAVE_LOGGING_WEAK_LOG_FUNCT
@@ -262,11 +798,16 @@ NL_DLL_EXPORT __WEAVE_LOGGING_LINK_ATTRIBUTE void Log(uint8_t module, uint8_t ca
 {
     va_list ap;
     va_start(ap, msg);
-#if WEAVE_LOG_ENABLE_DYNAMIC_LOGING_FUNCTION
-    gLogFunct(module, category, msg, ap);
-#else
-    DefaultLogMessage(module, category, msg, ap);
-#endif
+
+#if WEAVE_CONFIG_BINARY_LOGGING
+    if (sBinaryLoggingEnabled && (!IsCategoryEnabled(category) || RecordBinaryLogMessage(module, category, msg, ap)))
+    {
+        va_end(ap);
+        return;
+    }
+#endif // WEAVE_CONFIG_BINARY_LOGGING
+
+    LogV(module, category, msg, ap);
     va_end(ap);
 }
 
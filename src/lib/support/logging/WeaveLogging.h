@@ -319,6 +319,14 @@ extern void SetLogFunct(LogMessageFunct logFunct);
 
 #endif // WEAVE_LOG_ENABLE_DYNAMIC_LOGING_FUNCTION
 
+#if WEAVE_CONFIG_BINARY_LOGGING && !WEAVE_LOGGING_STYLE_EXTERNAL
+
+extern void SetBinaryLogging(bool enabled);
+extern bool IsBinaryLoggingEnabled(void);
+extern uint32_t FlushBinaryLog(uint32_t maxMessages);
+
+#endif // WEAVE_CONFIG_BINARY_LOGGING && !WEAVE_LOGGING_STYLE_EXTERNAL
+
 #else // _WEAVE_USE_LOGGING
 
 static inline void GetMessageWithPrefix(char *buf, uint8_t bufSize, uint8_t module, const char *msg)
@@ -61,6 +61,11 @@
 #define RAD_MAX_RSES_PER_TIME_FRAME             (4U)
 #define RAD_MAX_RSES_PER_TIME_FRAME_PERIOD      (60U * 1000U)       //60 seconds
 
+//RFC 4861, Section 10. 'Protocol Constants': delay solicited RAs by up to MAX_RA_DELAY_TIME, coalescing the RSes
+//received in the meantime, and multicast RAs no more often than every MIN_DELAY_BETWEEN_RAS.
+#define RAD_MAX_RA_DELAY_TIME                   (500U)              //500 milliseconds
+#define RAD_MIN_DELAY_BETWEEN_RAS               (3U * 1000U)        //3 seconds
+
 extern void DumpMemory(const uint8_t *mem, uint32_t len, const char *prefix, uint32_t rowWidth);
 
 namespace nl {
@@ -68,8 +73,6 @@ namespace Inet {
 
 using namespace nl::Weave::Encoding;
 
-#define RAD_IPV6_ADDR_LEN                       (16U)
-
 #define RAD_ICMP6_TYPE_RS   133
 #define RAD_ICMP6_TYPE_RA   134
 uint8_t RADaemon::ICMP6Types[]          = { RAD_ICMP6_TYPE_RA };
@@ -85,13 +88,13 @@ void RADaemon::Init(Weave::System::Layer& aSystemLayer, InetLayer& aInetLayer)
     for (int j = 0; j < RAD_MAX_ADVERTISING_LINKS; ++j)     { LinkInfo[j].Self = this; }
 }
 
-//Return a Standard Internet Checksum as described in RFC 1071.
+//Add data to a Standard Internet Checksum as described in RFC 1071, returning the partial sum.
 //Code adapted from Section 4.0 "Implementation Examples", Subsection 4.1 "C".
 //Verified correct behavior comparing to <http://ask.wireshark.org/questions/11061/icmp-checksum>
 //And also comparing with <http://www.erg.abdn.ac.uk/~gorry/course/inet-pages/packet-dec2.html>
-uint16_t RADaemon::CalculateChecksum(uint16_t *startpos, uint16_t checklen)
+//NOTE: as the sum is independent of the order of its terms, data of even length can be added in any order.
+uint32_t RADaemon::ChecksumAdd(uint32_t sum, const uint16_t *startpos, uint16_t checklen)
 {
-    uint32_t sum    = 0;
     uint16_t answer = 0;
 
     while (checklen > 1)
@@ -102,41 +105,21 @@ uint16_t RADaemon::CalculateChecksum(uint16_t *startpos, uint16_t checklen)
 
     if (checklen == 1)
     {
-        *(uint8_t *)(&answer) = *(uint8_t *)startpos;
+        *(uint8_t *)(&answer) = *(const uint8_t *)startpos;
         sum += answer;
     }
 
-    sum = (sum >> 16) + (sum & 0xffff);
-    sum += (sum >> 16);
-    answer = ~sum;
-
-    return answer;
+    return sum;
 }
 
-struct PrefixInfoOption
+//Fold and complement a partial sum into the final checksum.
+uint16_t RADaemon::ChecksumFinish(uint32_t sum)
 {
-    uint8_t     Type;
-    uint8_t     Length;
-    uint8_t     PrefixLength;
-    uint8_t     L_A_Reserved1;
-    uint32_t    ValidLifetime;
-    uint32_t    PreferredLifetime;
-    uint32_t    Reserved2;
-    uint8_t     Prefix[RAD_IPV6_ADDR_LEN];
-};
+    sum = (sum >> 16) + (sum & 0xffff);
+    sum += (sum >> 16);
 
-struct RouterAdvertisementHeader
-{
-    uint8_t             Type;
-    uint8_t             Code;
-    uint16_t            Checksum;
-    uint8_t             CurHopLimit;
-    uint8_t             M_O_Reserved;
-    uint16_t            RouterLifetime;
-    uint32_t            ReacheableTime;
-    uint32_t            RetransTimer;
-    PrefixInfoOption    PrefixInfoOpt[RAD_MAX_PREFIXES_PER_LINK];
-};
+    return (uint16_t)~sum;
+}
 
 struct half
 {
@@ -175,14 +158,13 @@ struct PseudoHeader {
     uint16_t    PayloadLength;
     uint16_t    NextHeader;
     uint8_t     SrcAddr[16];
-    uint8_t     DstAddr[16];
 };
 
-void RADaemon::BuildRA(PacketBuffer *RAPacket, RADaemon::LinkInformation *linkInfo, const IPAddress &destAddr)
+void RADaemon::BuildRATemplate(RADaemon::LinkInformation *linkInfo)
 {
     uint8_t     index = 0;
 
-    RouterAdvertisementHeader *icmp6payload  = (RouterAdvertisementHeader*)RAPacket->Start();
+    RouterAdvertisementHeader *icmp6payload  = &linkInfo->RATemplate;
 
     //Fill up the ICMPv6 header fields.
     icmp6payload->Type           = RAD_ICMP6_TYPE_RA;
@@ -214,23 +196,38 @@ void RADaemon::BuildRA(PacketBuffer *RAPacket, RADaemon::LinkInformation *linkIn
 
     uint16_t reqSize = sizeof(RouterAdvertisementHeader) - (RAD_MAX_PREFIXES_PER_LINK - index) * sizeof(PrefixInfoOption);
 
-    //Fill up IPv6 fields belonging to the pseudo header necessary to calculate the checksum.
-    PseudoHeader *ip6payload = (PseudoHeader *)((uint8_t *)icmp6payload - sizeof(PseudoHeader));
-    ip6payload->PayloadLength   = BigEndian::HostSwap16(reqSize);
-    ip6payload->NextHeader      = BigEndian::HostSwap16(kIPProtocol_ICMPv6);
-    memcpy(ip6payload->SrcAddr, &linkInfo->LLAddr, sizeof(ip6payload->SrcAddr));
-    memcpy(ip6payload->DstAddr, &destAddr, sizeof(ip6payload->DstAddr));
+    //Fill up the IPv6 fields belonging to the pseudo header necessary to calculate the checksum, but for the
+    //destination address, which BuildRA() adds for every RA.
+    PseudoHeader ip6payload;
+    ip6payload.PayloadLength    = BigEndian::HostSwap16(reqSize);
+    ip6payload.NextHeader       = BigEndian::HostSwap16(kIPProtocol_ICMPv6);
+    memcpy(ip6payload.SrcAddr, &linkInfo->LLAddr, sizeof(ip6payload.SrcAddr));
+
+    linkInfo->RATemplateSum     = ChecksumAdd(ChecksumAdd(0, (uint16_t*)&ip6payload, sizeof(PseudoHeader)), (uint16_t*)icmp6payload, reqSize);
+    linkInfo->RATemplateLen     = reqSize;
+    linkInfo->RATemplateValid   = true;
+}
+
+void RADaemon::BuildRA(PacketBuffer *RAPacket, RADaemon::LinkInformation *linkInfo, const IPAddress &destAddr)
+{
+    if (!linkInfo->RATemplateValid)
+    {
+        BuildRATemplate(linkInfo);
+    }
+
+    RouterAdvertisementHeader *icmp6payload  = (RouterAdvertisementHeader*)RAPacket->Start();
+
+    memcpy(icmp6payload, &linkInfo->RATemplate, linkInfo->RATemplateLen);
 
     //NOTE: because the fields in the packets are already converted to BigEndian order,
     //      there is no need to convert the final result of the checksumming to such order.
-    icmp6payload->Checksum = CalculateChecksum((uint16_t*)ip6payload, sizeof(PseudoHeader) + reqSize);
+    icmp6payload->Checksum = ChecksumFinish(ChecksumAdd(linkInfo->RATemplateSum, (const uint16_t*)destAddr.Addr, RAD_IPV6_ADDR_LEN));
 
     //Tell the PacketBuffer about the length of the ICMP6 message.
-    RAPacket->SetDataLength(reqSize);
+    RAPacket->SetDataLength(linkInfo->RATemplateLen);
 
 //    Debugging
-//    ::DumpMemory((const uint8_t*)ip6payload, sizeof(PseudoHeader), "", 16);
-//    ::DumpMemory((const uint8_t*)icmp6payload, reqSize, "", 16);
+//    ::DumpMemory((const uint8_t*)icmp6payload, linkInfo->RATemplateLen, "", 16);
 }
 
 void RADaemon::MulticastRA(InetLayer* inet, void* appState, INET_ERROR err)
@@ -254,6 +251,7 @@ void RADaemon::MulticastRA(InetLayer* inet, void* appState, INET_ERROR err)
     {
         BuildRA(RAPacket, linkInfo, destAddr);
         linkInfo->RawEP->SendTo(destAddr, RAPacket);
+        linkInfo->LastMcastRATime = Weave::System::Layer::GetClock_MonotonicMS();
     }
 }
 
@@ -286,6 +284,45 @@ void RADaemon::MulticastPeriodicRA(Weave::System::Layer* aSystemLayer, void* aAp
     aSystemLayer->StartTimer(lTimeout + lFuzz, MulticastPeriodicRA, lLinkInfo);
 }
 
+void RADaemon::SendSolicitedRA(Weave::System::Layer* aSystemLayer, void* aAppState, Weave::System::Error aError)
+{
+    RADaemon::LinkInformation*  lLinkInfo   = reinterpret_cast<RADaemon::LinkInformation*>(aAppState);
+    INET_ERROR                  lError      = static_cast<INET_ERROR>(aError);
+    PacketBuffer*               lRAPacket   = NULL;
+
+    lLinkInfo->SolicitedRAPending = false;
+
+    if (lError != INET_NO_ERROR)
+    {
+        return;
+    }
+
+    if (lLinkInfo->SolicitedRADest == IPAddress::Any)
+    {
+        uint32_t lTimeout = RAD_SHORT_UNSOLICITED_PERIOD;
+        const uint32_t lFuzz = rand() % (RAD_FUZZY_FACTOR * 2);
+
+        MulticastRA(lLinkInfo->Self->Inet, lLinkInfo, INET_NO_ERROR);
+
+        //Since mcast has been used to reply to the RSes, reschedule a new periodic mcast of RAs.
+        if (lLinkInfo->NumRAsSentSoFar < RAD_MAX_UNSOLICITED_STARTUP_PERIODS)
+        {
+            lTimeout = RAD_SHORT_UNSOLICITED_STARTUP_PERIOD;
+        }
+
+        aSystemLayer->StartTimer(lTimeout + lFuzz, MulticastPeriodicRA, lLinkInfo);
+    }
+    else
+    {
+        lRAPacket = PacketBuffer::New();
+        if (lRAPacket == NULL)
+            return;
+
+        RADaemon::BuildRA(lRAPacket, lLinkInfo, lLinkInfo->SolicitedRADest);
+        lLinkInfo->RawEP->SendTo(lLinkInfo->SolicitedRADest, lRAPacket);
+    }
+}
+
 void RADaemon::TrackRSes(Weave::System::Layer* aSystemLayer, void* aAppState, Weave::System::Error aError)
 {
     RADaemon::LinkInformation*  lLinkInfo   = reinterpret_cast<RADaemon::LinkInformation*>(aAppState);
@@ -307,6 +344,7 @@ void RADaemon::UpdateLinkLocalAddr(RADaemon::LinkInformation *linkInfo, IPAddres
 
     //Update the Link Local address of this link
     linkInfo->LLAddr = *llAddr;
+    linkInfo->RATemplateValid = false;
 
     //Multicast an RA with the new Link Local Address.
     MulticastRA(linkInfo->Self->Inet, linkInfo, INET_NO_ERROR);
@@ -316,6 +354,9 @@ void RADaemon::UpdateLinkLocalAddr(RADaemon::LinkInformation *linkInfo, IPAddres
 
 void RADaemon::McastAllPrefixes(RADaemon::LinkInformation *linkInfo)
 {
+    //The prefix information changed, so the RA has to be rebuilt.
+    linkInfo->RATemplateValid = false;
+
     //Multicast an RA.
     MulticastRA(linkInfo->Self->Inet, linkInfo, INET_NO_ERROR);
 
@@ -354,7 +395,6 @@ void RADaemon::HandleMessageReceived(RawEndPoint *RawEPListen, PacketBuffer *msg
     RSPacketHdr        *RSPacket        = (RSPacketHdr *)msg->Start();
     RSPacketHdr        *RSPacketEnd     = (RSPacketHdr *)((uint8_t *)RSPacket + msgDataLen);
     LinkInformation    *currLinkInfo    = NULL;
-    PacketBuffer       *RAPacket        = NULL;
 
 //    Debugging
 //    char senderAddrStr[64];
@@ -404,37 +444,32 @@ void RADaemon::HandleMessageReceived(RawEndPoint *RawEPListen, PacketBuffer *msg
         }
     }
 
-    RAPacket = PacketBuffer::New();
-    if (RAPacket == NULL)
-        goto finalize;
-
     if (pktInfo == NULL)
         goto finalize;
 
-    if (pktInfo->SrcAddress == IPAddress::Any)
+    if (!currLinkInfo->SolicitedRAPending)
     {
-        uint32_t lTimeout = RAD_SHORT_UNSOLICITED_PERIOD;
-        const uint32_t lFuzz = rand() % (RAD_FUZZY_FACTOR * 2);
-        IPAddress mcastAddr;
-        IPAddress::FromString("FF02::1", mcastAddr);
-        RADaemon::BuildRA(RAPacket, currLinkInfo, mcastAddr);
-        currLinkInfo->RawEP->SendTo(mcastAddr, RAPacket);
-
-        //Since mcast has been used to reply to this RS, reschedule a new periodic mcast of RAs.
-        RADaemon *self = currLinkInfo->Self;
-        Weave::System::Layer* lSystemLayer = self->SystemLayer;
-
-        if (currLinkInfo->NumRAsSentSoFar < RAD_MAX_UNSOLICITED_STARTUP_PERIODS)
+        //RFC 4861, Section 6.2.6. 'Processing Router Solicitations':
+        // "In all cases, Router Advertisements sent in response to a Router Solicitation MUST be delayed by a
+        //  random time between 0 and MAX_RA_DELAY_TIME seconds." and "... consecutive Router Advertisements
+        //  sent to the all-nodes multicast address MUST be rate limited to no more than one advertisement every
+        //  MIN_DELAY_BETWEEN_RAS seconds."
+        uint32_t lDelay = rand() % RAD_MAX_RA_DELAY_TIME;
+        const uint64_t lSinceLastMcast = Weave::System::Layer::GetClock_MonotonicMS() - currLinkInfo->LastMcastRATime;
+
+        if (lSinceLastMcast + lDelay < RAD_MIN_DELAY_BETWEEN_RAS)
         {
-            lTimeout = RAD_SHORT_UNSOLICITED_STARTUP_PERIOD;
+            lDelay = RAD_MIN_DELAY_BETWEEN_RAS - (uint32_t)lSinceLastMcast;
         }
 
-        lSystemLayer->StartTimer(lTimeout + lFuzz, MulticastPeriodicRA, currLinkInfo);
+        currLinkInfo->SolicitedRAPending = true;
+        currLinkInfo->SolicitedRADest = pktInfo->SrcAddress;
+        currLinkInfo->Self->SystemLayer->StartTimer(lDelay, SendSolicitedRA, currLinkInfo);
     }
-    else
+    else if (currLinkInfo->SolicitedRADest != pktInfo->SrcAddress)
     {
-        RADaemon::BuildRA(RAPacket, currLinkInfo, pktInfo->SrcAddress);
-        currLinkInfo->RawEP->SendTo(pktInfo->SrcAddress, RAPacket);
+        //Several hosts are soliciting: answer them all with a single multicast RA.
+        currLinkInfo->SolicitedRADest = IPAddress::Any;
     }
 
 finalize:
@@ -672,6 +707,7 @@ void RADaemon::DelLinkInfo(InterfaceId link)
             currLinkInfo->RawEP = NULL;
             SystemLayer->CancelTimer(MulticastPeriodicRA, currLinkInfo);
             SystemLayer->CancelTimer(TrackRSes, currLinkInfo);
+            SystemLayer->CancelTimer(SendSolicitedRA, currLinkInfo);
             *currLinkInfo = RADaemon::LinkInformation();
             currLinkInfo->Self = this;
             break;
@@ -53,6 +53,33 @@ using ::nl::Weave::System::PacketBuffer;
 #define FSM_NO_PREFIX       0  //This state must always be zero.
 #define FSM_ADVERTISING     1
 
+#define RAD_IPV6_ADDR_LEN                       (16U)
+
+struct PrefixInfoOption
+{
+    uint8_t     Type;
+    uint8_t     Length;
+    uint8_t     PrefixLength;
+    uint8_t     L_A_Reserved1;
+    uint32_t    ValidLifetime;
+    uint32_t    PreferredLifetime;
+    uint32_t    Reserved2;
+    uint8_t     Prefix[RAD_IPV6_ADDR_LEN];
+};
+
+struct RouterAdvertisementHeader
+{
+    uint8_t             Type;
+    uint8_t             Code;
+    uint16_t            Checksum;
+    uint8_t             CurHopLimit;
+    uint8_t             M_O_Reserved;
+    uint16_t            RouterLifetime;
+    uint32_t            ReacheableTime;
+    uint32_t            RetransTimer;
+    PrefixInfoOption    PrefixInfoOpt[RAD_MAX_PREFIXES_PER_LINK];
+};
+
 // RADaemon -- The object containing the per-link FSMs that periodically or on demand send Router Advertisements.
 // NOTE: it is assumed that a single thread instanciates a single RADaemon object.
 class RADaemon
@@ -76,6 +103,18 @@ private:
         RawEndPoint            *RawEPListen;    //Used to received RSes
         RADaemon               *Self;
         IPPrefixInformation     IPPrefixInfo[RAD_MAX_PREFIXES_PER_LINK];
+
+        //The RA sent on this link, prebuilt with a zero checksum, and the partial checksum of everything but the
+        //destination address. Rebuilt only when the prefix information or the link local address change.
+        RouterAdvertisementHeader   RATemplate;
+        uint16_t                    RATemplateLen;
+        bool                        RATemplateValid;
+        uint32_t                    RATemplateSum;
+
+        //Solicited RA waiting to be sent, coalescing the RSes received in the meantime.
+        bool                    SolicitedRAPending;
+        IPAddress               SolicitedRADest;    //IPAddress::Any if the RA is to be multicast.
+        uint64_t                LastMcastRATime;
     };
 
     static void MulticastRA(InetLayer* inet, void* appState, INET_ERROR err);
@@ -84,7 +123,10 @@ private:
     static void HandleMessageReceived(RawEndPoint *RawEPListen, PacketBuffer *msg, const IPPacketInfo *pktInfo);
     static void HandleReceiveError(RawEndPoint *endPoint, INET_ERROR err, const IPPacketInfo *pktInfo);
     static void BuildRA(PacketBuffer *RAPacket, LinkInformation *linkInfo, const IPAddress &destAddr);
-    static uint16_t CalculateChecksum(uint16_t *startpos, uint16_t checklen);
+    static void BuildRATemplate(LinkInformation *linkInfo);
+    static uint32_t ChecksumAdd(uint32_t sum, const uint16_t *startpos, uint16_t checklen);
+    static uint16_t ChecksumFinish(uint32_t sum);
+    static void SendSolicitedRA(Weave::System::Layer* aSystemLayer, void* aAppState, Weave::System::Error aError);
     static void MulticastPeriodicRA(Weave::System::Layer* aSystemLayer, void* aAppState, Weave::System::Error aError);
     static void TrackRSes(Weave::System::Layer* aSystemLayer, void* aAppState, Weave::System::Error aError);
     static void UpdateLinkLocalAddr(LinkInformation *linkInfo, IPAddress *llAddr);
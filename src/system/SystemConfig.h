@@ -375,6 +375,97 @@
 #endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX */
 #endif /* !WEAVE_SYSTEM_CONFIG_USE_LWIP */
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the packet buffer pool of the BSD sockets configuration provides small and medium size
+ *      classes in addition to the #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC buffers of #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX
+ *      octets.
+ *
+ *  @details
+ *      Each size class has its own free list. An allocation takes a buffer from the smallest size class that fits and is not
+ *      exhausted, and PacketBuffer::RightSize() moves a buffer into a smaller size class when its contents fit.
+ *
+ *      This requires a non-zero #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC and is not available on LwIP-based platforms.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES 0
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+ *
+ *  @brief
+ *      The capacity, in octets including the reserved header space, of the small packet buffer size class.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY 128
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+ *
+ *  @brief
+ *      The number of packet buffers in the small size class.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC 16
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+ *
+ *  @brief
+ *      The capacity, in octets including the reserved header space, of the medium packet buffer size class.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY 512
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY */
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+ *
+ *  @brief
+ *      The number of packet buffers in the medium size class.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC 8
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC */
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#error "FORBIDDEN: WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES && (WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0)"
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+
+#if !(WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY && \
+      WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX)
+#error "REQUIRED: WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX"
+#endif
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the packet buffer pool of the BSD sockets configuration is managed without a mutex.
+ *
+ *  @details
+ *      When asserted, each free list is a lock-free stack whose head carries a generation tag to defeat ABA races, and buffer
+ *      reference counts are updated with atomic operations. Application threads may then allocate and free packet buffers in
+ *      parallel with the Weave event loop without serializing on a lock. The packet buffer statistics counters are not
+ *      synchronized in this mode and are only approximate under contention.
+ *
+ *      This requires a non-zero #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC and is not available on LwIP-based platforms.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL 0
+#endif /* WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL */
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL && (WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0)
+#error "FORBIDDEN: WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL && (WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0)"
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL && (WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0)
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 /**
@@ -498,6 +589,89 @@ struct LwIPEvent;
 #define WEAVE_SYSTEM_CONFIG_NUM_TIMERS 32
 #endif /* WEAVE_SYSTEM_CONFIG_NUM_TIMERS */
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) armed timers are kept in a per-layer hierarchical timing wheel.
+ *
+ *  @details
+ *      With the timing wheel, starting and cancelling a timer are constant-time operations and each expiration pass does work
+ *      bounded by #WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_MAX_EXPIRIES, independent of the number of armed timers. Without it, the
+ *      armed timers are found by scanning the timer pool (BSD sockets) or kept in a sorted list (LwIP).
+ *
+ *      On LwIP-based systems, work queued with Layer::ScheduleWork() continues to be delivered through the event queue and is
+ *      not affected by Layer::CancelTimer() when this option is asserted.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#define WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL 0
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS
+ *
+ *  @brief
+ *      The number of hash buckets used by the timing wheel to look up an armed timer by its completion function and application
+ *      state, as Layer::StartTimer() and Layer::CancelTimer() do.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS
+#define WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS 32
+#endif // WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_MAX_EXPIRIES
+ *
+ *  @brief
+ *      The maximum number of expired timers completed by a single pass over the timing wheel before control is returned to the
+ *      event loop. Any remaining expired timers are completed on the next pass.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_MAX_EXPIRIES
+#define WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_MAX_EXPIRIES WEAVE_SYSTEM_CONFIG_NUM_TIMERS
+#endif // WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_MAX_EXPIRIES
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the timer pool grows from the heap when all #WEAVE_SYSTEM_CONFIG_NUM_TIMERS timers
+ *      are in use.
+ *
+ *  @details
+ *      The pool grows in blocks of #WEAVE_SYSTEM_CONFIG_NUM_TIMERS timers, which are retained for reuse and never returned to
+ *      the heap. This requires #WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL, since only the fixed pool can be scanned for armed timers,
+ *      and is enabled by default with the timing wheel on BSD sockets-based systems.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL && WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#define WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL 1
+#else // !(WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL && WEAVE_SYSTEM_CONFIG_USE_SOCKETS)
+#define WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL 0
+#endif // !(WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL && WEAVE_SYSTEM_CONFIG_USE_SOCKETS)
+#endif // WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+
+#if WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL && !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#error "REQUIRED: WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL => WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL"
+#endif // WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL && !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) each ObjectPool keeps a bitmap of its retained slots.
+ *
+ *  @details
+ *      With the bitmap, ObjectPool::TryCreate() finds the first free slot by counting trailing bits, one word of 32 slots at a
+ *      time, instead of trying each object in turn, and the final Object::Release() clears the slot's bit. This costs a word per
+ *      32 slots in each pool and two words in each object, and is enabled by default on BSD sockets-based systems.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#define WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP 1
+#else // !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#define WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP 0
+#endif // !WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#endif // WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+
 /**
  *  @def WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
  *
@@ -509,6 +683,52 @@ struct LwIPEvent;
 #define WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS 0
 #endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) each packet buffer records the subsystem that allocated it, so that the statistics
+ *      (see #WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS) can report the buffers in use, and their high watermark, per owner.
+ *
+ *  @note
+ *      The owner is recorded in an otherwise unused byte of the buffer header, so this is only available when the Weave System
+ *      Layer provides its own packet buffer allocator, i.e. when #WEAVE_SYSTEM_CONFIG_USE_LWIP is 0.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+#define WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS 0
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS && (WEAVE_SYSTEM_CONFIG_USE_LWIP || !WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS)
+#error "FORBIDDEN: WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS && (WEAVE_SYSTEM_CONFIG_USE_LWIP || !WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS)"
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS && (WEAVE_SYSTEM_CONFIG_USE_LWIP || !WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS)
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_TRACING
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the trace points placed along the message path (SYSTEM_TRACE_SCOPE() and friends,
+ *      see SystemTrace.h) are compiled in.  When disabled, the trace point macros compile to nothing.
+ *
+ *      By default, trace events are recorded into an in-memory ring buffer that can be exported in the Chrome trace JSON
+ *      format, readable by Perfetto and chrome://tracing.  A platform may instead route the trace points to its own tracing
+ *      system, e.g. LTTng, by defining SYSTEM_TRACE_BEGIN(), SYSTEM_TRACE_END() and SYSTEM_TRACE_INSTANT() in its project
+ *      configuration header.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_TRACING
+#define WEAVE_SYSTEM_CONFIG_TRACING 0
+#endif // WEAVE_SYSTEM_CONFIG_TRACING
+
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_TRACE_BUFFER_SIZE
+ *
+ *  @brief
+ *      The number of trace events held by the in-memory trace buffer (see #WEAVE_SYSTEM_CONFIG_TRACING).  Once the buffer
+ *      is full, the oldest events are overwritten.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_TRACE_BUFFER_SIZE
+#define WEAVE_SYSTEM_CONFIG_TRACE_BUFFER_SIZE 4096
+#endif // WEAVE_SYSTEM_CONFIG_TRACE_BUFFER_SIZE
+
 /**
  *  @def WEAVE_SYSTEM_CONFIG_TEST
  *
@@ -519,6 +739,22 @@ struct LwIPEvent;
 #define WEAVE_SYSTEM_CONFIG_TEST 0
 #endif
 
+/**
+ *  @def WEAVE_SYSTEM_CONFIG_FAULT_INJECTION_ARMED_BY_DEFAULT
+ *
+ *  @brief
+ *    Defines whether (1) or not (0) the fault-injection points compiled in by the System, Inet and Weave testing
+ *    aids are armed at startup.
+ *
+ *    While fault injection is disarmed, each fault-injection point costs a single load and a predictable branch; the
+ *    fault managers are neither consulted nor updated, so no faults fire and the fault counters do not advance.
+ *    Performance and soak test builds that need fault injection compiled in can set this to 0 and call
+ *    nl::Weave::System::FaultInjection::SetArmed() once faults are actually configured.
+ */
+#ifndef WEAVE_SYSTEM_CONFIG_FAULT_INJECTION_ARMED_BY_DEFAULT
+#define WEAVE_SYSTEM_CONFIG_FAULT_INJECTION_ARMED_BY_DEFAULT 1
+#endif // WEAVE_SYSTEM_CONFIG_FAULT_INJECTION_ARMED_BY_DEFAULT
+
 // clang-format on
 
 // Configuration parameters with header inclusion dependencies
@@ -529,12 +765,19 @@ struct LwIPEvent;
  * @brief
  *  The number of bytes to reserve in a network packet buffer to contain all the possible protocol encapsulation headers before the
  *  application message text. On POSIX sockets, this is WEAVE_SYSTEM_HEADER_RESERVE_SIZE. On LwIP, additional space is required for
- *  the all the headers from layer-2 up to the TCP or UDP header.
+ *  the all the headers from layer-2 up to the TCP or UDP header, including any encapsulation the network interface adds in front
+ *  of the link header (PBUF_LINK_ENCAPSULATION_HLEN), so that LwIP can prepend every header in place rather than allocating and
+ *  chaining a separate header buffer.
  */
 #ifndef WEAVE_SYSTEM_CONFIG_HEADER_RESERVE_SIZE
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#ifdef PBUF_LINK_ENCAPSULATION_HLEN
+#define WEAVE_SYSTEM_CONFIG_HEADER_RESERVE_SIZE \
+    (PBUF_LINK_ENCAPSULATION_HLEN + PBUF_LINK_HLEN + PBUF_IP_HLEN + PBUF_TRANSPORT_HLEN + WEAVE_SYSTEM_HEADER_RESERVE_SIZE)
+#else /* !defined(PBUF_LINK_ENCAPSULATION_HLEN) */
 #define WEAVE_SYSTEM_CONFIG_HEADER_RESERVE_SIZE \
     (PBUF_LINK_HLEN + PBUF_IP_HLEN + PBUF_TRANSPORT_HLEN + WEAVE_SYSTEM_HEADER_RESERVE_SIZE)
+#endif /* !defined(PBUF_LINK_ENCAPSULATION_HLEN) */
 #else /* !WEAVE_SYSTEM_CONFIG_USE_LWIP */
 #define WEAVE_SYSTEM_CONFIG_HEADER_RESERVE_SIZE (WEAVE_SYSTEM_HEADER_RESERVE_SIZE)
 #endif /* !WEAVE_SYSTEM_CONFIG_USE_LWIP */
@@ -25,6 +25,23 @@
 #include <nlassert.h>
 #include <SystemLayer/SystemFaultInjection.h>
 
+namespace nl {
+namespace Weave {
+namespace System {
+namespace FaultInjection {
+
+bool gArmed = WEAVE_SYSTEM_CONFIG_FAULT_INJECTION_ARMED_BY_DEFAULT;
+
+void SetArmed(bool aArmed)
+{
+    gArmed = aArmed;
+}
+
+} // namespace FaultInjection
+} // namespace System
+} // namespace Weave
+} // namespace nl
+
 #if WEAVE_SYSTEM_CONFIG_TEST
 
 #include "SystemLayerPrivate.h"
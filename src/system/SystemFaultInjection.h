@@ -26,6 +26,53 @@
 
 #include <SystemLayer/SystemConfig.h>
 
+#include <Weave/Support/NLDLLUtil.h>
+
+namespace nl {
+namespace Weave {
+namespace System {
+namespace FaultInjection {
+
+/**
+ * Global switch for all fault-injection points in the System, Inet and Weave layers.
+ *
+ * Defined regardless of WEAVE_SYSTEM_CONFIG_TEST, since the Inet and Weave testing aids may be enabled on their own.
+ * Use IsArmed() and SetArmed() rather than accessing it directly.
+ */
+extern NL_DLL_EXPORT bool gArmed;
+
+/**
+ * Returns whether fault-injection points are armed.
+ *
+ * @see WEAVE_SYSTEM_CONFIG_FAULT_INJECTION_ARMED_BY_DEFAULT
+ */
+inline bool IsArmed(void)
+{
+    return gArmed;
+}
+
+/**
+ * Arm or disarm all fault-injection points.
+ *
+ * @param[in] aArmed    True if fault-injection points should consult their fault managers.
+ */
+NL_DLL_EXPORT void SetArmed(bool aArmed);
+
+} // namespace FaultInjection
+} // namespace System
+} // namespace Weave
+} // namespace nl
+
+/**
+ * Evaluates to true if fault-injection points are armed; hints to the compiler that they usually are not, so that a
+ * disarmed fault-injection point costs no more than a not-taken branch.
+ */
+#if defined(__GNUC__)
+#define WEAVE_SYSTEM_FAULT_INJECTION_ARMED() __builtin_expect(::nl::Weave::System::FaultInjection::gArmed, 0)
+#else
+#define WEAVE_SYSTEM_FAULT_INJECTION_ARMED() (::nl::Weave::System::FaultInjection::gArmed)
+#endif
+
 #if WEAVE_SYSTEM_CONFIG_TEST
 
 #include <nlfaultinjection.hpp>
@@ -103,7 +150,12 @@ NL_DLL_EXPORT void InjectAsyncEvent(void);
  * @param[in] aStatements   Statements to be executed if the fault is enabled.
  */
 #define WEAVE_SYSTEM_FAULT_INJECT(aFaultId, aStatement) \
-        nlFAULT_INJECT(::nl::Weave::System::FaultInjection::GetManager(), aFaultId, aStatement)
+    do { \
+        if (WEAVE_SYSTEM_FAULT_INJECTION_ARMED()) \
+        { \
+            nlFAULT_INJECT(::nl::Weave::System::FaultInjection::GetManager(), aFaultId, aStatement); \
+        } \
+    } while (0)
 
 /**
  * This macro implements the injection of asynchronous events.
@@ -119,7 +171,10 @@ NL_DLL_EXPORT void InjectAsyncEvent(void);
  */
 #define WEAVE_SYSTEM_FAULT_INJECT_ASYNC_EVENT() \
     do { \
-        nl::Weave::System::FaultInjection::InjectAsyncEvent(); \
+        if (WEAVE_SYSTEM_FAULT_INJECTION_ARMED()) \
+        { \
+            nl::Weave::System::FaultInjection::InjectAsyncEvent(); \
+        } \
     } while (0)
 
 
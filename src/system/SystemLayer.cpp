@@ -30,6 +30,7 @@
 
 // Include local headers
 #include <SystemLayer/SystemClock.h>
+#include <SystemLayer/SystemStats.h>
 #include <SystemLayer/SystemTimer.h>
 
 // Include additional Weave headers
@@ -45,6 +46,10 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+
+#if HAVE_SYS_EVENTFD_H && HAVE_EVENTFD
+#include <sys/eventfd.h>
+#endif // HAVE_SYS_EVENTFD_H && HAVE_EVENTFD
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -95,13 +100,20 @@ Layer::Layer()
         sSystemEventHandlerDelegate.Init(HandleSystemLayerEvent);
 
     this->mEventDelegateList = NULL;
+#if !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     this->mTimerList = NULL;
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     this->mTimerComplete = false;
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    this->mTimerWheel.Init(0);
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     this->mWakePipeIn = 0;
     this->mWakePipeOut = 0;
+    this->mWakePending = 0;
 
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
@@ -113,8 +125,12 @@ Error Layer::Init(void* aContext)
 {
     Error lReturn;
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if HAVE_SYS_EVENTFD_H && HAVE_EVENTFD
+    int lEventFD;
+#else // !(HAVE_SYS_EVENTFD_H && HAVE_EVENTFD)
     int lPipeFDs[2];
     int lOSReturn, lFlags;
+#endif // !(HAVE_SYS_EVENTFD_H && HAVE_EVENTFD)
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
     RegisterSystemLayerErrorFormatter();
@@ -131,11 +147,30 @@ Error Layer::Init(void* aContext)
     lReturn = Platform::Layer::WillInit(*this, aContext);
     SuccessOrExit(lReturn);
 
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP && !LWIP_PBUF_FROM_CUSTOM_POOLS
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs, PBUF_POOL_SIZE);
+#elif !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs, WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC +
+        WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC + WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC);
+#elif !WEAVE_SYSTEM_CONFIG_USE_LWIP
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs, WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC);
+#endif
+    SYSTEM_STATS_SET_CAPACITY(nl::Weave::System::Stats::kSystemLayer_NumTimers, WEAVE_SYSTEM_CONFIG_NUM_TIMERS);
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     this->AddEventHandlerDelegate(sSystemEventHandlerDelegate);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if HAVE_SYS_EVENTFD_H && HAVE_EVENTFD
+    // Create an event counter to allow an arbitrary thread to wake the thread in the select loop. Both ends of the "pipe" are
+    // the same descriptor.
+    lEventFD = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    VerifyOrExit(lEventFD != -1, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
+
+    this->mWakePipeIn = lEventFD;
+    this->mWakePipeOut = lEventFD;
+#else // !(HAVE_SYS_EVENTFD_H && HAVE_EVENTFD)
     // Create a Unix pipe to allow an arbitrary thread to wake the thread in the select loop.
     lOSReturn = ::pipe(lPipeFDs);
     VerifyOrExit(lOSReturn == 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
@@ -151,8 +186,15 @@ Error Layer::Init(void* aContext)
     lFlags = ::fcntl(this->mWakePipeOut, F_GETFL, 0);
     lOSReturn = ::fcntl(this->mWakePipeOut, F_SETFL, lFlags | O_NONBLOCK);
     VerifyOrExit(lOSReturn == 0, lReturn = nl::Weave::System::MapErrorPOSIX(errno));
+#endif // !(HAVE_SYS_EVENTFD_H && HAVE_EVENTFD)
+
+    this->mWakePending = 0;
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    this->mTimerWheel.Init(Timer::GetCurrentEpoch());
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     this->mLayerState = kLayerState_Initialized;
     this->mContext = aContext;
 
@@ -176,12 +218,28 @@ Error Layer::Shutdown()
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     if (this->mWakePipeOut != -1)
     {
+        if (this->mWakePipeIn != this->mWakePipeOut)
+            ::close(this->mWakePipeIn);
+
         ::close(this->mWakePipeOut);
         this->mWakePipeOut = -1;
         this->mWakePipeIn = -1;
     }
 #endif
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    for (Timer* lTimer = this->mTimerWheel.Next(NULL); lTimer != NULL; )
+    {
+        Timer* lNext = this->mTimerWheel.Next(lTimer);
+
+        lTimer->Cancel();
+        lTimer = lNext;
+    }
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    this->mTimerWheel.CancelWork();
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); ++i)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -191,6 +249,7 @@ Error Layer::Shutdown()
             lTimer->Cancel();
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
     this->mContext = NULL;
     this->mLayerState = kLayerState_NotInitialized;
@@ -229,7 +288,11 @@ Error Layer::NewTimer(Timer*& aTimerPtr)
     if (this->State() != kLayerState_Initialized)
         return WEAVE_SYSTEM_ERROR_UNEXPECTED_STATE;
 
+#if WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+    lTimer = Timer::TryCreateFromPool(*this);
+#else // !WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
     lTimer = Timer::sPool.TryCreate(*this);
+#endif // !WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
     aTimerPtr = lTimer;
 
     if (lTimer == NULL)
@@ -260,6 +323,35 @@ Error Layer::NewTimer(Timer*& aTimerPtr)
 *
 */
 Error Layer::StartTimer(uint32_t aMilliseconds, TimerCompleteFunct aComplete, void* aAppState)
+{
+    return this->StartTimer(aMilliseconds, 0, aComplete, aAppState);
+}
+
+/**
+* @brief
+*   This method starts a one-shot timer that may fire late by up to a given tolerance.
+*
+*   The tolerance gives the timer slack: it fires no earlier than @a aMilliseconds and no later than @a aMilliseconds plus
+*   @a aToleranceMilliseconds from now. The system layer uses this slack to fire timers whose windows overlap together, on a
+*   single platform timer expiration, so that a sleepy device wakes less often. Timers that must fire on time, such as
+*   retransmission timers, should use a tolerance of zero.
+*
+*   @note
+*       Only a single timer is allowed to be started with the same @a aComplete and @a aAppState
+*       arguments. If called with @a aComplete and @a aAppState identical to an existing timer,
+*       the currently-running timer will first be cancelled.
+*
+*   @param[in]  aMilliseconds           Expiration time in milliseconds.
+*   @param[in]  aToleranceMilliseconds  How long, in milliseconds, expiration may be deferred past @a aMilliseconds.
+*   @param[in]  aComplete               A pointer to the function called when timer expires.
+*   @param[in]  aAppState               A pointer to the application state object used when timer expires.
+*
+*   @return WEAVE_SYSTEM_NO_ERROR On success.
+*   @return WEAVE_SYSTEM_ERROR_NO_MEMORY If a timer cannot be allocated.
+*   @return Other Value indicating timer failed to start.
+*
+*/
+Error Layer::StartTimer(uint32_t aMilliseconds, uint32_t aToleranceMilliseconds, TimerCompleteFunct aComplete, void* aAppState)
 {
     Error lReturn;
     Timer* lTimer;
@@ -268,7 +360,7 @@ Error Layer::StartTimer(uint32_t aMilliseconds, TimerCompleteFunct aComplete, vo
     lReturn = this->NewTimer(lTimer);
     SuccessOrExit(lReturn);
 
-    lReturn = lTimer->Start(aMilliseconds, aComplete, aAppState);
+    lReturn = lTimer->Start(aMilliseconds, aToleranceMilliseconds, aComplete, aAppState);
     if (lReturn != WEAVE_SYSTEM_NO_ERROR)
     {
         lTimer->Release();
@@ -296,6 +388,14 @@ void Layer::CancelTimer(Layer::TimerCompleteFunct aOnComplete, void* aAppState)
     if (this->State() != kLayerState_Initialized)
         return;
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    Timer* lTimer = this->mTimerWheel.Find(aOnComplete, aAppState);
+
+    if (lTimer != NULL)
+    {
+        lTimer->Cancel();
+    }
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); ++i)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -306,11 +406,23 @@ void Layer::CancelTimer(Layer::TimerCompleteFunct aOnComplete, void* aAppState)
             break;
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 }
 
 #if WEAVE_SYSTEM_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 void Layer::CancelAllMatchingInetTimers(nl::Inet::InetLayer& aInetLayer, void* aOnCompleteInetLayer, void* aAppState)
 {
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    for (Timer* lTimer = this->mTimerWheel.Next(NULL); lTimer != NULL; lTimer = this->mTimerWheel.Next(lTimer))
+    {
+        if (lTimer->mInetLayer == &aInetLayer && lTimer->mOnCompleteInetLayer == aOnCompleteInetLayer &&
+            lTimer->mAppStateInetLayer == aAppState)
+        {
+            lTimer->Cancel();
+            break;
+        }
+    }
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); ++i)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -322,6 +434,7 @@ void Layer::CancelAllMatchingInetTimers(nl::Inet::InetLayer& aInetLayer, void* a
             break;
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 }
 #endif // WEAVE_SYSTEM_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 
@@ -574,6 +687,18 @@ void Layer::PrepareSelect(int& aSetSize, fd_set* aReadSet, fd_set* aWriteSet, fd
     const Timer::Epoch kCurrentEpoch = Timer::GetCurrentEpoch();
     Timer::Epoch lAwakenEpoch = kCurrentEpoch + static_cast<Timer::Epoch>(aSleepTime.tv_sec) * 1000 + aSleepTime.tv_usec / 1000;
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    Timer::Epoch lNextEpoch;
+
+    if (this->mTimerWheel.HasWork())
+    {
+        lAwakenEpoch = kCurrentEpoch;
+    }
+    else if (this->mTimerWheel.GetNextEvent(lNextEpoch) && lNextEpoch < lAwakenEpoch)
+    {
+        lAwakenEpoch = (lNextEpoch < kCurrentEpoch) ? kCurrentEpoch : lNextEpoch;
+    }
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); i++)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -586,10 +711,11 @@ void Layer::PrepareSelect(int& aSetSize, fd_set* aReadSet, fd_set* aWriteSet, fd
                 break;
             }
 
-            if (Timer::IsEarlierEpoch(lTimer->mAwakenEpoch, lAwakenEpoch))
-                lAwakenEpoch = lTimer->mAwakenEpoch;
+            if (Timer::IsEarlierEpoch(lTimer->DeadlineEpoch(), lAwakenEpoch))
+                lAwakenEpoch = lTimer->DeadlineEpoch();
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
     const Timer::Epoch kSleepTime = lAwakenEpoch - kCurrentEpoch;
     aSleepTime.tv_sec = kSleepTime / 1000;
@@ -632,6 +758,16 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
         // If we woke because of someone writing to the wake pipe, clear the contents of the pipe before returning.
         if (FD_ISSET(this->mWakePipeIn, aReadSet))
         {
+            // Allow the next WakeSelect() to write again. This is a full barrier, so any work posted before a wake that was
+            // coalesced into the pending one is visible to the dispatch below.
+            __sync_fetch_and_and(&this->mWakePending, 0);
+
+#if HAVE_SYS_EVENTFD_H && HAVE_EVENTFD
+            // A single read resets the event counter.
+            uint64_t lCount;
+            const ssize_t kIOResult = ::read(this->mWakePipeIn, &lCount, sizeof(lCount));
+            static_cast<void>(kIOResult);
+#else // !(HAVE_SYS_EVENTFD_H && HAVE_EVENTFD)
             while (true)
             {
                 uint8_t lBytes[128];
@@ -639,6 +775,7 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
                 if (lTmp < static_cast<int>(sizeof(lBytes)))
                     break;
             }
+#endif // !(HAVE_SYS_EVENTFD_H && HAVE_EVENTFD)
         }
     }
 
@@ -648,6 +785,10 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
     this->mHandleSelectThread = lThreadSelf;
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    this->mTimerWheel.HandleExpiredTimers(kCurrentEpoch, WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_MAX_EXPIRIES);
+    this->mTimerWheel.HandleWork();
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     for (size_t i = 0; i < Timer::sPool.Size(); i++)
     {
         Timer* lTimer = Timer::sPool.Get(*this, i);
@@ -657,6 +798,7 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
             lTimer->HandleComplete();
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     this->mHandleSelectThread = PTHREAD_NULL;
@@ -670,6 +812,9 @@ void Layer::HandleSelectResult(int aSetSize, fd_set* aReadSet, fd_set* aWriteSet
  *      If @p WakeSelect() is being called from within @p HandleSelectResult(), then writing to the wake pipe can be skipped, since
  *      the I/O thread is already awake.
  *
+ *      Wakes are coalesced: once the wake pipe has been written, further calls return without a system call until
+ *      @p HandleSelectResult() drains it. Many threads scheduling work in a burst therefore cost the I/O thread one wake.
+ *
  *      Furthermore, we don't care if this write fails as the only reasonably likely failure is that the pipe is full, in which
  *      case the select calling thread is going to wake up anyway.
  */
@@ -685,9 +830,19 @@ void Layer::WakeSelect()
     }
 #endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 
+    // A wake is already pending; the I/O thread will see everything posted up to this point.
+    if (__sync_fetch_and_or(&this->mWakePending, 1) != 0)
+        return;
+
+#if HAVE_SYS_EVENTFD_H && HAVE_EVENTFD
+    // Increment the event counter to wake up the select call.
+    const uint64_t kCount = 1;
+    const ssize_t kIOResult = ::write(this->mWakePipeOut, &kCount, sizeof(kCount));
+#else // !(HAVE_SYS_EVENTFD_H && HAVE_EVENTFD)
     // Write a single byte to the wake pipe to wake up the select call.
     const uint8_t kByte = 0;
     const ssize_t kIOResult = ::write(this->mWakePipeOut, &kByte, 1);
+#endif // !(HAVE_SYS_EVENTFD_H && HAVE_EVENTFD)
     static_cast<void>(kIOResult);
 }
 
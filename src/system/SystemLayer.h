@@ -44,6 +44,10 @@
 #include <SystemLayer/SystemObject.h>
 #include <SystemLayer/SystemEvent.h>
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+#include <SystemLayer/SystemTimer.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 #if WEAVE_SYSTEM_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 
 namespace nl {
@@ -151,6 +155,7 @@ public:
 
     typedef void (*TimerCompleteFunct)(Layer* aLayer, void* aAppState, Error aError);
     Error StartTimer(uint32_t aMilliseconds, TimerCompleteFunct aComplete, void* aAppState);
+    Error StartTimer(uint32_t aMilliseconds, uint32_t aToleranceMilliseconds, TimerCompleteFunct aComplete, void* aAppState);
     void CancelTimer(TimerCompleteFunct aOnComplete, void* aAppState);
 
     Error ScheduleWork(TimerCompleteFunct aComplete, void* aAppState);
@@ -191,13 +196,20 @@ private:
     static LwIPEventHandlerDelegate sSystemEventHandlerDelegate;
 
     const LwIPEventHandlerDelegate* mEventDelegateList;
+#if !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     Timer* mTimerList;
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     bool mTimerComplete;
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    TimerWheel mTimerWheel;
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     int mWakePipeIn;
     int mWakePipeOut;
+    volatile int mWakePending;
 
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     pthread_t mHandleSelectThread;
@@ -53,6 +53,11 @@ NL_DLL_EXPORT void Object::Release(void)
     {
         this->mSystemLayer = NULL;
         __sync_synchronize();
+
+#if WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+        // Only now that the object is free can the pool hand out its slot again.
+        __sync_fetch_and_and(this->mPoolUsageWord, ~this->mPoolUsageBit);
+#endif // WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
     }
     else if (oldCount == 0)
     {
@@ -104,6 +104,11 @@ private:
     Layer* volatile mSystemLayer;   /**< Pointer to the layer object that owns this object. */
     unsigned int mRefCount;         /**< Count of remaining calls to Release before object is dead. */
 
+#if WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+    volatile uint32_t* mPoolUsageWord;  /**< The word of the pool bitmap that holds the bit for this object's slot. */
+    uint32_t mPoolUsageBit;             /**< The bit for this object's slot in \c mPoolUsageWord. */
+#endif // WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+
     /** If not already retained, attempt initial retention of this object for \c aLayer and zero up to \c aOctets. */
     bool TryCreate(Layer& aLayer, size_t aOctets);
 
@@ -189,6 +194,19 @@ private:
 
     ObjectArena<void*, N * sizeof(T)> mArena;
 
+#if WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+    enum
+    {
+        kUsageWordBits  = 32,
+        kNumUsageWords  = (N + kUsageWordBits - 1) / kUsageWordBits
+    };
+
+    static uint32_t UsageWordMask(unsigned int aWord);
+
+    /* A set bit marks a retained slot, so that a zeroed pool is empty. */
+    volatile uint32_t mUsage[kNumUsageWords];
+#endif // WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+
 #if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
     void GetNumObjectsInUse(unsigned int aStartIndex, unsigned int& aNumInUse);
     void UpdateHighWatermark(const unsigned int& aCandidate);
@@ -223,6 +241,20 @@ inline T* ObjectPool<T, N>::Get(const Layer& aLayer, size_t aIndex)
     return (lReturn != NULL) && lReturn->IsRetained(aLayer) ? lReturn : NULL;
 }
 
+#if WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+/**
+ *  @brief
+ *      Returns the mask of the bits in usage word \c aWord that correspond to slots in the pool.
+ */
+template<class T, unsigned int N>
+inline uint32_t ObjectPool<T, N>::UsageWordMask(unsigned int aWord)
+{
+    const unsigned int kNumSlots = N - aWord * kUsageWordBits;
+
+    return (kNumSlots >= kUsageWordBits) ? ~static_cast<uint32_t>(0) : ((static_cast<uint32_t>(1) << kNumSlots) - 1);
+}
+#endif // WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+
 /**
  *  @brief
  *      Tries to initially retain the first object in the pool that is not retained by any layer.
@@ -236,6 +268,34 @@ inline T* ObjectPool<T, N>::TryCreate(Layer& aLayer)
     unsigned int lNumInUse = 0;
 #endif
 
+#if WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
+    for (unsigned int lWord = 0; lReturn == NULL && lWord < kNumUsageWords; ++lWord)
+    {
+        uint32_t lUsage, lFree;
+
+        while (lReturn == NULL && (lFree = ~(lUsage = mUsage[lWord]) & UsageWordMask(lWord)) != 0)
+        {
+            const uint32_t lBit = lFree & (0 - lFree);
+
+            // Claim the lowest free slot in this word; on contention, reread the word.
+            if (!__sync_bool_compare_and_swap(&mUsage[lWord], lUsage, lUsage | lBit))
+                continue;
+
+            lIndex = lWord * kUsageWordBits + static_cast<unsigned int>(__builtin_ctz(lFree));
+
+            T& lObject = reinterpret_cast<T*>(mArena.uMemory)[lIndex];
+
+            // The bit is cleared only after the object is released, so this fails only if the bitmap was reset under a retained
+            // object. Leave the bit set, since the slot is in use, and move on.
+            if (lObject.TryCreate(aLayer, sizeof(T)))
+            {
+                lObject.mPoolUsageWord = &mUsage[lWord];
+                lObject.mPoolUsageBit = lBit;
+                lReturn = &lObject;
+            }
+        }
+    }
+#else // !WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
     for (lIndex = 0; lIndex < N; ++lIndex)
     {
         T& lObject = reinterpret_cast<T*>(mArena.uMemory)[lIndex];
@@ -247,6 +307,7 @@ inline T* ObjectPool<T, N>::TryCreate(Layer& aLayer)
             break;
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_OBJECT_POOL_BITMAP
 
 #if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
     if (lReturn != NULL)
@@ -67,7 +67,33 @@ namespace System {
 
 static BufferPoolElement sBufferPool[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC];
 
-PacketBuffer* PacketBuffer::sFreeList = PacketBuffer::BuildFreeList();
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+static SmallBufferPoolElement sSmallBufferPool[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC];
+static MediumBufferPoolElement sMediumBufferPool[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC];
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+PacketBuffer::FreeList PacketBuffer::sFreeList = PacketBuffer::MakeFreeList(PacketBuffer::BuildFreeList(), sBufferPool[0].Block,
+    sizeof(sBufferPool[0]));
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+PacketBuffer::FreeList PacketBuffer::sSmallFreeList = PacketBuffer::MakeFreeList(PacketBuffer::BuildFreeList(sSmallBufferPool[0].Block,
+    sizeof(sSmallBufferPool[0]), WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC, WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY),
+    sSmallBufferPool[0].Block, sizeof(sSmallBufferPool[0]));
+PacketBuffer::FreeList PacketBuffer::sMediumFreeList = PacketBuffer::MakeFreeList(PacketBuffer::BuildFreeList(sMediumBufferPool[0].Block,
+    sizeof(sMediumBufferPool[0]), WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC, WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY),
+    sMediumBufferPool[0].Block, sizeof(sMediumBufferPool[0]));
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+
+#else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+PacketBuffer::FreeList PacketBuffer::sFreeList = PacketBuffer::BuildFreeList();
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+PacketBuffer::FreeList PacketBuffer::sSmallFreeList = PacketBuffer::BuildFreeList(sSmallBufferPool[0].Block,
+    sizeof(sSmallBufferPool[0]), WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC, WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY);
+PacketBuffer::FreeList PacketBuffer::sMediumFreeList = PacketBuffer::BuildFreeList(sMediumBufferPool[0].Block,
+    sizeof(sMediumBufferPool[0]), WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_MAXALLOC, WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY);
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
 
 #if !WEAVE_SYSTEM_CONFIG_NO_LOCKING
 static Mutex sBufferPoolMutex;
@@ -75,6 +101,7 @@ static Mutex sBufferPoolMutex;
 #define LOCK_BUF_POOL()     do { sBufferPoolMutex.Lock(); } while (0)
 #define UNLOCK_BUF_POOL()   do { sBufferPoolMutex.Unlock(); } while (0)
 #endif // !WEAVE_SYSTEM_CONFIG_NO_LOCKING
+#endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
 
 #endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
@@ -301,6 +328,57 @@ void PacketBuffer::CompactHead()
     }
 }
 
+/**
+ * Move just enough data from subsequent buffers in the chain into the current buffer for it to hold the first \c aLength bytes of
+ * the chain contiguously, in the manner of the BSD \c m_pullup function.
+ *
+ *  Unlike CompactHead(), only the bytes needed are moved, and the data within the current buffer is moved to the front of the
+ *  buffer only if the space after it is too small. If a subsequent buffer in the chain is moved into the current buffer in its
+ *  entirety, it is removed from the chain and freed. Nothing is moved if the chain or the current buffer is too short.
+ *
+ *  @param[in] aLength  The number of bytes needed in the current buffer.
+ *
+ *  @return \c true if the current buffer holds at least \c aLength bytes on return, otherwise \c false.
+ */
+bool PacketBuffer::PullUp(uint16_t aLength)
+{
+    uint8_t* const kStart = reinterpret_cast<uint8_t*>(this) + WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE;
+
+    if (this->len >= aLength)
+        return true;
+
+    if (this->tot_len < aLength || this->AllocSize() < aLength)
+        return false;
+
+    if (this->MaxDataLength() < aLength)
+    {
+        memmove(kStart, this->payload, this->len);
+        this->payload = kStart;
+    }
+
+    while (this->len < aLength)
+    {
+        PacketBuffer& lNextPacket = *static_cast<PacketBuffer*>(this->next);
+        VerifyOrDieWithMsg(lNextPacket.ref == 1, WeaveSystemLayer, "next buffer %p is not exclusive to this chain", &lNextPacket);
+
+        uint16_t lMoveLength = lNextPacket.len;
+        if (lMoveLength > aLength - this->len)
+            lMoveLength = aLength - this->len;
+
+        memcpy(static_cast<uint8_t*>(this->payload) + this->len, lNextPacket.payload, lMoveLength);
+
+        lNextPacket.payload = (uint8_t *) lNextPacket.payload + lMoveLength;
+        this->len += lMoveLength;
+        lNextPacket.len -= lMoveLength;
+        lNextPacket.tot_len -= lMoveLength;
+
+        if (lNextPacket.len == 0)
+            this->next = this->FreeHead(&lNextPacket);
+    }
+
+    return true;
+}
+
 /**
  * Adjust the current buffer to indicate the amount of data consumed.
  *
@@ -419,11 +497,13 @@ void PacketBuffer::AddRef()
 {
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
     pbuf_ref(this);
-#else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+#elif WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+    __sync_fetch_and_add(&this->ref, 1);
+#else // !WEAVE_SYSTEM_CONFIG_USE_LWIP && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
     LOCK_BUF_POOL();
     ++this->ref;
     UNLOCK_BUF_POOL();
-#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+#endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
 }
 
 /**
@@ -458,16 +538,7 @@ PacketBuffer* PacketBuffer::NewWithAvailableSize(uint16_t aReservedSize, size_t
 #else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
-    LOCK_BUF_POOL();
-
-    lPacket = sFreeList;
-    if (lPacket != NULL)
-    {
-        sFreeList = static_cast<PacketBuffer*>(lPacket->next);
-        SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
-    }
-
-    UNLOCK_BUF_POOL();
+    lPacket = PacketBuffer::PopFreeList(lAllocSize, WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX + 1);
 
 #else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
@@ -492,6 +563,10 @@ PacketBuffer* PacketBuffer::NewWithAvailableSize(uint16_t aReservedSize, size_t
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
     lPacket->alloc_size = lAllocSize;
 #endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+    lPacket->owner = Stats::GetPacketBufferOwner();
+    Stats::CountPacketBufferAlloc(lPacket->owner);
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
 
     return lPacket;
 }
@@ -579,14 +654,24 @@ void PacketBuffer::Free(PacketBuffer* aPacket)
 
         VerifyOrDieWithMsg(aPacket->ref > 0, WeaveSystemLayer, "SystemPacketBuffer::Free: aPacket->ref = 0");
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+        if (__sync_sub_and_fetch(&aPacket->ref, 1) == 0)
+#else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
         aPacket->ref--;
         if (aPacket->ref == 0)
+#endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
         {
             SYSTEM_STATS_DECREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+            Stats::CountPacketBufferFree(aPacket->owner);
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
             aPacket->Clear();
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-            aPacket->next = sFreeList;
-            sFreeList = aPacket;
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+            PacketBuffer::Push(PacketBuffer::FreeListFor(aPacket->alloc_size), aPacket);
+#else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+            PacketBuffer::Push(sFreeList, aPacket);
+#endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
 #else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
             free(aPacket);
 #endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
@@ -638,7 +723,9 @@ PacketBuffer* PacketBuffer::FreeHead(PacketBuffer* aPacket)
 
 /**
  * Copy the given buffer to a right-sized buffer if applicable.
- * This function is a no-op for sockets.
+ *
+ * On sockets platforms, this is a no-op unless #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES is asserted, in which case an
+ * unchained, unshared buffer whose reserved space and data fit a smaller size class is copied into a buffer of that class.
  *
  *  @param[in] aPacket - buffer or buffer chain.
  *
@@ -655,6 +742,30 @@ PacketBuffer* PacketBuffer::RightSize(PacketBuffer *aPacket)
 
         WeaveLogProgress(WeaveSystemLayer, "PacketBuffer: RightSize Copied");
     }
+#elif !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    VerifyOrExit(aPacket != NULL && aPacket->next == NULL && aPacket->ref == 1, );
+
+    {
+        const uint16_t lReservedSize = aPacket->ReservedSize();
+        const size_t lUsedSize = static_cast<size_t>(lReservedSize) + aPacket->len;
+
+        lNewPacket = PacketBuffer::PopFreeList(lUsedSize, aPacket->alloc_size);
+        VerifyOrExit(lNewPacket != NULL, lNewPacket = aPacket);
+
+        lNewPacket->payload = reinterpret_cast<uint8_t*>(lNewPacket) + WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE + lReservedSize;
+        memcpy(lNewPacket->payload, aPacket->payload, aPacket->len);
+        lNewPacket->len = lNewPacket->tot_len = aPacket->len;
+        lNewPacket->next = NULL;
+        lNewPacket->ref = 1;
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+        lNewPacket->owner = aPacket->owner;
+        Stats::CountPacketBufferAlloc(lNewPacket->owner);
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+
+        PacketBuffer::Free(aPacket);
+    }
+
+exit:
 #endif
     return lNewPacket;
 }
@@ -663,6 +774,10 @@ PacketBuffer* PacketBuffer::RightSize(PacketBuffer *aPacket)
 
 PacketBuffer* PacketBuffer::BuildFreeList()
 {
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    PacketBuffer* lHead = PacketBuffer::BuildFreeList(sBufferPool[0].Block, sizeof(sBufferPool[0]),
+        WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC, sizeof(sBufferPool[0].Block) - WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE);
+#else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
     PacketBuffer* lHead = NULL;
 
     for (int i = 0; i < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC; i++)
@@ -672,12 +787,219 @@ PacketBuffer* PacketBuffer::BuildFreeList()
         lCursor->ref = 0;
         lHead = lCursor;
     }
+#endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
 
+#if !WEAVE_SYSTEM_CONFIG_NO_LOCKING && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
     Mutex::Init(sBufferPoolMutex);
+#endif // !WEAVE_SYSTEM_CONFIG_NO_LOCKING && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
 
     return lHead;
 }
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+/**
+ * Build the free list of a size class from an array of pool elements.
+ *
+ *  @param[in] aBlocks      The first pool element.
+ *  @param[in] aBlockStride The size of a pool element.
+ *  @param[in] aNumBlocks   The number of pool elements.
+ *  @param[in] aAllocSize   The capacity of the buffers, excluding the PacketBuffer structure.
+ *
+ *  @return the head of the free list.
+ */
+PacketBuffer* PacketBuffer::BuildFreeList(uint8_t* aBlocks, size_t aBlockStride, size_t aNumBlocks, uint16_t aAllocSize)
+{
+    PacketBuffer* lHead = NULL;
+
+    for (size_t i = 0; i < aNumBlocks; i++)
+    {
+        PacketBuffer* lCursor = reinterpret_cast<PacketBuffer*>(aBlocks + i * aBlockStride);
+        lCursor->next = lHead;
+        lCursor->ref = 0;
+        lCursor->alloc_size = aAllocSize;
+        lHead = lCursor;
+    }
+
+    return lHead;
+}
+
+/**
+ * Return the free list of the size class with the given capacity.
+ */
+PacketBuffer::FreeList& PacketBuffer::FreeListFor(size_t aAllocSize)
+{
+    if (aAllocSize == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY)
+        return sSmallFreeList;
+
+    if (aAllocSize == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY)
+        return sMediumFreeList;
+
+    return sFreeList;
+}
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+
+/**
+ * Take a buffer from the pool.
+ *
+ *  With #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES, the buffer comes from the smallest size class that has a capacity of at
+ *  least \c aAllocSize and less than \c aSizeLimit, and that is not exhausted.
+ *
+ *  @param[in] aAllocSize   The number of octets needed, including the reserved space.
+ *  @param[in] aSizeLimit   The exclusive upper bound on the capacity of the buffer.
+ *
+ *  @return a pointer to the buffer, or \c NULL if none is available.
+ */
+PacketBuffer* PacketBuffer::PopFreeList(size_t aAllocSize, size_t aSizeLimit)
+{
+    PacketBuffer* lPacket = NULL;
+
+    LOCK_BUF_POOL();
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    if (aAllocSize <= WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY < aSizeLimit)
+    {
+        lPacket = PacketBuffer::Pop(sSmallFreeList);
+    }
+
+    if (lPacket == NULL && aAllocSize <= WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY &&
+        WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY < aSizeLimit)
+    {
+        lPacket = PacketBuffer::Pop(sMediumFreeList);
+    }
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+
+    if (lPacket == NULL && aAllocSize <= WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX &&
+        WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX < aSizeLimit)
+    {
+        lPacket = PacketBuffer::Pop(sFreeList);
+    }
+
+    if (lPacket != NULL)
+    {
+        SYSTEM_STATS_INCREMENT(nl::Weave::System::Stats::kSystemLayer_NumPacketBufs);
+    }
+
+    UNLOCK_BUF_POOL();
+
+    return lPacket;
+}
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+/**
+ * Return the free list index of a buffer, i.e. its position in the pool plus one, or 0 for \c NULL.
+ */
+uint32_t PacketBuffer::FreeList::IndexOf(const PacketBuffer* aPacket) const
+{
+    if (aPacket == NULL)
+        return 0;
+
+    return static_cast<uint32_t>((reinterpret_cast<const uint8_t*>(aPacket) - this->mBase) / this->mStride) + 1;
+}
+
+/**
+ * Return the buffer at the given free list index, or \c NULL for index 0.
+ */
+PacketBuffer* PacketBuffer::FreeList::AtIndex(uint32_t aIndex) const
+{
+    if (aIndex == 0)
+        return NULL;
+
+    return reinterpret_cast<PacketBuffer*>(this->mBase + (aIndex - 1) * this->mStride);
+}
+
+/**
+ * Make a lock-free free list from a linked list of buffers taken from a pool.
+ *
+ *  @param[in] aHead        The head of the linked list.
+ *  @param[in] aBlocks      The first pool element.
+ *  @param[in] aBlockStride The size of a pool element.
+ */
+PacketBuffer::FreeList PacketBuffer::MakeFreeList(PacketBuffer* aHead, uint8_t* aBlocks, size_t aBlockStride)
+{
+    FreeList lFreeList;
+
+    lFreeList.mBase = aBlocks;
+    lFreeList.mStride = aBlockStride;
+    lFreeList.mHead = lFreeList.IndexOf(aHead);
+
+    return lFreeList;
+}
+
+/**
+ * Pop a buffer from a free list.
+ *
+ *  The head is replaced with a single compare-and-swap. Each successful update also advances the generation tag in the head, so a
+ *  thread that read a head which was popped and pushed back in the meantime fails its compare-and-swap and retries.
+ *
+ *  @return the buffer, or \c NULL if the free list is empty.
+ */
+PacketBuffer* PacketBuffer::Pop(FreeList& aFreeList)
+{
+    uint64_t lHead;
+    uint64_t lNewHead;
+    PacketBuffer* lPacket;
+
+    do
+    {
+        lHead = aFreeList.mHead;
+        lPacket = aFreeList.AtIndex(static_cast<uint32_t>(lHead));
+
+        if (lPacket == NULL)
+            break;
+
+        lNewHead = (((lHead >> 32) + 1) << 32) | aFreeList.IndexOf(static_cast<PacketBuffer*>(lPacket->next));
+    }
+    while (!__sync_bool_compare_and_swap(&aFreeList.mHead, lHead, lNewHead));
+
+    return lPacket;
+}
+
+/**
+ * Push a buffer onto a free list. See PacketBuffer::Pop().
+ */
+void PacketBuffer::Push(FreeList& aFreeList, PacketBuffer* aPacket)
+{
+    const uint64_t lIndex = aFreeList.IndexOf(aPacket);
+    uint64_t lHead;
+    uint64_t lNewHead;
+
+    do
+    {
+        lHead = aFreeList.mHead;
+        aPacket->next = aFreeList.AtIndex(static_cast<uint32_t>(lHead));
+        lNewHead = (((lHead >> 32) + 1) << 32) | lIndex;
+    }
+    while (!__sync_bool_compare_and_swap(&aFreeList.mHead, lHead, lNewHead));
+}
+
+#else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+/**
+ * Pop a buffer from a free list. The caller holds the buffer pool lock.
+ *
+ *  @return the buffer, or \c NULL if the free list is empty.
+ */
+PacketBuffer* PacketBuffer::Pop(FreeList& aFreeList)
+{
+    PacketBuffer* lPacket = aFreeList;
+
+    if (lPacket != NULL)
+    {
+        aFreeList = static_cast<PacketBuffer*>(lPacket->next);
+    }
+
+    return lPacket;
+}
+
+/**
+ * Push a buffer onto a free list. The caller holds the buffer pool lock.
+ */
+void PacketBuffer::Push(FreeList& aFreeList, PacketBuffer* aPacket)
+{
+    aPacket->next = aFreeList;
+    aFreeList = aPacket;
+}
+#endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+
 #endif //  !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
 } // namespace System
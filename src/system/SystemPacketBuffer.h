@@ -55,9 +55,12 @@ struct pbuf
     uint16_t tot_len;
     uint16_t len;
     uint16_t ref;
-#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0 || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
     uint16_t alloc_size;
-#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0 || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+    uint8_t owner;
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
 };
 #endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
 
@@ -115,6 +118,7 @@ public:
     void AddToEnd(PacketBuffer* aPacket);
     PacketBuffer* DetachTail(void);
     void CompactHead(void);
+    bool PullUp(uint16_t aLength);
     PacketBuffer* Consume(uint16_t aConsumeLength);
     void ConsumeHead(uint16_t aConsumeLength);
     bool EnsureReservedSize(uint16_t aReservedSize);
@@ -135,9 +139,36 @@ public:
 
 private:
 #if !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
-    static PacketBuffer* sFreeList;
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+    struct FreeList
+    {
+        volatile uint64_t mHead; // generation tag in the upper 32 bits, index of the top buffer plus one in the lower 32 bits
+        uint8_t* mBase;
+        size_t mStride;
+
+        uint32_t IndexOf(const PacketBuffer* aPacket) const;
+        PacketBuffer* AtIndex(uint32_t aIndex) const;
+    };
+#else // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+    typedef PacketBuffer* FreeList;
+#endif // !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+
+    static FreeList sFreeList;
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    static FreeList sSmallFreeList;
+    static FreeList sMediumFreeList;
+
+    static PacketBuffer* BuildFreeList(uint8_t* aBlocks, size_t aBlockStride, size_t aNumBlocks, uint16_t aAllocSize);
+    static FreeList& FreeListFor(size_t aAllocSize);
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
 
     static PacketBuffer* BuildFreeList(void);
+    static PacketBuffer* PopFreeList(size_t aAllocSize, size_t aSizeLimit);
+    static PacketBuffer* Pop(FreeList& aFreeList);
+    static void Push(FreeList& aFreeList, PacketBuffer* aPacket);
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
+    static FreeList MakeFreeList(PacketBuffer* aHead, uint8_t* aBlocks, size_t aBlockStride);
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL
 #endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
     void Clear(void);
@@ -202,6 +233,20 @@ typedef union
     uint8_t Block[WEAVE_SYSTEM_PACKETBUFFER_SIZE];
 } BufferPoolElement;
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+typedef union
+{
+    PacketBuffer Header;
+    uint8_t Block[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY + WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE];
+} SmallBufferPoolElement;
+
+typedef union
+{
+    PacketBuffer Header;
+    uint8_t Block[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY + WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE];
+} MediumBufferPoolElement;
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+
 #endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP && WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC
 
 /**
@@ -225,12 +270,12 @@ inline size_t PacketBuffer::AllocSize(void) const
     return LWIP_MEM_ALIGN_SIZE(PBUF_POOL_BUFSIZE) - WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE;
 #endif // !LWIP_PBUF_FROM_CUSTOM_POOLS
 #else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
-#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0 || WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
     return static_cast<size_t>(this->alloc_size);
-#else // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
+#else // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0 && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
     extern BufferPoolElement gDummyBufferPoolElement;
     return sizeof(gDummyBufferPoolElement.Block) - WEAVE_SYSTEM_PACKETBUFFER_HEADER_SIZE;
-#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC != 0 && !WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
 #endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
 }
 
@@ -66,6 +66,9 @@ static const Label sStatsStrings[nl::Weave::System::Stats::kNumEntries] =
     "ExchangeMgr_NumContextsInUse",
     "ExchangeMgr_NumUMHandlersInUse",
     "ExchangeMgr_NumBindings",
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    "ExchangeMgr_NumRetransEntriesInUse",
+#endif
     "MessageLayer_NumConnectionsInUse",
 #if WEAVE_CONFIG_ENABLE_SERVICE_DIRECTORY
     "ServiceMgr_NumRequestsInUse",
@@ -97,9 +100,25 @@ static const Label sStatsStrings[nl::Weave::System::Stats::kNumEntries] =
 
 };
 
+static const Label sPacketBufferOwnerStrings[kNumPacketBufferOwners] =
+{
+    "Other",
+    "InetLayer",
+    "MessageLayer",
+    "ExchangeMgr",
+    "Security",
+    "WDM",
+};
+
 count_t sResourcesInUse[kNumEntries];
 count_t sHighWatermarks[kNumEntries];
 
+static uint16_t sCapacities[kNumEntries];
+
+static uint8_t sPacketBufferOwner = kPacketBufferOwner_Other;
+static count_t sPacketBuffersInUse[kNumPacketBufferOwners];
+static count_t sPacketBufferHighWatermarks[kNumPacketBufferOwners];
+
 const Label *GetStrings(void)
 {
     return sStatsStrings;
@@ -115,6 +134,94 @@ count_t *GetHighWatermarks(void)
     return sHighWatermarks;
 }
 
+/**
+ * Records the number of objects statically provisioned for a resource, so
+ * that its high watermark can be compared against it.
+ *
+ * @param[in] aEntry        The resource, one of the entries below kNumEntries.
+ * @param[in] aCapacity     The size of the resource's pool, or 0 if it is unbounded.
+ */
+void SetCapacity(unsigned int aEntry, uint16_t aCapacity)
+{
+    if (aEntry < kNumEntries)
+    {
+        sCapacities[aEntry] = aCapacity;
+    }
+}
+
+/**
+ * Returns the pool sizes recorded by SetCapacity(), indexed like GetStrings().
+ */
+const uint16_t *GetCapacities(void)
+{
+    return sCapacities;
+}
+
+const Label *GetPacketBufferOwnerStrings(void)
+{
+    return sPacketBufferOwnerStrings;
+}
+
+/**
+ * Returns the owner to which packet buffers allocated now are attributed.
+ */
+uint8_t GetPacketBufferOwner(void)
+{
+    return sPacketBufferOwner;
+}
+
+/**
+ * Sets the owner to which packet buffers allocated from now on are attributed.
+ *
+ * Most code should use PacketBufferOwnerScope instead.
+ */
+void SetPacketBufferOwner(uint8_t aOwner)
+{
+    sPacketBufferOwner = (aOwner < kNumPacketBufferOwners) ? aOwner : static_cast<uint8_t>(kPacketBufferOwner_Other);
+}
+
+void CountPacketBufferAlloc(uint8_t aOwner)
+{
+    count_t new_value = ++sPacketBuffersInUse[aOwner];
+
+    if (sPacketBufferHighWatermarks[aOwner] < new_value)
+    {
+        sPacketBufferHighWatermarks[aOwner] = new_value;
+    }
+}
+
+void CountPacketBufferFree(uint8_t aOwner)
+{
+    sPacketBuffersInUse[aOwner]--;
+}
+
+/**
+ * Returns the number of packet buffers in use by each owner, indexed by PacketBufferOwner.
+ */
+const count_t *GetPacketBuffersInUse(void)
+{
+    return sPacketBuffersInUse;
+}
+
+/**
+ * Returns the largest number of packet buffers used at once by each owner, indexed by PacketBufferOwner.
+ */
+const count_t *GetPacketBufferHighWatermarks(void)
+{
+    return sPacketBufferHighWatermarks;
+}
+
+PacketBufferOwnerScope::PacketBufferOwnerScope(PacketBufferOwner aOwner) :
+    mPrevOwner(GetPacketBufferOwner())
+{
+    SetPacketBufferOwner(aOwner);
+}
+
+PacketBufferOwnerScope::~PacketBufferOwnerScope(void)
+{
+    SetPacketBufferOwner(mPrevOwner);
+}
+
 void UpdateSnapshot(Snapshot &aSnapshot)
 {
     memcpy(&aSnapshot.mResourcesInUse, &sResourcesInUse, sizeof(aSnapshot.mResourcesInUse));
@@ -145,6 +252,36 @@ bool Difference(Snapshot &result, Snapshot &after, Snapshot &before)
     return leak;
 }
 
+/**
+ * Writes a table of the resources in use, their high watermarks and their
+ * capacities, followed by the packet buffers in use by each owner if
+ * #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS is enabled.
+ *
+ * A capacity of 0 means the resource is unbounded or its size was not
+ * recorded.
+ *
+ * @param[in] aSnapshot     The resource counts to write, see UpdateSnapshot().
+ * @param[in] aWriter       The function to which each line is written.
+ */
+void Dump(const Snapshot &aSnapshot, DumpWriter aWriter)
+{
+    aWriter("%-40s %6s %6s %6s\n", "Resource", "InUse", "Max", "Cap");
+
+    for (int i = 0; i < kNumEntries; i++)
+    {
+        aWriter("%-40s %6d %6d %6u\n", sStatsStrings[i], aSnapshot.mResourcesInUse[i], aSnapshot.mHighWatermarks[i],
+                sCapacities[i]);
+    }
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+    for (int i = 0; i < kNumPacketBufferOwners; i++)
+    {
+        aWriter("PacketBufs_%-29s %6d %6d\n", sPacketBufferOwnerStrings[i], sPacketBuffersInUse[i],
+                sPacketBufferHighWatermarks[i]);
+    }
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+}
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 void UpdateLwipPbufCounts(void)
 {
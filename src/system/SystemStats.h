@@ -75,6 +75,9 @@ enum
     kExchangeMgr_NumContexts,
     kExchangeMgr_NumUMHandlers,
     kExchangeMgr_NumBindings,
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    kExchangeMgr_NumRetransEntries,
+#endif
     kMessageLayer_NumConnections,
 #if WEAVE_CONFIG_ENABLE_SERVICE_DIRECTORY
     kServiceMgr_NumRequests,
@@ -114,6 +117,45 @@ typedef int8_t count_t;
 extern count_t ResourcesInUse[kNumEntries];
 extern count_t HighWatermarks[kNumEntries];
 
+/**
+ * The subsystems to which packet buffers are attributed when
+ * #WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS is enabled.
+ *
+ * A buffer is attributed to the owner that was current when it was
+ * allocated (see PacketBufferOwnerScope), for its whole lifetime.
+ */
+enum PacketBufferOwner
+{
+    kPacketBufferOwner_Other = 0,
+    kPacketBufferOwner_InetLayer,
+    kPacketBufferOwner_MessageLayer,
+    kPacketBufferOwner_ExchangeMgr,
+    kPacketBufferOwner_Security,
+    kPacketBufferOwner_WDM,
+
+    kNumPacketBufferOwners
+};
+
+/**
+ * Attributes the packet buffers allocated during its lifetime to an owner,
+ * restoring the previous owner when it goes out of scope.
+ *
+ * The current owner is global rather than per thread, so on multi-threaded
+ * platforms allocations made concurrently by other threads may be
+ * misattributed; the totals are unaffected.
+ */
+class PacketBufferOwnerScope
+{
+public:
+    explicit PacketBufferOwnerScope(PacketBufferOwner aOwner);
+    ~PacketBufferOwnerScope(void);
+
+private:
+    uint8_t mPrevOwner;
+};
+
+typedef void (*DumpWriter)(const char *aFormat, ...);
+
 class Snapshot
 {
 public:
@@ -127,12 +169,25 @@ void UpdateSnapshot(Snapshot &aSnapshot);
 count_t *GetResourcesInUse(void);
 count_t *GetHighWatermarks(void);
 
+void SetCapacity(unsigned int aEntry, uint16_t aCapacity);
+const uint16_t *GetCapacities(void);
+
+uint8_t GetPacketBufferOwner(void);
+void SetPacketBufferOwner(uint8_t aOwner);
+void CountPacketBufferAlloc(uint8_t aOwner);
+void CountPacketBufferFree(uint8_t aOwner);
+const count_t *GetPacketBuffersInUse(void);
+const count_t *GetPacketBufferHighWatermarks(void);
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 void UpdateLwipPbufCounts(void);
 #endif
 
 typedef const char *Label;
 const Label *GetStrings(void);
+const Label *GetPacketBufferOwnerStrings(void);
+
+void Dump(const Snapshot &aSnapshot, DumpWriter aWriter);
 
 } // namespace Stats
 } // namespace System
@@ -174,6 +229,18 @@ const Label *GetStrings(void);
         nl::Weave::System::Stats::GetResourcesInUse()[entry] = 0; \
     } while (0);
 
+#define SYSTEM_STATS_SET_CAPACITY(entry, capacity) \
+    do { \
+        nl::Weave::System::Stats::SetCapacity((entry), (capacity)); \
+    } while (0);
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+#define SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(owner) \
+    nl::Weave::System::Stats::PacketBufferOwnerScope lPacketBufferOwnerScope(owner)
+#else // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+#define SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(owner) do { } while (0)
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_OWNER_TAGS
+
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP && LWIP_STATS && MEMP_STATS
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS() \
     do { \
@@ -194,6 +261,10 @@ const Label *GetStrings(void);
 
 #define SYSTEM_STATS_RESET(entry)
 
+#define SYSTEM_STATS_SET_CAPACITY(entry, capacity)
+
+#define SYSTEM_STATS_PACKETBUFFER_OWNER_SCOPE(owner) do { } while (0)
+
 #define SYSTEM_STATS_UPDATE_LWIP_PBUF_COUNTS()
 
 #endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
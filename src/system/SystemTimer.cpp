@@ -32,6 +32,10 @@
 // Include local headers
 #include <string.h>
 
+#if WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+#include <stdlib.h>
+#endif // WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+
 #include <SystemLayer/SystemError.h>
 #include <SystemLayer/SystemLayer.h>
 #include <SystemLayer/SystemFaultInjection.h>
@@ -78,6 +82,73 @@ namespace System {
 
 ObjectPool<Timer, WEAVE_SYSTEM_CONFIG_NUM_TIMERS> Timer::sPool;
 
+#if WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+struct Timer::PoolBlock
+{
+    ObjectPool<Timer, WEAVE_SYSTEM_CONFIG_NUM_TIMERS> mPool;
+    PoolBlock* mNext;
+};
+
+Timer::PoolBlock* volatile Timer::sPoolBlocks;
+
+/**
+ *  Tries to initially retain a timer for \c aLayer, first from the static pool and then from the blocks allocated from the heap.
+ *  If every timer is in use, another block is allocated.
+ *
+ *  @return A pointer to the timer, or \c NULL if the heap is exhausted.
+ */
+Timer* Timer::TryCreateFromPool(Layer& aLayer)
+{
+    Timer* lTimer = sPool.TryCreate(aLayer);
+    PoolBlock* lBlock;
+
+    for (lBlock = sPoolBlocks; lTimer == NULL && lBlock != NULL; lBlock = lBlock->mNext)
+    {
+        lTimer = lBlock->mPool.TryCreate(aLayer);
+    }
+
+    VerifyOrExit(lTimer == NULL, );
+
+    // Like the static pool, a block must start out zeroed. Blocks are never returned to the heap.
+    lBlock = static_cast<PoolBlock*>(calloc(1, sizeof(PoolBlock)));
+    VerifyOrExit(lBlock != NULL, );
+
+    lTimer = lBlock->mPool.TryCreate(aLayer);
+
+    do
+    {
+        lBlock->mNext = sPoolBlocks;
+    } while (!__sync_bool_compare_and_swap(&sPoolBlocks, lBlock->mNext, lBlock));
+
+exit:
+    return lTimer;
+}
+
+void Timer::GetStatistics(nl::Weave::System::Stats::count_t& aNumInUse, nl::Weave::System::Stats::count_t& aHighWatermark)
+{
+    sPool.GetStatistics(aNumInUse, aHighWatermark);
+
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    unsigned int lNumInUse = aNumInUse;
+    unsigned int lHighWatermark = aHighWatermark;
+
+    for (PoolBlock* lBlock = sPoolBlocks; lBlock != NULL; lBlock = lBlock->mNext)
+    {
+        nl::Weave::System::Stats::count_t lBlockInUse;
+        nl::Weave::System::Stats::count_t lBlockHighWatermark;
+
+        lBlock->mPool.GetStatistics(lBlockInUse, lBlockHighWatermark);
+        lNumInUse += lBlockInUse;
+        lHighWatermark += lBlockHighWatermark;
+    }
+
+    aNumInUse = static_cast<nl::Weave::System::Stats::count_t>(lNumInUse > WEAVE_SYS_STATS_COUNT_MAX ? WEAVE_SYS_STATS_COUNT_MAX : lNumInUse);
+    aHighWatermark = static_cast<nl::Weave::System::Stats::count_t>(lHighWatermark > WEAVE_SYS_STATS_COUNT_MAX ?
+        WEAVE_SYS_STATS_COUNT_MAX : lHighWatermark);
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+}
+#endif // WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+
 /**
  *  This method returns the current epoch, corrected by system sleep with the system timescale, in milliseconds.
  *
@@ -124,33 +195,72 @@ bool Timer::IsEarlierEpoch(const Timer::Epoch &inFirst, const Timer::Epoch &inSe
  *
  */
 Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, void* aAppState)
+{
+    return this->Start(aDelayMilliseconds, 0, aOnComplete, aAppState);
+}
+
+/**
+ *  This method registers an one-shot timer with the underlying timer mechanism provided by the platform, allowing the timer to
+ *  fire late by up to the given tolerance so that it can be coalesced with other timers.
+ *
+ *  @note
+ *      The tolerance is honored by the sorted timer list used on LwIP-based systems and by the timer pool scan used on
+ *      sockets-based systems. The timer wheel always fires timers at their nominal expiration.
+ *
+ *  @param[in]  aDelayMilliseconds      The number of milliseconds before this timer fires
+ *  @param[in]  aToleranceMilliseconds  The number of milliseconds by which firing may be deferred past @a aDelayMilliseconds
+ *  @param[in]  aOnComplete             A pointer to the callback function when this timer fires
+ *  @param[in]  aAppState               An arbitrary pointer to be passed into onComplete when this timer fires
+ *
+ *  @retval #WEAVE_SYSTEM_NO_ERROR Unconditionally.
+ *
+ */
+Error Timer::Start(uint32_t aDelayMilliseconds, uint32_t aToleranceMilliseconds, OnCompleteFunct aOnComplete, void* aAppState)
 {
     Layer& lLayer = this->SystemLayer();
 
     WEAVE_SYSTEM_FAULT_INJECT(FaultInjection::kFault_TimeoutImmediate, aDelayMilliseconds = 0);
 
+    // Keep the deadline representable as a platform timer delay.
+    if (aToleranceMilliseconds > UINT32_MAX - aDelayMilliseconds)
+    {
+        aToleranceMilliseconds = UINT32_MAX - aDelayMilliseconds;
+    }
+
     this->AppState = aAppState;
     this->mAwakenEpoch = Timer::GetCurrentEpoch() + static_cast<Epoch>(aDelayMilliseconds);
+    this->mToleranceMilliseconds = aToleranceMilliseconds;
     if (!__sync_bool_compare_and_swap(&this->OnComplete, NULL, aOnComplete))
     {
         WeaveDie();
     }
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    Epoch lNextEpoch;
+    const bool lHaveNextEvent = lLayer.mTimerWheel.GetNextEvent(lNextEpoch);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    lLayer.mTimerWheel.Add(*this);
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    // if this is now the earliest event, the platform timer needs (re-)starting, unless HandleExpiredTimers() is running and
+    // will re-start it.
+    if (!lLayer.mTimerComplete && (!lHaveNextEvent || this->mAwakenEpoch < lNextEpoch))
+    {
+        lLayer.StartPlatformTimer(aDelayMilliseconds);
+    }
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+#elif WEAVE_SYSTEM_CONFIG_USE_LWIP
+    Epoch lWakeEpoch;
+    const bool lHaveWakeEpoch = Timer::GetWakeEpoch(lLayer.mTimerList, lWakeEpoch);
+
     // add to the sorted list of timers. Earliest timer appears first.
     if (lLayer.mTimerList == NULL ||
         this->IsEarlierEpoch(this->mAwakenEpoch, lLayer.mTimerList->mAwakenEpoch))
     {
         this->mNextTimer = lLayer.mTimerList;
         lLayer.mTimerList = this;
-
-        // this is the new eariest timer and so the timer needs (re-)starting provided that
-        // the system is not currently processing expired timers, in which case it is left to
-        // HandleExpiredTimers() to re-start the timer.
-        if (!lLayer.mTimerComplete)
-        {
-            lLayer.StartPlatformTimer(aDelayMilliseconds);
-        }
     }
     else
     {
@@ -170,7 +280,14 @@ Error Timer::Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, voi
         this->mNextTimer = lTimer->mNextTimer;
         lTimer->mNextTimer = this;
     }
-#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    // if this timer must fire before the platform timer is due, the platform timer needs (re-)starting provided that the system
+    // is not currently processing expired timers, in which case it is left to HandleExpiredTimers() to re-start the timer.
+    if (!lLayer.mTimerComplete && (!lHaveWakeEpoch || this->IsEarlierEpoch(this->DeadlineEpoch(), lWakeEpoch)))
+    {
+        lLayer.StartPlatformTimer(aDelayMilliseconds + aToleranceMilliseconds);
+    }
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL / WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
     lLayer.WakeSelect();
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
@@ -194,6 +311,9 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void* aAppState)
     err = lLayer.PostEvent(*this, Weave::System::kEvent_ScheduleWork, 0);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 #if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    lLayer.mTimerWheel.PushWork(*this);
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     lLayer.WakeSelect();
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
@@ -207,9 +327,9 @@ Error Timer::ScheduleWork(OnCompleteFunct aOnComplete, void* aAppState)
  */
 Error Timer::Cancel()
 {
-#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     Layer& lLayer = this->SystemLayer();
-#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP || WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     OnCompleteFunct lOnComplete = this->OnComplete;
 
     // Check if the timer is armed
@@ -220,7 +340,9 @@ Error Timer::Cancel()
     // Since this thread changed the state of OnComplete, release the timer.
     this->AppState = NULL;
 
-#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    lLayer.mTimerWheel.Remove(*this);
+#elif WEAVE_SYSTEM_CONFIG_USE_LWIP
     if (lLayer.mTimerList)
     {
         if (this == lLayer.mTimerList)
@@ -245,7 +367,7 @@ Error Timer::Cancel()
 
         this->mNextTimer = NULL;
     }
-#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL / WEAVE_SYSTEM_CONFIG_USE_LWIP
 
     this->Release();
 exit:
@@ -296,6 +418,30 @@ exit:
  */
 Error Timer::HandleExpiredTimers(Layer& aLayer)
 {
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    Epoch currentEpoch = Timer::GetCurrentEpoch();
+    Epoch nextEpoch;
+
+    aLayer.mTimerComplete = true;
+    aLayer.mTimerWheel.HandleExpiredTimers(currentEpoch, WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_MAX_EXPIRIES);
+    aLayer.mTimerComplete = false;
+
+    if (aLayer.mTimerWheel.GetNextEvent(nextEpoch))
+    {
+        // timers still exist so restart the platform timer. The next event of the wheel is always within its span, well below
+        // UINT32_MAX milliseconds away.
+        uint64_t delayMilliseconds = 0ULL;
+
+        currentEpoch = Timer::GetCurrentEpoch();
+
+        if (currentEpoch < nextEpoch)
+        {
+            delayMilliseconds = nextEpoch - currentEpoch;
+        }
+
+        aLayer.StartPlatformTimer(static_cast<uint32_t>(delayMilliseconds));
+    }
+#else // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     size_t timersHandled = 0;
 
     // Expire each timer in turn until an unexpired timer is reached or the timerlist is emptied.  We set the current expiration
@@ -323,15 +469,18 @@ Error Timer::HandleExpiredTimers(Layer& aLayer)
         }
         else
         {
-            // timers still exist so restart the platform timer.
+            // timers still exist so restart the platform timer, for the latest time at which all the timers whose slack
+            // windows overlap the earliest one can be fired together.
             uint64_t delayMilliseconds = 0ULL;
+            Epoch wakeEpoch;
 
+            Timer::GetWakeEpoch(aLayer.mTimerList, wakeEpoch);
             currentEpoch = Timer::GetCurrentEpoch();
 
             // the next timer expires in the future, so set the delayMilliseconds to a non-zero value
-            if (currentEpoch < aLayer.mTimerList->mAwakenEpoch)
+            if (currentEpoch < wakeEpoch)
             {
-                delayMilliseconds = aLayer.mTimerList->mAwakenEpoch - currentEpoch;
+                delayMilliseconds = wakeEpoch - currentEpoch;
             }
             /*
              * StartPlatformTimer() accepts a 32bit value in milliseconds.  Epochs are 64bit numbers.  The only way in which this could
@@ -345,11 +494,475 @@ Error Timer::HandleExpiredTimers(Layer& aLayer)
             break; // all remaining timers are still ticking.
         }
     }
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
     return WEAVE_SYSTEM_NO_ERROR;
 }
+
+#if !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+/**
+ *  Computes the epoch at which the platform timer should next fire for a sorted list of timers.
+ *
+ *  @brief
+ *      This is the earliest deadline (expiration plus tolerance) of any timer in the list. Every timer that has expired by then
+ *      is completed on the same platform timer expiration, so timers with overlapping slack windows are coalesced into a single
+ *      wake-up. Since the list is sorted by expiration, the scan stops at the first timer that expires after the deadline found
+ *      so far.
+ *
+ *  @param[in]  aTimerList  The earliest timer of the list, or NULL.
+ *  @param[out] aWakeEpoch  The epoch at which the platform timer should fire.
+ *
+ *  @return true if the list is not empty, false otherwise.
+ */
+bool Timer::GetWakeEpoch(const Timer* aTimerList, Epoch& aWakeEpoch)
+{
+    VerifyOrExit(aTimerList != NULL, );
+
+    aWakeEpoch = aTimerList->DeadlineEpoch();
+
+    for (const Timer* lTimer = aTimerList->mNextTimer; lTimer != NULL && IsEarlierEpoch(lTimer->mAwakenEpoch, aWakeEpoch);
+         lTimer = lTimer->mNextTimer)
+    {
+        if (IsEarlierEpoch(lTimer->DeadlineEpoch(), aWakeEpoch))
+        {
+            aWakeEpoch = lTimer->DeadlineEpoch();
+        }
+    }
+
+exit:
+    return aTimerList != NULL;
+}
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+/**
+ *  This method empties the wheel and sets the earliest tick not yet expired.
+ *
+ *  @param[in]  aCurrentEpoch   The current epoch, in milliseconds.
+ */
+void TimerWheel::Init(Timer::Epoch aCurrentEpoch)
+{
+    memset(this->mSlots, 0, sizeof(this->mSlots));
+    memset(this->mOccupied, 0, sizeof(this->mOccupied));
+    memset(this->mBuckets, 0, sizeof(this->mBuckets));
+    this->mCurrentTick = aCurrentEpoch;
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    this->mPendingWork = NULL;
+    this->mDispatchingWork = NULL;
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+}
+
+/**
+ *  This method adds an armed timer to the wheel, to expire at its awaken epoch.
+ */
+void TimerWheel::Add(Timer& aTimer)
+{
+    const size_t lBucket = TimerWheel::BucketFor(aTimer.OnComplete, aTimer.AppState);
+
+    aTimer.mMatchBucket = static_cast<uint16_t>(lBucket);
+    aTimer.mMatchPrev = NULL;
+    aTimer.mMatchNext = this->mBuckets[lBucket];
+
+    if (aTimer.mMatchNext != NULL)
+        aTimer.mMatchNext->mMatchPrev = &aTimer;
+
+    this->mBuckets[lBucket] = &aTimer;
+
+    this->Schedule(aTimer);
+}
+
+/**
+ *  This method removes a timer from the wheel. It's harmless if the timer is not in the wheel.
+ */
+void TimerWheel::Remove(Timer& aTimer)
+{
+    VerifyOrExit(aTimer.mWheelSlot != 0, );
+
+    this->UnlinkSlot(aTimer);
+
+    if (aTimer.mMatchPrev != NULL)
+        aTimer.mMatchPrev->mMatchNext = aTimer.mMatchNext;
+    else
+        this->mBuckets[aTimer.mMatchBucket] = aTimer.mMatchNext;
+
+    if (aTimer.mMatchNext != NULL)
+        aTimer.mMatchNext->mMatchPrev = aTimer.mMatchPrev;
+
+    aTimer.mMatchPrev = NULL;
+    aTimer.mMatchNext = NULL;
+
+exit:
+    return;
+}
+
+/**
+ *  This method looks up an armed timer, or a pending scheduled work item, by its completion function and application state.
+ *
+ *  @return A pointer to the first matching timer, or \c NULL if there is none.
+ */
+Timer* TimerWheel::Find(Timer::OnCompleteFunct aOnComplete, void* aAppState) const
+{
+    Timer* lTimer;
+
+    for (lTimer = this->mBuckets[TimerWheel::BucketFor(aOnComplete, aAppState)]; lTimer != NULL; lTimer = lTimer->mMatchNext)
+    {
+        if (lTimer->OnComplete == aOnComplete && lTimer->AppState == aAppState)
+            ExitNow();
+    }
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    for (lTimer = this->mDispatchingWork; lTimer != NULL; lTimer = lTimer->mWheelNext)
+    {
+        if (lTimer->OnComplete == aOnComplete && lTimer->AppState == aAppState)
+            ExitNow();
+    }
+
+    // Other threads only ever push onto the head of the pending list, so the rest of it may be walked safely.
+    for (lTimer = this->mPendingWork; lTimer != NULL; lTimer = lTimer->mWheelNext)
+    {
+        if (lTimer->OnComplete == aOnComplete && lTimer->AppState == aAppState)
+            ExitNow();
+    }
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+exit:
+    return lTimer;
+}
+
+/**
+ *  This method iterates over the timers in the wheel, in no particular order.
+ *
+ *  @param[in]  aTimer  The timer returned by the previous call, or \c NULL to start the iteration.
+ *
+ *  @return A pointer to the next timer, or \c NULL when there are no more.
+ */
+Timer* TimerWheel::Next(const Timer* aTimer) const
+{
+    Timer* lReturn = NULL;
+    unsigned int lSlot = 0;
+
+    if (aTimer != NULL)
+    {
+        lReturn = aTimer->mWheelNext;
+        lSlot = aTimer->mWheelSlot;
+    }
+
+    for (; lReturn == NULL && lSlot < kNumSlots; lSlot++)
+    {
+        lReturn = this->mSlots[lSlot];
+    }
+
+    return lReturn;
+}
+
+/**
+ *  This method finds the earliest epoch at which a timer expires or a slot of the wheel must be redistributed, which is never
+ *  later than the earliest timer awaken epoch.
+ *
+ *  @param[out] aEpoch  The earliest event epoch, in milliseconds, if any.
+ *
+ *  @return \c true if the wheel is not empty, \c false otherwise.
+ */
+bool TimerWheel::GetNextEvent(Timer::Epoch& aEpoch) const
+{
+    bool lFound = false;
+
+    if (this->mSlots[kExpiringSlot] != NULL)
+    {
+        aEpoch = this->mSlots[kExpiringSlot]->mAwakenEpoch;
+        return true;
+    }
+
+    for (unsigned int lLevel = 0; lLevel < kNumLevels; lLevel++)
+    {
+        const unsigned int lShift = lLevel * kSlotBits;
+        const uint64_t lOccupied = this->mOccupied[lLevel];
+        const unsigned int lIndex = static_cast<unsigned int>(this->mCurrentTick >> lShift) & kSlotMask;
+        const Timer::Epoch lRotation = (this->mCurrentTick >> (lShift + kSlotBits)) << (lShift + kSlotBits);
+        uint64_t lAhead;
+        Timer::Epoch lCandidate;
+
+        if (lOccupied == 0)
+            continue;
+
+        // The current slot of a level is still to be reached in this rotation only until all of the lower levels have wrapped.
+        if ((this->mCurrentTick & ((static_cast<Timer::Epoch>(1) << lShift) - 1)) == 0)
+            lAhead = lOccupied & (~static_cast<uint64_t>(0) << lIndex);
+        else
+            lAhead = (lIndex == kSlotMask) ? 0 : (lOccupied & (~static_cast<uint64_t>(0) << (lIndex + 1)));
+
+        if (lAhead != 0)
+            lCandidate = lRotation + (static_cast<Timer::Epoch>(__builtin_ctzll(lAhead)) << lShift);
+        else
+            lCandidate = lRotation + (static_cast<Timer::Epoch>(1) << (lShift + kSlotBits)) +
+                (static_cast<Timer::Epoch>(__builtin_ctzll(lOccupied)) << lShift);
+
+        if (!lFound || lCandidate < aEpoch)
+        {
+            aEpoch = lCandidate;
+            lFound = true;
+        }
+    }
+
+    return lFound;
+}
+
+/**
+ *  This method advances the wheel up to and including the current epoch, completing expired timers.
+ *
+ *  @param[in]  aCurrentEpoch   The current epoch, in milliseconds.
+ *  @param[in]  aMaxExpiries    The maximum number of timers to complete. Any remaining expired timers are completed by the next
+ *                              call.
+ *
+ *  @return The number of timers completed.
+ */
+size_t TimerWheel::HandleExpiredTimers(Timer::Epoch aCurrentEpoch, size_t aMaxExpiries)
+{
+    size_t lExpired = 0;
+    Timer::Epoch lNextEpoch;
+
+    while (lExpired < aMaxExpiries)
+    {
+        Timer* lTimer = this->mSlots[kExpiringSlot];
+
+        if (lTimer == NULL)
+        {
+            // Skip directly to the next tick on which anything happens.
+            if (!this->GetNextEvent(lNextEpoch) || lNextEpoch > aCurrentEpoch)
+            {
+                if (this->mCurrentTick <= aCurrentEpoch)
+                    this->mCurrentTick = aCurrentEpoch + 1;
+                break;
+            }
+
+            this->mCurrentTick = lNextEpoch;
+
+            // Redistribute the higher level slots reached on this tick, then move the timers of this tick aside so that the
+            // completion callbacks may freely start and cancel timers.
+            const unsigned int lIndex = static_cast<unsigned int>(this->mCurrentTick) & kSlotMask;
+
+            for (unsigned int lLevel = 1; lIndex == 0 && lLevel < kNumLevels; lLevel++)
+            {
+                const unsigned int lLevelIndex = static_cast<unsigned int>(this->mCurrentTick >> (lLevel * kSlotBits)) & kSlotMask;
+
+                this->Cascade(lLevel * kSlotsPerLevel + lLevelIndex);
+
+                if (lLevelIndex != 0)
+                    break;
+            }
+
+            while ((lTimer = this->mSlots[lIndex]) != NULL)
+            {
+                this->UnlinkSlot(*lTimer);
+                this->LinkSlot(*lTimer, kExpiringSlot);
+            }
+
+            this->mCurrentTick++;
+            continue;
+        }
+
+        this->Remove(*lTimer);
+        lTimer->HandleComplete();
+        lExpired++;
+    }
+
+    return lExpired;
+}
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+/**
+ *  This method retains a timer armed by Timer::ScheduleWork() and adds it to the pending work list. It may be called from any
+ *  thread.
+ */
+void TimerWheel::PushWork(Timer& aTimer)
+{
+    Timer* lHead;
+
+    aTimer.Retain();
+
+    do
+    {
+        lHead = this->mPendingWork;
+        aTimer.mWheelNext = lHead;
+    } while (!__sync_bool_compare_and_swap(&this->mPendingWork, lHead, &aTimer));
+}
+
+/**
+ *  This method returns whether any scheduled work is pending.
+ */
+bool TimerWheel::HasWork(void) const
+{
+    return this->mPendingWork != NULL;
+}
+
+/**
+ *  This method completes the work pending when it is called, in the order it was scheduled. Work scheduled meanwhile is left
+ *  for the next call.
+ */
+void TimerWheel::HandleWork(void)
+{
+    Timer* lTimer = __sync_lock_test_and_set(&this->mPendingWork, static_cast<Timer*>(NULL));
+    Timer* lOrdered = NULL;
+
+    while (lTimer != NULL)
+    {
+        Timer* lNext = lTimer->mWheelNext;
+
+        lTimer->mWheelNext = lOrdered;
+        lOrdered = lTimer;
+        lTimer = lNext;
+    }
+
+    this->mDispatchingWork = lOrdered;
+
+    while ((lTimer = this->mDispatchingWork) != NULL)
+    {
+        this->mDispatchingWork = lTimer->mWheelNext;
+        lTimer->mWheelNext = NULL;
+
+        lTimer->HandleComplete();
+        lTimer->Release();
+    }
+}
+
+/**
+ *  This method cancels all scheduled work.
+ */
+void TimerWheel::CancelWork(void)
+{
+    Timer* lTimer = __sync_lock_test_and_set(&this->mPendingWork, static_cast<Timer*>(NULL));
+
+    while (lTimer != NULL)
+    {
+        Timer* lNext = lTimer->mWheelNext;
+
+        lTimer->mWheelNext = NULL;
+        lTimer->Cancel();
+        lTimer->Release();
+        lTimer = lNext;
+    }
+
+    // Work already being dispatched is released by HandleWork().
+    for (lTimer = this->mDispatchingWork; lTimer != NULL; lTimer = lTimer->mWheelNext)
+    {
+        lTimer->Cancel();
+    }
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+size_t TimerWheel::BucketFor(Timer::OnCompleteFunct aOnComplete, void* aAppState)
+{
+    uintptr_t lHash = (reinterpret_cast<uintptr_t>(aOnComplete) >> 2) * 31 + (reinterpret_cast<uintptr_t>(aAppState) >> 3);
+
+    lHash ^= lHash >> 16;
+
+    return lHash % WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS;
+}
+
+/**
+ *  This method puts a timer in the slot of the lowest level whose span covers its remaining delay.
+ */
+void TimerWheel::Schedule(Timer& aTimer)
+{
+    Timer::Epoch lTick = aTimer.mAwakenEpoch;
+    Timer::Epoch lDelta;
+    unsigned int lLevel = 0;
+
+    // Timers that are already due are completed by the next pass, ahead of any later tick.
+    if (lTick < this->mCurrentTick)
+    {
+        this->LinkSlot(aTimer, kExpiringSlot);
+        return;
+    }
+
+    lDelta = lTick - this->mCurrentTick;
+
+    // Timers beyond the span of the wheel are kept at its far end and rescheduled from there.
+    if (lDelta >= kSpan)
+    {
+        lDelta = kSpan - 1;
+        lTick = this->mCurrentTick + lDelta;
+    }
+
+    while (lLevel < kNumLevels - 1 && lDelta >= (static_cast<Timer::Epoch>(1) << ((lLevel + 1) * kSlotBits)))
+    {
+        lLevel++;
+    }
+
+    this->LinkSlot(aTimer, lLevel * kSlotsPerLevel + (static_cast<unsigned int>(lTick >> (lLevel * kSlotBits)) & kSlotMask));
+}
+
+void TimerWheel::LinkSlot(Timer& aTimer, unsigned int aSlot)
+{
+    Timer* const lHead = this->mSlots[aSlot];
+
+    // Slots are kept in insertion order; the first timer's previous pointer designates the last timer.
+    aTimer.mWheelNext = NULL;
+
+    if (lHead == NULL)
+    {
+        aTimer.mWheelPrev = &aTimer;
+        this->mSlots[aSlot] = &aTimer;
+    }
+    else
+    {
+        aTimer.mWheelPrev = lHead->mWheelPrev;
+        lHead->mWheelPrev->mWheelNext = &aTimer;
+        lHead->mWheelPrev = &aTimer;
+    }
+
+    aTimer.mWheelSlot = static_cast<uint16_t>(aSlot + 1);
+
+    if (aSlot < kExpiringSlot)
+        this->mOccupied[aSlot / kSlotsPerLevel] |= static_cast<uint64_t>(1) << (aSlot & kSlotMask);
+}
+
+void TimerWheel::UnlinkSlot(Timer& aTimer)
+{
+    const unsigned int lSlot = aTimer.mWheelSlot - 1;
+    Timer* const lHead = this->mSlots[lSlot];
+
+    if (&aTimer == lHead)
+    {
+        this->mSlots[lSlot] = aTimer.mWheelNext;
+
+        if (aTimer.mWheelNext != NULL)
+            aTimer.mWheelNext->mWheelPrev = aTimer.mWheelPrev;
+        else if (lSlot < kExpiringSlot)
+            this->mOccupied[lSlot / kSlotsPerLevel] &= ~(static_cast<uint64_t>(1) << (lSlot & kSlotMask));
+    }
+    else
+    {
+        aTimer.mWheelPrev->mWheelNext = aTimer.mWheelNext;
+
+        if (aTimer.mWheelNext != NULL)
+            aTimer.mWheelNext->mWheelPrev = aTimer.mWheelPrev;
+        else
+            lHead->mWheelPrev = aTimer.mWheelPrev;
+    }
+
+    aTimer.mWheelPrev = NULL;
+    aTimer.mWheelNext = NULL;
+    aTimer.mWheelSlot = 0;
+}
+
+/**
+ *  This method redistributes the timers of a higher level slot, which the wheel has just reached, to the lower levels.
+ */
+void TimerWheel::Cascade(unsigned int aSlot)
+{
+    Timer* lTimer;
+
+    while ((lTimer = this->mSlots[aSlot]) != NULL)
+    {
+        this->UnlinkSlot(*lTimer);
+        this->Schedule(*lTimer);
+    }
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
 } // namespace System
 } // namespace Weave
 } // namespace nl
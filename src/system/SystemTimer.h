@@ -54,6 +54,7 @@ namespace Weave {
 namespace System {
 
 class Layer;
+class TimerWheel;
 
 /**
  * @class Timer
@@ -67,6 +68,9 @@ class Layer;
 class NL_DLL_EXPORT Timer : public Object
 {
     friend class Layer;
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    friend class TimerWheel;
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
 public:
     /**
@@ -83,6 +87,7 @@ public:
     OnCompleteFunct OnComplete;
 
     Error Start(uint32_t aDelayMilliseconds, OnCompleteFunct aOnComplete, void* aAppState);
+    Error Start(uint32_t aDelayMilliseconds, uint32_t aToleranceMilliseconds, OnCompleteFunct aOnComplete, void* aAppState);
     Error Cancel(void);
 
     static void GetStatistics(nl::Weave::System::Stats::count_t& aNumInUse, nl::Weave::System::Stats::count_t& aHighWatermark);
@@ -97,7 +102,25 @@ public:
 private:
     static ObjectPool<Timer, WEAVE_SYSTEM_CONFIG_NUM_TIMERS> sPool;
 
+#if WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+    struct PoolBlock;
+
+    static PoolBlock* volatile sPoolBlocks;
+
+    static Timer* TryCreateFromPool(Layer& aLayer);
+#endif // WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+
     Epoch mAwakenEpoch;
+    uint32_t mToleranceMilliseconds;    /**< How long after mAwakenEpoch the timer may be deferred to coalesce with others. */
+
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    Timer* mWheelPrev;      /**< In a wheel slot, the previous timer, or the last timer when this is the first. */
+    Timer* mWheelNext;      /**< In a wheel slot or in the scheduled work list, the next timer. */
+    Timer* mMatchPrev;      /**< The previous timer in the same lookup bucket. */
+    Timer* mMatchNext;      /**< The next timer in the same lookup bucket. */
+    uint16_t mWheelSlot;    /**< One more than the index of the containing wheel slot, or zero if not in the wheel. */
+    uint16_t mMatchBucket;  /**< The index of the containing lookup bucket. */
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
 
 #if WEAVE_SYSTEM_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
     Inet::InetLayer* mInetLayer;
@@ -107,11 +130,18 @@ private:
 
     void HandleComplete(void);
 
+    /** Returns the latest epoch at which the timer may fire. */
+    Epoch DeadlineEpoch(void) const { return this->mAwakenEpoch + static_cast<Epoch>(this->mToleranceMilliseconds); }
+
     Error ScheduleWork(OnCompleteFunct aOnComplete, void* aAppState);
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
     Timer *mNextTimer;
 
+    static bool GetWakeEpoch(const Timer* aTimerList, Epoch& aWakeEpoch);
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
     static Error HandleExpiredTimers(Layer& aLayer);
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
@@ -120,12 +150,81 @@ private:
     Timer& operator =(const Timer&);
 };
 
+#if WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+/**
+ * @class TimerWheel
+ *
+ * @brief
+ *  This is an internal class to Weave System Layer, used by each Layer object to hold its armed timers in a hierarchical timing
+ *  wheel with a resolution of one millisecond.
+ *
+ *  Each of the four levels has 64 slots. A timer is kept on the lowest level whose span covers its remaining delay, and the
+ *  timers in a slot of a higher level are redistributed to the lower levels when the wheel reaches that slot. Timers further out
+ *  than the span of the wheel, about 4.6 hours, are kept on the highest level and redistributed until they come within range.
+ *  Armed timers are also hashed by completion function and application state, for Layer::CancelTimer().
+ *
+ *  Apart from the scheduled work list, a wheel may only be used from the thread that owns the layer.
+ */
+class TimerWheel
+{
+public:
+    void Init(Timer::Epoch aCurrentEpoch);
+
+    void Add(Timer& aTimer);
+    void Remove(Timer& aTimer);
+    Timer* Find(Timer::OnCompleteFunct aOnComplete, void* aAppState) const;
+    Timer* Next(const Timer* aTimer) const;
+
+    bool GetNextEvent(Timer::Epoch& aEpoch) const;
+    size_t HandleExpiredTimers(Timer::Epoch aCurrentEpoch, size_t aMaxExpiries);
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    void PushWork(Timer& aTimer);
+    bool HasWork(void) const;
+    void HandleWork(void);
+    void CancelWork(void);
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+private:
+    enum
+    {
+        kSlotBits           = 6,
+        kSlotsPerLevel      = 1 << kSlotBits,
+        kSlotMask           = kSlotsPerLevel - 1,
+        kNumLevels          = 4,
+        kExpiringSlot       = kNumLevels * kSlotsPerLevel,  /**< Holds the timers of the tick currently being expired. */
+        kNumSlots           = kExpiringSlot + 1
+    };
+
+    static const Timer::Epoch kSpan = static_cast<Timer::Epoch>(1) << (kNumLevels * kSlotBits);
+
+    Timer* mSlots[kNumSlots];
+    uint64_t mOccupied[kNumLevels];
+    Timer* mBuckets[WEAVE_SYSTEM_CONFIG_TIMER_WHEEL_HASH_BUCKETS];
+    Timer::Epoch mCurrentTick;  /**< The earliest tick not yet expired. */
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+    Timer* volatile mPendingWork;
+    Timer* mDispatchingWork;
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
+
+    static size_t BucketFor(Timer::OnCompleteFunct aOnComplete, void* aAppState);
+
+    void Schedule(Timer& aTimer);
+    void LinkSlot(Timer& aTimer, unsigned int aSlot);
+    void UnlinkSlot(Timer& aTimer);
+    void Cascade(unsigned int aSlot);
+};
+#endif // WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+
+#if !WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
 
 inline void Timer::GetStatistics(nl::Weave::System::Stats::count_t& aNumInUse,
                                  nl::Weave::System::Stats::count_t& aHighWatermark)
 {
     sPool.GetStatistics(aNumInUse, aHighWatermark);
 }
+#endif // !WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
 
 #if WEAVE_SYSTEM_CONFIG_PROVIDE_OBSOLESCENT_INTERFACES
 inline void Timer::AttachInetLayer(Inet::InetLayer& aInetLayer, void* aOnCompleteInetLayer, void* aAppStateInetLayer)
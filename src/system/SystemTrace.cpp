@@ -0,0 +1,145 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file implements the in-memory trace buffer behind the Weave
+ *  trace points, and its export in the Chrome trace JSON format.
+ */
+
+// Include module header
+#include <SystemLayer/SystemTrace.h>
+
+// Include common private header
+#include "SystemLayerPrivate.h"
+
+// Include local headers
+#include <SystemLayer/SystemLayer.h>
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#if WEAVE_SYSTEM_CONFIG_TRACING
+
+namespace nl {
+namespace Weave {
+namespace System {
+namespace Trace {
+
+static Event sEvents[WEAVE_SYSTEM_CONFIG_TRACE_BUFFER_SIZE];
+static size_t sNextEvent = 0;
+static size_t sEventCount = 0;
+
+/**
+ *  Record a trace event into the trace buffer, overwriting the oldest event if the buffer is full.
+ *
+ *  @note Like the rest of the System Layer, this is not thread-safe; trace points are expected to be hit with the stack lock
+ *        held.
+ *
+ *  @param[in]  aType       The type of the event.
+ *  @param[in]  aCategory   The layer or component the event belongs to.  Must remain valid, e.g. a string literal.
+ *  @param[in]  aName       The name of the span or point.  Must remain valid, e.g. a string literal.
+ */
+NL_DLL_EXPORT void Record(EventType aType, const char *aCategory, const char *aName)
+{
+    Event &event = sEvents[sNextEvent];
+
+    event.Category = aCategory;
+    event.Name = aName;
+    event.Timestamp = Layer::GetClock_MonotonicHiRes();
+    event.Type = static_cast<uint8_t>(aType);
+
+    sNextEvent = (sNextEvent + 1) % WEAVE_SYSTEM_CONFIG_TRACE_BUFFER_SIZE;
+    if (sEventCount < WEAVE_SYSTEM_CONFIG_TRACE_BUFFER_SIZE)
+        sEventCount++;
+}
+
+/**
+ *  Discard all events in the trace buffer.
+ */
+NL_DLL_EXPORT void Clear(void)
+{
+    sNextEvent = 0;
+    sEventCount = 0;
+}
+
+/**
+ *  Return the number of events in the trace buffer.
+ */
+NL_DLL_EXPORT size_t GetEventCount(void)
+{
+    return sEventCount;
+}
+
+/**
+ *  Return an event from the trace buffer.
+ *
+ *  @param[in]  aIndex  The index of the event, from 0 for the oldest event to GetEventCount() - 1 for the newest.
+ *
+ *  @return The event, or NULL if @a aIndex is out of range.
+ */
+NL_DLL_EXPORT const Event *GetEvent(size_t aIndex)
+{
+    if (aIndex >= sEventCount)
+        return NULL;
+
+    return &sEvents[(sNextEvent + WEAVE_SYSTEM_CONFIG_TRACE_BUFFER_SIZE - sEventCount + aIndex) % WEAVE_SYSTEM_CONFIG_TRACE_BUFFER_SIZE];
+}
+
+/**
+ *  Export the events in the trace buffer, oldest first, as a Chrome trace JSON document, which can be loaded into Perfetto
+ *  (https://ui.perfetto.dev) or chrome://tracing.
+ *
+ *  Category and name strings are written as is, so they must not contain characters that need escaping in JSON.
+ *
+ *  @param[in]  aWriteFunct     A function called with each successive piece of the document.
+ *  @param[in]  aContext        An argument passed through to @a aWriteFunct, e.g. a FILE pointer.
+ */
+NL_DLL_EXPORT void ExportChromeTraceJSON(WriteFunct aWriteFunct, void *aContext)
+{
+    static const char kHeader[] = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    static const char kTrailer[] = "\n]}\n";
+    char line[256];
+
+    aWriteFunct(aContext, kHeader, sizeof(kHeader) - 1);
+
+    for (size_t i = 0; i < sEventCount; i++)
+    {
+        const Event *event = GetEvent(i);
+        int len;
+
+        len = snprintf(line, sizeof(line), "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRIu64 ",\"pid\":1,\"tid\":1%s}",
+                       (i == 0) ? "" : ",", event->Name, event->Category, event->Type, event->Timestamp,
+                       (event->Type == kEventType_Instant) ? ",\"s\":\"t\"" : "");
+        if (len < 0)
+            continue;
+        if (static_cast<size_t>(len) >= sizeof(line))
+            len = sizeof(line) - 1;
+
+        aWriteFunct(aContext, line, static_cast<size_t>(len));
+    }
+
+    aWriteFunct(aContext, kTrailer, sizeof(kTrailer) - 1);
+}
+
+} // namespace Trace
+} // namespace System
+} // namespace Weave
+} // namespace nl
+
+#endif // WEAVE_SYSTEM_CONFIG_TRACING
@@ -0,0 +1,142 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file declares the Weave API to trace where time is spent along
+ *  the message path, across the System, Inet and Weave layers.
+ */
+
+#ifndef SYSTEMTRACE_H
+#define SYSTEMTRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Include configuration headers
+#include <SystemLayer/SystemConfig.h>
+
+// Include dependent headers
+#include <Weave/Support/NLDLLUtil.h>
+
+#if WEAVE_SYSTEM_CONFIG_TRACING
+
+namespace nl {
+namespace Weave {
+namespace System {
+namespace Trace {
+
+/**
+ *  The type of a trace event, using the phase letters of the Chrome trace format.
+ */
+enum EventType
+{
+    kEventType_Begin    = 'B',      /**< Start of a span. */
+    kEventType_End      = 'E',      /**< End of the innermost open span. */
+    kEventType_Instant  = 'i'       /**< A point in time. */
+};
+
+/**
+ *  A trace event, as held by the in-memory trace buffer.
+ */
+struct Event
+{
+    const char *Category;           /**< The layer or component, e.g. "Inet"; must be a string literal. */
+    const char *Name;               /**< The span or point name; must be a string literal. */
+    uint64_t Timestamp;             /**< Monotonic time, in microseconds. */
+    uint8_t Type;                   /**< An EventType. */
+};
+
+typedef void (*WriteFunct)(void *aContext, const char *aData, size_t aDataLen);
+
+NL_DLL_EXPORT void Record(EventType aType, const char *aCategory, const char *aName);
+NL_DLL_EXPORT void Clear(void);
+NL_DLL_EXPORT size_t GetEventCount(void);
+NL_DLL_EXPORT const Event *GetEvent(size_t aIndex);
+NL_DLL_EXPORT void ExportChromeTraceJSON(WriteFunct aWriteFunct, void *aContext);
+
+} // namespace Trace
+} // namespace System
+} // namespace Weave
+} // namespace nl
+
+#ifndef SYSTEM_TRACE_BEGIN
+#define SYSTEM_TRACE_BEGIN(category, name) \
+    nl::Weave::System::Trace::Record(nl::Weave::System::Trace::kEventType_Begin, category, name)
+#endif
+
+#ifndef SYSTEM_TRACE_END
+#define SYSTEM_TRACE_END(category, name) \
+    nl::Weave::System::Trace::Record(nl::Weave::System::Trace::kEventType_End, category, name)
+#endif
+
+#ifndef SYSTEM_TRACE_INSTANT
+#define SYSTEM_TRACE_INSTANT(category, name) \
+    nl::Weave::System::Trace::Record(nl::Weave::System::Trace::kEventType_Instant, category, name)
+#endif
+
+namespace nl {
+namespace Weave {
+namespace System {
+namespace Trace {
+
+/**
+ *  Traces a span from its construction to the end of the enclosing scope.  Use through SYSTEM_TRACE_SCOPE().
+ */
+class Scope
+{
+public:
+    Scope(const char *aCategory, const char *aName) : mCategory(aCategory), mName(aName)
+    {
+        SYSTEM_TRACE_BEGIN(mCategory, mName);
+    }
+
+    ~Scope(void)
+    {
+        SYSTEM_TRACE_END(mCategory, mName);
+    }
+
+private:
+    const char *mCategory;
+    const char *mName;
+};
+
+} // namespace Trace
+} // namespace System
+} // namespace Weave
+} // namespace nl
+
+#define _SYSTEM_TRACE_CONCAT_(a, b) a##b
+#define _SYSTEM_TRACE_CONCAT(a, b) _SYSTEM_TRACE_CONCAT_(a, b)
+
+#define SYSTEM_TRACE_SCOPE(category, name) \
+    nl::Weave::System::Trace::Scope _SYSTEM_TRACE_CONCAT(_systemTraceScope, __LINE__)(category, name)
+
+#else // WEAVE_SYSTEM_CONFIG_TRACING
+
+#define SYSTEM_TRACE_BEGIN(category, name)
+
+#define SYSTEM_TRACE_END(category, name)
+
+#define SYSTEM_TRACE_INSTANT(category, name)
+
+#define SYSTEM_TRACE_SCOPE(category, name)
+
+#endif // WEAVE_SYSTEM_CONFIG_TRACING
+
+#endif // SYSTEMTRACE_H
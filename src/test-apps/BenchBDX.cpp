@@ -0,0 +1,886 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a throughput benchmark for BDX transfers.
+ *
+ *      A BDX client downloads a synthetic image from a BDX server of the
+ *      same node, over the loopback interface, using UDP with WRMP or TCP,
+ *      for each of a set of block and window sizes.  Loss, latency and
+ *      reordering are injected into the messages the node receives, so that
+ *      the transfers can be compared under the network conditions of a
+ *      constrained or lossy link.  The benchmark reports the throughput, the
+ *      WRMP retransmissions and the CPU time spent per MB transferred.
+ *
+ */
+
+#include "ToolCommon.h"
+
+#include <sys/resource.h>
+
+#include <map>
+#include <set>
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Support/RandUtils.h>
+#include <Weave/Profiles/bulk-data-transfer/Development/BulkDataTransfer.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/init.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+using namespace nl::Weave::Profiles::WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesignation_Development);
+using nl::Weave::System::PacketBuffer;
+
+#define TOOL_NAME "BenchBDX"
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+
+enum
+{
+    kTransport_UDP              = 0x01,
+    kTransport_TCP              = 0x02,
+
+    kDefaultTransferSize        = 1024 * 1024,
+    kMaxBlockSize               = UINT16_MAX,
+    kTransferTimeoutMs          = 120000,
+    kReorderHoldMs              = 10,           // How much longer than the others a reordered message is held back
+};
+
+static const char sFileDesignator[] = "bench-bdx-image";
+
+// The block and window sizes benchmarked when none is given.
+static const uint16_t sDefaultBlockSizes[] = { 256, 1024 };
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+static const uint8_t sDefaultWindowSizes[] = { 1, 4, WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE };
+#else
+static const uint8_t sDefaultWindowSizes[] = { 1 };
+#endif
+
+static uint8_t gTransports = kTransport_UDP | kTransport_TCP;
+static int32_t gBlockSize = 0;
+static int32_t gWindowSize = 0;
+static int32_t gTransferSize = kDefaultTransferSize;
+static int32_t gLossPercent = 0;
+static int32_t gLatencyMs = 0;
+static int32_t gReorderPercent = 0;
+
+static uint8_t gBlockData[kMaxBlockSize];
+
+/**
+ *  The state and results of one benchmarked transfer.
+ */
+struct BenchRun
+{
+    uint8_t transport;
+    uint16_t blockSize;
+    uint8_t windowSize;
+
+    bool receiverDone;
+    bool senderDone;
+    bool failed;
+    bool timedOut;
+
+    uint64_t bytesSent;
+    uint64_t bytesReceived;
+    uint32_t messages;
+    uint32_t retransmissions;
+    uint32_t dropped;
+    uint64_t elapsedMs;
+    uint64_t cpuUs;
+};
+
+static BenchRun sRun;
+static Binding *sBinding = NULL;
+static WeaveConnection *sCon = NULL;
+static BdxServer sServer;
+static BdxClient sClient;
+
+/**
+ *  A received message held back to inject latency or reordering.  UDP
+ *  messages are held once decoded, TCP data before it is parsed into
+ *  messages.
+ */
+struct DelayedMessage
+{
+    TCPEndPoint *endPoint;      // The endpoint TCP data was received on, NULL for a UDP message
+    WeaveMessageInfo msgInfo;
+    IPPacketInfo pktInfo;
+    bool hasPktInfo;
+    PacketBuffer *buf;
+};
+
+static std::multimap<uint64_t, DelayedMessage> sDelayedMessages;
+static std::set<uint32_t> sReceivedMessageIds;
+static std::set<uint32_t> sDeliveredMessageIds;
+
+static WeaveMessageLayer::MessageReceiveFunct sDeliverUDPMessage;
+static TCPEndPoint::OnDataReceivedFunct sDeliverTCPData;
+
+static inline bool RandomPercent(int32_t percent)
+{
+    return percent > 0 && static_cast<int32_t>(GetRandU32() % 100) < percent;
+}
+
+static uint64_t GetCPUTimeUs(void)
+{
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    return static_cast<uint64_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 +
+           usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+static void HandleDeliveryTimer(System::Layer *aSystemLayer, void *aAppState, System::Error aError);
+
+static void ScheduleDelivery(void)
+{
+    uint64_t now = System::Layer::GetClock_MonotonicMS();
+    uint64_t next;
+
+    SystemLayer.CancelTimer(HandleDeliveryTimer, NULL);
+
+    if (!sDelayedMessages.empty())
+    {
+        next = sDelayedMessages.begin()->first;
+        SystemLayer.StartTimer((next > now) ? static_cast<uint32_t>(next - now) : 0, HandleDeliveryTimer, NULL);
+    }
+}
+
+static void DelayMessage(DelayedMessage &msg, uint32_t delayMs)
+{
+    sDelayedMessages.insert(std::make_pair(System::Layer::GetClock_MonotonicMS() + delayMs, msg));
+    ScheduleDelivery();
+}
+
+static void HandleDeliveryTimer(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    uint64_t now = System::Layer::GetClock_MonotonicMS();
+
+    while (!sDelayedMessages.empty() && sDelayedMessages.begin()->first <= now)
+    {
+        // Take the message out of the queue first, as its delivery may delay further messages.
+        DelayedMessage msg = sDelayedMessages.begin()->second;
+        sDelayedMessages.erase(sDelayedMessages.begin());
+
+        if (msg.endPoint != NULL)
+        {
+            sDeliverTCPData(msg.endPoint, msg.buf);
+        }
+        else
+        {
+            msg.msgInfo.InPacketInfo = msg.hasPktInfo ? &msg.pktInfo : NULL;
+            sDeliverUDPMessage(&MessageLayer, &msg.msgInfo, msg.buf);
+        }
+    }
+
+    ScheduleDelivery();
+}
+
+static void DiscardDelayedMessages(void)
+{
+    std::multimap<uint64_t, DelayedMessage>::iterator it;
+
+    for (it = sDelayedMessages.begin(); it != sDelayedMessages.end(); ++it)
+    {
+        PacketBuffer::Free(it->second.buf);
+    }
+
+    sDelayedMessages.clear();
+    SystemLayer.CancelTimer(HandleDeliveryTimer, NULL);
+}
+
+/**
+ *  Injects loss, latency and reordering into the UDP messages the node
+ *  receives, and counts the retransmitted ones.
+ *
+ *  Messages are dropped once decoded, so that every copy of a message is
+ *  seen and the retransmissions can be told from the first transmissions
+ *  by their message id.  As the message layer has then already recorded
+ *  the id, the first copy delivered is cleared of the duplicate flag it
+ *  gets when an earlier copy was dropped.
+ */
+static void HandleUDPMessage(WeaveMessageLayer *msgLayer, WeaveMessageInfo *msgInfo, PacketBuffer *payload)
+{
+    DelayedMessage msg;
+    uint32_t delayMs = gLatencyMs;
+
+    sRun.messages++;
+
+    if (!sReceivedMessageIds.insert(msgInfo->MessageId).second)
+    {
+        sRun.retransmissions++;
+    }
+
+    if (RandomPercent(gLossPercent))
+    {
+        sRun.dropped++;
+        PacketBuffer::Free(payload);
+        ExitNow();
+    }
+
+    if (sDeliveredMessageIds.insert(msgInfo->MessageId).second)
+    {
+        msgInfo->Flags &= ~kWeaveMessageFlag_DuplicateMessage;
+    }
+
+    if (RandomPercent(gReorderPercent))
+    {
+        delayMs += kReorderHoldMs;
+    }
+
+    if (delayMs == 0)
+    {
+        sDeliverUDPMessage(msgLayer, msgInfo, payload);
+        ExitNow();
+    }
+
+    msg.endPoint = NULL;
+    msg.msgInfo = *msgInfo;
+    msg.hasPktInfo = (msgInfo->InPacketInfo != NULL);
+    if (msg.hasPktInfo)
+    {
+        msg.pktInfo = *msgInfo->InPacketInfo;
+    }
+    msg.buf = payload;
+
+    DelayMessage(msg, delayMs);
+
+exit:
+    return;
+}
+
+/**
+ *  Injects latency into the TCP data the node receives.  The data of a
+ *  connection is always delivered in order, and is never dropped, as TCP
+ *  would retransmit it below the Weave layers.
+ */
+static void HandleTCPData(TCPEndPoint *endPoint, PacketBuffer *data)
+{
+    DelayedMessage msg;
+
+    if (gLatencyMs == 0)
+    {
+        sDeliverTCPData(endPoint, data);
+        ExitNow();
+    }
+
+    msg.endPoint = endPoint;
+    msg.msgInfo.Clear();
+    msg.hasPktInfo = false;
+    msg.buf = data;
+
+    DelayMessage(msg, gLatencyMs);
+
+exit:
+    return;
+}
+
+static void InterposeTCPData(WeaveConnection *con)
+{
+    TCPEndPoint *endPoint = con->GetTCPEndPoint();
+
+    if (endPoint != NULL)
+    {
+        sDeliverTCPData = endPoint->OnDataReceived;
+        endPoint->OnDataReceived = HandleTCPData;
+    }
+}
+
+static void EndRun(bool failed)
+{
+    if (!sRun.receiverDone)
+    {
+        sRun.failed = sRun.failed || failed;
+        sRun.receiverDone = true;
+    }
+}
+
+static void HandleTransferTimeout(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    sRun.timedOut = true;
+    EndRun(true);
+    sRun.senderDone = true;
+}
+
+// ===== The server, which sends the image
+
+static void ServerGetBlockHandler(BDXTransfer *aXfer, uint64_t *aLength, uint8_t **aDataBlock, bool *aIsLastBlock)
+{
+    uint64_t remaining = aXfer->mLength - aXfer->mBytesSent;
+
+    *aLength = (remaining < aXfer->mMaxBlockSize) ? remaining : aXfer->mMaxBlockSize;
+    *aDataBlock = gBlockData;
+    aXfer->mBytesSent += *aLength;
+    *aIsLastBlock = (aXfer->mBytesSent == aXfer->mLength);
+
+    sRun.bytesSent = aXfer->mBytesSent;
+}
+
+static void ServerXferErrorHandler(BDXTransfer *aXfer, StatusReport *aXferError)
+{
+    printf("Server transfer error: %s\n", nl::StatusReportStr(aXferError->mProfileId, aXferError->mStatusCode));
+    sRun.failed = true;
+    sRun.senderDone = true;
+    aXfer->Shutdown();
+}
+
+static void ServerXferDoneHandler(BDXTransfer *aXfer)
+{
+    sRun.senderDone = true;
+    aXfer->Shutdown();
+}
+
+static void ServerErrorHandler(BDXTransfer *aXfer, WEAVE_ERROR anErrorCode)
+{
+    printf("Server error: %s\n", ErrorStr(anErrorCode));
+    sRun.failed = true;
+    sRun.senderDone = true;
+    aXfer->Shutdown();
+}
+
+static uint16_t ServerReceiveInitHandler(BDXTransfer *aXfer, ReceiveInit *aReceiveInit)
+{
+    BDXHandlers handlers =
+    {
+        NULL,                       // SendAcceptHandler
+        NULL,                       // ReceiveAcceptHandler
+        NULL,                       // RejectHandler
+        ServerGetBlockHandler,      // GetBlockHandler
+        NULL,                       // PutBlockHandler
+        ServerXferErrorHandler,     // XferErrorHandler
+        ServerXferDoneHandler,      // XferDoneHandler
+        ServerErrorHandler          // ErrorHandler
+    };
+
+    aXfer->SetHandlers(handlers);
+    aXfer->mLength = gTransferSize;
+    aXfer->mIsAccepted = true;
+    aXfer->mTransferMode = kMode_ReceiverDrive;
+
+    return kStatus_NoError;
+}
+
+// ===== The client, which receives the image
+
+static void ClientPutBlockHandler(BDXTransfer *aXfer, uint64_t aLength, uint8_t *aDataBlock, bool aIsLastBlock)
+{
+    sRun.bytesReceived += aLength;
+}
+
+static void ClientRejectHandler(BDXTransfer *aXfer, StatusReport *aReport)
+{
+    printf("Transfer rejected: %s\n", nl::StatusReportStr(aReport->mProfileId, aReport->mStatusCode));
+    sRun.senderDone = true;
+    EndRun(true);
+}
+
+static void ClientXferErrorHandler(BDXTransfer *aXfer, StatusReport *aXferError)
+{
+    printf("Client transfer error: %s\n", nl::StatusReportStr(aXferError->mProfileId, aXferError->mStatusCode));
+    EndRun(true);
+    aXfer->Shutdown();
+}
+
+static void ClientXferDoneHandler(BDXTransfer *aXfer)
+{
+    EndRun(sRun.bytesReceived != static_cast<uint64_t>(gTransferSize));
+    aXfer->Shutdown();
+}
+
+static void ClientErrorHandler(BDXTransfer *aXfer, WEAVE_ERROR anErrorCode)
+{
+    printf("Client error: %s\n", ErrorStr(anErrorCode));
+    EndRun(true);
+    aXfer->Shutdown();
+}
+
+static WEAVE_ERROR StartTransfer(void)
+{
+    WEAVE_ERROR err;
+    BDXTransfer *xfer = NULL;
+    ReferencedString fileDesignator;
+    BDXHandlers handlers =
+    {
+        NULL,                       // SendAcceptHandler
+        NULL,                       // ReceiveAcceptHandler
+        ClientRejectHandler,        // RejectHandler
+        NULL,                       // GetBlockHandler
+        ClientPutBlockHandler,      // PutBlockHandler
+        ClientXferErrorHandler,     // XferErrorHandler
+        ClientXferDoneHandler,      // XferDoneHandler
+        ClientErrorHandler          // ErrorHandler
+    };
+
+    fileDesignator.init(static_cast<uint16_t>(sizeof(sFileDesignator) - 1), const_cast<char *>(sFileDesignator));
+
+    if (sRun.transport == kTransport_TCP)
+    {
+        err = sClient.NewTransfer(sCon, handlers, fileDesignator, NULL, xfer);
+    }
+    else
+    {
+        err = sClient.NewTransfer(sBinding, handlers, fileDesignator, NULL, xfer);
+    }
+    SuccessOrExit(err);
+
+    xfer->mMaxBlockSize = sRun.blockSize;
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    xfer->mWindowSize = sRun.windowSize;
+#endif
+
+    err = sClient.InitBdxReceive(*xfer, true, false, false, NULL);
+    SuccessOrExit(err);
+
+exit:
+    if (err != WEAVE_NO_ERROR && xfer != NULL)
+    {
+        xfer->Shutdown();
+    }
+
+    return err;
+}
+
+static void HandleBindingEvent(void *const appState, const Binding::EventType event, const Binding::InEventParam &inParam,
+                               Binding::OutEventParam &outParam)
+{
+    WEAVE_ERROR err;
+
+    switch (event)
+    {
+    case Binding::kEvent_BindingReady:
+        err = StartTransfer();
+        if (err != WEAVE_NO_ERROR)
+        {
+            printf("Failed to start transfer: %s\n", ErrorStr(err));
+            sRun.senderDone = true;
+            EndRun(true);
+        }
+        break;
+
+    case Binding::kEvent_PrepareFailed:
+        printf("Binding prepare failed: %s\n", ErrorStr(inParam.PrepareFailed.Reason));
+        sRun.senderDone = true;
+        EndRun(true);
+        break;
+
+    default:
+        Binding::DefaultEventHandler(appState, event, inParam, outParam);
+    }
+}
+
+static void HandleConnectionComplete(WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    if (conErr == WEAVE_NO_ERROR)
+    {
+        InterposeTCPData(con);
+        conErr = StartTransfer();
+    }
+
+    if (conErr != WEAVE_NO_ERROR)
+    {
+        printf("Failed to start transfer: %s\n", ErrorStr(conErr));
+        sRun.senderDone = true;
+        EndRun(true);
+    }
+}
+
+static void HandleConnectionClosed(WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    if (con == sCon)
+    {
+        sCon = NULL;
+    }
+
+    con->Close();
+}
+
+static void HandleConnectionReceived(WeaveMessageLayer *msgLayer, WeaveConnection *con)
+{
+    con->OnConnectionClosed = HandleConnectionClosed;
+    InterposeTCPData(con);
+}
+
+static WEAVE_ERROR Connect(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    IPAddress loopbackAddr;
+
+    IPAddress::FromString("::1", loopbackAddr);
+
+    if (sRun.transport == kTransport_TCP)
+    {
+        sCon = MessageLayer.NewConnection();
+        VerifyOrExit(sCon != NULL, err = WEAVE_ERROR_TOO_MANY_CONNECTIONS);
+
+        sCon->OnConnectionComplete = HandleConnectionComplete;
+        sCon->OnConnectionClosed = HandleConnectionClosed;
+
+        err = sCon->Connect(FabricState.LocalNodeId, kWeaveAuthMode_Unauthenticated, loopbackAddr);
+        SuccessOrExit(err);
+    }
+    else
+    {
+        sBinding = ExchangeMgr.NewBinding(HandleBindingEvent, NULL);
+        VerifyOrExit(sBinding != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        err = sBinding->BeginConfiguration()
+            .Target_NodeId(FabricState.LocalNodeId)
+            .TargetAddress_IP(loopbackAddr)
+            .Transport_UDP_WRM()
+            .Security_None()
+            .PrepareBinding();
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+static void Disconnect(void)
+{
+    if (sBinding != NULL)
+    {
+        sBinding->Release();
+        sBinding = NULL;
+    }
+
+    if (sCon != NULL)
+    {
+        sCon->Close();
+        sCon = NULL;
+    }
+}
+
+/**
+ *  Run one transfer, timing it from the connection set up until the client
+ *  has received the whole image, and let the server finish before the next.
+ */
+static WEAVE_ERROR RunTransfer(uint8_t transport, uint16_t blockSize, uint8_t windowSize)
+{
+    WEAVE_ERROR err;
+    uint64_t startMs;
+    uint64_t startCPUUs;
+    struct timeval sleepTime;
+
+    memset(&sRun, 0, sizeof(sRun));
+    sRun.transport = transport;
+    sRun.blockSize = blockSize;
+    sRun.windowSize = windowSize;
+
+    sReceivedMessageIds.clear();
+    sDeliveredMessageIds.clear();
+
+    err = SystemLayer.StartTimer(kTransferTimeoutMs, HandleTransferTimeout, NULL);
+    SuccessOrExit(err);
+
+    startMs = System::Layer::GetClock_MonotonicMS();
+    startCPUUs = GetCPUTimeUs();
+
+    err = Connect();
+    if (err != WEAVE_NO_ERROR)
+    {
+        EndRun(true);
+        sRun.senderDone = true;
+    }
+
+    ServiceNetworkUntil(&sRun.receiverDone);
+
+    sRun.elapsedMs = System::Layer::GetClock_MonotonicMS() - startMs;
+    sRun.cpuUs = GetCPUTimeUs() - startCPUUs;
+
+    ServiceNetworkUntil(&sRun.senderDone);
+
+    // Deliver the messages still held back, e.g. the final acknowledgements.
+    sleepTime.tv_sec = 0;
+    sleepTime.tv_usec = 10000;
+    while (!sDelayedMessages.empty() && !sRun.timedOut)
+    {
+        ServiceNetwork(sleepTime);
+    }
+
+    SystemLayer.CancelTimer(HandleTransferTimeout, NULL);
+    DiscardDelayedMessages();
+    Disconnect();
+
+exit:
+    return err;
+}
+
+static void Report(void)
+{
+    const char *transportName = (sRun.transport == kTransport_TCP) ? "TCP" : "UDP";
+    double elapsedMs = (sRun.elapsedMs != 0) ? static_cast<double>(sRun.elapsedMs) : 1.0;
+    double megabytes = static_cast<double>(sRun.bytesReceived) / (1024 * 1024);
+    double kbPerSec = (sRun.bytesReceived / 1024.0) * 1000.0 / elapsedMs;
+    double cpuMsPerMB = (megabytes > 0) ? (sRun.cpuUs / 1000.0) / megabytes : 0.0;
+    char caseName[32];
+
+    if (sRun.failed)
+    {
+        printf("%-4s block %5u window %2u: FAILED%s after %" PRIu64 " of %d bytes\n", transportName, sRun.blockSize,
+               sRun.windowSize, sRun.timedOut ? " (timed out)" : "", sRun.bytesReceived, gTransferSize);
+        return;
+    }
+
+    printf("%-4s block %5u window %2u: %10.1f KB/s %8" PRIu64 " ms %6u msgs %6u retrans %6u dropped %8.2f ms CPU/MB\n",
+           transportName, sRun.blockSize, sRun.windowSize, kbPerSec, sRun.elapsedMs, sRun.messages, sRun.retransmissions,
+           sRun.dropped, cpuMsPerMB);
+
+    snprintf(caseName, sizeof(caseName), "%s-b%u-w%u", transportName, sRun.blockSize, sRun.windowSize);
+    gBenchmarkOptions.RecordResult("bdx", caseName, "throughput", kbPerSec, "KB/s", true);
+    gBenchmarkOptions.RecordResult("bdx", caseName, "cpu", cpuMsPerMB, "ms/MB", false);
+}
+
+static OptionDef gToolOptionDefs[] =
+{
+    { "transport",      kArgumentRequired, 't' },
+    { "block-size",     kArgumentRequired, 'b' },
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    { "window-size",    kArgumentRequired, 'w' },
+#endif
+    { "size",           kArgumentRequired, 's' },
+    { "loss",           kArgumentRequired, 'l' },
+    { "latency",        kArgumentRequired, 'L' },
+    { "reorder",        kArgumentRequired, 'r' },
+    { }
+};
+
+static const char *const gToolOptionHelp =
+    "  -t, --transport <udp|tcp>\n"
+    "       Benchmark only the transfers over the given transport: UDP with WRMP, or\n"
+    "       TCP. Defaults to both.\n"
+    "\n"
+    "  -b, --block-size <int>\n"
+    "       Benchmark only the given block size. Defaults to 256 and 1024 bytes.\n"
+    "\n"
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    "  -w, --window-size <int>\n"
+    "       Benchmark only the given window size. Defaults to 1, 4 and\n"
+    "       WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE blocks.\n"
+    "\n"
+#endif
+    "  -s, --size <int>\n"
+    "       Size of the transferred image, in bytes. Defaults to 1 MB.\n"
+    "\n"
+    "  -l, --loss <percent>\n"
+    "       Percentage of the UDP messages received that are dropped. Defaults to 0.\n"
+    "\n"
+    "  -L, --latency <ms>\n"
+    "       Delay added to every message received. Defaults to 0.\n"
+    "\n"
+    "  -r, --reorder <percent>\n"
+    "       Percentage of the UDP messages received that are held back behind the\n"
+    "       following ones. Defaults to 0.\n"
+    "\n"
+    ;
+
+static OptionSet gToolOptions =
+{
+    HandleOption,
+    gToolOptionDefs,
+    "GENERAL OPTIONS",
+    gToolOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    TOOL_NAME,
+    "Usage: " TOOL_NAME " [<options...>]\n",
+    WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+    "Throughput benchmark for BDX transfers over UDP with WRMP and TCP.\n"
+);
+
+static OptionSet *gToolOptionSets[] =
+{
+    &gToolOptions,
+    &gNetworkOptions,
+    &gWeaveNodeOptions,
+    &gFaultInjectionOptions,
+    &gBenchmarkOptions,
+    &gHelpOptions,
+    NULL
+};
+
+static bool ParsePercent(const char *arg, int32_t &percent)
+{
+    return ParseInt(arg, percent) && percent >= 0 && percent <= 100;
+}
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case 't':
+        if (strcmp(arg, "udp") == 0)
+        {
+            gTransports = kTransport_UDP;
+        }
+        else if (strcmp(arg, "tcp") == 0)
+        {
+            gTransports = kTransport_TCP;
+        }
+        else
+        {
+            PrintArgError("%s: Invalid value specified for transport: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'b':
+        if (!ParseInt(arg, gBlockSize) || gBlockSize <= 0 || gBlockSize > kMaxBlockSize)
+        {
+            PrintArgError("%s: Invalid value specified for block size: %s\n", progName, arg);
+            return false;
+        }
+        break;
+#if WEAVE_CONFIG_BDX_VERSION >= 2
+    case 'w':
+        if (!ParseInt(arg, gWindowSize) || gWindowSize <= 0 || gWindowSize > WEAVE_CONFIG_BDX_MAX_WINDOW_SIZE)
+        {
+            PrintArgError("%s: Invalid value specified for window size: %s\n", progName, arg);
+            return false;
+        }
+        break;
+#endif
+    case 's':
+        if (!ParseInt(arg, gTransferSize) || gTransferSize <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for size: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'l':
+        if (!ParsePercent(arg, gLossPercent))
+        {
+            PrintArgError("%s: Invalid value specified for loss: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'L':
+        if (!ParseInt(arg, gLatencyMs) || gLatencyMs < 0)
+        {
+            PrintArgError("%s: Invalid value specified for latency: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'r':
+        if (!ParsePercent(arg, gReorderPercent))
+        {
+            PrintArgError("%s: Invalid value specified for reorder: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  Main
+ */
+int main(int argc, char *argv[])
+{
+    WEAVE_ERROR err;
+    const uint8_t transports[] = { kTransport_UDP, kTransport_TCP };
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    tcpip_init(NULL, NULL);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    InitToolCommon();
+
+    if (!ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets) ||
+        !ResolveWeaveNetworkOptions(TOOL_NAME, gWeaveNodeOptions, gNetworkOptions))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    InitSystemLayer();
+    InitNetwork();
+    InitWeaveStack(true, true);
+
+    gBenchmarkOptions.SeedRandom();
+
+    for (size_t i = 0; i < sizeof(gBlockData); i++)
+    {
+        gBlockData[i] = static_cast<uint8_t>(i);
+    }
+
+    // Hook the delivery of the messages the node receives, to inject the network conditions.
+    sDeliverUDPMessage = MessageLayer.OnMessageReceived;
+    MessageLayer.OnMessageReceived = HandleUDPMessage;
+    MessageLayer.OnConnectionReceived = HandleConnectionReceived;
+
+    err = sServer.Init(&ExchangeMgr);
+    FAIL_ERROR(err, "BdxServer.Init failed");
+
+    err = sServer.AwaitBdxReceiveInit(ServerReceiveInitHandler);
+    FAIL_ERROR(err, "BdxServer.AwaitBdxReceiveInit failed");
+
+    err = sClient.Init(&ExchangeMgr);
+    FAIL_ERROR(err, "BdxClient.Init failed");
+
+    printf("%d byte transfers, %d%% loss, %d ms latency, %d%% reordered\n", gTransferSize, gLossPercent, gLatencyMs,
+           gReorderPercent);
+
+    for (size_t t = 0; t < sizeof(transports) / sizeof(transports[0]); t++)
+    {
+        if ((gTransports & transports[t]) == 0)
+        {
+            continue;
+        }
+
+        for (size_t b = 0; b < sizeof(sDefaultBlockSizes) / sizeof(sDefaultBlockSizes[0]); b++)
+        {
+            uint16_t blockSize = (gBlockSize != 0) ? gBlockSize : sDefaultBlockSizes[b];
+
+            for (size_t w = 0; w < sizeof(sDefaultWindowSizes) / sizeof(sDefaultWindowSizes[0]); w++)
+            {
+                uint8_t windowSize = (gWindowSize != 0) ? gWindowSize : sDefaultWindowSizes[w];
+
+                err = RunTransfer(transports[t], blockSize, windowSize);
+                FAIL_ERROR(err, "RunTransfer failed");
+
+                Report();
+
+                if (gWindowSize != 0)
+                {
+                    break;
+                }
+            }
+
+            if (gBlockSize != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    sClient.Shutdown();
+    sServer.Shutdown();
+
+    ShutdownWeaveStack();
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,458 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a throughput and latency benchmark for Weave
+ *      event logging.
+ *
+ *      Events of the schema-generated test_e_trait TestEEvent are logged
+ *      into a set of event buffers of a configurable size, one per
+ *      importance tier.  For every importance the benchmark measures the
+ *      cost of LogEvent while the events still fit in the first buffer,
+ *      and once every new event has to make room by moving or evicting
+ *      older ones.  It then measures FetchEventsSince throughput, reading
+ *      the events in packet sized chunks, with the buffers filled to
+ *      different levels.  Results are reported in nanoseconds and events
+ *      per second and can also be written as CSV for regression tracking.
+ *
+ */
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+
+#include "ToolCommon.h"
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveTLV.h>
+#include <Weave/Support/TraitEventUtils.h>
+#include <SystemLayer/SystemLayer.h>
+
+#include <Weave/Profiles/data-management/DataManagement.h>
+
+#include <nest/test/trait/TestCommon.h>
+#include <nest/test/trait/TestETrait.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/init.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+using namespace nl;
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Profiles::DataManagement;
+using namespace Schema::Nest::Test::Trait;
+
+#define TOOL_NAME "BenchEventLogging"
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+
+enum
+{
+    kNumImportanceTiers     = kImportanceType_Last - kImportanceType_First + 1,
+    kMaxBufferSize          = 65536,
+    kDefaultBufferSize      = 4096,
+    kDefaultEvents          = 20000,
+    kDefaultFetchIterations = 200,
+    kFetchChunkSize         = 1024
+};
+
+static const uint64_t kBenchNodeId = 0x18B4300001408362ULL;
+
+// Fill levels, in percent of the space available to an importance, at which fetch throughput is measured.
+static const uint32_t sFillLevels[] = { 25, 50, 75, 100 };
+
+static const char *const sImportanceNames[kNumImportanceTiers] = { "ProdCritical", "Production", "Info", "Debug" };
+
+static int32_t gBufferSize = kDefaultBufferSize;
+static int32_t gEvents = kDefaultEvents;
+static int32_t gFetchIterations = kDefaultFetchIterations;
+static const char *gCSVFileName = NULL;
+static FILE *gCSVFile = NULL;
+
+static uint64_t gEventBuffers[kNumImportanceTiers][kMaxBufferSize / sizeof(uint64_t)];
+
+static uint32_t gSamples[8] = { 1, 3, 5, 7, 11, 13, 17, 19 };
+static TestCommon::CommonStructE gStructs[3] = { { 1111111, true }, { 2222222, false }, { 3333333, true } };
+static TestETrait::TestEEvent gEvent;
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+namespace Platform {
+    // The benchmark is single-threaded, so the dummy critical section is sufficient.
+    void CriticalSectionEnter()
+    {
+        return;
+    }
+
+    void CriticalSectionExit()
+    {
+        return;
+    }
+} // Platform
+} // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+}
+}
+}
+
+SubscriptionEngine * SubscriptionEngine::GetInstance()
+{
+    static SubscriptionEngine sSubscriptionEngine;
+
+    return &sSubscriptionEngine;
+}
+
+static inline uint64_t BenchNow(void)
+{
+    return nl::Weave::System::Layer::GetClock_MonotonicHiRes();
+}
+
+static void Report(const char *bench, ImportanceType importance, uint32_t fillPercent, uint64_t events, uint64_t bytes,
+                   uint64_t elapsedUS)
+{
+    const char *importanceName = sImportanceNames[importance - kImportanceType_First];
+    double nsPerEvent = events ? (elapsedUS * 1000.0) / events : 0.0;
+    double eventsPerSec = (events * 1000000.0) / (elapsedUS ? elapsedUS : 1);
+    char caseName[48];
+
+    printf("%-12s %-12s %4u%% %10" PRIu64 " events %10.1f ns/event %12.0f events/s %8.2f MB/s\n",
+           bench, importanceName, fillPercent, events, nsPerEvent, eventsPerSec,
+           (double) bytes / (elapsedUS ? elapsedUS : 1));
+
+    if (gCSVFile != NULL)
+    {
+        fprintf(gCSVFile, "%s,%s,%d,%u,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%.1f,%.0f\n",
+                bench, importanceName, gBufferSize, fillPercent, events, bytes, elapsedUS, nsPerEvent, eventsPerSec);
+    }
+
+    snprintf(caseName, sizeof(caseName), "%s-%s-%u", bench, importanceName, fillPercent);
+    gBenchmarkOptions.RecordResult("event-logging", caseName, "time", nsPerEvent, "ns/event", false);
+}
+
+static void ResetLogging(WeaveExchangeManager *exchangeMgr)
+{
+    LogStorageResources logStorageResources[kNumImportanceTiers];
+
+    for (int i = 0; i < kNumImportanceTiers; i++)
+    {
+        logStorageResources[i].mBuffer = gEventBuffers[i];
+        logStorageResources[i].mBufferSize = gBufferSize;
+        logStorageResources[i].mCounterKey = NULL;
+        logStorageResources[i].mCounterEpoch = 0;
+        logStorageResources[i].mCounterStorage = NULL;
+        logStorageResources[i].mImportance = static_cast<ImportanceType>(kImportanceType_First + i);
+    }
+
+    LoggingManagement::DestroyLoggingManagement();
+    LoggingManagement::CreateLoggingManagement(exchangeMgr, kNumImportanceTiers, logStorageResources);
+    LoggingConfiguration::GetInstance().mGlobalImportance = kImportanceType_Last;
+}
+
+static event_id_t LogBenchEvent(ImportanceType importance)
+{
+    EventSchema schema = TestETrait::TestEEvent::Schema;
+    StructureSchemaPointerPair structureSchemaPair = { &gEvent, &TestETrait::TestEEvent::FieldSchema };
+
+    schema.mImportance = importance;
+    gEvent.teA++;
+
+    return LogEvent(schema, SerializedDataToTLVWriterHelper, &structureSchemaPair);
+}
+
+// The space that events of an importance can occupy: the buffer of that importance and those of the less important ones.
+static uint32_t CapacityForImportance(ImportanceType importance)
+{
+    return (kImportanceType_Last - importance + 1) * gBufferSize;
+}
+
+/**
+ *  Measure LogEvent for events of one importance: first while the events
+ *  fit in the first (least important) buffer, then once every event has
+ *  to make room by moving older events on to the next buffer or evicting
+ *  them.
+ */
+static WEAVE_ERROR BenchLogEvent(WeaveExchangeManager *exchangeMgr, ImportanceType importance)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    LoggingManagement *logger;
+    uint32_t eventSize;
+    uint32_t bytesBefore;
+    uint64_t start, elapsed;
+    uint64_t numEvents;
+    uint64_t numBytes;
+
+    ResetLogging(exchangeMgr);
+    logger = &LoggingManagement::GetInstance();
+
+    // Log one event to learn how much space each event takes.
+    VerifyOrExit(LogBenchEvent(importance) != 0, err = WEAVE_ERROR_NO_MEMORY);
+    eventSize = logger->GetBytesWritten();
+
+    // Only a few events fit in the first buffer, so fill it over and over until as many events as in the
+    // second phase have been logged.
+    numEvents = 0;
+    numBytes = 0;
+    elapsed = 0;
+    while (numEvents < static_cast<uint64_t>(gEvents))
+    {
+        ResetLogging(exchangeMgr);
+
+        start = BenchNow();
+        while (logger->GetBytesWritten() + eventSize <= static_cast<uint32_t>(gBufferSize))
+        {
+            LogBenchEvent(importance);
+            numEvents++;
+        }
+        elapsed += BenchNow() - start;
+        numBytes += logger->GetBytesWritten();
+    }
+    Report("log", importance, 0, numEvents, numBytes, elapsed);
+
+    bytesBefore = logger->GetBytesWritten();
+    start = BenchNow();
+    for (numEvents = 0; numEvents < static_cast<uint64_t>(gEvents); numEvents++)
+    {
+        LogBenchEvent(importance);
+    }
+    elapsed = BenchNow() - start;
+    Report("log+evict", importance, 100, numEvents, logger->GetBytesWritten() - bytesBefore, elapsed);
+
+exit:
+    return err;
+}
+
+/**
+ *  Measure FetchEventsSince for events of one importance, with the space
+ *  available to them filled to `fillPercent`.  All events are read, from
+ *  the oldest one, in chunks of kFetchChunkSize bytes.
+ */
+static WEAVE_ERROR BenchFetch(WeaveExchangeManager *exchangeMgr, ImportanceType importance, uint32_t fillPercent)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    LoggingManagement *logger;
+    static uint8_t chunk[kFetchChunkSize];
+    uint32_t fillBytes = CapacityForImportance(importance) / 100 * fillPercent;
+    uint64_t numEvents = 0;
+    uint64_t numBytes = 0;
+    uint64_t start;
+
+    ResetLogging(exchangeMgr);
+    logger = &LoggingManagement::GetInstance();
+
+    while (logger->GetBytesWritten() < fillBytes)
+    {
+        VerifyOrExit(LogBenchEvent(importance) != 0, err = WEAVE_ERROR_NO_MEMORY);
+    }
+
+    start = BenchNow();
+    for (int32_t i = 0; i < gFetchIterations; i++)
+    {
+        EventFetchCursor cursor;
+        event_id_t eventId = logger->GetFirstEventID(importance);
+        event_id_t firstEventId = eventId;
+
+        do
+        {
+            TLVWriter writer;
+            event_id_t chunkStart = eventId;
+
+            writer.Init(chunk, sizeof(chunk));
+            err = logger->FetchEventsSince(writer, importance, eventId, &cursor);
+            numBytes += writer.GetLengthWritten();
+
+            // A chunk too small for a single event would never make progress.
+            VerifyOrExit(eventId != chunkStart || err == WEAVE_END_OF_TLV || err == WEAVE_NO_ERROR,
+                         err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+        } while (err == WEAVE_ERROR_BUFFER_TOO_SMALL || err == WEAVE_ERROR_NO_MEMORY);
+
+        VerifyOrExit(err == WEAVE_END_OF_TLV || err == WEAVE_NO_ERROR, );
+        err = WEAVE_NO_ERROR;
+
+        numEvents += eventId - firstEventId;
+    }
+    Report("fetch", importance, fillPercent, numEvents, numBytes, BenchNow() - start);
+
+exit:
+    return err;
+}
+
+static OptionDef gToolOptionDefs[] =
+{
+    { "buffer-size",    kArgumentRequired, 'b' },
+    { "events",         kArgumentRequired, 'e' },
+    { "fetches",        kArgumentRequired, 'f' },
+    { "csv",            kArgumentRequired, 'C' },
+    { }
+};
+
+static const char *const gToolOptionHelp =
+    "  -b, --buffer-size <int>\n"
+    "       Size in bytes of the event buffer of each importance tier. Defaults to\n"
+    "       4096, at most 65536.\n"
+    "\n"
+    "  -e, --events <int>\n"
+    "       Number of events logged, per importance, once the buffers are full.\n"
+    "       Defaults to 20000.\n"
+    "\n"
+    "  -f, --fetches <int>\n"
+    "       Number of times the whole log is fetched at each fill level. Defaults\n"
+    "       to 200.\n"
+    "\n"
+    "  -C, --csv <file>\n"
+    "       Also write the results to <file> as comma separated values.\n"
+    "\n"
+    ;
+
+static OptionSet gToolOptions =
+{
+    HandleOption,
+    gToolOptionDefs,
+    "GENERAL OPTIONS",
+    gToolOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    TOOL_NAME,
+    "Usage: " TOOL_NAME " [<options...>]\n",
+    WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+    "Throughput and latency benchmark for Weave event logging.\n"
+);
+
+static OptionSet *gToolOptionSets[] =
+{
+    &gToolOptions,
+    &gBenchmarkOptions,
+    &gHelpOptions,
+    NULL
+};
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case 'b':
+        if (!ParseInt(arg, gBufferSize) || gBufferSize < kFetchChunkSize || gBufferSize > kMaxBufferSize)
+        {
+            PrintArgError("%s: Invalid value specified for buffer size: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'e':
+        if (!ParseInt(arg, gEvents) || gEvents <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for events: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'f':
+        if (!ParseInt(arg, gFetchIterations) || gFetchIterations <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for fetches: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'C':
+        gCSVFileName = arg;
+        break;
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  Main
+ */
+int main(int argc, char *argv[])
+{
+    WEAVE_ERROR err;
+    static WeaveFabricState sFabricState;
+    static WeaveExchangeManager sExchangeMgr;
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    tcpip_init(NULL, NULL);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    if (!ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    // Event logging only needs an exchange manager with a fabric state that holds the node ID.
+    err = sFabricState.Init();
+    FAIL_ERROR(err, "WeaveFabricState.Init failed");
+
+    sFabricState.LocalNodeId = kBenchNodeId;
+    sExchangeMgr.FabricState = &sFabricState;
+    sExchangeMgr.State       = WeaveExchangeManager::kState_Initialized;
+
+    if (gCSVFileName != NULL)
+    {
+        gCSVFile = fopen(gCSVFileName, "w");
+        if (gCSVFile == NULL)
+        {
+            fprintf(stderr, "%s: Unable to open %s\n", TOOL_NAME, gCSVFileName);
+            exit(EXIT_FAILURE);
+        }
+        fprintf(gCSVFile, "benchmark,importance,buffer_size,fill_percent,events,bytes,elapsed_us,ns_per_event,events_per_sec\n");
+    }
+
+    memset(&gEvent, 0, sizeof(gEvent));
+    gEvent.teB     = -555555;
+    gEvent.teC     = true;
+    gEvent.teD     = -666666;
+    gEvent.teE.seA = 777777;
+    gEvent.teE.seC = -888888;
+    gEvent.teF     = 999999;
+    gEvent.teG.seA = 101010;
+    gEvent.teG.seB = true;
+    gEvent.teH.num = sizeof(gSamples) / sizeof(gSamples[0]);
+    gEvent.teH.buf = gSamples;
+    gEvent.teI.num = sizeof(gStructs) / sizeof(gStructs[0]);
+    gEvent.teI.buf = gStructs;
+    gEvent.teJ     = 12121;
+
+    printf("%s: %d byte buffers, %d events, %d fetches, %d byte fetch chunks\n", TOOL_NAME, gBufferSize, gEvents,
+           gFetchIterations, kFetchChunkSize);
+
+    for (int i = kImportanceType_First; i <= kImportanceType_Last; i++)
+    {
+        err = BenchLogEvent(&sExchangeMgr, static_cast<ImportanceType>(i));
+        FAIL_ERROR(err, "LogEvent benchmark failed");
+    }
+
+    for (int i = kImportanceType_First; i <= kImportanceType_Last; i++)
+    {
+        for (size_t j = 0; j < sizeof(sFillLevels) / sizeof(sFillLevels[0]); j++)
+        {
+            err = BenchFetch(&sExchangeMgr, static_cast<ImportanceType>(i), sFillLevels[j]);
+            FAIL_ERROR(err, "FetchEventsSince benchmark failed");
+        }
+    }
+
+    LoggingManagement::DestroyLoggingManagement();
+
+    if (gCSVFile != NULL)
+    {
+        fclose(gCSVFile);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,790 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements benchmarks for the Weave message layer, WRMP
+ *      and CASE session establishment.
+ *
+ *      The message benchmark encodes and decodes messages in memory, for
+ *      a set of payload sizes and each message encryption type.  The WRMP
+ *      benchmark runs echo exchanges one after the other between a client
+ *      and an echo server of the same node, over the loopback interface,
+ *      with and without WRMP, and reports the round trip times.  The CASE
+ *      benchmark runs complete CASE handshakes between two engines in
+ *      memory, for each CASE configuration and curve.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include "ToolCommon.h"
+#include "CASEOptions.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Profiles/echo/WeaveEcho.h>
+#include <Weave/Profiles/security/WeaveCASE.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/init.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+using namespace nl::Weave::Profiles::Security;
+using namespace nl::Weave::Profiles::Security::CASE;
+using nl::Weave::System::PacketBuffer;
+
+#define TOOL_NAME "BenchMessaging"
+
+namespace nl {
+namespace Weave {
+
+class NL_DLL_EXPORT WeaveMessageLayerTestObject
+{
+public:
+    WeaveMessageLayer *msgLayer;
+
+    WEAVE_ERROR DecodeMessage(PacketBuffer *msgBuf, uint64_t sourceNodeId, WeaveConnection *con,
+            WeaveMessageInfo *msgInfo, uint8_t **rPayload, uint16_t *rPayloadLen)
+    {
+        return msgLayer->DecodeMessage(msgBuf, sourceNodeId, con, msgInfo, rPayload, rPayloadLen);
+    }
+};
+
+} // namespace Weave
+} // namespace nl
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+
+enum
+{
+    kBenchmark_Message          = 0x01,
+    kBenchmark_WRMP             = 0x02,
+    kBenchmark_CASE             = 0x04,
+
+    kDefaultMessages            = 20000,
+    kDefaultExchanges           = 1000,
+    kDefaultHandshakes          = 50,
+    kDefaultEchoPayloadSize     = 64,
+
+    kMessageBatchSize           = 64,           // Messages encoded, then decoded, per timed batch
+    kSessionKeyNumBase          = 100,          // First session key number used by the message benchmark
+    kResponseTimeoutMs          = 5000
+};
+
+// The payload sizes benchmarked by the message benchmark.
+static const uint16_t sPayloadSizes[] = { 64, 512, 1024 };
+
+struct EncryptionCase
+{
+    const char *Name;
+    uint8_t EncryptionType;
+};
+
+static const EncryptionCase sEncryptionCases[] =
+{
+    { "none",           kWeaveEncryptionType_None           },
+    { "aes128ctrsha1",  kWeaveEncryptionType_AES128CTRSHA1  },
+    { "aes128ccm",      kWeaveEncryptionType_AES128CCM      },
+};
+
+struct CASECase
+{
+    const char *Name;
+    uint32_t Config;
+    uint32_t CurveId;
+};
+
+static const CASECase sCASECases[] =
+{
+#if WEAVE_CONFIG_SUPPORT_CASE_CONFIG1
+    { "config1-prime256v1", kCASEConfig_Config1, kWeaveCurveId_prime256v1 },
+#endif
+    { "config2-prime256v1", kCASEConfig_Config2, kWeaveCurveId_prime256v1 },
+#if WEAVE_CONFIG_SUPPORT_ELLIPTIC_CURVE_SECP224R1
+    { "config2-secp224r1",  kCASEConfig_Config2, kWeaveCurveId_secp224r1  },
+#endif
+};
+
+static uint8_t gBenchmarks = kBenchmark_Message | kBenchmark_WRMP | kBenchmark_CASE;
+static int32_t gMessages = kDefaultMessages;
+static int32_t gExchanges = kDefaultExchanges;
+static int32_t gHandshakes = kDefaultHandshakes;
+static int32_t gEchoPayloadSize = kDefaultEchoPayloadSize;
+
+/**
+ *  The state and results of one run of echo exchanges.
+ */
+struct ExchangeRun
+{
+    bool done;
+    bool failed;
+    int32_t remaining;
+    uint64_t sentAt;
+    std::vector<uint32_t> rttsUS;
+};
+
+static ExchangeRun sRun;
+static Binding *sBinding = NULL;
+static WeaveEchoServer sEchoServer;
+
+static inline uint64_t BenchNow(void)
+{
+    return nl::Weave::System::Layer::GetClock_MonotonicHiRes();
+}
+
+static uint32_t Percentile(const std::vector<uint32_t> &aSorted, uint32_t aPercent)
+{
+    size_t index;
+
+    if (aSorted.empty())
+        return 0;
+
+    index = (aSorted.size() * aPercent) / 100;
+    if (index >= aSorted.size())
+        index = aSorted.size() - 1;
+
+    return aSorted[index];
+}
+
+// ==================== Message Encoding ====================
+
+static WEAVE_ERROR SetupSessionKeys(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveEncryptionKey key;
+    WeaveSessionKey *sessionKey;
+
+    // Messages are sent to the local node, so one key serves both the encoding and the decoding side.
+    for (size_t i = 0; i < sizeof(sEncryptionCases) / sizeof(sEncryptionCases[0]); i++)
+    {
+        if (sEncryptionCases[i].EncryptionType == kWeaveEncryptionType_None)
+            continue;
+
+        memset(&key, static_cast<int>(0xA0 + i), sizeof(key));
+
+        err = FabricState.AllocSessionKey(FabricState.LocalNodeId, WeaveKeyId::MakeSessionKeyId(kSessionKeyNumBase + i),
+                                          NULL, sessionKey);
+        SuccessOrExit(err);
+
+        err = FabricState.SetSessionKey(sessionKey, sEncryptionCases[i].EncryptionType, kWeaveAuthMode_CASE_Device, &key);
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+/**
+ *  Encode, then decode, the given number of messages in batches, timing the encoding and the decoding separately.
+ */
+static WEAVE_ERROR BenchMessageCase(size_t encCase, uint16_t payloadSize)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    WeaveMessageLayerTestObject msgLayerTestObject;
+    PacketBuffer *bufs[kMessageBatchSize] = { NULL };
+    uint64_t encodeUS = 0;
+    uint64_t decodeUS = 0;
+    uint64_t start;
+    int32_t count = 0;
+    char caseName[32];
+
+    msgLayerTestObject.msgLayer = &MessageLayer;
+
+    while (count < gMessages)
+    {
+        int32_t batch = std::min<int32_t>(kMessageBatchSize, gMessages - count);
+        WeaveMessageInfo msgInfo;
+
+        for (int32_t i = 0; i < batch; i++)
+        {
+            bufs[i] = PacketBuffer::New();
+            VerifyOrExit(bufs[i] != NULL, err = WEAVE_ERROR_NO_MEMORY);
+            VerifyOrExit(bufs[i]->AvailableDataLength() >= payloadSize, err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+            memset(bufs[i]->Start(), static_cast<int>(i), payloadSize);
+            bufs[i]->SetDataLength(payloadSize);
+        }
+
+        start = BenchNow();
+        for (int32_t i = 0; i < batch; i++)
+        {
+            msgInfo.Clear();
+            msgInfo.SourceNodeId = FabricState.LocalNodeId;
+            msgInfo.DestNodeId = FabricState.LocalNodeId;
+            msgInfo.Flags = kWeaveMessageFlag_DestNodeId | kWeaveMessageFlag_SourceNodeId;
+            msgInfo.MessageVersion = kWeaveMessageVersion_V2;
+            msgInfo.EncryptionType = sEncryptionCases[encCase].EncryptionType;
+            msgInfo.KeyId = (msgInfo.EncryptionType == kWeaveEncryptionType_None) ? static_cast<uint16_t>(WeaveKeyId::kNone) :
+                WeaveKeyId::MakeSessionKeyId(kSessionKeyNumBase + encCase);
+
+            err = MessageLayer.EncodeMessage(&msgInfo, bufs[i], NULL, UINT16_MAX, 0);
+            SuccessOrExit(err);
+        }
+        encodeUS += BenchNow() - start;
+
+        start = BenchNow();
+        for (int32_t i = 0; i < batch; i++)
+        {
+            uint8_t *payload;
+            uint16_t payloadLen;
+
+            msgInfo.Clear();
+
+            err = msgLayerTestObject.DecodeMessage(bufs[i], FabricState.LocalNodeId, NULL, &msgInfo, &payload, &payloadLen);
+            SuccessOrExit(err);
+        }
+        decodeUS += BenchNow() - start;
+
+        for (int32_t i = 0; i < batch; i++)
+        {
+            PacketBuffer::Free(bufs[i]);
+            bufs[i] = NULL;
+        }
+
+        count += batch;
+    }
+
+    printf("message  %-14s %5u bytes: %10.1f ns/encode %10.1f ns/decode\n", sEncryptionCases[encCase].Name, payloadSize,
+           (encodeUS * 1000.0) / count, (decodeUS * 1000.0) / count);
+
+    snprintf(caseName, sizeof(caseName), "%s-%u", sEncryptionCases[encCase].Name, payloadSize);
+    gBenchmarkOptions.RecordResult("message", caseName, "encode", (encodeUS * 1000.0) / count, "ns/msg", false);
+    gBenchmarkOptions.RecordResult("message", caseName, "decode", (decodeUS * 1000.0) / count, "ns/msg", false);
+
+exit:
+    for (int32_t i = 0; i < kMessageBatchSize; i++)
+    {
+        if (bufs[i] != NULL)
+            PacketBuffer::Free(bufs[i]);
+    }
+
+    return err;
+}
+
+static WEAVE_ERROR BenchMessage(void)
+{
+    WEAVE_ERROR err;
+
+    err = SetupSessionKeys();
+    SuccessOrExit(err);
+
+    for (size_t e = 0; e < sizeof(sEncryptionCases) / sizeof(sEncryptionCases[0]); e++)
+    {
+        for (size_t p = 0; p < sizeof(sPayloadSizes) / sizeof(sPayloadSizes[0]); p++)
+        {
+            err = BenchMessageCase(e, sPayloadSizes[p]);
+            SuccessOrExit(err);
+        }
+    }
+
+exit:
+    return err;
+}
+
+// ==================== WRMP ====================
+
+static void EndRun(bool failed)
+{
+    sRun.failed = sRun.failed || failed;
+    sRun.done = true;
+}
+
+static void HandleEchoResponse(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
+                               uint32_t profileId, uint8_t msgType, PacketBuffer *payload);
+static void HandleResponseTimeout(ExchangeContext *ec);
+
+static void SendEchoRequest(void)
+{
+    WEAVE_ERROR err;
+    ExchangeContext *ec = NULL;
+    PacketBuffer *payload;
+
+    err = sBinding->NewExchangeContext(ec);
+    SuccessOrExit(err);
+
+    ec->OnMessageReceived = HandleEchoResponse;
+    ec->OnResponseTimeout = HandleResponseTimeout;
+    ec->ResponseTimeout = kResponseTimeoutMs;
+
+    payload = PacketBuffer::New();
+    VerifyOrExit(payload != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    memset(payload->Start(), 0, gEchoPayloadSize);
+    payload->SetDataLength(gEchoPayloadSize);
+
+    sRun.sentAt = BenchNow();
+
+    // Over a UDP_WRM binding the exchange requests acknowledgments automatically.
+    err = ec->SendMessage(kWeaveProfile_Echo, kEchoMessageType_EchoRequest, payload, ExchangeContext::kSendFlag_ExpectResponse);
+    SuccessOrExit(err);
+
+exit:
+    if (err != WEAVE_NO_ERROR)
+    {
+        printf("Failed to send echo request: %s\n", ErrorStr(err));
+        if (ec != NULL)
+            ec->Abort();
+        EndRun(true);
+    }
+}
+
+static void HandleEchoResponse(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo,
+                               uint32_t profileId, uint8_t msgType, PacketBuffer *payload)
+{
+    uint64_t now = BenchNow();
+
+    PacketBuffer::Free(payload);
+    ec->Close();
+
+    if (profileId != kWeaveProfile_Echo || msgType != kEchoMessageType_EchoResponse)
+    {
+        printf("Received unexpected message %08" PRIX32 ":%u\n", profileId, msgType);
+        EndRun(true);
+        return;
+    }
+
+    sRun.rttsUS.push_back(static_cast<uint32_t>(now - sRun.sentAt));
+
+    if (--sRun.remaining > 0)
+        SendEchoRequest();
+    else
+        EndRun(false);
+}
+
+static void HandleResponseTimeout(ExchangeContext *ec)
+{
+    printf("Echo response timed out\n");
+    ec->Abort();
+    EndRun(true);
+}
+
+static void HandleBindingEvent(void *const appState, const Binding::EventType event, const Binding::InEventParam &inParam,
+                               Binding::OutEventParam &outParam)
+{
+    switch (event)
+    {
+    case Binding::kEvent_BindingReady:
+        SendEchoRequest();
+        break;
+
+    case Binding::kEvent_PrepareFailed:
+        printf("Binding prepare failed: %s\n", ErrorStr(inParam.PrepareFailed.Reason));
+        EndRun(true);
+        break;
+
+    default:
+        Binding::DefaultEventHandler(appState, event, inParam, outParam);
+    }
+}
+
+/**
+ *  Run the given number of echo exchanges one after the other, over UDP with or without WRMP.
+ */
+static WEAVE_ERROR BenchExchanges(bool useWRMP)
+{
+    WEAVE_ERROR err;
+    const char *caseName = useWRMP ? "udp-wrm" : "udp";
+    IPAddress loopbackAddr;
+    uint64_t start;
+    uint64_t elapsedUS;
+    double exchangesPerSec;
+
+    IPAddress::FromString("::1", loopbackAddr);
+
+    sRun.done = false;
+    sRun.failed = false;
+    sRun.remaining = gExchanges;
+    sRun.rttsUS.clear();
+    sRun.rttsUS.reserve(gExchanges);
+
+    sBinding = ExchangeMgr.NewBinding(HandleBindingEvent, NULL);
+    VerifyOrExit(sBinding != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    start = BenchNow();
+
+    if (useWRMP)
+    {
+        err = sBinding->BeginConfiguration()
+            .Target_NodeId(FabricState.LocalNodeId)
+            .TargetAddress_IP(loopbackAddr)
+            .Transport_UDP_WRM()
+            .Security_None()
+            .PrepareBinding();
+    }
+    else
+    {
+        err = sBinding->BeginConfiguration()
+            .Target_NodeId(FabricState.LocalNodeId)
+            .TargetAddress_IP(loopbackAddr)
+            .Transport_UDP()
+            .Security_None()
+            .PrepareBinding();
+    }
+    SuccessOrExit(err);
+
+    ServiceNetworkUntil(&sRun.done);
+
+    elapsedUS = BenchNow() - start;
+
+    VerifyOrExit(!sRun.failed, err = WEAVE_ERROR_TIMEOUT);
+
+    std::sort(sRun.rttsUS.begin(), sRun.rttsUS.end());
+    exchangesPerSec = (sRun.rttsUS.size() * 1000000.0) / (elapsedUS ? elapsedUS : 1);
+
+    printf("wrmp     %-8s %5d bytes: %10u us p50 %10u us p99 %10.0f exchanges/s\n", caseName, gEchoPayloadSize,
+           Percentile(sRun.rttsUS, 50), Percentile(sRun.rttsUS, 99), exchangesPerSec);
+
+    gBenchmarkOptions.RecordResult("wrmp", caseName, "rtt-p50", Percentile(sRun.rttsUS, 50), "us", false);
+    gBenchmarkOptions.RecordResult("wrmp", caseName, "rtt-p99", Percentile(sRun.rttsUS, 99), "us", false);
+    gBenchmarkOptions.RecordResult("wrmp", caseName, "throughput", exchangesPerSec, "exchanges/s", true);
+
+exit:
+    if (sBinding != NULL)
+    {
+        sBinding->Release();
+        sBinding = NULL;
+    }
+
+    return err;
+}
+
+static WEAVE_ERROR BenchWRMP(void)
+{
+    WEAVE_ERROR err;
+
+    err = sEchoServer.Init(&ExchangeMgr);
+    SuccessOrExit(err);
+
+    err = BenchExchanges(false);
+    SuccessOrExit(err);
+
+    err = BenchExchanges(true);
+    SuccessOrExit(err);
+
+exit:
+    sEchoServer.Shutdown();
+
+    return err;
+}
+
+// ==================== CASE ====================
+
+static void InitCASEEngine(WeaveCASEEngine &engine)
+{
+    engine.Init();
+    engine.AuthDelegate = &gCASEOptions;
+    engine.SetAllowedConfigs(kCASEAllowedConfig_Mask);
+    engine.SetAllowedCurves(kWeaveCurveSet_All);
+}
+
+/**
+ *  Run one complete CASE handshake, with key confirmation, between two engines of the local node.
+ */
+static WEAVE_ERROR RunHandshake(const CASECase &aCase)
+{
+    WEAVE_ERROR err;
+    WeaveCASEEngine initiatorEng;
+    WeaveCASEEngine responderEng;
+    PacketBuffer *msgBuf = NULL;
+    PacketBuffer *msgBuf2 = NULL;
+
+    InitCASEEngine(initiatorEng);
+    InitCASEEngine(responderEng);
+    responderEng.SetResponderRequiresKeyConfirm(true);
+
+    // Initiator forms BeginSessionRequest.
+    {
+        BeginSessionRequestContext req;
+
+        req.Reset();
+        req.ProtocolConfig = aCase.Config;
+        req.CurveId = aCase.CurveId;
+        req.SetPerformKeyConfirm(true);
+        req.SessionKeyId = sTestDefaultSessionKeyId;
+        req.EncryptionType = kWeaveEncryptionType_AES128CTRSHA1;
+
+        msgBuf = PacketBuffer::New();
+        VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        err = initiatorEng.GenerateBeginSessionRequest(req, msgBuf);
+        SuccessOrExit(err);
+    }
+
+    // Responder processes BeginSessionRequest and forms BeginSessionResponse.
+    {
+        BeginSessionRequestContext req;
+        BeginSessionResponseContext resp;
+        ReconfigureContext reconf;
+
+        req.Reset();
+        req.PeerNodeId = FabricState.LocalNodeId;
+        reconf.Reset();
+
+        err = responderEng.ProcessBeginSessionRequest(msgBuf, req, reconf);
+        SuccessOrExit(err);
+
+        PacketBuffer::Free(msgBuf);
+        msgBuf = NULL;
+
+        resp.Reset();
+        resp.PeerNodeId = FabricState.LocalNodeId;
+        resp.ProtocolConfig = req.ProtocolConfig;
+        resp.CurveId = req.CurveId;
+
+        msgBuf2 = PacketBuffer::New();
+        VerifyOrExit(msgBuf2 != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+        err = responderEng.GenerateBeginSessionResponse(resp, msgBuf2, req);
+        SuccessOrExit(err);
+    }
+
+    // Initiator processes BeginSessionResponse.
+    {
+        BeginSessionResponseContext resp;
+
+        resp.Reset();
+        resp.PeerNodeId = FabricState.LocalNodeId;
+
+        err = initiatorEng.ProcessBeginSessionResponse(msgBuf2, resp);
+        SuccessOrExit(err);
+
+        PacketBuffer::Free(msgBuf2);
+        msgBuf2 = NULL;
+    }
+
+    // Initiator confirms the key.
+    msgBuf = PacketBuffer::New();
+    VerifyOrExit(msgBuf != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = initiatorEng.GenerateInitiatorKeyConfirm(msgBuf);
+    SuccessOrExit(err);
+
+    err = responderEng.ProcessInitiatorKeyConfirm(msgBuf);
+    SuccessOrExit(err);
+
+    VerifyOrExit(initiatorEng.State == WeaveCASEEngine::kState_Complete &&
+                 responderEng.State == WeaveCASEEngine::kState_Complete, err = WEAVE_ERROR_INCORRECT_STATE);
+
+exit:
+    PacketBuffer::Free(msgBuf);
+    PacketBuffer::Free(msgBuf2);
+
+    initiatorEng.Shutdown();
+    responderEng.Shutdown();
+
+    return err;
+}
+
+static WEAVE_ERROR BenchCASE(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    for (size_t c = 0; c < sizeof(sCASECases) / sizeof(sCASECases[0]); c++)
+    {
+        uint64_t start = BenchNow();
+        double usPerHandshake;
+
+        for (int32_t i = 0; i < gHandshakes; i++)
+        {
+            err = RunHandshake(sCASECases[c]);
+            SuccessOrExit(err);
+        }
+
+        usPerHandshake = static_cast<double>(BenchNow() - start) / gHandshakes;
+
+        printf("case     %-22s: %10.0f us/handshake\n", sCASECases[c].Name, usPerHandshake);
+
+        gBenchmarkOptions.RecordResult("case", sCASECases[c].Name, "handshake", usPerHandshake, "us", false);
+    }
+
+exit:
+    return err;
+}
+
+static OptionDef gToolOptionDefs[] =
+{
+    { "benchmark",      kArgumentRequired, 'B' },
+    { "messages",       kArgumentRequired, 'm' },
+    { "exchanges",      kArgumentRequired, 'e' },
+    { "handshakes",     kArgumentRequired, 'H' },
+    { "payload-size",   kArgumentRequired, 'p' },
+    { }
+};
+
+static const char *const gToolOptionHelp =
+    "  -B, --benchmark <message|wrmp|case>\n"
+    "       Run only the given benchmark. Defaults to all three.\n"
+    "\n"
+    "  -m, --messages <int>\n"
+    "       Number of messages encoded and decoded for each payload size and\n"
+    "       encryption type. Defaults to 20000.\n"
+    "\n"
+    "  -e, --exchanges <int>\n"
+    "       Number of echo exchanges run with and without WRMP. Defaults to 1000.\n"
+    "\n"
+    "  -H, --handshakes <int>\n"
+    "       Number of CASE handshakes run for each configuration and curve.\n"
+    "       Defaults to 50.\n"
+    "\n"
+    "  -p, --payload-size <int>\n"
+    "       Size of the echo request payloads, in bytes. Defaults to 64.\n"
+    "\n"
+    ;
+
+static OptionSet gToolOptions =
+{
+    HandleOption,
+    gToolOptionDefs,
+    "GENERAL OPTIONS",
+    gToolOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    TOOL_NAME,
+    "Usage: " TOOL_NAME " [<options...>]\n",
+    WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+    "Benchmarks for Weave message encoding, WRMP exchanges and CASE handshakes.\n"
+);
+
+static OptionSet *gToolOptionSets[] =
+{
+    &gToolOptions,
+    &gNetworkOptions,
+    &gWeaveNodeOptions,
+    &gCASEOptions,
+    &gBenchmarkOptions,
+    &gHelpOptions,
+    NULL
+};
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case 'B':
+        if (strcmp(arg, "message") == 0)
+        {
+            gBenchmarks = kBenchmark_Message;
+        }
+        else if (strcmp(arg, "wrmp") == 0)
+        {
+            gBenchmarks = kBenchmark_WRMP;
+        }
+        else if (strcmp(arg, "case") == 0)
+        {
+            gBenchmarks = kBenchmark_CASE;
+        }
+        else
+        {
+            PrintArgError("%s: Invalid value specified for benchmark: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'm':
+        if (!ParseInt(arg, gMessages) || gMessages <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for messages: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'e':
+        if (!ParseInt(arg, gExchanges) || gExchanges <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for exchanges: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'H':
+        if (!ParseInt(arg, gHandshakes) || gHandshakes <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for handshakes: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'p':
+        if (!ParseInt(arg, gEchoPayloadSize) || gEchoPayloadSize <= 0 || gEchoPayloadSize > 1024)
+        {
+            PrintArgError("%s: Invalid value specified for payload size: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  Main
+ */
+int main(int argc, char *argv[])
+{
+    WEAVE_ERROR err;
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    tcpip_init(NULL, NULL);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    InitToolCommon();
+
+    // Default to a node with a test certificate, which the CASE benchmark authenticates with.
+    gWeaveNodeOptions.LocalNodeId = TestDevice1_NodeId;
+
+    if (!ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets) ||
+        !ResolveWeaveNetworkOptions(TOOL_NAME, gWeaveNodeOptions, gNetworkOptions))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    InitSystemLayer();
+    InitNetwork();
+    InitWeaveStack(true, true);
+
+    gBenchmarkOptions.SeedRandom();
+
+    if (gBenchmarks & kBenchmark_Message)
+    {
+        err = BenchMessage();
+        FAIL_ERROR(err, "Message benchmark failed");
+    }
+
+    if (gBenchmarks & kBenchmark_WRMP)
+    {
+        err = BenchWRMP();
+        FAIL_ERROR(err, "WRMP benchmark failed");
+    }
+
+    if (gBenchmarks & kBenchmark_CASE)
+    {
+        err = BenchCASE();
+        FAIL_ERROR(err, "CASE benchmark failed");
+    }
+
+    ShutdownWeaveStack();
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,808 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements micro-benchmarks for the Weave TLV reader,
+ *      writer, updater and circular buffer implementations.
+ *
+ *      Each benchmark is run over a set of representative payloads (a WDM
+ *      notify request, an event envelope and a Weave certificate) and, where
+ *      applicable, over both a single contiguous buffer and a chain of small
+ *      PacketBuffers.  Results are reported in nanoseconds per TLV element
+ *      and megabytes per second.
+ *
+ */
+
+#include "ToolCommon.h"
+#include "TestWeaveCertData.h"
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveTLV.h>
+#include <Weave/Core/WeaveCircularTLVBuffer.h>
+#include <SystemLayer/SystemLayer.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/init.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+using namespace nl;
+using namespace nl::Weave::TLV;
+using namespace nl::TestCerts;
+using nl::Weave::System::PacketBuffer;
+
+#define TOOL_NAME "BenchTLV"
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+
+enum
+{
+    kMaxPayloadSize         = 1024,
+    kMaxPayloadElements     = 128,
+    kMaxNestingDepth        = 16,
+    kCircularBufferSize     = 4096,
+    kDefaultIterations      = 10000,
+    kDefaultSegmentSize     = 128
+};
+
+enum
+{
+    kWeaveProfile_Bench     = 0x235A0001
+};
+
+/**
+ *  A single TLV element of a payload, captured so that the payload can be
+ *  re-encoded without the cost of decoding it.  Elements with a type of
+ *  kTLVType_NotSpecified mark the end of the enclosing container.
+ */
+struct BenchElement
+{
+    uint64_t Tag;
+    TLVType Type;
+    union
+    {
+        int64_t SInt;
+        uint64_t UInt;
+        double Float;
+        bool Bool;
+    } Value;
+    const uint8_t *Data;
+    uint32_t DataLen;
+};
+
+struct BenchPayload
+{
+    const char *Name;
+    uint8_t Encoding[kMaxPayloadSize];
+    uint32_t EncodingLen;
+    BenchElement Elements[kMaxPayloadElements];
+    uint32_t ElementCount;      // Number of entries in Elements, including end-of-container markers.
+    uint32_t TLVElementCount;   // Number of TLV elements in the encoding.
+};
+
+static int32_t gIterations = kDefaultIterations;
+static int32_t gSegmentSize = kDefaultSegmentSize;
+
+static BenchPayload gPayloads[3];
+static uint32_t gNumPayloads = 0;
+
+static inline uint64_t BenchNow(void)
+{
+    return nl::Weave::System::Layer::GetClock_MonotonicHiRes();
+}
+
+static void Report(const BenchPayload &payload, const char *op, const char *backing, uint64_t elapsedUS,
+                   int32_t iterations, uint32_t elemsPerIter, uint32_t bytesPerIter)
+{
+    double totalElems = (double) elemsPerIter * iterations;
+    double totalBytes = (double) bytesPerIter * iterations;
+    double nsPerElem;
+    char caseName[64];
+
+    if (elapsedUS == 0)
+        elapsedUS = 1;
+
+    nsPerElem = (elapsedUS * 1000.0) / totalElems;
+
+    printf("%-12s %-16s %-12s %10.1f ns/elem %10.2f MB/s\n",
+           payload.Name, op, backing,
+           nsPerElem,
+           totalBytes / elapsedUS);
+
+    snprintf(caseName, sizeof(caseName), "%s-%s-%s", payload.Name, op, backing);
+    gBenchmarkOptions.RecordResult("tlv", caseName, "time", nsPerElem, "ns/elem", false);
+}
+
+// ==================== Payload Construction ====================
+
+static WEAVE_ERROR EncodeNotifyPayload(TLVWriter &writer)
+{
+    WEAVE_ERROR err;
+    TLVType outerContainer, dataList, dataElement, path, instanceLocator, data;
+    static const char *const sNames[] = { "Living Room", "Kitchen", "Hallway", "Bedroom" };
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainer);
+    SuccessOrExit(err);
+
+    // SubscriptionId
+    err = writer.Put(ContextTag(1), (uint64_t) 0x18B4300000012345ULL);
+    SuccessOrExit(err);
+
+    // DataList
+    err = writer.StartContainer(ContextTag(2), kTLVType_Array, dataList);
+    SuccessOrExit(err);
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        err = writer.StartContainer(AnonymousTag, kTLVType_Structure, dataElement);
+        SuccessOrExit(err);
+
+        // Path
+        err = writer.StartContainer(ContextTag(1), kTLVType_Path, path);
+        SuccessOrExit(err);
+
+        err = writer.StartContainer(ContextTag(1), kTLVType_Structure, instanceLocator);
+        SuccessOrExit(err);
+
+        err = writer.Put(ContextTag(2), (uint32_t) 0x0E010000 + i);
+        SuccessOrExit(err);
+
+        err = writer.Put(ContextTag(3), (uint64_t) i);
+        SuccessOrExit(err);
+
+        err = writer.EndContainer(instanceLocator);
+        SuccessOrExit(err);
+
+        err = writer.Put(ContextTag(i + 1), (uint8_t) 1);
+        SuccessOrExit(err);
+
+        err = writer.EndContainer(path);
+        SuccessOrExit(err);
+
+        // Version
+        err = writer.Put(ContextTag(2), (uint64_t) 0x7A3B9C21D0000000ULL + i);
+        SuccessOrExit(err);
+
+        // Data
+        err = writer.StartContainer(ContextTag(3), kTLVType_Structure, data);
+        SuccessOrExit(err);
+
+        err = writer.Put(ContextTag(1), (int16_t) (-1000 + 250 * i));
+        SuccessOrExit(err);
+
+        err = writer.Put(ContextTag(2), (uint32_t) 21500 + i);
+        SuccessOrExit(err);
+
+        err = writer.PutBoolean(ContextTag(3), (i & 1) != 0);
+        SuccessOrExit(err);
+
+        err = writer.PutString(ContextTag(4), sNames[i]);
+        SuccessOrExit(err);
+
+        err = writer.Put(ContextTag(5), 20.5 + i);
+        SuccessOrExit(err);
+
+        err = writer.PutNull(ContextTag(6));
+        SuccessOrExit(err);
+
+        err = writer.EndContainer(data);
+        SuccessOrExit(err);
+
+        err = writer.EndContainer(dataElement);
+        SuccessOrExit(err);
+    }
+
+    err = writer.EndContainer(dataList);
+    SuccessOrExit(err);
+
+    err = writer.EndContainer(outerContainer);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR EncodeEventPayload(TLVWriter &writer)
+{
+    WEAVE_ERROR err;
+    TLVType outerContainer, eventData;
+    static const uint8_t sCorrelationId[16] =
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF
+    };
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainer);
+    SuccessOrExit(err);
+
+    // Source, Importance, ID
+    err = writer.Put(ContextTag(1), (uint64_t) 0x18B4300000ABCDEFULL);
+    SuccessOrExit(err);
+
+    err = writer.Put(ContextTag(2), (uint8_t) 2);
+    SuccessOrExit(err);
+
+    err = writer.Put(ContextTag(3), (uint64_t) 0x0000000100002345ULL);
+    SuccessOrExit(err);
+
+    // UTC and system timestamps
+    err = writer.Put(ContextTag(12), (uint64_t) 1546300800000ULL);
+    SuccessOrExit(err);
+
+    err = writer.Put(ContextTag(13), (uint64_t) 86400123ULL);
+    SuccessOrExit(err);
+
+    // Trait profile ID and event type
+    err = writer.Put(ContextTag(15), (uint32_t) 0x0E010001);
+    SuccessOrExit(err);
+
+    err = writer.Put(ContextTag(17), (uint16_t) 3);
+    SuccessOrExit(err);
+
+    // Event data
+    err = writer.StartContainer(ContextTag(50), kTLVType_Structure, eventData);
+    SuccessOrExit(err);
+
+    err = writer.Put(ContextTag(1), (uint8_t) 4);
+    SuccessOrExit(err);
+
+    err = writer.Put(ContextTag(2), (int32_t) -40000);
+    SuccessOrExit(err);
+
+    err = writer.PutString(ContextTag(3), "door-lock: bolt actuated");
+    SuccessOrExit(err);
+
+    err = writer.PutBytes(ContextTag(4), sCorrelationId, sizeof(sCorrelationId));
+    SuccessOrExit(err);
+
+    err = writer.EndContainer(eventData);
+    SuccessOrExit(err);
+
+    err = writer.EndContainer(outerContainer);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR CaptureElements(TLVReader &reader, BenchPayload &payload)
+{
+    WEAVE_ERROR err;
+
+    while ((err = reader.Next()) == WEAVE_NO_ERROR)
+    {
+        BenchElement &elem = payload.Elements[payload.ElementCount];
+        TLVType type = reader.GetType();
+
+        VerifyOrExit(payload.ElementCount + 2 <= kMaxPayloadElements, err = WEAVE_ERROR_NO_MEMORY);
+
+        memset(&elem, 0, sizeof(elem));
+        elem.Tag = reader.GetTag();
+        elem.Type = type;
+        payload.ElementCount++;
+        payload.TLVElementCount++;
+
+        switch (type)
+        {
+        case kTLVType_SignedInteger:
+            err = reader.Get(elem.Value.SInt);
+            break;
+        case kTLVType_UnsignedInteger:
+            err = reader.Get(elem.Value.UInt);
+            break;
+        case kTLVType_FloatingPointNumber:
+            err = reader.Get(elem.Value.Float);
+            break;
+        case kTLVType_Boolean:
+            err = reader.Get(elem.Value.Bool);
+            break;
+        case kTLVType_UTF8String:
+        case kTLVType_ByteString:
+            elem.DataLen = reader.GetLength();
+            err = reader.GetDataPtr(elem.Data);
+            break;
+        case kTLVType_Structure:
+        case kTLVType_Array:
+        case kTLVType_Path:
+        {
+            TLVType outerContainer;
+
+            err = reader.EnterContainer(outerContainer);
+            SuccessOrExit(err);
+
+            err = CaptureElements(reader, payload);
+            SuccessOrExit(err);
+
+            err = reader.ExitContainer(outerContainer);
+            SuccessOrExit(err);
+
+            memset(&payload.Elements[payload.ElementCount], 0, sizeof(BenchElement));
+            payload.Elements[payload.ElementCount].Type = kTLVType_NotSpecified;
+            payload.ElementCount++;
+            break;
+        }
+        default:
+            break;
+        }
+        SuccessOrExit(err);
+    }
+
+    if (err == WEAVE_END_OF_TLV)
+        err = WEAVE_NO_ERROR;
+
+exit:
+    return err;
+}
+
+static void AddPayload(const char *name, const uint8_t *encoding, uint32_t encodingLen)
+{
+    WEAVE_ERROR err;
+    BenchPayload &payload = gPayloads[gNumPayloads++];
+    TLVReader reader;
+
+    VerifyOrDie(encodingLen <= kMaxPayloadSize);
+
+    payload.Name = name;
+    memcpy(payload.Encoding, encoding, encodingLen);
+    payload.EncodingLen = encodingLen;
+    payload.ElementCount = 0;
+    payload.TLVElementCount = 0;
+
+    reader.Init(payload.Encoding, payload.EncodingLen);
+    err = CaptureElements(reader, payload);
+    FAIL_ERROR(err, "CaptureElements failed");
+}
+
+static void InitPayloads(void)
+{
+    WEAVE_ERROR err;
+    uint8_t buf[kMaxPayloadSize];
+    TLVWriter writer;
+
+    writer.Init(buf, sizeof(buf));
+    err = EncodeNotifyPayload(writer);
+    FAIL_ERROR(err, "EncodeNotifyPayload failed");
+    err = writer.Finalize();
+    FAIL_ERROR(err, "TLVWriter::Finalize failed");
+    AddPayload("wdm-notify", buf, writer.GetLengthWritten());
+
+    writer.Init(buf, sizeof(buf));
+    err = EncodeEventPayload(writer);
+    FAIL_ERROR(err, "EncodeEventPayload failed");
+    err = writer.Finalize();
+    FAIL_ERROR(err, "TLVWriter::Finalize failed");
+    AddPayload("event", buf, writer.GetLengthWritten());
+
+    AddPayload("certificate", sTestCert_Dev_Weave, sTestCertLength_Dev_Weave);
+}
+
+// ==================== PacketBuffer Chains ====================
+
+/**
+ *  Allocates a chain of PacketBuffers, each of which offers gSegmentSize bytes of
+ *  space, sufficient to hold len bytes.
+ */
+static PacketBuffer *NewSegmentedChain(uint32_t len)
+{
+    PacketBuffer *head = NULL;
+
+    for (uint32_t allocated = 0; allocated < len || head == NULL; allocated += gSegmentSize)
+    {
+        PacketBuffer *buf = PacketBuffer::New(0);
+        VerifyOrDie(buf != NULL && buf->MaxDataLength() >= gSegmentSize);
+
+        VerifyOrDie(buf->EnsureReservedSize(buf->MaxDataLength() - gSegmentSize));
+
+        if (head == NULL)
+            head = buf;
+        else
+            head->AddToEnd(buf);
+    }
+
+    return head;
+}
+
+static void ResetChain(PacketBuffer *head)
+{
+    for (PacketBuffer *buf = head; buf != NULL; buf = buf->Next())
+        buf->SetDataLength(0, head);
+}
+
+// ==================== Benchmarks ====================
+
+static WEAVE_ERROR WriteElements(TLVWriter &writer, const BenchPayload &payload)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TLVType containerStack[kMaxNestingDepth];
+    uint32_t depth = 0;
+
+    for (uint32_t i = 0; i < payload.ElementCount && err == WEAVE_NO_ERROR; i++)
+    {
+        const BenchElement &elem = payload.Elements[i];
+
+        switch (elem.Type)
+        {
+        case kTLVType_SignedInteger:
+            err = writer.Put(elem.Tag, elem.Value.SInt);
+            break;
+        case kTLVType_UnsignedInteger:
+            err = writer.Put(elem.Tag, elem.Value.UInt);
+            break;
+        case kTLVType_FloatingPointNumber:
+            err = writer.Put(elem.Tag, elem.Value.Float);
+            break;
+        case kTLVType_Boolean:
+            err = writer.PutBoolean(elem.Tag, elem.Value.Bool);
+            break;
+        case kTLVType_UTF8String:
+            err = writer.PutString(elem.Tag, (const char *) elem.Data, elem.DataLen);
+            break;
+        case kTLVType_ByteString:
+            err = writer.PutBytes(elem.Tag, elem.Data, elem.DataLen);
+            break;
+        case kTLVType_Null:
+            err = writer.PutNull(elem.Tag);
+            break;
+        case kTLVType_Structure:
+        case kTLVType_Array:
+        case kTLVType_Path:
+            VerifyOrExit(depth < kMaxNestingDepth, err = WEAVE_ERROR_TLV_CONTAINER_OPEN);
+            err = writer.StartContainer(elem.Tag, elem.Type, containerStack[depth++]);
+            break;
+        case kTLVType_NotSpecified:
+            err = writer.EndContainer(containerStack[--depth]);
+            break;
+        default:
+            err = WEAVE_ERROR_INVALID_TLV_ELEMENT;
+            break;
+        }
+    }
+
+exit:
+    return err;
+}
+
+static WEAVE_ERROR ReadElements(TLVReader &reader, uint32_t &elemCount)
+{
+    WEAVE_ERROR err;
+    uint64_t uintVal;
+    int64_t sintVal;
+    double floatVal;
+    bool boolVal;
+
+    while ((err = reader.Next()) == WEAVE_NO_ERROR)
+    {
+        elemCount++;
+
+        switch (reader.GetType())
+        {
+        case kTLVType_SignedInteger:
+            err = reader.Get(sintVal);
+            break;
+        case kTLVType_UnsignedInteger:
+            err = reader.Get(uintVal);
+            break;
+        case kTLVType_FloatingPointNumber:
+            err = reader.Get(floatVal);
+            break;
+        case kTLVType_Boolean:
+            err = reader.Get(boolVal);
+            break;
+        case kTLVType_Structure:
+        case kTLVType_Array:
+        case kTLVType_Path:
+        {
+            TLVType outerContainer;
+
+            err = reader.EnterContainer(outerContainer);
+            SuccessOrExit(err);
+
+            err = ReadElements(reader, elemCount);
+            SuccessOrExit(err);
+
+            err = reader.ExitContainer(outerContainer);
+            break;
+        }
+        default:
+            break;
+        }
+        SuccessOrExit(err);
+    }
+
+    if (err == WEAVE_END_OF_TLV)
+        err = WEAVE_NO_ERROR;
+
+exit:
+    return err;
+}
+
+static void BenchWriterFlat(const BenchPayload &payload)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t buf[kMaxPayloadSize];
+    TLVWriter writer;
+    uint64_t start;
+
+    start = BenchNow();
+    for (int32_t i = 0; i < gIterations && err == WEAVE_NO_ERROR; i++)
+    {
+        writer.Init(buf, sizeof(buf));
+        err = WriteElements(writer, payload);
+        if (err == WEAVE_NO_ERROR)
+            err = writer.Finalize();
+    }
+    FAIL_ERROR(err, "TLVWriter benchmark failed");
+
+    Report(payload, "TLVWriter", "flat", BenchNow() - start, gIterations, payload.TLVElementCount, payload.EncodingLen);
+}
+
+static void BenchWriterChained(const BenchPayload &payload)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *chain = NewSegmentedChain(payload.EncodingLen);
+    TLVWriter writer;
+    uint64_t start;
+
+    start = BenchNow();
+    for (int32_t i = 0; i < gIterations && err == WEAVE_NO_ERROR; i++)
+    {
+        ResetChain(chain);
+        writer.Init(chain, UINT32_MAX, true);
+        err = WriteElements(writer, payload);
+        if (err == WEAVE_NO_ERROR)
+            err = writer.Finalize();
+    }
+    FAIL_ERROR(err, "TLVWriter benchmark failed");
+
+    Report(payload, "TLVWriter", "chained", BenchNow() - start, gIterations, payload.TLVElementCount, payload.EncodingLen);
+
+    PacketBuffer::Free(chain);
+}
+
+static void BenchReaderFlat(const BenchPayload &payload)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TLVReader reader;
+    uint32_t elemCount = 0;
+    uint64_t start;
+
+    start = BenchNow();
+    for (int32_t i = 0; i < gIterations && err == WEAVE_NO_ERROR; i++)
+    {
+        reader.Init(payload.Encoding, payload.EncodingLen);
+        err = ReadElements(reader, elemCount);
+    }
+    FAIL_ERROR(err, "TLVReader benchmark failed");
+
+    Report(payload, "TLVReader", "flat", BenchNow() - start, gIterations, payload.TLVElementCount, payload.EncodingLen);
+}
+
+static void BenchReaderChained(const BenchPayload &payload)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    PacketBuffer *chain = NewSegmentedChain(payload.EncodingLen);
+    TLVWriter writer;
+    TLVReader reader;
+    uint32_t elemCount = 0;
+    uint64_t start;
+
+    writer.Init(chain, UINT32_MAX, true);
+    err = WriteElements(writer, payload);
+    if (err == WEAVE_NO_ERROR)
+        err = writer.Finalize();
+    FAIL_ERROR(err, "Failed to populate PacketBuffer chain");
+
+    start = BenchNow();
+    for (int32_t i = 0; i < gIterations && err == WEAVE_NO_ERROR; i++)
+    {
+        reader.Init(chain, UINT32_MAX, true);
+        err = ReadElements(reader, elemCount);
+    }
+    FAIL_ERROR(err, "TLVReader benchmark failed");
+
+    Report(payload, "TLVReader", "chained", BenchNow() - start, gIterations, payload.TLVElementCount, payload.EncodingLen);
+
+    PacketBuffer::Free(chain);
+}
+
+static void BenchUpdater(const BenchPayload &payload, bool inPlace)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint8_t buf[kMaxPayloadSize + 64];
+    TLVUpdater updater;
+    uint64_t start;
+
+    start = BenchNow();
+    for (int32_t i = 0; i < gIterations && err == WEAVE_NO_ERROR; i++)
+    {
+        memcpy(buf, payload.Encoding, payload.EncodingLen);
+
+        if (inPlace)
+            err = updater.InitInPlace(buf, payload.EncodingLen, sizeof(buf));
+        else
+            err = updater.Init(buf, payload.EncodingLen, sizeof(buf));
+        SuccessOrExit(err);
+
+        // Copy the payload through the updater, element by element.
+        while ((err = updater.Next()) == WEAVE_NO_ERROR)
+        {
+            err = updater.Move();
+            SuccessOrExit(err);
+        }
+        VerifyOrExit(err == WEAVE_END_OF_TLV, /* no-op */);
+
+        // Append a trailing element, then finish.
+        err = updater.Put(ProfileTag(kWeaveProfile_Bench, 1), (uint32_t) i);
+        SuccessOrExit(err);
+
+        err = updater.Finalize();
+    }
+
+exit:
+    FAIL_ERROR(err, "TLVUpdater benchmark failed");
+
+    Report(payload, "TLVUpdater", inPlace ? "in-place" : "flat", BenchNow() - start, gIterations, payload.TLVElementCount + 1,
+           payload.EncodingLen);
+}
+
+static void BenchCircular(const BenchPayload &payload)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    static uint8_t sBackingStore[kCircularBufferSize];
+    WeaveCircularTLVBuffer buffer(sBackingStore, sizeof(sBackingStore));
+    CircularTLVWriter writer;
+    CircularTLVReader reader;
+    uint32_t elemCount = 0;
+    uint32_t residentElems, residentBytes;
+    int32_t readIterations;
+    uint64_t start;
+
+    // Write the payload repeatedly, evicting the oldest copies once the buffer fills.
+    writer.Init(&buffer);
+
+    start = BenchNow();
+    for (int32_t i = 0; i < gIterations && err == WEAVE_NO_ERROR; i++)
+        err = WriteElements(writer, payload);
+    if (err == WEAVE_NO_ERROR)
+        err = writer.Finalize();
+    FAIL_ERROR(err, "CircularTLVWriter benchmark failed");
+
+    Report(payload, "CircularWriter", "circular", BenchNow() - start, gIterations, payload.TLVElementCount, payload.EncodingLen);
+
+    // Traverse the resident copies, scaling the iteration count so that roughly the same amount of
+    // data is read as was written.
+    reader.Init(&buffer);
+    err = ReadElements(reader, elemCount);
+    FAIL_ERROR(err, "CircularTLVReader benchmark failed");
+
+    residentElems = elemCount;
+    residentBytes = buffer.DataLength();
+    readIterations = gIterations / (residentElems / payload.TLVElementCount);
+    if (readIterations == 0)
+        readIterations = 1;
+
+    start = BenchNow();
+    for (int32_t i = 0; i < readIterations && err == WEAVE_NO_ERROR; i++)
+    {
+        reader.Init(&buffer);
+        err = ReadElements(reader, elemCount);
+    }
+    FAIL_ERROR(err, "CircularTLVReader benchmark failed");
+
+    Report(payload, "CircularReader", "circular", BenchNow() - start, readIterations, residentElems, residentBytes);
+}
+
+static OptionDef gToolOptionDefs[] =
+{
+    { "iterations",   kArgumentRequired, 'i' },
+    { "segment-size", kArgumentRequired, 's' },
+    { }
+};
+
+static const char *const gToolOptionHelp =
+    "  -i, --iterations <int>\n"
+    "       Number of times each payload is processed by each benchmark. Defaults to 10000.\n"
+    "\n"
+    "  -s, --segment-size <int>\n"
+    "       Size of each PacketBuffer in the chained-buffer benchmarks. Defaults to 128.\n"
+    "\n"
+    ;
+
+static OptionSet gToolOptions =
+{
+    HandleOption,
+    gToolOptionDefs,
+    "GENERAL OPTIONS",
+    gToolOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    TOOL_NAME,
+    "Usage: " TOOL_NAME " [<options...>]\n",
+    WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+    "Micro-benchmarks for the Weave TLV reader, writer, updater and circular buffer.\n"
+);
+
+static OptionSet *gToolOptionSets[] =
+{
+    &gToolOptions,
+    &gBenchmarkOptions,
+    &gHelpOptions,
+    NULL
+};
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case 'i':
+        if (!ParseInt(arg, gIterations) || gIterations <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for iterations: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 's':
+        if (!ParseInt(arg, gSegmentSize) || gSegmentSize < 16)
+        {
+            PrintArgError("%s: Invalid value specified for segment size: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  Main
+ */
+int main(int argc, char *argv[])
+{
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    tcpip_init(NULL, NULL);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    if (!ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    InitPayloads();
+
+    printf("%s: %d iterations, %d byte segments\n", TOOL_NAME, gIterations, gSegmentSize);
+
+    for (uint32_t i = 0; i < gNumPayloads; i++)
+    {
+        const BenchPayload &payload = gPayloads[i];
+
+        printf("%s: %u bytes, %u elements\n", payload.Name, payload.EncodingLen, payload.TLVElementCount);
+
+        BenchWriterFlat(payload);
+        BenchWriterChained(payload);
+        BenchReaderFlat(payload);
+        BenchReaderChained(payload);
+        BenchUpdater(payload, false);
+        BenchUpdater(payload, true);
+        BenchCircular(payload);
+    }
+
+    return EXIT_SUCCESS;
+}
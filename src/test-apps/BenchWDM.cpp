@@ -0,0 +1,632 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements an end-to-end benchmark for the WDM publisher
+ *      and subscription client data paths.
+ *
+ *      A publisher with a configurable number of test_h_trait data sources
+ *      serves a configurable number of established subscriptions in-process.
+ *      Each cycle mutates a number of leaf properties across the sources,
+ *      then has the notification engine build the notifies for every
+ *      subscription and feeds each one through the subscription client into
+ *      a set of data sinks, the same way a notify arriving over the network
+ *      would be processed.  The benchmark reports notify throughput,
+ *      mutation-to-sink latency percentiles, bytes produced and peak packet
+ *      buffer usage, so that graph solvers and configuration settings can be
+ *      compared.
+ *
+ */
+
+#include "ToolCommon.h"
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveTLV.h>
+#include <Weave/Support/RandUtils.h>
+#include <SystemLayer/SystemLayer.h>
+#include <SystemLayer/SystemStats.h>
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/DataManagement.h>
+
+#include <nest/test/trait/TestHTrait.h>
+
+#include <algorithm>
+#include <vector>
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/init.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+using namespace nl;
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Profiles::DataManagement;
+using namespace Schema::Nest::Test::Trait;
+using nl::Weave::System::PacketBuffer;
+
+#define TOOL_NAME "BenchWDM"
+
+#define BENCH_STRINGIFY(x) #x
+#define BENCH_TO_STRING(x) BENCH_STRINGIFY(x)
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+
+enum
+{
+    kMaxTraitInstances          = 4,
+    kDefaultCycles              = 1000,
+    kDefaultSubscriptions       = WDM_MAX_NUM_SUBSCRIPTION_HANDLERS,
+    kDefaultTraitInstances      = 2,
+    kDefaultMutationsPerCycle   = 4
+};
+
+// The static uint32 leaves of test_h_trait that the benchmark mutates.
+static const PropertyPathHandle sMutableLeaves[] =
+{
+    TestHTrait::kPropertyHandle_A, TestHTrait::kPropertyHandle_B, TestHTrait::kPropertyHandle_C,
+    TestHTrait::kPropertyHandle_D, TestHTrait::kPropertyHandle_E, TestHTrait::kPropertyHandle_F,
+    TestHTrait::kPropertyHandle_G, TestHTrait::kPropertyHandle_H, TestHTrait::kPropertyHandle_I,
+    TestHTrait::kPropertyHandle_J, TestHTrait::kPropertyHandle_K_Sb, TestHTrait::kPropertyHandle_K_Sc
+};
+
+static int32_t gCycles = kDefaultCycles;
+static int32_t gSubscriptions = kDefaultSubscriptions;
+static int32_t gTraitInstances = kDefaultTraitInstances;
+static int32_t gMutationsPerCycle = kDefaultMutationsPerCycle;
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+namespace Platform {
+    // The benchmark is single-threaded, so the dummy critical section is sufficient.
+    void CriticalSectionEnter()
+    {
+        return;
+    }
+
+    void CriticalSectionExit()
+    {
+        return;
+    }
+} // Platform
+} // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+}
+}
+}
+
+static SubscriptionEngine *gSubscriptionEngine;
+
+SubscriptionEngine * SubscriptionEngine::GetInstance()
+{
+    return gSubscriptionEngine;
+}
+
+static inline uint64_t BenchNow(void)
+{
+    return nl::Weave::System::Layer::GetClock_MonotonicHiRes();
+}
+
+//
+// A test_h_trait source with a flat table of leaf values and empty dictionaries.
+//
+class BenchSource : public TraitDataSource
+{
+public:
+    BenchSource(void) : TraitDataSource(&TestHTrait::TraitSchema) { memset(mValues, 0, sizeof(mValues)); }
+
+    void SetValue(PropertyPathHandle aLeafHandle, uint32_t aValue)
+    {
+        mValues[GetPropertySchemaHandle(aLeafHandle)] = aValue;
+        SetDirty(aLeafHandle);
+    }
+
+private:
+    WEAVE_ERROR GetLeafData(PropertyPathHandle aLeafHandle, uint64_t aTagToWrite, TLVWriter &aWriter)
+    {
+        return aWriter.Put(aTagToWrite, mValues[GetPropertySchemaHandle(aLeafHandle)]);
+    }
+
+    WEAVE_ERROR GetNextDictionaryItemKey(PropertyPathHandle aDictionaryHandle, uintptr_t &aContext, PropertyDictionaryKey &aKey)
+    {
+        return WEAVE_END_OF_INPUT;
+    }
+
+    uint32_t mValues[TestHTrait::kPropertyHandle_L_Value_Dc + 1];
+};
+
+//
+// A test_h_trait sink that counts the leaves stored into it.
+//
+class BenchSink : public TraitDataSink
+{
+public:
+    BenchSink(void) : TraitDataSink(&TestHTrait::TraitSchema), mNumLeavesStored(0) { }
+
+    uint32_t mNumLeavesStored;
+
+private:
+    WEAVE_ERROR SetLeafData(PropertyPathHandle aLeafHandle, TLVReader &aReader)
+    {
+        uint32_t val;
+
+        mNumLeavesStored++;
+
+        return aReader.Get(val);
+    }
+};
+
+namespace nl {
+namespace Weave {
+namespace Profiles {
+namespace WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current) {
+
+class BenchWdm
+{
+public:
+    BenchWdm(void);
+
+    WEAVE_ERROR Setup(void);
+    WEAVE_ERROR Run(void);
+    void Report(void);
+    void Teardown(void);
+
+private:
+    WEAVE_ERROR Mutate(void);
+    WEAVE_ERROR BuildAndProcessNotifies(SubscriptionHandler *aSubHandler);
+
+    SubscriptionHandler *mSubHandlers[WDM_MAX_NUM_SUBSCRIPTION_HANDLERS];
+    SubscriptionClient *mSubClient;
+    NotificationEngine *mNotificationEngine;
+
+    SubscriptionEngine mSubscriptionEngine;
+    SingleResourceSourceTraitCatalog::CatalogItem mSourceCatalogStore[kMaxTraitInstances];
+    SingleResourceSourceTraitCatalog mSourceCatalog;
+    SingleResourceSinkTraitCatalog::CatalogItem mSinkCatalogStore[kMaxTraitInstances];
+    SingleResourceSinkTraitCatalog mSinkCatalog;
+    BenchSource mSources[kMaxTraitInstances];
+    BenchSink mSinks[kMaxTraitInstances];
+
+    Binding *mClientBinding;
+
+    uint32_t mNextValue;
+    uint32_t mNextLeaf;
+
+    // Measurements
+    std::vector<uint32_t> mLatenciesUS;
+    uint64_t mBuildTimeUS;
+    uint64_t mProcessTimeUS;
+    uint64_t mNumNotifies;
+    uint64_t mNumBytes;
+    uint32_t mMaxNotifyBytes;
+};
+
+BenchWdm::BenchWdm(void)
+    : mSubClient(NULL),
+      mNotificationEngine(NULL),
+      mSourceCatalog(ResourceIdentifier(ResourceIdentifier::SELF_NODE_ID), mSourceCatalogStore, kMaxTraitInstances),
+      mSinkCatalog(ResourceIdentifier(ResourceIdentifier::SELF_NODE_ID), mSinkCatalogStore, kMaxTraitInstances),
+      mClientBinding(NULL),
+      mNextValue(1),
+      mNextLeaf(0),
+      mBuildTimeUS(0),
+      mProcessTimeUS(0),
+      mNumNotifies(0),
+      mNumBytes(0),
+      mMaxNotifyBytes(0)
+{
+    memset(mSubHandlers, 0, sizeof(mSubHandlers));
+}
+
+WEAVE_ERROR BenchWdm::Setup(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TraitDataHandle sourceHandles[kMaxTraitInstances];
+    TraitDataHandle sinkHandle;
+
+    gSubscriptionEngine = &mSubscriptionEngine;
+
+    VerifyOrExit(gSubscriptions * gTraitInstances <= SubscriptionEngine::kMaxNumPathGroups, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = mSubscriptionEngine.Init(&ExchangeMgr, NULL, NULL);
+    SuccessOrExit(err);
+
+    err = mSubscriptionEngine.EnablePublisher(NULL, &mSourceCatalog);
+    SuccessOrExit(err);
+
+    mNotificationEngine = &mSubscriptionEngine.mNotificationEngine;
+
+    for (int32_t i = 0; i < gTraitInstances; i++)
+    {
+        err = mSourceCatalog.Add(i, &mSources[i], sourceHandles[i]);
+        SuccessOrExit(err);
+
+        err = mSinkCatalog.Add(i, &mSinks[i], sinkHandle);
+        SuccessOrExit(err);
+    }
+
+    // Every subscription is established and covers all the trait instances.
+    for (int32_t i = 0; i < gSubscriptions; i++)
+    {
+        SubscriptionHandler *subHandler;
+
+        err = mSubscriptionEngine.NewSubscriptionHandler(&subHandler);
+        SuccessOrExit(err);
+
+        subHandler->mBinding = ExchangeMgr.NewBinding();
+        VerifyOrExit(subHandler->mBinding != NULL, err = WEAVE_ERROR_NO_MEMORY);
+        subHandler->mBinding->BeginConfiguration().Transport_UDP();
+
+        subHandler->mSubscriptionId = i + 1;
+        subHandler->mTraitInstanceList = mSubscriptionEngine.mTraitInfoPool + mSubscriptionEngine.mNumTraitInfosInPool;
+
+        for (int32_t j = 0; j < gTraitInstances; j++)
+        {
+            SubscriptionHandler::TraitInstanceInfo *traitInstance = subHandler->mTraitInstanceList + j;
+
+            traitInstance->Init();
+            traitInstance->mTraitDataHandle = sourceHandles[j];
+            traitInstance->mRequestedVersion = 1;
+
+            subHandler->mNumTraitInstances++;
+            mSubscriptionEngine.mNumTraitInfosInPool++;
+        }
+
+        subHandler->MoveToState(SubscriptionHandler::kState_SubscriptionEstablished_Idle);
+
+        mSubHandlers[i] = subHandler;
+    }
+
+    mClientBinding = ExchangeMgr.NewBinding();
+    VerifyOrExit(mClientBinding != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = mSubscriptionEngine.NewClient(&mSubClient, mClientBinding, NULL, NULL, &mSinkCatalog, 0);
+    SuccessOrExit(err);
+
+    mLatenciesUS.reserve(gCycles * gSubscriptions);
+
+exit:
+    return err;
+}
+
+void BenchWdm::Teardown(void)
+{
+    if (mClientBinding != NULL)
+    {
+        mClientBinding->Release();
+        mClientBinding = NULL;
+    }
+}
+
+/**
+ *  Apply one cycle's worth of mutations, spreading them over the sources
+ *  and the mutable leaves round-robin.  Each source is updated under its
+ *  lock so its data version advances as it would in an application.
+ */
+WEAVE_ERROR BenchWdm::Mutate(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    for (int32_t i = 0; i < gMutationsPerCycle; i++)
+    {
+        BenchSource &source = mSources[i % gTraitInstances];
+
+        err = source.Lock();
+        SuccessOrExit(err);
+
+        source.SetValue(sMutableLeaves[mNextLeaf], mNextValue++);
+        mNextLeaf = (mNextLeaf + 1) % (sizeof(sMutableLeaves) / sizeof(sMutableLeaves[0]));
+
+        err = source.Unlock();
+        SuccessOrExit(err);
+    }
+
+exit:
+    return err;
+}
+
+/**
+ *  Build every notify needed to bring one subscription up to date, and
+ *  process each of them through the subscription client into the sinks.
+ */
+WEAVE_ERROR BenchWdm::BuildAndProcessNotifies(SubscriptionHandler *aSubHandler)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    bool isSubscriptionClean = false;
+    PacketBuffer *buf = NULL;
+
+    while (!isSubscriptionClean)
+    {
+        NotificationEngine::NotifyRequestBuilder notifyRequest;
+        TLVWriter writer;
+        TLVReader reader;
+        TLVType dummyType1, dummyType2;
+        bool neWriteInProgress = false;
+        uint32_t maxPayloadSize = 0;
+        uint64_t start;
+
+        start = BenchNow();
+
+        err = aSubHandler->mBinding->AllocateRightSizedBuffer(buf, aSubHandler->GetMaxNotificationSize(), WDM_MIN_NOTIFICATION_SIZE,
+                                                               maxPayloadSize);
+        SuccessOrExit(err);
+
+        err = notifyRequest.Init(buf, &writer, aSubHandler, maxPayloadSize);
+        SuccessOrExit(err);
+
+        isSubscriptionClean = true;
+
+        err = mNotificationEngine->BuildSingleNotifyRequestDataList(aSubHandler, notifyRequest, isSubscriptionClean, neWriteInProgress);
+        SuccessOrExit(err);
+
+        VerifyOrExit(neWriteInProgress, /* nothing was dirty */);
+
+        err = notifyRequest.MoveToState(NotificationEngine::kNotifyRequestBuilder_Idle);
+        SuccessOrExit(err);
+
+        mBuildTimeUS += BenchNow() - start;
+        mNumNotifies++;
+        mNumBytes += buf->DataLength();
+        mMaxNotifyBytes = std::max<uint32_t>(mMaxNotifyBytes, buf->DataLength());
+
+        start = BenchNow();
+
+        reader.Init(buf);
+
+        err = reader.Next();
+        SuccessOrExit(err);
+
+        // Enter the notify, skip the SubscriptionId and enter the DataList
+        err = reader.EnterContainer(dummyType1);
+        SuccessOrExit(err);
+
+        err = reader.Next();
+        SuccessOrExit(err);
+
+        err = reader.Next();
+        SuccessOrExit(err);
+
+        VerifyOrExit(kTLVType_Array == reader.GetType(), err = WEAVE_ERROR_WRONG_TLV_TYPE);
+
+        err = reader.EnterContainer(dummyType2);
+        SuccessOrExit(err);
+
+        err = mSubClient->ProcessDataList(reader);
+        SuccessOrExit(err);
+
+        mProcessTimeUS += BenchNow() - start;
+
+        PacketBuffer::Free(buf);
+        buf = NULL;
+    }
+
+exit:
+    if (buf != NULL)
+    {
+        PacketBuffer::Free(buf);
+    }
+
+    return err;
+}
+
+WEAVE_ERROR BenchWdm::Run(void)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+
+    for (int32_t cycle = 0; cycle < gCycles; cycle++)
+    {
+        uint64_t start = BenchNow();
+
+        err = Mutate();
+        SuccessOrExit(err);
+
+        for (int32_t i = 0; i < gSubscriptions; i++)
+        {
+            err = BuildAndProcessNotifies(mSubHandlers[i]);
+            SuccessOrExit(err);
+
+            // Time from the start of the mutations until this subscriber's sinks hold the new values.
+            mLatenciesUS.push_back(static_cast<uint32_t>(BenchNow() - start));
+        }
+
+        mNotificationEngine->mGraphSolver.ClearDirty();
+    }
+
+exit:
+    return err;
+}
+
+static uint32_t Percentile(const std::vector<uint32_t> &aSorted, uint32_t aPercent)
+{
+    size_t index;
+
+    if (aSorted.empty())
+        return 0;
+
+    index = (aSorted.size() * aPercent) / 100;
+    if (index >= aSorted.size())
+        index = aSorted.size() - 1;
+
+    return aSorted[index];
+}
+
+void BenchWdm::Report(void)
+{
+    uint64_t totalUS = mBuildTimeUS + mProcessTimeUS;
+    uint32_t leavesStored = 0;
+    char caseName[96];
+
+    for (int32_t i = 0; i < gTraitInstances; i++)
+    {
+        leavesStored += mSinks[i].mNumLeavesStored;
+    }
+
+    std::sort(mLatenciesUS.begin(), mLatenciesUS.end());
+
+    if (totalUS == 0)
+        totalUS = 1;
+
+    printf("%s: graph solver %s, %d subscriptions, %d trait instances, %d mutations/cycle, %d cycles\n", TOOL_NAME,
+           BENCH_TO_STRING(WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER), gSubscriptions, gTraitInstances, gMutationsPerCycle, gCycles);
+    printf("notifies        %10" PRIu64 "  (%.0f notifies/s)\n", mNumNotifies, (mNumNotifies * 1000000.0) / totalUS);
+    printf("build           %10.2f us/notify\n", mNumNotifies ? (double) mBuildTimeUS / mNumNotifies : 0.0);
+    printf("process         %10.2f us/notify\n", mNumNotifies ? (double) mProcessTimeUS / mNumNotifies : 0.0);
+    printf("bytes           %10" PRIu64 "  (%.1f bytes/notify, max %u)\n", mNumBytes,
+           mNumNotifies ? (double) mNumBytes / mNumNotifies : 0.0, mMaxNotifyBytes);
+    printf("leaves stored   %10u\n", leavesStored);
+    printf("latency         p50 %u us, p90 %u us, p99 %u us, max %u us\n", Percentile(mLatenciesUS, 50),
+           Percentile(mLatenciesUS, 90), Percentile(mLatenciesUS, 99), mLatenciesUS.empty() ? 0 : mLatenciesUS.back());
+#if WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    printf("peak pbufs      %10d\n",
+           nl::Weave::System::Stats::GetHighWatermarks()[nl::Weave::System::Stats::kSystemLayer_NumPacketBufs]);
+#endif // WEAVE_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+    if (mNumNotifies != 0)
+    {
+        snprintf(caseName, sizeof(caseName), "%s-s%d-t%d-m%d", BENCH_TO_STRING(WEAVE_CONFIG_WDM_PUBLISHER_GRAPH_SOLVER),
+                 gSubscriptions, gTraitInstances, gMutationsPerCycle);
+        gBenchmarkOptions.RecordResult("wdm", caseName, "build", (double) mBuildTimeUS / mNumNotifies, "us/notify", false);
+        gBenchmarkOptions.RecordResult("wdm", caseName, "process", (double) mProcessTimeUS / mNumNotifies, "us/notify", false);
+        gBenchmarkOptions.RecordResult("wdm", caseName, "bytes", (double) mNumBytes / mNumNotifies, "bytes/notify", false);
+        gBenchmarkOptions.RecordResult("wdm", caseName, "latency-p99", Percentile(mLatenciesUS, 99), "us", false);
+    }
+}
+
+} // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
+}
+}
+}
+
+static OptionDef gToolOptionDefs[] =
+{
+    { "cycles",         kArgumentRequired, 'c' },
+    { "subscriptions",  kArgumentRequired, 's' },
+    { "traits",         kArgumentRequired, 't' },
+    { "mutations",      kArgumentRequired, 'm' },
+    { }
+};
+
+static const char *const gToolOptionHelp =
+    "  -c, --cycles <int>\n"
+    "       Number of mutate/notify cycles to run. Defaults to 1000.\n"
+    "\n"
+    "  -s, --subscriptions <int>\n"
+    "       Number of established subscriptions served by the publisher. Defaults to\n"
+    "       WDM_MAX_NUM_SUBSCRIPTION_HANDLERS, which is also the maximum.\n"
+    "\n"
+    "  -t, --traits <int>\n"
+    "       Number of trait instances published and covered by every subscription.\n"
+    "       Defaults to 2, at most 4.\n"
+    "\n"
+    "  -m, --mutations <int>\n"
+    "       Number of leaf properties changed before each notify cycle. Defaults to 4.\n"
+    "\n"
+    ;
+
+static OptionSet gToolOptions =
+{
+    HandleOption,
+    gToolOptionDefs,
+    "GENERAL OPTIONS",
+    gToolOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    TOOL_NAME,
+    "Usage: " TOOL_NAME " [<options...>]\n",
+    WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+    "End-to-end benchmark for WDM notify generation and processing.\n"
+);
+
+static OptionSet *gToolOptionSets[] =
+{
+    &gToolOptions,
+    &gBenchmarkOptions,
+    &gHelpOptions,
+    NULL
+};
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case 'c':
+        if (!ParseInt(arg, gCycles) || gCycles <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for cycles: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 's':
+        if (!ParseInt(arg, gSubscriptions) || gSubscriptions <= 0 || gSubscriptions > WDM_MAX_NUM_SUBSCRIPTION_HANDLERS)
+        {
+            PrintArgError("%s: Invalid value specified for subscriptions: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 't':
+        if (!ParseInt(arg, gTraitInstances) || gTraitInstances <= 0 || gTraitInstances > kMaxTraitInstances)
+        {
+            PrintArgError("%s: Invalid value specified for traits: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'm':
+        if (!ParseInt(arg, gMutationsPerCycle) || gMutationsPerCycle <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for mutations: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  Main
+ */
+int main(int argc, char *argv[])
+{
+    WEAVE_ERROR err;
+    static BenchWdm bench;
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    tcpip_init(NULL, NULL);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    if (!ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    err = bench.Setup();
+    FAIL_ERROR(err, "Benchmark setup failed");
+
+    err = bench.Run();
+    FAIL_ERROR(err, "Benchmark run failed");
+
+    bench.Report();
+    bench.Teardown();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,833 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a throughput and latency benchmark for Weave
+ *      over BLE (WoBLE).
+ *
+ *      A central and a peripheral BleLayer of the same process connect a
+ *      pair of BLEEndPoints over a simulated BLE link, whose platform
+ *      delegate delivers the GATT operations of both devices at simulated
+ *      connection events.  The sender then sends a series of messages to
+ *      the receiver, for each of a set of MTUs and BTP receive window
+ *      sizes, and the benchmark reports the effective throughput, the
+ *      fragments sent per second and the message latency, so that changes
+ *      to BTP windowing and fragmentation can be compared.
+ *
+ */
+
+#include "ToolCommon.h"
+
+#include <deque>
+#include <vector>
+
+#include <BleLayer/BleLayer.h>
+#include <BleLayer/BLEEndPoint.h>
+#include <BleLayer/BleApplicationDelegate.h>
+#include <BleLayer/BlePlatformDelegate.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/init.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+using nl::Ble::BleLayer;
+using nl::Ble::BLEEndPoint;
+using nl::Ble::BleTransportCapabilitiesRequestMessage;
+using nl::Ble::WeaveBleUUID;
+using nl::Ble::WEAVE_BLE_SVC_ID;
+using nl::Weave::System::PacketBuffer;
+
+#define TOOL_NAME "BenchWoBLE"
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+
+enum
+{
+    kDefaultConnectionIntervalMs = 30,
+    kDefaultPacketsPerEvent      = 4,
+    kDefaultMessageSize          = 512,
+    kDefaultMessageCount         = 20,
+    kDefaultOutstanding          = 1,
+    kMinMTU                      = 23,
+    kMaxMTU                      = 517,
+    kMinWindowSize               = 3,
+    kRunTimeoutMs                = 300000,
+};
+
+// The MTUs and receive window sizes benchmarked when none is given.
+static const uint16_t sDefaultMTUs[] = { 23, 185, 247 };
+static const uint8_t sDefaultWindowSizes[] = { kMinWindowSize, BLE_MAX_RECEIVE_WINDOW_SIZE };
+
+static int32_t gConnectionIntervalMs = kDefaultConnectionIntervalMs;
+static int32_t gPacketsPerEvent = kDefaultPacketsPerEvent;
+static int32_t gMTU = 0;
+static int32_t gWindowSize = 0;
+static int32_t gMessageSize = kDefaultMessageSize;
+static int32_t gMessageCount = kDefaultMessageCount;
+static int32_t gOutstanding = kDefaultOutstanding;
+static bool gPeripheralSends = false;
+
+/**
+ *  The state and results of one benchmarked run.
+ */
+struct BenchRun
+{
+    uint16_t mtu;
+    uint8_t windowSize;
+
+    bool windowSet;
+    bool done;
+    bool failed;
+    bool timedOut;
+
+    uint32_t messagesSent;
+    uint32_t messagesReceived;
+    uint64_t bytesReceived;
+    uint32_t fragments;         // GATT data operations of the sender, including the piggybacked acks
+    uint32_t acks;              // GATT data operations of the receiver, i.e. its stand-alone acks
+    uint64_t latencyTotalUs;
+    uint64_t latencyMaxUs;
+    uint64_t startUs;
+    uint64_t handshakeUs;
+    uint64_t elapsedUs;
+};
+
+static BenchRun sRun;
+static std::vector<uint64_t> sSendTimesUs;
+
+static BleLayer sCentralBle;
+static BleLayer sPeripheralBle;
+static BLEEndPoint *sCentralEndPoint = NULL;
+static BLEEndPoint *sPeripheralEndPoint = NULL;
+
+// The Weave service characteristics, as seen by the platform.
+static const WeaveBleUUID sWeaveCharRxId = { { // 18EE2EF5-263D-4559-959F-4F9C429F9D11
+                                               0x18, 0xEE, 0x2E, 0xF5, 0x26, 0x3D, 0x45, 0x59, 0x95, 0x9F, 0x4F, 0x9C,
+                                               0x42, 0x9F, 0x9D, 0x11 } };
+static const WeaveBleUUID sWeaveCharTxId = { { // 18EE2EF5-263D-4559-959F-4F9C429F9D12
+                                               0x18, 0xEE, 0x2E, 0xF5, 0x26, 0x3D, 0x45, 0x59, 0x95, 0x9F, 0x4F, 0x9C,
+                                               0x42, 0x9F, 0x9D, 0x12 } };
+
+// The connection objects with which each device identifies the simulated BLE connection.
+static uint8_t sCentralConn;
+static uint8_t sPeripheralConn;
+static BLE_CONNECTION_OBJECT const sCentralConnObj = &sCentralConn;
+static BLE_CONNECTION_OBJECT const sPeripheralConnObj = &sPeripheralConn;
+
+/**
+ *  The GATT operations, and their confirmations, carried by the simulated
+ *  link.  The central writes the Weave RX characteristic and subscribes to
+ *  the TX characteristic, which the peripheral indicates.
+ */
+enum LinkOpType
+{
+    kLinkOp_WriteRequest,
+    kLinkOp_WriteWithoutResponse,
+    kLinkOp_Indication,
+    kLinkOp_Notification,
+    kLinkOp_Subscribe,
+    kLinkOp_Unsubscribe,
+    kLinkOp_WriteConfirmation,
+    kLinkOp_IndicationConfirmation,
+    kLinkOp_SubscribeComplete,
+    kLinkOp_UnsubscribeComplete,
+};
+
+struct LinkOp
+{
+    LinkOpType type;
+    uint32_t event;             // The first connection event the operation may be delivered in
+    PacketBuffer *buf;
+};
+
+static std::deque<LinkOp> sLinkOps;
+static uint32_t sEventCount;
+
+static inline bool IsDataOp(LinkOpType type)
+{
+    return type == kLinkOp_WriteRequest || type == kLinkOp_WriteWithoutResponse ||
+           type == kLinkOp_Indication || type == kLinkOp_Notification;
+}
+
+static inline bool IsSentByCentral(LinkOpType type)
+{
+    return type == kLinkOp_WriteRequest || type == kLinkOp_WriteWithoutResponse || type == kLinkOp_Subscribe ||
+           type == kLinkOp_Unsubscribe || type == kLinkOp_IndicationConfirmation;
+}
+
+/**
+ *  Queue a GATT operation for the next connection event.  The payload of a
+ *  data operation is copied, as a BLE controller would, and the stack's
+ *  reference to it released.
+ */
+static bool QueueLinkOp(LinkOpType type, PacketBuffer *pBuf)
+{
+    LinkOp op;
+
+    op.type = type;
+    op.event = sEventCount + 1;
+    op.buf = NULL;
+
+    if (pBuf != NULL)
+    {
+        op.buf = PacketBuffer::New();
+
+        if (op.buf == NULL || pBuf->DataLength() > op.buf->AvailableDataLength())
+        {
+            PacketBuffer::Free(op.buf);
+            PacketBuffer::Free(pBuf);
+            return false;
+        }
+
+        memcpy(op.buf->Start(), pBuf->Start(), pBuf->DataLength());
+        op.buf->SetDataLength(pBuf->DataLength());
+        PacketBuffer::Free(pBuf);
+    }
+
+    sLinkOps.push_back(op);
+
+    return true;
+}
+
+static void DiscardLinkOps(void)
+{
+    while (!sLinkOps.empty())
+    {
+        PacketBuffer::Free(sLinkOps.front().buf);
+        sLinkOps.pop_front();
+    }
+}
+
+/**
+ *  Deliver a GATT operation to the device it is addressed to, and queue its
+ *  confirmation for the following connection event.
+ */
+static void DeliverLinkOp(const LinkOp &op)
+{
+    bool senderIsCentral = IsSentByCentral(op.type);
+
+    if (IsDataOp(op.type))
+    {
+        if (senderIsCentral != gPeripheralSends)
+        {
+            sRun.fragments++;
+        }
+        else
+        {
+            sRun.acks++;
+        }
+    }
+
+    switch (op.type)
+    {
+    case kLinkOp_WriteRequest:
+        sPeripheralBle.HandleWriteReceived(sPeripheralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharRxId, op.buf);
+        QueueLinkOp(kLinkOp_WriteConfirmation, NULL);
+        break;
+    case kLinkOp_WriteWithoutResponse:
+        sPeripheralBle.HandleWriteReceived(sPeripheralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharRxId, op.buf);
+        break;
+    case kLinkOp_Indication:
+        sCentralBle.HandleIndicationReceived(sCentralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharTxId, op.buf);
+        QueueLinkOp(kLinkOp_IndicationConfirmation, NULL);
+        break;
+    case kLinkOp_Notification:
+        sCentralBle.HandleIndicationReceived(sCentralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharTxId, op.buf);
+        break;
+    case kLinkOp_Subscribe:
+        sPeripheralBle.HandleSubscribeReceived(sPeripheralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharTxId);
+        QueueLinkOp(kLinkOp_SubscribeComplete, NULL);
+        break;
+    case kLinkOp_Unsubscribe:
+        sPeripheralBle.HandleUnsubscribeReceived(sPeripheralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharTxId);
+        QueueLinkOp(kLinkOp_UnsubscribeComplete, NULL);
+        break;
+    case kLinkOp_WriteConfirmation:
+        sCentralBle.HandleWriteConfirmation(sCentralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharRxId);
+        break;
+    case kLinkOp_IndicationConfirmation:
+        sPeripheralBle.HandleIndicationConfirmation(sPeripheralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharTxId);
+        break;
+    case kLinkOp_SubscribeComplete:
+        sCentralBle.HandleSubscribeComplete(sCentralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharTxId);
+        break;
+    case kLinkOp_UnsubscribeComplete:
+        sCentralBle.HandleUnsubscribeComplete(sCentralConnObj, &WEAVE_BLE_SVC_ID, &sWeaveCharTxId);
+        break;
+    }
+}
+
+/**
+ *  Run a connection event of the simulated link: deliver the operations
+ *  queued before it, up to the given number of data packets per direction,
+ *  in the order they were queued.
+ */
+static void HandleConnectionEvent(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    std::vector<LinkOp> dueOps;
+    int32_t dataOps[2] = { 0, 0 };
+
+    sEventCount++;
+
+    // Take the operations out of the queue first, as their delivery queues further operations.
+    for (std::deque<LinkOp>::iterator it = sLinkOps.begin(); it != sLinkOps.end(); )
+    {
+        int dir = IsSentByCentral(it->type) ? 0 : 1;
+
+        if (it->event <= sEventCount && (!IsDataOp(it->type) || dataOps[dir] < gPacketsPerEvent))
+        {
+            if (IsDataOp(it->type))
+            {
+                dataOps[dir]++;
+            }
+
+            dueOps.push_back(*it);
+            it = sLinkOps.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (size_t i = 0; i < dueOps.size(); i++)
+    {
+        DeliverLinkOp(dueOps[i]);
+    }
+
+    SystemLayer.StartTimer(gConnectionIntervalMs, HandleConnectionEvent, NULL);
+}
+
+/**
+ *  The platform delegate of both devices, which carries their GATT
+ *  operations over the simulated link.
+ */
+class BenchBlePlatformDelegate : public nl::Ble::BlePlatformDelegate
+{
+public:
+    bool SubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID *svcId, const WeaveBleUUID *charId)
+    {
+        return QueueLinkOp(kLinkOp_Subscribe, NULL);
+    }
+
+    bool UnsubscribeCharacteristic(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID *svcId, const WeaveBleUUID *charId)
+    {
+        return QueueLinkOp(kLinkOp_Unsubscribe, NULL);
+    }
+
+    bool CloseConnection(BLE_CONNECTION_OBJECT connObj)
+    {
+        return true;
+    }
+
+    uint16_t GetMTU(BLE_CONNECTION_OBJECT connObj) const
+    {
+        return sRun.mtu;
+    }
+
+    bool SendIndication(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID *svcId, const WeaveBleUUID *charId,
+                        PacketBuffer *pBuf)
+    {
+        return QueueLinkOp(kLinkOp_Indication, pBuf);
+    }
+
+    bool SendWriteRequest(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID *svcId, const WeaveBleUUID *charId,
+                          PacketBuffer *pBuf)
+    {
+        // The first write of the central is its capabilities request.  Lower the receive window size it
+        // offers to the one benchmarked, which both devices then use.
+        if (!sRun.windowSet)
+        {
+            BleTransportCapabilitiesRequestMessage req;
+
+            if (BleTransportCapabilitiesRequestMessage::Decode(*pBuf, req) == BLE_NO_ERROR)
+            {
+                req.mWindowSize = nl::Weave::min(req.mWindowSize, sRun.windowSize);
+                req.Encode(pBuf);
+            }
+
+            sRun.windowSet = true;
+        }
+
+        return QueueLinkOp(kLinkOp_WriteRequest, pBuf);
+    }
+
+#if BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+    bool SendNotification(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID *svcId, const WeaveBleUUID *charId,
+                          PacketBuffer *pBuf)
+    {
+        return QueueLinkOp(kLinkOp_Notification, pBuf);
+    }
+
+    bool SendWriteWithoutResponse(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID *svcId, const WeaveBleUUID *charId,
+                                  PacketBuffer *pBuf)
+    {
+        return QueueLinkOp(kLinkOp_WriteWithoutResponse, pBuf);
+    }
+#endif // BLE_CONFIG_UNCONFIRMED_GATT_OPERATIONS
+
+    bool SendReadRequest(BLE_CONNECTION_OBJECT connObj, const WeaveBleUUID *svcId, const WeaveBleUUID *charId,
+                         PacketBuffer *pBuf)
+    {
+        PacketBuffer::Free(pBuf);
+        return false;
+    }
+
+    bool SendReadResponse(BLE_CONNECTION_OBJECT connObj, BLE_READ_REQUEST_CONTEXT requestContext, const WeaveBleUUID *svcId,
+                          const WeaveBleUUID *charId)
+    {
+        return false;
+    }
+};
+
+class BenchBleApplicationDelegate : public nl::Ble::BleApplicationDelegate
+{
+public:
+    void NotifyWeaveConnectionClosed(BLE_CONNECTION_OBJECT connObj)
+    {
+    }
+};
+
+static BenchBlePlatformDelegate sPlatformDelegate;
+static BenchBleApplicationDelegate sApplicationDelegate;
+
+static void EndRun(bool failed)
+{
+    if (!sRun.done)
+    {
+        sRun.done = true;
+        sRun.failed = failed;
+        sRun.elapsedUs = System::Layer::GetClock_Monotonic() - sRun.startUs;
+    }
+}
+
+/**
+ *  Send the next messages, keeping the given number of them outstanding.
+ *  Each message carries its index, with which its latency is measured.
+ */
+static void SendMessages(void)
+{
+    BLEEndPoint *sender = gPeripheralSends ? sPeripheralEndPoint : sCentralEndPoint;
+
+    while (!sRun.done && sRun.messagesSent < static_cast<uint32_t>(gMessageCount) &&
+           sRun.messagesSent - sRun.messagesReceived < static_cast<uint32_t>(gOutstanding))
+    {
+        PacketBuffer *msg = PacketBuffer::NewWithAvailableSize(gMessageSize);
+        uint8_t *p;
+        BLE_ERROR err;
+
+        if (msg == NULL)
+        {
+            printf("PacketBuffer allocation failed\n");
+            EndRun(true);
+            return;
+        }
+
+        p = msg->Start();
+        nl::Weave::Encoding::LittleEndian::Put32(p, sRun.messagesSent);
+        for (int32_t i = 4; i < gMessageSize; i++)
+        {
+            p[i] = static_cast<uint8_t>(i);
+        }
+        msg->SetDataLength(gMessageSize);
+
+        sSendTimesUs[sRun.messagesSent++] = System::Layer::GetClock_Monotonic();
+
+        err = sender->Send(msg);
+        if (err != BLE_NO_ERROR)
+        {
+            printf("BLEEndPoint::Send failed: %s\n", ErrorStr(err));
+            EndRun(true);
+            return;
+        }
+    }
+}
+
+static void StartSending(void)
+{
+    // Wait for both end points to complete the BTP handshake.
+    if (sCentralEndPoint == NULL || sCentralEndPoint->mState != BLEEndPoint::kState_Connected ||
+        sPeripheralEndPoint == NULL || sPeripheralEndPoint->mState != BLEEndPoint::kState_Connected)
+    {
+        return;
+    }
+
+    sRun.handshakeUs = System::Layer::GetClock_Monotonic() - sRun.startUs;
+    sRun.startUs += sRun.handshakeUs;
+    sRun.fragments = 0;
+    sRun.acks = 0;
+
+    SendMessages();
+}
+
+static void HandleMessageReceived(BLEEndPoint *endPoint, PacketBuffer *msg)
+{
+    uint64_t now = System::Layer::GetClock_Monotonic();
+    uint32_t index;
+    uint64_t latencyUs;
+
+    if (msg->DataLength() != gMessageSize)
+    {
+        printf("Received message of unexpected length %u\n", msg->DataLength());
+        PacketBuffer::Free(msg);
+        EndRun(true);
+        return;
+    }
+
+    index = nl::Weave::Encoding::LittleEndian::Get32(msg->Start());
+    PacketBuffer::Free(msg);
+
+    if (index >= sRun.messagesSent)
+    {
+        printf("Received unexpected message %u\n", index);
+        EndRun(true);
+        return;
+    }
+
+    latencyUs = now - sSendTimesUs[index];
+    sRun.latencyTotalUs += latencyUs;
+    sRun.latencyMaxUs = nl::Weave::max(sRun.latencyMaxUs, latencyUs);
+    sRun.bytesReceived += gMessageSize;
+    sRun.messagesReceived++;
+
+    if (sRun.messagesReceived == static_cast<uint32_t>(gMessageCount))
+    {
+        EndRun(false);
+    }
+    else
+    {
+        SendMessages();
+    }
+}
+
+static void HandleConnectionClosed(BLEEndPoint *endPoint, BLE_ERROR err)
+{
+    if (!sRun.done)
+    {
+        printf("WoBLE connection closed: %s\n", ErrorStr(err));
+        EndRun(true);
+    }
+}
+
+static void HandleCentralConnectComplete(BLEEndPoint *endPoint, BLE_ERROR err)
+{
+    if (err != BLE_NO_ERROR)
+    {
+        printf("WoBLE connect failed: %s\n", ErrorStr(err));
+        EndRun(true);
+        return;
+    }
+
+    StartSending();
+}
+
+static void HandlePeripheralConnectionReceived(BLEEndPoint *endPoint)
+{
+    sPeripheralEndPoint = endPoint;
+    sPeripheralEndPoint->OnMessageReceived = HandleMessageReceived;
+    sPeripheralEndPoint->OnConnectionClosed = HandleConnectionClosed;
+
+    StartSending();
+}
+
+static void HandleRunTimeout(System::Layer *aSystemLayer, void *aAppState, System::Error aError)
+{
+    sRun.timedOut = true;
+    EndRun(true);
+}
+
+/**
+ *  Run one benchmark, from the BTP handshake until the receiver has
+ *  received all the messages.
+ */
+static WEAVE_ERROR RunBenchmark(uint16_t mtu, uint8_t windowSize)
+{
+    WEAVE_ERROR err;
+
+    memset(&sRun, 0, sizeof(sRun));
+    sRun.mtu = mtu;
+    sRun.windowSize = windowSize;
+
+    sSendTimesUs.assign(gMessageCount, 0);
+    sEventCount = 0;
+    sCentralEndPoint = NULL;
+    sPeripheralEndPoint = NULL;
+
+    err = sCentralBle.Init(&sPlatformDelegate, &sApplicationDelegate, &SystemLayer);
+    SuccessOrExit(err);
+
+    err = sPeripheralBle.Init(&sPlatformDelegate, &sApplicationDelegate, &SystemLayer);
+    SuccessOrExit(err);
+
+    sPeripheralBle.OnWeaveBleConnectReceived = HandlePeripheralConnectionReceived;
+
+    err = SystemLayer.StartTimer(kRunTimeoutMs, HandleRunTimeout, NULL);
+    SuccessOrExit(err);
+
+    err = SystemLayer.StartTimer(gConnectionIntervalMs, HandleConnectionEvent, NULL);
+    SuccessOrExit(err);
+
+    sRun.startUs = System::Layer::GetClock_Monotonic();
+
+    err = sCentralBle.NewBleEndPoint(&sCentralEndPoint, sCentralConnObj, nl::Ble::kBleRole_Central, false);
+    SuccessOrExit(err);
+
+    sCentralEndPoint->OnConnectComplete = HandleCentralConnectComplete;
+    sCentralEndPoint->OnMessageReceived = HandleMessageReceived;
+    sCentralEndPoint->OnConnectionClosed = HandleConnectionClosed;
+
+    err = sCentralEndPoint->StartConnect();
+    SuccessOrExit(err);
+
+    ServiceNetworkUntil(&sRun.done);
+
+exit:
+    SystemLayer.CancelTimer(HandleConnectionEvent, NULL);
+    SystemLayer.CancelTimer(HandleRunTimeout, NULL);
+
+    // Shutting the layers down aborts and frees the end points of both.
+    sCentralBle.Shutdown();
+    sPeripheralBle.Shutdown();
+    DiscardLinkOps();
+
+    return err;
+}
+
+static void Report(void)
+{
+    double elapsedS = (sRun.elapsedUs != 0) ? sRun.elapsedUs / 1000000.0 : 1.0;
+    double latencyAvgMs = (sRun.messagesReceived != 0) ? (sRun.latencyTotalUs / 1000.0) / sRun.messagesReceived : 0.0;
+
+    if (sRun.failed)
+    {
+        printf("MTU %3u window %3u: FAILED%s after %u of %d messages\n", sRun.mtu, sRun.windowSize,
+               sRun.timedOut ? " (timed out)" : "", sRun.messagesReceived, gMessageCount);
+        return;
+    }
+
+    printf("MTU %3u window %3u: %9.1f B/s %7.1f frags/s %5u frags %5u acks %8.1f ms avg %8.1f ms max latency "
+           "%6.1f ms handshake\n",
+           sRun.mtu, sRun.windowSize, sRun.bytesReceived / elapsedS, sRun.fragments / elapsedS, sRun.fragments, sRun.acks,
+           latencyAvgMs, sRun.latencyMaxUs / 1000.0, sRun.handshakeUs / 1000.0);
+}
+
+static OptionDef gToolOptionDefs[] =
+{
+    { "interval",           kArgumentRequired, 'i' },
+    { "packets-per-event",  kArgumentRequired, 'p' },
+    { "mtu",                kArgumentRequired, 'm' },
+    { "window-size",        kArgumentRequired, 'w' },
+    { "size",               kArgumentRequired, 's' },
+    { "count",              kArgumentRequired, 'c' },
+    { "outstanding",        kArgumentRequired, 'o' },
+    { "sender",             kArgumentRequired, 'S' },
+    { }
+};
+
+static const char *const gToolOptionHelp =
+    "  -i, --interval <ms>\n"
+    "       Simulated BLE connection interval. Defaults to 30 ms.\n"
+    "\n"
+    "  -p, --packets-per-event <int>\n"
+    "       Maximum number of GATT data packets each device sends per connection\n"
+    "       event. Defaults to 4.\n"
+    "\n"
+    "  -m, --mtu <int>\n"
+    "       Benchmark only the given ATT MTU. Defaults to 23, 185 and 247 bytes.\n"
+    "\n"
+    "  -w, --window-size <int>\n"
+    "       Benchmark only the given BTP receive window size. Defaults to 3 and\n"
+    "       BLE_MAX_RECEIVE_WINDOW_SIZE fragments.\n"
+    "\n"
+    "  -s, --size <int>\n"
+    "       Size of the messages sent, in bytes. Defaults to 512.\n"
+    "\n"
+    "  -c, --count <int>\n"
+    "       Number of messages sent. Defaults to 20.\n"
+    "\n"
+    "  -o, --outstanding <int>\n"
+    "       Number of messages sent ahead of their receipt. Defaults to 1, which\n"
+    "       measures the latency of a message sent on an idle connection.\n"
+    "\n"
+    "  -S, --sender <central|peripheral>\n"
+    "       Device that sends the messages. Defaults to the central.\n"
+    "\n"
+    ;
+
+static OptionSet gToolOptions =
+{
+    HandleOption,
+    gToolOptionDefs,
+    "GENERAL OPTIONS",
+    gToolOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    TOOL_NAME,
+    "Usage: " TOOL_NAME " [<options...>]\n",
+    WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+    "Throughput and latency benchmark for Weave over BLE, over a simulated BLE link.\n"
+);
+
+static OptionSet *gToolOptionSets[] =
+{
+    &gToolOptions,
+    &gHelpOptions,
+    NULL
+};
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case 'i':
+        if (!ParseInt(arg, gConnectionIntervalMs) || gConnectionIntervalMs <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for interval: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'p':
+        if (!ParseInt(arg, gPacketsPerEvent) || gPacketsPerEvent <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for packets per event: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'm':
+        if (!ParseInt(arg, gMTU) || gMTU < kMinMTU || gMTU > kMaxMTU)
+        {
+            PrintArgError("%s: Invalid value specified for MTU: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'w':
+        if (!ParseInt(arg, gWindowSize) || gWindowSize < kMinWindowSize || gWindowSize > BLE_MAX_RECEIVE_WINDOW_SIZE)
+        {
+            PrintArgError("%s: Invalid value specified for window size: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 's':
+        // Each message carries its 4-byte index, and must fit in a single PacketBuffer.
+        if (!ParseInt(arg, gMessageSize) || gMessageSize < 4 ||
+            gMessageSize > WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX - WEAVE_SYSTEM_CONFIG_HEADER_RESERVE_SIZE)
+        {
+            PrintArgError("%s: Invalid value specified for size: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'c':
+        if (!ParseInt(arg, gMessageCount) || gMessageCount <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for count: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'o':
+        if (!ParseInt(arg, gOutstanding) || gOutstanding <= 0)
+        {
+            PrintArgError("%s: Invalid value specified for outstanding: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'S':
+        if (strcmp(arg, "central") == 0)
+        {
+            gPeripheralSends = false;
+        }
+        else if (strcmp(arg, "peripheral") == 0)
+        {
+            gPeripheralSends = true;
+        }
+        else
+        {
+            PrintArgError("%s: Invalid value specified for sender: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ *  Main
+ */
+int main(int argc, char *argv[])
+{
+    WEAVE_ERROR err;
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    tcpip_init(NULL, NULL);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    InitToolCommon();
+
+    if (!ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    InitSystemLayer();
+    InitNetwork();
+
+    printf("%d messages of %d bytes from the %s, %d outstanding, %d ms connection interval, %d packets per event\n",
+           gMessageCount, gMessageSize, gPeripheralSends ? "peripheral" : "central", gOutstanding, gConnectionIntervalMs,
+           gPacketsPerEvent);
+
+    for (size_t m = 0; m < sizeof(sDefaultMTUs) / sizeof(sDefaultMTUs[0]); m++)
+    {
+        uint16_t mtu = (gMTU != 0) ? gMTU : sDefaultMTUs[m];
+
+        for (size_t w = 0; w < sizeof(sDefaultWindowSizes) / sizeof(sDefaultWindowSizes[0]); w++)
+        {
+            uint8_t windowSize = (gWindowSize != 0) ? gWindowSize : sDefaultWindowSizes[w];
+
+            // Skip the duplicate of the default window sizes when BLE_MAX_RECEIVE_WINDOW_SIZE is the minimum.
+            if (w > 0 && gWindowSize == 0 && windowSize == sDefaultWindowSizes[w - 1])
+            {
+                continue;
+            }
+
+            err = RunBenchmark(mtu, windowSize);
+            FAIL_ERROR(err, "RunBenchmark failed");
+
+            Report();
+
+            if (gWindowSize != 0)
+            {
+                break;
+            }
+        }
+
+        if (gMTU != 0)
+        {
+            break;
+        }
+    }
+
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return EXIT_SUCCESS;
+}
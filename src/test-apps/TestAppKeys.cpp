@@ -271,6 +271,37 @@ void DeriveAppRotatingKey_Test(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, memcmp(appRotatingKey, sAppRotatingKey_SRK_E3_G54, sAppRotatingKeyLen_SRK_E3_G54) == 0);
 }
 
+void DeriveAppKeyWithSaltKeySchedule_Test(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    TestGroupKeyStore keyStore;
+    HMACSHA1KeySchedule saltKeySchedule;
+    uint8_t appKey[sAppRotatingKeyLen_SRK_E3_G54];
+    uint32_t keyId;
+    uint32_t appGroupGlobalId;
+
+    // Derive application rotating key using the precomputed key schedule of an empty salt.
+    saltKeySchedule.SetKey(NULL, 0);
+
+    keyId = sAppRotatingKeyId_SRK_E3_G54;
+    err = keyStore.DeriveApplicationKey(keyId, saltKeySchedule,
+                                        sAppRotatingKeyDiversifier_SRK_E3_G54, sAppRotatingKeyDiversifierLen_SRK_E3_G54,
+                                        appKey, sizeof(appKey), sAppRotatingKeyLen_SRK_E3_G54, appGroupGlobalId);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, appGroupGlobalId == sAppGroupMasterKey54_GlobalId);
+    NL_TEST_ASSERT(inSuite, keyId == sAppRotatingKeyId_SRK_E3_G54);
+    NL_TEST_ASSERT(inSuite, memcmp(appKey, sAppRotatingKey_SRK_E3_G54, sAppRotatingKeyLen_SRK_E3_G54) == 0);
+
+    // The key schedule can be reused for further derivations.
+    keyId = sAppStaticKeyId_CRK_G10;
+    err = keyStore.DeriveApplicationKey(keyId, saltKeySchedule,
+                                        sAppStaticKeyDiversifier_CRK_G10, sAppStaticKeyDiversifierLen_CRK_G10,
+                                        appKey, sizeof(appKey), sAppStaticKeyLen_CRK_G10, appGroupGlobalId);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, keyId == sAppStaticKeyId_CRK_G10);
+    NL_TEST_ASSERT(inSuite, memcmp(appKey, sAppStaticKey_CRK_G10, sAppStaticKeyLen_CRK_G10) == 0);
+}
+
 void DerivePasscodeKeys_Test(nlTestSuite *inSuite, void *inContext)
 {
     WEAVE_ERROR err;
@@ -407,6 +438,27 @@ void GetAppGroupMasterKeyId_Test(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, groupMasterKeyId == sAppGroupMasterKey54_KeyId);
 }
 
+void EnumerateEpochKeys_Test(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    TestGroupKeyStore keyStore;
+    uint32_t keyIds[WEAVE_CONFIG_MAX_APPLICATION_EPOCH_KEYS];
+    uint32_t startTimes[WEAVE_CONFIG_MAX_APPLICATION_EPOCH_KEYS];
+    uint8_t keyCount;
+
+    // Enumerate all epoch keys along with their start times.
+    err = keyStore.EnumerateEpochKeys(keyIds, startTimes, WEAVE_CONFIG_MAX_APPLICATION_EPOCH_KEYS, keyCount);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, keyCount == 4);
+    NL_TEST_ASSERT(inSuite, keyIds[0] == sEpochKey0_KeyId && startTimes[0] == sEpochKey0_StartTime);
+    NL_TEST_ASSERT(inSuite, keyIds[1] == sEpochKey1_KeyId && startTimes[1] == sEpochKey1_StartTime);
+    NL_TEST_ASSERT(inSuite, keyIds[2] == sEpochKey2_KeyId && startTimes[2] == sEpochKey2_StartTime);
+    NL_TEST_ASSERT(inSuite, keyIds[3] == sEpochKey3_KeyId && startTimes[3] == sEpochKey3_StartTime);
+
+    // A group global Id that matches no group master key is not found.
+    err = keyStore.FindGroupMasterKeyId(0xDEADBEEF, keyIds[0]);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_KEY_NOT_FOUND);
+}
 
 int main(int argc, char *argv[])
 {
@@ -415,8 +467,10 @@ int main(int argc, char *argv[])
         NL_TEST_DEF("DeriveAppIntermediateKey",         DeriveAppIntermediateKey_Test),
         NL_TEST_DEF("DeriveAppStaticKey",               DeriveAppStaticKey_Test),
         NL_TEST_DEF("DeriveAppRotatingKey",             DeriveAppRotatingKey_Test),
+        NL_TEST_DEF("DeriveAppKeyWithSaltKeySchedule",  DeriveAppKeyWithSaltKeySchedule_Test),
         NL_TEST_DEF("DerivePasscodeKeys",               DerivePasscodeKeys_Test),
         NL_TEST_DEF("GetAppGroupMasterKeyId",           GetAppGroupMasterKeyId_Test),
+        NL_TEST_DEF("EnumerateEpochKeys",               EnumerateEpochKeys_Test),
         NL_TEST_SENTINEL()
     };
 
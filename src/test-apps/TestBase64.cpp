@@ -0,0 +1,292 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the Weave
+ *      base-64 encoding and decoding functions.
+ *
+ */
+
+#ifndef __STDC_LIMIT_MACROS
+#define __STDC_LIMIT_MACROS
+#endif
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Weave/Support/Base64.h>
+#include <SystemLayer/SystemLayer.h>
+
+#include <nlunit-test.h>
+
+using namespace nl;
+
+// Reference character conversions, matching the ones in Base64.cpp.  Passing these to the function pointer variants
+// selects the character-at-a-time code, against which the table-driven code is checked.
+
+static char RefValToChar(uint8_t val)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    return (val < 64) ? alphabet[val] : '=';
+}
+
+static uint8_t RefCharToVal(uint8_t c)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const char *p = (c != 0) ? strchr(alphabet, c) : NULL;
+    return (p != NULL) ? (uint8_t)(p - alphabet) : UINT8_MAX;
+}
+
+enum
+{
+    kMaxTestLen     = 300,
+    kThroughputLen  = 48 * 1024,
+    kThroughputReps = 64
+};
+
+static void FillRandom(uint8_t *buf, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+        buf[i] = (uint8_t)rand();
+}
+
+static void CheckKnownVectors(nlTestSuite *inSuite, void *inContext)
+{
+    static const struct
+    {
+        const char *decoded;
+        const char *encoded;
+    } sVectors[] = {
+        { "",       ""         },
+        { "f",      "Zg=="     },
+        { "fo",     "Zm8="     },
+        { "foo",    "Zm9v"     },
+        { "foob",   "Zm9vYg==" },
+        { "fooba",  "Zm9vYmE=" },
+        { "foobar", "Zm9vYmFy" },
+    };
+    char encoded[32];
+    uint8_t decoded[32];
+
+    for (size_t i = 0; i < sizeof(sVectors) / sizeof(sVectors[0]); i++)
+    {
+        uint16_t decodedLen = (uint16_t)strlen(sVectors[i].decoded);
+        uint16_t encodedLen = (uint16_t)strlen(sVectors[i].encoded);
+
+        NL_TEST_ASSERT(inSuite, Base64Encode((const uint8_t *)sVectors[i].decoded, decodedLen, encoded) == encodedLen);
+        NL_TEST_ASSERT(inSuite, memcmp(encoded, sVectors[i].encoded, encodedLen) == 0);
+
+        NL_TEST_ASSERT(inSuite, Base64Decode(sVectors[i].encoded, encodedLen, decoded) == decodedLen);
+        NL_TEST_ASSERT(inSuite, memcmp(decoded, sVectors[i].decoded, decodedLen) == 0);
+    }
+
+    // Unpadded input and the URL alphabet.
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9vYmE", 7, decoded) == 5);
+    NL_TEST_ASSERT(inSuite, Base64URLDecode("QmFzZTY0D-8xMjM0D_8=", 20, decoded) == 14);
+    NL_TEST_ASSERT(inSuite, Base64URLEncode(decoded, 14, encoded) == 20);
+    NL_TEST_ASSERT(inSuite, memcmp(encoded, "QmFzZTY0D-8xMjM0D_8=", 20) == 0);
+}
+
+static void CheckInvalidInput(nlTestSuite *inSuite, void *inContext)
+{
+    uint8_t decoded[16];
+
+    NL_TEST_ASSERT(inSuite, Base64Decode("Z", 1, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64Decode("Z\x01" "9vYmFy", 8, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9vY", 5, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9vY;", 6, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9 vYg", 7, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9v*mFy", 8, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9v-_==", 8, decoded) == UINT16_MAX);
+    NL_TEST_ASSERT(inSuite, Base64URLDecode("Zm9v+/==", 8, decoded) == UINT16_MAX);
+
+    // Decoding ends quietly at whitespace between groups.
+    NL_TEST_ASSERT(inSuite, Base64Decode("Zm9v\nYmFy", 9, decoded) == 3);
+}
+
+static void CheckMatchesReference(nlTestSuite *inSuite, void *inContext)
+{
+    uint8_t data[kMaxTestLen];
+    char encoded[BASE64_ENCODED_LEN(kMaxTestLen)];
+    char refEncoded[BASE64_ENCODED_LEN(kMaxTestLen)];
+    uint8_t decoded[kMaxTestLen];
+    uint8_t refDecoded[kMaxTestLen];
+
+    FillRandom(data, sizeof(data));
+
+    for (uint16_t len = 0; len <= kMaxTestLen; len++)
+    {
+        uint16_t encodedLen = Base64Encode(data, len, encoded);
+        uint16_t decodedLen;
+
+        NL_TEST_ASSERT(inSuite, encodedLen == BASE64_ENCODED_LEN(len));
+        NL_TEST_ASSERT(inSuite, Base64Encode(data, len, refEncoded, RefValToChar) == encodedLen);
+        NL_TEST_ASSERT(inSuite, memcmp(encoded, refEncoded, encodedLen) == 0);
+        NL_TEST_ASSERT(inSuite, Base64Encode32(data, len, refEncoded) == encodedLen);
+        NL_TEST_ASSERT(inSuite, memcmp(encoded, refEncoded, encodedLen) == 0);
+
+        decodedLen = Base64Decode(encoded, encodedLen, decoded);
+        NL_TEST_ASSERT(inSuite, decodedLen == len);
+        NL_TEST_ASSERT(inSuite, memcmp(decoded, data, len) == 0);
+        NL_TEST_ASSERT(inSuite, Base64Decode(encoded, encodedLen, refDecoded, RefCharToVal) == decodedLen);
+        NL_TEST_ASSERT(inSuite, memcmp(refDecoded, data, len) == 0);
+
+        // Decode in place.
+        NL_TEST_ASSERT(inSuite, Base64Decode32(encoded, encodedLen, (uint8_t *)encoded) == len);
+        NL_TEST_ASSERT(inSuite, memcmp(encoded, data, len) == 0);
+    }
+}
+
+static void CheckStreaming(nlTestSuite *inSuite, void *inContext)
+{
+    uint8_t data[kMaxTestLen];
+    char encoded[BASE64_ENCODED_LEN(kMaxTestLen)];
+    char streamEncoded[BASE64_ENCODED_LEN(kMaxTestLen) + kMaxTestLen];
+    uint8_t streamDecoded[kMaxTestLen + 4];
+
+    FillRandom(data, sizeof(data));
+
+    for (uint16_t len = 0; len <= kMaxTestLen; len += 7)
+    {
+        uint16_t encodedLen = Base64Encode(data, len, encoded);
+        Base64Encoder encoder;
+        Base64Decoder decoder;
+        uint32_t streamLen = 0;
+        uint32_t pos;
+        uint32_t outLen;
+
+        // Encode in randomly sized pieces.
+        encoder.Init();
+        for (pos = 0; pos < len; )
+        {
+            uint32_t pieceLen = 1 + rand() % 17;
+            if (pieceLen > len - pos)
+                pieceLen = len - pos;
+            streamLen += encoder.Update(data + pos, pieceLen, streamEncoded + streamLen);
+            pos += pieceLen;
+        }
+        streamLen += encoder.Finalize(streamEncoded + streamLen);
+
+        NL_TEST_ASSERT(inSuite, streamLen == encodedLen);
+        NL_TEST_ASSERT(inSuite, memcmp(streamEncoded, encoded, encodedLen) == 0);
+
+        // Break the encoding into lines, then decode it in randomly sized pieces.
+        streamLen = 0;
+        for (pos = 0; pos < encodedLen; pos++)
+        {
+            streamEncoded[streamLen++] = encoded[pos];
+            if (pos % 64 == 63)
+                streamEncoded[streamLen++] = '\n';
+        }
+
+        decoder.Init();
+        outLen = 0;
+        for (pos = 0; pos < streamLen; )
+        {
+            uint32_t pieceLen = 1 + rand() % 13;
+            uint32_t res;
+            if (pieceLen > streamLen - pos)
+                pieceLen = streamLen - pos;
+            res = decoder.Update(streamEncoded + pos, pieceLen, streamDecoded + outLen);
+            NL_TEST_ASSERT(inSuite, res != UINT32_MAX);
+            outLen += res;
+            pos += pieceLen;
+        }
+        outLen += decoder.Finalize(streamDecoded + outLen);
+
+        NL_TEST_ASSERT(inSuite, outLen == len);
+        NL_TEST_ASSERT(inSuite, memcmp(streamDecoded, data, len) == 0);
+    }
+
+    // Padding may only be followed by padding or whitespace, and a lone trailing character is an error.
+    {
+        Base64Decoder decoder;
+        uint8_t out[8];
+
+        decoder.Init();
+        NL_TEST_ASSERT(inSuite, decoder.Update("Zg==\n", 5, out) == 1);
+        NL_TEST_ASSERT(inSuite, decoder.Update("Zg", 2, out) == UINT32_MAX);
+        NL_TEST_ASSERT(inSuite, decoder.Finalize(out) == UINT32_MAX);
+
+        decoder.Init();
+        NL_TEST_ASSERT(inSuite, decoder.Update("Zm9vY", 5, out) == 3);
+        NL_TEST_ASSERT(inSuite, decoder.Finalize(out) == UINT32_MAX);
+
+        decoder.InitURL();
+        NL_TEST_ASSERT(inSuite, decoder.Update("D-8", 3, out) == 0);
+        NL_TEST_ASSERT(inSuite, decoder.Finalize(out) == 2);
+        NL_TEST_ASSERT(inSuite, out[0] == 0x0F && out[1] == 0xEF);
+    }
+}
+
+static void CheckThroughput(nlTestSuite *inSuite, void *inContext)
+{
+    static uint8_t data[kThroughputLen];
+    static char encoded[BASE64_ENCODED_LEN(kThroughputLen)];
+    uint64_t start, fastUsec, refUsec;
+    uint32_t encodedLen = 0;
+
+    FillRandom(data, sizeof(data));
+
+    start = nl::Weave::System::Layer::GetClock_MonotonicHiRes();
+    for (int i = 0; i < kThroughputReps; i++)
+    {
+        encodedLen = Base64Encode32(data, kThroughputLen, encoded);
+        NL_TEST_ASSERT(inSuite, Base64Decode32(encoded, encodedLen, data) == kThroughputLen);
+    }
+    fastUsec = nl::Weave::System::Layer::GetClock_MonotonicHiRes() - start;
+
+    start = nl::Weave::System::Layer::GetClock_MonotonicHiRes();
+    for (int i = 0; i < kThroughputReps; i++)
+    {
+        encodedLen = Base64Encode32(data, kThroughputLen, encoded, RefValToChar);
+        NL_TEST_ASSERT(inSuite, Base64Decode32(encoded, encodedLen, data, RefCharToVal) == kThroughputLen);
+    }
+    refUsec = nl::Weave::System::Layer::GetClock_MonotonicHiRes() - start;
+
+    // Timing is reported rather than asserted, since it depends on the host.
+    printf("base-64 encode+decode of %u bytes x %u: %" PRIu64 " usec (character-at-a-time: %" PRIu64 " usec)\n",
+           (unsigned)kThroughputLen, (unsigned)kThroughputReps, fastUsec, refUsec);
+}
+
+static const nlTest sTests[] = {
+    NL_TEST_DEF("known vectors",         CheckKnownVectors),
+    NL_TEST_DEF("invalid input",         CheckInvalidInput),
+    NL_TEST_DEF("matches reference",     CheckMatchesReference),
+    NL_TEST_DEF("streaming",             CheckStreaming),
+    NL_TEST_DEF("throughput",            CheckThroughput),
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "weave-base64",
+        &sTests[0]
+    };
+
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
@@ -119,6 +119,7 @@ static int32_t sContext[] =
       BLE_ERROR_INVALID_BTP_SEQUENCE_NUMBER,
       BLE_ERROR_REASSEMBLER_INCORRECT_STATE,
       BLE_ERROR_RECEIVED_MESSAGE_TOO_BIG,
+      BLE_ERROR_L2CAP_SEND_FAILED,
 
       WEAVE_ERROR_TOO_MANY_CONNECTIONS,
       WEAVE_ERROR_SENDING_BLOCKED,
@@ -294,6 +295,7 @@ static int32_t sContext[] =
       WEAVE_ERROR_SESSION_KEY_SUSPENDED,
       WEAVE_ERROR_UNSUPPORTED_WIRELESS_REGULATORY_DOMAIN,
       WEAVE_ERROR_UNSUPPORTED_WIRELESS_OPERATING_LOCATION,
+      WEAVE_ERROR_CASE_RESUMPTION_TICKET_NOT_FOUND,
 
       WEAVE_ERROR_TUNNEL_ROUTING_RESTRICTED,
 
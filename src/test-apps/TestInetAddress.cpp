@@ -25,6 +25,7 @@
  */
 
 #include <InetLayer/IPAddress.h>
+#include <InetLayer/IPPrefixTrie.h>
 #include "ToolCommon.h"
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -1694,6 +1695,69 @@ static void CheckIPPrefix(nlTestSuite *inSuite, void *inContext)
     }
 }
 
+/**
+ *  Test IPPrefixTrie longest-prefix match.
+ */
+static void CheckIPPrefixTrie(nlTestSuite *inSuite, void *inContext)
+{
+    IPPrefixTrie::Node nodes[IPPrefixTrie::NodesForPrefixes(4)];
+    IPPrefixTrie trie;
+    IPPrefix prefix;
+    IPAddress addr;
+    uint8_t value, length;
+
+    trie.Init(nodes, sizeof(nodes) / sizeof(nodes[0]));
+    NL_TEST_ASSERT(inSuite, trie.IsEmpty());
+
+    // A fabric's /48, one of its /64 subnets, a second fabric's /48 and a /8.
+    IPAddress::FromString("fd00:0:1:1::", prefix.IPAddr);
+    prefix.Length = 64;
+    NL_TEST_ASSERT(inSuite, trie.Add(prefix, 2) == INET_NO_ERROR);
+    IPAddress::FromString("fd00:0:1::", prefix.IPAddr);
+    prefix.Length = 48;
+    NL_TEST_ASSERT(inSuite, trie.Add(prefix, 1) == INET_NO_ERROR);
+    IPAddress::FromString("fd00:0:2::", prefix.IPAddr);
+    NL_TEST_ASSERT(inSuite, trie.Add(prefix, 3) == INET_NO_ERROR);
+    IPAddress::FromString("fd00::", prefix.IPAddr);
+    prefix.Length = 8;
+    NL_TEST_ASSERT(inSuite, trie.Add(prefix, 4) == INET_NO_ERROR);
+
+    IPAddress::FromString("fd00:0:1:1::1234", addr);
+    NL_TEST_ASSERT(inSuite, trie.Lookup(addr, value, length) && value == 2 && length == 64);
+    IPAddress::FromString("fd00:0:1:2::1234", addr);
+    NL_TEST_ASSERT(inSuite, trie.Lookup(addr, value, length) && value == 1 && length == 48);
+    IPAddress::FromString("fd00:0:2:1::1234", addr);
+    NL_TEST_ASSERT(inSuite, trie.Lookup(addr, value, length) && value == 3 && length == 48);
+    IPAddress::FromString("fd12:3456::1", addr);
+    NL_TEST_ASSERT(inSuite, trie.Lookup(addr, value, length) && value == 4 && length == 8);
+    IPAddress::FromString("fe80::1", addr);
+    NL_TEST_ASSERT(inSuite, !trie.Lookup(addr, value));
+
+    // Removing the /48 exposes the covering /8, but leaves the more specific /64.
+    IPAddress::FromString("fd00:0:1::", prefix.IPAddr);
+    prefix.Length = 48;
+    NL_TEST_ASSERT(inSuite, trie.Remove(prefix) == INET_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, trie.Remove(prefix) == INET_ERROR_ADDRESS_NOT_FOUND);
+    IPAddress::FromString("fd00:0:1:2::1234", addr);
+    NL_TEST_ASSERT(inSuite, trie.Lookup(addr, value) && value == 4);
+    IPAddress::FromString("fd00:0:1:1::1234", addr);
+    NL_TEST_ASSERT(inSuite, trie.Lookup(addr, value) && value == 2);
+
+    // Freed nodes are reused, until too few remain for a prefix that needs a new branch.
+    IPAddress::FromString("2001:db8::", prefix.IPAddr);
+    prefix.Length = 32;
+    NL_TEST_ASSERT(inSuite, trie.Add(prefix, 5) == INET_NO_ERROR);
+    IPAddress::FromString("2002::", prefix.IPAddr);
+    prefix.Length = 16;
+    NL_TEST_ASSERT(inSuite, trie.Add(prefix, 6) == INET_ERROR_NO_MEMORY);
+    IPAddress::FromString("2001:db8:1::1", addr);
+    NL_TEST_ASSERT(inSuite, trie.Lookup(addr, value) && value == 5);
+
+    trie.Clear();
+    NL_TEST_ASSERT(inSuite, trie.IsEmpty());
+    NL_TEST_ASSERT(inSuite, !trie.Lookup(addr, value));
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
@@ -1731,6 +1795,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Assemble IPv6 Transient Multicast address",   CheckMakeIPv6TransientMulticast),
     NL_TEST_DEF("Assemble IPv6 Prefix Multicast address",      CheckMakeIPv6PrefixMulticast),
     NL_TEST_DEF("IPPrefix test",                               CheckIPPrefix),
+    NL_TEST_DEF("IPPrefixTrie test",                           CheckIPPrefixTrie),
     NL_TEST_SENTINEL()
 };
 
@@ -34,6 +34,8 @@
 #include "ToolCommon.h"
 #include <Weave/Core/WeaveConfig.h>
 #include <Weave/Support/crypto/CTRMode.h>
+#include <Weave/Support/crypto/CCMMode.h>
+#include <Weave/Support/crypto/HMAC.h>
 #include <Weave/Support/crypto/WeaveCrypto.h>
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -60,6 +62,11 @@ public:
     {
         return msgLayer->DecodeMessage(msgBuf, sourceNodeId, con, msgInfo, rPayload, rPayloadLen);
     }
+
+    WEAVE_ERROR DecodeHeader(PacketBuffer *msgBuf, WeaveMessageInfo *msgInfo, uint8_t **payloadStart)
+    {
+        return msgLayer->DecodeHeader(msgBuf, msgInfo, payloadStart);
+    }
 };
 
 } // namespace nl
@@ -339,11 +346,526 @@ void WeaveMessageEncryption_Test1(nlTestSuite *inSuite, void *inContext)
     }
 }
 
+void WeaveMessageEncryption_KeySchedule_Test(nlTestSuite *inSuite, void *inContext)
+{
+    uint8_t longKey[HMACSHA1::kDigestLength * 5];
+    uint8_t expected[sizeof(sMsgPayload) + HMACSHA1::kDigestLength];
+    uint8_t actual[sizeof(sMsgPayload) + HMACSHA1::kDigestLength];
+
+    for (size_t i = 0; i < sizeof(longKey); i++)
+        longKey[i] = (uint8_t)i;
+
+    // An HMAC started from a key schedule must match one keyed directly, both for a key
+    // shorter than the hash block and for one that is longer and therefore hashed first,
+    // and the schedule must be reusable.
+    const uint8_t *keys[] = { sMsgEncKey_IntegrityKey, longKey };
+    const uint16_t keyLens[] = { sizeof(sMsgEncKey_IntegrityKey), sizeof(longKey) };
+
+    for (size_t k = 0; k < 2; k++)
+    {
+        HMACSHA1KeySchedule keySchedule;
+        keySchedule.SetKey(keys[k], keyLens[k]);
+
+        for (uint16_t len = 0; len <= sizeof(sMsgPayload); len += sizeof(sMsgPayload) / 2)
+        {
+            HMACSHA1 hmac;
+
+            hmac.Begin(keys[k], keyLens[k]);
+            hmac.AddData(sMsgPayload, len);
+            hmac.Finish(expected);
+
+            hmac.Begin(keySchedule);
+            hmac.AddData(sMsgPayload, len);
+            hmac.Finish(actual);
+
+            NL_TEST_ASSERT(inSuite, memcmp(expected, actual, HMACSHA1::kDigestLength) == 0);
+        }
+    }
+
+    // A CTR-mode object whose key has been set once must produce the same output for
+    // each message as a freshly keyed one.
+    AES128CTRMode cachedCTR;
+    cachedCTR.SetKey(sMsgEncKey_DataKey);
+
+    for (uint32_t msgId = 1; msgId <= 3; msgId++)
+    {
+        AES128CTRMode freshCTR;
+        freshCTR.SetKey(sMsgEncKey_DataKey);
+        freshCTR.SetWeaveMessageCounter(0x18B4300012345678ULL, msgId);
+        freshCTR.EncryptData(sMsgPayload, sizeof(sMsgPayload), expected);
+
+        cachedCTR.SetWeaveMessageCounter(0x18B4300012345678ULL, msgId);
+        cachedCTR.EncryptData(sMsgPayload, sizeof(sMsgPayload), actual);
+
+        NL_TEST_ASSERT(inSuite, memcmp(expected, actual, sizeof(sMsgPayload)) == 0);
+    }
+}
+
+void WeaveMessageEncryption_AES128CCM_Test(nlTestSuite *inSuite, void *inContext)
+{
+    static WeaveFabricState fabricState;
+    static WeaveMessageLayer messageLayer;
+    static WeaveMessageInfo msgInfo;
+
+    WEAVE_ERROR err;
+    PacketBuffer *msgBuf;
+    WeaveSessionKey *sessionKey;
+    uint64_t srcNodeId = 0x18B4300000000002ULL;
+    uint64_t destNodeId = 0x18B4300012345678ULL;
+    uint32_t msgId = 3;
+    uint8_t encType = kWeaveEncryptionType_AES128CCM;
+    uint16_t sessionKeyId = sTestDefaultSessionKeyId;
+    enum { kTagLen = 16, kHeadLen = 2 + 4 + 8 + 8 + 2 };
+
+    err = fabricState.Init();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    fabricState.LocalNodeId = srcNodeId;
+
+    // Initialize the message encryption session key, for both the destination node and the
+    // local node (so that the message can be decoded locally).
+    WeaveEncryptionKey msgEncSessionKey;
+    memcpy(msgEncSessionKey.AES128CCM.DataKey, sMsgEncKey_DataKey, sizeof(sMsgEncKey_DataKey));
+
+    err = fabricState.AllocSessionKey(destNodeId, sessionKeyId, NULL, sessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    fabricState.SetSessionKey(sessionKey, encType, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+
+    err = fabricState.AllocSessionKey(srcNodeId, sessionKeyId, NULL, sessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    fabricState.SetSessionKey(sessionKey, encType, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+
+    messageLayer.FabricState = &fabricState;
+
+    const uint8_t msgVersions[] = { kWeaveMessageVersion_V1, kWeaveMessageVersion_V2 };
+
+    for (size_t ith = 0; ith < sizeof(msgVersions); ith++)
+    {
+        uint8_t msgVersion = msgVersions[ith];
+        uint8_t expectedMsg[kHeadLen + sizeof(sMsgPayload) + kTagLen];
+        uint8_t *p = expectedMsg;
+
+        for (int tamper = 0; tamper < 2; tamper++)
+        {
+            msgBuf = PacketBuffer::New();
+            NL_TEST_ASSERT(inSuite, msgBuf != NULL);
+            if (msgBuf == NULL)
+                continue;
+
+            memcpy(msgBuf->Start(), sMsgPayload, sizeof(sMsgPayload));
+            msgBuf->SetDataLength(sizeof(sMsgPayload));
+
+            msgInfo.Clear();
+            msgInfo.SourceNodeId = srcNodeId;
+            msgInfo.DestNodeId = destNodeId;
+            msgInfo.MessageId = msgId;
+            msgInfo.KeyId = sessionKeyId;
+            msgInfo.Flags = kWeaveMessageFlag_DestNodeId | kWeaveMessageFlag_SourceNodeId | kWeaveMessageFlag_ReuseMessageId;
+            msgInfo.MessageVersion = msgVersion;
+            msgInfo.EncryptionType = encType;
+
+            err = messageLayer.EncodeMessage(&msgInfo, msgBuf, NULL, UINT16_MAX, 0);
+            NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+            if (tamper == 0 && err == WEAVE_NO_ERROR)
+            {
+                // Manually encode the message: the header, followed by the payload encrypted with AES-128-CCM
+                // using a nonce formed from the source node id and message id, and the 16 byte tag. The
+                // node ids (and, for V2, the header field and message id) are authenticated.
+                p = expectedMsg;
+
+                uint16_t headerVal = ((uint16_t) (msgInfo.Flags & 0xF0F) << 0) |
+                                     ((uint16_t) (msgInfo.EncryptionType & 0xF) << 4) |
+                                     ((uint16_t) (msgInfo.MessageVersion & 0xF) << 12);
+                LittleEndian::Write16(p, headerVal);
+                LittleEndian::Write32(p, msgId);
+                LittleEndian::Write64(p, srcNodeId);
+                LittleEndian::Write64(p, destNodeId);
+                LittleEndian::Write16(p, sessionKeyId);
+
+                uint8_t nonce[12];
+                uint8_t *p2 = nonce;
+                BigEndian::Write64(p2, srcNodeId);
+                BigEndian::Write32(p2, msgId);
+
+                uint8_t aad[2 * sizeof(uint64_t) + sizeof(uint16_t) + sizeof(uint32_t)];
+                p2 = aad;
+                LittleEndian::Write64(p2, srcNodeId);
+                LittleEndian::Write64(p2, destNodeId);
+                if (msgVersion == kWeaveMessageVersion_V2)
+                {
+                    LittleEndian::Write16(p2, headerVal & kMsgHeaderField_MessageHMACMask);
+                    LittleEndian::Write32(p2, msgId);
+                }
+
+                AES128CCMMode aes128CCM;
+                aes128CCM.SetKey(sMsgEncKey_DataKey);
+                err = aes128CCM.Encrypt(nonce, sizeof(nonce), aad, p2 - aad, sMsgPayload, sizeof(sMsgPayload), p,
+                                        p + sizeof(sMsgPayload), kTagLen);
+                NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+                NL_TEST_ASSERT(inSuite, msgBuf->DataLength() == sizeof(expectedMsg));
+                NL_TEST_ASSERT(inSuite, memcmp(msgBuf->Start(), expectedMsg, sizeof(expectedMsg)) == 0);
+            }
+
+            // Modify a byte of the encrypted payload, which must cause the message to be rejected.
+            if (tamper)
+                msgBuf->Start()[kHeadLen + 1] ^= 0x80;
+
+            WeaveMessageLayerTestObject msgLayerTestObject;
+            uint8_t *payload;
+            uint16_t payloadLen;
+
+            msgLayerTestObject.msgLayer = &messageLayer;
+            err = msgLayerTestObject.DecodeMessage(msgBuf, srcNodeId, NULL, &msgInfo, &payload, &payloadLen);
+
+            if (tamper)
+                NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INTEGRITY_CHECK_FAILED);
+            else
+            {
+                NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+                NL_TEST_ASSERT(inSuite, payloadLen == sizeof(sMsgPayload));
+                NL_TEST_ASSERT(inSuite, memcmp(payload, sMsgPayload, sizeof(sMsgPayload)) == 0);
+            }
+
+            PacketBuffer::Free(msgBuf);
+            msgBuf = NULL;
+        }
+    }
+}
+
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+// Build a buffer chain holding the given data, split into pieces of the given lengths.
+static PacketBuffer *MakeChain(const uint8_t *data, const uint16_t *pieceLens, size_t numPieces)
+{
+    PacketBuffer *chain = NULL;
+
+    for (size_t i = 0; i < numPieces; i++)
+    {
+        PacketBuffer *buf = PacketBuffer::New();
+        if (buf == NULL)
+            break;
+
+        memcpy(buf->Start(), data, pieceLens[i]);
+        buf->SetDataLength(pieceLens[i]);
+        data += pieceLens[i];
+
+        if (chain == NULL)
+            chain = buf;
+        else
+            chain->AddToEnd(buf);
+    }
+
+    return chain;
+}
+
+// Copy the data of a buffer chain, starting at the given position within the first buffer.
+static uint16_t CopyChain(PacketBuffer *chain, uint8_t *start, uint8_t *out)
+{
+    uint16_t len = 0;
+
+    for (PacketBuffer *buf = chain; buf != NULL; buf = buf->Next())
+    {
+        uint8_t *p = (buf == chain) ? start : buf->Start();
+        uint16_t pieceLen = buf->DataLength() - (p - buf->Start());
+
+        memcpy(out + len, p, pieceLen);
+        len += pieceLen;
+    }
+
+    return len;
+}
+
+void WeaveMessageEncryption_Chained_Test(nlTestSuite *inSuite, void *inContext)
+{
+    static WeaveFabricState fabricState;
+    static WeaveMessageLayer messageLayer;
+    static WeaveMessageInfo msgInfo;
+    static WeaveConnection con;
+
+    enum
+    {
+        kPayloadLen = 1000,
+        kHeadLen = 2 + 4 + 8 + 8 + 2,
+        kMaxMsgLen = kHeadLen + kPayloadLen + HMACSHA1::kDigestLength
+    };
+
+    WEAVE_ERROR err;
+    PacketBuffer *msgBuf;
+    WeaveSessionKey *destSessionKey;
+    WeaveSessionKey *srcSessionKey;
+    uint64_t srcNodeId = 0x18B4300000000002ULL;
+    uint64_t destNodeId = 0x18B4300012345678ULL;
+    uint16_t sessionKeyId = sTestDefaultSessionKeyId;
+    uint8_t payloadData[kPayloadLen];
+    uint8_t expectedMsg[kMaxMsgLen];
+    uint8_t actualMsg[kMaxMsgLen];
+    uint16_t expectedLen;
+    WeaveMessageLayerTestObject msgLayerTestObject;
+
+    // The payload is encoded from uneven pieces, and decoded with the message trailer split across the last two.
+    const uint16_t encodePieceLens[] = { 300, 1, 599, 100 };
+    const uint8_t encTypes[] = { kWeaveEncryptionType_AES128CTRSHA1, kWeaveEncryptionType_AES128CCM };
+
+    err = fabricState.Init();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    fabricState.LocalNodeId = srcNodeId;
+    messageLayer.FabricState = &fabricState;
+    msgLayerTestObject.msgLayer = &messageLayer;
+    con.NetworkType = WeaveConnection::kNetworkType_IP;
+
+    // Initialize the session key for both the destination node and the local node, so that the message can be
+    // decoded locally.
+    err = fabricState.AllocSessionKey(destNodeId, sessionKeyId, NULL, destSessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = fabricState.AllocSessionKey(srcNodeId, sessionKeyId, NULL, srcSessionKey);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    for (uint16_t i = 0; i < kPayloadLen; i++)
+        payloadData[i] = static_cast<uint8_t>(i * 7 + 3);
+
+    for (size_t ith = 0; ith < sizeof(encTypes); ith++)
+    {
+        uint8_t encType = encTypes[ith];
+        WeaveEncryptionKey msgEncSessionKey;
+
+        memcpy(msgEncSessionKey.AES128CTRSHA1.DataKey, sMsgEncKey_DataKey, sizeof(sMsgEncKey_DataKey));
+        memcpy(msgEncSessionKey.AES128CTRSHA1.IntegrityKey, sMsgEncKey_IntegrityKey, sizeof(sMsgEncKey_IntegrityKey));
+
+        fabricState.SetSessionKey(destSessionKey, encType, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+        fabricState.SetSessionKey(srcSessionKey, encType, kWeaveAuthMode_CASE_Device, &msgEncSessionKey);
+
+        msgInfo.Clear();
+        msgInfo.SourceNodeId = srcNodeId;
+        msgInfo.DestNodeId = destNodeId;
+        msgInfo.MessageId = 3;
+        msgInfo.KeyId = sessionKeyId;
+        msgInfo.Flags = kWeaveMessageFlag_DestNodeId | kWeaveMessageFlag_SourceNodeId | kWeaveMessageFlag_ReuseMessageId;
+        msgInfo.MessageVersion = kWeaveMessageVersion_V2;
+        msgInfo.EncryptionType = encType;
+
+        // Encode the payload in a single buffer, for reference.
+        msgBuf = PacketBuffer::New();
+        NL_TEST_ASSERT(inSuite, msgBuf != NULL);
+        memcpy(msgBuf->Start(), payloadData, kPayloadLen);
+        msgBuf->SetDataLength(kPayloadLen);
+
+        err = messageLayer.EncodeMessage(&msgInfo, msgBuf, &con, UINT16_MAX, 0);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        expectedLen = msgBuf->DataLength();
+        memcpy(expectedMsg, msgBuf->Start(), expectedLen);
+        PacketBuffer::Free(msgBuf);
+
+        // Encoding the payload as a chain must produce the same message.
+        msgBuf = MakeChain(payloadData, encodePieceLens, sizeof(encodePieceLens) / sizeof(encodePieceLens[0]));
+        NL_TEST_ASSERT(inSuite, msgBuf != NULL && msgBuf->TotalLength() == kPayloadLen);
+
+        msgInfo.Flags &= ~kWeaveMessageFlag_MessageEncoded;
+        err = messageLayer.EncodeMessage(&msgInfo, msgBuf, &con, UINT16_MAX, 0);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, msgBuf->TotalLength() == expectedLen);
+        NL_TEST_ASSERT(inSuite, CopyChain(msgBuf, msgBuf->Start(), actualMsg) == expectedLen);
+        NL_TEST_ASSERT(inSuite, memcmp(actualMsg, expectedMsg, expectedLen) == 0);
+        PacketBuffer::Free(msgBuf);
+
+        for (int tamper = 0; tamper < 2; tamper++)
+        {
+            const uint16_t decodePieceLens[] = { kHeadLen + 10, 500, static_cast<uint16_t>(expectedLen - (kHeadLen + 10 + 500 + 7)), 7 };
+            uint8_t *payload;
+            uint16_t payloadLen;
+
+            msgBuf = MakeChain(expectedMsg, decodePieceLens, sizeof(decodePieceLens) / sizeof(decodePieceLens[0]));
+            NL_TEST_ASSERT(inSuite, msgBuf != NULL && msgBuf->TotalLength() == expectedLen);
+
+            // Modify a byte of the encrypted payload in the second buffer, which must cause the message to be rejected.
+            if (tamper)
+                msgBuf->Next()->Start()[1] ^= 0x80;
+
+            err = msgLayerTestObject.DecodeMessage(msgBuf, srcNodeId, &con, &msgInfo, &payload, &payloadLen);
+
+            if (tamper)
+                NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INTEGRITY_CHECK_FAILED);
+            else
+            {
+                NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+                NL_TEST_ASSERT(inSuite, payload == msgBuf->Start() + kHeadLen);
+                NL_TEST_ASSERT(inSuite, payloadLen == kPayloadLen);
+                NL_TEST_ASSERT(inSuite, msgBuf->TotalLength() == kHeadLen + kPayloadLen);
+                NL_TEST_ASSERT(inSuite, CopyChain(msgBuf, payload, actualMsg) == kPayloadLen);
+                NL_TEST_ASSERT(inSuite, memcmp(actualMsg, payloadData, kPayloadLen) == 0);
+            }
+
+            PacketBuffer::Free(msgBuf);
+        }
+    }
+}
+
+#endif // WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+
+void WeaveMessageDuplicateDetection_Test(nlTestSuite *inSuite, void *inContext)
+{
+    enum
+    {
+        kWindowWords = 4,
+        kWindowSize  = kWindowWords * WeaveSessionState::kReceiveWindowWordBits
+    };
+
+    WeaveMsgEncryptionKey msgEncKey;
+    MonotonicallyIncreasingCounter nextMsgId;
+    uint32_t maxRcvdMsgId = 0;
+    WeaveSessionState::ReceiveFlagsType rcvFlags = 0;
+    WeaveSessionState::ReceiveWindowWordType rcvWindow[kWindowWords];
+
+    memset(&msgEncKey, 0, sizeof(msgEncKey));
+    msgEncKey.KeyId = sTestDefaultSessionKeyId;
+    msgEncKey.EncType = kWeaveEncryptionType_AES128CTRSHA1;
+    nextMsgId.Init(0);
+
+    WeaveSessionState sessionState(&msgEncKey, kWeaveAuthMode_CASE_Device, &nextMsgId, &maxRcvdMsgId, &rcvFlags,
+                                   rcvWindow, kWindowWords);
+
+    // The first message synchronizes the session; repeats of any message are duplicates.
+    NL_TEST_ASSERT(inSuite, !sessionState.IsDuplicateMessage(1000));
+    NL_TEST_ASSERT(inSuite, sessionState.IsDuplicateMessage(1000));
+    NL_TEST_ASSERT(inSuite, !sessionState.IsDuplicateMessage(1001));
+    NL_TEST_ASSERT(inSuite, !sessionState.IsDuplicateMessage(999));
+    NL_TEST_ASSERT(inSuite, sessionState.IsDuplicateMessage(999));
+
+    // After jumping ahead across several window words, earlier messages are still remembered...
+    NL_TEST_ASSERT(inSuite, !sessionState.IsDuplicateMessage(1100));
+    NL_TEST_ASSERT(inSuite, sessionState.IsDuplicateMessage(1001));
+    NL_TEST_ASSERT(inSuite, sessionState.IsDuplicateMessage(1000));
+    NL_TEST_ASSERT(inSuite, !sessionState.IsDuplicateMessage(1050));
+    NL_TEST_ASSERT(inSuite, sessionState.IsDuplicateMessage(1050));
+
+    // ... messages reordered by up to the full window width are accepted exactly once...
+    NL_TEST_ASSERT(inSuite, !sessionState.IsDuplicateMessage(1100 - kWindowSize));
+    NL_TEST_ASSERT(inSuite, sessionState.IsDuplicateMessage(1100 - kWindowSize));
+
+    // ... and encrypted messages older than the window are treated as duplicates.
+    NL_TEST_ASSERT(inSuite, sessionState.IsDuplicateMessage(1100 - kWindowSize - 1));
+
+    // Deliver a run of messages in a shuffled order with a bounded displacement; each must be
+    // accepted exactly once.
+    for (uint32_t base = 2000; base < 2000 + 8 * kWindowSize; base += kWindowSize / 2)
+    {
+        for (uint32_t i = 0; i < kWindowSize / 2; i++)
+        {
+            uint32_t msgId = base + ((i * 37) % (kWindowSize / 2));
+            NL_TEST_ASSERT(inSuite, !sessionState.IsDuplicateMessage(msgId));
+            NL_TEST_ASSERT(inSuite, sessionState.IsDuplicateMessage(msgId));
+        }
+    }
+}
+
+void WeaveMessageHeaderDecode_Test(nlTestSuite *inSuite, void *inContext)
+{
+    enum
+    {
+        kEncryptedHeaderLen   = 24,
+        kUnencryptedHeaderLen = 22,
+        kBenchmarkIterations  = 100000
+    };
+
+    static WeaveFabricState fabricState;
+    static WeaveMessageLayer messageLayer;
+
+    // An unencrypted version of the test message header, with both node ids.
+    static const uint8_t sUnencryptedHeader[kUnencryptedHeaderLen] =
+    {
+        0x00, 0x13, 0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x30, 0xB4, 0x18, 0x78, 0x56,
+        0x34, 0x12, 0x00, 0x30, 0xB4, 0x18
+    };
+
+    WeaveMessageLayerTestObject testObject;
+    WeaveMessageInfo msgInfo;
+    WEAVE_ERROR err;
+    PacketBuffer *msgBuf;
+    uint8_t *payload;
+    uint64_t startTime;
+
+    err = fabricState.Init();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    messageLayer.FabricState = &fabricState;
+    testObject.msgLayer = &messageLayer;
+
+    msgBuf = PacketBuffer::New();
+    NL_TEST_ASSERT(inSuite, msgBuf != NULL);
+
+    // Decode the header of the encrypted test message.
+    memcpy(msgBuf->Start(), sEncodedMsg_V1, sizeof(sEncodedMsg_V1));
+    msgBuf->SetDataLength(sizeof(sEncodedMsg_V1));
+
+    err = testObject.DecodeHeader(msgBuf, &msgInfo, &payload);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, msgInfo.MessageVersion == kWeaveMessageVersion_V1);
+    NL_TEST_ASSERT(inSuite, msgInfo.EncryptionType == kWeaveEncryptionType_AES128CTRSHA1);
+    NL_TEST_ASSERT(inSuite, msgInfo.MessageId == 3);
+    NL_TEST_ASSERT(inSuite, msgInfo.SourceNodeId == 0x18B4300000000002ULL);
+    NL_TEST_ASSERT(inSuite, msgInfo.DestNodeId == 0x18B4300012345678ULL);
+    NL_TEST_ASSERT(inSuite, msgInfo.KeyId == sTestDefaultSessionKeyId);
+    NL_TEST_ASSERT(inSuite, payload == msgBuf->Start() + kEncryptedHeaderLen);
+
+    // Every truncation of the header is rejected.
+    for (uint16_t len = 0; len < kEncryptedHeaderLen; len++)
+    {
+        msgBuf->SetDataLength(len);
+        err = testObject.DecodeHeader(msgBuf, &msgInfo, &payload);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+    }
+
+    msgBuf->SetDataLength(sizeof(sEncodedMsg_V1));
+
+    startTime = Now();
+    for (uint32_t i = 0; i < kBenchmarkIterations; i++)
+        testObject.DecodeHeader(msgBuf, &msgInfo, &payload);
+    printf("DecodeHeader (AES128CTRSHA1): %lu ns per header\n",
+           (unsigned long)((Now() - startTime) * 1000 / kBenchmarkIterations));
+
+    // Decode the unencrypted header.
+    memcpy(msgBuf->Start(), sUnencryptedHeader, sizeof(sUnencryptedHeader));
+    msgBuf->SetDataLength(sizeof(sUnencryptedHeader));
+
+    err = testObject.DecodeHeader(msgBuf, &msgInfo, &payload);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, msgInfo.EncryptionType == kWeaveEncryptionType_None);
+    NL_TEST_ASSERT(inSuite, msgInfo.DestNodeId == 0x18B4300012345678ULL);
+    NL_TEST_ASSERT(inSuite, msgInfo.KeyId == WeaveKeyId::kNone);
+    NL_TEST_ASSERT(inSuite, payload == msgBuf->Start() + kUnencryptedHeaderLen);
+
+    for (uint16_t len = 0; len < kUnencryptedHeaderLen; len++)
+    {
+        msgBuf->SetDataLength(len);
+        err = testObject.DecodeHeader(msgBuf, &msgInfo, &payload);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+    }
+
+    msgBuf->SetDataLength(sizeof(sUnencryptedHeader));
+
+    startTime = Now();
+    for (uint32_t i = 0; i < kBenchmarkIterations; i++)
+        testObject.DecodeHeader(msgBuf, &msgInfo, &payload);
+    printf("DecodeHeader (unencrypted): %lu ns per header\n",
+           (unsigned long)((Now() - startTime) * 1000 / kBenchmarkIterations));
+
+    PacketBuffer::Free(msgBuf);
+}
 
 int main(int argc, char *argv[])
 {
     static const nlTest tests[] = {
         NL_TEST_DEF("WeaveMessageEncryption",           WeaveMessageEncryption_Test1),
+        NL_TEST_DEF("WeaveMessageEncryptionKeySchedule", WeaveMessageEncryption_KeySchedule_Test),
+        NL_TEST_DEF("WeaveMessageEncryptionAES128CCM",  WeaveMessageEncryption_AES128CCM_Test),
+#if WEAVE_CONFIG_ENABLE_CHAINED_TCP_MESSAGES
+        NL_TEST_DEF("WeaveMessageEncryptionChained",    WeaveMessageEncryption_Chained_Test),
+#endif
+        NL_TEST_DEF("WeaveMessageDuplicateDetection",   WeaveMessageDuplicateDetection_Test),
+        NL_TEST_DEF("WeaveMessageHeaderDecode",         WeaveMessageHeaderDecode_Test),
         NL_TEST_SENTINEL()
     };
 
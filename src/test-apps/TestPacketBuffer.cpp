@@ -37,6 +37,10 @@
 #include <lwip/tcpip.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+
 #include <nlunit-test.h>
 
 using ::nl::Weave::System::PacketBuffer;
@@ -134,10 +138,15 @@ static void BufferAlloc(struct TestContext* theContext)
     theContext->buf->pool = lPool;
 #endif // LWIP_PBUF_FROM_CUSTOM_POOLS
 #else // !WEAVE_SYSTEM_CONFIG_USE_LWIP
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    const uint16_t lClassSize = theContext->buf->alloc_size;
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
     memset(theContext->buf, 0, lAllocSize);
 #if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
     theContext->buf->alloc_size = lAllocSize;
-#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC == 0
+#elif WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    theContext->buf->alloc_size = lClassSize;
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
 #endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
 
     theContext->start_buffer = reinterpret_cast<uint8_t*>(theContext->buf);
@@ -636,6 +645,113 @@ static void CheckCompactHead(nlTestSuite *inSuite, void *inContext)
     }
 }
 
+/**
+ *  Test PacketBuffer::PullUp() function.
+ *
+ *  Description: Build a chain of buffers holding a known byte pattern. Pull
+ *               up various lengths into the first buffer and check that just
+ *               the bytes needed are moved, that the pattern is preserved,
+ *               that emptied buffers are freed, and that the request fails
+ *               without side effects when the chain or the first buffer is
+ *               too short.
+ */
+static void FillPullUpChain(PacketBuffer* aHead, uint16_t aLength, uint8_t& aNext)
+{
+    uint8_t* lData = aHead->Start() + aHead->DataLength();
+
+    for (uint16_t i = 0; i < aLength; i++)
+        lData[i] = aNext++;
+
+    aHead->SetDataLength(aHead->DataLength() + aLength);
+}
+
+static bool CheckPullUpPattern(const PacketBuffer* aHead, uint16_t aLength)
+{
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        if (aHead->Start()[i] != static_cast<uint8_t>(i))
+            return false;
+    }
+
+    return true;
+}
+
+static void CheckPullUp(nlTestSuite *inSuite, void *inContext)
+{
+    const uint16_t kSegmentLength = 100;
+    PacketBuffer* lHead = PacketBuffer::New(0);
+    PacketBuffer* lBuffer;
+    uint8_t lNext = 0;
+    uint8_t* lStart;
+
+    NL_TEST_ASSERT(inSuite, lHead != NULL);
+    if (lHead == NULL)
+        return;
+
+    FillPullUpChain(lHead, kSegmentLength, lNext);
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        lBuffer = PacketBuffer::New(0);
+        NL_TEST_ASSERT(inSuite, lBuffer != NULL);
+        if (lBuffer == NULL)
+            break;
+
+        FillPullUpChain(lBuffer, kSegmentLength, lNext);
+        lHead->AddToEnd(lBuffer);
+    }
+
+    lStart = lHead->Start();
+
+    // Already contiguous.
+    NL_TEST_ASSERT(inSuite, lHead->PullUp(kSegmentLength / 2));
+    NL_TEST_ASSERT(inSuite, lHead->DataLength() == kSegmentLength);
+
+    // Only the bytes needed are moved, in place, and the emptied second buffer is freed.
+    NL_TEST_ASSERT(inSuite, lHead->PullUp(2 * kSegmentLength + kSegmentLength / 2));
+    NL_TEST_ASSERT(inSuite, lHead->Start() == lStart);
+    NL_TEST_ASSERT(inSuite, lHead->DataLength() == 2 * kSegmentLength + kSegmentLength / 2);
+    NL_TEST_ASSERT(inSuite, lHead->TotalLength() == 3 * kSegmentLength);
+    NL_TEST_ASSERT(inSuite, lHead->Next() != NULL && lHead->Next()->DataLength() == kSegmentLength / 2);
+    NL_TEST_ASSERT(inSuite, lHead->Next() != NULL && lHead->Next()->Next() == NULL);
+    NL_TEST_ASSERT(inSuite, CheckPullUpPattern(lHead, lHead->DataLength()));
+
+    // The chain is too short.
+    NL_TEST_ASSERT(inSuite, !lHead->PullUp(3 * kSegmentLength + 1));
+    NL_TEST_ASSERT(inSuite, lHead->DataLength() == 2 * kSegmentLength + kSegmentLength / 2);
+
+    PacketBuffer::Free(lHead);
+
+    // With too little space after its data, the data in the first buffer is moved to the front.
+    lNext = 0;
+    lHead = PacketBuffer::New(0);
+    lBuffer = PacketBuffer::New(0);
+    NL_TEST_ASSERT(inSuite, lHead != NULL && lBuffer != NULL);
+    if (lHead == NULL || lBuffer == NULL)
+    {
+        PacketBuffer::Free(lHead);
+        PacketBuffer::Free(lBuffer);
+        return;
+    }
+
+    lStart = lHead->Start();
+    lHead->SetStart(lStart + lHead->MaxDataLength() - kSegmentLength / 2);
+    FillPullUpChain(lHead, kSegmentLength / 2, lNext);
+    FillPullUpChain(lBuffer, lBuffer->MaxDataLength(), lNext);
+    lHead->AddToEnd(lBuffer);
+
+    NL_TEST_ASSERT(inSuite, lHead->PullUp(kSegmentLength));
+    NL_TEST_ASSERT(inSuite, lHead->Start() == lStart);
+    NL_TEST_ASSERT(inSuite, lHead->DataLength() == kSegmentLength);
+    NL_TEST_ASSERT(inSuite, CheckPullUpPattern(lHead, kSegmentLength));
+
+    // The first buffer is too small.
+    NL_TEST_ASSERT(inSuite, !lHead->PullUp(static_cast<uint16_t>(lHead->AllocSize() + 1)));
+    NL_TEST_ASSERT(inSuite, lHead->DataLength() == kSegmentLength);
+
+    PacketBuffer::Free(lHead);
+}
+
 /**
  *  Test PacketBuffer::ConsumeHead() function.
  *
@@ -1098,6 +1214,154 @@ static void CheckFreeHead(nlTestSuite *inSuite, void *inContext)
     }
 }
 
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+/**
+ *  Test PacketBuffer size classes.
+ *
+ *  Description: Verify that NewWithAvailableSize() takes buffers from the smallest size class that fits the request, that it
+ *               falls back to a larger class when a class is exhausted, and that RightSize() copies an unchained buffer into a
+ *               smaller class while preserving its reserved space and data.
+ */
+static void CheckSizeClasses(nlTestSuite *inSuite, void *inContext)
+{
+    PacketBuffer *buffer;
+    PacketBuffer *lSmall[WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC];
+    static const uint16_t kReserved = 16;
+    static const uint8_t kData[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+    (void)inContext;
+
+    buffer = PacketBuffer::NewWithAvailableSize(0, 10);
+    NL_TEST_ASSERT(inSuite, buffer != NULL && buffer->AllocSize() == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY);
+    PacketBuffer::Free(buffer);
+
+    buffer = PacketBuffer::NewWithAvailableSize(0, WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY + 1);
+    NL_TEST_ASSERT(inSuite, buffer != NULL && buffer->AllocSize() == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY);
+    PacketBuffer::Free(buffer);
+
+    buffer = PacketBuffer::NewWithAvailableSize(0, WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY + 1);
+    NL_TEST_ASSERT(inSuite, buffer != NULL && buffer->AllocSize() == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX);
+    PacketBuffer::Free(buffer);
+
+    // Exhaust the small class; the next small request falls back to the medium class.
+    for (size_t i = 0; i < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC; i++)
+    {
+        lSmall[i] = PacketBuffer::NewWithAvailableSize(0, 1);
+        NL_TEST_ASSERT(inSuite, lSmall[i] != NULL && lSmall[i]->AllocSize() == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY);
+    }
+
+    buffer = PacketBuffer::NewWithAvailableSize(0, 1);
+    NL_TEST_ASSERT(inSuite, buffer != NULL && buffer->AllocSize() == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MEDIUM_CAPACITY);
+    PacketBuffer::Free(buffer);
+
+    for (size_t i = 0; i < WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_MAXALLOC; i++)
+        PacketBuffer::Free(lSmall[i]);
+
+    // Right-size a full-sized buffer holding a small message.
+    buffer = PacketBuffer::New(kReserved);
+    NL_TEST_ASSERT(inSuite, buffer != NULL && buffer->AllocSize() == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_CAPACITY_MAX);
+
+    if (buffer != NULL)
+    {
+        memcpy(buffer->Start(), kData, sizeof(kData));
+        buffer->SetDataLength(sizeof(kData));
+
+        buffer = PacketBuffer::RightSize(buffer);
+        NL_TEST_ASSERT(inSuite, buffer->AllocSize() == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SMALL_CAPACITY);
+        NL_TEST_ASSERT(inSuite, buffer->ReservedSize() == kReserved);
+        NL_TEST_ASSERT(inSuite, buffer->DataLength() == sizeof(kData));
+        NL_TEST_ASSERT(inSuite, memcmp(buffer->Start(), kData, sizeof(kData)) == 0);
+
+        // A buffer already in the smallest fitting class is left untouched.
+        NL_TEST_ASSERT(inSuite, PacketBuffer::RightSize(buffer) == buffer);
+
+        PacketBuffer::Free(buffer);
+    }
+}
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+static const unsigned int kNumThreads = 8;
+static const unsigned int kNumIterations = 20000;
+static volatile unsigned int sNumCorruptions;
+
+static void* LockFreeWorker(void* aContext)
+{
+    const uint8_t lTag = static_cast<uint8_t>(reinterpret_cast<uintptr_t>(aContext));
+
+    for (unsigned int i = 0; i < kNumIterations; i++)
+    {
+        PacketBuffer* lBuffer = (i & 1) ? PacketBuffer::New() : PacketBuffer::NewWithAvailableSize(0, 1);
+
+        if (lBuffer == NULL)
+            continue;
+
+        memset(lBuffer->Start(), lTag, 8);
+        lBuffer->AddRef();
+
+        for (size_t j = 0; j < 8; j++)
+        {
+            if (lBuffer->Start()[j] != lTag)
+            {
+                __sync_fetch_and_add(&sNumCorruptions, 1);
+                break;
+            }
+        }
+
+        PacketBuffer::Free(lBuffer);
+        PacketBuffer::Free(lBuffer);
+    }
+
+    return NULL;
+}
+
+/**
+ *  Test the lock-free PacketBuffer pool.
+ *
+ *  Description: Allocate and free buffers from several threads at once and verify that no buffer is handed out to two threads at
+ *               the same time. Then verify that every buffer has been returned to the pool.
+ */
+static void CheckLockFreeConcurrency(nlTestSuite *inSuite, void *inContext)
+{
+    pthread_t lThread[kNumThreads];
+    PacketBuffer* lBuffer;
+    PacketBuffer* lHeld = NULL;
+    size_t lNumFree = 0;
+
+    (void)inContext;
+
+    for (unsigned int i = 0; i < kNumThreads; i++)
+    {
+        int lError = pthread_create(&lThread[i], NULL, LockFreeWorker, reinterpret_cast<void*>(static_cast<uintptr_t>(i + 1)));
+
+        NL_TEST_ASSERT(inSuite, lError == 0);
+    }
+
+    for (unsigned int i = 0; i < kNumThreads; i++)
+    {
+        int lError = pthread_join(lThread[i], NULL);
+
+        NL_TEST_ASSERT(inSuite, lError == 0);
+    }
+
+    NL_TEST_ASSERT(inSuite, sNumCorruptions == 0);
+
+    // The test setup holds one full-sized buffer per test context.
+    while ((lBuffer = PacketBuffer::New()) != NULL)
+    {
+        if (lHeld == NULL)
+            lHeld = lBuffer;
+        else
+            lHeld->AddToEnd(lBuffer);
+        lNumFree++;
+    }
+
+    NL_TEST_ASSERT(inSuite, lNumFree == WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC - kTestElements);
+
+    PacketBuffer::Free(lHeld);
+}
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+
 /**
  *  Test PacketBuffer::BuildFreeList() function.
  */
@@ -1112,6 +1376,12 @@ static void CheckBuildFreeList(nlTestSuite *inSuite, void *inContext)
  *   Test Suite. It lists all the test functions.
  */
 static const nlTest sTests[] = {
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+    NL_TEST_DEF("PacketBuffer::SizeClasses",                    CheckSizeClasses),
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_SIZE_CLASSES
+#if WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+    NL_TEST_DEF("PacketBuffer::LockFreeConcurrency",            CheckLockFreeConcurrency),
+#endif // WEAVE_SYSTEM_CONFIG_PACKETBUFFER_LOCKFREE_POOL && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     NL_TEST_DEF("PacketBuffer::NewWithAvailableSize&PacketBuffer::Free", CheckNewWithAvailableSizeAndFree),
     NL_TEST_DEF("PacketBuffer::Start",                          CheckStart),
     NL_TEST_DEF("PacketBuffer::SetStart",                       CheckSetStart),
@@ -1124,6 +1394,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("PacketBuffer::AddToEnd",                       CheckAddToEnd),
     NL_TEST_DEF("PacketBuffer::DetachTail",                     CheckDetachTail),
     NL_TEST_DEF("PacketBuffer::CompactHead",                    CheckCompactHead),
+    NL_TEST_DEF("PacketBuffer::PullUp",                         CheckPullUp),
     NL_TEST_DEF("PacketBuffer::ConsumeHead",                    CheckConsumeHead),
     NL_TEST_DEF("PacketBuffer::Consume",                        CheckConsume),
     NL_TEST_DEF("PacketBuffer::EnsureReservedSize",             CheckEnsureReservedSize),
@@ -102,6 +102,7 @@ class TraitPathStoreTest {
         void TestFlags(nlTestSuite *inSuite, void *inContext);
         void TestInsertItem(nlTestSuite *inSuite, void *inContext);
         void TestSetFailedTrait(nlTestSuite *inSuite, void *inContext);
+        void TestTraitIndex(nlTestSuite *inSuite, void *inContext);
 };
 
 TraitPathStoreTest::TraitPathStoreTest() :
@@ -644,6 +645,83 @@ void TraitPathStoreTest::TestSetFailedTrait(nlTestSuite *inSuite, void *inContex
     mStore.Clear();
 }
 
+void TraitPathStoreTest::TestTraitIndex(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    TraitPath tp;
+    // Shares a trait index bucket with mTDH1
+    TraitDataHandle tdh3 = mTDH1 + 16;
+
+    mStore.Clear();
+
+    mPath.mTraitDataHandle = mTDH1;
+    mPath.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K);
+    err = mStore.AddItem(mPath);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    mPath.mTraitDataHandle = tdh3;
+    mPath.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_I);
+    err = mStore.AddItem(mPath);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, mStore.IsTraitPresent(mTDH1));
+    NL_TEST_ASSERT(inSuite, mStore.IsTraitPresent(tdh3));
+    NL_TEST_ASSERT(inSuite, false == mStore.IsTraitPresent(mTDH2));
+
+    // Paths of other trait instances in the same bucket are not matched
+    tp.mTraitDataHandle = mTDH1;
+    tp.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K_Sa);
+    NL_TEST_ASSERT(inSuite, mStore.Includes(tp, mSchemaEngine));
+    tp.mTraitDataHandle = tdh3;
+    NL_TEST_ASSERT(inSuite, false == mStore.Includes(tp, mSchemaEngine));
+    NL_TEST_ASSERT(inSuite, false == mStore.Intersects(tp, mSchemaEngine));
+    tp.mPropertyPathHandle = kRootPropertyPathHandle;
+    NL_TEST_ASSERT(inSuite, mStore.Intersects(tp, mSchemaEngine));
+
+    // Dictionary items that differ only by key have the same ancestor mask
+    mPath.mTraitDataHandle = mTDH2;
+    mPath.mPropertyPathHandle = mSchemaEngine->GetDictionaryItemHandle(CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K_Sa), 1);
+    err = mStore.AddItem(mPath);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    tp.mTraitDataHandle = mTDH2;
+    tp.mPropertyPathHandle = mSchemaEngine->GetDictionaryItemHandle(CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K_Sa), 2);
+    NL_TEST_ASSERT(inSuite, false == mStore.Includes(tp, mSchemaEngine));
+    NL_TEST_ASSERT(inSuite, false == mStore.Intersects(tp, mSchemaEngine));
+
+    // Adding an ancestor replaces the item
+    tp.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K);
+    NL_TEST_ASSERT(inSuite, mStore.Intersects(tp, mSchemaEngine));
+    err = mStore.AddItemDedup(tp, mSchemaEngine);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, 3 == mStore.GetNumItems());
+    NL_TEST_ASSERT(inSuite, mStore.IsPresent(tp));
+    NL_TEST_ASSERT(inSuite, false == mStore.IsPresent(mPath));
+
+    // The index follows items around as the store is edited
+    mStore.RemoveTrait(mTDH1);
+    NL_TEST_ASSERT(inSuite, false == mStore.IsTraitPresent(mTDH1));
+    NL_TEST_ASSERT(inSuite, mStore.IsTraitPresent(tdh3));
+
+    mStore.Compact();
+
+    mPath.mTraitDataHandle = mTDH1;
+    mPath.mPropertyPathHandle = CreatePropertyPathHandle(TestHTrait::kPropertyHandle_K);
+    err = mStore.InsertItemAt(0, mPath, TraitPathStore::kFlag_None);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, 0 == mStore.GetFirstValidItem(mTDH1));
+
+    mStore.RemoveTrait(tdh3);
+    NL_TEST_ASSERT(inSuite, mStore.IsTraitPresent(mTDH1));
+    NL_TEST_ASSERT(inSuite, false == mStore.IsTraitPresent(tdh3));
+    NL_TEST_ASSERT(inSuite, mStore.IsTraitPresent(mTDH2));
+
+    mStore.Clear();
+
+    NL_TEST_ASSERT(inSuite, false == mStore.IsTraitPresent(mTDH1));
+    NL_TEST_ASSERT(inSuite, false == mStore.IsTraitPresent(mTDH2));
+}
+
 } // WeaveMakeManagedNamespaceIdentifier(DataManagement, kWeaveManagedNamespaceDesignation_Current)
 }
 }
@@ -720,6 +798,11 @@ void TraitPathStoreTest_SetFailedTrait(nlTestSuite *inSuite, void *inContext)
     gPathStoreTest.TestSetFailedTrait(inSuite, inContext);
 }
 
+void TraitPathStoreTest_TraitIndex(nlTestSuite *inSuite, void *inContext)
+{
+    gPathStoreTest.TestTraitIndex(inSuite, inContext);
+}
+
 // Test Suite
 
 /**
@@ -738,6 +821,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Flags",  TraitPathStoreTest_Flags),
     NL_TEST_DEF("InsertItem",  TraitPathStoreTest_InsertItem),
     NL_TEST_DEF("SetFailedTrait",  TraitPathStoreTest_SetFailedTrait),
+    NL_TEST_DEF("TraitIndex",  TraitPathStoreTest_TraitIndex),
 
     NL_TEST_SENTINEL()
 };
@@ -173,6 +173,123 @@ static void CheckWriteNextCounterStart(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, value == 0x20000);
 }
 
+static void CheckAdaptiveEpoch(nlTestSuite *inSuite, void *inContext)
+{
+    TestPersistedCounterContext *context = static_cast<TestPersistedCounterContext *>(inContext);
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    nl::Weave::PersistedCounter counter, counter2;
+    const char *testKey = "testcounter";
+    uint32_t storedValue = 0;
+
+    InitializePersistedStorage(context);
+
+    err = counter.Init(testKey, 0x100);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    // Exhausting the first epoch quickly doubles the size of the next one,
+    // so the reservation written out covers twice as many values.
+
+    for (int32_t i = 0; i < 0x100; i++)
+    {
+        err = counter.Advance();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, counter.GetValue() == 0x100);
+
+    err = nl::Weave::Platform::PersistedStorage::Read(testKey, storedValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storedValue == 0x100 + 2 * 0x100);
+
+    // The epoch stops growing at its maximum scale.
+
+    for (int32_t i = 0; i < 0x100 * 4 * WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE; i++)
+    {
+        err = counter.Advance();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    err = nl::Weave::Platform::PersistedStorage::Read(testKey, storedValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storedValue - counter.GetValue() <= 0x100 * WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE);
+
+    // After a "reboot", the counter resumes past every value vended.
+
+    err = counter2.Init(testKey, 0x100);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter2.GetValue() == storedValue);
+    NL_TEST_ASSERT(inSuite, counter2.GetValue() > counter.GetValue());
+}
+
+static void CheckDeferredWrites(nlTestSuite *inSuite, void *inContext)
+{
+    TestPersistedCounterContext *context = static_cast<TestPersistedCounterContext *>(inContext);
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    nl::Weave::PersistedCounter counter, counter2;
+    const char *testKey = "testcounter";
+    uint32_t storedValue = 0;
+    uint32_t reservedValue = 0;
+
+    InitializePersistedStorage(context);
+
+    err = counter.Init(testKey, 0x100);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    // Enabling deferred writes asks for the next epoch to be reserved.
+
+    counter.SetDeferredWrites(true);
+    NL_TEST_ASSERT(inSuite, counter.IsWritePending());
+
+    err = counter.WritePending();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !counter.IsWritePending());
+
+    err = nl::Weave::Platform::PersistedStorage::Read(testKey, reservedValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reservedValue > 0x100);
+
+    // Starting the next epoch leaves storage untouched until the pending
+    // write is performed.
+
+    for (int32_t i = 0; i < 0x100; i++)
+    {
+        err = counter.Advance();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    NL_TEST_ASSERT(inSuite, counter.GetValue() == 0x100);
+    NL_TEST_ASSERT(inSuite, counter.IsWritePending());
+
+    err = nl::Weave::Platform::PersistedStorage::Read(testKey, storedValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storedValue == reservedValue);
+
+    err = counter.WritePending();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !counter.IsWritePending());
+
+    err = nl::Weave::Platform::PersistedStorage::Read(testKey, storedValue);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, storedValue > reservedValue);
+
+    // Without the pending write, the counter writes synchronously once the
+    // reservation is exhausted, and never vends a value past it.
+
+    for (int32_t i = 0; i < 0x100 * 8 * WEAVE_CONFIG_PERSISTED_COUNTER_MAX_EPOCH_SCALE; i++)
+    {
+        err = counter.Advance();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = nl::Weave::Platform::PersistedStorage::Read(testKey, storedValue);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, storedValue > counter.GetValue());
+    }
+
+    err = counter2.Init(testKey, 0x100);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, counter2.GetValue() > counter.GetValue());
+}
+
 // Test Suite
 
 /**
@@ -182,6 +299,8 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Out of box Test", CheckOOB),
     NL_TEST_DEF("Reboot Test", CheckReboot),
     NL_TEST_DEF("Write Next Counter Start Test", CheckWriteNextCounterStart),
+    NL_TEST_DEF("Adaptive Epoch Test", CheckAdaptiveEpoch),
+    NL_TEST_DEF("Deferred Writes Test", CheckDeferredWrites),
 
     NL_TEST_SENTINEL()
 };
@@ -0,0 +1,291 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a capacity test for the pools that bound how
+ *      many exchanges, bindings, timers and packet buffers a Weave node can
+ *      hold at once.
+ *
+ *      Built with the high-scale project configuration
+ *      (build/config/standalone/high-scale), it verifies that the pools
+ *      that configuration makes dynamic grow well beyond their initial
+ *      size.  With fixed pools it verifies that the pools fail cleanly
+ *      once exhausted.  In both cases the same capacity must be available
+ *      again once everything has been released.
+ */
+
+#include "ToolCommon.h"
+
+#include <nlunit-test.h>
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveWRMPConfig.h>
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+#include <lwip/init.h>
+#include <lwip/tcpip.h>
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+using nl::Weave::System::PacketBuffer;
+
+enum
+{
+    // How far beyond its initial size each growable pool is expected to grow.
+    kGrowthFactor               = 4,
+
+    // The number of packet buffers allocated when they come from the heap.
+    kNumHeapPacketBuffers       = 1024,
+
+    kTimerTimeoutMsec           = 60000
+};
+
+static const uint64_t kPeerNodeIdBase = 0x18B4300000000001ULL;
+
+// The maximum number of objects each pool can hold, or 0 if the pool grows without limit.
+
+#if !WEAVE_CONFIG_EXCHANGE_MGR_DYNAMIC_POOLS
+static const size_t kExchangePoolSlabs = 1;
+#else
+static const size_t kExchangePoolSlabs = WEAVE_CONFIG_EXCHANGE_MGR_MAX_POOL_SLABS;
+#endif
+
+static const size_t kContextLimit = kExchangePoolSlabs * WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS;
+static const size_t kBindingLimit = kExchangePoolSlabs * WEAVE_CONFIG_MAX_BINDINGS;
+
+#if WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+static const size_t kTimerLimit = 0;
+#else
+static const size_t kTimerLimit = WEAVE_SYSTEM_CONFIG_NUM_TIMERS;
+#endif
+
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+static const size_t kPacketBufferLimit = PBUF_POOL_SIZE;
+#else
+static const size_t kPacketBufferLimit = WEAVE_SYSTEM_CONFIG_PACKETBUFFER_MAXALLOC;
+#endif
+
+static const size_t kNumContexts = (kContextLimit != 0) ? kContextLimit : kGrowthFactor * WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS;
+static const size_t kNumBindings = (kBindingLimit != 0) ? kBindingLimit : kGrowthFactor * WEAVE_CONFIG_MAX_BINDINGS;
+static const size_t kNumTimers = (kTimerLimit != 0) ? kTimerLimit : kGrowthFactor * WEAVE_SYSTEM_CONFIG_NUM_TIMERS;
+static const size_t kNumPacketBuffers = (kPacketBufferLimit != 0) ? kPacketBufferLimit : static_cast<size_t>(kNumHeapPacketBuffers);
+
+// One more than the target of each pool, so that allocation past a limit is attempted.
+static ExchangeContext *sContexts[kNumContexts + 1];
+static Binding *sBindings[kNumBindings + 1];
+static uint8_t sTimerStates[kNumTimers + 1];
+static PacketBuffer *sPacketBuffers[kNumPacketBuffers + 1];
+
+/**
+ *  Check the number of objects allocated from a pool of the given limit, attempting one more than the target.
+ *  A bounded pool must have been exhausted without exceeding its limit; an unbounded one must have supplied
+ *  every object.
+ */
+static void CheckAllocCount(nlTestSuite *inSuite, size_t count, size_t target, size_t limit)
+{
+    if (limit != 0)
+        NL_TEST_ASSERT(inSuite, count > 0 && count <= limit);
+    else
+        NL_TEST_ASSERT(inSuite, count == target + 1);
+}
+
+static void CheckCoupledLimits(nlTestSuite *inSuite, void *inContext)
+{
+    // Each connection may carry its own session key.
+    NL_TEST_ASSERT(inSuite, WEAVE_CONFIG_MAX_SESSION_KEYS >= WEAVE_CONFIG_MAX_CONNECTIONS);
+
+    // Each connection needs a TCP end point.
+    NL_TEST_ASSERT(inSuite, WEAVE_CONFIG_MAX_CONNECTIONS <= INET_CONFIG_NUM_TCP_ENDPOINTS);
+    NL_TEST_ASSERT(inSuite, WEAVE_CONFIG_MAX_INCOMING_TCP_CONNECTIONS <= WEAVE_CONFIG_MAX_CONNECTIONS);
+
+    // Reliable messaging must be able to hold messages awaiting acknowledgment, also when packet
+    // buffers come from the heap.
+    NL_TEST_ASSERT(inSuite, WEAVE_CONFIG_WRMP_RETRANS_TABLE_SIZE > 0);
+}
+
+static void CheckExchangeContexts(nlTestSuite *inSuite, void *inContext)
+{
+    size_t firstCount = 0;
+
+    for (int round = 0; round < 2; round++)
+    {
+        size_t count;
+
+        for (count = 0; count <= kNumContexts; count++)
+        {
+            sContexts[count] = ExchangeMgr.NewContext(kPeerNodeIdBase + count);
+            if (sContexts[count] == NULL)
+                break;
+        }
+
+        CheckAllocCount(inSuite, count, kNumContexts, kContextLimit);
+
+        // Nothing is lost between rounds.
+        if (round == 0)
+            firstCount = count;
+        else
+            NL_TEST_ASSERT(inSuite, count == firstCount);
+
+        for (size_t i = 0; i < count; i++)
+            sContexts[i]->Close();
+    }
+}
+
+static void CheckBindings(nlTestSuite *inSuite, void *inContext)
+{
+    size_t firstCount = 0;
+
+    for (int round = 0; round < 2; round++)
+    {
+        size_t count;
+
+        for (count = 0; count <= kNumBindings; count++)
+        {
+            sBindings[count] = ExchangeMgr.NewBinding();
+            if (sBindings[count] == NULL)
+                break;
+        }
+
+        CheckAllocCount(inSuite, count, kNumBindings, kBindingLimit);
+
+        if (round == 0)
+            firstCount = count;
+        else
+            NL_TEST_ASSERT(inSuite, count == firstCount);
+
+        for (size_t i = 0; i < count; i++)
+            sBindings[i]->Release();
+    }
+}
+
+static void HandleTimer(System::Layer *aLayer, void *aAppState, System::Error aError)
+{
+}
+
+static void CheckTimers(nlTestSuite *inSuite, void *inContext)
+{
+    size_t firstCount = 0;
+
+    for (int round = 0; round < 2; round++)
+    {
+        size_t count;
+
+        // Each timer has its own application state, so that none replaces another.
+        for (count = 0; count <= kNumTimers; count++)
+        {
+            if (SystemLayer.StartTimer(kTimerTimeoutMsec, HandleTimer, &sTimerStates[count]) != WEAVE_SYSTEM_NO_ERROR)
+                break;
+        }
+
+        CheckAllocCount(inSuite, count, kNumTimers, kTimerLimit);
+
+        if (round == 0)
+            firstCount = count;
+        else
+            NL_TEST_ASSERT(inSuite, count == firstCount);
+
+        for (size_t i = 0; i < count; i++)
+            SystemLayer.CancelTimer(HandleTimer, &sTimerStates[i]);
+    }
+}
+
+static void CheckPacketBuffers(nlTestSuite *inSuite, void *inContext)
+{
+    size_t firstCount = 0;
+
+    for (int round = 0; round < 2; round++)
+    {
+        size_t count;
+
+        for (count = 0; count <= kNumPacketBuffers; count++)
+        {
+            sPacketBuffers[count] = PacketBuffer::New();
+            if (sPacketBuffers[count] == NULL)
+                break;
+        }
+
+        CheckAllocCount(inSuite, count, kNumPacketBuffers, kPacketBufferLimit);
+
+        if (round == 0)
+            firstCount = count;
+        else
+            NL_TEST_ASSERT(inSuite, count == firstCount);
+
+        for (size_t i = 0; i < count; i++)
+            PacketBuffer::Free(sPacketBuffers[i]);
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Coupled Limits",       CheckCoupledLimits),
+    NL_TEST_DEF("Exchange Contexts",    CheckExchangeContexts),
+    NL_TEST_DEF("Bindings",             CheckBindings),
+    NL_TEST_DEF("Timers",               CheckTimers),
+    NL_TEST_DEF("Packet Buffers",       CheckPacketBuffers),
+
+    NL_TEST_SENTINEL()
+};
+
+/**
+ *  Set up the test suite.
+ */
+static int TestSetup(void *inContext)
+{
+    InitSystemLayer();
+    InitNetwork();
+    InitWeaveStack(false, true);
+
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+static int TestTeardown(void *inContext)
+{
+    ShutdownWeaveStack();
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+#if WEAVE_SYSTEM_CONFIG_USE_LWIP
+    tcpip_init(NULL, NULL);
+#endif // WEAVE_SYSTEM_CONFIG_USE_LWIP
+
+    nlTestSuite theSuite = {
+        "weave-scale-capacity",
+        &sTests[0],
+        TestSetup,
+        TestTeardown
+    };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit against one context
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
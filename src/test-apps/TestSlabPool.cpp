@@ -0,0 +1,186 @@
+/*
+ *
+ *    Copyright (c) 2018 Nest Labs, Inc.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the Weave fixed-size
+ *      and growable object pool templates.
+ *
+ */
+
+#include <stdint.h>
+
+#include <nlunit-test.h>
+
+#include <Weave/Support/SlabPool.h>
+
+using nl::Weave::PoolStats;
+using nl::Weave::SlabPool;
+using nl::Weave::StaticPool;
+
+struct TestObject
+{
+    uint32_t mValue;
+    bool mInUse;
+};
+
+enum
+{
+    kPoolSize = 4
+};
+
+template <class PoolType>
+static size_t CountObjects(PoolType &pool)
+{
+    size_t count = 0;
+
+    for (TestObject *obj = pool.First(); obj != NULL; obj = pool.Next(obj))
+        count++;
+
+    return count;
+}
+
+static void CheckStaticPool(nlTestSuite *inSuite, void *inContext)
+{
+    StaticPool<TestObject, kPoolSize> pool;
+    TestObject *objs[kPoolSize];
+    PoolStats stats;
+
+    pool.Init();
+
+    for (size_t i = 0; i < kPoolSize; i++)
+    {
+        objs[i] = pool.Alloc();
+        NL_TEST_ASSERT(inSuite, objs[i] != NULL);
+        NL_TEST_ASSERT(inSuite, pool.GetIndex(objs[i]) == i);
+        NL_TEST_ASSERT(inSuite, objs[i]->mValue == 0 && !objs[i]->mInUse);
+    }
+
+    NL_TEST_ASSERT(inSuite, pool.Alloc() == NULL);
+
+    // A freed object is the next one handed out.
+    pool.Free(objs[1]);
+    NL_TEST_ASSERT(inSuite, pool.Alloc() == objs[1]);
+    pool.Free(objs[2]);
+    pool.Free(objs[3]);
+
+    pool.GetStats(stats);
+    NL_TEST_ASSERT(inSuite, stats.InUse == 2);
+    NL_TEST_ASSERT(inSuite, stats.HighWaterMark == kPoolSize);
+    NL_TEST_ASSERT(inSuite, stats.Capacity == kPoolSize);
+
+    NL_TEST_ASSERT(inSuite, CountObjects(pool) == kPoolSize);
+
+    pool.Shutdown();
+}
+
+static void CheckSlabPoolGrowth(nlTestSuite *inSuite, void *inContext)
+{
+    SlabPool<TestObject, kPoolSize> pool;
+    TestObject *objs[3 * kPoolSize];
+    PoolStats stats;
+
+    pool.Init();
+
+    for (size_t i = 0; i < 3 * kPoolSize; i++)
+    {
+        objs[i] = pool.Alloc();
+        NL_TEST_ASSERT(inSuite, objs[i] != NULL);
+        NL_TEST_ASSERT(inSuite, pool.GetIndex(objs[i]) == i);
+        NL_TEST_ASSERT(inSuite, objs[i]->mValue == 0 && !objs[i]->mInUse);
+        objs[i]->mValue = i;
+    }
+
+    pool.GetStats(stats);
+    NL_TEST_ASSERT(inSuite, stats.InUse == 3 * kPoolSize);
+    NL_TEST_ASSERT(inSuite, stats.Capacity == 3 * kPoolSize);
+
+    // Iteration visits every slot of every slab, in index order.
+    {
+        size_t i = 0;
+
+        for (TestObject *obj = pool.First(); obj != NULL; obj = pool.Next(obj), i++)
+            NL_TEST_ASSERT(inSuite, obj == objs[i] && obj->mValue == i);
+
+        NL_TEST_ASSERT(inSuite, i == 3 * kPoolSize);
+    }
+
+    // Freed objects are reused, most recently freed first, before the pool grows again.
+    pool.Free(objs[2]);
+    pool.Free(objs[kPoolSize + 1]);
+    NL_TEST_ASSERT(inSuite, pool.Alloc() == objs[kPoolSize + 1]);
+    NL_TEST_ASSERT(inSuite, pool.Alloc() == objs[2]);
+
+    pool.GetStats(stats);
+    NL_TEST_ASSERT(inSuite, stats.Capacity == 3 * kPoolSize);
+    NL_TEST_ASSERT(inSuite, stats.HighWaterMark == 3 * kPoolSize);
+
+    for (size_t i = 0; i < 3 * kPoolSize; i++)
+        pool.Free(objs[i]);
+
+    pool.GetStats(stats);
+    NL_TEST_ASSERT(inSuite, stats.InUse == 0);
+    NL_TEST_ASSERT(inSuite, stats.HighWaterMark == 3 * kPoolSize);
+
+    // Shutting down releases the heap slabs.
+    pool.Shutdown();
+    pool.GetStats(stats);
+    NL_TEST_ASSERT(inSuite, stats.Capacity == kPoolSize);
+    NL_TEST_ASSERT(inSuite, CountObjects(pool) == kPoolSize);
+}
+
+static void CheckSlabPoolLimit(nlTestSuite *inSuite, void *inContext)
+{
+    SlabPool<TestObject, kPoolSize> pool;
+    size_t count = 0;
+    PoolStats stats;
+
+    pool.Init(2);
+
+    while (pool.Alloc() != NULL)
+        count++;
+
+    NL_TEST_ASSERT(inSuite, count == 2 * kPoolSize);
+
+    pool.GetStats(stats);
+    NL_TEST_ASSERT(inSuite, stats.InUse == 2 * kPoolSize);
+    NL_TEST_ASSERT(inSuite, stats.Capacity == 2 * kPoolSize);
+
+    pool.Shutdown();
+}
+
+static const nlTest sTests[] = {
+    NL_TEST_DEF("static-pool",       CheckStaticPool),
+    NL_TEST_DEF("slab-pool-growth",  CheckSlabPoolGrowth),
+    NL_TEST_DEF("slab-pool-limit",   CheckSlabPoolLimit),
+    NL_TEST_SENTINEL()
+};
+
+int main(void)
+{
+    nlTestSuite theSuite = {
+        "weave-slab-pool",
+        &sTests[0]
+    };
+
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
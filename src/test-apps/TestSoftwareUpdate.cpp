@@ -29,11 +29,15 @@
 #include <Weave/Core/WeaveTLV.h>
 #include <Weave/Profiles/ProfileCommon.h>
 #include <Weave/Profiles/software-update/SoftwareUpdateProfile.h>
+#include <Weave/Profiles/software-update/DeltaImageDecoder.h>
+#include <Weave/Profiles/software-update/WeaveImageCache.h>
 
 #include <SystemLayer/SystemPacketBuffer.h>
 
 using namespace nl::Weave::TLV;
 using namespace nl::Weave::Profiles::SoftwareUpdate;
+using nl::Weave::Profiles::BulkDataTransfer::BDXTransfer;
+using nl::Weave::Profiles::BulkDataTransfer::ReceiveInit;
 
 void WeaveTestIntegrityTypeList(nlTestSuite * inSuite, void * inContext)
 {
@@ -604,6 +608,34 @@ void WeaveTestImageQuery(nlTestSuite * inSuite, void * inContext)
         PacketBuffer::Free(buffer);
     } while (0);
 
+    // test installed image option, which precedes the TLV
+    do
+    {
+        ImageQuery imageQuery;
+        ImageQuery parsedQuery;
+        PacketBuffer * buffer = PacketBuffer::New();
+        uint8_t installedHash[kLength_SHA256] = { 0xA5, 1, 2, 3 };
+        IntegritySpec installedImage;
+
+        err = installedImage.init(kIntegrityType_SHA256, installedHash);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = imageQuery.init(testSpec, testVersion, integrityTypeList, updateSchemeList, NULL, &testLocale, testNodeId,
+                              &testTLVData, &installedImage);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = imageQuery.pack(buffer);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = ImageQuery::parse(buffer, parsedQuery);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, parsedQuery.hasInstalledImageSpec);
+        NL_TEST_ASSERT(inSuite, parsedQuery.installedImageSpec == installedImage);
+        NL_TEST_ASSERT(inSuite, parsedQuery == imageQuery);
+
+        PacketBuffer::Free(buffer);
+    } while (0);
+
     // test packing errors
     // no options
     do
@@ -772,6 +804,321 @@ void WeaveTestImageQueryResponse(nlTestSuite * inSuite, void * inContext)
         }
         PacketBuffer::Free(buffer);
     } while (0);
+
+    // pack and parse a delta image response, including incomplete packets
+    do
+    {
+        PacketBuffer * buffer = PacketBuffer::New();
+        uint8_t baseHash[kLength_SHA256] = { 0x5A, 4, 3, 2, 1 };
+        IntegritySpec baseImage;
+        ImageQueryResponse deltaResponse;
+        uint16_t dataLen;
+
+        err = baseImage.init(kIntegrityType_SHA256, baseHash);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = deltaResponse.init(testUri, testVersion, testIntegritySpec, kUpdateScheme_BDX, Normal, IfUnmatched, false, &baseImage);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = deltaResponse.pack(buffer);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = ImageQueryResponse::parse(buffer, parsedResponse);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, parsedResponse.isDeltaImage);
+        NL_TEST_ASSERT(inSuite, parsedResponse.baseImageSpec == baseImage);
+        NL_TEST_ASSERT(inSuite, parsedResponse == deltaResponse);
+        NL_TEST_ASSERT(inSuite, !(parsedResponse == testResponse));
+
+        dataLen = buffer->DataLength();
+        for (int i = 0; i < dataLen; i++)
+        {
+            buffer->SetDataLength(i);
+            err = ImageQueryResponse::parse(buffer, parsedResponse);
+            NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+        }
+        PacketBuffer::Free(buffer);
+    } while (0);
+}
+
+struct DeltaImageTestState
+{
+    const uint8_t * baseImage;
+    uint32_t baseImageLen;
+    uint8_t newImage[64];
+    uint32_t newImageLen;
+};
+
+static WEAVE_ERROR DeltaImageTestReadBaseImage(void * aAppState, uint32_t aOffset, uint8_t * aBuf, uint32_t aLength)
+{
+    DeltaImageTestState * state = static_cast<DeltaImageTestState *>(aAppState);
+
+    if (aOffset > state->baseImageLen || aLength > state->baseImageLen - aOffset)
+        return WEAVE_ERROR_INVALID_ARGUMENT;
+
+    memcpy(aBuf, state->baseImage + aOffset, aLength);
+    return WEAVE_NO_ERROR;
+}
+
+static WEAVE_ERROR DeltaImageTestWriteImage(void * aAppState, uint8_t * aData, uint32_t aLength)
+{
+    DeltaImageTestState * state = static_cast<DeltaImageTestState *>(aAppState);
+
+    if (aLength > sizeof(state->newImage) - state->newImageLen)
+        return WEAVE_ERROR_BUFFER_TOO_SMALL;
+
+    memcpy(state->newImage + state->newImageLen, aData, aLength);
+    state->newImageLen += aLength;
+    return WEAVE_NO_ERROR;
+}
+
+void WeaveTestDeltaImageDecoder(nlTestSuite * inSuite, void * inContext)
+{
+    WEAVE_ERROR err;
+    const uint8_t baseImage[] = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25 };
+    const uint8_t expectedImage[] = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 0xAA, 0xBB, 20, 22, 24, 26 };
+    // clang-format off
+    uint8_t delta[] =
+    {
+        'W', 'D', 'L', 'T', DeltaImageDecoder::kFormatVersion, 16, 0, 0, 0,
+        DeltaImageDecoder::kOpcode_Copy, 0, 0, 0, 0, 10, 0, 0, 0,
+        DeltaImageDecoder::kOpcode_Insert, 2, 0, 0, 0, 0xAA, 0xBB,
+        DeltaImageDecoder::kOpcode_Add, 12, 0, 0, 0, 4, 0, 0, 0, 0xFE, 0xFF, 0, 1,
+        DeltaImageDecoder::kOpcode_End
+    };
+    // clang-format on
+    uint8_t buf[3];
+
+    // decode the delta image fed in pieces of every size
+    for (uint32_t pieceLen = 1; pieceLen <= sizeof(delta); pieceLen++)
+    {
+        DeltaImageDecoder decoder;
+        DeltaImageTestState state;
+
+        state.baseImage    = baseImage;
+        state.baseImageLen = sizeof(baseImage);
+        state.newImageLen  = 0;
+
+        decoder.Init(&state, DeltaImageTestReadBaseImage, DeltaImageTestWriteImage, buf, sizeof(buf));
+
+        err = WEAVE_NO_ERROR;
+        for (uint32_t offset = 0; offset < sizeof(delta) && err == WEAVE_NO_ERROR; offset += pieceLen)
+        {
+            uint32_t len = sizeof(delta) - offset < pieceLen ? sizeof(delta) - offset : pieceLen;
+
+            NL_TEST_ASSERT(inSuite, decoder.Finish() == WEAVE_ERROR_MESSAGE_INCOMPLETE);
+            err = decoder.Decode(delta + offset, len);
+        }
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = decoder.Finish();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, decoder.GetImageLength() == sizeof(expectedImage));
+        NL_TEST_ASSERT(inSuite, state.newImageLen == sizeof(expectedImage));
+        NL_TEST_ASSERT(inSuite, memcmp(state.newImage, expectedImage, sizeof(expectedImage)) == 0);
+
+        // nothing may follow the End command
+        err = decoder.Decode(delta, 1);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+    }
+
+    // malformed delta images
+    do
+    {
+        DeltaImageDecoder decoder;
+        DeltaImageTestState state;
+        uint8_t badDelta[sizeof(delta)];
+
+        state.baseImage    = baseImage;
+        state.baseImageLen = sizeof(baseImage);
+
+        // bad magic
+        memcpy(badDelta, delta, sizeof(delta));
+        badDelta[0] = 'X';
+        state.newImageLen = 0;
+        decoder.Init(&state, DeltaImageTestReadBaseImage, DeltaImageTestWriteImage, buf, sizeof(buf));
+        err = decoder.Decode(badDelta, sizeof(badDelta));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_ARGUMENT);
+
+        // unsupported version
+        memcpy(badDelta, delta, sizeof(delta));
+        badDelta[4] = DeltaImageDecoder::kFormatVersion + 1;
+        state.newImageLen = 0;
+        decoder.Init(&state, DeltaImageTestReadBaseImage, DeltaImageTestWriteImage, buf, sizeof(buf));
+        err = decoder.Decode(badDelta, sizeof(badDelta));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_UNSUPPORTED_MESSAGE_VERSION);
+
+        // commands describing more than the new image
+        memcpy(badDelta, delta, sizeof(delta));
+        badDelta[5] = 15;
+        state.newImageLen = 0;
+        decoder.Init(&state, DeltaImageTestReadBaseImage, DeltaImageTestWriteImage, buf, sizeof(buf));
+        err = decoder.Decode(badDelta, sizeof(badDelta));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+        // commands describing less than the new image
+        memcpy(badDelta, delta, sizeof(delta));
+        badDelta[5] = 17;
+        state.newImageLen = 0;
+        decoder.Init(&state, DeltaImageTestReadBaseImage, DeltaImageTestWriteImage, buf, sizeof(buf));
+        err = decoder.Decode(badDelta, sizeof(badDelta));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_MESSAGE_LENGTH);
+
+        // unknown opcode
+        memcpy(badDelta, delta, sizeof(delta));
+        badDelta[DeltaImageDecoder::kHeaderLength] = 0x7F;
+        state.newImageLen = 0;
+        decoder.Init(&state, DeltaImageTestReadBaseImage, DeltaImageTestWriteImage, buf, sizeof(buf));
+        err = decoder.Decode(badDelta, sizeof(badDelta));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_ARGUMENT);
+
+        // copy from outside the base image
+        memcpy(badDelta, delta, sizeof(delta));
+        badDelta[DeltaImageDecoder::kHeaderLength + 1] = 8;
+        state.newImageLen = 0;
+        decoder.Init(&state, DeltaImageTestReadBaseImage, DeltaImageTestWriteImage, buf, sizeof(buf));
+        err = decoder.Decode(badDelta, sizeof(badDelta));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_ARGUMENT);
+
+        // truncated
+        state.newImageLen = 0;
+        decoder.Init(&state, DeltaImageTestReadBaseImage, DeltaImageTestWriteImage, buf, sizeof(buf));
+        err = decoder.Decode(delta, sizeof(delta) - 1);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        err = decoder.Finish();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_MESSAGE_INCOMPLETE);
+    } while (0);
+}
+
+class ImageCacheTestDelegate : public IWeaveImageCacheDelegate
+{
+public:
+    void OnImageQueryMiss(ExchangeContext * ec, const WeaveMessageInfo * msgInfo, PacketBuffer * payload)
+    {
+        PacketBuffer::Free(payload);
+        ec->Close();
+    }
+
+    // The byte at each offset of the image is the offset modulo 251.
+    WEAVE_ERROR ReadCachedImage(const WeaveCachedImage & image, uint64_t offset, uint8_t * buf, uint32_t length)
+    {
+        if (offset + length > image.length)
+            return WEAVE_ERROR_INVALID_ARGUMENT;
+
+        for (uint32_t i = 0; i < length; i++)
+            buf[i] = static_cast<uint8_t>((offset + i) % 251);
+        return WEAVE_NO_ERROR;
+    }
+};
+
+void WeaveTestImageCache(nlTestSuite * inSuite, void * inContext)
+{
+    WEAVE_ERROR err;
+    WeaveImageCache cache;
+    ImageCacheTestDelegate delegate;
+    ProductSpec testSpec(9050, 4, 1);
+    ProductSpec otherSpec(9050, 5, 1);
+    uint8_t testSHA256Hash[32] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+    IntegritySpec testIntegritySpec;
+    char versionString[] = "v1.0";
+    ReferencedString testVersion;
+    uint8_t sha256Type = kIntegrityType_SHA256;
+    uint8_t sha160Type = kIntegrityType_SHA160;
+    uint8_t bdxScheme  = kUpdateScheme_BDX;
+    uint8_t httpsScheme = kUpdateScheme_HTTPS;
+    IntegrityTypeList sha256List, sha160List;
+    UpdateSchemeList bdxList, httpsList;
+    char testUri[] = "bdx://gateway/image-v2.0";
+    const WeaveCachedImage * image;
+
+    cache.SetDelegate(&delegate);
+
+    testIntegritySpec.init(kIntegrityType_SHA256, testSHA256Hash);
+    testVersion.init(static_cast<uint8_t>(strlen(versionString)), versionString);
+    sha256List.init(1, &sha256Type);
+    sha160List.init(1, &sha160Type);
+    bdxList.init(1, &bdxScheme);
+    httpsList.init(1, &httpsScheme);
+
+    err = cache.AddImage(testSpec, "v2.0", testIntegritySpec, testUri, 1000, NULL);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    // only queries for the product, accepting BDX and the integrity type, find the image
+    do
+    {
+        ImageQuery query;
+
+        query.init(testSpec, testVersion, sha256List, bdxList);
+        image = cache.FindImage(query);
+        NL_TEST_ASSERT(inSuite, image != NULL);
+        NL_TEST_ASSERT(inSuite, image != NULL && strcmp(image->uri, testUri) == 0 && strcmp(image->version, "v2.0") == 0);
+
+        query.init(testSpec, testVersion, sha256List, httpsList);
+        NL_TEST_ASSERT(inSuite, cache.FindImage(query) == NULL);
+
+        query.init(testSpec, testVersion, sha160List, bdxList);
+        NL_TEST_ASSERT(inSuite, cache.FindImage(query) == NULL);
+
+        query.init(otherSpec, testVersion, sha256List, bdxList);
+        NL_TEST_ASSERT(inSuite, cache.FindImage(query) == NULL);
+    } while (0);
+
+    NL_TEST_ASSERT(inSuite, cache.FindImage(testUri, static_cast<uint16_t>(strlen(testUri))) == image);
+    NL_TEST_ASSERT(inSuite, cache.FindImage(testUri, static_cast<uint16_t>(strlen(testUri) - 1)) == NULL);
+
+    // serve the image over BDX from an offset, a block at a time
+    do
+    {
+        BDXTransfer xfer;
+        ReceiveInit receiveInit;
+        ReferencedString designator;
+        uint8_t block[512];
+        uint64_t received = 0;
+        bool isLast = false;
+
+        xfer.Reset();
+
+        designator.init(static_cast<uint16_t>(strlen(testUri)), testUri);
+        receiveInit.init(1, true, true, false, sizeof(block), static_cast<uint32_t>(100), static_cast<uint32_t>(0), designator, NULL);
+
+        NL_TEST_ASSERT(inSuite, cache.HandleReceiveInit(&xfer, &receiveInit) == nl::Weave::Profiles::BulkDataTransfer::kStatus_NoError);
+        NL_TEST_ASSERT(inSuite, xfer.mIsAccepted && xfer.mLength == 900);
+        NL_TEST_ASSERT(inSuite, xfer.mHandlers.mGetBlockHandler != NULL);
+
+        // an image being served may not be replaced or removed
+        err = cache.AddImage(testSpec, "v3.0", testIntegritySpec, testUri, 1000, NULL);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INCORRECT_STATE);
+        err = cache.RemoveImage(testUri);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INCORRECT_STATE);
+
+        while (!isLast && received < 1000)
+        {
+            uint64_t length = sizeof(block);
+            uint8_t * data  = block;
+
+            xfer.mHandlers.mGetBlockHandler(&xfer, &length, &data, &isLast);
+            NL_TEST_ASSERT(inSuite, length == (isLast ? 900 % sizeof(block) : sizeof(block)));
+
+            for (uint64_t i = 0; i < length; i++)
+                NL_TEST_ASSERT(inSuite, data[i] == (100 + received + i) % 251);
+            received += length;
+        }
+        NL_TEST_ASSERT(inSuite, isLast && received == 900);
+
+        designator.init(static_cast<uint16_t>(strlen(testUri) - 1), testUri);
+        receiveInit.init(1, true, true, false, sizeof(block), static_cast<uint32_t>(0), static_cast<uint32_t>(0), designator, NULL);
+        NL_TEST_ASSERT(inSuite, cache.HandleReceiveInit(&xfer, &receiveInit) == nl::Weave::Profiles::BulkDataTransfer::kStatus_UnknownFile);
+    } while (0);
+
+    // the cache holds an image per product, up to its size
+    do
+    {
+        err = cache.AddImage(otherSpec, "v1.1", testIntegritySpec, "bdx://gateway/other-v1.1", 1000, NULL);
+        NL_TEST_ASSERT(inSuite, err == (WEAVE_CONFIG_SWU_IMAGE_CACHE_SIZE > 1 ? WEAVE_NO_ERROR : WEAVE_ERROR_NO_MEMORY));
+
+        err = cache.RemoveImage("bdx://gateway/unknown");
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_KEY_NOT_FOUND);
+    } while (0);
 }
 
 /**
@@ -783,6 +1130,8 @@ static const nlTest sTests[] = { NL_TEST_DEF("Test IntergrityTypeList", WeaveTes
                                  NL_TEST_DEF("Test ProductSpec", WeaveTestProductSpec),
                                  NL_TEST_DEF("Test ImageQuery", WeaveTestImageQuery),
                                  NL_TEST_DEF("Test ImageQueryResponse", WeaveTestImageQueryResponse),
+                                 NL_TEST_DEF("Test DeltaImageDecoder", WeaveTestDeltaImageDecoder),
+                                 NL_TEST_DEF("Test WeaveImageCache", WeaveTestImageCache),
                                  NL_TEST_SENTINEL() };
 
 /**
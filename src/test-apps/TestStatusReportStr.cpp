@@ -69,7 +69,7 @@ struct Profile_Status {
     WeaveProfileId id;
     const char *fmt;
     uint8_t statusCount;
-    uint16_t statusCodes[23];
+    uint16_t statusCodes[24];
 };
 
 static struct Profile_Status sContext[] = {
@@ -204,7 +204,7 @@ static struct Profile_Status sContext[] = {
     {
         kWeaveProfile_Security,
         "[ Security(%08" PRIX32 "):%" PRIu16 " ]",
-        23,
+        24,
         {
             Security::kStatusCode_SessionAborted,
             Security::kStatusCode_PASESupportsOnlyConfig1,
@@ -229,6 +229,7 @@ static struct Profile_Status sContext[] = {
             Security::kStatusCode_OperationalNodeIdInUse,
             Security::kStatusCode_InvalidOperationalNodeId,
             Security::kStatusCode_InvalidOperationalCertificate,
+            Security::kStatusCode_ResumptionTicketNotFound,
          }
     },
     {
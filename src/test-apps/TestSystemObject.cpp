@@ -69,6 +69,7 @@ public:
     Error Init(void);
 
     static void CheckRetention(nlTestSuite* inSuite, void* aContext);
+    static void CheckFreeSlots(nlTestSuite* inSuite, void* aContext);
     static void CheckConcurrency(nlTestSuite* inSuite, void* aContext);
     static void CheckHighWatermark(nlTestSuite* inSuite, void* aContext);
     static void CheckHighWatermarkConcurrency(nlTestSuite* inSuite, void* aContext);
@@ -183,6 +184,67 @@ void TestObject::CheckRetention(nlTestSuite* inSuite, void* aContext)
 }
 
 
+// Test Object slot reuse
+
+void TestObject::CheckFreeSlots(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext&    lContext = *static_cast<TestContext*>(aContext);
+    const unsigned int kStride = 7;
+    Layer           lLayer;
+    TestObject*     lObject;
+    unsigned int    i;
+
+    lLayer.Init(lContext.mLayerContext);
+    memset(&sPool, 0, sizeof(sPool));
+
+    for (i = 0; i < kPoolSize; ++i)
+    {
+        lObject = sPool.TryCreate(lLayer);
+        NL_TEST_ASSERT(lContext.mTestSuite, lObject == sPool.Get(lLayer, i));
+    }
+
+    NL_TEST_ASSERT(lContext.mTestSuite, sPool.TryCreate(lLayer) == NULL);
+
+    // Free scattered slots, including the last one, in descending order.
+    sPool.Get(lLayer, kPoolSize - 1)->Release();
+
+    for (i = (kPoolSize - 2) / kStride * kStride; ; i -= kStride)
+    {
+        sPool.Get(lLayer, i)->Release();
+
+        if (i == 0)
+            break;
+    }
+
+    // The freed slots are handed out again lowest first, and only once each.
+    for (i = 0; i < kPoolSize - 1; i += kStride)
+    {
+        NL_TEST_ASSERT(lContext.mTestSuite, sPool.Get(lLayer, i) == NULL);
+
+        lObject = sPool.TryCreate(lLayer);
+        NL_TEST_ASSERT(lContext.mTestSuite, lObject != NULL && lObject == sPool.Get(lLayer, i));
+    }
+
+    lObject = sPool.TryCreate(lLayer);
+    NL_TEST_ASSERT(lContext.mTestSuite, lObject != NULL && lObject == sPool.Get(lLayer, kPoolSize - 1));
+    NL_TEST_ASSERT(lContext.mTestSuite, sPool.TryCreate(lLayer) == NULL);
+
+    for (i = 0; i < kPoolSize; ++i)
+    {
+        lObject = sPool.Get(lLayer, i);
+
+        NL_TEST_ASSERT(lContext.mTestSuite, lObject != NULL);
+        if (lObject == NULL)
+            continue;
+
+        lObject->Release();
+        NL_TEST_ASSERT(lContext.mTestSuite, !lObject->IsRetained(lLayer));
+    }
+
+    lLayer.Shutdown();
+}
+
+
 // Test Object concurrency
 
 #if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
@@ -454,6 +516,7 @@ void TestObject::CheckHighWatermark(nlTestSuite* inSuite, void* aContext)
  */
 const nlTest sTests[] = {
     NL_TEST_DEF("Retention", TestObject::CheckRetention),
+    NL_TEST_DEF("FreeSlots", TestObject::CheckFreeSlots),
     NL_TEST_DEF("Concurrency", TestObject::CheckConcurrency),
     NL_TEST_DEF("HighWatermark", TestObject::CheckHighWatermark),
     NL_TEST_DEF("HighWatermarkConcurrency", TestObject::CheckHighWatermarkConcurrency),
@@ -43,6 +43,11 @@
 #include <sys/select.h>
 #endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS
 
+#if WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#include <sched.h>
+#endif // WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+
 #include <SystemLayer/SystemError.h>
 #include <SystemLayer/SystemLayer.h>
 #include <SystemLayer/SystemTimer.h>
@@ -186,8 +191,229 @@ static void CheckStarvation(nlTestSuite* inSuite, void* aContext)
     sleepTime.tv_sec = 0;
     sleepTime.tv_usec = 1000; // 1 ms tick
     ServiceEvents(lSys, sleepTime);
+
+    lSys.CancelTimer(HandleGreedyTimer, aContext);
+}
+
+
+static const uint32_t kOrderDelays[] = { 40, 0, 130, 5, 70, 5, 300, 1 };
+static const size_t kNumOrderTimers = sizeof(kOrderDelays) / sizeof(kOrderDelays[0]);
+static const size_t kCancelledOrderTimer = 4;
+static uint64_t sOrderStart;
+static uint32_t sOrderFired[kNumOrderTimers];
+static size_t sNumOrderFired;
+static bool sOrderFailed;
+
+void HandleOrderTimer(Layer* aLayer, void* aState, Error aError)
+{
+    const size_t lIndex = static_cast<size_t>(reinterpret_cast<uintptr_t>(aState));
+    const uint64_t lElapsed = Layer::GetClock_MonotonicMS() - sOrderStart;
+
+    if (lIndex == kCancelledOrderTimer || lElapsed < kOrderDelays[lIndex] || sNumOrderFired >= kNumOrderTimers)
+        sOrderFailed = true;
+    else
+        sOrderFired[sNumOrderFired++] = kOrderDelays[lIndex];
+}
+
+static void CheckOrder(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    Layer& lSys = *lContext.mLayer;
+
+    sNumOrderFired = 0;
+    sOrderFailed = false;
+    sOrderStart = Layer::GetClock_MonotonicMS();
+
+    for (size_t i = 0; i < kNumOrderTimers; i++)
+    {
+        Error lError = lSys.StartTimer(kOrderDelays[i], HandleOrderTimer, reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_SYSTEM_NO_ERROR);
+    }
+
+    lSys.CancelTimer(HandleOrderTimer, reinterpret_cast<void*>(static_cast<uintptr_t>(kCancelledOrderTimer)));
+
+    while (sNumOrderFired < kNumOrderTimers - 1 && !sOrderFailed &&
+           Layer::GetClock_MonotonicMS() - sOrderStart < 2000)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 100000;
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, !sOrderFailed);
+    NL_TEST_ASSERT(inSuite, sNumOrderFired == kNumOrderTimers - 1);
+
+    for (size_t i = 1; i < sNumOrderFired; i++)
+    {
+        NL_TEST_ASSERT(inSuite, sOrderFired[i - 1] <= sOrderFired[i]);
+    }
+}
+
+static const uint32_t kSlackDelay = 20;
+static const uint32_t kSlackTolerance = 200;
+static const uint32_t kStrictDelay = 60;
+static uint64_t sSlackStart;
+static uint64_t sSlackFired;
+static uint64_t sStrictFired;
+
+void HandleSlackTimer(Layer* aLayer, void* aState, Error aError)
+{
+    sSlackFired = Layer::GetClock_MonotonicMS() - sSlackStart;
+}
+
+void HandleStrictTimer(Layer* aLayer, void* aState, Error aError)
+{
+    sStrictFired = Layer::GetClock_MonotonicMS() - sSlackStart;
+}
+
+static void CheckTolerance(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    Layer& lSys = *lContext.mLayer;
+    Error lError;
+
+    sSlackFired = sStrictFired = 0;
+    sSlackStart = Layer::GetClock_MonotonicMS();
+
+    lError = lSys.StartTimer(kSlackDelay, kSlackTolerance, HandleSlackTimer, aContext);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_SYSTEM_NO_ERROR);
+    lError = lSys.StartTimer(kStrictDelay, HandleStrictTimer, aContext);
+    NL_TEST_ASSERT(inSuite, lError == WEAVE_SYSTEM_NO_ERROR);
+
+    while ((sSlackFired == 0 || sStrictFired == 0) && Layer::GetClock_MonotonicMS() - sSlackStart < 2000)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 100000;
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sSlackFired >= kSlackDelay);
+    NL_TEST_ASSERT(inSuite, sStrictFired >= kStrictDelay);
+
+#if !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+    // The timer with slack is deferred until the strict timer fires, and both complete on the same wake-up.
+    NL_TEST_ASSERT(inSuite, sSlackFired >= kStrictDelay);
+#endif // !WEAVE_SYSTEM_CONFIG_USE_TIMER_WHEEL
+}
+
+#if WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+static const size_t kNumPoolTimers = 3 * WEAVE_SYSTEM_CONFIG_NUM_TIMERS;
+static size_t sNumPoolTimersFired;
+
+void HandlePoolTimer(Layer* aLayer, void* aState, Error aError)
+{
+    sNumPoolTimersFired++;
 }
 
+static void CheckDynamicPool(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    Layer& lSys = *lContext.mLayer;
+    const uint64_t lStart = Layer::GetClock_MonotonicMS();
+
+    sNumPoolTimersFired = 0;
+
+    for (size_t i = 0; i < kNumPoolTimers; i++)
+    {
+        Error lError = lSys.StartTimer(static_cast<uint32_t>(i % 7), HandlePoolTimer, reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+        NL_TEST_ASSERT(inSuite, lError == WEAVE_SYSTEM_NO_ERROR);
+    }
+
+    while (sNumPoolTimersFired < kNumPoolTimers && Layer::GetClock_MonotonicMS() - lStart < 2000)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 10000;
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sNumPoolTimersFired == kNumPoolTimers);
+}
+#endif // WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+static const size_t kNumWorkThreads = 4;
+static const size_t kNumWorkPerThread = 250;
+static const size_t kNumBurstWork = WEAVE_SYSTEM_CONFIG_NUM_TIMERS / 2;
+static volatile size_t sNumWorkHandled;
+
+void HandleCrossThreadWork(Layer* aLayer, void* aState, Error aError)
+{
+    sNumWorkHandled++;
+}
+
+static void* PostWork(void* aArg)
+{
+    Layer& lSys = *static_cast<Layer*>(aArg);
+    size_t lNumPosted = 0;
+
+    while (lNumPosted < kNumWorkPerThread)
+    {
+        // The timer pool may be momentarily exhausted while the select loop catches up.
+        if (lSys.ScheduleWork(HandleCrossThreadWork, NULL) == WEAVE_SYSTEM_NO_ERROR)
+            lNumPosted++;
+        else
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void* PostBurst(void* aArg)
+{
+    Layer& lSys = *static_cast<Layer*>(aArg);
+
+    for (size_t i = 0; i < kNumBurstWork; i++)
+        lSys.ScheduleWork(HandleCrossThreadWork, NULL);
+
+    return NULL;
+}
+
+static void CheckCrossThreadWork(nlTestSuite* inSuite, void* aContext)
+{
+    TestContext& lContext = *static_cast<TestContext*>(aContext);
+    Layer& lSys = *lContext.mLayer;
+    pthread_t lThreads[kNumWorkThreads];
+    uint64_t lStart;
+
+    // A burst posted while the select loop is idle coalesces into one wake, and one pass dispatches all of it.
+    sNumWorkHandled = 0;
+
+    NL_TEST_ASSERT(inSuite, pthread_create(&lThreads[0], NULL, PostBurst, &lSys) == 0);
+    pthread_join(lThreads[0], NULL);
+
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec = 1;
+        sleepTime.tv_usec = 0;
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    NL_TEST_ASSERT(inSuite, sNumWorkHandled == kNumBurstWork);
+
+    // Several producers posting while the select loop runs.
+    sNumWorkHandled = 0;
+    lStart = Layer::GetClock_MonotonicMS();
+
+    for (size_t i = 0; i < kNumWorkThreads; i++)
+        NL_TEST_ASSERT(inSuite, pthread_create(&lThreads[i], NULL, PostWork, &lSys) == 0);
+
+    while (sNumWorkHandled < kNumWorkThreads * kNumWorkPerThread && Layer::GetClock_MonotonicMS() - lStart < 5000)
+    {
+        struct timeval sleepTime;
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 100000;
+        ServiceEvents(lSys, sleepTime);
+    }
+
+    for (size_t i = 0; i < kNumWorkThreads; i++)
+        pthread_join(lThreads[i], NULL);
+
+    NL_TEST_ASSERT(inSuite, sNumWorkHandled == kNumWorkThreads * kNumWorkPerThread);
+}
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
 
 // Test Suite
 
@@ -198,6 +424,14 @@ static void CheckStarvation(nlTestSuite* inSuite, void* aContext)
 static const nlTest sTests[] = {
     NL_TEST_DEF("Timer::TestOverflow",             CheckOverflow),
     NL_TEST_DEF("Timer::TestTimerStarvation",      CheckStarvation),
+    NL_TEST_DEF("Timer::TestTimerOrder",           CheckOrder),
+    NL_TEST_DEF("Timer::TestTimerTolerance",       CheckTolerance),
+#if WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+    NL_TEST_DEF("Timer::TestDynamicPool",          CheckDynamicPool),
+#endif // WEAVE_SYSTEM_CONFIG_DYNAMIC_TIMER_POOL
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
+    NL_TEST_DEF("Timer::TestCrossThreadWork",      CheckCrossThreadWork),
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_SYSTEM_CONFIG_POSIX_LOCKING
     NL_TEST_SENTINEL()
 };
 
@@ -159,6 +159,12 @@ static void TestTdmDictionary_DeleteStoreOverflowAndItemAddition(nlTestSuite *in
 static void TestTdmDictionary_DirtyStoreOverflowAndItemDeletion(nlTestSuite *inSuite, void *inContext);
 static void TestTdmDictionary_DeleteEntryTwice(nlTestSuite *inSuite, void *inContext);
 static void TestRandomizedDataVersions(nlTestSuite *inSuite, void *inContext);
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+static void TestDataSourceVersionHistory(nlTestSuite *inSuite, void *inContext);
+#endif
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+static void TestDataSourceSnapshot(nlTestSuite *inSuite, void *inContext);
+#endif
 
 static void TestTdmStatic_MultiInstance(nlTestSuite *inSuite, void *inContext);
 static void CheckAllocateRightSizedBufferForNotifications(nlTestSuite *inSuite, void *inContext);
@@ -223,6 +229,16 @@ static const nlTest sTests[] = {
     // Test randomized data versions
     NL_TEST_DEF("Test Tdm (Randomized Data Versions): Randomized Data Versions", TestRandomizedDataVersions),
 
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    // Test the data source version history used to narrow the first notify of a resubscribe
+    NL_TEST_DEF("Test Tdm (Version History): Changed handle since a version", TestDataSourceVersionHistory),
+#endif
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+    // Test the pre-encoded snapshot of a data source
+    NL_TEST_DEF("Test Tdm (Snapshot): Read of the root from a snapshot", TestDataSourceSnapshot),
+#endif
+
     NL_TEST_DEF("Test Tdm (Multi Instance): Multi Instance", TestTdmStatic_MultiInstance),
 
     // Tests the allocation of buffer for building and sending Notifies and
@@ -416,6 +432,9 @@ public:
     void SetValue(PropertyPathHandle aPropertyPathHandle, uint32_t aValue);
     void Reset();
 
+    // Making this public to allow tests to access it.
+    using TraitDataSource::SetVersion;
+
 private:
     WEAVE_ERROR GetLeafData(PropertyPathHandle aLeafHandle, uint64_t aTagToWrite, TLVWriter &aWriter);
     WEAVE_ERROR GetNextDictionaryItemKey(PropertyPathHandle aDictionaryHandle, uintptr_t &aContext, PropertyDictionaryKey &aKey);
@@ -738,6 +757,12 @@ public:
     void TestTdmDictionary_DeleteEntryTwice(nlTestSuite *inSuite);
 
     void TestRandomizedDataVersions(nlTestSuite *inSuite);
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+    void TestDataSourceVersionHistory(nlTestSuite *inSuite);
+#endif
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+    void TestDataSourceSnapshot(nlTestSuite *inSuite);
+#endif
 
     void TestTdmStatic_MultiInstance(nlTestSuite *inSuite);
 
@@ -2013,6 +2038,134 @@ void TestTdm::TestRandomizedDataVersions(nlTestSuite *inSuite)
     NL_TEST_ASSERT(inSuite, version == 10);
 }
 
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+void TestTdm::TestDataSourceVersionHistory(nlTestSuite *inSuite)
+{
+    TestTdmSource dataSource;
+    TraitDataSource::VersionHistoryEntry history[3];
+    PropertyPathHandle changedHandle;
+    uint64_t baseVersion;
+    PropertyPathHandle changes[] = {
+        TestHTrait::kPropertyHandle_K_Sb,
+        TestHTrait::kPropertyHandle_K_Sc,
+        TestHTrait::kPropertyHandle_A,
+        TestHTrait::kPropertyHandle_K_Sb,
+        TestHTrait::kPropertyHandle_K_Sc
+    };
+
+    dataSource.SetVersionHistoryStore(history, sizeof(history) / sizeof(history[0]));
+    baseVersion = dataSource.GetVersion();
+
+    // Case 1 - nothing recorded yet
+    NL_TEST_ASSERT(inSuite, !dataSource.GetChangedHandleSince(baseVersion, changedHandle));
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        dataSource.Lock();
+        dataSource.SetDirty(changes[i]);
+        dataSource.Unlock();
+    }
+
+    // Case 2 - one version back is just the last change, two versions back is the lowest common ancestor of both
+    NL_TEST_ASSERT(inSuite, dataSource.GetChangedHandleSince(baseVersion + 1, changedHandle));
+    NL_TEST_ASSERT(inSuite, changedHandle == TestHTrait::kPropertyHandle_K_Sc);
+    NL_TEST_ASSERT(inSuite, dataSource.GetChangedHandleSince(baseVersion, changedHandle));
+    NL_TEST_ASSERT(inSuite, changedHandle == TestHTrait::kPropertyHandle_K);
+
+    // Case 3 - the current version, or one from the future, has no changes to send
+    NL_TEST_ASSERT(inSuite, !dataSource.GetChangedHandleSince(baseVersion + 2, changedHandle));
+    NL_TEST_ASSERT(inSuite, !dataSource.GetChangedHandleSince(baseVersion + 3, changedHandle));
+
+    for (size_t i = 2; i < sizeof(changes) / sizeof(changes[0]); i++)
+    {
+        dataSource.Lock();
+        dataSource.SetDirty(changes[i]);
+        dataSource.Unlock();
+    }
+
+    // Case 4 - only the last three versions are kept
+    NL_TEST_ASSERT(inSuite, !dataSource.GetChangedHandleSince(baseVersion + 1, changedHandle));
+    NL_TEST_ASSERT(inSuite, dataSource.GetChangedHandleSince(baseVersion + 2, changedHandle));
+    NL_TEST_ASSERT(inSuite, changedHandle == TestHTrait::kPropertyHandle_Root);
+    NL_TEST_ASSERT(inSuite, dataSource.GetChangedHandleSince(baseVersion + 3, changedHandle));
+    NL_TEST_ASSERT(inSuite, changedHandle == TestHTrait::kPropertyHandle_K);
+
+    // Case 5 - a version set by the app invalidates the history
+    dataSource.SetVersion(baseVersion + 10);
+    NL_TEST_ASSERT(inSuite, !dataSource.GetChangedHandleSince(baseVersion + 3, changedHandle));
+
+    dataSource.Lock();
+    dataSource.SetDirty(TestHTrait::kPropertyHandle_A);
+    dataSource.Unlock();
+
+    NL_TEST_ASSERT(inSuite, !dataSource.GetChangedHandleSince(baseVersion + 3, changedHandle));
+    NL_TEST_ASSERT(inSuite, dataSource.GetChangedHandleSince(baseVersion + 10, changedHandle));
+    NL_TEST_ASSERT(inSuite, changedHandle == TestHTrait::kPropertyHandle_A);
+}
+#endif // WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+static uint32_t ReadRoot(TraitDataSource & aDataSource, uint8_t * aBuf, uint32_t aBufSize)
+{
+    TLVWriter writer;
+    TLVType dataElementType;
+
+    // Read the trait instance the way a notify does, as the data of a data element.
+    writer.Init(aBuf, aBufSize);
+    if (writer.StartContainer(AnonymousTag, kTLVType_Structure, dataElementType) != WEAVE_NO_ERROR ||
+        aDataSource.ReadData(kRootPropertyPathHandle, ContextTag(DataElement::kCsTag_Data), writer) != WEAVE_NO_ERROR ||
+        writer.EndContainer(dataElementType) != WEAVE_NO_ERROR || writer.Finalize() != WEAVE_NO_ERROR)
+    {
+        return 0;
+    }
+
+    return writer.GetLengthWritten();
+}
+
+void TestTdm::TestDataSourceSnapshot(nlTestSuite *inSuite)
+{
+    TestTdmSource dataSource, referenceSource, smallStoreSource;
+    uint8_t snapshot[256];
+    uint8_t smallSnapshot[8];
+    uint8_t buf[256], referenceBuf[256];
+    uint32_t len, referenceLen;
+
+    dataSource.SetSnapshotStore(snapshot, sizeof(snapshot));
+    smallStoreSource.SetSnapshotStore(smallSnapshot, sizeof(smallSnapshot));
+
+    // Case 1 - the first read builds the snapshot, and reads the same as a source without one
+    len = ReadRoot(dataSource, buf, sizeof(buf));
+    referenceLen = ReadRoot(referenceSource, referenceBuf, sizeof(referenceBuf));
+    NL_TEST_ASSERT(inSuite, len != 0 && len == referenceLen && memcmp(buf, referenceBuf, len) == 0);
+
+    // Case 2 - data changed without marking it dirty is not seen, since the snapshot is read instead
+    dataSource.mBackingValue = 2;
+    len = ReadRoot(dataSource, buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, len == referenceLen && memcmp(buf, referenceBuf, len) == 0);
+
+    // Case 3 - marking the source dirty discards the snapshot
+    dataSource.mBackingValue = 1;
+    dataSource.Lock();
+    dataSource.SetValue(TestHTrait::kPropertyHandle_A, 7);
+    dataSource.Unlock();
+    referenceSource.Lock();
+    referenceSource.SetValue(TestHTrait::kPropertyHandle_A, 7);
+    referenceSource.Unlock();
+
+    len = ReadRoot(dataSource, buf, sizeof(buf));
+    referenceLen = ReadRoot(referenceSource, referenceBuf, sizeof(referenceBuf));
+    NL_TEST_ASSERT(inSuite, len != 0 && len == referenceLen && memcmp(buf, referenceBuf, len) == 0);
+
+    // Case 4 - a store that is too small falls back to reading every property
+    smallStoreSource.Lock();
+    smallStoreSource.SetValue(TestHTrait::kPropertyHandle_A, 7);
+    smallStoreSource.Unlock();
+
+    len = ReadRoot(smallStoreSource, buf, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, len == referenceLen && memcmp(buf, referenceBuf, len) == 0);
+}
+#endif // WDM_PUBLISHER_SNAPSHOT_SUPPORT
+
 WEAVE_ERROR TestTdm::AllocateBuffer(uint32_t desiredSize, uint32_t minSize)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -2395,6 +2548,20 @@ static void  TestRandomizedDataVersions(nlTestSuite *inSuite, void *inContext)
     gTestTdm->TestRandomizedDataVersions(inSuite);
 }
 
+#if WDM_PUBLISHER_VERSION_HISTORY_SUPPORT
+static void TestDataSourceVersionHistory(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestDataSourceVersionHistory(inSuite);
+}
+#endif
+
+#if WDM_PUBLISHER_SNAPSHOT_SUPPORT
+static void TestDataSourceSnapshot(nlTestSuite *inSuite, void *inContext)
+{
+    gTestTdm->TestDataSourceSnapshot(inSuite);
+}
+#endif
+
 static void TestTdmStatic_MultiInstance(nlTestSuite *inSuite, void *inContext)
 {
     gTestTdm->TestTdmStatic_MultiInstance(inSuite);
@@ -31,6 +31,8 @@
 #include <Weave/Core/WeaveTLV.h>
 #include <Weave/Core/WeaveTLVDebug.hpp>
 #include <Weave/Core/WeaveTLVUtilities.hpp>
+#include <Weave/Core/WeaveTLVIndex.hpp>
+#include <Weave/Core/WeaveTLVJson.hpp>
 #include <Weave/Core/WeaveTLVData.hpp>
 #include <Weave/Core/WeaveCircularTLVBuffer.h>
 #include <Weave/Support/RandUtils.h>
@@ -1564,6 +1566,284 @@ void CheckWeaveTLVUtilities(nlTestSuite *inSuite, void *inContext)
     NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
 }
 
+/**
+ *  Test Weave TLV Index
+ */
+void CheckWeaveTLVIndex(nlTestSuite *inSuite, void *inContext)
+{
+    uint8_t buf[2048];
+    TLVWriter writer;
+    TLVReader reader, tagReader, containerReader;
+    TLVIndex index;
+    TLVIndex::Entry entries[18];
+    TLVType outerContainerType;
+    WEAVE_ERROR err;
+
+    writer.Init(buf, sizeof(buf));
+    writer.ImplicitProfileId = TestProfile_2;
+
+    WriteEncoding1(inSuite, writer);
+
+    uint32_t encodedLen = writer.GetLengthWritten();
+
+    // Too few entries
+    err = index.Init(buf, encodedLen, entries, 17, TestProfile_2);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    err = index.Init(buf, encodedLen, entries, 18, TestProfile_2);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, index.GetEntryCount() == 18);
+    NL_TEST_ASSERT(inSuite, entries[0].DescendantCount == 17);
+    NL_TEST_ASSERT(inSuite, entries[0].EndOffset == encodedLen);
+
+    reader.Init(buf, encodedLen);
+    reader.ImplicitProfileId = TestProfile_2;
+
+    TestNext(inSuite, reader);
+
+    // Find a member that follows a large container
+    err = index.Find(reader, ProfileTag(TestProfile_2, 65536), tagReader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    TestGet<TLVReader, double>(inSuite, tagReader, kTLVType_FloatingPointNumber, ProfileTag(TestProfile_2, 65536), (double)17.9);
+    TestEnd<TLVReader>(inSuite, tagReader);
+
+    // Find a member that is not present, or is nested more deeply
+    err = index.Find(reader, ProfileTag(TestProfile_2, 1024), tagReader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_TLV_TAG_NOT_FOUND);
+
+    err = index.Find(reader, ProfileTag(TestProfile_1, 17), tagReader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_TLV_TAG_NOT_FOUND);
+
+    // The result is positioned as a reader returned by OpenContainer() would be
+    err = index.Find(reader, ProfileTag(TestProfile_1, 5), tagReader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    TestAndOpenContainer(inSuite, reader, kTLVType_Structure, ProfileTag(TestProfile_1, 1), containerReader);
+    do
+    {
+        TestNext(inSuite, containerReader);
+    } while (containerReader.GetTag() != ProfileTag(TestProfile_1, 5));
+
+    NL_TEST_ASSERT(inSuite, tagReader.GetLengthRead() == containerReader.GetLengthRead());
+    NL_TEST_ASSERT(inSuite, tagReader.GetContainerType() == containerReader.GetContainerType());
+    TestString(inSuite, tagReader, ProfileTag(TestProfile_1, 5), "This is a test");
+
+    // Skip an indexed container and continue reading after it
+    err = index.Find(reader, ContextTag(0), tagReader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, tagReader.GetType() == kTLVType_Array);
+
+    err = index.Skip(tagReader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    TestNext(inSuite, tagReader);
+    NL_TEST_ASSERT(inSuite, tagReader.GetTag() == ProfileTag(TestProfile_1, 5));
+
+    // Skip within a container entered by the reader
+    err = index.Find(reader, ContextTag(0), tagReader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    TestAndEnterContainer<TLVReader>(inSuite, tagReader, kTLVType_Array, ContextTag(0), outerContainerType);
+    for (int i = 0; i < 6; i++)
+    {
+        TestNext(inSuite, tagReader);
+        err = index.Skip(tagReader);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+    TestEndAndExitContainer<TLVReader>(inSuite, tagReader, outerContainerType);
+    TestNext(inSuite, tagReader);
+    NL_TEST_ASSERT(inSuite, tagReader.GetTag() == ProfileTag(TestProfile_1, 5));
+
+    // Readers over a different copy of the encoding fall back to linear operations
+    {
+        uint8_t buf2[2048];
+        TLVReader reader2;
+
+        memcpy(buf2, buf, encodedLen);
+        reader2.Init(buf2, encodedLen);
+        reader2.ImplicitProfileId = TestProfile_2;
+        TestNext(inSuite, reader2);
+
+        err = index.Find(reader2, ProfileTag(TestProfile_2, 65535), tagReader);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        TestGet<TLVReader, double>(inSuite, tagReader, kTLVType_FloatingPointNumber, ProfileTag(TestProfile_2, 65535), (float)17.9);
+
+        err = index.Skip(reader2);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        TestEnd<TLVReader>(inSuite, reader2);
+    }
+
+    // Skip the outermost container
+    reader.Init(buf, encodedLen);
+    reader.ImplicitProfileId = TestProfile_2;
+    TestNext(inSuite, reader);
+    err = index.Skip(reader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.GetLengthRead() == encodedLen);
+    TestEnd<TLVReader>(inSuite, reader);
+}
+
+/**
+ *  Test Weave TLV JSON conversion
+ */
+struct JsonTestOutput
+{
+    char Buf[512];
+    size_t Len;
+};
+
+static WEAVE_ERROR JsonTestOutputFunct(const char *aData, size_t aDataLen, void *aContext)
+{
+    JsonTestOutput *output = static_cast<JsonTestOutput *>(aContext);
+
+    if (output->Len + aDataLen >= sizeof(output->Buf))
+        return WEAVE_ERROR_BUFFER_TOO_SMALL;
+
+    memcpy(output->Buf + output->Len, aData, aDataLen);
+    output->Len += aDataLen;
+    output->Buf[output->Len] = 0;
+
+    return WEAVE_NO_ERROR;
+}
+
+static const char *JsonTestTagName(uint64_t aTag, void *aContext)
+{
+    return (aTag == ContextTag(7)) ? "name" : NULL;
+}
+
+static WEAVE_ERROR JsonTestTagLookup(const char *aName, size_t aNameLen, uint64_t &aTag, void *aContext)
+{
+    if (aNameLen != 4 || memcmp(aName, "name", 4) != 0)
+        return WEAVE_ERROR_INVALID_TLV_TAG;
+
+    aTag = ContextTag(7);
+    return WEAVE_NO_ERROR;
+}
+
+void CheckWeaveTLVJson(nlTestSuite *inSuite, void *inContext)
+{
+    static const char sExpectedJson[] =
+        "{\"1\":-17,\"2\":40000000000,\"3\":true,\"4\":null,\"5\":1.5,"
+        "\"0x00235A00:9\":[\"a\\\"b\\n\",[],{}],\"name\":\"x\"}\n"
+        "\"AQID\"\n";
+    static const uint8_t sBytes[] = { 1, 2, 3 };
+    WEAVE_ERROR err;
+    uint8_t buf[256];
+    uint8_t buf2[256];
+    char scratch[16];
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainerType, outerContainerType2;
+    JsonTestOutput output;
+    Json::ConvertContext context = { JsonTestOutputFunct, JsonTestTagName, JsonTestTagLookup, &output };
+
+    writer.Init(buf, sizeof(buf));
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    {
+        err = writer.Put(ContextTag(1), (int8_t)-17);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = writer.Put(ContextTag(2), (uint64_t)40000000000ULL);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = writer.PutBoolean(ContextTag(3), true);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = writer.PutNull(ContextTag(4));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = writer.Put(ContextTag(5), 1.5);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = writer.StartContainer(ProfileTag(0x235A00, 9), kTLVType_Array, outerContainerType2);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        {
+            TLVType outerContainerType3;
+
+            err = writer.PutString(AnonymousTag, "a\"b\n");
+            NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+            err = writer.StartContainer(AnonymousTag, kTLVType_Array, outerContainerType3);
+            NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+            err = writer.EndContainer(outerContainerType3);
+            NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+            err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType3);
+            NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+            err = writer.EndContainer(outerContainerType3);
+            NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        }
+        err = writer.EndContainer(outerContainerType2);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = writer.PutString(ContextTag(7), "x");
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.PutBytes(AnonymousTag, sBytes, sizeof(sBytes));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    // TLV to JSON
+    output.Len = 0;
+    reader.Init(buf, writer.GetLengthWritten());
+
+    err = Json::TLVToJson(reader, context);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(output.Buf, sExpectedJson) == 0);
+
+    // JSON to TLV and back again.  The byte string comes back as a UTF-8 string.
+    writer.Init(buf2, sizeof(buf2));
+
+    err = Json::JsonToTLV(output.Buf, output.Len, writer, context, scratch, sizeof(scratch));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    output.Len = 0;
+    reader.Init(buf2, writer.GetLengthWritten());
+
+    err = Json::TLVToJson(reader, context);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(output.Buf, sExpectedJson) == 0);
+
+    // Unicode escapes are decoded to UTF-8
+    {
+        static const char sJson[] = "[\"\\u00e9\\ud83d\\ude00\"]";
+        static const char sExpected[] = "\xC3\xA9\xF0\x9F\x98\x80";
+
+        writer.Init(buf2, sizeof(buf2));
+
+        err = Json::JsonToTLV(sJson, strlen(sJson), writer, context, scratch, sizeof(scratch));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        reader.Init(buf2, writer.GetLengthWritten());
+        TestNext<TLVReader>(inSuite, reader);
+        TestAndEnterContainer<TLVReader>(inSuite, reader, kTLVType_Array, AnonymousTag, outerContainerType);
+        TestNext<TLVReader>(inSuite, reader);
+        TestString(inSuite, reader, AnonymousTag, sExpected);
+        TestEndAndExitContainer<TLVReader>(inSuite, reader, outerContainerType);
+    }
+
+    // Malformed JSON and unknown member names are rejected
+    {
+        static const char *const sBadJson[] = { "{\"1\":}", "[1,]", "{\"1\" 2}", "tru", "\"abc", "{\"foo\":1}" };
+
+        for (size_t i = 0; i < sizeof(sBadJson) / sizeof(sBadJson[0]); i++)
+        {
+            writer.Init(buf2, sizeof(buf2));
+
+            err = Json::JsonToTLV(sBadJson[i], strlen(sBadJson[i]), writer, context, scratch, sizeof(scratch));
+            NL_TEST_ASSERT(inSuite, err != WEAVE_NO_ERROR);
+        }
+    }
+}
+
 /**
  *  Test Weave TLV Empty Find
  */
@@ -2296,6 +2576,102 @@ void CheckCircularTLVBufferEdge(nlTestSuite *inSuite, void *inContext)
     TestEnd<TLVReader>(inSuite, reader);
 
 }
+
+/**
+ *  Reads the byte strings written by CheckCircularTLVBufferAvoidWrap(), verifying that each is
+ *  stored contiguously and that they run consecutively up to @p lastIndex.  Returns the number
+ *  of strings read, or 0 if any string is split across the end of the backing store.
+ */
+static uint32_t ReadContiguousByteStrings(nlTestSuite *inSuite, WeaveCircularTLVBuffer &buffer, uint8_t lastIndex)
+{
+    CircularTLVReader reader;
+    WEAVE_ERROR err;
+    const uint8_t *data;
+    uint8_t index = 0;
+    uint32_t count = 0;
+    bool contiguous = true;
+
+    reader.Init(&buffer);
+
+    while ((err = reader.Next()) == WEAVE_NO_ERROR)
+    {
+        NL_TEST_ASSERT(inSuite, reader.GetType() == kTLVType_ByteString);
+
+        if (reader.GetDataPtr(data) != WEAVE_NO_ERROR)
+        {
+            contiguous = false;
+            continue;
+        }
+
+        NL_TEST_ASSERT(inSuite, count == 0 || data[0] == (uint8_t)(index + 1));
+        index = data[0];
+        for (uint32_t i = 0; i < reader.GetLength(); i++)
+            NL_TEST_ASSERT(inSuite, data[i] == index);
+
+        count++;
+    }
+
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+    NL_TEST_ASSERT(inSuite, !contiguous || index == lastIndex);
+
+    return contiguous ? count : 0;
+}
+
+void CheckCircularTLVBufferAvoidWrap(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    uint8_t backingStore[64];
+    uint8_t value[16];
+    CircularTLVWriter writer;
+    WeaveCircularTLVBuffer buffer(backingStore, sizeof(backingStore));
+    bool sawSplit = false;
+
+    // Without wrap avoidance, variable-length elements end up split across the end of the backing store.
+    writer.Init(&buffer);
+    for (uint8_t i = 1; i <= 40; i++)
+    {
+        memset(value, i, sizeof(value));
+        err = writer.PutBytes(AnonymousTag, value, 5 + (i % 11));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        err = writer.Finalize();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        sawSplit = sawSplit || (ReadContiguousByteStrings(inSuite, buffer, i) == 0);
+    }
+    NL_TEST_ASSERT(inSuite, sawSplit);
+
+    // With wrap avoidance, every element is contiguous, and no more than one element is lost to padding.
+    WeaveCircularTLVBuffer noWrapBuffer(backingStore, sizeof(backingStore));
+    noWrapBuffer.mAvoidElementWrap = true;
+
+    writer.Init(&noWrapBuffer);
+    for (uint8_t i = 1; i <= 40; i++)
+    {
+        memset(value, i, sizeof(value));
+        err = writer.PutBytes(AnonymousTag, value, 5 + (i % 11));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        err = writer.Finalize();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        NL_TEST_ASSERT(inSuite, ReadContiguousByteStrings(inSuite, noWrapBuffer, i) != 0);
+        NL_TEST_ASSERT(inSuite, noWrapBuffer.PaddingLength() < 2 + 16);
+    }
+
+    // Bulk eviction frees at least the requested space, oldest elements first.
+    err = noWrapBuffer.EvictHeadUntilAvailable(40);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, noWrapBuffer.AvailableDataLength() >= 40);
+    NL_TEST_ASSERT(inSuite, ReadContiguousByteStrings(inSuite, noWrapBuffer, 40) != 0);
+
+    err = noWrapBuffer.EvictHeadUntilAvailable(sizeof(backingStore));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, noWrapBuffer.DataLength() == 0);
+    NL_TEST_ASSERT(inSuite, noWrapBuffer.PaddingLength() == 0);
+
+    err = noWrapBuffer.EvictHeadUntilAvailable(sizeof(backingStore) + 1);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+}
+
 void CheckWeaveTLVPutStringF(nlTestSuite *inSuite, void *inContext)
 {
     const size_t bufsize = 24;
@@ -2429,6 +2805,333 @@ void CheckWeaveTLVSkipCircular(nlTestSuite *inSuite, void * inContext)
 
 }
 
+/**
+ *  Test skipping containers, within a single buffer and across buffer boundaries
+ */
+void CheckWeaveTLVSkipContainer(nlTestSuite *inSuite, void * inContext)
+{
+    TLVReader reader;
+    WEAVE_ERROR err;
+
+    // Skipping in a single contiguous buffer
+    reader.Init(Encoding1, sizeof(Encoding1));
+    reader.ImplicitProfileId = TestProfile_2;
+
+    TestNext<TLVReader>(inSuite, reader);
+    TestSkip(inSuite, reader);
+    NL_TEST_ASSERT(inSuite, reader.GetLengthRead() == sizeof(Encoding1));
+    TestEnd<TLVReader>(inSuite, reader);
+
+    // Skipping when the encoding is split at every possible point between two buffers
+    for (uint32_t splitLen = 1; splitLen < sizeof(Encoding1); splitLen++)
+    {
+        PacketBuffer *buf = PacketBuffer::New(0);
+        PacketBuffer *buf2 = PacketBuffer::New(0);
+
+        memcpy(buf->Start(), Encoding1, splitLen);
+        buf->SetDataLength(splitLen);
+        memcpy(buf2->Start(), Encoding1 + splitLen, sizeof(Encoding1) - splitLen);
+        buf2->SetDataLength(sizeof(Encoding1) - splitLen);
+        buf->AddToEnd(buf2);
+
+        reader.Init(buf, 0xFFFFFFFFUL, true);
+        reader.ImplicitProfileId = TestProfile_2;
+
+        TestNext<TLVReader>(inSuite, reader);
+        TestSkip(inSuite, reader);
+        NL_TEST_ASSERT(inSuite, reader.GetLengthRead() == sizeof(Encoding1));
+        TestEnd<TLVReader>(inSuite, reader);
+
+        PacketBuffer::Free(buf);
+    }
+
+    // Malformed elements within a skipped container are still detected
+    {
+        static const uint8_t sContextTagInArray[] =
+        {
+            0x15, 0x36, 0x01, 0x24, 0x02, 0x05, 0x18, 0x18
+        };
+
+        reader.Init(sContextTagInArray, sizeof(sContextTagInArray));
+        TestNext<TLVReader>(inSuite, reader);
+        err = reader.Skip();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_TLV_TAG);
+    }
+
+    {
+        static const uint8_t sStringOverrun[] =
+        {
+            0x15, 0x2C, 0x01, 0x20, 0x61, 0x62, 0x18
+        };
+
+        reader.Init(sStringOverrun, sizeof(sStringOverrun));
+        TestNext<TLVReader>(inSuite, reader);
+        err = reader.Skip();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_TLV_UNDERRUN);
+    }
+
+    {
+        static const uint8_t sMissingEnd[] =
+        {
+            0x15, 0x36, 0x01, 0x04, 0x2A, 0x18
+        };
+
+        reader.Init(sMissingEnd, sizeof(sMissingEnd));
+        TestNext<TLVReader>(inSuite, reader);
+        err = reader.Skip();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_TLV_UNDERRUN || err == WEAVE_END_OF_TLV);
+    }
+}
+
+/**
+ *  Test arena-backed copies and views of string values
+ */
+void CheckWeaveTLVArena(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    uint8_t encoding[64];
+    uint8_t arenaBuf[24];
+    TLVArena arena;
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainerType;
+    uint8_t *bytes;
+    char *str;
+    const uint8_t *data;
+    uint32_t dataLen;
+
+    writer.Init(encoding, sizeof(encoding));
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = writer.PutString(ContextTag(1), "Living Room");
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = writer.PutBytes(ContextTag(2), (const uint8_t *) "0123456789", 10);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = writer.PutString(ContextTag(3), "Kitchen");
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = writer.Put(ContextTag(4), (uint8_t) 42);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    // Copies are allocated consecutively from the arena.
+    arena.Init(arenaBuf, sizeof(arenaBuf));
+    reader.Init(encoding, writer.GetLengthWritten());
+
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.EnterContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.DupString(arena, str);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, strcmp(str, "Living Room") == 0);
+    NL_TEST_ASSERT(inSuite, (uint8_t *) str == arenaBuf);
+    NL_TEST_ASSERT(inSuite, arena.GetUsedLength() == 12);
+
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.DupBytes(arena, bytes, dataLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dataLen == 10 && memcmp(bytes, "0123456789", 10) == 0);
+    NL_TEST_ASSERT(inSuite, bytes == arenaBuf + 12);
+    NL_TEST_ASSERT(inSuite, arena.GetRemainingLength() == 2);
+
+    // A copy that does not fit fails without consuming the arena or the value.
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.DupString(arena, str);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, arena.GetRemainingLength() == 2);
+
+    // A view of a value in a contiguous buffer points into the buffer, and does not use the arena.
+    err = reader.GetDataView(arena, data, dataLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, dataLen == 7 && memcmp(data, "Kitchen", 7) == 0);
+    NL_TEST_ASSERT(inSuite, data > encoding && data < encoding + sizeof(encoding));
+    NL_TEST_ASSERT(inSuite, arena.GetRemainingLength() == 2);
+
+    TestNext<TLVReader>(inSuite, reader);
+    err = reader.DupBytes(arena, bytes, dataLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_WRONG_TLV_TYPE);
+    err = reader.GetDataView(arena, data, dataLen);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_WRONG_TLV_TYPE);
+
+    // Once reset, the arena is reused from the start.
+    arena.Reset();
+    NL_TEST_ASSERT(inSuite, arena.GetRemainingLength() == sizeof(arenaBuf));
+
+    // A view of a value split across buffers is copied into the arena, leaving the reader in place.
+    {
+        const uint32_t encodingLen = writer.GetLengthWritten();
+        const uint32_t splitLen = 22; // falls within the value of the byte string
+        PacketBuffer *buf = PacketBuffer::New(0);
+        PacketBuffer *buf2 = PacketBuffer::New(0);
+
+        memcpy(buf->Start(), encoding, splitLen);
+        buf->SetDataLength(splitLen);
+        memcpy(buf2->Start(), encoding + splitLen, encodingLen - splitLen);
+        buf2->SetDataLength(encodingLen - splitLen);
+        buf->AddToEnd(buf2);
+
+        reader.Init(buf, 0xFFFFFFFFUL, true);
+
+        TestNext<TLVReader>(inSuite, reader);
+        err = reader.EnterContainer(outerContainerType);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        TestNext<TLVReader>(inSuite, reader);
+        TestNext<TLVReader>(inSuite, reader);
+
+        err = reader.GetDataPtr(data);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_TLV_UNDERRUN);
+
+        err = reader.GetDataView(arena, data, dataLen);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, dataLen == 10 && memcmp(data, "0123456789", 10) == 0);
+        NL_TEST_ASSERT(inSuite, data == arenaBuf);
+
+        TestNext<TLVReader>(inSuite, reader);
+        TestDupString(inSuite, reader, ContextTag(3), "Kitchen");
+
+        PacketBuffer::Free(buf);
+    }
+}
+
+/**
+ *  Test writing PacketBuffer-backed values by reference
+ */
+static PacketBuffer *MakeTestValueBuffer(uint8_t fill, uint16_t len)
+{
+    PacketBuffer *buf = PacketBuffer::New(0);
+
+    memset(buf->Start(), fill, len);
+    buf->SetDataLength(len);
+
+    return buf;
+}
+
+static void CheckTestValue(nlTestSuite *inSuite, TLVReader& reader, uint64_t tag, uint8_t fill, uint32_t len)
+{
+    WEAVE_ERROR err;
+    const uint8_t *val;
+    uint8_t *copy;
+
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.GetType() == kTLVType_ByteString);
+    NL_TEST_ASSERT(inSuite, reader.GetTag() == tag);
+    NL_TEST_ASSERT(inSuite, reader.GetLength() == len);
+
+    copy = (uint8_t *)malloc(len);
+    err = reader.GetBytes(copy, len);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    val = copy;
+    while (val < copy + len && *val == fill)
+        val++;
+    NL_TEST_ASSERT(inSuite, val == copy + len);
+
+    free(copy);
+}
+
+void CheckWeaveTLVPutByReference(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    TLVWriter writer;
+    TLVReader reader;
+    TLVType outerContainerType;
+    PacketBuffer *buf = PacketBuffer::New(0);
+    PacketBuffer *smallVal = MakeTestValueBuffer(0x11, 8);
+    PacketBuffer *largeVal = MakeTestValueBuffer(0x22, buf->MaxDataLength() / 2);
+    PacketBuffer *containerVal = PacketBuffer::New(0);
+    uint8_t *p;
+
+    // Two chained buffers, each filling half a buffer, forming a byte string larger than the space
+    // that remains in the output buffer.
+    largeVal->AddToEnd(MakeTestValueBuffer(0x22, buf->MaxDataLength() / 2));
+
+    // A pre-encoded set of container members, including the end-of-container marker.
+    p = containerVal->Start();
+    *p++ = 0x24; *p++ = 0x01; *p++ = 0x2A;
+    *p++ = 0x18;
+    containerVal->SetDataLength(p - containerVal->Start());
+
+    writer.Init(buf, 0xFFFFFFFFUL, true);
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.PutBytes(ContextTag(1), smallVal);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.PutBytes(ContextTag(2), largeVal);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.PutPreEncodedContainer(ContextTag(3), kTLVType_Structure, containerVal);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Put(ContextTag(4), (uint32_t)7);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    // The small value was copied; the large value was linked into the output chain directly after
+    // the first buffer.
+    NL_TEST_ASSERT(inSuite, buf->Next() == largeVal);
+
+    reader.Init(buf, 0xFFFFFFFFUL, true);
+
+    TestNext<TLVReader>(inSuite, reader);
+    TestAndEnterContainer<TLVReader>(inSuite, reader, kTLVType_Structure, AnonymousTag, outerContainerType);
+    {
+        CheckTestValue(inSuite, reader, ContextTag(1), 0x11, 8);
+        CheckTestValue(inSuite, reader, ContextTag(2), 0x22, 2 * (buf->MaxDataLength() / 2));
+
+        TestNext<TLVReader>(inSuite, reader);
+        {
+            TLVType outerContainerType2;
+
+            TestAndEnterContainer<TLVReader>(inSuite, reader, kTLVType_Structure, ContextTag(3), outerContainerType2);
+            TestNext<TLVReader>(inSuite, reader);
+            TestGet<TLVReader, uint8_t>(inSuite, reader, kTLVType_UnsignedInteger, ContextTag(1), 42);
+            TestEndAndExitContainer<TLVReader>(inSuite, reader, outerContainerType2);
+        }
+
+        TestNext<TLVReader>(inSuite, reader);
+        TestGet<TLVReader, uint32_t>(inSuite, reader, kTLVType_UnsignedInteger, ContextTag(4), 7);
+    }
+    TestEndAndExitContainer<TLVReader>(inSuite, reader, outerContainerType);
+    TestEnd<TLVReader>(inSuite, reader);
+
+    PacketBuffer::Free(buf);
+
+    // A writer not writing to a chain of PacketBuffers copies the value.
+    {
+        uint8_t flatBuf[32];
+
+        writer.Init(flatBuf, sizeof(flatBuf));
+
+        err = writer.PutBytes(AnonymousTag, MakeTestValueBuffer(0x33, 20));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = writer.Finalize();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        reader.Init(flatBuf, writer.GetLengthWritten());
+        CheckTestValue(inSuite, reader, AnonymousTag, 0x33, 20);
+        TestEnd<TLVReader>(inSuite, reader);
+
+        writer.Init(flatBuf, sizeof(flatBuf));
+
+        err = writer.PutBytes(AnonymousTag, MakeTestValueBuffer(0x33, sizeof(flatBuf)));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+    }
+}
+
 /**
  *  Test Buffer Overflow
  */
@@ -3302,6 +4005,155 @@ static void CheckWeaveUpdater(nlTestSuite *inSuite, void *inContext)
     WriteDeleteReadTest(inSuite);
 }
 
+/**
+ *  Test Weave TLV Updater in-place editing
+ */
+static void WriteInPlaceTestEncoding(nlTestSuite *inSuite, uint8_t *buf, uint32_t bufLen, uint32_t& encodedLen)
+{
+    WEAVE_ERROR err;
+    TLVWriter writer;
+    TLVType outerContainerType;
+
+    memset(buf, 0xFF, bufLen);
+
+    writer.Init(buf, bufLen);
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Put(ContextTag(1), (uint32_t)100, true);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Put(ContextTag(2), (uint32_t)200, true);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.PutString(ContextTag(3), "in-place");
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    encodedLen = writer.GetLengthWritten();
+}
+
+static void CheckWeaveUpdaterInPlace(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err;
+    uint8_t buf[64];
+    uint32_t encodedLen;
+    uint32_t i;
+    TLVUpdater updater;
+    TLVReader reader;
+    TLVType outerContainerType;
+
+    // Replace a scalar with a value of the same encoded size
+    WriteInPlaceTestEncoding(inSuite, buf, sizeof(buf), encodedLen);
+
+    err = updater.InitInPlace(buf, encodedLen, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, updater.GetRemainingFreeLength() == sizeof(buf) - encodedLen);
+
+    TestNext<TLVUpdater>(inSuite, updater);
+    TestAndEnterContainer<TLVUpdater>(inSuite, updater, kTLVType_Structure, AnonymousTag, outerContainerType);
+    {
+        TestNext<TLVUpdater>(inSuite, updater);
+        TestMove(inSuite, updater);
+
+        TestNext<TLVUpdater>(inSuite, updater);
+        TestGet<TLVUpdater, uint32_t>(inSuite, updater, kTLVType_UnsignedInteger, ContextTag(2), 200);
+
+        // Skip the old value and write the new one in its place
+        TestNext<TLVUpdater>(inSuite, updater);
+
+        err = updater.Put(ContextTag(2), (uint32_t)300, true);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        TestMove(inSuite, updater);
+    }
+    TestEndAndExitContainer<TLVUpdater>(inSuite, updater, outerContainerType);
+
+    updater.MoveUntilEnd();
+
+    err = updater.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, updater.GetLengthWritten() == encodedLen);
+
+    // The free space at the end of the buffer was never touched
+    for (i = encodedLen; i < sizeof(buf) && buf[i] == 0xFF; i++)
+        ;
+    NL_TEST_ASSERT(inSuite, i == sizeof(buf));
+
+    reader.Init(buf, encodedLen);
+    TestNext<TLVReader>(inSuite, reader);
+    TestAndEnterContainer<TLVReader>(inSuite, reader, kTLVType_Structure, AnonymousTag, outerContainerType);
+    {
+        TestNext<TLVReader>(inSuite, reader);
+        TestGet<TLVReader, uint32_t>(inSuite, reader, kTLVType_UnsignedInteger, ContextTag(1), 100);
+        TestNext<TLVReader>(inSuite, reader);
+        TestGet<TLVReader, uint32_t>(inSuite, reader, kTLVType_UnsignedInteger, ContextTag(2), 300);
+        TestNext<TLVReader>(inSuite, reader);
+        TestString(inSuite, reader, ContextTag(3), "in-place");
+    }
+    TestEndAndExitContainer<TLVReader>(inSuite, reader, outerContainerType);
+    TestEnd<TLVReader>(inSuite, reader);
+
+    // Insert several elements at the same position
+    WriteInPlaceTestEncoding(inSuite, buf, sizeof(buf), encodedLen);
+
+    err = updater.InitInPlace(buf, encodedLen, sizeof(buf));
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    TestNext<TLVUpdater>(inSuite, updater);
+    TestAndEnterContainer<TLVUpdater>(inSuite, updater, kTLVType_Structure, AnonymousTag, outerContainerType);
+    {
+        TestNext<TLVUpdater>(inSuite, updater);
+        TestMove(inSuite, updater);
+
+        err = updater.PutBoolean(ContextTag(4), true);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = updater.Put(ContextTag(5), (uint8_t)5);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    updater.MoveUntilEnd();
+
+    err = updater.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, updater.GetLengthWritten() == encodedLen + 5);
+    NL_TEST_ASSERT(inSuite, updater.GetRemainingFreeLength() == sizeof(buf) - encodedLen - 5);
+
+    reader.Init(buf, updater.GetLengthWritten());
+    TestNext<TLVReader>(inSuite, reader);
+    TestAndEnterContainer<TLVReader>(inSuite, reader, kTLVType_Structure, AnonymousTag, outerContainerType);
+    {
+        TestNext<TLVReader>(inSuite, reader);
+        TestGet<TLVReader, uint32_t>(inSuite, reader, kTLVType_UnsignedInteger, ContextTag(1), 100);
+        TestNext<TLVReader>(inSuite, reader);
+        TestGet<TLVReader, bool>(inSuite, reader, kTLVType_Boolean, ContextTag(4), true);
+        TestNext<TLVReader>(inSuite, reader);
+        TestGet<TLVReader, uint8_t>(inSuite, reader, kTLVType_UnsignedInteger, ContextTag(5), 5);
+        TestNext<TLVReader>(inSuite, reader);
+        TestGet<TLVReader, uint32_t>(inSuite, reader, kTLVType_UnsignedInteger, ContextTag(2), 200);
+        TestNext<TLVReader>(inSuite, reader);
+        TestString(inSuite, reader, ContextTag(3), "in-place");
+    }
+    TestEndAndExitContainer<TLVReader>(inSuite, reader, outerContainerType);
+    TestEnd<TLVReader>(inSuite, reader);
+
+    // Insertions beyond the free space in the buffer fail
+    WriteInPlaceTestEncoding(inSuite, buf, sizeof(buf), encodedLen);
+
+    err = updater.InitInPlace(buf, encodedLen, encodedLen + 1);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = updater.Put(AnonymousTag, (uint64_t)1000);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_BUFFER_TOO_SMALL);
+}
+
 /**
  * Test TLV CloseContainer symbol reservations
  */
@@ -3774,12 +4626,19 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Weave TLV Writer",                    CheckWeaveTLVWriter),
     NL_TEST_DEF("Weave TLV Reader",                    CheckWeaveTLVReader),
     NL_TEST_DEF("Weave TLV Utilities",                 CheckWeaveTLVUtilities),
+    NL_TEST_DEF("Weave TLV Index",                     CheckWeaveTLVIndex),
+    NL_TEST_DEF("Weave TLV JSON",                      CheckWeaveTLVJson),
+    NL_TEST_DEF("Weave TLV Arena",                     CheckWeaveTLVArena),
     NL_TEST_DEF("Weave TLV Updater",                   CheckWeaveUpdater),
+    NL_TEST_DEF("Weave TLV Updater In Place",          CheckWeaveUpdaterInPlace),
     NL_TEST_DEF("Weave TLV Empty Find",                CheckWeaveTLVEmptyFind),
+    NL_TEST_DEF("Weave TLV Skip Container",            CheckWeaveTLVSkipContainer),
+    NL_TEST_DEF("Weave TLV Put By Reference",          CheckWeaveTLVPutByReference),
     NL_TEST_DEF("Weave Circular TLV buffer, simple",   CheckCircularTLVBufferSimple),
     NL_TEST_DEF("Weave Circular TLV buffer, mid-buffer start", CheckCircularTLVBufferStartMidway),
     NL_TEST_DEF("Weave Circular TLV buffer, straddle", CheckCircularTLVBufferEvictStraddlingEvent),
     NL_TEST_DEF("Weave Circular TLV buffer, edge",     CheckCircularTLVBufferEdge),
+    NL_TEST_DEF("Weave Circular TLV buffer, avoid wrap", CheckCircularTLVBufferAvoidWrap),
     NL_TEST_DEF("Weave TLV Printf",                    CheckWeaveTLVPutStringF),
     NL_TEST_DEF("Weave TLV Printf, Circular TLV buf",  CheckWeaveTLVPutStringFCircular),
     NL_TEST_DEF("Weave TLV Skip non-contiguous",       CheckWeaveTLVSkipCircular),
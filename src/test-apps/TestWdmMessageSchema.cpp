@@ -0,0 +1,383 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the table-driven WDM message
+ *      decoders and encoders.
+ *
+ */
+
+#include "ToolCommon.h"
+
+#include <nlunit-test.h>
+
+#include <Weave/Core/WeaveCore.h>
+#include <Weave/Core/WeaveTLV.h>
+
+#include <Weave/Profiles/data-management/Current/WdmManagedNamespace.h>
+#include <Weave/Profiles/data-management/DataManagement.h>
+
+using namespace nl;
+using namespace nl::Weave::TLV;
+using namespace nl::Weave::Profiles::DataManagement;
+
+static const uint64_t kTestSubscriptionId = 0x1122334455667788ULL;
+static const uint32_t kTestTimeoutMin     = 30;
+static const uint32_t kTestTimeoutMax     = 120;
+
+struct TestContents
+{
+    uint32_t mPresenceMask;
+    uint8_t mSmall;
+    int16_t mSigned;
+    MessageSchema::Element mAny;
+};
+
+static const MessageSchema::FieldDescriptor sTestFields[] = {
+    WDM_SCHEMA_FIELD(TestContents, mSmall, 1, MessageSchema::kFieldType_UnsignedInteger, MessageSchema::kFieldFlag_Mandatory),
+    WDM_SCHEMA_FIELD(TestContents, mSigned, 2, MessageSchema::kFieldType_SignedInteger, 0),
+    WDM_SCHEMA_FIELD(TestContents, mAny, 3, MessageSchema::kFieldType_Any, 0),
+};
+
+static const MessageSchema::StructDescriptor sTestDescriptor = WDM_SCHEMA_STRUCT(TestContents, sTestFields);
+
+// Writes a Subscribe Request, with an extra element of an unknown tag ahead of the path list
+static uint32_t WriteSubscribeRequest(nlTestSuite * inSuite, uint8_t * aBuf, uint32_t aBufSize, bool aDuplicateTimeout)
+{
+    WEAVE_ERROR err;
+    TLVWriter writer;
+    TLVType outerContainerType, listContainerType;
+
+    writer.Init(aBuf, aBufSize);
+
+    err = writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Put(ContextTag(SubscribeRequest::kCsTag_SubscriptionId), kTestSubscriptionId);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Put(ContextTag(SubscribeRequest::kCsTag_SubscribeTimeOutMin), kTestTimeoutMin);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    if (aDuplicateTimeout)
+    {
+        err = writer.Put(ContextTag(SubscribeRequest::kCsTag_SubscribeTimeOutMin), kTestTimeoutMin);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    err = writer.Put(ContextTag(SubscribeRequest::kCsTag_SubscribeTimeOutMax), kTestTimeoutMax);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.PutBoolean(ContextTag(SubscribeRequest::kCsTag_SubscribeToAllEvents), true);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.PutString(ContextTag(15), "ignored");
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.StartContainer(ContextTag(SubscribeRequest::kCsTag_PathList), kTLVType_Array, listContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        TLVType pathContainerType;
+
+        err = writer.StartContainer(AnonymousTag, kTLVType_Path, pathContainerType);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = writer.Put(ContextTag(1), i);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = writer.EndContainer(pathContainerType);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    err = writer.EndContainer(listContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.EndContainer(outerContainerType);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    return writer.GetLengthWritten();
+}
+
+static void CheckSubscribeRequest(nlTestSuite * inSuite, const SubscribeRequest::Contents & aContents)
+{
+    WEAVE_ERROR err;
+    TLVReader reader;
+    PathList::Parser pathList;
+    uint32_t count = 0;
+
+    NL_TEST_ASSERT(inSuite, aContents.IsPresent(SubscribeRequest::Contents::kField_SubscriptionId));
+    NL_TEST_ASSERT(inSuite, aContents.mSubscriptionId == kTestSubscriptionId);
+    NL_TEST_ASSERT(inSuite, aContents.IsPresent(SubscribeRequest::Contents::kField_SubscribeTimeOutMin));
+    NL_TEST_ASSERT(inSuite, aContents.mSubscribeTimeOutMin == kTestTimeoutMin);
+    NL_TEST_ASSERT(inSuite, aContents.IsPresent(SubscribeRequest::Contents::kField_SubscribeTimeOutMax));
+    NL_TEST_ASSERT(inSuite, aContents.mSubscribeTimeOutMax == kTestTimeoutMax);
+    NL_TEST_ASSERT(inSuite, aContents.IsPresent(SubscribeRequest::Contents::kField_SubscribeToAllEvents));
+    NL_TEST_ASSERT(inSuite, aContents.mSubscribeToAllEvents);
+    NL_TEST_ASSERT(inSuite, !aContents.IsPresent(SubscribeRequest::Contents::kField_LastObservedEventIdList));
+    NL_TEST_ASSERT(inSuite, !aContents.IsPresent(SubscribeRequest::Contents::kField_VersionList));
+    NL_TEST_ASSERT(inSuite, aContents.IsPresent(SubscribeRequest::Contents::kField_PathList));
+
+    err = aContents.mPathList.GetReader(reader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, reader.GetTag() == ContextTag(SubscribeRequest::kCsTag_PathList));
+
+    err = pathList.Init(reader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    while (WEAVE_NO_ERROR == (err = pathList.Next()))
+    {
+        count++;
+    }
+
+    NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+    NL_TEST_ASSERT(inSuite, count == 3);
+}
+
+static void CheckDecodeSubscribeRequest(nlTestSuite * inSuite, void * inContext)
+{
+    WEAVE_ERROR err;
+    uint8_t buf[256];
+    uint8_t buf2[256];
+    TLVReader reader;
+    TLVWriter writer;
+    SubscribeRequest::Parser request;
+    SubscribeRequest::Contents contents;
+    SubscribeRequest::Contents contents2;
+    uint32_t len;
+
+    len = WriteSubscribeRequest(inSuite, buf, sizeof(buf), false);
+
+    reader.Init(buf, len);
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = request.Init(reader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = request.Decode(contents);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    CheckSubscribeRequest(inSuite, contents);
+
+    // Re-encoding the request drops the unknown element and preserves everything else
+    writer.Init(buf2, sizeof(buf2));
+
+    err = MessageSchema::Encode(writer, AnonymousTag, contents);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, writer.GetLengthWritten() < len);
+
+    reader.Init(buf2, writer.GetLengthWritten());
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = request.Init(reader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = request.Decode(contents2);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    CheckSubscribeRequest(inSuite, contents2);
+    NL_TEST_ASSERT(inSuite, contents2.mPathList.mLen == contents.mPathList.mLen);
+    NL_TEST_ASSERT(inSuite, memcmp(contents2.mPathList.mData, contents.mPathList.mData, contents.mPathList.mLen) == 0);
+}
+
+static void CheckDecodeErrors(nlTestSuite * inSuite, void * inContext)
+{
+    WEAVE_ERROR err;
+    uint8_t buf[256];
+    TLVReader reader;
+    TLVWriter writer;
+    TLVType outerContainerType;
+    SubscribeRequest::Parser request;
+    SubscribeRequest::Contents contents;
+    TestContents testContents;
+    uint32_t len;
+
+    // A field may only appear once
+    len = WriteSubscribeRequest(inSuite, buf, sizeof(buf), true);
+
+    reader.Init(buf, len);
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = request.Init(reader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = request.Decode(contents);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_INVALID_TLV_TAG);
+    NL_TEST_ASSERT(inSuite, contents.mPresenceMask == 0);
+
+    // Values must have the expected type and fit their member
+    writer.Init(buf, sizeof(buf));
+    writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    writer.Put(ContextTag(1), static_cast<uint32_t>(0x100));
+    writer.EndContainer(outerContainerType);
+    writer.Finalize();
+
+    reader.Init(buf, writer.GetLengthWritten());
+    reader.Next();
+    reader.EnterContainer(outerContainerType);
+
+    err = MessageSchema::DecodeStructure(reader, sTestDescriptor, &testContents);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_WRONG_TLV_TYPE);
+
+    writer.Init(buf, sizeof(buf));
+    writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    writer.Put(ContextTag(1), static_cast<uint8_t>(7));
+    writer.Put(ContextTag(2), static_cast<uint8_t>(7));
+    writer.EndContainer(outerContainerType);
+    writer.Finalize();
+
+    reader.Init(buf, writer.GetLengthWritten());
+    reader.Next();
+    reader.EnterContainer(outerContainerType);
+
+    err = MessageSchema::DecodeStructure(reader, sTestDescriptor, &testContents);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_WRONG_TLV_TYPE);
+
+    // Mandatory fields must be present
+    writer.Init(buf, sizeof(buf));
+    writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    writer.Put(ContextTag(2), static_cast<int16_t>(-300));
+    writer.PutString(ContextTag(3), "any");
+    writer.EndContainer(outerContainerType);
+    writer.Finalize();
+
+    reader.Init(buf, writer.GetLengthWritten());
+    reader.Next();
+    reader.EnterContainer(outerContainerType);
+
+    err = MessageSchema::DecodeStructure(reader, sTestDescriptor, &testContents);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_ERROR_MISSING_TLV_ELEMENT);
+
+    writer.Init(buf, sizeof(buf));
+    writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    writer.PutString(ContextTag(3), "any");
+    writer.Put(ContextTag(2), static_cast<int16_t>(-300));
+    writer.Put(ContextTag(1), static_cast<uint8_t>(255));
+    writer.EndContainer(outerContainerType);
+    writer.Finalize();
+
+    reader.Init(buf, writer.GetLengthWritten());
+    reader.Next();
+    reader.EnterContainer(outerContainerType);
+
+    err = MessageSchema::DecodeStructure(reader, sTestDescriptor, &testContents);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, testContents.mPresenceMask == 0x7);
+    NL_TEST_ASSERT(inSuite, testContents.mSmall == 255);
+    NL_TEST_ASSERT(inSuite, testContents.mSigned == -300);
+
+    {
+        TLVReader anyReader;
+        char str[8];
+
+        err = testContents.mAny.GetReader(anyReader);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, anyReader.GetType() == kTLVType_UTF8String);
+
+        err = anyReader.GetString(str, sizeof(str));
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, strcmp(str, "any") == 0);
+    }
+}
+
+static void CheckDecodeNotificationRequest(nlTestSuite * inSuite, void * inContext)
+{
+    WEAVE_ERROR err;
+    uint8_t buf[256];
+    TLVReader reader;
+    TLVWriter writer;
+    TLVType outerContainerType, listContainerType;
+    NotificationRequest::Parser notify;
+    NotificationRequest::Contents contents;
+
+    writer.Init(buf, sizeof(buf));
+    writer.StartContainer(AnonymousTag, kTLVType_Structure, outerContainerType);
+    writer.Put(ContextTag(NotificationRequest::kCsTag_SubscriptionId), kTestSubscriptionId);
+    writer.StartContainer(ContextTag(NotificationRequest::kCsTag_DataList), kTLVType_Array, listContainerType);
+    writer.EndContainer(listContainerType);
+    writer.PutBoolean(ContextTag(NotificationRequest::kCsTag_PossibleLossOfEvent), false);
+    writer.Put(ContextTag(NotificationRequest::kCsTag_SystemTimestamp), static_cast<uint64_t>(12345));
+    writer.EndContainer(outerContainerType);
+    err = writer.Finalize();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    reader.Init(buf, writer.GetLengthWritten());
+    err = reader.Next();
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = notify.Init(reader);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    err = notify.Decode(contents);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, contents.mSubscriptionId == kTestSubscriptionId);
+    NL_TEST_ASSERT(inSuite, contents.IsPresent(NotificationRequest::Contents::kField_DataList));
+    NL_TEST_ASSERT(inSuite, contents.IsPresent(NotificationRequest::Contents::kField_PossibleLossOfEvent));
+    NL_TEST_ASSERT(inSuite, !contents.mPossibleLossOfEvent);
+    NL_TEST_ASSERT(inSuite, !contents.IsPresent(NotificationRequest::Contents::kField_UTCTimestamp));
+    NL_TEST_ASSERT(inSuite, contents.mSystemTimestamp == 12345);
+    NL_TEST_ASSERT(inSuite, !contents.IsPresent(NotificationRequest::Contents::kField_EventList));
+
+    {
+        DataList::Parser dataList;
+
+        err = contents.mDataList.GetReader(reader);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = dataList.Init(reader);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+        err = dataList.Next();
+        NL_TEST_ASSERT(inSuite, err == WEAVE_END_OF_TLV);
+    }
+}
+
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Test WDM message schema -- Subscribe Request", CheckDecodeSubscribeRequest),
+    NL_TEST_DEF("Test WDM message schema -- Notification Request", CheckDecodeNotificationRequest),
+    NL_TEST_DEF("Test WDM message schema -- validation", CheckDecodeErrors),
+    NL_TEST_SENTINEL(),
+};
+
+/**
+ *  Main
+ */
+int main(int argc, char * argv[])
+{
+    nlTestSuite theSuite = { "weave-wdm-message-schema", &sTests[0], NULL, NULL };
+
+    // Generate machine-readable, comma-separated value (CSV) output.
+    nl_test_set_output_style(OUTPUT_CSV);
+
+    // Run test suit against one context
+    nlTestRunner(&theSuite, NULL);
+
+    return nlTestRunnerStats(&theSuite);
+}
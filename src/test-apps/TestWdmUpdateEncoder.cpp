@@ -121,6 +121,7 @@ class WdmUpdateEncoderTest {
         void TestOverflowDictionary(nlTestSuite *inSuite, void *inContext);
         void TestOverflowRoot(nlTestSuite *inSuite, void *inContext);
         void TestDataElementTooBig(nlTestSuite *inSuite, void *inContext);
+        void TestPackSmallerDataElement(nlTestSuite *inSuite, void *inContext);
         void TestBadInputs(nlTestSuite *inSuite, void *inContext);
         void TestStoreTooSmall(nlTestSuite *inSuite, void *inContext);
 
@@ -175,6 +176,7 @@ class WdmUpdateEncoderTest {
         void BasicTestBody(nlTestSuite *inSuite);
         void InitEncoderContext(nlTestSuite *inSuite);
         void VerifyDataList(nlTestSuite *inSuite, PacketBuffer *aBuf, size_t aItemToStartFrom = 0);
+        uint16_t MeasureEncodedLength(nlTestSuite *inSuite, const PropertyPathHandle *aPathHandles, size_t aNumPathHandles);
 
 };
 
@@ -865,6 +867,115 @@ void WdmUpdateEncoderTest::TestDataElementTooBig(nlTestSuite *inSuite, void *inC
     }
 }
 
+uint16_t WdmUpdateEncoderTest::MeasureEncodedLength(nlTestSuite *inSuite, const PropertyPathHandle *aPathHandles, size_t aNumPathHandles)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    uint16_t len;
+
+    SetupTest();
+
+    if (mBuf != NULL)
+    {
+        PacketBuffer::Free(mBuf);
+    }
+    mBuf = PacketBuffer::New(0);
+
+    for (size_t i = 0; i < aNumPathHandles; i++)
+    {
+        mTP = { mTraitHandleSet[kTestATraitSink0Index], aPathHandles[i] };
+
+        err = mPathList.AddItem(mTP);
+        NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+    }
+
+    BasicTestBody(inSuite);
+
+    len = mBuf->TotalLength();
+
+    PacketBuffer::Free(mBuf);
+    mBuf = NULL;
+
+    return len;
+}
+
+void WdmUpdateEncoderTest::TestPackSmallerDataElement(nlTestSuite *inSuite, void *inContext)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    const PropertyPathHandle leafA = CreatePropertyPathHandle(TestATrait::kPropertyHandle_TaA);
+    const PropertyPathHandle leafB = CreatePropertyPathHandle(TestATrait::kPropertyHandle_TaB);
+    const PropertyPathHandle structD = CreatePropertyPathHandle(TestATrait::kPropertyHandle_TaD);
+    const PropertyPathHandle leavesAB[] = { leafA, leafB };
+    const PropertyPathHandle leafAStructD[] = { leafA, structD };
+    uint16_t available;
+    uint16_t encodedLeavesLen;
+    uint16_t encodedLeafAndStructLen;
+    TraitPath tp;
+
+    PRINT_TEST_NAME();
+
+    mBuf = PacketBuffer::New(0);
+    available = mBuf->AvailableDataLength();
+    PacketBuffer::Free(mBuf);
+    mBuf = NULL;
+
+    encodedLeavesLen = MeasureEncodedLength(inSuite, leavesAB, ArraySize(leavesAB));
+    encodedLeafAndStructLen = MeasureEncodedLength(inSuite, leafAStructD, ArraySize(leafAStructD));
+
+    NL_TEST_ASSERT(inSuite, encodedLeavesLen < encodedLeafAndStructLen);
+
+    // Encode A, D, B in a payload that fits A and B but not A and D:
+    // B should be packed in place of D, which is left for the next payload.
+
+    SetupTest();
+
+    mTP = { mTraitHandleSet[kTestATraitSink0Index], leafA };
+    err = mPathList.AddItem(mTP);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    mTP.mPropertyPathHandle = structD;
+    err = mPathList.AddItem(mTP);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    mTP.mPropertyPathHandle = leafB;
+    err = mPathList.AddItem(mTP);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    mBuf = PacketBuffer::New(available - encodedLeavesLen);
+    NL_TEST_ASSERT(inSuite, NULL != mBuf);
+
+    InitEncoderContext(inSuite);
+
+    err = mEncoder.EncodeRequest(mContext);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, 2 == mContext.mNumDataElementsAddedToPayload);
+    NL_TEST_ASSERT(inSuite, 2 == mContext.mItemInProgress);
+    NL_TEST_ASSERT(inSuite, 3 == mPathList.GetNumItems());
+
+    mPathList.GetItemAt(1, tp);
+    NL_TEST_ASSERT(inSuite, leafB == tp.mPropertyPathHandle);
+    mPathList.GetItemAt(2, tp);
+    NL_TEST_ASSERT(inSuite, structD == tp.mPropertyPathHandle);
+
+    VerifyDataList(inSuite, mBuf);
+
+    // The second payload carries D
+
+    PacketBuffer::Free(mBuf);
+    mBuf = PacketBuffer::New(0);
+    NL_TEST_ASSERT(inSuite, NULL != mBuf);
+
+    mContext.mBuf = mBuf;
+    mContext.mMaxPayloadSize = mBuf->AvailableDataLength();
+
+    err = mEncoder.EncodeRequest(mContext);
+    NL_TEST_ASSERT(inSuite, err == WEAVE_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, 1 == mContext.mNumDataElementsAddedToPayload);
+    VerifyDataList(inSuite, mBuf, 2);
+    NL_TEST_ASSERT(inSuite, mPathList.GetPathStoreSize() == mContext.mItemInProgress);
+}
+
 void WdmUpdateEncoderTest::TestBadInputs(nlTestSuite *inSuite, void *inContext)
 {
     WEAVE_ERROR err = WEAVE_NO_ERROR;
@@ -1096,6 +1207,11 @@ void WdmUpdateEncoderTest_DataElementTooBig(nlTestSuite *inSuite, void *inContex
     gWdmUpdateEncoderTest.TestDataElementTooBig(inSuite, inContext);
 }
 
+void WdmUpdateEncoderTest_PackSmallerDataElement(nlTestSuite *inSuite, void *inContext)
+{
+    gWdmUpdateEncoderTest.TestPackSmallerDataElement(inSuite, inContext);
+}
+
 void WdmUpdateEncoderTest_BadInputs(nlTestSuite *inSuite, void *inContext)
 {
     gWdmUpdateEncoderTest.TestBadInputs(inSuite, inContext);
@@ -1127,6 +1243,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Encode overflowing dictionary",  WdmUpdateEncoderTest_OverflowDictionary),
     NL_TEST_DEF("Encode overflowing root DE",  WdmUpdateEncoderTest_OverflowRoot),
     NL_TEST_DEF("Fail to encode because DataElement is too big",  WdmUpdateEncoderTest_DataElementTooBig),
+    NL_TEST_DEF("Pack a smaller DataElement in place of one that does not fit",  WdmUpdateEncoderTest_PackSmallerDataElement),
     NL_TEST_DEF("Fail to encode because of bad inputs",  WdmUpdateEncoderTest_BadInputs),
     NL_TEST_DEF("Fail to encode because the path store can't hold private paths",  WdmUpdateEncoderTest_StoreTooSmall),
     NL_TEST_DEF("Remove dictionary items between payloads",  WdmUpdateEncoderTest_RemoveDictionaryItemsBetweenPayloads),
@@ -145,6 +145,50 @@ void WeaveCertTest_X509ToWeave()
     printf("%s passed\n", __FUNCTION__);
 }
 
+void WeaveCertTest_ConversionBenchmark()
+{
+    enum { kIterations = 1000 };
+
+    WEAVE_ERROR err;
+    const uint8_t *weaveCert;
+    size_t weaveCertLen;
+    const uint8_t *x509Cert;
+    size_t x509CertLen;
+    uint8_t outCertBuf[kTestCertBufSize];
+    uint32_t outCertLen;
+    uint64_t start, weaveToX509Usec = 0, x509ToWeaveUsec = 0;
+
+    for (size_t i = 0; i < gNumTestCerts; i++)
+    {
+        int certSelector = gTestCerts[i];
+
+        GetTestCert(certSelector, weaveCert, weaveCertLen);
+        GetTestCert(certSelector | kTestCertLoadFlag_DERForm, x509Cert, x509CertLen);
+
+        start = System::Layer::GetClock_MonotonicHiRes();
+        for (int j = 0; j < kIterations; j++)
+        {
+            err = ConvertWeaveCertToX509Cert(weaveCert, weaveCertLen, outCertBuf, sizeof(outCertBuf), outCertLen);
+            SuccessOrFail(err, "%s Certificate: ConvertWeaveCertToX509Cert() returned error", GetTestCertName(certSelector));
+        }
+        weaveToX509Usec += System::Layer::GetClock_MonotonicHiRes() - start;
+
+        start = System::Layer::GetClock_MonotonicHiRes();
+        for (int j = 0; j < kIterations; j++)
+        {
+            err = ConvertX509CertToWeaveCert(x509Cert, x509CertLen, outCertBuf, sizeof(outCertBuf), outCertLen);
+            SuccessOrFail(err, "%s Certificate: ConvertX509CertToWeaveCert() returned error", GetTestCertName(certSelector));
+        }
+        x509ToWeaveUsec += System::Layer::GetClock_MonotonicHiRes() - start;
+    }
+
+    // Timings are reported rather than checked, since they depend on the host.
+    printf("%s: %u conversions each way: Weave->X509 %" PRIu64 " usec, X509->Weave %" PRIu64 " usec\n", __FUNCTION__,
+           (unsigned)(gNumTestCerts * kIterations), weaveToX509Usec, x509ToWeaveUsec);
+
+    printf("%s passed\n", __FUNCTION__);
+}
+
 void WeaveCertTest_CertValidation()
 {
     WEAVE_ERROR err;
@@ -503,6 +547,98 @@ void WeaveCertTest_CertValidTime()
     printf("%s passed\n", __FUNCTION__);
 }
 
+void WeaveCertTest_CertValidationCache()
+{
+    WEAVE_ERROR err;
+    WeaveCertificateSet certSet;
+    ValidationContext validContext;
+    uint8_t badSig[EncodedECDSASignature::kMaxValueLength];
+    ValidationContext expiryContext;
+
+    ClearCertValidationCache();
+
+    certSet.Init(kStandardCertsCount, kTestCertBufSize);
+
+    LoadStandardCerts(certSet);
+
+    WeaveCertificateData& caCert = certSet.Certs[1];
+    WeaveCertificateData& devCert = certSet.Certs[2];
+
+    memset(&validContext, 0, sizeof(validContext));
+    SetEffectiveTime(validContext, 2016, 5, 3);
+    validContext.RequiredKeyUsages = kKeyUsageFlag_DigitalSignature;
+    validContext.RequiredKeyPurposes = kKeyPurposeFlag_ServerAuth;
+
+    // Validate the chain once, so that the signature of the CA certificate is remembered.
+    err = certSet.ValidateCert(devCert, validContext);
+    VerifyOrFail(err == WEAVE_NO_ERROR, "Unexpected result from ValidateCert()");
+
+    // Corrupt the signature of the CA certificate.  Validation still succeeds, since the signature is not verified again.
+    memset(badSig, 0x5A, sizeof(badSig));
+    memcpy(badSig, caCert.Signature.EC.S, caCert.Signature.EC.SLen);
+    badSig[caCert.Signature.EC.SLen - 1] ^= 0x01;
+    caCert.Signature.EC.S = badSig;
+    err = certSet.ValidateCert(devCert, validContext);
+    VerifyOrFail(err == WEAVE_NO_ERROR, "Unexpected result from ValidateCert() with cached CA certificate");
+
+    // The validity period of a remembered CA certificate is still checked.
+    memset(&expiryContext, 0, sizeof(expiryContext));
+    SetEffectiveTime(expiryContext, 2016, 5, 1);
+    {
+        uint16_t savedNotAfterDate = caCert.NotAfterDate;
+
+        caCert.NotAfterDate = PackedCertTimeToDate(expiryContext.EffectiveTime);
+        err = certSet.ValidateCert(devCert, validContext);
+        VerifyOrFail(err == WEAVE_ERROR_CA_CERT_NOT_FOUND, "Unexpected result from ValidateCert() with expired CA certificate");
+        caCert.NotAfterDate = savedNotAfterDate;
+    }
+
+    // Once the cache is cleared, the corrupted signature is detected.
+    ClearCertValidationCache();
+    err = certSet.ValidateCert(devCert, validContext);
+    VerifyOrFail(err == WEAVE_ERROR_CA_CERT_NOT_FOUND, "Unexpected result from ValidateCert() after clearing cache");
+
+    certSet.Release();
+
+    printf("%s passed\n", __FUNCTION__);
+}
+
+void WeaveCertTest_TruncateCertSet()
+{
+    WEAVE_ERROR err;
+    WeaveCertificateSet certSet;
+    ValidationContext validContext;
+
+    certSet.Init(kStandardCertsCount, kTestCertBufSize);
+
+    LoadTestCert(certSet, kTestCert_Root | kDecodeFlag_IsTrusted);
+    LoadTestCert(certSet, kTestCert_CA   | kDecodeFlag_GenerateTBSHash);
+
+    memset(&validContext, 0, sizeof(validContext));
+    SetEffectiveTime(validContext, 2016, 5, 3);
+
+    // Validate the same device certificate repeatedly against the CA certificates loaded once.
+    for (int i = 0; i < 3; i++)
+    {
+        LoadTestCert(certSet, kTestCert_Dev | kDecodeFlag_GenerateTBSHash);
+        VerifyOrFail(certSet.CertCount == kStandardCertsCount, "Unexpected certificate count");
+
+        err = certSet.ValidateCert(*certSet.LastCert(), validContext);
+        VerifyOrFail(err == WEAVE_NO_ERROR, "Unexpected result from ValidateCert()");
+
+        certSet.Truncate(kStandardCertsCount - 1);
+        VerifyOrFail(certSet.CertCount == kStandardCertsCount - 1, "Unexpected certificate count after Truncate()");
+    }
+
+    // Truncating to a count greater than the number of certificates has no effect.
+    certSet.Truncate(kStandardCertsCount);
+    VerifyOrFail(certSet.CertCount == kStandardCertsCount - 1, "Unexpected certificate count after Truncate()");
+
+    certSet.Release();
+
+    printf("%s passed\n", __FUNCTION__);
+}
+
 void WeaveCertTest_CertUsage()
 {
     WEAVE_ERROR err;
@@ -867,8 +1003,13 @@ int main(int argc, char *argv[])
 {
     WeaveCertTest_WeaveToX509();
     WeaveCertTest_X509ToWeave();
+    WeaveCertTest_ConversionBenchmark();
     WeaveCertTest_CertValidation();
     WeaveCertTest_CertValidTime();
+#if WEAVE_CONFIG_CERT_VALIDATION_CACHE_SIZE > 0
+    WeaveCertTest_CertValidationCache();
+#endif
+    WeaveCertTest_TruncateCertSet();
     WeaveCertTest_CertUsage();
     WeaveCertTest_CertType();
     WeaveCertTest_GenerateOperationalDeviceCert();
@@ -34,6 +34,7 @@
 #endif
 
 #include <inttypes.h>
+#include <stdarg.h>
 #include <stdint.h>
 #include <signal.h>
 #include <sys/types.h>
@@ -46,7 +47,9 @@
 
 #include <SystemLayer/SystemTimer.h>
 #include <SystemLayer/SystemFaultInjection.h>
+#include <SystemLayer/SystemTrace.h>
 #include <Weave/Support/WeaveFaultInjection.h>
+#include <Weave/Support/PerfInstrumentation.h>
 #include <InetLayer/InetFaultInjection.h>
 #include <Weave/Support/crypto/WeaveCrypto.h>
 #include <Weave/Support/crypto/WeaveRNG.h>
@@ -758,8 +761,40 @@ void InitSystemLayer()
 #endif // !WEAVE_SYSTEM_CONFIG_USE_LWIP
 }
 
+#if WEAVE_SYSTEM_CONFIG_TRACING
+static void WriteTraceData(void *aContext, const char *aData, size_t aDataLen)
+{
+    fwrite(aData, 1, aDataLen, static_cast<FILE *>(aContext));
+}
+
+// If the WEAVE_TRACE_FILE environment variable is set, write the trace events recorded during the run to the named
+// file, in the Chrome trace JSON format.
+static void ExportTrace()
+{
+    const char *traceFileName = getenv("WEAVE_TRACE_FILE");
+    FILE *traceFile;
+
+    if (traceFileName == NULL)
+        return;
+
+    traceFile = fopen(traceFileName, "w");
+    if (traceFile == NULL)
+    {
+        printf("Unable to open trace file %s: %s\n", traceFileName, strerror(errno));
+        return;
+    }
+
+    nl::Weave::System::Trace::ExportChromeTraceJSON(WriteTraceData, traceFile);
+    fclose(traceFile);
+}
+#endif // WEAVE_SYSTEM_CONFIG_TRACING
+
 void ShutdownSystemLayer()
 {
+#if WEAVE_SYSTEM_CONFIG_TRACING
+    ExportTrace();
+#endif // WEAVE_SYSTEM_CONFIG_TRACING
+
     SystemLayer.Shutdown();
 
 #if WEAVE_SYSTEM_CONFIG_USE_LWIP
@@ -1327,6 +1362,10 @@ void ShutdownNetwork()
 
 void ShutdownWeaveStack()
 {
+#if WEAVE_CONFIG_PERF_INSTRUMENTATION
+    nl::Weave::PerfInstrumentation::DumpStats();
+#endif // WEAVE_CONFIG_PERF_INSTRUMENTATION
+
     SecurityMgr.Shutdown();
     ExchangeMgr.Shutdown();
     MessageLayer.Shutdown();
@@ -1516,6 +1555,15 @@ void *WeaveBleIOLoop(void *arg)
 }
 #endif /* CONFIG_BLE_PLATFORM_BLUEZ */
 
+static void StatsDumpWriter(const char *aFormat, ...)
+{
+    va_list args;
+
+    va_start(args, aFormat);
+    vprintf(aFormat, args);
+    va_end(args);
+}
+
 void PrintStatsCounters(nl::Weave::System::Stats::count_t *counters, const char *aPrefix)
 {
     size_t i;
@@ -1596,6 +1644,9 @@ bool ProcessStats(nl::Weave::System::Stats::Snapshot &aBefore, nl::Weave::System
         {
             printf("\nHigh watermarks:\n");
             PrintStatsCounters(aAfter.mHighWatermarks, prefix);
+
+            printf("\nResource usage:\n");
+            nl::Weave::System::Stats::Dump(aAfter, StatsDumpWriter);
         }
     }
 
@@ -53,6 +53,7 @@ GroupKeyEncOptions gGroupKeyEncOptions;
 GeneralSecurityOptions gGeneralSecurityOptions;
 ServiceDirClientOptions gServiceDirClientOptions;
 FaultInjectionOptions gFaultInjectionOptions;
+BenchmarkOptions gBenchmarkOptions;
 
 NetworkOptions::NetworkOptions()
 {
@@ -971,6 +972,7 @@ bool FaultInjectionOptions::HandleOption(const char *progName, OptionSet *optSet
             PrintArgError("%s: Invalid string specified for fault injection option: %s\n", progName, arg);
             return false;
         }
+        nl::Weave::System::FaultInjection::SetArmed(true);
         break;
     }
     case kToolCommonOpt_FaultTestIterations:
@@ -985,6 +987,8 @@ bool FaultInjectionOptions::HandleOption(const char *progName, OptionSet *optSet
         break;
     case kToolCommonOpt_PrintFaultCounters:
         PrintFaultCounters = true;
+        // The counters only advance while fault injection is armed.
+        nl::Weave::System::FaultInjection::SetArmed(true);
         break;
     case kToolCommonOpt_ExtraCleanupTime:
         if ((!ParseInt(arg, ExtraCleanupTimeMsec)) || (ExtraCleanupTimeMsec == 0))
@@ -1002,6 +1006,106 @@ bool FaultInjectionOptions::HandleOption(const char *progName, OptionSet *optSet
     return true;
 }
 
+BenchmarkOptions::BenchmarkOptions()
+{
+    static OptionDef optionDefs[] =
+    {
+        { "results",               kArgumentRequired, kToolCommonOpt_BenchmarkResults },
+        { "seed",                  kArgumentRequired, kToolCommonOpt_BenchmarkSeed    },
+        { }
+    };
+    OptionDefs = optionDefs;
+
+    HelpGroupName = "BENCHMARK OPTIONS";
+
+    OptionHelp =
+        "  --results <file>\n"
+        "       Append the results to <file> as comma separated values, one row per\n"
+        "       metric: benchmark,case,metric,value,unit,better. The file is created\n"
+        "       with a header row if it does not exist.\n"
+        "\n"
+        "  --seed <int>\n"
+        "       Seed the random number generator used for simulated loss, reordering\n"
+        "       and retransmission jitter with the given value, so that runs are\n"
+        "       repeatable. Defaults to a random seed.\n"
+        "\n"
+        "";
+
+    // Defaults
+    ResultsFileName = NULL;
+    Seed = 0;
+    SeedSet = false;
+}
+
+bool BenchmarkOptions::HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case kToolCommonOpt_BenchmarkResults:
+        ResultsFileName = arg;
+        break;
+    case kToolCommonOpt_BenchmarkSeed:
+        if (!ParseInt(arg, Seed))
+        {
+            PrintArgError("%s: Invalid value specified for seed: %s\n", progName, arg);
+            return false;
+        }
+        SeedSet = true;
+        break;
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Seed the rand() generator with the value given by --seed, if any.
+ *
+ * InitToolCommon() and InitWeaveStack() both reseed the generator, so benchmarks call this once the stack is
+ * initialized.
+ */
+void BenchmarkOptions::SeedRandom(void) const
+{
+    if (SeedSet)
+        srand(Seed);
+}
+
+/**
+ * Append one result to the file given by --results, if any.
+ *
+ * @param[in]   benchmark       The name of the benchmark, e.g. "tlv".
+ * @param[in]   caseName        The configuration measured, unique within the benchmark.
+ * @param[in]   metric          The name of the quantity measured.
+ * @param[in]   value           The measured value.
+ * @param[in]   unit            The unit of \c value.
+ * @param[in]   higherIsBetter  Whether an increase in \c value is an improvement, e.g. for a throughput, or a
+ *                              regression, e.g. for a latency.
+ */
+void BenchmarkOptions::RecordResult(const char *benchmark, const char *caseName, const char *metric, double value,
+                                    const char *unit, bool higherIsBetter) const
+{
+    FILE *file;
+
+    if (ResultsFileName == NULL)
+        return;
+
+    file = fopen(ResultsFileName, "a");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Unable to open %s\n", ResultsFileName);
+        exit(EXIT_FAILURE);
+    }
+
+    if (ftell(file) == 0)
+        fprintf(file, "benchmark,case,metric,value,unit,better\n");
+
+    fprintf(file, "%s,%s,%s,%.6g,%s,%s\n", benchmark, caseName, metric, value, unit, higherIsBetter ? "higher" : "lower");
+
+    fclose(file);
+}
+
 
 #if WEAVE_CONFIG_ENABLE_DNS_RESOLVER
 
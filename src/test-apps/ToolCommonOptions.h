@@ -100,6 +100,8 @@ enum
     kToolCommonOpt_SecurityTAKE,
     kToolCommonOpt_GeneralSecurityIdleSessionTimeout,
     kToolCommonOpt_GeneralSecuritySessionEstablishmentTimeout,
+    kToolCommonOpt_BenchmarkResults,
+    kToolCommonOpt_BenchmarkSeed,
 };
 
 
@@ -292,6 +294,28 @@ public:
 
 extern FaultInjectionOptions gFaultInjectionOptions;
 
+
+/**
+ * Handler for options that control how benchmarks report their results.
+ */
+class BenchmarkOptions : public OptionSetBase
+{
+public:
+    const char *ResultsFileName;
+    uint32_t Seed;
+    bool SeedSet;
+
+    BenchmarkOptions();
+
+    virtual bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+
+    void SeedRandom(void) const;
+    void RecordResult(const char *benchmark, const char *caseName, const char *metric, double value, const char *unit,
+                      bool higherIsBetter) const;
+};
+
+extern BenchmarkOptions gBenchmarkOptions;
+
 extern bool ParseDNSOptions(const char * progName, const char *argName, const char * arg, uint8_t & dnsOptions);
 
 extern bool ResolveWeaveNetworkOptions(const char * progName, WeaveNodeOptions &weaveOptions, NetworkOptions &networkOptions);
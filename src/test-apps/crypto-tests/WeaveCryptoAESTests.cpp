@@ -22,12 +22,20 @@
  *
  */
 
+#include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 
 #include <nlunit-test.h>
 
 #include <Weave/Support/crypto/AESBlockCipher.h>
 #include <Weave/Support/crypto/CTRMode.h>
+#include <Weave/Support/crypto/CCMMode.h>
+#include <SystemLayer/SystemClock.h>
+
+#if WEAVE_WITH_OPENSSL
+#include <openssl/evp.h>
+#endif
 
 #include "WeaveCryptoTests.h"
 
@@ -185,6 +193,231 @@ static void Check_AES128CTRMode_Test4(nlTestSuite *inSuite, void *inContext)
     aes128CTR.Reset();
 }
 
+static void Check_AES128CTRMode_Test5(nlTestSuite *inSuite, void *inContext)
+{
+    // Messages spanning many blocks, encrypted in various chunk sizes, must match a reference
+    // keystream generated one block at a time. The initial counter is chosen so that the low
+    // order counter bytes carry partway through the message.
+    static uint8_t key[]                = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    static uint8_t ctr[]                = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xff, 0xfb };
+    enum { kMsgLen = 16 * 11 + 7 };
+    uint8_t plainText[kMsgLen];
+    uint8_t expectedCipherText[kMsgLen];
+    uint8_t cipherText[kMsgLen];
+    uint8_t counter[AES128BlockCipherEnc::kBlockLength];
+    uint8_t keyStream[AES128BlockCipherEnc::kBlockLength];
+    AES128BlockCipherEnc aes128BlockEnc;
+
+    for (size_t i = 0; i < kMsgLen; i++)
+        plainText[i] = (uint8_t)(i * 7);
+
+    aes128BlockEnc.SetKey(key);
+    memcpy(counter, ctr, sizeof(counter));
+    for (size_t i = 0; i < kMsgLen; i++)
+    {
+        if (i % AES128BlockCipherEnc::kBlockLength == 0)
+        {
+            aes128BlockEnc.EncryptBlock(counter, keyStream);
+            for (int j = AES128BlockCipherEnc::kBlockLength - 1; j >= 0 && ++counter[j] == 0; j--)
+                ;
+        }
+        expectedCipherText[i] = plainText[i] ^ keyStream[i % AES128BlockCipherEnc::kBlockLength];
+    }
+
+    for (size_t chunkSize = 1; chunkSize <= kMsgLen; chunkSize++)
+    {
+        AES128CTRMode aes128CTR;
+
+        aes128CTR.SetKey(key);
+        aes128CTR.SetCounter(ctr);
+
+        memcpy(cipherText, plainText, kMsgLen);
+        for (size_t chunkStart = 0; chunkStart < kMsgLen; chunkStart += chunkSize)
+        {
+            uint16_t inLen = kMsgLen - chunkStart;
+            if (inLen > chunkSize)
+                inLen = chunkSize;
+
+            // Encrypt in place, as the message layer does.
+            aes128CTR.EncryptData(cipherText + chunkStart, inLen, cipherText + chunkStart);
+        }
+
+        NL_TEST_ASSERT(inSuite, memcmp(cipherText, expectedCipherText, kMsgLen) == 0);
+    }
+}
+
+static void Check_AES128BlockCipher_EncryptBlocks(nlTestSuite *inSuite, void *inContext)
+{
+    static uint8_t key[] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    enum { kMaxBlocks = 9 };
+    uint8_t inBlocks[kMaxBlocks * AES128BlockCipherEnc::kBlockLength];
+    uint8_t outBlocks[kMaxBlocks * AES128BlockCipherEnc::kBlockLength];
+    uint8_t expectedBlock[AES128BlockCipherEnc::kBlockLength];
+    AES128BlockCipherEnc aes128BlockEnc;
+
+    for (size_t i = 0; i < sizeof(inBlocks); i++)
+        inBlocks[i] = (uint8_t)(i * 13);
+
+    aes128BlockEnc.SetKey(key);
+
+    // EncryptBlocks() must agree with EncryptBlock() for any number of blocks, including
+    // counts that are not a multiple of the number processed together.
+    for (size_t numBlocks = 1; numBlocks <= kMaxBlocks; numBlocks++)
+    {
+        memset(outBlocks, 0, sizeof(outBlocks));
+        aes128BlockEnc.EncryptBlocks(inBlocks, outBlocks, numBlocks);
+
+        for (size_t i = 0; i < numBlocks; i++)
+        {
+            aes128BlockEnc.EncryptBlock(inBlocks + i * AES128BlockCipherEnc::kBlockLength, expectedBlock);
+            NL_TEST_ASSERT(inSuite, memcmp(outBlocks + i * AES128BlockCipherEnc::kBlockLength, expectedBlock, sizeof(expectedBlock)) == 0);
+        }
+    }
+}
+
+bool AES128CCMMode_DoTest(const uint8_t *key, const uint8_t *nonce, uint8_t nonceLen, const uint8_t *aad, uint16_t aadLen,
+                          const uint8_t *plainText, uint16_t plainTextLen, const uint8_t *expectedCipherText,
+                          const uint8_t *expectedTag, uint8_t tagLen)
+{
+    uint8_t cipherText[TEXT_BUFFER_LENGHT] = { 0 };
+    uint8_t tag[AES128CCMMode::kMaxTagLength] = { 0 };
+    WEAVE_ERROR err;
+    AES128CCMMode aes128CCM;
+
+    aes128CCM.SetKey(key);
+
+    err = aes128CCM.Encrypt(nonce, nonceLen, aad, aadLen, plainText, plainTextLen, cipherText, tag, tagLen);
+    if (err != WEAVE_NO_ERROR)
+        return false;
+
+    if (memcmp(cipherText, expectedCipherText, plainTextLen) != 0 || memcmp(tag, expectedTag, tagLen) != 0)
+        return false;
+
+    // Decrypt in place, as the message layer does.
+    err = aes128CCM.Decrypt(nonce, nonceLen, aad, aadLen, cipherText, plainTextLen, cipherText, tag, tagLen);
+    if (err != WEAVE_NO_ERROR || memcmp(cipherText, plainText, plainTextLen) != 0)
+        return false;
+
+    // Encrypting and decrypting incrementally, in pieces of any size, must give the same results.
+    static const uint16_t pieceLens[] = { 1, 5, 16, 17, 70 };
+    for (size_t i = 0; i < sizeof(pieceLens) / sizeof(pieceLens[0]); i++)
+    {
+        err = aes128CCM.Begin(nonce, nonceLen, aad, aadLen, plainTextLen, tagLen);
+        if (err != WEAVE_NO_ERROR)
+            return false;
+
+        for (uint16_t offset = 0; offset < plainTextLen; offset += pieceLens[i])
+        {
+            uint16_t len = (plainTextLen - offset < pieceLens[i]) ? plainTextLen - offset : pieceLens[i];
+            aes128CCM.EncryptData(plainText + offset, len, cipherText + offset);
+        }
+
+        aes128CCM.Finish(tag);
+
+        if (memcmp(cipherText, expectedCipherText, plainTextLen) != 0 || memcmp(tag, expectedTag, tagLen) != 0)
+            return false;
+
+        err = aes128CCM.Begin(nonce, nonceLen, aad, aadLen, plainTextLen, tagLen);
+        if (err != WEAVE_NO_ERROR)
+            return false;
+
+        for (uint16_t offset = 0; offset < plainTextLen; offset += pieceLens[i])
+        {
+            uint16_t len = (plainTextLen - offset < pieceLens[i]) ? plainTextLen - offset : pieceLens[i];
+            aes128CCM.DecryptData(cipherText + offset, len, cipherText + offset);
+        }
+
+        err = aes128CCM.FinishDecrypt(tag);
+        if (err != WEAVE_NO_ERROR || memcmp(cipherText, plainText, plainTextLen) != 0)
+            return false;
+    }
+
+    // A modified tag must be rejected.
+    memcpy(cipherText, expectedCipherText, plainTextLen);
+    tag[tagLen - 1] ^= 0x01;
+    err = aes128CCM.Decrypt(nonce, nonceLen, aad, aadLen, cipherText, plainTextLen, cipherText, tag, tagLen);
+    if (err != WEAVE_ERROR_INTEGRITY_CHECK_FAILED)
+        return false;
+
+    return true;
+}
+
+static void Check_AES128CCMMode_Test1(nlTestSuite *inSuite, void *inContext)
+{
+    bool res;
+
+    // This is Example 1 from NIST SP 800-38C, Appendix C.
+    static uint8_t key[]                = { 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f };
+    static uint8_t nonce[]              = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16 };
+    static uint8_t aad[]                = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+    static uint8_t plainText[]          = { 0x20, 0x21, 0x22, 0x23 };
+    static uint8_t expectedCipherText[] = { 0x71, 0x62, 0x01, 0x5b };
+    static uint8_t expectedTag[]        = { 0x4d, 0xac, 0x25, 0x5d };
+
+    res = AES128CCMMode_DoTest(key, nonce, sizeof(nonce), aad, sizeof(aad), plainText, sizeof(plainText),
+                               expectedCipherText, expectedTag, sizeof(expectedTag));
+
+    // Invalid ciphertext or tag generated by AES128CCMMode::Encrypt()
+    NL_TEST_ASSERT(inSuite, res == true);
+}
+
+static void Check_AES128CCMMode_Test2(nlTestSuite *inSuite, void *inContext)
+{
+    bool res;
+
+    // This is Example 2 from NIST SP 800-38C, Appendix C.
+    static uint8_t key[]                = { 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f };
+    static uint8_t nonce[]              = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 };
+    static uint8_t aad[]                = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+    static uint8_t plainText[]          = { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f };
+    static uint8_t expectedCipherText[] = { 0xd2, 0xa1, 0xf0, 0xe0, 0x51, 0xea, 0x5f, 0x62, 0x08, 0x1a, 0x77, 0x92, 0x07, 0x3d, 0x59, 0x3d };
+    static uint8_t expectedTag[]        = { 0x1f, 0xc6, 0x4f, 0xbf, 0xac, 0xcd };
+
+    res = AES128CCMMode_DoTest(key, nonce, sizeof(nonce), aad, sizeof(aad), plainText, sizeof(plainText),
+                               expectedCipherText, expectedTag, sizeof(expectedTag));
+
+    // Invalid ciphertext or tag generated by AES128CCMMode::Encrypt()
+    NL_TEST_ASSERT(inSuite, res == true);
+}
+
+static void Check_AES128CCMMode_Test3(nlTestSuite *inSuite, void *inContext)
+{
+    bool res;
+
+    // This is Packet Vector #1 from RFC-3610.
+    static uint8_t key[]                = { 0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF };
+    static uint8_t nonce[]              = { 0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5 };
+    static uint8_t aad[]                = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 };
+    static uint8_t plainText[]          = { 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+                                            0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E };
+    static uint8_t expectedCipherText[] = { 0x58, 0x8C, 0x97, 0x9A, 0x61, 0xC6, 0x63, 0xD2, 0xF0, 0x66, 0xD0, 0xC2, 0xC0, 0xF9, 0x89, 0x80,
+                                            0x6D, 0x5F, 0x6B, 0x61, 0xDA, 0xC3, 0x84 };
+    static uint8_t expectedTag[]        = { 0x17, 0xE8, 0xD1, 0x2C, 0xFD, 0xF9, 0x26, 0xE0 };
+
+    res = AES128CCMMode_DoTest(key, nonce, sizeof(nonce), aad, sizeof(aad), plainText, sizeof(plainText),
+                               expectedCipherText, expectedTag, sizeof(expectedTag));
+
+    // Invalid ciphertext or tag generated by AES128CCMMode::Encrypt()
+    NL_TEST_ASSERT(inSuite, res == true);
+}
+
+static void Check_AES128CCMMode_InvalidParams(nlTestSuite *inSuite, void *inContext)
+{
+    static uint8_t key[] = { 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f };
+    uint8_t nonce[AES128CCMMode::kMaxNonceLength + 1] = { 0 };
+    uint8_t data[16] = { 0 };
+    uint8_t tag[AES128CCMMode::kMaxTagLength + 2];
+    AES128CCMMode aes128CCM;
+
+    aes128CCM.SetKey(key);
+
+    NL_TEST_ASSERT(inSuite, aes128CCM.Encrypt(nonce, AES128CCMMode::kMinNonceLength - 1, NULL, 0, data, sizeof(data), data, tag, 8) == WEAVE_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, aes128CCM.Encrypt(nonce, AES128CCMMode::kMaxNonceLength + 1, NULL, 0, data, sizeof(data), data, tag, 8) == WEAVE_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, aes128CCM.Encrypt(nonce, 12, NULL, 0, data, sizeof(data), data, tag, 7) == WEAVE_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, aes128CCM.Encrypt(nonce, 12, NULL, 0, data, sizeof(data), data, tag, AES128CCMMode::kMaxTagLength + 2) == WEAVE_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, aes128CCM.Encrypt(nonce, 12, NULL, 0, data, sizeof(data), data, tag, AES128CCMMode::kMaxTagLength) == WEAVE_NO_ERROR);
+}
+
 bool AES256CTRMode_DoTest(const uint8_t *key, const uint8_t *ctr, const uint8_t *plainText, size_t plainTextLen, const uint8_t *expectedCipherText)
 {
     uint8_t cipherText[TEXT_BUFFER_LENGHT] = { 0 };
@@ -407,10 +640,16 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("AES128CTRMode Test2",        Check_AES128CTRMode_Test2),
     NL_TEST_DEF("AES128CTRMode Test3",        Check_AES128CTRMode_Test3),
     NL_TEST_DEF("AES128CTRMode Test4",        Check_AES128CTRMode_Test4),
+    NL_TEST_DEF("AES128CTRMode Test5",        Check_AES128CTRMode_Test5),
+    NL_TEST_DEF("AES128CCMMode Test1",        Check_AES128CCMMode_Test1),
+    NL_TEST_DEF("AES128CCMMode Test2",        Check_AES128CCMMode_Test2),
+    NL_TEST_DEF("AES128CCMMode Test3",        Check_AES128CCMMode_Test3),
+    NL_TEST_DEF("AES128CCMMode InvalidParams", Check_AES128CCMMode_InvalidParams),
     NL_TEST_DEF("AES256CTRMode Test1",        Check_AES256CTRMode_Test1),
     NL_TEST_DEF("AES256CTRMode Test2",        Check_AES256CTRMode_Test2),
     NL_TEST_DEF("AES256CTRMode Test3",        Check_AES256CTRMode_Test3),
     NL_TEST_DEF("AES128BlockCipher Test1",    Check_AES128BlockCipher_Test1),
+    NL_TEST_DEF("AES128BlockCipher EncryptBlocks", Check_AES128BlockCipher_EncryptBlocks),
     NL_TEST_DEF("AES256BlockCipher Test1",    Check_AES256BlockCipher_Test1),
     NL_TEST_SENTINEL()
 };
@@ -428,3 +667,85 @@ int WeaveCryptoAESTests(void)
 
     return nlTestRunnerStats(&theSuite);
 }
+
+#if WEAVE_CONFIG_AES_IMPLEMENTATION_OPENSSL
+#define AES_IMPLEMENTATION_NAME "OpenSSL"
+#elif WEAVE_CONFIG_AES_IMPLEMENTATION_AESNI
+#define AES_IMPLEMENTATION_NAME "AES-NI"
+#elif WEAVE_CONFIG_AES_IMPLEMENTATION_MBEDTLS
+#define AES_IMPLEMENTATION_NAME "mbedTLS"
+#else
+#define AES_IMPLEMENTATION_NAME "platform"
+#endif
+
+static void PrintAESBenchmarkResult(const char *name, size_t msgLen, uint32_t iterations, uint64_t elapsedUS)
+{
+    if (elapsedUS == 0)
+        elapsedUS = 1;
+
+    printf("%-24s %6u %10" PRIu32 " %10" PRIu64 " %10.1f %10.1f\n", name, (unsigned)msgLen, iterations, elapsedUS,
+           (double)msgLen * iterations / elapsedUS, (double)elapsedUS * 1000 / iterations);
+}
+
+/*
+ * Measure the throughput of AES-128-CTR as used for Weave message encryption, for
+ * a range of message sizes, using the AES implementation selected at build time.
+ *
+ * The AES implementation is a build-time choice, so comparing backends means running
+ * this once per build configuration. Where OpenSSL is available, its EVP AES-128-CTR
+ * implementation is also measured as a common reference.
+ */
+int WeaveCryptoAESBenchmark(void)
+{
+    using nl::Weave::System::Platform::Layer::GetClock_MonotonicHiRes;
+
+    static const uint8_t key[] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+    static const size_t msgLens[] = { 16, 64, 256, 1024, 1280 };
+    static uint8_t buf[1280];
+    enum { kTargetBytes = 32 * 1024 * 1024 };
+
+    printf("%-24s %6s %10s %10s %10s %10s\n", "implementation", "bytes", "iterations", "usec", "MB/s", "ns/msg");
+
+    for (size_t i = 0; i < sizeof(msgLens) / sizeof(msgLens[0]); i++)
+    {
+        size_t msgLen = msgLens[i];
+        uint32_t iterations = kTargetBytes / msgLen;
+        AES128CTRMode aes128CTR;
+        uint64_t start;
+
+        // Key once, as the message layer does with cached key schedules, and set the
+        // counter for each message.
+        aes128CTR.SetKey(key);
+
+        start = GetClock_MonotonicHiRes();
+        for (uint32_t n = 0; n < iterations; n++)
+        {
+            aes128CTR.SetWeaveMessageCounter(0x18B4300012345678ULL, n);
+            aes128CTR.EncryptData(buf, msgLen, buf);
+        }
+        PrintAESBenchmarkResult("Weave " AES_IMPLEMENTATION_NAME, msgLen, iterations, GetClock_MonotonicHiRes() - start);
+
+#if WEAVE_WITH_OPENSSL
+        {
+            EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+            uint8_t iv[AES128CTRMode::kCounterLength] = { 0 };
+            int outLen;
+
+            EVP_EncryptInit_ex(ctx, EVP_aes_128_ctr(), NULL, key, iv);
+
+            start = GetClock_MonotonicHiRes();
+            for (uint32_t n = 0; n < iterations; n++)
+            {
+                iv[11] = (uint8_t)n;
+                EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv);
+                EVP_EncryptUpdate(ctx, buf, &outLen, buf, (int)msgLen);
+            }
+            PrintAESBenchmarkResult("OpenSSL EVP", msgLen, iterations, GetClock_MonotonicHiRes() - start);
+
+            EVP_CIPHER_CTX_free(ctx);
+        }
+#endif // WEAVE_WITH_OPENSSL
+    }
+
+    return 0;
+}
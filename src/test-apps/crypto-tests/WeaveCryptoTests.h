@@ -52,4 +52,10 @@ int WeaveCryptoHKDFTests(void);
  */
 int WeaveCryptoAESTests(void);
 
+/*
+ * Benchmark function for AES-CTR message encryption. This is not run as part
+ * of the default set of tests.
+ */
+int WeaveCryptoAESBenchmark(void);
+
 #endif /* WEAVE_CRYPTO_TESTS_H_ */
@@ -0,0 +1,198 @@
+#!/bin/sh
+
+#
+#    Copyright (c) 2019 Google LLC.
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+#    Description:
+#      This script runs the Weave benchmarks with fixed arguments and a
+#      fixed random seed, collects their results in one comma separated
+#      values file and compares the results against a baseline.
+#
+#      A metric regresses when it is worse than its baseline value by more
+#      than the tolerance, in percent, given for it in the baseline.  The
+#      script fails if any metric regresses, or if a metric of the baseline
+#      is missing from the results of a benchmark that was run.  Metrics
+#      that are not in the baseline are reported but do not fail the run.
+#
+#      With --update-baseline, the baseline is replaced by the results,
+#      keeping the tolerance of the metrics already in it and giving new
+#      ones PERF_TOLERANCE.
+#
+#    Environment:
+#      builddir        Directory holding the benchmark programs.  Defaults to
+#                      the current directory.
+#      srcdir          Directory holding the default baseline.  Defaults to
+#                      the directory of this script.
+#      PERF_BASELINE   The baseline.  Defaults to ${srcdir}/perf-baseline.csv.
+#      PERF_RESULTS    Where the results are written.  Defaults to
+#                      ${builddir}/perf-results.csv.
+#      PERF_TOLERANCE  Tolerance, in percent, of metrics added to the
+#                      baseline.  Defaults to 10.
+#      PERF_SEED       Random seed passed to the benchmarks.  Defaults to 1.
+#
+
+builddir="${builddir:-.}"
+srcdir="${srcdir:-`dirname ${0}`}"
+baseline="${PERF_BASELINE:-${srcdir}/perf-baseline.csv}"
+results="${PERF_RESULTS:-${builddir}/perf-results.csv}"
+tolerance="${PERF_TOLERANCE:-10}"
+seed="${PERF_SEED:-1}"
+update=0
+skipped=""
+
+case "${1}" in
+    "")
+        ;;
+    --update-baseline)
+        update=1
+        ;;
+    *)
+        echo "Usage: `basename ${0}` [--update-baseline]" >&2
+        exit 1
+        ;;
+esac
+
+# run_bench <benchmarks> <program> [<args>...]
+#
+# Run a benchmark program, appending its results to the results file.  A
+# program that was not built is skipped, along with the benchmarks it
+# reports.
+run_bench() {
+    benchmarks="${1}"
+    program="${builddir}/${2}"
+    shift 2
+
+    if test ! -x "${program}" ; then
+        echo "SKIP: ${program} not built"
+        skipped="${skipped} ${benchmarks}"
+        return
+    fi
+
+    echo "RUN:  ${program} ${*}"
+
+    "${program}" --seed "${seed}" --results "${results}" "${@}"
+    if test ${?} -ne 0 ; then
+        echo "FAIL: ${program} exited with an error" >&2
+        exit 1
+    fi
+}
+
+rm -f "${results}"
+
+run_bench "message wrmp case" BenchMessaging --messages 20000 --exchanges 1000 --handshakes 50
+run_bench "tlv"               BenchTLV --iterations 10000
+run_bench "event-logging"     BenchEventLogging --events 20000 --fetches 200
+run_bench "wdm"               BenchWDM --cycles 1000
+run_bench "bdx"               BenchBDX --size 262144
+
+if test ! -f "${results}" ; then
+    echo "FAIL: no results in ${results}" >&2
+    exit 1
+fi
+
+if test ${update} -eq 1 ; then
+    tmp="${baseline}.tmp"
+
+    awk -F, -v tolerance="${tolerance}" '
+        # Keep the comments heading the baseline and the tolerance of each metric.
+        FNR == NR {
+            if ($0 ~ /^#/) {
+                print
+            } else if ($1 != "benchmark") {
+                tol[$1 "," $2 "," $3] = $7
+            }
+            next
+        }
+        $1 == "benchmark" {
+            print "benchmark,case,metric,value,unit,better,tolerance"
+            next
+        }
+        {
+            key = $1 "," $2 "," $3
+            print $0 "," ((key in tol) ? tol[key] : tolerance)
+        }
+    ' "${baseline}" "${results}" > "${tmp}" || exit 1
+
+    mv "${tmp}" "${baseline}" || exit 1
+
+    echo "Updated ${baseline}"
+    exit 0
+fi
+
+awk -F, -v skipped="${skipped}" '
+    BEGIN {
+        n = split(skipped, s, " ")
+        for (i = 1; i <= n; i++)
+            skip[s[i]] = 1
+        failed = 0
+    }
+
+    # The baseline: benchmark,case,metric,value,unit,better,tolerance
+    FNR == NR {
+        if ($0 ~ /^#/ || $1 == "benchmark" || NF < 7)
+            next
+        key = $1 "," $2 "," $3
+        base[key] = $4
+        better[key] = $6
+        tol[key] = $7
+        bench[key] = $1
+        next
+    }
+
+    # The results: benchmark,case,metric,value,unit,better
+    $1 == "benchmark" {
+        next
+    }
+
+    {
+        key = $1 "," $2 "," $3
+        seen[key] = 1
+
+        if (!(key in base)) {
+            printf "NEW:  %-60s %12g %s\n", key, $4, $5
+            next
+        }
+
+        change = (base[key] != 0) ? ($4 - base[key]) * 100 / base[key] : 0
+        worse = (better[key] == "higher") ? -change : change
+
+        if (worse > tol[key]) {
+            printf "FAIL: %-60s %12g %s (baseline %g, %+.1f%%, tolerance %g%%)\n", key, $4, $5, base[key], change, tol[key]
+            failed = 1
+        } else {
+            printf "OK:   %-60s %12g %s (baseline %g, %+.1f%%)\n", key, $4, $5, base[key], change
+        }
+    }
+
+    END {
+        for (key in base) {
+            if (!(key in seen) && !(bench[key] in skip)) {
+                printf "FAIL: %-60s missing from the results\n", key
+                failed = 1
+            }
+        }
+        exit failed
+    }
+' "${baseline}" "${results}"
+
+if test ${?} -ne 0 ; then
+    echo "Performance regressions found; results are in ${results}" >&2
+    exit 1
+fi
+
+exit 0
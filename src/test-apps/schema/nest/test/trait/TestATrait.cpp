@@ -112,6 +112,10 @@ const ConstSchemaVersionRange traitVersion = { .mMinVersion = 1, .mMaxVersion =
 // Schema
 //
 
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+TRAIT_SCHEMA_INDEX_DEFINE(sSchemaIndex, sizeof(PropertyMap) / sizeof(PropertyMap[0]));
+#endif
+
 const TraitSchemaEngine TraitSchema = {
     {
         kWeaveProfileId,
@@ -131,6 +135,9 @@ const TraitSchemaEngine TraitSchema = {
 #endif
 #if (TDM_VERSIONING_SUPPORT)
         &traitVersion,
+#endif
+#if (TDM_SCHEMA_INDEX_SUPPORT)
+        &sSchemaIndex,
 #endif
     }
 };
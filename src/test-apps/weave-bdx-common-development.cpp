@@ -31,6 +31,8 @@
 #include <fcntl.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 // This code uses DEVELOPMENT BDX namespace
 
@@ -65,6 +67,13 @@ namespace Profiles {
 namespace WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesignation_Development) {
 
 static BdxAppState mAppStatePool[WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS];
+static BdxFileMapping mFileMappingPool[WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS];
+
+// Amount of a mapped file requested from the kernel ahead of the block being sent.
+enum
+{
+    kBdxReadAheadLength = 256 * 1024
+};
 
 // curled files go here
 char TempFileLocation[FILENAME_MAX] = "/tmp/";
@@ -77,7 +86,7 @@ BdxAppState *NewAppState()
     for (int i = 0; i < WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS; i++)
     {
         appState = &mAppStatePool[i];
-        if (appState->mFile != NULL || !appState->mDone || appState->mBuffer != NULL)
+        if (appState->mFile != NULL || !appState->mDone || appState->mBuffer != NULL || appState->mMapping != NULL)
         {
             continue;
         }
@@ -96,6 +105,75 @@ void ResetAppStates()
         mAppStatePool[i].mFile = NULL;
         mAppStatePool[i].mDone = true;
         mAppStatePool[i].mBuffer = NULL;
+        mAppStatePool[i].mMapping = NULL;
+        mAppStatePool[i].mOffset = 0;
+        mAppStatePool[i].mReadAheadOffset = 0;
+    }
+}
+
+BdxFileMapping *AcquireFileMapping(const char *aPath)
+{
+    BdxFileMapping *mapping = NULL;
+    BdxFileMapping *freeMapping = NULL;
+    struct stat fileStat;
+    void *data;
+    int fd;
+
+    fd = open(aPath, O_RDONLY);
+    VerifyOrExit(fd >= 0, );
+
+    VerifyOrExit(fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0, );
+
+    // Share the mapping of a file that is already being sent.
+    for (int i = 0; i < WEAVE_CONFIG_BDX_MAX_NUM_TRANSFERS; i++)
+    {
+        if (mFileMappingPool[i].mRefCount == 0)
+        {
+            if (freeMapping == NULL)
+            {
+                freeMapping = &mFileMappingPool[i];
+            }
+        }
+        else if (mFileMappingPool[i].mDevice == fileStat.st_dev && mFileMappingPool[i].mInode == fileStat.st_ino &&
+                 mFileMappingPool[i].mLength == static_cast<uint64_t>(fileStat.st_size))
+        {
+            mapping = &mFileMappingPool[i];
+            mapping->mRefCount++;
+            ExitNow();
+        }
+    }
+
+    VerifyOrExit(freeMapping != NULL, );
+
+    data = mmap(NULL, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    VerifyOrExit(data != MAP_FAILED, WeaveLogError(BDX, "Unable to map file %s", aPath));
+
+    // Blocks are sent in order, so let the kernel read ahead aggressively and drop pages behind.
+    posix_madvise(data, fileStat.st_size, POSIX_MADV_SEQUENTIAL);
+
+    mapping = freeMapping;
+    mapping->mDevice = fileStat.st_dev;
+    mapping->mInode = fileStat.st_ino;
+    mapping->mData = static_cast<const uint8_t *>(data);
+    mapping->mLength = fileStat.st_size;
+    mapping->mRefCount = 1;
+
+exit:
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    return mapping;
+}
+
+void ReleaseFileMapping(BdxFileMapping *aMapping)
+{
+    if (aMapping != NULL && aMapping->mRefCount > 0 && --aMapping->mRefCount == 0)
+    {
+        munmap(const_cast<uint8_t *>(aMapping->mData), aMapping->mLength);
+        aMapping->mData = NULL;
+        aMapping->mLength = 0;
     }
 }
 
@@ -318,6 +396,7 @@ uint16_t BdxReceiveInitHandler(BDXTransfer *aXfer, ReceiveInit *aReceiveInit)
     char *tempFileDesignator = NULL;
 #endif
     FILE *targetFile = NULL;
+    BdxFileMapping *mapping = NULL;
 
     BDXHandlers handlers =
     {
@@ -369,24 +448,43 @@ uint16_t BdxReceiveInitHandler(BDXTransfer *aXfer, ReceiveInit *aReceiveInit)
     aXfer->mAppState = mAppState;
 
     // The client already handles Setting transfer mode, max block size, and start sending
-    // We just need to open the file and allocate a buffer for reading blocks
-    targetFile = fopen(fileDesignator, "r");
-    VerifyOrExit(targetFile != NULL,
-                 err = kStatus_UnknownFile;
-                 WeaveLogError(BDX, "Error opening file %s", fileDesignator));
-    // Use fseek/ftell to find the size of the file.
-    fseek(targetFile, 0, SEEK_END);
-    // This will only work for files below 2 GB
-    fileSize = ftell(targetFile);
-    VerifyOrExit(fileSize >= 0, err = kStatus_Unknown);
-    VerifyOrExit(static_cast<uint64_t>(fileSize) >= aReceiveInit->mStartOffset, err = kStatus_StartOffsetNotSupported);
+    // We just need to map the file, or failing that open it and allocate a buffer for reading blocks
+    mapping = AcquireFileMapping(fileDesignator);
+    if (mapping != NULL)
+    {
+        fileSize = mapping->mLength;
+        VerifyOrExit(static_cast<uint64_t>(fileSize) >= aReceiveInit->mStartOffset, err = kStatus_StartOffsetNotSupported);
+
+        mAppState->mMapping = mapping;
+        mAppState->mOffset = aReceiveInit->mStartOffset;
+        mAppState->mReadAheadOffset = aReceiveInit->mStartOffset;
 
-    retval = fseek(targetFile, aReceiveInit->mStartOffset, SEEK_SET);
-    VerifyOrExit(retval == 0, err = kStatus_StartOffsetNotSupported);
+        mapping = NULL;
+    }
+    else
+    {
+        targetFile = fopen(fileDesignator, "r");
+        VerifyOrExit(targetFile != NULL,
+                     err = kStatus_UnknownFile;
+                     WeaveLogError(BDX, "Error opening file %s", fileDesignator));
+        // Use fseek/ftell to find the size of the file.
+        fseek(targetFile, 0, SEEK_END);
+        // This will only work for files below 2 GB
+        fileSize = ftell(targetFile);
+        VerifyOrExit(fileSize >= 0, err = kStatus_Unknown);
+        VerifyOrExit(static_cast<uint64_t>(fileSize) >= aReceiveInit->mStartOffset, err = kStatus_StartOffsetNotSupported);
+
+        retval = fseek(targetFile, aReceiveInit->mStartOffset, SEEK_SET);
+        VerifyOrExit(retval == 0, err = kStatus_StartOffsetNotSupported);
+
+        mAppState->mFile = targetFile;
 
-    mAppState->mFile = targetFile;
+        targetFile = NULL;
 
-    targetFile = NULL;
+        //TODO: shouldn't be using dynamic memory allocation, but how to do that with dynamically negotiated maxBlockSize???
+        //perhaps just go ahead and allocate our maximum size since we know the transfer won't go above that?
+        mAppState->mBuffer = (uint8_t *)malloc(aReceiveInit->mMaxBlockSize);
+    }
 
     if (aReceiveInit->mLength == 0)
     {
@@ -397,10 +495,6 @@ uint16_t BdxReceiveInitHandler(BDXTransfer *aXfer, ReceiveInit *aReceiveInit)
         aXfer->mLength = (aReceiveInit->mLength + aReceiveInit->mStartOffset > static_cast<uint64_t>(fileSize)) ? (fileSize - aReceiveInit->mStartOffset) : (aReceiveInit->mLength);
     }
 
-    //TODO: shouldn't be using dynamic memory allocation, but how to do that with dynamically negotiated maxBlockSize???
-    //perhaps just go ahead and allocate our maximum size since we know the transfer won't go above that?
-    mAppState->mBuffer = (uint8_t *)malloc(aReceiveInit->mMaxBlockSize);
-
     // All seems good, so accept the transfer and set the handlers
     aXfer->mIsAccepted = true;
     aXfer->mTransferMode = aReceiveInit->mReceiverDriveSupported ? kMode_ReceiverDrive : kMode_SenderDrive;
@@ -418,6 +512,8 @@ exit:
         targetFile = NULL;
     }
 
+    ReleaseFileMapping(mapping);
+
     return err;
 }
 
@@ -433,7 +529,15 @@ WEAVE_ERROR BdxSendAcceptHandler(BDXTransfer *aXfer, SendAccept *aSendAcceptMsg)
     WEAVE_ERROR error = WEAVE_NO_ERROR;
 
     // The client already handles Setting transfer mode, max block size, and start sending
-    // We just need to open the file and allocate a buffer for reading blocks
+    // We just need to map the file, or failing that open it and allocate a buffer for reading blocks
+    bdxState->mMapping = AcquireFileMapping(aXfer->mFileDesignator.theString);
+    if (bdxState->mMapping != NULL)
+    {
+        bdxState->mOffset = 0;
+        bdxState->mReadAheadOffset = 0;
+        return error;
+    }
+
     bdxState->mFile = fopen(aXfer->mFileDesignator.theString, "r");
     if (!bdxState->mFile)
     {
@@ -509,6 +613,9 @@ void BdxRejectHandler(BDXTransfer *aXfer, StatusReport *aReport)
 /** Example implementation of a GetBlockHandler that reads a block from the associated
  * open file handle, stores it in the AppState's buffer, and sets the parameters as
  * appropriate so the protocol can handle the block.
+ *
+ * If the file is mapped, the block is instead handed to the protocol in place, so its
+ * only copy is the one into the outgoing message buffer.
  */
 void BdxGetBlockHandler(BDXTransfer *aXfer,
                         uint64_t *aLength,
@@ -527,8 +634,37 @@ void BdxGetBlockHandler(BDXTransfer *aXfer,
         blockSize = aXfer->mMaxBlockSize;
     }
 
-    *aLength = fread(bdxState->mBuffer, 1, blockSize, bdxState->mFile);
-    *aDataBlock = bdxState->mBuffer;
+    if (bdxState->mMapping != NULL)
+    {
+        const BdxFileMapping *mapping = bdxState->mMapping;
+        uint64_t remaining = mapping->mLength - bdxState->mOffset;
+
+        *aLength = (blockSize < remaining) ? blockSize : remaining;
+        *aDataBlock = const_cast<uint8_t *>(mapping->mData + bdxState->mOffset);
+        bdxState->mOffset += *aLength;
+
+        // Keep the kernel reading ahead of the blocks being sent.
+        if (bdxState->mOffset + blockSize > bdxState->mReadAheadOffset && bdxState->mReadAheadOffset < mapping->mLength)
+        {
+            uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            uint64_t start = bdxState->mOffset & ~(pageSize - 1);
+            uint64_t end = bdxState->mOffset + kBdxReadAheadLength;
+
+            if (end > mapping->mLength)
+            {
+                end = mapping->mLength;
+            }
+
+            posix_madvise(const_cast<uint8_t *>(mapping->mData + start), end - start, POSIX_MADV_WILLNEED);
+            bdxState->mReadAheadOffset = end;
+        }
+    }
+    else
+    {
+        *aLength = fread(bdxState->mBuffer, 1, blockSize, bdxState->mFile);
+        *aDataBlock = bdxState->mBuffer;
+    }
+
     aXfer->mBytesSent += blockSize;
 
     *aIsLastBlock = (*aLength < aXfer->mMaxBlockSize) ? true : false;
@@ -582,6 +718,9 @@ void BdxXferErrorHandler(BDXTransfer *aXfer, StatusReport *aXferError)
 
     appState->mBuffer = NULL;
 
+    ReleaseFileMapping(appState->mMapping);
+    appState->mMapping = NULL;
+
     aXfer->Shutdown();
 }
 
@@ -612,6 +751,9 @@ void BdxXferDoneHandler(BDXTransfer *aXfer)
 
     appState->mBuffer = NULL;
 
+    ReleaseFileMapping(appState->mMapping);
+    appState->mMapping = NULL;
+
     aXfer->Shutdown();
 }
 
@@ -639,6 +781,8 @@ void BdxErrorHandler(BDXTransfer *aXfer, WEAVE_ERROR aErrorCode)
         appState->mBuffer = NULL;
     }
 
+    ReleaseFileMapping(appState->mMapping);
+    appState->mMapping = NULL;
 
     aXfer->Shutdown();
 }
@@ -29,6 +29,7 @@
 #define _WEAVE_BDX_COMMON_H_
 
 #include <stdio.h>
+#include <sys/types.h>
 
 #include <Weave/Profiles/bulk-data-transfer/Development/BulkDataTransfer.h>
 
@@ -40,6 +41,17 @@ namespace Weave {
 namespace Profiles {
 namespace WeaveMakeManagedNamespaceIdentifier(BDX, kWeaveManagedNamespaceDesignation_Development) {
 
+// Read-only mapping of a file being sent.  A single mapping of a given file is shared,
+// through the page cache, by all of the transfers currently sending that file.
+struct BdxFileMapping
+{
+    dev_t mDevice;
+    ino_t mInode;
+    const uint8_t *mData;
+    uint64_t mLength;
+    uint32_t mRefCount;
+};
+
 // AppState object for holding application-specific info that is passed around to handlers
 // This object is attached to a BDXTransfer via its mAppState member.
 struct BdxAppState
@@ -47,6 +59,9 @@ struct BdxAppState
     FILE *mFile;
     bool mDone;
     uint8_t *mBuffer; // buffer to store read blocks
+    BdxFileMapping *mMapping; // mapping blocks are sent from, in place of mFile and mBuffer
+    uint64_t mOffset; // offset of the next block to send from mMapping
+    uint64_t mReadAheadOffset; // end of the range of mMapping requested from the kernel
 };
 
 // Returns a reference to a static BdxAppState so that handlers can grab one
@@ -61,6 +76,12 @@ void SetTempLocation(const char *path);
 // Helper functions
 size_t WriteData(void *aPtr, size_t aSize, size_t aNmemb, FILE *aStream);
 size_t ReadData(char *aPtr, size_t aSize, size_t aNemb, FILE *aStream);
+/** Returns a read-only mapping of the given file, sharing an existing mapping if the
+ * file is already being sent, or NULL if the file can't be mapped (in which case the
+ * caller should fall back to reading it with the FILE API).  Each successful call must
+ * be balanced with a call to ReleaseFileMapping(). */
+BdxFileMapping *AcquireFileMapping(const char *aPath);
+void ReleaseFileMapping(BdxFileMapping *aMapping);
 /** This function curls the given file (so it must be a URI, use file:// for local files),
  * saves it in TempFileLocation, modifies aFileDesignator to point to the newly saved
  * copy, and returns a status code indicating whether the curl was successful. */
@@ -0,0 +1,960 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a command line tool, weave-echo-load, that
+ *      generates load on a Weave node using the Weave Echo Profile and
+ *      measures the latency of the responses.
+ *
+ *      Unlike weave-ping, which sends one Echo Request at a time, the tool
+ *      keeps a configurable number of Echo exchanges in flight over a single
+ *      binding, optionally paced to a target request rate, and reports
+ *      latency percentiles.  Any node running an Echo server, such as
+ *      weave-ping --listen, can be the target.
+ *
+ */
+
+#define __STDC_FORMAT_MACROS
+#define __STDC_LIMIT_MACROS
+
+#include <inttypes.h>
+#include <limits.h>
+
+#include "ToolCommon.h"
+#include <Weave/WeaveVersion.h>
+#include <Weave/Core/WeaveBinding.h>
+#include <Weave/Profiles/echo/WeaveEcho.h>
+#include <Weave/Support/RandUtils.h>
+#include <Weave/Support/TimeUtils.h>
+
+#define TOOL_NAME "weave-echo-load"
+
+/**
+ * Records latencies in a fixed-size, log-linear histogram, in the manner of HdrHistogram.
+ *
+ * Values below 2 * kSubBucketCount are recorded exactly; above that, values are recorded with
+ * kSubBucketBits significant bits, i.e. to within 1/kSubBucketCount (about 3%) of their value.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram(void) { Reset(); }
+
+    void Reset(void);
+    void Record(uint64_t value);
+
+    uint64_t Count(void) const { return mCount; }
+    uint64_t Min(void) const { return (mCount != 0) ? mMin : 0; }
+    uint64_t Max(void) const { return mMax; }
+    uint64_t Mean(void) const { return (mCount != 0) ? mSum / mCount : 0; }
+    uint64_t ValueAtPercentile(double percentile) const;
+
+private:
+    enum
+    {
+        kSubBucketBits      = 5,
+        kSubBucketCount     = 1 << kSubBucketBits,
+        kMaxValueBits       = 40,
+        kBucketCount        = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount,
+    };
+
+    static uint32_t IndexOf(uint64_t value);
+    static uint64_t HighestValueAt(uint32_t index);
+
+    uint32_t mCounts[kBucketCount];
+    uint64_t mCount;
+    uint64_t mSum;
+    uint64_t mMin;
+    uint64_t mMax;
+};
+
+/**
+ * State of one of the concurrent Echo exchanges.
+ */
+struct EchoSlot
+{
+    ExchangeContext *EC;
+    uint64_t IntendedSendTime;
+};
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+static bool HandleNonOptionArgs(const char *progName, int argc, char *argv[]);
+static bool ParseDestAddress(const char *progName, const char *arg);
+static bool ParseLength(const char *progName, const char *arg);
+static void BindingEventHandler(void *appState, Binding::EventType eventType, const Binding::InEventParam& inParam, Binding::OutEventParam& outParam);
+static void StartLoad(void);
+static void FinishLoad(void);
+static void DriveSending(void);
+static void HandleSendTimer(System::Layer *systemLayer, void *appState, System::Error err);
+static void HandleReportTimer(System::Layer *systemLayer, void *appState, System::Error err);
+static WEAVE_ERROR SendEchoRequest(EchoSlot *slot, uint64_t intendedSendTime);
+static void CompleteEchoRequest(EchoSlot *slot, WEAVE_ERROR err);
+static void HandleEchoResponse(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer *payload);
+static void HandleResponseTimeout(ExchangeContext *ec);
+static void HandleKeyError(ExchangeContext *ec, WEAVE_ERROR keyErr);
+static void HandleConnectionClosed(ExchangeContext *ec, WeaveConnection *con, WEAVE_ERROR conErr);
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+static void HandleSendError(ExchangeContext *ec, WEAVE_ERROR sendErr, void *msgCtxt);
+#endif
+static void PrintReport(const char *label, const LatencyHistogram& histogram, uint64_t completed, uint64_t failed, uint64_t elapsedUS);
+
+static uint32_t Concurrency = 1;
+static uint32_t TargetRate = 0;
+static uint64_t MaxRequestCount = UINT64_MAX;
+static uint32_t Duration = 0;
+static uint32_t MinLength = 0;
+static uint32_t MaxLength = 0;
+static uint32_t ResponseTimeout = 5000;
+static uint32_t ReportInterval = 1;
+static bool UseTCP = true;
+static bool UseWRMP = false;
+static uint64_t DestNodeId;
+static const char *DestAddr = NULL;
+static IPAddress DestIPAddr;
+static uint16_t DestPort;
+static InterfaceId DestIntf = INET_NULL_INTERFACEID;
+
+static Binding *EchoBinding = NULL;
+static EchoSlot *Slots = NULL;
+static EchoSlot **FreeSlots = NULL;
+static uint32_t FreeSlotCount = 0;
+static bool Sending = false;
+static uint64_t StartTime;
+static uint64_t EndTime;
+static uint64_t LastReportTime;
+static uint64_t RequestsSent = 0;
+static uint64_t RequestsCompleted = 0;
+static uint64_t RequestsFailed = 0;
+static uint64_t RequestsTimedOut = 0;
+static uint64_t IntervalCompleted = 0;
+static uint64_t IntervalFailed = 0;
+static uint64_t SendDelayedCount = 0;
+static uint64_t BytesSent = 0;
+static LatencyHistogram TotalLatency;
+static LatencyHistogram IntervalLatency;
+
+static OptionDef gToolOptionDefs[] =
+{
+    { "dest-addr",       kArgumentRequired, 'D' },
+    { "concurrency",     kArgumentRequired, 'C' },
+    { "rate",            kArgumentRequired, 'r' },
+    { "count",           kArgumentRequired, 'c' },
+    { "duration",        kArgumentRequired, 'd' },
+    { "length",          kArgumentRequired, 'l' },
+    { "timeout",         kArgumentRequired, 'T' },
+    { "report-interval", kArgumentRequired, 'R' },
+    { "tcp",             kNoArgument,       't' },
+    { "udp",             kNoArgument,       'u' },
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    { "wrmp",            kNoArgument,       'w' },
+#endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    { }
+};
+
+static const char *const gToolOptionHelp =
+    "  -D, --dest-addr <host>[:<port>][%<interface>]\n"
+    "       Send Echo Requests to a specific address rather than one\n"
+    "       derived from the destination node id. <host> can be a hostname,\n"
+    "       an IPv4 address or an IPv6 address. If <port> is specified, Echo\n"
+    "       requests will be sent to the specified port. If <interface> is\n"
+    "       specified, Echo Requests will be sent over the specified local\n"
+    "       interface.\n"
+    "\n"
+    "       NOTE: When specifying a port with an IPv6 address, the IPv6 address\n"
+    "       must be enclosed in brackets, e.g. [fd00:0:1:1::1]:11095.\n"
+    "\n"
+    "  -C, --concurrency <num>\n"
+    "       Keep up to the specified number of Echo exchanges in flight.  Limited\n"
+    "       by the size of the exchange context pool (WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS).\n"
+    "       Defaults to 1.\n"
+    "\n"
+    "  -r, --rate <num>\n"
+    "       Send Echo Requests at the specified rate, in requests per second.  When\n"
+    "       all exchanges are in flight at the time a request is due, the request is\n"
+    "       sent as soon as an exchange completes, and its latency is measured from\n"
+    "       the time it was due.  Defaults to 0, which sends a new request as soon\n"
+    "       as an exchange completes.\n"
+    "\n"
+    "  -c, --count <num>\n"
+    "       Send the specified number of Echo Requests and exit.\n"
+    "\n"
+    "  -d, --duration <sec>\n"
+    "       Send Echo Requests for the specified number of seconds and exit.\n"
+    "\n"
+    "  -l, --length <num>[-<max>]\n"
+    "       Send Echo Requests with the specified number of bytes in the payload.\n"
+    "       If a range is given, the length of each payload is chosen uniformly\n"
+    "       from the range.  Defaults to 0.\n"
+    "\n"
+    "  -T, --timeout <ms>\n"
+    "       Fail Echo exchanges that receive no response within the specified\n"
+    "       time in milliseconds.  Defaults to 5000.\n"
+    "\n"
+    "  -R, --report-interval <sec>\n"
+    "       Print the throughput and latency at the specified interval in seconds.\n"
+    "       Defaults to 1.  0 disables interval reports.\n"
+    "\n"
+    "  -t, --tcp\n"
+    "       Use TCP to send Echo Requests. This is the default.\n"
+    "\n"
+    "  -u, --udp\n"
+    "       Use UDP to send Echo Requests.\n"
+    "\n"
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    "  -w, --wrmp\n"
+    "       Use UDP with Weave reliable messaging to send Echo requests.\n"
+    "\n"
+#endif
+    ;
+
+static OptionSet gToolOptions =
+{
+    HandleOption,
+    gToolOptionDefs,
+    "GENERAL OPTIONS",
+    gToolOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    TOOL_NAME,
+    "Usage: " TOOL_NAME " [<options...>] <dest-node-id>[@<dest-host>[:<dest-port>][%<interface>]]\n",
+    WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+    "Generate Weave Echo profile load on a node and measure the latency of its responses.\n"
+    "\n"
+    "The supported security modes are none, CASE, shared CASE and group key encryption.\n"
+);
+
+static OptionSet *gToolOptionSets[] =
+{
+    &gToolOptions,
+    &gNetworkOptions,
+    &gWeaveNodeOptions,
+    &gWRMPOptions,
+    &gWeaveSecurityMode,
+    &gCASEOptions,
+    &gGroupKeyEncOptions,
+    &gDeviceDescOptions,
+    &gHelpOptions,
+    NULL
+};
+
+int main(int argc, char *argv[])
+{
+    WEAVE_ERROR err;
+
+    InitToolCommon();
+
+    SetSignalHandler(DoneOnHandleSIGUSR1);
+
+    if (argc == 1)
+    {
+        gHelpOptions.PrintBriefUsage(stderr);
+        exit(EXIT_FAILURE);
+    }
+
+    if (!ParseArgsFromEnvVar(TOOL_NAME, TOOL_OPTIONS_ENV_VAR_NAME, gToolOptionSets, NULL, true) ||
+        !ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets, HandleNonOptionArgs) ||
+        !ResolveWeaveNetworkOptions(TOOL_NAME, gWeaveNodeOptions, gNetworkOptions))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    switch (gWeaveSecurityMode.SecurityMode)
+    {
+    case WeaveSecurityMode::kNone:
+    case WeaveSecurityMode::kCASE:
+    case WeaveSecurityMode::kCASEShared:
+        break;
+    case WeaveSecurityMode::kGroupEnc:
+        if (gGroupKeyEncOptions.GetEncKeyId() == WeaveKeyId::kNone)
+        {
+            PrintArgError("%s: Please specify a group encryption key id using the --group-enc-... options.\n", TOOL_NAME);
+            exit(EXIT_FAILURE);
+        }
+        break;
+    default:
+        PrintArgError("%s: Unsupported security mode specified\n", TOOL_NAME);
+        exit(EXIT_FAILURE);
+    }
+
+    if (Concurrency > WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS)
+    {
+        PrintArgError("%s: Concurrency exceeds the size of the exchange context pool (%d)\n", TOOL_NAME, WEAVE_CONFIG_MAX_EXCHANGE_CONTEXTS);
+        exit(EXIT_FAILURE);
+    }
+
+    InitSystemLayer();
+
+    InitNetwork();
+
+    InitWeaveStack(false, true);
+
+    PrintNodeConfig();
+
+    Slots = new EchoSlot[Concurrency];
+    FreeSlots = new EchoSlot *[Concurrency];
+    for (uint32_t i = 0; i < Concurrency; i++)
+    {
+        Slots[i].EC = NULL;
+        FreeSlots[FreeSlotCount++] = &Slots[i];
+    }
+
+    // Create and prepare the binding shared by all the Echo exchanges.  The load starts once the
+    // binding is ready.
+    EchoBinding = ExchangeMgr.NewBinding(BindingEventHandler, NULL);
+    if (EchoBinding == NULL)
+    {
+        printf("ExchangeMgr.NewBinding failed\n");
+        exit(EXIT_FAILURE);
+    }
+
+    err = EchoBinding->RequestPrepare();
+    if (err != WEAVE_NO_ERROR)
+    {
+        printf("Binding prepare failed: %s\n", ErrorStr(err));
+        exit(EXIT_FAILURE);
+    }
+
+    ServiceNetworkUntil(&Done, NULL);
+
+    FinishLoad();
+
+    for (uint32_t i = 0; i < Concurrency; i++)
+    {
+        if (Slots[i].EC != NULL)
+        {
+            Slots[i].EC->Abort();
+            Slots[i].EC = NULL;
+        }
+    }
+
+    EchoBinding->Release();
+
+    delete[] FreeSlots;
+    delete[] Slots;
+
+    ShutdownWeaveStack();
+    ShutdownNetwork();
+    ShutdownSystemLayer();
+
+    return (RequestsCompleted != 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void BindingEventHandler(void *appState, Binding::EventType eventType, const Binding::InEventParam& inParam, Binding::OutEventParam& outParam)
+{
+    switch (eventType)
+    {
+    case Binding::kEvent_PrepareRequested:
+    {
+        Binding::Configuration bindingConfig = inParam.Source->BeginConfiguration();
+
+        bindingConfig.Target_NodeId(DestNodeId);
+
+        if (DestAddr != NULL)
+            bindingConfig.TargetAddress_IP(DestIPAddr, DestPort, DestIntf);
+
+        if (UseTCP)
+            bindingConfig.Transport_TCP();
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+        else if (UseWRMP)
+        {
+            bindingConfig.Transport_UDP_WRM();
+            bindingConfig.Transport_DefaultWRMPConfig(gWRMPOptions.GetWRMPConfig());
+        }
+#endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+        else
+            bindingConfig.Transport_UDP();
+
+        switch (gWeaveSecurityMode.SecurityMode)
+        {
+        case WeaveSecurityMode::kNone:
+        default:
+            bindingConfig.Security_None();
+            break;
+        case WeaveSecurityMode::kCASE:
+            bindingConfig.Security_CASESession();
+            break;
+        case WeaveSecurityMode::kCASEShared:
+            bindingConfig.Security_SharedCASESession();
+            break;
+        case WeaveSecurityMode::kGroupEnc:
+            bindingConfig.Security_Key(gGroupKeyEncOptions.GetEncKeyId());
+            break;
+        }
+
+        bindingConfig.Exchange_ResponseTimeoutMsec(ResponseTimeout);
+
+        outParam.PrepareRequested.PrepareError = bindingConfig.PrepareBinding();
+        break;
+    }
+    case Binding::kEvent_BindingReady:
+        if (!Sending && RequestsSent == 0)
+            StartLoad();
+        break;
+    case Binding::kEvent_PrepareFailed:
+        printf("Binding prepare failed: %s\n", ErrorStr(inParam.PrepareFailed.Reason));
+        Done = true;
+        break;
+    case Binding::kEvent_BindingFailed:
+        printf("Binding failed: %s\n", ErrorStr(inParam.BindingFailed.Reason));
+        Done = true;
+        break;
+    default:
+        Binding::DefaultEventHandler(appState, eventType, inParam, outParam);
+        break;
+    }
+}
+
+void StartLoad(void)
+{
+    printf("Sending Echo Requests via %s to node %" PRIX64, (UseTCP) ? "TCP" : (UseWRMP) ? "UDP with WRMP" : "UDP", DestNodeId);
+    if (DestAddr != NULL)
+        printf(" (%s)", DestAddr);
+    printf(", %" PRIu32 " in flight", Concurrency);
+    if (TargetRate != 0)
+        printf(", at %" PRIu32 " per second", TargetRate);
+    else
+        printf(", back to back");
+    printf(", with %" PRIu32, MinLength);
+    if (MaxLength != MinLength)
+        printf("-%" PRIu32, MaxLength);
+    printf(" byte payloads\n");
+
+    Sending = true;
+    StartTime = LastReportTime = System::Layer::GetClock_MonotonicHiRes();
+    EndTime = (Duration != 0) ? StartTime + (uint64_t)Duration * nl::kMicrosecondsPerSecond : UINT64_MAX;
+
+    if (ReportInterval != 0)
+        SystemLayer.StartTimer(ReportInterval * nl::kMillisecondPerSecond, HandleReportTimer, NULL);
+
+    DriveSending();
+}
+
+void FinishLoad(void)
+{
+    uint64_t now = System::Layer::GetClock_MonotonicHiRes();
+
+    Sending = false;
+    SystemLayer.CancelTimer(HandleSendTimer, NULL);
+    SystemLayer.CancelTimer(HandleReportTimer, NULL);
+
+    if (RequestsSent == 0)
+        return;
+
+    printf("\n");
+    printf("Requests sent: %" PRIu64 ", completed: %" PRIu64 ", failed: %" PRIu64 " (%" PRIu64 " timed out)\n",
+           RequestsSent, RequestsCompleted, RequestsFailed, RequestsTimedOut);
+    if (TargetRate != 0)
+        printf("Requests sent late for want of a free exchange: %" PRIu64 "\n", SendDelayedCount);
+    printf("Payload bytes sent: %" PRIu64 "\n", BytesSent);
+    PrintReport("Total", TotalLatency, RequestsCompleted, RequestsFailed, now - StartTime);
+    printf("Latency (us): min %" PRIu64 ", mean %" PRIu64 ", p50 %" PRIu64 ", p90 %" PRIu64 ", p99 %" PRIu64
+           ", p99.9 %" PRIu64 ", p99.99 %" PRIu64 ", max %" PRIu64 "\n",
+           TotalLatency.Min(), TotalLatency.Mean(), TotalLatency.ValueAtPercentile(50.0), TotalLatency.ValueAtPercentile(90.0),
+           TotalLatency.ValueAtPercentile(99.0), TotalLatency.ValueAtPercentile(99.9), TotalLatency.ValueAtPercentile(99.99),
+           TotalLatency.Max());
+}
+
+/**
+ * Sends any Echo Requests that are due, and arranges to be called again when the next one is due.
+ */
+void DriveSending(void)
+{
+    uint64_t now;
+    bool sendFailed = false;
+
+    if (!Sending)
+        return;
+
+    now = System::Layer::GetClock_MonotonicHiRes();
+
+    if (now >= EndTime || RequestsSent >= MaxRequestCount)
+    {
+        // Stop sending, and exit once the outstanding exchanges have completed.
+        Sending = false;
+        if (FreeSlotCount == Concurrency)
+            Done = true;
+        return;
+    }
+
+    while (FreeSlotCount > 0 && RequestsSent < MaxRequestCount)
+    {
+        uint64_t intendedSendTime = now;
+
+        if (TargetRate != 0)
+        {
+            // Pace the requests from the start time, rather than from the previous request, so that
+            // requests sent late do not lower the offered rate.
+            intendedSendTime = StartTime + (RequestsSent * nl::kMicrosecondsPerSecond) / TargetRate;
+            if (intendedSendTime > now)
+                break;
+        }
+
+        EchoSlot *slot = FreeSlots[--FreeSlotCount];
+        WEAVE_ERROR err = SendEchoRequest(slot, intendedSendTime);
+        if (err != WEAVE_NO_ERROR)
+        {
+            printf("Failed to send Echo Request: %s\n", ErrorStr(err));
+            FreeSlots[FreeSlotCount++] = slot;
+            RequestsFailed++;
+            IntervalFailed++;
+            sendFailed = true;
+            break;
+        }
+    }
+
+    if (sendFailed)
+    {
+        // Retry shortly, rather than spinning on a failure that is likely to persist for a while
+        // (e.g. running out of packet buffers).
+        SystemLayer.StartTimer(nl::kMillisecondPerSecond / 10, HandleSendTimer, NULL);
+    }
+    else if (TargetRate != 0 && RequestsSent < MaxRequestCount)
+    {
+        uint64_t nextSendTime = StartTime + (RequestsSent * nl::kMicrosecondsPerSecond) / TargetRate;
+
+        // If the next request is already due, it will be sent when an exchange completes.
+        if (nextSendTime > now)
+        {
+            uint32_t delayMS = (uint32_t)((nextSendTime - now + 999) / 1000);
+            SystemLayer.StartTimer(delayMS, HandleSendTimer, NULL);
+        }
+        else
+            SendDelayedCount++;
+    }
+    else if (Duration != 0)
+    {
+        // Sending back to back is driven by the completion of exchanges; check back for the end of
+        // the run in case none complete meanwhile.
+        SystemLayer.StartTimer((uint32_t)((EndTime - now) / 1000) + 1, HandleSendTimer, NULL);
+    }
+}
+
+void HandleSendTimer(System::Layer *systemLayer, void *appState, System::Error err)
+{
+    DriveSending();
+}
+
+void HandleReportTimer(System::Layer *systemLayer, void *appState, System::Error err)
+{
+    uint64_t now = System::Layer::GetClock_MonotonicHiRes();
+
+    PrintReport("Interval", IntervalLatency, IntervalCompleted, IntervalFailed, now - LastReportTime);
+
+    IntervalLatency.Reset();
+    IntervalCompleted = 0;
+    IntervalFailed = 0;
+    LastReportTime = now;
+
+    if (Sending)
+        SystemLayer.StartTimer(ReportInterval * nl::kMillisecondPerSecond, HandleReportTimer, NULL);
+}
+
+WEAVE_ERROR SendEchoRequest(EchoSlot *slot, uint64_t intendedSendTime)
+{
+    WEAVE_ERROR err;
+    PacketBuffer *payload = NULL;
+    uint32_t length = MinLength;
+    ExchangeContext *ec = NULL;
+
+    if (MaxLength != MinLength)
+        length += GetRandU32() % (MaxLength - MinLength + 1);
+
+    payload = PacketBuffer::New();
+    VerifyOrExit(payload != NULL, err = WEAVE_ERROR_NO_MEMORY);
+    VerifyOrExit(length <= payload->AvailableDataLength(), err = WEAVE_ERROR_BUFFER_TOO_SMALL);
+
+    memset(payload->Start(), (uint8_t)RequestsSent, length);
+    payload->SetDataLength((uint16_t)length);
+
+    err = EchoBinding->NewExchangeContext(ec);
+    SuccessOrExit(err);
+
+    ec->AppState = slot;
+    ec->OnMessageReceived = HandleEchoResponse;
+    ec->OnResponseTimeout = HandleResponseTimeout;
+    ec->OnKeyError = HandleKeyError;
+    ec->OnConnectionClosed = HandleConnectionClosed;
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    ec->OnSendError = HandleSendError;
+#endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+
+    slot->EC = ec;
+    slot->IntendedSendTime = intendedSendTime;
+
+    RequestsSent++;
+    BytesSent += length;
+
+    err = ec->SendMessage(kWeaveProfile_Echo, kEchoMessageType_EchoRequest, payload, ExchangeContext::kSendFlag_ExpectResponse);
+    payload = NULL;
+    if (err != WEAVE_NO_ERROR)
+    {
+        slot->EC = NULL;
+        ec->Abort();
+    }
+
+exit:
+    PacketBuffer::Free(payload);
+    return err;
+}
+
+/**
+ * Records the outcome of the Echo exchange in a slot and frees the slot for the next request.
+ */
+void CompleteEchoRequest(EchoSlot *slot, WEAVE_ERROR err)
+{
+    ExchangeContext *ec = slot->EC;
+
+    if (ec == NULL)
+        return;
+    slot->EC = NULL;
+
+    if (err == WEAVE_NO_ERROR)
+    {
+        // Measure the latency from when the request was due, so that the delays that requests see
+        // when the responder falls behind the target rate are reflected in the percentiles.
+        uint64_t latency = System::Layer::GetClock_MonotonicHiRes() - slot->IntendedSendTime;
+
+        TotalLatency.Record(latency);
+        IntervalLatency.Record(latency);
+        RequestsCompleted++;
+        IntervalCompleted++;
+
+        // Close rather than abort the exchange, so that any pending WRM ACK for the response is sent.
+        ec->Close();
+    }
+    else
+    {
+        if (err == WEAVE_ERROR_TIMEOUT)
+            RequestsTimedOut++;
+        else if (RequestsFailed - RequestsTimedOut < 10)
+            printf("Echo exchange failed: %s\n", ErrorStr(err));
+        RequestsFailed++;
+        IntervalFailed++;
+
+        ec->Abort();
+    }
+
+    FreeSlots[FreeSlotCount++] = slot;
+
+    if (Sending)
+        DriveSending();
+    else if (FreeSlotCount == Concurrency)
+        Done = true;
+}
+
+void HandleEchoResponse(ExchangeContext *ec, const IPPacketInfo *pktInfo, const WeaveMessageInfo *msgInfo, uint32_t profileId, uint8_t msgType, PacketBuffer *payload)
+{
+    EchoSlot *slot = static_cast<EchoSlot *>(ec->AppState);
+
+    PacketBuffer::Free(payload);
+
+    if (profileId != kWeaveProfile_Echo || msgType != kEchoMessageType_EchoResponse)
+    {
+        CompleteEchoRequest(slot, WEAVE_ERROR_INVALID_MESSAGE_TYPE);
+        return;
+    }
+
+    CompleteEchoRequest(slot, WEAVE_NO_ERROR);
+}
+
+void HandleResponseTimeout(ExchangeContext *ec)
+{
+    CompleteEchoRequest(static_cast<EchoSlot *>(ec->AppState), WEAVE_ERROR_TIMEOUT);
+}
+
+void HandleKeyError(ExchangeContext *ec, WEAVE_ERROR keyErr)
+{
+    CompleteEchoRequest(static_cast<EchoSlot *>(ec->AppState), keyErr);
+}
+
+void HandleConnectionClosed(ExchangeContext *ec, WeaveConnection *con, WEAVE_ERROR conErr)
+{
+    CompleteEchoRequest(static_cast<EchoSlot *>(ec->AppState), (conErr != WEAVE_NO_ERROR) ? conErr : WEAVE_ERROR_CONNECTION_CLOSED_UNEXPECTEDLY);
+}
+
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+void HandleSendError(ExchangeContext *ec, WEAVE_ERROR sendErr, void *msgCtxt)
+{
+    CompleteEchoRequest(static_cast<EchoSlot *>(ec->AppState), sendErr);
+}
+#endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+
+void PrintReport(const char *label, const LatencyHistogram& histogram, uint64_t completed, uint64_t failed, uint64_t elapsedUS)
+{
+    uint64_t rate = (elapsedUS != 0) ? (completed * nl::kMicrosecondsPerSecond) / elapsedUS : 0;
+
+    printf("%s: %" PRIu64 " completed, %" PRIu64 " failed, %" PRIu64 " per second; latency (us) p50 %" PRIu64 ", p99 %" PRIu64 ", max %" PRIu64 "\n",
+           label, completed, failed, rate, histogram.ValueAtPercentile(50.0), histogram.ValueAtPercentile(99.0), histogram.Max());
+}
+
+void LatencyHistogram::Reset(void)
+{
+    memset(mCounts, 0, sizeof(mCounts));
+    mCount = 0;
+    mSum = 0;
+    mMin = UINT64_MAX;
+    mMax = 0;
+}
+
+void LatencyHistogram::Record(uint64_t value)
+{
+    mCounts[IndexOf(value)]++;
+    mCount++;
+    mSum += value;
+    if (value < mMin)
+        mMin = value;
+    if (value > mMax)
+        mMax = value;
+}
+
+/**
+ * Returns the value below which the given percentage of the recorded values fall, to the
+ * precision of the histogram.
+ */
+uint64_t LatencyHistogram::ValueAtPercentile(double percentile) const
+{
+    uint64_t target;
+    uint64_t cumulative = 0;
+
+    if (mCount == 0)
+        return 0;
+
+    target = (uint64_t)((percentile / 100.0) * mCount + 0.5);
+    if (target == 0)
+        target = 1;
+
+    for (uint32_t i = 0; i < kBucketCount; i++)
+    {
+        cumulative += mCounts[i];
+        if (cumulative >= target)
+        {
+            uint64_t value = HighestValueAt(i);
+            return (value < mMax) ? value : mMax;
+        }
+    }
+
+    return mMax;
+}
+
+uint32_t LatencyHistogram::IndexOf(uint64_t value)
+{
+    uint32_t msb;
+    uint32_t shift;
+
+    if (value < 2 * kSubBucketCount)
+        return (uint32_t)value;
+
+    if (value >= (1ULL << kMaxValueBits))
+        value = (1ULL << kMaxValueBits) - 1;
+
+    // Keep the kSubBucketBits + 1 most significant bits of the value, the top one of which is always set.
+    msb = 63 - __builtin_clzll(value);
+    shift = msb - kSubBucketBits;
+
+    return (shift + 1) * kSubBucketCount + (uint32_t)(value >> shift) - kSubBucketCount;
+}
+
+uint64_t LatencyHistogram::HighestValueAt(uint32_t index)
+{
+    uint32_t shift;
+    uint64_t subBucket;
+
+    if (index < 2 * kSubBucketCount)
+        return index;
+
+    shift = index / kSubBucketCount - 1;
+    subBucket = index % kSubBucketCount + kSubBucketCount;
+
+    return ((subBucket + 1) << shift) - 1;
+}
+
+bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case 'D':
+        return ParseDestAddress(progName, arg);
+    case 'C':
+        if (!ParseInt(arg, Concurrency) || Concurrency == 0)
+        {
+            PrintArgError("%s: Invalid value specified for concurrency: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'r':
+        if (!ParseInt(arg, TargetRate))
+        {
+            PrintArgError("%s: Invalid value specified for request rate: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'c':
+        if (!ParseInt(arg, MaxRequestCount) || MaxRequestCount == 0)
+        {
+            PrintArgError("%s: Invalid value specified for send count: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'd':
+        if (!ParseInt(arg, Duration) || Duration == 0)
+        {
+            PrintArgError("%s: Invalid value specified for duration: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'l':
+        return ParseLength(progName, arg);
+    case 'T':
+        if (!ParseInt(arg, ResponseTimeout) || ResponseTimeout == 0)
+        {
+            PrintArgError("%s: Invalid value specified for response timeout: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'R':
+        if (!ParseInt(arg, ReportInterval))
+        {
+            PrintArgError("%s: Invalid value specified for report interval: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 't':
+        UseTCP = true;
+        UseWRMP = false;
+        break;
+    case 'u':
+        UseTCP = false;
+        UseWRMP = false;
+        break;
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    case 'w':
+        UseTCP = false;
+        UseWRMP = true;
+        break;
+#endif // WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+bool HandleNonOptionArgs(const char *progName, int argc, char *argv[])
+{
+    const char *destAddr = NULL;
+
+    if (argc == 0)
+    {
+        PrintArgError("%s: Please specify a destination node id\n", progName);
+        return false;
+    }
+
+    if (argc > 1)
+    {
+        PrintArgError("%s: Unexpected argument: %s\n", progName, argv[1]);
+        return false;
+    }
+
+    const char *nodeId = argv[0];
+    char *p = (char *)strchr(nodeId, '@');
+    if (p != NULL)
+    {
+        *p = 0;
+        destAddr = p+1;
+    }
+
+    if (!ParseNodeId(nodeId, DestNodeId))
+    {
+        PrintArgError("%s: Invalid value specified for destination node-id: %s\n", progName, nodeId);
+        return false;
+    }
+
+    if (destAddr != NULL && !ParseDestAddress(progName, destAddr))
+        return false;
+
+    return true;
+}
+
+bool ParseLength(const char *progName, const char *arg)
+{
+    char minStr[11];
+    const char *sep = strchr(arg, '-');
+    bool res;
+
+    if (sep == NULL)
+    {
+        res = ParseInt(arg, MinLength);
+        MaxLength = MinLength;
+    }
+    else
+    {
+        size_t minLen = sep - arg;
+
+        res = (minLen < sizeof(minStr));
+        if (res)
+        {
+            memcpy(minStr, arg, minLen);
+            minStr[minLen] = 0;
+            res = ParseInt(minStr, MinLength) && ParseInt(sep + 1, MaxLength) && MaxLength >= MinLength;
+        }
+    }
+
+    if (!res)
+        PrintArgError("%s: Invalid value specified for payload length: %s\n", progName, arg);
+
+    return res;
+}
+
+bool ParseDestAddress(const char *progName, const char *arg)
+{
+    WEAVE_ERROR err;
+    const char *addr;
+    uint16_t addrLen;
+    const char *intfName;
+    uint16_t intfNameLen;
+
+    err = ParseHostPortAndInterface(arg, strlen(arg), addr, addrLen, DestPort, intfName, intfNameLen);
+    if (err != INET_NO_ERROR)
+    {
+        PrintArgError("%s: Invalid destination address: %s\n", progName, arg);
+        return false;
+    }
+
+    if (!IPAddress::FromString(addr, DestIPAddr))
+    {
+        PrintArgError("%s: Invalid destination address: %s\n", progName, arg);
+        return false;
+    }
+
+    if (intfName != NULL)
+    {
+        err = InterfaceNameToId(intfName, DestIntf);
+        if (err != INET_NO_ERROR)
+        {
+            PrintArgError("%s: Invalid interface name: %s\n", progName, intfName);
+            return false;
+        }
+    }
+
+    DestAddr = arg;
+
+    return true;
+}
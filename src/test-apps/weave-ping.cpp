@@ -672,16 +672,22 @@ void DriveSending()
 
         // If the --test-session-suspend option has been enabled, suspend and restore
         // the CASE session every 4 echo requests.  Every 8th echo request, remove the
-        // suspended session before attempting to restore it.
+        // suspended session before attempting to restore it.  The session state is
+        // alternately serialized in TLV and captured in compact form, 8 requests at a time.
         if (TestSessionSuspend && gWeaveSecurityMode.SecurityMode == WeaveSecurityMode::kCASE)
         {
             if (EchoCount > 0 && (EchoCount % 4) == 0)
             {
                 uint8_t buf[256];
                 uint16_t serializedKeyLen;
-
-                printf("Suspending CASE session\n");
-                err = FabricState.SuspendSession(EchoClient.KeyId, DestNodeId, buf, sizeof(buf), serializedKeyLen);
+                WeaveSuspendedSession suspendedSession;
+                const bool useCompactForm = ((EchoCount / 8) % 2) != 0;
+
+                printf("Suspending CASE session%s\n", useCompactForm ? " (compact form)" : "");
+                if (useCompactForm)
+                    err = FabricState.SuspendSession(EchoClient.KeyId, DestNodeId, suspendedSession);
+                else
+                    err = FabricState.SuspendSession(EchoClient.KeyId, DestNodeId, buf, sizeof(buf), serializedKeyLen);
                 if (err != WEAVE_NO_ERROR)
                 {
                     printf("FabricState.SuspendSession() failed: %s\n", ErrorStr(err));
@@ -700,12 +706,17 @@ void DriveSending()
                 if (err == WEAVE_NO_ERROR)
                 {
                     printf("Restoring suspended CASE session\n");
-                    err = FabricState.RestoreSession(buf, serializedKeyLen);
+                    if (useCompactForm)
+                        err = FabricState.RestoreSession(suspendedSession);
+                    else
+                        err = FabricState.RestoreSession(buf, serializedKeyLen);
                     if (err != WEAVE_NO_ERROR)
                     {
                         printf("FabricState.RestoreSession() failed: %s\n", ErrorStr(err));
                     }
                 }
+
+                suspendedSession.Clear();
             }
         }
 
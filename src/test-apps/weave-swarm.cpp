@@ -0,0 +1,656 @@
+/*
+ *
+ *    Copyright (c) 2019 Google LLC.
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a command line tool, weave-swarm, that emulates
+ *      many Weave nodes in a single process, for load testing a service.
+ *
+ *      Each emulated node has its own fabric state, message layer and
+ *      exchange manager, bound to its own Weave address, and sends
+ *      Heartbeats to the destination node.  The nodes are spread over one or
+ *      more shards, each of which is a thread running a System::Layer and
+ *      InetLayer shared by the nodes in the shard.
+ *
+ */
+
+#define __STDC_FORMAT_MACROS
+#define __STDC_LIMIT_MACROS
+
+#include <inttypes.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sys/select.h>
+
+#include "ToolCommon.h"
+#include <Weave/WeaveVersion.h>
+#include <Weave/Core/WeaveBinding.h>
+#include <Weave/Profiles/heartbeat/WeaveHeartbeat.h>
+
+using namespace nl::Weave::Profiles::Heartbeat;
+
+#define TOOL_NAME "weave-swarm"
+
+// Environment variable from which further options are read; set by simnet for
+// nodes with a Weave node count greater than 1.
+#define SWARM_OPTIONS_ENV_VAR_NAME "WEAVE_SWARM_CONFIG"
+
+// The number of sockets opened by each node: the Weave UDP endpoint and, as the node is
+// bound to its own address, the Weave UDP multicast endpoint.
+#define SOCKETS_PER_NODE 2
+
+// The number of file descriptors set aside for other uses, such as the wake pipe of each
+// shard and the standard streams.
+#define RESERVED_FDS 64
+
+#if WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_CONFIG_ENABLE_TARGETED_LISTEN
+
+struct SwarmShard;
+
+struct SwarmNode
+{
+    SwarmShard *Shard;
+    WeaveFabricState FabricState;
+    WeaveMessageLayer MessageLayer;
+    WeaveExchangeManager ExchangeMgr;
+    WeaveHeartbeatSender HeartbeatSender;
+    uint32_t HeartbeatCount;
+};
+
+struct SwarmShard
+{
+    System::Layer SystemLayer;
+    InetLayer Inet;
+    pthread_t Thread;
+    uint32_t NodeCount;
+    volatile uint32_t HeartbeatsSent;
+    volatile uint32_t HeartbeatsFailed;
+    volatile uint32_t NodesDone;
+};
+
+static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
+static bool HandleNonOptionArgs(const char *progName, int argc, char *argv[]);
+static bool ParseDestAddress(const char *progName, const char *arg);
+static WEAVE_ERROR InitShard(SwarmShard& shard);
+static WEAVE_ERROR InitNode(SwarmNode& node, SwarmShard& shard, uint32_t nodeIndex);
+static void ShutdownNode(SwarmNode& node);
+static void *ShardMain(void *arg);
+static void PrintTotals(void);
+static void HeartbeatSenderEventHandler(void *appState, WeaveHeartbeatSender::EventType eventType, const WeaveHeartbeatSender::InEventParam& inParam, WeaveHeartbeatSender::OutEventParam& outParam);
+static void BindingEventHandler(void *appState, Binding::EventType eventType, const Binding::InEventParam& inParam, Binding::OutEventParam& outParam);
+
+static uint32_t NodeCount = 1;
+static uint32_t ShardCount = 1;
+static uint32_t MaxHeartbeatCount = UINT32_MAX;
+static uint32_t HeartbeatInterval = 10000; // 10 seconds
+static uint32_t HeartbeatWindow = 0;
+static uint32_t ReportInterval = 10; // 10 seconds
+static bool RequestAck = false;
+static uint64_t DestNodeId;
+static const char *DestAddr = NULL;
+static IPAddress DestIPAddr;
+static uint16_t DestPort;
+static InterfaceId DestIntf = INET_NULL_INTERFACEID;
+static SwarmNode *Nodes = NULL;
+static SwarmShard *Shards = NULL;
+
+static OptionDef gToolOptionDefs[] =
+{
+    { "node-count",      kArgumentRequired, 'n' },
+    { "shards",          kArgumentRequired, 's' },
+    { "dest-addr",       kArgumentRequired, 'D' },
+    { "count",           kArgumentRequired, 'c' },
+    { "interval",        kArgumentRequired, 'i' },
+    { "window",          kArgumentRequired, 'W' },
+    { "report-interval", kArgumentRequired, 'R' },
+    { "request-ack",     kNoArgument,       'r' },
+    { }
+};
+
+static const char *const gToolOptionHelp =
+    "  -n, --node-count <num>\n"
+    "       The number of Weave nodes to emulate.  The nodes take consecutive node ids,\n"
+    "       starting with the id given by --node-id, and each is bound to the Weave\n"
+    "       address for its node id in the fabric and subnet given by --fabric-id and\n"
+    "       --subnet.  The addresses must be assigned to a local interface; simnet\n"
+    "       does this for Weave devices with a weaveNodeCount.  Defaults to 1.\n"
+    "\n"
+    "  -s, --shards <num>\n"
+    "       Spread the nodes over the specified number of threads.  Each thread runs\n"
+    "       its own System and Inet layers, shared by the nodes it runs.  Defaults to 1.\n"
+    "\n"
+    "  -D, --dest-addr <host>[:<port>][%<interface>]\n"
+    "       Send Heartbeats to a specific address rather than one\n"
+    "       derived from the destination node id. <host> can be a hostname,\n"
+    "       an IPv4 address or an IPv6 address. If <port> is specified, Heartbeat\n"
+    "       requests will be sent to the specified port. If <interface> is\n"
+    "       specified, Heartbeats will be sent over the specified local\n"
+    "       interface.\n"
+    "\n"
+    "       NOTE: When specifying a port with an IPv6 address, the IPv6 address\n"
+    "       must be enclosed in brackets, e.g. [fd00:0:1:1::1]:11095.\n"
+    "\n"
+    "  -c, --count <num>\n"
+    "       Send the specified number of Heartbeats from each node and exit.\n"
+    "\n"
+    "  -i, --interval <ms>\n"
+    "       Send Heartbeats from each node at the specified interval in milliseconds.\n"
+    "       The nodes' Heartbeats are spread evenly over the interval.  Defaults to\n"
+    "       10000.\n"
+    "\n"
+    "  -W, --window <ms>\n"
+    "       Randomize the sending of Heartbeats over the specified interval in milliseconds.\n"
+    "\n"
+    "  -R, --report-interval <sec>\n"
+    "       Print the number of Heartbeats sent at the specified interval in seconds.\n"
+    "       Defaults to 10.\n"
+    "\n"
+    "  -r, --request-ack\n"
+    "       Use Weave Reliable Messaging when sending heartbeats over UDP.\n"
+    "\n"
+    "  Further options are read from the " SWARM_OPTIONS_ENV_VAR_NAME " environment variable.\n"
+    "\n"
+    "  The number of nodes a process can emulate is limited by the size of the Inet\n"
+    "  layer's UDP endpoint pool (INET_CONFIG_NUM_UDP_ENDPOINTS) and System layer's\n"
+    "  timer pool (WEAVE_SYSTEM_CONFIG_NUM_TIMERS), which are set at build time, and\n"
+    "  by the number of sockets select() can wait on (FD_SETSIZE).  Run several\n"
+    "  processes, with distinct node id ranges, to emulate more nodes.\n"
+    "\n";
+
+static OptionSet gToolOptions =
+{
+    HandleOption,
+    gToolOptionDefs,
+    "GENERAL OPTIONS",
+    gToolOptionHelp
+};
+
+static HelpOptions gHelpOptions(
+    TOOL_NAME,
+    "Usage: " TOOL_NAME " [<options...>] <dest-node-id>[@<dest-host>[:<dest-port>][%%<interface>]]\n",
+    WEAVE_VERSION_STRING "\n" WEAVE_TOOL_COPYRIGHT,
+    "Emulate many Weave nodes sending Heartbeats to a destination node.\n"
+);
+
+static OptionSet *gToolOptionSets[] =
+{
+    &gToolOptions,
+    &gWeaveNodeOptions,
+    &gWRMPOptions,
+    &gHelpOptions,
+    NULL
+};
+
+int main(int argc, char *argv[])
+{
+    WEAVE_ERROR err;
+    uint32_t maxNodeCount;
+    uint32_t shardsStarted = 0;
+    uint32_t nodesInited = 0;
+    uint64_t lastReportTime;
+    int res = EXIT_SUCCESS;
+
+    InitToolCommon();
+
+    SetSignalHandler(DoneOnHandleSIGUSR1);
+
+    if (argc == 1)
+    {
+        gHelpOptions.PrintBriefUsage(stderr);
+        exit(EXIT_FAILURE);
+    }
+
+    if (!ParseArgsFromEnvVar(TOOL_NAME, TOOL_OPTIONS_ENV_VAR_NAME, gToolOptionSets, NULL, true) ||
+        !ParseArgsFromEnvVar(TOOL_NAME, SWARM_OPTIONS_ENV_VAR_NAME, gToolOptionSets, NULL, true) ||
+        !ParseArgs(TOOL_NAME, argc, argv, gToolOptionSets, HandleNonOptionArgs))
+    {
+        exit(EXIT_FAILURE);
+    }
+
+    if (!gWeaveNodeOptions.FabricIdSet)
+    {
+        PrintArgError("%s: Please specify the fabric id using the --fabric-id option\n", TOOL_NAME);
+        exit(EXIT_FAILURE);
+    }
+
+    maxNodeCount = (FD_SETSIZE - RESERVED_FDS) / SOCKETS_PER_NODE;
+    if (maxNodeCount > INET_CONFIG_NUM_UDP_ENDPOINTS / SOCKETS_PER_NODE)
+        maxNodeCount = INET_CONFIG_NUM_UDP_ENDPOINTS / SOCKETS_PER_NODE;
+    if (NodeCount > maxNodeCount)
+    {
+        PrintArgError("%s: This build can emulate at most %" PRIu32 " nodes per process\n", TOOL_NAME, maxNodeCount);
+        exit(EXIT_FAILURE);
+    }
+
+    if (ShardCount > NodeCount)
+        ShardCount = NodeCount;
+
+    Shards = new SwarmShard[ShardCount];
+    Nodes = new SwarmNode[NodeCount];
+
+    for (uint32_t i = 0; i < ShardCount; i++)
+    {
+        err = InitShard(Shards[i]);
+        if (err != WEAVE_NO_ERROR)
+        {
+            printf("Shard initialization failed: %s\n", ErrorStr(err));
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Initialize the nodes before starting the shards, so that each node is only ever
+    // touched by the thread running its shard from then on.
+    for (; nodesInited < NodeCount; nodesInited++)
+    {
+        err = InitNode(Nodes[nodesInited], Shards[nodesInited % ShardCount], nodesInited);
+        if (err != WEAVE_NO_ERROR)
+        {
+            printf("Initialization of node %" PRIX64 " failed: %s\n", gWeaveNodeOptions.LocalNodeId + nodesInited, ErrorStr(err));
+            ExitNow(res = EXIT_FAILURE);
+        }
+    }
+
+    printf("Emulating %" PRIu32 " nodes, %016" PRIX64 " to %016" PRIX64 ", in %" PRIu32 " shards\n",
+           NodeCount, gWeaveNodeOptions.LocalNodeId, gWeaveNodeOptions.LocalNodeId + NodeCount - 1, ShardCount);
+    printf("Sending");
+    if (MaxHeartbeatCount != UINT32_MAX)
+        printf(" %u", MaxHeartbeatCount);
+    printf(" Heartbeats from each node via %s to node %" PRIX64, (RequestAck) ? "UDP with WRMP" : "UDP", DestNodeId);
+    if (DestAddr != NULL)
+        printf(" (%s)", DestAddr);
+    printf(" every %" PRIu32 " ms\n", HeartbeatInterval);
+
+    for (; shardsStarted < ShardCount; shardsStarted++)
+    {
+        int pthreadErr = pthread_create(&Shards[shardsStarted].Thread, NULL, ShardMain, &Shards[shardsStarted]);
+        if (pthreadErr != 0)
+        {
+            printf("Unable to start shard thread: %s\n", strerror(pthreadErr));
+            ExitNow(res = EXIT_FAILURE);
+        }
+    }
+
+    lastReportTime = System::Layer::GetClock_MonotonicMS();
+
+    while (!Done)
+    {
+        uint32_t nodesDone = 0;
+
+        usleep(100000);
+
+        if (System::Layer::GetClock_MonotonicMS() - lastReportTime >= ReportInterval * 1000ULL)
+        {
+            PrintTotals();
+            lastReportTime = System::Layer::GetClock_MonotonicMS();
+        }
+
+        for (uint32_t i = 0; i < ShardCount; i++)
+            nodesDone += Shards[i].NodesDone;
+        if (nodesDone == NodeCount)
+            Done = true;
+    }
+
+exit:
+    Done = true;
+
+    for (uint32_t i = 0; i < shardsStarted; i++)
+        pthread_join(Shards[i].Thread, NULL);
+
+    PrintTotals();
+
+    for (uint32_t i = 0; i < nodesInited; i++)
+        ShutdownNode(Nodes[i]);
+
+    for (uint32_t i = 0; i < ShardCount; i++)
+    {
+        Shards[i].Inet.Shutdown();
+        Shards[i].SystemLayer.Shutdown();
+    }
+
+    delete[] Nodes;
+    delete[] Shards;
+
+    return res;
+}
+
+WEAVE_ERROR InitShard(SwarmShard& shard)
+{
+    WEAVE_ERROR err;
+
+    shard.NodeCount = 0;
+    shard.HeartbeatsSent = 0;
+    shard.HeartbeatsFailed = 0;
+    shard.NodesDone = 0;
+
+    err = shard.SystemLayer.Init(NULL);
+    SuccessOrExit(err);
+
+    err = shard.Inet.Init(shard.SystemLayer, NULL);
+    SuccessOrExit(err);
+
+exit:
+    return err;
+}
+
+WEAVE_ERROR InitNode(SwarmNode& node, SwarmShard& shard, uint32_t nodeIndex)
+{
+    WEAVE_ERROR err;
+    WeaveMessageLayer::InitContext initContext;
+    Binding *binding = NULL;
+
+    node.Shard = &shard;
+    node.HeartbeatCount = 0;
+    shard.NodeCount++;
+
+    err = node.FabricState.Init();
+    SuccessOrExit(err);
+
+    node.FabricState.FabricId = gWeaveNodeOptions.FabricId;
+    node.FabricState.LocalNodeId = gWeaveNodeOptions.LocalNodeId + nodeIndex;
+    node.FabricState.DefaultSubnet = gWeaveNodeOptions.SubnetId;
+
+    // Bind each node to its own address, so that the nodes can share the Weave port.
+    node.FabricState.ListenIPv6Addr = node.FabricState.SelectNodeAddress(node.FabricState.LocalNodeId);
+
+    initContext.systemLayer = &shard.SystemLayer;
+    initContext.inet = &shard.Inet;
+    initContext.fabricState = &node.FabricState;
+    initContext.listenTCP = false;
+    initContext.listenUDP = true;
+
+    err = node.MessageLayer.Init(&initContext);
+    SuccessOrExit(err);
+
+    err = node.ExchangeMgr.Init(&node.MessageLayer);
+    SuccessOrExit(err);
+
+    binding = node.ExchangeMgr.NewBinding(BindingEventHandler, &node);
+    VerifyOrExit(binding != NULL, err = WEAVE_ERROR_NO_MEMORY);
+
+    err = node.HeartbeatSender.Init(&node.ExchangeMgr, binding, HeartbeatSenderEventHandler, &node);
+    SuccessOrExit(err);
+
+    // Spread the nodes' Heartbeats evenly over the interval, so that the destination sees a
+    // steady load rather than a burst every interval.
+    node.HeartbeatSender.SetConfiguration(HeartbeatInterval, (uint32_t)(((uint64_t)HeartbeatInterval * nodeIndex) / NodeCount), HeartbeatWindow);
+    node.HeartbeatSender.SetRequestAck(RequestAck);
+    node.HeartbeatSender.SetSubscriptionState(0x01);
+
+    err = node.HeartbeatSender.StartHeartbeat();
+    SuccessOrExit(err);
+
+exit:
+    // The HeartbeatSender retains its own reference to the binding.
+    if (binding != NULL)
+        binding->Release();
+    return err;
+}
+
+void ShutdownNode(SwarmNode& node)
+{
+    node.HeartbeatSender.Shutdown();
+    node.ExchangeMgr.Shutdown();
+    node.MessageLayer.Shutdown();
+    node.FabricState.Shutdown();
+}
+
+void *ShardMain(void *arg)
+{
+    SwarmShard *shard = static_cast<SwarmShard *>(arg);
+
+    while (!Done)
+    {
+        struct timeval sleepTime;
+        fd_set readFDs, writeFDs, exceptFDs;
+        int numFDs = 0;
+        int selectRes;
+
+        sleepTime.tv_sec = 0;
+        sleepTime.tv_usec = 100000;
+
+        FD_ZERO(&readFDs);
+        FD_ZERO(&writeFDs);
+        FD_ZERO(&exceptFDs);
+
+        shard->SystemLayer.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+        shard->Inet.PrepareSelect(numFDs, &readFDs, &writeFDs, &exceptFDs, sleepTime);
+
+        selectRes = select(numFDs, &readFDs, &writeFDs, &exceptFDs, &sleepTime);
+        if (selectRes < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            printf("select failed: %s\n", ErrorStr(System::MapErrorPOSIX(errno)));
+            Done = true;
+            break;
+        }
+
+        shard->SystemLayer.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+        shard->Inet.HandleSelectResult(selectRes, &readFDs, &writeFDs, &exceptFDs);
+    }
+
+    return NULL;
+}
+
+void PrintTotals(void)
+{
+    uint32_t sent = 0;
+    uint32_t failed = 0;
+
+    for (uint32_t i = 0; i < ShardCount; i++)
+    {
+        sent += Shards[i].HeartbeatsSent;
+        failed += Shards[i].HeartbeatsFailed;
+    }
+
+    printf("Heartbeats sent: %" PRIu32 ", failed: %" PRIu32 "\n", sent, failed);
+}
+
+bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
+{
+    switch (id)
+    {
+    case 'n':
+        if (!ParseInt(arg, NodeCount) || NodeCount == 0)
+        {
+            PrintArgError("%s: Invalid value specified for node count: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 's':
+        if (!ParseInt(arg, ShardCount) || ShardCount == 0)
+        {
+            PrintArgError("%s: Invalid value specified for shard count: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'c':
+        if (!ParseInt(arg, MaxHeartbeatCount))
+        {
+            PrintArgError("%s: Invalid value specified for send count: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'i':
+        if (!ParseInt(arg, HeartbeatInterval) || HeartbeatInterval == 0)
+        {
+            PrintArgError("%s: Invalid value specified for heartbeat interval: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'W':
+        if (!ParseInt(arg, HeartbeatWindow))
+        {
+            PrintArgError("%s: Invalid value specified for heartbeat randomization window: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'R':
+        if (!ParseInt(arg, ReportInterval) || ReportInterval == 0)
+        {
+            PrintArgError("%s: Invalid value specified for report interval: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case 'D':
+        return ParseDestAddress(progName, arg);
+    case 'r':
+#if WEAVE_CONFIG_ENABLE_RELIABLE_MESSAGING
+        RequestAck = true;
+        break;
+#else
+        PrintArgError("%s: WRMP not supported: %s\n", progName, name);
+        return false;
+#endif
+    default:
+        PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+bool HandleNonOptionArgs(const char *progName, int argc, char *argv[])
+{
+    const char *destAddr = NULL;
+
+    if (argc == 0)
+    {
+        PrintArgError("%s: Please specify a destination node id\n", progName);
+        return false;
+    }
+
+    if (argc > 1)
+    {
+        PrintArgError("%s: Unexpected argument: %s\n", progName, argv[1]);
+        return false;
+    }
+
+    const char *nodeId = argv[0];
+    char *p = (char *)strchr(nodeId, '@');
+    if (p != NULL)
+    {
+        *p = 0;
+        destAddr = p+1;
+    }
+
+    if (!ParseNodeId(nodeId, DestNodeId))
+    {
+        PrintArgError("%s: Invalid value specified for destination node-id: %s\n", progName, nodeId);
+        return false;
+    }
+
+    if (destAddr != NULL && !ParseDestAddress(progName, destAddr))
+        return false;
+
+    return true;
+}
+
+bool ParseDestAddress(const char *progName, const char *arg)
+{
+    WEAVE_ERROR err;
+    const char *addr;
+    uint16_t addrLen;
+    const char *intfName;
+    uint16_t intfNameLen;
+
+    err = ParseHostPortAndInterface(arg, strlen(arg), addr, addrLen, DestPort, intfName, intfNameLen);
+    if (err != INET_NO_ERROR)
+    {
+        PrintArgError("%s: Invalid destination address: %s\n", progName, arg);
+        return false;
+    }
+
+    if (!IPAddress::FromString(addr, DestIPAddr))
+    {
+        PrintArgError("%s: Invalid destination address: %s\n", progName, arg);
+        return false;
+    }
+
+    if (intfName != NULL)
+    {
+        err = InterfaceNameToId(intfName, DestIntf);
+        if (err != INET_NO_ERROR)
+        {
+            PrintArgError("%s: Invalid interface name: %s\n", progName, intfName);
+            return false;
+        }
+    }
+
+    DestAddr = arg;
+
+    return true;
+}
+
+void HeartbeatSenderEventHandler(void *appState, WeaveHeartbeatSender::EventType eventType, const WeaveHeartbeatSender::InEventParam& inParam, WeaveHeartbeatSender::OutEventParam& outParam)
+{
+    SwarmNode *node = static_cast<SwarmNode *>(appState);
+
+    switch (eventType)
+    {
+    case WeaveHeartbeatSender::kEvent_HeartbeatSent:
+        __sync_fetch_and_add(&node->Shard->HeartbeatsSent, 1);
+        break;
+    case WeaveHeartbeatSender::kEvent_HeartbeatFailed:
+        __sync_fetch_and_add(&node->Shard->HeartbeatsFailed, 1);
+        break;
+    default:
+        WeaveHeartbeatSender::DefaultEventHandler(appState, eventType, inParam, outParam);
+        return;
+    }
+
+    if (++node->HeartbeatCount == MaxHeartbeatCount)
+    {
+        node->HeartbeatSender.StopHeartbeat();
+        __sync_fetch_and_add(&node->Shard->NodesDone, 1);
+    }
+}
+
+void BindingEventHandler(void *appState, Binding::EventType eventType, const Binding::InEventParam& inParam, Binding::OutEventParam& outParam)
+{
+    switch (eventType)
+    {
+    case Binding::kEvent_PrepareRequested:
+    {
+        Binding::Configuration bindingConfig = inParam.Source->BeginConfiguration()
+            .Target_NodeId(DestNodeId)
+            .Transport_UDP()
+            .Transport_DefaultWRMPConfig(gWRMPOptions.GetWRMPConfig())
+            .Security_None();
+        if (DestAddr != NULL)
+        {
+            bindingConfig.TargetAddress_IP(DestIPAddr, DestPort, DestIntf);
+        }
+        outParam.PrepareRequested.PrepareError = bindingConfig.PrepareBinding();
+        break;
+    }
+    default:
+        Binding::DefaultEventHandler(appState, eventType, inParam, outParam);
+        break;
+    }
+}
+
+#else // !(WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_CONFIG_ENABLE_TARGETED_LISTEN)
+
+int main(int argc, char *argv[])
+{
+    fprintf(stderr, TOOL_NAME ": Requires sockets and WEAVE_CONFIG_ENABLE_TARGETED_LISTEN\n");
+    return EXIT_FAILURE;
+}
+
+#endif // WEAVE_SYSTEM_CONFIG_USE_SOCKETS && WEAVE_CONFIG_ENABLE_TARGETED_LISTEN
@@ -0,0 +1,69 @@
+# 
+# Simnet Network Layout: Device swarm
+#
+# This simnet configuration defines a single HAN with a WiFi network, for load
+# testing a service with a large number of Weave devices.  The HAN contains a
+# Weave device (swarm) that hosts 1000 Weave nodes, with consecutive node ids
+# starting at 0x100, each with its own address on the WiFi network.  A Gateway
+# node (home-gw) connects the HAN's WiFi network to a simulated Internet.
+#
+# To emulate the nodes, run weave-swarm in a shell on the swarm node, e.g.:
+#
+#     sudo simnet device-swarm.py shell swarm
+#     weave-swarm --shards 8 <service-node-id>@<service-addr>
+#
+# The node count is passed to weave-swarm in the WEAVE_SWARM_CONFIG environment
+# variable.  weave-swarm limits the number of nodes per process according to its
+# build configuration; use several Weave devices, with distinct node id ranges,
+# to emulate more nodes than one process can.
+#
+
+#
+#    Copyright (c) 2019 Google LLC.
+#    All rights reserved.
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#===============================================================================
+# Networks
+#===============================================================================
+
+Internet()
+
+WiFiNetwork(
+    name = 'wifi',
+)
+
+#===============================================================================
+# Devices
+#===============================================================================
+
+# Home WiFi gateway with connection to the Internet
+Gateway(
+    name = 'home-gw',
+    outsideNetwork = 'inet',
+    insideNetwork = 'wifi',
+    insideIP4Subnet = '192.168.168.0/24',
+    isIP4DefaultGateway = True
+)
+
+# Weave device hosting a swarm of 1000 Weave nodes on the WiFi network
+WeaveDevice(
+    name = 'swarm',
+    weaveNodeId = 0x100,
+    weaveFabricId = 1,
+    weaveNodeCount = 1000,
+    wifiNetwork = 'wifi',
+    useLwIP = False
+)
@@ -1154,14 +1154,20 @@ class WeaveDevice(Node):
                  legacyNetwork=None, legacyInterface=None,
                  cellularNetwork=None, cellularInterface=None,
                  weaveNodeId=None, weaveFabricId=None, isWeaveBorderGateway=False, advertiseWiFiPrefix=True, 
-                 hostAliases=[], useLwIP=False, useHost=False):
+                 hostAliases=[], useLwIP=False, useHost=False, weaveNodeCount=1):
 
         if useHost and useLwIP:
             raise ConfigException('Cannot specify both useHost and useLwIP for Weave node %s' % (name))
+        if weaveNodeCount < 1:
+            raise ConfigException('Invalid Weave node count for Weave node %s' % (name))
+        if weaveNodeCount > 1 and useLwIP:
+            raise ConfigException('Cannot specify a Weave node count greater than 1 with useLwIP for Weave node %s' % (name))
         
         Node.__init__(self, name, isHostNode=useHost)
         
         self.weaveNodeId = weaveNodeId if weaveNodeId != None else self.nodeIndex
+        self.weaveNodeCount = weaveNodeCount
+        self.swarmAddresses = { }
         self.weaveFabricId = weaveFabricId if weaveFabricId != None else defaultWeaveFabricId
         self.fabricAddrGlobalId = self.weaveFabricId % ((1 << 40) - 1) # bottom 40 bits of fabric id
         self.advertiseWiFiPrefix = advertiseWiFiPrefix
@@ -1222,6 +1228,27 @@ class WeaveDevice(Node):
             self.legacyWeaveAddr = self.weaveInterfaceAddress(subnetNum=2)
             self.legacyInterface.ip6Addresses.append(self.legacyWeaveAddr)
 
+        # When the node emulates a swarm of Weave nodes (see weave-swarm), give each of the additional
+        # nodes its own Weave address on the primary Weave interface.  These are kept apart from the
+        # interface's address list, so that they are assigned in bulk and not listed in hosts entries.
+        self.swarmAddresses = { }
+        if self.weaveNodeCount > 1:
+            if self.wifiInterface:
+                (interface, subnetNum) = (self.wifiInterface, 1)
+            elif self.threadInterface:
+                (interface, subnetNum) = (self.threadInterface, 6)
+            elif self.legacyInterface:
+                (interface, subnetNum) = (self.legacyInterface, 2)
+            else:
+                raise ConfigException('Weave node %s with a Weave node count greater than 1 must have a wifi, thread or legacy interface' % (self.name))
+            self.swarmAddresses[interface] = [ self.weaveInterfaceAddress(subnetNum, nodeId=self.weaveNodeId + i) for i in range(1, self.weaveNodeCount) ]
+
+    def _buildNode(self):
+        Node._buildNode(self)
+
+        for (interface, addrs) in self.swarmAddresses.items():
+            assignAddressesToInterface(interface.ifName, addrs, nsName=self.nsName)
+
     def requestIP6AutoConfig(self, interface):
         if self.wifiInterface and interface.network == self.wifiInterface.network and self.advertiseWiFiPrefix:
             wifiPrefix = self.weaveSubnetPrefix(subnetNum=1)
@@ -1242,18 +1269,20 @@ class WeaveDevice(Node):
     def weaveSubnetPrefix(self, subnetNum):
         return makeIP6Prefix(ulaPrefix, networkNum=self.fabricAddrGlobalId, subnetNum=subnetNum, prefixLen=64)
     
-    def weaveInterfaceAddress(self, subnetNum):
+    def weaveInterfaceAddress(self, subnetNum, nodeId=None):
         subnetPrefix = self.weaveSubnetPrefix(subnetNum)
+        if nodeId == None:
+            nodeId = self.weaveNodeId
         
         # As a convenience to testing, interface addresses for Weave nodes with a node id less than 65536
         # are considered 'local', and therefore have their universal/local bit is set to zero.  This simplifies
         # the string representation of the corresponding IPv6 addresses. For example a WiFi ULA for a node
         # with a node id of 10 would be FD00:0:1:1::A, instead of FD00:0:1:1:0200::A.  This behavior matches
         # the behavior of the C++ Weave code.
-        if self.weaveNodeId < 65536:
-            iid = self.weaveNodeId              # 'test' node id, generate 'local' iid
+        if nodeId < 65536:
+            iid = nodeId                        # 'test' node id, generate 'local' iid
         else:
-            iid = self.weaveNodeId | (1 << 57)  # 'real' node id, generate 'universal' iid
+            iid = nodeId | (1 << 57)            # 'real' node id, generate 'universal' iid
 
         a = makeIP6InterfaceAddress(subnetPrefix, iid=iid, prefixLen=64)
         return a 
@@ -1321,10 +1350,15 @@ class WeaveDevice(Node):
         if self.useLwIP:
             weaveConfig += self.getLwIPConfig()
         environ['WEAVE_CONFIG'] = weaveConfig
+        if self.weaveNodeCount > 1:
+            environ['WEAVE_SWARM_CONFIG'] = '--node-count %d ' % self.weaveNodeCount
 
     def summary(self, prefix=''):
         s = Node.summary(self, prefix)
-        s += '%s  Weave Node Id: %016X\n' % (prefix, self.weaveNodeId)
+        if self.weaveNodeCount > 1:
+            s += '%s  Weave Node Ids: %016X - %016X (%d nodes)\n' % (prefix, self.weaveNodeId, self.weaveNodeId + self.weaveNodeCount - 1, self.weaveNodeCount)
+        else:
+            s += '%s  Weave Node Id: %016X\n' % (prefix, self.weaveNodeId)
         s += '%s  Weave Fabric Id: %016X\n' % (prefix, self.weaveFabricId)
         return s
 
@@ -1746,6 +1780,15 @@ def deleteInterface(name, nsName=None):
 def assignAddressToInterface(ifName, addr, nsName=None):
     runCmd([ 'ip', 'addr', 'add', str(addr), 'dev', ifName ], errMsg='Unable to assign address %s to interface %s in namespace %s' % (addr, ifName, nsName), nsName=nsName)
     
+def assignAddressesToInterface(ifName, addrs, nsName=None):
+    # Assign the addresses with a single invocation of ip, skipping duplicate address detection so that
+    # they can be bound as soon as they are assigned.
+    with tempfile.NamedTemporaryFile(prefix='simnet-', suffix='.batch') as batchFile:
+        for a in addrs:
+            batchFile.write('addr add %s dev %s nodad\n' % (a, ifName))
+        batchFile.flush()
+        runCmd([ 'ip', '-batch', batchFile.name ], errMsg='Unable to assign %d addresses to interface %s' % (len(addrs), ifName), nsName=nsName)
+
 def removeAddressFromInterface(ifName, addr, nsName=None):
     runCmd([ 'ip', 'addr', 'del', str(addr), 'dev', ifName ], errMsg='Unable to remove address %s from interface %s in namespace %s' % (addr, ifName, nsName), nsName=nsName)
 
@@ -32,6 +32,7 @@
 #include <getopt.h>
 #include <inttypes.h>
 #include <limits.h>
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
@@ -46,11 +47,16 @@ using namespace nl::Weave::ASN1;
 #define CMD_NAME "weave gen-provisioning-data"
 
 static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
-static bool OutputProvisioningData(FILE *outFile, uint64_t devId, X509 *caCert, EVP_PKEY *caKey, const char *curveName,
-                                   const struct tm& validFrom, uint32_t validDays,
-                                   const char *sigType, const EVP_MD *sigHashAlgo,
-                                   CertFormat certFormat, KeyFormat keyFormat,
-                                   uint32_t pairingCodeLen);
+static bool MakeProvisioningData(uint64_t devId, X509 *caCert, EVP_PKEY *caKey, const char *curveName,
+                                 const struct tm& validFrom, uint32_t validDays,
+                                 const char *sigType, const EVP_MD *sigHashAlgo,
+                                 CertFormat certFormat, KeyFormat keyFormat,
+                                 uint32_t pairingCodeLen, char *& record);
+static bool OutputProvisioningData(FILE *outFile, X509 *caCert, EVP_PKEY *caKey);
+static bool OutputProvisioningDataParallel(FILE *outFile, X509 *caCert, EVP_PKEY *caKey);
+static void *ProvisioningDataWorker(void *arg);
+static bool ReadDeviceIdList(const char *fileName);
+static uint64_t GetDeviceId(int32_t index);
 static char *GeneratePairingCode(uint32_t pairingCodeLen);
 static char *GeneratePermissions(uint64_t devId);
 
@@ -63,10 +69,16 @@ enum
     kToolOpt_PKCS8Key   = 1004,
 };
 
+// The number of records each worker thread may generate ahead of the record being
+// written, when generating in parallel.
+#define RECORDS_AHEAD_PER_JOB 16
+
 static OptionDef gCmdOptionDefs[] =
 {
     { "dev-id",            kArgumentRequired, 'i'                   },
     { "count",             kArgumentRequired, 'c'                   },
+    { "dev-list",          kArgumentRequired, 'L'                   },
+    { "jobs",              kArgumentRequired, 'j'                   },
     { "ca-cert",           kArgumentRequired, 'C'                   },
     { "ca-key",            kArgumentRequired, 'K'                   },
     { "out",               kArgumentRequired, 'o'                   },
@@ -95,6 +107,21 @@ static const char *const gCmdOptionHelp =
     "\n"
     "       The number of devices for which provisioning data should be generated.\n"
     "\n"
+    "   -L, --dev-list <file>\n"
+    "\n"
+    "       File containing the ids (in hex) of the devices for which provisioning data\n"
+    "       should be generated, one per line.  Only the first comma-separated field of\n"
+    "       each line is read, so a CSV file may be given.  Blank lines, lines starting\n"
+    "       with '#' and a header line are ignored.  May be used in place of the --dev-id\n"
+    "       and --count options.\n"
+    "\n"
+    "   -j, --jobs <num>\n"
+    "\n"
+    "       The number of threads used to generate the provisioning data.  The CA key\n"
+    "       is loaded once and shared by all threads, and the data is written in device\n"
+    "       order whatever the number of threads.  0 means one thread per CPU.\n"
+    "       Default is 1.\n"
+    "\n"
     "   -C, --ca-cert <file>\n"
     "\n"
     "       File containing CA certificate to be used to sign device certificates.\n"
@@ -193,6 +220,9 @@ static OptionSet *gCmdOptionSets[] =
 
 static uint64_t gDevId = 0;
 static int32_t gDevCount = 0;
+static const char *gDevListFileName = NULL;
+static uint64_t *gDevIdList = NULL;
+static int32_t gJobCount = 1;
 static const char *gCurveName = NULL;
 static const char *gCACertFileName = NULL;
 static const char *gCAKeyFileName = NULL;
@@ -234,16 +264,31 @@ bool Cmd_GenProvisioningData(int argc, char *argv[])
         ExitNow(res = false);
     }
 
-    if (gDevId == 0)
+    if (gDevListFileName != NULL)
     {
-        fprintf(stderr, "Please specify the starting device id using the --dev-id option.\n");
-        ExitNow(res = false);
+        if (gDevId != 0 || gDevCount != 0)
+        {
+            fprintf(stderr, "The --dev-list option cannot be combined with the --dev-id or --count options.\n");
+            ExitNow(res = false);
+        }
+
+        if (!ReadDeviceIdList(gDevListFileName))
+            ExitNow(res = false);
     }
 
-    if (gDevCount == 0)
+    else
     {
-        fprintf(stderr, "Please specify the number of devices device id using the --count option.\n");
-        ExitNow(res = false);
+        if (gDevId == 0)
+        {
+            fprintf(stderr, "Please specify the starting device id using the --dev-id option.\n");
+            ExitNow(res = false);
+        }
+
+        if (gDevCount == 0)
+        {
+            fprintf(stderr, "Please specify the number of devices device id using the --count option.\n");
+            ExitNow(res = false);
+        }
     }
 
     if (gCACertFileName == NULL)
@@ -334,17 +379,33 @@ bool Cmd_GenProvisioningData(int argc, char *argv[])
         ExitNow(res = false);
     }
 
-    for (int32_t i = 0; i < gDevCount; i++)
-        if (!OutputProvisioningData(outFile, gDevId + i,
-                caCert, caKey,
-                gCurveName,
-                gValidFrom, gValidDays,
-                gSigType, gSigHashAlgo,
-                gCertFormat, gKeyFormat,
-                gPairingCodeLen))
+    if (gJobCount == 0)
+    {
+        long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+        gJobCount = (cpuCount > 0) ? (int32_t)cpuCount : 1;
+    }
+
+    if (gJobCount > gDevCount)
+        gJobCount = gDevCount;
+
+    if (gJobCount > 1)
+    {
+        if (!OutputProvisioningDataParallel(outFile, caCert, caKey))
             ExitNow(res = false);
+    }
+
+    else
+    {
+        if (!OutputProvisioningData(outFile, caCert, caKey))
+            ExitNow(res = false);
+    }
 
 exit:
+    if (gDevIdList != NULL)
+    {
+        free(gDevIdList);
+        gDevIdList = NULL;
+    }
     if (caCert != NULL)
         X509_free(caCert);
     if (caKey != NULL)
@@ -374,6 +435,16 @@ bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *n
             return false;
         }
         break;
+    case 'L':
+        gDevListFileName = arg;
+        break;
+    case 'j':
+        if (!ParseInt(arg, gJobCount) || gJobCount < 0)
+        {
+            PrintArgError("%s: Invalid value specified for job count: %s\n", progName, arg);
+            return false;
+        }
+        break;
     case 'C':
         gCACertFileName = arg;
         break;
@@ -446,11 +517,15 @@ bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *n
     return true;
 }
 
-bool OutputProvisioningData(FILE *outFile, uint64_t devId, X509 *caCert, EVP_PKEY *caKey, const char *curveName,
-                            const struct tm& validFrom, uint32_t validDays,
-                            const char *sigType, const EVP_MD *sigHashAlgo,
-                            CertFormat certFormat, KeyFormat keyFormat,
-                            uint32_t pairingCodeLen)
+/**
+ * Generate the key, certificate and pairing code for a device, and format them as a
+ * line of provisioning data.  The line is returned in a malloc'd string.
+ */
+bool MakeProvisioningData(uint64_t devId, X509 *caCert, EVP_PKEY *caKey, const char *curveName,
+                          const struct tm& validFrom, uint32_t validDays,
+                          const char *sigType, const EVP_MD *sigHashAlgo,
+                          CertFormat certFormat, KeyFormat keyFormat,
+                          uint32_t pairingCodeLen, char *& record)
 {
     bool res = true;
     X509 *devCert = NULL;
@@ -464,6 +539,8 @@ bool OutputProvisioningData(FILE *outFile, uint64_t devId, X509 *caCert, EVP_PKE
     char *pairingCode = NULL;
     char *perms = NULL;
 
+    record = NULL;
+
     if (!MakeDeviceCert(devId, caCert, caKey, curveName, validFrom, validDays, sigHashAlgo, devCert, devKey))
         ExitNow(res = false);
 
@@ -504,10 +581,10 @@ bool OutputProvisioningData(FILE *outFile, uint64_t devId, X509 *caCert, EVP_PKE
     if (pairingCode == NULL)
         ExitNow(res = false);
 
-    if (fprintf(outFile, "%016" PRIX64 ",%s,%s,%s,%s,%s\n", devId, encodedCertB64, encodedKeyB64, perms, pairingCode, sigType) < 0 ||
-        ferror(outFile))
+    if (asprintf(&record, "%016" PRIX64 ",%s,%s,%s,%s,%s\n", devId, encodedCertB64, encodedKeyB64, perms, pairingCode, sigType) < 0)
     {
-        fprintf(stderr, "Error writing to output file: %s\n", strerror(errno));
+        record = NULL;
+        fprintf(stderr, "Memory allocation error\n");
         ExitNow(res = false);
     }
 
@@ -531,6 +608,304 @@ exit:
     return res;
 }
 
+static bool WriteRecord(FILE *outFile, const char *record)
+{
+    if (fputs(record, outFile) < 0 || ferror(outFile))
+    {
+        fprintf(stderr, "Error writing to output file: %s\n", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+bool OutputProvisioningData(FILE *outFile, X509 *caCert, EVP_PKEY *caKey)
+{
+    bool res = true;
+    char *record = NULL;
+
+    for (int32_t i = 0; i < gDevCount; i++)
+    {
+        if (!MakeProvisioningData(GetDeviceId(i),
+                caCert, caKey,
+                gCurveName,
+                gValidFrom, gValidDays,
+                gSigType, gSigHashAlgo,
+                gCertFormat, gKeyFormat,
+                gPairingCodeLen, record))
+            ExitNow(res = false);
+
+        if (!WriteRecord(outFile, record))
+            ExitNow(res = false);
+
+        free(record);
+        record = NULL;
+    }
+
+exit:
+    if (record != NULL)
+        free(record);
+    return res;
+}
+
+/**
+ * State shared between the worker threads that generate provisioning data and the
+ * thread that writes it out.
+ *
+ * Workers claim devices in order, and leave each record in the slot for its device,
+ * in a window of slots that follows the next record to be written.  A worker waits
+ * before claiming a device beyond the end of the window, so that the memory held by
+ * records waiting to be written stays bounded however many devices are generated.
+ */
+struct ProvisioningDataJobs
+{
+    pthread_mutex_t Lock;
+    pthread_cond_t RecordReady;
+    pthread_cond_t SlotFree;
+    X509 *CACert;
+    EVP_PKEY *CAKey;
+    char **Records;
+    int32_t WindowSize;
+    int32_t NextIndex;
+    int32_t WriteIndex;
+    bool Failed;
+};
+
+bool OutputProvisioningDataParallel(FILE *outFile, X509 *caCert, EVP_PKEY *caKey)
+{
+    bool res = true;
+    ProvisioningDataJobs jobs;
+    pthread_t *threads = NULL;
+    int32_t threadCount = 0;
+    char *record;
+
+    if (!InitOpenSSLThreads())
+        return false;
+
+    pthread_mutex_init(&jobs.Lock, NULL);
+    pthread_cond_init(&jobs.RecordReady, NULL);
+    pthread_cond_init(&jobs.SlotFree, NULL);
+    jobs.CACert = caCert;
+    jobs.CAKey = caKey;
+    jobs.WindowSize = gJobCount * RECORDS_AHEAD_PER_JOB;
+    jobs.NextIndex = 0;
+    jobs.WriteIndex = 0;
+    jobs.Failed = false;
+
+    jobs.Records = (char **)calloc(jobs.WindowSize, sizeof(char *));
+    threads = (pthread_t *)calloc(gJobCount, sizeof(pthread_t));
+    if (jobs.Records == NULL || threads == NULL)
+    {
+        fprintf(stderr, "Memory allocation error\n");
+        ExitNow(res = false);
+    }
+
+    for (; threadCount < gJobCount; threadCount++)
+    {
+        int err = pthread_create(&threads[threadCount], NULL, ProvisioningDataWorker, &jobs);
+        if (err != 0)
+        {
+            fprintf(stderr, "Unable to start worker thread: %s\n", strerror(err));
+            ExitNow(res = false);
+        }
+    }
+
+    // Write the records out in device order, as they become available.
+    pthread_mutex_lock(&jobs.Lock);
+    while (jobs.WriteIndex < gDevCount && !jobs.Failed)
+    {
+        char *& slot = jobs.Records[jobs.WriteIndex % jobs.WindowSize];
+
+        if (slot == NULL)
+        {
+            pthread_cond_wait(&jobs.RecordReady, &jobs.Lock);
+            continue;
+        }
+
+        record = slot;
+        slot = NULL;
+        pthread_mutex_unlock(&jobs.Lock);
+
+        res = WriteRecord(outFile, record);
+        free(record);
+
+        pthread_mutex_lock(&jobs.Lock);
+        if (!res)
+            jobs.Failed = true;
+        jobs.WriteIndex++;
+        pthread_cond_broadcast(&jobs.SlotFree);
+    }
+    if (jobs.Failed)
+        res = false;
+    pthread_mutex_unlock(&jobs.Lock);
+
+exit:
+    if (!res)
+    {
+        pthread_mutex_lock(&jobs.Lock);
+        jobs.Failed = true;
+        pthread_cond_broadcast(&jobs.SlotFree);
+        pthread_mutex_unlock(&jobs.Lock);
+    }
+    for (int32_t i = 0; i < threadCount; i++)
+        pthread_join(threads[i], NULL);
+    if (jobs.Records != NULL)
+    {
+        for (int32_t i = 0; i < jobs.WindowSize; i++)
+            if (jobs.Records[i] != NULL)
+                free(jobs.Records[i]);
+        free(jobs.Records);
+    }
+    if (threads != NULL)
+        free(threads);
+    pthread_cond_destroy(&jobs.SlotFree);
+    pthread_cond_destroy(&jobs.RecordReady);
+    pthread_mutex_destroy(&jobs.Lock);
+    return res;
+}
+
+void *ProvisioningDataWorker(void *arg)
+{
+    ProvisioningDataJobs *jobs = (ProvisioningDataJobs *)arg;
+    int32_t index;
+    char *record;
+    bool res;
+
+    pthread_mutex_lock(&jobs->Lock);
+
+    while (true)
+    {
+        if (jobs->Failed || jobs->NextIndex >= gDevCount)
+            break;
+
+        if (jobs->NextIndex >= jobs->WriteIndex + jobs->WindowSize)
+        {
+            pthread_cond_wait(&jobs->SlotFree, &jobs->Lock);
+            continue;
+        }
+
+        index = jobs->NextIndex++;
+        pthread_mutex_unlock(&jobs->Lock);
+
+        res = MakeProvisioningData(GetDeviceId(index),
+                jobs->CACert, jobs->CAKey,
+                gCurveName,
+                gValidFrom, gValidDays,
+                gSigType, gSigHashAlgo,
+                gCertFormat, gKeyFormat,
+                gPairingCodeLen, record);
+
+        pthread_mutex_lock(&jobs->Lock);
+
+        if (!res)
+        {
+            jobs->Failed = true;
+            pthread_cond_broadcast(&jobs->SlotFree);
+            pthread_cond_signal(&jobs->RecordReady);
+            break;
+        }
+
+        jobs->Records[index % jobs->WindowSize] = record;
+        if (index == jobs->WriteIndex)
+            pthread_cond_signal(&jobs->RecordReady);
+    }
+
+    pthread_mutex_unlock(&jobs->Lock);
+
+    return NULL;
+}
+
+bool ReadDeviceIdList(const char *fileName)
+{
+    bool res = true;
+    uint8_t *fileData = NULL;
+    uint8_t *newData;
+    uint32_t fileLen;
+    char *line;
+    char *lineEnd;
+    char *fieldEnd;
+    int32_t lineNum = 0;
+    int32_t listSize = 0;
+    uint64_t *newList;
+
+    if (!ReadFileIntoMem(fileName, fileData, fileLen))
+        ExitNow(res = false);
+
+    // Make room for the terminator.
+    newData = (uint8_t *)realloc(fileData, fileLen + 1);
+    if (newData == NULL)
+    {
+        fprintf(stderr, "Memory allocation error\n");
+        ExitNow(res = false);
+    }
+    fileData = newData;
+    fileData[fileLen] = 0;
+
+    gDevCount = 0;
+
+    for (line = (char *)fileData; *line != 0; line = lineEnd)
+    {
+        uint64_t devId;
+
+        lineNum++;
+
+        lineEnd = line + strcspn(line, "\r\n");
+        if (*lineEnd != 0)
+            *lineEnd++ = 0;
+
+        while (isspace(*line))
+            line++;
+
+        if (*line == 0 || *line == '#')
+            continue;
+
+        fieldEnd = line + strcspn(line, ",");
+        *fieldEnd = 0;
+        while (fieldEnd > line && isspace(fieldEnd[-1]))
+            *--fieldEnd = 0;
+
+        if (!ParseEUI64(line, devId) || devId == 0)
+        {
+            // Skip the header line of a CSV file.
+            if (gDevCount == 0 && !isxdigit(*line))
+                continue;
+
+            fprintf(stderr, "weave: Invalid device id on line %d of %s: %s\n", (int)lineNum, fileName, line);
+            ExitNow(res = false);
+        }
+
+        if (gDevCount == listSize)
+        {
+            listSize = (listSize != 0) ? listSize * 2 : 1024;
+            newList = (uint64_t *)realloc(gDevIdList, listSize * sizeof(uint64_t));
+            if (newList == NULL)
+            {
+                fprintf(stderr, "Memory allocation error\n");
+                ExitNow(res = false);
+            }
+            gDevIdList = newList;
+        }
+
+        gDevIdList[gDevCount++] = devId;
+    }
+
+    if (gDevCount == 0)
+    {
+        fprintf(stderr, "weave: No device ids found in %s\n", fileName);
+        ExitNow(res = false);
+    }
+
+exit:
+    if (fileData != NULL)
+        free(fileData);
+    return res;
+}
+
+uint64_t GetDeviceId(int32_t index)
+{
+    return (gDevIdList != NULL) ? gDevIdList[index] : gDevId + index;
+}
+
 char *GeneratePairingCode(uint32_t pairingCodeLen)
 {
     char *pairingCode;
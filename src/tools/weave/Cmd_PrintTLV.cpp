@@ -33,6 +33,8 @@
 #include <sys/types.h>
 
 #include <Weave/Core/WeaveTLVDebug.hpp>
+#include <Weave/Core/WeaveTLVJson.hpp>
+#include <Weave/Core/WeaveTLVUtilities.hpp>
 #include <Weave/Support/Base64.h>
 
 #include "weave-tool.h"
@@ -44,10 +46,26 @@ using namespace nl::Weave::TLV;
 static bool HandleNonOptionArgs(const char *progName, int argc, char *argv[]);
 static bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg);
 static void _DumpWriter(const char *aFormat, ...);
+static WEAVE_ERROR _JsonOutput(const char *aData, size_t aDataLen, void *aContext);
+static bool ParseTagPath(const char *aPath);
+static WEAVE_ERROR PrintMatchingElements(TLVReader &aReader, uint32_t aDepth);
+static WEAVE_ERROR PrintElement(const TLVReader &aReader);
+static WEAVE_ERROR DumpContentsHandler(const TLVReader &aReader, size_t aDepth, void *aContext);
+
+// The maximum number of components in a tag path given with --path.
+#define MAX_TAG_PATH_LEN 32
+
+// The size of the stdio buffer used for output.
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+// A tag path component that matches any tag.
+static const uint64_t kAnyTag = UINT64_MAX;
 
 static OptionDef gCmdOptionDefs[] =
 {
     { "base64", kNoArgument, 'b' },
+    { "json",   kNoArgument, 'j' },
+    { "path",   kArgumentRequired, 'p' },
     { }
 };
 
@@ -56,6 +74,27 @@ static const char *const gCmdOptionHelp =
     "\n"
     "       The file containing the TLV should be parsed as base64.\n"
     "\n"
+    "   -j, --json\n"
+    "\n"
+    "       Print the TLV as JSON, one line per top-level element.\n"
+    "\n"
+    "   -p, --path <tag-path>\n"
+    "\n"
+    "       Print only the elements at the given tag path, and their contents.  The\n"
+    "       path is a list of tags separated by '/', starting from the top-level\n"
+    "       elements, where each tag is one of:\n"
+    "\n"
+    "           <num>               A context tag.\n"
+    "           <profile>:<num>     A profile tag.\n"
+    "           *                   Any tag, including anonymous.\n"
+    "\n"
+    "       Numbers may be given in decimal or, with a 0x prefix, in hex; e.g.\n"
+    "       '*/0x235A0000:1/2'.  With --json, each matching element is printed on\n"
+    "       a line of its own.\n"
+    "\n"
+    "       The input is walked in place, skipping over elements off the path, so\n"
+    "       large inputs such as event log captures are filtered in constant memory.\n"
+    "\n"
     ;
 
 static OptionSet gCmdOptions =
@@ -90,6 +129,10 @@ static OptionSet *gCmdOptionSets[] =
 
 static const char *gFileName = NULL;
 static bool gUseBase64Decoding = false;
+static bool gPrintJson = false;
+static uint64_t gTagPath[MAX_TAG_PATH_LEN];
+static uint32_t gTagPathLen = 0;
+static const nl::Weave::TLV::Json::ConvertContext gJsonContext = { _JsonOutput, NULL, NULL, NULL };
 
 bool Cmd_PrintTLV(int argc, char *argv[])
 {
@@ -100,6 +143,7 @@ bool Cmd_PrintTLV(int argc, char *argv[])
     struct stat st;
     TLVReader reader;
     uint32_t len;
+    WEAVE_ERROR err;
 
     if (argc == 1)
     {
@@ -125,13 +169,27 @@ bool Cmd_PrintTLV(int argc, char *argv[])
         ExitNow(res = false);
     }
 
+    if (st.st_size == 0)
+    {
+        fprintf(stderr, "weave: %s is empty\n", gFileName);
+        close(fd);
+        ExitNow(res = false);
+    }
+
     map = static_cast<uint8_t *>(mmap(0, st.st_size, PROT_READ, MAP_SHARED, fd, 0));
+    close(fd);
     if (!map || map == MAP_FAILED)
     {
-        close(fd);
+        map = NULL;
+        fprintf(stderr, "weave: Error mapping %s: %s\n", gFileName, strerror(errno));
         ExitNow(res = false);
     }
 
+    // The input is read front to back, once.
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+    setvbuf(stdout, NULL, _IOFBF, OUTPUT_BUFFER_SIZE);
+
     if (gUseBase64Decoding)
     {
         raw = (uint8_t *)malloc(st.st_size);
@@ -143,11 +201,38 @@ bool Cmd_PrintTLV(int argc, char *argv[])
         raw = map;
     }
 
-    printf("TLV length is %d bytes\n", len);
     reader.Init(raw, len);
-    nl::Weave::TLV::Debug::Dump(reader, _DumpWriter);
+
+    if (gTagPathLen != 0)
+    {
+        if (!gPrintJson)
+            printf("TLV length is %d bytes\n", len);
+
+        err = PrintMatchingElements(reader, 0);
+        if (err != WEAVE_NO_ERROR)
+        {
+            fprintf(stderr, "weave: Error reading %s: %s\n", gFileName, nl::ErrorStr(err));
+            ExitNow(res = false);
+        }
+    }
+    else if (gPrintJson)
+    {
+        err = nl::Weave::TLV::Json::TLVToJson(reader, gJsonContext);
+        if (err != WEAVE_NO_ERROR)
+        {
+            fprintf(stderr, "weave: Error converting %s to JSON: %s\n", gFileName, nl::ErrorStr(err));
+            ExitNow(res = false);
+        }
+    }
+    else
+    {
+        printf("TLV length is %d bytes\n", len);
+        nl::Weave::TLV::Debug::Dump(reader, _DumpWriter);
+    }
 
 exit:
+    fflush(stdout);
+
     if (raw != NULL && raw != map)
     {
         free(raw);
@@ -180,6 +265,159 @@ static bool HandleNonOptionArgs(const char *progName, int argc, char *argv[])
     return true;
 }
 
+/**
+ * Print the elements at the tag path given with --path, among the elements at the
+ * reader's position and depth.
+ *
+ * Elements off the path are skipped without being decoded, and the elements on it
+ * are printed straight from the input, so the walk needs no memory beyond the stack.
+ */
+static WEAVE_ERROR PrintMatchingElements(TLVReader &aReader, uint32_t aDepth)
+{
+    WEAVE_ERROR err;
+    TLVType containerType;
+
+    while ((err = aReader.Next()) == WEAVE_NO_ERROR)
+    {
+        if (gTagPath[aDepth] != kAnyTag && gTagPath[aDepth] != aReader.GetTag())
+            continue;
+
+        if (aDepth + 1 == gTagPathLen)
+        {
+            err = PrintElement(aReader);
+            SuccessOrExit(err);
+        }
+        else if (TLVTypeIsContainer(aReader.GetType()))
+        {
+            err = aReader.EnterContainer(containerType);
+            SuccessOrExit(err);
+
+            err = PrintMatchingElements(aReader, aDepth + 1);
+            SuccessOrExit(err);
+
+            err = aReader.ExitContainer(containerType);
+            SuccessOrExit(err);
+        }
+    }
+
+    if (err == WEAVE_END_OF_TLV)
+        err = WEAVE_NO_ERROR;
+
+exit:
+    return err;
+}
+
+/**
+ * Print the element the reader is positioned on, and its contents.
+ */
+static WEAVE_ERROR PrintElement(const TLVReader &aReader)
+{
+    WEAVE_ERROR err = WEAVE_NO_ERROR;
+    nl::Weave::TLV::Debug::DumpContext dumpContext = { _DumpWriter, NULL };
+    TLVReader container;
+    TLVReader contents;
+
+    if (gPrintJson)
+    {
+        err = nl::Weave::TLV::Json::ElementToJson(aReader, gJsonContext);
+        ExitNow();
+    }
+
+    err = nl::Weave::TLV::Debug::DumpHandler(aReader, 0, &dumpContext);
+    SuccessOrExit(err);
+
+    if (TLVTypeIsContainer(aReader.GetType()))
+    {
+        container.Init(aReader);
+
+        err = container.OpenContainer(contents);
+        SuccessOrExit(err);
+
+        err = nl::Weave::TLV::Utilities::Iterate(contents, DumpContentsHandler, &dumpContext);
+        if (err == WEAVE_END_OF_TLV)
+            err = WEAVE_NO_ERROR;
+    }
+
+exit:
+    return err;
+}
+
+/**
+ * Dump an element within a matched container, one level deeper than it is found by
+ * the iteration over the container's contents.
+ */
+static WEAVE_ERROR DumpContentsHandler(const TLVReader &aReader, size_t aDepth, void *aContext)
+{
+    return nl::Weave::TLV::Debug::DumpHandler(aReader, aDepth + 1, aContext);
+}
+
+static bool ParseTagPath(const char *aPath)
+{
+    const char *p = aPath;
+    char *parseEnd;
+    unsigned long profileId;
+    unsigned long tagNum;
+
+    gTagPathLen = 0;
+
+    if (*p == '/')
+        p++;
+
+    while (*p != 0)
+    {
+        if (gTagPathLen == MAX_TAG_PATH_LEN)
+            return false;
+
+        if (*p == '*')
+        {
+            gTagPath[gTagPathLen] = kAnyTag;
+            p++;
+        }
+        else
+        {
+            errno = 0;
+            tagNum = strtoul(p, &parseEnd, 0);
+            if (parseEnd == p || errno != 0 || tagNum > UINT32_MAX)
+                return false;
+            p = parseEnd;
+
+            if (*p == ':')
+            {
+                p++;
+                profileId = tagNum;
+                tagNum = strtoul(p, &parseEnd, 0);
+                if (parseEnd == p || errno != 0 || tagNum > UINT32_MAX)
+                    return false;
+                p = parseEnd;
+
+                gTagPath[gTagPathLen] = ProfileTag((uint32_t)profileId, (uint32_t)tagNum);
+            }
+            else
+            {
+                if (tagNum > UINT8_MAX)
+                    return false;
+
+                gTagPath[gTagPathLen] = ContextTag((uint8_t)tagNum);
+            }
+        }
+
+        gTagPathLen++;
+
+        if (*p == '/')
+        {
+            p++;
+            if (*p == 0)
+                return false;
+        }
+        else if (*p != 0)
+        {
+            return false;
+        }
+    }
+
+    return gTagPathLen != 0;
+}
+
 static void _DumpWriter(const char *aFormat, ...)
 {
     va_list args;
@@ -191,6 +429,14 @@ static void _DumpWriter(const char *aFormat, ...)
     va_end(args);
 }
 
+static WEAVE_ERROR _JsonOutput(const char *aData, size_t aDataLen, void *aContext)
+{
+    if (fwrite(aData, 1, aDataLen, stdout) != aDataLen)
+        return nl::Weave::System::MapErrorPOSIX(errno);
+
+    return WEAVE_NO_ERROR;
+}
+
 bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *name, const char *arg)
 {
     switch (id)
@@ -199,6 +445,18 @@ bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *n
         gUseBase64Decoding = true;
         break;
 
+    case 'j':
+        gPrintJson = true;
+        break;
+
+    case 'p':
+        if (!ParseTagPath(arg))
+        {
+            PrintArgError("%s: Invalid value specified for tag path: %s\n", progName, arg);
+            return false;
+        }
+        break;
+
     default:
         PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", progName, name);
         return false;
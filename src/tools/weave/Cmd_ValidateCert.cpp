@@ -19,7 +19,7 @@
 /**
  *    @file
  *      This file implements the command handler for the 'weave' tool
- *      that validates a Weave certificate.
+ *      that validates one or more Weave certificates.
  *
  */
 
@@ -29,6 +29,8 @@
 #include <getopt.h>
 #include <errno.h>
 #include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
 
 #include "weave-tool.h"
 #include <Weave/Support/ASN1OID.h>
@@ -46,6 +48,8 @@ static OptionDef gCmdOptionDefs[] =
 {
     { "cert",           kArgumentRequired,  'c' },
     { "trusted-cert",   kArgumentRequired,  't' },
+    { "cert-list",      kArgumentRequired,  'l' },
+    { "jobs",           kArgumentRequired,  'j' },
     { "verbose",        kNoArgument,        'V' },
     { }
 };
@@ -61,9 +65,21 @@ static const char *const gCmdOptionHelp =
     "       A file containing a trusted Weave certificate to be used during\n"
     "       validation. The file must be in base-64 or TLV format.\n"
     "\n"
+    "  -l, --cert-list <file>\n"
+    "\n"
+    "       A file containing the names of certificate files to be validated,\n"
+    "       one per line, in addition to those given as arguments.\n"
+    "\n"
+    "  -j, --jobs <num>\n"
+    "\n"
+    "       The number of processes among which the validation of multiple\n"
+    "       target certificates is divided. Defaults to 1.\n"
+    "\n"
     "  -V, --verbose\n"
     "\n"
     "       Display detailed validation results for each input certificate.\n"
+    "       When validating multiple target certificates, report each result,\n"
+    "       rather than only failures.\n"
     "\n"
     ;
 
@@ -77,10 +93,14 @@ static OptionSet gCmdOptions =
 
 static HelpOptions gHelpOptions(
     CMD_NAME,
-    "Usage: " CMD_NAME " [ <options...> ] <target-cert-file>\n",
+    "Usage: " CMD_NAME " [ <options...> ] <target-cert-file>...\n",
     WEAVE_VERSION_STRING "\n" COPYRIGHT_STRING,
     "Validate a chain of Weave certificates.\n"
     "\n"
+    "When more than one target certificate is given, the CA certificates are\n"
+    "loaded once and used to validate each target in turn, and a summary of\n"
+    "the results is displayed.\n"
+    "\n"
     "ARGUMENTS\n"
     "\n"
     "  <target-cert-file>\n"
@@ -98,13 +118,301 @@ static OptionSet *gCmdOptionSets[] =
 };
 
 
-enum { kMaxCerts = 64 };
+enum { kMaxCerts = 64, kMaxJobs = 256, kMaxErrorKinds = 32 };
+
+// The result of validating one target certificate in batch mode.
+struct BatchResult
+{
+    uint32_t Index;                 // Index of the target certificate file name
+    bool Loaded;                    // Whether the certificate could be read and decoded
+    WEAVE_ERROR Err;                // The result of validation, if the certificate was loaded
+};
 
 static const char *gTargetCertFileName = NULL;
 static const char *gCACertFileNames[kMaxCerts];
 static bool gCACertIsTrusted[kMaxCerts];
 static size_t gNumCertFileNames = 0;
+static const char *gCertListFileName = NULL;
+static int gNumJobs = 1;
 static bool gVerbose = false;
+static char **gTargetCertFileNames = NULL;
+static size_t gNumTargetCertFileNames = 0;
+
+static bool AddTargetCertFileName(const char *fileName)
+{
+    char **newNames;
+    char *name;
+
+    if ((gNumTargetCertFileNames & (gNumTargetCertFileNames - 1)) == 0)
+    {
+        newNames = (char **)realloc(gTargetCertFileNames, sizeof(char *) * (gNumTargetCertFileNames == 0 ? 1 : 2 * gNumTargetCertFileNames));
+        if (newNames == NULL)
+            return false;
+        gTargetCertFileNames = newNames;
+    }
+
+    name = strdup(fileName);
+    if (name == NULL)
+        return false;
+
+    gTargetCertFileNames[gNumTargetCertFileNames++] = name;
+    return true;
+}
+
+static bool ReadCertList(const char *fileName)
+{
+    bool res = true;
+    FILE *file;
+    char line[1024];
+
+    file = fopen(fileName, "r");
+    if (file == NULL)
+    {
+        fprintf(stderr, "weave: Unable to open %s\n%s\n", fileName, strerror(errno));
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        size_t len = strlen(line);
+
+        while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+            line[--len] = 0;
+
+        if (len == 0)
+            continue;
+
+        if (!AddTargetCertFileName(line))
+        {
+            fprintf(stderr, "weave: Memory allocation failure\n");
+            ExitNow(res = false);
+        }
+    }
+
+    if (ferror(file))
+    {
+        fprintf(stderr, "weave: Unable to read %s\n%s\n", fileName, strerror(errno));
+        ExitNow(res = false);
+    }
+
+exit:
+    fclose(file);
+    return res;
+}
+
+// Validate a single target certificate against the CA certificates already in the set, leaving the set as it was.
+static void ValidateTargetCert(WeaveCertificateSet& certSet, uint32_t index, BatchResult& result)
+{
+    const uint8_t caCertCount = certSet.CertCount;
+    uint8_t *certBuf = NULL;
+    WeaveCertificateData *certToBeValidated;
+    WeaveCertificateData *validatedCert;
+    ValidationContext context;
+
+    result.Index = index;
+    result.Err = WEAVE_NO_ERROR;
+
+    result.Loaded = LoadWeaveCert(gTargetCertFileNames[index], false, certSet, certBuf);
+    if (!result.Loaded)
+        return;
+
+    certToBeValidated = certSet.LastCert();
+
+    memset(&context, 0, sizeof(context));
+    context.EffectiveTime = SecondsSinceEpochToPackedCertTime(time(NULL));
+
+    result.Err = certSet.FindValidCert(certToBeValidated->SubjectDN, certToBeValidated->SubjectKeyId, context, validatedCert);
+
+    certSet.Truncate(caCertCount);
+    free(certBuf);
+}
+
+// Validate every numJobs'th target certificate, starting with the first, writing the results to a pipe.
+static void RunBatchJob(WeaveCertificateSet& certSet, uint32_t first, uint32_t numJobs, int fd)
+{
+    for (uint32_t i = first; i < gNumTargetCertFileNames; i += numJobs)
+    {
+        BatchResult result;
+        const uint8_t *p = (const uint8_t *)&result;
+        size_t remaining = sizeof(result);
+
+        ValidateTargetCert(certSet, i, result);
+
+        while (remaining > 0)
+        {
+            ssize_t len = write(fd, p, remaining);
+            if (len < 0 && errno == EINTR)
+                continue;
+            if (len <= 0)
+                return;
+            p += len;
+            remaining -= len;
+        }
+    }
+}
+
+// Validate all target certificates, dividing the work among gNumJobs processes, and report the results.
+//
+// The validation of each target is independent, but certificate validation relies on process-wide state, such as
+// the cache of verified CA certificate signatures.  So rather than threads, each job is a child process, which
+// inherits the CA certificates loaded by the parent and validates each CA certificate signature at most once.
+static bool ValidateTargetCerts(WeaveCertificateSet& certSet)
+{
+    bool res = true;
+    BatchResult *results;
+    pid_t pids[kMaxJobs];
+    int fds[kMaxJobs];
+    uint32_t numJobs = (uint32_t)gNumJobs;
+    size_t numValid = 0, numInvalid = 0, numUnreadable = 0;
+    WEAVE_ERROR errKinds[kMaxErrorKinds];
+    size_t errKindCounts[kMaxErrorKinds];
+    size_t numErrKinds = 0, numOtherErrs = 0;
+
+    if (numJobs > gNumTargetCertFileNames)
+        numJobs = (uint32_t)gNumTargetCertFileNames;
+
+    results = (BatchResult *)calloc(gNumTargetCertFileNames, sizeof(BatchResult));
+    if (results == NULL)
+    {
+        fprintf(stderr, "weave: Memory allocation failure\n");
+        return false;
+    }
+
+    if (numJobs <= 1)
+    {
+        for (uint32_t i = 0; i < gNumTargetCertFileNames; i++)
+            ValidateTargetCert(certSet, i, results[i]);
+    }
+    else
+    {
+        uint32_t numStarted;
+
+        // Mark every result as missing until it has been received from a job.
+        for (uint32_t i = 0; i < gNumTargetCertFileNames; i++)
+            results[i].Index = UINT32_MAX;
+
+        // Make sure buffered output is not written twice.
+        fflush(stdout);
+        fflush(stderr);
+
+        for (numStarted = 0; numStarted < numJobs; numStarted++)
+        {
+            int pipeFds[2];
+
+            if (pipe(pipeFds) != 0)
+            {
+                fprintf(stderr, "weave: Unable to create pipe\n%s\n", strerror(errno));
+                break;
+            }
+
+            pids[numStarted] = fork();
+            if (pids[numStarted] == 0)
+            {
+                close(pipeFds[0]);
+                RunBatchJob(certSet, numStarted, numJobs, pipeFds[1]);
+                close(pipeFds[1]);
+                _exit(0);
+            }
+
+            close(pipeFds[1]);
+
+            if (pids[numStarted] < 0)
+            {
+                fprintf(stderr, "weave: Unable to start job\n%s\n", strerror(errno));
+                close(pipeFds[0]);
+                break;
+            }
+
+            fds[numStarted] = pipeFds[0];
+        }
+
+        // Each job writes only to its own pipe, so the results can be collected one job at a time.
+        for (uint32_t j = 0; j < numStarted; j++)
+        {
+            BatchResult result;
+            uint8_t *p = (uint8_t *)&result;
+            size_t received = 0;
+
+            while (true)
+            {
+                ssize_t len = read(fds[j], p + received, sizeof(result) - received);
+                if (len < 0 && errno == EINTR)
+                    continue;
+                if (len <= 0)
+                    break;
+                received += len;
+                if (received == sizeof(result))
+                {
+                    if (result.Index < gNumTargetCertFileNames)
+                        results[result.Index] = result;
+                    received = 0;
+                }
+            }
+
+            close(fds[j]);
+            waitpid(pids[j], NULL, 0);
+        }
+
+        // Validate any targets left over by a job that failed to start or stopped early.
+        for (uint32_t i = 0; i < gNumTargetCertFileNames; i++)
+            if (results[i].Index != i)
+                ValidateTargetCert(certSet, i, results[i]);
+    }
+
+    for (uint32_t i = 0; i < gNumTargetCertFileNames; i++)
+    {
+        const BatchResult& result = results[i];
+
+        if (!result.Loaded)
+        {
+            numUnreadable++;
+            printf("%s: Unable to load certificate\n", gTargetCertFileNames[i]);
+            continue;
+        }
+
+        if (result.Err == WEAVE_NO_ERROR)
+        {
+            numValid++;
+            if (gVerbose)
+                printf("%s: Valid\n", gTargetCertFileNames[i]);
+            continue;
+        }
+
+        numInvalid++;
+        printf("%s: %s\n", gTargetCertFileNames[i], nl::ErrorStr(result.Err));
+
+        {
+            size_t k;
+
+            for (k = 0; k < numErrKinds && errKinds[k] != result.Err; k++)
+                ;
+
+            if (k == numErrKinds && numErrKinds < kMaxErrorKinds)
+            {
+                errKinds[numErrKinds] = result.Err;
+                errKindCounts[numErrKinds++] = 0;
+            }
+
+            if (k < numErrKinds)
+                errKindCounts[k]++;
+            else
+                numOtherErrs++;
+        }
+    }
+
+    printf("\nValidated %u certificates: %u valid, %u invalid, %u unreadable.\n",
+           (unsigned)gNumTargetCertFileNames, (unsigned)numValid, (unsigned)numInvalid, (unsigned)numUnreadable);
+
+    for (size_t k = 0; k < numErrKinds; k++)
+        printf("  %8u  %s\n", (unsigned)errKindCounts[k], nl::ErrorStr(errKinds[k]));
+    if (numOtherErrs > 0)
+        printf("  %8u  Other errors\n", (unsigned)numOtherErrs);
+
+    res = (numValid == gNumTargetCertFileNames);
+
+    free(results);
+    return res;
+}
 
 bool Cmd_ValidateCert(int argc, char *argv[])
 {
@@ -130,6 +438,15 @@ bool Cmd_ValidateCert(int argc, char *argv[])
         ExitNow(res = false);
     }
 
+    if (gCertListFileName != NULL && !ReadCertList(gCertListFileName))
+        ExitNow(res = false);
+
+    if (gNumTargetCertFileNames == 0)
+    {
+        PrintArgError("%s: Please specify the name of the certificate to be validated.\n", CMD_NAME);
+        ExitNow(res = false);
+    }
+
     err = certSet.Init(kMaxCerts, 2048);
     if (err != WEAVE_NO_ERROR)
     {
@@ -143,6 +460,11 @@ bool Cmd_ValidateCert(int argc, char *argv[])
             ExitNow(res = false);
     }
 
+    if (gNumTargetCertFileNames > 1 || gCertListFileName != NULL)
+        ExitNow(res = ValidateTargetCerts(certSet));
+
+    gTargetCertFileName = gTargetCertFileNames[0];
+
     res = LoadWeaveCert(gTargetCertFileName, false, certSet, certBufs[certSet.CertCount]);
     if (!res)
         ExitNow(res = false);
@@ -177,6 +499,11 @@ exit:
     for (int i = 0; i < kMaxCerts; i++)
         if (certBufs[i] != NULL)
             free(certBufs[i]);
+    for (size_t i = 0; i < gNumTargetCertFileNames; i++)
+        free(gTargetCertFileNames[i]);
+    free(gTargetCertFileNames);
+    gTargetCertFileNames = NULL;
+    gNumTargetCertFileNames = 0;
     return res;
 }
 
@@ -189,6 +516,16 @@ bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *n
         gCACertFileNames[gNumCertFileNames] = arg;
         gCACertIsTrusted[gNumCertFileNames++] = (id == 't');
         break;
+    case 'l':
+        gCertListFileName = arg;
+        break;
+    case 'j':
+        if (!ParseInt(arg, gNumJobs) || gNumJobs < 1 || gNumJobs > kMaxJobs)
+        {
+            PrintArgError("%s: Invalid value specified for number of jobs: %s\n", progName, arg);
+            return false;
+        }
+        break;
     case 'V':
         gVerbose = true;
         break;
@@ -202,19 +539,14 @@ bool HandleOption(const char *progName, OptionSet *optSet, int id, const char *n
 
 bool HandleNonOptionArgs(const char *progName, int argc, char *argv[])
 {
-    if (argc == 0)
+    for (int i = 0; i < argc; i++)
     {
-        PrintArgError("%s: Please specify the name of the certificate to be validated.\n", progName);
-        return false;
+        if (!AddTargetCertFileName(argv[i]))
+        {
+            PrintArgError("%s: Memory allocation failure\n", progName);
+            return false;
+        }
     }
 
-    if (argc > 1)
-    {
-        PrintArgError("%s: Unexpected argument: %s\n", progName, argv[1]);
-        return false;
-    }
-
-    gTargetCertFileName = argv[0];
-
     return true;
 }
@@ -34,6 +34,7 @@
 #include <ctype.h>
 #include <getopt.h>
 #include <time.h>
+#include <pthread.h>
 
 #include "weave-tool.h"
 
@@ -108,6 +109,56 @@ exit:
     return res;
 }
 
+// Before version 1.1.0, OpenSSL relies on the application to supply the locks
+// that make it safe to use from multiple threads.
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+
+static pthread_mutex_t *sOpenSSLLocks = NULL;
+
+static void OpenSSLLockingCallback(int mode, int n, const char *file, int line)
+{
+    if (mode & CRYPTO_LOCK)
+        pthread_mutex_lock(&sOpenSSLLocks[n]);
+    else
+        pthread_mutex_unlock(&sOpenSSLLocks[n]);
+}
+
+static unsigned long OpenSSLThreadIdCallback(void)
+{
+    return (unsigned long)pthread_self();
+}
+
+#endif // (OPENSSL_VERSION_NUMBER < 0x10100000L)
+
+bool InitOpenSSLThreads()
+{
+    bool res = true;
+
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+    if (sOpenSSLLocks == NULL)
+    {
+        int numLocks = CRYPTO_num_locks();
+
+        sOpenSSLLocks = (pthread_mutex_t *)OPENSSL_malloc(numLocks * sizeof(pthread_mutex_t));
+        if (sOpenSSLLocks == NULL)
+        {
+            fprintf(stderr, "Memory allocation error\n");
+            ExitNow(res = false);
+        }
+
+        for (int i = 0; i < numLocks; i++)
+            pthread_mutex_init(&sOpenSSLLocks[i], NULL);
+
+        CRYPTO_set_id_callback(OpenSSLThreadIdCallback);
+        CRYPTO_set_locking_callback(OpenSSLLockingCallback);
+    }
+
+exit:
+#endif // (OPENSSL_VERSION_NUMBER < 0x10100000L)
+
+    return res;
+}
+
 OID NIDToWeaveOID(int nid)
 {
     const ASN1_OBJECT *encodedOID;
@@ -137,6 +137,7 @@ extern bool DecodePublicKey(const uint8_t *keyData, uint32_t keyDataLen, KeyForm
 extern KeyFormat DetectPublicKeyFormat(const uint8_t *key, uint32_t keyLen);
 
 extern bool InitOpenSSL();
+extern bool InitOpenSSLThreads();
 extern OID NIDToWeaveOID(int nid);
 extern char *Base64Encode(const uint8_t *inData, uint32_t inDataLen);
 extern uint8_t *Base64Encode(const uint8_t *inData, uint32_t inDataLen, uint8_t *outBuf, uint32_t outBufSize, uint32_t& outDataLen);
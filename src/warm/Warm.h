@@ -405,6 +405,10 @@ void InvokeActions(void);
  *    When this happens new Address and Routing Actions will be suspended until the system
  *    calls ReportActionComplete to announce the completion of the operation.
  *
+ *    When WARM_CONFIG_MAX_CONCURRENT_ACTIONS is greater than 1, the Actions that do not
+ *    depend on the ones in progress keep being issued, and the platform must report the
+ *    completion of the asynchronous operations in the order in which they were started.
+ *
  *  @param[in]  inResult    The result of the pending action. must be one of: {kPlatformResultSuccess | kPlatformResultFailure}
  *
  */
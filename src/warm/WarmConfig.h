@@ -296,6 +296,32 @@
 #define WARM_CONFIG_ENABLE_BACKUP_ROUTING_OVER_THREAD             1
 #endif // WARM_CONFIG_ENABLE_BACKUP_ROUTING_OVER_THREAD
 
+/**
+ *  @def WARM_CONFIG_MAX_CONCURRENT_ACTIONS
+ *
+ *  @brief
+ *    The maximum number of platform actions that may be in
+ *    progress at the same time.
+ *
+ *    With the default of 1, WARM waits for each platform API
+ *    returning kPlatformResultInProgress to complete before
+ *    taking any further action.  With a larger value, WARM keeps
+ *    issuing the actions that do not depend on the ones in
+ *    progress, e.g. the Tunnel address while a Thread route is
+ *    being added, so that the system converges faster after an
+ *    interface flap.  The platform must then report the
+ *    completion of the actions, by calling ReportActionComplete(),
+ *    in the order in which they were issued.
+ *
+ */
+#ifndef WARM_CONFIG_MAX_CONCURRENT_ACTIONS
+#define WARM_CONFIG_MAX_CONCURRENT_ACTIONS                        1
+#endif // WARM_CONFIG_MAX_CONCURRENT_ACTIONS
+
+#if WARM_CONFIG_MAX_CONCURRENT_ACTIONS < 1 || WARM_CONFIG_MAX_CONCURRENT_ACTIONS > 16
+#error "WARM_CONFIG_MAX_CONCURRENT_ACTIONS must be between 1 and 16"
+#endif
+
 // clang-format on
 
 #endif /* WARMCONFIG_H_ */
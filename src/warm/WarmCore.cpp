@@ -83,6 +83,7 @@ typedef struct
     FlagsType           mNecessaryActiveSystemFeatures; /**< Stores the System Features that that are pre-requisites for taking the affirmative form of the Action. */
     ActionType          mActionType;                    /**< The type of Action to which this Entry pertains. */
     ActionFunction      mAction;                        /**< A function to execute the Action. */
+    FlagsType           mDependencies;                  /**< Stores the Actions that this Action must not run concurrently with; the relation must be symmetric. */
 } ActionEntry;
 
 typedef struct {
@@ -97,9 +98,11 @@ typedef struct {
 #endif
 
     // the following members are used to support platform API's that return kPlatformResultInProgress
-    volatile bool                                           mActionInProgress;             /**< Tracks whether or not an Action is in progress. */
-    ActionType                                              mInProgressAction;             /**< Stores the type of Action that is in progress. */
-    bool                                                    mInProgressActionState;        /**< Stores the desired State of the Action when the Action completes. */
+    volatile uint8_t                                        mNumInProgressActions;         /**< Tracks the number of Actions that are in progress. */
+    uint8_t                                                 mInProgressHead;               /**< Stores the index of the oldest Action in progress. */
+    FlagsType                                               mInProgressActions;            /**< Tracks the Actions that are in progress. */
+    ActionType                                              mInProgressAction[WARM_CONFIG_MAX_CONCURRENT_ACTIONS];       /**< Stores the Actions that are in progress, in the order they were issued. */
+    bool                                                    mInProgressActionState[WARM_CONFIG_MAX_CONCURRENT_ACTIONS];  /**< Stores the desired State of each Action when it completes. */
 } ModuleState;
 
 // Prototypes
@@ -317,12 +320,17 @@ static PlatformActionExecution RecordPlatformResult(PlatformResult inResult, Act
             break;
 
         case kPlatformResultInProgress:
-            retval = kPlatformActionExecutionSuspendForAsynchOpCompletion; // instruct caller to stop executing actions.
-            // record that an action is in progress and use this in ReportActionComplete()
-            sState.mInProgressAction = inAction;
-            sState.mInProgressActionState = inActionState;
-            sState.mActionInProgress = true;
+        {
+            const uint8_t tail = (sState.mInProgressHead + sState.mNumInProgressActions) % WARM_CONFIG_MAX_CONCURRENT_ACTIONS;
+
+            retval = kPlatformActionExecutionSuspendForAsynchOpCompletion; // instruct caller to hold the dependent actions.
+            // record that an action is in progress, in issue order, and use this in ReportActionComplete()
+            sState.mInProgressAction[tail] = inAction;
+            sState.mInProgressActionState[tail] = inActionState;
+            sState.mInProgressActions |= inAction;
+            sState.mNumInProgressActions++;
             break;
+        }
     }
 
     return retval;
@@ -431,7 +439,9 @@ WEAVE_ERROR Init(WeaveFabricState &inFabricState)
 
     sState.mSystemFeatureStateFlags = 0;
     sState.mActionStateFlags        = 0;
-    sState.mActionInProgress        = false;
+    sState.mNumInProgressActions    = 0;
+    sState.mInProgressHead          = 0;
+    sState.mInProgressActions       = 0;
     sState.mFabricState             = &inFabricState;
 
     err = Platform::Init(&sFabricStateDelegate);
@@ -569,7 +579,7 @@ void InvokeActions(void)
 {
     Platform::CriticalSectionEnter();
     {
-        if (!sState.mActionInProgress)
+        if (sState.mNumInProgressActions < WARM_CONFIG_MAX_CONCURRENT_ACTIONS)
         {
             // this represents what should be the one-and-only call to TakeActions().
             TakeActions();
@@ -592,12 +602,18 @@ void InvokeActions(void)
  */
 void ReportActionComplete(PlatformResult inResult)
 {
-    VerifyOrExit(((inResult != kPlatformResultInProgress) && (sState.mActionInProgress)), (void)0);
+    VerifyOrExit(((inResult != kPlatformResultInProgress) && (sState.mNumInProgressActions != 0)), (void)0);
 
     Platform::CriticalSectionEnter();
     {
-        RecordPlatformResult(inResult, sState.mInProgressAction, sState.mInProgressActionState);
-        sState.mActionInProgress = false;
+        // Actions complete in the order they were issued.
+        const uint8_t head = sState.mInProgressHead;
+
+        sState.mInProgressHead = (head + 1) % WARM_CONFIG_MAX_CONCURRENT_ACTIONS;
+        sState.mNumInProgressActions--;
+        sState.mInProgressActions &= ~sState.mInProgressAction[head];
+
+        RecordPlatformResult(inResult, sState.mInProgressAction[head], sState.mInProgressActionState[head]);
     }
     Platform::CriticalSectionExit();
 
@@ -1207,7 +1223,8 @@ static void TakeActions(void)
             ( kSystemFeatureTypeIsFabricMember |
               kSystemFeatureTypeWiFiConnected ),
             kActionTypeWiFiHostAddress,
-            WiFiHostAddressAction
+            WiFiHostAddressAction,
+            0
         },
 #endif // WARM_CONFIG_SUPPORT_WIFI
 #if WARM_CONFIG_SUPPORT_THREAD
@@ -1215,19 +1232,22 @@ static void TakeActions(void)
             ( kSystemFeatureTypeIsFabricMember |
               kSystemFeatureTypeThreadConnected ),
             kActionTypeThreadHostAddress,
-            ThreadHostAddressAction
+            ThreadHostAddressAction,
+            kActionTypeHostRouteThread
         },
         {
             ( kSystemFeatureTypeIsFabricMember |
               kSystemFeatureTypeThreadConnected ),
             kActionTypeThreadThreadAddress,
-            ThreadThreadAddressAction
+            ThreadThreadAddressAction,
+            kActionTypeThreadAdvertisement
         },
         {
             ( kSystemFeatureTypeIsFabricMember |
               kSystemFeatureTypeThreadConnected ),
             kActionTypeHostRouteThread,
-            ThreadHostRouteAction
+            ThreadHostRouteAction,
+            kActionTypeThreadHostAddress
         },
 #endif // WARM_CONFIG_SUPPORT_THREAD
 #if WARM_CONFIG_SUPPORT_LEGACY6LOWPAN_NETWORK
@@ -1235,13 +1255,15 @@ static void TakeActions(void)
             ( kSystemFeatureTypeIsFabricMember |
               kSystemFeatureTypeThreadConnected ),
             kActionTypeLegacy6LoWPANHostAddress,
-            LegacyHostAddressAction
+            LegacyHostAddressAction,
+            0
         },
         {
             ( kSystemFeatureTypeIsFabricMember |
               kSystemFeatureTypeThreadConnected ),
             kActionTypeLegacy6LoWPANThreadAddress,
-            LegacyThreadAddressAction
+            LegacyThreadAddressAction,
+            0
         },
 #endif // WARM_CONFIG_SUPPORT_LEGACY6LOWPAN_NETWORK
 #if WARM_CONFIG_SUPPORT_THREAD_ROUTING
@@ -1250,7 +1272,9 @@ static void TakeActions(void)
               kSystemFeatureTypeThreadConnected |
               kSystemFeatureTypeThreadRoutingEnabled ),
             kActionTypeThreadAdvertisement,
-            ThreadAdvertisementAction
+            ThreadAdvertisementAction,
+            ( kActionTypeThreadThreadAddress |
+              kActionTypeThreadRoute )
         },
 #endif // WARM_CONFIG_SUPPORT_THREAD_ROUTING
 #if WARM_CONFIG_SUPPORT_BORDER_ROUTING
@@ -1262,7 +1286,9 @@ static void TakeActions(void)
               kSystemFeatureTypeBorderRoutingEnabled |
               kSystemFeatureTypeTunnelState ),
             kActionTypeThreadRoute,
-            ThreadThreadRouteAction
+            ThreadThreadRouteAction,
+            ( kActionTypeThreadAdvertisement |
+              kActionTypeThreadRoutePriority )
         },
         {
             ( kSystemFeatureTypeIsFabricMember |
@@ -1272,7 +1298,8 @@ static void TakeActions(void)
               kSystemFeatureTypeBorderRoutingEnabled |
               kSystemFeatureTypeTunnelState ),
             kActionTypeThreadRoutePriority,
-            ThreadRoutePriorityAction
+            ThreadRoutePriorityAction,
+            kActionTypeThreadRoute
         },
 #endif // WARM_CONFIG_SUPPORT_BORDER_ROUTING
 #if WARM_CONFIG_SUPPORT_WEAVE_TUNNEL
@@ -1280,14 +1307,16 @@ static void TakeActions(void)
             ( kSystemFeatureTypeIsFabricMember |
               kSystemFeatureTypeTunnelInterfaceEnabled ),
             kActionTypeTunnelHostAddress,
-            TunnelHostAddressAction
+            TunnelHostAddressAction,
+            kActionTypeTunnelHostRoute
         },
         {
             ( kSystemFeatureTypeIsFabricMember |
               kSystemFeatureTypeTunnelInterfaceEnabled |
               kSystemFeatureTypeTunnelState),
             kActionTypeTunnelHostRoute,
-            TunnelHostRouteAction
+            TunnelHostRouteAction,
+            kActionTypeTunnelHostAddress
         },
 #endif // WARM_CONFIG_SUPPORT_WEAVE_TUNNEL
     };
@@ -1297,18 +1326,38 @@ static void TakeActions(void)
     const uint64_t globalId = nl::Weave::WeaveFabricIdToIPv6GlobalId(sState.mFabricId);
     const uint64_t interfaceId = nl::Weave::WeaveNodeIdToIPv6InterfaceId(sState.mFabricState->LocalNodeId);
     ActionType theActionType;
+    FlagsType blockedActions = sState.mInProgressActions;
+
+    // The Actions in progress, and those depending on them, must wait for them to complete.
+    for (size_t i = 0 ; i < sizeof(kActions) / sizeof(kActions[0]) ; i++)
+    {
+        if (kActions[i].mActionType & sState.mInProgressActions)
+        {
+            blockedActions |= kActions[i].mDependencies;
+        }
+    }
 
     for (size_t i = 0 ; i < sizeof(kActions) / sizeof(kActions[0]) ; i++)
     {
         theActionType = kActions[i].mActionType;
 
+        if (theActionType & blockedActions)
+        {
+            continue;
+        }
+
         if (ShouldPerformAction(theActionType, kActions[i].mNecessaryActiveSystemFeatures, activate))
         {
             platformResult = kActions[i].mAction(theActionType, activate, globalId, interfaceId);
 
             if (kPlatformActionExecutionContinue != RecordPlatformResult(platformResult, theActionType, activate))
             {
-                break;
+                if (sState.mNumInProgressActions >= WARM_CONFIG_MAX_CONCURRENT_ACTIONS)
+                {
+                    break;
+                }
+
+                blockedActions |= kActions[i].mDependencies;
             }
         }
     }